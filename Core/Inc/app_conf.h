@@ -42,6 +42,49 @@
 /*****************************************************/
 
 /* USER CODE BEGIN Specific_Parameters */
+/**
+ * When CFG_ZIGBEE_SED_SUPPORTED is set to 1, the application is a Sleepy End Device instead of a Router (Debug_SED
+ * build configuration, linked with ZigBeeProR23_RFD.a) : it joins as a battery powered device with its receiver off,
+ * polls its Parent and sleeps in Standby between the polls.
+ */
+#ifndef CFG_ZIGBEE_SED_SUPPORTED
+#define CFG_ZIGBEE_SED_SUPPORTED  (0)
+#endif /* CFG_ZIGBEE_SED_SUPPORTED */
+
+/**
+ * When CFG_ZIGBEE_SNIFFER_SUPPORTED is set to 1, the application is an 802.15.4 sniffer instead of a Router
+ * (Debug_Sniffer build configuration) : the Zigbee stack is not started, and the frames received by the raw MAC are
+ * streamed in PCAP format on the trace UART.
+ */
+#ifndef CFG_ZIGBEE_SNIFFER_SUPPORTED
+#define CFG_ZIGBEE_SNIFFER_SUPPORTED  (0)
+#endif /* CFG_ZIGBEE_SNIFFER_SUPPORTED */
+
+/**
+ * When CFG_ZIGBEE_CONCURRENT_SUPPORTED is set to 1, the application runs on the BLE + 802.15.4 concurrent link layer
+ * (Debug_Concurrent build configuration) : the radio is time-sliced by the event scheduler of the link layer between
+ * the BLE events and the MAC events, arbitrated as set by the CFG_LL_COEX_* parameters.
+ */
+#ifndef CFG_ZIGBEE_CONCURRENT_SUPPORTED
+#define CFG_ZIGBEE_CONCURRENT_SUPPORTED  (0)
+#endif /* CFG_ZIGBEE_CONCURRENT_SUPPORTED */
+
+/**
+ * When CFG_ZIGBEE_ZDD_SUPPORTED is set to 1, the Router is also a Zigbee Direct Device (Debug_ZDD build configuration,
+ * concurrent link layer, linked with the ZDD stack) : a phone connected by BLE commissions the device and tunnels its
+ * ZDO/ZCL requests into the network ( see CFG_ZIGBEE_ZDD_WINDOW ).
+ */
+#ifndef CFG_ZIGBEE_ZDD_SUPPORTED
+#define CFG_ZIGBEE_ZDD_SUPPORTED  (0)
+#endif /* CFG_ZIGBEE_ZDD_SUPPORTED */
+
+/**
+ * CFG_ZIGBEE_STACK_SE is set to 1 by the build configuration linked with the R22 Smart Energy stack (Debug_R22_SE).
+ * The R22 builds (Debug_R22, Debug_R22_SE) also set CONFIG_ZB_REV to 22 for the headers of the stack.
+ */
+#ifndef CFG_ZIGBEE_STACK_SE
+#define CFG_ZIGBEE_STACK_SE  (0)
+#endif /* CFG_ZIGBEE_STACK_SE */
 
 /* USER CODE END Specific_Parameters */
 
@@ -66,6 +109,40 @@
 #define CFG_LPM_STDBY_WAKEUP_TIME (1500)
 
 /* USER CODE BEGIN Low_Power 0 */
+/* Minimum time (in ms) until the next deadline (Zigbee stack timer, application timer or radio event) to enter
+ * Stop mode, and to enter Standby (GPIO and radio restored at wake-up). Below, the device stays in a lighter mode. */
+#define CFG_LPM_STOP_MIN_TIME     (2U)
+#define CFG_LPM_STDBY_MIN_TIME    (20U)
+
+/* Above these floors, the deepest mode that pays off until the next deadline is selected : the charge of each mode
+ * is its transition cost (measured enter + exit time, at the run current) plus the rest of the time at its own
+ * current. Typical currents in uA, to be adjusted to the board. The exit from Standby counts CFG_LPM_STDBY_WAKEUP_TIME
+ * (restore not measured), the Stop transition cost starts at CFG_LPM_STOP_COST_INIT (us) until measured. */
+#define CFG_LPM_RUN_CURRENT       (3000U)
+#define CFG_LPM_SLEEP_CURRENT     (1200U)
+#define CFG_LPM_STOP_CURRENT      (30U)
+#define CFG_LPM_STDBY_CURRENT     (2U)
+#define CFG_LPM_STOP_COST_INIT    (200U)
+
+/* At the exit of Standby, restore the GPIO ports and EXTI lines from a snapshot taken at the entry (SRAM retained)
+ * instead of running again the BSP init of the LEDs and buttons. The handles in SRAM are kept as they are. */
+#define CFG_LPM_STDBY_FAST_RESTORE  (0)
+
+#if (CFG_ZIGBEE_SED_SUPPORTED != 0)
+  /* Sleepy End Device : lowest power (log and debug disabled), Standby with retention between the polls */
+  #undef  CFG_LPM_LEVEL
+  #define CFG_LPM_LEVEL             (2)
+  #undef  CFG_LPM_STDBY_SUPPORTED
+  #define CFG_LPM_STDBY_SUPPORTED   (1)
+#endif /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0)
+  /* Sniffer : receiver always on, and the trace UART must be available */
+  #undef  CFG_LPM_LEVEL
+  #define CFG_LPM_LEVEL             (0)
+  #undef  CFG_LPM_STDBY_SUPPORTED
+  #define CFG_LPM_STDBY_SUPPORTED   (0)
+#endif /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
 
 /* USER CODE END Low_Power 0 */
 
@@ -80,6 +157,13 @@ typedef enum
   CFG_LPM_LL_DEEPSLEEP,
   CFG_LPM_LL_HW_RCO_CLBR,
   /* USER CODE BEGIN CFG_LPM_Id_t */
+  CFG_LPM_APP_DEADLINE,
+  CFG_LPM_PKA,
+  CFG_LPM_ADC,
+  CFG_LPM_LOG_RX,
+  CFG_LPM_LEVEL_PWM,
+  CFG_LPM_METER,
+  CFG_LPM_SCRATCH,
 
   /* USER CODE END CFG_LPM_Id_t */
 } CFG_LPM_Id_t;
@@ -100,8 +184,8 @@ typedef enum
  * Logs
  *
  * Applications must call LOG_INFO_APP for logs.
- * By default, CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE is set to 0.
- * As a result, there is no time stamp insertion inside the logs.
+ * By default, CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE is set to 1.
+ * As a result, each log starts with its time stamp ("[value] "), read from CFG_LOG_TIME_STAMP_SOURCE.
  *
  * For advanced log use cases, see the log_module.h file.
  * This file is customizable, you can create new verbose levels and log regions.
@@ -119,12 +203,70 @@ extern UART_HandleTypeDef           huart1;
 
 /* Configure Log display settings */
 #define CFG_LOG_INSERT_COLOR_INSIDE_THE_TRACE       (1U)
-#define CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE  (0U)
+#define CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE  (1U)
 #define CFG_LOG_INSERT_EOL_INSIDE_THE_TRACE         (1U)
 
+/**
+ * Source of the time stamp of the logs (text and binary), the same for the application and the stacks logs:
+ * the microseconds time base (TIMER_IF_GetTimeUs : DWT cycles bounded by the RTC, continuing through the Stop modes),
+ * or the UTIL_TIMER in milliseconds.
+ */
+#define CFG_LOG_TIME_STAMP_SOURCE_DWT     (0U)
+#define CFG_LOG_TIME_STAMP_SOURCE_TIMER   (1U)
+#define CFG_LOG_TIME_STAMP_SOURCE         (CFG_LOG_TIME_STAMP_SOURCE_DWT)
+
 #define CFG_LOG_TRACE_FIFO_SIZE     (4096U)
 #define CFG_LOG_TRACE_BUF_SIZE      (256U)
 
+/**
+ * When CFG_LOG_BINARY_SUPPORTED is set to 1, the logs are not formatted on target: only the address of
+ * the format string, a time stamp and the raw arguments are sent. The text is rendered on the host from
+ * the ELF file with STM32CubeIDE/log_decode.py.
+ */
+#define CFG_LOG_BINARY_SUPPORTED    (0U)
+
+/* The logs are also captured as binary frames by the crash log ( see CFG_CRASH_LOG_SUPPORTED ) and the BLE
+ * diagnostics export ( see CFG_BLE_DIAG_SUPPORTED ) */
+#define CFG_LOG_CAPTURE_SUPPORTED   ( ( CFG_CRASH_LOG_SUPPORTED != 0 ) || ( CFG_BLE_DIAG_SUPPORTED != 0 ) )
+
+/**
+ * When CFG_LOG_ZERO_COPY_SUPPORTED is set to 1, the logs are formatted directly inside the trace FIFO instead
+ * of a CFG_LOG_TRACE_BUF_SIZE buffer on the stack of the caller.
+ */
+#define CFG_LOG_ZERO_COPY_SUPPORTED (1U)
+
+/**
+ * Rate limitation of the logs, per region: at most CFG_LOG_RATE_LIMIT_PER_SECOND logs per second on average
+ * and CFG_LOG_RATE_LIMIT_BURST at once, so that a burst of logs cannot overrun the trace FIFO.
+ */
+#define CFG_LOG_RATE_LIMIT_SUPPORTED    (1U)
+#define CFG_LOG_RATE_LIMIT_PER_SECOND   (50U)
+#define CFG_LOG_RATE_LIMIT_BURST        (64U)
+
+/**
+ * When CFG_LOG_TRACE_STATS_SUPPORTED is set to 1, the trace FIFO counts the dropped traces and bytes, the overruns
+ * and its highest fill, dumped with the TRACESTATS command.
+ */
+#define CFG_LOG_TRACE_STATS_SUPPORTED   (1U)
+
+/**
+ * Output of the traces: the USART (DMA), the ITM stimulus port 0 (SWO, configured by the debugger) or a
+ * RAM ring buffer read by the debugger (SEGGER RTT layout). The commands are always received on the USART.
+ */
+#define CFG_LOG_TRANSPORT_USART     (0U)
+#define CFG_LOG_TRANSPORT_ITM       (1U)
+#define CFG_LOG_TRANSPORT_RTT       (2U)
+#define CFG_LOG_TRANSPORT           (CFG_LOG_TRANSPORT_USART)
+#define CFG_LOG_RTT_BUFFER_SIZE     (2048U)
+
+/**
+ * When CFG_LOG_RX_DMA_SUPPORTED is set to 1 (and the USART has a RX DMA channel), the commands are received by a
+ * circular DMA in a ring of CFG_LOG_RX_RING_SIZE bytes, given to the consumer at half ring, end of ring and idle
+ * line instead of one interrupt per character. Stop mode is not used while it receives (CFG_LPM_LOG_RX).
+ */
+#define CFG_LOG_RX_DMA_SUPPORTED    (1U)
+#define CFG_LOG_RX_RING_SIZE        (256U)
+
 /* macro ensuring retrocompatibility with old applications */
 #define APP_DBG                     LOG_INFO_APP
 #define APP_DBG_MSG                 LOG_INFO_APP
@@ -172,7 +314,7 @@ extern UART_HandleTypeDef           huart1;
 
 /**
  * These are the lists of task id registered to the sequencer
- * Each task id shall be in the range [0:31]
+ * Each task id shall be in the range [0:UTIL_SEQ_CONF_TASK_NBR-1], each task has its own id
  */
 typedef enum
 {
@@ -188,9 +330,39 @@ typedef enum
   CFG_TASK_ZIGBEE_APP3,
   CFG_TASK_ZIGBEE_APP4,
   /* USER CODE BEGIN CFG_Task_Id_t */
+  CFG_TASK_TIMER_SERVER,          /* Task linked to Timer Server deferred expiries. */
   CFG_TASK_BSP_BUTTON_B1,         /* Task linked to push-button. */
   CFG_TASK_BSP_BUTTON_B2,
   CFG_TASK_BSP_BUTTON_B3,
+  CFG_TASK_FLASH_MANAGER,         /* Task linked to the Flash Manager (Zigbee persistence). */
+  CFG_TASK_ZIGBEE_PERSISTENCE,    /* Task linked to the save of the Zigbee persistence data. */
+  CFG_TASK_ZIGBEE_INSTALL_CODE,   /* Task linked to the derivation of the install code link keys. */
+  CFG_TASK_ZIGBEE_JOIN_ADMISSION, /* Task linked to the reopening of the Permit Join after a deferral. */
+  CFG_TASK_ZIGBEE_FANOUT,         /* Task linked to the send of a ZCL command to a list of destinations. */
+  CFG_TASK_ZIGBEE_TRAFFIC,        /* Task linked to the OnOff traffic generator. */
+  CFG_TASK_ZIGBEE_HEALTH,         /* Task linked to the sample of the Neighbor/Route tables. */
+  CFG_TASK_ZIGBEE_BROADCAST,      /* Task linked to the adaptive broadcast policy. */
+  CFG_TASK_ZIGBEE_CONCENTRATOR,   /* Task linked to the tuning of the Concentrator parameters. */
+  CFG_TASK_ZIGBEE_REPORT,         /* Task linked to the attribute report aggregator. */
+  CFG_TASK_ZIGBEE_OTA,            /* Task linked to the OTA download (flash pipeline). */
+  CFG_TASK_ZIGBEE_POLL,           /* Task linked to the data polls of the Sleepy End Device. */
+  CFG_TASK_ZIGBEE_TX_POWER,       /* Task linked to the adaptive TX power. */
+  CFG_TASK_ZIGBEE_CHANNEL,        /* Task linked to the energy scans of the channel quality monitor. */
+  CFG_TASK_TEMP_MEAS,             /* Task linked to the temperature measurements (radio calibrations). */
+  CFG_TASK_HW_PKA,                /* Task linked to the asynchronous PKA jobs. */
+  CFG_TASK_SCM_GOVERNOR,          /* Task linked to the load-driven system clock request. */
+  CFG_TASK_ZIGBEE_COUNTER,        /* Task linked to the NWK frame counter log. */
+  CFG_TASK_SNVMA_CHECK,           /* Task linked to the CRC check of the SNVMA bank trusted at Init. */
+  CFG_TASK_SNVMA_FLUSH,           /* Task linked to the writes merged by the SNVMA coalescing window. */
+  CFG_TASK_CRYPTO_BENCH,          /* Task linked to the crypto micro-benchmarks. */
+  CFG_TASK_NVM_BENCH,             /* Task linked to the persistence benchmark. */
+  CFG_TASK_HOST_PROTOCOL,         /* Task linked to the host control protocol. */
+  CFG_TASK_ZIGBEE_CSMA,           /* Task linked to the tuning of the CSMA-CA parameters. */
+  CFG_TASK_ZIGBEE_STAGGER,        /* Task linked to the slots of the staggered network-wide operations. */
+  CFG_TASK_ZIGBEE_PERSIST_BATCH,  /* Task linked to the flush of the batched attribute persistence. */
+  CFG_TASK_BLE_HOST,              /* Task linked to the BLE host stack (BLE diagnostics export, Zigbee Direct). */
+  CFG_TASK_BLE_DIAG,              /* Task linked to the notifications of the BLE diagnostics export. */
+  CFG_TASK_ZIGBEE_ZDD,            /* Task linked to the tunnel window and the port of the Zigbee Direct. */
 
   /* USER CODE END CFG_Task_Id_t */
   CFG_TASK_NBR /* Shall be LAST in the list */
@@ -209,29 +381,363 @@ typedef enum
   CFG_SEQ_PRIO_0 = 0,
   CFG_SEQ_PRIO_1,
   /* USER CODE BEGIN CFG_SEQ_Prio_Id_t */
+  CFG_SEQ_PRIO_2,
+  CFG_SEQ_PRIO_3,
 
   /* USER CODE END CFG_SEQ_Prio_Id_t */
   CFG_SEQ_PRIO_NBR /* Shall be LAST in the list */
 } CFG_SEQ_Prio_Id_t;
 
-/* Sequencer configuration */
+/**
+ * Priority classes of the tasks (TASK_PRIO_xxx of stm32_rtos.h). The first level is reserved to the radio tasks
+ * (CFG_SEQ_RADIO_TASKS : link layer, its RNG and temperature tasks, and MAC), so that the radio latency does not
+ * depend on the application. With CFG_SEQ_PRIO_CHECK_SUPPORTED, a task of another class set at this level is run at
+ * the system level instead, with a warning logged once per task (PRIOSTATS gives the offending tasks).
+ */
+#define CFG_SEQ_PRIO_RADIO                  CFG_SEQ_PRIO_0    /* Link layer and MAC */
+#define CFG_SEQ_PRIO_SYSTEM                 CFG_SEQ_PRIO_1    /* Zigbee stack, timer server, memory, flash, clock */
+#define CFG_SEQ_PRIO_APP                    CFG_SEQ_PRIO_2    /* Application : clusters, network services, buttons */
+#define CFG_SEQ_PRIO_BACKGROUND             CFG_SEQ_PRIO_3    /* Benchmarks and host protocol */
+#define CFG_SEQ_PRIO_CHECK_SUPPORTED        (1)
+
+/* Sequencer configuration : above 32 tasks, the task bit mapping (UTIL_SEQ_bm_t) is 64 bits wide */
 #define UTIL_SEQ_CONF_PRIO_NBR              CFG_SEQ_PRIO_NBR
+#define UTIL_SEQ_CONF_TASK_NBR              (48)      /* At least CFG_TASK_NBR, checked in app_entry.c */
+
+/**
+ * When CFG_SEQ_PROFILING_SUPPORTED is set to 1, the sequencer records the execution time
+ * and the SetTask to run latency of each task using the DWT cycle counter.
+ * Statistics can be read with UTIL_SEQ_GetStats() or printed with the 'SEQSTATS' serial command.
+ */
+#define CFG_SEQ_PROFILING_SUPPORTED         (0)
+
+/**
+ * Number of tasks that can be delayed or periodically set at the same time with
+ * UTIL_SEQ_SetTaskDelayed() / UTIL_SEQ_SetTaskPeriodic(). Set to 0 to remove the feature.
+ */
+#define CFG_SEQ_DELAYED_TASK_NBR            (2)
+
+/**
+ * When CFG_SEQ_MSG_QUEUE_SUPPORTED is set to 1, a message queue can be attached to a task with
+ * UTIL_SEQ_RegMsgQueue(), ISRs then post their items with UTIL_SEQ_PostMsg() and the task drains
+ * them with UTIL_SEQ_GetMsg().
+ */
+#define CFG_SEQ_MSG_QUEUE_SUPPORTED         (0)
+
+/**
+ * When CFG_SEQ_TASK_BUDGET_SUPPORTED is set to 1, a warning is logged each time a sequencer task
+ * runs longer than CFG_SEQ_TASK_BUDGET_US (measured with the DWT cycle counter).
+ */
+#define CFG_SEQ_TASK_BUDGET_SUPPORTED       (0)
+#define CFG_SEQ_TASK_BUDGET_US              (5000u)
+
+/**
+ * When CFG_SEQ_RADIO_YIELD_SUPPORTED is set to 1, a long application task can call APPE_SEQ_YieldToRadio() between
+ * two steps of its work : the pending link layer and MAC tasks are run there, nested, instead of waiting for its
+ * end. It shall not be called from a Zigbee stack callback (the MAC indications would re-enter the stack).
+ */
+#define CFG_SEQ_RADIO_YIELD_SUPPORTED       (1)
+
+/**
+ * When CFG_SEQ_DEFERRABLE_SUPPORTED is set to 1, the housekeeping tasks registered with UTIL_SEQ_TASK_DEFERRABLE
+ * (Zigbee health, NVM check) do not wake the device on their own : they run in the next wakeup that runs another
+ * task, at the latest CFG_SEQ_DEFER_MAX_DELAY ms after they were set. Only useful with the low power modes.
+ */
+#if ( CFG_LPM_LEVEL != 0 )
+#define CFG_SEQ_DEFERRABLE_SUPPORTED        (1)
+#else /* ( CFG_LPM_LEVEL != 0 ) */
+#define CFG_SEQ_DEFERRABLE_SUPPORTED        (0)
+#endif /* ( CFG_LPM_LEVEL != 0 ) */
+#define CFG_SEQ_DEFER_MAX_DELAY             (2000u)   /* ms */
+
+/**
+ * When CFG_SEQ_DEADLINE_SUPPORTED is set to 1, the tasks set with UTIL_SEQ_SetTaskDeadline() (deadline in us of the
+ * microseconds time base) are run before the other tasks of their priority level, the earliest deadline first. The
+ * deadlines missed are counted for each task and printed with the SEQDEADLINE command. The Flash Manager task is set
+ * with the end of the radio window it requests for a write.
+ */
+#define CFG_SEQ_DEADLINE_SUPPORTED          (1)
+
+/**
+ * When CFG_LOAD_METER_SUPPORTED is set to 1, the idle time of the sequencer (from UTIL_SEQ_PreIdle() to the end of
+ * UTIL_SEQ_PostIdle(), low power modes included) is measured with the microseconds time base, and the CPU load of
+ * each second is kept over the last 60 s. The mean loads over 1 s, 10 s and 60 s are printed with the LOADSTATS
+ * command, with the load of each task over the last 10 s when CFG_SEQ_PROFILING_SUPPORTED is set, and can be read
+ * remotely with CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED.
+ */
+#define CFG_LOAD_METER_SUPPORTED            (0)
+
+/**
+ * When CFG_TIMER_STATS_SUPPORTED is set to 1, the timer server records for each timer the lateness
+ * of its callback versus its expiry time (min, max and mean), dumped with the TIMSTATS command.
+ */
+#define CFG_TIMER_STATS_SUPPORTED           (0)
+
+/**
+ * When CFG_LL_ISR_STATS_SUPPORTED is set to 1, the radio high and SW low ISRs are measured with the DWT cycle
+ * counter : duration, nesting, SW low trigger to entry latency, re-triggers and handoffs to the low priority, and
+ * longest LINKLAYER_PLAT_DisableIRQ critical section with its caller. Dumped (then reset) with the ISRSTATS command.
+ */
+#define CFG_LL_ISR_STATS_SUPPORTED          (0)
+
+/**
+ * When CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED is set to 1, the ZIGBEE_PLAT RNG and AES entry points and the software AES
+ * block of the stack (its NWK/APS frame security) are measured with the DWT cycle counter : calls, total and longest
+ * call. Dumped (then reset) with the CRYPTOSTATS command.
+ */
+#define CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED   (0)
+
+/**
+ * When CFG_PERF_SNAPSHOT_SUPPORTED is set to 1, the PERFSNAP command prints in CSV ("PERFSNAP,<metric>,<value>,<unit>")
+ * the counters of the statistics built : sequencer, timer lateness, heaps and AMM, trace FIFO, MAC and APS counters,
+ * low power residency, CPU load and crypto. They are read without being reset : perf_gate.py takes a snapshot before
+ * and after a scripted traffic run, and compares their difference to a baseline.
+ */
+#define CFG_PERF_SNAPSHOT_SUPPORTED         (1)
+
+/**
+ * When CFG_BOOT_PROFILE_SUPPORTED is set to 1, the DWT cycle counter is started by SystemInit() and the time of each
+ * boot stage, from the reset to the end of APP_ZIGBEE_ApplicationStart(), is recorded in a RAM table, printed once
+ * the boot completes and with the BOOTSTATS command. Stages are timed in us up to the end of MX_APPE_Init(), then in
+ * ms with the timer server (the DWT is stopped in the low power modes).
+ */
+#define CFG_BOOT_PROFILE_SUPPORTED          (0)
+
+/**
+ * When CFG_STACK_MONITOR_SUPPORTED is set to 1, the free part of the main stack is painted at the start of main().
+ * After each sequencer task, the words just below the deepest point seen are checked, and every
+ * CFG_STACK_MONITOR_PERIOD ms the whole stack is scanned (the interrupts are seen there). The deepest point is
+ * recorded with the task running and the nesting level of UTIL_SEQ_Run(), a warning is logged when the headroom
+ * drops below CFG_STACK_MONITOR_HEADROOM bytes. Statistics with the STACKSTATS command.
+ */
+#define CFG_STACK_MONITOR_SUPPORTED         (1)
+#define CFG_STACK_MONITOR_PERIOD            (10000u)
+#define CFG_STACK_MONITOR_HEADROOM          (512u)
+
+/**
+ * When CFG_BOOT_PARALLEL_INIT_SUPPORTED is set to 1, the slow hardware settling of the boot is launched first in
+ * MX_APPE_Init() and completed where it is first needed : the RNG seeds while the system, the memory and the
+ * modules are initialized and its pool is filled just before the link layer, the ADC regulator (with the
+ * temperature based radio calibration) stabilizes before the first measurement. The result is unchanged, the gain
+ * is visible with CFG_BOOT_PROFILE_SUPPORTED.
+ */
+#define CFG_BOOT_PARALLEL_INIT_SUPPORTED    (0)
+
+/**
+ * When CFG_LL_BG_COALESCING_SUPPORTED is set to 1, the link layer background task is posted once while it is
+ * pending (the redundant requests are only counted), and it runs the link layer background process again while new
+ * work is requested, up to CFG_LL_BG_PROCESS_BUDGET_US, before yielding. Statistics with the LLBGSTATS command.
+ */
+#define CFG_LL_BG_COALESCING_SUPPORTED      (1)
+#define CFG_LL_BG_PROCESS_BUDGET_US         (500u)
+
+/**
+ * When CFG_HOT_CODE_IN_SRAM_SUPPORTED is set to 1, the functions marked HOT_CODE (sequencer loop, timer server
+ * expiry, radio interrupt, link layer ISR wrappers, AES block cipher, Zigbee slab allocator) are linked in the
+ * .RamFunc section, copied to SRAM by the startup code with the .data section, and run without flash wait states
+ * nor ICACHE misses. Calls between SRAM and flash go through long branch veneers added by the linker.
+ */
+#define CFG_HOT_CODE_IN_SRAM_SUPPORTED      (1)
+
+#if (CFG_HOT_CODE_IN_SRAM_SUPPORTED != 0)
+#define HOT_CODE                            __attribute__((section(".RamFunc"), noinline))
+#else
+#define HOT_CODE
+#endif /* (CFG_HOT_CODE_IN_SRAM_SUPPORTED != 0) */
+
+/**
+ * When CFG_ICACHE_STATS_SUPPORTED is set to 1, the hit and miss monitors of the ICACHE are started after its
+ * initialization. The hits, misses (16 bits counter, saturated), hit ratio and size of the code in SRAM are printed
+ * with the ICACHESTATS command, which restarts the counting.
+ */
+#define CFG_ICACHE_STATS_SUPPORTED          (1)
+
+/**
+ * When CFG_HAL_TICK_RTC_SUPPORTED is set to 1, the HAL time base (HAL_GetTick(), HAL_Delay() and the HAL timeouts)
+ * moves from the SysTick to the RTC binary counter of the timer server once it is initialized, continuing the
+ * SysTick count. The RTC keeps counting in Stop and Standby : the SysTick is stopped, there is no 1 kHz interrupt
+ * while idle and HAL_GetTick() stays right across the low power modes.
+ */
+#define CFG_HAL_TICK_RTC_SUPPORTED          (1)
+
+/**
+ * When CFG_LL_DELAY_TIMER_SUPPORTED is set to 1, the delays of the link layer (LINKLAYER_PLAT_DelayUs) from
+ * CFG_LL_DELAY_WFE_MIN_US are timed by TIM17 (one pulse at 1 MHz) with the CPU in WFE, woken by its pending interrupt
+ * (SEVONPEND, interrupt not enabled in the NVIC), the shorter ones by a busy wait on the cycle counter. Delays counted,
+ * printed with the DELAYSTATS command.
+ */
+#define CFG_LL_DELAY_TIMER_SUPPORTED        (1)
+#define CFG_LL_DELAY_WFE_MIN_US             (10u)
+
+/**
+ * When CFG_MAC_STATS_SUPPORTED is set to 1, the transmissions (success, CCA failure, no acknowledgment, other error)
+ * and receptions (success, FCS error, other error) of the MAC are counted in the radio callbacks, in total and over
+ * the last interval of CFG_MAC_STATS_PERIOD. Printed with the MACSTATS command.
+ */
+#define CFG_MAC_STATS_SUPPORTED             (1)
+#define CFG_MAC_STATS_PERIOD                (10000u)  /* ms */
+
+/**
+ * When CFG_MAC_BUFFER_STATS_SUPPORTED is set to 1, the allocations of the MAC buffer pool and the enqueues of the MAC
+ * queues are counted through the linker (--wrap=buffMgmt_allocateBuffer,--wrap=queueMgmt_enqueue) : buffers in use
+ * and peak, failed allocations, and for the first CFG_MAC_BUFFER_STATS_QUEUE_NB queues their peak and failed
+ * enqueues. Printed with the MACSTATS command, to size the pool (built in the MAC library) on the real traffic.
+ */
+#define CFG_MAC_BUFFER_STATS_SUPPORTED      (1)
+#define CFG_MAC_BUFFER_STATS_QUEUE_NB       (8u)
+
+#if ( CFG_MAC_BUFFER_STATS_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 )
+#error "CFG_MAC_BUFFER_STATS_SUPPORTED requires CFG_MAC_STATS_SUPPORTED (MACSTATS command)."
+#endif /* ( CFG_MAC_BUFFER_STATS_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 ) */
+
+/**
+ * When CFG_MAC_SRC_MATCH_SUPPORTED is set to 1, the indirect frames queued by the Zigbee stack for the sleepy children
+ * (MCPS-DATA.request, MLME-ASSOCIATE.response) are followed up to their confirmation, and the source address match
+ * table of the radio holds the children with a frame : the ACK of a data request carries the frame pending bit only
+ * for them, without software in the radio ISR. Above CFG_MAC_SRC_MATCH_FRAME_NB frames held, the bit is set for all
+ * the children until the frames followed are all confirmed. Needs the linker options --wrap=ST_MAC_init,
+ * --wrap=ST_MAC_MCPSDataReq and --wrap=ST_MAC_MLMEAssociateRes.
+ */
+#define CFG_MAC_SRC_MATCH_SUPPORTED         (1)
+#define CFG_MAC_SRC_MATCH_FRAME_NB          (16u)
+
+/**
+ * When CFG_FRAME_LOG_SUPPORTED is set to 1, the metadata of the last CFG_FRAME_LOG_RECORD_NB frames sent or received by
+ * the MAC (time, direction, MAC addresses and sequence, NWK sequence, frame types, length, RSSI/LQI, result) are kept
+ * in a RAM ring of 16 bytes records, filled in the radio callbacks of CFG_MAC_STATS_SUPPORTED without formatting.
+ * Printed with the FRAMELOG command, and added to the crash log entry ( CRASHLOG DUMP ).
+ */
+#define CFG_FRAME_LOG_SUPPORTED             (1)
+#define CFG_FRAME_LOG_RECORD_NB             (64u)
+
+#if ( CFG_FRAME_LOG_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 )
+#error "CFG_FRAME_LOG_SUPPORTED requires CFG_MAC_STATS_SUPPORTED (radio callbacks)."
+#endif /* ( CFG_FRAME_LOG_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 ) */
+
+/**
+ * Concurrent build (CFG_ZIGBEE_CONCURRENT_SUPPORTED) : in each window of CFG_LL_COEX_WINDOW_MS, the MAC events are
+ * raised to high priority over the BLE events until CFG_LL_COEX_ZIGBEE_AIRTIME (%) of the window is granted to the
+ * MAC, then compete at their own priority. The Zigbee protection (COEX PROTECT ON, e.g. during a BLE commissioning)
+ * keeps all of them at high priority. Statistics with the COEXSTATS command, share changed with COEX <share>.
+ */
+#define CFG_LL_COEX_WINDOW_MS               (100u)
+#define CFG_LL_COEX_ZIGBEE_AIRTIME          (60u)     /* % */
+
+/**
+ * When CFG_BLE_DIAG_SUPPORTED is set to 1 (concurrent build), the BLE host stack runs a GATT server exporting the
+ * diagnostics to a phone, without a serial cable : on a write of the control characteristic, the binary logs (frames
+ * of the log capture : format address, time stamp and raw arguments, rendered by log_decode.py), the frame log records
+ * or the logs of the performance snapshot are notified on the data characteristic as they are in RAM, without any
+ * formatting. At the connection, the LE 2M PHY, the longest data length and an ATT MTU of CFG_BLE_DIAG_ATT_MTU are
+ * requested. The records waiting for the link are kept in a FIFO of CFG_BLE_DIAG_FIFO_SIZE bytes (the new records are
+ * dropped when it is full). No pairing : the security records of the BLE host are kept in RAM until the reset.
+ * Statistics with the BLEDIAG command.
+ */
+#define CFG_BLE_DIAG_SUPPORTED              ( ( CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0 ) && ( CFG_ZIGBEE_ZDD_SUPPORTED == 0 ) )
+#define CFG_BLE_DIAG_DEVICE_NAME            "ZB-DIAG"
+#define CFG_BLE_DIAG_ATT_MTU                (247u)
+#define CFG_BLE_DIAG_ADV_INTERVAL_MIN       (0x0080u)   /* 0.625 ms unit : 80 ms */
+#define CFG_BLE_DIAG_ADV_INTERVAL_MAX       (0x00A0u)   /* 0.625 ms unit : 100 ms */
+#define CFG_BLE_DIAG_FIFO_SIZE              (8192u)
+
+#if ( CFG_BLE_DIAG_SUPPORTED != 0 ) && ( CFG_ZIGBEE_CONCURRENT_SUPPORTED == 0 )
+#error "CFG_BLE_DIAG_SUPPORTED requires the BLE + 802.15.4 concurrent link layer (CFG_ZIGBEE_CONCURRENT_SUPPORTED)."
+#endif /* ( CFG_BLE_DIAG_SUPPORTED != 0 ) && ( CFG_ZIGBEE_CONCURRENT_SUPPORTED == 0 ) */
+
+/**
+ * Zigbee Direct build (CFG_ZIGBEE_ZDD_SUPPORTED) : the GATT server of the ZDD stack owns the BLE host, in place of the
+ * diagnostics export. The requests written by the phone in the tunnel characteristic are given to the stack at most
+ * CFG_ZIGBEE_ZDD_WINDOW at a time (a request is in flight until its response is tunnelled back, or until
+ * CFG_ZIGBEE_ZDD_REQ_TIMEOUT), so that the BLE link keeps the mesh busy without flooding the APS queue. The next ones
+ * wait in a queue of CFG_ZIGBEE_ZDD_QUEUE_NB writes (its oldest one given to the stack at once when full). Latency of the
+ * requests per session (BLE link) and overall with the ZDD command.
+ */
+#define CFG_ZIGBEE_ZDD_ENDPOINT             (19u)       /* ZDD server cluster */
+#define CFG_ZIGBEE_ZDD_WINDOW               (4u)        /* Tunnelled requests in flight */
+#define CFG_ZIGBEE_ZDD_QUEUE_NB             (16u)       /* Tunnelled writes waiting for the window */
+#define CFG_ZIGBEE_ZDD_REQ_TIMEOUT          (5000u)     /* ms, in flight without response */
+#define CFG_ZIGBEE_ZDD_ADV_INTERVAL_MIN     (0x0080u)   /* 0.625 ms unit : 80 ms */
+#define CFG_ZIGBEE_ZDD_ADV_INTERVAL_MAX     (0x00A0u)   /* 0.625 ms unit : 100 ms */
+
+#if ( CFG_ZIGBEE_ZDD_SUPPORTED != 0 ) && ( CFG_ZIGBEE_CONCURRENT_SUPPORTED == 0 )
+#error "CFG_ZIGBEE_ZDD_SUPPORTED requires the BLE + 802.15.4 concurrent link layer (CFG_ZIGBEE_CONCURRENT_SUPPORTED)."
+#endif /* ( CFG_ZIGBEE_ZDD_SUPPORTED != 0 ) && ( CFG_ZIGBEE_CONCURRENT_SUPPORTED == 0 ) */
+
+#if ( CFG_ZIGBEE_ZDD_WINDOW == 0u )
+#error "CFG_ZIGBEE_ZDD_WINDOW shall not be 0."
+#endif /* ( CFG_ZIGBEE_ZDD_WINDOW == 0u ) */
+
+/* BLE host stack, for the diagnostics export or the Zigbee Direct */
+#define CFG_BLE_HOST_SUPPORTED              ( ( CFG_BLE_DIAG_SUPPORTED != 0 ) || ( CFG_ZIGBEE_ZDD_SUPPORTED != 0 ) )
+#define CFG_BLE_HOST_TIMER_NB               (4u)        /* Timers of the BLE host running at once */
+#define CFG_BLE_HOST_NVM_SIZE               (512u)      /* RAM records of the BLE host, in bytes */
+
+/**
+ * When USE_TEMPERATURE_BASED_RADIO_CALIBRATION is set to 1, the temperature is measured by the ADC (internal sensor)
+ * on the requests of the link layer, and every CFG_LL_TEMP_MEAS_PERIOD. With the sleep timer on the RCO (LSI), its
+ * periodic calibration is slowed to CFG_LL_RCO_CLBR_INTERVAL_IDLE, and a recalibration is requested when the
+ * temperature drifted by CFG_LL_RCO_CLBR_TEMP_DRIFT since the last one, while no radio event runs (or at the latest
+ * after CFG_LL_RCO_CLBR_DEFER_MAX busy measurements). Statistics with the RCOSTATS command.
+ */
+#define USE_TEMPERATURE_BASED_RADIO_CALIBRATION   (1)
+#define CFG_LL_TEMP_MEAS_PERIOD             (10000u)  /* ms */
+#define CFG_LL_RCO_CLBR_TEMP_DRIFT          (5)       /* Celsius degrees */
+#define CFG_LL_RCO_CLBR_DEFER_MAX           (6u)
+#define CFG_LL_RCO_CLBR_DURATION            (8u)      /* Sleep clock cycles */
+#define CFG_LL_RCO_CLBR_INTERVAL_IDLE       (3600000u)  /* Periodicity of the calibration events, link layer unit */
+#define CFG_LL_RCO_CLBR_INTERVAL_DRIFT      (1000u)     /* Periodicity until the requested calibration is done */
+
+/**
+ * When CFG_ADCCTRL_DMA_SUPPORTED is set to 1, ADCCTRL_SubmitBatch() converts CFG_ADCCTRL_BATCH_SAMPLES samples of a
+ * handle, each one oversampled by the ADC (CFG_ADCCTRL_BATCH_OVS_RATIO, CFG_ADCCTRL_BATCH_OVS_SHIFT), through the
+ * GPDMA1 channel CFG_ADCCTRL_DMA_CHANNEL, and gives their average to a callback from the DMA interrupt. The batches
+ * queued while the ADC is busy run in the same activation : the temperature of the link layer (measured without
+ * blocking the sequencer) and the supply voltage of the application (every CFG_APP_SUPPLY_PERIOD, VDDSTATS command).
+ * The channel must differ from the CRC one (CRCCTRL_DMA_CHANNEL) and from the AES ones.
+ */
+#define CFG_ADCCTRL_DMA_SUPPORTED           (0)
+#define CFG_ADCCTRL_DMA_CHANNEL             LL_DMA_CHANNEL_5
+#define CFG_ADCCTRL_DMA_IRQn                GPDMA1_Channel5_IRQn
+#define CFG_ADCCTRL_BATCH_SAMPLES           (8u)
+#define CFG_ADCCTRL_BATCH_OVS_RATIO         LL_ADC_OVS_RATIO_4
+#define CFG_ADCCTRL_BATCH_OVS_SHIFT         LL_ADC_OVS_SHIFT_RIGHT_2
+#define CFG_APP_SUPPLY_PERIOD               (60000u)  /* ms */
+#define ADC_DMA_INTR_PRIO                   (6)       /* End of the ADC batches */
 
 /* Sequencer defines */
-#define TASK_HW_RNG                         ( 1u << CFG_TASK_HW_RNG )
-#define TASK_LINK_LAYER                     ( 1u << CFG_TASK_LINK_LAYER )
-#define TASK_MAC_LAYER                      ( 1u << CFG_TASK_MAC_LAYER )
-#define TASK_ZIGBEE_LAYER                   ( 1u << CFG_TASK_ZIGBEE_LAYER )
-#define TASK_ZIGBEE_NETWORK_FORM            ( 1u << CFG_TASK_ZIGBEE_NETWORK_FORM )
-#define TASK_ZIGBEE_APP_START               ( 1u << CFG_TASK_ZIGBEE_APP_START )
-#define TASK_ZIGBEE_APP1                    ( 1u << CFG_TASK_ZIGBEE_APP1 )
-#define TASK_ZIGBEE_APP2                    ( 1u << CFG_TASK_ZIGBEE_APP2 )
-#define TASK_ZIGBEE_APP3                    ( 1u << CFG_TASK_ZIGBEE_APP3 )
-#define TASK_ZIGBEE_APP4                    ( 1u << CFG_TASK_ZIGBEE_APP3 )
+#define TASK_HW_RNG                         UTIL_SEQ_TASK_BM( CFG_TASK_HW_RNG )
+#define TASK_LINK_LAYER                     UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER )
+#define TASK_MAC_LAYER                      UTIL_SEQ_TASK_BM( CFG_TASK_MAC_LAYER )
+#define TASK_ZIGBEE_LAYER                   UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_LAYER )
+#define TASK_ZIGBEE_NETWORK_FORM            UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM )
+#define TASK_ZIGBEE_APP_START               UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_APP_START )
+#define TASK_ZIGBEE_APP1                    UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_APP1 )
+#define TASK_ZIGBEE_APP2                    UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_APP2 )
+#define TASK_ZIGBEE_APP3                    UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_APP3 )
+#define TASK_ZIGBEE_APP4                    UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_APP4 )
 /* USER CODE BEGIN TASK_ID_Define */
-#define TASK_BSP_BUTTON_B1                  ( 1u << CFG_TASK_BSP_BUTTON_B1 )
-#define TASK_BSP_BUTTON_B2                  ( 1u << CFG_TASK_BSP_BUTTON_B2 )
-#define TASK_BSP_BUTTON_B3                  ( 1u << CFG_TASK_BSP_BUTTON_B3 )
+#define TASK_BSP_BUTTON_B1                  UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B1 )
+#define TASK_BSP_BUTTON_B2                  UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B2 )
+#define TASK_BSP_BUTTON_B3                  UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B3 )
+#define TASK_FLASH_MANAGER                  UTIL_SEQ_TASK_BM( CFG_TASK_FLASH_MANAGER )
+#define TASK_ZIGBEE_PERSISTENCE             UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSISTENCE )
+#define TASK_ZIGBEE_INSTALL_CODE            UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_INSTALL_CODE )
+#define TASK_ZIGBEE_JOIN_ADMISSION          UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_JOIN_ADMISSION )
+#define TASK_ZIGBEE_FANOUT                  UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_FANOUT )
+#define TASK_ZIGBEE_TRAFFIC                 UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TRAFFIC )
+#define TASK_ZIGBEE_HEALTH                  UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_HEALTH )
+#define TASK_ZIGBEE_BROADCAST               UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_BROADCAST )
+#define TASK_ZIGBEE_CONCENTRATOR            UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CONCENTRATOR )
+#define TASK_ZIGBEE_REPORT                  UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_REPORT )
+#define TASK_ZIGBEE_OTA                     UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA )
+#define TASK_ZIGBEE_POLL                    UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_POLL )
+#define TASK_ZIGBEE_TX_POWER                UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TX_POWER )
+#define TASK_ZIGBEE_CHANNEL                 UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CHANNEL )
+#define TASK_TEMP_MEAS                      UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS )
+#define TASK_HW_PKA                         UTIL_SEQ_TASK_BM( CFG_TASK_HW_PKA )
+
+/* Tasks of the radio priority class (CFG_SEQ_PRIO_RADIO) */
+#define CFG_SEQ_RADIO_TASKS                 ( TASK_HW_RNG | TASK_LINK_LAYER | TASK_MAC_LAYER | TASK_TEMP_MEAS )
 
 /* USER CODE END TASK_ID_Define */
 
@@ -286,12 +792,80 @@ typedef enum
 #define CFG_RT_DEBUG_GPIO_MODULE            (0)
 #define CFG_RT_DEBUG_DTB                    (0)
 
+/**
+ * When CFG_RT_DEBUG_RUN_BUS is set to 1 (with CFG_RT_DEBUG_GPIO_MODULE), the code running is written on the 6 pins of
+ * the run bus (GPIO_DEBUG_RUN_BUS_PORT in debug_config.h), to be read as a bus by a logic analyzer : 0 to 31 for the
+ * sequencer task of this ID, 32 to 62 for the timer callbacks numbered in the order of their first expiry (listed by
+ * the 'RUNBUS' command), 63 when no task nor callback runs (idle and low power).
+ */
+#define CFG_RT_DEBUG_RUN_BUS                (0)
+
+#if (CFG_RT_DEBUG_RUN_BUS != 0) && (CFG_RT_DEBUG_GPIO_MODULE == 0)
+#error "CFG_RT_DEBUG_RUN_BUS needs CFG_RT_DEBUG_GPIO_MODULE"
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) && (CFG_RT_DEBUG_GPIO_MODULE == 0) */
+
+/**
+ * When CFG_RT_DEBUG_ITM is set to 1, the RT_DEBUG signals (set, reset, toggle) are written as ITM packets time stamped
+ * by the hardware, without any GPIO : system signals on the stimulus port 1, link layer signals on the port 2,
+ * application signals on the port 3, and the running task or timer callback on the port 4. The SWO output and the
+ * ports (to select the domains) are configured by the debugger, the timeline is rendered by itm_timeline.py.
+ */
+#define CFG_RT_DEBUG_ITM                    (0)
+
+#if (CFG_RT_DEBUG_ITM != 0) && (CFG_RT_DEBUG_RUN_BUS != 0)
+#error "CFG_RT_DEBUG_ITM and CFG_RT_DEBUG_RUN_BUS both trace the running task, select one"
+#endif /* (CFG_RT_DEBUG_ITM != 0) && (CFG_RT_DEBUG_RUN_BUS != 0) */
+
+/**
+ * When CFG_LST_DEBUG_SUPPORTED is set to 1, the counted lists (tListCounted of stm_list.h) check the links around each
+ * node inserted or removed : a broken link is counted in the errors of the list, instead of being followed.
+ */
+#define CFG_LST_DEBUG_SUPPORTED             (0)
+
 /******************************************************************************
  * System Clock Manager module configuration
  ******************************************************************************/
 
 #define CFG_SCM_SUPPORTED                   (1)
 
+/**
+ * When CFG_SCM_GOVERNOR_SUPPORTED is set to 1, the application clock request (SCM_USER_APP) follows the load instead
+ * of staying at HSE 32 MHz. Every CFG_SCM_GOVERNOR_PERIOD ms, the execution time of the sequencer tasks (profiling
+ * statistics, CFG_SEQ_PROFILING_SUPPORTED) is compared to the elapsed time at the current clock : above
+ * CFG_SCM_GOVERNOR_UP_LOAD (per mille) the request steps up ( HSE 16 MHz, HSE 32 MHz, PLL ), below
+ * CFG_SCM_GOVERNOR_DOWN_LOAD it steps down. The PLL (96 MHz) is requested at once while a burst requester of
+ * CFG_SCM_Boost_Id_t is set. HSE 16 MHz runs in VOS range 2, and the radio keeps its own HSE 32 MHz request while
+ * active. The time at each request and the switch latencies are displayed with the 'CLKSTATS' command.
+ */
+#define CFG_SCM_GOVERNOR_SUPPORTED          (0)
+#define CFG_SCM_GOVERNOR_PERIOD             (100u)    /* ms */
+#define CFG_SCM_GOVERNOR_UP_LOAD            (600u)    /* per mille */
+#define CFG_SCM_GOVERNOR_DOWN_LOAD          (200u)    /* per mille */
+
+/* Requesters of the PLL for a burst of processing - up to 32 */
+typedef enum
+{
+  CFG_SCM_BOOST_OTA,                /* OTA download and Integrity Code hash */
+  CFG_SCM_BOOST_INSTALL_CODE,       /* Derivation of the queued install code link keys */
+} CFG_SCM_Boost_Id_t;
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0) && ((CFG_SCM_SUPPORTED == 0) || (CFG_SEQ_PROFILING_SUPPORTED == 0))
+#error "CFG_SCM_GOVERNOR_SUPPORTED needs CFG_SCM_SUPPORTED and CFG_SEQ_PROFILING_SUPPORTED"
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) && ((CFG_SCM_SUPPORTED == 0) || (CFG_SEQ_PROFILING_SUPPORTED == 0)) */
+
+/**
+ * When CFG_SCM_HSE_TUNE_SUPPORTED is set to 1, the HSE start-up time (enable to HSERDY) is measured at each exit of
+ * the low power modes. Once CFG_SCM_HSE_TUNE_SAMPLES start-ups are measured, the stabilization delay after HSERDY
+ * (SCM_HSE_STABILIZATION_TIME_DEFAULT, 200 us) becomes CFG_SCM_HSE_TUNE_RATIO percent of the slowest start-up seen on
+ * this device plus CFG_SCM_HSE_TUNE_MARGIN us, never above the default delay. The slowest start-up is saved by the
+ * Flash Manager in the page CFG_SCM_HSE_TUNE_SECTOR_ID each time it grows, so that the delay applies from the boot.
+ * The measurements are displayed with the 'HSESTATS' command.
+ */
+#define CFG_SCM_HSE_TUNE_SUPPORTED          (0)
+#define CFG_SCM_HSE_TUNE_SAMPLES            (64u)
+#define CFG_SCM_HSE_TUNE_RATIO              (50u)     /* percent */
+#define CFG_SCM_HSE_TUNE_MARGIN             (20u)     /* us */
+
 /******************************************************************************
  * HW RADIO configuration
  ******************************************************************************/
@@ -325,9 +899,120 @@ typedef enum
 #define CFG_HW_RNG_POOL_SIZE                (32)
 
 /* USER CODE BEGIN HW_RNG_Configuration */
+/* Pool level (in 32-bit words) at or below which the pool is refilled in background, ahead of the next requests */
+#define CFG_HW_RNG_POOL_THRESHOLD           (16)
 
 /* USER CODE END HW_RNG_Configuration */
 
+/******************************************************************************
+ * HW_AES configuration
+ ******************************************************************************/
+/* USER CODE BEGIN HW_AES_Configuration */
+/* When CFG_HW_AES_DMA_SUPPORTED is set to 1, HW_AES_CryptBlocksDma() streams the blocks through the AES by two GPDMA1
+ * channels (CFG_HW_AES_DMA_IN_CHANNEL, CFG_HW_AES_DMA_OUT_CHANNEL), with a callback at the end of the transfer */
+#define CFG_HW_AES_DMA_SUPPORTED            (1)
+#define CFG_HW_AES_DMA_IN_CHANNEL           LL_DMA_CHANNEL_2
+#define CFG_HW_AES_DMA_OUT_CHANNEL          LL_DMA_CHANNEL_3
+#define CFG_HW_AES_DMA_OUT_IRQn             GPDMA1_Channel3_IRQn
+#define AES_DMA_INTR_PRIO                   (6)           /* End of the AES DMA transfers */
+
+/* When CFG_BAES_SW_FALLBACK is set to 1, the BasicAES ECB, CMAC and AES-MMO functions run on the AES S/W implementation
+ * when the AES is in use by another owner (a DMA transfer for instance) instead of taking it over.
+ * CFG_BAES_SW_OPERATIONS is the mask of the operations always run in S/W (BAES_OP_ECB, BAES_OP_CMAC, BAES_OP_MMO):
+ * the AES H/W is the fastest for every operation on the CRYPTOBENCH results, so none by default */
+#define CFG_BAES_SW_FALLBACK                (1)
+#define CFG_BAES_SW_OPERATIONS              (0)
+
+/* USER CODE END HW_AES_Configuration */
+
+/******************************************************************************
+ * HW_PKA configuration
+ ******************************************************************************/
+/* USER CODE BEGIN HW_PKA_Configuration */
+/* When CFG_HW_PKA_ASYNC_SUPPORTED is set to 1, HW_PKA_Submit() queues the PKA jobs (HW_PKA_P256_EccScalarMulAsync...)
+ * and runs them one at a time on the PKA interrupt, with a callback from the sequencer at the end of each job */
+#define CFG_HW_PKA_ASYNC_SUPPORTED          (1)
+#define PKA_INTR_PRIO                       (6)           /* End of the PKA processing */
+
+#if ( CFG_BLE_HOST_SUPPORTED != 0 ) && ( CFG_HW_PKA_ASYNC_SUPPORTED == 0 )
+#error "CFG_BLE_HOST_SUPPORTED requires CFG_HW_PKA_ASYNC_SUPPORTED (P-256 keys of the BLE host)."
+#endif /* ( CFG_BLE_HOST_SUPPORTED != 0 ) && ( CFG_HW_PKA_ASYNC_SUPPORTED == 0 ) */
+
+/* USER CODE END HW_PKA_Configuration */
+
+/******************************************************************************
+ * Crypto micro-benchmarks
+ ******************************************************************************/
+/**
+ * When CFG_CRYPTO_BENCH_SUPPORTED is set to 1, the CRYPTOBENCH serial command times the HW_AES, BasicAES and PKA P-256
+ * operations in DWT cycles (CFG_CRYPTO_BENCH_ITERATIONS runs of each, CFG_CRYPTO_BENCH_PKA_ITERATIONS for the PKA)
+ * and prints the results in CSV. One iteration is done per run of its Task.
+ */
+#define CFG_CRYPTO_BENCH_SUPPORTED          (1)
+#define CFG_CRYPTO_BENCH_ITERATIONS         (16u)
+#define CFG_CRYPTO_BENCH_PKA_ITERATIONS     (4u)
+
+/******************************************************************************
+ * Persistence benchmark
+ ******************************************************************************/
+/**
+ * When CFG_NVM_BENCH_SUPPORTED is set to 1 (test build), the
+ * NVMBENCH serial command replays the flash patterns of the Zigbee persistence ( SNVMA bank rewrite, SNVML record
+ * append and compaction, NWK frame counter record ) with the Flash Manager in two scratch pages, and prints in CSV
+ * the commit latency percentiles, the wait for the radio windows, the erases per hour and the flash lifetime projected
+ * from CFG_NVM_BENCH_ENDURANCE erase cycles per page. At most CFG_NVM_BENCH_COMMIT_MAX commits are timed per run.
+ */
+#define CFG_NVM_BENCH_SUPPORTED             (0)
+#define CFG_NVM_BENCH_COMMIT_MAX            (256u)
+#define CFG_NVM_BENCH_ENDURANCE             (10000u)  /* Erase cycles per flash page */
+
+/******************************************************************************
+ * Utilities micro-benchmarks
+ ******************************************************************************/
+/**
+ * When CFG_UTIL_BENCH_SUPPORTED is set to 1 (test build), the UTILBENCH serial command times in DWT cycles the timer
+ * server ( start, stop and expiry of a timer with 0 up to CFG_UTIL_BENCH_TIMER_NBR more timers running ) and the AMM
+ * ( CFG_UTIL_BENCH_TRACE_LOOPS replays of a Zigbee allocation trace in the Zigbee heap, with the fragmentation of the
+ * pool after each one ), CFG_UTIL_BENCH_ITERATIONS runs per timer case, and prints the results in CSV. No Task : the
+ * benchmarks run in the command, the interrupts masked a few ms for each timer expiry.
+ */
+#define CFG_UTIL_BENCH_SUPPORTED            (0)
+#define CFG_UTIL_BENCH_ITERATIONS           (16u)
+#define CFG_UTIL_BENCH_TIMER_NBR            (8u)
+#define CFG_UTIL_BENCH_TRACE_LOOPS          (8u)
+
+/******************************************************************************
+ * Zigbee stack variant benchmark
+ ******************************************************************************/
+/**
+ * When CFG_ZIGBEE_BENCH_SUPPORTED is set to 1, the STACKBENCH serial command prints in CSV the figures compared between
+ * the stack variants (Debug R23, Debug_R22 and Debug_R22_SE builds) : time of the last Startup, Toggle latency of the
+ * first destination, APS throughput of the last run of the traffic generator and peak of the Zigbee heap.
+ * STM32CubeIDE/stack_bench.py merges them with the memory report of each build in one table.
+ */
+#define CFG_ZIGBEE_BENCH_SUPPORTED          (1)
+
+/******************************************************************************
+ * Host control protocol
+ ******************************************************************************/
+/**
+ * When CFG_HOST_PROTOCOL_SUPPORTED is set to 1 (test build), the
+ * log UART also carries binary frames for the automation host : 0xA5, length, type, sequence, data, CRC-16. They are
+ * received by the circular DMA of the log UART (CFG_LOG_RX_DMA_SUPPORTED), and queued (at most CFG_HOST_RX_FRAMES of
+ * CFG_HOST_FRAME_MAX bytes) for the Task running ZCL sends, NIB get/set, statistics and persistence requests. The
+ * other bytes still go to the serial command interpreter. At most CFG_HOST_ZCL_INFLIGHT ZCL sends wait for their
+ * response, which is sent as an event. The ZCL sends longer than CFG_HOST_ZCL_FRAG_SIZE bytes are APS fragmented.
+ */
+#define CFG_HOST_PROTOCOL_SUPPORTED         (0)
+#define CFG_HOST_RX_FRAMES                  (8u)        /* Power of 2 */
+#define CFG_HOST_FRAME_MAX                  (96u)       /* Type, sequence and data */
+#define CFG_HOST_ZCL_INFLIGHT               (8u)
+#define CFG_HOST_ZCL_FRAG_SIZE              (64u)
+
+#if (CFG_HOST_PROTOCOL_SUPPORTED != 0) && (CFG_LOG_RX_DMA_SUPPORTED == 0)
+#error "CFG_HOST_PROTOCOL_SUPPORTED needs the DMA reception of the log UART, enable CFG_LOG_RX_DMA_SUPPORTED"
+#endif /* (CFG_HOST_PROTOCOL_SUPPORTED != 0) && (CFG_LOG_RX_DMA_SUPPORTED == 0) */
+
 /******************************************************************************
  * MEMORY MANAGER
  ******************************************************************************/
@@ -342,9 +1027,759 @@ typedef enum
                                                           + (AMM_VIRTUAL_INFO_ELEMENT_SIZE * CFG_AMM_VIRTUAL_MEMORY_NUMBER) )
 
 /* USER CODE BEGIN MEMORY_MANAGER_Configuration */
+/**
+ * When CFG_ZIGBEE_SLAB_SUPPORTED is set to 1, the small Zigbee stack allocations are served in O(1)
+ * from fixed-size blocks pools (16, 32, 64 and 128 bytes), the others still come from the AMM.
+ * Number of blocks per pool shall be adjusted according to the application profile.
+ */
+#define CFG_ZIGBEE_SLAB_SUPPORTED                         (1)
+#define CFG_ZIGBEE_SLAB_16_NBR                            (32U)
+#define CFG_ZIGBEE_SLAB_32_NBR                            (24U)
+#define CFG_ZIGBEE_SLAB_64_NBR                            (16U)
+#define CFG_ZIGBEE_SLAB_128_NBR                           (8U)
+
+/**
+ * When CFG_AMM_BMM_TLSF_SUPPORTED is set to 1, the AMM pool is managed by the Two-Level Segregated Fit
+ * allocator (stm32_tlsf.c, bounded allocation and release time) instead of stm32_mm.c (first fit).
+ */
+#define CFG_AMM_BMM_TLSF_SUPPORTED                        (0)
+
+/**
+ * When the free shared AMM pool goes below CFG_AMM_LOW_WATERMARK_SIZE, the Zigbee heap refuses the
+ * allocations checked by the stack that the pools can not serve, until the pool goes back above.
+ * Set to 0 to disable.
+ */
+#define CFG_AMM_LOW_WATERMARK_SIZE                        (500U)    /* words (32 bits) */
+
+/**
+ * When CFG_AMM_REBALANCE_SUPPORTED is set to 1, CFG_AMM_REBALANCE_DELAY after the application start (the end of
+ * the boot allocations), the ZIGBEE_INIT reservation is shrunk to its occupation plus CFG_AMM_REBALANCE_INIT_MARGIN,
+ * and CFG_AMM_REBALANCE_HEAP_SHARE % of the released memory is added to the ZIGBEE_HEAP reservation, without going
+ * above CFG_AMM_REBALANCE_HEAP_MAX_SIZE. The rest goes to the shared pool. The AMMREBALANCE command does it again
+ * (the reservations are only shrunk and grown in this direction), AMMSTATS prints the reservations.
+ */
+#define CFG_AMM_REBALANCE_SUPPORTED                       (1)
+#define CFG_AMM_REBALANCE_DELAY                           (30000U)  /* ms */
+#define CFG_AMM_REBALANCE_INIT_MARGIN                     (256U)    /* words (32 bits) */
+#define CFG_AMM_REBALANCE_HEAP_SHARE                      (50U)     /* % */
+#define CFG_AMM_REBALANCE_HEAP_MAX_SIZE                   (8000U)   /* words (32 bits) */
+
+/**
+ * When CFG_SRAM_SCRATCH_SUPPORTED is set to 1, the buffers taken with APPE_MEM_Alloc() with the APPE_MEM_SCRATCH
+ * lifetime come from a pool of CFG_SRAM_SCRATCH_POOL_SIZE bytes in the SRAM1 pages 5 to 7 (.ram_scratch section),
+ * which are not retained in Standby : only the SRAM1 pages 1 to 4 (data, bss, AMM pool with the Zigbee stack state,
+ * and stack) are. SRAM2, where nothing is linked, is not retained either. Standby is not used while a scratch buffer
+ * is allocated. The APPE_MEM_PERSISTENT buffers, and the scratch ones when the pool is full, come from the AMM pool.
+ */
+#define CFG_SRAM_SCRATCH_SUPPORTED                        (1)
+#define CFG_SRAM_SCRATCH_POOL_SIZE                        (16384U)  /* bytes */
+
+/**
+ * When CFG_HEAP_DIAG_SUPPORTED is set to 1, the HEAPSTATS command walks the AMM pool and dumps the
+ * fragmentation of the free blocks and the occupation of each virtual memory.
+ */
+#define CFG_HEAP_DIAG_SUPPORTED                           (1)
+
+/**
+ * When CFG_ZIGBEE_HEAP_TRACE_SUPPORTED is set to 1, the last CFG_ZIGBEE_HEAP_TRACE_NBR zb_heap_alloc()
+ * and zb_heap_free() calls (address, size, caller, time) are stored in RAM, the HEAPTRACE command dumps
+ * the buffers not freed yet. Needs the linker flags -Wl,--wrap=zb_heap_alloc,--wrap=zb_heap_free.
+ */
+#define CFG_ZIGBEE_HEAP_TRACE_SUPPORTED                   (0)
+#define CFG_ZIGBEE_HEAP_TRACE_NBR                         (128U)
+
+/**
+ * When CFG_ZIGBEE_HEAP_RECORD_SUPPORTED is set to 1 (with the host protocol), between the HEAPRECSTART and
+ * HEAPRECSTOP commands each allocation and release of the Zigbee heaps (ZIGBEE_PLAT_ZbHeapMalloc/Free,
+ * ZIGBEE_PLAT_HeapMalloc/Free : time in us, address, size, heap) is streamed to the host, in APP_HOST_EVENT_HEAP_TRACE
+ * events of CFG_ZIGBEE_HEAP_RECORD_BATCH records. heap_replay.py replays the traces on the allocators (host build).
+ */
+#define CFG_ZIGBEE_HEAP_RECORD_SUPPORTED                  (0)
+#define CFG_ZIGBEE_HEAP_RECORD_BATCH                      (16U)     /* Records of 12 bytes per event, 21 at most */
+
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) && (CFG_HOST_PROTOCOL_SUPPORTED == 0)
+#error "CFG_ZIGBEE_HEAP_RECORD_SUPPORTED streams the records with the host protocol, enable CFG_HOST_PROTOCOL_SUPPORTED"
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) && (CFG_HOST_PROTOCOL_SUPPORTED == 0) */
+
+/**
+ * When CFG_ZIGBEE_INIT_ARENA_SUPPORTED is set to 1, the ZIGBEE_INIT allocations (done once at ZbInit)
+ * are carved linearly, without header, from one block of CFG_ZIGBEE_INIT_ARENA_SIZE words taken in
+ * the ZIGBEE_INIT virtual memory. Once a block of the arena is released out of order, the next
+ * allocations go to the AMM until all the arena blocks are released.
+ * CFG_ZIGBEE_INIT_ARENA_SIZE shall be lower than CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT_BUFFER_SIZE.
+ */
+#define CFG_ZIGBEE_INIT_ARENA_SUPPORTED                   (0)
+#define CFG_ZIGBEE_INIT_ARENA_SIZE                        (9000U)   /* words (32 bits) */
 
 /* USER CODE END MEMORY_MANAGER_Configuration */
 
+/******************************************************************************
+ * NVM configuration
+ ******************************************************************************/
+/**
+ * When CFG_ZIGBEE_PERSISTENCE_SUPPORTED is set to 1, the Zigbee stack persistence data (ZbPersistGet) is
+ * saved in flash through the Simple NVM Arbiter, and restored at boot with ZbStartupPersist: the device
+ * comes back onto its network without scan and without a new secure join.
+ * CFG_ZIGBEE_PERSISTENCE_BUFFER_SIZE shall hold the ZbPersistGet data plus its 8 bytes header, and fit in
+ * one SNVMA bank (one flash page).
+ * The stack notifications are debounced: the data is saved CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY after the
+ * last notification, or at most CFG_ZIGBEE_PERSISTENCE_MAX_DELAY after the first one, and only when it
+ * differs from the last saved data.
+ */
+#define CFG_ZIGBEE_PERSISTENCE_SUPPORTED                  (1)
+#define CFG_ZIGBEE_PERSISTENCE_BUFFER_SIZE                (1024U)   /* words (32 bits) */
+#define CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY             (2000U)   /* ms */
+#define CFG_ZIGBEE_PERSISTENCE_MAX_DELAY                  (30000U)  /* ms */
+
+/**
+ * When CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED is set to 1, the persistence image is saved by the Simple NVM Log in
+ * the two pages of the Simple NVM Arbiter banks : the image is cut in records of SNVML_RECORD_SIZE bytes
+ * (simple_nvm_log_conf.h) and a save only appends the records that have changed, then a commit record. A page is
+ * erased only when the other one is full and the records of the image are compacted in it, instead of an erase and
+ * a full bank write at each save. The statistics of the log are displayed with NVMSTATS.
+ * The format differs from the SNVMA banks : the data saved by the other format is not restored once.
+ */
+#define CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED              (1)
+
+/**
+ * When CFG_ZIGBEE_PERSIST_BATCH_SUPPORTED is set to 1, the changes of the persistable attributes of the application
+ * clusters (OnOff, CurrentLevel, color at the end of a transition, values written by a controller in the
+ * attribute store) are collected in one batch of at most CFG_ZIGBEE_PERSIST_BATCH_ATTR_NB attributes, an attribute
+ * changed again being kept once, instead of a persistence request each. The batch is flushed
+ * CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY after the last change, at most CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY after the
+ * first one, or at once when full; the stack notifications received while it is open are merged in it. The flush gives
+ * the attributes to the stack (ZbZclAttrPersist) then saves the persistence image once : only its changed records
+ * with the Simple NVM Log. Statistics printed with PERSISTBATCH.
+ */
+#define CFG_ZIGBEE_PERSIST_BATCH_SUPPORTED                ( CFG_ZIGBEE_PERSISTENCE_SUPPORTED )
+#define CFG_ZIGBEE_PERSIST_BATCH_ATTR_NB                  (16U)
+#define CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY              (1000U)   /* ms */
+#define CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY                (10000U)  /* ms */
+
+#if ( CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY < CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY )
+#error "CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY shall not be shorter than CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY."
+#endif /* ( CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY < CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY ) */
+
+/* Simple NVM Arbiter start address : the last CFG_SNVMA_SECTOR_NB flash pages ( NVM region of the linker file ). They
+ * shall hold the SNVMA_NUMBER_OF_SECTOR_NEEDED of simple_nvm_arbiter_conf.h : 7 with SNVMA_NVM_LAYOUT_HOT_WARM_COLD. */
+#define CFG_SNVMA_SECTOR_NB                               (2u)
+#define CFG_SNVMA_START_SECTOR_ID                         ( ( FLASH_SIZE / FLASH_PAGE_SIZE ) - CFG_SNVMA_SECTOR_NB )
+#define CFG_SNVMA_START_ADDRESS                           ( FLASH_BASE + ( FLASH_PAGE_SIZE * ( CFG_SNVMA_START_SECTOR_ID ) ) )
+
+/* SNVMA_Init trusts the newest bank sealed by its summary from its header : its CRC is checked afterwards by the
+ * Task CFG_TASK_SNVMA_CHECK. The writes merged by the SNVMA coalescing window are started by CFG_TASK_SNVMA_FLUSH. */
+
+/**
+ * When CFG_ZIGBEE_COUNTER_LOG_SUPPORTED is set to 1, the outgoing NWK frame counter is saved apart from the persistence
+ * data, in an append-only log of 16-byte records written by the Flash Manager in two alternate flash pages. Each record
+ * reserves CFG_ZIGBEE_COUNTER_LOG_STRIDE frame counters : a new record is written when the counter, read every
+ * CFG_ZIGBEE_COUNTER_LOG_PERIOD, comes within half a stride of the last reservation, and at each Startup the counter
+ * skips ahead to the last reservation. A page is erased once every ( FLASH_PAGE_SIZE / 16 ) records.
+ */
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+#define CFG_ZIGBEE_COUNTER_LOG_SUPPORTED                  (1)
+#else /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+#define CFG_ZIGBEE_COUNTER_LOG_SUPPORTED                  (0)
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+#define CFG_ZIGBEE_COUNTER_LOG_STRIDE                     (1024U)
+#define CFG_ZIGBEE_COUNTER_LOG_PERIOD                     (1000U)   /* ms */
+
+/* Frame counter log : the two flash pages below the Simple NVM Arbiter ( NVM region of the linker file ) */
+#define CFG_ZIGBEE_COUNTER_LOG_SECTOR_ID                  ( CFG_SNVMA_START_SECTOR_ID - 2u )
+#define CFG_ZIGBEE_COUNTER_LOG_ADDRESS                    ( FLASH_BASE + ( FLASH_PAGE_SIZE * ( CFG_ZIGBEE_COUNTER_LOG_SECTOR_ID ) ) )
+
+/**
+ * When CFG_CRASH_LOG_SUPPORTED is set to 1, the last CFG_CRASH_LOG_RECORD_NB logs are captured as binary frames in a
+ * RAM ring kept across the resets ( .noinit section ). On a fatal error ( Zigbee error, Error_Handler, HardFault ),
+ * the error and the profiling counters are added to the ring. At the next boot after a fatal error or a watchdog
+ * reset, the whole capture is written by the Flash Manager in a circular log of two flash pages, then printed by the
+ * CRASHLOG serial command ( log_decode.py renders the frames with the ELF file of the crashed firmware ).
+ * With CFG_FRAME_LOG_SUPPORTED, the frame log is added to the entry ( one entry per flash page with 64 frames ).
+ * When CFG_CRASH_LOG_RESET_ON_FATAL is set to 1, the fatal error resets the device instead of waiting forever.
+ */
+#define CFG_CRASH_LOG_SUPPORTED                           ( CFG_ZIGBEE_PERSISTENCE_SUPPORTED )
+#define CFG_CRASH_LOG_RECORD_NB                           (32U)
+#define CFG_CRASH_LOG_RESET_ON_FATAL                      (0)
+
+/* Crash log : the two flash pages below the frame counter log */
+#define CFG_CRASH_LOG_SECTOR_ID                           ( CFG_ZIGBEE_COUNTER_LOG_SECTOR_ID - 2u )
+#define CFG_CRASH_LOG_ADDRESS                             ( FLASH_BASE + ( FLASH_PAGE_SIZE * ( CFG_CRASH_LOG_SECTOR_ID ) ) )
+
+/* HSE start-up record : the flash page below the crash log */
+#define CFG_SCM_HSE_TUNE_SECTOR_ID                        ( CFG_CRASH_LOG_SECTOR_ID - 1u )
+#define CFG_SCM_HSE_TUNE_ADDRESS                          ( FLASH_BASE + ( FLASH_PAGE_SIZE * ( CFG_SCM_HSE_TUNE_SECTOR_ID ) ) )
+
+#if (CFG_SCM_HSE_TUNE_SUPPORTED != 0) && ((CFG_SCM_SUPPORTED == 0) || (CFG_ZIGBEE_PERSISTENCE_SUPPORTED == 0))
+#error "CFG_SCM_HSE_TUNE_SUPPORTED needs CFG_SCM_SUPPORTED and the Flash Manager of CFG_ZIGBEE_PERSISTENCE_SUPPORTED"
+#endif /* (CFG_SCM_HSE_TUNE_SUPPORTED != 0) && ((CFG_SCM_SUPPORTED == 0) || (CFG_ZIGBEE_PERSISTENCE_SUPPORTED == 0)) */
+
+/* Persistence benchmark : the two flash pages below the HSE start-up record, taken from the OTA download area */
+#define CFG_NVM_BENCH_SECTOR_ID                           ( CFG_SCM_HSE_TUNE_SECTOR_ID - 2u )
+#define CFG_NVM_BENCH_ADDRESS                             ( FLASH_BASE + ( FLASH_PAGE_SIZE * ( CFG_NVM_BENCH_SECTOR_ID ) ) )
+
+/******************************************************************************
+ * Zigbee commissioning
+ ******************************************************************************/
+/**
+ * When CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED is set to 1, a table of EUI64/install code pairs can be queued
+ * at once (APP_ZIGBEE_AddDevicesWithInstallCode or the ICADD serial command). The link keys are derived and
+ * added in background, then a single Permit Join window is opened (ICJOIN serial command).
+ * CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE is the number of pairs waiting for their link key at the same time.
+ */
+#define CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED           (1)
+#define CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE                (32U)
+
+/**
+ * When CFG_ZIGBEE_TC_KEY_INDEX_SUPPORTED is set to 1 and this device forms the network, the device key pair set of
+ * the Trust Center is indexed by a hash of the EUI64 in CFG_ZIGBEE_TC_KEY_INDEX_SIZE slots (power of 2, about twice
+ * the number of devices) : the key of a device is read at its slot instead of a walk of the table. The index is
+ * updated by the keys added from an install code and by the key exchanges with the devices. TCKEYSTATS prints it.
+ */
+#define CFG_ZIGBEE_TC_KEY_INDEX_SUPPORTED                 (1)
+#define CFG_ZIGBEE_TC_KEY_INDEX_SIZE                      (512U)
+
+/**
+ * When CFG_ZIGBEE_HASHED_TCLK_SUPPORTED is set to 1 and this device forms the network, the TC link key requests are
+ * answered with a key derived from the EUI64 of the device and a secret of the network (itself derived from
+ * CFG_ZIGBEE_HASHED_TCLK_SECRET, to be set per product, and the EUI64 of the Trust Center). Only the last
+ * CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE keys used are kept in the device key table : the key of a device evicted is
+ * derived again at its Trust Center rejoin. To be chosen before the network is formed, as the keys issued before
+ * are not derived. HASHKEYSTATS prints the state.
+ */
+#define CFG_ZIGBEE_HASHED_TCLK_SUPPORTED                  (0)
+#define CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE                 (16U)
+#define CFG_ZIGBEE_HASHED_TCLK_SECRET                     { 0x53, 0x54, 0x4D, 0x33, 0x32, 0x57, 0x42, 0x41, \
+                                                            0x48, 0x61, 0x73, 0x68, 0x54, 0x43, 0x4C, 0x4B }
+
+/**
+ * When CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED is set to 1, the Joins on this device are paced : once
+ * CFG_ZIGBEE_JOIN_ADMISSION_MAX Devices have joined within a CFG_ZIGBEE_JOIN_ADMISSION_WINDOW window, the
+ * local Permit Join is closed until the end of the window, then opened again for its remaining time.
+ * The Devices refused meanwhile retry their association later. The counters are displayed with JOINSTATS.
+ */
+#define CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED               (1)
+#define CFG_ZIGBEE_JOIN_ADMISSION_WINDOW                  (1000U)   /* ms */
+#define CFG_ZIGBEE_JOIN_ADMISSION_MAX                     (4U)      /* Joins per window */
+
+/**
+ * When CFG_ZIGBEE_CONCENTRATOR_SUPPORTED is set to 1, a Router can be a Concentrator (CONCENTRATOR ON/OFF serial
+ * command, or stZigbeeAppInfo.bConcentrator) : the Devices send to it with many-to-one routing and it answers with
+ * source routing. Every CFG_ZIGBEE_CONCENTRATOR_PERIOD, the Network size is estimated from the NWK tables and the
+ * source route length, the Many-to-One Route Request radius and period are tuned (up to
+ * CFG_ZIGBEE_CONCENTRATOR_SMALL_NETWORK Devices, the Network is small). The state is displayed with CONCSTATS.
+ */
+#define CFG_ZIGBEE_CONCENTRATOR_SUPPORTED                 (1)
+#define CFG_ZIGBEE_CONCENTRATOR_PERIOD                    (60000U)  /* ms */
+#define CFG_ZIGBEE_CONCENTRATOR_SMALL_NETWORK             (32U)     /* Devices */
+
+/**
+ * When CFG_ZIGBEE_LINK_STATUS_SUPPORTED is set to 1, the Link Status period of the Router follows the stability of the
+ * mesh : every CFG_ZIGBEE_LINK_STATUS_TICK, the Router neighbors (addresses and costs) are compared, and after
+ * CFG_ZIGBEE_LINK_STATUS_STABLE_TICKS ticks without change the period is doubled, up to
+ * CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX. A change (Router neighbor, join of a Router, leave, link failure) restores
+ * CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN. The Router age limit keeps the neighbors aged out after about
+ * CFG_ZIGBEE_LINK_STATUS_AGE_TIME (at least 2 periods). The neighbors with the default settings age this Router out
+ * after 3 x 15 s : CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX stays below, unless all the Routers run this policy.
+ * LINKSTATS prints the state.
+ */
+#define CFG_ZIGBEE_LINK_STATUS_SUPPORTED                  (1)
+#define CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN                 (15U)     /* s */
+#define CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX                 (40U)     /* s */
+#define CFG_ZIGBEE_LINK_STATUS_AGE_TIME                   (45U)     /* s */
+#define CFG_ZIGBEE_LINK_STATUS_TICK                       (60000U)  /* ms */
+#define CFG_ZIGBEE_LINK_STATUS_STABLE_TICKS               (5U)
+
+/******************************************************************************
+ * Zigbee application traffic
+ ******************************************************************************/
+/**
+ * A ZCL command can be sent to a list of at most CFG_ZIGBEE_FANOUT_DEST_MAX destinations (APP_ZIGBEE_FanoutStart).
+ * At most CFG_ZIGBEE_FANOUT_MAX_INFLIGHT requests wait for their confirmation at the same time, and two group or
+ * broadcast requests are spaced by at least CFG_ZIGBEE_FANOUT_BROADCAST_SPACING.
+ */
+#define CFG_ZIGBEE_FANOUT_DEST_MAX                        (32U)
+#define CFG_ZIGBEE_FANOUT_MAX_INFLIGHT                    (4U)
+#define CFG_ZIGBEE_FANOUT_BROADCAST_SPACING               (100U)    /* ms */
+
+/**
+ * When CFG_ZIGBEE_FINDBIND_SUPPORTED is set to 1, SW2 binds the OnOff Client to the matching Servers of the Network
+ * (APP_ZIGBEE_FindBindStart) : the targets found by one broadcast Match_Desc (at most CFG_ZIGBEE_FINDBIND_TARGET_MAX)
+ * are processed as their responses come, with at most CFG_ZIGBEE_FINDBIND_MAX_INFLIGHT IEEE_addr/Simple_Desc requests
+ * waiting for their response at the same time. FINDBINDSTATS prints the last result.
+ */
+#define CFG_ZIGBEE_FINDBIND_SUPPORTED                     (1)
+#define CFG_ZIGBEE_FINDBIND_TARGET_MAX                    (32U)
+#define CFG_ZIGBEE_FINDBIND_MAX_INFLIGHT                  (6U)
+
+/**
+ * When CFG_ZIGBEE_INDIRECT_SUPPORTED is set to 1 (router), the frames held for the sleepy children until they poll are
+ * bounded : the stack queues at most CFG_ZIGBEE_INDIRECT_CHILD_FRAMES frames per sleepy child, for
+ * CFG_ZIGBEE_INDIRECT_PERSISTENCE (0 : stack default). The unicasts of the fan-out to a sleepy child (at most
+ * CFG_ZIGBEE_INDIRECT_CHILDREN_MAX tracked) are admitted within the same limit, the low priority ones within half of
+ * it and not after an expiry of the child during the last CFG_ZIGBEE_INDIRECT_TICK. INDIRECTSTATS prints the state.
+ */
+#define CFG_ZIGBEE_INDIRECT_SUPPORTED                     (1)
+#define CFG_ZIGBEE_INDIRECT_CHILDREN_MAX                  (40U)
+#define CFG_ZIGBEE_INDIRECT_CHILD_FRAMES                  (4U)
+#define CFG_ZIGBEE_INDIRECT_PERSISTENCE                   (0U)      /* nwkTransactionPersistenceTime */
+#define CFG_ZIGBEE_INDIRECT_TICK                          (10000U)  /* ms */
+
+/**
+ * When CFG_ZIGBEE_LATENCY_SUPPORTED is set to 1, the ZCL requests sent through APP_ZIGBEE_LatencyRequest (all the
+ * fan-out requests) are timed from their submission to their completion, with an histogram per destination for
+ * at most CFG_ZIGBEE_LATENCY_DEST_MAX destinations and CFG_ZIGBEE_LATENCY_PENDING_MAX requests at the same time.
+ * The statistics are printed with LATSTATS and cleared with LATRESET.
+ */
+#define CFG_ZIGBEE_LATENCY_SUPPORTED                      (1)
+#define CFG_ZIGBEE_LATENCY_DEST_MAX                       (8U)
+#define CFG_ZIGBEE_LATENCY_PENDING_MAX                    (8U)
+
+/**
+ * When CFG_ZIGBEE_TRAFFIC_SUPPORTED is set to 1, SW3 (or TRAFFIC START/STOP) runs an OnOff traffic generator :
+ * bursts of Toggle sent periodically to an unicast, group or broadcast destination, with at most
+ * CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX bytes of padding. It is configured with the TRAFFIC serial commands and prints
+ * the success ratio, the retries and the latency statistics at the end of the run.
+ */
+#define CFG_ZIGBEE_TRAFFIC_SUPPORTED                      (1)
+#define CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX                    (64U)
+
+/**
+ * When CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED is set to 1 (paired actuator), an OnOff Server with the Groups and Scenes
+ * Servers is added on a second Endpoint. Its On/Off/Toggle commands and its scene recalls drive the output (green
+ * LED) directly from the stack callback, with the output state cached in RAM. At most
+ * CFG_ZIGBEE_ONOFF_SERVER_SCENES_MAX scenes are stored.
+ */
+#define CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED                 (0)
+#define CFG_ZIGBEE_ONOFF_SERVER_SCENES_MAX                (16U)
+
+/**
+ * When CFG_ZIGBEE_FASTPATH_SUPPORTED is set to 1 (with the OnOff Server), the APSDE-DATA.indications of the hot
+ * clusters of its Endpoint are dispatched from a constant table indexed by the cluster, before the stack : the output
+ * is driven there, then the stack processes the frame as before (attribute, response, scenes).
+ */
+#define CFG_ZIGBEE_FASTPATH_SUPPORTED                     (1)
+
+/**
+ * When CFG_ZIGBEE_LEVEL_PWM_SUPPORTED is set to 1 (dimmer, with the OnOff Server), a Level Control Server is added on
+ * the OnOff Server Endpoint. Its output is a TIM1 PWM (CFG_ZIGBEE_LEVEL_PWM_FREQUENCY, CFG_ZIGBEE_LEVEL_PWM_RESOLUTION
+ * counts) on the CFG_ZIGBEE_LEVEL_PWM_GPIO pin (to adapt to the board). A transition is played by batches of
+ * CFG_ZIGBEE_LEVEL_BATCH_FRAMES gamma corrected frames, computed ahead and written by the GPDMA1 channel 6 at the
+ * update events of the timer (its repetition counter holds a frame for several periods) : the CPU is woken once per
+ * batch, and at the end to update the CurrentLevel attribute. Stop mode is not allowed while the output is on.
+ * LEVELSTATS prints the state.
+ */
+#define CFG_ZIGBEE_LEVEL_PWM_SUPPORTED                    (0)
+#define CFG_ZIGBEE_LEVEL_PWM_FREQUENCY                    (1000U)   /* Hz */
+#define CFG_ZIGBEE_LEVEL_PWM_RESOLUTION                   (4096U)   /* Timer counts per period */
+#define CFG_ZIGBEE_LEVEL_BATCH_FRAMES                     (64U)     /* Frames computed ahead, per CPU wake */
+#define CFG_ZIGBEE_LEVEL_PWM_GPIO_PORT                    GPIOB
+#define CFG_ZIGBEE_LEVEL_PWM_GPIO_PIN                     GPIO_PIN_8
+#define CFG_ZIGBEE_LEVEL_PWM_GPIO_AF                      GPIO_AF1_TIM1
+#define CFG_ZIGBEE_LEVEL_PWM_GPIO_CLK_ENABLE()            __HAL_RCC_GPIOB_CLK_ENABLE()
+
+#if (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) && (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED == 0)
+#error "CFG_ZIGBEE_LEVEL_PWM_SUPPORTED adds the Level Server on the OnOff Server Endpoint, enable CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED"
+#endif /* (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) && (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED == 0) */
+
+/**
+ * When CFG_ZIGBEE_COLOR_SUPPORTED is set to 1 (color light, with the Level Server PWM), a Color Control Server (Hue
+ * Saturation and XY) is added on the OnOff Server Endpoint. The output becomes R, G, B on the TIM1 channels 1 to 3
+ * (CFG_ZIGBEE_COLOR_PWM_GPIO_PINS of the CFG_ZIGBEE_LEVEL_PWM_GPIO port, to adapt to the board), weighted by the color
+ * at the level of the Level Server. The color of a transition is computed in fixed point, one frame every
+ * CFG_ZIGBEE_COLOR_STEP_PERIOD, by batches handed to the transition engine of the Level Server. COLORSTATS prints
+ * the state.
+ */
+#define CFG_ZIGBEE_COLOR_SUPPORTED                        (0)
+#define CFG_ZIGBEE_COLOR_STEP_PERIOD                      (10U)     /* ms, frame of a color transition */
+#define CFG_ZIGBEE_COLOR_PWM_GPIO_PINS                    ( GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 )
+
+#if (CFG_ZIGBEE_COLOR_SUPPORTED != 0) && (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED == 0)
+#error "CFG_ZIGBEE_COLOR_SUPPORTED drives the PWM of the Level Server, enable CFG_ZIGBEE_LEVEL_PWM_SUPPORTED"
+#endif /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) && (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED == 0) */
+
+/**
+ * When CFG_ZIGBEE_SCENE_CACHE_SUPPORTED is set to 1 (with the OnOff Server and the fast path), a Store Scene keeps the
+ * scene as an actuation snapshot (OnOff state and PWM frame of the output) : a Recall Scene without transition drives
+ * the output from the fast path in constant time, whatever the clusters of the scene, then the stack processes it as
+ * before. The snapshots are in RAM : a scene stored before a reset is recalled by the stack only. SCENECACHE prints
+ * the state.
+ */
+#define CFG_ZIGBEE_SCENE_CACHE_SUPPORTED                  (1)
+
+#if (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED == 0)
+#error "CFG_ZIGBEE_SCENE_CACHE_SUPPORTED recalls the scenes from the fast path, enable CFG_ZIGBEE_FASTPATH_SUPPORTED"
+#endif /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED == 0) */
+
+/**
+ * When CFG_ZIGBEE_TIMESYNC_SUPPORTED is set to 1, a Time Server is added on the Endpoint and the nodes share the us
+ * time base of the master (CFG_ZIGBEE_TIMESYNC_MASTER, the Time attribute it was given is shared too). Every
+ * CFG_ZIGBEE_TIMESYNC_PERIOD, a node sends CFG_ZIGBEE_TIMESYNC_BURST_NB two-way exchanges (manufacturer specific
+ * commands of the Time cluster, time stamped at their APSDE-DATA.indication) : the one of shortest round trip gives
+ * the offset to the master, the successive offsets give the rate of its clock. A command of the OnOff, Level Control or
+ * Scenes cluster sent with a mesh time (APP_ZIGBEE_TimeSyncSendAt) is kept by its receivers until that time (at most
+ * CFG_ZIGBEE_TIMESYNC_APPLY_MAX ahead) : its output is driven by the fast path handler of its cluster, polling the us
+ * time base the last CFG_ZIGBEE_TIMESYNC_APPLY_LEAD, then the stack processes it. TIMESYNC prints the state.
+ */
+#define CFG_ZIGBEE_TIMESYNC_SUPPORTED                     (1)
+#define CFG_ZIGBEE_TIMESYNC_MASTER                        (0x0000U) /* Short address of the master (Coordinator) */
+#define CFG_ZIGBEE_TIMESYNC_PERIOD                        (60000U)  /* ms, between the synchronizations */
+#define CFG_ZIGBEE_TIMESYNC_BURST_NB                      (8U)      /* Exchanges of a synchronization */
+#define CFG_ZIGBEE_TIMESYNC_SAMPLE_TIMEOUT                (200U)    /* ms, response of the master to an exchange */
+#define CFG_ZIGBEE_TIMESYNC_APPLY_NB                      (4U)      /* Commands waiting for their mesh time */
+#define CFG_ZIGBEE_TIMESYNC_APPLY_MAX                     (60000U)  /* ms, largest delay of a command */
+#define CFG_ZIGBEE_TIMESYNC_APPLY_LEAD                    (2U)      /* ms, us time base polled before a command */
+#define CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX                   (16U)     /* Payload of a command */
+
+/**
+ * When CFG_ZIGBEE_METER_SUPPORTED is set to 1 (sub-meter, R22 Smart Energy stack), a Metering Server is added on the
+ * Endpoint. The pulses of the meter (CFG_ZIGBEE_METER_PULSE_GPIO pin, to adapt to the board) are time stamped by the
+ * TIM2 input capture and written by the GPDMA1 channel 6 in a circular ring of CFG_ZIGBEE_METER_RING_SIZE time stamps,
+ * without interrupt. The ring is processed at most every CFG_ZIGBEE_METER_PROCESS_PERIOD, sooner when the pulse rate
+ * would fill half of it : summation, demand and interval (CFG_ZIGBEE_METER_INTERVAL) accumulated, then the attributes
+ * updated once per processing. CFG_ZIGBEE_METER_PULSES_PER_UNIT pulses make one kWh (Divisor attribute). Stop mode is
+ * not used (the timer stops there). METERSTATS prints the state.
+ */
+#define CFG_ZIGBEE_METER_SUPPORTED                        (0)
+#define CFG_ZIGBEE_METER_PULSES_PER_UNIT                  (1000U)   /* Pulses per kWh */
+#define CFG_ZIGBEE_METER_RING_SIZE                        (256U)    /* Time stamps, power of 2 */
+#define CFG_ZIGBEE_METER_PROCESS_PERIOD                   (1000U)   /* ms, longest */
+#define CFG_ZIGBEE_METER_INTERVAL                         (900U)    /* s, interval of the partial profile value */
+#define CFG_ZIGBEE_METER_PULSE_FILTER                     (0x0FU)   /* Input capture filter (debounce) */
+#define CFG_ZIGBEE_METER_PULSE_GPIO_PORT                  GPIOA
+#define CFG_ZIGBEE_METER_PULSE_GPIO_PIN                   GPIO_PIN_5
+#define CFG_ZIGBEE_METER_PULSE_GPIO_AF                    GPIO_AF1_TIM2
+#define CFG_ZIGBEE_METER_PULSE_GPIO_CLK_ENABLE()          __HAL_RCC_GPIOA_CLK_ENABLE()
+
+#if (CFG_ZIGBEE_METER_SUPPORTED != 0) && (CFG_ZIGBEE_STACK_SE == 0)
+#error "CFG_ZIGBEE_METER_SUPPORTED uses the Metering Server of the R22 Smart Energy stack (Debug_R22_SE)"
+#endif /* (CFG_ZIGBEE_METER_SUPPORTED != 0) && (CFG_ZIGBEE_STACK_SE == 0) */
+#if (CFG_ZIGBEE_METER_SUPPORTED != 0) && (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0)
+#error "CFG_ZIGBEE_METER_SUPPORTED and CFG_ZIGBEE_LEVEL_PWM_SUPPORTED both use the GPDMA1 channel 6"
+#endif /* (CFG_ZIGBEE_METER_SUPPORTED != 0) && (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) */
+
+/**
+ * When CFG_ZIGBEE_GP_PROXY_SUPPORTED is set to 1, the GP frames of the Green Power Endpoint (Proxy Basic of the stack)
+ * go first through a filter : a frame received again from the same source within CFG_ZIGBEE_GP_DEDUP_WINDOW is
+ * dropped (set of CFG_ZIGBEE_GP_DEDUP_SIZE hashes, power of 2), and the GPD paired by the sinks are cached in RAM (at
+ * most CFG_ZIGBEE_GP_GPD_MAX). GPSTATS prints the state.
+ */
+#define CFG_ZIGBEE_GP_PROXY_SUPPORTED                     (1)
+#define CFG_ZIGBEE_GP_DEDUP_SIZE                          (16U)
+#define CFG_ZIGBEE_GP_DEDUP_WINDOW                        (2000U)   /* ms */
+#define CFG_ZIGBEE_GP_GPD_MAX                             (8U)
+
+/**
+ * When CFG_ZIGBEE_TOUCHLINK_SUPPORTED is set to 1, TLSTART commissions by Touchlink the target close to the device
+ * (RSSI above CFG_ZIGBEE_TOUCHLINK_RSSI_MIN, identify of CFG_ZIGBEE_TOUCHLINK_IDENTIFY_TIME). Only the primary channels
+ * and the channels where targets were found are scanned, all the channels after a session without target. A request
+ * during a session is merged into it. TLSTATS prints the state.
+ */
+#define CFG_ZIGBEE_TOUCHLINK_SUPPORTED                    ( CFG_ZIGBEE_ZDD_SUPPORTED == 0 )   /* Not in the ZDD stack */
+#define CFG_ZIGBEE_TOUCHLINK_IDENTIFY_TIME                (2U)      /* s */
+#define CFG_ZIGBEE_TOUCHLINK_RSSI_MIN                     (-60)     /* dBm */
+
+/******************************************************************************
+ * Zigbee network health
+ ******************************************************************************/
+/**
+ * When CFG_ZIGBEE_HEALTH_SUPPORTED is set to 1, the Neighbor and Route tables and the APS counters are sampled
+ * every CFG_ZIGBEE_HEALTH_PERIOD, a few entries per Task run. The last CFG_ZIGBEE_HEALTH_TREND_DEPTH LQI and
+ * outgoing cost values of at most CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX neighbors are kept, with the number of routes
+ * through each of them. They are printed with HEALTH / HEALTHNBR, and a Diagnostics Server cluster is added.
+ */
+#define CFG_ZIGBEE_HEALTH_SUPPORTED                       (1)
+#define CFG_ZIGBEE_HEALTH_PERIOD                          (30000U)  /* ms */
+#define CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX                    (32U)
+#define CFG_ZIGBEE_HEALTH_TREND_DEPTH                     (8U)
+
+/**
+ * When CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED is set to 1, a manufacturer specific server cluster
+ * (CFG_ZIGBEE_PERF_CLUSTER_ID) is added on the application endpoint, with read-only and reportable attributes of the
+ * performance counters that are built : CPU load (CFG_LOAD_METER_SUPPORTED), Zigbee heap used and peak, MAC retry
+ * rate, trace drops (CFG_LOG_TRACE_STATS_SUPPORTED) and sequencer max latency (CFG_SEQ_PROFILING_SUPPORTED). Their
+ * default reporting intervals are CFG_ZIGBEE_PERF_REPORT_MIN and CFG_ZIGBEE_PERF_REPORT_MAX.
+ */
+#define CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED                 (0)
+#define CFG_ZIGBEE_PERF_CLUSTER_ID                        (0xFC00U)
+#define CFG_ZIGBEE_PERF_REPORT_MIN                        (60U)     /* s */
+#define CFG_ZIGBEE_PERF_REPORT_MAX                        (900U)    /* s */
+
+/**
+ * When CFG_ZIGBEE_ATTR_STORE_SUPPORTED is set to 1, the application clusters can keep their attributes in a packed
+ * store (APP_ZIGBEE_AttrStoreAppend) : the const descriptors stay in flash and the values of each cluster take one
+ * block of a static pool of CFG_ZIGBEE_ATTR_STORE_POOL_SIZE bytes (at most CFG_ZIGBEE_ATTR_STORE_MAX clusters),
+ * instead of one allocation of the Zigbee heap per attribute. A value is found from its descriptor by index on the
+ * Read Attributes and the report scans. The stores are printed with ATTRSTATS.
+ */
+#define CFG_ZIGBEE_ATTR_STORE_SUPPORTED                   (1)
+#define CFG_ZIGBEE_ATTR_STORE_MAX                         (8U)
+#define CFG_ZIGBEE_ATTR_STORE_POOL_SIZE                   (512U)    /* Bytes */
+
+/**
+ * When CFG_ZIGBEE_BROADCAST_POLICY_SUPPORTED is set to 1 and group addressing is used, the Broadcast Transaction
+ * Table occupancy and the MAC unicast retry rate are sampled every CFG_ZIGBEE_BROADCAST_POLICY_PERIOD. Under load,
+ * the broadcast delivery time is lengthened, the broadcast retries are reduced and the spacing of the broadcasts
+ * originated by the fan-out is doubled at each level. The state is printed with BCASTSTATS.
+ * The Router neighbors are counted at the same time : from CFG_ZIGBEE_BROADCAST_DENSE_ROUTERS, each broadcast is
+ * relayed by enough neighbors that one more retry is removed and the passive-ack timeout is lengthened (the relays
+ * contend for the channel). From CFG_ZIGBEE_BROADCAST_CROWDED_ROUTERS, with at least CFG_ZIGBEE_BROADCAST_GOOD_LINKS
+ * of them on good links, passive-acks are disabled.
+ */
+#define CFG_ZIGBEE_BROADCAST_POLICY_SUPPORTED             (1)
+#define CFG_ZIGBEE_BROADCAST_POLICY_PERIOD                (2000U)   /* ms */
+#define CFG_ZIGBEE_BROADCAST_DENSE_ROUTERS                (6U)
+#define CFG_ZIGBEE_BROADCAST_CROWDED_ROUTERS              (12U)
+#define CFG_ZIGBEE_BROADCAST_GOOD_LINKS                   (75U)     /* % of the Router neighbors */
+
+/**
+ * When CFG_ZIGBEE_REPORT_AGGREGATION_SUPPORTED is set to 1, the attributes added with APP_ZIGBEE_ReportAdd are
+ * reported on a shared schedule of CFG_ZIGBEE_REPORT_WINDOW : the attributes due before the next tick are sent at
+ * this tick, in one Report Attributes frame (at most CFG_ZIGBEE_REPORT_FRAME_MAX bytes of records) per destination
+ * and cluster. At most CFG_ZIGBEE_REPORT_ATTRIBUTE_MAX attributes of at most CFG_ZIGBEE_REPORT_VALUE_MAX bytes are
+ * supported.
+ */
+#define CFG_ZIGBEE_REPORT_AGGREGATION_SUPPORTED           (1)
+#define CFG_ZIGBEE_REPORT_WINDOW                          (5000U)   /* ms */
+#define CFG_ZIGBEE_REPORT_ATTRIBUTE_MAX                   (16U)
+#define CFG_ZIGBEE_REPORT_FRAME_MAX                       (64U)
+#define CFG_ZIGBEE_REPORT_VALUE_MAX                       (8U)
+
+/**
+ * When CFG_ZIGBEE_ROUTE_CACHE_SUPPORTED is set to 1, the unicast destinations of the application (reports, fan-out,
+ * host ZCL requests) are tracked : at most CFG_ZIGBEE_ROUTE_HOT_MAX of them, hot when used at least
+ * CFG_ZIGBEE_ROUTE_HOT_THRESHOLD times (uses halved at each CFG_ZIGBEE_ROUTE_TICK). At each tick, the route of a
+ * hot destination not active, or discovered more than CFG_ZIGBEE_ROUTE_REFRESH_AGE ago, is discovered ahead. The
+ * frames to a hot destination with an active route are sent without route discovery. ROUTESTATS prints the state.
+ */
+#define CFG_ZIGBEE_ROUTE_CACHE_SUPPORTED                  (1)
+#define CFG_ZIGBEE_ROUTE_HOT_MAX                          (8U)
+#define CFG_ZIGBEE_ROUTE_HOT_THRESHOLD                    (3U)
+#define CFG_ZIGBEE_ROUTE_TICK                             (10000U)  /* ms */
+#define CFG_ZIGBEE_ROUTE_REFRESH_AGE                      (120000U) /* ms */
+
+/**
+ * When CFG_ZIGBEE_ADDR_CACHE_SUPPORTED is set to 1, the unicast destinations given by IEEE address are resolved from
+ * an application cache of CFG_ZIGBEE_ADDR_CACHE_SIZE short addresses (least recently used replaced), learned from the
+ * Device_annce and the incoming frames, and sent to by short address. The entries used at least
+ * CFG_ZIGBEE_ADDR_HOT_THRESHOLD times during CFG_ZIGBEE_ADDR_TICK, and not confirmed since
+ * CFG_ZIGBEE_ADDR_REFRESH_AGE, are refreshed ahead by NWK_addr_req (one at a time). ADDRCACHE prints the state.
+ */
+#define CFG_ZIGBEE_ADDR_CACHE_SUPPORTED                   (1)
+#define CFG_ZIGBEE_ADDR_CACHE_SIZE                        (16U)
+#define CFG_ZIGBEE_ADDR_HOT_THRESHOLD                     (2U)
+#define CFG_ZIGBEE_ADDR_TICK                              (15000U)  /* ms */
+#define CFG_ZIGBEE_ADDR_REFRESH_AGE                       (300000U) /* ms */
+
+/**
+ * When CFG_ZIGBEE_BINDMAP_SUPPORTED is set to 1, the local bindings (at most CFG_ZIGBEE_BINDMAP_BIND_MAX) and the
+ * group memberships (at most CFG_ZIGBEE_BINDMAP_GROUP_MAX) are mirrored in hash indexes of CFG_ZIGBEE_BINDMAP_BUCKETS
+ * buckets (power of 2) : the bound fan-out and the group membership lookups read one bucket. The mirror is updated
+ * by the APP_ZIGBEE_BindMap requests, and built again after a remote Bind, Unbind or Groups command. BINDSTATS
+ * prints the state.
+ */
+#define CFG_ZIGBEE_BINDMAP_SUPPORTED                      (1)
+#define CFG_ZIGBEE_BINDMAP_BIND_MAX                       (32U)
+#define CFG_ZIGBEE_BINDMAP_GROUP_MAX                      (32U)
+#define CFG_ZIGBEE_BINDMAP_BUCKETS                        (16U)
+
+/**
+ * When CFG_ZIGBEE_FRAG_TUNER_SUPPORTED is set to 1, the APS window size and interframe delay of the fragmented
+ * transfers are tuned per peer (at most CFG_ZIGBEE_FRAG_PEER_MAX) : started from the LQI of the neighbour, then
+ * changed one step (window, or CFG_ZIGBEE_FRAG_DELAY_STEP ms of delay) after CFG_ZIGBEE_FRAG_HOLD transfers when the
+ * goodput improves, and backed off on failure. CFG_ZIGBEE_FRAG_THRESHOLD (0 : stack default) is the fragmentation
+ * threshold. The stack defaults are restored after each transfer. FRAGSTATS prints the state.
+ */
+#define CFG_ZIGBEE_FRAG_TUNER_SUPPORTED                   (1)
+#define CFG_ZIGBEE_FRAG_PEER_MAX                          (4U)
+#define CFG_ZIGBEE_FRAG_THRESHOLD                         (0U)
+#define CFG_ZIGBEE_FRAG_DELAY_MIN                         (10U)     /* ms */
+#define CFG_ZIGBEE_FRAG_DELAY_MAX                         (100U)    /* ms */
+#define CFG_ZIGBEE_FRAG_DELAY_STEP                        (10U)     /* ms */
+#define CFG_ZIGBEE_FRAG_HOLD                              (4U)
+
+/**
+ * When CFG_ZIGBEE_OTA_SUPPORTED is set to 1, an OTA Upgrade Client downloads the new image (OTA START serial command
+ * or Image Notify of a Server) in the CFG_ZIGBEE_OTA_DOWNLOAD_SIZE bytes at CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS (page
+ * aligned, outside of the application). The blocks are copied in two buffers of CFG_ZIGBEE_OTA_BUFFER_SIZE bytes
+ * (multiple of 16, at least 256, divider of FLASH_PAGE_SIZE) written alternately by the Flash Manager. A failed
+ * block is retried at most CFG_ZIGBEE_OTA_RETRY_MAX times, after CFG_ZIGBEE_OTA_RETRY_DELAY doubled at each retry.
+ */
+#define CFG_ZIGBEE_OTA_SUPPORTED                          (1)
+#define CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS                   ( FLASH_BASE + 0x00100000U )
+#if (CFG_NVM_BENCH_SUPPORTED != 0)
+#define CFG_ZIGBEE_OTA_DOWNLOAD_SIZE                      ( CFG_NVM_BENCH_ADDRESS - CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS )
+#else /* (CFG_NVM_BENCH_SUPPORTED != 0) */
+#define CFG_ZIGBEE_OTA_DOWNLOAD_SIZE                      ( CFG_SCM_HSE_TUNE_ADDRESS - CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS )
+#endif /* (CFG_NVM_BENCH_SUPPORTED != 0) */
+#define CFG_ZIGBEE_OTA_BUFFER_SIZE                        (1024U)
+#define CFG_ZIGBEE_OTA_RETRY_MAX                          (4U)
+#define CFG_ZIGBEE_OTA_RETRY_DELAY                        (2000U)   /* ms */
+
+/**
+ * When CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED is set to 1, the upgrade image is accepted only with a valid ECDSA P-256
+ * signature of the SHA-256 of its firmware, carried by a manufacturer tag after the image tag (r then s, big-endian).
+ * The HASH updates the SHA-256 on each buffer given to the Flash Manager, and the PKA job verifying the signature is
+ * queued as soon as the tag is received : the image is never read back from the flash.
+ */
+#define CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED                (1)
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) && ((CFG_ZIGBEE_OTA_SUPPORTED == 0) || (CFG_HW_PKA_ASYNC_SUPPORTED == 0))
+#error "CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED needs CFG_ZIGBEE_OTA_SUPPORTED and the PKA jobs of CFG_HW_PKA_ASYNC_SUPPORTED"
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) && ... */
+
+/**
+ * When CFG_ZIGBEE_OTA_AB_SUPPORTED is set to 1, the download area is the inactive flash bank (A/B slots) : the image
+ * is activated by a bank swap (SWAP_BANK option bit) and a reboot, without copy at boot. The data pages above the
+ * download area (persistence, logs) are copied in the same place of the active bank before the swap. The new image
+ * is on trial until it ran CFG_ZIGBEE_OTA_AB_CONFIRM_DELAY without reset : after CFG_ZIGBEE_OTA_AB_TRIAL_BOOTS resets
+ * on trial, the banks are swapped back. The trial is recorded in the backup register CFG_ZIGBEE_OTA_AB_BKP_REGISTER.
+ */
+#define CFG_ZIGBEE_OTA_AB_SUPPORTED                       (1)
+#define CFG_ZIGBEE_OTA_AB_CONFIRM_DELAY                   (60000U)  /* ms */
+#define CFG_ZIGBEE_OTA_AB_TRIAL_BOOTS                     (3U)
+#define CFG_ZIGBEE_OTA_AB_BKP_REGISTER                    RTC_BKP_DR8
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) && (CFG_ZIGBEE_OTA_SUPPORTED == 0)
+#error "CFG_ZIGBEE_OTA_AB_SUPPORTED activates the image of the OTA Client, enable CFG_ZIGBEE_OTA_SUPPORTED"
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) && (CFG_ZIGBEE_OTA_SUPPORTED == 0) */
+
+/**
+ * When CFG_ZIGBEE_OTA_SERVER_SUPPORTED is set to 1, an OTA Upgrade Server proposes the image set by
+ * APP_ZIGBEE_OtaServerSetImage. The Image Block Requests are served from CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB lines of
+ * CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE bytes of the image (least recently used line replaced), so that the Clients
+ * upgraded together read the storage once. A Client requesting a line being read waits CFG_ZIGBEE_OTA_SERVER_WAIT_TIME.
+ */
+#define CFG_ZIGBEE_OTA_SERVER_SUPPORTED                   (0)
+#define CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB               (8U)
+#define CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE             (256U)
+#define CFG_ZIGBEE_OTA_SERVER_WAIT_TIME                   (1U)      /* s */
+
+/**
+ * When CFG_ZIGBEE_STAGGER_SUPPORTED is set to 1, the Coordinator applies a heavy operation to the nodes of its Address
+ * Map (at most CFG_ZIGBEE_STAGGER_NODE_MAX) one by one instead of all together : each node gets one of the
+ * CFG_ZIGBEE_STAGGER_SLOT_NB slots of CFG_ZIGBEE_STAGGER_SLOT_DURATION from a hash of its short address, and at most
+ * CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX operations are in progress at once, down to one as the CCA failures of the MAC
+ * rise from CFG_ZIGBEE_STAGGER_CCA_LOW % to CFG_ZIGBEE_STAGGER_CCA_HIGH %. Operations : unicast Image Notify
+ * (STAGGER OTA, CFG_ZIGBEE_OTA_SERVER_SUPPORTED, ended by the Upgrade End Request or after
+ * CFG_ZIGBEE_STAGGER_OTA_TIMEOUT), Bind_req to the Coordinator (STAGGER BIND <endpoint> <cluster>, ended by the
+ * Bind_rsp or after CFG_ZIGBEE_STAGGER_BIND_TIMEOUT), or any operation of the application (APP_ZIGBEE_StaggerStart).
+ */
+#define CFG_ZIGBEE_STAGGER_SUPPORTED                      (1)
+#define CFG_ZIGBEE_STAGGER_NODE_MAX                       (64U)
+#define CFG_ZIGBEE_STAGGER_SLOT_NB                        (32U)
+#define CFG_ZIGBEE_STAGGER_SLOT_DURATION                  (2000U)   /* ms */
+#define CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX                (4U)
+#define CFG_ZIGBEE_STAGGER_CCA_LOW                        (2U)      /* % */
+#define CFG_ZIGBEE_STAGGER_CCA_HIGH                       (15U)     /* % */
+#define CFG_ZIGBEE_STAGGER_OTA_TIMEOUT                    (600000U) /* ms */
+#define CFG_ZIGBEE_STAGGER_BIND_TIMEOUT                   (10000U)  /* ms */
+
+#if ( CFG_ZIGBEE_STAGGER_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 )
+#error "CFG_ZIGBEE_STAGGER_SUPPORTED requires CFG_MAC_STATS_SUPPORTED (channel load)."
+#endif /* ( CFG_ZIGBEE_STAGGER_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 ) */
+
+/**
+ * Data polls of the Sleepy End Device (CFG_ZIGBEE_SED_SUPPORTED) : the long poll interval starts at
+ * CFG_ZIGBEE_SED_LONG_POLL_MIN, comes back to it each time the Parent has data and doubles when not, up to the
+ * LongPollInterval attribute of the Poll Control Server (CFG_ZIGBEE_SED_LONG_POLL_MAX at startup). A request of the
+ * application polls every CFG_ZIGBEE_SED_FAST_POLL_PERIOD during CFG_ZIGBEE_SED_FAST_POLL_TIMEOUT.
+ * CFG_ZIGBEE_SED_TIMEOUT is the End Device Timeout index (60 * 2^n seconds) given to the Parent.
+ */
+#define CFG_ZIGBEE_SED_LONG_POLL_MIN                      (1000U)   /* ms */
+#define CFG_ZIGBEE_SED_LONG_POLL_MAX                      (60000U)  /* ms */
+#define CFG_ZIGBEE_SED_FAST_POLL_PERIOD                   (250U)    /* ms */
+#define CFG_ZIGBEE_SED_FAST_POLL_TIMEOUT                  (3000U)   /* ms */
+#define CFG_ZIGBEE_SED_TIMEOUT                            (8U)
+
+/**
+ * When CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED is set to 1, the timers of the Zigbee stack are driven by a single UTIL_TIMER
+ * armed at the exact next deadline ( ZbCheckTime ) after each ZbTimerWork, through the linker ( --wrap=ZbTimerWork,
+ * --wrap=ZbPortHwTimerReStart, --wrap=ZbPortHwTimerStop ), instead of the periodic timer of the port, which also wakes
+ * the Zigbee task every second when no timer is scheduled.
+ */
+#define CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED                 (1)
+
+/**
+ * When CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED is set to 1, the Link Power Delta negotiation of the stack (every
+ * CFG_ZIGBEE_TX_POWER_DELTA_PERIOD) adapts the TX power toward each neighbor, and the Neighbor table is sampled every
+ * CFG_ZIGBEE_TX_POWER_PERIOD : the TX power of the interface is raised of CFG_ZIGBEE_TX_POWER_STEP (up to the startup
+ * TX power) when a link is below CFG_ZIGBEE_TX_POWER_LQI_LOW or failed, and lowered of one step (down to
+ * CFG_ZIGBEE_TX_POWER_MIN) when all the links are above CFG_ZIGBEE_TX_POWER_LQI_HIGH. State printed with TXPOWER.
+ */
+#define CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED            (1)
+#define CFG_ZIGBEE_TX_POWER_PERIOD                        (30000U)  /* ms */
+#define CFG_ZIGBEE_TX_POWER_DELTA_PERIOD                  (64U)     /* s */
+#define CFG_ZIGBEE_TX_POWER_MIN                           ((int8_t) -6)
+#define CFG_ZIGBEE_TX_POWER_STEP                          (2)       /* dB */
+#define CFG_ZIGBEE_TX_POWER_LQI_LOW                       (150U)
+#define CFG_ZIGBEE_TX_POWER_LQI_HIGH                      (230U)
+
+/**
+ * When CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED is set to 1, the adaptive TX power also selects the TX power table of
+ * the link layer : the low power table ( ID 1, lower PA supply setting, up to +3 dBm ) while the TX power is at most
+ * CFG_ZIGBEE_TX_POWER_LOW_TABLE_MAX, the max power table ( ID 0 ) above. The time and the transmissions spent with each
+ * table are printed with TXPOWER, to relate the supply current measured on the board to each setting.
+ */
+#define CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED        (1)
+#define CFG_ZIGBEE_TX_POWER_LOW_TABLE_MAX                 ((int8_t) 3)
+
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) && ((CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED == 0) || (CFG_RF_TX_POWER_TABLE_ID != 0))
+#error "CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED requires CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED and the max power table at startup."
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) && ((CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED == 0) || ... */
+
+/**
+ * When CFG_ZIGBEE_CSMA_TUNING_SUPPORTED is set to 1, the CCA failure and no acknowledgment rates of the MAC
+ * transmissions (CFG_MAC_STATS_SUPPORTED) are sampled every CFG_ZIGBEE_CSMA_PERIOD (once CFG_ZIGBEE_CSMA_TX_MIN
+ * transmissions are counted) : above CFG_ZIGBEE_CSMA_CCA_HIGH % of CCA failures, macMinBE (up to
+ * CFG_ZIGBEE_CSMA_MIN_BE_HIGH), macMaxBE (up to CFG_ZIGBEE_CSMA_MAX_BE_HIGH) and macMaxCSMABackoffs (up to
+ * CFG_ZIGBEE_CSMA_BACKOFFS_HIGH) are raised of one step, at most CFG_ZIGBEE_CSMA_CCA_LOW % they are lowered of one step
+ * (macMinBE down to CFG_ZIGBEE_CSMA_MIN_BE_LOW, the others down to the defaults of the MAC). macMaxFrameRetries is
+ * raised (up to CFG_ZIGBEE_CSMA_RETRIES_HIGH) above CFG_ZIGBEE_CSMA_NO_ACK_HIGH % of transmissions not acknowledged,
+ * lowered back to the default at most CFG_ZIGBEE_CSMA_NO_ACK_LOW %. State printed with CSMA.
+ */
+#define CFG_ZIGBEE_CSMA_TUNING_SUPPORTED                  (1)
+#define CFG_ZIGBEE_CSMA_PERIOD                            (30000U)  /* ms */
+#define CFG_ZIGBEE_CSMA_TX_MIN                            (20U)
+#define CFG_ZIGBEE_CSMA_CCA_HIGH                          (10U)     /* % */
+#define CFG_ZIGBEE_CSMA_CCA_LOW                           (2U)      /* % */
+#define CFG_ZIGBEE_CSMA_NO_ACK_HIGH                       (10U)     /* % */
+#define CFG_ZIGBEE_CSMA_NO_ACK_LOW                        (3U)      /* % */
+#define CFG_ZIGBEE_CSMA_MIN_BE_LOW                        (2U)
+#define CFG_ZIGBEE_CSMA_MIN_BE_HIGH                       (5U)
+#define CFG_ZIGBEE_CSMA_MAX_BE_HIGH                       (7U)
+#define CFG_ZIGBEE_CSMA_BACKOFFS_HIGH                     (5U)
+#define CFG_ZIGBEE_CSMA_RETRIES_HIGH                      (6U)
+
+#if ( CFG_ZIGBEE_CSMA_TUNING_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 )
+#error "CFG_ZIGBEE_CSMA_TUNING_SUPPORTED requires CFG_MAC_STATS_SUPPORTED (CCA failure and no acknowledgment counts)."
+#endif /* ( CFG_ZIGBEE_CSMA_TUNING_SUPPORTED != 0 ) && ( CFG_MAC_STATS_SUPPORTED == 0 ) */
+
+/**
+ * When CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED is set to 1, one channel of the mask is energy scanned every
+ * CFG_ZIGBEE_CHANNEL_SCAN_PERIOD (scan of CFG_ZIGBEE_CHANNEL_SCAN_DURATION, 0 = 31 ms) when the MAC was idle during
+ * the period (CFG_MAC_STATS_SUPPORTED), or at the latest after CFG_ZIGBEE_CHANNEL_SKIP_MAX busy periods. At the end of
+ * each sweep, when the current channel averages above CFG_ZIGBEE_CHANNEL_ED_THRESHOLD and the quietest channel is lower
+ * by CFG_ZIGBEE_CHANNEL_ED_MARGIN, it is set as nwkNextChannelChange and proposed to the Network Manager, then not
+ * again during CFG_ZIGBEE_CHANNEL_TRIGGER_HOLDOFF sweeps. Noise histograms printed with CHANNEL.
+ * Not on a Sleepy End Device (radio off between the polls).
+ */
+#if (CFG_ZIGBEE_SED_SUPPORTED != 0)
+#define CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED              (0)
+#else /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
+#define CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED              (1)
+#endif /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
+#define CFG_ZIGBEE_CHANNEL_SCAN_PERIOD                    (2000U)   /* ms */
+#define CFG_ZIGBEE_CHANNEL_SCAN_DURATION                  (0U)
+#define CFG_ZIGBEE_CHANNEL_SKIP_MAX                       (15U)
+#define CFG_ZIGBEE_CHANNEL_ED_THRESHOLD                   (160U)
+#define CFG_ZIGBEE_CHANNEL_ED_MARGIN                      (40U)
+#define CFG_ZIGBEE_CHANNEL_TRIGGER_HOLDOFF                (10U)     /* sweeps */
+
+/**
+ * Sniffer (CFG_ZIGBEE_SNIFFER_SUPPORTED) : capture started on CFG_ZIGBEE_SNIFFER_CHANNEL (SNIFF <channel> / SNIFF STOP
+ * serial commands), with the trace UART at CFG_ZIGBEE_SNIFFER_BAUDRATE to follow a channel at full load.
+ */
+#define CFG_ZIGBEE_SNIFFER_CHANNEL                        (14U)
+#define CFG_ZIGBEE_SNIFFER_BAUDRATE                       (921600U)
+
 /* USER CODE BEGIN Defines */
 /**
  * User interaction
@@ -358,6 +1793,14 @@ typedef enum
 #define CFG_LED_SUPPORTED           (1)
 #define CFG_BUTTON_SUPPORTED        (1)
 
+/**
+ * When CFG_BSP_EDGE_TIMESTAMP_SUPPORTED is set to 1, both edges of the buttons interrupt and are time stamped: the
+ * press duration (long press) is computed from them, the action being launched at the release, instead of a timer
+ * sampling the button while it is pressed. The joystick (Discovery) is watched by the analog watchdog of its ADC
+ * instead of a periodic conversion.
+ */
+#define CFG_BSP_EDGE_TIMESTAMP_SUPPORTED  (1)
+
 /**
  * If CFG_LPM_LEVEL at 2, make sure LED are disabled
  */
@@ -400,6 +1843,12 @@ typedef enum
 #endif /* (CFG_LPM_STDBY_SUPPORTED > 0) && (CFG_LPM_LEVEL != 0) */
 
 /* USER CODE BEGIN Defines_2 */
+#if (CFG_RT_DEBUG_ITM != 0) && (CFG_DEBUGGER_LEVEL == 0)
+#error "CFG_RT_DEBUG_ITM needs the debugger (SWO), CFG_DEBUGGER_LEVEL is 0"
+#endif /* (CFG_RT_DEBUG_ITM != 0) && (CFG_DEBUGGER_LEVEL == 0) */
+#if (CFG_HOST_PROTOCOL_SUPPORTED != 0) && (CFG_LOG_SUPPORTED == 0)
+#error "CFG_HOST_PROTOCOL_SUPPORTED shares the log UART, CFG_LOG_SUPPORTED is 0"
+#endif /* (CFG_HOST_PROTOCOL_SUPPORTED != 0) && (CFG_LOG_SUPPORTED == 0) */
 
 /* USER CODE END Defines_2 */
 
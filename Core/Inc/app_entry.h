@@ -31,11 +31,40 @@ extern "C" {
 /* Private includes ----------------------------------------------------------*/
 #include "app_common.h"
 /* USER CODE BEGIN Includes */
+#include <stdbool.h>
 
 /* USER CODE END Includes */
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
+/* Stages of the boot profile, in their order */
+typedef enum
+{
+  APPE_BOOT_MAIN,                 /* Reset to main() : SystemInit, copy of the data, clear of the bss */
+  APPE_BOOT_APPE_CONFIG,          /* HAL_Init and MX_APPE_Config (HSE trimming) */
+  APPE_BOOT_CLOCK_CONFIG,         /* SystemClock_Config (LSE and HSE start-up) */
+  APPE_BOOT_PERIPHERALS,          /* MX peripherals (GPIO, DMA, ICACHE, RAMCFG, RTC, RNG) */
+  APPE_BOOT_SYSTEM_INIT,          /* System_Init (timer server, logs) */
+  APPE_BOOT_POWER_CONFIG,         /* SystemPower_Config (System Clock Manager, low power) */
+  APPE_BOOT_AMM_INIT,             /* APPE_AMM_Init */
+  APPE_BOOT_MODULES_INIT,         /* RNG, PKA, NVM, BSP and application modules */
+  APPE_BOOT_LINK_LAYER_INIT,      /* Link layer and MAC */
+  APPE_BOOT_ZIGBEE_INIT,          /* ZbInit */
+  APPE_BOOT_ENDPOINTS,            /* Basic Server, Endpoints and Clusters */
+  APPE_BOOT_APPE_INIT,            /* End of MX_APPE_Init */
+  APPE_BOOT_STARTUP_BEGIN,        /* First Startup (or restart from the persistence data) launched */
+  APPE_BOOT_STARTUP_END,          /* Network formed, joined or restored */
+  APPE_BOOT_APPLICATION_START,    /* APP_ZIGBEE_ApplicationStart done : operational */
+  APPE_BOOT_STAGE_NB
+} APPE_BootStage_t;
+
+/* Lifetime of a buffer of APPE_MEM_Alloc() */
+typedef enum
+{
+  APPE_MEM_PERSISTENT,            /* Kept across Standby : AMM pool, retained SRAM */
+  APPE_MEM_SCRATCH,               /* Released before Standby : scratch pool, not retained (CFG_SRAM_SCRATCH_SUPPORTED) */
+} APPE_MEM_Lifetime_t;
+
 
 /* USER CODE END ET */
 
@@ -63,6 +92,98 @@ void MX_APPE_LinkLayerInit(void);
 void MX_APPE_Process(void);
 
 /* USER CODE BEGIN EFP */
+void * APPE_MEM_Alloc(uint32_t lSize, APPE_MEM_Lifetime_t eLifetime);
+void APPE_MEM_Free(void * pBuffer);
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+void APPE_MEM_ScratchReset(void);
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+void APPE_SEQ_PrintStats(void);
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+void APPE_SEQ_PrintDeadlines(void);
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+#if (CFG_TIMER_STATS_SUPPORTED != 0)
+void APPE_TIMER_PrintStats(void);
+#endif /* (CFG_TIMER_STATS_SUPPORTED != 0) */
+#if (CFG_HEAP_DIAG_SUPPORTED != 0)
+void APPE_HEAP_PrintStats(void);
+#endif /* (CFG_HEAP_DIAG_SUPPORTED != 0) */
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+void APPE_AMM_RebalanceStart(void);
+void APPE_AMM_Rebalance(void);
+void APPE_AMM_PrintStats(void);
+#else /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+#define APPE_AMM_RebalanceStart()
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+void APPE_LL_ISR_PrintStats(void);
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+#if (CFG_ICACHE_STATS_SUPPORTED != 0)
+void APPE_ICACHE_PrintStats(void);
+#endif /* (CFG_ICACHE_STATS_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+void APPE_NVM_PrintStats(void);
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+void APPE_FLASH_PrintStats(void);
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+void APPE_CRYPTO_PrintStats(void);
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+void APPE_LL_DELAY_PrintStats(void);
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+void APPE_LL_BG_PrintStats(void);
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+void APPE_MAC_PrintStats(void);
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+void APPE_RCO_PrintStats(void);
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+void APPE_COEX_PrintStats(void);
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+#if (CFG_LOG_TRACE_STATS_SUPPORTED != 0)
+void APPE_TRACE_PrintStats(void);
+#endif /* (CFG_LOG_TRACE_STATS_SUPPORTED != 0) */
+uint32_t APPE_NextDeadlineGet(void);
+#if (CFG_LPM_LEVEL != 0)
+void APPE_LPM_PrintStats(void);
+#endif /* (CFG_LPM_LEVEL != 0) */
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+void APPE_CLK_SetBoost(uint32_t lBoostId_bm, bool bBoost);
+void APPE_CLK_PrintStats(void);
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+#if (CFG_BOOT_PROFILE_SUPPORTED != 0)
+void APPE_BOOT_Mark(APPE_BootStage_t eStage);
+void APPE_BOOT_PrintStats(void);
+#else /* (CFG_BOOT_PROFILE_SUPPORTED != 0) */
+#define APPE_BOOT_Mark( eStage )
+#endif /* (CFG_BOOT_PROFILE_SUPPORTED != 0) */
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+void APPE_STACK_Paint(void);
+void APPE_STACK_PrintStats(void);
+#else /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+#define APPE_STACK_Paint()
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+#if (CFG_SEQ_RADIO_YIELD_SUPPORTED != 0)
+void APPE_SEQ_YieldToRadio(void);
+#else /* (CFG_SEQ_RADIO_YIELD_SUPPORTED != 0) */
+#define APPE_SEQ_YieldToRadio()
+#endif /* (CFG_SEQ_RADIO_YIELD_SUPPORTED != 0) */
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+uint16_t APPE_LOAD_Get(uint32_t lSeconds);
+void APPE_LOAD_PrintStats(void);
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+#if (CFG_PERF_SNAPSHOT_SUPPORTED != 0)
+void APPE_PERF_PrintSnapshot(void);
+#endif /* (CFG_PERF_SNAPSHOT_SUPPORTED != 0) */
+#if (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0)
+uint32_t APPE_SEQ_PrioViolation(uint64_t llTaskMask);
+void APPE_SEQ_PrintPrio(void);
+#endif /* (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0) */
+void APPE_TIMER_CapacityError(void ( *callback )( void * ));
 
 /* USER CODE END EFP */
 
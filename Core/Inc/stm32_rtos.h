@@ -47,8 +47,51 @@ extern "C" {
 #define TASK_PRIO_ZIGBEE_APP_START              CFG_SEQ_PRIO_1
 
 /* USER CODE BEGIN TASK_Priority_Define */
-#define CFG_TASK_PRIO_BUTTON_Bx                 CFG_SEQ_PRIO_0
-#define TASK_PRIO_FUOTA_SEND                    CFG_SEQ_PRIO_1
+/* Default priorities set in their class (CFG_SEQ_PRIO_RADIO reserved to CFG_SEQ_RADIO_TASKS) */
+#undef TASK_PRIO_RNG
+#undef TASK_PRIO_LINK_LAYER
+#undef TASK_PRIO_MAC_LAYER
+#undef TASK_PRIO_ZIGBEE_LAYER
+#undef TASK_PRIO_ZIGBEE_NETWORK_FORM
+#undef TASK_PRIO_ZIGBEE_APP_START
+#define TASK_PRIO_RNG                           CFG_SEQ_PRIO_RADIO
+#define TASK_PRIO_LINK_LAYER                    CFG_SEQ_PRIO_RADIO
+#define TASK_PRIO_MAC_LAYER                     CFG_SEQ_PRIO_RADIO
+#define TASK_PRIO_TEMP_MEAS                     CFG_SEQ_PRIO_RADIO
+#define TASK_PRIO_ZIGBEE_LAYER                  CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_NETWORK_FORM           CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_APP_START              CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_BLE_HOST                      CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_TIMER_SERVER                  CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_SCM_GOVERNOR                  CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_HW_PKA                        CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_FLASH_MANAGER                 CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_SNVMA_CHECK                   CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_SNVMA_FLUSH                   CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_PERSISTENCE            CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_PERSIST_BATCH          CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_INSTALL_CODE           CFG_SEQ_PRIO_SYSTEM
+#define TASK_PRIO_ZIGBEE_JOIN_ADMISSION         CFG_SEQ_PRIO_SYSTEM
+#define CFG_TASK_PRIO_BUTTON_Bx                 CFG_SEQ_PRIO_APP
+#define TASK_PRIO_FUOTA_SEND                    CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_FANOUT                 CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_TRAFFIC                CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_HEALTH                 CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_BROADCAST              CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_CONCENTRATOR           CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_REPORT                 CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_OTA                    CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_POLL                   CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_TX_POWER               CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_CHANNEL                CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_COUNTER                CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_CSMA                   CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_STAGGER                CFG_SEQ_PRIO_APP
+#define TASK_PRIO_ZIGBEE_ZDD                    CFG_SEQ_PRIO_APP
+#define TASK_PRIO_HOST_PROTOCOL                 CFG_SEQ_PRIO_BACKGROUND
+#define TASK_PRIO_BLE_DIAG                      CFG_SEQ_PRIO_BACKGROUND
+#define TASK_PRIO_CRYPTO_BENCH                  CFG_SEQ_PRIO_BACKGROUND
+#define TASK_PRIO_NVM_BENCH                     CFG_SEQ_PRIO_BACKGROUND
 
 /* USER CODE END TASK_Priority_Define */
 
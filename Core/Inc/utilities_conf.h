@@ -107,6 +107,87 @@ extern "C" {
   */
 #define UTIL_SEQ_MEMSET8( dest, value, size )   UTIL_MEM_set_8( dest, value, size )
 
+/**
+  * @brief Sequencer task profiling and task budget, based on the DWT cycle counter
+  */
+#define UTIL_SEQ_CONF_PROFILING                 CFG_SEQ_PROFILING_SUPPORTED
+#define UTIL_SEQ_CONF_TASK_BUDGET               CFG_SEQ_TASK_BUDGET_SUPPORTED
+#define UTIL_SEQ_PROFILING_INIT( )              do { DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;   \
+                                                     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; } while(0)
+#define UTIL_SEQ_PROFILING_GET_TIME( )          ( DWT->CYCCNT )
+
+/**
+  * @brief Sequencer task start hook : wake-up to first task latency of the low power modes
+  */
+#if (CFG_LPM_LEVEL != 0)
+extern void PWR_WakeupTaskStart( void );
+#define UTIL_SEQ_TASK_START_HOOK( )             PWR_WakeupTaskStart( )
+#endif /* (CFG_LPM_LEVEL != 0) */
+
+/**
+  * @brief Sequencer task trace : ID of the running task on the debug GPIO run bus or the ITM run port
+  */
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+extern uint32_t APP_DEBUG_RunBusEnter( uint32_t code );
+extern void APP_DEBUG_RunBusExit( uint32_t previous );
+#define UTIL_SEQ_TASK_TRACE_ENTER( _ID_ )       APP_DEBUG_RunBusEnter( _ID_ )
+#define UTIL_SEQ_TASK_TRACE_EXIT( _PREVIOUS_ )  APP_DEBUG_RunBusExit( _PREVIOUS_ )
+#elif (CFG_RT_DEBUG_ITM != 0)
+extern uint32_t RT_DEBUG_ITMRunEnter( uint32_t code );
+extern void RT_DEBUG_ITMRunExit( uint32_t previous );
+#define UTIL_SEQ_TASK_TRACE_ENTER( _ID_ )       RT_DEBUG_ITMRunEnter( _ID_ )
+#define UTIL_SEQ_TASK_TRACE_EXIT( _PREVIOUS_ )  RT_DEBUG_ITMRunExit( _PREVIOUS_ )
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) */
+
+/**
+  * @brief Sequencer task end hook : stack high-water mark of the task
+  */
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+extern void APPE_STACK_TaskEnd( uint32_t lTaskIdx, uint32_t lNesting );
+#define UTIL_SEQ_TASK_END_HOOK( _ID_, _NESTING_ ) APPE_STACK_TaskEnd( _ID_, _NESTING_ )
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+
+/**
+  * @brief Sequencer priority check : radio priority level reserved to the radio tasks
+  */
+#if (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0)
+extern uint32_t APPE_SEQ_PrioViolation( uint64_t llTaskMask );
+#define UTIL_SEQ_TASK_PRIO_CHECK( _TASK_BM_, _PRIO_ ) \
+  ( ( ( (_PRIO_) == (uint32_t)CFG_SEQ_PRIO_RADIO ) && ( ( (_TASK_BM_) & ~CFG_SEQ_RADIO_TASKS ) != 0u ) ) \
+    ? APPE_SEQ_PrioViolation( _TASK_BM_ ) : (_PRIO_) )
+#endif /* (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0) */
+
+/**
+  * @brief Sequencer delayed and periodic tasks, based on the timer server
+  */
+#define UTIL_SEQ_CONF_DELAYED_TASK_NBR          CFG_SEQ_DELAYED_TASK_NBR
+
+/**
+  * @brief Sequencer task message queues
+  */
+#define UTIL_SEQ_CONF_MSG_QUEUE                 CFG_SEQ_MSG_QUEUE_SUPPORTED
+#define UTIL_SEQ_MSG_BARRIER( )                 __DMB()
+
+/**
+  * @brief Sequencer deferrable tasks, batched with the next wakeup
+  */
+#define UTIL_SEQ_CONF_DEFERRABLE                CFG_SEQ_DEFERRABLE_SUPPORTED
+#define UTIL_SEQ_CONF_DEFER_MAX_MS              CFG_SEQ_DEFER_MAX_DELAY
+
+/**
+  * @brief Sequencer deadline scheduling, deadlines in microseconds (time base continuing through the Stop modes)
+  */
+#define UTIL_SEQ_CONF_DEADLINE                  CFG_SEQ_DEADLINE_SUPPORTED
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+extern uint64_t TIMER_IF_GetTimeUs( void );
+#define UTIL_SEQ_DEADLINE_GET_TIME( )           ( (uint32_t)TIMER_IF_GetTimeUs( ) )
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+
+/**
+  * @brief Sequencer loop placed in SRAM with the other hot functions
+  */
+#define UTIL_SEQ_HOT_CODE                       HOT_CODE
+
 /**
   * @brief macro used to initialize the critical section
   */
@@ -134,16 +215,48 @@ extern "C" {
   */
 #define UTILS_EXIT_LIMITED_CRITICAL_SECTION()  __set_BASEPRI(basepri_value)
 
+/******************************************************************************
+  * advanced memory manager
+  ******************************************************************************/
+
+#define AMM_CONF_VIRTUAL_ID_MAX                    CFG_AMM_VIRTUAL_MEMORY_NUMBER         /*!< highest virtual memory ID */
+
+/******************************************************************************
+  * timer server
+  ******************************************************************************/
+
+#define UTIL_TIMER_CONF_MAX_TIMER_NBR              (56U)                                 /*!< timers created (52 with every module) */
+#define UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ         (4U)                                  /*!< expired timers processed per interrupt */
+#define UTIL_TIMER_CONF_STATS                      CFG_TIMER_STATS_SUPPORTED             /*!< callback lateness statistics */
+#define UTIL_TIMER_HOT_CODE                        HOT_CODE                              /*!< expiry processing placed in SRAM */
+
+/* Timer created above UTIL_TIMER_CONF_MAX_TIMER_NBR : logged, then Error_Handler() */
+extern void APPE_TIMER_CapacityError( void ( *callback )( void * ) );
+#define UTIL_TIMER_CAPACITY_ERROR( _CALLBACK_ )       APPE_TIMER_CapacityError( _CALLBACK_ )
+
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+/* Timer callback trace : ID of the running callback on the debug GPIO run bus */
+extern uint32_t APP_DEBUG_RunBusEnterTimer( void ( *callback )( void * ) );
+#define UTIL_TIMER_CALLBACK_TRACE_ENTER( _TIMER_ )    APP_DEBUG_RunBusEnterTimer( ( _TIMER_ )->Callback )
+#define UTIL_TIMER_CALLBACK_TRACE_EXIT( _PREVIOUS_ )  APP_DEBUG_RunBusExit( _PREVIOUS_ )
+#elif (CFG_RT_DEBUG_ITM != 0)
+/* Timer callback trace : address of the running callback on the ITM run port */
+#define UTIL_TIMER_CALLBACK_TRACE_ENTER( _TIMER_ )    RT_DEBUG_ITMRunEnter( (uint32_t)( _TIMER_ )->Callback )
+#define UTIL_TIMER_CALLBACK_TRACE_EXIT( _PREVIOUS_ )  RT_DEBUG_ITMRunExit( _PREVIOUS_ )
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) */
+
 /******************************************************************************
   * trace\advanced
   * the define option
   *    UTIL_ADV_TRACE_CONDITIONNAL shall be defined if you want use conditional function
   *    UTIL_ADV_TRACE_UNCHUNK_MODE shall be defined if you want use the unchunk mode
+  *    UTIL_ADV_TRACE_STATISTICS shall be set to 1 if you want the statistics of the fifo
   *
   ******************************************************************************/
 
 #define UTIL_ADV_TRACE_CONDITIONNAL                                                      /*!< not used */
 #define UTIL_ADV_TRACE_UNCHUNK_MODE                                                      /*!< not used */
+#define UTIL_ADV_TRACE_STATISTICS                  CFG_LOG_TRACE_STATS_SUPPORTED         /*!< fifo statistics */
 #define UTIL_ADV_TRACE_DEBUG(...)                                                        /*!< not used */
 #define UTIL_ADV_TRACE_INIT_CRITICAL_SECTION( )    UTILS_INIT_CRITICAL_SECTION()         /*!< init the critical section in trace feature */
 #define UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION( )   UTILS_ENTER_CRITICAL_SECTION()        /*!< enter the critical section in trace feature */
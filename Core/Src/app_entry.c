@@ -24,15 +24,48 @@
 #include "app_conf.h"
 #include "main.h"
 #include "app_zigbee.h"
+#include "app_zigbee_latency.h"
+#include "app_zigbee_traffic.h"
+#include "app_zigbee_health.h"
+#include "app_zigbee_broadcast.h"
+#include "app_zigbee_report.h"
+#include "app_zigbee_ota.h"
+#include "app_zigbee_ota_server.h"
+#include "app_zigbee_poll.h"
+#include "app_zigbee_txpower.h"
+#include "app_zigbee_csma.h"
+#include "app_zigbee_stagger.h"
+#include "app_zigbee_batch.h"
+#include "app_zigbee_zdd.h"
+#include "app_zigbee_channel.h"
+#include "app_zigbee_counter.h"
+#include "app_zigbee_timesync.h"
+#include "app_crypto_bench.h"
+#include "app_nvm_bench.h"
+#include "app_util_bench.h"
+#include "app_hse_tune.h"
+#include "app_supply.h"
+#include "app_host.h"
+#include "app_crash_log.h"
+#include "app_frame_log.h"
+#include "app_ble_diag.h"
+#include "app_zigbee_sniffer.h"
 #include "app_entry.h"
 #include "stm32_rtos.h"
 #if (CFG_LPM_LEVEL != 0)
 #include "app_sys.h"
 #include "stm32_lpm.h"
+#include "stm32_lpm_if.h"
 #endif /* (CFG_LPM_LEVEL != 0) */
 #include "stm32_timer.h"
 #include "advanced_memory_manager.h"
 #include "stm32_mm.h"
+#include "stm32_tlsf.h"
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+#include "flash_manager.h"
+#include "simple_nvm_arbiter.h"
+#include "simple_nvm_log.h"
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
 #if (CFG_LOG_SUPPORTED != 0)
 #include "stm32_adv_trace.h"
 #include "serial_cmd_interpreter.h"
@@ -46,6 +79,12 @@
 extern void ll_sys_mac_cntrl_init( void );
 /* USER CODE BEGIN Includes */
 #include "app_bsp.h"
+#include "timer_if.h"
+#include "zigbee_plat.h"
+#include "os_wrapper.h"
+#include "ll_sys_if.h"
+#include "mac_sys_if.h"
+#include "adc_ctrl.h"
 
 /* USER CODE END Includes */
 
@@ -68,6 +107,18 @@ extern void ll_sys_mac_cntrl_init( void );
 
 /* Private constants ---------------------------------------------------------*/
 /* USER CODE BEGIN PC */
+/* Each task has its own sequencer id : the TASK_xxx masks shall not overlap (their sum is their union) */
+#define APPE_SEQ_TASK_MASKS( _OP_ )   ( TASK_HW_RNG _OP_ TASK_LINK_LAYER _OP_ TASK_MAC_LAYER _OP_ TASK_ZIGBEE_LAYER     \
+  _OP_ TASK_ZIGBEE_NETWORK_FORM _OP_ TASK_ZIGBEE_APP_START _OP_ TASK_ZIGBEE_APP1 _OP_ TASK_ZIGBEE_APP2                \
+  _OP_ TASK_ZIGBEE_APP3 _OP_ TASK_ZIGBEE_APP4 _OP_ TASK_BSP_BUTTON_B1 _OP_ TASK_BSP_BUTTON_B2 _OP_ TASK_BSP_BUTTON_B3  \
+  _OP_ TASK_FLASH_MANAGER _OP_ TASK_ZIGBEE_PERSISTENCE _OP_ TASK_ZIGBEE_INSTALL_CODE _OP_ TASK_ZIGBEE_JOIN_ADMISSION  \
+  _OP_ TASK_ZIGBEE_FANOUT _OP_ TASK_ZIGBEE_TRAFFIC _OP_ TASK_ZIGBEE_HEALTH _OP_ TASK_ZIGBEE_BROADCAST                 \
+  _OP_ TASK_ZIGBEE_CONCENTRATOR _OP_ TASK_ZIGBEE_REPORT _OP_ TASK_ZIGBEE_OTA _OP_ TASK_ZIGBEE_POLL                    \
+  _OP_ TASK_ZIGBEE_TX_POWER _OP_ TASK_ZIGBEE_CHANNEL _OP_ TASK_TEMP_MEAS _OP_ TASK_HW_PKA )
+
+static_assert( (uint32_t)CFG_TASK_NBR <= UTIL_SEQ_CONF_TASK_NBR, "CFG_TASK_NBR exceeds UTIL_SEQ_CONF_TASK_NBR" );
+static_assert( ( 8u * sizeof( UTIL_SEQ_bm_t ) ) >= UTIL_SEQ_CONF_TASK_NBR, "UTIL_SEQ_bm_t too narrow for the tasks" );
+static_assert( APPE_SEQ_TASK_MASKS( | ) == APPE_SEQ_TASK_MASKS( + ), "Two TASK_xxx masks share a sequencer task id" );
 
 /* USER CODE END PC */
 
@@ -116,12 +167,64 @@ static AMM_InitParameters_t ammInitConfig =
   .p_VirtualMemoryConfigList = vmConfig
 };
 
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+static UTIL_TIMER_Object_t  stAmmRebalanceTimer;
+static uint32_t             lAmmRebalanceNb;          /* Rebalances done */
+static uint32_t             lAmmRebalanceFailedNb;    /* Resizes refused by the AMM */
+static uint32_t             lAmmReleasedSize;         /* words, taken from the ZIGBEE_INIT reservation */
+static uint32_t             lAmmGrantedSize;          /* words, added to the ZIGBEE_HEAP reservation */
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+/* Pool of the transient buffers, in SRAM not retained in Standby */
+static uint32_t alScratchPool[DIVC(CFG_SRAM_SCRATCH_POOL_SIZE, sizeof(uint32_t))] PLACE_IN_SECTION(".ram_scratch");
+static uint32_t lScratchBufferNb;
+static uint32_t lScratchBufferPeakNb;
+static uint32_t lScratchFallbackNb;
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+
 
 /* USER CODE BEGIN PV */
 
 /* USER CODE END PV */
 
 /* Global variables ----------------------------------------------------------*/
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+/* Configuration of the NVMs used by the Simple NVM Arbiter */
+SNVMA_NvmElt_t SNVMA_NvmConfiguration[SNVMA_NVM_NUMBER] =
+{
+  {
+    .BankNumber = SNVMA_NVM_ID_1_BANK_NUMBER,
+    .BankSize = SNVMA_NVM_ID_1_BANK_SIZE,
+    .CoalescingDelay = SNVMA_NVM_ID_1_COALESCING_DELAY,
+    .MaxLatency = SNVMA_NVM_ID_1_MAX_LATENCY,
+  },
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+  {
+    .BankNumber = SNVMA_NVM_ID_2_BANK_NUMBER,
+    .BankSize = SNVMA_NVM_ID_2_BANK_SIZE,
+    .CoalescingDelay = SNVMA_NVM_ID_2_COALESCING_DELAY,
+    .MaxLatency = SNVMA_NVM_ID_2_MAX_LATENCY,
+  },
+  {
+    .BankNumber = SNVMA_NVM_ID_3_BANK_NUMBER,
+    .BankSize = SNVMA_NVM_ID_3_BANK_SIZE,
+    .CoalescingDelay = SNVMA_NVM_ID_3_COALESCING_DELAY,
+    .MaxLatency = SNVMA_NVM_ID_3_MAX_LATENCY,
+  },
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
+};
+
+#if (SNVMA_NUMBER_OF_SECTOR_NEEDED > CFG_SNVMA_SECTOR_NB)
+#error "The NVMs of simple_nvm_arbiter_conf.h need more flash pages than CFG_SNVMA_SECTOR_NB"
+#endif /* (SNVMA_NUMBER_OF_SECTOR_NEEDED > CFG_SNVMA_SECTOR_NB) */
+
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0) && (SNVMA_WRITE_COALESCING_DELAY != 0u)
+/* One shot timer closing the coalescing window of the Simple NVM Arbiter writes */
+static UTIL_TIMER_Object_t  SNVMA_FlushTimer;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0) && (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
 /* USER CODE BEGIN GV */
 
 /* USER CODE END GV */
@@ -131,13 +234,68 @@ static void System_Init( void );
 static void SystemPower_Config( void );
 static void Config_HSE(void);
 static void APPE_RNG_Init( void );
+#if (CFG_HW_PKA_ASYNC_SUPPORTED != 0)
+static void APPE_PKA_Init( void );
+#endif /* (CFG_HW_PKA_ASYNC_SUPPORTED != 0) */
 
 static void APPE_AMM_Init(void);
 static void AMM_WrapperInit(uint32_t * const p_PoolAddr, const uint32_t PoolSize);
 static uint32_t * AMM_WrapperAllocate(const uint32_t BufferSize);
 static void AMM_WrapperFree(uint32_t * const p_BufferAddr);
+static uint32_t AMM_WrapperGetLargestFreeBlock(void);
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+static void APPE_NVM_Init(void);
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0)
+static void APPE_NVM_CheckTask(void);
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+static void APPE_NVM_FlushTask(void);
+static void APPE_NVM_FlushTimerCallback(void * arg);
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+#if (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT)
+static uint32_t APPE_LOG_GetTimeStampUs(void);
+#endif /* (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT) */
 
 /* USER CODE BEGIN PFP */
+#if (CFG_LOG_SUPPORTED != 0)
+static bool APPE_LOG_SerialCmdExecute( const char * szCommand );
+static void APPE_SerialCmdInit( void );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+#if (CFG_LPM_LEVEL != 0)
+static void APPE_LPM_DeadlinePolicy(void);
+static void APPE_LPM_EnterMeasure(void);
+static void APPE_LPM_CostUpdate(void);
+#endif /* (CFG_LPM_LEVEL != 0) */
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+static bool APPE_COEX_SerialCmdExecute( const char * szCommand );
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+static void APPE_AMM_RebalanceTimerCallback(void * arg);
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+static void APPE_STACK_MonitorInit(void);
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+#if (CFG_ICACHE_STATS_SUPPORTED != 0)
+static void APPE_ICACHE_StatsInit(void);
+#endif /* (CFG_ICACHE_STATS_SUPPORTED != 0) */
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+static void APPE_LOAD_Init(void);
+static void APPE_LOAD_IdleEnter(void);
+static void APPE_LOAD_IdleExit(void);
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+static void APPE_CLK_GovernorInit(void);
+static void APPE_CLK_GovernorTask(void);
+static void APPE_CLK_GovernorTimerCallback(void * arg);
+static void APPE_CLK_Request(scm_clockconfig_t eClock);
+static void APPE_CLK_SwitchDone(scm_clockconfig_t eClock);
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+static void APPE_RUNBUS_Print(void);
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) */
 
 /* USER CODE END PFP */
 
@@ -176,31 +334,119 @@ uint32_t MX_APPE_Init(void *p_param)
 
   UNUSED(p_param);
 
+  /* Sequencer initialization, before any task registration */
+  UTIL_SEQ_Init();
+
+#if (CFG_BOOT_PARALLEL_INIT_SUPPORTED != 0)
+  /* Launch the slow hardware settling, completed where it is first needed */
+  HW_RNG_StartAsync();
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  (void)ADCCTRL_WarmUp();
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+#endif /* (CFG_BOOT_PARALLEL_INIT_SUPPORTED != 0) */
+
   /* System initialization */
   System_Init();
+  APPE_BOOT_Mark( APPE_BOOT_SYSTEM_INIT );
 
   /* Configure the system Power Mode */
   SystemPower_Config();
+  APPE_BOOT_Mark( APPE_BOOT_POWER_CONFIG );
 
   /* Initialize the Advance Memory Manager module */
   APPE_AMM_Init();
+  APPE_BOOT_Mark( APPE_BOOT_AMM_INIT );
 
   /* Initialize the Random Number Generator module */
   APPE_RNG_Init();
 
+#if (CFG_HW_PKA_ASYNC_SUPPORTED != 0)
+  /* Initialize the asynchronous PKA jobs */
+  APPE_PKA_Init();
+#endif /* (CFG_HW_PKA_ASYNC_SUPPORTED != 0) */
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  /* Initialize the load-driven system clock request */
+  APPE_CLK_GovernorInit();
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+  /* Initialize the periodic scan of the stack */
+  APPE_STACK_MonitorInit();
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+
+#if (CFG_ICACHE_STATS_SUPPORTED != 0)
+  /* Start the hit and miss monitors of the ICACHE */
+  APPE_ICACHE_StatsInit();
+#endif /* (CFG_ICACHE_STATS_SUPPORTED != 0) */
+
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  /* Initialize the CPU load meter */
+  APPE_LOAD_Init();
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+  /* Initialize the Flash Manager and the Simple NVM Arbiter modules */
+  APPE_NVM_Init();
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
   /* USER CODE BEGIN APPE_Init_1 */
   /* Initialize Peripherals */
   APP_BSP_Init();
 
+  /* Image activated by a bank swap : confirm it, or swap back after too many resets on trial */
+  APP_ZIGBEE_OtaBootCheck();
+
+  /* Initialize the crypto micro-benchmarks (CRYPTOBENCH) */
+  APP_CRYPTO_BenchInit();
+
+  /* Initialize the persistence benchmark (NVMBENCH) */
+  APP_NVM_BenchInit();
+
+  /* Initialize the timer server and memory manager benchmarks (UTILBENCH) */
+  APP_UTIL_BenchInit();
+
+  /* Apply the HSE stabilization delay tuned on this device (HSESTATS) */
+  APP_HSE_TuneInit();
+
+  /* Monitor the supply voltage by ADC batches (VDDSTATS) */
+  APP_SUPPLY_Init();
+
+  APPE_BOOT_Mark( APPE_BOOT_MODULES_INIT );
+
   /* USER CODE END APPE_Init_1 */
 
+#if (CFG_BOOT_PARALLEL_INIT_SUPPORTED != 0)
+  /* The link layer is the first user of the random numbers */
+  HW_RNG_WaitPool();
+#endif /* (CFG_BOOT_PARALLEL_INIT_SUPPORTED != 0) */
+
   /* Initialization of the low level : link layer and MAC */
   MX_APPE_LinkLayerInit();
+  APPE_BOOT_Mark( APPE_BOOT_LINK_LAYER_INIT );
 
+#if (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0)
+  /* Initialization of the 802.15.4 sniffer, instead of the Zigbee Application */
+  APP_ZIGBEE_SnifferInit();
+#else /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
   /* Initialization of the Zigbee Application */
   APP_ZIGBEE_ApplicationInit();
+#endif /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
 
   /* USER CODE BEGIN APPE_Init_2 */
+  /* Save the crash log of the previous run, then capture the logs of this one */
+  APP_CRASH_LOG_Init();
+  APP_FRAME_LOG_Init();
+
+  /* Export of the diagnostics over BLE (after the crash log : its capture is chained) */
+  APP_BLE_DIAG_Init();
+
+#if (CFG_SEQ_TASK_BUDGET_SUPPORTED != 0)
+  /* Warn about any task that runs longer than its budget */
+  UTIL_SEQ_SetTaskBudget( UTIL_SEQ_DEFAULT, ( CFG_SEQ_TASK_BUDGET_US * ( SystemCoreClock / 1000000u ) ) );
+#endif /* (CFG_SEQ_TASK_BUDGET_SUPPORTED != 0) */
+
+  APPE_BOOT_Mark( APPE_BOOT_APPE_INIT );
 
   /* USER CODE END APPE_Init_2 */
 
@@ -213,14 +459,1655 @@ void MX_APPE_Process(void)
 {
   /* USER CODE BEGIN MX_APPE_Process_1 */
 
-  /* USER CODE END MX_APPE_Process_1 */
-  UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
-  /* USER CODE BEGIN MX_APPE_Process_2 */
+  /* USER CODE END MX_APPE_Process_1 */
+  UTIL_SEQ_Run(UTIL_SEQ_DEFAULT);
+  /* USER CODE BEGIN MX_APPE_Process_2 */
+
+  /* USER CODE END MX_APPE_Process_2 */
+}
+
+/* USER CODE BEGIN FD */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+/**
+ * @brief   Print the execution statistics of all the registered sequencer tasks.
+ */
+void APPE_SEQ_PrintStats(void)
+{
+  UTIL_SEQ_TaskStats_t  stStats;
+  uint32_t              lTaskIdx;
+  uint32_t              lAverage;
+
+  LOG_INFO_SYSTEM( "Sequencer statistics (in CPU cycles) :" );
+  for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+  {
+    if ( ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lTaskIdx ), &stStats ) != 0u ) && ( stStats.CallCount != 0u ) )
+    {
+      lAverage = (uint32_t)( stStats.TotalTime / stStats.CallCount );
+      LOG_INFO_SYSTEM( "Task %2d : calls %u, avg %u, max %u, last %u, max latency %u", lTaskIdx, stStats.CallCount,
+                       lAverage, stStats.MaxTime, stStats.LastTime, stStats.MaxLatency );
+      LOG_INFO_SYSTEM( "  latency histo : %u %u %u %u %u %u %u %u", stStats.LatencyHisto[0], stStats.LatencyHisto[1],
+                       stStats.LatencyHisto[2], stStats.LatencyHisto[3], stStats.LatencyHisto[4],
+                       stStats.LatencyHisto[5], stStats.LatencyHisto[6], stStats.LatencyHisto[7] );
+    }
+  }
+}
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+/**
+ * @brief   Print the deadline statistics of the sequencer tasks set with a deadline.
+ */
+void APPE_SEQ_PrintDeadlines(void)
+{
+  UTIL_SEQ_DeadlineStats_t  stStats;
+  uint32_t                  lTaskIdx;
+
+  LOG_INFO_SYSTEM( "Sequencer deadlines :" );
+  for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+  {
+    if ( ( UTIL_SEQ_GetDeadlineStats( UTIL_SEQ_TASK_BM( lTaskIdx ), &stStats ) != 0u ) && ( stStats.RunCount != 0u ) )
+    {
+      LOG_INFO_SYSTEM( "Task %2d : runs %u, missed %u, max lateness %u us", lTaskIdx, stStats.RunCount,
+                       stStats.MissCount, stStats.MaxLateness );
+    }
+  }
+}
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+
+#if (CFG_SEQ_RADIO_YIELD_SUPPORTED != 0)
+/**
+ * @brief   Preemption point of a long application task : the pending link layer and MAC tasks are run now.
+ */
+void APPE_SEQ_YieldToRadio(void)
+{
+  UTIL_SEQ_Yield( TASK_LINK_LAYER | TASK_MAC_LAYER );
+}
+#endif /* (CFG_SEQ_RADIO_YIELD_SUPPORTED != 0) */
+
+#if (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0)
+static uint32_t               lSeqPrioViolationCount;
+static uint64_t               llSeqPrioViolationMask;   /* Tasks already set at the radio priority */
+
+/**
+ * @brief   Called by the sequencer when a task out of CFG_SEQ_RADIO_TASKS is set at the radio priority : it is run
+ *          at the system priority instead, and a warning is logged the first time for each task.
+ * @param   llTaskMask  Tasks set (TASK_xxx).
+ * @return  Priority to use.
+ */
+uint32_t APPE_SEQ_PrioViolation(uint64_t llTaskMask)
+{
+  uint64_t  llNewTasks;
+
+  llTaskMask &= ~(uint64_t)CFG_SEQ_RADIO_TASKS;
+  llNewTasks = llTaskMask & ~llSeqPrioViolationMask;
+  llSeqPrioViolationMask |= llTaskMask;
+  lSeqPrioViolationCount++;
+
+  if ( llNewTasks != 0u )
+  {
+    LOG_WARNING_SYSTEM( "Sequencer tasks 0x%08X%08X set at the radio priority, run at the system priority",
+                        (uint32_t)( llNewTasks >> 32u ), (uint32_t)llNewTasks );
+  }
+
+  return (uint32_t)CFG_SEQ_PRIO_SYSTEM;
+}
+
+/**
+ * @brief   Print the priority classes and the tasks that were set in the radio class.
+ */
+void APPE_SEQ_PrintPrio(void)
+{
+  LOG_INFO_SYSTEM( "Sequencer priorities : radio %d, system %d, application %d, background %d (of %d)",
+                   CFG_SEQ_PRIO_RADIO, CFG_SEQ_PRIO_SYSTEM, CFG_SEQ_PRIO_APP, CFG_SEQ_PRIO_BACKGROUND, CFG_SEQ_PRIO_NBR );
+  LOG_INFO_SYSTEM( "  radio tasks 0x%08X%08X, violations %u (tasks 0x%08X%08X)",
+                   (uint32_t)( (uint64_t)CFG_SEQ_RADIO_TASKS >> 32u ), (uint32_t)CFG_SEQ_RADIO_TASKS,
+                   lSeqPrioViolationCount, (uint32_t)( llSeqPrioViolationMask >> 32u ), (uint32_t)llSeqPrioViolationMask );
+}
+#endif /* (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0) */
+
+/**
+ * @brief   Called by the timer server when a timer is created above UTIL_TIMER_CONF_MAX_TIMER_NBR timers (or a timer
+ *          not created is started with the heap full) : the timer would never expire, so the configuration is fixed
+ *          rather than run without it.
+ * @param   callback  Callback of the timer.
+ */
+void APPE_TIMER_CapacityError(void ( *callback )( void * ))
+{
+  LOG_ERROR_SYSTEM( "Timer 0x%08X not created : more than %d timers, raise UTIL_TIMER_CONF_MAX_TIMER_NBR",
+                    (uint32_t)callback, UTIL_TIMER_CONF_MAX_TIMER_NBR );
+  Error_Handler();
+}
+
+#if (CFG_SEQ_TASK_BUDGET_SUPPORTED != 0)
+/**
+ * @brief   Called by the sequencer when a task has run longer than its budget.
+ * @param   TaskIdx       Index of the task (CFG_TASK_xxx).
+ * @param   ElapsedTime   Execution time of the task in CPU cycles.
+ */
+void UTIL_SEQ_TaskOverBudget( uint32_t TaskIdx, uint32_t ElapsedTime )
+{
+  LOG_WARNING_SYSTEM( "Sequencer task %d ran for %u us (budget %u us)", TaskIdx,
+                      ( ElapsedTime / ( SystemCoreClock / 1000000u ) ), CFG_SEQ_TASK_BUDGET_US );
+}
+#endif /* (CFG_SEQ_TASK_BUDGET_SUPPORTED != 0) */
+
+#if (CFG_TIMER_STATS_SUPPORTED != 0)
+/**
+ * @brief   Print the callback lateness statistics of all the running timers.
+ */
+void APPE_TIMER_PrintStats(void)
+{
+  UTIL_TIMER_Object_t * pTimerList[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+  UTIL_TIMER_Stats_t    stStats;
+  uint32_t              lTimerNbr;
+  uint32_t              lIndex;
+  uint32_t              lMean;
+
+  lTimerNbr = UTIL_TIMER_GetRunningTimers( pTimerList, UTIL_TIMER_CONF_MAX_TIMER_NBR );
+
+  LOG_INFO_SYSTEM( "Timer statistics (lateness in us) :" );
+  for ( lIndex = 0u; lIndex < lTimerNbr; lIndex++ )
+  {
+    if ( ( UTIL_TIMER_GetStats( pTimerList[lIndex], &stStats ) == UTIL_TIMER_OK ) && ( stStats.Count != 0u ) )
+    {
+      lMean = (uint32_t)( stStats.TotalLateness / stStats.Count );
+      LOG_INFO_SYSTEM( "Timer %p : calls %u, min %u, max %u, mean %u", (void *)pTimerList[lIndex]->Callback, stStats.Count,
+                       TIMER_IF_Convert_Tick2us( stStats.MinLateness ), TIMER_IF_Convert_Tick2us( stStats.MaxLateness ),
+                       TIMER_IF_Convert_Tick2us( lMean ) );
+    }
+  }
+}
+#endif /* (CFG_TIMER_STATS_SUPPORTED != 0) */
+
+#if (CFG_HEAP_DIAG_SUPPORTED != 0)
+/**
+ * @brief   Print the fragmentation of the AMM pool and the occupation of each virtual memory.
+ */
+void APPE_HEAP_PrintStats(void)
+{
+  AMM_VirtualMemoryStats_t  stAmmStats;
+  ZigbeePlatHeapStats_t     stZbStats;
+  AMM_RetryStats_t          stRetryStats;
+  uint32_t                  lId;
+#if (CFG_AMM_BMM_TLSF_SUPPORTED == 0)
+  UTIL_MM_HeapStats_t       stHeapStats;
+
+  /* Walk of all the blocks, done in critical section to get a coherent view */
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+    UTIL_MM_GetHeapStats( &stHeapStats );
+    UTILS_EXIT_CRITICAL_SECTION();
+  }
+
+  LOG_INFO_SYSTEM( "Heap : free %u bytes (min %u), largest block %u, %u free blocks, %u used blocks", stHeapStats.FreeBytes,
+                   stHeapStats.MinimumEverFreeBytes, stHeapStats.LargestFreeBlock, stHeapStats.FreeBlockNbr, stHeapStats.UsedBlockNbr );
+  LOG_INFO_SYSTEM( "  free blocks histo (<32 ... >=4096) : %u %u %u %u %u %u %u %u %u", stHeapStats.FreeBlockHisto[0],
+                   stHeapStats.FreeBlockHisto[1], stHeapStats.FreeBlockHisto[2], stHeapStats.FreeBlockHisto[3],
+                   stHeapStats.FreeBlockHisto[4], stHeapStats.FreeBlockHisto[5], stHeapStats.FreeBlockHisto[6],
+                   stHeapStats.FreeBlockHisto[7], stHeapStats.FreeBlockHisto[8] );
+#else /* (CFG_AMM_BMM_TLSF_SUPPORTED == 0) */
+  uint32_t                  lLargestFreeBlock = 0u;
+
+  (void)AMM_GetLargestFreeBlock( &lLargestFreeBlock );
+  LOG_INFO_SYSTEM( "Heap : largest block %u", ( lLargestFreeBlock * sizeof( uint32_t ) ) );
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED == 0) */
+
+  for ( lId = 0u; lId <= AMM_CONF_VIRTUAL_ID_MAX; lId++ )
+  {
+    if ( AMM_GetVirtualMemoryStats( (uint8_t)lId, &stAmmStats ) == AMM_ERROR_OK )
+    {
+      LOG_INFO_SYSTEM( "Virtual memory %d : occupied %u bytes, available %u bytes", lId,
+                       ( stAmmStats.OccupiedSize * sizeof( uint32_t ) ), ( stAmmStats.AvailableSize * sizeof( uint32_t ) ) );
+    }
+
+    if ( AMM_GetRetryStats( (uint8_t)lId, &stRetryStats ) == AMM_ERROR_OK )
+    {
+      LOG_INFO_SYSTEM( "  %u failed allocations, %u retries queued", stRetryStats.AllocFailedNbr, stRetryStats.CallbackQueuedNbr );
+    }
+
+    if ( ZIGBEE_PLAT_GetHeapStats( (uint8_t)lId, &stZbStats ) == true )
+    {
+      LOG_INFO_SYSTEM( "  Zigbee heap : used %u bytes, peak %u bytes, %u buffers, %u failures", stZbStats.lUsedSize,
+                       stZbStats.lPeakSize, stZbStats.lAllocNbr, stZbStats.lAllocFailedNbr );
+    }
+  }
+
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+  LOG_INFO_SYSTEM( "Scratch pool : %u buffers (peak %u), largest block %u bytes, %u taken from the AMM pool",
+                   lScratchBufferNb, lScratchBufferPeakNb,
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+                   (uint32_t)UTIL_MM_GetLargestFreeBlock(),
+#else
+                   (uint32_t)UTIL_TLSF_GetLargestFreeBlock(),
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
+                   lScratchFallbackNb );
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+}
+#endif /* (CFG_HEAP_DIAG_SUPPORTED != 0) */
+
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the radio ISRs (in us), then reset them.
+ */
+void APPE_LL_ISR_PrintStats(void)
+{
+  LINKLAYER_PLAT_IsrStats_t   stStats;
+  uint32_t                    lCyclePerUs = ( SystemCoreClock / 1000000u );
+
+  LINKLAYER_PLAT_GetIsrStats( &stStats );
+  LINKLAYER_PLAT_ResetIsrStats();
+
+  LOG_INFO_SYSTEM( "Radio ISR : calls %u, avg %u, max %u, %u delayed by a critical section", stStats.HighCount,
+                   ( stStats.HighCount != 0u ) ? (uint32_t)( stStats.HighTotalDuration / stStats.HighCount ) / lCyclePerUs : 0u,
+                   stStats.HighMaxDuration / lCyclePerUs, stStats.HighDelayedCount );
+  LOG_INFO_SYSTEM( "SW low ISR : calls %u, avg %u, max %u, max latency %u, %u re-triggers, %u handoffs", stStats.LowCount,
+                   ( stStats.LowCount != 0u ) ? (uint32_t)( stStats.LowTotalDuration / stStats.LowCount ) / lCyclePerUs : 0u,
+                   stStats.LowMaxDuration / lCyclePerUs, stStats.LowMaxLatency / lCyclePerUs, stStats.LowRetriggerCount,
+                   stStats.LowHandoffCount );
+  LOG_INFO_SYSTEM( "Max nesting %u, longest critical section %u by 0x%08X", stStats.MaxNesting,
+                   stStats.IrqOffMaxDuration / lCyclePerUs, stStats.IrqOffMaxCaller );
+}
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+
+#if (CFG_ICACHE_STATS_SUPPORTED != 0)
+/* Bounds of the functions copied in RAM (linker script) */
+extern uint8_t  _sramfunc[];
+extern uint8_t  _eramfunc[];
+
+/**
+ * @brief   Reset and start the hit and miss monitors of the ICACHE (enabled by MX_ICACHE_Init()).
+ */
+static void APPE_ICACHE_StatsInit(void)
+{
+  (void)HAL_ICACHE_Monitor_Reset( ICACHE_MONITOR_HIT_MISS );
+  (void)HAL_ICACHE_Monitor_Start( ICACHE_MONITOR_HIT_MISS );
+}
+
+/**
+ * @brief   Print the hits and misses of the ICACHE since the last call, then restart the counting.
+ */
+void APPE_ICACHE_PrintStats(void)
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t  lHits, lMisses, lRatio;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  (void)HAL_ICACHE_Monitor_Stop( ICACHE_MONITOR_HIT_MISS );
+#if (CFG_LOG_SUPPORTED != 0)
+  lHits = HAL_ICACHE_Monitor_GetHitValue();
+  lMisses = HAL_ICACHE_Monitor_GetMissValue();
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  (void)HAL_ICACHE_Monitor_Reset( ICACHE_MONITOR_HIT_MISS );
+  (void)HAL_ICACHE_Monitor_Start( ICACHE_MONITOR_HIT_MISS );
+
+#if (CFG_LOG_SUPPORTED != 0)
+  /* Ratio in 0.1 %, the miss counter saturates at 0xFFFF */
+  lRatio = 0u;
+  if ( ( lHits + lMisses ) != 0u )
+  {
+    lRatio = (uint32_t)( ( (uint64_t)lHits * 1000u ) / ( (uint64_t)lHits + lMisses ) );
+  }
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_SYSTEM( "ICACHE : hits %u, misses %u%s, hit ratio %u.%u %%", lHits, lMisses,
+                   ( lMisses == 0xFFFFu ) ? " (saturated)" : "", lRatio / 10u, lRatio % 10u );
+  LOG_INFO_SYSTEM( "Code in RAM : %u bytes", (uint32_t)( _eramfunc - _sramfunc ) );
+}
+#endif /* (CFG_ICACHE_STATS_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the Simple NVM Log (persistence data).
+ */
+void APPE_NVM_PrintStats(void)
+{
+  SNVML_Stats_t   stStats;
+
+  SNVML_GetStats( &stStats );
+
+  LOG_INFO_SYSTEM( "NVM log : page %u, %u free records, %u records written, %u commits", stStats.Page, stStats.FreeSlots,
+                   stStats.RecordWrites, stStats.CommitWrites );
+  LOG_INFO_SYSTEM( "  %u erases, %u compactions, %u failures", stStats.Erases, stStats.Compactions, stStats.Failures );
+}
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+
+/**
+ * @brief   Print the statistics of the radio time windows (times in us) and of the queues of the Flash Manager.
+ */
+void APPE_FLASH_PrintStats(void)
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  static const char * const   szPriority[FM_PRIORITY_NUMBER] = { "NVM", "OTA", "LOG" };
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  FM_WindowStats_t  stStats;
+  FM_QueueStats_t   stQueueStats;
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t          lEfficiency = 0u;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  FM_GetWindowStats( &stStats );
+
+#if (CFG_LOG_SUPPORTED != 0)
+  if ( stStats.GrantedTime != 0u )
+  {
+    lEfficiency = (uint32_t)( ( (uint64_t)stStats.UsedTime * 100u ) / stStats.GrantedTime );
+  }
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_SYSTEM( "Flash windows : %u granted, %u us granted, %u us used (%u%%)", stStats.WindowCount,
+                   stStats.GrantedTime, stStats.UsedTime, lEfficiency );
+  LOG_INFO_SYSTEM( "  %u quad-words (%u us each), %u sectors (%u us each)", stStats.QuadWords, stStats.ProgramTime,
+                   stStats.Sectors, stStats.EraseTime );
+  LOG_INFO_SYSTEM( "  Wait for the windows : %u us (max %u us)", stStats.WaitTime, stStats.MaxWaitTime );
+
+  for ( uint8_t cPriority = 0u; cPriority < (uint8_t)FM_PRIORITY_NUMBER; cPriority++ )
+  {
+    FM_GetQueueStats( (FM_Priority_t)cPriority, &stQueueStats );
+    LOG_INFO_SYSTEM( "  Queue %s : %u queued, %u rejected, depth %u (max %u)", szPriority[cPriority], stQueueStats.Queued,
+                     stQueueStats.Rejected, stQueueStats.Depth, stQueueStats.MaxDepth );
+  }
+}
+
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+/**
+ * @brief   Print the cost of the crypto entry points since the last dump (times in us), then reset it.
+ */
+void APPE_CRYPTO_PrintStats(void)
+{
+  static const char * const   szOperation[ZIGBEE_PLAT_CRYPTO_NBR] =
+  {
+    "RngGet", "RngProcess", "AesEcbEncrypt", "AesCmacSetKey", "AesCmacSetVector", "AesCrypt32", "AesCrypt",
+    "AesCmacCompute", "AesMmoHash", "AesCcmCrypt", "Stack AES block"
+  };
+  static uint32_t             lLastTick = 0u;
+  ZigbeePlatCryptoStats_t     stStats;
+  uint32_t                    lCyclePerUs = ( SystemCoreClock / 1000000u );
+  uint32_t                    lElapsedMs, lTick;
+  uint64_t                    llTotalCycles = 0u;
+  uint8_t                     cOperation;
+
+  lTick = HAL_GetTick();
+  lElapsedMs = lTick - lLastTick;
+  if ( lElapsedMs == 0u )
+  {
+    lElapsedMs = 1u;
+  }
+
+  LOG_INFO_SYSTEM( "Crypto cost over %u ms (calls, calls/s, avg, max, total) :", lElapsedMs );
+  for ( cOperation = 0u; cOperation < (uint8_t)ZIGBEE_PLAT_CRYPTO_NBR; cOperation++ )
+  {
+    (void)ZIGBEE_PLAT_GetCryptoStats( cOperation, &stStats );
+    if ( stStats.lCallNbr != 0u )
+    {
+      LOG_INFO_SYSTEM( "  %s : %u, %u, %u, %u, %u", szOperation[cOperation], stStats.lCallNbr,
+                       (uint32_t)( ( (uint64_t)stStats.lCallNbr * 1000u ) / lElapsedMs ),
+                       (uint32_t)( stStats.llTotalCycles / stStats.lCallNbr ) / lCyclePerUs,
+                       stStats.lMaxCycles / lCyclePerUs, (uint32_t)( stStats.llTotalCycles / lCyclePerUs ) );
+      llTotalCycles += stStats.llTotalCycles;
+    }
+  }
+
+  /* Share of the CPU time in per mille */
+  LOG_INFO_SYSTEM( "  CPU share %u per mille", (uint32_t)( llTotalCycles / ( (uint64_t)lElapsedMs * lCyclePerUs ) ) );
+
+  ZIGBEE_PLAT_ResetCryptoStats();
+  lLastTick = lTick;
+}
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the delays requested by the link layer.
+ */
+void APPE_LL_DELAY_PrintStats(void)
+{
+  LINKLAYER_PLAT_DelayStats_t   stStats;
+
+  LINKLAYER_PLAT_GetDelayStats( &stStats );
+
+  LOG_INFO_SYSTEM( "Link layer delays : %u calls (%u timed in WFE), %u us in total, max %u us",
+                   stStats.Count, stStats.TimerCount, (uint32_t)stStats.TotalDelay, stStats.MaxDelay );
+}
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the link layer background task.
+ */
+void APPE_LL_BG_PrintStats(void)
+{
+  LL_SYS_BgStats_t    stStats;
+
+  ll_sys_bg_get_stats( &stStats );
+
+  LOG_INFO_SYSTEM( "Link layer task : %u posts, %u requests coalesced, %u runs, %u iterations (max %u per run), %u budgets exceeded",
+                   stStats.PostCount, stStats.CoalescedCount, stStats.RunCount, stStats.IterationCount,
+                   stStats.MaxIterations, stStats.BudgetExceededCount );
+}
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+/**
+ * @brief   Print the radio counters of the MAC, over the last interval and since the start.
+ */
+void APPE_MAC_PrintStats(void)
+{
+  MAC_SYS_Stats_t     stStats;
+#if (CFG_LOG_SUPPORTED != 0)
+  MAC_SYS_Counters_t  * pstCounters;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  uint8_t             cIndex;
+
+  MacSys_GetStats( &stStats );
+
+  for ( cIndex = 0; cIndex < 2u; cIndex++ )
+  {
+#if (CFG_LOG_SUPPORTED != 0)
+    pstCounters = ( cIndex == 0u ) ? &stStats.Interval : &stStats.Total;
+    LOG_INFO_SYSTEM( "MAC %s : TX %u (ok %u, CCA fail %u, no ACK %u, error %u), RX %u (FCS error %u, error %u)",
+                     ( ( cIndex == 0u ) ? "last interval" : "total" ), pstCounters->TxCount, pstCounters->TxSuccessCount,
+                     pstCounters->TxCcaFailCount, pstCounters->TxNoAckCount, pstCounters->TxErrorCount,
+                     pstCounters->RxCount, pstCounters->RxCrcErrorCount, pstCounters->RxErrorCount );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  }
+
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  {
+    MAC_SYS_BufferStats_t   stBufferStats;
+
+    MacSys_GetBufferStats( &stBufferStats );
+    LOG_INFO_SYSTEM( "MAC buffers : %u allocated, %u failed, small %u/%u peak (%u bytes), large %u/%u peak (%u bytes)",
+                     stBufferStats.AllocCount, stBufferStats.AllocFailCount, stBufferStats.SmallPeak,
+                     stBufferStats.SmallTotal, stBufferStats.SmallSize, stBufferStats.LargePeak,
+                     stBufferStats.LargeTotal, stBufferStats.LargeSize );
+    for ( cIndex = 0; cIndex < stBufferStats.QueueNb; cIndex++ )
+    {
+      LOG_INFO_SYSTEM( "MAC queue %u (0x%08X) : %u/%u peak, %u enqueued, %u refused", cIndex,
+                       (uint32_t)stBufferStats.Queues[cIndex].Queue, stBufferStats.Queues[cIndex].Peak,
+                       stBufferStats.Queues[cIndex].Capacity, stBufferStats.Queues[cIndex].EnqueueCount,
+                       stBufferStats.Queues[cIndex].EnqueueFailCount );
+    }
+    if ( stBufferStats.QueueUntrackedNb != 0u )
+    {
+      LOG_INFO_SYSTEM( "MAC queues : %u enqueues on untracked queues", stBufferStats.QueueUntrackedNb );
+    }
+  }
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  {
+    MAC_SYS_SrcMatchStats_t stSrcMatchStats;
+
+    MacSys_GetSrcMatchStats( &stSrcMatchStats );
+    LOG_INFO_SYSTEM( "MAC source match : %u indirect frames followed, %u held (%u peak, %u max), %u overflows%s",
+                     stSrcMatchStats.FrameCount, stSrcMatchStats.Pending, stSrcMatchStats.PendingPeak,
+                     CFG_MAC_SRC_MATCH_FRAME_NB, stSrcMatchStats.OverflowCount,
+                     ( ( stSrcMatchStats.Fallback != 0u ) ? ", pending bit set for all" : "" ) );
+  }
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+}
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+/**
+ * @brief   Print the statistics of the temperature measurements and of the RCO recalibrations.
+ */
+void APPE_RCO_PrintStats(void)
+{
+  LL_SYS_RcoClbrStats_t   stStats;
+
+  ll_sys_rco_clbr_get_stats( &stStats );
+
+  LOG_INFO_SYSTEM( "Temperature : %d C (%d C at the last RCO calibration), %u measurements (%u by the link layer)",
+                   stStats.Temperature, stStats.ClbrTemperature, stStats.MeasureCount, stStats.LlRequestCount );
+  LOG_INFO_SYSTEM( "RCO calibration : %u done, %u requested on drift (%u after %u deferrals), %u measurements deferred%s",
+                   stStats.ClbrCount, stStats.ClbrRequestCount, stStats.ForcedCount, CFG_LL_RCO_CLBR_DEFER_MAX,
+                   stStats.DeferredCount, ( ( stStats.RcoSleepClock == 0u ) ? ", sleep timer not on the RCO" : "" ) );
+}
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the arbitration between the BLE and 802.15.4 radio events.
+ */
+void APPE_COEX_PrintStats(void)
+{
+  LL_SYS_CoexStats_t    stStats;
+
+  ll_sys_coex_get_stats( &stStats );
+
+  LOG_INFO_SYSTEM( "Coexistence : MAC airtime %u%% in the last window (%u%% at high priority%s), %u windows",
+                   stStats.LastWindowShare, stStats.AirtimeShare, ( ( stStats.ZigbeeProtect != 0u ) ? ", protected" : "" ),
+                   stStats.WindowCount );
+  LOG_INFO_SYSTEM( "Coexistence : %u MAC events (%u raised), %u granted, %u blocked (%u by priority), RX on idle %u granted / %u aborted",
+                   stStats.MacEventCount, stStats.MacRaisedCount, stStats.MacGrantCount, stStats.MacBlockedCount,
+                   stStats.MacBlockedPriorityCount, stStats.MacIdleGrantCount, stStats.MacIdleAbortCount );
+}
+
+/**
+ * @brief   Coexistence serial commands : COEXSTATS, COEX <share %> (0 for the default), COEX PROTECT ON|OFF.
+ * @param   szCommand   Command received.
+ * @return  True if the command is a coexistence command.
+ */
+static bool APPE_COEX_SerialCmdExecute( const char * szCommand )
+{
+  char *    pEnd;
+  uint32_t  lValue;
+
+  if ( strcmp( szCommand, "COEXSTATS" ) == 0 )
+  {
+    APPE_COEX_PrintStats();
+  }
+  else if ( strcmp( szCommand, "COEX PROTECT ON" ) == 0 )
+  {
+    ll_sys_coex_set_zigbee_protect( 1u );
+  }
+  else if ( strcmp( szCommand, "COEX PROTECT OFF" ) == 0 )
+  {
+    ll_sys_coex_set_zigbee_protect( 0u );
+  }
+  else if ( strncmp( szCommand, "COEX ", 5u ) == 0 )
+  {
+    lValue = strtoul( &szCommand[5], &pEnd, 0 );
+    if ( ( pEnd == &szCommand[5] ) || ( lValue > 100u ) )
+    {
+      LOG_ERROR_APP( "Wrong airtime share : %s", &szCommand[5] );
+      return true;
+    }
+    ll_sys_coex_set_airtime_share( (uint8_t)lValue );
+    APPE_COEX_PrintStats();
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+
+#if (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0)
+/**
+ * @brief   Print the statistics of the trace FIFO, then reset them.
+ */
+void APPE_TRACE_PrintStats(void)
+{
+  UTIL_ADV_TRACE_Stats_t    stStats;
+
+  UTIL_ADV_TRACE_GetStats( &stStats );
+  UTIL_ADV_TRACE_ResetStats();
+
+  LOG_INFO_SYSTEM( "Trace FIFO : max fill %u / %u bytes, %u overruns, %u traces (%u bytes) dropped", stStats.MaxFill,
+                   stStats.FifoSize, stStats.OverrunNbr, stStats.DroppedNbr, stStats.DroppedBytes );
+}
+#endif /* (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0) */
+
+#if (CFG_LOG_SUPPORTED != 0)
+/**
+ * @brief   Runtime configuration of the logs from the serial console :
+ *          LOGLEVEL <level>, LOGREGION <mask>, ZBLOG <mask>, LOGMODE BIN|TEXT and LOGCFG (display).
+ *          The values are decimal or hexadecimal (0x prefix).
+ * @param   szCommand   Command received.
+ * @return  True if the command is a log configuration command.
+ */
+static bool APPE_LOG_SerialCmdExecute( const char * szCommand )
+{
+  char *    pEnd;
+  uint32_t  lValue;
+  bool      bDone = true;
+
+  if ( strncmp( szCommand, "LOGLEVEL ", 9u ) == 0 )
+  {
+    lValue = strtoul( &szCommand[9], &pEnd, 0 );
+    if ( ( pEnd != &szCommand[9] ) && ( lValue <= (uint32_t)LOG_VERBOSE_DEBUG ) )
+    {
+      Log_Module_Set_Verbose_Level( (Log_Verbose_Level_t)lValue );
+    }
+    else
+    {
+      bDone = false;
+    }
+  }
+  else if ( strncmp( szCommand, "LOGREGION ", 10u ) == 0 )
+  {
+    lValue = strtoul( &szCommand[10], &pEnd, 0 );
+    if ( pEnd != &szCommand[10] )
+    {
+      Log_Module_Set_Multiple_Regions( lValue );
+    }
+    else
+    {
+      bDone = false;
+    }
+  }
+  else if ( strncmp( szCommand, "ZBLOG ", 6u ) == 0 )
+  {
+    lValue = strtoul( &szCommand[6], &pEnd, 0 );
+    bDone = ( ( pEnd != &szCommand[6] ) && ( APP_ZIGBEE_SetLogMask( lValue ) != false ) );
+  }
+  else if ( strcmp( szCommand, "LOGMODE BIN" ) == 0 )
+  {
+    bDone = Log_Module_Set_Binary_Mode( true );
+  }
+  else if ( strcmp( szCommand, "LOGMODE TEXT" ) == 0 )
+  {
+    bDone = Log_Module_Set_Binary_Mode( false );
+  }
+  else if ( strcmp( szCommand, "LOGCFG" ) != 0 )
+  {
+    /* Not a log configuration command */
+    return false;
+  }
+
+  /* Printed at INFO level for all the regions, so that it stays visible whatever the new configuration */
+  if ( bDone == false )
+  {
+    Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_ALL_REGIONS, "Invalid or unsupported log command : %s", szCommand );
+  }
+
+  Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_ALL_REGIONS, "Logs : level %u, regions 0x%08X, %s mode",
+                    (unsigned int)Log_Module_Get_Verbose_Level(), (unsigned int)Log_Module_Get_Region_Mask(),
+                    ( Log_Module_Get_Binary_Mode() != false ) ? "binary" : "text" );
+
+  return true;
+}
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+/**
+ * @brief   Time until the next deadline of the device : first of the Zigbee stack timers (ZbCheckTime), of the
+ *          application timers and of the next radio event of the link layer.
+ * @return  Time in ms (UINT32_MAX if nothing is scheduled).
+ */
+uint32_t APPE_NextDeadlineGet(void)
+{
+  uint32_t  lDeadline, lValue;
+  uint64_t  dlRadioEvent;
+
+  lDeadline = UTIL_TIMER_GetFirstRemainingTime();
+
+  if ( stZigbeeAppInfo.pstZigbee != NULL )
+  {
+    lValue = ZbCheckTime( stZigbeeAppInfo.pstZigbee );
+    if ( lValue < lDeadline )
+    {
+      lDeadline = lValue;
+    }
+  }
+
+  /* Next radio event in us */
+  dlRadioEvent = os_timer_get_earliest_time() / 1000u;
+  if ( dlRadioEvent < lDeadline )
+  {
+    lDeadline = (uint32_t)dlRadioEvent;
+  }
+
+  return lDeadline;
+}
+
+#if (CFG_LPM_LEVEL != 0)
+/* Low power modes, indexed by UTIL_LPM_Mode_t */
+#define APPE_LPM_MODE_NB          (3u)
+#define APPE_LPM_GAP_MAX_US       (10000000u)   /* Farther deadlines give the same choice */
+
+static const char * const   aszLpmModeName[APPE_LPM_MODE_NB] = { "Sleep", "Stop", "Standby" };
+static const char * const   aszLpmWakeupName[PWR_WAKEUP_SOURCE_NB] = { "radio", "RTC", "EXTI", "UART", "other", "unknown" };
+static const uint32_t       alLpmCurrent[APPE_LPM_MODE_NB] = { CFG_LPM_SLEEP_CURRENT, CFG_LPM_STOP_CURRENT, CFG_LPM_STDBY_CURRENT };
+static uint32_t             alLpmCostUs[APPE_LPM_MODE_NB] = { 0u, CFG_LPM_STOP_COST_INIT, CFG_LPM_STDBY_WAKEUP_TIME };
+static uint32_t             alLpmChoices[APPE_LPM_MODE_NB];
+static UTIL_LPM_Mode_t      eLpmMode;
+static bool                 bLpmEntered;
+static uint32_t             lLpmStartCycle;
+static uint32_t             lLpmEnterCycles;
+
+/**
+ * @brief   Low power policy on the next deadline : for each mode, the charge until the deadline is its transition
+ *          cost at the run current plus the rest of the time at the current of the mode, and the mode of lowest
+ *          charge is kept. A 2 ms gap does not pay the Standby wake-up. Stop mode is never used for a deadline closer
+ *          than CFG_LPM_STOP_MIN_TIME, nor Standby for a deadline closer than CFG_LPM_STDBY_MIN_TIME.
+ */
+static void APPE_LPM_DeadlinePolicy(void)
+{
+  uint32_t        lDeadline, lGapUs, lMode;
+  uint64_t        llCharge, llBest;
+  UTIL_LPM_Mode_t eBest = UTIL_LPM_SLEEPMODE;
+
+  /* Transition cost measured from here */
+  lLpmStartCycle = DWT->CYCCNT;
+
+  lDeadline = APPE_NextDeadlineGet();
+  lGapUs = ( lDeadline < ( APPE_LPM_GAP_MAX_US / 1000u ) ) ? ( lDeadline * 1000u ) : APPE_LPM_GAP_MAX_US;
+
+  llBest = (uint64_t)lGapUs * alLpmCurrent[UTIL_LPM_SLEEPMODE];
+  for ( lMode = UTIL_LPM_STOPMODE; lMode < APPE_LPM_MODE_NB; lMode++ )
+  {
+    if ( alLpmCostUs[lMode] < lGapUs )
+    {
+      llCharge = ( (uint64_t)alLpmCostUs[lMode] * CFG_LPM_RUN_CURRENT ) +
+                 ( (uint64_t)( lGapUs - alLpmCostUs[lMode] ) * alLpmCurrent[lMode] );
+      if ( llCharge < llBest )
+      {
+        llBest = llCharge;
+        eBest = (UTIL_LPM_Mode_t)lMode;
+      }
+    }
+  }
+
+  if ( ( eBest == UTIL_LPM_OFFMODE ) && ( lDeadline < CFG_LPM_STDBY_MIN_TIME ) )
+  {
+    eBest = UTIL_LPM_STOPMODE;
+  }
+  if ( lDeadline < CFG_LPM_STOP_MIN_TIME )
+  {
+    eBest = UTIL_LPM_SLEEPMODE;
+  }
+  alLpmChoices[eBest]++;
+
+  UTIL_LPM_SetStopMode( 1U << CFG_LPM_APP_DEADLINE, ( ( eBest == UTIL_LPM_SLEEPMODE ) ? UTIL_LPM_DISABLE : UTIL_LPM_ENABLE ) );
+  UTIL_LPM_SetOffMode( 1U << CFG_LPM_APP_DEADLINE, ( ( eBest != UTIL_LPM_OFFMODE ) ? UTIL_LPM_DISABLE : UTIL_LPM_ENABLE ) );
+}
+
+/**
+ * @brief   Start of the low power mode selected by all the requesters : the enter part of its transition cost.
+ *          Its entries, residency and wake-up sources are counted by the low power interface (stm32_lpm_if).
+ */
+static void APPE_LPM_EnterMeasure(void)
+{
+  eLpmMode = UTIL_LPM_GetMode();
+  bLpmEntered = true;
+
+  lLpmEnterCycles = DWT->CYCCNT - lLpmStartCycle;
+}
+
+/**
+ * @brief   End of the wake-up : the transition cost of the mode is averaged over the last entries. The DWT is gated
+ *          in Stop mode, so that its count from the policy is the active time of the enter and exit. It is reset in
+ *          Standby : there, the enter is measured and the exit is CFG_LPM_STDBY_WAKEUP_TIME.
+ */
+static void APPE_LPM_CostUpdate(void)
+{
+  uint32_t  lSampleUs;
+
+  if ( bLpmEntered == false )
+  {
+    return;
+  }
+  bLpmEntered = false;
+
+  if ( eLpmMode == UTIL_LPM_STOPMODE )
+  {
+    lSampleUs = ( DWT->CYCCNT - lLpmStartCycle ) / ( SystemCoreClock / 1000000u );
+  }
+  else if ( eLpmMode == UTIL_LPM_OFFMODE )
+  {
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    lSampleUs = ( lLpmEnterCycles / ( SystemCoreClock / 1000000u ) ) + CFG_LPM_STDBY_WAKEUP_TIME;
+  }
+  else
+  {
+    return;
+  }
+
+  /* Average over about 8 entries */
+  alLpmCostUs[eLpmMode] = alLpmCostUs[eLpmMode] - ( alLpmCostUs[eLpmMode] >> 3 ) + ( lSampleUs >> 3 );
+}
+
+/**
+ * @brief   Print the residency in each low power mode, the choices of the policy, the transition costs, the
+ *          wake-up sources, the wake-up to first task latency and the Standby exit time.
+ */
+void APPE_LPM_PrintStats(void)
+{
+  uint32_t        lMode, lSource;
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t        lNowMs, lResidencyMs;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  PWR_LpmStats_t  stLpmStats;
+
+  PWR_GetLpmStats( &stLpmStats );
+
+#if (CFG_LOG_SUPPORTED != 0)
+  lNowMs = MAX( UTIL_TIMER_GetCurrentTime(), 1u );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  LOG_INFO_SYSTEM( "Low power since the boot (%u ms) :", lNowMs );
+  for ( lMode = 0; lMode < APPE_LPM_MODE_NB; lMode++ )
+  {
+#if (CFG_LOG_SUPPORTED != 0)
+    lResidencyMs = (uint32_t)( stLpmStats.ResidencyUs[lMode] / 1000u );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+    LOG_INFO_SYSTEM( "  %s : %u entries (%u chosen on the deadline), %u ms (%u.%u %%), transition %u us",
+                     aszLpmModeName[lMode], stLpmStats.Entries[lMode], alLpmChoices[lMode], lResidencyMs,
+                     ( (uint32_t)( ( (uint64_t)lResidencyMs * 1000u ) / lNowMs ) / 10u ),
+                     ( (uint32_t)( ( (uint64_t)lResidencyMs * 1000u ) / lNowMs ) % 10u ), alLpmCostUs[lMode] );
+    for ( lSource = 0; lSource < PWR_WAKEUP_SOURCE_NB; lSource++ )
+    {
+      if ( stLpmStats.Wakeups[lMode][lSource] != 0u )
+      {
+        LOG_INFO_SYSTEM( "    woken up by %s : %u", aszLpmWakeupName[lSource], stLpmStats.Wakeups[lMode][lSource] );
+      }
+    }
+  }
+  LOG_INFO_SYSTEM( "  Wake-up to first task : %u wake-ups, average %u us, max %u us", stLpmStats.LatencyCount,
+                   (uint32_t)( stLpmStats.LatencyTotalUs / MAX( stLpmStats.LatencyCount, 1u ) ), stLpmStats.LatencyMaxUs );
+  if ( stLpmStats.RestoreCount != 0u )
+  {
+    LOG_INFO_SYSTEM( "  Standby exit to radio ready : %u exits, average %u us, max %u us (%s restore)", stLpmStats.RestoreCount,
+                     (uint32_t)( stLpmStats.RestoreTotalUs / stLpmStats.RestoreCount ), stLpmStats.RestoreMaxUs,
+                     ( CFG_LPM_STDBY_FAST_RESTORE != 0 ) ? "selective" : "full" );
+  }
+}
+#endif /* (CFG_LPM_LEVEL != 0) */
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+/* Clock requests of the governor, from HSE_16MHZ to SYS_PLL */
+#define APPE_CLK_LEVEL_NB           (3u)
+#define APPE_CLK_LEVEL( eClock )    ( (uint32_t)( eClock ) - (uint32_t)HSE_16MHZ )
+
+/* PLL : HSE 32 MHz / 4 * 48 / 4 = 96 MHz, AHB5 divided by 3 (32 MHz) */
+static const scm_pll_config_t stClkPllConfig =
+{
+  0u, PLL_INTEGER_MODE, 4u, 48u, 4u, 4u, 4u, 0u, LL_RCC_AHB5_DIV_3
+};
+
+static const char * const   aszClkLevelName[APPE_CLK_LEVEL_NB] = { "HSE 16 MHz", "HSE 32 MHz", "PLL 96 MHz" };
+static UTIL_TIMER_Object_t  stClkGovernorTimer;
+static scm_clockconfig_t    eClkRequest;
+static uint32_t             lClkBoost_bm;
+static uint64_t             llClkBusyCycles;
+static uint32_t             lClkWindowStart;
+static uint32_t             lClkLoad;
+static uint32_t             lClkSwitchStart;
+static bool                 bClkSwitchPending;
+static uint32_t             alClkTimeMs[APPE_CLK_LEVEL_NB];
+static uint32_t             alClkSwitches[APPE_CLK_LEVEL_NB];
+static uint32_t             alClkLatencyTotalUs[APPE_CLK_LEVEL_NB];
+static uint32_t             alClkLatencyMaxUs[APPE_CLK_LEVEL_NB];
+
+/**
+ * @brief   Start of the governor : the PLL is configured once (started only when requested), from the HSE 32 MHz
+ *          request of SystemPower_Config().
+ */
+static void APPE_CLK_GovernorInit(void)
+{
+  scm_pll_setconfig( &stClkPllConfig );
+
+  eClkRequest = HSE_32MHZ;
+  lClkWindowStart = UTIL_TIMER_GetCurrentTime();
+
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_SCM_GOVERNOR ), UTIL_SEQ_RFU, APPE_CLK_GovernorTask );
+  UTIL_TIMER_Create( &stClkGovernorTimer, CFG_SCM_GOVERNOR_PERIOD, UTIL_TIMER_PERIODIC, &APPE_CLK_GovernorTimerCallback, NULL );
+  UTIL_TIMER_Start( &stClkGovernorTimer );
+}
+
+/**
+ * @brief   End of a governor window.
+ */
+static void APPE_CLK_GovernorTimerCallback(void * arg)
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_SCM_GOVERNOR ), TASK_PRIO_SCM_GOVERNOR );
+}
+
+/**
+ * @brief   Governor : the PLL while a burst requester is set, else one step up or down from the load of the window,
+ *          i.e. the execution time of the sequencer tasks over the cycles of the window at the current clock.
+ */
+static void APPE_CLK_GovernorTask(void)
+{
+  UTIL_SEQ_TaskStats_t  stStats;
+  uint64_t              llBusyCycles = 0;
+  uint64_t              llWindowCycles;
+  uint32_t              lTaskIdx, lNow, lElapsed;
+  scm_clockconfig_t     eClock = eClkRequest;
+
+  for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+  {
+    if ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lTaskIdx ), &stStats ) != 0u )
+    {
+      llBusyCycles += stStats.TotalTime;
+    }
+  }
+
+  lNow = UTIL_TIMER_GetCurrentTime();
+  lElapsed = lNow - lClkWindowStart;
+  if ( lElapsed != 0u )
+  {
+    /* The time of the nested tasks (UTIL_SEQ_WaitEvt) is counted twice : the load is saturated */
+    llWindowCycles = (uint64_t)lElapsed * ( SystemCoreClock / 1000u );
+    lClkLoad = (uint32_t)MIN( ( ( llBusyCycles - llClkBusyCycles ) * 1000u ) / llWindowCycles, 1000u );
+    alClkTimeMs[APPE_CLK_LEVEL( eClkRequest )] += lElapsed;
+  }
+  llClkBusyCycles = llBusyCycles;
+  lClkWindowStart = lNow;
+
+  if ( lClkBoost_bm != 0u )
+  {
+    eClock = SYS_PLL;
+  }
+  else if ( ( lClkLoad > CFG_SCM_GOVERNOR_UP_LOAD ) && ( eClkRequest < SYS_PLL ) )
+  {
+    eClock = (scm_clockconfig_t)( eClkRequest + 1 );
+  }
+  else if ( ( lClkLoad < CFG_SCM_GOVERNOR_DOWN_LOAD ) && ( eClkRequest > HSE_16MHZ ) )
+  {
+    eClock = (scm_clockconfig_t)( eClkRequest - 1 );
+  }
+
+  APPE_CLK_Request( eClock );
+}
+
+/**
+ * @brief   Request of a new system clock to the SCM. The switches between HSE frequencies are done in the call,
+ *          the switch to the PLL ends in the PLLRDY interrupt ( scm_pllready() ). No switch happens when another
+ *          user (radio) keeps a higher request.
+ */
+static void APPE_CLK_Request(scm_clockconfig_t eClock)
+{
+  uint32_t  lCoreClock = SystemCoreClock;
+
+  if ( eClock == eClkRequest )
+  {
+    return;
+  }
+
+  eClkRequest = eClock;
+  bClkSwitchPending = true;
+  lClkSwitchStart = DWT->CYCCNT;
+  scm_setsystemclock( SCM_USER_APP, eClock );
+
+  if ( eClock != SYS_PLL )
+  {
+    if ( SystemCoreClock != lCoreClock )
+    {
+      APPE_CLK_SwitchDone( eClock );
+    }
+    bClkSwitchPending = false;
+  }
+}
+
+/**
+ * @brief   End of a switch requested by the governor : its latency in us (at the new clock).
+ */
+static void APPE_CLK_SwitchDone(scm_clockconfig_t eClock)
+{
+  uint32_t  lLatencyUs, lLevel = APPE_CLK_LEVEL( eClock );
+
+  lLatencyUs = ( DWT->CYCCNT - lClkSwitchStart ) / ( SystemCoreClock / 1000000u );
+  alClkSwitches[lLevel]++;
+  alClkLatencyTotalUs[lLevel] += lLatencyUs;
+  alClkLatencyMaxUs[lLevel] = MAX( alClkLatencyMaxUs[lLevel], lLatencyUs );
+}
+
+/**
+ * @brief   The system clock is now on the PLL (RCC interrupt).
+ */
+void scm_pllready(void)
+{
+  /* Ignore the PLL restarts at the exit of the Stop mode */
+  if ( bClkSwitchPending != false )
+  {
+    bClkSwitchPending = false;
+    APPE_CLK_SwitchDone( SYS_PLL );
+  }
+}
+
+/**
+ * @brief   Set or clear a requester of the PLL for a burst of processing. The PLL is requested at once.
+ * @param   lBoostId_bm   Requesters (1 << CFG_SCM_BOOST_xxx).
+ * @param   bBoost        True while the burst lasts.
+ */
+void APPE_CLK_SetBoost(uint32_t lBoostId_bm, bool bBoost)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( bBoost != false )
+  {
+    lClkBoost_bm |= lBoostId_bm;
+  }
+  else
+  {
+    lClkBoost_bm &= ~lBoostId_bm;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( bBoost != false )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_SCM_GOVERNOR ), TASK_PRIO_SCM_GOVERNOR );
+  }
+}
+
+/**
+ * @brief   Print the time spent at each clock request of the governor and the latencies of the switches.
+ */
+void APPE_CLK_PrintStats(void)
+{
+  uint32_t  lLevel;
+
+  LOG_INFO_SYSTEM( "Clock governor : request %s, system clock %u Hz, load %u.%u %%, boost 0x%02X",
+                   aszClkLevelName[APPE_CLK_LEVEL( eClkRequest )], SystemCoreClock, ( lClkLoad / 10u ),
+                   ( lClkLoad % 10u ), lClkBoost_bm );
+  for ( lLevel = 0; lLevel < APPE_CLK_LEVEL_NB; lLevel++ )
+  {
+    LOG_INFO_SYSTEM( "  %s : %u ms, %u switches, latency avg %u us, max %u us", aszClkLevelName[lLevel],
+                     alClkTimeMs[lLevel], alClkSwitches[lLevel],
+                     ( alClkLatencyTotalUs[lLevel] / MAX( alClkSwitches[lLevel], 1u ) ), alClkLatencyMaxUs[lLevel] );
+  }
+}
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+/**
+ * @brief   Print the timer callbacks assigned to the codes of the debug GPIO run bus (to be found in the map file).
+ */
+static void APPE_RUNBUS_Print(void)
+{
+  uint32_t                    lCode;
+  APP_DEBUG_TimerCallback_t   pfCallback;
+
+  LOG_INFO_SYSTEM( "Run bus : 0 to 31 sequencer task ID, 62 other timer callbacks, 63 idle" );
+  for ( lCode = 32u; lCode < 62u; lCode++ )
+  {
+    pfCallback = APP_DEBUG_RunBusGetTimerCallback( lCode );
+    if ( pfCallback != NULL )
+    {
+      LOG_INFO_SYSTEM( "  %u : timer callback 0x%08X", lCode, (uint32_t)pfCallback );
+    }
+  }
+}
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) */
+
+#if (CFG_BOOT_PROFILE_SUPPORTED != 0)
+static const char * const   aszBootStageName[APPE_BOOT_STAGE_NB] =
+{
+  "Reset to main()", "MX_APPE_Config", "SystemClock_Config", "MX peripherals", "System_Init", "SystemPower_Config",
+  "APPE_AMM_Init", "Modules init", "Link layer init", "ZbInit", "Endpoints config", "MX_APPE_Init end",
+  "Startup launched", "Startup done", "ApplicationStart"
+};
+static uint32_t   alBootTimeUs[APPE_BOOT_STAGE_NB];               /* Time of the stages since the reset */
+static uint32_t   lBootReached_bm;
+static uint32_t   lBootLastCycle;                                 /* DWT reset by SystemInit() */
+static uint32_t   lBootLastCycleMhz = ( HSI_VALUE / 1000000u );   /* Core clock since the previous stage */
+static uint32_t   lBootLastUs;
+static uint32_t   lBootTimerRefMs;
+
+/**
+ * @brief   Record the end of a boot stage (once). Up to the end of MX_APPE_Init, the DWT cycles since the previous
+ *          stage are converted with the core clock of the previous stage (a clock switch inside the stage is not
+ *          seen). After, the sequencer may enter the low power modes where the DWT is stopped : the timer server
+ *          (ms) is used. The table is printed at the end of APP_ZIGBEE_ApplicationStart().
+ */
+void APPE_BOOT_Mark(APPE_BootStage_t eStage)
+{
+  uint32_t  lCycle;
+
+  if ( ( eStage >= APPE_BOOT_STAGE_NB ) || ( ( lBootReached_bm & ( 1UL << eStage ) ) != 0u ) )
+  {
+    return;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( ( lBootReached_bm & ( 1UL << APPE_BOOT_APPE_INIT ) ) == 0u )
+  {
+    lCycle = DWT->CYCCNT;
+    lBootLastUs += ( ( lCycle - lBootLastCycle ) / lBootLastCycleMhz );
+    lBootLastCycle = lCycle;
+    lBootLastCycleMhz = MAX( SystemCoreClock / 1000000u, 1u );
+    alBootTimeUs[eStage] = lBootLastUs;
+    if ( eStage == APPE_BOOT_APPE_INIT )
+    {
+      lBootTimerRefMs = UTIL_TIMER_GetCurrentTime();
+    }
+  }
+  else
+  {
+    alBootTimeUs[eStage] = lBootLastUs + ( ( UTIL_TIMER_GetCurrentTime() - lBootTimerRefMs ) * 1000u );
+  }
+  lBootReached_bm |= ( 1UL << eStage );
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( eStage == APPE_BOOT_APPLICATION_START )
+  {
+    APPE_BOOT_PrintStats();
+  }
+}
+
+/**
+ * @brief   Print the boot profile : time of each stage reached since the reset, and its duration.
+ */
+void APPE_BOOT_PrintStats(void)
+{
+  uint32_t  lStage, lPreviousUs = 0;
+
+  LOG_INFO_SYSTEM( "Boot profile (since the reset) :" );
+  for ( lStage = 0; lStage < APPE_BOOT_STAGE_NB; lStage++ )
+  {
+    if ( ( lBootReached_bm & ( 1UL << lStage ) ) != 0u )
+    {
+      LOG_INFO_SYSTEM( "  %s : at %u.%03u ms (+%u us)", aszBootStageName[lStage], ( alBootTimeUs[lStage] / 1000u ),
+                       ( alBootTimeUs[lStage] % 1000u ), ( alBootTimeUs[lStage] - lPreviousUs ) );
+      lPreviousUs = alBootTimeUs[lStage];
+    }
+  }
+}
+#endif /* (CFG_BOOT_PROFILE_SUPPORTED != 0) */
+
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+#define APPE_STACK_PAINT          ( 0xA5A5A5A5u )
+#define APPE_STACK_SP_MARGIN      ( 64u )         /* Bytes kept below the stack pointer when painting */
+#define APPE_STACK_SCAN_WORDS     ( 32u )         /* Words checked below the deepest point after each task */
+#define APPE_STACK_NO_TASK        ( 0xFFFFFFFFu ) /* As UTIL_SEQ_NOTASKRUNNING : interrupt or idle */
+
+extern uint32_t   _estack[];
+extern uint32_t   _Min_Stack_Size[];
+
+static uint32_t *             pStackLimit;                  /* Bottom of the painted stack, NULL when not painted */
+static uint32_t *             pStackDeepest;                /* Deepest word used seen */
+static uint32_t               lStackDeepestTask = APPE_STACK_NO_TASK;
+static uint32_t               lStackDeepestNesting;
+static uint32_t               lStackWarnedHeadroom = UINT32_MAX;
+static UTIL_TIMER_Object_t    stStackMonitorTimer;
+
+/**
+ * @brief   Paint the free part of the main stack, from its reserved bottom to just below the stack pointer. Called
+ *          at the start of main(), before any deep call.
+ */
+void APPE_STACK_Paint(void)
+{
+  uint32_t *  pWord = (uint32_t *)( (uint32_t)_estack - (uint32_t)_Min_Stack_Size );
+  uint32_t *  pTop = (uint32_t *)( ( __get_MSP() - APPE_STACK_SP_MARGIN ) & ~3u );
+
+  pStackLimit = pWord;
+  pStackDeepest = pTop;
+  while ( pWord < pTop )
+  {
+    *pWord++ = APPE_STACK_PAINT;
+  }
+}
+
+/**
+ * @brief   First word used (not painted) between pFrom and pTo, pTo when all are painted.
+ */
+static uint32_t * APPE_STACK_Scan(uint32_t * pFrom, uint32_t * pTo)
+{
+  while ( ( pFrom < pTo ) && ( *pFrom == APPE_STACK_PAINT ) )
+  {
+    pFrom++;
+  }
+
+  return pFrom;
+}
+
+/**
+ * @brief   Record a new deepest point of the stack (the timer callback may record at the same time).
+ */
+static void APPE_STACK_Record(uint32_t * pUsed, uint32_t lTaskIdx, uint32_t lNesting)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( pUsed < pStackDeepest )
+  {
+    pStackDeepest = pUsed;
+    lStackDeepestTask = lTaskIdx;
+    lStackDeepestNesting = lNesting;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief   Sequencer task end hook : only the words just below the deepest point are checked, and the next ones
+ *          while the lowest checked is used. Warning when the headroom drops below CFG_STACK_MONITOR_HEADROOM.
+ */
+void APPE_STACK_TaskEnd(uint32_t lTaskIdx, uint32_t lNesting)
+{
+  uint32_t *  pWindow;
+  uint32_t *  pUsed;
+  uint32_t    lHeadroom;
+
+  if ( pStackLimit == NULL )
+  {
+    return;
+  }
+
+  do
+  {
+    pWindow = pStackLimit;
+    if ( ( pStackDeepest - pStackLimit ) > (int32_t)APPE_STACK_SCAN_WORDS )
+    {
+      pWindow = pStackDeepest - APPE_STACK_SCAN_WORDS;
+    }
+    pUsed = APPE_STACK_Scan( pWindow, pStackDeepest );
+    APPE_STACK_Record( pUsed, lTaskIdx, lNesting );
+  }
+  while ( ( pUsed == pWindow ) && ( pWindow > pStackLimit ) );
+
+  lHeadroom = (uint32_t)( pStackDeepest - pStackLimit ) * sizeof( uint32_t );
+  if ( ( lHeadroom < CFG_STACK_MONITOR_HEADROOM ) && ( lHeadroom < lStackWarnedHeadroom ) )
+  {
+    lStackWarnedHeadroom = lHeadroom;
+    LOG_WARNING_SYSTEM( "Stack headroom %u bytes (task %d, nesting %u)", lHeadroom, (int32_t)lStackDeepestTask,
+                        lStackDeepestNesting );
+  }
+}
+
+/**
+ * @brief   Periodic scan of the whole painted stack : the depth reached in the interrupts or the idle, not seen by
+ *          the task end hook, is recorded without task (reported at the end of the next task).
+ */
+static void APPE_STACK_MonitorTimerCallback(void * arg)
+{
+  UNUSED( arg );
+
+  APPE_STACK_Record( APPE_STACK_Scan( pStackLimit, pStackDeepest ), APPE_STACK_NO_TASK, 0u );
+}
+
+/**
+ * @brief   Start of the periodic scan (the stack has been painted by main()).
+ */
+static void APPE_STACK_MonitorInit(void)
+{
+  if ( pStackLimit == NULL )
+  {
+    return;
+  }
+
+  UTIL_TIMER_Create( &stStackMonitorTimer, CFG_STACK_MONITOR_PERIOD, UTIL_TIMER_PERIODIC, &APPE_STACK_MonitorTimerCallback, NULL );
+  UTIL_TIMER_Start( &stStackMonitorTimer );
+}
+
+/**
+ * @brief   Print the stack usage : size, maximum used, headroom, and the task (-1 for none : interrupt or idle) and
+ *          the nesting level of UTIL_SEQ_Run() when the deepest point was seen.
+ */
+void APPE_STACK_PrintStats(void)
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t  lSize = (uint32_t)_Min_Stack_Size;
+  uint32_t  lHeadroom;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  if ( pStackLimit == NULL )
+  {
+    LOG_INFO_SYSTEM( "Stack not painted" );
+    return;
+  }
+
+  APPE_STACK_MonitorTimerCallback( NULL );
+#if (CFG_LOG_SUPPORTED != 0)
+  lHeadroom = (uint32_t)( pStackDeepest - pStackLimit ) * sizeof( uint32_t );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  LOG_INFO_SYSTEM( "Stack : size %u bytes, max used %u bytes, headroom %u bytes (task %d, nesting %u)", lSize,
+                   ( lSize - lHeadroom ), lHeadroom, (int32_t)lStackDeepestTask, lStackDeepestNesting );
+}
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+#define APPE_LOAD_SECONDS         ( 60u )         /* Seconds of the longest mean */
+#define APPE_LOAD_TASK_WINDOW_US  ( 10000000u )   /* Window of the load of each task */
+
+static uint16_t               aiLoadPermille[APPE_LOAD_SECONDS];  /* Load of the last seconds (ring) */
+static uint32_t               lLoadIndex;                         /* Next second of the ring */
+static uint32_t               lLoadCount;                         /* Seconds recorded, up to APPE_LOAD_SECONDS */
+static bool                   bLoadIdle;
+static uint64_t               llLoadIdleStartUs;
+static uint64_t               llLoadIdleUs;                       /* Total idle time */
+static uint64_t               llLoadSampleUs;                     /* Time and idle time of the previous second */
+static uint64_t               llLoadSampleIdleUs;
+static UTIL_TIMER_Object_t    stLoadTimer;
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+static uint64_t               allLoadTaskCycles[CFG_TASK_NBR];    /* Execution time of the tasks at the window start */
+static uint16_t               aiLoadTaskPermille[CFG_TASK_NBR];   /* Load of the tasks over the last window */
+static uint64_t               llLoadTaskWindowUs;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+/**
+ * @brief   Start of the idle of the sequencer (UTIL_SEQ_PreIdle).
+ */
+static void APPE_LOAD_IdleEnter(void)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  llLoadIdleStartUs = TIMER_IF_GetTimeUs();
+  bLoadIdle = true;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief   End of the idle of the sequencer (UTIL_SEQ_PostIdle).
+ */
+static void APPE_LOAD_IdleExit(void)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  llLoadIdleUs += ( TIMER_IF_GetTimeUs() - llLoadIdleStartUs );
+  bLoadIdle = false;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+/**
+ * @brief   End of the window of the load of each task : the execution time of each task (profiling counters, in
+ *          cycles converted at the current clock) over the window.
+ */
+static void APPE_LOAD_TaskSample(uint64_t llNowUs)
+{
+  UTIL_SEQ_TaskStats_t  stStats;
+  uint32_t              lTaskIdx, lWindowUs, lCyclesPerUs;
+
+  lWindowUs = (uint32_t)( llNowUs - llLoadTaskWindowUs );
+  lCyclesPerUs = MAX( SystemCoreClock / 1000000u, 1u );
+  llLoadTaskWindowUs = llNowUs;
+
+  for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+  {
+    if ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lTaskIdx ), &stStats ) == 0u )
+    {
+      continue;
+    }
+    aiLoadTaskPermille[lTaskIdx] = (uint16_t)MIN( ( ( stStats.TotalTime - allLoadTaskCycles[lTaskIdx] ) / lCyclesPerUs )
+                                                  * 1000u / lWindowUs, 1000u );
+    allLoadTaskCycles[lTaskIdx] = stStats.TotalTime;
+  }
+}
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+/**
+ * @brief   End of a second : its load is the time out of the idle over the elapsed time. An idle in progress (the
+ *          timer wakes up the system) is counted up to now.
+ */
+static void APPE_LOAD_TimerCallback(void * arg)
+{
+  uint64_t  llNowUs, llIdleUs;
+  uint32_t  lElapsedUs, lIdleUs;
+
+  UNUSED( arg );
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  llNowUs = TIMER_IF_GetTimeUs();
+  llIdleUs = llLoadIdleUs;
+  if ( bLoadIdle != false )
+  {
+    llIdleUs += ( llNowUs - llLoadIdleStartUs );
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  lElapsedUs = (uint32_t)( llNowUs - llLoadSampleUs );
+  lIdleUs = (uint32_t)MIN( llIdleUs - llLoadSampleIdleUs, lElapsedUs );
+  llLoadSampleUs = llNowUs;
+  llLoadSampleIdleUs = llIdleUs;
+  if ( lElapsedUs == 0u )
+  {
+    return;
+  }
+
+  aiLoadPermille[lLoadIndex] = (uint16_t)( ( (uint64_t)( lElapsedUs - lIdleUs ) * 1000u ) / lElapsedUs );
+  lLoadIndex = ( lLoadIndex + 1u ) % APPE_LOAD_SECONDS;
+  if ( lLoadCount < APPE_LOAD_SECONDS )
+  {
+    lLoadCount++;
+  }
+
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  if ( ( llNowUs - llLoadTaskWindowUs ) >= APPE_LOAD_TASK_WINDOW_US )
+  {
+    APPE_LOAD_TaskSample( llNowUs );
+  }
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+}
+
+/**
+ * @brief   Start of the load meter : one sample each second.
+ */
+static void APPE_LOAD_Init(void)
+{
+  llLoadSampleUs = TIMER_IF_GetTimeUs();
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  llLoadTaskWindowUs = llLoadSampleUs;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+  UTIL_TIMER_Create( &stLoadTimer, 1000u, UTIL_TIMER_PERIODIC, &APPE_LOAD_TimerCallback, NULL );
+  UTIL_TIMER_Start( &stLoadTimer );
+}
+
+/**
+ * @brief   Mean CPU load over the last seconds (fewer just after the start).
+ * @param   lSeconds  Length of the mean, from 1 to 60 s.
+ * @return  Load in per mille.
+ */
+uint16_t APPE_LOAD_Get(uint32_t lSeconds)
+{
+  uint32_t  lSum = 0, lSecond, lIndex;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  lSeconds = MIN( lSeconds, lLoadCount );
+  lIndex = lLoadIndex;
+  for ( lSecond = 0; lSecond < lSeconds; lSecond++ )
+  {
+    lIndex = ( ( lIndex == 0u ) ? APPE_LOAD_SECONDS : lIndex ) - 1u;
+    lSum += aiLoadPermille[lIndex];
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return (uint16_t)( ( lSeconds != 0u ) ? ( lSum / lSeconds ) : 0u );
+}
+
+/**
+ * @brief   Print the mean CPU loads and the load of each task over the last window.
+ */
+void APPE_LOAD_PrintStats(void)
+{
+  uint16_t  iLoad1s = APPE_LOAD_Get( 1u );
+  uint16_t  iLoad10s = APPE_LOAD_Get( 10u );
+  uint16_t  iLoad60s = APPE_LOAD_Get( 60u );
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  uint32_t  lTaskIdx;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+  LOG_INFO_SYSTEM( "CPU load : 1 s %u.%u %%, 10 s %u.%u %%, 60 s %u.%u %%", ( iLoad1s / 10u ), ( iLoad1s % 10u ),
+                   ( iLoad10s / 10u ), ( iLoad10s % 10u ), ( iLoad60s / 10u ), ( iLoad60s % 10u ) );
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+  {
+    if ( aiLoadTaskPermille[lTaskIdx] != 0u )
+    {
+      LOG_INFO_SYSTEM( "  Task %u : %u.%u %%", lTaskIdx, ( aiLoadTaskPermille[lTaskIdx] / 10u ),
+                       ( aiLoadTaskPermille[lTaskIdx] % 10u ) );
+    }
+  }
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+}
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+
+#if (CFG_PERF_SNAPSHOT_SUPPORTED != 0)
+/**
+ * @brief   One metric of the performance snapshot.
+ * @param   szMetric  Name of the metric.
+ * @param   lIndex    Index of the metric (task, virtual memory...), appended to its name, or UINT32_MAX.
+ * @param   lValue    Value.
+ * @param   szUnit    Unit (empty for a count).
+ */
+static void APPE_PERF_Put(const char * szMetric, uint32_t lIndex, uint32_t lValue, const char * szUnit)
+{
+  if ( lIndex == UINT32_MAX )
+  {
+    LOG_INFO_SYSTEM( "PERFSNAP,%s,%u,%s", szMetric, lValue, szUnit );
+  }
+  else
+  {
+    LOG_INFO_SYSTEM( "PERFSNAP,%s%u,%u,%s", szMetric, lIndex, lValue, szUnit );
+  }
+}
+
+/**
+ * @brief   PERFSNAP command : the counters of the statistics built, in CSV, without resetting them. The counters are
+ *          cumulated since the boot, a run is measured by the difference of two snapshots (perf_gate.py).
+ */
+void APPE_PERF_PrintSnapshot(void)
+{
+  ZigbeePlatHeapStats_t     stZbStats;
+  struct ZbApsStatTableT    stApsStats;
+  uint32_t                  lIndex;
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0) || (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+  uint32_t                  lCyclePerUs = MAX( ( SystemCoreClock / 1000000u ), 1u );
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) || (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  UTIL_SEQ_TaskStats_t      stTaskStats;
+  uint32_t                  lMaxLatency = 0u;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+  UTIL_SEQ_DeadlineStats_t  stDeadlineStats;
+  uint32_t                  lDeadlineMiss = 0u, lDeadlineMaxLateness = 0u;
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+#if (CFG_TIMER_STATS_SUPPORTED != 0)
+  UTIL_TIMER_Object_t     * pTimerList[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+  UTIL_TIMER_Stats_t        stTimerStats;
+  uint64_t                  llTimerLateness = 0u;
+  uint32_t                  lTimerNbr, lTimerCalls = 0u, lTimerMaxLateness = 0u;
+#endif /* (CFG_TIMER_STATS_SUPPORTED != 0) */
+#if (CFG_HEAP_DIAG_SUPPORTED != 0)
+  AMM_RetryStats_t          stRetryStats;
+#endif /* (CFG_HEAP_DIAG_SUPPORTED != 0) */
+#if (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0)
+  UTIL_ADV_TRACE_Stats_t    stTraceStats;
+#endif /* (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0) */
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MAC_SYS_Stats_t           stMacStats;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+#if (CFG_LPM_LEVEL != 0)
+  PWR_LpmStats_t            stLpmStats;
+#endif /* (CFG_LPM_LEVEL != 0) */
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+  ZigbeePlatCryptoStats_t   stCryptoStats;
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+
+  LOG_INFO_SYSTEM( "PERFSNAP,metric,value,unit" );
+  APPE_PERF_Put( "uptime", UINT32_MAX, HAL_GetTick(), "ms" );
+
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  for ( lIndex = 0u; lIndex < (uint32_t)CFG_TASK_NBR; lIndex++ )
+  {
+    if ( ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lIndex ), &stTaskStats ) != 0u ) && ( stTaskStats.CallCount != 0u ) )
+    {
+      APPE_PERF_Put( "seq_calls_task", lIndex, stTaskStats.CallCount, "" );
+      APPE_PERF_Put( "seq_time_task", lIndex, (uint32_t)( stTaskStats.TotalTime / lCyclePerUs ), "us" );
+      lMaxLatency = MAX( lMaxLatency, stTaskStats.MaxLatency );
+    }
+  }
+  APPE_PERF_Put( "seq_max_latency", UINT32_MAX, ( lMaxLatency / lCyclePerUs ), "us" );
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+  for ( lIndex = 0u; lIndex < (uint32_t)CFG_TASK_NBR; lIndex++ )
+  {
+    if ( UTIL_SEQ_GetDeadlineStats( UTIL_SEQ_TASK_BM( lIndex ), &stDeadlineStats ) != 0u )
+    {
+      lDeadlineMiss += stDeadlineStats.MissCount;
+      lDeadlineMaxLateness = MAX( lDeadlineMaxLateness, stDeadlineStats.MaxLateness );
+    }
+  }
+  APPE_PERF_Put( "seq_deadline_miss", UINT32_MAX, lDeadlineMiss, "" );
+  APPE_PERF_Put( "seq_deadline_max_lateness", UINT32_MAX, lDeadlineMaxLateness, "us" );
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+
+#if (CFG_TIMER_STATS_SUPPORTED != 0)
+  lTimerNbr = UTIL_TIMER_GetRunningTimers( pTimerList, UTIL_TIMER_CONF_MAX_TIMER_NBR );
+  for ( lIndex = 0u; lIndex < lTimerNbr; lIndex++ )
+  {
+    if ( UTIL_TIMER_GetStats( pTimerList[lIndex], &stTimerStats ) == UTIL_TIMER_OK )
+    {
+      lTimerCalls += stTimerStats.Count;
+      llTimerLateness += stTimerStats.TotalLateness;
+      lTimerMaxLateness = MAX( lTimerMaxLateness, stTimerStats.MaxLateness );
+    }
+  }
+  APPE_PERF_Put( "timer_calls", UINT32_MAX, lTimerCalls, "" );
+  APPE_PERF_Put( "timer_lateness", UINT32_MAX, TIMER_IF_Convert_Tick2us( (uint32_t)llTimerLateness ), "us" );
+  APPE_PERF_Put( "timer_max_lateness", UINT32_MAX, TIMER_IF_Convert_Tick2us( lTimerMaxLateness ), "us" );
+#endif /* (CFG_TIMER_STATS_SUPPORTED != 0) */
+
+  for ( lIndex = 0u; lIndex <= AMM_CONF_VIRTUAL_ID_MAX; lIndex++ )
+  {
+    if ( ZIGBEE_PLAT_GetHeapStats( (uint8_t)lIndex, &stZbStats ) == true )
+    {
+      APPE_PERF_Put( "zb_heap_used_vm", lIndex, stZbStats.lUsedSize, "bytes" );
+      APPE_PERF_Put( "zb_heap_peak_vm", lIndex, stZbStats.lPeakSize, "bytes" );
+      APPE_PERF_Put( "zb_heap_allocs_vm", lIndex, stZbStats.lAllocNbr, "" );
+      APPE_PERF_Put( "zb_heap_failures_vm", lIndex, stZbStats.lAllocFailedNbr, "" );
+    }
+#if (CFG_HEAP_DIAG_SUPPORTED != 0)
+    if ( AMM_GetRetryStats( (uint8_t)lIndex, &stRetryStats ) == AMM_ERROR_OK )
+    {
+      APPE_PERF_Put( "amm_failures_vm", lIndex, stRetryStats.AllocFailedNbr, "" );
+    }
+#endif /* (CFG_HEAP_DIAG_SUPPORTED != 0) */
+  }
+
+#if (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0)
+  UTIL_ADV_TRACE_GetStats( &stTraceStats );
+  APPE_PERF_Put( "trace_dropped", UINT32_MAX, stTraceStats.DroppedNbr, "" );
+  APPE_PERF_Put( "trace_overruns", UINT32_MAX, stTraceStats.OverrunNbr, "" );
+  APPE_PERF_Put( "trace_max_fill", UINT32_MAX, stTraceStats.MaxFill, "bytes" );
+#endif /* (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0) */
+
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MacSys_GetStats( &stMacStats );
+  APPE_PERF_Put( "mac_tx", UINT32_MAX, stMacStats.Total.TxCount, "" );
+  APPE_PERF_Put( "mac_tx_ok", UINT32_MAX, stMacStats.Total.TxSuccessCount, "" );
+  APPE_PERF_Put( "mac_tx_cca_fail", UINT32_MAX, stMacStats.Total.TxCcaFailCount, "" );
+  APPE_PERF_Put( "mac_tx_no_ack", UINT32_MAX, stMacStats.Total.TxNoAckCount, "" );
+  APPE_PERF_Put( "mac_rx", UINT32_MAX, stMacStats.Total.RxCount, "" );
+  APPE_PERF_Put( "mac_rx_fcs_error", UINT32_MAX, stMacStats.Total.RxCrcErrorCount, "" );
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  {
+    MAC_SYS_BufferStats_t   stBufferStats;
+
+    MacSys_GetBufferStats( &stBufferStats );
+    APPE_PERF_Put( "mac_buffer_failures", UINT32_MAX, stBufferStats.AllocFailCount, "" );
+    APPE_PERF_Put( "mac_buffer_small_peak", UINT32_MAX, stBufferStats.SmallPeak, "" );
+    APPE_PERF_Put( "mac_buffer_large_peak", UINT32_MAX, stBufferStats.LargePeak, "" );
+  }
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+  if ( ( stZigbeeAppInfo.pstZigbee != NULL ) &&
+       ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) == ZB_STATUS_SUCCESS ) )
+  {
+    APPE_PERF_Put( "aps_ucast_success", UINT32_MAX, stApsStats.aps_tx_ucast_success, "" );
+    APPE_PERF_Put( "aps_ucast_retry", UINT32_MAX, stApsStats.aps_tx_ucast_retry, "" );
+    APPE_PERF_Put( "aps_ucast_fail", UINT32_MAX, stApsStats.aps_tx_ucast_fail, "" );
+    APPE_PERF_Put( "nwk_mac_ucast", UINT32_MAX, stApsStats.mac_tx_ucast, "" );
+    APPE_PERF_Put( "nwk_mac_ucast_retry", UINT32_MAX, stApsStats.mac_tx_ucast_retry, "" );
+    APPE_PERF_Put( "nwk_mac_ucast_fail", UINT32_MAX, stApsStats.mac_tx_ucast_fail, "" );
+    APPE_PERF_Put( "nwk_decrypt_failures", UINT32_MAX, stApsStats.nwk_decrypt_failures, "" );
+  }
+
+#if (CFG_LPM_LEVEL != 0)
+  PWR_GetLpmStats( &stLpmStats );
+  for ( lIndex = 0; lIndex < APPE_LPM_MODE_NB; lIndex++ )
+  {
+    APPE_PERF_Put( "lpm_entries_mode", lIndex, stLpmStats.Entries[lIndex], "" );
+    APPE_PERF_Put( "lpm_residency_mode", lIndex, (uint32_t)( stLpmStats.ResidencyUs[lIndex] / 1000u ), "ms" );
+  }
+  APPE_PERF_Put( "lpm_wakeup_max_latency", UINT32_MAX, stLpmStats.LatencyMaxUs, "us" );
+#endif /* (CFG_LPM_LEVEL != 0) */
+
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  APPE_PERF_Put( "cpu_load_1s", UINT32_MAX, APPE_LOAD_Get( 1u ), "permille" );
+  APPE_PERF_Put( "cpu_load_10s", UINT32_MAX, APPE_LOAD_Get( 10u ), "permille" );
+  APPE_PERF_Put( "cpu_load_60s", UINT32_MAX, APPE_LOAD_Get( 60u ), "permille" );
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
 
-  /* USER CODE END MX_APPE_Process_2 */
-}
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+  /* Since the last CRYPTOSTATS (it resets them) */
+  for ( lIndex = 0u; lIndex < (uint32_t)ZIGBEE_PLAT_CRYPTO_NBR; lIndex++ )
+  {
+    if ( ( ZIGBEE_PLAT_GetCryptoStats( (uint8_t)lIndex, &stCryptoStats ) == true ) && ( stCryptoStats.lCallNbr != 0u ) )
+    {
+      APPE_PERF_Put( "crypto_calls_op", lIndex, stCryptoStats.lCallNbr, "" );
+      APPE_PERF_Put( "crypto_time_op", lIndex, (uint32_t)( stCryptoStats.llTotalCycles / lCyclePerUs ), "us" );
+    }
+  }
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
 
-/* USER CODE BEGIN FD */
+  LOG_INFO_SYSTEM( "PERFSNAP,end" );
+}
+#endif /* (CFG_PERF_SNAPSHOT_SUPPORTED != 0) */
 
 /* USER CODE END FD */
 
@@ -230,6 +2117,17 @@ void MX_APPE_Process(void)
  *
  *************************************************************/
 
+#if (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT)
+/**
+ * @brief   Time stamp of the logs, in microseconds on 32 bits (wraps after 71 minutes), from the microseconds time
+ *          base : it continues through the Stop modes.
+ */
+static uint32_t APPE_LOG_GetTimeStampUs(void)
+{
+  return (uint32_t)TIMER_IF_GetTimeUs();
+}
+#endif /* (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT) */
+
 /**
  * @brief Configure HSE by read this Tuning from OTP
  *
@@ -261,6 +2159,9 @@ static void System_Init( void )
   /* Initialize the Timer Server */
   UTIL_TIMER_Init();
 
+  /* Task used when more timers than UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ expire at once */
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_TIMER_SERVER ), UTIL_SEQ_RFU, UTIL_TIMER_ProcessExpired );
+
   /* Enable wakeup out of standby from RTC ( UTIL_TIMER )*/
   HAL_PWR_EnableWakeUpPin(PWR_WAKEUP_PIN7_HIGH_3);
 
@@ -269,11 +2170,26 @@ static void System_Init( void )
 
   /* Initialize the logs ( using the USART ) */
   Log_Module_Init( Log_Module_Config );
+#if (CFG_LOG_BINARY_SUPPORTED != 0) || (CFG_LOG_CAPTURE_SUPPORTED != 0) || (CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0)
+#if (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT)
+  Log_Module_RegisterBinaryTimeStampFunction( APPE_LOG_GetTimeStampUs );
+#else /* (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT) */
+  Log_Module_RegisterBinaryTimeStampFunction( UTIL_TIMER_GetCurrentTime );
+#endif /* (CFG_LOG_TIME_STAMP_SOURCE == CFG_LOG_TIME_STAMP_SOURCE_DWT) */
+#endif /* (CFG_LOG_BINARY_SUPPORTED != 0) || (CFG_LOG_CAPTURE_SUPPORTED != 0) || (CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0) */
+#if (CFG_LOG_RATE_LIMIT_SUPPORTED != 0)
+  Log_Module_RegisterTickFunction( UTIL_TIMER_GetCurrentTime );
+  Log_Module_Set_Rate_Limit( LOG_REGION_ALL_REGIONS, CFG_LOG_RATE_LIMIT_PER_SECOND, CFG_LOG_RATE_LIMIT_BURST );
+#endif /* (CFG_LOG_RATE_LIMIT_SUPPORTED != 0) */
   Log_Module_Set_Region( LOG_REGION_APP );
   Log_Module_Add_Region( LOG_REGION_ZIGBEE );
 
   /* Initialize the Command Interpreter */
+  APPE_SerialCmdInit();
   Serial_CMD_Interpreter_Init();
+
+  /* Binary host protocol on the same UART (HOSTSTATS) */
+  APP_HOST_Init();
 #endif  /* (CFG_LOG_SUPPORTED != 0) */
 
 #if(CFG_RT_DEBUG_DTB == 1)
@@ -285,6 +2201,10 @@ static void System_Init( void )
   /* RT DEBUG GPIO_Init */
   RT_DEBUG_GPIO_Init();
 #endif /* (CFG_RT_DEBUG_GPIO_MODULE == 1) */
+#if(CFG_RT_DEBUG_ITM == 1)
+  /* RT DEBUG ITM timeline trace */
+  RT_DEBUG_ITMInit();
+#endif /* (CFG_RT_DEBUG_ITM == 1) */
 
 #if ( CFG_LPM_LEVEL != 0)
   system_startup_done = TRUE;
@@ -335,13 +2255,25 @@ static void SystemPower_Config(void)
   UTIL_LPM_Init();
 
 #if (CFG_LPM_STDBY_SUPPORTED > 0)
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+  /* Retain only the SRAM1 pages of the RAM region (data, bss, AMM pool and stack) : the scratch pool (pages 5 to 7)
+   * and SRAM2 are lost in Standby. Enable RADIO retention */
+  LL_PWR_SetSRAM1SBRetention(LL_PWR_SRAM1_SB_PAGE1_RETENTION | LL_PWR_SRAM1_SB_PAGE2_RETENTION |
+                             LL_PWR_SRAM1_SB_PAGE3_RETENTION | LL_PWR_SRAM1_SB_PAGE4_RETENTION);
+  LL_PWR_SetSRAM2SBRetention(LL_PWR_SRAM2_SB_NO_RETENTION);
+#else
   /* Enable SRAM1, SRAM2 and RADIO retention*/
   LL_PWR_SetSRAM1SBRetention(LL_PWR_SRAM1_SB_FULL_RETENTION);
   LL_PWR_SetSRAM2SBRetention(LL_PWR_SRAM2_SB_FULL_RETENTION);
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
   LL_PWR_SetRadioSBRetention(LL_PWR_RADIO_SB_FULL_RETENTION); /* Retain sleep timer configuration */
 
 #endif /* (CFG_LPM_STDBY_SUPPORTED > 0) */
 
+  /* DWT cycle counter for the transition costs of the low power modes */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
   /* Disable LowPower during Init */
   UTIL_LPM_SetStopMode(1U << CFG_LPM_APP, UTIL_LPM_DISABLE);
   UTIL_LPM_SetOffMode(1U << CFG_LPM_APP, UTIL_LPM_DISABLE);
@@ -358,11 +2290,24 @@ static void SystemPower_Config(void)
  */
 static void APPE_RNG_Init(void)
 {
+#if (CFG_BOOT_PARALLEL_INIT_SUPPORTED == 0)
   HW_RNG_Start();
+#endif /* (CFG_BOOT_PARALLEL_INIT_SUPPORTED == 0) */
 
   /* Register Random Number Generator task */
-  UTIL_SEQ_RegTask(1U << CFG_TASK_HW_RNG, UTIL_SEQ_RFU, (void (*)(void))HW_RNG_Process);
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_HW_RNG ), UTIL_SEQ_RFU, (void (*)(void))HW_RNG_Process);
+}
+
+#if (CFG_HW_PKA_ASYNC_SUPPORTED != 0)
+/**
+ * @brief Initialize the asynchronous PKA jobs
+ */
+static void APPE_PKA_Init(void)
+{
+  /* Register the PKA task (end of a job and start of the next one) */
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_HW_PKA ), UTIL_SEQ_RFU, HW_PKA_Process);
 }
+#endif /* (CFG_HW_PKA_ASYNC_SUPPORTED != 0) */
 
 static void APPE_AMM_Init(void)
 {
@@ -372,9 +2317,323 @@ static void APPE_AMM_Init(void)
     Error_Handler();
   }
 
+  /* Notify the Zigbee layer when the shared pool becomes low */
+  (void)AMM_SetLowWatermark(CFG_AMM_LOW_WATERMARK_SIZE);
+
   /* Register Advance Memory Manager task */
-  UTIL_SEQ_RegTask(1U << CFG_TASK_AMM, UTIL_SEQ_RFU, AMM_BackgroundProcess);
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_AMM ), UTIL_SEQ_RFU, AMM_BackgroundProcess);
+
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+  UTIL_TIMER_Create(&stAmmRebalanceTimer, CFG_AMM_REBALANCE_DELAY, UTIL_TIMER_ONESHOT, &APPE_AMM_RebalanceTimerCallback, NULL);
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+  APPE_MEM_ScratchReset();
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+}
+
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+/**
+ * @brief   End of the boot-heavy phase : the rebalance of the reservations is done CFG_AMM_REBALANCE_DELAY later.
+ */
+void APPE_AMM_RebalanceStart(void)
+{
+  UTIL_TIMER_Start(&stAmmRebalanceTimer);
+}
+
+static void APPE_AMM_RebalanceTimerCallback(void * arg)
+{
+  UNUSED(arg);
+
+  APPE_AMM_Rebalance();
+}
+
+/**
+ * @brief   Shrink the ZIGBEE_INIT reservation to its occupation plus CFG_AMM_REBALANCE_INIT_MARGIN, and give a share of
+ *          the released memory to the ZIGBEE_HEAP reservation. The free shared pool only grows : the watermark is not
+ *          crossed downwards by a rebalance.
+ */
+void APPE_AMM_Rebalance(void)
+{
+  AMM_VirtualMemoryStats_t  stInitStats;
+  AMM_VirtualMemoryStats_t  stHeapStats;
+  uint32_t                  lInitSize, lReleased, lGranted;
+
+  if ( ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, &stInitStats ) != AMM_ERROR_OK )
+    || ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, &stHeapStats ) != AMM_ERROR_OK ) )
+  {
+    return;
+  }
+
+  lInitSize = stInitStats.OccupiedSize + CFG_AMM_REBALANCE_INIT_MARGIN;
+  if ( lInitSize >= stInitStats.ReservedSize )
+  {
+    LOG_INFO_SYSTEM( "AMM rebalance : nothing to release (ZIGBEE_INIT reserved %u bytes, occupied %u bytes)",
+                     ( stInitStats.ReservedSize * sizeof( uint32_t ) ), ( stInitStats.OccupiedSize * sizeof( uint32_t ) ) );
+    return;
+  }
+
+  if ( AMM_ResizeVirtualMemory( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, lInitSize ) != AMM_ERROR_OK )
+  {
+    lAmmRebalanceFailedNb++;
+    LOG_WARNING_SYSTEM( "AMM rebalance : ZIGBEE_INIT shrink to %u bytes refused", ( lInitSize * sizeof( uint32_t ) ) );
+    return;
+  }
+  lReleased = stInitStats.ReservedSize - lInitSize;
+  lAmmReleasedSize += lReleased;
+
+  /* Share of the released memory, up to the maximum reservation of the runtime heap */
+  lGranted = ( lReleased * CFG_AMM_REBALANCE_HEAP_SHARE ) / 100u;
+  if ( stHeapStats.ReservedSize >= CFG_AMM_REBALANCE_HEAP_MAX_SIZE )
+  {
+    lGranted = 0u;
+  }
+  else if ( ( stHeapStats.ReservedSize + lGranted ) > CFG_AMM_REBALANCE_HEAP_MAX_SIZE )
+  {
+    lGranted = CFG_AMM_REBALANCE_HEAP_MAX_SIZE - stHeapStats.ReservedSize;
+  }
+
+  if ( lGranted != 0u )
+  {
+    if ( AMM_ResizeVirtualMemory( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, ( stHeapStats.ReservedSize + lGranted ) ) == AMM_ERROR_OK )
+    {
+      lAmmGrantedSize += lGranted;
+    }
+    else
+    {
+      lAmmRebalanceFailedNb++;
+      lGranted = 0u;
+    }
+  }
+
+  lAmmRebalanceNb++;
+  LOG_INFO_SYSTEM( "AMM rebalance : ZIGBEE_INIT %u -> %u bytes, ZIGBEE_HEAP %u -> %u bytes",
+                   ( stInitStats.ReservedSize * sizeof( uint32_t ) ), ( lInitSize * sizeof( uint32_t ) ),
+                   ( stHeapStats.ReservedSize * sizeof( uint32_t ) ), ( ( stHeapStats.ReservedSize + lGranted ) * sizeof( uint32_t ) ) );
+}
+
+/**
+ * @brief   Print the reservation of each virtual memory (and its size at boot), the shared pool and the rebalances.
+ */
+void APPE_AMM_PrintStats(void)
+{
+  AMM_VirtualMemoryStats_t  stAmmStats;
+  uint32_t                  lIndex;
+
+  for ( lIndex = 0u; lIndex < CFG_AMM_VIRTUAL_MEMORY_NUMBER; lIndex++ )
+  {
+    if ( AMM_GetVirtualMemoryStats( vmConfig[lIndex].Id, &stAmmStats ) == AMM_ERROR_OK )
+    {
+      LOG_INFO_SYSTEM( "Virtual memory %u : reserved %u bytes (%u at boot), occupied %u bytes", vmConfig[lIndex].Id,
+                       ( stAmmStats.ReservedSize * sizeof( uint32_t ) ), ( vmConfig[lIndex].BufferSize * sizeof( uint32_t ) ),
+                       ( stAmmStats.OccupiedSize * sizeof( uint32_t ) ) );
+    }
+  }
+
+  if ( AMM_GetVirtualMemoryStats( AMM_NO_VIRTUAL_ID, &stAmmStats ) == AMM_ERROR_OK )
+  {
+    LOG_INFO_SYSTEM( "Shared pool : occupied %u bytes, free %u bytes", ( stAmmStats.OccupiedSize * sizeof( uint32_t ) ),
+                     ( stAmmStats.AvailableSize * sizeof( uint32_t ) ) );
+  }
+
+  LOG_INFO_SYSTEM( "Rebalance : %u done, %u resizes refused, %u bytes released by ZIGBEE_INIT, %u bytes given to ZIGBEE_HEAP",
+                   lAmmRebalanceNb, lAmmRebalanceFailedNb, ( lAmmReleasedSize * sizeof( uint32_t ) ),
+                   ( lAmmGrantedSize * sizeof( uint32_t ) ) );
+}
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+/**
+ * @brief   Initialize the scratch pool, at boot and at the exit of Standby (its content, free list included, is lost
+ *          there, Standby being used only when no scratch buffer is allocated).
+ *          It is managed by the basic memory manager that the AMM does not use.
+ * @retval  None
+ */
+void APPE_MEM_ScratchReset(void)
+{
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+  UTIL_MM_Init((uint8_t *)alScratchPool, sizeof(alScratchPool));
+#else
+  UTIL_TLSF_Init((uint8_t *)alScratchPool, sizeof(alScratchPool));
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
+}
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+
+/**
+ * @brief   Allocate a buffer according to its lifetime : the persistent buffers come from the AMM pool (retained in
+ *          Standby), the scratch ones from the scratch pool (not retained, Standby not used while one is allocated),
+ *          or from the AMM pool when it is full or not supported.
+ * @param   lSize       Size in bytes.
+ * @param   eLifetime   Lifetime of the buffer.
+ * @retval  Pointer on the buffer (32 bits aligned), NULL if no memory.
+ */
+void * APPE_MEM_Alloc(uint32_t lSize, APPE_MEM_Lifetime_t eLifetime)
+{
+  uint32_t  * pBuffer = NULL;
+
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+  if ( eLifetime == APPE_MEM_SCRATCH )
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+    pBuffer = (uint32_t *)UTIL_MM_GetBuffer((size_t)lSize);
+#else
+    pBuffer = (uint32_t *)UTIL_TLSF_GetBuffer((size_t)lSize);
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
+    if ( pBuffer != NULL )
+    {
+      lScratchBufferNb++;
+      if ( lScratchBufferNb > lScratchBufferPeakNb )
+      {
+        lScratchBufferPeakNb = lScratchBufferNb;
+      }
+#if (CFG_LPM_LEVEL != 0)
+      UTIL_LPM_SetOffMode(1U << CFG_LPM_SCRATCH, UTIL_LPM_DISABLE);
+#endif /* (CFG_LPM_LEVEL != 0) */
+    }
+    else
+    {
+      lScratchFallbackNb++;
+    }
+    UTILS_EXIT_CRITICAL_SECTION();
+
+    if ( pBuffer != NULL )
+    {
+      return pBuffer;
+    }
+  }
+#else /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+  UNUSED(eLifetime);
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+
+  if ( AMM_Alloc(AMM_NO_VIRTUAL_ID, DIVC(lSize, sizeof(uint32_t)), &pBuffer, NULL) != AMM_ERROR_OK )
+  {
+    pBuffer = NULL;
+  }
+
+  return pBuffer;
+}
+
+/**
+ * @brief   Release a buffer of APPE_MEM_Alloc(), Standby allowed again when the last scratch buffer is released.
+ * @param   pBuffer   Pointer on the buffer.
+ * @retval  None
+ */
+void APPE_MEM_Free(void * pBuffer)
+{
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+  if ( ( (uint32_t *)pBuffer >= &alScratchPool[0] ) &&
+       ( (uint32_t *)pBuffer < &alScratchPool[sizeof(alScratchPool) / sizeof(alScratchPool[0])] ) )
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+    UTIL_MM_ReleaseBuffer(pBuffer);
+#else
+    UTIL_TLSF_ReleaseBuffer(pBuffer);
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
+    lScratchBufferNb--;
+#if (CFG_LPM_LEVEL != 0)
+    if ( lScratchBufferNb == 0u )
+    {
+      UTIL_LPM_SetOffMode(1U << CFG_LPM_SCRATCH, UTIL_LPM_ENABLE);
+    }
+#endif /* (CFG_LPM_LEVEL != 0) */
+    UTILS_EXIT_CRITICAL_SECTION();
+    return;
+  }
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
+
+  (void)AMM_Free((uint32_t *)pBuffer);
+}
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+/**
+ * @brief Initialize the Flash Manager and the Simple NVM Arbiter (or Simple NVM Log) modules
+ */
+static void APPE_NVM_Init(void)
+{
+  /* Register Flash Manager task */
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_FLASH_MANAGER ), UTIL_SEQ_RFU, FM_BackgroundProcess);
+
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  /* Initialize the Simple NVM Log, in the pages of the Simple NVM Arbiter banks */
+  if( SNVML_Init((uint32_t *)CFG_SNVMA_START_ADDRESS) != SNVML_ERROR_OK )
+  {
+    Error_Handler();
+  }
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  /* Initialize the Simple NVM Arbiter */
+  if( SNVMA_Init((uint32_t *)CFG_SNVMA_START_ADDRESS) != SNVMA_ERROR_OK )
+  {
+    Error_Handler();
+  }
+
+  /* The CRC of the bank trusted by SNVMA_Init is checked once the boot is over */
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_SNVMA_CHECK ), UTIL_SEQ_TASK_DEFERRABLE, APPE_NVM_CheckTask);
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_SNVMA_CHECK ), TASK_PRIO_SNVMA_CHECK);
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+  /* The writes merged by the coalescing window are started by a Task once the timer elapses */
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_SNVMA_FLUSH ), UTIL_SEQ_RFU, APPE_NVM_FlushTask);
+  UTIL_TIMER_Create(&SNVMA_FlushTimer, SNVMA_WRITE_COALESCING_DELAY, UTIL_TIMER_ONESHOT, &APPE_NVM_FlushTimerCallback, NULL);
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+}
+
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0)
+/**
+ * @brief Check in background the CRC of the Simple NVM Arbiter bank trusted at boot from its summary
+ */
+static void APPE_NVM_CheckTask(void)
+{
+  /* When a write is on going (SNVMA_ERROR_CMD_PENDING), its new bank is checked at the end of the write */
+  if ( SNVMA_Check() == SNVMA_ERROR_NVM_BANK_CORRUPTED )
+  {
+    LOG_ERROR_APP( "Persistence NVM bank corrupted, erased : the next save rewrites it" );
+  }
+}
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+/**
+ * @brief Arm the coalescing timer of the Simple NVM Arbiter, a running timer is restarted with the new delay
+ */
+void SNVMA_CoalescingTimerStart(const uint32_t Delay)
+{
+  if ( Delay == 0u )
+  {
+    /* Max latency reached : flush as soon as possible */
+    (void)UTIL_TIMER_Stop(&SNVMA_FlushTimer);
+    UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_SNVMA_FLUSH ), TASK_PRIO_SNVMA_FLUSH);
+  }
+  else
+  {
+    (void)UTIL_TIMER_StartWithPeriod(&SNVMA_FlushTimer, Delay);
+  }
+}
+
+/**
+ * @brief Coalescing window elapsed, the flush is done in Task context
+ */
+static void APPE_NVM_FlushTimerCallback(void * arg)
+{
+  UNUSED(arg);
+
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_SNVMA_FLUSH ), TASK_PRIO_SNVMA_FLUSH);
+}
+
+/**
+ * @brief Start the write of the requests merged by the coalescing windows that are over
+ */
+static void APPE_NVM_FlushTask(void)
+{
+  if ( SNVMA_FlushDue() == SNVMA_ERROR_FLASH_ERROR )
+  {
+    LOG_ERROR_APP( "Persistence NVM flush refused by the Flash Manager" );
+  }
 }
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED == 0) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
 
 /* USER CODE BEGIN FD_LOCAL_FUNCTIONS */
 
@@ -395,6 +2654,7 @@ void UTIL_SEQ_Idle( void )
   SCM_HSE_StopStabilizationTimer();
   /* SCM HSE END */
 #endif /* CFG_SCM_SUPPORTED */
+  APPE_LPM_EnterMeasure();
   UTIL_LPM_EnterLowPower();
   HAL_ResumeTick();
 #endif /* CFG_LPM_LEVEL */
@@ -404,6 +2664,13 @@ void UTIL_SEQ_Idle( void )
 void UTIL_SEQ_PreIdle( void )
 {
   /* USER CODE BEGIN UTIL_SEQ_PreIdle_1 */
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  APPE_LOAD_IdleEnter();
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+#if ( CFG_LPM_LEVEL != 0)
+  /* Select the low power mode before it is entered (Standby prepared below) */
+  APPE_LPM_DeadlinePolicy();
+#endif /* CFG_LPM_LEVEL */
 
   /* USER CODE END UTIL_SEQ_PreIdle_1 */
 #if ( CFG_LPM_LEVEL != 0)
@@ -447,18 +2714,42 @@ void UTIL_SEQ_PostIdle( void )
   ll_sys_dp_slp_exit();
 #endif /* CFG_LPM_LEVEL */
   /* USER CODE BEGIN UTIL_SEQ_PostIdle_2 */
+#if ( CFG_LPM_LEVEL != 0)
+  APPE_LPM_CostUpdate();
+#endif /* CFG_LPM_LEVEL */
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  APPE_LOAD_IdleExit();
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
 
   /* USER CODE END UTIL_SEQ_PostIdle_2 */
   return;
 }
 
+/**
+ * @brief Callback used by Timer Server to launch Task to process the remaining expired timers
+ */
+void UTIL_TIMER_DeferExpiry( void )
+{
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_TIMER_SERVER ), TASK_PRIO_TIMER_SERVER );
+}
+
 /**
  * @brief Callback used by Random Number Generator to launch Task to generate Random Numbers
  */
 void HWCB_RNG_Process( void )
 {
-  UTIL_SEQ_SetTask(1U << CFG_TASK_HW_RNG, TASK_PRIO_RNG);
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_HW_RNG ), TASK_PRIO_RNG);
+}
+
+#if (CFG_HW_PKA_ASYNC_SUPPORTED != 0)
+/**
+ * @brief Callback used by the PKA driver to launch the Task of the asynchronous jobs
+ */
+void HWCB_PKA_Process( void )
+{
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_HW_PKA ), TASK_PRIO_HW_PKA);
 }
+#endif /* (CFG_HW_PKA_ASYNC_SUPPORTED != 0) */
 
 void AMM_RegisterBasicMemoryManager (AMM_BasicMemoryManagerFunctions_t * const p_BasicMemoryManagerFunctions)
 {
@@ -466,27 +2757,76 @@ void AMM_RegisterBasicMemoryManager (AMM_BasicMemoryManagerFunctions_t * const p
   p_BasicMemoryManagerFunctions->Init = AMM_WrapperInit;
   p_BasicMemoryManagerFunctions->Allocate = AMM_WrapperAllocate;
   p_BasicMemoryManagerFunctions->Free = AMM_WrapperFree;
+  p_BasicMemoryManagerFunctions->GetLargestFreeBlock = AMM_WrapperGetLargestFreeBlock;
 }
 
 void AMM_ProcessRequest(void)
 {
   /* Trigger to call Advance Memory Manager process function */
-  UTIL_SEQ_SetTask(1U << CFG_TASK_AMM, CFG_SEQ_PRIO_0);
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_AMM ), CFG_SEQ_PRIO_SYSTEM);
+}
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+void FM_ProcessRequest(void)
+{
+  /* Trigger to call Flash Manager process function, within the radio window of a write */
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+  UTIL_SEQ_SetTaskDeadline(UTIL_SEQ_TASK_BM( CFG_TASK_FLASH_MANAGER ), TASK_PRIO_FLASH_MANAGER,
+                           ( (uint32_t)TIMER_IF_GetTimeUs() + TIME_WINDOW_WRITE_DURATION ));
+#else
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_FLASH_MANAGER ), TASK_PRIO_FLASH_MANAGER);
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+}
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+void AMM_LowWatermarkNotification(const uint8_t Reached)
+{
+  if (Reached == TRUE)
+  {
+    LOG_WARNING_SYSTEM("AMM shared pool below the low watermark");
+  }
+  else
+  {
+    LOG_INFO_SYSTEM("AMM shared pool back above the low watermark");
+  }
+
+  ZIGBEE_PLAT_HeapLowNotification((Reached == TRUE));
 }
 
 static void AMM_WrapperInit(uint32_t * const p_PoolAddr, const uint32_t PoolSize)
 {
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+  UTIL_TLSF_Init ((uint8_t *)p_PoolAddr, ((size_t)PoolSize * sizeof(uint32_t)));
+#else
   UTIL_MM_Init ((uint8_t *)p_PoolAddr, ((size_t)PoolSize * sizeof(uint32_t)));
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
 }
 
 static uint32_t * AMM_WrapperAllocate(const uint32_t BufferSize)
 {
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+  return (uint32_t *)UTIL_TLSF_GetBuffer (((size_t)BufferSize * sizeof(uint32_t)));
+#else
   return (uint32_t *)UTIL_MM_GetBuffer (((size_t)BufferSize * sizeof(uint32_t)));
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
 }
 
 static void AMM_WrapperFree (uint32_t * const p_BufferAddr)
 {
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+  UTIL_TLSF_ReleaseBuffer ((void *)p_BufferAddr);
+#else
   UTIL_MM_ReleaseBuffer ((void *)p_BufferAddr);
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
+}
+
+static uint32_t AMM_WrapperGetLargestFreeBlock(void)
+{
+#if (CFG_AMM_BMM_TLSF_SUPPORTED != 0)
+  return (uint32_t)(UTIL_TLSF_GetLargestFreeBlock () / sizeof(uint32_t));
+#else
+  return (uint32_t)(UTIL_MM_GetLargestFreeBlock () / sizeof(uint32_t));
+#endif /* (CFG_AMM_BMM_TLSF_SUPPORTED != 0) */
 }
 
 #if ((CFG_LOG_SUPPORTED == 0) && (CFG_LPM_LEVEL != 0))
@@ -540,6 +2880,122 @@ void UTIL_ADV_TRACE_PostSendHook(void)
   /* USER CODE END UTIL_ADV_TRACE_PostSendHook */
 }
 
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+/**
+ * @brief  Dump the Zigbee heap allocations still in use.
+ */
+static void APPE_HEAP_TraceDump( void )
+{
+  ZIGBEE_PLAT_HeapTraceDump( true );
+}
+
+/**
+ * @brief  Dump all the Zigbee heap allocations traced.
+ */
+static void APPE_HEAP_TraceDumpAll( void )
+{
+  ZIGBEE_PLAT_HeapTraceDump( false );
+}
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+/* Diagnostic commands without argument, sorted by keyword */
+static const SerialCmd_t APPE_SerialCmds[] =
+{
+#if (CFG_AMM_REBALANCE_SUPPORTED != 0)
+  { "AMMREBALANCE", APPE_AMM_Rebalance, NULL },
+  { "AMMSTATS", APPE_AMM_PrintStats, NULL },
+#endif /* (CFG_AMM_REBALANCE_SUPPORTED != 0) */
+#if (CFG_BOOT_PROFILE_SUPPORTED != 0)
+  { "BOOTSTATS", APPE_BOOT_PrintStats, NULL },
+#endif /* (CFG_BOOT_PROFILE_SUPPORTED != 0) */
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  { "CLKSTATS", APPE_CLK_PrintStats, NULL },
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+  { "CRYPTOSTATS", APPE_CRYPTO_PrintStats, NULL },
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+  { "DELAYSTATS", APPE_LL_DELAY_PrintStats, NULL },
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+  { "FLASHSTATS", APPE_FLASH_PrintStats, NULL },
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+  { "HEAPRECSTART", ZIGBEE_PLAT_HeapRecordStart, NULL },
+  { "HEAPRECSTOP", ZIGBEE_PLAT_HeapRecordStop, NULL },
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+#if (CFG_HEAP_DIAG_SUPPORTED != 0)
+  { "HEAPSTATS", APPE_HEAP_PrintStats, NULL },
+#endif /* (CFG_HEAP_DIAG_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+  { "HEAPTRACE", APPE_HEAP_TraceDump, NULL },
+  { "HEAPTRACEALL", APPE_HEAP_TraceDumpAll, NULL },
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+#if (CFG_ICACHE_STATS_SUPPORTED != 0)
+  { "ICACHESTATS", APPE_ICACHE_PrintStats, NULL },
+#endif /* (CFG_ICACHE_STATS_SUPPORTED != 0) */
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+  { "ISRSTATS", APPE_LL_ISR_PrintStats, NULL },
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_LATENCY_SUPPORTED != 0) && (CFG_ZIGBEE_SNIFFER_SUPPORTED == 0)
+  { "LATRESET", APP_ZIGBEE_LatencyReset, NULL },
+  { "LATSTATS", APP_ZIGBEE_LatencyPrintStats, NULL },
+#endif /* (CFG_ZIGBEE_LATENCY_SUPPORTED != 0) && (CFG_ZIGBEE_SNIFFER_SUPPORTED == 0) */
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+  { "LLBGSTATS", APPE_LL_BG_PrintStats, NULL },
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  { "LOADSTATS", APPE_LOAD_PrintStats, NULL },
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+#if (CFG_LPM_LEVEL != 0)
+  { "LPMSTATS", APPE_LPM_PrintStats, NULL },
+#endif /* (CFG_LPM_LEVEL != 0) */
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  { "MACSTATS", APPE_MAC_PrintStats, NULL },
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  { "NVMSTATS", APPE_NVM_PrintStats, NULL },
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) && (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+#if (CFG_PERF_SNAPSHOT_SUPPORTED != 0)
+  { "PERFSNAP", APPE_PERF_PrintSnapshot, NULL },
+#endif /* (CFG_PERF_SNAPSHOT_SUPPORTED != 0) */
+#if (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0)
+  { "PRIOSTATS", APPE_SEQ_PrintPrio, NULL },
+#endif /* (CFG_SEQ_PRIO_CHECK_SUPPORTED != 0) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  { "RCOSTATS", APPE_RCO_PrintStats, NULL },
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+  { "RUNBUS", APPE_RUNBUS_Print, NULL },
+#endif /* (CFG_RT_DEBUG_RUN_BUS != 0) */
+#if (CFG_SEQ_DEADLINE_SUPPORTED != 0)
+  { "SEQDEADLINE", APPE_SEQ_PrintDeadlines, NULL },
+#endif /* (CFG_SEQ_DEADLINE_SUPPORTED != 0) */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  { "SEQSTATS", APPE_SEQ_PrintStats, NULL },
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+#if (CFG_STACK_MONITOR_SUPPORTED != 0)
+  { "STACKSTATS", APPE_STACK_PrintStats, NULL },
+#endif /* (CFG_STACK_MONITOR_SUPPORTED != 0) */
+#if (CFG_TIMER_STATS_SUPPORTED != 0)
+  { "TIMSTATS", APPE_TIMER_PrintStats, NULL },
+#endif /* (CFG_TIMER_STATS_SUPPORTED != 0) */
+#if (CFG_LOG_TRACE_STATS_SUPPORTED != 0)
+  { "TRACESTATS", APPE_TRACE_PrintStats, NULL },
+#endif /* (CFG_LOG_TRACE_STATS_SUPPORTED != 0) */
+};
+
+static SerialCmdTable_t APPE_SerialCmdTable =
+{
+  APPE_SerialCmds, ( sizeof( APPE_SerialCmds ) / sizeof( APPE_SerialCmds[0] ) ), NULL
+};
+
+/**
+ * @brief  Register the diagnostic commands of the application entry.
+ */
+static void APPE_SerialCmdInit( void )
+{
+  Serial_CMD_Interpreter_RegisterTable( &APPE_SerialCmdTable );
+}
+
 /**
  * @brief  Treat Serial commands.
  *
@@ -550,7 +3006,115 @@ void UTIL_ADV_TRACE_PostSendHook(void)
 void Serial_CMD_Interpreter_CmdExecute( uint8_t * pRxBuffer, uint16_t iRxBufferSize )
 {
   /* USER CODE BEGIN Serial_CMD_Interpreter_CmdExecute_1 */
-  
+  /* Commands registered by the modules */
+  if ( Serial_CMD_Interpreter_Dispatch( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+  if ( APPE_COEX_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+  if ( APPE_LOG_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_CRYPTO_BenchSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_NVM_BenchSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_HSE_TuneSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_SUPPLY_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_CRASH_LOG_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_FRAME_LOG_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_BLE_DIAG_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+#if (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0)
+  /* Sniffer : no Zigbee stack behind the other commands */
+  (void)APP_ZIGBEE_SnifferSerialCmdExecute( (char const*)pRxBuffer );
+  return;
+#endif /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
+  if ( APP_ZIGBEE_SerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_HealthSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_BroadcastSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_ReportSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_OtaSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_OtaServerSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_StaggerSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_BatchSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_ZddSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_PollSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_TxPowerSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_CsmaSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_ChannelSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_CounterSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+  if ( APP_ZIGBEE_TimeSyncSerialCmdExecute( (char const*)pRxBuffer ) != false )
+  {
+    return;
+  }
+
   /* Threat USART Command to simulate button press for instance. */
   (void)APP_BSP_SerialCmdExecute( pRxBuffer, iRxBufferSize );
 
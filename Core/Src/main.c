@@ -21,6 +21,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "app_crash_log.h"
 
 /* USER CODE END Includes */
 
@@ -76,6 +77,8 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
+  APPE_STACK_Paint();
+  APPE_BOOT_Mark( APPE_BOOT_MAIN );
 
   /* USER CODE END 1 */
 
@@ -87,6 +90,7 @@ int main(void)
   MX_APPE_Config();
 
   /* USER CODE BEGIN Init */
+  APPE_BOOT_Mark( APPE_BOOT_APPE_CONFIG );
 
   /* USER CODE END Init */
 
@@ -97,6 +101,7 @@ int main(void)
   PeriphCommonClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  APPE_BOOT_Mark( APPE_BOOT_CLOCK_CONFIG );
 
   /* USER CODE END SysInit */
 
@@ -108,6 +113,7 @@ int main(void)
   MX_RTC_Init();
   MX_RNG_Init();
   /* USER CODE BEGIN 2 */
+  APPE_BOOT_Mark( APPE_BOOT_PERIPHERALS );
 
   /* USER CODE END 2 */
 
@@ -448,6 +454,14 @@ void MX_USART1_UART_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USART1_Init 2 */
+#if (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0)
+  /* Sniffer : the PCAP stream needs a faster link than the logs */
+  huart1.Init.BaudRate = CFG_ZIGBEE_SNIFFER_BAUDRATE;
+  if (HAL_UART_Init(&huart1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+#endif /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
 
   /* USER CODE END USART1_Init 2 */
 
@@ -486,6 +500,7 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  APP_CRASH_LOG_Fatal( APP_CRASH_LOG_REASON_ERROR_HANDLER, 0u, 0u );
   __disable_irq();
   while (1)
   {
@@ -506,6 +521,7 @@ void assert_failed(uint8_t *file, uint32_t line)
   /* USER CODE BEGIN 6 */
   /* User can add his own implementation to report the file name and line number,
      ex: sprintf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+  APP_CRASH_LOG_Fatal( APP_CRASH_LOG_REASON_ASSERT, line, (uint32_t)file );
   Error_Handler();
   /* USER CODE END 6 */
 }
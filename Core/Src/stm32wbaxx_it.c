@@ -27,6 +27,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "app_bsp.h"
+#include "hw.h"
+#include "app_crash_log.h"
+#include "adc_ctrl.h"
 
 /* USER CODE END Includes */
 
@@ -99,6 +102,7 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
+  APP_CRASH_LOG_Fatal( APP_CRASH_LOG_REASON_HARDFAULT, SCB->HFSR, SCB->CFSR );
 
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
@@ -342,7 +346,7 @@ void RNG_IRQHandler(void)
 /**
   * @brief This function handles 2.4GHz RADIO global interrupt.
   */
-void RADIO_IRQHandler(void)
+HOT_CODE void RADIO_IRQHandler(void)
 {
   /* USER CODE BEGIN RADIO_IRQn 0 */
 
@@ -393,6 +397,36 @@ void HASH_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+#if (CFG_HW_AES_DMA_SUPPORTED != 0)
+/**
+  * @brief This function handles GPDMA1 Channel 3 global interrupt (end of the AES DMA transfers).
+  */
+void GPDMA1_Channel3_IRQHandler(void)
+{
+  HW_AES_DmaIrqHandler();
+}
+#endif /* (CFG_HW_AES_DMA_SUPPORTED != 0) */
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+  * @brief This function handles GPDMA1 Channel 5 global interrupt (end of the ADC batches).
+  */
+void GPDMA1_Channel5_IRQHandler(void)
+{
+  ADCCTRL_DmaIrqHandler();
+}
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+#if (CFG_HW_PKA_ASYNC_SUPPORTED != 0)
+/**
+  * @brief This function handles PKA global interrupt (end of the asynchronous PKA jobs).
+  */
+void PKA_IRQHandler(void)
+{
+  HW_PKA_IrqHandler();
+}
+#endif /* (CFG_HW_PKA_ASYNC_SUPPORTED != 0) */
+
 /**
   * @brief This function handles WKUP global interrupt.
   */
@@ -409,7 +443,11 @@ void WKUP_IRQHandler(void)
   */
 void EXTI4_IRQHandler(void)
 {
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  APP_BSP_ButtonIRQHandler(B3);
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   BSP_PB_IRQHandler(B3);
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 }
 
 /**
@@ -417,7 +455,11 @@ void EXTI4_IRQHandler(void)
   */
 void EXTI5_IRQHandler(void)
 {
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  APP_BSP_ButtonIRQHandler(B2);
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   BSP_PB_IRQHandler(B2);
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 }
 
 /**
@@ -425,7 +467,21 @@ void EXTI5_IRQHandler(void)
   */
 void EXTI13_IRQHandler(void)
 {
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  APP_BSP_ButtonIRQHandler(B1);
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   BSP_PB_IRQHandler(B1);
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
+}
+
+#if defined(CFG_BSP_ON_DISCOVERY) && (CFG_JOYSTICK_SUPPORTED == 1) && (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+/**
+  * @brief This function handles ADC4 interrupt (analog watchdog of the joystick).
+  */
+void ADC4_IRQHandler(void)
+{
+  APP_BSP_JoystickIRQHandler();
 }
+#endif /* defined(CFG_BSP_ON_DISCOVERY) && (CFG_JOYSTICK_SUPPORTED == 1) && (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 
 /* USER CODE END 1 */
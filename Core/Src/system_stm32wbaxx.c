@@ -80,6 +80,7 @@
 
 #include "stm32wbaxx.h"
 #include <math.h>
+#include "app_conf.h"
 
 /**
   * @}
@@ -251,6 +252,13 @@ void SystemInit(void)
   /* Disable ADC kernel clock */
   CLEAR_BIT(RCC->AHB4ENR, RCC_AHB4ENR_ADC4EN);
 #endif
+
+#if (CFG_BOOT_PROFILE_SUPPORTED != 0)
+  /* Boot profile : the cycles are counted from here, before the copy of the data and the clear of the bss */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* (CFG_BOOT_PROFILE_SUPPORTED != 0) */
 }
 
 /**
@@ -333,6 +333,22 @@ static uint64_t u32_muladd64(uint32_t x, uint32_t y, uint32_t z, uint32_t t)
 #endif /* MUL64_IS_CONSTANT_TIME */
 #endif /* MULADD64_ASM */
 
+/*
+ * Compile-time switch for the field multiplication: when P256M_FIELD_MUL_OPT
+ * is 1, m256_mul() uses m256_mul_opt() (the two multiply-accumulate passes of
+ * each Montgomery round fused, the carries kept in registers) instead of the
+ * portable reference m256_mul_ref(). Both are cross-checked by
+ * p256_field_selftest(). By default it is enabled when u32_muladd64() is small
+ * enough to be unrolled (UMAAL on the Cortex-M33 and the other DSP cores).
+ */
+#if !defined(P256M_FIELD_MUL_OPT)
+#if defined(MULADD64_SMALL)
+#define P256M_FIELD_MUL_OPT 1
+#else
+#define P256M_FIELD_MUL_OPT 0
+#endif
+#endif /* P256M_FIELD_MUL_OPT */
+
 /*
  * 288 + 32 x 256 -> 288-bit multiply and add
  *
@@ -573,7 +589,7 @@ static void m256_sub_p(uint32_t z[8],
 }
 
 /*
- * Montgomery modular multiplication
+ * Montgomery modular multiplication (portable reference)
  *
  * in: x, y in [0, m)
  *     mod must point to a valid m256_mod structure
@@ -581,9 +597,9 @@ static void m256_sub_p(uint32_t z[8],
  *
  * Note: as a memory area, z may overlap with x or y.
  */
-static void m256_mul(uint32_t z[8],
-                     const uint32_t x[8], const uint32_t y[8],
-                     const m256_mod *mod)
+static void m256_mul_ref(uint32_t z[8],
+                         const uint32_t x[8], const uint32_t y[8],
+                         const m256_mod *mod)
 {
     /*
      * Algorithm 14.36 in Handbook of Applied Cryptography with:
@@ -613,6 +629,93 @@ static void m256_mul(uint32_t z[8],
     u256_cmov(z, a, 1 - use_sub);
 }
 
+#if P256M_FIELD_MUL_OPT
+/*
+ * Montgomery modular multiplication (optimised)
+ *
+ * Same contract as m256_mul_ref(). In each round, a + x[i] * y + u * m is
+ * computed in a single pass over the limbs (two multiply-accumulate chains,
+ * one UMAAL each per limb on Cortex-M33), and the result is written one limb
+ * down, which also does the division by 2^32: no u288_rshift32() pass and
+ * half the loads and stores of a[].
+ */
+static void m256_mul_opt(uint32_t z[8],
+                         const uint32_t x[8], const uint32_t y[8],
+                         const m256_mod *mod)
+{
+    uint32_t m_prime = mod->ni;
+    uint32_t a[9];
+
+    for (unsigned i = 0; i < 9; i++) {
+        a[i] = 0;
+    }
+
+    for (unsigned i = 0; i < 8; i++) {
+        uint32_t xi = x[i];
+        /* the "mod 2^32" is implicit from the type */
+        uint32_t u = (a[0] + xi * y[0]) * m_prime;
+        uint32_t c1, c2;
+        uint64_t prod;
+
+        /* limb 0: zero by the choice of u, only the carries are kept */
+        prod = u32_muladd64(xi, y[0], a[0], 0);
+        c1 = (uint32_t) (prod >> 32);
+        prod = u32_muladd64(u, mod->m[0], (uint32_t) prod, 0);
+        c2 = (uint32_t) (prod >> 32);
+
+#define M256_MUL_OPT_STEP(j) \
+    do { \
+        prod = u32_muladd64(xi, y[j], a[j], c1); \
+        c1 = (uint32_t) (prod >> 32); \
+        prod = u32_muladd64(u, mod->m[j], (uint32_t) prod, c2); \
+        c2 = (uint32_t) (prod >> 32); \
+        a[j - 1] = (uint32_t) prod; \
+    } while( 0 )
+
+        M256_MUL_OPT_STEP(1);
+        M256_MUL_OPT_STEP(2);
+        M256_MUL_OPT_STEP(3);
+        M256_MUL_OPT_STEP(4);
+        M256_MUL_OPT_STEP(5);
+        M256_MUL_OPT_STEP(6);
+        M256_MUL_OPT_STEP(7);
+
+#undef M256_MUL_OPT_STEP
+
+        /* limb 8 and the carry out of the 288-bit sum */
+        uint64_t sum = (uint64_t) a[8] + c1 + c2;
+        a[7] = (uint32_t) sum;
+        a[8] = (uint32_t) (sum >> 32);
+    }
+
+    /* a = a > m ? a - m : a */
+    uint32_t carry_add = a[8];  // 0 or 1 since a < 2m, see HAC Note 14.37
+    uint32_t carry_sub = u256_sub(z, a, mod->m);
+    uint32_t use_sub = carry_add | (1 - carry_sub);     // see m256_add()
+    u256_cmov(z, a, 1 - use_sub);
+}
+#endif /* P256M_FIELD_MUL_OPT */
+
+/*
+ * Montgomery modular multiplication
+ *
+ * in: x, y in [0, m)
+ *     mod must point to a valid m256_mod structure
+ * out: z = (x * y) / 2^256 mod m, in [0, m)
+ *
+ * Note: as a memory area, z may overlap with x or y.
+ */
+static void m256_mul(uint32_t z[8],
+                     const uint32_t x[8], const uint32_t y[8],
+                     const m256_mod *mod)
+{
+#if P256M_FIELD_MUL_OPT
+    m256_mul_opt(z, x, y, mod);
+#else
+    m256_mul_ref(z, x, y, mod);
+#endif
+}
+
 /*
  * Montgomery modular multiplication modulo p.
  *
@@ -1511,4 +1614,54 @@ int p256_public_from_private(uint8_t pub[64], const uint8_t priv[32])
     return P256_SUCCESS;
 }
 
+/*
+ * Field multiplication self-test
+ *
+ * The field multiplication used (m256_mul) is compared with the portable
+ * reference (m256_mul_ref) modulo p and n, on pseudo-random operands below
+ * 2^255 (so below p and n) and on the largest operands m - 1.
+ */
+int p256_field_selftest(unsigned rounds)
+{
+    const m256_mod *mods[2] = { &p256_p, &p256_n };
+    uint32_t seed = 0x2545F491;
+    uint32_t x[8], y[8], z[8], z_ref[8];
+    uint32_t diff = 0;
+
+    for (unsigned k = 0; k < 2; k++) {
+        const m256_mod *mod = mods[k];
+
+        /* largest operands: (m - 1)^2 */
+        for (unsigned i = 0; i < 8; i++) {
+            x[i] = mod->m[i];
+        }
+        x[0] -= 1;
+        m256_mul(z, x, x, mod);
+        m256_mul_ref(z_ref, x, x, mod);
+        diff |= u256_diff(z, z_ref);
+
+        for (unsigned r = 0; r < rounds; r++) {
+            for (unsigned i = 0; i < 8; i++) {
+                /* xorshift32 */
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                x[i] = seed;
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                y[i] = seed;
+            }
+            x[7] &= 0x7FFFFFFF;
+            y[7] &= 0x7FFFFFFF;
+
+            m256_mul(z, x, y, mod);
+            m256_mul_ref(z_ref, x, y, mod);
+            diff |= u256_diff(z, z_ref);
+        }
+    }
+
+    return diff == 0 ? P256_SUCCESS : P256_FIELD_SELFTEST_FAILED;
+}
+
 #endif
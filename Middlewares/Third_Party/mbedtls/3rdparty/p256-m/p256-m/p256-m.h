@@ -17,6 +17,7 @@
 #define P256_INVALID_PUBKEY     -2
 #define P256_INVALID_PRIVKEY    -3
 #define P256_INVALID_SIGNATURE  -4
+#define P256_FIELD_SELFTEST_FAILED -5
 
 #ifdef __cplusplus
 extern "C" {
@@ -128,6 +129,18 @@ int p256_validate_privkey(const uint8_t priv[32]);
  */
 int p256_public_from_private(uint8_t pub[64], const uint8_t priv[32]);
 
+/*
+ * Field multiplication self-test
+ *
+ * Compare the Montgomery multiplication used (optimised when
+ * P256M_FIELD_MUL_OPT is 1) with the portable reference, modulo the curve's
+ * p and n, on the largest operands and on 'rounds' pseudo-random operands.
+ *
+ * return:  P256_SUCCESS if they agree
+ *          P256_FIELD_SELFTEST_FAILED otherwise
+ */
+int p256_field_selftest(unsigned rounds);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file    adv_trace_itm_if.c
+  * @author  MCD Application Team
+  * @brief : Source file for interfacing the stm32_adv_trace to the ITM (SWO output)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "stm32_adv_trace.h"
+#include "adv_trace_itm_if.h"
+#include "adv_trace_usart_if.h"
+
+#if (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_ITM)
+
+/* Private define ------------------------------------------------------------*/
+/* Stimulus port used by the traces */
+#define ITM_TRACE_PORT          (0u)
+
+/* Exported constants --------------------------------------------------------*/
+
+/* list all the driver interface used by the trace application. */
+/* The reception (commands) remains on the USART. */
+const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
+{
+  SWO_Init,
+  SWO_DeInit,
+  UART_StartRx,
+  SWO_Transmit
+};
+
+/* Private variables ---------------------------------------------------------*/
+static void (*TxCpltCallback)       ( void * );
+
+/* Private user code ---------------------------------------------------------*/
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t SWO_Init( void (*pCallbackFunction)(void *) )
+{
+  TxCpltCallback = pCallbackFunction;
+
+  /* Trace enable, the remaining of the configuration is done by the debugger */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t SWO_DeInit( void )
+{
+  TxCpltCallback = NULL;
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t SWO_Transmit( uint8_t * pData, uint16_t iSize )
+{
+  uint32_t  lWord;
+  uint16_t  iIndex = 0;
+
+  /* Nothing is written when no debugger has enabled the ITM and the port */
+  if ( ( ( ITM->TCR & ITM_TCR_ITMENA_Msk ) != 0u ) && ( ( ITM->TER & ( 1UL << ITM_TRACE_PORT ) ) != 0u ) )
+  {
+    /* Words first (one SWO packet for 4 bytes), then the remaining bytes */
+    while ( ( iSize - iIndex ) >= 4u )
+    {
+      lWord = (uint32_t)pData[iIndex] | ( (uint32_t)pData[iIndex + 1u] << 8 ) |
+              ( (uint32_t)pData[iIndex + 2u] << 16 ) | ( (uint32_t)pData[iIndex + 3u] << 24 );
+      while ( ITM->PORT[ITM_TRACE_PORT].u32 == 0u )
+      {
+        __NOP();
+      }
+      ITM->PORT[ITM_TRACE_PORT].u32 = lWord;
+      iIndex += 4u;
+    }
+
+    while ( iIndex < iSize )
+    {
+      while ( ITM->PORT[ITM_TRACE_PORT].u32 == 0u )
+      {
+        __NOP();
+      }
+      ITM->PORT[ITM_TRACE_PORT].u8 = pData[iIndex];
+      iIndex++;
+    }
+  }
+
+  /* The data is in the ITM FIFO : the transfer is complete */
+  if ( TxCpltCallback != NULL )
+  {
+    TxCpltCallback( NULL );
+  }
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+#endif /* (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_ITM) */
@@ -0,0 +1,63 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    adv_trace_itm_if.h
+  * @author  MCD Application Team
+  * @brief   Header for adv_trace_itm_if.c module (ITM/SWO interface)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ITM_IF_H
+#define ITM_IF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_adv_trace.h"
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+* @brief  Init the ITM stimulus port used by the traces.
+* @note   The SWO output (TPIU prescaler and protocol) is configured by the debugger (SWV).
+* @param  cb tx function callback.
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t SWO_Init(void (*cb)(void *));
+
+/**
+* @brief  DeInit the ITM interface.
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t SWO_DeInit(void);
+
+/**
+* @brief  Write a buffer on the ITM stimulus port. The data is dropped when no debugger has enabled the port.
+* @param  pdata data to be sent
+* @param  size of buffer p_data to be sent
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t SWO_Transmit(uint8_t *pdata, uint16_t size);
+
+/* USER CODE BEGIN EFP */
+
+/* USER CODE END EFP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ITM_IF_H */
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    adv_trace_rtt_if.c
+  * @author  MCD Application Team
+  * @brief : Source file for interfacing the stm32_adv_trace to a RAM ring buffer
+  *          read by the debugger, with the SEGGER RTT control block layout.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "app_conf.h"
+#include "stm32_adv_trace.h"
+#include "adv_trace_rtt_if.h"
+#include "adv_trace_usart_if.h"
+
+#if (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_RTT)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Ring buffer descriptor, as expected by the RTT viewers */
+typedef struct
+{
+  const char *          sName;
+  uint8_t *             pBuffer;
+  uint32_t              lSizeOfBuffer;
+  volatile uint32_t     lWrOff;
+  volatile uint32_t     lRdOff;
+  uint32_t              lFlags;
+} RttBuffer_t;
+
+/* Control block, found by the RTT viewers with its identifier or with the _SEGGER_RTT symbol */
+typedef struct
+{
+  char                  acID[16];
+  int32_t               lMaxNumUpBuffers;
+  int32_t               lMaxNumDownBuffers;
+  RttBuffer_t           stUp;
+  RttBuffer_t           stDown;
+} RttControlBlock_t;
+
+/* Private define ------------------------------------------------------------*/
+#define RTT_DOWN_BUFFER_SIZE    (16u)
+
+/* Data that do not fit in the up buffer is trimmed */
+#define RTT_MODE_NO_BLOCK_TRIM  (1u)
+
+/* Exported constants --------------------------------------------------------*/
+
+/* list all the driver interface used by the trace application. */
+/* The reception (commands) remains on the USART. */
+const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
+{
+  RTT_Init,
+  RTT_DeInit,
+  UART_StartRx,
+  RTT_Transmit
+};
+
+/* Private variables ---------------------------------------------------------*/
+RttControlBlock_t               _SEGGER_RTT;
+
+static uint8_t                  aRttUpBuffer[CFG_LOG_RTT_BUFFER_SIZE];
+static uint8_t                  aRttDownBuffer[RTT_DOWN_BUFFER_SIZE];
+static uint32_t                 lRttDroppedBytes;
+
+static void (*TxCpltCallback)   ( void * );
+
+/* Private user code ---------------------------------------------------------*/
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t RTT_Init( void (*pCallbackFunction)(void *) )
+{
+  static const char szRttId[] = "SEGGER RTT";
+
+  TxCpltCallback = pCallbackFunction;
+  lRttDroppedBytes = 0;
+
+  memset( &_SEGGER_RTT, 0, sizeof( _SEGGER_RTT ) );
+  _SEGGER_RTT.lMaxNumUpBuffers = 1;
+  _SEGGER_RTT.lMaxNumDownBuffers = 1;
+
+  _SEGGER_RTT.stUp.sName = "Terminal";
+  _SEGGER_RTT.stUp.pBuffer = aRttUpBuffer;
+  _SEGGER_RTT.stUp.lSizeOfBuffer = sizeof( aRttUpBuffer );
+  _SEGGER_RTT.stUp.lFlags = RTT_MODE_NO_BLOCK_TRIM;
+
+  _SEGGER_RTT.stDown.sName = "Terminal";
+  _SEGGER_RTT.stDown.pBuffer = aRttDownBuffer;
+  _SEGGER_RTT.stDown.lSizeOfBuffer = sizeof( aRttDownBuffer );
+
+  /* Identifier written last, so that the viewer never finds a partially initialized control block */
+  __DMB();
+  memcpy( _SEGGER_RTT.acID, szRttId, sizeof( szRttId ) );
+  __DMB();
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t RTT_DeInit( void )
+{
+  TxCpltCallback = NULL;
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+/**
+ *
+ */
+UTIL_ADV_TRACE_Status_t RTT_Transmit( uint8_t * pData, uint16_t iSize )
+{
+  RttBuffer_t * pUp = &_SEGGER_RTT.stUp;
+  uint32_t      lWrOff = pUp->lWrOff;
+  uint32_t      lRdOff = pUp->lRdOff;
+  uint32_t      lFree;
+  uint32_t      lChunk;
+  uint32_t      lCopied = 0;
+
+  /* One byte is kept free to distinguish a full buffer from an empty one */
+  if ( lRdOff > lWrOff )
+  {
+    lFree = lRdOff - lWrOff - 1u;
+  }
+  else
+  {
+    lFree = pUp->lSizeOfBuffer - lWrOff + lRdOff - 1u;
+  }
+
+  if ( iSize > lFree )
+  {
+    lRttDroppedBytes += ( iSize - lFree );
+    iSize = (uint16_t)lFree;
+  }
+
+  /* Up to the end of the buffer, then from its start */
+  while ( lCopied < iSize )
+  {
+    lChunk = pUp->lSizeOfBuffer - lWrOff;
+    if ( lChunk > ( iSize - lCopied ) )
+    {
+      lChunk = iSize - lCopied;
+    }
+
+    memcpy( &pUp->pBuffer[lWrOff], &pData[lCopied], lChunk );
+    lCopied += lChunk;
+    lWrOff += lChunk;
+    if ( lWrOff == pUp->lSizeOfBuffer )
+    {
+      lWrOff = 0;
+    }
+  }
+
+  /* Data visible before the write offset */
+  __DMB();
+  pUp->lWrOff = lWrOff;
+
+  /* The data is in the ring buffer : the transfer is complete */
+  if ( TxCpltCallback != NULL )
+  {
+    TxCpltCallback( NULL );
+  }
+
+  return UTIL_ADV_TRACE_OK;
+}
+
+/**
+ *
+ */
+uint32_t RTT_GetDroppedBytes( void )
+{
+  return lRttDroppedBytes;
+}
+
+#endif /* (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_RTT) */
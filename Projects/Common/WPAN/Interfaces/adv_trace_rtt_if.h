@@ -0,0 +1,68 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    adv_trace_rtt_if.h
+  * @author  MCD Application Team
+  * @brief   Header for adv_trace_rtt_if.c module (RAM ring read by the debugger)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef RTT_IF_H
+#define RTT_IF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_adv_trace.h"
+
+/* Exported functions prototypes ---------------------------------------------*/
+/**
+* @brief  Init the RTT control block (SEGGER RTT layout, one up buffer for the traces).
+* @param  cb tx function callback.
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t RTT_Init(void (*cb)(void *));
+
+/**
+* @brief  DeInit the RTT interface.
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t RTT_DeInit(void);
+
+/**
+* @brief  Copy a buffer in the RTT up buffer. The bytes that do not fit (host too slow or absent) are dropped.
+* @param  pdata data to be sent
+* @param  size of buffer p_data to be sent
+* @return @ref UTIL_ADV_TRACE_Status_t
+*/
+UTIL_ADV_TRACE_Status_t RTT_Transmit(uint8_t *pdata, uint16_t size);
+
+/**
+* @brief  Provide the number of bytes dropped because the RTT up buffer was full.
+* @return Number of bytes dropped since the initialization.
+*/
+uint32_t RTT_GetDroppedBytes(void);
+
+/* USER CODE BEGIN EFP */
+
+/* USER CODE END EFP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTT_IF_H */
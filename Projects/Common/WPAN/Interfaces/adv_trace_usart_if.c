@@ -20,6 +20,7 @@
 #include "app_conf.h"
 #include "stm32_adv_trace.h"
 #include "adv_trace_usart_if.h"
+#include "stm32_lpm.h"
 
 /* Private includes ----------------------------------------------------------*/
 
@@ -33,6 +34,7 @@
 
 /* Exported constants --------------------------------------------------------*/
 
+#if (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_USART)
 /* list all the driver interface used by the trace application. */
 const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
 {
@@ -41,6 +43,7 @@ const UTIL_ADV_TRACE_Driver_s UTIL_TraceDriver =
   UART_StartRx,
   UART_TransmitDMA
 };
+#endif /* (CFG_LOG_TRANSPORT == CFG_LOG_TRANSPORT_USART) */
 
 /* Private variables ---------------------------------------------------------*/
 
@@ -50,6 +53,22 @@ uint8_t receive_after_transmit = 0;
 /* Buffer to receive 1 character */
 static uint8_t cCharRx;
 
+/* Whether the traces are sent by the GPDMA (resolved once at the init, not on each chunk) */
+static uint8_t cUseDmaTx;
+
+#if (CFG_LOG_RX_DMA_SUPPORTED != 0)
+/* Whether the commands are received by the circular GPDMA */
+static uint8_t cUseDmaRx;
+
+/* Ring written by the circular DMA, and position of the next byte to give to the consumer */
+static uint8_t aRxRing[CFG_LOG_RX_RING_SIZE];
+static uint16_t iRxRead;
+
+/* Linked-list with one node looping on the ring */
+static DMA_NodeTypeDef stRxNode;
+static DMA_QListTypeDef stRxList;
+#endif /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
+
 /* Exported macro ------------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
@@ -59,6 +78,11 @@ static void (*RxCpltCallback)       ( uint8_t * pData, uint16_t iSize, uint8_t c
 
 static void UsartIf_TxCpltCallback  ( UART_HandleTypeDef *huart );
 static void UsartIf_RxCpltCallback  ( UART_HandleTypeDef *huart );
+#if (CFG_LOG_RX_DMA_SUPPORTED != 0)
+static uint8_t UsartIf_RxDmaStart   ( void );
+static void UsartIf_RxEventCallback ( UART_HandleTypeDef *huart, uint16_t iPosition );
+static void UsartIf_RxErrorCallback ( UART_HandleTypeDef *huart );
+#endif /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
 static IRQn_Type get_IRQn_Type_from_DMA_HandleTypeDef (DMA_HandleTypeDef * hDmaHandler );
 
 /* Private user code ---------------------------------------------------------*/
@@ -68,10 +92,23 @@ static IRQn_Type get_IRQn_Type_from_DMA_HandleTypeDef (DMA_HandleTypeDef * hDmaH
  */
 UTIL_ADV_TRACE_Status_t UART_Init(  void (*pCallbackFunction)(void *))
 {
+  IRQn_Type eDmaTxIrq;
+
   TxCpltCallback = pCallbackFunction;
 
   LOG_UART_HANDLER.TxCpltCallback = UsartIf_TxCpltCallback;
 
+  /* The UART is initialized before the traces : its TX DMA channel (if any) is already linked */
+  cUseDmaTx = 0;
+  if ( LOG_UART_HANDLER.hdmatx != NULL )
+  {
+    eDmaTxIrq = get_IRQn_Type_from_DMA_HandleTypeDef( LOG_UART_HANDLER.hdmatx );
+    if ( ( eDmaTxIrq >= GPDMA1_Channel0_IRQn ) && ( eDmaTxIrq <= GPDMA1_Channel7_IRQn ) )
+    {
+      cUseDmaTx = 1;
+    }
+  }
+
   return UTIL_ADV_TRACE_OK;
 }
 
@@ -97,15 +134,32 @@ UTIL_ADV_TRACE_Status_t UART_DeInit( void )
  */
 UTIL_ADV_TRACE_Status_t UART_StartRx( void (*pCallbackFunction)(uint8_t * pData, uint16_t iSize, uint8_t cError ) )
 {
-  /* Configure UART in Receive mode */
-  HAL_UART_Receive_IT( &LOG_UART_HANDLER, &cCharRx, 1 );
-  LOG_UART_HANDLER.RxCpltCallback = &UsartIf_RxCpltCallback;
-
   if ( pCallbackFunction != NULL )
   {
     RxCpltCallback = pCallbackFunction;
   }
 
+#if (CFG_LOG_RX_DMA_SUPPORTED != 0)
+  /* A new consumer takes over the running reception */
+  if ( cUseDmaRx != 0 )
+  {
+    return UTIL_ADV_TRACE_OK;
+  }
+
+  if ( UsartIf_RxDmaStart() != 0 )
+  {
+    cUseDmaRx = 1;
+
+    /* The USART does not receive in Stop mode */
+    UTIL_LPM_SetStopMode( 1U << CFG_LPM_LOG_RX, UTIL_LPM_DISABLE );
+    return UTIL_ADV_TRACE_OK;
+  }
+#endif /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
+
+  /* Configure UART in Receive mode, one character at a time */
+  LOG_UART_HANDLER.RxCpltCallback = &UsartIf_RxCpltCallback;
+  HAL_UART_Receive_IT( &LOG_UART_HANDLER, &cCharRx, 1 );
+
   return UTIL_ADV_TRACE_OK;
 }
 
@@ -116,25 +170,19 @@ UTIL_ADV_TRACE_Status_t UART_TransmitDMA ( uint8_t * pData, uint16_t iSize )
 {
   UTIL_ADV_TRACE_Status_t eStatus = UTIL_ADV_TRACE_OK;
   HAL_StatusTypeDef eResult;
-  IRQn_Type         eUseDmaTx;
-  IRQn_Type         eUseDmaRx;
-
-  eUseDmaTx = get_IRQn_Type_from_DMA_HandleTypeDef( LOG_UART_HANDLER.hdmatx );
-  eUseDmaRx = get_IRQn_Type_from_DMA_HandleTypeDef( LOG_UART_HANDLER.hdmarx );
-
-  if ( ( eUseDmaTx == GPDMA1_Channel0_IRQn ) || ( eUseDmaTx == GPDMA1_Channel1_IRQn ) ||
-       ( eUseDmaTx == GPDMA1_Channel2_IRQn ) || ( eUseDmaTx == GPDMA1_Channel3_IRQn ) ||
-       ( eUseDmaTx == GPDMA1_Channel4_IRQn ) || ( eUseDmaTx == GPDMA1_Channel5_IRQn ) ||
-       ( eUseDmaTx == GPDMA1_Channel6_IRQn ) || ( eUseDmaTx == GPDMA1_Channel7_IRQn ) ||
-       ( eUseDmaRx == GPDMA1_Channel0_IRQn ) || ( eUseDmaRx == GPDMA1_Channel1_IRQn ) ||
-       ( eUseDmaRx == GPDMA1_Channel2_IRQn ) || ( eUseDmaRx == GPDMA1_Channel3_IRQn ) ||
-       ( eUseDmaRx == GPDMA1_Channel4_IRQn ) || ( eUseDmaRx == GPDMA1_Channel5_IRQn ) ||
-       ( eUseDmaRx == GPDMA1_Channel6_IRQn ) || ( eUseDmaRx == GPDMA1_Channel7_IRQn ) )
+
+  if ( cUseDmaTx != 0 )
   {
     eResult = HAL_UART_Transmit_DMA( &LOG_UART_HANDLER, pData, iSize );
+    if ( ( eResult == HAL_OK ) && ( iSize > 1U ) )
+    {
+      /* Only the end of the chunk is used (UART TC interrupt) : no half transfer interrupt */
+      __HAL_DMA_DISABLE_IT( LOG_UART_HANDLER.hdmatx, DMA_IT_HT );
+    }
   }
   else
   {
+    /* No TX DMA channel : one interrupt per byte */
     eResult = HAL_UART_Transmit_IT( &LOG_UART_HANDLER, pData, iSize );
   }
 
@@ -143,8 +191,12 @@ UTIL_ADV_TRACE_Status_t UART_TransmitDMA ( uint8_t * pData, uint16_t iSize )
     eStatus = UTIL_ADV_TRACE_HW_ERROR;
   }
 
-  /* Check whether the UART should return in Receiver mode */
+  /* Check whether the UART should return in Receiver mode (always the case with the DMA reception) */
+#if (CFG_LOG_RX_DMA_SUPPORTED != 0)
+  if ( ( receive_after_transmit ) && ( cUseDmaRx == 0 ) )
+#else /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
   if ( receive_after_transmit )
+#endif /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
   {
     HAL_UART_Receive_IT( &LOG_UART_HANDLER, &cCharRx, 1 );
   }
@@ -170,6 +222,102 @@ static void UsartIf_RxCpltCallback(UART_HandleTypeDef *huart)
   HAL_UART_Receive_IT( &LOG_UART_HANDLER, &cCharRx, 1 );
 }
 
+#if (CFG_LOG_RX_DMA_SUPPORTED != 0)
+/**
+ * Set the DMA channel of the UART reception in circular mode (linked-list with one node) on the ring, the reception
+ * being signaled at half ring, end of ring and idle line. Returns 0 when the UART has no RX DMA channel.
+ */
+static uint8_t UsartIf_RxDmaStart( void )
+{
+  DMA_HandleTypeDef     * pstDma = LOG_UART_HANDLER.hdmarx;
+  DMA_NodeConfTypeDef   stNodeConfig;
+
+  if ( pstDma == NULL )
+  {
+    return 0;
+  }
+
+  /* The node keeps the request and the widths of the channel configured by the MSP */
+  memset( &stNodeConfig, 0, sizeof( stNodeConfig ) );
+  stNodeConfig.NodeType = DMA_GPDMA_LINEAR_NODE;
+  stNodeConfig.Init = pstDma->Init;
+  stNodeConfig.Init.Mode = DMA_NORMAL;
+  stNodeConfig.DataHandlingConfig.DataExchange = DMA_EXCHANGE_NONE;
+  stNodeConfig.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+  stNodeConfig.TriggerConfig.TriggerPolarity = DMA_TRIG_POLARITY_MASKED;
+  stNodeConfig.SrcAddress = (uint32_t)&LOG_UART_HANDLER.Instance->RDR;
+  stNodeConfig.DstAddress = (uint32_t)aRxRing;
+  stNodeConfig.DataSize = CFG_LOG_RX_RING_SIZE;
+
+  (void)HAL_UART_AbortReceive( &LOG_UART_HANDLER );
+  (void)HAL_DMA_DeInit( pstDma );
+
+  memset( &stRxList, 0, sizeof( stRxList ) );
+  if ( ( HAL_DMAEx_List_BuildNode( &stNodeConfig, &stRxNode ) != HAL_OK ) ||
+       ( HAL_DMAEx_List_InsertNode_Tail( &stRxList, &stRxNode ) != HAL_OK ) ||
+       ( HAL_DMAEx_List_SetCircularMode( &stRxList ) != HAL_OK ) )
+  {
+    return 0;
+  }
+
+  pstDma->InitLinkedList.Priority = DMA_LOW_PRIORITY_HIGH_WEIGHT;
+  pstDma->InitLinkedList.LinkStepMode = DMA_LSM_FULL_EXECUTION;
+  pstDma->InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT0;
+  pstDma->InitLinkedList.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  pstDma->InitLinkedList.LinkedListMode = DMA_LINKEDLIST_CIRCULAR;
+  if ( ( HAL_DMAEx_List_Init( pstDma ) != HAL_OK ) || ( HAL_DMAEx_List_LinkQ( pstDma, &stRxList ) != HAL_OK ) ||
+       ( HAL_DMA_ConfigChannelAttributes( pstDma, DMA_CHANNEL_NPRIV ) != HAL_OK ) )
+  {
+    return 0;
+  }
+  __HAL_LINKDMA( &LOG_UART_HANDLER, hdmarx, *pstDma );
+
+  (void)HAL_UART_RegisterRxEventCallback( &LOG_UART_HANDLER, UsartIf_RxEventCallback );
+  (void)HAL_UART_RegisterCallback( &LOG_UART_HANDLER, HAL_UART_ERROR_CB_ID, UsartIf_RxErrorCallback );
+
+  iRxRead = 0;
+  return ( ( HAL_UARTEx_ReceiveToIdle_DMA( &LOG_UART_HANDLER, aRxRing, CFG_LOG_RX_RING_SIZE ) == HAL_OK ) ? 1 : 0 );
+}
+
+/**
+ * Reception event (half ring, end of ring or idle line) : the bytes written by the DMA since the previous event are
+ * given to the consumer, in one or two contiguous parts of the ring.
+ */
+static void UsartIf_RxEventCallback( UART_HandleTypeDef *huart, uint16_t iPosition )
+{
+  UNUSED( huart );
+
+  /* The position is the ring size at its end */
+  iPosition = (uint16_t)( iPosition % CFG_LOG_RX_RING_SIZE );
+  if ( iPosition < iRxRead )
+  {
+    RxCpltCallback( &aRxRing[iRxRead], (uint16_t)( CFG_LOG_RX_RING_SIZE - iRxRead ), 0 );
+    iRxRead = 0;
+  }
+  if ( iPosition != iRxRead )
+  {
+    RxCpltCallback( &aRxRing[iRxRead], (uint16_t)( iPosition - iRxRead ), 0 );
+    iRxRead = iPosition;
+  }
+}
+
+/**
+ * Reception error (overrun, noise, framing) : the HAL stopped the DMA, the consumer is told then the reception
+ * restarts at the ring start.
+ */
+static void UsartIf_RxErrorCallback( UART_HandleTypeDef *huart )
+{
+  if ( huart->RxState != HAL_UART_STATE_READY )
+  {
+    return;
+  }
+
+  RxCpltCallback( aRxRing, 0, 1 );
+  iRxRead = 0;
+  (void)HAL_UARTEx_ReceiveToIdle_DMA( huart, aRxRing, CFG_LOG_RX_RING_SIZE );
+}
+#endif /* (CFG_LOG_RX_DMA_SUPPORTED != 0) */
+
 /**
   * The purpose of this function is to match a DMA_HandleTypeDef as key with the corresponding IRQn_Type as value.
   *
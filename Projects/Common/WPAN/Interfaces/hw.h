@@ -100,6 +100,8 @@ extern int HW_AES_Enable( void );
  * The "mode" parameter must be set to HW_AES_ENC for encryption and to
  * HW_AES_DEC for decryption. It can be or-ed with HW_AES_REV for a reveresd
  * oreder of key bytes, and with HW_AES_SWAP to use data byte swapping mode.
+ * The key registers are not rewritten when the same key is already loaded in
+ * the same mode.
  */
 extern void HW_AES_SetKey( uint32_t mode,
                            const uint8_t* key );
@@ -123,6 +125,39 @@ extern void HW_AES_Crypt( const uint32_t* input,
  */
 extern void HW_AES_Crypt8( const uint8_t* input, uint8_t* output );
 
+/*
+ * HW_AES_CryptBlocks
+ *
+ * Encrypts/decrypts "nb_blocks" consecutive 16-byte blocks of "input" into
+ * "output", the next block being written as soon as the previous result is
+ * read (same data format as HW_AES_Crypt).
+ */
+extern void HW_AES_CryptBlocks( const uint32_t* input,
+                                uint32_t* output,
+                                uint32_t nb_blocks );
+
+/*
+ * HW_AES_CryptBlocksDma
+ *
+ * Starts the encryption/decryption of "nb_blocks" consecutive 16-byte blocks
+ * (up to 4095) by DMA, with the key set by HW_AES_SetKey() (HW_AES_SWAP for
+ * byte arrays). The function returns 0 if a transfer is already in progress
+ * or if the DMA is not supported. At the end of the transfer, "callback" is
+ * called from the DMA interrupt with 1 on success, 0 on a transfer error.
+ * The AES stays enabled and the system must not enter Stop mode until then.
+ */
+extern int HW_AES_CryptBlocksDma( const uint32_t* input,
+                                  uint32_t* output,
+                                  uint32_t nb_blocks,
+                                  void (*callback)( int success ) );
+
+/*
+ * HW_AES_DmaIrqHandler
+ *
+ * To be called from the interrupt handler of the DMA output channel.
+ */
+extern void HW_AES_DmaIrqHandler( void );
+
 /*
  * HW_AES_Disable
  *
@@ -142,6 +177,35 @@ extern void HW_AES_InitCcm( uint8_t decrypt,
                             const uint32_t* b0,
                             const uint32_t* b1 );
 
+/*
+ * HW_AES_StartCcm
+ *
+ * Starts a CCM processing with the init phase only: the header is then
+ * written with HW_AES_CcmHeader (block by block, none when there is no
+ * additional data) and the payload phase started with
+ * HW_AES_StartCcmPayload.
+ *
+ */
+extern void HW_AES_StartCcm( uint8_t decrypt,
+                             const uint8_t* key,
+                             const uint32_t* b0 );
+
+/*
+ * HW_AES_CcmHeader
+ *
+ * Writes one 4-word block of the formatted CCM header (B1, B2...)
+ *
+ */
+extern void HW_AES_CcmHeader( const uint32_t* block );
+
+/*
+ * HW_AES_StartCcmPayload
+ *
+ * Ends the CCM header and starts the payload phase
+ *
+ */
+extern void HW_AES_StartCcmPayload( uint8_t decrypt );
+
 /*
  * HW_AES_EndCcm
  *
@@ -250,6 +314,47 @@ extern void HW_PKA_ReadResult( uint32_t index,
  */
 extern void HW_PKA_Disable( void );
 
+/*
+ * HW_PKA_JOB_T
+ *
+ * Job of the asynchronous PKA service (CFG_HW_PKA_ASYNC_SUPPORTED): "start"
+ * writes the operands and starts the PKA, "end" reads the result when the
+ * processing is complete, then "callback" is called by HW_PKA_Process().
+ * The job must not be modified until its callback is called.
+ */
+typedef struct HW_PKA_JOB_T
+{
+  struct HW_PKA_JOB_T* next;
+  void (*start)( struct HW_PKA_JOB_T* job );
+  void (*end)( struct HW_PKA_JOB_T* job );
+  void (*callback)( struct HW_PKA_JOB_T* job );
+} HW_PKA_JOB_T;
+
+/*
+ * HW_PKA_Submit
+ *
+ * Queues a job: the jobs are processed one at a time, in their order, when
+ * the PKA is not used by a synchronous user (HW_PKA_Enable).
+ */
+extern void HW_PKA_Submit( HW_PKA_JOB_T* job );
+
+/*
+ * HW_PKA_Process
+ *
+ * Ends the job completed by the PKA and starts the next one.
+ * Must be called in background by the task set in HWCB_PKA_Process().
+ */
+extern void HW_PKA_Process( void );
+
+/*
+ * HW_PKA_IrqHandler
+ *
+ * To be called from the PKA interrupt handler.
+ */
+extern void HW_PKA_IrqHandler( void );
+
+extern void HWCB_PKA_Process( void );
+
 /*
  * Notes:
  *
@@ -349,6 +454,93 @@ extern void HW_PKA_P256_StartEccScalarMul( const uint32_t* k,
 extern void HW_PKA_P256_ReadEccScalarMul( uint32_t* p_x,
                                           uint32_t* p_y );
 
+/*
+ * HW_PKA_P256_StartEcdsaVerif
+ *
+ * Starts the PKA ECDSA signature verification using the P-256 elliptic curve.
+ *
+ * This function sets the parameters in PKA memory and then starts the
+ * processing. The PKA has to be enabled before with HW_PKA_Enable( ).
+ * The user must poll on the result availability by calling the
+ * HW_PKA_EndOfOperation() function.
+ *
+ * The input parameters are the hash e (truncated to 256 bits), the signature
+ * (r, s) and the public key Q defined by its 2 coordinates q_x and q_y. Each
+ * parameter must be a vector of 8 x 32-bit words (32 bytes).
+ *
+ * The verification result is retrieved by calling
+ * HW_PKA_P256_IsEcdsaVerifOk().
+ */
+extern void HW_PKA_P256_StartEcdsaVerif( const uint32_t* e,
+                                         const uint32_t* r,
+                                         const uint32_t* s,
+                                         const uint32_t* q_x,
+                                         const uint32_t* q_y );
+
+/*
+ * HW_PKA_P256_IsEcdsaVerifOk
+ *
+ * Reads the result of P-256 ECDSA verification. This function must only be
+ * called when HW_PKA_EndOfOperation() returns a non-zero value.
+ *
+ * Returns 0 if the signature is not valid ; 1 otherwise.
+ */
+extern uint32_t HW_PKA_P256_IsEcdsaVerifOk( void );
+
+/*
+ * HW_PKA_P256_ECC_MUL_JOB_T
+ *
+ * Asynchronous scalar multiplication: k, p_x and p_y as for
+ * HW_PKA_P256_StartEccScalarMul() (p_x and p_y can be NULL for the base
+ * point), result in r_x and r_y, and success set when the result is valid.
+ */
+typedef struct
+{
+  HW_PKA_JOB_T job;
+  const uint32_t* k;
+  const uint32_t* p_x;
+  const uint32_t* p_y;
+  uint32_t r_x[8];
+  uint32_t r_y[8];
+  uint8_t success;
+} HW_PKA_P256_ECC_MUL_JOB_T;
+
+/*
+ * HW_PKA_P256_EccScalarMulAsync
+ *
+ * Queues a scalar multiplication using the P-256 elliptic curve, without
+ * waiting for the PKA: the callback is called with &job->job at its end.
+ */
+extern void HW_PKA_P256_EccScalarMulAsync( HW_PKA_P256_ECC_MUL_JOB_T* job,
+                                           void (*callback)( HW_PKA_JOB_T* job ) );
+
+/*
+ * HW_PKA_P256_ECDSA_VERIF_JOB_T
+ *
+ * Asynchronous ECDSA verification: e, r, s, q_x and q_y as for
+ * HW_PKA_P256_StartEcdsaVerif() (they must stay valid until the callback),
+ * and success set when the signature is valid.
+ */
+typedef struct
+{
+  HW_PKA_JOB_T job;
+  const uint32_t* e;
+  const uint32_t* r;
+  const uint32_t* s;
+  const uint32_t* q_x;
+  const uint32_t* q_y;
+  uint8_t success;
+} HW_PKA_P256_ECDSA_VERIF_JOB_T;
+
+/*
+ * HW_PKA_P256_EcdsaVerifAsync
+ *
+ * Queues an ECDSA verification using the P-256 elliptic curve, without
+ * waiting for the PKA: the callback is called with &job->job at its end.
+ */
+extern void HW_PKA_P256_EcdsaVerifAsync( HW_PKA_P256_ECDSA_VERIF_JOB_T* job,
+                                         void (*callback)( HW_PKA_JOB_T* job ) );
+
 /* ---------------------------------------------------------------------------
  *                                 RNG
  * ---------------------------------------------------------------------------
@@ -398,6 +590,20 @@ extern void HW_RNG_Disable( void );
  */
 extern void HW_RNG_Start( void );
 
+/* HW_RNG_StartAsync
+ *
+ * First half of HW_RNG_Start(): resets the pool and enables the RNG IP,
+ * without waiting for the random numbers. The RNG seeds while the caller
+ * goes on; HW_RNG_WaitPool() must then be called before HW_RNG_Get().
+ */
+extern void HW_RNG_StartAsync( void );
+
+/* HW_RNG_WaitPool
+ *
+ * Second half of HW_RNG_Start(): fills the pool and disables the RNG IP.
+ */
+extern void HW_RNG_WaitPool( void );
+
 /*
  * HW_RNG_Get
  *
@@ -409,6 +615,17 @@ extern void HW_RNG_Start( void );
 extern void HW_RNG_Get( uint8_t n,
                         uint32_t* val );
 
+/*
+ * HW_RNG_GetBytes
+ *
+ * Retrieves "n" random bytes, copied from the pool in a single critical
+ * section. "n" must be at most 4 * CFG_HW_RNG_POOL_SIZE.
+ * The pool is refilled in background when its level falls at or below
+ * CFG_HW_RNG_POOL_THRESHOLD words, so that the callers do not find it empty.
+ */
+extern void HW_RNG_GetBytes( uint32_t n,
+                             uint8_t* val );
+
 /*
  * HW_RNG_Process
  *
@@ -18,6 +18,9 @@
 
 #include "app_common.h"
 #include "stm32wbaxx_ll_bus.h"
+#if CFG_HW_AES_DMA_SUPPORTED != 0
+#include "stm32wbaxx_ll_dma.h"
+#endif /* CFG_HW_AES_DMA_SUPPORTED != 0 */
 
 /*****************************************************************************/
 
@@ -36,6 +39,19 @@
 typedef struct
 {
   uint8_t  run;
+
+  /* Key loaded by HW_AES_SetKey() and its mode (key_valid = 0 when the key
+     registers were written by another processing) */
+  uint8_t  key_valid;
+  uint8_t  key_mode;
+  uint32_t key[4];
+
+#if CFG_HW_AES_DMA_SUPPORTED != 0
+
+  void (*dma_callback)( int success );
+
+#endif /* CFG_HW_AES_DMA_SUPPORTED != 0 */
+
 } HW_AES_VAR_T;
 
 /*****************************************************************************/
@@ -71,6 +87,7 @@ int HW_AES_Enable( void )
 void HW_AES_SetKey( uint32_t mode,
                     const uint8_t* key )
 {
+  HW_AES_VAR_T* av = &HW_AES_var;
   uint32_t tmp[4];
 
   /* Retrieve all bytes of key */
@@ -85,6 +102,25 @@ void HW_AES_SetKey( uint32_t mode,
   */
   HW_AESX->CR = 0;
 
+  /* Keep the key registers (and the decryption key preparation) when the
+     same key is already loaded: the key is kept while the AES clock is
+     disabled and KEYVALID is cleared by a reset of the peripheral */
+  if ( av->key_valid &&
+       (av->key_mode == (uint8_t)(mode & (HW_AES_ENC | HW_AES_REV))) &&
+       (memcmp( av->key, tmp, 16 ) == 0) &&
+       (HW_AESX->SR & AES_SR_KEYVALID) )
+  {
+    if ( !(mode & HW_AES_ENC) )
+      HW_AESX->CR = AES_CR_MODE_1;
+
+    if ( mode & HW_AES_SWAP )
+      HW_AESX->CR |= AES_CR_DATATYPE_1;
+
+    HW_AESX->CR |= AES_CR_EN;
+    return;
+  }
+  av->key_valid = FALSE;
+
   /* Copy key bytes to the AES registers */
 
   if ( mode & HW_AES_REV )
@@ -127,14 +163,18 @@ void HW_AES_SetKey( uint32_t mode,
   /* Wait until KEYVALID is set */
   while ( !(HW_AESX->SR & AES_SR_KEYVALID) );
 
+  memcpy( av->key, tmp, 16 );
+  av->key_mode = (uint8_t)(mode & (HW_AES_ENC | HW_AES_REV));
+  av->key_valid = TRUE;
+
   /* Enable AES processing */
   HW_AESX->CR |= AES_CR_EN;
 }
 
 /*****************************************************************************/
 
-void HW_AES_Crypt( const uint32_t* input,
-                   uint32_t* output )
+HOT_CODE void HW_AES_Crypt( const uint32_t* input,
+                            uint32_t* output )
 {
   /* Write the input block into the input FIFO */
   HW_AESX->DINR = input[0];
@@ -179,6 +219,162 @@ void HW_AES_Disable( void )
 
 /*****************************************************************************/
 
+void HW_AES_CryptBlocks( const uint32_t* input,
+                         uint32_t* output,
+                         uint32_t nb_blocks )
+{
+  if ( nb_blocks == 0 )
+  {
+    return;
+  }
+
+  /* Write the first input block into the input FIFO */
+  HW_AESX->DINR = input[0];
+  HW_AESX->DINR = input[1];
+  HW_AESX->DINR = input[2];
+  HW_AESX->DINR = input[3];
+
+  while ( nb_blocks-- )
+  {
+    /* Wait for CCF flag to be raised */
+    while ( !(HW_AESX->SR & AES_SR_CCF) );
+
+    /* Read the output block from the output FIFO */
+    output[0] = HW_AESX->DOUTR;
+    output[1] = HW_AESX->DOUTR;
+    output[2] = HW_AESX->DOUTR;
+    output[3] = HW_AESX->DOUTR;
+
+    /* Clear CCF Flag */
+    HW_AESX->ICR |= AES_ICR_CCF;
+
+    /* Write the next input block at once */
+    if ( nb_blocks )
+    {
+      input += 4;
+      HW_AESX->DINR = input[0];
+      HW_AESX->DINR = input[1];
+      HW_AESX->DINR = input[2];
+      HW_AESX->DINR = input[3];
+    }
+    output += 4;
+  }
+}
+
+/*****************************************************************************/
+
+#if CFG_HW_AES_DMA_SUPPORTED != 0
+
+int HW_AES_CryptBlocksDma( const uint32_t* input,
+                           uint32_t* output,
+                           uint32_t nb_blocks,
+                           void (*callback)( int success ) )
+{
+  HW_AES_VAR_T* av = &HW_AES_var;
+  uint32_t length = nb_blocks * AES_BLOCK_SIZE_BYTE;
+
+  if ( (av->dma_callback != NULL) || (nb_blocks == 0) || (length > 0xFFFFUL) )
+  {
+    return FALSE;
+  }
+  av->dma_callback = callback;
+
+  /* Input channel: memory to AES_DINR */
+  LL_DMA_SetDataTransferDirection( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_DMA_DIRECTION_MEMORY_TO_PERIPH );
+  LL_DMA_SetPeriphRequest( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_GPDMA1_REQUEST_AES_IN );
+  LL_DMA_SetSrcIncMode( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_DMA_SRC_INCREMENT );
+  LL_DMA_SetDestIncMode( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_DMA_DEST_FIXED );
+  LL_DMA_SetSrcDataWidth( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_DMA_SRC_DATAWIDTH_WORD );
+  LL_DMA_SetDestDataWidth( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, LL_DMA_DEST_DATAWIDTH_WORD );
+  LL_DMA_SetSrcAddress( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, (uint32_t)input );
+  LL_DMA_SetDestAddress( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, (uint32_t)&HW_AESX->DINR );
+  LL_DMA_SetBlkDataLength( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL, length );
+
+  /* Output channel: AES_DOUTR to memory, end of transfer interrupt */
+  LL_DMA_SetDataTransferDirection( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_DMA_DIRECTION_PERIPH_TO_MEMORY );
+  LL_DMA_SetPeriphRequest( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_GPDMA1_REQUEST_AES_OUT );
+  LL_DMA_SetSrcIncMode( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_DMA_SRC_FIXED );
+  LL_DMA_SetDestIncMode( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_DMA_DEST_INCREMENT );
+  LL_DMA_SetSrcDataWidth( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_DMA_SRC_DATAWIDTH_WORD );
+  LL_DMA_SetDestDataWidth( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, LL_DMA_DEST_DATAWIDTH_WORD );
+  LL_DMA_SetSrcAddress( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, (uint32_t)&HW_AESX->DOUTR );
+  LL_DMA_SetDestAddress( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, (uint32_t)output );
+  LL_DMA_SetBlkDataLength( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL, length );
+  LL_DMA_ClearFlag_TC( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_ClearFlag_DTE( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL );
+  LL_DMA_ClearFlag_DTE( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_EnableIT_TC( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_EnableIT_DTE( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+
+  NVIC_SetPriority( CFG_HW_AES_DMA_OUT_IRQn, AES_DMA_INTR_PRIO );
+  NVIC_EnableIRQ( CFG_HW_AES_DMA_OUT_IRQn );
+
+  LL_DMA_EnableChannel( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_EnableChannel( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL );
+
+  /* Start the AES DMA requests */
+  HW_AESX->CR |= AES_CR_DMAINEN | AES_CR_DMAOUTEN;
+
+  return TRUE;
+}
+
+/*****************************************************************************/
+
+void HW_AES_DmaIrqHandler( void )
+{
+  HW_AES_VAR_T* av = &HW_AES_var;
+  void (*callback)( int success ) = av->dma_callback;
+  int success = TRUE;
+
+  if ( LL_DMA_IsActiveFlag_DTE( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL ) ||
+       LL_DMA_IsActiveFlag_DTE( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL ) )
+  {
+    success = FALSE;
+  }
+  else if ( !LL_DMA_IsActiveFlag_TC( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL ) )
+  {
+    return;
+  }
+
+  /* Stop the AES DMA requests and the channels */
+  HW_AESX->CR &= ~(AES_CR_DMAINEN | AES_CR_DMAOUTEN);
+  LL_DMA_DisableChannel( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL );
+  LL_DMA_DisableChannel( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_ClearFlag_TC( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  LL_DMA_ClearFlag_DTE( GPDMA1, CFG_HW_AES_DMA_IN_CHANNEL );
+  LL_DMA_ClearFlag_DTE( GPDMA1, CFG_HW_AES_DMA_OUT_CHANNEL );
+  HW_AESX->ICR |= AES_ICR_CCF;
+
+  av->dma_callback = NULL;
+  if ( callback != NULL )
+  {
+    callback( success );
+  }
+}
+
+#else /* CFG_HW_AES_DMA_SUPPORTED != 0 */
+
+int HW_AES_CryptBlocksDma( const uint32_t* input,
+                           uint32_t* output,
+                           uint32_t nb_blocks,
+                           void (*callback)( int success ) )
+{
+  (void)input;
+  (void)output;
+  (void)nb_blocks;
+  (void)callback;
+
+  return FALSE;
+}
+
+void HW_AES_DmaIrqHandler( void )
+{
+}
+
+#endif /* CFG_HW_AES_DMA_SUPPORTED != 0 */
+
+/*****************************************************************************/
+
 void HW_AES_Crypt8( const uint8_t * pInput, uint8_t * pOutput )
 {
   uint32_t    pTemp[AES_BLOCK_SIZE_WORD];
@@ -215,9 +411,23 @@ void HW_AES_InitCcm( uint8_t decrypt,
                      const uint8_t* key,
                      const uint32_t* b0,
                      const uint32_t* b1 )
+{
+  HW_AES_StartCcm( decrypt, key, b0 );
+  HW_AES_CcmHeader( b1 );
+  HW_AES_StartCcmPayload( decrypt );
+}
+
+/*****************************************************************************/
+
+void HW_AES_StartCcm( uint8_t decrypt,
+                      const uint8_t* key,
+                      const uint32_t* b0 )
 {
   uint32_t tmp[4], mode = decrypt ? AES_CR_MODE_1 : 0;
 
+  /* The key registers no more hold the key of HW_AES_SetKey() */
+  HW_AES_var.key_valid = FALSE;
+
   /* CCM init phase */
   HW_AESX->CR = AES_CR_CHMOD_2 | mode;
 
@@ -242,24 +452,39 @@ void HW_AES_InitCcm( uint8_t decrypt,
 
   /* Clear CCF Flag */
   HW_AESX->ICR |= AES_ICR_CCF;
+}
 
-  /* CCM header phase */
-  HW_AESX->CR = AES_CR_CHMOD_2 | AES_CR_GCMPH_0 | AES_CR_DATATYPE_1;
+/*****************************************************************************/
 
-  /* Enable AES processing */
-  HW_AESX->CR |= AES_CR_EN;
+void HW_AES_CcmHeader( const uint32_t* block )
+{
+  /* CCM header phase (entered with the first header block) */
+  if ( (HW_AESX->CR & AES_CR_GCMPH) != AES_CR_GCMPH_0 )
+  {
+    HW_AESX->CR = AES_CR_CHMOD_2 | AES_CR_GCMPH_0 | AES_CR_DATATYPE_1;
+
+    /* Enable AES processing */
+    HW_AESX->CR |= AES_CR_EN;
+  }
 
-  /* Write the header block B1 into the input FIFO */
-  HW_AESX->DINR = b1[0];
-  HW_AESX->DINR = b1[1];
-  HW_AESX->DINR = b1[2];
-  HW_AESX->DINR = b1[3];
+  /* Write the header block into the input FIFO */
+  HW_AESX->DINR = block[0];
+  HW_AESX->DINR = block[1];
+  HW_AESX->DINR = block[2];
+  HW_AESX->DINR = block[3];
 
   /* Wait for CCF flag to be raised */
   while ( !(HW_AESX->SR & AES_SR_CCF) );
 
   /* Clear CCF Flag */
   HW_AESX->ICR |= AES_ICR_CCF;
+}
+
+/*****************************************************************************/
+
+void HW_AES_StartCcmPayload( uint8_t decrypt )
+{
+  uint32_t mode = decrypt ? AES_CR_MODE_1 : 0;
 
   /* CCM payload  phase */
   HW_AESX->CR = (AES_CR_EN | AES_CR_CHMOD_2 |
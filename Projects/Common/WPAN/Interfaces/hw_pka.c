@@ -19,12 +19,27 @@
 #include "app_common.h"
 #include "stm32wbaxx_ll_bus.h"
 #include "stm32wbaxx_ll_pka.h"
+#if CFG_HW_PKA_ASYNC_SUPPORTED != 0
+#include "stm32_lpm.h"
+#endif /* CFG_HW_PKA_ASYNC_SUPPORTED != 0 */
 
 /*****************************************************************************/
 
 typedef struct
 {
   uint8_t  run;
+
+#if CFG_HW_PKA_ASYNC_SUPPORTED != 0
+
+  /* Queue of the asynchronous jobs: the first one is processed by the PKA
+     when job_run is set, job_done is set by the interrupt at its end */
+  HW_PKA_JOB_T* head;
+  HW_PKA_JOB_T* tail;
+  uint8_t job_run;
+  volatile uint8_t job_done;
+
+#endif /* CFG_HW_PKA_ASYNC_SUPPORTED != 0 */
+
 } HW_PKA_VAR_T;
 
 /*****************************************************************************/
@@ -164,7 +179,116 @@ void HW_PKA_Disable( void )
     UTILS_EXIT_CRITICAL_SECTION( );
 
     pv->run = FALSE;
+
+#if CFG_HW_PKA_ASYNC_SUPPORTED != 0
+
+    /* The asynchronous jobs may wait for the PKA */
+    if ( pv->head && !pv->job_run )
+    {
+      HWCB_PKA_Process( );
+    }
+
+#endif /* CFG_HW_PKA_ASYNC_SUPPORTED != 0 */
+  }
+}
+
+/*****************************************************************************/
+
+#if CFG_HW_PKA_ASYNC_SUPPORTED != 0
+
+void HW_PKA_Submit( HW_PKA_JOB_T* job )
+{
+  HW_PKA_VAR_T* pv = &HW_PKA_var;
+
+  job->next = NULL;
+
+  UTILS_ENTER_CRITICAL_SECTION( );
+
+  if ( pv->tail )
+  {
+    pv->tail->next = job;
+  }
+  else
+  {
+    pv->head = job;
   }
+  pv->tail = job;
+
+  UTILS_EXIT_CRITICAL_SECTION( );
+
+  /* The job is started from the background task */
+  HWCB_PKA_Process( );
 }
 
 /*****************************************************************************/
+
+void HW_PKA_Process( void )
+{
+  HW_PKA_VAR_T* pv = &HW_PKA_var;
+  HW_PKA_JOB_T* job;
+
+  /* End of the running job */
+  if ( pv->job_run )
+  {
+    if ( !pv->job_done )
+    {
+      return;
+    }
+
+    UTILS_ENTER_CRITICAL_SECTION( );
+
+    job = pv->head;
+    pv->head = job->next;
+    if ( pv->head == NULL )
+    {
+      pv->tail = NULL;
+    }
+
+    UTILS_EXIT_CRITICAL_SECTION( );
+
+    job->end( job );
+
+    pv->job_run = FALSE;
+    pv->job_done = FALSE;
+    HW_PKA_Disable( );
+    UTIL_LPM_SetStopMode( 1U << CFG_LPM_PKA, UTIL_LPM_ENABLE );
+
+    job->callback( job );
+  }
+
+  /* Start of the next job, unless the PKA is used by a synchronous user
+     (the job is then started when HW_PKA_Disable() is called) */
+  if ( (pv->head == NULL) || pv->job_run || !HW_PKA_Enable( ) )
+  {
+    return;
+  }
+
+  /* The PKA is not clocked in Stop mode */
+  UTIL_LPM_SetStopMode( 1U << CFG_LPM_PKA, UTIL_LPM_DISABLE );
+
+  pv->job_run = TRUE;
+  pv->head->start( pv->head );
+
+  NVIC_SetPriority( PKA_IRQn, PKA_INTR_PRIO );
+  NVIC_EnableIRQ( PKA_IRQn );
+  LL_PKA_EnableIT_PROCEND( PKA );
+}
+
+/*****************************************************************************/
+
+void HW_PKA_IrqHandler( void )
+{
+  HW_PKA_VAR_T* pv = &HW_PKA_var;
+
+  if ( LL_PKA_IsActiveFlag_PROCEND( PKA ) )
+  {
+    LL_PKA_DisableIT_PROCEND( PKA );
+    pv->job_done = TRUE;
+
+    HWCB_PKA_Process( );
+  }
+}
+
+#endif /* CFG_HW_PKA_ASYNC_SUPPORTED != 0 */
+
+/*****************************************************************************/
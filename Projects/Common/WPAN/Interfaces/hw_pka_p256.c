@@ -233,3 +233,116 @@ void HW_PKA_P256_ReadEccScalarMul( uint32_t* p_x,
 }
 
 /*****************************************************************************/
+
+void HW_PKA_P256_StartEcdsaVerif( const uint32_t* e,
+                                  const uint32_t* r,
+                                  const uint32_t* s,
+                                  const uint32_t* q_x,
+                                  const uint32_t* q_y )
+{
+  /* Set the order and the modulus number of bits */
+  HW_PKA_WriteSingleInput( PKA_ECDSA_VERIF_IN_ORDER_NB_BITS, 256 );
+  HW_PKA_WriteSingleInput( PKA_ECDSA_VERIF_IN_MOD_NB_BITS, 256 );
+
+  /* Set the coefficient a sign (|a| = 3, a is negative) and value */
+  HW_PKA_WriteSingleInput( PKA_ECDSA_VERIF_IN_A_COEFF_SIGN, 1 );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_A_COEFF, 8, HW_PKA_P256_a );
+
+  /* Set the modulus value p */
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_MOD_GF, 8, HW_PKA_P256_gfp );
+
+  /* Set the base point G and the order n */
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_INITIAL_POINT_X, 8, HW_PKA_P256_p_x );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_INITIAL_POINT_Y, 8, HW_PKA_P256_p_y );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_ORDER_N, 8, HW_PKA_P256_n );
+
+  /* Set the public key Q */
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_X, 8, q_x );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_PUBLIC_KEY_POINT_Y, 8, q_y );
+
+  /* Set the signature (r, s) and the hash e */
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_SIGNATURE_R, 8, r );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_SIGNATURE_S, 8, s );
+  HW_PKA_WriteOperand( PKA_ECDSA_VERIF_IN_HASH_E, 8, e );
+
+  /* Start PKA hardware */
+  HW_PKA_Start( LL_PKA_MODE_ECDSA_VERIFICATION );
+}
+
+/*****************************************************************************/
+
+uint32_t HW_PKA_P256_IsEcdsaVerifOk( void )
+{
+  return (HW_PKA_ReadSingleOutput( PKA_ECDSA_VERIF_OUT_RESULT ) == 0xD60DUL);
+}
+
+/*****************************************************************************/
+
+#if CFG_HW_PKA_ASYNC_SUPPORTED != 0
+
+static void HW_PKA_P256_StartEccScalarMulJob( HW_PKA_JOB_T* job )
+{
+  HW_PKA_P256_ECC_MUL_JOB_T* mj = (HW_PKA_P256_ECC_MUL_JOB_T*)job;
+
+  HW_PKA_P256_StartEccScalarMul( mj->k, mj->p_x, mj->p_y );
+}
+
+/*****************************************************************************/
+
+static void HW_PKA_P256_EndEccScalarMulJob( HW_PKA_JOB_T* job )
+{
+  HW_PKA_P256_ECC_MUL_JOB_T* mj = (HW_PKA_P256_ECC_MUL_JOB_T*)job;
+
+  mj->success = (HW_PKA_ReadSingleOutput( PKA_ECC_SCALAR_MUL_OUT_ERROR ) ==
+                 0xD60DUL);
+
+  HW_PKA_P256_ReadEccScalarMul( mj->r_x, mj->r_y );
+}
+
+/*****************************************************************************/
+
+void HW_PKA_P256_EccScalarMulAsync( HW_PKA_P256_ECC_MUL_JOB_T* job,
+                                    void (*callback)( HW_PKA_JOB_T* job ) )
+{
+  job->job.start = HW_PKA_P256_StartEccScalarMulJob;
+  job->job.end = HW_PKA_P256_EndEccScalarMulJob;
+  job->job.callback = callback;
+  job->success = 0;
+
+  HW_PKA_Submit( &job->job );
+}
+
+/*****************************************************************************/
+
+static void HW_PKA_P256_StartEcdsaVerifJob( HW_PKA_JOB_T* job )
+{
+  HW_PKA_P256_ECDSA_VERIF_JOB_T* vj = (HW_PKA_P256_ECDSA_VERIF_JOB_T*)job;
+
+  HW_PKA_P256_StartEcdsaVerif( vj->e, vj->r, vj->s, vj->q_x, vj->q_y );
+}
+
+/*****************************************************************************/
+
+static void HW_PKA_P256_EndEcdsaVerifJob( HW_PKA_JOB_T* job )
+{
+  HW_PKA_P256_ECDSA_VERIF_JOB_T* vj = (HW_PKA_P256_ECDSA_VERIF_JOB_T*)job;
+
+  vj->success = (uint8_t)HW_PKA_P256_IsEcdsaVerifOk( );
+}
+
+/*****************************************************************************/
+
+void HW_PKA_P256_EcdsaVerifAsync( HW_PKA_P256_ECDSA_VERIF_JOB_T* job,
+                                  void (*callback)( HW_PKA_JOB_T* job ) )
+{
+  job->job.start = HW_PKA_P256_StartEcdsaVerifJob;
+  job->job.end = HW_PKA_P256_EndEcdsaVerifJob;
+  job->job.callback = callback;
+  job->success = 0;
+
+  HW_PKA_Submit( &job->job );
+}
+
+/*****************************************************************************/
+
+#endif /* CFG_HW_PKA_ASYNC_SUPPORTED != 0 */
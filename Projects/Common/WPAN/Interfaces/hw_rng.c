@@ -21,6 +21,11 @@
 #include "stm32wbaxx_ll_rng.h"
 #include "RTDebug.h"
 
+/* Pool level (in 32-bit words) at or below which a refill is launched */
+#ifndef CFG_HW_RNG_POOL_THRESHOLD
+#define CFG_HW_RNG_POOL_THRESHOLD           (CFG_HW_RNG_POOL_SIZE / 2)
+#endif
+
 __weak void RNG_KERNEL_CLK_ON(void)
 {
   /* NOTE : This function should not be modified, when the callback is needed,
@@ -236,6 +241,14 @@ static int HW_RNG_Run( HW_RNG_VAR_T* pv )
 /*****************************************************************************/
 
 void HW_RNG_Start( void )
+{
+  HW_RNG_StartAsync( );
+  HW_RNG_WaitPool( );
+}
+
+/*****************************************************************************/
+
+void HW_RNG_StartAsync( void )
 {
   HW_RNG_VAR_T* pv = &HW_RNG_var;
 
@@ -245,12 +258,21 @@ void HW_RNG_Start( void )
   pv->error = HW_OK;
   pv->clock_en = 0;
 
+  /* First call of the "run" function : enables the RNG */
+  pv->error = HW_RNG_Run( pv );
+}
+
+/*****************************************************************************/
+
+void HW_RNG_WaitPool( void )
+{
+  HW_RNG_VAR_T* pv = &HW_RNG_var;
+
   /* Fill the random numbers pool by calling the "run" function */
-  do
+  while ( pv->run && !pv->error )
   {
     pv->error = HW_RNG_Run( pv );
   }
-  while ( pv->run && !pv->error );
 }
 
 /*****************************************************************************/
@@ -279,8 +301,49 @@ void HW_RNG_Get( uint8_t n, uint32_t* val )
     *val++ = pool_value;
   }
 
-  /* Call the process callback function to fill the pool offline */
-  HWCB_RNG_Process( );
+  /* Call the process callback function to fill the pool offline, before it is empty */
+  if ( pv->size <= CFG_HW_RNG_POOL_THRESHOLD )
+  {
+    HWCB_RNG_Process( );
+  }
+}
+
+/*****************************************************************************/
+
+void HW_RNG_GetBytes( uint32_t n, uint8_t* val )
+{
+  HW_RNG_VAR_T* pv = &HW_RNG_var;
+  uint32_t pool_value, len, size;
+
+  UTILS_ENTER_CRITICAL_SECTION( );
+
+  while ( n > 0 )
+  {
+    if ( pv->size == 0 )
+    {
+      pv->error = HW_RNG_UFLOW_ERROR;
+      pool_value = ~pv->pool[n & (CFG_HW_RNG_POOL_SIZE - 1)];
+    }
+    else
+    {
+      pool_value = pv->pool[--pv->size];
+    }
+
+    len = ( n < 4 ) ? n : 4;
+    memcpy( val, &pool_value, len );
+    val += len;
+    n -= len;
+  }
+
+  size = pv->size;
+
+  UTILS_EXIT_CRITICAL_SECTION( );
+
+  /* Call the process callback function to fill the pool offline, before it is empty */
+  if ( size <= CFG_HW_RNG_POOL_THRESHOLD )
+  {
+    HWCB_RNG_Process( );
+  }
 }
 
 /*****************************************************************************/
@@ -106,6 +106,20 @@ static bool RTC_Initialized = 0;
   */
 static uint32_t RtcTimerContext = 0;
 
+/**
+  * @brief Microseconds time base : last time returned, and DWT cycle it was read at (less the remainder of the
+  *        conversion)
+  */
+static uint64_t TimeUsLast = 0;
+static uint32_t TimeUsLastCycle = 0;
+
+#if (CFG_HAL_TICK_RTC_SUPPORTED != 0)
+/**
+  * @brief HAL time base on the RTC : offset (ms) continuing the SysTick count of the boot
+  */
+static uint32_t HalTickOffsetMs = 0;
+#endif /* (CFG_HAL_TICK_RTC_SUPPORTED != 0) */
+
 /* Exported macro ------------------------------------------------------------*/
 #ifdef RTIF_DEBUG
 #include "sys_app.h" /*for app_log*/
@@ -164,9 +178,20 @@ UTIL_TIMER_Status_t TIMER_IF_Init(void)
     /* Initialise MSB ticks */
     TIMER_IF_BkUp_Write_MSBticks(0);
 
+    /* DWT cycle counter of the microseconds time base */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    TimeUsLastCycle = DWT->CYCCNT;
+
     TIMER_IF_SetTimerContext();
 
     RTC_Initialized = true;
+
+#if (CFG_HAL_TICK_RTC_SUPPORTED != 0)
+    /* HAL time base on the RTC from now : the SysTick is stopped */
+    HalTickOffsetMs = uwTick - (uint32_t)(TIMER_IF_GetTimeUs() / 1000U);
+    SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+#endif /* (CFG_HAL_TICK_RTC_SUPPORTED != 0) */
   }
 
   return ret;
@@ -264,6 +289,11 @@ uint32_t TIMER_IF_Convert_Tick2ms(uint32_t tick)
   return ((uint32_t)( ( ( ( int64_t)( tick ) ) * 1000U ) >> RTC_N_PREDIV_S ) );
 }
 
+uint32_t TIMER_IF_Convert_Tick2us(uint32_t tick)
+{
+  return ((uint32_t)( ( ( ( uint64_t)( tick ) ) * 1000000U ) >> RTC_N_PREDIV_S ) );
+}
+
 void TIMER_IF_DelayMs(uint32_t delay)
 {
   uint32_t delayTicks = TIMER_IF_Convert_ms2Tick(delay);
@@ -308,6 +338,148 @@ uint32_t TIMER_IF_GetTime(uint16_t *mSeconds)
   return seconds;
 }
 
+uint64_t TIMER_IF_GetTimeUs(void)
+{
+  uint32_t primask_bit;
+  uint32_t cycle;
+  uint32_t elapsed;
+  uint32_t cyclePerUs;
+  uint32_t timerValueLsb;
+  uint32_t timerValueMSB;
+  uint64_t ticks;
+  uint64_t tickStartUs;
+  uint64_t tickEndUs;
+  uint64_t timeUs;
+
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+
+  /* Cycles since the previous call, converted with the current core clock */
+  cycle = DWT->CYCCNT;
+  cyclePerUs = SystemCoreClock / 1000000U;
+  if (cyclePerUs == 0U)
+  {
+    cyclePerUs = 1U;
+  }
+  elapsed = cycle - TimeUsLastCycle;
+  timeUs = TimeUsLast + (elapsed / cyclePerUs);
+  TimeUsLastCycle = cycle - (elapsed % cyclePerUs);
+
+  if (RTC_Initialized == true)
+  {
+    /* The MSBticks is incremented by the SSRU interrupt, maybe still pending */
+    timerValueMSB = TIMER_IF_BkUp_Read_MSBticks();
+    timerValueLsb = GetTimerTicks();
+    if ((LL_RTC_IsActiveFlag_SSRU(RTC) != 0U) && (timerValueLsb < (UINT32_MAX / 2U)))
+    {
+      timerValueMSB++;
+    }
+    ticks = (((uint64_t) timerValueMSB) << 32) + timerValueLsb;
+
+    /* The DWT time must lie in the current RTC tick : it is behind after a Stop mode, or a DWT wrap */
+    tickStartUs = ((ticks >> RTC_N_PREDIV_S) * 1000000U) + (((ticks & RTC_PREDIV_S) * 1000000U) >> RTC_N_PREDIV_S);
+    tickEndUs = (((ticks + 1U) >> RTC_N_PREDIV_S) * 1000000U) + ((((ticks + 1U) & RTC_PREDIV_S) * 1000000U) >> RTC_N_PREDIV_S);
+    if (timeUs < tickStartUs)
+    {
+      timeUs = tickStartUs;
+    }
+    else if (timeUs >= tickEndUs)
+    {
+      timeUs = tickEndUs - 1U;
+    }
+  }
+
+  /* Never backwards, even if the MSBticks and the counter were read across their update */
+  if (timeUs < TimeUsLast)
+  {
+    timeUs = TimeUsLast;
+  }
+  TimeUsLast = timeUs;
+
+  __set_PRIMASK(primask_bit);
+
+  return timeUs;
+}
+
+#if (CFG_HAL_TICK_RTC_SUPPORTED != 0)
+/**
+  * @brief HAL time base : SysTick on its selected clock until the RTC runs, then nothing (clock changes, Standby exit)
+  * @param TickPriority Tick interrupt priority
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  uint32_t ticknumber;
+
+  uwTickPrio = TickPriority;
+  if (RTC_Initialized == true)
+  {
+    return HAL_OK;
+  }
+
+  if (READ_BIT(SysTick->CTRL, SysTick_CTRL_CLKSOURCE_Msk) == SysTick_CTRL_CLKSOURCE_Msk)
+  {
+    ticknumber = SystemCoreClock / (1000UL / (uint32_t)uwTickFreq);
+  }
+  else if (__HAL_RCC_GET_SYSTICK_SOURCE() == RCC_SYSTICKCLKSOURCE_HCLK_DIV8)
+  {
+    ticknumber = SystemCoreClock / (8000UL / (uint32_t)uwTickFreq);
+  }
+  else if (__HAL_RCC_GET_SYSTICK_SOURCE() == RCC_SYSTICKCLKSOURCE_LSI)
+  {
+    ticknumber = LSI_VALUE / (1000UL / (uint32_t)uwTickFreq);
+  }
+  else
+  {
+    ticknumber = LSE_VALUE / (1000UL / (uint32_t)uwTickFreq);
+  }
+
+  if (HAL_SYSTICK_Config(ticknumber) > 0U)
+  {
+    return HAL_ERROR;
+  }
+  HAL_NVIC_SetPriority(SysTick_IRQn, TickPriority, 0U);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief HAL time base : SysTick count until the RTC runs, then RTC time in ms
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  if (RTC_Initialized == true)
+  {
+    return (HalTickOffsetMs + (uint32_t)(TIMER_IF_GetTimeUs() / 1000U));
+  }
+
+  return uwTick;
+}
+
+/**
+  * @brief HAL time base : SysTick interrupt disabled, nothing to do on the RTC
+  */
+void HAL_SuspendTick(void)
+{
+  if (RTC_Initialized == false)
+  {
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+  }
+}
+
+/**
+  * @brief HAL time base : SysTick interrupt enabled again, nothing to do on the RTC
+  */
+void HAL_ResumeTick(void)
+{
+  if (RTC_Initialized == false)
+  {
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+  }
+}
+#endif /* (CFG_HAL_TICK_RTC_SUPPORTED != 0) */
+
 void TIMER_IF_BkUp_Write_Seconds(uint32_t Seconds)
 {
   HAL_RTCEx_BKUPWrite(&hrtc, RTC_BKP_SECONDS, Seconds);
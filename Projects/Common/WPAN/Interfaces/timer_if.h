@@ -120,6 +120,13 @@ uint32_t TIMER_IF_Convert_ms2Tick(uint32_t timeMilliSec);
   */
 uint32_t TIMER_IF_Convert_Tick2ms(uint32_t tick);
 
+/**
+  * @brief converts time in ticks to time in us (used to report the timer lateness)
+  * @param[in] tick time in timer ticks
+  * @return time in timer microseconds
+  */
+uint32_t TIMER_IF_Convert_Tick2us(uint32_t tick);
+
 /**
   * @brief Get rtc time
   * @param[out] subSeconds in ticks
@@ -127,6 +134,15 @@ uint32_t TIMER_IF_Convert_Tick2ms(uint32_t tick);
   */
 uint32_t TIMER_IF_GetTime(uint16_t *subSeconds);
 
+/**
+  * @brief Get the monotonic time in microseconds on 64 bits, on the time base of the RTC
+  * @note The DWT cycles give the microseconds, the RTC (running in Stop modes) bounds them to its current tick :
+  *       precise over short intervals, and consistent after a Stop mode (the DWT is stopped there) within one tick.
+  *       Short enough for the interrupts, not for a Standby mode (the RTC counter restarts with the MSBticks).
+  * @return time in microseconds
+  */
+uint64_t TIMER_IF_GetTimeUs(void);
+
 /**
   * @brief write seconds in backUp register
   * @note Used to store seconds difference between RTC time and Unix time
@@ -24,17 +24,55 @@
 /* Basic AES module dedicated to BLE stack with the following features:
  *   - AES ECB encryption
  *   - AES CMAC computation
+ *   - AES MMO hash (Zigbee)
  *
  * Configuration: the file "app_common.h" is included in this module.
  * It must define:
  *   - CFG_BAES_SW equals to 1 for software implementation
  *   - CFG_BAES_SW equals to 0 for use of hardware accelerator
+ * It can define:
+ *   - CFG_BAES_SW_FALLBACK equals to 1 to run ECB, CMAC and MMO in software
+ *     when the hardware accelerator is in use by another owner
+ *   - CFG_BAES_SW_OPERATIONS as the mask of the operations (BAES_OP_xxx)
+ *     always run in software when CFG_BAES_SW_FALLBACK equals to 1
  *
  * Notes:
  *   - only 128-bit key is supported
- *   - re-entrance is not supported
+ *   - re-entrance is not supported (but CMAC contexts can be interleaved)
  */
 
+/* Operations for CFG_BAES_SW_OPERATIONS */
+
+#define BAES_OP_ECB    0x01u
+#define BAES_OP_CMAC   0x02u
+#define BAES_OP_MMO    0x04u
+
+/* AES CMAC context: several contexts can be used concurrently. The subkeys
+ * K1/K2 are derived at the first finalization and kept while the key of the
+ * context does not change. */
+
+typedef struct
+{
+  uint32_t iv[4];          /* Temporary result/IV */
+  uint32_t k1[4];          /* Subkey for a full last block */
+  uint32_t k2[4];          /* Subkey for a padded last block */
+  uint8_t  key[16];        /* Key of the context */
+  uint8_t  subkeys_valid;  /* K1/K2 derived for the key */
+
+#if (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0)
+
+  uint32_t exp_key[44];    /* Expanded AES key */
+
+#endif /* (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0) */
+
+#if CFG_BAES_SW_FALLBACK != 0
+
+  uint8_t  sw;             /* Current computation run in S/W */
+
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+
+} BAES_CMAC_t;
+
 /* General interface */
 
 extern void BAES_Reset( void );
@@ -56,7 +94,27 @@ extern void BAES_CmacCompute( const uint8_t* input,
                               uint32_t size,
                               uint8_t* output );
 
-/* AES CCM interface */
+/* AES CMAC interface with a context */
+
+extern void BAES_CmacCtxSetKey( BAES_CMAC_t* ctx,
+                                const uint8_t* key );
+
+extern void BAES_CmacCtxSetVector( BAES_CMAC_t* ctx,
+                                   const uint8_t * pIV );
+
+extern void BAES_CmacCtxCompute( BAES_CMAC_t* ctx,
+                                 const uint8_t* input,
+                                 uint32_t size,
+                                 uint8_t* output );
+
+/* AES MMO hash interface */
+
+extern void BAES_MmoHash( const uint8_t* input,
+                          uint32_t size,
+                          uint8_t* output );
+
+/* AES CCM interface: returns 0 on success, a positive value on a tag
+ * mismatch and, with CFG_BAES_SW_FALLBACK, -1 if the AES is in use */
 
 extern int BAES_CcmCrypt( uint8_t mode,
                           const uint8_t* key,
@@ -52,29 +52,55 @@ int BAES_CcmCrypt( uint8_t mode,
 
   /* This implementation of AES CCM only supports HW AES and it also only
    * supports the following range for input parameters:
-   *  - tag_length: 4..16 (multiple of 2)
+   *  - tag_length: 0 (CCM* encryption only) or 4..16 (multiple of 2)
    *  - iv_length:  7..13
-   *  - add_length: 1..14
+   *  - add_length: 0..65279
    */
   uint32_t left_len, b0[4], bx[4];
-  uint8_t len, *b;
+  uint8_t len, pos, *b;
 
   /* Build B0 */
   b = (uint8_t*)b0;
   memset( b0, 0, 16 );
-  b[0] = (1U << 6) | (((tag_length - 2) / 2) << 3) | (14U - iv_length);
+  b[0] = (uint8_t)(14U - iv_length);
+  if ( add_length > 0 )
+    b[0] |= (1U << 6);
+  if ( tag_length > 0 )
+    b[0] |= ((tag_length - 2U) / 2U) << 3;
   memcpy( b + 1, iv, iv_length );
   SET_U16_BE( b, 14, input_length );
 
-  /* Build B1 */
+  /* Start CCM process with Init phase */
+#if CFG_BAES_SW_FALLBACK != 0
+  /* No S/W CCM: the AES in use by another owner is reported */
+  if ( !HW_AES_Enable( ) )
+    return -1;
+#else /* CFG_BAES_SW_FALLBACK == 0 */
+  HW_AES_Enable( );
+#endif /* CFG_BAES_SW_FALLBACK == 0 */
+  HW_AES_StartCcm( mode, key, b0 );
+
+  /* Header phase: B1, B2... with the additional data prefixed by its length */
   b = (uint8_t*)bx;
-  memset( bx, 0, 16 );
-  b[1] = add_length;
-  memcpy( b + 2, add, add_length );
+  left_len = add_length;
+  pos = 2;
+  SET_U16_BE( b, 0, add_length );
+  while ( left_len > 0 )
+  {
+    len = 16 - pos;
+    if ( left_len < len )
+    {
+      len = (uint8_t)left_len;
+      memset( b + pos + len, 0, 16U - pos - len );
+    }
 
-  /* Start CCM process with Init and Header phases */
-  HW_AES_Enable( );
-  HW_AES_InitCcm( mode, key, b0, bx );
+    memcpy( b + pos, add, len );
+    HW_AES_CcmHeader( bx );
+    add += len;
+    left_len -= len;
+    pos = 0;
+  }
+  HW_AES_StartCcmPayload( mode );
 
   /* Continue CCM process with Payload Phase */
   left_len = input_length;
@@ -99,11 +125,11 @@ int BAES_CcmCrypt( uint8_t mode,
   }
 
   /* End CCM process with Final Phase */
-  HW_AES_EndCcm( tag_length, mode ? b : tag );
+  HW_AES_EndCcm( tag_length, (mode || !tag_length) ? b : tag );
   HW_AES_Disable( );
 
   /* Verification of the tag in case of decryption */
-  if ( mode )
+  if ( mode && tag_length )
   {
     uint8_t diff = 0;
     for ( int i = 0; i < tag_length; i++ )
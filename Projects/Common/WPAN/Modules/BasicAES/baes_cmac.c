@@ -20,21 +20,17 @@
 
 /*****************************************************************************/
 
-typedef struct
-{
-  uint32_t iv[4];          /* Temporary result/IV */
-
-#if CFG_BAES_SW != 0
+/* Context of the interface without context */
 
-  uint32_t exp_key[44];    /* Expanded AES key */
+BAES_CMAC_t BAES_CMAC_var;
 
-#endif /* CFG_BAES_SW != 0 */
+#if CFG_BAES_SW == 0
 
-} BAES_CMAC_t;
+/* Context whose key is loaded in the AES peripheral */
 
-/*****************************************************************************/
+static const BAES_CMAC_t* BAES_CMAC_hw_ctx;
 
-BAES_CMAC_t BAES_CMAC_var;
+#endif /* CFG_BAES_SW == 0 */
 
 /*****************************************************************************/
 
@@ -59,17 +55,25 @@ static void BAES_CmacKeyRoll( uint32_t* key )
  *
  */
 
-static void BAES_CmacRawEncrypt( const uint32_t* input,
+static void BAES_CmacRawEncrypt( const BAES_CMAC_t* av,
+                                 const uint32_t* input,
                                  uint32_t* output )
 {
 #if CFG_BAES_SW == 0
 
+#if CFG_BAES_SW_FALLBACK != 0
+  if ( av->sw )
+  {
+    BAES_RawEncrypt( input, output, av->exp_key );
+    return;
+  }
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+
+  (void)av;
   HW_AES_Crypt( input, output );
 
 #else /* CFG_BAES_SW != 0 */
 
-  BAES_CMAC_t *av = &BAES_CMAC_var;
-
   BAES_RawEncrypt( input, output, av->exp_key );
 
 #endif /* CFG_BAES_SW != 0 */
@@ -77,44 +81,112 @@ static void BAES_CmacRawEncrypt( const uint32_t* input,
 
 /*****************************************************************************/
 
+#if CFG_BAES_SW == 0
+
+/*
+ * Load the key of the context in the AES peripheral, if another key is
+ * loaded or if the peripheral was disabled since.
+ * With the S/W fallback, returns 0 when the computation must run in S/W:
+ * operation forced in S/W or AES peripheral in use by another owner.
+ */
+
+static int BAES_CmacLoadKey( const BAES_CMAC_t* av )
+{
+  int enabled;
+
+#if CFG_BAES_SW_FALLBACK != 0
+  if ( CFG_BAES_SW_OPERATIONS & BAES_OP_CMAC )
+    return 0;
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+
+  enabled = HW_AES_Enable( );
+
+#if CFG_BAES_SW_FALLBACK != 0
+  if ( !enabled && (BAES_CMAC_hw_ctx == NULL) )
+    return 0;
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+
+  if ( enabled || (BAES_CMAC_hw_ctx != av) )
+  {
+    HW_AES_SetKey( HW_AES_ENC, av->key );
+    BAES_CMAC_hw_ctx = av;
+  }
+
+  return 1;
+}
+
+#endif /* CFG_BAES_SW == 0 */
+
+/*****************************************************************************/
+
 /*
  * Initialization for AES-CMAC for Authentication TAG Generation.
  * Must be called each time a new CMAC has to be computed.
+ * The subkeys of the context are kept if the key is the same.
  */
 
-void BAES_CmacSetKey( const uint8_t* key )
+void BAES_CmacCtxSetKey( BAES_CMAC_t* ctx,
+                         const uint8_t* key )
 {
-  BAES_CMAC_t *av = &BAES_CMAC_var;
+  BAES_CMAC_t *av = ctx;
+
+  if ( !av->subkeys_valid || (memcmp( av->key, key, 16 ) != 0) )
+  {
+    memcpy( av->key, key, 16 );
+    av->subkeys_valid = 0;
+
+#if (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0)
+
+    uint32_t tmp[4];
+    memcpy( tmp, key, 16 );
+    BAES_COPY_REV( av->exp_key, tmp );
+
+    BAES_EncKeySchedule( av->exp_key );
+
+#endif /* (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0) */
+  }
 
   /* Initialize for ECB encoding */
 
 #if CFG_BAES_SW == 0
 
-  HW_AES_Enable( );
-  HW_AES_SetKey( HW_AES_ENC, key );
+#if CFG_BAES_SW_FALLBACK != 0
 
-#else /* CFG_BAES_SW != 0 */
+  /* The key is loaded at the first computation if the AES peripheral is
+     free: it is only reloaded here if the context already has it */
+  if ( BAES_CMAC_hw_ctx == av )
+  {
+    HW_AES_SetKey( HW_AES_ENC, key );
+  }
 
-  uint32_t tmp[4];
-  memcpy( tmp, key, 16 );
-  BAES_COPY_REV( av->exp_key, tmp );
+#else /* CFG_BAES_SW_FALLBACK == 0 */
 
-  BAES_EncKeySchedule( av->exp_key );
+  HW_AES_Enable( );
+  HW_AES_SetKey( HW_AES_ENC, key );
+  BAES_CMAC_hw_ctx = av;
 
-#endif /* CFG_BAES_SW != 0 */
+#endif /* CFG_BAES_SW_FALLBACK == 0 */
+
+#endif /* CFG_BAES_SW == 0 */
 
   /* set IV to zero */
   av->iv[0] = av->iv[1] = av->iv[2] = av->iv[3] = 0;
 }
 
+void BAES_CmacSetKey( const uint8_t* key )
+{
+  BAES_CmacCtxSetKey( &BAES_CMAC_var, key );
+}
+
 /*
  * Initialization for AES-CMAC for Authentication TAG Generation.
  * Must be called each time a new CMAC has to be computed.
  */
 
-void BAES_CmacSetVector( const uint8_t * pIV )
+void BAES_CmacCtxSetVector( BAES_CMAC_t* ctx,
+                            const uint8_t * pIV )
 {
-    BAES_CMAC_t  * av = &BAES_CMAC_var;
+    BAES_CMAC_t  * av = ctx;
 
     // -- Update IV if exist else set to zero --
     if ( pIV != NULL )
@@ -123,6 +195,11 @@ void BAES_CmacSetVector( const uint8_t * pIV )
       { memset( av->iv, 0x00, AES_BLOCK_SIZE_BYTE ); }
 }
 
+void BAES_CmacSetVector( const uint8_t * pIV )
+{
+  BAES_CmacCtxSetVector( &BAES_CMAC_var, pIV );
+}
+
 /*****************************************************************************/
 
 /*
@@ -134,16 +211,28 @@ void BAES_CmacSetVector( const uint8_t * pIV )
  * be NULL.
  */
 
-void BAES_CmacCompute( const uint8_t* input,
-                       uint32_t size,
-                       uint8_t* output )
+void BAES_CmacCtxCompute( BAES_CMAC_t* ctx,
+                          const uint8_t* input,
+                          uint32_t size,
+                          uint8_t* output )
 {
-  BAES_CMAC_t *av = &BAES_CMAC_var;
+  BAES_CMAC_t *av = ctx;
   uint32_t i;
   uint32_t last_size = 0;
-  uint32_t tmp[4], key[4];
+  uint32_t tmp[4];
+  const uint32_t* key;
   const uint8_t* ptr = input;
 
+#if CFG_BAES_SW == 0
+
+#if CFG_BAES_SW_FALLBACK != 0
+  av->sw = !BAES_CmacLoadKey( av );
+#else /* CFG_BAES_SW_FALLBACK == 0 */
+  (void)BAES_CmacLoadKey( av );
+#endif /* CFG_BAES_SW_FALLBACK == 0 */
+
+#endif /* CFG_BAES_SW == 0 */
+
   if ( output )
   {
     /* In case of final append, compute size of last block */
@@ -161,7 +250,7 @@ void BAES_CmacCompute( const uint8_t* input,
     BAES_REV_XOR( tmp, av->iv );
 
     /* Encrypt block */
-    BAES_CmacRawEncrypt( tmp, av->iv );
+    BAES_CmacRawEncrypt( av, tmp, av->iv );
 
     /* Next block */
     ptr += 16;
@@ -177,16 +266,23 @@ void BAES_CmacCompute( const uint8_t* input,
       BAES_OR_BYTE_BE( tmp, i, ptr[i] );
     }
 
-    /* Compute K1 */
-    key[0] = key[1] = key[2] = key[3] = 0;
-    BAES_CmacRawEncrypt( key, key );
-    BAES_CmacKeyRoll( key );
+    /* Compute K1 and K2 once per key */
+    if ( !av->subkeys_valid )
+    {
+      av->k1[0] = av->k1[1] = av->k1[2] = av->k1[3] = 0;
+      BAES_CmacRawEncrypt( av, av->k1, av->k1 );
+      BAES_CmacKeyRoll( av->k1 );
+      memcpy( av->k2, av->k1, 16 );
+      BAES_CmacKeyRoll( av->k2 );
+      av->subkeys_valid = 1;
+    }
 
-    /* Add padding and compute K2 if the last block is not full */
+    /* Add padding and use K2 if the last block is not full */
+    key = av->k1;
     if ( last_size < 16 )
     {
       BAES_OR_BYTE_BE( tmp, last_size, 0x80 );
-      BAES_CmacKeyRoll( key );
+      key = av->k2;
     }
 
     /* Xor data with previous tag and key */
@@ -196,11 +292,17 @@ void BAES_CmacCompute( const uint8_t* input,
     }
 
     /* Encrypt block */
-    BAES_CmacRawEncrypt( tmp, av->iv );
+    BAES_CmacRawEncrypt( av, tmp, av->iv );
 
 #if CFG_BAES_SW == 0
 
-    HW_AES_Disable( );
+#if CFG_BAES_SW_FALLBACK != 0
+    if ( !av->sw )
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+    {
+      HW_AES_Disable( );
+      BAES_CMAC_hw_ctx = NULL;
+    }
 
 #endif /* CFG_BAES_SW == 0 */
 
@@ -210,4 +312,11 @@ void BAES_CmacCompute( const uint8_t* input,
   }
 }
 
+void BAES_CmacCompute( const uint8_t* input,
+                       uint32_t size,
+                       uint8_t* output )
+{
+  BAES_CmacCtxCompute( &BAES_CMAC_var, input, size, output );
+}
+
 /*****************************************************************************/
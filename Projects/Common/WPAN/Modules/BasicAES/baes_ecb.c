@@ -38,6 +38,28 @@ void BAES_EcbCrypt( const uint8_t* key,
 {
   uint32_t tmp[4];
 
+#if (CFG_BAES_SW == 0) && (CFG_BAES_SW_FALLBACK != 0)
+
+  /* Encryption in S/W if forced or if the AES is in use by another owner */
+  if ( enc &&
+       ((CFG_BAES_SW_OPERATIONS & BAES_OP_ECB) || !HW_AES_Enable( )) )
+  {
+    uint32_t exp_key[44];
+
+    memcpy( exp_key, key, 16 );
+    BAES_SWAP( exp_key );
+    BAES_EncKeySchedule( exp_key );
+
+    memcpy( tmp, input, 16 );
+    BAES_SWAP( tmp );
+    BAES_RawEncrypt( tmp, tmp, exp_key );
+    BAES_SWAP( tmp );
+    memcpy( output, tmp, 16 );
+    return;
+  }
+
+#endif /* (CFG_BAES_SW == 0) && (CFG_BAES_SW_FALLBACK != 0) */
+
 #if CFG_BAES_SW == 0
 
   HW_AES_Enable( );
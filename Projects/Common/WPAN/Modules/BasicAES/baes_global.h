@@ -35,6 +35,17 @@
 #define CFG_BAES_SW                                        0
 #endif
 
+/* By default, no fallback on the AES S/W implementation when the AES H/W is
+ * in use by another owner */
+#ifndef CFG_BAES_SW_FALLBACK
+#define CFG_BAES_SW_FALLBACK                               0
+#endif
+
+/* Mask of the operations (BAES_OP_xxx) always run in S/W with the fallback */
+#ifndef CFG_BAES_SW_OPERATIONS
+#define CFG_BAES_SW_OPERATIONS                             0
+#endif
+
 #if CFG_BAES_SW == 1
 
 /* Enables to include AES S/W decryption when set to 1 */
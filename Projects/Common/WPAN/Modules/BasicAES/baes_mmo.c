@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * @file    baes_mmo.c
+ *
+ * @brief   This file contains the AES MMO hash implementation.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ *****************************************************************************
+ */
+
+#include "baes_global.h"
+
+/*****************************************************************************/
+
+/*
+ * One step of the Matyas-Meyer-Oseas hash: h = E(h, m) ^ m
+ * (4-word arrays in big endian words), run in S/W if "sw" is set with the
+ * S/W fallback
+ */
+
+static void BAES_MmoBlock( uint32_t* h,
+                           const uint32_t* m,
+                           int sw )
+{
+  uint32_t tmp[4];
+  int i;
+
+  (void)sw;
+
+#if CFG_BAES_SW == 0
+
+#if CFG_BAES_SW_FALLBACK != 0
+  if ( !sw )
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+  {
+    /* The key of each step is the previous hash */
+    BAES_COPY_REV( tmp, h );
+    HW_AES_SetKey( HW_AES_ENC, (const uint8_t*)tmp );
+    HW_AES_Crypt( m, tmp );
+  }
+#if CFG_BAES_SW_FALLBACK != 0
+  else
+#endif /* CFG_BAES_SW_FALLBACK != 0 */
+
+#endif /* CFG_BAES_SW == 0 */
+
+#if (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0)
+  {
+    uint32_t exp_key[44];
+
+    memcpy( exp_key, h, 16 );
+    BAES_EncKeySchedule( exp_key );
+    BAES_RawEncrypt( m, tmp, exp_key );
+  }
+#endif /* (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0) */
+
+  for ( i = 0; i < 4; i++ )
+  {
+    h[i] = tmp[i] ^ m[i];
+  }
+}
+
+/*****************************************************************************/
+
+/*
+ * AES MMO hash (Zigbee specification, B.6): the message is padded with a 1
+ * bit, zeros and its length in bits (16-bit, or 32-bit followed by 16 zero
+ * bits for 2^16 bits and more), the hash of the first step being zero.
+ */
+
+void BAES_MmoHash( const uint8_t* input,
+                   uint32_t size,
+                   uint8_t* output )
+{
+  uint32_t h[4], m[4], bits = size * 8;
+  uint8_t tail[32];
+  uint32_t tail_size, len_size, i;
+  int sw = 0;
+
+  h[0] = h[1] = h[2] = h[3] = 0;
+
+#if CFG_BAES_SW == 0
+
+  /* The AES stays enabled for all the steps; with the S/W fallback, the hash
+     runs in S/W if forced or if the AES is in use by another owner */
+#if CFG_BAES_SW_FALLBACK != 0
+  sw = (CFG_BAES_SW_OPERATIONS & BAES_OP_MMO) || !HW_AES_Enable( );
+#else /* CFG_BAES_SW_FALLBACK == 0 */
+  HW_AES_Enable( );
+#endif /* CFG_BAES_SW_FALLBACK == 0 */
+
+#endif /* CFG_BAES_SW == 0 */
+
+  /* All full blocks */
+  for ( ; size >= 16; size -= 16, input += 16 )
+  {
+    memcpy( m, input, 16 );
+    BAES_COPY_REV( m, m );
+    BAES_MmoBlock( h, m, sw );
+  }
+
+  /* Last block(s) with the padding and the length */
+  len_size = (bits < 0x10000UL) ? 2 : 6;
+  tail_size = (size + 1 + len_size <= 16) ? 16 : 32;
+
+  memset( tail, 0, sizeof(tail) );
+  memcpy( tail, input, size );
+  tail[size] = 0x80;
+  if ( len_size == 2 )
+  {
+    tail[tail_size - 2] = (uint8_t)(bits >> 8);
+    tail[tail_size - 1] = (uint8_t)bits;
+  }
+  else
+  {
+    tail[tail_size - 6] = (uint8_t)(bits >> 24);
+    tail[tail_size - 5] = (uint8_t)(bits >> 16);
+    tail[tail_size - 4] = (uint8_t)(bits >> 8);
+    tail[tail_size - 3] = (uint8_t)bits;
+  }
+
+  for ( i = 0; i < tail_size; i += 16 )
+  {
+    memcpy( m, &tail[i], 16 );
+    BAES_COPY_REV( m, m );
+    BAES_MmoBlock( h, m, sw );
+  }
+
+#if CFG_BAES_SW == 0
+
+  if ( !sw )
+    HW_AES_Disable( );
+
+#endif /* CFG_BAES_SW == 0 */
+
+  /* Write the hash */
+  BAES_COPY_REV( h, h );
+  memcpy( output, h, 16 );
+}
+
+/*****************************************************************************/
@@ -0,0 +1,164 @@
+/*****************************************************************************
+ * @file    baes_sw.c
+ *
+ * @brief   This file contains the AES S/W implementation (encryption).
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ *****************************************************************************
+ */
+
+#include "baes_global.h"
+
+#if (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0)
+
+/*****************************************************************************/
+
+/* The 4-word blocks and keys are in big endian words: w[0] holds the bytes
+ * 0 to 3 of the block, byte 0 in the most significant bits. */
+
+static const uint8_t BAES_sbox[256] =
+{
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5,
+  0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0,
+  0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC,
+  0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A,
+  0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0,
+  0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B,
+  0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85,
+  0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5,
+  0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17,
+  0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88,
+  0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C,
+  0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9,
+  0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6,
+  0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E,
+  0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94,
+  0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68,
+  0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const uint8_t BAES_rcon[10] =
+{
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
+};
+
+/*****************************************************************************/
+
+/* Multiplication by 2 in GF(2^8) */
+#define BAES_XTIME( b )      ((uint8_t)(((b) << 1) ^ (((b) & 0x80U) ? 0x1BU : 0)))
+
+/* S-box applied to the 4 bytes of a word */
+#define BAES_SUB_WORD( w )   ( ((uint32_t)BAES_sbox[((w) >> 24) & 0xFFU] << 24) | \
+                               ((uint32_t)BAES_sbox[((w) >> 16) & 0xFFU] << 16) | \
+                               ((uint32_t)BAES_sbox[((w) >>  8) & 0xFFU] <<  8) | \
+                               ((uint32_t)BAES_sbox[((w) >>  0) & 0xFFU] <<  0) )
+
+/*****************************************************************************/
+
+/*
+ * Key expansion: the first 4 words of "p_exp_key" hold the key, the 44
+ * words of the expanded key are written.
+ */
+
+void BAES_EncKeySchedule( uint32_t* p_exp_key )
+{
+  uint32_t i, t;
+
+  for ( i = 4; i < 44; i++ )
+  {
+    t = p_exp_key[i - 1];
+    if ( (i % 4) == 0 )
+    {
+      t = BAES_SUB_WORD( (t << 8) | (t >> 24) ) ^
+          ((uint32_t)BAES_rcon[(i / 4) - 1] << 24);
+    }
+    p_exp_key[i] = p_exp_key[i - 4] ^ t;
+  }
+}
+
+/*****************************************************************************/
+
+/*
+ * Encryption of one block with the expanded key
+ */
+
+void BAES_RawEncrypt( const uint32_t* p_in,
+                      uint32_t* p_out,
+                      const uint32_t *p_exp_key )
+{
+  uint8_t s[16], t[16], a0, a1, a2, a3, x;
+  uint32_t i, c, round;
+
+  /* State (column c = word c) with the first round key */
+  for ( c = 0; c < 4; c++ )
+  {
+    uint32_t w = p_in[c] ^ p_exp_key[c];
+    s[4*c + 0] = (uint8_t)(w >> 24);
+    s[4*c + 1] = (uint8_t)(w >> 16);
+    s[4*c + 2] = (uint8_t)(w >>  8);
+    s[4*c + 3] = (uint8_t)(w >>  0);
+  }
+
+  for ( round = 1; round <= 10; round++ )
+  {
+    /* SubBytes and ShiftRows: row r is rotated by r columns */
+    for ( i = 0; i < 16; i++ )
+    {
+      t[i] = BAES_sbox[s[(i + 4 * (i % 4)) % 16]];
+    }
+
+    /* MixColumns, except in the last round */
+    for ( c = 0; c < 4; c++ )
+    {
+      a0 = t[4*c + 0]; a1 = t[4*c + 1]; a2 = t[4*c + 2]; a3 = t[4*c + 3];
+      if ( round < 10 )
+      {
+        x = a0 ^ a1 ^ a2 ^ a3;
+        t[4*c + 0] = a0 ^ x ^ BAES_XTIME( a0 ^ a1 );
+        t[4*c + 1] = a1 ^ x ^ BAES_XTIME( a1 ^ a2 );
+        t[4*c + 2] = a2 ^ x ^ BAES_XTIME( a2 ^ a3 );
+        t[4*c + 3] = a3 ^ x ^ BAES_XTIME( a3 ^ a0 );
+      }
+
+      /* AddRoundKey */
+      uint32_t k = p_exp_key[4 * round + c];
+      s[4*c + 0] = t[4*c + 0] ^ (uint8_t)(k >> 24);
+      s[4*c + 1] = t[4*c + 1] ^ (uint8_t)(k >> 16);
+      s[4*c + 2] = t[4*c + 2] ^ (uint8_t)(k >>  8);
+      s[4*c + 3] = t[4*c + 3] ^ (uint8_t)(k >>  0);
+    }
+  }
+
+  for ( c = 0; c < 4; c++ )
+  {
+    p_out[c] = ((uint32_t)s[4*c + 0] << 24) | ((uint32_t)s[4*c + 1] << 16) |
+               ((uint32_t)s[4*c + 2] <<  8) | ((uint32_t)s[4*c + 3] <<  0);
+  }
+}
+
+/*****************************************************************************/
+
+#endif /* (CFG_BAES_SW != 0) || (CFG_BAES_SW_FALLBACK != 0) */
@@ -39,13 +39,6 @@ typedef enum FM_BackGround_States
   FM_BKGND_WINDOWED_FLASHOP,
 }FM_BackGround_States_t;
 
-/* Flash operation type */
-typedef enum
-{
-  FM_WRITE_OP,
-  FM_ERASE_OP
-} FM_FlashOp_t;
-
 /**
  * @brief Flash operation configuration struct
  */
@@ -112,10 +105,47 @@ static FM_FlashOpConfig_t fm_flashop_parameters;
  */
 static FM_BackGround_States_t FM_CurrentBackGroundState;
 
+/**
+ * @brief Queues of the flash operations, one per priority class
+ */
+static tListCounted fm_op_queue[FM_PRIORITY_NUMBER];
+
+/**
+ * @brief Statistics of the queues
+ */
+static FM_QueueStats_t fm_queue_stats[FM_PRIORITY_NUMBER];
+
+/**
+ * @brief Time stamp of the time window granted
+ */
+static uint32_t fm_window_timestamp;
+
+/**
+ * @brief Time stamp of the time window request
+ */
+static uint32_t fm_request_timestamp;
+
+/**
+ * @brief Statistics of the time windows, with the estimated flash operation durations used to size them
+ */
+static FM_WindowStats_t fm_window_stats = {
+  .ProgramTime = TIME_PROGRAM_DURATION_INIT,
+  .EraseTime = TIME_WINDOW_ERASE_DURATION
+};
+
 /* Private function prototypes -----------------------------------------------*/
 
 static FM_Cmd_Status_t FM_CheckFlashManagerState(FM_CallbackNode_t *CallbackNode);
+static FM_Cmd_Status_t FM_CheckWriteRequest(uint32_t *Src, uint32_t *Dest, int32_t Size);
+static FM_Cmd_Status_t FM_CheckEraseRequest(uint32_t FirstSect, uint32_t NbrSect);
+static FM_Cmd_Status_t FM_QueueOp(FM_Priority_t Priority, FM_FlashOpNode_t *OpNode);
+static void FM_StartQueuedOp(FM_FlashOpNode_t *OpNode);
+static void FM_ServeQueue(FM_Priority_t Priority);
 static void FM_WindowAllowed_Callback(void);
+static void FM_RequestWindow(void);
+static uint32_t FM_GetTimeStamp(void);
+static uint32_t FM_GetElapsedTime(uint32_t TimeStamp);
+static void FM_UpdateEstimate(uint32_t *p_Estimate, uint32_t Duration);
 
 /* Functions Definition ------------------------------------------------------*/
 
@@ -132,20 +162,8 @@ FM_Cmd_Status_t FM_Write(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_Callbac
 {
   FM_Cmd_Status_t status;
 
-  if (((uint32_t)Dest < FLASH_BASE) || ((uint32_t)Dest > (FLASH_BASE + FLASH_SIZE))
-                                    || (((uint32_t)Dest + Size) > (FLASH_BASE + FLASH_SIZE)))
+  if (FM_CheckWriteRequest(Src, Dest, Size) != FM_OK)
   {
-    LOG_ERROR_SYSTEM("\r\nFM_Write - Destination address not part of the flash");
-
-    /* Destination address not part of the flash */
-    return FM_ERROR;
-  }
-
-  if (((uint32_t) Src & ALIGNMENT_32) || ((uint32_t) Dest & ALIGNMENT_128))
-  {
-    LOG_ERROR_SYSTEM("\r\nFM_Write - Source or destination address not properly aligned");
-
-    /* Source or destination address not properly aligned */
     return FM_ERROR;
   }
 
@@ -183,19 +201,8 @@ FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t
 {
   FM_Cmd_Status_t status;
 
-  if ((FirstSect > FLASH_PAGE_NBR) || ((FirstSect + NbrSect) > FLASH_PAGE_NBR))
-  {
-    LOG_ERROR_SYSTEM("\r\nFM_Erase - Inconsistent request");
-
-    /* Inconsistent request */
-    return FM_ERROR;
-  }
-
-  if (NbrSect == 0)
+  if (FM_CheckEraseRequest(FirstSect, NbrSect) != FM_OK)
   {
-    LOG_ERROR_SYSTEM("\r\nFM_Erase - Inconsistent request");
-
-    /* Inconsistent request */
     return FM_ERROR;
   }
 
@@ -221,6 +228,75 @@ FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t
   return status;
 }
 
+/**
+  * @brief  Queue a Flash Write operation in a priority class
+  * @note   The operation starts at once when the Flash Manager is available. Else it is started once the
+  *         operations of the higher classes and the ones queued before it in its class are done
+  * @param  Src: Address of the data to be stored in FLASH. It shall be 32bits aligned
+  * @param  Dest: Address where the data shall be written. It shall be 128bits aligned
+  * @param  Size: This is the size of data to be written in Flash.
+                  The size is a multiple of 32bits (size = 1 means 32bits)
+  * @param  Priority: Priority class of the operation
+  * @param  OpNode: Node of the operation, not to be reused until its callback is called
+  * @retval FM_Cmd_Status_t: FM_OK when started or queued, FM_QUEUE_FULL or FM_ERROR else
+  */
+FM_Cmd_Status_t FM_QueueWrite(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_Priority_t Priority, FM_FlashOpNode_t *OpNode)
+{
+  if ((OpNode == NULL) || (FM_CheckWriteRequest(Src, Dest, Size) != FM_OK))
+  {
+    return FM_ERROR;
+  }
+
+  OpNode->Type = FM_WRITE_OP;
+  OpNode->Src = Src;
+  OpNode->Dest = Dest;
+  OpNode->Size = Size;
+
+  return FM_QueueOp(Priority, OpNode);
+}
+
+/**
+  * @brief  Queue a Flash Erase operation in a priority class
+  * @param  FirstSect: Index of the first sector to erase
+  * @param  NbrSect: Number of sector to erase
+  * @param  Priority: Priority class of the operation
+  * @param  OpNode: Node of the operation, not to be reused until its callback is called
+  * @retval FM_Cmd_Status_t: FM_OK when started or queued, FM_QUEUE_FULL or FM_ERROR else
+  */
+FM_Cmd_Status_t FM_QueueErase(uint32_t FirstSect, uint32_t NbrSect, FM_Priority_t Priority, FM_FlashOpNode_t *OpNode)
+{
+  if ((OpNode == NULL) || (FM_CheckEraseRequest(FirstSect, NbrSect) != FM_OK))
+  {
+    return FM_ERROR;
+  }
+
+  OpNode->Type = FM_ERASE_OP;
+  OpNode->FirstSect = FirstSect;
+  OpNode->NbrSect = NbrSect;
+
+  return FM_QueueOp(Priority, OpNode);
+}
+
+/**
+  * @brief  Get the statistics of the queue of a priority class
+  * @param  Priority: Priority class
+  * @param  p_Stats: Statistics to fill
+  * @retval None
+  */
+void FM_GetQueueStats (FM_Priority_t Priority, FM_QueueStats_t *p_Stats)
+{
+  if (Priority < FM_PRIORITY_NUMBER)
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+
+    *p_Stats = fm_queue_stats[Priority];
+    p_Stats->Depth = (uint8_t)LST_cnt_get_size(&fm_op_queue[Priority]);
+    p_Stats->MaxDepth = (uint8_t)LST_cnt_get_max_size(&fm_op_queue[Priority]);
+
+    UTILS_EXIT_CRITICAL_SECTION();
+  }
+}
+
 /**
   * @brief  Execute Flash Manager background tasks
   * @param  None
@@ -228,10 +304,13 @@ FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t
   */
 void FM_BackgroundProcess (void)
 {
-  static uint32_t duration;
   bool flashop_complete = false;
   FD_FlashOp_Status_t fdReturnValue = FD_FLASHOP_SUCCESS;
   FM_CallbackNode_t *pCbNode = NULL;
+  uint32_t window_duration;
+  uint32_t op_timestamp;
+  uint32_t op_duration;
+  uint32_t op_count = 0;
 
   switch (FM_CurrentBackGroundState)
   {
@@ -243,9 +322,6 @@ void FM_BackgroundProcess (void)
       {
         LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_NOWINDOW_FLASHOP - Write operation");
 
-        /* Update duration time value */
-        duration = TIME_WINDOW_WRITE_REQUEST;
-
         /* Set the next possible state - App could stop at anytime no window operation */
         FM_CurrentBackGroundState = FM_BKGND_WINDOWED_FLASHOP;
 
@@ -254,11 +330,15 @@ void FM_BackgroundProcess (void)
         while((fm_flashop_parameters.writeSize > 0) &&
               (fdReturnValue == FD_FLASHOP_SUCCESS))
         {
+          op_timestamp = FM_GetTimeStamp();
+
           fdReturnValue = FD_WriteData((uint32_t) fm_flashop_parameters.writeDest,
                                        (uint32_t) fm_flashop_parameters.writeSrc);
 
           if (fdReturnValue == FD_FLASHOP_SUCCESS)
           {
+            FM_UpdateEstimate(&fm_window_stats.ProgramTime, FM_GetElapsedTime(op_timestamp));
+
             fm_flashop_parameters.writeDest += FLASH_WRITE_BLOCK_SIZE;
             fm_flashop_parameters.writeSrc += FLASH_WRITE_BLOCK_SIZE;
             fm_flashop_parameters.writeSize -= FLASH_WRITE_BLOCK_SIZE;
@@ -277,9 +357,6 @@ void FM_BackgroundProcess (void)
       {
         LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_NOWINDOW_FLASHOP - Erase operation");
 
-        /* Update duration time value */
-        duration = TIME_WINDOW_ERASE_REQUEST;
-
         /* Set the next possible state */
         FM_CurrentBackGroundState = FM_BKGND_WINDOWED_FLASHOP;
 
@@ -288,10 +365,14 @@ void FM_BackgroundProcess (void)
         while((fm_flashop_parameters.eraseNbrSect > 0) &&
               (fdReturnValue == FD_FLASHOP_SUCCESS))
         {
+          op_timestamp = FM_GetTimeStamp();
+
           fdReturnValue = FD_EraseSectors(fm_flashop_parameters.eraseFirstSect);
 
           if (fdReturnValue == FD_FLASHOP_SUCCESS)
           {
+            FM_UpdateEstimate(&fm_window_stats.EraseTime, FM_GetElapsedTime(op_timestamp));
+
             fm_flashop_parameters.eraseNbrSect--;
             fm_flashop_parameters.eraseFirstSect++;
           }
@@ -316,12 +397,27 @@ void FM_BackgroundProcess (void)
         LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_WINDOWED_FLASHOP - No time window granted yet, request one");
 
         /* No time window granted yet, request one */
-        RFTS_ReqWindow(duration, &FM_WindowAllowed_Callback);
+        FM_RequestWindow();
       }
       else
       {
         LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_WINDOWED_FLASHOP - Time window granted");
 
+        /* Time of the window left for the flash operations */
+        window_duration = RFTS_GetWindowDuration();
+
+        fm_window_stats.WindowCount++;
+        fm_window_stats.GrantedTime += window_duration;
+
+        if (window_duration > TIME_WINDOW_MARGIN)
+        {
+          window_duration -= TIME_WINDOW_MARGIN;
+        }
+        else
+        {
+          window_duration = 0;
+        }
+
         if (fm_flashop == FM_WRITE_OP)
         {
           /* Flash Write operation */
@@ -329,13 +425,30 @@ void FM_BackgroundProcess (void)
 
           HAL_FLASH_Unlock();
 
+          /* Program as many quad-words as fit in the window, the first one is always tried */
           while((fm_flashop_parameters.writeSize > 0) &&
-                (FD_WriteData((uint32_t) fm_flashop_parameters.writeDest,
-                              (uint32_t) fm_flashop_parameters.writeSrc) == FD_FLASHOP_SUCCESS))
+                (fdReturnValue == FD_FLASHOP_SUCCESS) &&
+                ((op_count == 0) ||
+                 ((FM_GetElapsedTime(fm_window_timestamp) + fm_window_stats.ProgramTime) <= window_duration)))
           {
+            op_timestamp = FM_GetTimeStamp();
+
+            fdReturnValue = FD_WriteData((uint32_t) fm_flashop_parameters.writeDest,
+                                         (uint32_t) fm_flashop_parameters.writeSrc);
+
+            if (fdReturnValue == FD_FLASHOP_SUCCESS)
+            {
+              op_duration = FM_GetElapsedTime(op_timestamp);
+              FM_UpdateEstimate(&fm_window_stats.ProgramTime, op_duration);
+
+              fm_window_stats.UsedTime += op_duration;
+              fm_window_stats.QuadWords++;
+              op_count++;
+
               fm_flashop_parameters.writeDest += FLASH_WRITE_BLOCK_SIZE;
               fm_flashop_parameters.writeSrc += FLASH_WRITE_BLOCK_SIZE;
               fm_flashop_parameters.writeSize -= FLASH_WRITE_BLOCK_SIZE;
+            }
           }
 
           if (fm_flashop_parameters.writeSize <= 0)
@@ -343,30 +456,46 @@ void FM_BackgroundProcess (void)
             flashop_complete = true;
           }
 
-      HAL_FLASH_Lock();
+          HAL_FLASH_Lock();
+        }
+        else
+        {
+          /* Flash Erase operation */
+          LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_WINDOWED_FLASHOP - Erase operation");
 
-    }
-    else
-    {
-      /* Flash Erase operation */
-      LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Case FM_BKGND_WINDOWED_FLASHOP - Erase operation");
+          HAL_FLASH_Unlock();
 
-      HAL_FLASH_Unlock();
+          /* Erase as many sectors as fit in the window, the first one is always tried */
+          while((fm_flashop_parameters.eraseNbrSect > 0) &&
+                (fdReturnValue == FD_FLASHOP_SUCCESS) &&
+                ((op_count == 0) ||
+                 ((FM_GetElapsedTime(fm_window_timestamp) + fm_window_stats.EraseTime) <= window_duration)))
+          {
+            op_timestamp = FM_GetTimeStamp();
 
-      /* Erase only one sector in a single time window */
-      if (FD_EraseSectors(fm_flashop_parameters.eraseFirstSect) == FD_FLASHOP_SUCCESS)
-      {
-        fm_flashop_parameters.eraseNbrSect--;
-        fm_flashop_parameters.eraseFirstSect++;
-      }
+            fdReturnValue = FD_EraseSectors(fm_flashop_parameters.eraseFirstSect);
 
-      if (fm_flashop_parameters.eraseNbrSect == 0)
-      {
-        flashop_complete = true;
-      }
+            if (fdReturnValue == FD_FLASHOP_SUCCESS)
+            {
+              op_duration = FM_GetElapsedTime(op_timestamp);
+              FM_UpdateEstimate(&fm_window_stats.EraseTime, op_duration);
 
-      HAL_FLASH_Lock();
-    }
+              fm_window_stats.UsedTime += op_duration;
+              fm_window_stats.Sectors++;
+              op_count++;
+
+              fm_flashop_parameters.eraseNbrSect--;
+              fm_flashop_parameters.eraseFirstSect++;
+            }
+          }
+
+          if (fm_flashop_parameters.eraseNbrSect == 0)
+          {
+            flashop_complete = true;
+          }
+
+          HAL_FLASH_Lock();
+        }
 
         /* Release the time window */
         RFTS_RelWindow();
@@ -403,6 +532,9 @@ void FM_BackgroundProcess (void)
       fm_running_cb(FM_OPERATION_COMPLETE);
     }
 
+    /* NVM commits first */
+    FM_ServeQueue(FM_PRIORITY_NVM);
+
     /* notify pending requesters */
     while((LST_is_empty (&fm_cb_pending_list) == false) &&
           (busy_flash_sem == false) && (flash_manager_busy == false))
@@ -410,6 +542,12 @@ void FM_BackgroundProcess (void)
       LST_remove_head (&fm_cb_pending_list, (tListNode**)&pCbNode);
       pCbNode->Callback(FM_OPERATION_AVAILABLE);
     }
+
+    /* Then the lower priority classes */
+    for (uint8_t priority = (uint8_t)FM_PRIORITY_OTA; priority < (uint8_t)FM_PRIORITY_NUMBER; priority++)
+    {
+      FM_ServeQueue((FM_Priority_t)priority);
+    }
   }
   else
   {
@@ -417,10 +555,24 @@ void FM_BackgroundProcess (void)
     LOG_DEBUG_SYSTEM("\r\nFM_BackgroundProcess - Flash operation not complete yet, request a new time window");
 
     /* Request a new time window */
-    RFTS_ReqWindow(duration, &FM_WindowAllowed_Callback);
+    FM_RequestWindow();
   }
 }
 
+/**
+  * @brief  Get the statistics of the time windows used by the Flash Manager
+  * @param  p_Stats: Statistics to fill
+  * @retval None
+  */
+void FM_GetWindowStats (FM_WindowStats_t *p_Stats)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  *p_Stats = fm_window_stats;
+
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
 /**
   * @brief  Check if the Flash Manager is busy or available
   * @param  CallbackNode: Pointer to the callback node for storage in list
@@ -438,6 +590,10 @@ static FM_Cmd_Status_t FM_CheckFlashManagerState(FM_CallbackNode_t *CallbackNode
   if (fm_cb_pending_list_init == false)
   {
     LST_init_head(&fm_cb_pending_list);
+    for (uint8_t priority = 0; priority < (uint8_t)FM_PRIORITY_NUMBER; priority++)
+    {
+      LST_cnt_init(&fm_op_queue[priority]);
+    }
     fm_cb_pending_list_init = true;
   }
   /* Check if semaphore on flash is available */
@@ -496,6 +652,177 @@ static FM_Cmd_Status_t FM_CheckFlashManagerState(FM_CallbackNode_t *CallbackNode
   return status;
 }
 
+/**
+  * @brief  Check the parameters of a Flash Write operation
+  * @param  Src: Address of the data to be stored in FLASH
+  * @param  Dest: Address where the data shall be written
+  * @param  Size: Size of data to be written in 32bits words
+  * @retval FM_Cmd_Status_t: FM_OK or FM_ERROR
+  */
+static FM_Cmd_Status_t FM_CheckWriteRequest(uint32_t *Src, uint32_t *Dest, int32_t Size)
+{
+  if (((uint32_t)Dest < FLASH_BASE) || ((uint32_t)Dest > (FLASH_BASE + FLASH_SIZE))
+                                    || (((uint32_t)Dest + Size) > (FLASH_BASE + FLASH_SIZE)))
+  {
+    LOG_ERROR_SYSTEM("\r\nFM_Write - Destination address not part of the flash");
+
+    /* Destination address not part of the flash */
+    return FM_ERROR;
+  }
+
+  if (((uint32_t) Src & ALIGNMENT_32) || ((uint32_t) Dest & ALIGNMENT_128))
+  {
+    LOG_ERROR_SYSTEM("\r\nFM_Write - Source or destination address not properly aligned");
+
+    /* Source or destination address not properly aligned */
+    return FM_ERROR;
+  }
+
+  return FM_OK;
+}
+
+/**
+  * @brief  Check the parameters of a Flash Erase operation
+  * @param  FirstSect: Index of the first sector to erase
+  * @param  NbrSect: Number of sector to erase
+  * @retval FM_Cmd_Status_t: FM_OK or FM_ERROR
+  */
+static FM_Cmd_Status_t FM_CheckEraseRequest(uint32_t FirstSect, uint32_t NbrSect)
+{
+  if ((FirstSect > FLASH_PAGE_NBR) || ((FirstSect + NbrSect) > FLASH_PAGE_NBR))
+  {
+    LOG_ERROR_SYSTEM("\r\nFM_Erase - Inconsistent request");
+
+    /* Inconsistent request */
+    return FM_ERROR;
+  }
+
+  if (NbrSect == 0)
+  {
+    LOG_ERROR_SYSTEM("\r\nFM_Erase - Inconsistent request");
+
+    /* Inconsistent request */
+    return FM_ERROR;
+  }
+
+  return FM_OK;
+}
+
+/**
+  * @brief  Start a queued operation when the Flash Manager is available, else queue it
+  * @param  Priority: Priority class of the operation
+  * @param  OpNode: Node of the operation
+  * @retval FM_Cmd_Status_t: FM_OK, FM_QUEUE_FULL or FM_ERROR
+  */
+static FM_Cmd_Status_t FM_QueueOp(FM_Priority_t Priority, FM_FlashOpNode_t *OpNode)
+{
+  FM_Cmd_Status_t status = FM_OK;
+
+  if (Priority >= FM_PRIORITY_NUMBER)
+  {
+    return FM_ERROR;
+  }
+
+  /* Operations of the class already waiting are served first */
+  if ((fm_cb_pending_list_init != false) && (LST_cnt_is_empty(&fm_op_queue[Priority]) == false))
+  {
+    status = FM_BUSY;
+  }
+  else
+  {
+    status = FM_CheckFlashManagerState(NULL);
+  }
+
+  if (status == FM_OK)
+  { /* Flash manager is available */
+    fm_queue_stats[Priority].Queued++;
+
+    FM_StartQueuedOp(OpNode);
+  }
+  else
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+
+    if (LST_cnt_get_size(&fm_op_queue[Priority]) < FM_QUEUE_DEPTH)
+    {
+      LST_cnt_insert_tail(&fm_op_queue[Priority], &(OpNode->NodeList));
+
+      fm_queue_stats[Priority].Queued++;
+
+      status = FM_OK;
+    }
+    else
+    {
+      fm_queue_stats[Priority].Rejected++;
+
+      status = FM_QUEUE_FULL;
+    }
+
+    UTILS_EXIT_CRITICAL_SECTION();
+  }
+
+  LOG_DEBUG_SYSTEM("\r\nFM_QueueOp - Class %d - Returned value : %d", Priority, status);
+
+  return status;
+}
+
+/**
+  * @brief  Start a queued operation, the Flash Manager being reserved
+  * @param  OpNode: Node of the operation
+  * @retval None
+  */
+static void FM_StartQueuedOp(FM_FlashOpNode_t *OpNode)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  fm_running_cb = OpNode->Callback;
+
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if (OpNode->Type == FM_WRITE_OP)
+  {
+    fm_flashop_parameters.writeSrc = OpNode->Src;
+    fm_flashop_parameters.writeDest = OpNode->Dest;
+    fm_flashop_parameters.writeSize = OpNode->Size;
+  }
+  else
+  {
+    fm_flashop_parameters.eraseFirstSect = OpNode->FirstSect;
+    fm_flashop_parameters.eraseNbrSect = OpNode->NbrSect;
+  }
+
+  fm_flashop = OpNode->Type;
+
+  FM_CurrentBackGroundState = FM_BKGND_NOWINDOW_FLASHOP;
+
+  /* Window request to be executed in background */
+  FM_ProcessRequest();
+}
+
+/**
+  * @brief  Start the oldest operation of a priority class when the Flash Manager is available
+  * @param  Priority: Priority class to serve
+  * @retval None
+  */
+static void FM_ServeQueue(FM_Priority_t Priority)
+{
+  FM_FlashOpNode_t *pOpNode = NULL;
+
+  if (LST_cnt_is_empty(&fm_op_queue[Priority]) == false)
+  {
+    if (FM_CheckFlashManagerState(NULL) == FM_OK)
+    {
+      UTILS_ENTER_CRITICAL_SECTION();
+
+      LST_cnt_remove_head(&fm_op_queue[Priority], (tListNode**)&pOpNode);
+
+      UTILS_EXIT_CRITICAL_SECTION();
+
+      FM_StartQueuedOp(pOpNode);
+    }
+  }
+}
+
 /**
   * @brief  Callback called by RF Timing Synchro module when a time window is available
   * @param  None
@@ -503,6 +830,17 @@ static FM_Cmd_Status_t FM_CheckFlashManagerState(FM_CallbackNode_t *CallbackNode
   */
 static void FM_WindowAllowed_Callback(void)
 {
+  uint32_t wait_time;
+
+  fm_window_timestamp = FM_GetTimeStamp();
+
+  wait_time = FM_GetElapsedTime(fm_request_timestamp);
+  fm_window_stats.WaitTime += wait_time;
+  if (wait_time > fm_window_stats.MaxWaitTime)
+  {
+    fm_window_stats.MaxWaitTime = wait_time;
+  }
+
   fm_window_granted = true;
 
   LOG_DEBUG_SYSTEM("\r\nFM_WindowAllowed_Callback");
@@ -510,3 +848,101 @@ static void FM_WindowAllowed_Callback(void)
   /* Flash operation to be executed in background */
   FM_ProcessRequest();
 }
+
+/**
+  * @brief  Request a time window sized for the flash operation still to be done
+  * @note   The minimum duration fits at least one quad-word program or one sector erase, the
+  *         Link Layer may grant up to the time estimated for the whole operation
+  * @param  None
+  * @retval None
+  */
+static void FM_RequestWindow(void)
+{
+  uint32_t duration_min;
+  uint32_t duration_max;
+
+  if (fm_flashop == FM_WRITE_OP)
+  {
+    duration_max = (((uint32_t) fm_flashop_parameters.writeSize + FLASH_WRITE_BLOCK_SIZE - 1U) / FLASH_WRITE_BLOCK_SIZE) *
+                   fm_window_stats.ProgramTime;
+
+    if (duration_max > TIME_WINDOW_WRITE_MAX_DURATION)
+    {
+      duration_max = TIME_WINDOW_WRITE_MAX_DURATION;
+    }
+
+    /* Not below the fixed duration : the window overrun timer has a 1 ms resolution */
+    duration_min = TIME_WINDOW_WRITE_DURATION;
+    if (duration_min < fm_window_stats.ProgramTime)
+    {
+      duration_min = fm_window_stats.ProgramTime;
+    }
+  }
+  else
+  {
+    duration_max = fm_flashop_parameters.eraseNbrSect * fm_window_stats.EraseTime;
+
+    if (duration_max > TIME_WINDOW_ERASE_MAX_DURATION)
+    {
+      duration_max = TIME_WINDOW_ERASE_MAX_DURATION;
+    }
+
+    duration_min = fm_window_stats.EraseTime;
+  }
+
+  if (duration_max < duration_min)
+  {
+    duration_max = duration_min;
+  }
+
+  fm_request_timestamp = FM_GetTimeStamp();
+
+  RFTS_ReqWindowRange((duration_min + TIME_WINDOW_MARGIN),
+                      (duration_max + TIME_WINDOW_MARGIN),
+                      &FM_WindowAllowed_Callback);
+}
+
+/**
+  * @brief  Get a time stamp from the DWT cycle counter, started if needed
+  * @param  None
+  * @retval Time stamp in CPU cycles
+  */
+static uint32_t FM_GetTimeStamp(void)
+{
+  if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+  {
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  return DWT->CYCCNT;
+}
+
+/**
+  * @brief  Get the time elapsed since a time stamp
+  * @param  TimeStamp: Time stamp returned by FM_GetTimeStamp
+  * @retval Time elapsed in us
+  */
+static uint32_t FM_GetElapsedTime(uint32_t TimeStamp)
+{
+  return ((DWT->CYCCNT - TimeStamp) / (SystemCoreClock / 1000000U));
+}
+
+/**
+  * @brief  Update the estimated duration of a flash operation with a new measure
+  * @note   A longer measure is taken at once, a shorter one lowers the estimate slowly
+  * @param  p_Estimate: Estimated duration in us to update
+  * @param  Duration: Measured duration in us
+  * @retval None
+  */
+static void FM_UpdateEstimate(uint32_t *p_Estimate, uint32_t Duration)
+{
+  if (Duration >= *p_Estimate)
+  {
+    *p_Estimate = Duration;
+  }
+  else
+  {
+    *p_Estimate -= ((*p_Estimate - Duration) / 8U);
+  }
+}
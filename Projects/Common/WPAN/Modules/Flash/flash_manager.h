@@ -35,7 +35,8 @@ typedef enum
 {
   FM_OK,    /* The Flash Manager is available and a window request is scheduled */
   FM_BUSY,  /* The Flash Manager is busy and the caller will be called back when it is available */
-  FM_ERROR  /* An error occurred while processing the command */
+  FM_ERROR,      /* An error occurred while processing the command */
+  FM_QUEUE_FULL  /* The queue of the priority class is full, the operation is not queued */
 } FM_Cmd_Status_t;
 
 /* Flash operation status */
@@ -45,6 +46,22 @@ typedef enum
   FM_OPERATION_AVAILABLE  /* A flash operation can be requested */
 } FM_FlashOp_Status_t;
 
+/* Flash operation type */
+typedef enum
+{
+  FM_WRITE_OP,
+  FM_ERASE_OP
+} FM_FlashOp_t;
+
+/* Priority classes of the queued flash operations, the first one is served first */
+typedef enum
+{
+  FM_PRIORITY_NVM,     /* NVM commits - The direct FM_Write/FM_Erase requests are served with this class */
+  FM_PRIORITY_OTA,     /* OTA image writes */
+  FM_PRIORITY_LOG,     /* Logging */
+  FM_PRIORITY_NUMBER
+} FM_Priority_t;
+
 /**
  * @brief  Flash Manager callback node type to store them in a chained list
  */
@@ -54,6 +71,48 @@ typedef struct FM_CallbackNode
   void (*Callback)(FM_FlashOp_Status_t Status);  /* Callback function pointer for Flash Manager caller */
 }FM_CallbackNode_t;
 
+/**
+ * @brief  Queued flash operation, owned by the caller until its callback is called
+ */
+typedef struct FM_FlashOpNode
+{
+  tListNode NodeList;  /* Next and previous nodes in the queue */
+  FM_FlashOp_t Type;   /* Write or erase */
+  uint32_t *Src;       /* Write source */
+  uint32_t *Dest;      /* Write destination */
+  int32_t Size;        /* Write size in 32 bits words */
+  uint32_t FirstSect;  /* First sector to erase */
+  uint32_t NbrSect;    /* Number of sectors to erase */
+  void (*Callback)(FM_FlashOp_Status_t Status);  /* Called with FM_OPERATION_COMPLETE once done - Can be NULL */
+}FM_FlashOpNode_t;
+
+/**
+ * @brief  Statistics of the queue of a priority class
+ */
+typedef struct FM_QueueStats
+{
+  uint32_t Queued;     /* Operations queued */
+  uint32_t Rejected;   /* Operations refused on full queue */
+  uint8_t  Depth;      /* Operations waiting in the queue */
+  uint8_t  MaxDepth;   /* Maximum operations waiting in the queue */
+}FM_QueueStats_t;
+
+/**
+ * @brief  Statistics of the time windows used by the Flash Manager
+ */
+typedef struct FM_WindowStats
+{
+  uint32_t WindowCount;   /* Time windows granted */
+  uint32_t GrantedTime;   /* Sum of the durations in us of the time windows granted */
+  uint32_t UsedTime;      /* Sum of the durations in us of the flash operations done in the time windows */
+  uint32_t QuadWords;     /* Quad-words programmed in the time windows */
+  uint32_t Sectors;       /* Sectors erased in the time windows */
+  uint32_t ProgramTime;   /* Estimated duration in us of a quad-word program */
+  uint32_t EraseTime;     /* Estimated duration in us of a sector erase */
+  uint32_t WaitTime;      /* Sum of the durations in us between the time window requests and their grant */
+  uint32_t MaxWaitTime;   /* Longest duration in us between a time window request and its grant */
+}FM_WindowStats_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 #define TIME_WINDOW_ERASE_DURATION 4000U  /* Duration in us of the time window requested for Flash Erase */
@@ -63,6 +122,14 @@ typedef struct FM_CallbackNode
 #define TIME_WINDOW_ERASE_REQUEST  (TIME_WINDOW_ERASE_DURATION + TIME_WINDOW_MARGIN)
 #define TIME_WINDOW_WRITE_REQUEST  (TIME_WINDOW_WRITE_DURATION + TIME_WINDOW_MARGIN)
 
+/* The window requested is sized from the measured durations of the flash operations still to be done.
+ * The Link Layer can grant up to the maximum duration according to its schedule, the minimum stays the fixed one */
+#define TIME_WINDOW_WRITE_MAX_DURATION  8000U  /* Maximum duration in us of the time window used for Flash Write */
+#define TIME_WINDOW_ERASE_MAX_DURATION  8000U  /* Maximum duration in us of the time window used for Flash Erase */
+#define TIME_PROGRAM_DURATION_INIT      100U   /* Estimated duration in us of a quad-word program before any measure */
+
+#define FM_QUEUE_DEPTH  4U  /* Maximum operations waiting in the queue of each priority class */
+
 /* Exported variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
@@ -70,6 +137,10 @@ FM_Cmd_Status_t FM_Write(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_Callbac
 FM_Cmd_Status_t FM_Erase(uint32_t FirstSect, uint32_t NbrSect, FM_CallbackNode_t *CallbackNode);
 void FM_BackgroundProcess (void);
 void FM_ProcessRequest (void);
+void FM_GetWindowStats (FM_WindowStats_t *p_Stats);
+FM_Cmd_Status_t FM_QueueWrite(uint32_t *Src, uint32_t *Dest, int32_t Size, FM_Priority_t Priority, FM_FlashOpNode_t *OpNode);
+FM_Cmd_Status_t FM_QueueErase(uint32_t FirstSect, uint32_t NbrSect, FM_Priority_t Priority, FM_FlashOpNode_t *OpNode);
+void FM_GetQueueStats (FM_Priority_t Priority, FM_QueueStats_t *p_Stats);
 
 #ifdef __cplusplus
 }
@@ -58,6 +58,16 @@ static UTIL_TIMER_Object_t rfts_timer;
   */
 static ext_evnt_hndl_t ext_event_handler;
 
+/**
+  * @brief Minimum duration in us of the time window requested
+  */
+static uint32_t rfts_window_req_duration;
+
+/**
+  * @brief Duration in us of the time window granted by the Firmware Link Layer
+  */
+static uint32_t rfts_window_duration;
+
 /* Private function prototypes -----------------------------------------------*/
 
 static void RFTS_WindowAllowed_Callback(void);
@@ -74,6 +84,18 @@ static uint32_t event_started_callback(ext_evnt_hndl_t evnt_hndl, uint32_t slot_
   * @retval RFTS_Cmd_Status_t: Success or failure of the window request
   */
 RFTS_Cmd_Status_t RFTS_ReqWindow(uint32_t Duration, void (*Callback)(void))
+{
+  return RFTS_ReqWindowRange(Duration, 0, Callback);
+}
+
+/**
+  * @brief  Request a time window to the Firmware Link Layer, which may grant a longer one according to its schedule
+  * @param  DurationMin: Minimum duration in us of the time window requested
+  * @param  DurationMax: Maximum duration in us of the time window that can be used, 0 for no extension
+  * @param  Callback: Callback to be called when time window is allocated
+  * @retval RFTS_Cmd_Status_t: Success or failure of the window request
+  */
+RFTS_Cmd_Status_t RFTS_ReqWindowRange(uint32_t DurationMin, uint32_t DurationMax, void (*Callback)(void))
 {
 #if (DISABLE_RFTS_EXT_EVNT_HNDLR == 0u)
   extrnl_evnt_st_t extrnl_evnt_config;
@@ -102,13 +124,14 @@ RFTS_Cmd_Status_t RFTS_ReqWindow(uint32_t Duration, void (*Callback)(void))
 
   /* Register requester's callback */
   req_callback = Callback;
+  rfts_window_req_duration = DurationMin;
 
   /* Submit request to Firmware Link Layer */
   extrnl_evnt_config.deadline = 0;
   extrnl_evnt_config.strt_min = 0;
   extrnl_evnt_config.strt_max = 0;
-  extrnl_evnt_config.durn_min = Duration;
-  extrnl_evnt_config.durn_max = 0;
+  extrnl_evnt_config.durn_min = DurationMin;
+  extrnl_evnt_config.durn_max = DurationMax;
   extrnl_evnt_config.prdc_intrvl = 0;
   extrnl_evnt_config.priority = PRIORITY_DEFAULT;
   extrnl_evnt_config.blocked = STATE_NOT_BLOCKED;
@@ -118,7 +141,7 @@ RFTS_Cmd_Status_t RFTS_ReqWindow(uint32_t Duration, void (*Callback)(void))
   extrnl_evnt_config.evnt_abortd_cbk = NULL;
 
   UTIL_TIMER_Create(&rfts_timer,
-                    (Duration/1000),
+                    (DurationMin/1000),
                     UTIL_TIMER_ONESHOT,
                     &RFTS_Timeout_Callback,
                     NULL);
@@ -137,6 +160,20 @@ RFTS_Cmd_Status_t RFTS_ReqWindow(uint32_t Duration, void (*Callback)(void))
   return RFTS_CMD_OK;
 }
 
+/**
+  * @brief  Get the duration of the time window granted
+  * @param  None
+  * @retval Duration in us of the time window, at least the minimum duration requested
+  */
+uint32_t RFTS_GetWindowDuration(void)
+{
+#if (DISABLE_RFTS_EXT_EVNT_HNDLR == 0u)
+  return rfts_window_duration;
+#else
+  return 0;
+#endif /* (DISABLE_RFTS_EXT_EVNT_HNDLR == 0u) */
+}
+
 /**
   * @brief  Execute necessary tasks to allow the time window to be released
   * @param  None
@@ -185,6 +222,9 @@ static void RFTS_WindowAllowed_Callback(void)
   /* Allow flash operation */
   FD_SetStatus(FD_FLASHACCESS_RFTS, LL_FLASH_ENABLE);
 
+  /* Window overrun control on the duration granted */
+  UTIL_TIMER_SetPeriod(&rfts_timer, (rfts_window_duration/1000));
+
   /* Start timer preventing window overrun */
   UTIL_TIMER_Start(&rfts_timer);
 
@@ -210,6 +250,16 @@ static void RFTS_Timeout_Callback(void* Argument)
 
 static uint32_t event_started_callback(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void* priv_data_ptr)
 {
+  /* The slot granted by the Firmware Link Layer may be longer than the one requested */
+  if (slot_durn > rfts_window_req_duration)
+  {
+    rfts_window_duration = slot_durn;
+  }
+  else
+  {
+    rfts_window_duration = rfts_window_req_duration;
+  }
+
   RFTS_WindowAllowed_Callback();
   return 0;
 }
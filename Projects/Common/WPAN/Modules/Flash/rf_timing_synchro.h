@@ -45,6 +45,8 @@ typedef enum
 
 /* Exported functions prototypes ---------------------------------------------*/
 RFTS_Cmd_Status_t RFTS_ReqWindow(uint32_t Duration, void (*Callback)(void));
+RFTS_Cmd_Status_t RFTS_ReqWindowRange(uint32_t DurationMin, uint32_t DurationMax, void (*Callback)(void));
+uint32_t RFTS_GetWindowDuration(void);
 RFTS_Cmd_Status_t RFTS_RelWindow(void);
 
 #ifdef __cplusplus
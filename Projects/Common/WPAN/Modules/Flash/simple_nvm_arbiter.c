@@ -57,11 +57,21 @@ extern void Error_Handler(void);
 /* Flash memory erased content */
 #define SNVMA_ERASED_CONTENT  0xFFFFu
 
+/* Marker of the bank summary - "SNVS" */
+#define SNVMA_SUMMARY_MAGIC   0x534E5653u
+
 /* Private macros ------------------------------------------------------------*/
 /* Align an address on a 128 bits boundary */
 #define SNVMA_ALIGN_128(p_Addr)  \
   ((p_Addr + SNVMA_MASK_ALIGNMENT_128) & ~SNVMA_MASK_ALIGNMENT_128)
 
+/* NVMs with requests to write, except the ones held by their coalescing window */
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+#define SNVMA_RELEASED_BITMASK()  (SNVMA_IdBitmask & ~SNVMA_HoldBitmask)
+#else /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+#define SNVMA_RELEASED_BITMASK()  (SNVMA_IdBitmask)
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
 /* Private typedef -----------------------------------------------------------*/
 
 /* Flash operation steps */
@@ -69,6 +79,7 @@ typedef enum SNVMA_FlashOpSteps
 {
   SNVMA_HEADER_WRITE,
   SNVMA_BUFFER_WRITE,
+  SNVMA_SUMMARY_WRITE,
   SNVMA_ERASE_BANK,
   SNVMA_RETRY_WRITE
 }SNVMA_FlashOpSteps_t;
@@ -111,6 +122,19 @@ typedef __PACKED_STRUCT __ALIGNED(16) SNVMA_BankHeader
   uint16_t SizeId4;
 }SNVMA_BankHeader_t;
 
+/* Bank summary - Last 128 bits of the bank, written once the bank is written and its CRC checked */
+typedef __PACKED_STRUCT __ALIGNED(16) SNVMA_BankSummary
+{
+  /* Marker of a complete bank - SNVMA_SUMMARY_MAGIC */
+  uint32_t Magic;
+  /* Bank counter - Same as the bank header */
+  uint32_t Counter;
+  /* Integrity check - Same as the bank header */
+  uint32_t Crc;
+  /* Check value - Inverse of the XOR of the three first words */
+  uint32_t Check;
+}SNVMA_BankSummary_t;
+
 /* Private variables ---------------------------------------------------------*/
 /* Flag for module initialization */
 static uint8_t SNVMA_ModuleInit = FALSE;
@@ -121,9 +145,29 @@ static uint8_t SNVMA_CommandPending = FALSE;
 /* Bitmask for write operation */
 static uint32_t SNVMA_IdBitmask = 0x00000000;
 
+/* Bitmask of the NVMs whose restore bank is trusted from its summary, its CRC is not checked yet */
+static uint32_t SNVMA_CrcCheckBitmask = 0x00000000;
+
 /* Bank header for write operation */
 static SNVMA_BankHeader_t SNVMA_WriteBankHeader;
 
+/* Bank summary for write operation */
+static SNVMA_BankSummary_t SNVMA_WriteBankSummary;
+
+/* Flag for an error of the CRC streamed during the write operation */
+static uint8_t SNVMA_CrcStreamError = FALSE;
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+/* Bitmask of the NVMs whose coalescing window is open, their write requests are merged until the window is over */
+static uint32_t SNVMA_HoldBitmask = 0x00000000;
+
+/* Tick of the first request of the coalescing window of each NVM */
+static uint32_t SNVMA_CoalescingStart[SNVMA_NVM_NUMBER];
+
+/* Tick of the end of the coalescing window of each NVM */
+static uint32_t SNVMA_CoalescingEnd[SNVMA_NVM_NUMBER];
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
 /* Callback struct for Flash manager */
 static FM_CallbackNode_t SNVMA_FlashCallback;
 
@@ -169,6 +213,53 @@ static inline uint8_t IsHeaderOk (const uint32_t * const p_BankStartAddress, con
  */
 static inline uint8_t IsCrcOk (const uint32_t * const p_BankStartAddress);
 
+/**
+ * @brief Feed the CRC with a buffer just written in the write bank
+ *
+ * @details The CRC is fed in background (DMA) while the next buffer is written, the buffers being written in the
+ *          order of the header CRC. The previous buffer shall be over first.
+ *
+ * @param NvmId: Id of the NVM in use
+ * @param BufferId: Index of the buffer written
+ * @param First: TRUE for the first buffer written in the bank
+ *
+ * @return None
+ */
+static inline void StreamBufferCrc (const uint8_t NvmId, const uint8_t BufferId, const uint8_t First);
+
+/**
+ * @brief Verify the integrity of the write bank from the CRC streamed by StreamBufferCrc
+ *
+ * @return State of the CRC
+ * @retval TRUE: CRC is OK
+ * @retval FALSE: CRC is NOK
+ */
+static inline uint8_t IsStreamedCrcOk (void);
+
+/**
+ * @brief Verify that a bank is sealed by its summary, matching its header
+ *
+ * @details The summary is written once the bank is written and its CRC checked
+ *
+ * @param p_BankStartAddress: Start address of the bank
+ * @param NvmId: Id of the NVM of the bank
+ *
+ * @return State of the summary
+ * @retval TRUE: Summary is OK, the bank can be trusted without its CRC
+ * @retval FALSE: No summary or summary is NOK
+ */
+static inline uint8_t IsSummaryOk (const uint32_t * const p_BankStartAddress, const uint8_t NvmId);
+
+/**
+ * @brief Get the summary address of a bank
+ *
+ * @param p_BankStartAddress: Start address of the bank
+ * @param NvmId: Id of the NVM of the bank
+ *
+ * @return Address of the summary, the last 128 bits of the bank
+ */
+static inline SNVMA_BankSummary_t * GetBankSummary (const uint32_t * const p_BankStartAddress, const uint8_t NvmId);
+
 /**
  * @brief Verify that the source and the destination content are the same
  *
@@ -214,6 +305,65 @@ static inline uint8_t EraseSector (const uint32_t SectorId, const uint32_t Secto
  */
 static inline FM_Cmd_Status_t StartFlashWrite (const uint8_t NvmId);
 
+#if (SNVMA_WRITE_SKIP_UNCHANGED != 0u)
+/**
+ * @brief Check if the registered buffers are the same as the ones of the restore bank
+ *
+ * @param NvmId: Id of the NVM in use
+ *
+ * @return Result of the comparison
+ * @retval TRUE: Same buffer configuration and content, the bank does not need to be written
+ * @retval FALSE: The bank shall be written
+ */
+static inline uint8_t IsBankUnchanged (const uint8_t NvmId);
+#endif /* (SNVMA_WRITE_SKIP_UNCHANGED != 0u) */
+
+/**
+ * @brief Start the write of the pending requests of a NVM
+ *
+ * @param NvmId: Id of the NVM in use
+ * @param Notify: TRUE when the requesters have already been answered, a failure is then notified through their callbacks
+ *
+ * @return Status of the command
+ */
+static inline SNVMA_Cmd_Status_t StartPendingWrite (const uint8_t NvmId, const uint8_t Notify);
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+/**
+ * @brief Open the coalescing window of a NVM or shorten it to its max latency bound
+ *
+ * @param NvmId: Id of the NVM in use
+ *
+ * @return None
+ */
+static inline void ArmCoalescingWindow (const uint8_t NvmId);
+
+/**
+ * @brief Coalescing delay of a NVM, its own or the default one
+ *
+ * @param NvmId: Id of the NVM in use
+ *
+ * @return Delay in ms, 0 to write at once
+ */
+static inline uint32_t GetCoalescingDelay (const uint8_t NvmId);
+
+/**
+ * @brief Arm the coalescing timer on the first end of the open windows
+ *
+ * @return None
+ */
+static inline void ArmCoalescingTimer (void);
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
+/**
+ * @brief Start the write of the NVMs released, the first one found
+ *
+ * @param DueOnly: TRUE to release only the NVMs whose coalescing window is over, else all of them
+ *
+ * @return Status of the command
+ */
+static inline SNVMA_Cmd_Status_t FlushNvms (const uint8_t DueOnly);
+
 /**
  * @brief Invoke all the NVM pending buffer registered callbacks
  *
@@ -235,6 +385,8 @@ SNVMA_Cmd_Status_t SNVMA_Init (const uint32_t * p_NvmStartAddress)
   uint32_t nvmOffset = 0x00;
   uint32_t addressOffset = 0x00;
 
+  uint8_t bankSummaryOk = FALSE;
+
   CRCCTRL_Cmd_Status_t crcCtrlStatus = CRCCTRL_UNKNOWN;
 
   SNVMA_BankElt_t * p_currentRestoreBank = NULL;
@@ -333,8 +485,9 @@ SNVMA_Cmd_Status_t SNVMA_Init (const uint32_t * p_NvmStartAddress)
 
               LOG_ERROR_SYSTEM("\r\nSNVMA_Init - Corrupted banks erases [IsHeaderOk]");
             }
-            /* Check if CRC OK */
-            else if (IsCrcOk (SNVMA_BankConfiguration[bankConfIdx].p_StartAddr) == FALSE)
+            /* Check if CRC OK - Not needed for a bank sealed by its summary, it is checked later on by SNVMA_Check */
+            else if ((IsSummaryOk (SNVMA_BankConfiguration[bankConfIdx].p_StartAddr, nvmIdx) == FALSE) &&
+                     (IsCrcOk (SNVMA_BankConfiguration[bankConfIdx].p_StartAddr) == FALSE))
             {
               /* Erase the bank */
               while (EraseSector (((nvmOffset + addressOffset) / FLASH_PAGE_SIZE),
@@ -345,10 +498,18 @@ SNVMA_Cmd_Status_t SNVMA_Init (const uint32_t * p_NvmStartAddress)
             /* Valid bank */
             else
             {
+              bankSummaryOk = IsSummaryOk (SNVMA_BankConfiguration[bankConfIdx].p_StartAddr, nvmIdx);
+
               /* Compute buffer addresses in the bank */
               if (SNVMA_NvmConfiguration[nvmIdx].p_BankForRestore == NULL)
               {
                 SNVMA_NvmConfiguration[nvmIdx].p_BankForRestore = &SNVMA_BankConfiguration[bankConfIdx];
+
+                /* Remember whether its CRC is still to be checked */
+                if (bankSummaryOk == TRUE)
+                {
+                  SNVMA_CrcCheckBitmask |= (1u << nvmIdx);
+                }
               }
               else
               {
@@ -367,6 +528,16 @@ SNVMA_Cmd_Status_t SNVMA_Init (const uint32_t * p_NvmStartAddress)
                 }
                 else
                 {
+                  /* Remember whether the CRC of the new restore bank is still to be checked */
+                  if (bankSummaryOk == TRUE)
+                  {
+                    SNVMA_CrcCheckBitmask |= (1u << nvmIdx);
+                  }
+                  else
+                  {
+                    SNVMA_CrcCheckBitmask &= ~(1u << nvmIdx);
+                  }
+
                   /* Erase p_currentRestoreBank */
                   while (EraseSector ((((uint32_t)p_currentRestoreBank->p_StartAddr - FLASH_BASE_NS) / FLASH_PAGE_SIZE),
                                       SNVMA_NvmConfiguration[nvmIdx].BankSize) == FALSE);
@@ -488,6 +659,14 @@ SNVMA_Cmd_Status_t SNVMA_Register (const SNVMA_BufferId_t BufferId,
       }
     }
 
+    /* Keep the last 128 bits of the bank for its summary */
+    if ((error == SNVMA_ERROR_NOK) &&
+        ((neededSpace + offSet + sizeof (SNVMA_BankSummary_t)) >
+         (SNVMA_NvmConfiguration[nvmId].BankSize * FLASH_PAGE_SIZE)))
+    {
+      error = SNVMA_ERROR_BUFFER_SIZE;
+    }
+
     if (error == SNVMA_ERROR_NOK)
     {
       /* Enter critical section */
@@ -580,8 +759,9 @@ SNVMA_Cmd_Status_t SNVMA_Restore (const SNVMA_BufferId_t BufferId)
     {
       error = SNVMA_ERROR_NVM_BANK_CORRUPTED;
     }
-    /* Check bank integrity - CRC value */
-    else if (IsCrcOk (SNVMA_NvmConfiguration[nvmId].p_BankForRestore->p_StartAddr) == FALSE)
+    /* Check bank integrity - CRC value, unless the bank is sealed by its summary (checked later on by SNVMA_Check) */
+    else if (((SNVMA_CrcCheckBitmask & (1u << nvmId)) == 0x00u) &&
+             (IsCrcOk (SNVMA_NvmConfiguration[nvmId].p_BankForRestore->p_StartAddr) == FALSE))
     {
       error = SNVMA_ERROR_NVM_BANK_CORRUPTED;
     }
@@ -695,69 +875,130 @@ SNVMA_Cmd_Status_t SNVMA_Write (const SNVMA_BufferId_t BufferId,
     /* Leave critical section */
     UTILS_EXIT_CRITICAL_SECTION ();
 
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+    /* Merge the request with the next ones of its NVM : the write starts once the coalescing window elapses */
+    if ((SNVMA_CommandPending == FALSE) && (GetCoalescingDelay (nvmId) == 0u))
+    {
+      error = StartPendingWrite (nvmId, FALSE);
+    }
+    else
+    {
+      if (SNVMA_CommandPending == FALSE)
+      {
+        ArmCoalescingWindow (nvmId);
+      }
+
+      /* Request information are registered, it will dealt later on */
+      error = SNVMA_ERROR_OK;
+    }
+#else /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
     /* Check if there is only one operation on going */
     if (SNVMA_CommandPending == FALSE)
     {
-      /* Enter critical section */
-      UTILS_ENTER_CRITICAL_SECTION();
+      error = StartPendingWrite (nvmId, FALSE);
+    }
+    else
+    {
+      /* Request information are registered, it will dealt later on */
+      error = SNVMA_ERROR_OK;
+    }
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+  }
 
-      /* Set that a command is pending */
-      SNVMA_CommandPending = TRUE;
-      
-      /* Flash op started */
-      SNVMA_FlashInfo.NvmId = nvmId;
-      SNVMA_FlashInfo.BufferId = idxBuf;
-      SNVMA_FlashInfo.FlashOpState = SNVMA_HEADER_WRITE;
+  return error;
+}
 
-      /* Set request active */
-      SNVMA_NvmConfiguration[nvmId].PendingBufferWriteOp =
-        (SNVMA_NvmConfiguration[nvmId].PendingBufferWriteOp << SNVMA_MAX_NUMBER_BUFFER) & 0xF0u;
+SNVMA_Cmd_Status_t SNVMA_Flush (void)
+{
+  SNVMA_Cmd_Status_t error = SNVMA_ERROR_OK;
 
-      /* Leave critical section */
-      UTILS_EXIT_CRITICAL_SECTION ();
+  /* Check if initialized */
+  if (SNVMA_ModuleInit == FALSE)
+  {
+    error = SNVMA_ERROR_NOT_INIT;
+  }
+  else
+  {
+    error = FlushNvms (FALSE);
+  }
+
+  LOG_DEBUG_SYSTEM("\r\nSNVMA_Flush returned 0x%02X", (uint8_t)error);
+
+  return error;
+}
+
+SNVMA_Cmd_Status_t SNVMA_FlushDue (void)
+{
+  SNVMA_Cmd_Status_t error = SNVMA_ERROR_OK;
+
+  /* Check if initialized */
+  if (SNVMA_ModuleInit == FALSE)
+  {
+    error = SNVMA_ERROR_NOT_INIT;
+  }
+  else
+  {
+    error = FlushNvms (TRUE);
+  }
+
+  LOG_DEBUG_SYSTEM("\r\nSNVMA_FlushDue returned 0x%02X", (uint8_t)error);
+
+  return error;
+}
+
+SNVMA_Cmd_Status_t SNVMA_Check (void)
+{
+  SNVMA_Cmd_Status_t error = SNVMA_ERROR_NOK;
+
+  uint32_t * p_bankStartAddr = NULL;
+
+  /* Check if initialized */
+  if (SNVMA_ModuleInit == FALSE)
+  {
+    error = SNVMA_ERROR_NOT_INIT;
+  }
+  /* Check if there is no command pending */
+  else if (SNVMA_CommandPending == TRUE)
+  {
+    error = SNVMA_ERROR_CMD_PENDING;
+  }
+  else
+  {
+    error = SNVMA_ERROR_OK;
 
-      /* Check flash write status */
-      if (StartFlashWrite (nvmId) == FM_ERROR)
+    /* For each NVM whose restore bank has been trusted from its summary */
+    for (uint8_t nvmIdx = 0x00;
+         nvmIdx < SNVMA_NVM_NUMBER;
+         nvmIdx++)
+    {
+      if ((SNVMA_CrcCheckBitmask & (1u << nvmIdx)) != 0x00u)
       {
         /* Enter critical section */
         UTILS_ENTER_CRITICAL_SECTION();
 
-        /* Reset command pending flag */
-        SNVMA_CommandPending = FALSE;
+        SNVMA_CrcCheckBitmask &= ~(1u << nvmIdx);
 
-        /* Clean flags */
-        SNVMA_IdBitmask &= ~(1u << nvmId);
-        SNVMA_NvmConfiguration[nvmId].PendingBufferWriteOp = 0u;
-        
-        /* Clean flash operation information */
-        memset ((void *)&SNVMA_FlashInfo,
-                0x00,
-                sizeof (SNVMA_FlashOpInfo_t));
-
-        for (uint8_t cnt = 0x00;
-             cnt < SNVMA_MAX_NUMBER_BUFFER;
-             cnt++)
+        p_bankStartAddr = SNVMA_NvmConfiguration[nvmIdx].p_BankForRestore->p_StartAddr;
+
+        /* Check bank integrity - CRC value */
+        if (IsCrcOk (p_bankStartAddr) == FALSE)
         {
-          SNVMA_NvmConfiguration[nvmId].a_Callback[cnt] = NULL;
+          /* Forget the bank, the next write will start from the empty write bank */
+          SNVMA_NvmConfiguration[nvmIdx].p_BankForRestore = NULL;
+
+          /* Erase the bank, else it would be trusted again at next boot - Rare case, done as in SNVMA_Init */
+          while (EraseSector ((((uint32_t)p_bankStartAddr - FLASH_BASE_NS) / FLASH_PAGE_SIZE),
+                              SNVMA_NvmConfiguration[nvmIdx].BankSize) == FALSE);
+
+          LOG_ERROR_SYSTEM("\r\nSNVMA_Check - Corrupted bank erased [IsCrcOk]");
+
+          error = SNVMA_ERROR_NVM_BANK_CORRUPTED;
         }
 
         /* Leave critical section */
         UTILS_EXIT_CRITICAL_SECTION ();
-
-        error = SNVMA_ERROR_FLASH_ERROR;
-      }
-      else
-      {  
-        LOG_DEBUG_SYSTEM("\r\nSNVMA_Write - Flash operation started (Header write request) : %d", (uint8_t)SNVMA_NvmConfiguration[nvmId].PendingBufferWriteOp);
-
-        error = SNVMA_ERROR_OK;
       }
     }
-    else
-    {
-      /* Request information are registered, it will dealt later on */
-      error = SNVMA_ERROR_OK;
-    }
   }
 
   return error;
@@ -770,6 +1011,8 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
 
   static uint8_t buffCnt = 0x00;
 
+  static uint8_t crcFirst = TRUE;
+
   static SNVMA_BankElt_t * tmpBank = NULL;
 
   /* Check Flash operation state */
@@ -832,6 +1075,18 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
           /* Reset the buffer write counter */
           buffCnt = 0x00;
 
+          /* The CRC of the written buffers starts over */
+          crcFirst = TRUE;
+
+          /* Write the buffers in the order of the header CRC, for their CRC to be streamed as they are written */
+          SNVMA_FlashInfo.BufferId = 0x00;
+
+          while (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].a_Buffers[SNVMA_FlashInfo.BufferId].p_Addr == NULL)
+          {
+            SNVMA_FlashInfo.BufferId++;
+            buffCnt++;
+          }
+
           /* Leave critical section */
           UTILS_EXIT_CRITICAL_SECTION ();
 
@@ -903,6 +1158,11 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
       /* Check flash operation status */
       if (Status == FM_OPERATION_COMPLETE)
       {
+        /* Feed the CRC with the buffer written, in background while the next one is written */
+        StreamBufferCrc (SNVMA_FlashInfo.NvmId, SNVMA_FlashInfo.BufferId, crcFirst);
+
+        crcFirst = FALSE;
+
         /* Enter critical section */
         UTILS_ENTER_CRITICAL_SECTION();
 
@@ -957,8 +1217,8 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
         /* Buffer write is over */
         else
         {
-          /* Check the integrity of the whole write operation */
-          if (IsCrcOk (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr) == FALSE)
+          /* Check the integrity of the whole write operation - CRC streamed as the buffers were written */
+          if (IsStreamedCrcOk () == FALSE)
           {
             /* Enter critical section */
             UTILS_ENTER_CRITICAL_SECTION();
@@ -999,199 +1259,330 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
             /* Enter critical section */
             UTILS_ENTER_CRITICAL_SECTION();
 
-            /* Pursue with a bank swap */
-            tmpBank = SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore;
-
-            /* Make the restore bank pointing the new valid bank */
-            SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore =
-              SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite;
-
-            /* Check if it is the last bank element of the list */
-            if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite ==
-                &SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].
-                  p_BankList[(SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].BankNumber - 1)])
-            {
-              SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite =
-                &SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankList[0x00];
-            }
-            else
-            {
-              SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite++;
-            }
+            /* The bank is complete, seal it with its summary */
+            SNVMA_FlashInfo.FlashOpState = SNVMA_SUMMARY_WRITE;
 
-            /* Update buffer addresses from old write bank */
-            for (uint8_t cnt = 0x00;
-                 cnt < SNVMA_MAX_NUMBER_BUFFER;
-                 cnt++)
-            {
-              if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->ap_BufferAddr[cnt] != NULL)
-              {
-                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->ap_BufferAddr[cnt] =
-                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->ap_BufferAddr[cnt] -
-                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->p_StartAddr +
-                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr;
-              }
-            }
+            SNVMA_WriteBankSummary.Magic = SNVMA_SUMMARY_MAGIC;
+            SNVMA_WriteBankSummary.Counter = SNVMA_WriteBankHeader.Counter;
+            SNVMA_WriteBankSummary.Crc = SNVMA_WriteBankHeader.Crc;
+            SNVMA_WriteBankSummary.Check = ~(SNVMA_WriteBankSummary.Magic ^
+                                             SNVMA_WriteBankSummary.Counter ^
+                                             SNVMA_WriteBankSummary.Crc);
 
             /* Leave critical section */
             UTILS_EXIT_CRITICAL_SECTION ();
 
-            /* Erase the old restore bank */
-            if (tmpBank != NULL)
+            flashFunRet = FM_Write ((uint32_t *)&SNVMA_WriteBankSummary,
+                                    (uint32_t *)GetBankSummary (
+                                      SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr,
+                                      SNVMA_FlashInfo.NvmId),
+                                    (sizeof (SNVMA_BankSummary_t) / sizeof (uint32_t)),
+                                    &SNVMA_FlashCallback);
+
+            /* Check flash operation */
+            if (flashFunRet == FM_ERROR)
             {
+              /* Notify buffers callbacks */
+              InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
+
               /* Enter critical section */
               UTILS_ENTER_CRITICAL_SECTION();
 
-              /* Update flash operation information */
-              SNVMA_FlashInfo.FlashOpState = SNVMA_ERASE_BANK;
-			  
-              /* Leave critical section */
-              UTILS_EXIT_CRITICAL_SECTION ();
-              
-              flashFunRet = FM_Erase ((((uint32_t)tmpBank->p_StartAddr - FLASH_BASE_NS) / FLASH_PAGE_SIZE),
-                                                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].BankSize,
-                                                  &SNVMA_FlashCallback);
+              /* Clear the NVM bitmask */
+              SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
 
-              /* Check flash operation */
-              if (flashFunRet == FM_ERROR)
-              {
-                /* Notify buffers callbacks */
-                InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
+              /* Reset command pending flag */
+              SNVMA_CommandPending = FALSE;
 
-                /* Enter critical section */
-                UTILS_ENTER_CRITICAL_SECTION();
+              /* Leave critical section */
+              UTILS_EXIT_CRITICAL_SECTION ();
+            }
+          }
+        }
+      }
+      /* Status == FM_OPERATION_AVAILABLE */
+      else
+      {
+        LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_BUFFER_WRITE - Retry write operation");
 
-                /* Clear the NVM bitmask */
-                SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+        /* Retry the buffer write */
+        flashFunRet = FM_Write (
+          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].a_Buffers[SNVMA_FlashInfo.BufferId].p_Addr,
+          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->ap_BufferAddr[SNVMA_FlashInfo.BufferId],
+          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].a_Buffers[SNVMA_FlashInfo.BufferId].Size,
+          &SNVMA_FlashCallback);
 
-                /* Reset command pending flag */
-                SNVMA_CommandPending = FALSE;
+        /* Check flash operation */
+        if (flashFunRet == FM_ERROR)
+        {
+          /* Notify buffers callbacks */
+          InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
 
-                /* Leave critical section */
-                UTILS_EXIT_CRITICAL_SECTION ();
-              }
-            }
-            else
-            {
-              /* Notify buffers callbacks */
-              InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_COMPLETE);
+          /* Enter critical section */
+          UTILS_ENTER_CRITICAL_SECTION();
 
-              /* Is there any new request ? */
-              if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp == 0x00)
-              {
-                /* Enter critical section */
-                UTILS_ENTER_CRITICAL_SECTION();
+          /* Clear the NVM bitmask */
+          SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
 
-                /* No more action on this NVM, clear the NVM bitmask */
-                SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+          /* Reset command pending flag */
+          SNVMA_CommandPending = FALSE;
 
-                /* Leave critical section */
-                UTILS_EXIT_CRITICAL_SECTION ();
-              }
+          /* Leave critical section */
+          UTILS_EXIT_CRITICAL_SECTION ();
+        }
+      }
+      break;
+    }
 
-              /* Check whether there is another pending requests */
-              if (SNVMA_IdBitmask != 0x00000000)
-              {
-                /* Determine which NVM is impacted */
-                for (uint8_t cnt = 0x00;
-                     cnt < SNVMA_MAX_NUMBER_NVM;
-                     cnt++)
-                {
-                  if ((SNVMA_IdBitmask & (1u << cnt)) != 0x00)
-                  {
-                    /* Enter critical section */
-                    UTILS_ENTER_CRITICAL_SECTION();
+    case SNVMA_SUMMARY_WRITE:
+    {
+      LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_SUMMARY_WRITE");
 
-                    /* Update flash information */
-                    SNVMA_FlashInfo.NvmId = cnt;
-                    SNVMA_FlashInfo.FlashOpState = SNVMA_HEADER_WRITE;
+      /* Check flash operation status */
+      if (Status == FM_OPERATION_COMPLETE)
+      {
+        /* Check that summary has been written correctly */
+        if (IsSameContent ((uint32_t *)&SNVMA_WriteBankSummary,
+                           (uint32_t *)GetBankSummary (
+                             SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr,
+                             SNVMA_FlashInfo.NvmId),
+                           (sizeof (SNVMA_BankSummary_t) / sizeof (uint32_t))) == FALSE)
+        {
+          /* Enter critical section */
+          UTILS_ENTER_CRITICAL_SECTION();
 
-                    /* Determine which buffer is impacted */
-                    for (uint8_t idx = 0x00;
-                        idx < SNVMA_MAX_NUMBER_BUFFER;
-                        idx++)
-                    {
-                      if ((SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp & (1u << idx)) != 0x00)
-                      {
-                        SNVMA_FlashInfo.BufferId = idx;
+          /* Reschedule the whole write operation but first erase the bank */
+          SNVMA_FlashInfo.FlashOpState = SNVMA_RETRY_WRITE;
 
-                        break;
-                      }
-                    }
+          /* Leave critical section */
+          UTILS_EXIT_CRITICAL_SECTION ();
 
-                    /* Leave critical section */
-                    UTILS_EXIT_CRITICAL_SECTION ();
+          flashFunRet = FM_Erase ((((uint32_t)
+                                    SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].
+                                      p_BankForWrite->p_StartAddr - FLASH_BASE_NS) / FLASH_PAGE_SIZE),
+                                    SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].BankSize,
+                                    &SNVMA_FlashCallback);
 
-                    break;
-                  }
-                }
+          /* Check flash operation */
+          if (flashFunRet == FM_ERROR)
+          {
+            /* Notify buffers callbacks */
+            InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
 
-                LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_BUFFER_WRITE - Start the pending write operation");
+            /* Enter critical section */
+            UTILS_ENTER_CRITICAL_SECTION();
 
-                /* Start the pending write operation */
-                flashFunRet = StartFlashWrite (SNVMA_FlashInfo.NvmId);
+            /* Clear the NVM bitmask */
+            SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
 
-                /* Check flash operation */
-                if (flashFunRet == FM_ERROR)
-                {
-                  /* Notify buffers callbacks */
-                  InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
+            /* Reset command pending flag */
+            SNVMA_CommandPending = FALSE;
 
-                  /* Enter critical section */
-                  UTILS_ENTER_CRITICAL_SECTION();
+            /* Leave critical section */
+            UTILS_EXIT_CRITICAL_SECTION ();
+          }
+        }
+        else
+        {
+          /* Enter critical section */
+          UTILS_ENTER_CRITICAL_SECTION();
 
-                  /* Clear the NVM bitmask */
-                  SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+          /* Pursue with a bank swap */
+          tmpBank = SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore;
 
-                  /* Reset command pending flag */
-                  SNVMA_CommandPending = FALSE;
+          /* Make the restore bank pointing the new valid bank */
+          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore =
+            SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite;
 
-                  /* Leave critical section */
-                  UTILS_EXIT_CRITICAL_SECTION ();
-                }
-                else
+          /* The CRC of the new restore bank has just been checked */
+          SNVMA_CrcCheckBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+
+          /* Check if it is the last bank element of the list */
+          if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite ==
+              &SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].
+                p_BankList[(SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].BankNumber - 1)])
+          {
+            SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite =
+              &SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankList[0x00];
+          }
+          else
+          {
+            SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite++;
+          }
+
+          /* Update buffer addresses from old write bank */
+          for (uint8_t cnt = 0x00;
+               cnt < SNVMA_MAX_NUMBER_BUFFER;
+               cnt++)
+          {
+            if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->ap_BufferAddr[cnt] != NULL)
+            {
+              SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->ap_BufferAddr[cnt] =
+                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->ap_BufferAddr[cnt] -
+                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForRestore->p_StartAddr +
+                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr;
+            }
+          }
+
+          /* Leave critical section */
+          UTILS_EXIT_CRITICAL_SECTION ();
+
+          /* Erase the old restore bank */
+          if (tmpBank != NULL)
+          {
+            /* Enter critical section */
+            UTILS_ENTER_CRITICAL_SECTION();
+
+            /* Update flash operation information */
+            SNVMA_FlashInfo.FlashOpState = SNVMA_ERASE_BANK;
+			  
+            /* Leave critical section */
+            UTILS_EXIT_CRITICAL_SECTION ();
+            
+            flashFunRet = FM_Erase ((((uint32_t)tmpBank->p_StartAddr - FLASH_BASE_NS) / FLASH_PAGE_SIZE),
+                                                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].BankSize,
+                                                &SNVMA_FlashCallback);
+
+            /* Check flash operation */
+            if (flashFunRet == FM_ERROR)
+            {
+              /* Notify buffers callbacks */
+              InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
+
+              /* Enter critical section */
+              UTILS_ENTER_CRITICAL_SECTION();
+
+              /* Clear the NVM bitmask */
+              SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+
+              /* Reset command pending flag */
+              SNVMA_CommandPending = FALSE;
+
+              /* Leave critical section */
+              UTILS_EXIT_CRITICAL_SECTION ();
+            }
+          }
+          else
+          {
+            /* Notify buffers callbacks */
+            InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_COMPLETE);
+
+            /* Is there any new request ? */
+            if (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp == 0x00)
+            {
+              /* Enter critical section */
+              UTILS_ENTER_CRITICAL_SECTION();
+
+              /* No more action on this NVM, clear the NVM bitmask */
+              SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+
+              /* Leave critical section */
+              UTILS_EXIT_CRITICAL_SECTION ();
+            }
+
+            /* Check whether there is another pending requests - The NVMs held by their coalescing window wait */
+            if (SNVMA_RELEASED_BITMASK () != 0x00000000)
+            {
+              /* Determine which NVM is impacted */
+              for (uint8_t cnt = 0x00;
+                   cnt < SNVMA_MAX_NUMBER_NVM;
+                   cnt++)
+              {
+                if ((SNVMA_RELEASED_BITMASK () & (1u << cnt)) != 0x00)
                 {
                   /* Enter critical section */
                   UTILS_ENTER_CRITICAL_SECTION();
 
-                  /* Set requests active */
-                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp |=
-                    (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp << SNVMA_MAX_NUMBER_BUFFER);
+                  /* Update flash information */
+                  SNVMA_FlashInfo.NvmId = cnt;
+                  SNVMA_FlashInfo.FlashOpState = SNVMA_HEADER_WRITE;
 
-                  /* Erase pendings requests */
-                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp &= 0xF0;
+                  /* Determine which buffer is impacted */
+                  for (uint8_t idx = 0x00;
+                      idx < SNVMA_MAX_NUMBER_BUFFER;
+                      idx++)
+                  {
+                    if ((SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp & (1u << idx)) != 0x00)
+                    {
+                      SNVMA_FlashInfo.BufferId = idx;
+
+                      break;
+                    }
+                  }
 
                   /* Leave critical section */
                   UTILS_EXIT_CRITICAL_SECTION ();
+
+                  break;
                 }
               }
-              /* No more stuff to do */
-              else
+
+              LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_BUFFER_WRITE - Start the pending write operation");
+
+              /* Start the pending write operation */
+              flashFunRet = StartFlashWrite (SNVMA_FlashInfo.NvmId);
+
+              /* Check flash operation */
+              if (flashFunRet == FM_ERROR)
               {
+                /* Notify buffers callbacks */
+                InvokeBufferCallback (SNVMA_FlashInfo.NvmId, SNVMA_OPERATION_FAILED);
+
                 /* Enter critical section */
                 UTILS_ENTER_CRITICAL_SECTION();
 
+                /* Clear the NVM bitmask */
+                SNVMA_IdBitmask &= ~(1u << SNVMA_FlashInfo.NvmId);
+
                 /* Reset command pending flag */
                 SNVMA_CommandPending = FALSE;
 
+                /* Leave critical section */
+                UTILS_EXIT_CRITICAL_SECTION ();
+              }
+              else
+              {
+                /* Enter critical section */
+                UTILS_ENTER_CRITICAL_SECTION();
+
+                /* Set requests active */
+                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp |=
+                  (SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp << SNVMA_MAX_NUMBER_BUFFER);
+
+                /* Erase pendings requests */
+                SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].PendingBufferWriteOp &= 0xF0;
+
                 /* Leave critical section */
                 UTILS_EXIT_CRITICAL_SECTION ();
               }
             }
+            /* No more stuff to do */
+            else
+            {
+              /* Enter critical section */
+              UTILS_ENTER_CRITICAL_SECTION();
+
+              /* Reset command pending flag */
+              SNVMA_CommandPending = FALSE;
+
+              /* Leave critical section */
+              UTILS_EXIT_CRITICAL_SECTION ();
+            }
           }
         }
       }
       /* Status == FM_OPERATION_AVAILABLE */
       else
       {
-        LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_BUFFER_WRITE - Retry write operation");
-
-        /* Retry the buffer write */
-        flashFunRet = FM_Write (
-          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].a_Buffers[SNVMA_FlashInfo.BufferId].p_Addr,
-          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->ap_BufferAddr[SNVMA_FlashInfo.BufferId],
-          SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].a_Buffers[SNVMA_FlashInfo.BufferId].Size,
-          &SNVMA_FlashCallback);
+        LOG_DEBUG_SYSTEM("\r\nSNVMA_FlashManagerCallback - Flash operation state : SNVMA_SUMMARY_WRITE - Retry write operation");
+
+        /* Retry the summary write */
+        flashFunRet = FM_Write ((uint32_t *)&SNVMA_WriteBankSummary,
+                                (uint32_t *)GetBankSummary (
+                                  SNVMA_NvmConfiguration[SNVMA_FlashInfo.NvmId].p_BankForWrite->p_StartAddr,
+                                  SNVMA_FlashInfo.NvmId),
+                                (sizeof (SNVMA_BankSummary_t) / sizeof (uint32_t)),
+                                &SNVMA_FlashCallback);
 
         /* Check flash operation */
         if (flashFunRet == FM_ERROR)
@@ -1238,15 +1629,15 @@ void SNVMA_FlashManagerCallback(FM_FlashOp_Status_t Status)
           UTILS_EXIT_CRITICAL_SECTION ();
         }
 
-        /* Check whether there is another pending requests */
-        if (SNVMA_IdBitmask != 0x00000000)
+        /* Check whether there is another pending requests - The NVMs held by their coalescing window wait */
+        if (SNVMA_RELEASED_BITMASK () != 0x00000000)
         {
           /* Determine which NVM is impacted */
           for (uint8_t cnt = 0x00;
                 cnt < SNVMA_MAX_NUMBER_NVM;
                 cnt++)
           {
-            if ((SNVMA_IdBitmask & (1u << cnt)) != 0x00)
+            if ((SNVMA_RELEASED_BITMASK () & (1u << cnt)) != 0x00)
             {
               /* Enter critical section */
               UTILS_ENTER_CRITICAL_SECTION();
@@ -1683,6 +2074,97 @@ uint8_t IsCrcOk (const uint32_t * const p_BankStartAddress)
   return error;
 }
 
+void StreamBufferCrc (const uint8_t NvmId, const uint8_t BufferId, const uint8_t First)
+{
+  uint32_t crcComputedValue = 0x00;
+  CRCCTRL_Cmd_Status_t eReturn = CRCCTRL_BUSY;
+
+  if (First == TRUE)
+  {
+    SNVMA_CrcStreamError = FALSE;
+  }
+  else
+  {
+    /* Wait for the previous buffer - Its feeding was overlapped by the flash write of this one */
+    do
+    {
+      eReturn = CRCCTRL_AccumulateEnd (&SNVMA_Handle, &crcComputedValue);
+    } while (CRCCTRL_BUSY == eReturn);
+
+    /* Transfer error, the write is checked NOK at the end */
+    if (CRCCTRL_OK != eReturn)
+    {
+      SNVMA_CrcStreamError = TRUE;
+    }
+  }
+
+  /* Feed the CRC with the flash copy of the buffer */
+  do
+  {
+    eReturn = CRCCTRL_AccumulateStart (&SNVMA_Handle,
+                                       SNVMA_NvmConfiguration[NvmId].p_BankForWrite->ap_BufferAddr[BufferId],
+                                       SNVMA_NvmConfiguration[NvmId].a_Buffers[BufferId].Size,
+                                       First);
+  } while (CRCCTRL_BUSY == eReturn);
+
+  if (CRCCTRL_OK != eReturn)
+  {
+    Error_Handler();
+  }
+}
+
+uint8_t IsStreamedCrcOk (void)
+{
+  uint8_t error = FALSE;
+
+  uint32_t crcComputedValue = 0x00;
+  CRCCTRL_Cmd_Status_t eReturn = CRCCTRL_BUSY;
+
+  /* Wait for the last buffer */
+  do
+  {
+    eReturn = CRCCTRL_AccumulateEnd (&SNVMA_Handle, &crcComputedValue);
+  } while (CRCCTRL_BUSY == eReturn);
+
+  /* Compare with the CRC of the header written */
+  if ((CRCCTRL_OK == eReturn) &&
+      (SNVMA_CrcStreamError == FALSE) &&
+      (crcComputedValue == SNVMA_WriteBankHeader.Crc))
+  {
+    error = TRUE;
+  }
+
+  LOG_DEBUG_SYSTEM("\r\nEnd of streamed CRC computation, value : %d", crcComputedValue);
+
+  return error;
+}
+
+uint8_t IsSummaryOk (const uint32_t * const p_BankStartAddress, const uint8_t NvmId)
+{
+  uint8_t error = FALSE;
+
+  SNVMA_BankHeader_t * p_bankHeader = (SNVMA_BankHeader_t *)p_BankStartAddress;
+  SNVMA_BankSummary_t * p_bankSummary = GetBankSummary (p_BankStartAddress, NvmId);
+
+  /* Check the marker and the check value, then that the summary is the one of the header */
+  if ((p_bankSummary->Magic == SNVMA_SUMMARY_MAGIC) &&
+      (p_bankSummary->Check == ~(p_bankSummary->Magic ^ p_bankSummary->Counter ^ p_bankSummary->Crc)) &&
+      (p_bankSummary->Counter == p_bankHeader->Counter) &&
+      (p_bankSummary->Crc == p_bankHeader->Crc))
+  {
+    error = TRUE;
+  }
+
+  return error;
+}
+
+SNVMA_BankSummary_t * GetBankSummary (const uint32_t * const p_BankStartAddress, const uint8_t NvmId)
+{
+  return (SNVMA_BankSummary_t *)((uint32_t)p_BankStartAddress +
+                                 (SNVMA_NvmConfiguration[NvmId].BankSize * FLASH_PAGE_SIZE) -
+                                 sizeof (SNVMA_BankSummary_t));
+}
+
 uint8_t IsSameContent (uint32_t * p_Source, uint32_t * p_Destination, uint32_t Size)
 {
   uint8_t error = TRUE;
@@ -1865,6 +2347,302 @@ FM_Cmd_Status_t StartFlashWrite (const uint8_t NvmId)
   return error;
 }
 
+#if (SNVMA_WRITE_SKIP_UNCHANGED != 0u)
+uint8_t IsBankUnchanged (const uint8_t NvmId)
+{
+  uint8_t error = FALSE;
+  uint32_t offset = sizeof (SNVMA_BankHeader_t);
+  uint16_t a_bankSize[SNVMA_MAX_NUMBER_BUFFER];
+  SNVMA_BankHeader_t * p_bankHeader = NULL;
+
+  /* Only a restore bank whose CRC has been checked can be kept */
+  if ((SNVMA_NvmConfiguration[NvmId].p_BankForRestore != NULL) &&
+      ((SNVMA_CrcCheckBitmask & (1u << NvmId)) == 0x00u) &&
+      (IsHeaderOk (SNVMA_NvmConfiguration[NvmId].p_BankForRestore->p_StartAddr, NvmId) == TRUE))
+  {
+    p_bankHeader = (SNVMA_BankHeader_t *)SNVMA_NvmConfiguration[NvmId].p_BankForRestore->p_StartAddr;
+
+    a_bankSize[0x00] = p_bankHeader->SizeId1;
+    a_bankSize[0x01] = p_bankHeader->SizeId2;
+    a_bankSize[0x02] = p_bankHeader->SizeId3;
+    a_bankSize[0x03] = p_bankHeader->SizeId4;
+
+    error = TRUE;
+
+    /* Compare each buffer with its copy in the bank, laid out as for the restore */
+    for (uint8_t cnt = 0x00;
+         (cnt < SNVMA_MAX_NUMBER_BUFFER) && (error == TRUE);
+         cnt++)
+    {
+      if (a_bankSize[cnt] != SNVMA_NvmConfiguration[NvmId].a_Buffers[cnt].Size)
+      {
+        error = FALSE;
+      }
+      else if ((a_bankSize[cnt] != 0x00u) &&
+               (IsSameContent (SNVMA_NvmConfiguration[NvmId].a_Buffers[cnt].p_Addr,
+                               (uint32_t *)((uint32_t)SNVMA_NvmConfiguration[NvmId].p_BankForRestore->p_StartAddr +
+                                            offset),
+                               a_bankSize[cnt]) == FALSE))
+      {
+        error = FALSE;
+      }
+      else
+      {
+        offset += SNVMA_ALIGN_128((a_bankSize[cnt] * sizeof (uint32_t)));
+      }
+    }
+  }
+
+  return error;
+}
+#endif /* (SNVMA_WRITE_SKIP_UNCHANGED != 0u) */
+
+SNVMA_Cmd_Status_t StartPendingWrite (const uint8_t NvmId, const uint8_t Notify)
+{
+  SNVMA_Cmd_Status_t error = SNVMA_ERROR_OK;
+
+  /* Enter critical section */
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  /* Set that a command is pending */
+  SNVMA_CommandPending = TRUE;
+
+  /* Flash op started */
+  SNVMA_FlashInfo.NvmId = NvmId;
+  SNVMA_FlashInfo.FlashOpState = SNVMA_HEADER_WRITE;
+
+  /* Determine which buffer is impacted */
+  for (uint8_t idx = 0x00;
+       idx < SNVMA_MAX_NUMBER_BUFFER;
+       idx++)
+  {
+    if ((SNVMA_NvmConfiguration[NvmId].PendingBufferWriteOp & (1u << idx)) != 0x00)
+    {
+      SNVMA_FlashInfo.BufferId = idx;
+
+      break;
+    }
+  }
+
+  /* Set requests active */
+  SNVMA_NvmConfiguration[NvmId].PendingBufferWriteOp =
+    (SNVMA_NvmConfiguration[NvmId].PendingBufferWriteOp << SNVMA_MAX_NUMBER_BUFFER) & 0xF0u;
+
+  /* Leave critical section */
+  UTILS_EXIT_CRITICAL_SECTION ();
+
+#if (SNVMA_WRITE_SKIP_UNCHANGED != 0u)
+  /* Same content as the restore bank, the bank is neither programmed nor erased */
+  if (IsBankUnchanged (NvmId) == TRUE)
+  {
+    LOG_DEBUG_SYSTEM("\r\nSNVMA - Flash operation skipped (Content unchanged) : %d", NvmId);
+
+    error = SNVMA_ERROR_UNCHANGED;
+  }
+  else
+#endif /* (SNVMA_WRITE_SKIP_UNCHANGED != 0u) */
+  /* Check flash write status */
+  if (StartFlashWrite (NvmId) == FM_ERROR)
+  {
+    error = SNVMA_ERROR_FLASH_ERROR;
+  }
+  else
+  {
+    LOG_DEBUG_SYSTEM("\r\nSNVMA - Flash operation started (Header write request) : %d", (uint8_t)SNVMA_NvmConfiguration[NvmId].PendingBufferWriteOp);
+  }
+
+  /* The write has not been started */
+  if (error != SNVMA_ERROR_OK)
+  {
+    if (Notify == TRUE)
+    {
+      /* Notify buffers callbacks */
+      InvokeBufferCallback (NvmId,
+                            ((error == SNVMA_ERROR_UNCHANGED) ? SNVMA_OPERATION_COMPLETE : SNVMA_OPERATION_FAILED));
+    }
+
+    /* Enter critical section */
+    UTILS_ENTER_CRITICAL_SECTION();
+
+    /* Reset command pending flag */
+    SNVMA_CommandPending = FALSE;
+
+    /* Clean flags */
+    SNVMA_IdBitmask &= ~(1u << NvmId);
+    SNVMA_NvmConfiguration[NvmId].PendingBufferWriteOp = 0u;
+
+    /* Clean flash operation information */
+    memset ((void *)&SNVMA_FlashInfo,
+            0x00,
+            sizeof (SNVMA_FlashOpInfo_t));
+
+    for (uint8_t cnt = 0x00;
+         cnt < SNVMA_MAX_NUMBER_BUFFER;
+         cnt++)
+    {
+      SNVMA_NvmConfiguration[NvmId].a_Callback[cnt] = NULL;
+    }
+
+    /* Leave critical section */
+    UTILS_EXIT_CRITICAL_SECTION ();
+  }
+
+  return error;
+}
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+uint32_t GetCoalescingDelay (const uint8_t NvmId)
+{
+  /* No policy set for the NVM : the default one */
+  return ((SNVMA_NvmConfiguration[NvmId].MaxLatency == 0u) ? SNVMA_WRITE_COALESCING_DELAY :
+                                                             SNVMA_NvmConfiguration[NvmId].CoalescingDelay);
+}
+
+void ArmCoalescingWindow (const uint8_t NvmId)
+{
+  uint32_t now = HAL_GetTick ();
+  uint32_t elapsed = 0x00000000;
+  uint32_t delay = GetCoalescingDelay (NvmId);
+  uint32_t maxLatency = SNVMA_NvmConfiguration[NvmId].MaxLatency;
+
+  if (maxLatency == 0u)
+  {
+    maxLatency = SNVMA_WRITE_MAX_LATENCY;
+  }
+
+  /* Enter critical section */
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  if ((SNVMA_HoldBitmask & (1u << NvmId)) == 0x00)
+  {
+    /* First request of the window */
+    SNVMA_HoldBitmask |= (1u << NvmId);
+    SNVMA_CoalescingStart[NvmId] = now;
+  }
+  else
+  {
+    elapsed = now - SNVMA_CoalescingStart[NvmId];
+  }
+
+  /* Each request pushes the write back, but never after the max latency of the first one */
+  if (elapsed >= maxLatency)
+  {
+    delay = 0u;
+  }
+  else if ((maxLatency - elapsed) < delay)
+  {
+    delay = maxLatency - elapsed;
+  }
+  else
+  {
+    /* Full coalescing delay */
+  }
+
+  SNVMA_CoalescingEnd[NvmId] = now + delay;
+
+  /* Leave critical section */
+  UTILS_EXIT_CRITICAL_SECTION ();
+
+  ArmCoalescingTimer ();
+}
+
+void ArmCoalescingTimer (void)
+{
+  uint32_t now = HAL_GetTick ();
+  uint32_t delay = UINT32_MAX;
+  uint32_t remaining;
+
+  /* Enter critical section */
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  for (uint8_t cnt = 0x00;
+       cnt < SNVMA_NVM_NUMBER;
+       cnt++)
+  {
+    if ((SNVMA_HoldBitmask & (1u << cnt)) != 0x00)
+    {
+      /* Window already over : 0 */
+      remaining = (((int32_t)(SNVMA_CoalescingEnd[cnt] - now) > 0) ? (SNVMA_CoalescingEnd[cnt] - now) : 0u);
+
+      if (remaining < delay)
+      {
+        delay = remaining;
+      }
+    }
+  }
+
+  /* Leave critical section */
+  UTILS_EXIT_CRITICAL_SECTION ();
+
+  if (delay != UINT32_MAX)
+  {
+    SNVMA_CoalescingTimerStart (delay);
+  }
+}
+
+__WEAK void SNVMA_CoalescingTimerStart (const uint32_t Delay)
+{
+  UNUSED (Delay);
+
+  /* No timer available : the write is started at once */
+  (void)SNVMA_Flush ();
+}
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
+SNVMA_Cmd_Status_t FlushNvms (const uint8_t DueOnly)
+{
+  SNVMA_Cmd_Status_t error = SNVMA_ERROR_OK;
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+  uint32_t now = HAL_GetTick ();
+
+  /* Enter critical section */
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  /* Close the coalescing windows that are over, or all of them */
+  for (uint8_t cnt = 0x00;
+       cnt < SNVMA_NVM_NUMBER;
+       cnt++)
+  {
+    if ((DueOnly == FALSE) || ((int32_t)(SNVMA_CoalescingEnd[cnt] - now) <= 0))
+    {
+      SNVMA_HoldBitmask &= ~(1u << cnt);
+    }
+  }
+
+  /* Leave critical section */
+  UTILS_EXIT_CRITICAL_SECTION ();
+#else /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+  UNUSED (DueOnly);
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
+  /* A write on going carries on with the pending requests */
+  if ((SNVMA_CommandPending == FALSE) && (SNVMA_RELEASED_BITMASK () != 0x00000000))
+  {
+    /* Determine which NVM is impacted, an unchanged NVM is skipped for the next one */
+    for (uint8_t cnt = 0x00;
+         (cnt < SNVMA_MAX_NUMBER_NVM) && (SNVMA_CommandPending == FALSE);
+         cnt++)
+    {
+      if ((SNVMA_RELEASED_BITMASK () & (1u << cnt)) != 0x00)
+      {
+        /* The requester has already been answered : the end of the write goes through its callback */
+        if (StartPendingWrite (cnt, TRUE) == SNVMA_ERROR_FLASH_ERROR)
+        {
+          error = SNVMA_ERROR_FLASH_ERROR;
+        }
+      }
+    }
+  }
+
+#if (SNVMA_WRITE_COALESCING_DELAY != 0u)
+  /* The windows still open need the timer again */
+  ArmCoalescingTimer ();
+#endif /* (SNVMA_WRITE_COALESCING_DELAY != 0u) */
+
+  return error;
+}
+
 void InvokeBufferCallback (const uint8_t NvmId, const SNVMA_Callback_Status_t CallbackStatus)
 {
   uint8_t pendingShift = 0x00;
@@ -109,6 +109,13 @@ SNVMA_Cmd_Status_t SNVMA_Restore (const SNVMA_BufferId_t BufferId);
  * @details A buffer write request cannot be scheduled once its NVM is already on a write operation. This will lead
  *          to a SNVMA_OPERATION_FAILED callback status.
  *
+ * @details When SNVMA_WRITE_COALESCING_DELAY is not 0, the write is held in the coalescing window of its NVM and
+ *          merged with the next requests of the NVM, see SNVMA_FlushDue. A NVM with a coalescing delay of 0 is
+ *          written at once.
+ *
+ * @details When SNVMA_WRITE_SKIP_UNCHANGED is not 0, no bank is written if the buffers are the same as the
+ *          last written bank. SNVMA_ERROR_UNCHANGED is then returned and the callback is not called.
+ *
  * @param BufferId: Id of the user which ask for buffer registration
  * @param Callback: Callback function for operation status return - Can be NULL
  *
@@ -119,10 +126,64 @@ SNVMA_Cmd_Status_t SNVMA_Restore (const SNVMA_BufferId_t BufferId);
  * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_BUFFERID_NOT_KNOWN
  * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_BUFFERID_NOT_REGISTERED
  * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_FLASH_ERROR
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_UNCHANGED
  */
 SNVMA_Cmd_Status_t SNVMA_Write (const SNVMA_BufferId_t BufferId,
                                 void (* Callback) (SNVMA_Callback_Status_t));
 
+/**
+ * @brief  Check the CRC of the restore banks trusted by SNVMA_Init from their summary only
+ *
+ * @details Each bank is sealed by a summary once written and checked. SNVMA_Init and SNVMA_Restore trust a sealed
+ *          bank after its header, without computing its CRC : this is done by this function, to be called in
+ *          background once the boot is over. A corrupted bank is erased, its NVM restarts empty.
+ *
+ * @return Status of the command
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_OK
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_NOT_INIT
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_CMD_PENDING
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_NVM_BANK_CORRUPTED
+ */
+SNVMA_Cmd_Status_t SNVMA_Check (void);
+
+/**
+ * @brief  Start at once the write of the requests held by the coalescing window
+ *
+ * @details To be called from the timer armed by SNVMA_CoalescingTimerStart, or before a shutdown.
+ *          A write failure is notified through the callbacks of the requests, as well as an unchanged content
+ *          (SNVMA_OPERATION_COMPLETE).
+ *
+ * @return Status of the command
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_OK
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_NOT_INIT
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_FLASH_ERROR
+ */
+SNVMA_Cmd_Status_t SNVMA_Flush (void);
+
+/**
+ * @brief  Start the write of the requests held by the coalescing windows that are over
+ *
+ * @details Each NVM has its own coalescing window (CoalescingDelay and MaxLatency of its SNVMA_NvmElt_t) : to be
+ *          called from the timer armed by SNVMA_CoalescingTimerStart, it writes the NVMs whose window is over and
+ *          arms the timer again for the other ones. SNVMA_Flush writes them all.
+ *
+ * @return Status of the command
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_OK
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_NOT_INIT
+ * @retval SNVMA_Cmd_Status_t::SNVMA_ERROR_FLASH_ERROR
+ */
+SNVMA_Cmd_Status_t SNVMA_FlushDue (void);
+
+/**
+ * @brief  Arm a one shot timer calling SNVMA_FlushDue after Delay ms, a pending timer is restarted
+ *
+ * @details Implemented by the user, the default implementation calls SNVMA_Flush at once.
+ *          SNVMA_FlushDue shall be called from a task, not from the timer interrupt.
+ *
+ * @param Delay: Delay in ms before the flush, 0 to flush as soon as possible
+ */
+void SNVMA_CoalescingTimerStart (const uint32_t Delay);
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,6 +64,7 @@ typedef enum SNVMA_Cmd_Status
   SNVMA_ERROR_BUFFER_SIZE,
   SNVMA_ERROR_BUFFER_CONFIG_MISSMATCH,
   SNVMA_ERROR_FLASH_ERROR,
+  SNVMA_ERROR_UNCHANGED,
   SNVMA_ERROR_UNKNOWN,
 } SNVMA_Cmd_Status_t;
 
@@ -110,6 +111,10 @@ typedef struct SNVMA_NvmElt
    *
    */
   uint8_t PendingBufferWriteOp;
+  /* Coalescing window of the write requests in ms, 0 to write at once - Default when MaxLatency is 0 */
+  uint32_t CoalescingDelay;
+  /* Max latency in ms between the first merged request and the start of the write - 0 for the default policy */
+  uint32_t MaxLatency;
   /* Pointer onto the bank list */
   SNVMA_BankElt_t * p_BankList;
   /* Pointer onto the bank being used for write operation */
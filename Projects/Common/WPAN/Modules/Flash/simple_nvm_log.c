@@ -0,0 +1,777 @@
+/**
+  ******************************************************************************
+  * @file    simple_nvm_log.c
+  * @author  MCD Application Team
+  * @brief   The Simple NVM log module saves a SRAM buffer in two flash pages
+  *          as a log of records : a write only appends the records that have
+  *          changed, then a commit record. A page is erased only when the
+  *          other one is full and its records are compacted.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* Memset */
+#include <string.h>
+
+/* Own header files */
+#include "simple_nvm_log.h"
+#include "simple_nvm_log_conf.h"
+
+/* Target defines */
+#include "stm32wbaxx_hal.h"
+
+/* Needed modules */
+#include "flash_manager.h"
+
+/* Tools */
+#include "utilities_common.h"
+
+/* Debug */
+#include "log_module.h"
+
+/* Private defines -----------------------------------------------------------*/
+/* Magic words of the page header and of the records */
+#define SNVML_PAGE_MAGIC          0x4C564E53u   /* "SNVL" */
+#define SNVML_RECORD_MAGIC        0x44434552u   /* "RECD" */
+
+/* Index of the commit record */
+#define SNVML_INDEX_COMMIT        0xFFFFu
+
+/* No slot for a record */
+#define SNVML_SLOT_NONE           0xFFFFu
+
+/* Flash memory erased content */
+#define SNVML_ERASED_CONTENT      0xFFFFFFFFu
+
+/* Words of a slot and of a record data */
+#define SNVML_SLOT_WORDS          (SNVML_SLOT_SIZE / sizeof(uint32_t))
+#define SNVML_RECORD_WORDS        (SNVML_RECORD_SIZE / sizeof(uint32_t))
+
+/* Hash (FNV-1a) of a record */
+#define SNVML_HASH_INIT           0x811C9DC5u
+#define SNVML_HASH_PRIME          0x01000193u
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Flash operation steps */
+typedef enum SNVML_FlashOpSteps
+{
+  SNVML_IDLE,
+  SNVML_ERASE_PAGE,
+  SNVML_RECORD_WRITE,
+  SNVML_COMMIT_WRITE,
+  SNVML_HEADER_WRITE
+}SNVML_FlashOpSteps_t;
+
+/* Page header, written last when a page is filled by a compaction */
+typedef struct SNVML_PageHeader
+{
+  uint32_t Magic;
+  /* Freshness of the page. The greater, the fresher */
+  uint32_t Sequence;
+  uint32_t SequenceInv;
+  uint32_t Rfu;
+}SNVML_PageHeader_t;
+
+/* Record of the log : header, then data */
+typedef struct SNVML_Record
+{
+  uint32_t Magic;
+  /* Index of the record in the buffer, SNVML_INDEX_COMMIT for a commit */
+  uint16_t Index;
+  uint16_t IndexInv;
+  /* Sequence of the write : the records are taken by the commit of the same sequence */
+  uint32_t Sequence;
+  /* Integrity check of the index, sequence and data */
+  uint32_t Hash;
+  uint32_t Data[SNVML_RECORD_WORDS];
+}SNVML_Record_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* Flag for module initialization */
+static uint8_t SNVML_ModuleInit = FALSE;
+
+/* First page of the log */
+static uint32_t SNVML_StartAddress;
+static uint32_t SNVML_StartSector;
+
+/* Registered buffer */
+static uint32_t * SNVML_p_Buffer = NULL;
+static uint32_t SNVML_BufferSize;
+static uint16_t SNVML_RecordCount;
+
+/* Current page, its sequence and its next free slot */
+static uint8_t SNVML_Page;
+static uint8_t SNVML_PageValid;
+static uint32_t SNVML_PageSequence;
+static uint16_t SNVML_NextSlot;
+
+/* Slots of the last committed records in the current page */
+static uint16_t SNVML_CommittedSlot[SNVML_RECORD_MAX];
+static uint8_t SNVML_CommitFound;
+
+/* Slots of the records written by the on going write */
+static uint16_t SNVML_PendingSlot[SNVML_RECORD_MAX];
+
+/* Sequence of the next write */
+static uint32_t SNVML_Sequence;
+
+/* On going write */
+static SNVML_FlashOpSteps_t SNVML_FlashOpState = SNVML_IDLE;
+static uint8_t SNVML_Compaction;
+static uint8_t SNVML_WritePage;
+static uint16_t SNVML_WriteSlot;
+static uint16_t SNVML_WriteIndex;
+static void (* SNVML_Callback) (SNVML_Callback_Status_t);
+
+/* Record and page header being written */
+static SNVML_Record_t SNVML_WriteRecord;
+static SNVML_PageHeader_t SNVML_WritePageHeader;
+
+/* Callback struct for Flash manager */
+static FM_CallbackNode_t SNVML_FlashCallback;
+
+/* Statistics */
+static SNVML_Stats_t SNVML_Stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void SNVML_FlashManagerCallback (FM_FlashOp_Status_t Status);
+static void SNVML_ScanPage (void);
+static uint8_t SNVML_FlashRequest (void);
+static void SNVML_NextStep (void);
+static void SNVML_WriteEnd (SNVML_Callback_Status_t Status);
+static void SNVML_BuildRecord (uint16_t Index, const uint32_t * p_Data, uint32_t Words);
+static uint8_t SNVML_IsRecordChanged (uint16_t Index);
+static uint32_t SNVML_RecordWords (uint16_t Index);
+static uint32_t SNVML_RecordHash (const SNVML_Record_t * p_Record);
+static uint8_t SNVML_IsRecordValid (const SNVML_Record_t * p_Record);
+static uint8_t SNVML_IsErased (const uint32_t * p_Data, uint32_t Words);
+static uint8_t SNVML_IsPageValid (uint8_t Page);
+static const SNVML_PageHeader_t * SNVML_GetPageHeader (uint8_t Page);
+static const SNVML_Record_t * SNVML_GetRecord (uint8_t Page, uint16_t Slot);
+
+/* Functions Definition ------------------------------------------------------*/
+
+SNVML_Cmd_Status_t SNVML_Init (const uint32_t * p_NvmStartAddress)
+{
+  uint32_t seq0, seq1;
+
+  if (SNVML_ModuleInit == TRUE)
+  {
+    return SNVML_ERROR_ALREADY_INIT;
+  }
+  if (p_NvmStartAddress == NULL)
+  {
+    return SNVML_ERROR_NVM_NULL;
+  }
+  if ((((uint32_t)p_NvmStartAddress - FLASH_BASE_NS) % FLASH_PAGE_SIZE) != 0u)
+  {
+    return SNVML_ERROR_NVM_NOT_ALIGNED;
+  }
+  if (((uint32_t)p_NvmStartAddress + (SNVML_PAGE_NUMBER * FLASH_PAGE_SIZE)) > (FLASH_BASE_NS + FLASH_SIZE))
+  {
+    return SNVML_ERROR_NVM_OVERLAP_FLASH;
+  }
+
+  SNVML_StartAddress = (uint32_t)p_NvmStartAddress;
+  SNVML_StartSector = (SNVML_StartAddress - FLASH_BASE_NS) / FLASH_PAGE_SIZE;
+  SNVML_FlashCallback.Callback = SNVML_FlashManagerCallback;
+  memset ((void *)&SNVML_Stats, 0x00, sizeof (SNVML_Stats));
+
+  /* The current page is the freshest valid one */
+  SNVML_PageValid = TRUE;
+  if ((SNVML_IsPageValid (0u) == TRUE) && (SNVML_IsPageValid (1u) == TRUE))
+  {
+    seq0 = SNVML_GetPageHeader (0u)->Sequence;
+    seq1 = SNVML_GetPageHeader (1u)->Sequence;
+    SNVML_Page = ((int32_t)(seq1 - seq0) > 0) ? 1u : 0u;
+  }
+  else if (SNVML_IsPageValid (0u) == TRUE)
+  {
+    SNVML_Page = 0u;
+  }
+  else if (SNVML_IsPageValid (1u) == TRUE)
+  {
+    SNVML_Page = 1u;
+  }
+  else
+  {
+    /* Empty log : the first write fills the page 0 */
+    SNVML_Page = 1u;
+    SNVML_PageValid = FALSE;
+  }
+
+  SNVML_ScanPage ();
+
+  SNVML_ModuleInit = TRUE;
+
+  LOG_DEBUG_SYSTEM("\r\nSNVML_Init - Page %d, %d slots used, commit %d", SNVML_Page, SNVML_NextSlot, SNVML_CommitFound);
+
+  return SNVML_ERROR_OK;
+}
+
+SNVML_Cmd_Status_t SNVML_Register (uint32_t * p_BufferAddress,
+                                   const uint32_t BufferSize)
+{
+  if (SNVML_ModuleInit == FALSE)
+  {
+    return SNVML_ERROR_NOT_INIT;
+  }
+  if (SNVML_FlashOpState != SNVML_IDLE)
+  {
+    return SNVML_ERROR_CMD_PENDING;
+  }
+  if (p_BufferAddress == NULL)
+  {
+    return SNVML_ERROR_BUFFER_NULL;
+  }
+  if (((uint32_t)p_BufferAddress & 0x00000003u) != 0u)
+  {
+    return SNVML_ERROR_BUFFER_NOT_ALIGNED;
+  }
+  if ((BufferSize == 0u) || (BufferSize > (SNVML_RECORD_MAX * SNVML_RECORD_WORDS)))
+  {
+    return SNVML_ERROR_BUFFER_SIZE;
+  }
+
+  SNVML_p_Buffer = p_BufferAddress;
+  SNVML_BufferSize = BufferSize;
+  SNVML_RecordCount = (uint16_t)((BufferSize + SNVML_RECORD_WORDS - 1u) / SNVML_RECORD_WORDS);
+
+  return SNVML_ERROR_OK;
+}
+
+SNVML_Cmd_Status_t SNVML_Restore (void)
+{
+  const SNVML_Record_t * p_record;
+  uint16_t index;
+
+  if (SNVML_ModuleInit == FALSE)
+  {
+    return SNVML_ERROR_NOT_INIT;
+  }
+  if (SNVML_p_Buffer == NULL)
+  {
+    return SNVML_ERROR_NOT_REGISTERED;
+  }
+  if (SNVML_FlashOpState != SNVML_IDLE)
+  {
+    return SNVML_ERROR_CMD_PENDING;
+  }
+  if (SNVML_CommitFound == FALSE)
+  {
+    return SNVML_ERROR_NVM_EMPTY;
+  }
+
+  for (index = 0u; index < SNVML_RecordCount; index++)
+  {
+    if (SNVML_CommittedSlot[index] == SNVML_SLOT_NONE)
+    {
+      return SNVML_ERROR_NVM_CORRUPTED;
+    }
+  }
+
+  for (index = 0u; index < SNVML_RecordCount; index++)
+  {
+    p_record = SNVML_GetRecord (SNVML_Page, SNVML_CommittedSlot[index]);
+    memcpy ((void *)&SNVML_p_Buffer[index * SNVML_RECORD_WORDS],
+            (const void *)p_record->Data,
+            (SNVML_RecordWords (index) * sizeof (uint32_t)));
+  }
+
+  return SNVML_ERROR_OK;
+}
+
+SNVML_Cmd_Status_t SNVML_Write (void (* Callback) (SNVML_Callback_Status_t))
+{
+  uint16_t index;
+  uint16_t changed = 0u;
+
+  if (SNVML_ModuleInit == FALSE)
+  {
+    return SNVML_ERROR_NOT_INIT;
+  }
+  if (SNVML_p_Buffer == NULL)
+  {
+    return SNVML_ERROR_NOT_REGISTERED;
+  }
+  if (SNVML_FlashOpState != SNVML_IDLE)
+  {
+    return SNVML_ERROR_CMD_PENDING;
+  }
+
+  for (index = 0u; index < SNVML_RecordCount; index++)
+  {
+    if (SNVML_IsRecordChanged (index) == TRUE)
+    {
+      changed++;
+    }
+  }
+  if (changed == 0u)
+  {
+    return SNVML_ERROR_UNCHANGED;
+  }
+
+  SNVML_Callback = Callback;
+  memset ((void *)SNVML_PendingSlot, 0xFF, sizeof (SNVML_PendingSlot));
+  SNVML_WriteIndex = 0u;
+
+  /* Not enough room for the changed records and their commit : all the records go to the other page */
+  if ((SNVML_PageValid == FALSE) || ((SNVML_NextSlot + changed + 1u) > SNVML_SLOT_NUMBER))
+  {
+    SNVML_Compaction = TRUE;
+    SNVML_WritePage = SNVML_Page ^ 1u;
+    SNVML_WriteSlot = 0u;
+    SNVML_FlashOpState = SNVML_ERASE_PAGE;
+  }
+  else
+  {
+    SNVML_Compaction = FALSE;
+    SNVML_WritePage = SNVML_Page;
+    SNVML_WriteSlot = SNVML_NextSlot;
+    SNVML_FlashOpState = SNVML_RECORD_WRITE;
+    while (SNVML_IsRecordChanged (SNVML_WriteIndex) == FALSE)
+    {
+      SNVML_WriteIndex++;
+    }
+    SNVML_BuildRecord (SNVML_WriteIndex, &SNVML_p_Buffer[SNVML_WriteIndex * SNVML_RECORD_WORDS],
+                       SNVML_RecordWords (SNVML_WriteIndex));
+  }
+
+  if (SNVML_FlashRequest () == FALSE)
+  {
+    SNVML_FlashOpState = SNVML_IDLE;
+    SNVML_Stats.Failures++;
+    return SNVML_ERROR_FLASH_ERROR;
+  }
+
+  return SNVML_ERROR_OK;
+}
+
+void SNVML_GetStats (SNVML_Stats_t * p_Stats)
+{
+  *p_Stats = SNVML_Stats;
+  p_Stats->FreeSlots = (SNVML_PageValid == TRUE) ? (uint16_t)(SNVML_SLOT_NUMBER - SNVML_NextSlot) : 0u;
+  p_Stats->Page = SNVML_Page;
+}
+
+/* Callback Definition ------------------------------------------------------*/
+static void SNVML_FlashManagerCallback (FM_FlashOp_Status_t Status)
+{
+  const SNVML_Record_t * p_record;
+
+  /* Flash Manager available again after a FM_BUSY : same operation requested again */
+  if (Status != FM_OPERATION_COMPLETE)
+  {
+    if (SNVML_FlashRequest () == FALSE)
+    {
+      SNVML_WriteEnd (SNVML_OPERATION_FAILED);
+    }
+    return;
+  }
+
+  switch (SNVML_FlashOpState)
+  {
+    case SNVML_ERASE_PAGE:
+    {
+      SNVML_Stats.Erases++;
+      SNVML_NextStep ();
+      break;
+    }
+
+    case SNVML_RECORD_WRITE:
+    case SNVML_COMMIT_WRITE:
+    {
+      /* Check that the record has been written correctly */
+      p_record = SNVML_GetRecord (SNVML_WritePage, SNVML_WriteSlot);
+      SNVML_WriteSlot++;
+      if (memcmp ((const void *)p_record, (const void *)&SNVML_WriteRecord, sizeof (SNVML_Record_t)) != 0)
+      {
+        SNVML_WriteEnd (SNVML_OPERATION_FAILED);
+      }
+      else if (SNVML_FlashOpState == SNVML_RECORD_WRITE)
+      {
+        SNVML_PendingSlot[SNVML_WriteIndex] = SNVML_WriteSlot - 1u;
+        SNVML_Stats.RecordWrites++;
+        SNVML_WriteIndex++;
+        SNVML_NextStep ();
+      }
+      else if (SNVML_Compaction == TRUE)
+      {
+        /* The new page becomes valid with its header */
+        SNVML_WritePageHeader.Magic = SNVML_PAGE_MAGIC;
+        SNVML_WritePageHeader.Sequence = SNVML_PageSequence + 1u;
+        SNVML_WritePageHeader.SequenceInv = ~SNVML_WritePageHeader.Sequence;
+        SNVML_WritePageHeader.Rfu = 0u;
+        SNVML_FlashOpState = SNVML_HEADER_WRITE;
+        if (SNVML_FlashRequest () == FALSE)
+        {
+          SNVML_WriteEnd (SNVML_OPERATION_FAILED);
+        }
+      }
+      else
+      {
+        SNVML_WriteEnd (SNVML_OPERATION_COMPLETE);
+      }
+      break;
+    }
+
+    case SNVML_HEADER_WRITE:
+    {
+      if (SNVML_IsPageValid (SNVML_WritePage) == FALSE)
+      {
+        SNVML_WriteEnd (SNVML_OPERATION_FAILED);
+      }
+      else
+      {
+        SNVML_Stats.Compactions++;
+        SNVML_WriteEnd (SNVML_OPERATION_COMPLETE);
+      }
+      break;
+    }
+
+    default:
+    {
+      break;
+    }
+  }
+}
+
+/* Private functions Definition ----------------------------------------------*/
+
+/**
+ * @brief Read the records of the current page : slots of the last committed records, next free slot and
+ *        sequence of the next write
+ */
+static void SNVML_ScanPage (void)
+{
+  const SNVML_Record_t * p_record;
+  uint16_t slot, index;
+  uint32_t lastSequence = 0u;
+  uint8_t sequenceFound = FALSE;
+
+  memset ((void *)SNVML_CommittedSlot, 0xFF, sizeof (SNVML_CommittedSlot));
+  memset ((void *)SNVML_PendingSlot, 0xFF, sizeof (SNVML_PendingSlot));
+  SNVML_CommitFound = FALSE;
+  SNVML_NextSlot = 0u;
+  SNVML_PageSequence = 0u;
+  SNVML_Sequence = 0u;
+
+  if (SNVML_PageValid == FALSE)
+  {
+    return;
+  }
+
+  SNVML_PageSequence = SNVML_GetPageHeader (SNVML_Page)->Sequence;
+
+  for (slot = 0u; slot < SNVML_SLOT_NUMBER; slot++)
+  {
+    p_record = SNVML_GetRecord (SNVML_Page, slot);
+    if (SNVML_IsErased ((const uint32_t *)p_record, SNVML_SLOT_WORDS) == TRUE)
+    {
+      continue;
+    }
+
+    /* Written slot, even if not valid (interrupted write) : the next records go after it */
+    SNVML_NextSlot = slot + 1u;
+    if (SNVML_IsRecordValid (p_record) == FALSE)
+    {
+      continue;
+    }
+
+    if ((sequenceFound == FALSE) || ((int32_t)(p_record->Sequence - lastSequence) > 0))
+    {
+      lastSequence = p_record->Sequence;
+      sequenceFound = TRUE;
+    }
+
+    if (p_record->Index == SNVML_INDEX_COMMIT)
+    {
+      /* Only the records of the same write are committed : those of an interrupted write are dropped */
+      for (index = 0u; index < SNVML_RECORD_MAX; index++)
+      {
+        if ((SNVML_PendingSlot[index] != SNVML_SLOT_NONE) &&
+            (SNVML_GetRecord (SNVML_Page, SNVML_PendingSlot[index])->Sequence == p_record->Sequence))
+        {
+          SNVML_CommittedSlot[index] = SNVML_PendingSlot[index];
+        }
+        SNVML_PendingSlot[index] = SNVML_SLOT_NONE;
+      }
+      SNVML_CommitFound = TRUE;
+    }
+    else if (p_record->Index < SNVML_RECORD_MAX)
+    {
+      SNVML_PendingSlot[p_record->Index] = slot;
+    }
+  }
+
+  SNVML_Sequence = lastSequence + 1u;
+}
+
+/**
+ * @brief Request the flash operation of the current step to the Flash Manager
+ *
+ * @return TRUE if the operation is requested or will be when the Flash Manager is available
+ */
+static uint8_t SNVML_FlashRequest (void)
+{
+  FM_Cmd_Status_t flashFunRet = FM_ERROR;
+
+  switch (SNVML_FlashOpState)
+  {
+    case SNVML_ERASE_PAGE:
+    {
+      flashFunRet = FM_Erase ((SNVML_StartSector + SNVML_WritePage), 1u, &SNVML_FlashCallback);
+      break;
+    }
+
+    case SNVML_RECORD_WRITE:
+    case SNVML_COMMIT_WRITE:
+    {
+      flashFunRet = FM_Write ((uint32_t *)&SNVML_WriteRecord,
+                              (uint32_t *)SNVML_GetRecord (SNVML_WritePage, SNVML_WriteSlot),
+                              (int32_t)SNVML_SLOT_WORDS,
+                              &SNVML_FlashCallback);
+      break;
+    }
+
+    case SNVML_HEADER_WRITE:
+    {
+      flashFunRet = FM_Write ((uint32_t *)&SNVML_WritePageHeader,
+                              (uint32_t *)SNVML_GetPageHeader (SNVML_WritePage),
+                              (int32_t)(sizeof (SNVML_PageHeader_t) / sizeof (uint32_t)),
+                              &SNVML_FlashCallback);
+      break;
+    }
+
+    default:
+    {
+      break;
+    }
+  }
+
+  /* FM_BUSY : the callback is called when the Flash Manager is available */
+  return (flashFunRet == FM_ERROR) ? FALSE : TRUE;
+}
+
+/**
+ * @brief Write the next changed record (all the records in a compaction), or the commit once they are written
+ */
+static void SNVML_NextStep (void)
+{
+  uint32_t count = SNVML_RecordCount;
+
+  while ((SNVML_WriteIndex < SNVML_RecordCount) &&
+         (SNVML_Compaction == FALSE) &&
+         (SNVML_IsRecordChanged (SNVML_WriteIndex) == FALSE))
+  {
+    SNVML_WriteIndex++;
+  }
+
+  if (SNVML_WriteIndex < SNVML_RecordCount)
+  {
+    SNVML_FlashOpState = SNVML_RECORD_WRITE;
+    SNVML_BuildRecord (SNVML_WriteIndex, &SNVML_p_Buffer[SNVML_WriteIndex * SNVML_RECORD_WORDS],
+                       SNVML_RecordWords (SNVML_WriteIndex));
+  }
+  else
+  {
+    SNVML_FlashOpState = SNVML_COMMIT_WRITE;
+    SNVML_BuildRecord (SNVML_INDEX_COMMIT, &count, 1u);
+  }
+
+  if (SNVML_FlashRequest () == FALSE)
+  {
+    SNVML_WriteEnd (SNVML_OPERATION_FAILED);
+  }
+}
+
+/**
+ * @brief End of a write : on success, the records written become the committed ones
+ *
+ * @param Status: Status of the write
+ */
+static void SNVML_WriteEnd (SNVML_Callback_Status_t Status)
+{
+  uint16_t index;
+  void (* callback) (SNVML_Callback_Status_t) = SNVML_Callback;
+
+  if (Status == SNVML_OPERATION_COMPLETE)
+  {
+    if (SNVML_Compaction == TRUE)
+    {
+      memcpy ((void *)SNVML_CommittedSlot, (const void *)SNVML_PendingSlot, sizeof (SNVML_CommittedSlot));
+      SNVML_Page = SNVML_WritePage;
+      SNVML_PageValid = TRUE;
+      SNVML_PageSequence = SNVML_WritePageHeader.Sequence;
+    }
+    else
+    {
+      for (index = 0u; index < SNVML_RecordCount; index++)
+      {
+        if (SNVML_PendingSlot[index] != SNVML_SLOT_NONE)
+        {
+          SNVML_CommittedSlot[index] = SNVML_PendingSlot[index];
+        }
+      }
+    }
+    SNVML_CommitFound = TRUE;
+    SNVML_Stats.CommitWrites++;
+  }
+  else
+  {
+    SNVML_Stats.Failures++;
+    /* The slot of the failed write is not reused */
+    if ((SNVML_Compaction == FALSE) && (SNVML_FlashOpState != SNVML_ERASE_PAGE) &&
+        (SNVML_WriteSlot < SNVML_SLOT_NUMBER) &&
+        (SNVML_IsErased ((const uint32_t *)SNVML_GetRecord (SNVML_WritePage, SNVML_WriteSlot), SNVML_SLOT_WORDS) == FALSE))
+    {
+      SNVML_WriteSlot++;
+    }
+  }
+
+  /* Records appended in the current page, even by a failed write */
+  if ((SNVML_Compaction == FALSE) || (Status == SNVML_OPERATION_COMPLETE))
+  {
+    SNVML_NextSlot = SNVML_WriteSlot;
+  }
+
+  /* The records of this write are never taken by an other commit */
+  SNVML_Sequence++;
+  memset ((void *)SNVML_PendingSlot, 0xFF, sizeof (SNVML_PendingSlot));
+  SNVML_FlashOpState = SNVML_IDLE;
+
+  if (callback != NULL)
+  {
+    callback (Status);
+  }
+}
+
+/**
+ * @brief Prepare the record to write
+ *
+ * @param Index: Index of the record, SNVML_INDEX_COMMIT for a commit
+ * @param p_Data: Data of the record
+ * @param Words: Size of the data in words, the rest of the record is set to zero
+ */
+static void SNVML_BuildRecord (uint16_t Index, const uint32_t * p_Data, uint32_t Words)
+{
+  memset ((void *)&SNVML_WriteRecord, 0x00, sizeof (SNVML_WriteRecord));
+  SNVML_WriteRecord.Magic = SNVML_RECORD_MAGIC;
+  SNVML_WriteRecord.Index = Index;
+  SNVML_WriteRecord.IndexInv = (uint16_t)~Index;
+  SNVML_WriteRecord.Sequence = SNVML_Sequence;
+  memcpy ((void *)SNVML_WriteRecord.Data, (const void *)p_Data, (Words * sizeof (uint32_t)));
+  SNVML_WriteRecord.Hash = SNVML_RecordHash (&SNVML_WriteRecord);
+}
+
+/**
+ * @brief Compare a record of the buffer with its last committed copy
+ *
+ * @param Index: Index of the record
+ *
+ * @return TRUE if the record shall be written
+ */
+static uint8_t SNVML_IsRecordChanged (uint16_t Index)
+{
+  const SNVML_Record_t * p_record;
+
+  if ((SNVML_CommitFound == FALSE) || (SNVML_CommittedSlot[Index] == SNVML_SLOT_NONE))
+  {
+    return TRUE;
+  }
+
+  p_record = SNVML_GetRecord (SNVML_Page, SNVML_CommittedSlot[Index]);
+
+  return (memcmp ((const void *)p_record->Data,
+                  (const void *)&SNVML_p_Buffer[Index * SNVML_RECORD_WORDS],
+                  (SNVML_RecordWords (Index) * sizeof (uint32_t))) != 0) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Size of a record of the buffer : the last one can be shorter
+ *
+ * @param Index: Index of the record
+ *
+ * @return Size in words
+ */
+static uint32_t SNVML_RecordWords (uint16_t Index)
+{
+  uint32_t offset = (uint32_t)Index * SNVML_RECORD_WORDS;
+
+  return ((SNVML_BufferSize - offset) < SNVML_RECORD_WORDS) ? (SNVML_BufferSize - offset) : SNVML_RECORD_WORDS;
+}
+
+/**
+ * @brief Integrity check of a record (FNV-1a on the index, sequence and data words)
+ *
+ * @param p_Record: Record
+ *
+ * @return Hash value
+ */
+static uint32_t SNVML_RecordHash (const SNVML_Record_t * p_Record)
+{
+  uint32_t hash = SNVML_HASH_INIT;
+  uint32_t cnt;
+
+  hash = (hash ^ (((uint32_t)p_Record->IndexInv << 16) | p_Record->Index)) * SNVML_HASH_PRIME;
+  hash = (hash ^ p_Record->Sequence) * SNVML_HASH_PRIME;
+  for (cnt = 0u; cnt < SNVML_RECORD_WORDS; cnt++)
+  {
+    hash = (hash ^ p_Record->Data[cnt]) * SNVML_HASH_PRIME;
+  }
+
+  return hash;
+}
+
+static uint8_t SNVML_IsRecordValid (const SNVML_Record_t * p_Record)
+{
+  return ((p_Record->Magic == SNVML_RECORD_MAGIC) &&
+          ((p_Record->Index ^ p_Record->IndexInv) == 0xFFFFu) &&
+          (p_Record->Hash == SNVML_RecordHash (p_Record))) ? TRUE : FALSE;
+}
+
+static uint8_t SNVML_IsErased (const uint32_t * p_Data, uint32_t Words)
+{
+  uint32_t cnt;
+
+  for (cnt = 0u; cnt < Words; cnt++)
+  {
+    if (p_Data[cnt] != SNVML_ERASED_CONTENT)
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static uint8_t SNVML_IsPageValid (uint8_t Page)
+{
+  const SNVML_PageHeader_t * p_header = SNVML_GetPageHeader (Page);
+
+  return ((p_header->Magic == SNVML_PAGE_MAGIC) &&
+          (p_header->Sequence == ~p_header->SequenceInv)) ? TRUE : FALSE;
+}
+
+static const SNVML_PageHeader_t * SNVML_GetPageHeader (uint8_t Page)
+{
+  return (const SNVML_PageHeader_t *)(SNVML_StartAddress + ((uint32_t)Page * FLASH_PAGE_SIZE));
+}
+
+static const SNVML_Record_t * SNVML_GetRecord (uint8_t Page, uint16_t Slot)
+{
+  return (const SNVML_Record_t *)(SNVML_StartAddress + ((uint32_t)Page * FLASH_PAGE_SIZE) +
+                                  sizeof (SNVML_PageHeader_t) + ((uint32_t)Slot * SNVML_SLOT_SIZE));
+}
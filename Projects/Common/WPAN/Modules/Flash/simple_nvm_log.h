@@ -0,0 +1,153 @@
+/**
+  ******************************************************************************
+  * @file    simple_nvm_log.h
+  * @author  MCD Application Team
+  * @brief   Header for simple_nvm_log.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SIMPLE_NVM_LOG_H
+#define SIMPLE_NVM_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "simple_nvm_log_conf.h"
+
+#include "utilities_common.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/* Simple NVM Log command status */
+typedef enum
+{
+  SNVML_ERROR_OK,                 /* The command is done, or the write is scheduled */
+  SNVML_ERROR_NOK,                /* Unexpected error */
+  SNVML_ERROR_NOT_INIT,           /* SNVML_Init not called */
+  SNVML_ERROR_ALREADY_INIT,       /* SNVML_Init already called */
+  SNVML_ERROR_NVM_NULL,           /* No start address */
+  SNVML_ERROR_NVM_NOT_ALIGNED,    /* Start address not on a flash page */
+  SNVML_ERROR_NVM_OVERLAP_FLASH,  /* The pages of the log go beyond the flash */
+  SNVML_ERROR_NOT_REGISTERED,     /* SNVML_Register not called */
+  SNVML_ERROR_BUFFER_NULL,        /* No buffer */
+  SNVML_ERROR_BUFFER_NOT_ALIGNED, /* Buffer not aligned on 32 bits */
+  SNVML_ERROR_BUFFER_SIZE,        /* Buffer larger than SNVML_RECORD_MAX records */
+  SNVML_ERROR_CMD_PENDING,        /* A write is on going */
+  SNVML_ERROR_NVM_EMPTY,          /* Nothing committed in the log */
+  SNVML_ERROR_NVM_CORRUPTED,      /* Records of the buffer missing in the log */
+  SNVML_ERROR_UNCHANGED,          /* The buffer is the same as the log, nothing written */
+  SNVML_ERROR_FLASH_ERROR         /* The Flash Manager refused the operation */
+} SNVML_Cmd_Status_t;
+
+/* Simple NVM Log write status */
+typedef enum
+{
+  SNVML_OPERATION_COMPLETE,       /* The changed records and their commit are written */
+  SNVML_OPERATION_FAILED          /* The write has failed, the log keeps the previous commit */
+} SNVML_Callback_Status_t;
+
+/* Statistics of the log since the boot */
+typedef struct
+{
+  uint32_t RecordWrites;          /* Records appended */
+  uint32_t CommitWrites;          /* Writes of the buffer committed */
+  uint32_t Erases;                /* Pages erased */
+  uint32_t Compactions;           /* Full rewrites in the other page */
+  uint32_t Failures;              /* Writes failed */
+  uint16_t FreeSlots;             /* Records that can still be appended in the current page */
+  uint8_t  Page;                  /* Current page */
+} SNVML_Stats_t;
+
+/* Exported variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+/**
+ * @brief  Initialize the Simple NVM Log : the two pages are read to find the last committed records
+ *
+ * @param p_NvmStartAddress: Start address of the two pages of the log - Shall be aligned on a flash page
+ *
+ * @return Status of the command
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_OK
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_ALREADY_INIT
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NVM_NULL
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NVM_NOT_ALIGNED
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NVM_OVERLAP_FLASH
+ */
+SNVML_Cmd_Status_t SNVML_Init (const uint32_t * p_NvmStartAddress);
+
+/**
+ * @brief  Register the user buffer, cut in records of SNVML_RECORD_SIZE bytes
+ *
+ * @param p_BufferAddress: Address of the buffer to be registered - Shall be aligned 32 bits
+ * @param BufferSize: Size of the buffer to be registered in words (32 bits)
+ *
+ * @return Status of the command
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_OK
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NOT_INIT
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_CMD_PENDING
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_BUFFER_NULL
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_BUFFER_NOT_ALIGNED
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_BUFFER_SIZE
+ */
+SNVML_Cmd_Status_t SNVML_Register (uint32_t * p_BufferAddress,
+                                   const uint32_t BufferSize);
+
+/**
+ * @brief  Restore the user buffer from the last committed records
+ *
+ * @return Status of the command
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_OK
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NOT_INIT
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NOT_REGISTERED
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_CMD_PENDING
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NVM_EMPTY
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NVM_CORRUPTED
+ */
+SNVML_Cmd_Status_t SNVML_Restore (void);
+
+/**
+ * @brief  Write the user buffer : only the records that differ from the log are appended, then a commit record.
+ *         When the current page is full, all the records are written in the other page (compaction).
+ *
+ * @details The buffer shall not be modified until the callback is called.
+ *
+ * @param Callback: Callback function for operation status return - Can be NULL
+ *
+ * @return Status of the command
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_OK
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NOT_INIT
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_NOT_REGISTERED
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_CMD_PENDING
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_UNCHANGED   (no callback)
+ * @retval SNVML_Cmd_Status_t::SNVML_ERROR_FLASH_ERROR (no callback)
+ */
+SNVML_Cmd_Status_t SNVML_Write (void (* Callback) (SNVML_Callback_Status_t));
+
+/**
+ * @brief  Get the statistics of the log
+ *
+ * @param p_Stats: Statistics to fill
+ */
+void SNVML_GetStats (SNVML_Stats_t * p_Stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*SIMPLE_NVM_LOG_H */
@@ -31,6 +31,18 @@
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
+#if (LOG_RATE_LIMIT != 0)
+/* Token bucket of a region, the tokens are counted in thousandths of log */
+typedef struct
+{
+  uint32_t      tokens;
+  uint32_t      last_time;
+  uint32_t      suppressed_nbr;
+  uint16_t      message_per_second;
+  uint16_t      burst;
+} Log_Rate_Limit_t;
+#endif /* LOG_RATE_LIMIT != 0 */
+
 /* USER CODE BEGIN PTD */
 
 /* USER CODE END PTD */
@@ -39,11 +51,34 @@
 /* Definition of 'End Of Line' */
 #define ENDOFLINE_SIZE          (0x01u)
 #define ENDOFLINE_CHAR          '\n'
+
+/* Binary trace frame : sync, payload size, verbose level, region, time stamp, format address, payload */
+#define BINARY_SYNC_CHAR        (0xA5u)
+#define BINARY_HEADER_SIZE      (12u)
+#define BINARY_FRAME_SIZE       (LOG_BINARY_FRAME_SIZE_MAX)
+
+/* Zero-copy trace : room for the color and the time stamp, formatted before the text */
+#define ZERO_COPY_PREFIX_SIZE   (32u)
+
+/* Hexadecimal dump : number of bytes per log line */
+#define HEX_DUMP_BYTES_PER_LINE (16u)
+
+#if defined(__GNUC__)
+#define LOG_NOINLINE            __attribute__((noinline))
+#else /* defined(__GNUC__) */
+#define LOG_NOINLINE
+#endif /* defined(__GNUC__) */
 /* USER CODE BEGIN PD */
 
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
+#if (LOG_INSERT_BINARY_TRACE != 0)
+#define LOG_BINARY_MODE()       (log_binary_mode)
+#else /* LOG_INSERT_BINARY_TRACE != 0 */
+#define LOG_BINARY_MODE()       (false)
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
+
 /* USER CODE BEGIN PM */
 
 /* USER CODE END PM */
@@ -77,10 +112,23 @@ const Log_Color_t LOG_COLOR_DEFAULT_CONFIGURATION[] =
 /* USER CODE END EC */
 
 /* Private variables ---------------------------------------------------------*/
+static const char               hex_digits[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
+                                                   '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
 static uint32_t                 current_region_mask;
 static Log_Verbose_Level_t      current_verbose_level;
 static Log_Color_t              current_color_list[32];
 CallBack_TimeStamp *            log_timestamp_function;
+CallBack_BinaryTimeStamp *      log_binary_timestamp_function;
+#if (LOG_INSERT_BINARY_TRACE != 0)
+static bool                     log_binary_mode = true;
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
+#if (LOG_INSERT_CAPTURE != 0)
+static CallBack_Capture *       log_capture_function;
+#endif /* LOG_INSERT_CAPTURE != 0 */
+#if (LOG_RATE_LIMIT != 0)
+static Log_Rate_Limit_t         rate_limit_list[LOG_RATE_LIMIT_REGION_NBR];
+static CallBack_Tick *          log_tick_function;
+#endif /* LOG_RATE_LIMIT != 0 */
 /* USER CODE BEGIN PV */
 
 /* USER CODE END PV */
@@ -91,6 +139,41 @@ static uint32_t Get_Region_Mask(Log_Region_t Region);
 #if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
 static uint16_t RegionToColor(char * TextBuffer, uint16_t SizeMax, Log_Region_t Region);
 #endif /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0  */
+
+#if (LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0)
+static uint16_t TimeStampToText(char * TextBuffer, uint16_t SizeMax);
+#endif /* LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0 */
+
+static uint16_t LogPrefix(char * TextBuffer, uint16_t SizeMax, Log_Region_t Region);
+static uint16_t HexToText(char * TextBuffer, const uint8_t * Data, uint16_t Size, char Separator);
+
+#if (LOG_INSERT_BINARY_TRACE != 0) || (LOG_INSERT_CAPTURE != 0)
+static uint16_t BinaryPayload(uint8_t * Payload, uint16_t SizeMax, const char * Text, va_list Args);
+static uint16_t BinaryFrame(uint8_t * Frame, Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args);
+#endif /* (LOG_INSERT_BINARY_TRACE != 0) || (LOG_INSERT_CAPTURE != 0) */
+#if (LOG_INSERT_BINARY_TRACE != 0)
+static void LogOutputBinary(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args);
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
+#if (LOG_INSERT_CAPTURE != 0)
+static void LogCapture(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args);
+#endif /* LOG_INSERT_CAPTURE != 0 */
+#if (LOG_ZERO_COPY_TRACE != 0)
+static uint16_t FifoCopy(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, const char * Data, uint16_t Size);
+static uint16_t FifoPrint(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, uint16_t Size, const char * Text, va_list Args);
+static uint16_t FifoPrintWrapped(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, uint16_t Size, const char * Text, va_list Args);
+static uint16_t FifoHex(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, const uint8_t * Data, uint16_t Size, char Separator);
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+static void LogOutput(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args);
+static void LogOutputFormat(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, ...);
+static bool LogAllowed(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region);
+static void HexLineFormat(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator);
+#if (LOG_ZERO_COPY_TRACE != 0)
+static bool HexLineZeroCopy(Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator);
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+
+#if (LOG_RATE_LIMIT != 0)
+static bool RateLimitAllow(Log_Region_t Region, uint32_t * SuppressedNbr);
+#endif /* LOG_RATE_LIMIT != 0 */
 /* USER CODE BEGIN PFP */
 
 /* USER CODE END PFP */
@@ -141,42 +224,522 @@ static uint16_t RegionToColor(char * TextBuffer, uint16_t SizeMax, Log_Region_t
 }
 #endif /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0  */
 
-void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+#if (LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0)
+/**
+ * @brief Insert the Time Stamp on the start of Log sentence.
+ *        Without text callback, the value of the binary Time Stamp callback is written in decimal, without printf.
+ *
+ * @param TextBuffer    Pointer on the log buffer
+ * @param SizeMax       The maximum number of bytes that will be written to the buffer.
+ *
+ * @return Length of the Time Stamp.
+ */
+static uint16_t TimeStampToText(char * TextBuffer, uint16_t SizeMax)
 {
-  uint16_t tmp_size = 0;
-  uint16_t buffer_size = 0;
+  uint16_t      text_length = 0;
+  uint16_t      digit_nbr = 0;
+  uint32_t      time_stamp;
+  char          digits[10];
+
+  if (log_timestamp_function != NULL)
+  {
+    log_timestamp_function(TextBuffer, SizeMax, &text_length);
+  }
+  else if (log_binary_timestamp_function != NULL)
+  {
+    time_stamp = log_binary_timestamp_function();
+    do
+    {
+      digits[digit_nbr++] = (char)('0' + (time_stamp % 10u));
+      time_stamp /= 10u;
+    } while (time_stamp != 0u);
+
+    /* "[" + digits + "] " */
+    if ((digit_nbr + 3u) <= SizeMax)
+    {
+      TextBuffer[text_length++] = '[';
+      while (digit_nbr != 0u)
+      {
+        TextBuffer[text_length++] = digits[--digit_nbr];
+      }
+      TextBuffer[text_length++] = ']';
+      TextBuffer[text_length++] = ' ';
+    }
+  }
+
+  return text_length;
+}
+#endif /* LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0 */
+
+/**
+ * @brief Insert the color and the Time Stamp on the start of Log sentence.
+ *
+ * @param TextBuffer    Pointer on the log buffer
+ * @param SizeMax       The maximum number of bytes that will be written to the buffer.
+ * @param Region        Region of the log.
+ *
+ * @return Length of the prefix.
+ */
+static uint16_t LogPrefix(char * TextBuffer, uint16_t SizeMax, Log_Region_t Region)
+{
+  uint16_t prefix_size = 0;
+
+#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
+  /* Add the color matching the region */
+  prefix_size += RegionToColor(&TextBuffer[prefix_size], (SizeMax - prefix_size), Region);
+#else /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 */
+  UNUSED(Region);
+#endif /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 */
+
+#if (LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0)
+  prefix_size += TimeStampToText(&TextBuffer[prefix_size], (SizeMax - prefix_size));
+#endif /* LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0 */
+
+  return prefix_size;
+}
+
+/**
+ * @brief Convert bytes in hexadecimal text, two digits per byte from a table, without null character.
+ *
+ * @param TextBuffer    Pointer on the text buffer, of at least 3 bytes per byte to convert.
+ * @param Data          The bytes to convert.
+ * @param Size          Number of bytes.
+ * @param Separator     Character between two bytes, or '\0' for none.
+ *
+ * @return Length of the text.
+ */
+static uint16_t HexToText(char * TextBuffer, const uint8_t * Data, uint16_t Size, char Separator)
+{
+  uint16_t text_length = 0;
+
+  for (uint16_t index = 0u; index < Size; index++)
+  {
+    if ((Separator != '\0') && (index != 0u))
+    {
+      TextBuffer[text_length++] = Separator;
+    }
+    TextBuffer[text_length++] = hex_digits[Data[index] >> 4];
+    TextBuffer[text_length++] = hex_digits[Data[index] & 0x0Fu];
+  }
+
+  return text_length;
+}
+
+#if (LOG_INSERT_BINARY_TRACE != 0) || (LOG_INSERT_CAPTURE != 0)
+/**
+ * @brief Store the arguments of a log, as described by its format string.
+ *        Integers and pointers take 4 bytes, 64 bits integers and floating numbers take 8 bytes,
+ *        strings are copied with their null character.
+ *
+ * @param Payload       Pointer on the payload buffer
+ * @param SizeMax       The maximum number of bytes that will be written to the buffer.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return Length of the payload.
+ */
+static uint16_t BinaryPayload(uint8_t * Payload, uint16_t SizeMax, const char * Text, va_list Args)
+{
+  uint16_t      payload_size = 0;
+  uint8_t       long_number;
+  uint32_t      word;
+  uint64_t      double_word;
+  double        floating;
+  const char *  string;
+
+  while (*Text != 0)
+  {
+    if (*Text++ != '%')
+    {
+      continue;
+    }
+
+    /* Flags, width and precision. A '*' consumes an int argument */
+    long_number = 0;
+    while ((*Text != 0) && (strchr("-+ #0123456789.*", *Text) != NULL))
+    {
+      if ((*Text == '*') && ((payload_size + 4u) <= SizeMax))
+      {
+        word = va_arg(Args, uint32_t);
+        memcpy(&Payload[payload_size], &word, 4u);
+        payload_size += 4u;
+      }
+      Text++;
+    }
+
+    /* Length modifiers, only 'll' and 'j' change the size of the argument */
+    while ((*Text != 0) && (strchr("hlLjzt", *Text) != NULL))
+    {
+      if ((*Text == 'j') || ((*Text == 'l') && (Text[1] == 'l')))
+      {
+        long_number = 1;
+      }
+      Text++;
+    }
+
+    switch (*Text)
+    {
+      case 0:
+        return payload_size;
+
+      case '%':
+        break;
+
+      case 's':
+        string = va_arg(Args, const char *);
+        if (string == NULL)
+        {
+          string = "(null)";
+        }
+        while ((*string != 0) && ((payload_size + 1u) < SizeMax))
+        {
+          Payload[payload_size++] = (uint8_t)*string++;
+        }
+        if (payload_size < SizeMax)
+        {
+          Payload[payload_size++] = 0;
+        }
+        break;
+
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        floating = va_arg(Args, double);
+        if ((payload_size + 8u) <= SizeMax)
+        {
+          memcpy(&Payload[payload_size], &floating, 8u);
+          payload_size += 8u;
+        }
+        break;
+
+      default:
+        if (long_number != 0)
+        {
+          double_word = va_arg(Args, uint64_t);
+          if ((payload_size + 8u) <= SizeMax)
+          {
+            memcpy(&Payload[payload_size], &double_word, 8u);
+            payload_size += 8u;
+          }
+        }
+        else
+        {
+          word = va_arg(Args, uint32_t);
+          if ((payload_size + 4u) <= SizeMax)
+          {
+            memcpy(&Payload[payload_size], &word, 4u);
+            payload_size += 4u;
+          }
+        }
+        break;
+    }
+
+    Text++;
+  }
+
+  return payload_size;
+}
+
+/**
+ * @brief Build the binary frame of a log, rendered by the host from the format string found in the ELF file.
+ *
+ * @param Frame         Pointer on the frame buffer, of BINARY_FRAME_SIZE bytes.
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return Length of the frame.
+ */
+static uint16_t BinaryFrame(uint8_t * Frame, Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+{
+  uint32_t word;
+  uint16_t payload_size;
+
+  payload_size = BinaryPayload(&Frame[BINARY_HEADER_SIZE], (BINARY_FRAME_SIZE - BINARY_HEADER_SIZE), Text, Args);
+
+  Frame[0] = BINARY_SYNC_CHAR;
+  Frame[1] = (uint8_t)payload_size;
+  Frame[2] = (uint8_t)VerboseLevel;
+  Frame[3] = (uint8_t)Region;
+  word = (log_binary_timestamp_function != NULL) ? log_binary_timestamp_function() : 0u;
+  memcpy(&Frame[4], &word, 4u);
+  word = (uint32_t)Text;
+  memcpy(&Frame[8], &word, 4u);
+
+  return (BINARY_HEADER_SIZE + payload_size);
+}
+#endif /* (LOG_INSERT_BINARY_TRACE != 0) || (LOG_INSERT_CAPTURE != 0) */
+
+#if (LOG_INSERT_BINARY_TRACE != 0)
+/**
+ * @brief Send a log in binary form.
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return None.
+ */
+static void LogOutputBinary(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+{
+  uint8_t frame[BINARY_FRAME_SIZE];
+  uint16_t frame_size;
+
+  frame_size = BinaryFrame(frame, VerboseLevel, Region, Text, Args);
+
+  UTIL_ADV_TRACE_Send(frame, frame_size);
+}
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
+
+#if (LOG_INSERT_CAPTURE != 0)
+/**
+ * @brief Give the binary frame of a log to the capture function. The arguments are left for the output.
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return None.
+ */
+static void LogCapture(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+{
+  uint8_t frame[BINARY_FRAME_SIZE];
+  uint16_t frame_size;
+  va_list args_copy;
+  CallBack_Capture * capture_function = log_capture_function;
+
+  if (capture_function == NULL)
+  {
+    return;
+  }
+
+  va_copy(args_copy, Args);
+  frame_size = BinaryFrame(frame, VerboseLevel, Region, Text, args_copy);
+  va_end(args_copy);
+
+  capture_function(frame, frame_size);
+}
+#endif /* LOG_INSERT_CAPTURE != 0 */
+
+#if (LOG_ZERO_COPY_TRACE != 0)
+/**
+ * @brief Copy data inside the space allocated in the trace FIFO.
+ *
+ * @param Fifo          Pointer on the trace FIFO
+ * @param FifoSize      Size of the trace FIFO.
+ * @param WritePos      Position of the first byte to write.
+ * @param Data          Data to copy.
+ * @param Size          Number of bytes to copy.
+ *
+ * @return Position following the copied data.
+ */
+static uint16_t FifoCopy(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, const char * Data, uint16_t Size)
+{
+  for (uint16_t index = 0u; index < Size; index++)
+  {
+    Fifo[WritePos] = (uint8_t)Data[index];
+    WritePos = (uint16_t)((WritePos + 1u) % FifoSize);
+  }
+
+  return WritePos;
+}
+
+/**
+ * @brief Format the text directly inside the space allocated in the trace FIFO.
+ *        The null character of vsnprintf lands on the byte following the allocated space, which
+ *        the trace FIFO always keeps free (or on the End Of Line slot, written afterwards).
+ *
+ * @param Fifo          Pointer on the trace FIFO
+ * @param FifoSize      Size of the trace FIFO.
+ * @param WritePos      Position of the first byte to write.
+ * @param Size          Number of characters to write.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return Position following the text.
+ */
+static uint16_t FifoPrint(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, uint16_t Size, const char * Text, va_list Args)
+{
+  if ((WritePos + Size) >= FifoSize)
+  {
+    /* The allocated space wraps around the end of the FIFO */
+    return FifoPrintWrapped(Fifo, FifoSize, WritePos, Size, Text, Args);
+  }
+
+  (void)vsnprintf((char *)&Fifo[WritePos], (Size + 1u), Text, Args);
+
+  return (uint16_t)(WritePos + Size);
+}
+
+/**
+ * @brief Format the text in a temporary buffer and copy it in the two parts of the allocated space.
+ *        Only the wrapped allocations need it, which cannot happen with UTIL_ADV_TRACE_UNCHUNK_MODE.
+ *        Kept out of line so that its buffer is not on the stack of every log.
+ *
+ * @param Fifo          Pointer on the trace FIFO
+ * @param FifoSize      Size of the trace FIFO.
+ * @param WritePos      Position of the first byte to write.
+ * @param Size          Number of characters to write.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return Position following the text.
+ */
+LOG_NOINLINE static uint16_t FifoPrintWrapped(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, uint16_t Size, const char * Text, va_list Args)
+{
+  char text[UTIL_ADV_TRACE_TMP_BUF_SIZE + 1u];
+
+  (void)vsnprintf(text, (Size + 1u), Text, Args);
+
+  return FifoCopy(Fifo, FifoSize, WritePos, text, Size);
+}
+
+/**
+ * @brief Convert bytes in hexadecimal text directly inside the space allocated in the trace FIFO.
+ *
+ * @param Fifo          Pointer on the trace FIFO
+ * @param FifoSize      Size of the trace FIFO.
+ * @param WritePos      Position of the first byte to write.
+ * @param Data          The bytes to convert.
+ * @param Size          Number of bytes.
+ * @param Separator     Character between two bytes, or '\0' for none.
+ *
+ * @return Position following the text.
+ */
+static uint16_t FifoHex(uint8_t * Fifo, uint16_t FifoSize, uint16_t WritePos, const uint8_t * Data, uint16_t Size, char Separator)
+{
+  char text[3];
+  uint16_t text_length;
+
+  for (uint16_t index = 0u; index < Size; index++)
+  {
+    text_length = 0;
+    if ((Separator != '\0') && (index != 0u))
+    {
+      text[text_length++] = Separator;
+    }
+    text[text_length++] = hex_digits[Data[index] >> 4];
+    text[text_length++] = hex_digits[Data[index] & 0x0Fu];
+
+    if ((WritePos + text_length) < FifoSize)
+    {
+      memcpy(&Fifo[WritePos], text, text_length);
+      WritePos += text_length;
+    }
+    else
+    {
+      WritePos = FifoCopy(Fifo, FifoSize, WritePos, text, text_length);
+    }
+  }
+
+  return WritePos;
+}
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+
+/**
+ * @brief Format the log and send it to ADV Traces.
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The format string.
+ * @param Args          The arguments.
+ *
+ * @return None.
+ */
+static void LogOutput(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+{
+#if (LOG_ZERO_COPY_TRACE != 0)
+  uint16_t tmp_size;
+  uint16_t prefix_size;
+  uint16_t text_size;
+  uint16_t eol_size = 0;
+  int text_length;
+  char prefix[ZERO_COPY_PREFIX_SIZE];
+  va_list args_copy;
+  uint8_t * p_fifo;
+  uint16_t fifo_size;
+  uint16_t write_pos;
+#else /* LOG_ZERO_COPY_TRACE != 0 */
+  uint16_t tmp_size;
+  uint16_t buffer_size;
   char full_text[UTIL_ADV_TRACE_TMP_BUF_SIZE + 1u];
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
 
-  /* USER CODE BEGIN Log_Module_PrintWithArg_1 */
+#if (LOG_INSERT_CAPTURE != 0)
+  LogCapture(VerboseLevel, Region, Text, Args);
+#endif /* LOG_INSERT_CAPTURE != 0 */
 
-  /* USER CODE END Log_Module_PrintWithArg_1 */
+#if (LOG_INSERT_BINARY_TRACE != 0)
+  if (log_binary_mode != false)
+  {
+    LogOutputBinary(VerboseLevel, Region, Text, Args);
+    return;
+  }
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
 
-  /* If the verbose level of the given log is not enabled, then we do not print the log */
-  if (VerboseLevel > current_verbose_level)
+#if (LOG_ZERO_COPY_TRACE != 0)
+  /* Color and time stamp */
+  prefix_size = LogPrefix(prefix, ZERO_COPY_PREFIX_SIZE, Region);
+
+  /* Size of the text, limited as in the buffered mode */
+  va_copy(args_copy, Args);
+  text_length = vsnprintf(NULL, 0u, Text, args_copy);
+  va_end(args_copy);
+  if (text_length < 0)
   {
     return;
   }
 
-  /* If the region for the given log is not enabled, then we do not print the log */
-  if ((Get_Region_Mask(Region) & current_region_mask) == 0u)
+  text_size = (uint16_t)(UTIL_ADV_TRACE_TMP_BUF_SIZE - 1u - prefix_size);
+  if ((uint32_t)text_length < text_size)
+  {
+    text_size = (uint16_t)text_length;
+  }
+
+#if (LOG_INSERT_EOL_INSIDE_THE_TRACE != 0)
+  /* The space is allocated before formatting: the End Of Line is decided on the format string */
+  if ((prefix_size + text_size) > 1u)
+  {
+    tmp_size = (uint16_t)strlen(Text);
+    if (((uint32_t)text_length != text_size) || (tmp_size < 2u)
+        || ((Text[tmp_size - 1u] != ENDOFLINE_CHAR) && (Text[tmp_size - 2u] != ENDOFLINE_CHAR)))
+    {
+      eol_size = ENDOFLINE_SIZE;
+    }
+  }
+#endif /* LOG_INSERT_EOL_INSIDE_THE_TRACE != 0 */
+
+  /* Reserve the space in the trace FIFO, the log is dropped when it is full (as with UTIL_ADV_TRACE_Send) */
+  if (UTIL_ADV_TRACE_ZCSend_Allocation((prefix_size + text_size + eol_size), &p_fifo, &fifo_size, &write_pos) != UTIL_ADV_TRACE_OK)
   {
     return;
   }
 
-#if (LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0)
-  /* Add to full_text the color matching the region */
-  tmp_size = RegionToColor(&full_text[buffer_size], (UTIL_ADV_TRACE_TMP_BUF_SIZE - buffer_size), Region);
-  buffer_size += tmp_size;
-#endif /* LOG_INSERT_COLOR_INSIDE_THE_TRACE != 0 */
+  write_pos = FifoCopy(p_fifo, fifo_size, write_pos, prefix, prefix_size);
+  write_pos = FifoPrint(p_fifo, fifo_size, write_pos, text_size, Text, Args);
 
-#if (LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0)
-  if (log_timestamp_function != NULL)
+  /* USER CODE BEGIN Log_Module_PrintWithArg_ZC */
+
+  /* USER CODE END Log_Module_PrintWithArg_ZC */
+
+  if (eol_size != 0u)
   {
-     tmp_size = UTIL_ADV_TRACE_TMP_BUF_SIZE - buffer_size;
-     log_timestamp_function(&full_text[buffer_size], tmp_size, &tmp_size);
-     buffer_size += tmp_size;
+    p_fifo[write_pos] = ENDOFLINE_CHAR;
   }
-#endif /* LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE != 0 */
+
+  /* Release the trace FIFO and start the transfer */
+  UTIL_ADV_TRACE_ZCSend_Finalize();
+#else /* LOG_ZERO_COPY_TRACE != 0 */
+  /* Add to full_text the color and the time stamp */
+  buffer_size = LogPrefix(full_text, UTIL_ADV_TRACE_TMP_BUF_SIZE, Region);
 
   /* Copy the data */
   tmp_size = (uint16_t)vsnprintf(&full_text[buffer_size], (UTIL_ADV_TRACE_TMP_BUF_SIZE - buffer_size), Text, Args);
@@ -204,6 +767,292 @@ void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Regi
 
   /* Send full_text to ADV Traces */
   UTIL_ADV_TRACE_Send((const uint8_t *)full_text, buffer_size);
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+}
+
+/**
+ * @brief Format and send a log of the module itself.
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The format string, followed by its arguments.
+ *
+ * @return None.
+ */
+static void LogOutputFormat(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, ...)
+{
+  va_list variadic_args;
+
+  va_start(variadic_args, Text);
+  LogOutput(VerboseLevel, Region, Text, variadic_args);
+  va_end(variadic_args);
+}
+
+/**
+ * @brief Print a line of hexadecimal dump, converted on the stack (buffered or binary traces).
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ * @param Text          The text printed before the bytes.
+ * @param Data          The bytes of the line.
+ * @param Size          Number of bytes, at most HEX_DUMP_BYTES_PER_LINE.
+ * @param Separator     Character between two bytes, or '\0' for none.
+ *
+ * @return None.
+ */
+static void HexLineFormat(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator)
+{
+  char hex_text[(HEX_DUMP_BYTES_PER_LINE * 3u) + 1u];
+
+  hex_text[HexToText(hex_text, Data, Size, Separator)] = '\0';
+  LogOutputFormat(VerboseLevel, Region, "%s%s", Text, hex_text);
+}
+
+#if (LOG_ZERO_COPY_TRACE != 0)
+/**
+ * @brief Print a line of hexadecimal dump, converted directly inside the trace FIFO.
+ *
+ * @param Region        Region of the log.
+ * @param Text          The text printed before the bytes.
+ * @param Data          The bytes of the line.
+ * @param Size          Number of bytes, at most HEX_DUMP_BYTES_PER_LINE.
+ * @param Separator     Character between two bytes, or '\0' for none.
+ *
+ * @return False when the trace FIFO is full.
+ */
+static bool HexLineZeroCopy(Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator)
+{
+  uint16_t prefix_size;
+  uint16_t text_size;
+  uint16_t hex_size;
+  uint16_t eol_size = 0;
+  char prefix[ZERO_COPY_PREFIX_SIZE];
+  uint8_t * p_fifo;
+  uint16_t fifo_size;
+  uint16_t write_pos;
+
+  hex_size = (uint16_t)(Size * 2u);
+  if ((Separator != '\0') && (Size != 0u))
+  {
+    hex_size += (uint16_t)(Size - 1u);
+  }
+#if (LOG_INSERT_EOL_INSIDE_THE_TRACE != 0)
+  eol_size = ENDOFLINE_SIZE;
+#endif /* LOG_INSERT_EOL_INSIDE_THE_TRACE != 0 */
+
+  prefix_size = LogPrefix(prefix, ZERO_COPY_PREFIX_SIZE, Region);
+  text_size = (uint16_t)strnlen(Text, (UTIL_ADV_TRACE_TMP_BUF_SIZE - 1u - prefix_size - hex_size));
+
+  if (UTIL_ADV_TRACE_ZCSend_Allocation((prefix_size + text_size + hex_size + eol_size), &p_fifo, &fifo_size, &write_pos) != UTIL_ADV_TRACE_OK)
+  {
+    return false;
+  }
+
+  write_pos = FifoCopy(p_fifo, fifo_size, write_pos, prefix, prefix_size);
+  write_pos = FifoCopy(p_fifo, fifo_size, write_pos, Text, text_size);
+  write_pos = FifoHex(p_fifo, fifo_size, write_pos, Data, Size, Separator);
+  if (eol_size != 0u)
+  {
+    p_fifo[write_pos] = ENDOFLINE_CHAR;
+  }
+
+  UTIL_ADV_TRACE_ZCSend_Finalize();
+
+  return true;
+}
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+
+#if (LOG_RATE_LIMIT != 0)
+/**
+ * @brief Take a token in the bucket of the region.
+ *
+ * @param Region        Region of the log.
+ * @param SuppressedNbr Updated with the number of logs dropped since the last allowed one.
+ *
+ * @return true if the log can be printed.
+ */
+static bool RateLimitAllow(Log_Region_t Region, uint32_t * SuppressedNbr)
+{
+  bool                  allowed = true;
+  uint32_t              now;
+  uint32_t              elapsed;
+  uint32_t              tokens_max;
+  Log_Rate_Limit_t *    p_limit;
+
+  *SuppressedNbr = 0;
+  if (((uint32_t)Region >= LOG_RATE_LIMIT_REGION_NBR) || (log_tick_function == NULL))
+  {
+    return true;
+  }
+
+  p_limit = &rate_limit_list[Region];
+  if (p_limit->message_per_second == 0u)
+  {
+    return true;
+  }
+
+  now = log_tick_function();
+
+  UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION();
+
+  /* Refill the bucket, the elapsed time is capped to avoid overflows (the bucket is full long before) */
+  elapsed = now - p_limit->last_time;
+  p_limit->last_time = now;
+  if (elapsed > 0xFFFFu)
+  {
+    elapsed = 0xFFFFu;
+  }
+
+  tokens_max = (uint32_t)p_limit->burst * 1000u;
+  elapsed *= p_limit->message_per_second;
+  if (elapsed >= (tokens_max - p_limit->tokens))
+  {
+    p_limit->tokens = tokens_max;
+  }
+  else
+  {
+    p_limit->tokens += elapsed;
+  }
+
+  if (p_limit->tokens >= 1000u)
+  {
+    p_limit->tokens -= 1000u;
+    *SuppressedNbr = p_limit->suppressed_nbr;
+    p_limit->suppressed_nbr = 0;
+  }
+  else
+  {
+    p_limit->suppressed_nbr++;
+    allowed = false;
+  }
+
+  UTIL_ADV_TRACE_EXIT_CRITICAL_SECTION();
+
+  return allowed;
+}
+#endif /* LOG_RATE_LIMIT != 0 */
+
+/**
+ * @brief Check that a log is enabled (verbose level, region and rate limitation).
+ *
+ * @param VerboseLevel  Verbose level of the log.
+ * @param Region        Region of the log.
+ *
+ * @return True when the log must be printed.
+ */
+static bool LogAllowed(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region)
+{
+#if (LOG_RATE_LIMIT != 0)
+  uint32_t suppressed_nbr;
+#endif /* LOG_RATE_LIMIT != 0 */
+
+  /* If the verbose level of the given log is not enabled, then we do not print the log */
+  if (VerboseLevel > current_verbose_level)
+  {
+    return false;
+  }
+
+  /* If the region for the given log is not enabled, then we do not print the log */
+  if ((Get_Region_Mask(Region) & current_region_mask) == 0u)
+  {
+    return false;
+  }
+
+#if (LOG_RATE_LIMIT != 0)
+  /* Drop the log when the region is over its rate, and report the dropped ones with the next log */
+  if (RateLimitAllow(Region, &suppressed_nbr) == false)
+  {
+    return false;
+  }
+
+  if (suppressed_nbr != 0u)
+  {
+    LogOutputFormat(VerboseLevel, Region, "%u messages suppressed\n", (unsigned int)suppressed_nbr);
+  }
+#endif /* LOG_RATE_LIMIT != 0 */
+
+  return true;
+}
+
+void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args)
+{
+  /* USER CODE BEGIN Log_Module_PrintWithArg_1 */
+
+  /* USER CODE END Log_Module_PrintWithArg_1 */
+
+  if (LogAllowed(VerboseLevel, Region) == false)
+  {
+    return;
+  }
+
+  LogOutput(VerboseLevel, Region, Text, Args);
+}
+
+void Log_Module_HexDump(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator)
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  uint16_t line_size;
+
+  /* The whole dump counts as one log for the rate limitation */
+  if ((Data == NULL) || (LogAllowed(VerboseLevel, Region) == false))
+  {
+    return;
+  }
+
+  /* One log line per HEX_DUMP_BYTES_PER_LINE bytes, so that a long buffer does not need a large FIFO allocation */
+  do
+  {
+    line_size = (Size > HEX_DUMP_BYTES_PER_LINE) ? HEX_DUMP_BYTES_PER_LINE : Size;
+
+#if (LOG_ZERO_COPY_TRACE != 0)
+    if (LOG_BINARY_MODE() == false)
+    {
+      if (HexLineZeroCopy(Region, Text, Data, line_size, Separator) == false)
+      {
+        return;
+      }
+    }
+    else
+    {
+      HexLineFormat(VerboseLevel, Region, Text, Data, line_size, Separator);
+    }
+#else /* LOG_ZERO_COPY_TRACE != 0 */
+    HexLineFormat(VerboseLevel, Region, Text, Data, line_size, Separator);
+#endif /* LOG_ZERO_COPY_TRACE != 0 */
+
+    Data += line_size;
+    Size -= line_size;
+  } while (Size != 0u);
+#else /* (CFG_LOG_SUPPORTED != 0) */
+  UNUSED(VerboseLevel);
+  UNUSED(Region);
+  UNUSED(Text);
+  UNUSED(Data);
+  UNUSED(Size);
+  UNUSED(Separator);
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+}
+
+uint16_t Log_Module_HexToText(char * TextBuffer, uint16_t SizeMax, const uint8_t * Data, uint16_t Size, char Separator)
+{
+  uint16_t byte_size = (Separator != '\0') ? 3u : 2u;
+  uint16_t text_length;
+
+  if (SizeMax == 0u)
+  {
+    return 0;
+  }
+
+  /* Keep room for the null character */
+  if (Size > ((SizeMax - 1u + ((Separator != '\0') ? 1u : 0u)) / byte_size))
+  {
+    Size = (uint16_t)((SizeMax - 1u + ((Separator != '\0') ? 1u : 0u)) / byte_size);
+  }
+
+  text_length = HexToText(TextBuffer, Data, Size, Separator);
+  TextBuffer[text_length] = '\0';
+
+  return text_length;
 }
 
 void Log_Module_Print(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, ...)
@@ -229,6 +1078,11 @@ void Log_Module_Init(Log_Module_t LogConfiguration)
   Log_Module_Set_Verbose_Level(LogConfiguration.verbose_level);
   Log_Module_Set_Multiple_Regions(LogConfiguration.region_mask);
   log_timestamp_function = NULL;
+  log_binary_timestamp_function = NULL;
+#if (LOG_RATE_LIMIT != 0)
+  memset(rate_limit_list, 0, sizeof(rate_limit_list));
+  log_tick_function = NULL;
+#endif /* LOG_RATE_LIMIT != 0 */
 }
 
 void Log_Module_DeInit(void)
@@ -236,6 +1090,31 @@ void Log_Module_DeInit(void)
   UTIL_ADV_TRACE_DeInit();
 }
 
+Log_Verbose_Level_t Log_Module_Get_Verbose_Level(void)
+{
+  return current_verbose_level;
+}
+
+uint32_t Log_Module_Get_Region_Mask(void)
+{
+  return current_region_mask;
+}
+
+bool Log_Module_Set_Binary_Mode(bool BinaryMode)
+{
+#if (LOG_INSERT_BINARY_TRACE != 0)
+  log_binary_mode = BinaryMode;
+  return true;
+#else /* LOG_INSERT_BINARY_TRACE != 0 */
+  return (BinaryMode == false);
+#endif /* LOG_INSERT_BINARY_TRACE != 0 */
+}
+
+bool Log_Module_Get_Binary_Mode(void)
+{
+  return LOG_BINARY_MODE();
+}
+
 void Log_Module_Set_Verbose_Level(Log_Verbose_Level_t NewVerboseLevel)
 {
   current_verbose_level = NewVerboseLevel;
@@ -293,6 +1172,68 @@ void Log_Module_RegisterTimeStampFunction(CallBack_TimeStamp * TimeStampFunction
   log_timestamp_function = TimeStampFunction;
 }
 
+void Log_Module_RegisterBinaryTimeStampFunction(CallBack_BinaryTimeStamp * TimeStampFunction)
+{
+  log_binary_timestamp_function = TimeStampFunction;
+}
+
+void Log_Module_Set_Rate_Limit(Log_Region_t Region, uint16_t MessagePerSecond, uint16_t Burst)
+{
+#if (LOG_RATE_LIMIT != 0)
+  uint32_t first = (uint32_t)Region;
+  uint32_t last = (uint32_t)Region + 1u;
+  uint32_t now = (log_tick_function != NULL) ? log_tick_function() : 0u;
+
+  if (Region == LOG_REGION_ALL_REGIONS)
+  {
+    first = 0u;
+    last = LOG_RATE_LIMIT_REGION_NBR;
+  }
+
+  for (uint32_t index = first; (index < last) && (index < LOG_RATE_LIMIT_REGION_NBR); index++)
+  {
+    UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION();
+    rate_limit_list[index].message_per_second = MessagePerSecond;
+    rate_limit_list[index].burst = Burst;
+    rate_limit_list[index].tokens = (uint32_t)Burst * 1000u;
+    rate_limit_list[index].last_time = now;
+    rate_limit_list[index].suppressed_nbr = 0;
+    UTIL_ADV_TRACE_EXIT_CRITICAL_SECTION();
+  }
+#else /* LOG_RATE_LIMIT != 0 */
+  UNUSED(Region);
+  UNUSED(MessagePerSecond);
+  UNUSED(Burst);
+#endif /* LOG_RATE_LIMIT != 0 */
+}
+
+void Log_Module_RegisterTickFunction(CallBack_Tick * TickFunction)
+{
+#if (LOG_RATE_LIMIT != 0)
+  log_tick_function = TickFunction;
+#else /* LOG_RATE_LIMIT != 0 */
+  UNUSED(TickFunction);
+#endif /* LOG_RATE_LIMIT != 0 */
+}
+
+void Log_Module_RegisterCaptureFunction(CallBack_Capture * CaptureFunction)
+{
+#if (LOG_INSERT_CAPTURE != 0)
+  log_capture_function = CaptureFunction;
+#else /* LOG_INSERT_CAPTURE != 0 */
+  UNUSED(CaptureFunction);
+#endif /* LOG_INSERT_CAPTURE != 0 */
+}
+
+CallBack_Capture * Log_Module_GetCaptureFunction(void)
+{
+#if (LOG_INSERT_CAPTURE != 0)
+  return log_capture_function;
+#else /* LOG_INSERT_CAPTURE != 0 */
+  return NULL;
+#endif /* LOG_INSERT_CAPTURE != 0 */
+}
+
 /* USER CODE BEGIN 0 */
 
 /* USER CODE END 0 */
@@ -37,6 +37,10 @@ extern "C" {
 
 /* USER CODE END Includes */
 
+/* Exported constants --------------------------------------------------------*/
+/* Largest binary frame of a log (see LOG_INSERT_BINARY_TRACE and LOG_INSERT_CAPTURE) */
+#define LOG_BINARY_FRAME_SIZE_MAX   (108u)
+
 /* Exported types ------------------------------------------------------------*/
 /* Log module types */
 /**
@@ -62,6 +66,30 @@ typedef struct
  */
 typedef void CallBack_TimeStamp(char * Data, uint16_t SizeMax, uint16_t * TimeStampSize);
 
+/**
+ * @brief  Callback function to get the Time Stamp of the binary traces.
+ *         Also written in decimal in the text traces when no CallBack_TimeStamp is registered.
+ *
+ * @return The Time Stamp, in the unit chosen by the application.
+ */
+typedef uint32_t CallBack_BinaryTimeStamp(void);
+
+/**
+ * @brief  Callback function to get the time used by the rate limitation of the logs.
+ *
+ * @return The time, in milliseconds.
+ */
+typedef uint32_t CallBack_Tick(void);
+
+/**
+ * @brief  Callback function receiving the binary frame of each log (see LOG_INSERT_CAPTURE).
+ *         It may be called from an interrupt.
+ *
+ * @param  Frame                The binary frame : sync, payload size, verbose level, region, time stamp, format address, payload.
+ * @param  Size                 The size of the frame.
+ */
+typedef void CallBack_Capture(const uint8_t * Frame, uint16_t Size);
+
 /* USER CODE BEGIN ET */
 
 /* USER CODE END ET */
@@ -164,6 +192,39 @@ void Log_Module_Remove_Region(Log_Region_t Region);
  */
 void Log_Module_Enable_All_Regions(void);
 
+/**
+ * @brief  Get the current verbose level.
+ *
+ * @param  None.
+ * @return The verbose level, of type Log_Verbose_Level_t.
+ */
+Log_Verbose_Level_t Log_Module_Get_Verbose_Level(void);
+
+/**
+ * @brief  Get the mask of the enabled regions.
+ *
+ * @param  None.
+ * @return The mask of the regions, one bit per Log_Region_t.
+ */
+uint32_t Log_Module_Get_Region_Mask(void);
+
+/**
+ * @brief  Select the binary or the text logs at runtime.
+ *         The binary logs need LOG_INSERT_BINARY_TRACE, the text logs are always available.
+ *
+ * @param  BinaryMode           True for the binary logs, false for the text logs.
+ * @return False when the requested mode is not compiled in.
+ */
+bool Log_Module_Set_Binary_Mode(bool BinaryMode);
+
+/**
+ * @brief  Get the current log mode.
+ *
+ * @param  None.
+ * @return True for the binary logs, false for the text logs.
+ */
+bool Log_Module_Get_Binary_Mode(void);
+
 /**
  * @brief  Set the color for a region.
  *
@@ -183,6 +244,52 @@ void Log_Module_Set_Color(Log_Region_t Region, Log_Color_t Color);
  */
 void Log_Module_RegisterTimeStampFunction(CallBack_TimeStamp * TimeStampFunction);
 
+/**
+ * @brief  Register a callback function to get the TimeStamp of the binary traces.
+ *
+ * @param  TimeStampFunction    Callback function returning the TimeStamp.
+ *                              Without callback, the TimeStamp of the binary traces is 0.
+ *                              Without Log_Module_RegisterTimeStampFunction, it is also inserted as "[value] " in the text traces.
+ * @return None.
+ */
+void Log_Module_RegisterBinaryTimeStampFunction(CallBack_BinaryTimeStamp * TimeStampFunction);
+
+/**
+ * @brief  Limit the number of logs of a region (token bucket).
+ *         The logs over the limit are dropped, and their number is printed before the next log of the region.
+ *
+ * @param  Region               The region to limit, of type Log_Region_t. LOG_REGION_ALL_REGIONS sets all the regions.
+ * @param  MessagePerSecond     The number of logs allowed per second, on average. 0 removes the limitation.
+ * @param  Burst                The number of logs allowed at once.
+ * @return None.
+ */
+void Log_Module_Set_Rate_Limit(Log_Region_t Region, uint16_t MessagePerSecond, uint16_t Burst);
+
+/**
+ * @brief  Register the callback function providing the time of the rate limitation.
+ *
+ * @param  TickFunction         Callback function returning the time in milliseconds.
+ *                              Without callback, the logs are not limited.
+ * @return None.
+ */
+void Log_Module_RegisterTickFunction(CallBack_Tick * TickFunction);
+
+/**
+ * @brief  Register the callback function receiving the binary frame of each log printed.
+ *
+ * @param  CaptureFunction      Callback function receiving the frame, NULL to stop the capture.
+ *                              Without LOG_INSERT_CAPTURE, nothing is captured.
+ * @return None.
+ */
+void Log_Module_RegisterCaptureFunction(CallBack_Capture * CaptureFunction);
+
+/**
+ * @brief  Get the callback function currently receiving the binary frames, so that a new one can forward them to it.
+ *
+ * @return The callback function registered, NULL if none (always NULL without LOG_INSERT_CAPTURE).
+ */
+CallBack_Capture * Log_Module_GetCaptureFunction(void);
+
 /* Module API - Wrapper function */
 /**
  * @brief  Underlying function of all the LOG_xxx macros.
@@ -209,6 +316,34 @@ void Log_Module_Print(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, con
  */
 void Log_Module_PrintWithArg(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, va_list Args);
 
+/**
+ * @brief  Dump bytes in hexadecimal after a text, converted from a table directly inside the trace FIFO
+ *         (zero-copy mode) without allocation. The bytes are split in lines of 16 bytes, each line starting with Text.
+ *
+ * @param  VerboseLevel         The level of verbose used for this Log, of type Log_Verbose_Level_t.
+ * @param  Region               The region set for this log, of type Log_Region_t.
+ * @param  Text                 The text printed before the bytes (not a format string).
+ * @param  Data                 The bytes to dump.
+ * @param  Size                 Number of bytes to dump.
+ * @param  Separator            Character between two bytes (e.g. ' ' or ':'), or '\0' for none.
+ *
+ * @return None.
+ */
+void Log_Module_HexDump(Log_Verbose_Level_t VerboseLevel, Log_Region_t Region, const char * Text, const uint8_t * Data, uint16_t Size, char Separator);
+
+/**
+ * @brief  Convert bytes in hexadecimal text, null terminated. The bytes that do not fit in the buffer are ignored.
+ *
+ * @param  TextBuffer           The buffer receiving the text.
+ * @param  SizeMax              Size of the buffer.
+ * @param  Data                 The bytes to convert.
+ * @param  Size                 Number of bytes to convert.
+ * @param  Separator            Character between two bytes (e.g. ' ' or ':'), or '\0' for none.
+ *
+ * @return Length of the text, without the null character.
+ */
+uint16_t Log_Module_HexToText(char * TextBuffer, uint16_t SizeMax, const uint8_t * Data, uint16_t Size, char Separator);
+
 /* USER CODE BEGIN EFP */
 
 /* USER CODE END EFP */
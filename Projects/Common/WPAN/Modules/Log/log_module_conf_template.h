@@ -38,7 +38,8 @@ extern "C" {
 /**
  * @brief  When this define is set to 0, there is no time stamp added to the trace data.
  *         When this define is set to 1, the time stamp is added to the trace data,
- *         according to the function registered with Log_Module_RegisterTimeStampFunction.
+ *         according to the function registered with Log_Module_RegisterTimeStampFunction,
+ *         or else the value returned by the one registered with Log_Module_RegisterBinaryTimeStampFunction.
  */
 #define LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE    CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE
 
@@ -17,6 +17,7 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <assert.h>
 #include "stm_list.h"
 #include "utilities_conf.h"
 #include "advanced_memory_manager.h"
@@ -26,16 +27,21 @@
 /**
  * @brief   Virtual Memory information struct
  */
-typedef struct __attribute__((packed, aligned(4))) VirtualMemoryInfo
+typedef struct VirtualMemoryInfo
 {
-  /* Identifier of the Virtual Memory */
-  uint8_t Id;
   /* Size required for this Virtual Memory buffer with a multiple of 32bits */
   uint32_t RequiredSize;
   /* Current occupation of the Virtual Memory buffer with a multiple of 32bits */
   uint32_t OccupiedSize;
+  /* Allocation retry statistics, given by address to the pending callbacks (naturally aligned) */
+  AMM_RetryStats_t RetryStats;
+  /* Identifier of the Virtual Memory */
+  uint8_t Id;
 }VirtualMemoryInfo_t;
 
+static_assert( sizeof( VirtualMemoryInfo_t ) == ( AMM_VIRTUAL_INFO_ELEMENT_SIZE * sizeof( uint32_t ) ),
+               "Virtual Memory info differs from AMM_VIRTUAL_INFO_ELEMENT_SIZE" );
+
 /* Private defines -----------------------------------------------------------*/
 
 /* Defines that the module is not initialized */
@@ -65,6 +71,14 @@ typedef struct __attribute__((packed, aligned(4))) VirtualMemoryInfo
 /* Mask of the Buffer Size field in Virtual Memory Header */
 #define VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_MASK 0x00FFFFFF
 
+/* Highest Virtual Memory ID, can be overridden in utilities_conf.h */
+#ifndef AMM_CONF_VIRTUAL_ID_MAX
+#define AMM_CONF_VIRTUAL_ID_MAX       0xFFu
+#endif
+
+/* Virtual Memory index table value for an unknown ID */
+#define VIRTUAL_MEMORY_INDEX_UNKNOWN  0xFFu
+
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 
@@ -89,24 +103,46 @@ static uint32_t AmmVirtualMemoryNumber;
 /* List of Virtual Memories info */
 static VirtualMemoryInfo_t * p_AmmVirtualMemoryList;
 
+/* Index in the Virtual Memories info list of each Virtual Memory ID */
+static uint8_t AmmVirtualMemoryIndex[AMM_CONF_VIRTUAL_ID_MAX + 1u];
+
 /* Handler of the Basic Memory Manager functions */
 static AMM_BasicMemoryManagerFunctions_t AmmBmmFunctionsHandler;
 
-/* Pointer on the first element of the pending callbacks */
-static AMM_VirtualMemoryCallbackHeader_t AmmPendingCallback;
+/* Pointer on the first element of the pending callbacks, for each priority */
+static AMM_VirtualMemoryCallbackHeader_t AmmPendingCallback[AMM_PRIORITY_NBR];
+
+/* Pointer on the first element of the active callbacks, for each priority */
+static AMM_VirtualMemoryCallbackHeader_t AmmActiveCallback[AMM_PRIORITY_NBR];
+
+/* Order in which the callbacks are invoked */
+static const AMM_CallbackPriority_t AmmPriorityOrder[AMM_PRIORITY_NBR] =
+{
+  AMM_PRIORITY_HIGH,
+  AMM_PRIORITY_NORMAL,
+  AMM_PRIORITY_LOW
+};
 
-/* Pointer on the first element of the active callbacks */
-static AMM_VirtualMemoryCallbackHeader_t AmmActiveCallback;
+/* Allocation retry statistics of the shared pool */
+static AMM_RetryStats_t AmmSharedRetryStats;
+
+/* Low watermark of the free shared pool, zero when disabled */
+static uint32_t AmmLowWatermark;
+
+/* Free shared pool currently below the low watermark */
+static uint8_t AmmLowWatermarkReached;
 
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
 /**
- * @brief  Push a callback structure into the Pending FIFO
+ * @brief  Push a callback structure into the Pending FIFO of its priority
  * @param  p_CallbackElt: Pointer onto the callback to push
+ * @param  p_RetryStats: Pointer onto the retry statistics of the failed allocation
  * @return None
  */
-static inline void pushPending (AMM_VirtualMemoryCallbackFunction_t * const p_CallbackElt);
+static inline void pushPending (AMM_VirtualMemoryCallbackFunction_t * const p_CallbackElt,
+                                AMM_RetryStats_t * const p_RetryStats);
 
 /**
  * @brief  Push the Pending callback(s) into the Active FIFO
@@ -120,6 +156,19 @@ static inline void passPendingToActive (void);
  */
 static inline AMM_VirtualMemoryCallbackFunction_t * popActive (void);
 
+/**
+ * @brief  Get the Virtual Memory info from its ID
+ * @param  VirtualMemoryId: Virtual Memory Identifier
+ * @return Pointer onto the Virtual Memory info, NULL if unknown
+ */
+static inline VirtualMemoryInfo_t * getVirtualMemory (const uint8_t VirtualMemoryId);
+
+/**
+ * @brief  Update the low watermark state from the free shared pool - Shall be called in critical section -
+ * @return TRUE if the state has changed
+ */
+static inline uint8_t updateLowWatermark (void);
+
 /* Functions Definition ------------------------------------------------------*/
 
 AMM_Function_Error_t AMM_Init (const AMM_InitParameters_t * const p_InitParams)
@@ -176,6 +225,11 @@ AMM_Function_Error_t AMM_Init (const AMM_InitParameters_t * const p_InitParams)
       {
         error = AMM_ERROR_BAD_VIRTUAL_CONFIG;
       }
+      /* Check the virtual memory ID can be indexed */
+      else if (p_InitParams->p_VirtualMemoryConfigList[memIdx].Id > AMM_CONF_VIRTUAL_ID_MAX)
+      {
+        error = AMM_ERROR_BAD_VIRTUAL_CONFIG;
+      }
       /* Check if size is not zero */
       else if (p_InitParams->p_VirtualMemoryConfigList[memIdx].BufferSize == 0)
       {
@@ -209,12 +263,24 @@ AMM_Function_Error_t AMM_Init (const AMM_InitParameters_t * const p_InitParams)
       AmmBmmFunctionsHandler.Init = NULL;
       AmmBmmFunctionsHandler.Allocate = NULL;
       AmmBmmFunctionsHandler.Free = NULL;
+      AmmBmmFunctionsHandler.GetLargestFreeBlock = NULL;
 
       /* Init all private variables: Callbacks relative */
-      AmmPendingCallback.next = NULL;
-      AmmPendingCallback.prev = NULL;
-      AmmActiveCallback.next = NULL;
-      AmmActiveCallback.prev = NULL;
+      for (uint32_t prioIdx = 0x00;
+           prioIdx < AMM_PRIORITY_NBR;
+           prioIdx++)
+      {
+        AmmPendingCallback[prioIdx].next = NULL;
+        AmmPendingCallback[prioIdx].prev = NULL;
+        AmmActiveCallback[prioIdx].next = NULL;
+        AmmActiveCallback[prioIdx].prev = NULL;
+      }
+
+      /* Init all private variables: Retry relative */
+      AmmSharedRetryStats.AllocFailedNbr = 0x00;
+      AmmSharedRetryStats.CallbackQueuedNbr = 0x00;
+      AmmLowWatermark = 0x00;
+      AmmLowWatermarkReached = FALSE;
 
       /* First get the Basic Memory Manager functions back */
       AMM_RegisterBasicMemoryManager (&AmmBmmFunctionsHandler);
@@ -251,12 +317,24 @@ AMM_Function_Error_t AMM_Init (const AMM_InitParameters_t * const p_InitParams)
           UTIL_SEQ_INIT_CRITICAL_SECTION ();
 
           /* Init both pending and active list */
-          LST_init_head (&AmmPendingCallback);
-          LST_init_head (&AmmActiveCallback);
+          for (uint32_t prioIdx = 0x00;
+               prioIdx < AMM_PRIORITY_NBR;
+               prioIdx++)
+          {
+            LST_init_head (&AmmPendingCallback[prioIdx]);
+            LST_init_head (&AmmActiveCallback[prioIdx]);
+          }
 
           /* Keep going on init, fulfill the virtual memories info */
           AmmVirtualMemoryNumber = p_InitParams->VirtualMemoryNumber;
 
+          for (uint32_t memId = 0x00;
+               memId <= AMM_CONF_VIRTUAL_ID_MAX;
+               memId++)
+          {
+            AmmVirtualMemoryIndex[memId] = VIRTUAL_MEMORY_INDEX_UNKNOWN;
+          }
+
           /* Actualize actual shared pool occupied size */
           AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize + (AMM_VIRTUAL_INFO_ELEMENT_SIZE
                                                                    * AmmVirtualMemoryNumber);
@@ -268,8 +346,12 @@ AMM_Function_Error_t AMM_Init (const AMM_InitParameters_t * const p_InitParams)
             p_AmmVirtualMemoryList[memIdx].Id = p_InitParams->p_VirtualMemoryConfigList[memIdx].Id;
             p_AmmVirtualMemoryList[memIdx].RequiredSize = p_InitParams->p_VirtualMemoryConfigList[memIdx].BufferSize;
             p_AmmVirtualMemoryList[memIdx].OccupiedSize = 0x00;
+            p_AmmVirtualMemoryList[memIdx].RetryStats.AllocFailedNbr = 0x00;
+            p_AmmVirtualMemoryList[memIdx].RetryStats.CallbackQueuedNbr = 0x00;
 
             AmmRequiredVirtualMemorySize = AmmRequiredVirtualMemorySize + p_AmmVirtualMemoryList[memIdx].RequiredSize;
+
+            AmmVirtualMemoryIndex[p_AmmVirtualMemoryList[memIdx].Id] = (uint8_t)memIdx;
           }
 
           /* Set init flag */
@@ -299,6 +381,7 @@ AMM_Function_Error_t AMM_DeInit (void)
     AmmBmmFunctionsHandler.Init = NULL;
     AmmBmmFunctionsHandler.Allocate = NULL;
     AmmBmmFunctionsHandler.Free = NULL;
+    AmmBmmFunctionsHandler.GetLargestFreeBlock = NULL;
 
     p_AmmPoolAddress = 0x00;
     AmmPoolSize = 0x00;
@@ -328,8 +411,21 @@ AMM_Function_Error_t AMM_Alloc (const uint8_t VirtualMemoryId,
 
   uint32_t selfAvailable = 0x00;
 
+  uint8_t watermarkChanged = FALSE;
+
   uint32_t * p_TmpAllocAddr = NULL;
 
+  VirtualMemoryInfo_t * p_VirtualMemory = NULL;
+
+  /* Size to allocate, do not forget the header */
+  const uint32_t allocSize = BufferSize + VIRTUAL_MEMORY_HEADER_SIZE;
+
+  /* Header of the allocated buffer */
+  const uint32_t header = (uint32_t)(((uint32_t)VirtualMemoryId << VIRTUAL_MEMORY_HEADER_ID_POS)
+                                        & VIRTUAL_MEMORY_HEADER_ID_MASK)
+                                      | ((BufferSize << VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_POS)
+                                        & VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_MASK);
+
   if (AmmInitialized == NOT_INITIALIZED)
   {
     error = AMM_ERROR_NOT_INIT;
@@ -348,30 +444,23 @@ AMM_Function_Error_t AMM_Alloc (const uint8_t VirtualMemoryId,
     /* Check for enough space in the shared pool */
     if (BufferSize < (AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize))
     {
-      /* Try Allocation. Do not forget the header */
-      p_TmpAllocAddr = AmmBmmFunctionsHandler.Allocate (BufferSize + VIRTUAL_MEMORY_HEADER_SIZE);
+      /* Try Allocation */
+      p_TmpAllocAddr = AmmBmmFunctionsHandler.Allocate (allocSize);
 
       /* Check if allocation is OK */
       if (p_TmpAllocAddr != NULL)
       {
-        /* Fulfill the header */
-        *p_TmpAllocAddr = (uint32_t)(((uint32_t)VirtualMemoryId << VIRTUAL_MEMORY_HEADER_ID_POS)
-                                        & VIRTUAL_MEMORY_HEADER_ID_MASK)
-                                      | ((BufferSize << VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_POS)
-                                        & VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_MASK);
-
-        /* Provide the right address to user, ie without the header */
-        *pp_AllocBuffer = (uint32_t *)(p_TmpAllocAddr + VIRTUAL_MEMORY_HEADER_SIZE);
-
         /* Actualize the current memory occupation of the shared space */
-        AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize + BufferSize + VIRTUAL_MEMORY_HEADER_SIZE;
+        AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize + allocSize;
+
+        watermarkChanged = updateLowWatermark ();
 
         error = AMM_ERROR_OK;
       }
       else
       {
         /* Register the callback for a future retry */
-        pushPending (p_CallBackFunction);
+        pushPending (p_CallBackFunction, &AmmSharedRetryStats);
 
         error = AMM_ERROR_ALLOCATION_FAILED;
       }
@@ -379,7 +468,7 @@ AMM_Function_Error_t AMM_Alloc (const uint8_t VirtualMemoryId,
     else
     {
       /* Register the callback for a future retry */
-      pushPending (p_CallBackFunction);
+      pushPending (p_CallBackFunction, &AmmSharedRetryStats);
 
       error = AMM_ERROR_BAD_ALLOCATION_SIZE;
     }
@@ -390,81 +479,83 @@ AMM_Function_Error_t AMM_Alloc (const uint8_t VirtualMemoryId,
   /* A specific ID is requested */
   else
   {
-    error = AMM_ERROR_UNKNOWN_ID;
-
-    /* Enter critical section */
-    UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+    /* Check if ID is known */
+    p_VirtualMemory = getVirtualMemory (VirtualMemoryId);
 
-    /* Check virtual memory info */
-    for (uint32_t memIdx = 0x00;
-         (memIdx < AmmVirtualMemoryNumber) && (error == AMM_ERROR_UNKNOWN_ID);
-         memIdx++)
+    if (p_VirtualMemory == NULL)
     {
-      /* Check if ID is known */
-      if (VirtualMemoryId == p_AmmVirtualMemoryList[memIdx].Id)
+      error = AMM_ERROR_UNKNOWN_ID;
+    }
+    else
+    {
+      /* Enter critical section */
+      UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+      /* Check if all the reserved memory has been consumed */
+      if (p_VirtualMemory->OccupiedSize < p_VirtualMemory->RequiredSize)
       {
-        /* Check if all the reserved memory has been consumed */
-        if (p_AmmVirtualMemoryList[memIdx].OccupiedSize < p_AmmVirtualMemoryList[memIdx].RequiredSize)
-        {
-          /* Compute what is remaining */
-          selfAvailable = p_AmmVirtualMemoryList[memIdx].RequiredSize
-                          - p_AmmVirtualMemoryList[memIdx].OccupiedSize;
-        }
+        /* Compute what is remaining */
+        selfAvailable = p_VirtualMemory->RequiredSize - p_VirtualMemory->OccupiedSize;
+      }
 
-        /* Check if there is enough space in the shared pool plus in our virtual memory pool */
-        if (BufferSize < (AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize + selfAvailable))
+      /* Check if there is enough space in the shared pool plus in our virtual memory pool */
+      if (BufferSize < (AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize + selfAvailable))
+      {
+        /* Try Allocation */
+        p_TmpAllocAddr = AmmBmmFunctionsHandler.Allocate (allocSize);
+
+        /* Check if allocation is OK */
+        if (p_TmpAllocAddr != NULL)
         {
-          /* Try Allocation. Do not forget the header */
-          p_TmpAllocAddr = AmmBmmFunctionsHandler.Allocate ((BufferSize + VIRTUAL_MEMORY_HEADER_SIZE));
+          /* Actualize our current memory occupation */
+          p_VirtualMemory->OccupiedSize = p_VirtualMemory->OccupiedSize + allocSize;
 
-          /* Check if allocation is OK */
-          if (p_TmpAllocAddr != NULL)
+          /* Check for overlapping the reserved memory */
+          if (p_VirtualMemory->RequiredSize < p_VirtualMemory->OccupiedSize)
           {
-            /* Fulfill the header */
-            *p_TmpAllocAddr = (uint32_t)(((uint32_t)VirtualMemoryId << VIRTUAL_MEMORY_HEADER_ID_POS)
-                                        & VIRTUAL_MEMORY_HEADER_ID_MASK)
-                                      | ((BufferSize << VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_POS)
-                                        & VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_MASK);
+            /* Actualize the shared memory occupation */
+            AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize + allocSize - selfAvailable;
 
-            /* Provide the right address to user, ie without the header */
-            *pp_AllocBuffer = (uint32_t *)(p_TmpAllocAddr + VIRTUAL_MEMORY_HEADER_SIZE);
-
-            /* Actualize our current memory occupation */
-            p_AmmVirtualMemoryList[memIdx].OccupiedSize = p_AmmVirtualMemoryList[memIdx].OccupiedSize
-                                                          + BufferSize
-                                                          + VIRTUAL_MEMORY_HEADER_SIZE;
-
-            /* Check for overlapping the reserved memory */
-            if (p_AmmVirtualMemoryList[memIdx].RequiredSize < p_AmmVirtualMemoryList[memIdx].OccupiedSize)
-            {
-              /* Actualize the shared memory occupation */
-              AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize
-                                          + BufferSize - selfAvailable
-                                          + VIRTUAL_MEMORY_HEADER_SIZE;
-            }
-
-            error = AMM_ERROR_OK;
+            watermarkChanged = updateLowWatermark ();
           }
-          else
-          {
-            /* Register the callback for a future retry */
-            pushPending (p_CallBackFunction);
 
-            error = AMM_ERROR_ALLOCATION_FAILED;
-          }
+          error = AMM_ERROR_OK;
         }
         else
         {
           /* Register the callback for a future retry */
-          pushPending (p_CallBackFunction);
+          pushPending (p_CallBackFunction, &p_VirtualMemory->RetryStats);
 
-          error = AMM_ERROR_BAD_ALLOCATION_SIZE;
+          error = AMM_ERROR_ALLOCATION_FAILED;
         }
       }
+      else
+      {
+        /* Register the callback for a future retry */
+        pushPending (p_CallBackFunction, &p_VirtualMemory->RetryStats);
+
+        error = AMM_ERROR_BAD_ALLOCATION_SIZE;
+      }
+
+      /* Exit critical section */
+      UTIL_SEQ_EXIT_CRITICAL_SECTION ();
     }
+  }
 
-    /* Exit critical section */
-    UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+  /* The buffer is owned by the caller, no need of critical section to fulfill it */
+  if (error == AMM_ERROR_OK)
+  {
+    /* Fulfill the header */
+    *p_TmpAllocAddr = header;
+
+    /* Provide the right address to user, ie without the header */
+    *pp_AllocBuffer = (uint32_t *)(p_TmpAllocAddr + VIRTUAL_MEMORY_HEADER_SIZE);
+  }
+
+  /* Notify out of the critical section */
+  if (watermarkChanged == TRUE)
+  {
+    AMM_LowWatermarkNotification (AmmLowWatermarkReached);
   }
 
   return error;
@@ -478,8 +569,12 @@ AMM_Function_Error_t AMM_Free (uint32_t * const p_BufferAddr)
   int32_t occupiedOverRequired = 0x00;
   uint32_t allocatedSize = 0x00;
 
+  uint8_t watermarkChanged = FALSE;
+
   uint32_t * p_TmpAllocAddr = NULL;
 
+  VirtualMemoryInfo_t * p_VirtualMemory = NULL;
+
   if (AmmInitialized == NOT_INITIALIZED)
   {
     error = AMM_ERROR_NOT_INIT;
@@ -500,19 +595,24 @@ AMM_Function_Error_t AMM_Free (uint32_t * const p_BufferAddr)
   }
   else
   {
-    /* Enter critical section */
-    UTIL_SEQ_ENTER_CRITICAL_SECTION ();
-
     /* First correct the address by adding the header */
     p_TmpAllocAddr = (uint32_t *)(p_BufferAddr - VIRTUAL_MEMORY_HEADER_SIZE);
 
-    /* Get the virtual memory information */
+    /* Get the virtual memory information, the header is not modified until the buffer is freed */
     virtualId = (*p_TmpAllocAddr & VIRTUAL_MEMORY_HEADER_ID_MASK) >> VIRTUAL_MEMORY_HEADER_ID_POS;
     allocatedSize = (*p_TmpAllocAddr & VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_MASK) >> VIRTUAL_MEMORY_HEADER_BUFFER_SIZE_POS;
 
     /* Add header size to allocated size */
     allocatedSize = allocatedSize + VIRTUAL_MEMORY_HEADER_SIZE;
 
+    if (virtualId != AMM_NO_VIRTUAL_ID)
+    {
+      p_VirtualMemory = getVirtualMemory (virtualId);
+    }
+
+    /* Enter critical section */
+    UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
     /* Free the allocated memory */
     AmmBmmFunctionsHandler.Free(p_TmpAllocAddr);
 
@@ -524,51 +624,48 @@ AMM_Function_Error_t AMM_Free (uint32_t * const p_BufferAddr)
 
       error = AMM_ERROR_OK;
     }
-    else
+    else if (p_VirtualMemory == NULL)
     {
       error = AMM_ERROR_UNKNOWN_ID;
+    }
+    else
+    {
+      occupiedOverRequired = (p_VirtualMemory->OccupiedSize - p_VirtualMemory->RequiredSize);
 
-      for (uint32_t memIdx = 0x00;
-           (memIdx < AmmVirtualMemoryNumber) && (error == AMM_ERROR_UNKNOWN_ID);
-           memIdx++)
+      /* Check whether the occupied size has overlaped the required or not */
+      if (occupiedOverRequired > 0x00)
       {
-        /* Check if it is the right ID */
-        if (virtualId == p_AmmVirtualMemoryList[memIdx].Id)
+        /* Check if reserved memory is overlapped */
+        if (allocatedSize > occupiedOverRequired)
         {
-          occupiedOverRequired = (p_AmmVirtualMemoryList[memIdx].OccupiedSize - p_AmmVirtualMemoryList[memIdx].RequiredSize);
-
-          /* Check whether the occupied size has overlaped the required or not */
-          if (occupiedOverRequired > 0x00)
-          {
-            /* Check if reserved memory is overlapped */
-            if (allocatedSize > occupiedOverRequired)
-            {
-              /* Update the occupation size */
-              AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize
-                                          - (p_AmmVirtualMemoryList[memIdx].OccupiedSize
-                                          - p_AmmVirtualMemoryList[memIdx].RequiredSize);
-            }
-            else
-            {
-              AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize - allocatedSize;
-            }
-          }
-
           /* Update the occupation size */
-          p_AmmVirtualMemoryList[memIdx].OccupiedSize = p_AmmVirtualMemoryList[memIdx].OccupiedSize
-                                                        - allocatedSize;
-
-          error = AMM_ERROR_OK;
+          AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize - occupiedOverRequired;
+        }
+        else
+        {
+          AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize - allocatedSize;
         }
       }
+
+      /* Update the occupation size */
+      p_VirtualMemory->OccupiedSize = p_VirtualMemory->OccupiedSize - allocatedSize;
+
+      error = AMM_ERROR_OK;
     }
 
+    watermarkChanged = updateLowWatermark ();
+
     /* Pop pending callbacks and add them to the active fifo */
     passPendingToActive ();
 
     /* Exit critical section */
     UTIL_SEQ_EXIT_CRITICAL_SECTION ();
 
+    if (watermarkChanged == TRUE)
+    {
+      AMM_LowWatermarkNotification (AmmLowWatermarkReached);
+    }
+
     /* Ask the user task to proceed to a background process call */
     AMM_ProcessRequest();
   }
@@ -576,6 +673,287 @@ AMM_Function_Error_t AMM_Free (uint32_t * const p_BufferAddr)
   return error;
 }
 
+AMM_Function_Error_t AMM_GetVirtualMemoryStats (const uint8_t VirtualMemoryId,
+                                                AMM_VirtualMemoryStats_t * const p_Stats)
+{
+  AMM_Function_Error_t error = AMM_ERROR_NOK;
+
+  uint32_t selfAvailable = 0x00;
+
+  VirtualMemoryInfo_t * p_VirtualMemory = NULL;
+
+  if (AmmInitialized == NOT_INITIALIZED)
+  {
+    error = AMM_ERROR_NOT_INIT;
+  }
+  else if (p_Stats == NULL)
+  {
+    error = AMM_ERROR_BAD_POINTER;
+  }
+  else
+  {
+    if (VirtualMemoryId != AMM_NO_VIRTUAL_ID)
+    {
+      p_VirtualMemory = getVirtualMemory (VirtualMemoryId);
+    }
+
+    if ((VirtualMemoryId != AMM_NO_VIRTUAL_ID) && (p_VirtualMemory == NULL))
+    {
+      error = AMM_ERROR_UNKNOWN_ID;
+    }
+    else
+    {
+      /* Enter critical section */
+      UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+      if (p_VirtualMemory == NULL)
+      {
+        p_Stats->OccupiedSize = AmmOccupiedSharedPoolSize;
+        p_Stats->ReservedSize = 0x00;
+      }
+      else
+      {
+        /* Compute what is remaining of the reserved memory */
+        if (p_VirtualMemory->OccupiedSize < p_VirtualMemory->RequiredSize)
+        {
+          selfAvailable = p_VirtualMemory->RequiredSize - p_VirtualMemory->OccupiedSize;
+        }
+
+        p_Stats->OccupiedSize = p_VirtualMemory->OccupiedSize;
+        p_Stats->ReservedSize = p_VirtualMemory->RequiredSize;
+      }
+
+      /* Same computation as in AMM_Alloc */
+      p_Stats->AvailableSize = AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize + selfAvailable;
+
+      /* Exit critical section */
+      UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+
+      error = AMM_ERROR_OK;
+    }
+  }
+
+  return error;
+}
+AMM_Function_Error_t AMM_GetLargestFreeBlock (uint32_t * const p_Size)
+{
+  AMM_Function_Error_t error = AMM_ERROR_NOK;
+
+  if (AmmInitialized == NOT_INITIALIZED)
+  {
+    error = AMM_ERROR_NOT_INIT;
+  }
+  else if (p_Size == NULL)
+  {
+    error = AMM_ERROR_BAD_POINTER;
+  }
+  else if (AmmBmmFunctionsHandler.GetLargestFreeBlock != NULL)
+  {
+    /* Enter critical section */
+    UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+    *p_Size = AmmBmmFunctionsHandler.GetLargestFreeBlock ();
+
+    /* Exit critical section */
+    UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+
+    /* Remove the header added by the AMM to each allocation */
+    if (*p_Size > VIRTUAL_MEMORY_HEADER_SIZE)
+    {
+      *p_Size = *p_Size - VIRTUAL_MEMORY_HEADER_SIZE;
+    }
+    else
+    {
+      *p_Size = 0x00;
+    }
+
+    error = AMM_ERROR_OK;
+  }
+  else
+  {
+    /* Not supported by the Basic Memory Manager */
+  }
+
+  return error;
+}
+
+AMM_Function_Error_t AMM_GetRetryStats (const uint8_t VirtualMemoryId,
+                                        AMM_RetryStats_t * const p_Stats)
+{
+  AMM_Function_Error_t error = AMM_ERROR_NOK;
+
+  VirtualMemoryInfo_t * p_VirtualMemory = NULL;
+
+  if (AmmInitialized == NOT_INITIALIZED)
+  {
+    error = AMM_ERROR_NOT_INIT;
+  }
+  else if (p_Stats == NULL)
+  {
+    error = AMM_ERROR_BAD_POINTER;
+  }
+  else
+  {
+    if (VirtualMemoryId != AMM_NO_VIRTUAL_ID)
+    {
+      p_VirtualMemory = getVirtualMemory (VirtualMemoryId);
+    }
+
+    if ((VirtualMemoryId != AMM_NO_VIRTUAL_ID) && (p_VirtualMemory == NULL))
+    {
+      error = AMM_ERROR_UNKNOWN_ID;
+    }
+    else
+    {
+      /* Enter critical section */
+      UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+      if (p_VirtualMemory == NULL)
+      {
+        *p_Stats = AmmSharedRetryStats;
+      }
+      else
+      {
+        *p_Stats = p_VirtualMemory->RetryStats;
+      }
+
+      /* Exit critical section */
+      UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+
+      error = AMM_ERROR_OK;
+    }
+  }
+
+  return error;
+}
+
+AMM_Function_Error_t AMM_SetLowWatermark (const uint32_t Size)
+{
+  AMM_Function_Error_t error = AMM_ERROR_NOK;
+
+  uint8_t watermarkChanged = FALSE;
+
+  if (AmmInitialized == NOT_INITIALIZED)
+  {
+    error = AMM_ERROR_NOT_INIT;
+  }
+  else
+  {
+    /* Enter critical section */
+    UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+    AmmLowWatermark = Size;
+
+    watermarkChanged = updateLowWatermark ();
+
+    /* Exit critical section */
+    UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+
+    if (watermarkChanged == TRUE)
+    {
+      AMM_LowWatermarkNotification (AmmLowWatermarkReached);
+    }
+
+    error = AMM_ERROR_OK;
+  }
+
+  return error;
+}
+
+AMM_Function_Error_t AMM_ResizeVirtualMemory (const uint8_t VirtualMemoryId,
+                                              const uint32_t NewSize)
+{
+  AMM_Function_Error_t error = AMM_ERROR_NOK;
+
+  uint32_t heldSize = 0x00;
+
+  uint8_t watermarkChanged = FALSE;
+  uint8_t released = FALSE;
+
+  VirtualMemoryInfo_t * p_VirtualMemory = NULL;
+
+  if (AmmInitialized == NOT_INITIALIZED)
+  {
+    error = AMM_ERROR_NOT_INIT;
+  }
+  else if (VirtualMemoryId == AMM_NO_VIRTUAL_ID)
+  {
+    error = AMM_ERROR_UNKNOWN_ID;
+  }
+  else
+  {
+    /* Check if ID is known */
+    p_VirtualMemory = getVirtualMemory (VirtualMemoryId);
+
+    if (p_VirtualMemory == NULL)
+    {
+      error = AMM_ERROR_UNKNOWN_ID;
+    }
+    else
+    {
+      /* Enter critical section */
+      UTIL_SEQ_ENTER_CRITICAL_SECTION ();
+
+      /* Size kept out of the free shared pool: the reservation, or the occupation when it overlaps the reservation */
+      heldSize = p_VirtualMemory->RequiredSize;
+      if (p_VirtualMemory->OccupiedSize > heldSize)
+      {
+        heldSize = p_VirtualMemory->OccupiedSize;
+      }
+
+      /* The reservation shall cover the buffers already allocated */
+      if (NewSize < p_VirtualMemory->OccupiedSize)
+      {
+        error = AMM_ERROR_BAD_ALLOCATION_SIZE;
+      }
+      /* Check for enough space in the shared pool, same computation as in AMM_Alloc */
+      else if ((NewSize > heldSize)
+               && ((NewSize - heldSize) >= (AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize)))
+      {
+        error = AMM_ERROR_BAD_ALLOCATION_SIZE;
+      }
+      else
+      {
+        /* The overlap of the reservation was counted in the shared pool, it is now in the reservation */
+        AmmOccupiedSharedPoolSize = AmmOccupiedSharedPoolSize - (heldSize - p_VirtualMemory->RequiredSize);
+
+        /* Actualize the sum of the reservations */
+        AmmRequiredVirtualMemorySize = AmmRequiredVirtualMemorySize - p_VirtualMemory->RequiredSize + NewSize;
+
+        p_VirtualMemory->RequiredSize = NewSize;
+
+        if (NewSize < heldSize)
+        {
+          released = TRUE;
+
+          /* Pop pending callbacks and add them to the active fifo */
+          passPendingToActive ();
+        }
+
+        watermarkChanged = updateLowWatermark ();
+
+        error = AMM_ERROR_OK;
+      }
+
+      /* Exit critical section */
+      UTIL_SEQ_EXIT_CRITICAL_SECTION ();
+
+      if (watermarkChanged == TRUE)
+      {
+        AMM_LowWatermarkNotification (AmmLowWatermarkReached);
+      }
+
+      if (released == TRUE)
+      {
+        /* Ask the user task to proceed to a background process call */
+        AMM_ProcessRequest();
+      }
+    }
+  }
+
+  return error;
+}
+
 void AMM_BackgroundProcess (void)
 {
   AMM_VirtualMemoryCallbackFunction_t * p_tmpCallback = NULL;
@@ -595,12 +973,25 @@ void AMM_BackgroundProcess (void)
 
 /* Private Functions Definition ------------------------------------------------------*/
 
-void pushPending (AMM_VirtualMemoryCallbackFunction_t * const p_CallbackElt)
+void pushPending (AMM_VirtualMemoryCallbackFunction_t * const p_CallbackElt,
+                  AMM_RetryStats_t * const p_RetryStats)
 {
+  AMM_CallbackPriority_t priority = AMM_PRIORITY_NORMAL;
+
+  p_RetryStats->AllocFailedNbr++;
+
   if (p_CallbackElt != NULL)
   {
+    /* Unknown priorities are handled as normal ones */
+    if (p_CallbackElt->Priority < AMM_PRIORITY_NBR)
+    {
+      priority = p_CallbackElt->Priority;
+    }
+
     /* Add the new callback */
-    LST_insert_tail (&AmmPendingCallback, (tListNode *)p_CallbackElt);
+    LST_insert_tail (&AmmPendingCallback[priority], (tListNode *)p_CallbackElt);
+
+    p_RetryStats->CallbackQueuedNbr++;
   }
 }
 
@@ -608,12 +999,17 @@ void passPendingToActive (void)
 {
   AMM_VirtualMemoryCallbackFunction_t * p_TmpElt = NULL;
 
-  while (LST_is_empty (&AmmPendingCallback) == FALSE)
+  for (uint32_t prioIdx = 0x00;
+       prioIdx < AMM_PRIORITY_NBR;
+       prioIdx++)
   {
-    /* Remove the head element */
-    LST_remove_head (&AmmPendingCallback, (tListNode**)&p_TmpElt);
-    /* Add at the bottom */
-    LST_insert_tail (&AmmActiveCallback, (tListNode *)p_TmpElt);
+    while (LST_is_empty (&AmmPendingCallback[prioIdx]) == FALSE)
+    {
+      /* Remove the head element */
+      LST_remove_head (&AmmPendingCallback[prioIdx], (tListNode**)&p_TmpElt);
+      /* Add at the bottom */
+      LST_insert_tail (&AmmActiveCallback[prioIdx], (tListNode *)p_TmpElt);
+    }
   }
 }
 
@@ -621,11 +1017,50 @@ AMM_VirtualMemoryCallbackFunction_t * popActive (void)
 {
   AMM_VirtualMemoryCallbackFunction_t * p_error = NULL;
 
-  if (LST_is_empty (&AmmActiveCallback) == FALSE)
+  /* Highest priority first */
+  for (uint32_t orderIdx = 0x00;
+       (orderIdx < AMM_PRIORITY_NBR) && (p_error == NULL);
+       orderIdx++)
   {
-    /* Remove last element */
-    LST_remove_head (&AmmActiveCallback, (tListNode**)&p_error);
+    if (LST_is_empty (&AmmActiveCallback[AmmPriorityOrder[orderIdx]]) == FALSE)
+    {
+      /* Remove first element */
+      LST_remove_head (&AmmActiveCallback[AmmPriorityOrder[orderIdx]], (tListNode**)&p_error);
+    }
+  }
+
+  return p_error;
+}
+
+VirtualMemoryInfo_t * getVirtualMemory (const uint8_t VirtualMemoryId)
+{
+  VirtualMemoryInfo_t * p_error = NULL;
+
+  if ((VirtualMemoryId <= AMM_CONF_VIRTUAL_ID_MAX)
+   && (AmmVirtualMemoryIndex[VirtualMemoryId] != VIRTUAL_MEMORY_INDEX_UNKNOWN))
+  {
+    p_error = &p_AmmVirtualMemoryList[AmmVirtualMemoryIndex[VirtualMemoryId]];
   }
 
   return p_error;
 }
+
+uint8_t updateLowWatermark (void)
+{
+  uint8_t reached = FALSE;
+  uint8_t changed = FALSE;
+
+  if ((AmmLowWatermark != 0x00)
+   && ((AmmPoolSize - AmmOccupiedSharedPoolSize - AmmRequiredVirtualMemorySize) < AmmLowWatermark))
+  {
+    reached = TRUE;
+  }
+
+  if (reached != AmmLowWatermarkReached)
+  {
+    AmmLowWatermarkReached = reached;
+    changed = TRUE;
+  }
+
+  return changed;
+}
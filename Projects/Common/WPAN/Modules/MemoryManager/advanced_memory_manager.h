@@ -40,7 +40,7 @@
  * - numberOfVirtualMemory = 3
  * - actualSizeOfThePoolToGive = sizeOfDesiredPool + numberOfVirtualMemory * AMM_VIRTUAL_INFO_ELEMENT_SIZE
  */
-#define AMM_VIRTUAL_INFO_ELEMENT_SIZE 0x3u
+#define AMM_VIRTUAL_INFO_ELEMENT_SIZE 0x5u
 
 /* Exported types ------------------------------------------------------------*/
 /* Redefine the header for chained list */
@@ -107,6 +107,8 @@ typedef struct AMM_BasicMemoryManagerFunctions
   uint32_t * (* Allocate) (const uint32_t BufferSize);
   /* Basic Memory Manager Free function */
   void (* Free) (uint32_t * const p_BufferAddr);
+  /* Basic Memory Manager largest free block function - Optional, can be NULL - Shall be in 32bits words - */
+  uint32_t (* GetLargestFreeBlock) (void);
 }AMM_BasicMemoryManagerFunctions_t;
 
 /**
@@ -131,6 +133,45 @@ typedef struct AMM_InitParameters
   AMM_VirtualMemoryConfig_t * p_VirtualMemoryConfigList;
 }AMM_InitParameters_t;
 
+/**
+ * @brief   Virtual Memory occupation struct
+ *
+ * @details All the sizes are a multiple of 32bits and include the buffer headers.
+ */
+typedef struct AMM_VirtualMemoryStats
+{
+  /* Current occupation of the Virtual Memory */
+  uint32_t OccupiedSize;
+  /* Size that can still be allocated: remaining reserved memory plus free shared memory */
+  uint32_t AvailableSize;
+  /* Size reserved for the Virtual Memory - 0 for the shared pool - */
+  uint32_t ReservedSize;
+}AMM_VirtualMemoryStats_t;
+
+/**
+ * @brief   Allocation retry statistics struct
+ */
+typedef struct AMM_RetryStats
+{
+  /* Number of failed allocations */
+  uint32_t AllocFailedNbr;
+  /* Number of callbacks registered for a retry */
+  uint32_t CallbackQueuedNbr;
+}AMM_RetryStats_t;
+
+/* Priority of a retry callback, high priority callbacks are invoked first */
+typedef enum AMM_CallbackPriority
+{
+  /* Default priority */
+  AMM_PRIORITY_NORMAL,
+  /* Critical consumers, invoked before the others */
+  AMM_PRIORITY_HIGH,
+  /* Bulk consumers, invoked after the others */
+  AMM_PRIORITY_LOW,
+  /* Number of priorities */
+  AMM_PRIORITY_NBR
+} AMM_CallbackPriority_t;
+
 /**
  * @brief   Virtual Memory Callback function struct
  */
@@ -140,6 +181,8 @@ typedef struct AMM_VirtualMemoryCallbackFunction
   AMM_VirtualMemoryCallbackHeader_t Header;
   /* Callback function pointer to invoke once memory has been freed */
   void (* Callback) (void);
+  /* Priority of the callback - AMM_PRIORITY_NORMAL when not set - */
+  AMM_CallbackPriority_t Priority;
 }AMM_VirtualMemoryCallbackFunction_t;
 
 /* Exported constants --------------------------------------------------------*/
@@ -209,6 +252,71 @@ AMM_Function_Error_t AMM_Alloc (const uint8_t VirtualMemoryId,
  */
 AMM_Function_Error_t AMM_Free (uint32_t * const p_BufferAddr);
 
+/**
+ * @brief  Get the occupation of a Virtual Memory
+ * @param  VirtualMemoryId: Virtual Memory Identifier - AMM_NO_VIRTUAL_ID Can be used for the shared pool -
+ * @param  p_Stats: Pointer onto the occupation to fulfill
+ * @return Status of the request
+ * @retval AMM_Function_Error_t::AMM_ERROR_OK
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOT_INIT
+ * @retval AMM_Function_Error_t::AMM_ERROR_BAD_POINTER
+ * @retval AMM_Function_Error_t::AMM_ERROR_UNKNOWN_ID
+ */
+AMM_Function_Error_t AMM_GetVirtualMemoryStats (const uint8_t VirtualMemoryId,
+                                                AMM_VirtualMemoryStats_t * const p_Stats);
+
+/**
+ * @brief  Get the largest buffer the Basic Memory Manager can provide
+ * @details Can take time as the Basic Memory Manager may walk all its free blocks
+ * @param  p_Size: Pointer onto the size to fulfill, with a multiple of 32bits
+ * @return Status of the request
+ * @retval AMM_Function_Error_t::AMM_ERROR_OK
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOK - Not supported by the Basic Memory Manager -
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOT_INIT
+ * @retval AMM_Function_Error_t::AMM_ERROR_BAD_POINTER
+ */
+AMM_Function_Error_t AMM_GetLargestFreeBlock (uint32_t * const p_Size);
+
+/**
+ * @brief  Get the allocation retry statistics of a Virtual Memory
+ * @param  VirtualMemoryId: Virtual Memory Identifier - AMM_NO_VIRTUAL_ID Can be used for the shared pool -
+ * @param  p_Stats: Pointer onto the statistics to fulfill
+ * @return Status of the request
+ * @retval AMM_Function_Error_t::AMM_ERROR_OK
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOT_INIT
+ * @retval AMM_Function_Error_t::AMM_ERROR_BAD_POINTER
+ * @retval AMM_Function_Error_t::AMM_ERROR_UNKNOWN_ID
+ */
+AMM_Function_Error_t AMM_GetRetryStats (const uint8_t VirtualMemoryId,
+                                        AMM_RetryStats_t * const p_Stats);
+
+/**
+ * @brief  Set the low watermark of the shared pool
+ * @details AMM_LowWatermarkNotification is called when the free shared pool goes below
+ *          the watermark and when it goes back above.
+ * @param  Size: Watermark with a multiple of 32bits - 0 disables the notification -
+ * @return Status of the request
+ * @retval AMM_Function_Error_t::AMM_ERROR_OK
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOT_INIT
+ */
+AMM_Function_Error_t AMM_SetLowWatermark (const uint32_t Size);
+
+/**
+ * @brief  Change the size reserved for a Virtual Memory
+ * @details The memory released by a shrink goes to the shared pool, and the pending retry callbacks
+ *          are invoked. A grow takes the memory from the free shared pool.
+ *          The reservation can not go below the current occupation of the Virtual Memory.
+ * @param  VirtualMemoryId: Virtual Memory Identifier
+ * @param  NewSize: New size of the Virtual Memory buffer with a multiple of 32bits
+ * @return Status of the request
+ * @retval AMM_Function_Error_t::AMM_ERROR_OK
+ * @retval AMM_Function_Error_t::AMM_ERROR_NOT_INIT
+ * @retval AMM_Function_Error_t::AMM_ERROR_UNKNOWN_ID
+ * @retval AMM_Function_Error_t::AMM_ERROR_BAD_ALLOCATION_SIZE - Below the occupation or not enough free shared memory -
+ */
+AMM_Function_Error_t AMM_ResizeVirtualMemory (const uint8_t VirtualMemoryId,
+                                              const uint32_t NewSize);
+
 /**
  * @brief  Background routine
  * @details Background routine that aims to call registered callbacks for an allocation retry
@@ -231,4 +339,11 @@ void AMM_RegisterBasicMemoryManager (AMM_BasicMemoryManagerFunctions_t * const p
  */
 void AMM_ProcessRequest (void);
 
+/**
+ * @brief  Notify the application that the free shared pool crossed the low watermark
+ * @param  Reached: TRUE when the free shared pool goes below the watermark, FALSE when it goes back above
+ * @return None
+ */
+void AMM_LowWatermarkNotification (const uint8_t Reached);
+
 #endif /* ADVANCED_MEMORY_MANAGER_H */
@@ -35,11 +35,212 @@
  */
 #define USE_NEW_MM   1
 
+/**
+ * When USE_LOCK_FREE_MM is set to 1, fixed-size elements are managed in a LIFO updated with
+ * LDREX/STREX (Cortex-M3 and above), it takes precedence over USE_NEW_MM.
+ * Get and release can be called from tasks and interrupts without masking the interrupts.
+ */
+#ifndef USE_LOCK_FREE_MM
+#define USE_LOCK_FREE_MM   0
+#endif
+
 /* Private macros ------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
-#if(USE_NEW_MM == 0)
+#if(USE_LOCK_FREE_MM != 0)
+
+static uint32_t * volatile p_FreeList __attribute__((section("MM_CONTEXT")));
+static uint32_t EltSize __attribute__((section("MM_CONTEXT")));
+static uint32_t EltNbr __attribute__((section("MM_CONTEXT")));
+static uint8_t *p_StartPoolAdd __attribute__((section("MM_CONTEXT")));
+static uint8_t *p_EndPoolAdd __attribute__((section("MM_CONTEXT")));
+static MM_pCb_t volatile BufferFreeCb __attribute__((section("MM_CONTEXT")));
+static volatile uint32_t FreeEltNbr __attribute__((section("MM_CONTEXT")));
+static volatile uint32_t MinFreeEltNbr __attribute__((section("MM_CONTEXT")));
+static volatile uint32_t AllocNbr __attribute__((section("MM_CONTEXT")));
+static volatile uint32_t AllocFailedNbr __attribute__((section("MM_CONTEXT")));
+
+/* Private function prototypes -----------------------------------------------*/
+static inline uint32_t AtomicAdd( volatile uint32_t *p_value, int32_t delta );
+static inline void AtomicMin( volatile uint32_t *p_value, uint32_t value );
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+ * @brief  Initialize the Pools
+ * @param  p_pool: The pool of memory to manage - Shall be 32bits aligned -
+ * @param  pool_size: The size of the pool
+ * @param  elt_size: The size of one element in the pool
+ * @retval None
+ */
+void MM_Init(uint8_t *p_pool, uint32_t pool_size,  uint32_t elt_size)
+{
+  uint32_t *p_elt;
+
+  EltSize = 4*DIVC( elt_size, 4 );
+  EltNbr = 0;
+
+  /**
+   * Save the first and last address of the pool of memory
+   */
+  p_StartPoolAdd = p_pool;
+  p_EndPoolAdd = p_pool + pool_size - 1;
+
+  /**
+   *  Chain the elements through their first word, in address order
+   */
+  p_FreeList = NULL;
+  while(pool_size >= EltSize)
+  {
+    pool_size -= EltSize;
+    p_elt = (uint32_t *)(p_pool + pool_size);
+    *p_elt = (uint32_t)p_FreeList;
+    p_FreeList = p_elt;
+    EltNbr++;
+  }
+
+  BufferFreeCb = 0;
+  FreeEltNbr = EltNbr;
+  MinFreeEltNbr = EltNbr;
+  AllocNbr = 0;
+  AllocFailedNbr = 0;
+
+  return;
+}
+
+/**
+ * @brief  Provide a buffer
+ * @note   Can be called from any context. On a single core, the exclusive monitor is cleared on
+ *         each exception entry and return, so the head can not be changed by an interrupt between
+ *         LDREX and STREX without the STREX failing: there is no ABA issue.
+ *
+ * @param  size: The size of the buffer requested
+ * @param  cb: The callback to be called when a buffer is made available later on
+ *                   if there is no buffer currently available when this API is called
+ * @retval The buffer address when available or NULL when there is no buffer
+ */
+MM_pBufAdd_t MM_GetBuffer( uint32_t size, MM_pCb_t cb )
+{
+  uint32_t *p_elt;
+
+  if( size > EltSize )
+  {
+    /* No element can hold this buffer */
+    (void)AtomicAdd( &AllocFailedNbr, 1 );
+    return 0;
+  }
+
+  do
+  {
+    p_elt = (uint32_t *)__LDREXW( (volatile uint32_t *)&p_FreeList );
+    if( p_elt == NULL )
+    {
+      __CLREX();
+      break;
+    }
+  } while( __STREXW( *p_elt, (volatile uint32_t *)&p_FreeList ) != 0U );
+
+  if( p_elt != NULL )
+  {
+    BufferFreeCb = 0;
+    (void)AtomicAdd( &AllocNbr, 1 );
+    AtomicMin( &MinFreeEltNbr, AtomicAdd( &FreeEltNbr, -1 ) );
+  }
+  else
+  {
+    BufferFreeCb = cb;
+    (void)AtomicAdd( &AllocFailedNbr, 1 );
+  }
+
+  return (MM_pBufAdd_t)p_elt;
+}
+
+/**
+ * @brief  Release a buffer
+ * @note   Can be called from any context
+ * @param  p_buffer: The data buffer address
+ * @retval None
+ */
+void MM_ReleaseBuffer( MM_pBufAdd_t p_buffer )
+{
+  uint32_t *p_elt = (uint32_t *)p_buffer;
+  MM_pCb_t cb;
+
+  if((p_buffer >= p_StartPoolAdd) && (p_buffer <= p_EndPoolAdd))
+  {
+    do
+    {
+      *p_elt = __LDREXW( (volatile uint32_t *)&p_FreeList );
+    } while( __STREXW( (uint32_t)p_elt, (volatile uint32_t *)&p_FreeList ) != 0U );
+
+    (void)AtomicAdd( &FreeEltNbr, 1 );
+
+    cb = BufferFreeCb;
+    if( cb )
+    {
+      /**
+       * The application is waiting for a free buffer
+       */
+      cb();
+    }
+  }
+
+  return;
+}
+
+/**
+ * @brief  Provide the usage counters
+ * @param  p_stats: The counters to fulfill
+ * @retval None
+ */
+void MM_GetStats( MM_Stats_t *p_stats )
+{
+  p_stats->EltNbr = EltNbr;
+  p_stats->FreeEltNbr = FreeEltNbr;
+  p_stats->MinFreeEltNbr = MinFreeEltNbr;
+  p_stats->AllocNbr = AllocNbr;
+  p_stats->AllocFailedNbr = AllocFailedNbr;
+
+  return;
+}
+
+/**
+ * @brief  Add a value to a counter without masking the interrupts
+ * @param  p_value: The counter
+ * @param  delta: The value to add
+ * @retval The new value of the counter
+ */
+static inline uint32_t AtomicAdd( volatile uint32_t *p_value, int32_t delta )
+{
+  uint32_t value;
+
+  do
+  {
+    value = __LDREXW( p_value ) + (uint32_t)delta;
+  } while( __STREXW( value, p_value ) != 0U );
+
+  return value;
+}
+
+/**
+ * @brief  Lower a counter to a value without masking the interrupts
+ * @param  p_value: The counter
+ * @param  value: The new value if it is lower
+ * @retval None
+ */
+static inline void AtomicMin( volatile uint32_t *p_value, uint32_t value )
+{
+  do
+  {
+    if( __LDREXW( p_value ) <= value )
+    {
+      __CLREX();
+      break;
+    }
+  } while( __STREXW( value, p_value ) != 0U );
+}
+
+#elif(USE_NEW_MM == 0)
 #pragma default_variable_attributes = @"MM_CONTEXT"
 
 static uint8_t QueueSize;
@@ -47,6 +248,10 @@ static tListNode BufferPool;
 static MM_pCb_t BufferFreeCb;
 static uint8_t *p_StartPoolAdd;
 static uint8_t *p_EndPoolAdd;
+static uint8_t EltNbr;
+static uint8_t MinQueueSize;
+static uint32_t AllocNbr;
+static uint32_t AllocFailedNbr;
 
 #pragma default_variable_attributes =
 
@@ -89,6 +294,11 @@ void MM_Init(uint8_t *p_pool, uint32_t pool_size,  uint32_t elt_size)
     pool_size -= elt_size_corrected;
   }
 
+  EltNbr = QueueSize;
+  MinQueueSize = QueueSize;
+  AllocNbr = 0;
+  AllocFailedNbr = 0;
+
   return;
 }
 
@@ -121,6 +331,11 @@ MM_pBufAdd_t MM_GetBuffer( uint32_t size, MM_pCb_t cb )
         /* The buffer is in a valid range */
         BufferFreeCb = 0;
         allocation_exit = TRUE;
+        AllocNbr++;
+        if( QueueSize < MinQueueSize )
+        {
+          MinQueueSize = QueueSize;
+        }
       }
       else
       {
@@ -135,6 +350,7 @@ MM_pBufAdd_t MM_GetBuffer( uint32_t size, MM_pCb_t cb )
       BufferFreeCb = cb;
       buffer_address = 0;
       allocation_exit = TRUE;
+      AllocFailedNbr++;
     }
     __set_PRIMASK( primask_bit );     /**< Restore PRIMASK bit*/
   }
@@ -169,12 +385,35 @@ void MM_ReleaseBuffer( MM_pBufAdd_t p_buffer )
 
   return;
 }
+
+/**
+ * @brief  Provide the usage counters
+ * @param  p_stats: The counters to fulfill
+ * @retval None
+ */
+void MM_GetStats( MM_Stats_t *p_stats )
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+  p_stats->EltNbr = EltNbr;
+  p_stats->FreeEltNbr = QueueSize;
+  p_stats->MinFreeEltNbr = MinQueueSize;
+  p_stats->AllocNbr = AllocNbr;
+  p_stats->AllocFailedNbr = AllocFailedNbr;
+  __set_PRIMASK( primask_bit );     /**< Restore PRIMASK bit*/
+
+  return;
+}
 #else
 #include "stm32_mm.h"
 
 static uint8_t *p_StartPoolAdd __attribute__((section("MM_CONTEXT")));
 static uint8_t *p_EndPoolAdd __attribute__((section("MM_CONTEXT")));
 static MM_pCb_t BufferFreeCb __attribute__((section("MM_CONTEXT")));
+static uint32_t AllocNbr __attribute__((section("MM_CONTEXT")));
+static uint32_t AllocFailedNbr __attribute__((section("MM_CONTEXT")));
 
 /* Functions Definition ------------------------------------------------------*/
 void MM_Init(uint8_t *p_pool, uint32_t pool_size,  uint32_t elt_size)
@@ -184,6 +423,8 @@ void MM_Init(uint8_t *p_pool, uint32_t pool_size,  uint32_t elt_size)
    */
   p_StartPoolAdd = p_pool;
   p_EndPoolAdd = p_pool + pool_size - 1;
+  AllocNbr = 0;
+  AllocFailedNbr = 0;
 
   UTIL_MM_Init(p_pool, pool_size);
 
@@ -235,6 +476,7 @@ MM_pBufAdd_t MM_GetBuffer( uint32_t size, MM_pCb_t cb )
         /* The buffer is in a valid range */
         BufferFreeCb = 0;
         allocation_exit = TRUE;
+        AllocNbr++;
       }
       else
       {
@@ -248,6 +490,7 @@ MM_pBufAdd_t MM_GetBuffer( uint32_t size, MM_pCb_t cb )
     {
       BufferFreeCb = cb;
       allocation_exit = TRUE;
+      AllocFailedNbr++;
     }
   }
 
@@ -285,4 +528,21 @@ void MM_ReleaseBuffer( MM_pBufAdd_t p_buffer )
   return;
 }
 
+/**
+ * @brief  Provide the usage counters
+ * @note   The elements are not fixed-size, only the allocation counters are provided
+ * @param  p_stats: The counters to fulfill
+ * @retval None
+ */
+void MM_GetStats( MM_Stats_t *p_stats )
+{
+  p_stats->EltNbr = 0;
+  p_stats->FreeEltNbr = 0;
+  p_stats->MinFreeEltNbr = 0;
+  p_stats->AllocNbr = AllocNbr;
+  p_stats->AllocFailedNbr = AllocFailedNbr;
+
+  return;
+}
+
 #endif
@@ -28,6 +28,15 @@
 typedef void (*MM_pCb_t)( void );
 typedef  uint8_t (*MM_pBufAdd_t);
 
+typedef struct
+{
+  uint32_t EltNbr;          /* Number of elements in the pool (0 when elements are not fixed-size) */
+  uint32_t FreeEltNbr;      /* Number of elements currently free */
+  uint32_t MinFreeEltNbr;   /* Lowest number of free elements since init */
+  uint32_t AllocNbr;        /* Number of buffers provided */
+  uint32_t AllocFailedNbr;  /* Number of requests without buffer available */
+} MM_Stats_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
@@ -35,6 +44,7 @@ typedef  uint8_t (*MM_pBufAdd_t);
 void MM_Init(uint8_t *p_pool, uint32_t pool_size,  uint32_t elt_size);
 MM_pBufAdd_t MM_GetBuffer(uint32_t size, MM_pCb_t cb );
 void MM_ReleaseBuffer( MM_pBufAdd_t p_buffer );
+void MM_GetStats( MM_Stats_t *p_stats );
 
 /* Exported functions to be implemented by the user if required ------------- */
 
@@ -163,6 +163,11 @@ static const size_t xHeapStructSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( p
 /* Create a couple of list links to mark the start and end of the list. */
 PRIVILEGED_DATA static BlockLink_t xStart, * pxEnd = NULL;
 
+#if (KEEP_ORIGINAL_CODE_FROM_FREERTOS == 0)
+/* First block of the pool, used to walk all the blocks. */
+PRIVILEGED_DATA static uint8_t * pucHeapStart = NULL;
+#endif
+
 /* Keeps track of the number of calls to allocate and free memory as well as the
  * number of free bytes remaining, but says nothing about fragmentation. */
 PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
@@ -386,6 +391,89 @@ void vPortFree( void * pv )
     }
 }
 /*-----------------------------------------------------------*/
+#if (KEEP_ORIGINAL_CODE_FROM_FREERTOS == 0)
+size_t UTIL_MM_GetLargestFreeBlock( void )
+{
+    BlockLink_t * pxBlock;
+    size_t xMaxSize = 0;
+
+    pxBlock = xStart.pxNextFreeBlock;
+
+    /* pxBlock will be NULL if the heap has not been initialised. */
+    if( pxBlock != NULL )
+    {
+        while( pxBlock != pxEnd )
+        {
+            if( pxBlock->xBlockSize > xMaxSize )
+            {
+                xMaxSize = pxBlock->xBlockSize;
+            }
+
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+    }
+
+    /* The structure placed at the beginning of the block is not available to the user */
+    if( xMaxSize > xHeapStructSize )
+    {
+        xMaxSize -= xHeapStructSize;
+    }
+    else
+    {
+        xMaxSize = 0;
+    }
+
+    return xMaxSize;
+}
+/*-----------------------------------------------------------*/
+
+void UTIL_MM_GetHeapStats( UTIL_MM_HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlockSize;
+    uint32_t ulHistoIndex;
+
+    memset( pxHeapStats, 0, sizeof( UTIL_MM_HeapStats_t ) );
+
+    /* Blocks are contiguous from the start of the pool up to pxEnd. */
+    if( pucHeapStart != NULL )
+    {
+        pxBlock = ( BlockLink_t * ) pucHeapStart;
+
+        while( pxBlock < pxEnd )
+        {
+            xBlockSize = pxBlock->xBlockSize & ~xBlockAllocatedBit;
+
+            if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 )
+            {
+                pxHeapStats->UsedBlockNbr++;
+            }
+            else
+            {
+                pxHeapStats->FreeBlockNbr++;
+
+                for( ulHistoIndex = 0; ( ulHistoIndex < ( UTIL_MM_HISTO_NBR - 1U ) ) && ( xBlockSize >= ( ( size_t ) 32 << ulHistoIndex ) ); ulHistoIndex++ )
+                {
+                }
+                pxHeapStats->FreeBlockHisto[ ulHistoIndex ]++;
+            }
+
+            /* A block of size 0 would loop forever, the heap is corrupted. */
+            if( xBlockSize == 0 )
+            {
+                break;
+            }
+
+            pxBlock = ( BlockLink_t * ) ( ( uint8_t * ) pxBlock + xBlockSize );
+        }
+    }
+
+    pxHeapStats->FreeBytes = xFreeBytesRemaining;
+    pxHeapStats->MinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+    pxHeapStats->LargestFreeBlock = UTIL_MM_GetLargestFreeBlock();
+}
+#endif
+/*-----------------------------------------------------------*/
 #if (KEEP_ORIGINAL_CODE_FROM_FREERTOS != 0)
 size_t xPortGetFreeHeapSize( void )
 {
@@ -430,6 +518,9 @@ void UTIL_MM_Init(uint8_t *p_pool, uint32_t pool_size)
     }
 
     pucAlignedHeap = ( uint8_t * ) uxAddress;
+#if (KEEP_ORIGINAL_CODE_FROM_FREERTOS == 0)
+    pucHeapStart = pucAlignedHeap;
+#endif
 
     /* xStart is used to hold a pointer to the first item in the list of free
      * blocks.  The void cast is used to prevent compiler warnings. */
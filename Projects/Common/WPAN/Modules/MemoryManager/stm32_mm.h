@@ -22,7 +22,25 @@
 
 /* Includes ------------------------------------------------------------------*/
 /* Exported defines -----------------------------------------------------------*/
+
+/* Number of ranges of the free blocks histogram: [0:32[, [32:64[, ... [2048:4096[, [4096:infinite[ bytes */
+#define UTIL_MM_HISTO_NBR     (9U)
+
 /* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief  Heap walk result, sizes in bytes
+ */
+typedef struct
+{
+  size_t    FreeBytes;                          /* Sum of the free blocks */
+  size_t    MinimumEverFreeBytes;               /* Lowest FreeBytes since init */
+  size_t    LargestFreeBlock;                   /* Biggest buffer that can be provided */
+  uint32_t  FreeBlockNbr;                       /* Number of free blocks */
+  uint32_t  UsedBlockNbr;                       /* Number of allocated blocks */
+  uint32_t  FreeBlockHisto[UTIL_MM_HISTO_NBR];  /* Number of free blocks per range of size */
+} UTIL_MM_HeapStats_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
@@ -51,6 +69,23 @@ void * UTIL_MM_GetBuffer(size_t xWantedSize);
 
 void UTIL_MM_ReleaseBuffer( void * pv );
 
+/**
+ * @brief  Provide the size of the largest free block (walk of the free blocks list)
+ * @note   Shall be called in critical section
+ * @retval The size of the biggest buffer that can be provided
+ */
+
+size_t UTIL_MM_GetLargestFreeBlock( void );
+
+/**
+ * @brief  Walk all the blocks of the pool, allocated and free, to measure the fragmentation
+ * @note   Shall be called in critical section, takes time proportional to the number of blocks
+ * @param  pxHeapStats: The result of the walk
+ * @retval None
+ */
+
+void UTIL_MM_GetHeapStats( UTIL_MM_HeapStats_t * pxHeapStats );
+
 /* Exported functions to be implemented by the user if required ------------- */
 
 #endif /* STM32_MM_H */
@@ -0,0 +1,457 @@
+/**
+  ******************************************************************************
+  * @file    stm32_tlsf.c
+  * @author  MCD Application Team
+  * @brief   Two-Level Segregated Fit Memory Manager Utility
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/*
+ * Free blocks are sorted in lists by size class. The first level splits the
+ * sizes by power of two, the second level splits each power of two range in
+ * TLSF_SL_INDEX_COUNT linear ranges. A bitmap per level tells which lists are
+ * not empty, so finding a free block large enough, splitting it, and merging a
+ * released block with its physical neighbours are done in constant time.
+ *
+ * This module does not handle any critical section, like stm32_mm.c it is
+ * expected to be called from the Advanced Memory Manager.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "utilities_conf.h"
+#include "stm32_tlsf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+ * @brief   Block header
+ *
+ * @details pNextFree and pPrevFree are only valid when the block is free,
+ *          otherwise they are the first bytes of the user buffer.
+ */
+typedef struct TLSF_Block
+{
+  /* Previous block in memory */
+  struct TLSF_Block * pPrevPhys;
+  /* Size of the block buffer in bytes, the lower bits are the block flags */
+  uint32_t Size;
+  /* Next free block of the same size class */
+  struct TLSF_Block * pNextFree;
+  /* Previous free block of the same size class */
+  struct TLSF_Block * pPrevFree;
+}TLSF_Block_t;
+
+/* Private defines -----------------------------------------------------------*/
+
+/* Log2 of the number of second level lists per first level */
+#define TLSF_SL_INDEX_COUNT_LOG2  4u
+#define TLSF_SL_INDEX_COUNT       (1u << TLSF_SL_INDEX_COUNT_LOG2)
+
+/* Buffers are 32bits aligned */
+#define TLSF_ALIGN_SIZE_LOG2      2u
+#define TLSF_ALIGN_SIZE           (1u << TLSF_ALIGN_SIZE_LOG2)
+
+/* Biggest block is below 2^TLSF_FL_INDEX_MAX bytes */
+#define TLSF_FL_INDEX_MAX         17u
+#define TLSF_FL_INDEX_SHIFT       (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_INDEX_COUNT       (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1u)
+
+/* Blocks below this size are all in the first level 0 */
+#define TLSF_SMALL_BLOCK_SIZE     (1u << TLSF_FL_INDEX_SHIFT)
+
+/* Block flags */
+#define TLSF_BLOCK_FREE           0x01u
+#define TLSF_BLOCK_FLAGS_MASK     (TLSF_ALIGN_SIZE - 1u)
+
+/* Header bytes not available to the user */
+#define TLSF_BLOCK_OVERHEAD       (offsetof(TLSF_Block_t, pNextFree))
+
+/* Smallest buffer, to hold the free list links once released */
+#define TLSF_BLOCK_SIZE_MIN       (sizeof(TLSF_Block_t) - TLSF_BLOCK_OVERHEAD)
+#define TLSF_BLOCK_SIZE_MAX       ((1u << TLSF_FL_INDEX_MAX) - TLSF_ALIGN_SIZE)
+
+/* Private macros ------------------------------------------------------------*/
+
+#define TLSF_BLOCK_SIZE(b)        ((b)->Size & ~TLSF_BLOCK_FLAGS_MASK)
+#define TLSF_BLOCK_IS_FREE(b)     (((b)->Size & TLSF_BLOCK_FREE) != 0u)
+#define TLSF_BLOCK_TO_PTR(b)      ((void *)((uint8_t *)(b) + TLSF_BLOCK_OVERHEAD))
+#define TLSF_PTR_TO_BLOCK(p)      ((TLSF_Block_t *)((uint8_t *)(p) - TLSF_BLOCK_OVERHEAD))
+#define TLSF_BLOCK_NEXT(b)        ((TLSF_Block_t *)((uint8_t *)(b) + TLSF_BLOCK_OVERHEAD + TLSF_BLOCK_SIZE(b)))
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Bitmap of the first level lists containing free blocks */
+static uint32_t TlsfFlBitmap;
+
+/* Bitmaps of the second level lists containing free blocks */
+static uint32_t TlsfSlBitmap[TLSF_FL_INDEX_COUNT];
+
+/* Heads of the free lists */
+static TLSF_Block_t * TlsfFreeList[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+/* Global variables ----------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+static inline uint32_t tlsfFls (const uint32_t Value);
+static inline uint32_t tlsfFfs (const uint32_t Value);
+static void mappingInsert (const uint32_t Size, uint32_t * const p_Fl, uint32_t * const p_Sl);
+static TLSF_Block_t * searchSuitableBlock (uint32_t * const p_Fl, uint32_t * const p_Sl);
+static void insertFreeBlock (TLSF_Block_t * const p_Block);
+static void removeFreeBlock (TLSF_Block_t * const p_Block);
+static TLSF_Block_t * mergeWithNext (TLSF_Block_t * const p_Block);
+
+/* Functions Definition ------------------------------------------------------*/
+
+void UTIL_TLSF_Init(uint8_t *p_pool, uint32_t pool_size)
+{
+  TLSF_Block_t * p_block;
+  TLSF_Block_t * p_sentinel;
+  uint32_t size;
+
+  TlsfFlBitmap = 0u;
+  for (uint32_t fl = 0u; fl < TLSF_FL_INDEX_COUNT; fl++)
+  {
+    TlsfSlBitmap[fl] = 0u;
+    for (uint32_t sl = 0u; sl < TLSF_SL_INDEX_COUNT; sl++)
+    {
+      TlsfFreeList[fl][sl] = NULL;
+    }
+  }
+
+  /* Room for the first block header and for the sentinel block */
+  if (pool_size < (sizeof(TLSF_Block_t) + TLSF_BLOCK_OVERHEAD))
+  {
+    return;
+  }
+
+  size = (pool_size - (2u * TLSF_BLOCK_OVERHEAD)) & ~TLSF_BLOCK_FLAGS_MASK;
+  if (size > TLSF_BLOCK_SIZE_MAX)
+  {
+    /* The end of the pool will not be used */
+    size = TLSF_BLOCK_SIZE_MAX;
+  }
+
+  /* One free block covers the whole pool */
+  p_block = (TLSF_Block_t *)p_pool;
+  p_block->pPrevPhys = NULL;
+  p_block->Size = size | TLSF_BLOCK_FREE;
+
+  /* The sentinel is a used block of size 0 which ends the pool */
+  p_sentinel = TLSF_BLOCK_NEXT(p_block);
+  p_sentinel->pPrevPhys = p_block;
+  p_sentinel->Size = 0u;
+
+  insertFreeBlock (p_block);
+}
+
+void * UTIL_TLSF_GetBuffer(size_t xWantedSize)
+{
+  TLSF_Block_t * p_block = NULL;
+  TLSF_Block_t * p_remain;
+  uint32_t size;
+  uint32_t fl;
+  uint32_t sl;
+
+  if ((xWantedSize == 0u) || (xWantedSize > TLSF_BLOCK_SIZE_MAX))
+  {
+    return NULL;
+  }
+
+  /* Round the size to the alignment and to the smallest block */
+  size = ((uint32_t)xWantedSize + TLSF_ALIGN_SIZE - 1u) & ~TLSF_BLOCK_FLAGS_MASK;
+  if (size < TLSF_BLOCK_SIZE_MIN)
+  {
+    size = TLSF_BLOCK_SIZE_MIN;
+  }
+
+  /* Round up to the next list, so that any block of this list is large enough */
+  if (size >= TLSF_SMALL_BLOCK_SIZE)
+  {
+    mappingInsert (size + (1u << (tlsfFls (size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1u, &fl, &sl);
+  }
+  else
+  {
+    mappingInsert (size, &fl, &sl);
+  }
+
+  if (fl < TLSF_FL_INDEX_COUNT)
+  {
+    p_block = searchSuitableBlock (&fl, &sl);
+  }
+
+  /* Last chance, the head of the list of the exact size may be large enough */
+  if (p_block == NULL)
+  {
+    mappingInsert (size, &fl, &sl);
+    if ((fl < TLSF_FL_INDEX_COUNT) && (TlsfFreeList[fl][sl] != NULL)
+     && (TLSF_BLOCK_SIZE(TlsfFreeList[fl][sl]) >= size))
+    {
+      p_block = TlsfFreeList[fl][sl];
+    }
+  }
+
+  if (p_block != NULL)
+  {
+    removeFreeBlock (p_block);
+
+    /* Split the block when the remaining part can be a block */
+    if (TLSF_BLOCK_SIZE(p_block) >= (size + sizeof(TLSF_Block_t)))
+    {
+      p_remain = (TLSF_Block_t *)((uint8_t *)TLSF_BLOCK_TO_PTR(p_block) + size);
+      p_remain->pPrevPhys = p_block;
+      p_remain->Size = (TLSF_BLOCK_SIZE(p_block) - size - TLSF_BLOCK_OVERHEAD) | TLSF_BLOCK_FREE;
+      TLSF_BLOCK_NEXT(p_remain)->pPrevPhys = p_remain;
+      p_block->Size = size;
+
+      insertFreeBlock (p_remain);
+    }
+    else
+    {
+      p_block->Size = TLSF_BLOCK_SIZE(p_block);
+    }
+
+    return TLSF_BLOCK_TO_PTR(p_block);
+  }
+
+  return NULL;
+}
+
+void UTIL_TLSF_ReleaseBuffer(void * pv)
+{
+  TLSF_Block_t * p_block;
+  TLSF_Block_t * p_prev;
+
+  if (pv == NULL)
+  {
+    return;
+  }
+
+  p_block = TLSF_PTR_TO_BLOCK(pv);
+
+  /* Check the block is actually allocated */
+  if (TLSF_BLOCK_IS_FREE(p_block))
+  {
+    return;
+  }
+
+  p_block->Size |= TLSF_BLOCK_FREE;
+
+  /* Merge with the previous block */
+  p_prev = p_block->pPrevPhys;
+  if ((p_prev != NULL) && TLSF_BLOCK_IS_FREE(p_prev))
+  {
+    removeFreeBlock (p_prev);
+    p_block = mergeWithNext (p_prev);
+  }
+
+  /* Merge with the next block, never with the sentinel as it is used */
+  if (TLSF_BLOCK_IS_FREE(TLSF_BLOCK_NEXT(p_block)))
+  {
+    removeFreeBlock (TLSF_BLOCK_NEXT(p_block));
+    p_block = mergeWithNext (p_block);
+  }
+
+  insertFreeBlock (p_block);
+}
+
+size_t UTIL_TLSF_GetLargestFreeBlock(void)
+{
+  uint32_t maxSize = 0u;
+  uint32_t fl;
+  uint32_t sl;
+
+  /* The largest blocks are all in the highest non empty list */
+  if (TlsfFlBitmap != 0u)
+  {
+    fl = tlsfFls (TlsfFlBitmap);
+    sl = tlsfFls (TlsfSlBitmap[fl]);
+
+    /* Any size up to the lower bound of this list can be allocated, the head of the list as well */
+    if (fl == 0u)
+    {
+      maxSize = sl * (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+    }
+    else
+    {
+      maxSize = (1u << (fl + TLSF_FL_INDEX_SHIFT - 1u))
+              + (sl << (fl + TLSF_FL_INDEX_SHIFT - 1u - TLSF_SL_INDEX_COUNT_LOG2));
+    }
+
+    if (TLSF_BLOCK_SIZE(TlsfFreeList[fl][sl]) > maxSize)
+    {
+      maxSize = TLSF_BLOCK_SIZE(TlsfFreeList[fl][sl]);
+    }
+  }
+
+  return maxSize;
+}
+
+/* Private Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Position of the most significant bit set
+ * @param  Value: Shall not be zero
+ * @return Position between 0 and 31
+ */
+static inline uint32_t tlsfFls (const uint32_t Value)
+{
+  return (31u - __CLZ (Value));
+}
+
+/**
+ * @brief  Position of the least significant bit set
+ * @param  Value: Shall not be zero
+ * @return Position between 0 and 31
+ */
+static inline uint32_t tlsfFfs (const uint32_t Value)
+{
+  return tlsfFls (Value & (~Value + 1u));
+}
+
+/**
+ * @brief  Compute the indexes of the list of a block size
+ * @param  Size: Size of the block buffer in bytes
+ * @param  p_Fl: First level index
+ * @param  p_Sl: Second level index
+ * @return None
+ */
+static void mappingInsert (const uint32_t Size, uint32_t * const p_Fl, uint32_t * const p_Sl)
+{
+  uint32_t fl;
+
+  if (Size < TLSF_SMALL_BLOCK_SIZE)
+  {
+    *p_Fl = 0u;
+    *p_Sl = Size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+  }
+  else
+  {
+    fl = tlsfFls (Size);
+    *p_Sl = (Size >> (fl - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+    *p_Fl = fl - (TLSF_FL_INDEX_SHIFT - 1u);
+  }
+}
+
+/**
+ * @brief  Find a free block in the given list or in a list of bigger blocks
+ * @param  p_Fl: First level index, updated with the list of the block found
+ * @param  p_Sl: Second level index, updated with the list of the block found
+ * @return Free block, NULL if none
+ */
+static TLSF_Block_t * searchSuitableBlock (uint32_t * const p_Fl, uint32_t * const p_Sl)
+{
+  uint32_t fl = *p_Fl;
+  uint32_t slMap;
+  uint32_t flMap;
+
+  /* Search for a list of bigger blocks in the same first level */
+  slMap = TlsfSlBitmap[fl] & (~0u << *p_Sl);
+  if (slMap == 0u)
+  {
+    /* Search in the upper first levels */
+    if ((fl + 1u) >= TLSF_FL_INDEX_COUNT)
+    {
+      return NULL;
+    }
+
+    flMap = TlsfFlBitmap & (~0u << (fl + 1u));
+    if (flMap == 0u)
+    {
+      return NULL;
+    }
+
+    fl = tlsfFfs (flMap);
+    slMap = TlsfSlBitmap[fl];
+  }
+
+  *p_Fl = fl;
+  *p_Sl = tlsfFfs (slMap);
+
+  return TlsfFreeList[*p_Fl][*p_Sl];
+}
+
+/**
+ * @brief  Add a block at the head of its free list
+ * @param  p_Block: Free block
+ * @return None
+ */
+static void insertFreeBlock (TLSF_Block_t * const p_Block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  mappingInsert (TLSF_BLOCK_SIZE(p_Block), &fl, &sl);
+
+  p_Block->pPrevFree = NULL;
+  p_Block->pNextFree = TlsfFreeList[fl][sl];
+  if (p_Block->pNextFree != NULL)
+  {
+    p_Block->pNextFree->pPrevFree = p_Block;
+  }
+  TlsfFreeList[fl][sl] = p_Block;
+
+  TlsfFlBitmap |= (1u << fl);
+  TlsfSlBitmap[fl] |= (1u << sl);
+}
+
+/**
+ * @brief  Remove a block from its free list
+ * @param  p_Block: Free block
+ * @return None
+ */
+static void removeFreeBlock (TLSF_Block_t * const p_Block)
+{
+  uint32_t fl;
+  uint32_t sl;
+
+  mappingInsert (TLSF_BLOCK_SIZE(p_Block), &fl, &sl);
+
+  if (p_Block->pNextFree != NULL)
+  {
+    p_Block->pNextFree->pPrevFree = p_Block->pPrevFree;
+  }
+
+  if (p_Block->pPrevFree != NULL)
+  {
+    p_Block->pPrevFree->pNextFree = p_Block->pNextFree;
+  }
+  else
+  {
+    /* Block was the head of the list */
+    TlsfFreeList[fl][sl] = p_Block->pNextFree;
+    if (TlsfFreeList[fl][sl] == NULL)
+    {
+      TlsfSlBitmap[fl] &= ~(1u << sl);
+      if (TlsfSlBitmap[fl] == 0u)
+      {
+        TlsfFlBitmap &= ~(1u << fl);
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Merge a free block with the next one in memory
+ * @details The next block shall be free and already removed from its list
+ * @param  p_Block: Free block, already removed from its list
+ * @return The merged block
+ */
+static TLSF_Block_t * mergeWithNext (TLSF_Block_t * const p_Block)
+{
+  TLSF_Block_t * p_next = TLSF_BLOCK_NEXT(p_Block);
+
+  p_Block->Size = (TLSF_BLOCK_SIZE(p_Block) + TLSF_BLOCK_OVERHEAD + TLSF_BLOCK_SIZE(p_next)) | TLSF_BLOCK_FREE;
+  TLSF_BLOCK_NEXT(p_Block)->pPrevPhys = p_Block;
+
+  return p_Block;
+}
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    stm32_tlsf.h
+  * @author  MCD Application Team
+  * @brief   Header for stm32_tlsf.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_TLSF_H
+#define STM32_TLSF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported defines -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/**
+ * @brief  Initialize the Pool
+ * @details The pool can be used as a Basic Memory Manager of the Advanced Memory Manager.
+ *          Allocation and release are done in a bounded time, whatever the number of blocks.
+ * @param  p_pool: The pool of memory to manage - Shall be 32bits aligned -
+ * @param  pool_size: The size of the pool in bytes
+ * @retval None
+ */
+void UTIL_TLSF_Init(uint8_t *p_pool, uint32_t pool_size);
+
+/**
+ * @brief  Provide a buffer
+ * @param  xWantedSize: The size of the buffer requested
+ * @retval The buffer address when available or NULL when there is no buffer
+ */
+void * UTIL_TLSF_GetBuffer(size_t xWantedSize);
+
+/**
+ * @brief  Release a buffer
+ * @param  pv: The data buffer address
+ * @retval None
+ */
+void UTIL_TLSF_ReleaseBuffer(void * pv);
+
+/**
+ * @brief  Provide the size of the largest buffer that can be provided
+ * @note   Shall be called in critical section
+ * @retval The size of the biggest buffer that can be provided
+ */
+size_t UTIL_TLSF_GetLargestFreeBlock(void);
+
+/* Exported functions to be implemented by the user if required ------------- */
+
+#endif /* STM32_TLSF_H */
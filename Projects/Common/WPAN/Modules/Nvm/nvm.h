@@ -48,6 +48,12 @@ enum
 
 #define CFG_NVM_ALIGN (1)
 
+/* Number of record types indexed in RAM: the first record of these types is
+   found without scanning the buffer (the other types are searched) */
+#ifndef CFG_NVM_INDEX_TYPE_NBR
+#define CFG_NVM_INDEX_TYPE_NBR (16)
+#endif
+
 #if CFG_NVM_ALIGN != 0
 extern void NVM_Init( uint64_t* buffer,
                       uint16_t size,
@@ -74,6 +80,8 @@ extern int NVM_Compare( uint16_t offset,
 
 extern void NVM_Discard( uint8_t mode );
 
+extern void NVM_Compact( void );
+
 /*
  * Callbacks
  */
@@ -30,6 +30,14 @@ static uint16_t NVM_size;       /* d */
 #endif
 static uint16_t NVM_max_size;   /* w */
 
+/* Index of the records: offset of the first valid record of each type, end
+   of data and words of the invalid records (not valid if the buffer is
+   corrupted: the records are then searched in the buffer) */
+static uint16_t NVM_index[CFG_NVM_INDEX_TYPE_NBR];
+static uint32_t NVM_end;        /* w */
+static uint32_t NVM_removed;    /* w */
+static uint8_t NVM_indexed;
+
 /*****************************************************************************/
 
 /* Number of 32-bit words in NVM flash area */
@@ -58,6 +66,14 @@ static uint16_t NVM_max_size;   /* w */
 #define NVM_OFFSET(size)        DIVC(size + 4, 4)
 #endif
 
+/* Value of the index for a type without valid record */
+#define NVM_INDEX_NONE          0xFFFFU
+
+/*****************************************************************************/
+
+static void NVM_BuildIndex( void );
+static void NVM_IndexNext( uint32_t type, uint32_t offset );
+
 /*****************************************************************************/
 
 #if CFG_NVM_ALIGN != 0
@@ -80,6 +96,9 @@ void NVM_Init( uint32_t* buffer )
 
   /* Initialize warning trigger level */
   NVM_trig_level = NVM_max_size - 1;
+
+  /* Index the records already in the buffer */
+  NVM_BuildIndex( );
 }
 
 /*****************************************************************************/
@@ -90,78 +109,40 @@ int NVM_Add( uint8_t type,
              const uint8_t* extra_data,
              uint16_t extra_size )
 {
-  uint32_t *ptr, next, left, total_size, offset, *start_ptr, removed;
+  uint32_t *ptr, total_size, offset, *start_ptr;
 
   if ( data && size )
   {
+    if ( !NVM_indexed )
+    {
+      /* Return if the end of data is not known (memory corruption case) */
+      return NVM_ERROR;
+    }
+
     total_size = size + extra_size;
     offset = 1 + NVM_OFFSET(total_size);
 
-    while ( 1 )
+    /* Test if there is enough room for the new record */
+    if ( offset > NVM_max_size - NVM_end )
     {
-      /* Search the end of data in the buffer */
-      ptr = NVM_buffer;
-      left = NVM_max_size;
-      removed = 0;
-      while ( !NVM_BLANK(ptr) )
-      {
-        next = NVM_OFFSET(NVM_SIZE(ptr));
-
-        if  ( next >= left )
-        {
-          /* Return if we exceed buffer size (memory corruption case) */
-          return NVM_ERROR;
-        }
-
-        if ( !NVM_VALID(ptr) )
-          removed += next;
-
-        ptr += next;
-        left -= next;
-      }
-
-      /* Test if there is enough room for the new record */
-      if ( offset <= left )
-      {
-        break;
-      }
-
-      if ( removed == 0 )
+      if ( NVM_removed == 0 )
       {
         /* Return if there is no more room in NVM */
         return NVM_FULL;
       }
 
-      /* Search for an invalid record */
-      ptr = NVM_buffer;
-      left = NVM_max_size;
-      while ( (!NVM_BLANK(ptr)) && NVM_VALID(ptr) )
-      {
-        next = NVM_OFFSET(NVM_SIZE(ptr));
-        ptr += next;
-        left -= next;
-      }
+      /* Remove all the invalid records at once to get room */
+      NVM_Compact( );
 
-      if ( NVM_BLANK(ptr) )
+      if ( offset > NVM_max_size - NVM_end )
       {
-        /* Return if we have reached the end of the buffer */
+        /* Return if there is no more room in NVM */
         return NVM_FULL;
       }
-
-      /* Move records to get room */
-      next = NVM_OFFSET(NVM_SIZE(ptr));
-      memmove( ptr, ptr + next, 4*(left - next) );
-      removed -= next;
-
-#if CFG_NVM_ALIGN != 0
-      NVM_size -= next/2;
-      NVMCB_Store( ptr, NVM_size );
-#else
-      NVMCB_Store( ptr, left - next );
-#endif
     }
 
-    /* Write the record */
+    /* Write the record at the end of data */
+    ptr = NVM_buffer + NVM_end;
     *ptr = 0x01000000UL | (((uint32_t)type) << 16) | total_size;
     start_ptr = ptr;
 
@@ -172,11 +153,17 @@ int NVM_Add( uint8_t type,
       memcpy( ((uint8_t*)(ptr + 1)) + size, extra_data, extra_size );
     }
 
+    if ( (type < CFG_NVM_INDEX_TYPE_NBR) && (NVM_index[type] == NVM_INDEX_NONE) )
+    {
+      NVM_index[type] = (uint16_t)NVM_end;
+    }
+
     /* Set next record as blank */
     ptr += NVM_OFFSET(NVM_SIZE(ptr));
     *ptr = 0;
+    NVM_end = ptr - NVM_buffer;
 #if CFG_NVM_ALIGN != 0
-    NVM_size = (ptr - NVM_buffer) / 2;
+    NVM_size = NVM_end / 2;
     NVMCB_Store( start_ptr, NVM_size );
 #else
     NVMCB_Store( start_ptr, ptr + 1 - start_ptr );
@@ -186,7 +173,7 @@ int NVM_Add( uint8_t type,
     NVM_trig_level = MIN(NVM_trig_level, NVM_max_size + 1 - offset);
 
     /* Check amount of NVM used */
-    if ( (ptr + 1 - NVM_buffer - removed) > NVM_trig_level )
+    if ( (NVM_end + 1 - NVM_removed) > NVM_trig_level )
     {
       /* Return warning to indicate that NVM is near to be full */
       return NVM_WARN;
@@ -210,7 +197,14 @@ int NVM_Get( uint8_t mode,
   /* Point at buffer start */
   ptr = NVM_buffer;
 
-  if ( mode == NVM_FIRST )
+  if ( (mode == NVM_FIRST) && NVM_indexed && (type < CFG_NVM_INDEX_TYPE_NBR) )
+  {
+    /* Point on the first record of this type, or on the end of data */
+    NVM_offset = (NVM_index[type] != NVM_INDEX_NONE) ? NVM_index[type] : NVM_end;
+    ptr += NVM_offset;
+    mode = NVM_CURRENT;
+  }
+  else if ( mode == NVM_FIRST )
   {
     NVM_offset = 0;
   }
@@ -332,7 +326,7 @@ int NVM_Compare( uint16_t offset,
 
 void NVM_Discard( uint8_t mode )
 {
-  uint32_t *ptr, *ptr_next, next, size;
+  uint32_t *ptr, *ptr_next, next, size, words, valid, type;
 
   ptr = NVM_buffer;
 
@@ -360,6 +354,10 @@ void NVM_Discard( uint8_t mode )
         return;
       }
 
+      words = next;
+      valid = NVM_VALID(ptr);
+      type = NVM_TYPE(ptr);
+
       if ( NVM_BLANK(ptr_next) )
       {
         /* Set current record as blank if next record is blank. */
@@ -368,6 +366,9 @@ void NVM_Discard( uint8_t mode )
 #if CFG_NVM_ALIGN != 0
         NVM_size = (ptr - NVM_buffer) / 2;
 #endif
+        NVM_end = NVM_offset;
+        if ( !valid )
+          NVM_removed -= words;
       }
       else
       {
@@ -386,6 +387,15 @@ void NVM_Discard( uint8_t mode )
 
         /* Invalidate the current record */
         *ptr = size;
+        if ( valid )
+          NVM_removed += words;
+      }
+
+      /* The first record of this type is now further */
+      if ( NVM_indexed && valid &&
+           (type < CFG_NVM_INDEX_TYPE_NBR) && (NVM_index[type] == NVM_offset) )
+      {
+        NVM_IndexNext( type, NVM_offset );
       }
     }
   }
@@ -397,6 +407,7 @@ void NVM_Discard( uint8_t mode )
 #if CFG_NVM_ALIGN != 0
     NVM_size = 0;
 #endif
+    NVM_BuildIndex( );
   }
 
 #if CFG_NVM_ALIGN != 0
@@ -408,6 +419,127 @@ void NVM_Discard( uint8_t mode )
 
 /*****************************************************************************/
 
+void NVM_Compact( void )
+{
+  uint32_t *src, *dst, *first, *end, next;
+
+  if ( !NVM_indexed || (NVM_removed == 0) )
+  {
+    /* Nothing to remove (or memory corruption case) */
+    return;
+  }
+
+  /* Skip the valid records at buffer start */
+  dst = NVM_buffer;
+  end = NVM_buffer + NVM_end;
+  while ( (dst < end) && NVM_VALID(dst) )
+  {
+    dst += NVM_OFFSET(NVM_SIZE(dst));
+  }
+  first = dst;
+
+  /* Move the valid records over the invalid ones, in one pass */
+  src = dst;
+  while ( src < end )
+  {
+    next = NVM_OFFSET(NVM_SIZE(src));
+
+    if ( NVM_VALID(src) )
+    {
+      memmove( dst, src, 4*next );
+      dst += next;
+    }
+
+    src += next;
+  }
+
+  /* Set next record as blank */
+  *dst = 0;
+
+#if CFG_NVM_ALIGN != 0
+  NVM_size = (dst - NVM_buffer) / 2;
+  NVMCB_Store( first, NVM_size );
+#else
+  NVMCB_Store( first, dst + 1 - first );
+#endif
+
+  /* The records have moved */
+  NVM_BuildIndex( );
+}
+
+/*****************************************************************************/
+
+static void NVM_BuildIndex( void )
+{
+  uint32_t *ptr, next, left, type;
+
+  for ( type = 0; type < CFG_NVM_INDEX_TYPE_NBR; type++ )
+  {
+    NVM_index[type] = NVM_INDEX_NONE;
+  }
+
+  ptr = NVM_buffer;
+  left = NVM_max_size;
+  NVM_removed = 0;
+  NVM_indexed = 0;
+
+  while ( !NVM_BLANK(ptr) )
+  {
+    next = NVM_OFFSET(NVM_SIZE(ptr));
+
+    if  ( next >= left )
+    {
+      /* Return if we exceed buffer size (memory corruption case) */
+      return;
+    }
+
+    if ( !NVM_VALID(ptr) )
+    {
+      NVM_removed += next;
+    }
+    else
+    {
+      type = NVM_TYPE(ptr);
+
+      if ( (type < CFG_NVM_INDEX_TYPE_NBR) && (NVM_index[type] == NVM_INDEX_NONE) )
+      {
+        NVM_index[type] = (uint16_t)(ptr - NVM_buffer);
+      }
+    }
+
+    ptr += next;
+    left -= next;
+  }
+
+  NVM_end = ptr - NVM_buffer;
+  NVM_indexed = 1;
+}
+
+/*****************************************************************************/
+
+static void NVM_IndexNext( uint32_t type, uint32_t offset )
+{
+  uint32_t *ptr, *end;
+
+  /* Search the next valid record of this type after offset */
+  ptr = NVM_buffer + offset;
+  end = NVM_buffer + NVM_end;
+  NVM_index[type] = NVM_INDEX_NONE;
+
+  while ( ptr < end )
+  {
+    if ( NVM_VALID(ptr) && (NVM_TYPE(ptr) == type) )
+    {
+      NVM_index[type] = (uint16_t)(ptr - NVM_buffer);
+      return;
+    }
+
+    ptr += NVM_OFFSET(NVM_SIZE(ptr));
+  }
+}
+
+/*****************************************************************************/
+
 /*
  * Callbacks
  */
@@ -27,12 +27,85 @@ static_assert((sizeof(general_debug_table)/sizeof(st_gpio_debug_t)) == RT_DEBUG_
 );
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
 
+#if(CFG_RT_DEBUG_ITM == 1)
+/* Code written on the run port for the task or timer callback running */
+static uint32_t itm_run_code = RT_DEBUG_ITM_RUN_IDLE;
+
+/* Write one packet, only when the debugger has enabled the ITM and the port */
+static void itm_write(uint32_t port, uint32_t value, uint32_t size)
+{
+  uint32_t primask_bit;
+
+  if(((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0U) || ((ITM->TER & (1UL << port)) == 0U))
+  {
+    return;
+  }
+
+  /* A packet written from an interrupt between the wait and the write would be lost */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+  while(ITM->PORT[port].u32 == 0U)
+  {
+    __NOP();
+  }
+  if(size == 2U)
+  {
+    ITM->PORT[port].u16 = (uint16_t)value;
+  }
+  else
+  {
+    ITM->PORT[port].u32 = value;
+  }
+  __set_PRIMASK(primask_bit);
+}
+
+/*****************************/
+/** ITM timeline trace APIs **/
+/*****************************/
+
+void RT_DEBUG_ITMInit(void)
+{
+  /* Trace enable, the SWO output and the stimulus ports are configured by the debugger */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+
+  /* Local time stamps generated by the ITM, in cycles of the core clock, following the packets */
+  if((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0U)
+  {
+    ITM->TCR |= ITM_TCR_TSENA_Msk;
+  }
+}
+
+void RT_DEBUG_ITMSignal(uint32_t port, uint32_t signal, uint32_t action)
+{
+  itm_write(port, (signal & 0xFFU) | (action << 8), 2U);
+}
+
+uint32_t RT_DEBUG_ITMRunEnter(uint32_t code)
+{
+  uint32_t previous = itm_run_code;
+
+  itm_run_code = code;
+  itm_write(RT_DEBUG_ITM_PORT_RUN, code, 4U);
+
+  return previous;
+}
+
+void RT_DEBUG_ITMRunExit(uint32_t previous)
+{
+  itm_run_code = previous;
+  itm_write(RT_DEBUG_ITM_PORT_RUN, previous, 4U);
+}
+#endif /* CFG_RT_DEBUG_ITM */
+
 /***********************/
 /** System debug APIs **/
 /***********************/
 
 void SYSTEM_DEBUG_SIGNAL_SET(system_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_SYSTEM, (uint32_t)signal, RT_DEBUG_ITM_ACTION_SET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_SET(signal, system_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -40,6 +113,9 @@ void SYSTEM_DEBUG_SIGNAL_SET(system_debug_signal_t signal)
 
 void SYSTEM_DEBUG_SIGNAL_RESET(system_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_SYSTEM, (uint32_t)signal, RT_DEBUG_ITM_ACTION_RESET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_RESET(signal, system_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -47,6 +123,9 @@ void SYSTEM_DEBUG_SIGNAL_RESET(system_debug_signal_t signal)
 
 void SYSTEM_DEBUG_SIGNAL_TOGGLE(system_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_SYSTEM, (uint32_t)signal, RT_DEBUG_ITM_ACTION_TOGGLE);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_TOGGLE(signal, system_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -59,6 +138,9 @@ void SYSTEM_DEBUG_SIGNAL_TOGGLE(system_debug_signal_t signal)
 /* Link Layer debug API definition */
 void LINKLAYER_DEBUG_SIGNAL_SET(linklayer_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_LINKLAYER, (uint32_t)signal, RT_DEBUG_ITM_ACTION_SET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_SET(signal, linklayer_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -66,6 +148,9 @@ void LINKLAYER_DEBUG_SIGNAL_SET(linklayer_debug_signal_t signal)
 
 void LINKLAYER_DEBUG_SIGNAL_RESET(linklayer_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_LINKLAYER, (uint32_t)signal, RT_DEBUG_ITM_ACTION_RESET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
    GENERIC_DEBUG_GPIO_RESET(signal, linklayer_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -73,6 +158,9 @@ void LINKLAYER_DEBUG_SIGNAL_RESET(linklayer_debug_signal_t signal)
 
 void LINKLAYER_DEBUG_SIGNAL_TOGGLE(linklayer_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_LINKLAYER, (uint32_t)signal, RT_DEBUG_ITM_ACTION_TOGGLE);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_TOGGLE(signal, linklayer_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -74,6 +74,33 @@
 
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
 
+#if(CFG_RT_DEBUG_ITM == 1)
+
+/*********************************************/
+/** ITM timeline trace (stimulus ports and  **/
+/** 16 bits signal packet : [7:0] signal    **/
+/** of the domain, [9:8] action)            **/
+/*********************************************/
+
+#define RT_DEBUG_ITM_PORT_SYSTEM      (1U)
+#define RT_DEBUG_ITM_PORT_LINKLAYER   (2U)
+#define RT_DEBUG_ITM_PORT_APP         (3U)
+#define RT_DEBUG_ITM_PORT_RUN         (4U)
+
+#define RT_DEBUG_ITM_ACTION_SET       (1U)
+#define RT_DEBUG_ITM_ACTION_RESET     (2U)
+#define RT_DEBUG_ITM_ACTION_TOGGLE    (3U)
+
+/* Run packet (32 bits) : task ID, address of the timer callback, or idle */
+#define RT_DEBUG_ITM_RUN_IDLE         (0xFFFFFFFFU)
+
+void RT_DEBUG_ITMInit(void);
+void RT_DEBUG_ITMSignal(uint32_t port, uint32_t signal, uint32_t action);
+uint32_t RT_DEBUG_ITMRunEnter(uint32_t code);
+void RT_DEBUG_ITMRunExit(uint32_t previous);
+
+#endif /* CFG_RT_DEBUG_ITM */
+
 /* System debug API definition */
 void SYSTEM_DEBUG_SIGNAL_SET(system_debug_signal_t signal);
 void SYSTEM_DEBUG_SIGNAL_RESET(system_debug_signal_t signal);
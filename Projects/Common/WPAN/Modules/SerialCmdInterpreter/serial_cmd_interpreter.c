@@ -17,6 +17,8 @@
   */
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
 #include "log_module.h"
 #include "app_conf.h"
 #include "stm32_adv_trace.h"
@@ -34,11 +36,13 @@
 /* Private variables ---------------------------------------------------------*/
 static uint8_t  RxBuffer[RX_BUFF_SIZE];
 static uint16_t indexRxBuffer = 0;
+static SerialCmdTable_t * pstSerialCmdTables = NULL;
 
 /* Global variables ----------------------------------------------------------*/
 
 /* Private functions prototypes ----------------------------------------------*/
 static void UART_Rx_Callback(uint8_t *PData, uint16_t Size, uint8_t Error);
+static int  SerialCmdCompare(const void * pKey, const void * pEntry);
 
 /* External variables --------------------------------------------------------*/
 
@@ -75,37 +79,135 @@ __weak void Serial_CMD_Interpreter_CmdExecute( uint8_t * pRxBuffer, uint16_t iRx
   */
 }
 
+/**
+  * @brief  Feed received characters to the interpreter, when the serial link is received by another module.
+  * @param  pData   Characters received
+  * @param  iSize   Number of characters
+  * @retval None
+  */
+void Serial_CMD_Interpreter_RxData( uint8_t * pData, uint16_t iSize )
+{
+  UART_Rx_Callback( pData, iSize, 0U );
+}
 
-/* Private functions definition ----------------------------------------------*/
-static void UART_Rx_Callback( uint8_t * pData, uint16_t Size, uint8_t Error )
+/**
+  * @brief  Register the commands of a module. Registering a table already registered does nothing.
+  * @param  pstTable  Table of the commands, its entries sorted by keyword (strcmp order)
+  * @retval None
+  */
+void Serial_CMD_Interpreter_RegisterTable( SerialCmdTable_t * pstTable )
 {
-  /* Filling buffer and wait for '\r' charactere to execute actions */
-  if ( indexRxBuffer < RX_BUFF_SIZE )
+  SerialCmdTable_t  * pstScan;
+
+  for ( pstScan = pstSerialCmdTables; pstScan != NULL; pstScan = pstScan->pstNext )
   {
-    if ( *pData == '\r' )
+    if ( pstScan == pstTable )
     {
-      Serial_CMD_Interpreter_CmdExecute( RxBuffer, indexRxBuffer );
+      return;
+    }
+  }
 
-      /* Clear receive buffer and character counter*/
-      indexRxBuffer = 0;
-      memset( &RxBuffer[0], 0, RX_BUFF_SIZE );
+  pstTable->pstNext = pstSerialCmdTables;
+  pstSerialCmdTables = pstTable;
+}
+
+/**
+  * @brief  Execute a command of the registered tables : its keyword is searched by dichotomy in each table.
+  * @param  szCommand  Command received
+  * @retval True if the command was found and executed.
+  */
+bool Serial_CMD_Interpreter_Dispatch( const char * szCommand )
+{
+  char                szKeyword[SERIAL_CMD_KEYWORD_MAX + 1U];
+  const char          * szArgs;
+  const SerialCmd_t   * pstCmd;
+  SerialCmdTable_t    * pstTable;
+  uint32_t            lLength;
+
+  szArgs = strchr( szCommand, ' ' );
+  lLength = ( szArgs != NULL ) ? (uint32_t)( szArgs - szCommand ) : strlen( szCommand );
+  if ( ( lLength == 0U ) || ( lLength > SERIAL_CMD_KEYWORD_MAX ) )
+  {
+    return false;
+  }
+
+  memcpy( szKeyword, szCommand, lLength );
+  szKeyword[lLength] = '\0';
+  szArgs = ( szArgs != NULL ) ? &szArgs[1] : "";
+
+  for ( pstTable = pstSerialCmdTables; pstTable != NULL; pstTable = pstTable->pstNext )
+  {
+    pstCmd = bsearch( szKeyword, pstTable->pstCmds, pstTable->iNbCmds, sizeof( SerialCmd_t ), SerialCmdCompare );
+    if ( pstCmd == NULL )
+    {
+      continue;
     }
-    else
+
+    if ( ( pstCmd->pfExecute != NULL ) && ( *szArgs == '\0' ) )
+    {
+      pstCmd->pfExecute();
+      return true;
+    }
+
+    if ( pstCmd->pfExecuteArgs != NULL )
     {
-      if ( ( * pData == '\n' ) && ( indexRxBuffer == 0 ) )
+      pstCmd->pfExecuteArgs( szArgs );
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Private functions definition ----------------------------------------------*/
+static int SerialCmdCompare( const void * pKey, const void * pEntry )
+{
+  return strcmp( (const char *)pKey, ((const SerialCmd_t *)pEntry)->szKeyword );
+}
+
+static void UART_Rx_Callback( uint8_t * pData, uint16_t Size, uint8_t Error )
+{
+  uint16_t  index;
+
+  /* A reception error (DMA reception) : the line in progress is lost */
+  if ( Error != 0U )
+  {
+    indexRxBuffer = 0;
+    memset(&RxBuffer[0], 0, RX_BUFF_SIZE);
+    return;
+  }
+
+  /* One character (interrupt reception) or a part of line (DMA reception) */
+  for ( index = 0; index < Size; index++ )
+  {
+    /* Filling buffer and wait for '\r' charactere to execute actions */
+    if ( indexRxBuffer < RX_BUFF_SIZE )
+    {
+      if ( pData[index] == '\r' )
       {
-        /* discard this first charactere if it's a delimiter  */
+        Serial_CMD_Interpreter_CmdExecute( RxBuffer, indexRxBuffer );
+
+        /* Clear receive buffer and character counter*/
+        indexRxBuffer = 0;
+        memset( &RxBuffer[0], 0, RX_BUFF_SIZE );
       }
       else
       {
-        RxBuffer[indexRxBuffer++] = *pData;
+        if ( ( pData[index] == '\n' ) && ( indexRxBuffer == 0 ) )
+        {
+          /* discard this first charactere if it's a delimiter  */
+        }
+        else
+        {
+          RxBuffer[indexRxBuffer++] = pData[index];
+        }
       }
     }
-  }
-  else
-  {
-    indexRxBuffer = 0;
-    memset(&RxBuffer[0], 0, RX_BUFF_SIZE);
+    else
+    {
+      indexRxBuffer = 0;
+      memset(&RxBuffer[0], 0, RX_BUFF_SIZE);
+    }
   }
   return;
 }
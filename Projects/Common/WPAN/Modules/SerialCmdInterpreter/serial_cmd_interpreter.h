@@ -25,18 +25,39 @@ extern "C" {
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
 
 /* Private includes ----------------------------------------------------------*/
 
 /* Exported types ------------------------------------------------------------*/
+/* A command is its keyword, then optionally a space and its arguments */
+typedef struct
+{
+  const char  * szKeyword;
+  void        (*pfExecute)( void );                   /* Called for the keyword alone, or NULL */
+  void        (*pfExecuteArgs)( const char * szArgs ); /* Called with the text after the keyword ("" if none), or NULL */
+} SerialCmd_t;
+
+/* Commands of a module, sorted by keyword (strcmp order) */
+typedef struct SerialCmdTable
+{
+  const SerialCmd_t     * pstCmds;
+  uint16_t              iNbCmds;
+  struct SerialCmdTable * pstNext;
+} SerialCmdTable_t;
 
 /* Exported constants --------------------------------------------------------*/
+#define SERIAL_CMD_KEYWORD_MAX    (16U)
 
 /* Exported macro ------------------------------------------------------------*/
 
 /* Exported functions prototypes ---------------------------------------------*/
 void Serial_CMD_Interpreter_Init(void);
 void Serial_CMD_Interpreter_CmdExecute( uint8_t * pRxBuffer, uint16_t iRxBufferSize );
+void Serial_CMD_Interpreter_RxData( uint8_t * pData, uint16_t iSize );
+void Serial_CMD_Interpreter_RegisterTable( SerialCmdTable_t * pstTable );
+bool Serial_CMD_Interpreter_Dispatch( const char * szCommand );
 
 /* Private defines -----------------------------------------------------------*/
 
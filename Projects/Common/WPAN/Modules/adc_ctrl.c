@@ -31,6 +31,12 @@
 /* LL ADC header */
 #include "stm32wbaxx_ll_adc.h"
 
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/* LL DMA header, low power manager for the batches */
+#include "stm32wbaxx_ll_dma.h"
+#include "stm32_lpm.h"
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Private defines -----------------------------------------------------------*/
 /**
  * @brief Initial value define for configuration tracking number
@@ -72,6 +78,15 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
+/**
+ * @brief A batch holds the ADC : the polled requests are refused
+ */
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+#define ADCCTRL_BATCH_RUNNING()         (0x00u != BatchRunning)
+#else
+#define ADCCTRL_BATCH_RUNNING()         (0)
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Private variables ---------------------------------------------------------*/
 /**
  * @brief  ADC IP Client list
@@ -93,6 +108,20 @@ static uint32_t MaxRegisteredId = ADCCTRL_NO_CONFIG;
  */
 static ADC_TypeDef * p_ADCHandle = ADCCTRL_HWADDR;
 
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+ * @brief Queue of the batches, the head one runs when BatchRunning is set
+ */
+static ADCCTRL_Batch_t * p_BatchHead;
+static ADCCTRL_Batch_t * p_BatchTail;
+static uint32_t BatchRunning;
+
+/**
+ * @brief Samples of the running batch, written by the DMA
+ */
+static uint16_t BatchSamples[CFG_ADCCTRL_BATCH_SAMPLES];
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Global variables ----------------------------------------------------------*/
 /* Error Handler */
 extern void Error_Handler(void);
@@ -149,6 +178,24 @@ static inline uint16_t AdcReadRaw (const ADCCTRL_Handle_t * const p_Handle);
   */
 static inline void ConversionStartPoll_ADC_GrpRegular (void);
 
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+  * @brief  Start the batch at the head of the queue, the ones that cannot be
+  *         started are completed with their error. Once the queue is empty,
+  *         the ADC is deactivated unless a client holds it.
+  * @param  None
+  * @retval None
+  */
+static void AdcBatchRun (void);
+
+/**
+  * @brief  Configure the ADC for a batch and start its conversions by DMA.
+  * @param  p_Batch: Batch to start
+  * @retval State of the start
+  */
+static ADCCTRL_Cmd_Status_t AdcBatchStart (const ADCCTRL_Batch_t * const p_Batch);
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Functions Definition ------------------------------------------------------*/
 __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_Init (void)
 {
@@ -176,6 +223,35 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_Init (void)
   return error;
 }
 
+__WEAK ADCCTRL_Cmd_Status_t ADCCTRL_WarmUp (void)
+{
+  ADCCTRL_Cmd_Status_t error = ADCCTRL_UNKNOWN;
+
+  /* Try to take the ADC mutex */
+  error = ADCCTRL_MutexTake ();
+
+  if (ADCCTRL_OK == error)
+  {
+    /* Same sequence as the start of AdcActivate, without the wait : the regulator is found ready there */
+    if (LL_ADC_IsEnabled(p_ADCHandle) == 0)
+    {
+      /* Select clock source */
+      ADCTCTRL_SET_CLOCK_SOURCE ();
+
+      /* Peripheral clock enable */
+      ADCCTRL_ENABLE_CLOCK ();
+
+      /* Enable ADC internal voltage regulator */
+      LL_ADC_EnableInternalRegulator(p_ADCHandle);
+    }
+
+    /* Release the mutex */
+    ADCCTRL_MutexRelease ();
+  }
+
+  return error;
+}
+
 __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RegisterHandle (ADCCTRL_Handle_t * const p_Handle)
 {
   ADCCTRL_Cmd_Status_t error = ADCCTRL_UNKNOWN;
@@ -234,10 +310,24 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestIpState (const ADCCTRL_Handle_t * con
     error = ADCCTRL_ERROR_STATE;
   }
 
-  if (0x00u == ClientList)
+  if (ADCCTRL_BATCH_RUNNING())
   {
-    /* Disable ADC as there is no request anymore */
-    AdcDeactivate();
+    /* Kept on until the end of the batches */
+  }
+  else if (0x00u == ClientList)
+  {
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+    if (NULL != p_BatchHead)
+    {
+      /* The batches waited for the release of the ADC */
+      AdcBatchRun();
+    }
+    else
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+    {
+      /* Disable ADC as there is no request anymore */
+      AdcDeactivate();
+    }
   }
   else
   {
@@ -276,6 +366,11 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestRawValue (const ADCCTRL_Handle_t * co
   {
     error = ADCCTRL_ERROR_STATE;
   }
+  /* ADC held by a batch */
+  else if (ADCCTRL_BATCH_RUNNING())
+  {
+    error = ADCCTRL_BUSY;
+  }
   else
   {
     /* Try to take the ADC mutex */
@@ -342,6 +437,11 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestTemperature (const ADCCTRL_Handle_t *
   {
     error = ADCCTRL_ERROR_STATE;
   }
+  /* ADC held by a batch */
+  else if (ADCCTRL_BATCH_RUNNING())
+  {
+    error = ADCCTRL_BUSY;
+  }
   else
   {
     /* Try to take the ADC mutex */
@@ -365,24 +465,7 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestTemperature (const ADCCTRL_Handle_t *
         uhADCxConvertedData = AdcReadRaw (p_Handle);
 
         /* Computation of ADC conversions raw data to physical values             */
-        /* using LL ADC driver helper macro.                                      */
-        if(*TEMPSENSOR_CAL1_ADDR == *TEMPSENSOR_CAL2_ADDR)
-        {
-          /* Case of samples not calibrated in production */
-          *p_ReadValue = __LL_ADC_CALC_TEMPERATURE_TYP_PARAMS (TEMPSENSOR_TYP_AVGSLOPE,
-                                                               TEMPSENSOR_TYP_CAL1_V,
-                                                               TEMPSENSOR_CAL1_TEMP,
-                                                               VDDA_APPLI,
-                                                               uhADCxConvertedData,
-                                                               p_Handle->InitConf.ConvParams.Resolution);
-        }
-        else
-        {
-          /* Case of samples calibrated in production */
-          *p_ReadValue = __LL_ADC_CALC_TEMPERATURE (VDDA_APPLI,
-                                                    uhADCxConvertedData,
-                                                    p_Handle->InitConf.ConvParams.Resolution);
-        }
+        *p_ReadValue = ADCCTRL_ConvertTemperature (p_Handle, uhADCxConvertedData);
       }
       else
       {
@@ -428,6 +511,11 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestCoreVoltage (const ADCCTRL_Handle_t *
   {
     error = ADCCTRL_ERROR_STATE;
   }
+  /* ADC held by a batch */
+  else if (ADCCTRL_BATCH_RUNNING())
+  {
+    error = ADCCTRL_BUSY;
+  }
   else
   {
     /* Try to take the ADC mutex */
@@ -500,6 +588,11 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestRefVoltage (const ADCCTRL_Handle_t *
   {
     error = ADCCTRL_ERROR_STATE;
   }
+  /* ADC held by a batch */
+  else if (ADCCTRL_BATCH_RUNNING())
+  {
+    error = ADCCTRL_BUSY;
+  }
   else
   {
     /* Try to take the ADC mutex */
@@ -523,9 +616,7 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestRefVoltage (const ADCCTRL_Handle_t *
         uhADCxConvertedData = AdcReadRaw (p_Handle);
 
         /* Computation of ADC conversions raw data to physical values             */
-        /* using LL ADC driver helper macro.                                      */
-        *p_ReadValue = __LL_ADC_CALC_VREFANALOG_VOLTAGE (uhADCxConvertedData,
-                                                         p_Handle->InitConf.ConvParams.Resolution);
+        *p_ReadValue = ADCCTRL_ConvertSupplyVoltage (p_Handle, uhADCxConvertedData);
       }
       else
       {
@@ -540,6 +631,157 @@ __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_RequestRefVoltage (const ADCCTRL_Handle_t *
   return error;
 }
 
+uint16_t ADCCTRL_ConvertTemperature (const ADCCTRL_Handle_t * const p_Handle,
+                                     const uint16_t RawValue)
+{
+  uint16_t temperature;
+
+  /* Computation of ADC conversions raw data to physical values             */
+  /* using LL ADC driver helper macro.                                      */
+  if(*TEMPSENSOR_CAL1_ADDR == *TEMPSENSOR_CAL2_ADDR)
+  {
+    /* Case of samples not calibrated in production */
+    temperature = __LL_ADC_CALC_TEMPERATURE_TYP_PARAMS (TEMPSENSOR_TYP_AVGSLOPE,
+                                                        TEMPSENSOR_TYP_CAL1_V,
+                                                        TEMPSENSOR_CAL1_TEMP,
+                                                        VDDA_APPLI,
+                                                        RawValue,
+                                                        p_Handle->InitConf.ConvParams.Resolution);
+  }
+  else
+  {
+    /* Case of samples calibrated in production */
+    temperature = __LL_ADC_CALC_TEMPERATURE (VDDA_APPLI,
+                                             RawValue,
+                                             p_Handle->InitConf.ConvParams.Resolution);
+  }
+
+  return temperature;
+}
+
+uint16_t ADCCTRL_ConvertSupplyVoltage (const ADCCTRL_Handle_t * const p_Handle,
+                                       const uint16_t RawValue)
+{
+  uint16_t voltage = 0;
+
+  /* Computation of ADC conversions raw data to physical values             */
+  /* using LL ADC driver helper macro.                                      */
+  if (0x00u != RawValue)
+  {
+    voltage = __LL_ADC_CALC_VREFANALOG_VOLTAGE (RawValue,
+                                                p_Handle->InitConf.ConvParams.Resolution);
+  }
+
+  return voltage;
+}
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+ADCCTRL_Cmd_Status_t ADCCTRL_SubmitBatch (ADCCTRL_Batch_t * const p_Batch)
+{
+  ADCCTRL_Cmd_Status_t error = ADCCTRL_OK;
+  uint8_t start = 0;
+
+  /* Null pointer for batch, handle or callback */
+  if ((NULL == p_Batch) || (NULL == p_Batch->p_Handle) || (NULL == p_Batch->Callback))
+  {
+    error = ADCCTRL_ERROR_NULL_POINTER;
+  }
+  /* Handle not init */
+  else if (ADCCTRL_HANDLE_NOT_REG == p_Batch->p_Handle->State)
+  {
+    error = ADCCTRL_HANDLE_NOT_REGISTERED;
+  }
+  else
+  {
+    p_Batch->Status = ADCCTRL_BUSY;
+    p_Batch->p_Next = NULL;
+
+    UTILS_ENTER_CRITICAL_SECTION();
+
+    if (NULL != p_BatchTail)
+    {
+      p_BatchTail->p_Next = p_Batch;
+    }
+    else
+    {
+      p_BatchHead = p_Batch;
+    }
+    p_BatchTail = p_Batch;
+
+    /* Started at once when the ADC is free, else at the end of the running batch or of the polled requests */
+    if ((0x00u == BatchRunning) && (0x00u == ClientList))
+    {
+      BatchRunning = 1u;
+      start = 1;
+    }
+
+    UTILS_EXIT_CRITICAL_SECTION();
+
+    if (0 != start)
+    {
+      AdcBatchRun();
+    }
+  }
+
+  return error;
+}
+
+void ADCCTRL_DmaIrqHandler (void)
+{
+  ADCCTRL_Batch_t * p_Batch = p_BatchHead;
+  ADCCTRL_Cmd_Status_t error = ADCCTRL_OK;
+  uint32_t sum = 0;
+  uint32_t index;
+
+  if (LL_DMA_IsActiveFlag_DTE(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL))
+  {
+    error = ADCCTRL_NOK;
+  }
+  else if (!LL_DMA_IsActiveFlag_TC(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL))
+  {
+    return;
+  }
+
+  /* Stop the conversions (continuous mode) and the channel */
+  LL_ADC_REG_StopConversion(p_ADCHandle);
+  while (LL_ADC_REG_IsStopConversionOngoing(p_ADCHandle) != 0);
+  LL_DMA_DisableChannel(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_TC(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_DTE(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_ADC_ClearFlag_OVR(p_ADCHandle);
+
+  SYSTEM_DEBUG_SIGNAL_RESET(ADC_TEMPERATURE_ACQUISITION);
+
+  if ((NULL == p_Batch) || (0x00u == BatchRunning))
+  {
+    return;
+  }
+
+  for (index = 0; index < CFG_ADCCTRL_BATCH_SAMPLES; index++)
+  {
+    sum += BatchSamples[index];
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  p_BatchHead = p_Batch->p_Next;
+  if (NULL == p_BatchHead)
+  {
+    p_BatchTail = NULL;
+  }
+
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  p_Batch->Average = (uint16_t)((sum + (CFG_ADCCTRL_BATCH_SAMPLES / 2u)) / CFG_ADCCTRL_BATCH_SAMPLES);
+  p_Batch->Status = error;
+
+  /* Next batch in the same activation, before the callback that may queue another one */
+  AdcBatchRun();
+
+  p_Batch->Callback(p_Batch);
+}
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Private function Definition -----------------------------------------------*/
 void AdcActivate (void)
 {
@@ -880,6 +1122,118 @@ void ConversionStartPoll_ADC_GrpRegular (void)
   LL_ADC_ClearFlag_EOC(p_ADCHandle);
 }
 
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+void AdcBatchRun (void)
+{
+  ADCCTRL_Batch_t * p_Batch;
+
+  while (1)
+  {
+    UTILS_ENTER_CRITICAL_SECTION();
+
+    p_Batch = p_BatchHead;
+    BatchRunning = (NULL != p_Batch) ? 1u : 0u;
+
+    UTILS_EXIT_CRITICAL_SECTION();
+
+    if (NULL == p_Batch)
+    {
+      /* End of the activation shared by the batches */
+      if (0x00u == ClientList)
+      {
+        AdcDeactivate();
+      }
+      UTIL_LPM_SetStopMode(1U << CFG_LPM_ADC, UTIL_LPM_ENABLE);
+      return;
+    }
+
+    /* The ADC and the DMA are not clocked in Stop mode */
+    UTIL_LPM_SetStopMode(1U << CFG_LPM_ADC, UTIL_LPM_DISABLE);
+
+    if (ADCCTRL_OK == AdcBatchStart(p_Batch))
+    {
+      return;
+    }
+
+    /* Not started : completed at once */
+    {
+      UTILS_ENTER_CRITICAL_SECTION();
+
+      p_BatchHead = p_Batch->p_Next;
+      if (NULL == p_BatchHead)
+      {
+        p_BatchTail = NULL;
+      }
+
+      UTILS_EXIT_CRITICAL_SECTION();
+    }
+
+    p_Batch->Average = 0;
+    p_Batch->Status = ADCCTRL_ERROR_CONFIG;
+    p_Batch->Callback(p_Batch);
+  }
+}
+
+ADCCTRL_Cmd_Status_t AdcBatchStart (const ADCCTRL_Batch_t * const p_Batch)
+{
+  ADCCTRL_Cmd_Status_t error;
+
+  SYSTEM_DEBUG_SIGNAL_SET(ADC_TEMPERATURE_ACQUISITION);
+
+  /* Activated once for all the batches of the queue, the configuration is applied to each one */
+  AdcActivate();
+
+  error = AdcConfigure(p_Batch->p_Handle);
+
+  /* The batch settings below differ from the handle ones : the next polled request configures the ADC again */
+  CurrentConfig = ADCCTRL_NO_CONFIG;
+
+  if (ADCCTRL_OK != error)
+  {
+    SYSTEM_DEBUG_SIGNAL_RESET(ADC_TEMPERATURE_ACQUISITION);
+    return error;
+  }
+
+  /* Continuous conversions, each one averaged by the oversampler, until the DMA transfer is complete */
+  LL_ADC_REG_SetContinuousMode(p_ADCHandle, LL_ADC_REG_CONV_CONTINUOUS);
+  LL_ADC_REG_SetDMATransfer(p_ADCHandle, LL_ADC_REG_DMA_TRANSFER_LIMITED);
+  LL_ADC_ConfigOverSamplingRatioShift(p_ADCHandle, CFG_ADCCTRL_BATCH_OVS_RATIO, CFG_ADCCTRL_BATCH_OVS_SHIFT);
+  LL_ADC_SetOverSamplingScope(p_ADCHandle, LL_ADC_OVS_GRP_REGULAR_CONTINUED);
+
+  /* Enable ADC */
+  LL_ADC_ClearFlag_ADRDY(p_ADCHandle);
+  LL_ADC_Enable(p_ADCHandle);
+  while (LL_ADC_IsActiveFlag_ADRDY(p_ADCHandle) == 0);
+
+  /* ADC data register to the samples */
+  LL_DMA_SetDataTransferDirection(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetPeriphRequest(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_GPDMA1_REQUEST_ADC4);
+  LL_DMA_SetSrcIncMode(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_DMA_SRC_FIXED);
+  LL_DMA_SetDestIncMode(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_DMA_DEST_INCREMENT);
+  LL_DMA_SetSrcDataWidth(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_DMA_SRC_DATAWIDTH_HALFWORD);
+  LL_DMA_SetDestDataWidth(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, LL_DMA_DEST_DATAWIDTH_HALFWORD);
+  LL_DMA_SetSrcAddress(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL,
+                       LL_ADC_DMA_GetRegAddr(p_ADCHandle, LL_ADC_DMA_REG_REGULAR_DATA));
+  LL_DMA_SetDestAddress(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, (uint32_t)BatchSamples);
+  LL_DMA_SetBlkDataLength(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL, sizeof(BatchSamples));
+  LL_DMA_ClearFlag_TC(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_DTE(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_DMA_EnableIT_TC(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+  LL_DMA_EnableIT_DTE(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+
+  NVIC_SetPriority(CFG_ADCCTRL_DMA_IRQn, ADC_DMA_INTR_PRIO);
+  NVIC_EnableIRQ(CFG_ADCCTRL_DMA_IRQn);
+
+  LL_DMA_EnableChannel(GPDMA1, CFG_ADCCTRL_DMA_CHANNEL);
+
+  /* Start ADC group regular conversions */
+  LL_ADC_ClearFlag_OVR(p_ADCHandle);
+  LL_ADC_REG_StartConversion(p_ADCHandle);
+
+  return ADCCTRL_OK;
+}
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Weak function Definition --------------------------------------------------*/
 __WEAK ADCCTRL_Cmd_Status_t ADCCTRL_MutexTake (void)
 {
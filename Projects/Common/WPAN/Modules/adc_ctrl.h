@@ -161,6 +161,20 @@ typedef struct ADCCTRL_Handle
   ADCCTRL_ChannelConfig_t ChannelConf;    /* Channel configuration of the ADC */
 } ADCCTRL_Handle_t;
 
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+ * @brief ADC batch : CFG_ADCCTRL_BATCH_SAMPLES conversions of a handle, oversampled by the ADC and transferred by DMA
+ */
+typedef struct ADCCTRL_Batch
+{
+  const ADCCTRL_Handle_t * p_Handle;                  /* Handle to convert */
+  void (* Callback) (struct ADCCTRL_Batch * p_Batch); /* Called from the DMA interrupt at the end of the batch */
+  ADCCTRL_Cmd_Status_t Status;                        /* ADCCTRL_OK, or the error of the batch */
+  uint16_t Average;                                   /* Average of the samples (raw value) */
+  struct ADCCTRL_Batch * p_Next;                      /* Queue of the batches */
+} ADCCTRL_Batch_t;
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Exported constants --------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
@@ -172,6 +186,17 @@ typedef struct ADCCTRL_Handle
   */
 ADCCTRL_Cmd_Status_t ADCCTRL_Init(void);
 
+/**
+  * @brief  Enable the ADC internal voltage regulator ahead of the first activation
+  *
+  * @details The regulator stabilizes while the caller goes on, the first
+  *          activation does not wait for it. It is turned off with the ADC at
+  *          the first deactivation.
+  *
+  * @retval State of the operation
+  */
+ADCCTRL_Cmd_Status_t ADCCTRL_WarmUp(void);
+
 /**
   * @brief  Register a ADC handle
   *
@@ -242,6 +267,53 @@ ADCCTRL_Cmd_Status_t ADCCTRL_RequestCoreVoltage (const ADCCTRL_Handle_t * const
 ADCCTRL_Cmd_Status_t ADCCTRL_RequestRefVoltage (const ADCCTRL_Handle_t * const p_Handle,
                                                 uint16_t * const p_ReadValue);
 
+/**
+  * @brief  Convert a raw value of the temperature sensor
+  *
+  * @param p_Handle: ADC handle of the conversion
+  * @param RawValue: Raw ADC value
+  *
+  * @retval Temperature in Celsius degrees
+  */
+uint16_t ADCCTRL_ConvertTemperature (const ADCCTRL_Handle_t * const p_Handle,
+                                     const uint16_t RawValue);
+
+/**
+  * @brief  Convert a raw value of the internal voltage reference to the
+  *         analog supply voltage
+  *
+  * @param p_Handle: ADC handle of the conversion
+  * @param RawValue: Raw ADC value of VrefInt
+  *
+  * @retval Analog supply voltage (Vref+) in mVolts, 0 on a null value
+  */
+uint16_t ADCCTRL_ConvertSupplyVoltage (const ADCCTRL_Handle_t * const p_Handle,
+                                       const uint16_t RawValue);
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+  * @brief  Queue a batch of conversions
+  *
+  * @details The batches run one after the other in the same activation of
+  *          the ADC, without waiting for the conversions : the callback of
+  *          each one is called from the DMA interrupt. A batch waits while
+  *          a client holds the ADC on for polled requests, and these
+  *          requests are refused (ADCCTRL_BUSY) while a batch runs.
+  *
+  * @param p_Batch: Batch to run, its handle and callback set
+  *
+  * @retval State of the operation
+  */
+ADCCTRL_Cmd_Status_t ADCCTRL_SubmitBatch (ADCCTRL_Batch_t * const p_Batch);
+
+/**
+  * @brief  End of the DMA transfer of a batch
+  *
+  * @details To be called from the interrupt handler of the DMA channel.
+  */
+void ADCCTRL_DmaIrqHandler (void);
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
 /* Exported functions to be implemented by the user ------------------------- */
 /**
  * @brief  Take ownership on the ADC mutex
@@ -28,6 +28,11 @@
 /* HAL CRC header */
 #include "stm32wbaxx_hal_crc.h"
 
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+/* LL DMA header */
+#include "stm32wbaxx_ll_dma.h"
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+
 /* Private defines -----------------------------------------------------------*/
 /**
  * @brief Initial value define for configuration tracking number
@@ -35,14 +40,26 @@
  */
 #define CRCCTRL_NO_CONFIG   (uint32_t)(0x00000000u)
 
+/**
+ * @brief Maximum size in words of a DMA block - The block length is on 16 bits, in bytes
+ *
+ */
+#define CRCCTRL_DMA_MAX_SIZE  (uint32_t)(0x0000FFFFu / sizeof (uint32_t))
+
 /* Private typedef -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /**
- * @brief Tracker of the current applied configuration
+ * @brief Tracker of the current applied configuration - Handle whose partial CRC is in the data register
  */
 static uint32_t CurrentConfig = CRCCTRL_NO_CONFIG;
 
+/**
+ * @brief Configuration loaded in the CRC, shared by the handles with the same one
+ */
+static CRCCTRL_Config_t LoadedConfig;
+static uint8_t IsConfigLoaded = FALSE;
+
 /**
  * @brief Higher registered handle ID
  */
@@ -56,6 +73,19 @@ static CRC_HandleTypeDef CRCHandle =
   .Instance = CRCCTRL_HWADDR,
 };
 
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+/**
+ * @brief Handle owning the CRC while its chunk is fed by the DMA
+ */
+static CRCCTRL_Handle_t * p_DmaHandle = NULL;
+
+/**
+ * @brief Rest of the chunk, beyond the maximum size of a DMA block
+ */
+static uint32_t * p_DmaPayload = NULL;
+static uint32_t DmaRemainingSize = 0x00u;
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+
 /* Global variables ----------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /**
@@ -65,6 +95,40 @@ static CRC_HandleTypeDef CRCHandle =
   */
 static inline HAL_StatusTypeDef CrcConfigure (CRCCTRL_Handle_t * const p_Handle);
 
+/**
+  * @brief  Compare a configuration to the one loaded in the CRC
+  * @param  p_Config: Configuration to compare
+  * @retval TRUE when the CRC does not need to be reprogrammed
+  */
+static inline uint8_t CrcIsConfigLoaded (const CRCCTRL_Config_t * const p_Config);
+
+/**
+  * @brief  Load the partial CRC of a handle as init value, to keep going from it
+  * @param  p_Handle: CRC handle
+  * @retval None
+  */
+static inline void CrcLoadState (const CRCCTRL_Handle_t * const p_Handle);
+
+/**
+  * @brief  Restore the init value of the loaded configuration
+  * @retval None
+  */
+static inline void CrcRestoreInit (void);
+
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+/**
+  * @brief  Feed the next DMA block of the chunk to the CRC
+  * @retval None
+  */
+static inline void DmaFeed (void);
+
+/**
+  * @brief  Stop the DMA, restore the CRC init value and release the CRC
+  * @retval None
+  */
+static inline void DmaStop (void);
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+
 /* Functions Definition ------------------------------------------------------*/
 __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Init (void)
 {
@@ -76,6 +140,7 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Init (void)
   if (CRCCTRL_OK == error)
   {
     CurrentConfig = CRCCTRL_NO_CONFIG;
+    IsConfigLoaded = FALSE;
 
     CRCHandle.State = HAL_CRC_STATE_RESET;
 
@@ -150,8 +215,24 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Calculate (CRCCTRL_Handle_t * const p_Handle
   }
   else
   {
-    /* Try to take the CRC mutex */
-    error = CRCCTRL_MutexTake ();
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+    /* A new computation of the handle aborts its chunk in progress */
+    if (p_DmaHandle == p_Handle)
+    {
+      DmaStop ();
+    }
+
+    /* The CRC is fed by the DMA for another handle */
+    if (NULL != p_DmaHandle)
+    {
+      error = CRCCTRL_BUSY;
+    }
+    else
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+    {
+      /* Try to take the CRC mutex */
+      error = CRCCTRL_MutexTake ();
+    }
 
     if (CRCCTRL_OK == error)
     {
@@ -207,8 +288,24 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Accumulate (CRCCTRL_Handle_t * const p_Handl
   }
   else
   {
-    /* Try to take the CRC mutex */
-    error = CRCCTRL_MutexTake ();
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+    /* A new computation of the handle aborts its chunk in progress */
+    if (p_DmaHandle == p_Handle)
+    {
+      DmaStop ();
+    }
+
+    /* The CRC is fed by the DMA for another handle */
+    if (NULL != p_DmaHandle)
+    {
+      error = CRCCTRL_BUSY;
+    }
+    else
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+    {
+      /* Try to take the CRC mutex */
+      error = CRCCTRL_MutexTake ();
+    }
 
     if (CRCCTRL_OK == error)
     {
@@ -226,7 +323,7 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Accumulate (CRCCTRL_Handle_t * const p_Handl
       else if (HAL_OK == CrcConfigure (p_Handle))
       {
         /* Before starting the accumulation, the init register shall be written with the previous value */
-        CRCHandle.Instance->INIT = p_Handle->PreviousComputedValue;
+        CrcLoadState (p_Handle);
 
         *p_ConmputedValue = HAL_CRC_Calculate (&CRCHandle,
                                                a_Payload,
@@ -234,6 +331,9 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Accumulate (CRCCTRL_Handle_t * const p_Handl
 
         /* Update the handle with the computed value */
         p_Handle->PreviousComputedValue = *p_ConmputedValue;
+
+        /* The next CRCCTRL_Calculate starts from the init value of the configuration */
+        CrcRestoreInit ();
       }
       else
       {
@@ -248,20 +348,297 @@ __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_Accumulate (CRCCTRL_Handle_t * const p_Handl
   return error;
 }
 
+__WEAK CRCCTRL_Cmd_Status_t CRCCTRL_AccumulateStart (CRCCTRL_Handle_t * const p_Handle,
+                                                     uint32_t a_Payload[],
+                                                     const uint32_t PayloadSize,
+                                                     const uint8_t First)
+{
+  CRCCTRL_Cmd_Status_t error = CRCCTRL_UNKNOWN;
+  uint32_t computedValue = 0x00u;
+
+  /* Null pointer for handle or payload */
+  if ((NULL == p_Handle) || (NULL == a_Payload))
+  {
+    error = CRCCTRL_ERROR_NULL_POINTER;
+  }
+  /* Handle not init */
+  else if (HANDLE_NOT_REG == p_Handle->State)
+  {
+    error = CRCCTRL_HANDLE_NOT_REGISTERED;
+  }
+  /* Handle not in the range */
+  else if ((MaxRegisteredId < p_Handle->Uid) ||
+           (CRCCTRL_NO_CONFIG >= p_Handle->Uid))
+  {
+    error = CRCCTRL_HANDLE_NOT_VALID;
+  }
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+  /* The DMA feeds words : other formats and empty chunks are fed by the CPU */
+  else if ((CRC_INPUTDATA_FORMAT_WORDS == p_Handle->Configuration.InputDataFormat) && (0x00u != PayloadSize))
+  {
+    /* A new computation of the handle aborts its chunk in progress */
+    if (p_DmaHandle == p_Handle)
+    {
+      DmaStop ();
+    }
+
+    /* The CRC is fed by the DMA for another handle */
+    if (NULL != p_DmaHandle)
+    {
+      error = CRCCTRL_BUSY;
+    }
+    else
+    {
+      /* Try to take the CRC mutex - Released by CRCCTRL_AccumulateEnd */
+      error = CRCCTRL_MutexTake ();
+    }
+
+    if (CRCCTRL_OK == error)
+    {
+      /* Configure the CRC before use */
+      if ((CurrentConfig != p_Handle->Uid) && (HAL_OK != CrcConfigure (p_Handle)))
+      {
+        error = CRCCTRL_ERROR_CONFIG;
+
+        /* Release the mutex */
+        CRCCTRL_MutexRelease ();
+      }
+      else
+      {
+        /* Start from the init value, or keep going from the previous chunks */
+        if (FALSE == First)
+        {
+          CrcLoadState (p_Handle);
+        }
+
+        __HAL_CRC_DR_RESET (&CRCHandle);
+
+        p_DmaHandle = p_Handle;
+        p_DmaPayload = a_Payload;
+        DmaRemainingSize = PayloadSize;
+
+        DmaFeed ();
+      }
+    }
+  }
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+  /* Fed by the CPU, at once */
+  else if (FALSE != First)
+  {
+    error = CRCCTRL_Calculate (p_Handle, a_Payload, PayloadSize, &computedValue);
+  }
+  else
+  {
+    error = CRCCTRL_Accumulate (p_Handle, a_Payload, PayloadSize, &computedValue);
+  }
+
+  return error;
+}
+
+__WEAK CRCCTRL_Cmd_Status_t CRCCTRL_AccumulateEnd (CRCCTRL_Handle_t * const p_Handle,
+                                                   uint32_t * const p_ConmputedValue)
+{
+  CRCCTRL_Cmd_Status_t error = CRCCTRL_UNKNOWN;
+
+  /* Null pointer for handle or value */
+  if ((NULL == p_Handle) || (NULL == p_ConmputedValue))
+  {
+    error = CRCCTRL_ERROR_NULL_POINTER;
+  }
+  /* Handle not init */
+  else if (HANDLE_NOT_REG == p_Handle->State)
+  {
+    error = CRCCTRL_HANDLE_NOT_REGISTERED;
+  }
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+  /* Chunk fed by the DMA */
+  else if (p_DmaHandle == p_Handle)
+  {
+    if (0u != LL_DMA_IsActiveFlag_DTE (GPDMA1, CRCCTRL_DMA_CHANNEL))
+    {
+      DmaStop ();
+
+      error = CRCCTRL_NOK;
+    }
+    else if (0u == LL_DMA_IsActiveFlag_TC (GPDMA1, CRCCTRL_DMA_CHANNEL))
+    {
+      error = CRCCTRL_BUSY;
+    }
+    else if (0x00u != DmaRemainingSize)
+    {
+      /* Block done, feed the rest of the chunk */
+      DmaFeed ();
+
+      error = CRCCTRL_BUSY;
+    }
+    else
+    {
+      *p_ConmputedValue = CRCHandle.Instance->DR;
+
+      /* Update the handle with the computed value */
+      p_Handle->PreviousComputedValue = *p_ConmputedValue;
+
+      DmaStop ();
+
+      error = CRCCTRL_OK;
+    }
+  }
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+  /* Chunk fed by the CPU */
+  else
+  {
+    *p_ConmputedValue = p_Handle->PreviousComputedValue;
+
+    error = CRCCTRL_OK;
+  }
+
+  return error;
+}
+
+__WEAK CRCCTRL_Cmd_Status_t CRCCTRL_SaveState (CRCCTRL_Handle_t * const p_Handle,
+                                               uint32_t * const p_State)
+{
+  CRCCTRL_Cmd_Status_t error = CRCCTRL_UNKNOWN;
+
+  /* Null pointer for handle or state */
+  if ((NULL == p_Handle) || (NULL == p_State))
+  {
+    error = CRCCTRL_ERROR_NULL_POINTER;
+  }
+  /* Handle not init */
+  else if (HANDLE_NOT_REG == p_Handle->State)
+  {
+    error = CRCCTRL_HANDLE_NOT_REGISTERED;
+  }
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+  /* Partial CRC not known until the end of the chunk */
+  else if (p_DmaHandle == p_Handle)
+  {
+    error = CRCCTRL_BUSY;
+  }
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+  else
+  {
+    /* The handle always holds its partial CRC : the CRC data register is only a cache of it */
+    *p_State = p_Handle->PreviousComputedValue;
+
+    error = CRCCTRL_OK;
+  }
+
+  return error;
+}
+
+__WEAK CRCCTRL_Cmd_Status_t CRCCTRL_RestoreState (CRCCTRL_Handle_t * const p_Handle,
+                                                  const uint32_t State)
+{
+  CRCCTRL_Cmd_Status_t error = CRCCTRL_UNKNOWN;
+
+  /* Null pointer for handle */
+  if (NULL == p_Handle)
+  {
+    error = CRCCTRL_ERROR_NULL_POINTER;
+  }
+  /* Handle not init */
+  else if (HANDLE_NOT_REG == p_Handle->State)
+  {
+    error = CRCCTRL_HANDLE_NOT_REGISTERED;
+  }
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+  else if (p_DmaHandle == p_Handle)
+  {
+    error = CRCCTRL_BUSY;
+  }
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+  else
+  {
+    /* Try to take the CRC mutex */
+    error = CRCCTRL_MutexTake ();
+
+    if (CRCCTRL_OK == error)
+    {
+      p_Handle->PreviousComputedValue = State;
+
+      /* The data register no more holds the partial CRC of the handle : reloaded by the next accumulation */
+      if (CurrentConfig == p_Handle->Uid)
+      {
+        CurrentConfig = CRCCTRL_NO_CONFIG;
+      }
+
+      /* Release the mutex */
+      CRCCTRL_MutexRelease ();
+    }
+  }
+
+  return error;
+}
+
 /* Private function Definition -----------------------------------------------*/
+#if (CRCCTRL_DMA_SUPPORTED != 0)
+void DmaFeed (void)
+{
+  uint32_t blockSize = DmaRemainingSize;
+
+  if (CRCCTRL_DMA_MAX_SIZE < blockSize)
+  {
+    blockSize = CRCCTRL_DMA_MAX_SIZE;
+  }
+
+  /* Memory to memory : the words of the payload to the fixed CRC data register */
+  LL_DMA_DisableChannel (GPDMA1, CRCCTRL_DMA_CHANNEL);
+  LL_DMA_SetDataTransferDirection (GPDMA1, CRCCTRL_DMA_CHANNEL, LL_DMA_DIRECTION_MEMORY_TO_MEMORY);
+  LL_DMA_SetSrcIncMode (GPDMA1, CRCCTRL_DMA_CHANNEL, LL_DMA_SRC_INCREMENT);
+  LL_DMA_SetDestIncMode (GPDMA1, CRCCTRL_DMA_CHANNEL, LL_DMA_DEST_FIXED);
+  LL_DMA_SetSrcDataWidth (GPDMA1, CRCCTRL_DMA_CHANNEL, LL_DMA_SRC_DATAWIDTH_WORD);
+  LL_DMA_SetDestDataWidth (GPDMA1, CRCCTRL_DMA_CHANNEL, LL_DMA_DEST_DATAWIDTH_WORD);
+  LL_DMA_SetSrcAddress (GPDMA1, CRCCTRL_DMA_CHANNEL, (uint32_t)p_DmaPayload);
+  LL_DMA_SetDestAddress (GPDMA1, CRCCTRL_DMA_CHANNEL, (uint32_t)&CRCHandle.Instance->DR);
+  LL_DMA_SetBlkDataLength (GPDMA1, CRCCTRL_DMA_CHANNEL, (blockSize * sizeof (uint32_t)));
+  LL_DMA_ClearFlag_TC (GPDMA1, CRCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_DTE (GPDMA1, CRCCTRL_DMA_CHANNEL);
+
+  p_DmaPayload = &p_DmaPayload[blockSize];
+  DmaRemainingSize = DmaRemainingSize - blockSize;
+
+  LL_DMA_EnableChannel (GPDMA1, CRCCTRL_DMA_CHANNEL);
+}
+
+void DmaStop (void)
+{
+  LL_DMA_DisableChannel (GPDMA1, CRCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_TC (GPDMA1, CRCCTRL_DMA_CHANNEL);
+  LL_DMA_ClearFlag_DTE (GPDMA1, CRCCTRL_DMA_CHANNEL);
+
+  /* Restore the init value of the configuration, for the next CRCCTRL_Calculate */
+  CrcRestoreInit ();
+
+  p_DmaHandle = NULL;
+  p_DmaPayload = NULL;
+  DmaRemainingSize = 0x00u;
+
+  /* Release the mutex */
+  CRCCTRL_MutexRelease ();
+}
+#endif /* (CRCCTRL_DMA_SUPPORTED != 0) */
+
 HAL_StatusTypeDef CrcConfigure (CRCCTRL_Handle_t * const p_Handle)
 {
   HAL_StatusTypeDef error = HAL_OK;
 
+  /* Same configuration as the previous handle : the CRC is kept as is, only its owner changes */
+  if (FALSE != CrcIsConfigLoaded (&p_Handle->Configuration))
+  {
+    CurrentConfig = p_Handle->Uid;
+  }
   /* No need to DeInit if the CRC if it is not yet initialized */
-  if (HAL_CRC_STATE_RESET != CRCHandle.State)
+  else if (HAL_CRC_STATE_RESET != CRCHandle.State)
   {
     /* DeInit the CRC module */
+    IsConfigLoaded = FALSE;
     error = HAL_CRC_DeInit(&CRCHandle);
   }
 
   /* All OK ? */
-  if (HAL_OK == error)
+  if ((HAL_OK == error) && (CurrentConfig != p_Handle->Uid))
   {
     /* Fulfill the configuration part */
     CRCHandle.Init.CRCLength = p_Handle->Configuration.CRCLength;
@@ -280,9 +657,13 @@ HAL_StatusTypeDef CrcConfigure (CRCCTRL_Handle_t * const p_Handle)
     {
       /* Update the current configuration */
       CurrentConfig = p_Handle->Uid;
+      LoadedConfig = p_Handle->Configuration;
+      IsConfigLoaded = TRUE;
     }
     else
     {
+      IsConfigLoaded = FALSE;
+
       /* There must be an issue with configuration, clean the configuration */
       memset ((void *)(&CRCHandle.Init),
               0x00,
@@ -295,6 +676,59 @@ HAL_StatusTypeDef CrcConfigure (CRCCTRL_Handle_t * const p_Handle)
   return error;
 }
 
+uint8_t CrcIsConfigLoaded (const CRCCTRL_Config_t * const p_Config)
+{
+  /* Compared field by field : the structure has padding */
+  return (uint8_t)((FALSE != IsConfigLoaded) &&
+                   (LoadedConfig.DefaultPolynomialUse == p_Config->DefaultPolynomialUse) &&
+                   (LoadedConfig.DefaultInitValueUse == p_Config->DefaultInitValueUse) &&
+                   (LoadedConfig.GeneratingPolynomial == p_Config->GeneratingPolynomial) &&
+                   (LoadedConfig.CRCLength == p_Config->CRCLength) &&
+                   (LoadedConfig.InitValue == p_Config->InitValue) &&
+                   (LoadedConfig.InputDataInversionMode == p_Config->InputDataInversionMode) &&
+                   (LoadedConfig.OutputDataInversionMode == p_Config->OutputDataInversionMode) &&
+                   (LoadedConfig.InputDataFormat == p_Config->InputDataFormat));
+}
+
+void CrcLoadState (const CRCCTRL_Handle_t * const p_Handle)
+{
+  uint32_t state = p_Handle->PreviousComputedValue;
+  uint32_t width = 32u;
+
+  /* The computed value is read bit-reversed on the CRC length : the init register takes it in normal order */
+  if (CRC_OUTPUTDATA_INVERSION_ENABLE == p_Handle->Configuration.OutputDataInversionMode)
+  {
+    if (CRC_POLYLENGTH_16B == p_Handle->Configuration.CRCLength)
+    {
+      width = 16u;
+    }
+    else if (CRC_POLYLENGTH_8B == p_Handle->Configuration.CRCLength)
+    {
+      width = 8u;
+    }
+    else if (CRC_POLYLENGTH_7B == p_Handle->Configuration.CRCLength)
+    {
+      width = 7u;
+    }
+
+    state = __RBIT (state) >> (32u - width);
+  }
+
+  CRCHandle.Instance->INIT = state;
+}
+
+void CrcRestoreInit (void)
+{
+  if (DEFAULT_INIT_VALUE_ENABLE == CRCHandle.Init.DefaultInitValueUse)
+  {
+    CRCHandle.Instance->INIT = DEFAULT_CRC_INITVALUE;
+  }
+  else
+  {
+    CRCHandle.Instance->INIT = CRCHandle.Init.InitValue;
+  }
+}
+
 /* Weak function Definition --------------------------------------------------*/
 __WEAK CRCCTRL_Cmd_Status_t CRCCTRL_MutexTake (void)
 {
@@ -180,6 +180,68 @@ CRCCTRL_Cmd_Status_t CRCCTRL_Accumulate (CRCCTRL_Handle_t * const p_Handle,
                                          const uint32_t PayloadSize,
                                          uint32_t * const p_ConmputedValue);
 
+/**
+  * @brief  Start feeding a payload to the CRC, in background when CRCCTRL_DMA_SUPPORTED is set
+  *
+  * @details The computation starts from the configured init value when First is TRUE, else it keeps going from the
+  *          CRC computed so far by the handle : a payload can be streamed chunk by chunk, one call per chunk.
+  *
+  * @details With a DMA, the CRC is owned by the handle until CRCCTRL_AccumulateEnd returns CRCCTRL_OK. A new start,
+  *          CRCCTRL_Calculate or CRCCTRL_Accumulate on the same handle aborts the chunk in progress.
+  *
+  * @param p_Handle: CRC handle
+  * @param a_Payload: Address of the first payload element
+  * @param PayloadSize: Size of the payload to compute the CRC
+  * @param First: TRUE for the first chunk of the payload
+  *
+  * @return State of the operation
+  * @retval CRCCTRL_Cmd_Status_t::CRCCTRL_BUSY when the CRC is owned by another handle
+  */
+CRCCTRL_Cmd_Status_t CRCCTRL_AccumulateStart (CRCCTRL_Handle_t * const p_Handle,
+                                              uint32_t a_Payload[],
+                                              const uint32_t PayloadSize,
+                                              const uint8_t First);
+
+/**
+  * @brief  Get the CRC of the chunks fed by CRCCTRL_AccumulateStart
+  *
+  * @param p_Handle: CRC handle
+  * @param p_ComputedValue: Computed CRC (returned value LSBs for CRC shorter than 32 bits)
+  *
+  * @return State of the operation
+  * @retval CRCCTRL_Cmd_Status_t::CRCCTRL_BUSY while the last chunk is fed to the CRC
+  */
+CRCCTRL_Cmd_Status_t CRCCTRL_AccumulateEnd (CRCCTRL_Handle_t * const p_Handle,
+                                            uint32_t * const p_ConmputedValue);
+
+/**
+  * @brief  Get the partial CRC of a handle, to resume its computation later
+  *
+  * @details The handles with the same configuration share the CRC without reprogramming it, and each handle keeps
+  *          its partial CRC : streaming users can interleave their CRCCTRL_Accumulate. The saved state allows a
+  *          handle to go back to a previous point of its stream (e.g. retry of a chunk).
+  *
+  * @param p_Handle: CRC handle
+  * @param p_State: Partial CRC of the handle (as returned by the last computation)
+  *
+  * @return State of the operation
+  * @retval CRCCTRL_Cmd_Status_t::CRCCTRL_BUSY while a chunk of the handle is fed by the DMA
+  */
+CRCCTRL_Cmd_Status_t CRCCTRL_SaveState (CRCCTRL_Handle_t * const p_Handle,
+                                        uint32_t * const p_State);
+
+/**
+  * @brief  Set the partial CRC of a handle, the next CRCCTRL_Accumulate keeps going from it
+  *
+  * @param p_Handle: CRC handle
+  * @param State: Partial CRC given by CRCCTRL_SaveState
+  *
+  * @return State of the operation
+  * @retval CRCCTRL_Cmd_Status_t::CRCCTRL_BUSY while a chunk of the handle is fed by the DMA
+  */
+CRCCTRL_Cmd_Status_t CRCCTRL_RestoreState (CRCCTRL_Handle_t * const p_Handle,
+                                           const uint32_t State);
+
 /* Exported functions to be implemented by the user ------------------------- */
 /**
  * @brief  Take ownership on the CRC mutex
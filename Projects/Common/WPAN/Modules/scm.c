@@ -44,16 +44,29 @@ __weak void SCM_HSI_SwithSystemClock_Exit(void)
 {
 
 }
+
+__weak void SCM_HSE_ReadyTimeMeasured(uint32_t ready_time_us)
+{
+  UNUSED(ready_time_us);
+}
 /* SCM HSE END */
 /* Private typedef -----------------------------------------------------------*/
 #define PLL_INPUTRANGE0_FREQMAX         8000000u  /* 8 MHz is maximum frequency for VCO input range 0 */
 
 /* Private define ------------------------------------------------------------*/
+/* SCM HSE BEGIN */
+/* The HSE stabilization timer (TIM16) counts on HSI 16 MHz, the system clock until the HSE is ready */
+#define SCM_HSE_TIMER_TICKS_PER_US      (HSI_VALUE / 1000000u)
+#define SCM_HSE_TIMER_TICKS_MAX         (0xFFFFu)
+/* SCM HSE END */
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* SCM HSE BEGIN */
 static uint8_t SW_HSERDY = 0;
+static uint32_t hse_stabilization_ticks = SCM_HSE_STABILIZATION_TIME_DEFAULT * SCM_HSE_TIMER_TICKS_PER_US;
+static uint32_t hse_enable_cycle;
+static uint8_t hse_ready_measure;
 /* SCM HSE END */
 
 RAMCFG_HandleTypeDef sram1_ns =
@@ -88,6 +101,11 @@ static void SwitchPlltoHse32(void);
  * @brief Initialize the timer for HSE stabilization
  */
 static void SCM_HSE_TimerInit(void);
+
+/**
+ * @brief End of the HSE start-up measurement at HSERDY
+ */
+static void SCM_HSE_ReadyMeasureEnd(void);
 /* SCM HSE END */
 
 /* Private functions ---------------------------------------------------------*/
@@ -378,13 +396,22 @@ static void SCM_HSE_TimerInit(void)
 
   TIM_InitStruct.Prescaler = 0;
   TIM_InitStruct.CounterMode = LL_TIM_COUNTERMODE_DOWN;
-  TIM_InitStruct.Autoreload = 3200;
+  TIM_InitStruct.Autoreload = hse_stabilization_ticks;
   TIM_InitStruct.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
   TIM_InitStruct.RepetitionCounter = 0;
   LL_TIM_Init(TIM16, &TIM_InitStruct);
   LL_TIM_DisableARRPreload(TIM16);
   LL_TIM_SetOnePulseMode(TIM16, LL_TIM_ONEPULSEMODE_SINGLE);
 }
+
+OPTIMIZED static void SCM_HSE_ReadyMeasureEnd(void)
+{
+  if (hse_ready_measure != 0U)
+  {
+    hse_ready_measure = 0U;
+    SCM_HSE_ReadyTimeMeasured((DWT->CYCCNT - hse_enable_cycle) / SCM_HSE_TIMER_TICKS_PER_US);
+  }
+}
 /* SCM HSE END */
 
 /* Public functions ----------------------------------------------------------*/
@@ -504,6 +531,10 @@ OPTIMIZED void scm_setup(void)
   LL_RCC_HSE_Enable();
   
   /* SCM HSE BEGIN */
+  /* HSE start-up time measured when HSERDY is awaited below (DWT still counting on HSI 16 MHz) */
+  hse_enable_cycle = DWT->CYCCNT;
+  hse_ready_measure = 0U;
+
   if ((SCM_HSE_Get_SW_HSERDY() != 0) && (RadioState == SCM_RADIO_ACTIVE))
   /* SCM HSE END */
   {
@@ -554,6 +585,10 @@ OPTIMIZED void scm_setup(void)
       /* Disable RCC IRQs */
       HAL_NVIC_DisableIRQ(RCC_IRQn);
       
+      /* SCM HSE BEGIN */
+      hse_ready_measure = ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U) ? 1U : 0U;
+      /* SCM HSE END */
+
       /* Enable HSERDY interrupt */      
       __HAL_RCC_ENABLE_IT(RCC_IT_HSERDY);
 
@@ -986,6 +1021,7 @@ OPTIMIZED void SCM_HSE_WaitUntilReady(void)
       {
         /* Active wait on HSERDY flag */
         while (LL_RCC_HSE_IsReady() == 0);
+        SCM_HSE_ReadyMeasureEnd();
             
         /* Clear the update flag */
         LL_TIM_ClearFlag_UPDATE(TIM16);
@@ -1012,6 +1048,8 @@ OPTIMIZED void SCM_HSE_WaitUntilReady(void)
 
 OPTIMIZED void SCM_HSE_StartStabilizationTimer(void)
 {  
+  SCM_HSE_ReadyMeasureEnd();
+
   if((SCM_HSE_Get_SW_HSERDY() == 0) && (LL_TIM_IsEnabledCounter(TIM16) == 0))
   {   
     /* Clear the update flag */
@@ -1041,6 +1079,36 @@ OPTIMIZED void SCM_HSE_StopStabilizationTimer(void)
   UTILS_EXIT_CRITICAL_SECTION();
 }
 
+void SCM_HSE_SetStabilizationTime(uint32_t time_us)
+{
+  uint32_t ticks = time_us * SCM_HSE_TIMER_TICKS_PER_US;
+
+  if (ticks == 0U)
+  {
+    ticks = 1U;
+  }
+  else if (ticks > SCM_HSE_TIMER_TICKS_MAX)
+  {
+    ticks = SCM_HSE_TIMER_TICKS_MAX;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  hse_stabilization_ticks = ticks;
+  LL_TIM_SetAutoReload(TIM16, ticks);
+
+  /* A stopped down-counter starts from its current value : reloaded at once */
+  if (LL_TIM_IsEnabledCounter(TIM16) == 0)
+  {
+    LL_TIM_SetCounter(TIM16, ticks);
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+uint32_t SCM_HSE_GetStabilizationTime(void)
+{
+  return (hse_stabilization_ticks / SCM_HSE_TIMER_TICKS_PER_US);
+}
+
 OPTIMIZED void SCM_HSE_SW_HSERDY_isr(void)
 {
   /* Set the SW HSERDY flag */
@@ -29,6 +29,12 @@
 #include "stm32wbaxx_ll_rcc.h"
 #include "stm32wbaxx_ll_tim.h"
 
+/* Exported constants --------------------------------------------------------*/
+/* SCM HSE BEGIN */
+/* HSE stabilization delay after HSERDY, in us, until SCM_HSE_SetStabilizationTime() */
+#define SCM_HSE_STABILIZATION_TIME_DEFAULT    (200u)
+/* SCM HSE END */
+
 /* Exported types ------------------------------------------------------------*/
 typedef enum {
   NO_CLOCK_CONFIG = 0,
@@ -234,6 +240,24 @@ void SCM_HSE_StopStabilizationTimer(void);
  * @brief HSE stabilization timer interrupt handler
  */
 void SCM_HSE_SW_HSERDY_isr(void);
+
+/**
+ * @brief Set the HSE stabilization delay after HSERDY (SCM_HSE_STABILIZATION_TIME_DEFAULT at init)
+ * @param time_us Delay in us
+ */
+void SCM_HSE_SetStabilizationTime(uint32_t time_us);
+
+/**
+ * @brief Get the HSE stabilization delay after HSERDY in us
+ */
+uint32_t SCM_HSE_GetStabilizationTime(void);
+
+/**
+ * @brief HSE start-up time (enable to HSERDY) measured at the exit of a low power mode.
+ *        Called under interrupt, weak : to be implemented by the user
+ * @param ready_time_us Start-up time in us
+ */
+void SCM_HSE_ReadyTimeMeasured(uint32_t ready_time_us);
 /* SCM HSE END */
 
 /* Exported functions - To be implemented by the user ------------------------- */
@@ -22,8 +22,31 @@
  ******************************************************************************/
 
 
+#include "app_conf.h"
 #include "stm_list.h"
 
+#ifndef CFG_LST_DEBUG_SUPPORTED
+#define CFG_LST_DEBUG_SUPPORTED   (0)
+#endif /* CFG_LST_DEBUG_SUPPORTED */
+
+/******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+#if (CFG_LST_DEBUG_SUPPORTED != 0)
+/* Links of the node consistent with its neighbours, to be called with the interrupts disabled */
+static uint8_t LST_cnt_node_valid (tListCounted * list, tListNode * node)
+{
+  if ((node == NULL) || (node->next == NULL) || (node->prev == NULL) ||
+      ((node->next)->prev != node) || ((node->prev)->next != node))
+  {
+    list->errors++;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+#endif /* (CFG_LST_DEBUG_SUPPORTED != 0) */
+
 /******************************************************************************
  * Function Definitions
  ******************************************************************************/
@@ -197,3 +220,147 @@ void LST_get_prev_node (tListNode * ref_node, tListNode ** node)
   __set_PRIMASK(primask_bit);      /**< Restore PRIMASK bit*/
 }
 
+void LST_cnt_init (tListCounted * list)
+{
+  LST_init_head (&list->head);
+  list->size = 0;
+  list->max_size = 0;
+  list->errors = 0;
+}
+
+uint8_t LST_cnt_is_empty (tListCounted * list)
+{
+  return ((list->size == 0u) ? TRUE : FALSE);
+}
+
+void LST_cnt_insert_head (tListCounted * list, tListNode * node)
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  LST_insert_head (&list->head, node);
+  list->size++;
+  if (list->size > list->max_size)
+  {
+    list->max_size = list->size;
+  }
+#if (CFG_LST_DEBUG_SUPPORTED != 0)
+  (void)LST_cnt_node_valid (list, node);
+#endif /* (CFG_LST_DEBUG_SUPPORTED != 0) */
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+}
+
+void LST_cnt_insert_tail (tListCounted * list, tListNode * node)
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  LST_insert_tail (&list->head, node);
+  list->size++;
+  if (list->size > list->max_size)
+  {
+    list->max_size = list->size;
+  }
+#if (CFG_LST_DEBUG_SUPPORTED != 0)
+  (void)LST_cnt_node_valid (list, node);
+#endif /* (CFG_LST_DEBUG_SUPPORTED != 0) */
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+}
+
+void LST_cnt_remove_node (tListCounted * list, tListNode * node)
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+#if (CFG_LST_DEBUG_SUPPORTED != 0)
+  /* The head, or a node not linked, is left as is */
+  if ((node != &list->head) && (list->size != 0u) && (LST_cnt_node_valid (list, node) != FALSE))
+#endif /* (CFG_LST_DEBUG_SUPPORTED != 0) */
+  {
+    LST_remove_node (node);
+    list->size--;
+  }
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+}
+
+void LST_cnt_remove_head (tListCounted * list, tListNode ** node )
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  *node = list->head.next;
+  LST_cnt_remove_node (list, list->head.next);
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+}
+
+void LST_cnt_remove_tail (tListCounted * list, tListNode ** node )
+{
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  *node = list->head.prev;
+  LST_cnt_remove_node (list, list->head.prev);
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+}
+
+uint16_t LST_cnt_get_size (tListCounted * list)
+{
+  return (list->size);
+}
+
+uint16_t LST_cnt_get_max_size (tListCounted * list)
+{
+  return (list->max_size);
+}
+
+uint8_t LST_cnt_check (tListCounted * list)
+{
+  uint8_t return_value = TRUE;
+  uint16_t size = 0;
+  tListNode * temp;
+  uint32_t primask_bit;
+
+  primask_bit = __get_PRIMASK();  /**< backup PRIMASK bit */
+  __disable_irq();                  /**< Disable all interrupts by setting PRIMASK bit on Cortex*/
+
+  /* Walk of the list, stopped after size nodes so that a loop not closing on the head ends */
+  temp = &list->head;
+  do
+  {
+    if ((temp->next == NULL) || ((temp->next)->prev != temp) || (size > list->size))
+    {
+      return_value = FALSE;
+      break;
+    }
+    temp = temp->next;
+    size++;
+  } while (temp != &list->head);
+
+  if ((return_value != FALSE) && ((size - 1u) != list->size))
+  {
+    return_value = FALSE;
+  }
+  if (return_value == FALSE)
+  {
+    list->errors++;
+  }
+
+  __set_PRIMASK(primask_bit);     /**< Restore PRIMASK bit*/
+
+  return return_value;
+}
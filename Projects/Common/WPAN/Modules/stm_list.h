@@ -27,6 +27,16 @@ typedef __PACKED_STRUCT _tListNode {
     struct _tListNode * prev;
 } tListNode;
 
+/* List head keeping its number of nodes : the size is read in O(1), without walking the list.
+ * The nodes are the same tListNode, only the head grows. The fields are kept by the LST_cnt_ functions,
+ * the list must not be changed with the other ones. */
+typedef struct _tListCounted {
+    tListNode head;
+    uint16_t  size;        /* Nodes in the list */
+    uint16_t  max_size;    /* Highest size since LST_cnt_init */
+    uint32_t  errors;      /* Broken links found by LST_cnt_check, and by each operation with CFG_LST_DEBUG_SUPPORTED */
+} tListCounted;
+
 void LST_init_head (tListNode * listHead);
 
 uint8_t LST_is_empty (tListNode * listHead);
@@ -51,4 +61,24 @@ void LST_get_next_node (tListNode * ref_node, tListNode ** node);
 
 void LST_get_prev_node (tListNode * ref_node, tListNode ** node);
 
+void LST_cnt_init (tListCounted * list);
+
+uint8_t LST_cnt_is_empty (tListCounted * list);
+
+void LST_cnt_insert_head (tListCounted * list, tListNode * node);
+
+void LST_cnt_insert_tail (tListCounted * list, tListNode * node);
+
+void LST_cnt_remove_node (tListCounted * list, tListNode * node);
+
+void LST_cnt_remove_head (tListCounted * list, tListNode ** node );
+
+void LST_cnt_remove_tail (tListCounted * list, tListNode ** node );
+
+uint16_t LST_cnt_get_size (tListCounted * list);
+
+uint16_t LST_cnt_get_max_size (tListCounted * list);
+
+uint8_t LST_cnt_check (tListCounted * list);
+
 #endif /* STM_LIST_H */
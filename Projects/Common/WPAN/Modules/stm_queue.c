@@ -382,3 +382,103 @@ int CircularQueue_NbElement(queue_t *q)
 {
   return q->elementCount;
 }
+
+/**
+  * @brief   Initialize a single producer / single consumer queue.
+  * @note    The producer (an interrupt for instance) fills the slots in place with CircularQueue_SpscReserve() and
+  *          CircularQueue_SpscCommit(), the consumer (a task) reads them in place with CircularQueue_SpscSense() and
+  *          CircularQueue_SpscRelease() : no copy and no critical section, as each side only writes its own index.
+  * @param  q: pointer on queue structure to be initialised
+  * @param  queueBuffer: pointer on the slots buffer, slotCount * slotSize bytes
+  * @param  slotCount: number of slots, a power of 2
+  * @param  slotSize: size of a slot in bytes
+  * @retval   0, -1 if slotCount is not a power of 2
+  */
+int CircularQueue_SpscInit(spsc_queue_t *q, uint8_t* queueBuffer, uint32_t slotCount, uint32_t slotSize)
+{
+  if ((slotCount == 0) || ((slotCount & (slotCount - 1)) != 0))
+  {
+    return -1;
+  }
+
+  q->qBuff = queueBuffer;
+  q->slotSize = slotSize;
+  q->mask = slotCount - 1;
+  q->head = 0;
+  q->tail = 0;
+
+  return 0;
+}
+
+/**
+  * @brief   Reserve the next free slot (producer side).
+  * @note    The slot is filled in place, then published with CircularQueue_SpscCommit(). Calling it again before
+  *          the commit returns the same slot.
+  * @param  q: pointer on queue structure to be handled
+  * @retval  Pointer on the free slot, NULL if the queue is full
+  */
+uint8_t* CircularQueue_SpscReserve(spsc_queue_t *q)
+{
+  uint32_t head = q->head;
+
+  if ((head - q->tail) > q->mask)
+  {
+    return NULL;
+  }
+
+  return q->qBuff + ((head & q->mask) * q->slotSize);
+}
+
+/**
+  * @brief   Publish the reserved slot to the consumer (producer side).
+  * @param  q: pointer on queue structure to be handled
+  * @retval  None
+  */
+void CircularQueue_SpscCommit(spsc_queue_t *q)
+{
+  /* The content of the slot is written before the index that publishes it */
+  __DMB();
+  q->head = q->head + 1;
+}
+
+/**
+  * @brief   Get the oldest slot, without removing it (consumer side).
+  * @param  q: pointer on queue structure to be handled
+  * @retval  Pointer on the slot, NULL if the queue is empty
+  */
+uint8_t* CircularQueue_SpscSense(spsc_queue_t *q)
+{
+  uint32_t tail = q->tail;
+
+  if (q->head == tail)
+  {
+    return NULL;
+  }
+
+  /* The index is read before the content of the slot */
+  __DMB();
+
+  return q->qBuff + ((tail & q->mask) * q->slotSize);
+}
+
+/**
+  * @brief   Give the sensed slot back to the producer (consumer side).
+  * @param  q: pointer on queue structure to be handled
+  * @retval  None
+  */
+void CircularQueue_SpscRelease(spsc_queue_t *q)
+{
+  /* The content of the slot is read before the index that frees it */
+  __DMB();
+  q->tail = q->tail + 1;
+}
+
+/**
+  * @brief   Number of slots committed and not released yet.
+  * @param  q: pointer on queue structure to be handled
+  * @retval  Number of elements
+  */
+uint32_t CircularQueue_SpscNbElement(spsc_queue_t *q)
+{
+  return q->head - q->tail;
+}
@@ -43,6 +43,16 @@ typedef struct {
    uint8_t  optionFlags;     /* option to enable specific features */
 } queue_t;
 
+/* Single producer / single consumer queue of fixed size slots, without lock :
+   the producer only writes head, the consumer only writes tail */
+typedef struct {
+   uint8_t* qBuff;              /* slots buffer (slotCount * slotSize bytes), provided by init fct */
+   uint32_t slotSize;           /* size of a slot in bytes */
+   uint32_t mask;               /* slotCount - 1, slotCount being a power of 2 */
+   volatile uint32_t head;      /* slots committed by the producer, free running */
+   volatile uint32_t tail;      /* slots released by the consumer, free running */
+} spsc_queue_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 /* Exported macro ------------------------------------------------------------*/
@@ -55,6 +65,12 @@ int CircularQueue_Empty(queue_t *q);
 int CircularQueue_NbElement(queue_t *q);
 uint8_t* CircularQueue_Remove_Copy(queue_t *q, uint16_t* elementSize, uint8_t* buffer);
 uint8_t* CircularQueue_Sense_Copy(queue_t *q, uint16_t* elementSize, uint8_t* buffer);
+int CircularQueue_SpscInit(spsc_queue_t *q, uint8_t* queueBuffer, uint32_t slotCount, uint32_t slotSize);
+uint8_t* CircularQueue_SpscReserve(spsc_queue_t *q);
+void CircularQueue_SpscCommit(spsc_queue_t *q);
+uint8_t* CircularQueue_SpscSense(spsc_queue_t *q);
+void CircularQueue_SpscRelease(spsc_queue_t *q);
+uint32_t CircularQueue_SpscNbElement(spsc_queue_t *q);
 
 /******************* (C) COPYRIGHT 2010 STMicroelectronics *****END OF FILE****/
 #endif /* __STM_QUEUE_H */
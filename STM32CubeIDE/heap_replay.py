@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    heap_replay.py
+  * @author  MCD Application Team
+  * @brief   Recording of the Zigbee heap calls (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED)
+  *          and their replay on the allocators of the device (host build)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 heap_replay.py record <serial port> <trace file>
+      python3 heap_replay.py replay <trace file> [pool bytes] [slab 16,32,64,128 counts]
+
+  record : HEAPRECSTART is sent with the host protocol, the records of the APP_HOST_EVENT_HEAP_TRACE events are
+  written in the trace file until Ctrl-C, then HEAPRECSTOP. The events lost are reported (gaps in the sequences).
+
+  replay : the trace is summarized, then replayed by host/build/heap_replay (built here with make if needed) on
+  the allocation path of zigbee_plat.c : the fixed-size pools first (counts of CFG_ZIGBEE_SLAB_xx_NBR, '0,0,0,0'
+  for none) then advanced_memory_manager.c on its basic memory manager, stm32_mm.c (CFG_AMM_BMM_TLSF_SUPPORTED 0)
+  and stm32_tlsf.c (CFG_AMM_BMM_TLSF_SUPPORTED 1), compiled from their sources. For each one : failed allocations
+  for the pool size (CFG_MM_POOL_SIZE), peak use, fragmentation at the peak and smallest pool without failure.
+  The allocator headers are the ones of the device with the 32-bit host build (make -C host M32=1).
+"""
+
+import os
+import struct
+import subprocess
+import sys
+import time
+
+RECORD = struct.Struct("<IIHBB")        # Time (us), address, size, heap, event
+ALLOC, FREE, FAILED = 0, 1, 2
+HEAPS = ["ZbHeap", "Heap"]
+
+EVENT_HEAP_TRACE = 0xC1
+HOST_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "host")
+HEAP_REPLAY = os.path.join(HOST_DIR, "build", "heap_replay")
+
+
+def record(port, path):
+    from host_protocol import Link, CMD_TEXT
+
+    link = Link(port)
+    expected = None
+    lost = 0
+    count = 0
+    link.send(CMD_TEXT, b"HEAPRECSTART")
+    with open(path, "wb") as output:
+        def collect():
+            nonlocal expected, lost, count
+            for kind, sequence, data in link.frames():
+                if kind != EVENT_HEAP_TRACE:
+                    continue
+                if expected is not None and sequence != expected:
+                    lost += (sequence - expected) & 0xFF
+                expected = (sequence + 1) & 0xFF
+                output.write(data)
+                count += len(data) // RECORD.size
+        try:
+            while True:
+                collect()
+        except KeyboardInterrupt:
+            pass
+        link.send(CMD_TEXT, b"HEAPRECSTOP")
+        end = time.monotonic() + 1.0
+        while time.monotonic() < end:
+            collect()
+    print("%d records, %d events lost" % (count, lost))
+
+
+def load(path):
+    with open(path, "rb") as trace:
+        data = trace.read()
+    return [RECORD.unpack_from(data, offset) for offset in range(0, len(data) - RECORD.size + 1, RECORD.size)]
+
+
+def main(argv):
+    if len(argv) >= 4 and argv[1] == "record":
+        record(argv[2], argv[3])
+        return 0
+    if len(argv) < 3 or argv[1] != "replay":
+        print(__doc__.split("Usage:")[1].split("record :")[0])
+        return 1
+
+    records = load(argv[2])
+    allocs = [item for item in records if item[4] != FREE]
+    print("%d records over %.1f s, %d allocations (%d failed on the device)" % (
+        len(records), ((records[-1][0] - records[0][0]) & 0xFFFFFFFF) / 1e6 if records else 0.0,
+        len(allocs), sum(1 for item in records if item[4] == FAILED)))
+    for heap, name in enumerate(HEAPS):
+        sizes = sorted(item[2] for item in allocs if item[3] == heap)
+        if sizes:
+            print("  %s : %d allocations, sizes min %d, median %d, max %d" % (
+                name, len(sizes), sizes[0], sizes[len(sizes) // 2], sizes[-1]))
+    sys.stdout.flush()
+
+    subprocess.run(["make", "-s", "-C", HOST_DIR, "build/heap_replay"], check=True)
+    return subprocess.run([HEAP_REPLAY] + argv[2:5]).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    app_conf.h
+  * @author  MCD Application Team
+  * @brief   Host build : the part of Core/Inc/app_conf.h used by the
+  *          utilities, same values.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CONF_H
+#define APP_CONF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "utilities_conf.h"
+
+/******************************************************************************
+ * Sequencer
+ ******************************************************************************/
+#define CFG_SEQ_PRIO_NBR                    (4)
+#define CFG_SEQ_PROFILING_SUPPORTED         (0)
+#define CFG_SEQ_DELAYED_TASK_NBR            (2)
+#define CFG_SEQ_MSG_QUEUE_SUPPORTED         (0)
+#define CFG_SEQ_TASK_BUDGET_SUPPORTED       (0)
+#define CFG_SEQ_DEFERRABLE_SUPPORTED        (1)       /* As with the low power modes */
+#define CFG_SEQ_DEFER_MAX_DELAY             (2000u)   /* ms */
+#define CFG_SEQ_DEADLINE_SUPPORTED          (1)
+
+/******************************************************************************
+ * Timer server
+ ******************************************************************************/
+#define CFG_TIMER_STATS_SUPPORTED           (0)
+
+/******************************************************************************
+ * Memory
+ ******************************************************************************/
+#define CFG_MM_POOL_SIZE                                  (54000U)  /* bytes */
+#define CFG_AMM_VIRTUAL_MEMORY_NUMBER                     (2U)
+#define CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT                 (1U)
+#define CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT_BUFFER_SIZE     (10500U)  /* words (32 bits) */
+#define CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP                 (2U)
+#define CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP_BUFFER_SIZE     (3000U)   /* words (32 bits) */
+#define CFG_ZIGBEE_SLAB_16_NBR                            (32U)     /* Default pools of heap_replay */
+#define CFG_ZIGBEE_SLAB_32_NBR                            (24U)
+#define CFG_ZIGBEE_SLAB_64_NBR                            (16U)
+#define CFG_ZIGBEE_SLAB_128_NBR                           (8U)
+
+#endif /* APP_CONF_H */
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_compiler.h
+  * @author  MCD Application Team
+  * @brief   Host build : the CMSIS compiler macros and core intrinsics used by
+  *          the utilities, the interrupt mask mocked by host_plat.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_CMSIS_COMPILER_H
+#define HOST_CMSIS_COMPILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported macros -----------------------------------------------------------*/
+#define __ASM                     __asm
+#define __INLINE                  inline
+#define __STATIC_INLINE           static inline
+#define __STATIC_FORCEINLINE      __attribute__((always_inline)) static inline
+#define __WEAK                    __attribute__((weak))
+#define __USED                    __attribute__((used))
+#define __NO_RETURN               __attribute__((__noreturn__))
+#define __PACKED                  __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT           struct __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)              __attribute__((aligned(x)))
+#define __RESTRICT                __restrict
+
+/* Exported functions ------------------------------------------------------- */
+/* Interrupt mask : one thread on the host, only the nesting is checked (host_plat.c) */
+uint32_t  HOST_PLAT_GetPrimask    ( void );
+void      HOST_PLAT_SetPrimask    ( uint32_t lPrimask );
+
+__STATIC_INLINE uint32_t __get_PRIMASK( void )
+{
+  return HOST_PLAT_GetPrimask();
+}
+
+__STATIC_INLINE void __set_PRIMASK( uint32_t lPrimask )
+{
+  HOST_PLAT_SetPrimask( lPrimask );
+}
+
+__STATIC_INLINE void __disable_irq( void )
+{
+  HOST_PLAT_SetPrimask( 1u );
+}
+
+__STATIC_INLINE void __enable_irq( void )
+{
+  HOST_PLAT_SetPrimask( 0u );
+}
+
+__STATIC_INLINE uint8_t __CLZ( uint32_t lValue )
+{
+  return ( ( lValue == 0u ) ? 32u : (uint8_t)__builtin_clz( lValue ) );
+}
+
+#define __DMB()                   __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define __DSB()                   __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define __ISB()                   __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define __NOP()                   do { } while ( 0 )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_CMSIS_COMPILER_H */
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file    utilities_conf.h
+  * @author  MCD Application Team
+  * @brief   Host build : configuration of the utilities, as Core/Inc/utilities_conf.h
+  *          with the critical sections and the time bases of host_plat.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef UTILITIES_CONF_H
+#define UTILITIES_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "cmsis_compiler.h"
+#include "app_conf.h"
+#include "host_plat.h"
+
+/* Exported macros -----------------------------------------------------------*/
+#define UTIL_PLACE_IN_SECTION( __x__ )
+
+#undef ALIGN
+#define ALIGN(n)                                __attribute__((aligned(n)))
+
+/**
+  * @brief Critical sections : same macros as on the device, on the interrupt mask of host_plat.c
+  */
+#define UTILS_INIT_CRITICAL_SECTION()
+#define UTILS_ENTER_CRITICAL_SECTION()          uint32_t primask_bit= __get_PRIMASK();\
+  __disable_irq()
+#define UTILS_EXIT_CRITICAL_SECTION()           __set_PRIMASK(primask_bit)
+
+/**
+  * @brief Sequencer : 64 tasks (64 bits task mapping, as the 48 tasks of the device), dispatch benchmark up to them
+  */
+#define UTIL_SEQ_CONF_TASK_NBR                  (64)
+#define UTIL_SEQ_CONF_PRIO_NBR                  CFG_SEQ_PRIO_NBR
+#define UTIL_SEQ_INIT_CRITICAL_SECTION( )       UTILS_INIT_CRITICAL_SECTION()
+#define UTIL_SEQ_ENTER_CRITICAL_SECTION( )      UTILS_ENTER_CRITICAL_SECTION()
+#define UTIL_SEQ_EXIT_CRITICAL_SECTION( )       UTILS_EXIT_CRITICAL_SECTION()
+#define UTIL_SEQ_MEMSET8( dest, value, size )   memset( dest, value, size )
+#define UTIL_SEQ_CONF_PROFILING                 CFG_SEQ_PROFILING_SUPPORTED
+#define UTIL_SEQ_CONF_TASK_BUDGET               CFG_SEQ_TASK_BUDGET_SUPPORTED
+#define UTIL_SEQ_PROFILING_INIT( )
+#define UTIL_SEQ_PROFILING_GET_TIME( )          HOST_PLAT_GetTimeUs( )
+#define UTIL_SEQ_CONF_DELAYED_TASK_NBR          CFG_SEQ_DELAYED_TASK_NBR
+#define UTIL_SEQ_CONF_MSG_QUEUE                 CFG_SEQ_MSG_QUEUE_SUPPORTED
+#define UTIL_SEQ_MSG_BARRIER( )                 __DMB()
+#define UTIL_SEQ_CONF_DEFERRABLE                CFG_SEQ_DEFERRABLE_SUPPORTED
+#define UTIL_SEQ_CONF_DEFER_MAX_MS              CFG_SEQ_DEFER_MAX_DELAY
+#define UTIL_SEQ_CONF_DEADLINE                  CFG_SEQ_DEADLINE_SUPPORTED
+#define UTIL_SEQ_DEADLINE_GET_TIME( )           HOST_PLAT_GetTimeUs( )
+
+/**
+  * @brief Advanced memory manager
+  */
+#define AMM_CONF_VIRTUAL_ID_MAX                 CFG_AMM_VIRTUAL_MEMORY_NUMBER
+
+/**
+  * @brief Timer server : same capacity as on the device, a timer above it stops the benchmark
+  */
+#define UTIL_TIMER_INIT_CRITICAL_SECTION( )     UTILS_INIT_CRITICAL_SECTION()
+#define UTIL_TIMER_CONF_MAX_TIMER_NBR           (56U)
+#define UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ      (4U)
+#define UTIL_TIMER_CONF_STATS                   CFG_TIMER_STATS_SUPPORTED
+#define UTIL_TIMER_CAPACITY_ERROR( _CALLBACK_ ) HOST_PLAT_Fatal( "timer server full" )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTILITIES_CONF_H */
@@ -0,0 +1,432 @@
+/**
+  ******************************************************************************
+  * @file    heap_replay.c
+  * @author  MCD Application Team
+  * @brief   Host replay of the Zigbee heap calls recorded on the device
+  *          (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED, heap_replay.py record) through
+  *          the allocation path of zigbee_plat.c : the fixed-size pools, then
+  *          the AMM of the device on stm32_mm and on stm32_tlsf, built from
+  *          their sources. Results in CSV on the standard output.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_conf.h"
+#include "host_plat.h"
+#include "advanced_memory_manager.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HEAP_REPLAY_RECORD_SIZE         (12u)       /* ZigbeeHeapRecord_t of zigbee_plat.c */
+#define HEAP_REPLAY_ALLOC               (0u)        /* ZIGBEE_HEAP_RECORD_ALLOC */
+#define HEAP_REPLAY_FREE                (1u)        /* ZIGBEE_HEAP_RECORD_FREE */
+#define HEAP_REPLAY_FAILED              (2u)        /* ZIGBEE_HEAP_RECORD_FAILED */
+#define HEAP_REPLAY_HEAP_NBR            (2u)        /* ZbHeap (ZIGBEE_INIT), Heap (ZIGBEE_HEAP) */
+
+#define HEAP_REPLAY_SLAB_CLASS_NBR      (4u)
+#define HEAP_REPLAY_NO_SLAB             (0xFFu)
+
+#define HEAP_REPLAY_SEARCH_MAX          (1u << 20)  /* bytes, largest pool tried */
+#define HEAP_REPLAY_SEARCH_STEP         (64u)       /* bytes, precision of the smallest pool */
+
+/* Private typedef -----------------------------------------------------------*/
+/* One call of a Zigbee heap as recorded on the device */
+typedef struct
+{
+  uint32_t    lAddress;
+  uint16_t    iSize;
+  uint8_t     cHeap;
+  uint8_t     cEvent;
+} HeapReplayRecord_t;
+
+/* Buffer allocated on the device and its copy on the host */
+typedef struct
+{
+  uint32_t    lAddress;       /* Address on the device */
+  uint32_t *  pBuffer;        /* AMM buffer on the host, NULL for a pool block */
+  uint8_t     cSlab;          /* Pool of the block, HEAP_REPLAY_NO_SLAB for an AMM buffer */
+} HeapReplayLive_t;
+
+/* Result of one replay */
+typedef struct
+{
+  uint32_t    lFailures;
+  uint32_t    lPeakSize;      /* Highest AMM occupation, headers included (bytes) */
+  uint32_t    lPeakFreeSize;  /* Free words of the pool at the peak */
+  uint32_t    lPeakLargest;   /* Largest free block at the peak (words) */
+} HeapReplayResult_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static bool     HeapReplayLoad              ( const char * szPath );
+static bool     HeapReplayParseSlabs        ( const char * szCounts, uint16_t * piCounts );
+static bool     HeapReplayRun               ( HOST_PLAT_Bmm_t eBmm, uint32_t lPoolSize, const uint16_t * piSlabCounts,
+                                              HeapReplayResult_t * pstResult );
+static uint32_t HeapReplaySmallestPool      ( HOST_PLAT_Bmm_t eBmm, const uint16_t * piSlabCounts );
+static uint8_t  HeapReplaySlabAlloc         ( uint32_t lSize, uint16_t * piSlabFree );
+static HeapReplayLive_t * HeapReplayFind    ( uint32_t lAddress );
+
+/* Private variables ---------------------------------------------------------*/
+/* Block sizes of the pools of zigbee_plat.c, default counts of CFG_ZIGBEE_SLAB_xx_NBR */
+static const uint16_t             aiHeapReplaySlabSize[HEAP_REPLAY_SLAB_CLASS_NBR] = { 16u, 32u, 64u, 128u };
+static const uint16_t             aiHeapReplaySlabNbr[HEAP_REPLAY_SLAB_CLASS_NBR] =
+{
+  CFG_ZIGBEE_SLAB_16_NBR, CFG_ZIGBEE_SLAB_32_NBR, CFG_ZIGBEE_SLAB_64_NBR, CFG_ZIGBEE_SLAB_128_NBR
+};
+
+/* AMM virtual memory of each Zigbee heap and its reservation in the pool of the device */
+static const uint8_t              acHeapReplayVmId[HEAP_REPLAY_HEAP_NBR] =
+{
+  CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP
+};
+static const uint32_t             alHeapReplayVmSize[HEAP_REPLAY_HEAP_NBR] =
+{
+  CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT_BUFFER_SIZE, CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP_BUFFER_SIZE
+};
+
+static HeapReplayRecord_t *       pstHeapReplayRecords;
+static uint32_t                   lHeapReplayRecordNbr;
+
+static HeapReplayLive_t *         pstHeapReplayLive;          /* Buffers allocated, in no order */
+static uint32_t                   lHeapReplayLiveNbr;
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  heap_replay <trace file> [pool bytes] [pools 16,32,64,128 counts] : replay of the trace with the pools
+ *         given then without pools, on stm32_mm and on stm32_tlsf.
+ */
+int main( int argc, char * argv[] )
+{
+  static const struct
+  {
+    HOST_PLAT_Bmm_t   eBmm;
+    const char *      szName;
+  } astBmm[] = { { HOST_PLAT_BMM_MM, "stm32_mm" }, { HOST_PLAT_BMM_TLSF, "stm32_tlsf" } };
+  uint16_t            aiSlabCounts[2][HEAP_REPLAY_SLAB_CLASS_NBR] = { { 0u }, { 0u } };
+  HeapReplayResult_t  stResult;
+  uint32_t            lPoolSize = CFG_MM_POOL_SIZE;
+  uint32_t            lBmm, lSlabs, lSmallest, lFree;
+
+  memcpy( aiSlabCounts[0], aiHeapReplaySlabNbr, sizeof( aiHeapReplaySlabNbr ) );
+
+  if ( ( argc < 2 ) || ( argc > 4 )
+    || ( ( argc > 2 ) && ( ( lPoolSize = (uint32_t)strtoul( argv[2], NULL, 0 ) ) == 0u ) )
+    || ( ( argc > 3 ) && ( HeapReplayParseSlabs( argv[3], aiSlabCounts[0] ) == false ) ) )
+  {
+    fprintf( stderr, "usage : %s <trace file> [pool bytes] [pools 16,32,64,128 counts]\n", argv[0] );
+    return 1;
+  }
+
+  if ( HeapReplayLoad( argv[1] ) == false )
+  {
+    return 1;
+  }
+
+  printf( "allocator,pool_bytes,slabs,failures,peak_bytes,peak_fragmentation,smallest_pool_bytes\n" );
+  for ( lBmm = 0; lBmm < ( sizeof( astBmm ) / sizeof( astBmm[0] ) ); lBmm++ )
+  {
+    for ( lSlabs = 0; lSlabs < 2u; lSlabs++ )
+    {
+      if ( HeapReplayRun( astBmm[lBmm].eBmm, lPoolSize, aiSlabCounts[lSlabs], &stResult ) == false )
+      {
+        HOST_PLAT_Fatal( "pool too small for the AMM configuration" );
+      }
+      lSmallest = HeapReplaySmallestPool( astBmm[lBmm].eBmm, aiSlabCounts[lSlabs] );
+      lFree = MAX( stResult.lPeakFreeSize, 1u );
+
+      printf( "%s,%u,%u/%u/%u/%u,%u,%u,%.2f,", astBmm[lBmm].szName, lPoolSize, aiSlabCounts[lSlabs][0],
+              aiSlabCounts[lSlabs][1], aiSlabCounts[lSlabs][2], aiSlabCounts[lSlabs][3], stResult.lFailures,
+              stResult.lPeakSize, ( 1.0 - ( (double)MIN( stResult.lPeakLargest, lFree ) / lFree ) ) );
+      if ( lSmallest != 0u )
+      {
+        printf( "%u\n", lSmallest );
+      }
+      else
+      {
+        printf( ">%u\n", HEAP_REPLAY_SEARCH_MAX );
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief  Read the records of the trace file (little endian, as written by heap_replay.py record).
+ */
+static bool HeapReplayLoad( const char * szPath )
+{
+  FILE      * pFile;
+  uint8_t   acRecord[HEAP_REPLAY_RECORD_SIZE];
+  uint32_t  lAllocated = 0;
+
+  pFile = fopen( szPath, "rb" );
+  if ( pFile == NULL )
+  {
+    perror( szPath );
+    return false;
+  }
+
+  while ( fread( acRecord, sizeof( acRecord ), 1u, pFile ) == 1u )
+  {
+    if ( lHeapReplayRecordNbr == lAllocated )
+    {
+      lAllocated = MAX( 1024u, ( lAllocated * 2u ) );
+      pstHeapReplayRecords = realloc( pstHeapReplayRecords, ( lAllocated * sizeof( HeapReplayRecord_t ) ) );
+      if ( pstHeapReplayRecords == NULL )
+      {
+        HOST_PLAT_Fatal( "no memory for the trace" );
+      }
+    }
+
+    /* Time (4 bytes, not used), address (4), size (2), heap (1), event (1) */
+    pstHeapReplayRecords[lHeapReplayRecordNbr].lAddress = (uint32_t)acRecord[4] | ( (uint32_t)acRecord[5] << 8 )
+                                                        | ( (uint32_t)acRecord[6] << 16 ) | ( (uint32_t)acRecord[7] << 24 );
+    pstHeapReplayRecords[lHeapReplayRecordNbr].iSize = (uint16_t)( acRecord[8] | ( acRecord[9] << 8 ) );
+    pstHeapReplayRecords[lHeapReplayRecordNbr].cHeap = acRecord[10];
+    pstHeapReplayRecords[lHeapReplayRecordNbr].cEvent = acRecord[11];
+    lHeapReplayRecordNbr++;
+  }
+  fclose( pFile );
+
+  /* At most one buffer alive per record */
+  pstHeapReplayLive = malloc( ( MAX( lHeapReplayRecordNbr, 1u ) * sizeof( HeapReplayLive_t ) ) );
+  if ( pstHeapReplayLive == NULL )
+  {
+    HOST_PLAT_Fatal( "no memory for the trace" );
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Counts of the pools "n16,n32,n64,n128".
+ */
+static bool HeapReplayParseSlabs( const char * szCounts, uint16_t * piCounts )
+{
+  char      * szEnd;
+  uint32_t  lIndex;
+
+  for ( lIndex = 0; lIndex < HEAP_REPLAY_SLAB_CLASS_NBR; lIndex++ )
+  {
+    piCounts[lIndex] = (uint16_t)strtoul( szCounts, &szEnd, 0 );
+    if ( ( szEnd == szCounts ) || ( *szEnd != ( ( lIndex < ( HEAP_REPLAY_SLAB_CLASS_NBR - 1u ) ) ? ',' : '\0' ) ) )
+    {
+      return false;
+    }
+    szCounts = szEnd + 1;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Replay of the trace with a pool of lPoolSize bytes (CFG_MM_POOL_SIZE). The reservations of the virtual
+ *         memories keep their share of the pool of the device. The allocations failed on the device are skipped,
+ *         as the releases of buffers not allocated in the replay.
+ * @retval false if the AMM does not accept this pool size.
+ */
+static bool HeapReplayRun( HOST_PLAT_Bmm_t eBmm, uint32_t lPoolSize, const uint16_t * piSlabCounts,
+                           HeapReplayResult_t * pstResult )
+{
+  AMM_VirtualMemoryConfig_t   astVmConfig[HEAP_REPLAY_HEAP_NBR];
+  AMM_InitParameters_t        stInit;
+  AMM_VirtualMemoryStats_t    stAmmStats;
+  const HeapReplayRecord_t    * pstRecord;
+  HeapReplayLive_t            * pstLive;
+  uint16_t                    aiSlabFree[HEAP_REPLAY_SLAB_CLASS_NBR];
+  uint32_t                    lPoolWords = DIVC( lPoolSize, sizeof( uint32_t ) );
+  uint32_t                    lIndex, lHeap, lOccupied, lLargest;
+  uint32_t                    * pBuffer;
+  uint8_t                     cSlab;
+
+  for ( lHeap = 0; lHeap < HEAP_REPLAY_HEAP_NBR; lHeap++ )
+  {
+    astVmConfig[lHeap].Id = acHeapReplayVmId[lHeap];
+    astVmConfig[lHeap].BufferSize = MAX( 1u, (uint32_t)( ( (uint64_t)alHeapReplayVmSize[lHeap] * lPoolWords )
+                                                         / DIVC( CFG_MM_POOL_SIZE, sizeof( uint32_t ) ) ) );
+  }
+
+  stInit.PoolSize = lPoolWords + ( AMM_VIRTUAL_INFO_ELEMENT_SIZE * HEAP_REPLAY_HEAP_NBR );
+  stInit.p_PoolAddr = malloc( stInit.PoolSize * sizeof( uint32_t ) );
+  stInit.VirtualMemoryNumber = HEAP_REPLAY_HEAP_NBR;
+  stInit.p_VirtualMemoryConfigList = astVmConfig;
+  if ( stInit.p_PoolAddr == NULL )
+  {
+    HOST_PLAT_Fatal( "no memory for the pool" );
+  }
+
+  HOST_PLAT_SetBmm( eBmm );
+  if ( AMM_Init( &stInit ) != AMM_ERROR_OK )
+  {
+    free( stInit.p_PoolAddr );
+    return false;
+  }
+
+  memcpy( aiSlabFree, piSlabCounts, sizeof( aiSlabFree ) );
+  memset( pstResult, 0, sizeof( *pstResult ) );
+  lHeapReplayLiveNbr = 0;
+
+  for ( lIndex = 0; lIndex < lHeapReplayRecordNbr; lIndex++ )
+  {
+    pstRecord = &pstHeapReplayRecords[lIndex];
+    if ( ( pstRecord->cEvent == HEAP_REPLAY_FAILED ) || ( pstRecord->cHeap >= HEAP_REPLAY_HEAP_NBR ) )
+    {
+      /* No buffer on the device, nothing released later */
+      continue;
+    }
+
+    if ( pstRecord->cEvent == HEAP_REPLAY_FREE )
+    {
+      pstLive = HeapReplayFind( pstRecord->lAddress );
+      if ( pstLive != NULL )
+      {
+        if ( pstLive->cSlab != HEAP_REPLAY_NO_SLAB )
+        {
+          aiSlabFree[pstLive->cSlab]++;
+        }
+        else
+        {
+          (void)AMM_Free( pstLive->pBuffer );
+        }
+        *pstLive = pstHeapReplayLive[--lHeapReplayLiveNbr];
+      }
+      continue;
+    }
+
+    /* Allocation : the pools then the AMM, as ZIGBEE_PLAT_Alloc() (a null size is one byte) */
+    pBuffer = NULL;
+    cSlab = HeapReplaySlabAlloc( MAX( pstRecord->iSize, 1u ), aiSlabFree );
+    if ( ( cSlab == HEAP_REPLAY_NO_SLAB )
+      && ( AMM_Alloc( acHeapReplayVmId[pstRecord->cHeap], DIVC( MAX( pstRecord->iSize, 1u ), sizeof( uint32_t ) ),
+                      &pBuffer, NULL ) != AMM_ERROR_OK ) )
+    {
+      pstResult->lFailures++;
+      continue;
+    }
+
+    pstLive = &pstHeapReplayLive[lHeapReplayLiveNbr++];
+    pstLive->lAddress = pstRecord->lAddress;
+    pstLive->pBuffer = pBuffer;
+    pstLive->cSlab = cSlab;
+
+    if ( pBuffer != NULL )
+    {
+      lOccupied = 0;
+      for ( lHeap = 0; lHeap < HEAP_REPLAY_HEAP_NBR; lHeap++ )
+      {
+        if ( AMM_GetVirtualMemoryStats( acHeapReplayVmId[lHeap], &stAmmStats ) == AMM_ERROR_OK )
+        {
+          lOccupied += stAmmStats.OccupiedSize;
+        }
+      }
+
+      if ( ( lOccupied * sizeof( uint32_t ) ) > pstResult->lPeakSize )
+      {
+        lLargest = 0;
+        (void)AMM_GetLargestFreeBlock( &lLargest );
+        pstResult->lPeakSize = lOccupied * sizeof( uint32_t );
+        pstResult->lPeakFreeSize = lPoolWords - lOccupied;
+        pstResult->lPeakLargest = lLargest;
+      }
+    }
+  }
+
+  while ( lHeapReplayLiveNbr != 0u )
+  {
+    pstLive = &pstHeapReplayLive[--lHeapReplayLiveNbr];
+    if ( pstLive->pBuffer != NULL )
+    {
+      (void)AMM_Free( pstLive->pBuffer );
+    }
+  }
+  (void)AMM_DeInit();
+  free( stInit.p_PoolAddr );
+
+  return true;
+}
+
+/**
+ * @brief  Smallest pool, in HEAP_REPLAY_SEARCH_STEP bytes, without failed allocation.
+ * @retval Size in bytes, 0 if above HEAP_REPLAY_SEARCH_MAX.
+ */
+static uint32_t HeapReplaySmallestPool( HOST_PLAT_Bmm_t eBmm, const uint16_t * piSlabCounts )
+{
+  HeapReplayResult_t  stResult;
+  uint32_t            lLow = 0, lHigh = HEAP_REPLAY_SEARCH_MAX, lMiddle;
+
+  if ( ( HeapReplayRun( eBmm, lHigh, piSlabCounts, &stResult ) == false ) || ( stResult.lFailures != 0u ) )
+  {
+    return 0;
+  }
+
+  while ( ( lHigh - lLow ) > HEAP_REPLAY_SEARCH_STEP )
+  {
+    lMiddle = ( lLow + lHigh ) / 2u;
+    if ( ( HeapReplayRun( eBmm, lMiddle, piSlabCounts, &stResult ) == true ) && ( stResult.lFailures == 0u ) )
+    {
+      lHigh = lMiddle;
+    }
+    else
+    {
+      lLow = lMiddle;
+    }
+  }
+
+  return lHigh;
+}
+
+/**
+ * @brief  Block of the smallest pool that fits and has a free block, as ZIGBEE_PLAT_SlabAlloc().
+ * @retval Index of the pool, HEAP_REPLAY_NO_SLAB if none.
+ */
+static uint8_t HeapReplaySlabAlloc( uint32_t lSize, uint16_t * piSlabFree )
+{
+  uint8_t   cIndex;
+
+  for ( cIndex = 0; cIndex < HEAP_REPLAY_SLAB_CLASS_NBR; cIndex++ )
+  {
+    if ( ( DIVC( lSize, sizeof( uint32_t ) ) <= ( aiHeapReplaySlabSize[cIndex] / sizeof( uint32_t ) ) )
+      && ( piSlabFree[cIndex] != 0u ) )
+    {
+      piSlabFree[cIndex]--;
+      return cIndex;
+    }
+  }
+
+  return HEAP_REPLAY_NO_SLAB;
+}
+
+/**
+ * @brief  Buffer allocated at this address on the device.
+ */
+static HeapReplayLive_t * HeapReplayFind( uint32_t lAddress )
+{
+  uint32_t  lIndex;
+
+  for ( lIndex = lHeapReplayLiveNbr; lIndex != 0u; lIndex-- )
+  {
+    if ( pstHeapReplayLive[lIndex - 1u].lAddress == lAddress )
+    {
+      return &pstHeapReplayLive[lIndex - 1u];
+    }
+  }
+
+  return NULL;
+}
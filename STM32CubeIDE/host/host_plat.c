@@ -0,0 +1,328 @@
+/**
+  ******************************************************************************
+  * @file    host_plat.c
+  * @author  MCD Application Team
+  * @brief   Host build : mocked platform of the utilities.
+  *          - interrupt mask : one thread, only the nesting of the critical
+  *            sections is checked and their number counted ;
+  *          - UTIL_TimerDriver : ticks of 1/1024 s as the RTC of the device, on
+  *            a software clock moved by HOST_PLAT_AdvanceTime(), which runs
+  *            the timer server interrupt when it reaches the programmed alarm ;
+  *          - basic memory manager of the AMM : stm32_mm.c or stm32_tlsf.c,
+  *            chosen before AMM_Init() with HOST_PLAT_SetBmm().
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "host_plat.h"
+#include "stm32_seq.h"
+#include "stm32_timer.h"
+#include "advanced_memory_manager.h"
+#include "stm32_mm.h"
+#include "stm32_tlsf.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define HOST_PLAT_TICK_LOG2             (10u)       /* RTC_N_PREDIV_S of the device */
+#define HOST_PLAT_MIN_ALARM_DELAY       (3u)        /* MIN_ALARM_DELAY of the device, ticks */
+
+/* Private functions prototypes-----------------------------------------------*/
+static UTIL_TIMER_Status_t  HostTimerInit               ( void );
+static UTIL_TIMER_Status_t  HostTimerStart              ( uint32_t lTimeout );
+static UTIL_TIMER_Status_t  HostTimerStop               ( void );
+static uint32_t             HostTimerSetContext         ( void );
+static uint32_t             HostTimerGetContext         ( void );
+static uint32_t             HostTimerGetElapsedTime     ( void );
+static uint32_t             HostTimerGetValue           ( void );
+static uint32_t             HostTimerGetMinimumTimeout  ( void );
+static uint32_t             HostTimerMs2Tick            ( uint32_t lTimeMs );
+static uint32_t             HostTimerTick2Ms            ( uint32_t lTick );
+static uint64_t             HostTimerGetTick64          ( void );
+
+static void                 HostBmmInit                 ( uint32_t * const p_PoolAddr, const uint32_t PoolSize );
+static uint32_t *           HostBmmAllocate             ( const uint32_t BufferSize );
+static void                 HostBmmFree                 ( uint32_t * const p_BufferAddr );
+static uint32_t             HostBmmGetLargestFreeBlock  ( void );
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t             lHostPrimask;
+static uint32_t             lHostCriticalNb;          /* Critical sections entered */
+
+static uint64_t             llHostTimeUs;             /* Software clock */
+static uint32_t             lHostTimerContext;
+static bool                 bHostAlarmArmed;
+static uint64_t             llHostAlarmTick;
+
+static HOST_PLAT_Bmm_t      eHostBmm = HOST_PLAT_BMM_MM;
+static bool                 bHostAmmRequest;
+
+/* Global variables ----------------------------------------------------------*/
+const UTIL_TIMER_Driver_s UTIL_TimerDriver =
+{
+  HostTimerInit,
+  NULL,
+
+  HostTimerStart,
+  HostTimerStop,
+
+  HostTimerSetContext,
+  HostTimerGetContext,
+
+  HostTimerGetElapsedTime,
+  HostTimerGetValue,
+  HostTimerGetMinimumTimeout,
+
+  HostTimerMs2Tick,
+  HostTimerTick2Ms,
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Interrupt mask, a critical section is counted when the interrupts are masked.
+ */
+uint32_t HOST_PLAT_GetPrimask( void )
+{
+  return lHostPrimask;
+}
+
+void HOST_PLAT_SetPrimask( uint32_t lPrimask )
+{
+  if ( ( lHostPrimask == 0u ) && ( lPrimask != 0u ) )
+  {
+    lHostCriticalNb++;
+  }
+  lHostPrimask = lPrimask;
+}
+
+/**
+ * @brief  Number of critical sections entered since the start.
+ */
+uint32_t HOST_PLAT_GetCriticalNb( void )
+{
+  return lHostCriticalNb;
+}
+
+/**
+ * @brief  Software clock in us (deadlines of the sequencer).
+ */
+uint32_t HOST_PLAT_GetTimeUs( void )
+{
+  return (uint32_t)llHostTimeUs;
+}
+
+/**
+ * @brief  Move the software clock : the timer server interrupt is run at each alarm reached on the way, the
+ *         interrupts masked as on the device.
+ * @param  lTimeUs  Time to move, in us.
+ */
+void HOST_PLAT_AdvanceTime( uint32_t lTimeUs )
+{
+  uint64_t  llEndUs = llHostTimeUs + lTimeUs;
+  uint64_t  llAlarmUs;
+  uint32_t  lPrimask;
+
+  if ( lHostPrimask != 0u )
+  {
+    HOST_PLAT_Fatal( "time moved in a critical section" );
+  }
+
+  while ( bHostAlarmArmed )
+  {
+    /* First us at or after the alarm tick */
+    llAlarmUs = ( ( llHostAlarmTick * 1000000u ) + ( 1u << HOST_PLAT_TICK_LOG2 ) - 1u ) >> HOST_PLAT_TICK_LOG2;
+    if ( llAlarmUs > llEndUs )
+    {
+      break;
+    }
+    if ( llAlarmUs > llHostTimeUs )
+    {
+      llHostTimeUs = llAlarmUs;
+    }
+    bHostAlarmArmed = false;
+
+    lPrimask = __get_PRIMASK();
+    __disable_irq();
+    UTIL_TIMER_IRQ_Handler();
+    __set_PRIMASK( lPrimask );
+  }
+
+  llHostTimeUs = llEndUs;
+}
+
+/**
+ * @brief  Basic memory manager given to the AMM on its next initialization.
+ */
+void HOST_PLAT_SetBmm( HOST_PLAT_Bmm_t eBmm )
+{
+  eHostBmm = eBmm;
+}
+
+/**
+ * @brief  Host monotonic time, for the measures.
+ */
+uint64_t HOST_PLAT_GetCpuTimeNs( void )
+{
+  struct timespec stTime;
+
+  clock_gettime( CLOCK_MONOTONIC, &stTime );
+  return ( ( (uint64_t)stTime.tv_sec * 1000000000u ) + (uint64_t)stTime.tv_nsec );
+}
+
+/**
+ * @brief  Error of the platform or of a utility : the run is stopped.
+ */
+void HOST_PLAT_Fatal( const char * szReason )
+{
+  fprintf( stderr, "fatal : %s\n", szReason );
+  exit( 2 );
+}
+
+/**
+ * @brief  Idle of the sequencer : the AMM background process requested, as its task on the device.
+ */
+void UTIL_SEQ_Idle( void )
+{
+  if ( bHostAmmRequest )
+  {
+    bHostAmmRequest = false;
+    AMM_BackgroundProcess();
+  }
+}
+
+void AMM_RegisterBasicMemoryManager( AMM_BasicMemoryManagerFunctions_t * const p_BasicMemoryManagerFunctions )
+{
+  p_BasicMemoryManagerFunctions->Init = HostBmmInit;
+  p_BasicMemoryManagerFunctions->Allocate = HostBmmAllocate;
+  p_BasicMemoryManagerFunctions->Free = HostBmmFree;
+  p_BasicMemoryManagerFunctions->GetLargestFreeBlock = HostBmmGetLargestFreeBlock;
+}
+
+void AMM_ProcessRequest( void )
+{
+  bHostAmmRequest = true;
+}
+
+void AMM_LowWatermarkNotification( const uint8_t Reached )
+{
+  (void)Reached;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static UTIL_TIMER_Status_t HostTimerInit( void )
+{
+  bHostAlarmArmed = false;
+  return UTIL_TIMER_OK;
+}
+
+static UTIL_TIMER_Status_t HostTimerStart( uint32_t lTimeout )
+{
+  /* Relative to the context, as the RTC alarm of the device */
+  llHostAlarmTick = ( HostTimerGetTick64() - (uint32_t)( HostTimerGetValue() - lHostTimerContext ) ) + lTimeout;
+  bHostAlarmArmed = true;
+  return UTIL_TIMER_OK;
+}
+
+static UTIL_TIMER_Status_t HostTimerStop( void )
+{
+  bHostAlarmArmed = false;
+  return UTIL_TIMER_OK;
+}
+
+static uint32_t HostTimerSetContext( void )
+{
+  lHostTimerContext = HostTimerGetValue();
+  return lHostTimerContext;
+}
+
+static uint32_t HostTimerGetContext( void )
+{
+  return lHostTimerContext;
+}
+
+static uint32_t HostTimerGetElapsedTime( void )
+{
+  return ( HostTimerGetValue() - lHostTimerContext );
+}
+
+static uint32_t HostTimerGetValue( void )
+{
+  return (uint32_t)HostTimerGetTick64();
+}
+
+static uint32_t HostTimerGetMinimumTimeout( void )
+{
+  return HOST_PLAT_MIN_ALARM_DELAY;
+}
+
+static uint32_t HostTimerMs2Tick( uint32_t lTimeMs )
+{
+  return (uint32_t)( ( (uint64_t)lTimeMs << HOST_PLAT_TICK_LOG2 ) / 1000u );
+}
+
+static uint32_t HostTimerTick2Ms( uint32_t lTick )
+{
+  return (uint32_t)( ( (uint64_t)lTick * 1000u ) >> HOST_PLAT_TICK_LOG2 );
+}
+
+static uint64_t HostTimerGetTick64( void )
+{
+  return ( ( llHostTimeUs << HOST_PLAT_TICK_LOG2 ) / 1000000u );
+}
+
+static void HostBmmInit( uint32_t * const p_PoolAddr, const uint32_t PoolSize )
+{
+  if ( eHostBmm == HOST_PLAT_BMM_TLSF )
+  {
+    UTIL_TLSF_Init( (uint8_t *)p_PoolAddr, ( (size_t)PoolSize * sizeof( uint32_t ) ) );
+  }
+  else
+  {
+    UTIL_MM_Init( (uint8_t *)p_PoolAddr, ( (size_t)PoolSize * sizeof( uint32_t ) ) );
+  }
+}
+
+static uint32_t * HostBmmAllocate( const uint32_t BufferSize )
+{
+  if ( eHostBmm == HOST_PLAT_BMM_TLSF )
+  {
+    return (uint32_t *)UTIL_TLSF_GetBuffer( ( (size_t)BufferSize * sizeof( uint32_t ) ) );
+  }
+  return (uint32_t *)UTIL_MM_GetBuffer( ( (size_t)BufferSize * sizeof( uint32_t ) ) );
+}
+
+static void HostBmmFree( uint32_t * const p_BufferAddr )
+{
+  if ( eHostBmm == HOST_PLAT_BMM_TLSF )
+  {
+    UTIL_TLSF_ReleaseBuffer( (void *)p_BufferAddr );
+  }
+  else
+  {
+    UTIL_MM_ReleaseBuffer( (void *)p_BufferAddr );
+  }
+}
+
+static uint32_t HostBmmGetLargestFreeBlock( void )
+{
+  if ( eHostBmm == HOST_PLAT_BMM_TLSF )
+  {
+    return (uint32_t)( UTIL_TLSF_GetLargestFreeBlock() / sizeof( uint32_t ) );
+  }
+  return (uint32_t)( UTIL_MM_GetLargestFreeBlock() / sizeof( uint32_t ) );
+}
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file    host_plat.h
+  * @author  MCD Application Team
+  * @brief   Host build : mocked platform of the utilities (interrupt mask,
+  *          software clock behind UTIL_TimerDriver, basic memory manager of
+  *          the AMM) and the host time measurement.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_PLAT_H
+#define HOST_PLAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Basic memory manager below the AMM (CFG_AMM_BMM_TLSF_SUPPORTED on the device) */
+typedef enum
+{
+  HOST_PLAT_BMM_MM,                   /* stm32_mm.c, first fit */
+  HOST_PLAT_BMM_TLSF,                 /* stm32_tlsf.c, good fit */
+} HOST_PLAT_Bmm_t;
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t  HOST_PLAT_GetPrimask        ( void );
+void      HOST_PLAT_SetPrimask        ( uint32_t lPrimask );
+uint32_t  HOST_PLAT_GetCriticalNb     ( void );
+
+uint32_t  HOST_PLAT_GetTimeUs         ( void );
+void      HOST_PLAT_AdvanceTime       ( uint32_t lTimeUs );
+
+void      HOST_PLAT_SetBmm            ( HOST_PLAT_Bmm_t eBmm );
+uint64_t  HOST_PLAT_GetCpuTimeNs      ( void );
+
+void      HOST_PLAT_Fatal             ( const char * szReason );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PLAT_H */
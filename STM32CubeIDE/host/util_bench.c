@@ -0,0 +1,466 @@
+/**
+  ******************************************************************************
+  * @file    util_bench.c
+  * @author  MCD Application Team
+  * @brief   Host micro-benchmarks of the sequencer, the timer server and the
+  *          memory managers, built from their sources of the device :
+  *          sequencer dispatch cost versus the number of tasks set, timer
+  *          start, stop and expiry costs versus the number of timers running,
+  *          AMM allocation and release costs and fragmentation under the
+  *          Zigbee allocation pattern of app_util_bench.c, on stm32_mm and on
+  *          stm32_tlsf. Results in CSV on the standard output, in ns of the
+  *          host with the critical sections entered per operation.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_plat.h"
+#include "stm32_seq.h"
+#include "stm32_timer.h"
+#include "advanced_memory_manager.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define UTIL_BENCH_ITERATIONS           (1000u)     /* Default runs per case */
+#define UTIL_BENCH_TRACE_LOOPS          (8u)
+#define UTIL_BENCH_FILL_PERIOD_MS       (3600000u)  /* Timers of the fill : never expire during the benchmark */
+#define UTIL_BENCH_FILL_STEP_MS         (1000u)
+#define UTIL_BENCH_FILL_NBR             ( UTIL_TIMER_CONF_MAX_TIMER_NBR - 2u )  /* Places of the probe and of the sequencer defer timer */
+#define UTIL_BENCH_PROBE_PERIOD_MS      ( UTIL_BENCH_FILL_PERIOD_MS + ( UTIL_BENCH_FILL_STEP_MS * UTIL_BENCH_FILL_NBR / 2u ) )
+#define UTIL_BENCH_EXPIRY_WAIT_US       (5000u)     /* Above the minimum timeout of the driver */
+#define UTIL_BENCH_ALLOC_SLOT_NBR       (12u)
+#define UTIL_BENCH_POOL_SIZE            ( ( CFG_MM_POOL_SIZE / sizeof( uint32_t ) ) \
+                                          + ( AMM_VIRTUAL_INFO_ELEMENT_SIZE * CFG_AMM_VIRTUAL_MEMORY_NUMBER ) )
+
+/* Private typedef -----------------------------------------------------------*/
+/* Host time of one measured operation */
+typedef struct
+{
+  uint64_t    llMin;
+  uint64_t    llMax;
+  uint64_t    llTotal;
+  uint32_t    lCount;
+  uint32_t    lCriticalNb;
+} UtilBenchStats_t;
+
+/* One step of the allocation trace : iSize bytes allocated in the slot cSlot (after the release of its buffer, if
+ * any), or the buffer of the slot released if iSize is 0 */
+typedef struct
+{
+  uint8_t     cSlot;
+  uint16_t    iSize;
+} UtilBenchAllocStep_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     UtilBenchSequencer          ( void );
+static void     UtilBenchSequencerLevel     ( uint32_t lTaskNbr, bool bSpread );
+static void     UtilBenchSequencerTask      ( void );
+static void     UtilBenchTimers             ( void );
+static void     UtilBenchTimersLevel        ( uint32_t lFillNbr );
+static void     UtilBenchTimerCallback      ( void * arg );
+static void     UtilBenchAmm                ( HOST_PLAT_Bmm_t eBmm, const char * szBmm );
+static void     UtilBenchAmmFree            ( uint8_t cSlot, UtilBenchStats_t * pstStats );
+static void     UtilBenchCalibrate          ( void );
+static uint64_t UtilBenchStart              ( void );
+static void     UtilBenchStatsReset         ( UtilBenchStats_t * pstStats );
+static void     UtilBenchStatsAdd           ( UtilBenchStats_t * pstStats, uint64_t llStart, uint32_t lCriticalNb,
+                                              uint32_t lOperationNb );
+static void     UtilBenchStatsPrint         ( const char * szName, uint32_t lSize, const UtilBenchStats_t * pstStats );
+
+/* Private variables ---------------------------------------------------------*/
+/* Allocation pattern of the Zigbee stack from the join to the ZCL traffic, as in app_util_bench.c */
+static const UtilBenchAllocStep_t astUtilBenchAllocTrace[] =
+{
+  { 0u, 200u }, { 1u, 127u }, { 1u, 0u },   { 2u, 127u }, { 3u, 64u },  { 2u, 0u },   { 4u, 40u },  { 5u, 24u },
+  { 3u, 0u },   { 6u, 127u }, { 7u, 96u },  { 5u, 0u },   { 8u, 48u },  { 6u, 0u },   { 9u, 127u }, { 4u, 0u },
+  { 10u, 300u },{ 7u, 0u },   { 8u, 0u },   { 11u, 127u },{ 9u, 0u },   { 1u, 80u },  { 11u, 0u },  { 2u, 24u },
+  { 1u, 0u },   { 3u, 127u }, { 4u, 160u }, { 2u, 0u },   { 5u, 40u },  { 3u, 0u },   { 6u, 256u }, { 5u, 0u },
+  { 7u, 127u }, { 4u, 0u },   { 7u, 0u },   { 6u, 0u },
+};
+
+static uint32_t                   lUtilBenchIterations = UTIL_BENCH_ITERATIONS;
+static uint64_t                   llUtilBenchOverhead;        /* ns, of an empty measure */
+
+static uint32_t                   lUtilBenchTaskRuns;
+
+static UTIL_TIMER_Object_t        astUtilBenchTimers[UTIL_BENCH_FILL_NBR];
+static UTIL_TIMER_Object_t        stUtilBenchProbe;
+static uint32_t                   lUtilBenchExpiries;
+
+static uint32_t                   alUtilBenchPool[UTIL_BENCH_POOL_SIZE];
+static uint32_t *                 apUtilBenchBuffers[UTIL_BENCH_ALLOC_SLOT_NBR];
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  util_bench [iterations] : run all the benchmarks.
+ */
+int main( int argc, char * argv[] )
+{
+  if ( argc > 1 )
+  {
+    lUtilBenchIterations = (uint32_t)strtoul( argv[1], NULL, 0 );
+    if ( lUtilBenchIterations == 0u )
+    {
+      fprintf( stderr, "usage : %s [iterations]\n", argv[0] );
+      return 1;
+    }
+  }
+
+  UTIL_TIMER_Init();
+  UTIL_SEQ_Init();
+  UtilBenchCalibrate();
+
+  printf( "UTILBENCH,host,%u bits,overhead_ns,%u\n", (unsigned)( 8u * sizeof( void * ) ), (unsigned)llUtilBenchOverhead );
+  printf( "UTILBENCH,operation,size,iterations,min_ns,avg_ns,max_ns,critical_sections\n" );
+
+  UtilBenchSequencer();
+  UtilBenchTimers();
+  UtilBenchAmm( HOST_PLAT_BMM_MM, "stm32_mm" );
+  UtilBenchAmm( HOST_PLAT_BMM_TLSF, "stm32_tlsf" );
+
+  printf( "UTILBENCH,end\n" );
+  return 0;
+}
+
+/**
+ * @brief  Sequencer : set and dispatch cost per task with 1, 2, 4... UTIL_SEQ_CONF_TASK_NBR tasks set at once, all
+ *         at the same priority then spread over the priorities. The size printed is the number of tasks set.
+ */
+static void UtilBenchSequencer( void )
+{
+  uint32_t  lTaskNbr;
+
+  for ( lTaskNbr = 0; lTaskNbr < UTIL_SEQ_CONF_TASK_NBR; lTaskNbr++ )
+  {
+    UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( lTaskNbr ), UTIL_SEQ_RFU, UtilBenchSequencerTask );
+  }
+
+  for ( lTaskNbr = 1; lTaskNbr <= UTIL_SEQ_CONF_TASK_NBR; lTaskNbr *= 2u )
+  {
+    UtilBenchSequencerLevel( lTaskNbr, false );
+  }
+  for ( lTaskNbr = UTIL_SEQ_CONF_PRIO_NBR; lTaskNbr <= UTIL_SEQ_CONF_TASK_NBR; lTaskNbr *= 2u )
+  {
+    UtilBenchSequencerLevel( lTaskNbr, true );
+  }
+}
+
+/**
+ * @brief  Sequencer : lTaskNbr tasks set then run, the costs divided by the number of tasks.
+ */
+static void UtilBenchSequencerLevel( uint32_t lTaskNbr, bool bSpread )
+{
+  UtilBenchStats_t  stSet, stRun;
+  uint32_t          lIndex, lTask, lCriticalNb;
+  uint64_t          llStart;
+
+  UtilBenchStatsReset( &stSet );
+  UtilBenchStatsReset( &stRun );
+
+  for ( lIndex = 0; lIndex < lUtilBenchIterations; lIndex++ )
+  {
+    lCriticalNb = HOST_PLAT_GetCriticalNb();
+    llStart = UtilBenchStart();
+    for ( lTask = 0; lTask < lTaskNbr; lTask++ )
+    {
+      UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( lTask ), ( bSpread ? ( lTask % UTIL_SEQ_CONF_PRIO_NBR ) : 0u ) );
+    }
+    UtilBenchStatsAdd( &stSet, llStart, lCriticalNb, lTaskNbr );
+
+    lUtilBenchTaskRuns = 0;
+    lCriticalNb = HOST_PLAT_GetCriticalNb();
+    llStart = UtilBenchStart();
+    UTIL_SEQ_Run( UTIL_SEQ_DEFAULT );
+    UtilBenchStatsAdd( &stRun, llStart, lCriticalNb, lTaskNbr );
+
+    if ( lUtilBenchTaskRuns != lTaskNbr )
+    {
+      HOST_PLAT_Fatal( "sequencer tasks not run" );
+    }
+  }
+
+  UtilBenchStatsPrint( ( bSpread ? "UTIL_SEQ_SetTask_prio" : "UTIL_SEQ_SetTask" ), lTaskNbr, &stSet );
+  UtilBenchStatsPrint( ( bSpread ? "UTIL_SEQ_Run_prio" : "UTIL_SEQ_Run" ), lTaskNbr, &stRun );
+}
+
+static void UtilBenchSequencerTask( void )
+{
+  lUtilBenchTaskRuns++;
+}
+
+/**
+ * @brief  Timer server : the costs measured with 0, 1, 2, 4... timers running, up to the capacity of the heap.
+ */
+static void UtilBenchTimers( void )
+{
+  uint32_t  lIndex, lFillNbr;
+
+  for ( lIndex = 0; lIndex < UTIL_BENCH_FILL_NBR; lIndex++ )
+  {
+    UTIL_TIMER_Create( &astUtilBenchTimers[lIndex], ( UTIL_BENCH_FILL_PERIOD_MS + ( lIndex * UTIL_BENCH_FILL_STEP_MS ) ),
+                       UTIL_TIMER_ONESHOT, &UtilBenchTimerCallback, NULL );
+  }
+  UTIL_TIMER_Create( &stUtilBenchProbe, UTIL_BENCH_PROBE_PERIOD_MS, UTIL_TIMER_ONESHOT, &UtilBenchTimerCallback, NULL );
+
+  lFillNbr = 0;
+  while ( true )
+  {
+    UtilBenchTimersLevel( lFillNbr );
+    if ( lFillNbr >= UTIL_BENCH_FILL_NBR )
+    {
+      break;
+    }
+    lFillNbr = ( ( lFillNbr == 0u ) ? 1u : MIN( ( lFillNbr * 2u ), UTIL_BENCH_FILL_NBR ) );
+  }
+}
+
+/**
+ * @brief  Timer server : start, stop and expiry of a timer with lFillNbr timers running. The expiry is the timer
+ *         server interrupt run by the software clock.
+ */
+static void UtilBenchTimersLevel( uint32_t lFillNbr )
+{
+  UtilBenchStats_t  stStart, stStop, stExpiry;
+  uint32_t          lIndex, lCriticalNb, lExpiries;
+  uint64_t          llStart;
+
+  for ( lIndex = 0; lIndex < lFillNbr; lIndex++ )
+  {
+    (void)UTIL_TIMER_Start( &astUtilBenchTimers[lIndex] );
+  }
+
+  UtilBenchStatsReset( &stStart );
+  UtilBenchStatsReset( &stStop );
+  UtilBenchStatsReset( &stExpiry );
+
+  for ( lIndex = 0; lIndex < lUtilBenchIterations; lIndex++ )
+  {
+    /* Insertion in the middle of the timers of the fill, then removal */
+    (void)UTIL_TIMER_SetPeriod( &stUtilBenchProbe, UTIL_BENCH_PROBE_PERIOD_MS );
+
+    lCriticalNb = HOST_PLAT_GetCriticalNb();
+    llStart = UtilBenchStart();
+    (void)UTIL_TIMER_Start( &stUtilBenchProbe );
+    UtilBenchStatsAdd( &stStart, llStart, lCriticalNb, 1u );
+
+    lCriticalNb = HOST_PLAT_GetCriticalNb();
+    llStart = UtilBenchStart();
+    (void)UTIL_TIMER_Stop( &stUtilBenchProbe );
+    UtilBenchStatsAdd( &stStop, llStart, lCriticalNb, 1u );
+
+    /* Expiry : first timer of the heap */
+    (void)UTIL_TIMER_SetPeriod( &stUtilBenchProbe, 1u );
+    (void)UTIL_TIMER_Start( &stUtilBenchProbe );
+    lExpiries = lUtilBenchExpiries;
+
+    lCriticalNb = HOST_PLAT_GetCriticalNb();
+    llStart = UtilBenchStart();
+    HOST_PLAT_AdvanceTime( UTIL_BENCH_EXPIRY_WAIT_US );
+    UtilBenchStatsAdd( &stExpiry, llStart, lCriticalNb, 1u );
+
+    if ( lUtilBenchExpiries != ( lExpiries + 1u ) )
+    {
+      HOST_PLAT_Fatal( "timer not expired" );
+    }
+  }
+
+  for ( lIndex = 0; lIndex < lFillNbr; lIndex++ )
+  {
+    (void)UTIL_TIMER_Stop( &astUtilBenchTimers[lIndex] );
+  }
+
+  UtilBenchStatsPrint( "UTIL_TIMER_Start", lFillNbr, &stStart );
+  UtilBenchStatsPrint( "UTIL_TIMER_Stop", lFillNbr, &stStop );
+  UtilBenchStatsPrint( "UTIL_TIMER_ProcessExpired", lFillNbr, &stExpiry );
+}
+
+static void UtilBenchTimerCallback( void * arg )
+{
+  (void)arg;
+
+  lUtilBenchExpiries++;
+}
+
+/**
+ * @brief  AMM on the basic memory manager eBmm, pool and virtual memories of the device : replays of the allocation
+ *         trace in the Zigbee heap virtual memory. The size still available to it and the largest free block of the
+ *         pool are printed after the first replays, the long-lived buffers still allocated.
+ */
+static void UtilBenchAmm( HOST_PLAT_Bmm_t eBmm, const char * szBmm )
+{
+  static AMM_VirtualMemoryConfig_t  astVmConfig[CFG_AMM_VIRTUAL_MEMORY_NUMBER] =
+  {
+    { .Id = CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, .BufferSize = CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT_BUFFER_SIZE },
+    { .Id = CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, .BufferSize = CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP_BUFFER_SIZE },
+  };
+  AMM_InitParameters_t              stInit =
+  {
+    .p_PoolAddr = alUtilBenchPool,
+    .PoolSize = UTIL_BENCH_POOL_SIZE,
+    .VirtualMemoryNumber = CFG_AMM_VIRTUAL_MEMORY_NUMBER,
+    .p_VirtualMemoryConfigList = astVmConfig
+  };
+  const UtilBenchAllocStep_t  * pstStep;
+  UtilBenchStats_t            stAlloc, stFree;
+  AMM_VirtualMemoryStats_t    stAmmStats;
+  char                        szName[32];
+  uint32_t                    lLoop, lIndex, lLargest, lCriticalNb, lFailures = 0;
+  uint64_t                    llStart;
+
+  HOST_PLAT_SetBmm( eBmm );
+  if ( AMM_Init( &stInit ) != AMM_ERROR_OK )
+  {
+    HOST_PLAT_Fatal( "AMM_Init" );
+  }
+
+  UtilBenchStatsReset( &stAlloc );
+  UtilBenchStatsReset( &stFree );
+
+  printf( "UTILBENCH,amm_fragmentation,%s,loop,free_words,largest_free_words\n", szBmm );
+
+  for ( lLoop = 0; lLoop < ( UTIL_BENCH_TRACE_LOOPS * lUtilBenchIterations ); lLoop++ )
+  {
+    for ( lIndex = 0; lIndex < ( sizeof( astUtilBenchAllocTrace ) / sizeof( astUtilBenchAllocTrace[0] ) ); lIndex++ )
+    {
+      pstStep = &astUtilBenchAllocTrace[lIndex];
+      UtilBenchAmmFree( pstStep->cSlot, &stFree );
+
+      if ( pstStep->iSize != 0u )
+      {
+        lCriticalNb = HOST_PLAT_GetCriticalNb();
+        llStart = UtilBenchStart();
+        if ( AMM_Alloc( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, DIVC( pstStep->iSize, sizeof( uint32_t ) ),
+                        &apUtilBenchBuffers[pstStep->cSlot], NULL ) == AMM_ERROR_OK )
+        {
+          UtilBenchStatsAdd( &stAlloc, llStart, lCriticalNb, 1u );
+        }
+        else
+        {
+          apUtilBenchBuffers[pstStep->cSlot] = NULL;
+          lFailures++;
+        }
+      }
+    }
+
+    /* Fragmentation of the first replays, the pool does not change after */
+    if ( lLoop < UTIL_BENCH_TRACE_LOOPS )
+    {
+      lLargest = 0;
+      (void)AMM_GetLargestFreeBlock( &lLargest );
+      stAmmStats.AvailableSize = 0;
+      (void)AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, &stAmmStats );
+      printf( "UTILBENCH,amm_fragmentation,%s,%u,%u,%u\n", szBmm, lLoop, stAmmStats.AvailableSize, lLargest );
+    }
+  }
+
+  for ( lIndex = 0; lIndex < UTIL_BENCH_ALLOC_SLOT_NBR; lIndex++ )
+  {
+    UtilBenchAmmFree( (uint8_t)lIndex, &stFree );
+  }
+  (void)AMM_DeInit();
+
+  snprintf( szName, sizeof( szName ), "AMM_Alloc_%s", szBmm );
+  UtilBenchStatsPrint( szName, 0u, &stAlloc );
+  snprintf( szName, sizeof( szName ), "AMM_Free_%s", szBmm );
+  UtilBenchStatsPrint( szName, 0u, &stFree );
+  if ( lFailures != 0u )
+  {
+    printf( "UTILBENCH,AMM_Alloc_%s,%u failures\n", szBmm, lFailures );
+  }
+}
+
+/**
+ * @brief  AMM : release of the buffer of a slot, if any.
+ */
+static void UtilBenchAmmFree( uint8_t cSlot, UtilBenchStats_t * pstStats )
+{
+  uint32_t  lCriticalNb;
+  uint64_t  llStart;
+
+  if ( apUtilBenchBuffers[cSlot] == NULL )
+  {
+    return;
+  }
+
+  lCriticalNb = HOST_PLAT_GetCriticalNb();
+  llStart = UtilBenchStart();
+  (void)AMM_Free( apUtilBenchBuffers[cSlot] );
+  UtilBenchStatsAdd( pstStats, llStart, lCriticalNb, 1u );
+
+  apUtilBenchBuffers[cSlot] = NULL;
+}
+
+/**
+ * @brief  Cost of an empty measure, removed from the measures.
+ */
+static void UtilBenchCalibrate( void )
+{
+  uint64_t  llStart, llTime;
+  uint32_t  lIndex;
+
+  llUtilBenchOverhead = UINT64_MAX;
+  for ( lIndex = 0; lIndex < 1000u; lIndex++ )
+  {
+    llStart = HOST_PLAT_GetCpuTimeNs();
+    llTime = HOST_PLAT_GetCpuTimeNs() - llStart;
+    llUtilBenchOverhead = MIN( llUtilBenchOverhead, llTime );
+  }
+}
+
+static uint64_t UtilBenchStart( void )
+{
+  return HOST_PLAT_GetCpuTimeNs();
+}
+
+static void UtilBenchStatsReset( UtilBenchStats_t * pstStats )
+{
+  pstStats->llMin = UINT64_MAX;
+  pstStats->llMax = 0;
+  pstStats->llTotal = 0;
+  pstStats->lCount = 0;
+  pstStats->lCriticalNb = 0;
+}
+
+/**
+ * @brief  Measure of lOperationNb operations started at llStart, the critical sections counted from lCriticalNb.
+ */
+static void UtilBenchStatsAdd( UtilBenchStats_t * pstStats, uint64_t llStart, uint32_t lCriticalNb,
+                               uint32_t lOperationNb )
+{
+  uint64_t  llTime = HOST_PLAT_GetCpuTimeNs() - llStart;
+
+  llTime = ( ( llTime > llUtilBenchOverhead ) ? ( llTime - llUtilBenchOverhead ) : 0u ) / lOperationNb;
+
+  pstStats->llMin = MIN( pstStats->llMin, llTime );
+  pstStats->llMax = MAX( pstStats->llMax, llTime );
+  pstStats->llTotal += llTime;
+  pstStats->lCount++;
+  pstStats->lCriticalNb += ( HOST_PLAT_GetCriticalNb() - lCriticalNb ) / lOperationNb;
+}
+
+static void UtilBenchStatsPrint( const char * szName, uint32_t lSize, const UtilBenchStats_t * pstStats )
+{
+  if ( pstStats->lCount == 0u )
+  {
+    printf( "UTILBENCH,%s,%u,0,,,,\n", szName, lSize );
+    return;
+  }
+
+  printf( "UTILBENCH,%s,%u,%u,%u,%u,%u,%u\n", szName, lSize, pstStats->lCount, (unsigned)pstStats->llMin,
+          (unsigned)( pstStats->llTotal / pstStats->lCount ), (unsigned)pstStats->llMax,
+          ( pstStats->lCriticalNb / pstStats->lCount ) );
+}
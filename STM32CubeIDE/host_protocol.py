@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    host_protocol.py
+  * @author  MCD Application Team
+  * @brief   Client of the binary host control protocol (CFG_HOST_PROTOCOL_SUPPORTED)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 host_protocol.py <serial port> ping [count]
+      python3 host_protocol.py <serial port> stats
+      python3 host_protocol.py <serial port> nib <attribute>
+      python3 host_protocol.py <serial port> toggle <short address> <endpoint> [count]
+      python3 host_protocol.py <serial port> text <command>
+
+  Frame : 0xA5, length, type, sequence, data, CRC-16 CCITT (0xFFFF, little endian) of the length up to the data.
+  The requests are pipelined : up to WINDOW are sent before waiting for their responses (the device queues
+  CFG_HOST_RX_FRAMES frames). The bytes out of the frames are the logs, printed as they come. Needs pyserial.
+"""
+
+import struct
+import sys
+import time
+
+SYNC = 0xA5
+RESPONSE = 0x80
+WINDOW = 4
+TIMEOUT = 2.0
+
+CMD_PING = 0x01
+CMD_ZCL_SEND = 0x02
+CMD_NIB_GET = 0x03
+CMD_NIB_SET = 0x04
+CMD_STATS = 0x05
+CMD_PERSIST = 0x06
+CMD_TEXT = 0x07
+EVENT_ZCL_RSP = 0xC0
+
+STATUS = ["OK", "UNKNOWN", "INVALID", "BUSY", "FAILED", "NOT_READY"]
+
+STATS_NAMES = ["frames", "CRC errors", "busy", "UART errors", "TX dropped", "ZCL sent", "ZCL responses"]
+APS_STATS = [("APS success", "<H"), ("APS retries", "<H"), ("APS failures", "<H"), ("MAC unicast", "<I"),
+             ("MAC retries", "<H"), ("MAC failures", "<H")]
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode(kind, sequence, data=b""):
+    body = bytes([len(data) + 2, kind, sequence]) + data
+    return bytes([SYNC]) + body + struct.pack("<H", crc16(body))
+
+
+class Link:
+    """Frames and logs of the serial link."""
+
+    def __init__(self, port):
+        import serial
+        self.port = serial.Serial(port, 115200, timeout=0.05)
+        self.buffer = bytearray()
+        self.text = bytearray()
+        self.sequence = 0
+
+    def send(self, kind, data=b""):
+        self.sequence = (self.sequence + 1) & 0xFF
+        self.port.write(encode(kind, self.sequence, data))
+        return self.sequence
+
+    def frames(self):
+        """Frames received (type, sequence, data), the logs printed."""
+        self.buffer += self.port.read(256)
+        while self.buffer:
+            if self.buffer[0] != SYNC:
+                byte = self.buffer.pop(0)
+                self.text.append(byte)
+                if byte == ord("\n"):
+                    sys.stderr.write(self.text.decode("latin-1"))
+                    self.text.clear()
+                continue
+            if len(self.buffer) < 2 or len(self.buffer) < self.buffer[1] + 4:
+                return
+            length = self.buffer[1]
+            body = bytes(self.buffer[1:2 + length])
+            crc, = struct.unpack_from("<H", self.buffer, 2 + length)
+            if crc != crc16(body):
+                # Not a frame : the sync byte is dropped
+                self.buffer.pop(0)
+                continue
+            del self.buffer[:4 + length]
+            yield body[1], body[2], body[3:]
+
+    def run(self, requests, on_frame):
+        """Send the requests (type, data) with at most WINDOW waiting, on_frame called for each frame received."""
+        pending = {}
+        requests = list(requests)
+        deadline = time.monotonic() + TIMEOUT
+        while requests or pending:
+            while requests and len(pending) < WINDOW:
+                kind, data = requests.pop(0)
+                pending[self.send(kind, data)] = time.monotonic()
+            for kind, sequence, data in self.frames():
+                if (kind & RESPONSE) != 0 and kind < EVENT_ZCL_RSP and sequence in pending:
+                    on_frame(kind, sequence, data, time.monotonic() - pending.pop(sequence))
+                    deadline = time.monotonic() + TIMEOUT
+                else:
+                    on_frame(kind, sequence, data, None)
+            if time.monotonic() > deadline:
+                print("timeout, %d requests without response" % len(pending))
+                return
+
+
+def status(data):
+    return STATUS[data[0]] if data and data[0] < len(STATUS) else "?"
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__.split("Usage:")[1].split("Frame")[0])
+        return 1
+
+    link = Link(argv[1])
+    command = argv[2]
+
+    def show(kind, sequence, data, delay):
+        if kind == EVENT_ZCL_RSP:
+            aps, zcl, cmd = data[0], data[1], data[2]
+            print("#%d ZCL response : APS 0x%02X, ZCL 0x%02X, command 0x%02X, %s" % (sequence, aps, zcl, cmd,
+                                                                                   data[3:].hex()))
+        elif delay is not None:
+            print("#%d %s %s (%.1f ms) %s" % (sequence, hex(kind), status(data), delay * 1e3, data[1:].hex()))
+
+    if command == "ping":
+        count = int(argv[3]) if len(argv) > 3 else 1
+        link.run([(CMD_PING, struct.pack("<I", index)) for index in range(count)], show)
+    elif command == "stats":
+        def show_stats(kind, sequence, data, delay):
+            if delay is None:
+                return
+            values = struct.unpack_from("<7I", data, 1)
+            print(", ".join("%s %d" % item for item in zip(STATS_NAMES, values)))
+            offset = 1 + 7 * 4
+            for name, layout in APS_STATS:
+                if offset + struct.calcsize(layout) > len(data):
+                    break
+                print("%s %d" % (name, struct.unpack_from(layout, data, offset)[0]))
+                offset += struct.calcsize(layout)
+        link.run([(CMD_STATS, b"")], show_stats)
+    elif command == "nib":
+        link.run([(CMD_NIB_GET, struct.pack("<H", int(argv[3], 0)))], show)
+    elif command == "toggle":
+        # Short address, dest. and source endpoints, HA profile, OnOff cluster, cluster specific, Toggle
+        address, endpoint = int(argv[3], 0), int(argv[4], 0)
+        count = int(argv[5]) if len(argv) > 5 else 1
+        data = struct.pack("<BHBBHHBB", 2, address, endpoint, 1, 0x0104, 0x0006, 0x01, 0x02)
+        link.run([(CMD_ZCL_SEND, data)] * count, show)
+        # The last events
+        end = time.monotonic() + TIMEOUT
+        while time.monotonic() < end:
+            for frame in link.frames():
+                show(*frame, None)
+    elif command == "text":
+        link.run([(CMD_TEXT, " ".join(argv[3:]).encode("latin-1"))], show)
+    else:
+        print("unknown command " + command)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
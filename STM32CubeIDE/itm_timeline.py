@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    itm_timeline.py
+  * @author  MCD Application Team
+  * @brief   Render the ITM timeline trace (CFG_RT_DEBUG_ITM) as a Chrome trace / Perfetto file
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 itm_timeline.py <core clock Hz> [application.elf] [capture.swo] > trace.json
+
+  The capture is the raw byte stream of the SWO (stdin when not given), with the local time stamps of the ITM
+  enabled. The stimulus ports are:
+      1, 2, 3 : system, link layer and application RT_DEBUG signals, 16 bits : [7:0] signal, [9:8] action
+                (1 : set, 2 : reset, 3 : toggle)
+      4       : task or timer callback running, 32 bits : task ID, callback address, or 0xFFFFFFFF (idle)
+  The names of the signals and the tasks are read from the enums of the sources, the names of the timer callbacks
+  from the symbols of the ELF file. The time stamps count the cycles of the core clock : the time is wrong while
+  the clock differs from the given one, and it does not progress while the debug clock is stopped (low power).
+  The output opens in https://ui.perfetto.dev or chrome://tracing.
+"""
+
+import json
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+# Stimulus ports, enum giving the names of the signals (file, enum closing name)
+SIGNAL_PORTS = {
+    1: ("System", "Projects/Common/WPAN/Modules/RTDebug/debug_signals.h", "system_debug_signal_t"),
+    2: ("LinkLayer", "Middlewares/ST/STM32_WPAN/link_layer/ll_cmd_lib/inc/bsp.h", "Debug_GPIO_t"),
+    3: ("App", "System/Config/Debug_GPIO/app_debug.h", "app_debug_signal_t"),
+}
+RUN_PORT = 4
+RUN_IDLE = 0xFFFFFFFF
+TASK_NUMBER = 32
+
+ACTION_SET = 1
+ACTION_RESET = 2
+ACTION_TOGGLE = 3
+
+TID_TASK = 1
+TID_TIMER = 2
+TID_SIGNAL_FIRST = 16
+
+
+def enum_names(path, closing):
+    """Names of the enum closed by '} closing;', in the order of their values."""
+    try:
+        with open(os.path.join(ROOT, path), "r", encoding="latin-1") as f:
+            text = f.read()
+    except OSError:
+        return []
+    match = re.search(r"typedef\s+enum[^{};]*\{([^{}]*)\}\s*" + closing + r"\s*;", text)
+    if match is None:
+        return []
+    body = re.sub(r"/\*.*?\*/|//[^\n]*", "", match.group(1), flags=re.S)
+    return [name.split("=")[0].strip() for name in body.split(",") if name.strip()]
+
+
+def task_names():
+    names = enum_names("Core/Inc/app_conf.h", "CFG_Task_Id_t")
+    return [name.replace("CFG_TASK_", "") for name in names]
+
+
+class Elf:
+    """Minimal ELF32 little-endian reader, enough to get the function symbols."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1:
+            raise ValueError(path + " is not an ELF32 file")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + index * shentsize) for index in range(shnum)]
+        self.functions = {}
+        for _, sh_type, _, _, offset, size, link, _, _, entsize in sections:
+            # SHT_SYMTAB, names in the linked string table
+            if sh_type != 2 or entsize == 0:
+                continue
+            strings = sections[link][4]
+            for position in range(offset, offset + size, entsize):
+                name, value, _, info, _, _ = struct.unpack_from("<IIIBBH", data, position)
+                if (info & 0xF) == 2:
+                    end = data.index(b"\0", strings + name)
+                    self.functions[value & ~1] = data[strings + name:end].decode("latin-1")
+
+    def function(self, address):
+        return self.functions.get(address & ~1)
+
+
+def packets(stream):
+    """ITM packets of the stream : ("source", port, value), ("time", cycles since the previous time stamp, 0)
+    and ("overflow", 0, 0)."""
+    index = 0
+
+    def continuation(index):
+        value = 0
+        shift = 0
+        while index < len(stream):
+            byte = stream[index]
+            index += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if (byte & 0x80) == 0:
+                break
+        return value, index
+
+    while index < len(stream):
+        header = stream[index]
+        index += 1
+        if header in (0x00, 0x80):
+            # Synchronization
+            continue
+        if header == 0x70:
+            yield ("overflow", 0, 0)
+        elif (header & 0x03) != 0:
+            # Source packet, instrumentation when bit 2 is clear (hardware source otherwise)
+            size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+            payload = stream[index:index + size]
+            index += size
+            if len(payload) == size and (header & 0x04) == 0:
+                yield ("source", header >> 3, int.from_bytes(payload, "little"))
+        elif (header & 0xCF) == 0xC0:
+            # Local time stamp format 1 : up to 4 continuation bytes
+            value, index = continuation(index)
+            yield ("time", value, 0)
+        elif (header & 0x8F) == 0x00:
+            # Local time stamp format 2 : 3 bits in the header
+            yield ("time", (header >> 4) & 0x07, 0)
+        elif (header & 0x80) != 0:
+            # Global time stamp, extension : not used
+            _, index = continuation(index)
+
+
+def decode(stream, clock, elf, output):
+    signals = {port: (domain, enum_names(path, closing)) for port, (domain, path, closing) in SIGNAL_PORTS.items()}
+    tasks = task_names()
+    events = []
+    threads = {TID_TASK: "Tasks", TID_TIMER: "Timer callbacks"}
+    signal_tid = {}
+    signal_level = {}
+    pending = []
+    cycles = 0
+    task = None
+    timer = None
+
+    def name_of(port, signal):
+        domain, names = signals[port]
+        return "%s %s" % (domain, names[signal] if signal < len(names) else signal)
+
+    def run_name(code):
+        if code < TASK_NUMBER:
+            return tasks[code] if code < len(tasks) else "task %d" % code
+        name = elf.function(code) if elf is not None else None
+        return name if name is not None else "0x%08X" % code
+
+    def emit(time, kind, port, value):
+        nonlocal task, timer
+        ts = time * 1e6 / clock
+        if kind == "overflow":
+            events.append({"name": "ITM overflow", "ph": "i", "s": "g", "ts": ts, "pid": 1, "tid": TID_TASK})
+            return
+        if port == RUN_PORT:
+            # A timer callback runs within the timer server task (or an interrupt), on its own track
+            if timer is not None and value != timer:
+                events.append({"name": run_name(timer), "ph": "E", "ts": ts, "pid": 1, "tid": TID_TIMER})
+                timer = None
+            if value < TASK_NUMBER:
+                if task != value:
+                    if task is not None:
+                        events.append({"name": run_name(task), "ph": "E", "ts": ts, "pid": 1, "tid": TID_TASK})
+                    events.append({"name": run_name(value), "ph": "B", "ts": ts, "pid": 1, "tid": TID_TASK})
+                    task = value
+            elif value == RUN_IDLE:
+                if task is not None:
+                    events.append({"name": run_name(task), "ph": "E", "ts": ts, "pid": 1, "tid": TID_TASK})
+                    task = None
+            elif timer is None:
+                events.append({"name": run_name(value), "ph": "B", "ts": ts, "pid": 1, "tid": TID_TIMER})
+                timer = value
+            return
+        if port not in signals:
+            return
+        signal = value & 0xFF
+        action = (value >> 8) & 0x03
+        key = (port, signal)
+        if key not in signal_tid:
+            signal_tid[key] = TID_SIGNAL_FIRST + len(signal_tid)
+            threads[signal_tid[key]] = name_of(port, signal)
+        tid = signal_tid[key]
+        name = name_of(port, signal)
+        if action == ACTION_TOGGLE:
+            events.append({"name": name, "ph": "i", "s": "t", "ts": ts, "pid": 1, "tid": tid})
+        elif action == ACTION_SET and not signal_level.get(key, False):
+            signal_level[key] = True
+            events.append({"name": name, "ph": "B", "ts": ts, "pid": 1, "tid": tid})
+        elif action == ACTION_RESET and signal_level.get(key, False):
+            signal_level[key] = False
+            events.append({"name": name, "ph": "E", "ts": ts, "pid": 1, "tid": tid})
+
+    # The local time stamp follows the packets it applies to
+    for kind, first, second in packets(stream):
+        if kind == "time":
+            cycles += first
+            for packet in pending:
+                emit(cycles, *packet)
+            pending = []
+        else:
+            pending.append((kind, first, second))
+    for packet in pending:
+        emit(cycles, *packet)
+
+    metadata = [{"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": name}}
+                for tid, name in threads.items()]
+    metadata.append({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "STM32WBA"}})
+    json.dump({"traceEvents": metadata + events, "displayTimeUnit": "ns"}, output)
+    output.write("\n")
+
+
+def main(argv):
+    if len(argv) not in (2, 3, 4):
+        print("usage: itm_timeline.py <core clock Hz> [application.elf] [capture.swo]")
+        return 1
+
+    clock = float(argv[1])
+    elf = Elf(argv[2]) if len(argv) >= 3 and argv[2] != "-" else None
+    if len(argv) == 4:
+        with open(argv[3], "rb") as f:
+            stream = f.read()
+    else:
+        stream = sys.stdin.buffer.read()
+
+    decode(stream, clock, elf, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    log_decode.py
+  * @author  MCD Application Team
+  * @brief   Render the binary traces of the log module (CFG_LOG_BINARY_SUPPORTED)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 log_decode.py <application.elf> [capture.bin]
+
+  The capture is the raw byte stream of the log UART (stdin when not given).
+  Each binary trace is:
+      0xA5, payload size, verbose level, region, time stamp (32 bits), format string address (32 bits), payload
+  The format string is read from the ELF file and the payload holds the arguments: 4 bytes for the
+  integers and pointers, 8 bytes for the 64 bits integers and the floating numbers, null terminated
+  strings. The bytes outside the binary traces are printed as they are.
+"""
+
+import re
+import struct
+import sys
+
+SYNC_CHAR = 0xA5
+HEADER_SIZE = 12
+
+LEVELS = ["INFO", "ERROR", "WARNING", "DEBUG"]
+REGIONS = ["BLE", "SYSTEM", "APP", "LINKLAYER", "MAC", "ZIGBEE", "THREAD", "RTOS"]
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+)?)?(hh|h|ll|l|L|j|z|t)?([diouxXcsfFeEgGaAp%])")
+
+
+class Elf:
+    """Minimal ELF32 little-endian reader, enough to get the strings of the loaded sections."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError(path + " is not an ELF32 file")
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for index in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", self.data,
+                                                                        shoff + index * shentsize)
+            # Allocated sections with content (not .bss)
+            if (flags & 0x2) != 0 and sh_type != 8 and size != 0:
+                self.sections.append((addr, offset, size))
+
+    def string(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.index(b"\0", start, offset + size)
+                return self.data[start:end].decode("latin-1")
+        return None
+
+
+def render(text, payload):
+    """Apply the C format string on the arguments found in the payload."""
+    position = 0
+    result = ""
+    last = 0
+
+    def take(size):
+        nonlocal position
+        value = payload[position:position + size]
+        position += size
+        return value if len(value) == size else None
+
+    def word():
+        value = take(4)
+        return struct.unpack("<I", value)[0] if value is not None else 0
+
+    for match in CONVERSION.finditer(text):
+        result += text[last:match.start()]
+        last = match.end()
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == "%":
+            result += "%"
+            continue
+        if width == "*":
+            width = str(struct.unpack("<i", struct.pack("<I", word()))[0])
+        if precision == "*":
+            precision = str(word())
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+
+        if conversion == "s":
+            end = payload.find(b"\0", position)
+            end = len(payload) if end < 0 else end
+            value = payload[position:end].decode("latin-1")
+            position = end + 1
+            result += (spec + "s") % value
+        elif conversion in "fFeEgGaA":
+            value = take(8)
+            value = struct.unpack("<d", value)[0] if value is not None else 0.0
+            result += (spec + (conversion if conversion not in "aA" else "e")) % value
+        elif conversion == "p":
+            result += "0x%08X" % word()
+        else:
+            if length in ("ll", "j"):
+                value = take(8)
+                value = struct.unpack("<Q", value)[0] if value is not None else 0
+                bits = 64
+            else:
+                value = word()
+                bits = 32
+            if conversion in "di" and value >= (1 << (bits - 1)):
+                value -= (1 << bits)
+            if conversion == "c":
+                result += (spec + "c") % chr(value & 0xFF)
+            else:
+                result += (spec + ("d" if conversion in "diu" else conversion)) % value
+
+    return result + text[last:]
+
+
+def decode(elf, stream, output):
+    index = 0
+    text = bytearray()
+    while index < len(stream):
+        if stream[index] != SYNC_CHAR or index + HEADER_SIZE > len(stream):
+            text.append(stream[index])
+            index += 1
+            continue
+
+        size, level, region, timestamp, address = struct.unpack_from("<BBBII", stream, index + 1)
+        fmt = elf.string(address)
+        if fmt is None or index + HEADER_SIZE + size > len(stream):
+            # Not a binary trace
+            text.append(stream[index])
+            index += 1
+            continue
+
+        if text:
+            output.write(text.decode("latin-1"))
+            text = bytearray()
+        payload = bytes(stream[index + HEADER_SIZE:index + HEADER_SIZE + size])
+        line = render(fmt, payload)
+        output.write("[{:>10}] {}/{}: {}".format(timestamp,
+                                                 REGIONS[region] if region < len(REGIONS) else region,
+                                                 LEVELS[level] if level < len(LEVELS) else level,
+                                                 line))
+        if not line.endswith("\n"):
+            output.write("\n")
+        index += HEADER_SIZE + size
+
+    if text:
+        output.write(text.decode("latin-1"))
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        print("usage: log_decode.py <application.elf> [capture.bin]")
+        return 1
+
+    elf = Elf(argv[1])
+    if len(argv) == 3:
+        with open(argv[2], "rb") as f:
+            stream = f.read()
+    else:
+        stream = sys.stdin.buffer.read()
+
+    decode(elf, stream, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    mem_report.py
+  * @author  MCD Application Team
+  * @brief   Static RAM and FLASH footprint per module, from the linker map file
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Run as post-build step of the STM32CubeIDE project (from the build directory):
+      python3 ../mem_report.py <project>.map <project>_memory.json
+
+  The report is a JSON file: usage of each memory region, footprint of each module
+  (library archive or source folder) and of some notable buffers. When the report
+  already exists, it is kept as <report>.prev and the differences are printed.
+"""
+
+import json
+import os
+import re
+import sys
+
+# Notable buffers reported on their own: name -> input section (with -fdata-sections)
+ITEMS = {
+    "AMM pool": ".bss.AMM_Pool",
+    "Trace FIFO": ".bss.ADV_TRACE_Buffer",
+    "Heap and stack": "._user_heap_stack",
+}
+
+# Output sections that are not loaded in the target
+DEBUG_SECTION = re.compile(r"^\.(debug|comment|ARM\.attributes|stab|note)")
+
+REGION_LINE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+# [name] address size [object file | load address]
+ADDRESS_LINE = re.compile(r"^\s*(\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s*(.*)$")
+
+
+def module_of(path):
+    """Name of the module owning an object file: library archive or top source folder."""
+    path = path.strip().replace("\\", "/")
+    archive = re.match(r"^(.*\.a)\(.*\)$", path)
+    if archive:
+        return os.path.basename(archive.group(1))
+    parts = [p for p in path.split("/") if p not in ("", ".", "..")]
+    if len(parts) > 1 and parts[0] in ("Middlewares", "Projects", "Drivers"):
+        return "/".join(parts[:3]) if parts[0] == "Middlewares" else "/".join(parts[:2])
+    if len(parts) > 1:
+        return parts[0]
+    return "Others"
+
+
+def parse_map(map_file):
+    """Memory regions, output sections (name, address, size, load address) and input sections
+       (output section, name, address, size, load address, module) of a GNU ld map file."""
+    regions = []
+    outputs = []
+    inputs = []
+
+    with open(map_file, "r", errors="replace") as f:
+        lines = f.read().splitlines()
+
+    index = 0
+    while index < len(lines) and not lines[index].startswith("Memory Configuration"):
+        index += 1
+    while index < len(lines) and not lines[index].startswith("Linker script and memory map"):
+        match = REGION_LINE.match(lines[index])
+        if match and match.group(1) not in ("Name", "*default*"):
+            regions.append({"name": match.group(1),
+                            "origin": int(match.group(2), 16),
+                            "length": int(match.group(3), 16)})
+        index += 1
+
+    output = None
+    load_offset = None
+    name = None
+    for line in lines[index:]:
+        if not line.startswith(" "):
+            # Output section, its address and size may be on the next line
+            match = re.match(r"^(\.\S+)(.*)$", line)
+            output = match.group(1) if match else None
+            name = None
+            load_offset = None
+            if output is None or DEBUG_SECTION.match(output):
+                output = None
+                continue
+            line = match.group(2)
+            if not line.strip():
+                continue
+
+        if output is None:
+            continue
+
+        match = ADDRESS_LINE.match(line)
+        if match is None:
+            # Input section name alone, its address and size are on the next line
+            match = re.match(r"^ (\S+)$", line)
+            name = match.group(1) if match else None
+            continue
+
+        field, address, size, rest = match.group(1), int(match.group(2), 16), int(match.group(3), 16), match.group(4)
+        if field is None and name is None and (not outputs or outputs[-1][0] != output):
+            # Address and size of the output section
+            load = re.match(r"^load address 0x([0-9a-fA-F]+)", rest)
+            load_offset = (int(load.group(1), 16) - address) if load else None
+            outputs.append((output, address, size, (address + load_offset) if load else None))
+            continue
+
+        if field is not None:
+            name = field
+        if name is not None and not name.startswith("*") and size != 0 and rest:
+            load = (address + load_offset) if load_offset is not None else None
+            inputs.append((output, name, address, size, load, module_of(rest)))
+        name = None
+
+    return regions, outputs, inputs
+
+
+def region_of(regions, address):
+    for region in regions:
+        if region["origin"] <= address < region["origin"] + region["length"]:
+            return region["name"]
+    return None
+
+
+def regions_used(regions, address, load):
+    """Regions occupied by a section: run-time address, plus load address for initialized data."""
+    used = [region_of(regions, address)]
+    if load is not None and region_of(regions, load) != used[0]:
+        used.append(region_of(regions, load))
+    return [region for region in used if region is not None]
+
+
+def build_report(regions, outputs, inputs):
+    report = {"regions": {}, "modules": {}, "items": {}}
+
+    for region in regions:
+        report["regions"][region["name"]] = {"size": region["length"], "used": 0}
+
+    for output, address, size, load in outputs:
+        for region in regions_used(regions, address, load):
+            report["regions"][region]["used"] += size
+
+    for output, name, address, size, load, module in inputs:
+        footprint = report["modules"].setdefault(module, {})
+        for region in regions_used(regions, address, load):
+            footprint[region] = footprint.get(region, 0) + size
+
+    for item, section in ITEMS.items():
+        report["items"][item] = sum([i[3] for i in inputs if i[1] == section]
+                                    + [o[2] for o in outputs if o[0] == section])
+
+    report["modules"] = dict(sorted(report["modules"].items(),
+                                    key=lambda m: -sum(m[1].values())))
+    return report
+
+
+def print_report(report, previous):
+    def delta(new, old):
+        return "" if old is None or new == old else " ({:+d})".format(new - old)
+
+    prev_regions = previous.get("regions", {}) if previous else {}
+    prev_modules = previous.get("modules", {}) if previous else {}
+    prev_items = previous.get("items", {}) if previous else {}
+
+    print("Memory footprint:")
+    for name, region in report["regions"].items():
+        old = prev_regions.get(name, {}).get("used") if previous else None
+        print("  {:<12} {:>8} / {:>8} bytes{}".format(name, region["used"], region["size"],
+                                                   delta(region["used"], old)))
+    for name, footprint in report["modules"].items():
+        sizes = []
+        for region, size in footprint.items():
+            old = prev_modules.get(name, {}).get(region, 0) if previous else None
+            sizes.append("{} {}{}".format(region, size, delta(size, old)))
+        print("  {:<40} {}".format(name, ", ".join(sizes)))
+    for name, size in report["items"].items():
+        old = prev_items.get(name) if previous else None
+        print("  {:<40} {}{}".format(name, size, delta(size, old)))
+
+
+def main(argv):
+    if len(argv) != 3:
+        print("usage: mem_report.py <map file> <json report>")
+        return 1
+
+    regions, outputs, inputs = parse_map(argv[1])
+    if not regions:
+        print("mem_report: no memory configuration found in " + argv[1])
+        return 1
+    report = build_report(regions, outputs, inputs)
+
+    previous = None
+    if os.path.exists(argv[2]):
+        with open(argv[2], "r") as f:
+            try:
+                previous = json.load(f)
+            except ValueError:
+                previous = None
+        os.replace(argv[2], argv[2] + ".prev")
+
+    with open(argv[2], "w") as f:
+        json.dump(report, f, indent=2)
+        f.write("\n")
+
+    print_report(report, previous)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    perf_gate.py
+  * @author  MCD Application Team
+  * @brief   Performance regression gate : PERFSNAP snapshots around a traffic
+  *          run, compared to a baseline
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 perf_gate.py <serial port> record <baseline> [traffic commands]
+      python3 perf_gate.py <serial port> check <baseline> [tolerance %]
+      python3 perf_gate.py <serial port> snapshot
+
+  The device (CFG_PERF_SNAPSHOT_SUPPORTED) must have joined. A PERFSNAP is taken, then the traffic commands are sent
+  (default 'TRAFFIC BURST 8;TRAFFIC PERIOD 100;TRAFFIC SIZE 64;TRAFFIC DURATION 60;TRAFFIC START', separated by ';'),
+  the run is waited (DURATION, plus 5 s) and a second PERFSNAP is taken. The counters are cumulated since the boot :
+  the run is the difference of the two snapshots, the levels (peaks, loads, sizes) are taken from the second one.
+
+  record : the run (commands, difference and levels) is written in the baseline (JSON).
+  check  : the run of the baseline is replayed, each metric of the baseline is compared (default tolerance 10 %,
+           plus a slack of 2 for the small counts), the regressions are listed and the exit code is 1 if any.
+  snapshot : one PERFSNAP, printed in JSON.
+"""
+
+import json
+import re
+import sys
+import time
+
+TRAFFIC = "TRAFFIC BURST 8;TRAFFIC PERIOD 100;TRAFFIC SIZE 64;TRAFFIC DURATION 60;TRAFFIC START"
+TOLERANCE = 10.0
+SLACK = 2
+SNAPSHOT_TIMEOUT = 5.0
+
+# Metrics whose value is a level, not a counter cumulated since the boot
+LEVELS = re.compile(r"(_peak|_max|_max_fill|_used_vm\d+|_peak_vm\d+|^cpu_load_|^mac_buffer_.*_peak)")
+
+# Metrics whose increase is an improvement (all the other ones : a decrease is)
+HIGHER_BETTER = re.compile(r"(^mac_tx_ok$|^aps_ucast_success$|^lpm_residency_mode[12]$)")
+
+
+class Device:
+    """Text commands and log lines of the serial link."""
+
+    def __init__(self, port):
+        import serial
+        self.port = serial.Serial(port, 115200, timeout=0.05)
+        self.text = bytearray()
+
+    def command(self, text):
+        self.port.write(text.encode("ascii") + b"\r")
+
+    def lines(self):
+        self.text += self.port.read(256)
+        while b"\n" in self.text:
+            index = self.text.index(b"\n")
+            line = self.text[:index].decode("latin-1").strip()
+            del self.text[:index + 1]
+            yield line
+
+    def snapshot(self):
+        """Metrics of a PERFSNAP : {metric: (value, unit)}."""
+        metrics = {}
+        self.command("PERFSNAP")
+        deadline = time.monotonic() + SNAPSHOT_TIMEOUT
+        while time.monotonic() < deadline:
+            for line in self.lines():
+                index = line.find("PERFSNAP,")
+                if index < 0:
+                    continue
+                fields = line[index:].split(",")
+                if fields[1] == "end":
+                    return metrics
+                if len(fields) >= 4 and fields[1] != "metric":
+                    try:
+                        metrics[fields[1]] = (int(fields[2]), fields[3])
+                    except ValueError:
+                        pass
+        raise RuntimeError("no PERFSNAP answer (CFG_PERF_SNAPSHOT_SUPPORTED ?)")
+
+    def wait(self, seconds):
+        end = time.monotonic() + seconds
+        while time.monotonic() < end:
+            for _ in self.lines():
+                pass
+
+
+def duration(commands):
+    for text in commands:
+        fields = text.split()
+        if len(fields) == 3 and fields[0] == "TRAFFIC" and fields[1] == "DURATION":
+            return int(fields[2])
+    return 60
+
+
+def run(device, commands):
+    """Difference of the counters and levels during the traffic run."""
+    before = device.snapshot()
+    for text in commands:
+        device.command(text)
+        device.wait(0.2)
+    device.wait(duration(commands) + 5)
+    after = device.snapshot()
+
+    result = {}
+    for metric, (value, unit) in after.items():
+        if LEVELS.search(metric) or metric not in before:
+            result[metric] = {"value": value, "unit": unit}
+        else:
+            # Negative for the counters reset during the run (CRYPTOSTATS) : not compared
+            result[metric] = {"value": value - before[metric][0], "unit": unit}
+    return result
+
+
+def compare(baseline, measure, tolerance):
+    regressions = []
+    print("| Metric | Baseline | Run | Difference |")
+    print("|---|---|---|---|")
+    for metric, reference in sorted(baseline.items()):
+        current = measure.get(metric)
+        if current is None:
+            print("| {} | {} | - | |".format(metric, reference["value"]))
+            continue
+        old, new = reference["value"], current["value"]
+        if old < 0 or new < 0:
+            continue
+        delta = new - old
+        percent = (100.0 * delta / old) if old != 0 else 0.0
+        limit = abs(old) * tolerance / 100.0 + SLACK
+        worse = (-delta if HIGHER_BETTER.search(metric) else delta) > limit
+        cell = "{:+d} ({:+.1f} %)".format(delta, percent)
+        if worse:
+            cell += " **regression**"
+            regressions.append(metric)
+        print("| {} | {} {} | {} {} | {} |".format(metric, old, reference["unit"], new, current["unit"], cell))
+    return regressions
+
+
+def main(argv):
+    if len(argv) < 3 or argv[2] not in ("record", "check", "snapshot"):
+        print(__doc__.split("Usage:")[1])
+        return 1
+
+    device = Device(argv[1])
+    if argv[2] == "snapshot":
+        print(json.dumps({metric: {"value": value, "unit": unit}
+                          for metric, (value, unit) in device.snapshot().items()}, indent=2))
+        return 0
+
+    if len(argv) < 4:
+        print(__doc__.split("Usage:")[1])
+        return 1
+
+    if argv[2] == "record":
+        commands = (argv[4] if len(argv) > 4 else TRAFFIC).split(";")
+        with open(argv[3], "w") as f:
+            json.dump({"commands": commands, "metrics": run(device, commands)}, f, indent=2)
+        print("perf_gate: baseline written in " + argv[3])
+        return 0
+
+    with open(argv[3], "r") as f:
+        baseline = json.load(f)
+    tolerance = float(argv[4]) if len(argv) > 4 else TOLERANCE
+    regressions = compare(baseline["metrics"], run(device, baseline["commands"]), tolerance)
+    if regressions:
+        print("perf_gate: {} regression(s) : {}".format(len(regressions), ", ".join(regressions)))
+        return 1
+    print("perf_gate: no regression")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
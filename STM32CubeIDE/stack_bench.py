@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  ******************************************************************************
+  * @file    stack_bench.py
+  * @author  MCD Application Team
+  * @brief   Comparison table of the Zigbee stack variants (R23, R22, R22 SE)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+
+  Usage:
+      python3 stack_bench.py <memory report>:<log capture> [<memory report>:<log capture> ...]
+
+  One pair per build configuration (Debug, Debug_R22, Debug_R22_SE): the JSON report written by mem_report.py
+  after the build, and the capture of the trace UART during the standard run of that build:
+      1. Reset, wait for the Startup (join_time, measured from the first tentative).
+      2. LATRESET, then 100 Toggle with Button1 or TRAFFIC BURST 1, PERIOD 1000, DURATION 100, START (latency).
+      3. TRAFFIC BURST 8, PERIOD 100, SIZE 64, DURATION 60, START (sustained APS throughput of the last run).
+      4. STACKBENCH.
+  The table (Markdown) holds the footprint and the STACKBENCH figures of each variant, with the difference to the
+  first one.
+"""
+
+import json
+import sys
+
+# Rows of the table : (label, source, key, unit)
+ROWS = [
+    ("Flash", "memory", "FLASH", "bytes"),
+    ("RAM", "memory", "RAM", "bytes"),
+    ("Join time", "bench", "join_time", "ms"),
+    ("Join attempts", "bench", "join_attempts", ""),
+    ("Toggle latency avg", "bench", "toggle_avg", "ms"),
+    ("Toggle latency p50", "bench", "toggle_p50", "ms"),
+    ("Toggle latency p99", "bench", "toggle_p99", "ms"),
+    ("APS throughput", "bench", "aps_throughput", "bps"),
+    ("Zigbee heap peak", "bench", "heap_peak", "bytes"),
+]
+
+
+def read_memory(path):
+    """Used size of each memory region of a mem_report.py report."""
+    with open(path, "r") as f:
+        report = json.load(f)
+    return {name: region["used"] for name, region in report.get("regions", {}).items()}
+
+
+def read_bench(path):
+    """Variant name and figures of the last STACKBENCH output of a log capture."""
+    variant = None
+    figures = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            index = line.find("STACKBENCH,")
+            if index < 0:
+                continue
+            fields = line[index:].strip().split(",")
+            if len(fields) >= 3 and fields[1] == "stack":
+                variant = fields[2]
+                figures = {}
+            elif len(fields) >= 3 and fields[1] not in ("metric", "end"):
+                try:
+                    figures[fields[1]] = int(fields[2])
+                except ValueError:
+                    pass
+    return variant, figures
+
+
+def print_table(columns):
+    names = [name for name, _, _ in columns]
+    print("| Metric | " + " | ".join(names) + " |")
+    print("|---|" + "---|" * len(names))
+    for label, source, key, unit in ROWS:
+        cells = []
+        reference = None
+        for _, memory, bench in columns:
+            value = (memory if source == "memory" else bench).get(key)
+            if value is None:
+                cells.append("-")
+                continue
+            cell = "{} {}".format(value, unit).strip()
+            if reference is None:
+                reference = value
+            elif reference != 0:
+                cell += " ({:+.1f} %)".format(100.0 * (value - reference) / reference)
+            cells.append(cell)
+        print("| {} | {} |".format(label, " | ".join(cells)))
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    columns = []
+    for argument in argv[1:]:
+        if ":" not in argument:
+            print("stack_bench: expected <memory report>:<log capture>, got " + argument)
+            return 1
+        memory_path, log_path = argument.rsplit(":", 1)
+        variant, bench = read_bench(log_path)
+        if variant is None:
+            print("stack_bench: no STACKBENCH output in " + log_path)
+            return 1
+        columns.append((variant, read_memory(memory_path), bench))
+
+    print_table(columns)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,827 @@
+/**
+  ******************************************************************************
+  * @file    app_ble_diag.c
+  * @author  MCD Application Team
+  * @brief   BLE diagnostics export of the concurrent build : a GATT server
+  *          (one link) streams the logs, the frame log records and the
+  *          performance snapshot to a phone, with notifications of the
+  *          longest ATT MTU on the LE 2M PHY, instead of the UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_entry.h"
+#include "app_ble_diag.h"
+
+#include "stm32_rtos.h"
+
+#if (CFG_BLE_DIAG_SUPPORTED != 0)
+#include "app_frame_log.h"
+#include "ble_plat.h"
+#include "ll_sys.h"
+#include "blestack.h"
+#include "ble_core.h"
+#include "auto/ble_raw_api.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BLE_DIAG_LINK_NB                (1u)
+#define BLE_DIAG_ATTRIBUTE_NB           (5u)      /* Control : declaration, value. Data : declaration, value, CCCD */
+#define BLE_DIAG_GATT_ATTRIBUTE_NB      ( 9u + BLE_DIAG_ATTRIBUTE_NB )    /* With the GAP and GATT services */
+#define BLE_DIAG_GATT_SERVICE_NB        ( 2u + 1u )
+#define BLE_DIAG_ATT_VALUE_SIZE         (512u)    /* Values of the GAP and GATT services and of the two characteristics */
+#define BLE_DIAG_CONTROL_SIZE_MAX       (20u)
+#define BLE_DIAG_VALUE_SIZE_MAX         (243u)    /* Longest value of a notification (one LL data PDU of 251 bytes) */
+#define BLE_DIAG_PREP_WRITE_NB          BLE_PREP_WRITE_X_ATT( BLE_DIAG_CONTROL_SIZE_MAX )
+#define BLE_DIAG_MBLOCK_MARGIN          (0x15u)   /* Notifications queued ahead of the connection events */
+#define BLE_DIAG_MBLOCK_NB              ( BLE_MBLOCKS_CALC( BLE_DIAG_PREP_WRITE_NB, CFG_BLE_DIAG_ATT_MTU, BLE_DIAG_LINK_NB ) \
+                                          + BLE_DIAG_MBLOCK_MARGIN )
+#define BLE_DIAG_HOST_BUFFER_SIZE       BLE_TOTAL_BUFFER_SIZE( BLE_DIAG_LINK_NB, BLE_DIAG_MBLOCK_NB )
+#define BLE_DIAG_GATT_BUFFER_SIZE       BLE_TOTAL_BUFFER_SIZE_GATT( BLE_DIAG_GATT_ATTRIBUTE_NB, BLE_DIAG_GATT_SERVICE_NB, \
+                                                                    BLE_DIAG_ATT_VALUE_SIZE )
+
+#define BLE_DIAG_LL_DATA_LENGTH         (251u)    /* Bytes of a LL data PDU */
+#define BLE_DIAG_LL_DATA_TIME           (2120u)   /* us, LL data PDU of 251 bytes on the LE 1M PHY */
+#define BLE_DIAG_ATT_HEADER_SIZE        (3u)      /* Opcode and handle of a notification */
+#define BLE_DIAG_UPDATE_NOTIFICATION    (0x01u)
+#define BLE_DIAG_CCCD_NOTIFICATION      (0x01u)
+#define BLE_DIAG_CONNECTION_NONE        (0xFFFFu)
+#define BLE_DIAG_RECORD_HEADER_SIZE     (2u)      /* Source and size of a record */
+#define BLE_DIAG_NOTIFICATION_PER_RUN   (8u)      /* Notifications given to the host by one run of the task */
+#define BLE_DIAG_UUID_ID_OFFSET         (12u)
+#define BLE_DIAG_DIVC( x, y )           ( ( (x) + (y) - 1u ) / (y) )
+
+#define BLE_DIAG_UUID_SERVICE           (0x00u)
+#define BLE_DIAG_UUID_CONTROL           (0x01u)
+#define BLE_DIAG_UUID_DATA              (0x02u)
+
+/* Private variables ---------------------------------------------------------*/
+static APP_BLE_DIAG_State_t   stBleDiagState;
+static uint16_t               iBleDiagConnection = BLE_DIAG_CONNECTION_NONE;
+static uint16_t               iBleDiagServiceHandle;
+static uint16_t               iBleDiagControlHandle;    /* Declaration of the control characteristic */
+static uint16_t               iBleDiagDataHandle;       /* Declaration of the data characteristic */
+static bool                   bBleDiagAdvertise;        /* Deferred to the task : advertising (re)started */
+static bool                   bBleDiagLinkSetup;        /* Deferred to the task : PHY, data length and MTU of a new link */
+static bool                   bBleDiagSnapshotRequest;
+static bool                   bBleDiagFrameLogRequest;
+static bool                   bBleDiagSnapshot;         /* Snapshot printed : its logs are captured */
+static bool                   bBleDiagTxPoolFull;       /* Waiting for ACI_GATT_TX_POOL_AVAILABLE_EVENT */
+static CallBack_Capture       * pfBleDiagNextCapture;   /* Capture function registered before (crash log) */
+
+/* Records waiting for the link : written from any context, read by the task */
+static uint8_t                acBleDiagFifo[CFG_BLE_DIAG_FIFO_SIZE];
+static volatile uint32_t      lBleDiagFifoWrite;
+static volatile uint32_t      lBleDiagFifoRead;
+
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+static APP_FRAME_LOG_Record_t astBleDiagFrames[CFG_FRAME_LOG_RECORD_NB];
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+/* Local name in the advertising data (AD type then the name) */
+static uint8_t                acBleDiagLocalName[sizeof( CFG_BLE_DIAG_DEVICE_NAME )];
+
+/* Buffers of the host */
+static uint32_t               alBleDiagHostBuffer[BLE_DIAG_DIVC( BLE_DIAG_HOST_BUFFER_SIZE, 4u )];
+static uint32_t               alBleDiagGattBuffer[BLE_DIAG_DIVC( BLE_DIAG_GATT_BUFFER_SIZE, 4u )];
+
+/* 128-bit UUIDs (LSB first) : 5A4201xx-7E4C-11E1-8A3B-0002A5D5C51B, xx for the service and the characteristics */
+static const uint8_t          acBleDiagUuid[16] = { 0x1B, 0xC5, 0xD5, 0xA5, 0x02, 0x00, 0x3B, 0x8A,
+                                                    0xE1, 0x11, 0x4C, 0x7E, 0x00, 0x01, 0x42, 0x5A };
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BleDiagHostTask         ( void );
+static void     BleDiagTask             ( void );
+static bool     BleDiagGattInit         ( void );
+static bool     BleDiagCheck            ( tBleStatus eStatus, const char * szCommand );
+static void     BleDiagGetAddress       ( uint8_t * pAddress );
+static void     BleDiagAdvertise        ( void );
+static void     BleDiagLinkSetup        ( void );
+static void     BleDiagNotify           ( void );
+static void     BleDiagCommand          ( uint8_t cCommand );
+static void     BleDiagSnapshot         ( void );
+static void     BleDiagFrameLog         ( void );
+static void     BleDiagFifoPush         ( uint8_t cSource, const uint8_t * pData, uint16_t iSize );
+static void     BleDiagFifoFlush        ( void );
+static void     BleDiagCapture          ( const uint8_t * pFrame, uint16_t iSize );
+static void     BleDiagConnected        ( uint16_t iConnection );
+static void     BleDiagDisconnected     ( const hci_disconnection_complete_event_rp0 * pstEvent );
+static void     BleDiagLeMetaEvent      ( uint8_t cSubEvent, const uint8_t * pData );
+static void     BleDiagVendorEvent      ( uint16_t iEvent, const uint8_t * pData );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Start of the host stack (it starts the BLE part of the link layer), of the GATT server and of the
+ *         advertising. To call after the capture function of the crash log is registered.
+ * @param  None
+ * @retval None
+ */
+void APP_BLE_DIAG_Init( void )
+{
+  BleStack_init_t   stInit;
+  tBleStatus        eStatus;
+
+  memset( &stInit, 0, sizeof( stInit ) );
+  stInit.bleStartRamAddress = (uint8_t *)alBleDiagHostBuffer;
+  stInit.total_buffer_size = BLE_DIAG_HOST_BUFFER_SIZE;
+  stInit.bleStartRamAddress_GATT = (uint8_t *)alBleDiagGattBuffer;
+  stInit.total_buffer_size_GATT = BLE_DIAG_GATT_BUFFER_SIZE;
+  stInit.numAttrRecord = BLE_DIAG_GATT_ATTRIBUTE_NB;
+  stInit.numAttrServ = BLE_DIAG_GATT_SERVICE_NB;
+  stInit.attrValueArrSize = BLE_DIAG_ATT_VALUE_SIZE;
+  stInit.numOfLinks = BLE_DIAG_LINK_NB;
+  stInit.prWriteListSize = BLE_DIAG_PREP_WRITE_NB;
+  stInit.mblockCount = BLE_DIAG_MBLOCK_NB;
+  stInit.attMtu = CFG_BLE_DIAG_ATT_MTU;
+  stInit.max_coc_mps = BLE_DEFAULT_ATT_MTU;
+  stInit.options = BLE_OPTIONS_DEV_NAME_READ_ONLY;
+
+  stBleDiagState.iPayloadSize = BLE_DEFAULT_ATT_MTU - BLE_DIAG_ATT_HEADER_SIZE;
+  stBleDiagState.cTxPhy = 1u;
+
+  /* The timers of the host and the host itself run in the host task */
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), UTIL_SEQ_RFU, BleDiagHostTask );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), UTIL_SEQ_RFU, BleDiagTask );
+
+  eStatus = BleStack_Init( &stInit );
+  if ( eStatus != BLE_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, BLE diag : host stack not started (0x%02X).", eStatus );
+    return;
+  }
+
+  if ( BleDiagGattInit() == false )
+  {
+    return;
+  }
+
+  /* The logs are given to the capture function of the crash log after ours */
+  pfBleDiagNextCapture = Log_Module_GetCaptureFunction();
+  Log_Module_RegisterCaptureFunction( BleDiagCapture );
+
+  bBleDiagAdvertise = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+  LOG_INFO_APP( "BLE diag : GATT server started (%s).", CFG_BLE_DIAG_DEVICE_NAME );
+}
+
+/**
+ * @brief  State of the BLE diagnostics export.
+ * @param  None
+ * @retval State
+ */
+const APP_BLE_DIAG_State_t * APP_BLE_DIAG_GetState( void )
+{
+  stBleDiagState.iFifoUsed = (uint16_t)( lBleDiagFifoWrite - lBleDiagFifoRead );
+
+  return &stBleDiagState;
+}
+
+/**
+ * @brief  BLE diagnostics serial command : BLEDIAG (state).
+ * @param  szCommand  Command received
+ * @retval True if the command is a BLE diagnostics command.
+ */
+bool APP_BLE_DIAG_SerialCmdExecute( const char * szCommand )
+{
+  BLE_PLAT_Stats_t  stPlatStats;
+
+  if ( strcmp( szCommand, "BLEDIAG" ) != 0 )
+  {
+    return false;
+  }
+
+  APP_BLE_DIAG_GetState();
+  BLE_PLAT_GetStats( &stPlatStats );
+
+  LOG_INFO_APP( "BLE diag : %s, notifications %s, logs %s, LE %dM PHY, %d bytes per notification, %d bytes waiting.",
+                ( stBleDiagState.bConnected ? "connected" : "advertising" ),
+                ( stBleDiagState.bNotifyEnabled ? "on" : "off" ), ( stBleDiagState.bLogStream ? "on" : "off" ),
+                stBleDiagState.cTxPhy, stBleDiagState.iPayloadSize, stBleDiagState.iFifoUsed );
+  LOG_INFO_APP( "BLE diag : %u connections, %u notifications, %u bytes, %u records dropped, %u TX pool full, %u errors.",
+                stBleDiagState.lConnectionNb, stBleDiagState.lNotificationNb, stBleDiagState.lByteNb,
+                stBleDiagState.lDroppedNb, stBleDiagState.lTxPoolFullNb, stBleDiagState.lErrorNb );
+  LOG_INFO_APP( "BLE diag : host timers %u started, %u expired, %u refused, %u PKA jobs, NVM %d bytes (%d refused).",
+                stPlatStats.lTimerStartNb, stPlatStats.lTimerExpiryNb, stPlatStats.lTimerFullNb, stPlatStats.lPkaJobNb,
+                stPlatStats.iNvmUsedSize, stPlatStats.iNvmFullNb );
+
+  return true;
+}
+
+/**
+ * @brief  Background process of the link layer : the host stack has to run.
+ * @param  None
+ * @retval None
+ */
+void HostStack_Process( void )
+{
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  Event or ACL data given by the host stack (from BleStack_Process).
+ * @param  data, length          HCI packet
+ * @param  ext_data, ext_length  End of a long packet (not used by our events)
+ * @retval BLE_STATUS_SUCCESS (packet consumed)
+ */
+uint8_t BLECB_Indication( const uint8_t * data, uint16_t length, const uint8_t * ext_data, uint16_t ext_length )
+{
+  UNUSED( ext_data );
+  UNUSED( ext_length );
+
+  if ( ( length < 3u ) || ( data[0] != HCI_EVENT_PKT_TYPE ) )
+  {
+    return BLE_STATUS_SUCCESS;
+  }
+
+  switch ( data[1] )
+  {
+    case HCI_DISCONNECTION_COMPLETE_EVT_CODE:
+        BleDiagDisconnected( (const hci_disconnection_complete_event_rp0 *)&data[3] );
+        break;
+
+    case HCI_LE_META_EVT_CODE:
+        BleDiagLeMetaEvent( data[3], &data[4] );
+        break;
+
+    case HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE:
+        BleDiagVendorEvent( (uint16_t)( data[3] | ( (uint16_t)data[4] << 8u ) ), &data[5] );
+        break;
+
+    default:
+        break;
+  }
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Host task : expired timers of the host then the host stack.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagHostTask( void )
+{
+  BLE_PLAT_TimerProcess();
+
+  if ( BleStack_Process() == BLE_SLEEPMODE_RUNNING )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+  }
+}
+
+/**
+ * @brief  Export task : BLE commands deferred from the events, commands of the phone, then notifications.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagTask( void )
+{
+  if ( bBleDiagAdvertise != false )
+  {
+    bBleDiagAdvertise = false;
+    BleDiagAdvertise();
+  }
+
+  if ( bBleDiagLinkSetup != false )
+  {
+    bBleDiagLinkSetup = false;
+    BleDiagLinkSetup();
+  }
+
+  if ( bBleDiagSnapshotRequest != false )
+  {
+    bBleDiagSnapshotRequest = false;
+    BleDiagSnapshot();
+  }
+
+  if ( bBleDiagFrameLogRequest != false )
+  {
+    bBleDiagFrameLogRequest = false;
+    BleDiagFrameLog();
+  }
+
+  BleDiagNotify();
+
+  /* The commands given to the host are processed by its task */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  Status of a BLE command (error logged and counted).
+ * @param  eStatus    Status returned by the command
+ * @param  szCommand  Name of the command
+ * @retval True on success.
+ */
+static bool BleDiagCheck( tBleStatus eStatus, const char * szCommand )
+{
+  if ( eStatus == BLE_STATUS_SUCCESS )
+  {
+    return true;
+  }
+
+  stBleDiagState.lErrorNb++;
+  LOG_ERROR_APP( "Error, BLE diag : %s (0x%02X).", szCommand, eStatus );
+
+  return false;
+}
+
+/**
+ * @brief  HCI, GAP and GATT of the host, then the diagnostics service (control and data characteristics).
+ * @param  None
+ * @retval True on success.
+ */
+static bool BleDiagGattInit( void )
+{
+  uint8_t       acAddress[6];
+  uint8_t       cNameLength = (uint8_t)( sizeof( CFG_BLE_DIAG_DEVICE_NAME ) - 1u );
+  uint16_t      iGapService, iGapName, iGapAppearance;
+  UUID_t        stUuid;
+  bool          bOk;
+
+  BleDiagGetAddress( acAddress );
+
+  acBleDiagLocalName[0] = AD_TYPE_COMPLETE_LOCAL_NAME;
+  memcpy( &acBleDiagLocalName[1], CFG_BLE_DIAG_DEVICE_NAME, cNameLength );
+
+  bOk = BleDiagCheck( HCI_RESET(), "HCI reset" );
+  bOk = bOk && BleDiagCheck( ACI_HAL_WRITE_CONFIG_DATA( CONFIG_DATA_PUBLIC_ADDRESS_OFFSET, sizeof( acAddress ),
+                                                        acAddress ), "public address" );
+  bOk = bOk && BleDiagCheck( HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH( BLE_DIAG_LL_DATA_LENGTH, BLE_DIAG_LL_DATA_TIME ),
+                             "default data length" );
+  bOk = bOk && BleDiagCheck( HCI_LE_SET_DEFAULT_PHY( 0u, ( HCI_TX_PHYS_LE_1M_PREF | HCI_TX_PHYS_LE_2M_PREF ),
+                                                     ( HCI_RX_PHYS_LE_1M_PREF | HCI_RX_PHYS_LE_2M_PREF ) ),
+                             "default PHY" );
+  bOk = bOk && BleDiagCheck( ACI_GATT_INIT(), "GATT init" );
+  bOk = bOk && BleDiagCheck( ACI_GAP_INIT( GAP_PERIPHERAL_ROLE, 0u, cNameLength, &iGapService, &iGapName,
+                                           &iGapAppearance ), "GAP init" );
+  bOk = bOk && BleDiagCheck( ACI_GATT_UPDATE_CHAR_VALUE( iGapService, iGapName, 0u, cNameLength,
+                                                         (const uint8_t *)CFG_BLE_DIAG_DEVICE_NAME ), "device name" );
+  bOk = bOk && BleDiagCheck( ACI_GAP_SET_IO_CAPABILITY( IO_CAP_NO_INPUT_NO_OUTPUT ), "IO capability" );
+
+  memcpy( stUuid.UUID_128, acBleDiagUuid, sizeof( acBleDiagUuid ) );
+  stUuid.UUID_128[BLE_DIAG_UUID_ID_OFFSET] = BLE_DIAG_UUID_SERVICE;
+  bOk = bOk && BleDiagCheck( ACI_GATT_ADD_SERVICE( UUID_TYPE_128, (const Service_UUID_t *)&stUuid, PRIMARY_SERVICE,
+                                                   ( 1u + BLE_DIAG_ATTRIBUTE_NB ), &iBleDiagServiceHandle ),
+                             "diagnostics service" );
+
+  stUuid.UUID_128[BLE_DIAG_UUID_ID_OFFSET] = BLE_DIAG_UUID_CONTROL;
+  bOk = bOk && BleDiagCheck( ACI_GATT_ADD_CHAR( iBleDiagServiceHandle, UUID_TYPE_128, (const Char_UUID_t *)&stUuid,
+                                                BLE_DIAG_CONTROL_SIZE_MAX, ( CHAR_PROP_WRITE | CHAR_PROP_WRITE_WITHOUT_RESP ),
+                                                ATTR_PERMISSION_NONE, GATT_NOTIFY_ATTRIBUTE_WRITE, 16u,
+                                                CHAR_VALUE_LEN_VARIABLE, &iBleDiagControlHandle ),
+                             "control characteristic" );
+
+  stUuid.UUID_128[BLE_DIAG_UUID_ID_OFFSET] = BLE_DIAG_UUID_DATA;
+  bOk = bOk && BleDiagCheck( ACI_GATT_ADD_CHAR( iBleDiagServiceHandle, UUID_TYPE_128, (const Char_UUID_t *)&stUuid,
+                                                BLE_DIAG_VALUE_SIZE_MAX, CHAR_PROP_NOTIFY, ATTR_PERMISSION_NONE,
+                                                GATT_NOTIFY_ATTRIBUTE_WRITE, 16u, CHAR_VALUE_LEN_VARIABLE,
+                                                &iBleDiagDataHandle ),
+                             "data characteristic" );
+
+  return bOk;
+}
+
+/**
+ * @brief  Public address from the unique device number.
+ * @param  pAddress  Address (6 bytes, LSB first)
+ * @retval None
+ */
+static void BleDiagGetAddress( uint8_t * pAddress )
+{
+  uint32_t  lUdn = LL_FLASH_GetUDN();
+  uint32_t  lCompanyId = LL_FLASH_GetSTCompanyID();
+
+  pAddress[0] = (uint8_t)( lUdn & 0xFFu );
+  pAddress[1] = (uint8_t)( ( lUdn >> 8u ) & 0xFFu );
+  pAddress[2] = (uint8_t)LL_FLASH_GetDeviceID();
+  pAddress[3] = (uint8_t)( lCompanyId & 0xFFu );
+  pAddress[4] = (uint8_t)( ( lCompanyId >> 8u ) & 0xFFu );
+  pAddress[5] = (uint8_t)( ( lCompanyId >> 16u ) & 0xFFu );
+}
+
+/**
+ * @brief  Connectable advertising with the local name.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagAdvertise( void )
+{
+  BleDiagCheck( ACI_GAP_SET_DISCOVERABLE( ADV_IND, CFG_BLE_DIAG_ADV_INTERVAL_MIN, CFG_BLE_DIAG_ADV_INTERVAL_MAX,
+                                          GAP_PUBLIC_ADDR, HCI_ADV_FILTER_NO, sizeof( acBleDiagLocalName ),
+                                          acBleDiagLocalName, 0u, NULL, 0u, 0u ), "advertising" );
+}
+
+/**
+ * @brief  New link : longest LL data PDU, LE 2M PHY and longest ATT MTU, for the largest notifications.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagLinkSetup( void )
+{
+  BleDiagCheck( HCI_LE_SET_DATA_LENGTH( iBleDiagConnection, BLE_DIAG_LL_DATA_LENGTH, BLE_DIAG_LL_DATA_TIME ),
+                "data length" );
+  BleDiagCheck( HCI_LE_SET_PHY( iBleDiagConnection, 0u, HCI_TX_PHYS_LE_2M_PREF, HCI_RX_PHYS_LE_2M_PREF, 0u ), "PHY" );
+  BleDiagCheck( ACI_GATT_EXCHANGE_CONFIG( iBleDiagConnection ), "MTU exchange" );
+}
+
+/**
+ * @brief  Records of the FIFO given to the host as notifications, until the FIFO is empty or the TX pool of the host
+ *         is full. No log here : it would be captured in the FIFO.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagNotify( void )
+{
+  static uint8_t  acValue[BLE_DIAG_VALUE_SIZE_MAX];
+  uint32_t        lUsed, lRead, lIndex;
+  uint16_t        iSize;
+  tBleStatus      eStatus;
+  uint8_t         cNotification;
+
+  for ( cNotification = 0; cNotification < BLE_DIAG_NOTIFICATION_PER_RUN; cNotification++ )
+  {
+    if ( ( stBleDiagState.bConnected == false ) || ( stBleDiagState.bNotifyEnabled == false ) ||
+         ( bBleDiagTxPoolFull != false ) )
+    {
+      return;
+    }
+
+    lRead = lBleDiagFifoRead;
+    lUsed = lBleDiagFifoWrite - lRead;
+    if ( lUsed == 0u )
+    {
+      return;
+    }
+
+    iSize = (uint16_t)MIN( lUsed, stBleDiagState.iPayloadSize );
+    for ( lIndex = 0; lIndex < iSize; lIndex++ )
+    {
+      acValue[lIndex] = acBleDiagFifo[( lRead + lIndex ) % CFG_BLE_DIAG_FIFO_SIZE];
+    }
+
+    eStatus = ACI_GATT_UPDATE_CHAR_VALUE_EXT( iBleDiagConnection, iBleDiagServiceHandle, iBleDiagDataHandle,
+                                              BLE_DIAG_UPDATE_NOTIFICATION, iSize, 0u, (uint8_t)iSize, acValue );
+    if ( eStatus == BLE_STATUS_INSUFFICIENT_RESOURCES )
+    {
+      /* Retried on ACI_GATT_TX_POOL_AVAILABLE_EVENT */
+      bBleDiagTxPoolFull = true;
+      stBleDiagState.lTxPoolFullNb++;
+      return;
+    }
+
+    if ( eStatus != BLE_STATUS_SUCCESS )
+    {
+      /* The stream restarts on the next record */
+      stBleDiagState.lErrorNb++;
+      BleDiagFifoFlush();
+      return;
+    }
+
+    stBleDiagState.lNotificationNb++;
+    stBleDiagState.lByteNb += iSize;
+    lBleDiagFifoRead = lRead + iSize;
+  }
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+}
+
+/**
+ * @brief  Command written by the phone in the control characteristic (from BleStack_Process).
+ * @param  cCommand  APP_BLE_DIAG_CMD_xxx
+ * @retval None
+ */
+static void BleDiagCommand( uint8_t cCommand )
+{
+  switch ( cCommand )
+  {
+    case APP_BLE_DIAG_CMD_SNAPSHOT:
+        bBleDiagSnapshotRequest = true;
+        break;
+
+    case APP_BLE_DIAG_CMD_FRAME_LOG:
+        bBleDiagFrameLogRequest = true;
+        break;
+
+    case APP_BLE_DIAG_CMD_LOG_START:
+        stBleDiagState.bLogStream = true;
+        break;
+
+    case APP_BLE_DIAG_CMD_LOG_STOP:
+        stBleDiagState.bLogStream = false;
+        break;
+
+    default:
+        LOG_WARNING_APP( "BLE diag : unknown command 0x%02X.", cCommand );
+        return;
+  }
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+}
+
+/**
+ * @brief  Performance snapshot : its logs are captured with the snapshot source.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagSnapshot( void )
+{
+#if (CFG_PERF_SNAPSHOT_SUPPORTED != 0)
+  bBleDiagSnapshot = true;
+  APPE_PERF_PrintSnapshot();
+  bBleDiagSnapshot = false;
+#else /* (CFG_PERF_SNAPSHOT_SUPPORTED != 0) */
+  LOG_WARNING_APP( "BLE diag : performance snapshot not supported." );
+#endif /* (CFG_PERF_SNAPSHOT_SUPPORTED != 0) */
+}
+
+/**
+ * @brief  Records of the frame log, oldest first.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagFrameLog( void )
+{
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  uint32_t  lTotal, lCount, lFirst, lIndex;
+
+  lTotal = APP_FRAME_LOG_Copy( astBleDiagFrames );
+  lCount = MIN( lTotal, CFG_FRAME_LOG_RECORD_NB );
+  lFirst = lTotal - lCount;
+
+  for ( lIndex = 0; lIndex < lCount; lIndex++ )
+  {
+    BleDiagFifoPush( APP_BLE_DIAG_SOURCE_FRAME_LOG,
+                     (const uint8_t *)&astBleDiagFrames[( lFirst + lIndex ) % CFG_FRAME_LOG_RECORD_NB],
+                     sizeof( APP_FRAME_LOG_Record_t ) );
+  }
+#else /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+  LOG_WARNING_APP( "BLE diag : frame log not supported." );
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+}
+
+/**
+ * @brief  Record added to the FIFO (any context), dropped if the FIFO is full.
+ * @param  cSource  APP_BLE_DIAG_SOURCE_xxx
+ * @param  pData    Data of the record
+ * @param  iSize    Size of the data
+ * @retval None
+ */
+static void BleDiagFifoPush( uint8_t cSource, const uint8_t * pData, uint16_t iSize )
+{
+  uint32_t  lWrite, lIndex;
+
+  if ( iSize > UINT8_MAX )
+  {
+    stBleDiagState.lDroppedNb++;
+    return;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  lWrite = lBleDiagFifoWrite;
+  if ( ( CFG_BLE_DIAG_FIFO_SIZE - ( lWrite - lBleDiagFifoRead ) ) < ( iSize + BLE_DIAG_RECORD_HEADER_SIZE ) )
+  {
+    stBleDiagState.lDroppedNb++;
+  }
+  else
+  {
+    acBleDiagFifo[lWrite % CFG_BLE_DIAG_FIFO_SIZE] = cSource;
+    acBleDiagFifo[( lWrite + 1u ) % CFG_BLE_DIAG_FIFO_SIZE] = (uint8_t)iSize;
+    lWrite += BLE_DIAG_RECORD_HEADER_SIZE;
+    for ( lIndex = 0; lIndex < iSize; lIndex++ )
+    {
+      acBleDiagFifo[( lWrite + lIndex ) % CFG_BLE_DIAG_FIFO_SIZE] = pData[lIndex];
+    }
+    lBleDiagFifoWrite = lWrite + iSize;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+}
+
+/**
+ * @brief  Records waiting for the link dropped.
+ * @param  None
+ * @retval None
+ */
+static void BleDiagFifoFlush( void )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  lBleDiagFifoRead = lBleDiagFifoWrite;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief  Capture of the binary frame of a log (any context) : streamed if asked by the phone, then given to the
+ *         capture function registered before.
+ * @param  pFrame  Binary frame of the log
+ * @param  iSize   Size of the frame
+ * @retval None
+ */
+static void BleDiagCapture( const uint8_t * pFrame, uint16_t iSize )
+{
+  if ( ( stBleDiagState.bConnected != false ) && ( stBleDiagState.bNotifyEnabled != false ) )
+  {
+    if ( bBleDiagSnapshot != false )
+    {
+      BleDiagFifoPush( APP_BLE_DIAG_SOURCE_SNAPSHOT, pFrame, iSize );
+    }
+    else if ( stBleDiagState.bLogStream != false )
+    {
+      BleDiagFifoPush( APP_BLE_DIAG_SOURCE_LOG, pFrame, iSize );
+    }
+  }
+
+  if ( pfBleDiagNextCapture != NULL )
+  {
+    pfBleDiagNextCapture( pFrame, iSize );
+  }
+}
+
+/**
+ * @brief  New link : its setup is deferred to the task.
+ * @param  iConnection  Handle of the link
+ * @retval None
+ */
+static void BleDiagConnected( uint16_t iConnection )
+{
+  iBleDiagConnection = iConnection;
+  stBleDiagState.bConnected = true;
+  stBleDiagState.cTxPhy = 1u;
+  stBleDiagState.iPayloadSize = BLE_DEFAULT_ATT_MTU - BLE_DIAG_ATT_HEADER_SIZE;
+  stBleDiagState.lConnectionNb++;
+
+  bBleDiagLinkSetup = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+  LOG_INFO_APP( "BLE diag : connected (0x%04X).", iConnection );
+}
+
+/**
+ * @brief  End of the link : records dropped, advertising restarted by the task.
+ * @param  pstEvent  HCI_DISCONNECTION_COMPLETE_EVENT
+ * @retval None
+ */
+static void BleDiagDisconnected( const hci_disconnection_complete_event_rp0 * pstEvent )
+{
+  if ( ( pstEvent->Status != BLE_STATUS_SUCCESS ) || ( pstEvent->Connection_Handle != iBleDiagConnection ) )
+  {
+    return;
+  }
+
+  iBleDiagConnection = BLE_DIAG_CONNECTION_NONE;
+  stBleDiagState.bConnected = false;
+  stBleDiagState.bNotifyEnabled = false;
+  stBleDiagState.bLogStream = false;
+  bBleDiagTxPoolFull = false;
+  bBleDiagLinkSetup = false;
+  bBleDiagSnapshotRequest = false;
+  bBleDiagFrameLogRequest = false;
+  BleDiagFifoFlush();
+
+  bBleDiagAdvertise = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+  LOG_INFO_APP( "BLE diag : disconnected (reason 0x%02X).", pstEvent->Reason );
+}
+
+/**
+ * @brief  LE meta events : connection and PHY of the link.
+ * @param  cSubEvent  Subevent code
+ * @param  pData      Parameters of the subevent
+ * @retval None
+ */
+static void BleDiagLeMetaEvent( uint8_t cSubEvent, const uint8_t * pData )
+{
+  switch ( cSubEvent )
+  {
+    case HCI_LE_CONNECTION_COMPLETE_SUBEVT_CODE:
+        {
+          const hci_le_connection_complete_event_rp0 * pstEvent = (const hci_le_connection_complete_event_rp0 *)pData;
+
+          if ( pstEvent->Status == BLE_STATUS_SUCCESS )
+          {
+            BleDiagConnected( pstEvent->Connection_Handle );
+          }
+        }
+        break;
+
+    case HCI_LE_ENHANCED_CONNECTION_COMPLETE_SUBEVT_CODE:
+        {
+          const hci_le_enhanced_connection_complete_event_rp0 * pstEvent =
+            (const hci_le_enhanced_connection_complete_event_rp0 *)pData;
+
+          if ( pstEvent->Status == BLE_STATUS_SUCCESS )
+          {
+            BleDiagConnected( pstEvent->Connection_Handle );
+          }
+        }
+        break;
+
+    case HCI_LE_PHY_UPDATE_COMPLETE_SUBEVT_CODE:
+        {
+          const hci_le_phy_update_complete_event_rp0 * pstEvent = (const hci_le_phy_update_complete_event_rp0 *)pData;
+
+          if ( pstEvent->Status == BLE_STATUS_SUCCESS )
+          {
+            stBleDiagState.cTxPhy = pstEvent->TX_PHY;
+          }
+        }
+        break;
+
+    default:
+        break;
+  }
+}
+
+/**
+ * @brief  Vendor events : writes of the phone, ATT MTU and TX pool of the host.
+ * @param  iEvent  Vendor event code
+ * @param  pData   Parameters of the event
+ * @retval None
+ */
+static void BleDiagVendorEvent( uint16_t iEvent, const uint8_t * pData )
+{
+  switch ( iEvent )
+  {
+    case ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE:
+        {
+          const aci_gatt_attribute_modified_event_rp0 * pstEvent = (const aci_gatt_attribute_modified_event_rp0 *)pData;
+
+          if ( pstEvent->Attr_Data_Length == 0u )
+          {
+            break;
+          }
+
+          /* CCCD of the data characteristic, value of the control characteristic */
+          if ( pstEvent->Attr_Handle == ( iBleDiagDataHandle + 2u ) )
+          {
+            stBleDiagState.bNotifyEnabled = ( ( pstEvent->Attr_Data[0] & BLE_DIAG_CCCD_NOTIFICATION ) != 0u );
+            UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+          }
+          else if ( pstEvent->Attr_Handle == ( iBleDiagControlHandle + 1u ) )
+          {
+            BleDiagCommand( pstEvent->Attr_Data[0] );
+          }
+        }
+        break;
+
+    case ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE:
+        {
+          const aci_att_exchange_mtu_resp_event_rp0 * pstEvent = (const aci_att_exchange_mtu_resp_event_rp0 *)pData;
+          uint16_t  iMtu = MIN( pstEvent->Server_RX_MTU, CFG_BLE_DIAG_ATT_MTU );
+
+          stBleDiagState.iPayloadSize = MIN( ( iMtu - BLE_DIAG_ATT_HEADER_SIZE ), BLE_DIAG_VALUE_SIZE_MAX );
+        }
+        break;
+
+    case ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE:
+        bBleDiagTxPoolFull = false;
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_DIAG ), TASK_PRIO_BLE_DIAG );
+        break;
+
+    default:
+        break;
+  }
+}
+
+#else /* (CFG_BLE_DIAG_SUPPORTED != 0) */
+
+static APP_BLE_DIAG_State_t   stBleDiagState;
+
+/**
+ * @brief  BLE diagnostics export not supported : nothing to start.
+ */
+void APP_BLE_DIAG_Init( void )
+{
+}
+
+/**
+ * @brief  BLE diagnostics export not supported : no command.
+ */
+bool APP_BLE_DIAG_SerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  BLE diagnostics export not supported : state never connected.
+ */
+const APP_BLE_DIAG_State_t * APP_BLE_DIAG_GetState( void )
+{
+  return &stBleDiagState;
+}
+
+#endif /* (CFG_BLE_DIAG_SUPPORTED != 0) */
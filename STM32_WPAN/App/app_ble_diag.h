@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file    app_ble_diag.h
+  * @author  MCD Application Team
+  * @brief   Interface of the BLE diagnostics export (GATT server of the
+  *          concurrent build streaming the raw diagnostics records).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_BLE_DIAG_H
+#define APP_BLE_DIAG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_conf.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Commands written in the control characteristic (one byte) */
+#define APP_BLE_DIAG_CMD_SNAPSHOT           (0x01u)   /* Logs of the performance snapshot */
+#define APP_BLE_DIAG_CMD_FRAME_LOG          (0x02u)   /* Records of the frame log, oldest first */
+#define APP_BLE_DIAG_CMD_LOG_START          (0x03u)   /* Logs, as they are printed */
+#define APP_BLE_DIAG_CMD_LOG_STOP           (0x04u)
+
+/* Source of a record notified on the data characteristic. The notifications are a byte stream of records : source
+ * (one byte), size (one byte) then the data, a record can be split between two notifications. */
+#define APP_BLE_DIAG_SOURCE_LOG             (0x01u)   /* Binary frame of a log (log_decode.py) */
+#define APP_BLE_DIAG_SOURCE_FRAME_LOG       (0x02u)   /* APP_FRAME_LOG_Record_t */
+#define APP_BLE_DIAG_SOURCE_SNAPSHOT        (0x03u)   /* Binary frame of a log of the performance snapshot */
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the export */
+typedef struct
+{
+  bool        bConnected;
+  bool        bNotifyEnabled;         /* Notifications of the data characteristic enabled by the phone */
+  bool        bLogStream;             /* Logs streamed as they are printed */
+  uint8_t     cTxPhy;                 /* PHY of the link (1 : LE 1M, 2 : LE 2M) */
+  uint16_t    iPayloadSize;           /* Bytes of a notification (ATT MTU - 3) */
+  uint16_t    iFifoUsed;              /* Bytes waiting for the link */
+  uint32_t    lConnectionNb;
+  uint32_t    lNotificationNb;
+  uint32_t    lByteNb;                /* Bytes notified */
+  uint32_t    lDroppedNb;             /* Records dropped (FIFO full) */
+  uint32_t    lTxPoolFullNb;          /* Notifications delayed until buffers of the host are released */
+  uint32_t    lErrorNb;               /* Notifications refused (bytes dropped) or BLE commands failed */
+} APP_BLE_DIAG_State_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_BLE_DIAG_Init                 ( void );
+bool      APP_BLE_DIAG_SerialCmdExecute     ( const char * szCommand );
+
+const APP_BLE_DIAG_State_t * APP_BLE_DIAG_GetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_BLE_DIAG_H */
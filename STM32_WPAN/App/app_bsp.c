@@ -27,9 +27,18 @@
 #include "stm32_timer.h"
 
 /* Private includes -----------------------------------------------------------*/
+#include <stdlib.h>
 #include "serial_cmd_interpreter.h"
 
 /* Private typedef -----------------------------------------------------------*/
+/* Serial command simulating a button or a joystick action */
+typedef struct
+{
+  const char  * szName;
+  uint16_t    iUserChoice;
+  uint8_t     cLongPress;
+} SerialKey_t;
+
 #if (CFG_BUTTON_SUPPORTED == 1)
 typedef struct
 {
@@ -37,6 +46,11 @@ typedef struct
   UTIL_TIMER_Object_t longTimerId;
   uint8_t             longPressed;
   uint32_t            waitingTime;
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  uint8_t             pressed;
+  uint32_t            pressTime;      /* Time stamp (ms) of the press edge */
+  EXTI_HandleTypeDef  exti;
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 } ButtonDesc_t;
 #endif /* (CFG_BUTTON_SUPPORTED == 1) */
 
@@ -44,6 +58,7 @@ typedef struct
 #if (CFG_BUTTON_SUPPORTED == 1)
 #define BUTTON_LONG_PRESS_SAMPLE_MS           (50u)     /* Sample button level rate in milli seconds. */
 #define BUTTON_LONG_PRESS_THRESHOLD_MS        (500u)    /* Long pression time threshold in milli seconds. */
+#define BUTTON_DEBOUNCE_MS                    (20u)     /* Shorter presses are bounces (edge time stamp mode). */
 #ifdef CFG_BSP_ON_CEB
 #define BUTTON_NB_MAX                         (B2 + 1u)
 #else /* CFG_BSP_ON_CEB */
@@ -100,11 +115,52 @@ typedef struct
 
 #if (CFG_JOYSTICK_SUPPORTED == 1)
 #define JOYSTICK_PRESS_SAMPLE_MS              (100u)     /* Sample Joystick level rate in milli seconds. */
+#define JOYSTICK_PRESS_SAMPLE_SLACK_MS        (20u)      /* Tolerated lateness of the Joystick sampling in milli seconds. */
+#define JOYSTICK_IDLE_LEVEL                   (0xF00u)   /* ADC level under which a key is pressed (analog watchdog). */
+#define JOYSTICK_ADC_MAX_LEVEL                (0xFFFu)
 #endif /* (CFG_JOYSTICK_SUPPORTED == 1) */
 
 /* Private macros ------------------------------------------------------------*/
 
 /* Private constants ---------------------------------------------------------*/
+/* Serial commands of the buttons and of the joystick, sorted by name */
+#if ( CFG_BUTTON_SUPPORTED == 1 )
+static const SerialKey_t SerialButtons[] =
+{
+#ifdef CFG_BSP_ON_CEB
+  /* For Board B_WBA5M_WPAN, the only button (same as B1 on other board) is named B2. */
+  { "B2", B2, 0 },
+  { "B2L", B2, 1 },
+  { "SW2", B2, 0 },
+  { "SW2L", B2, 1 },
+#else /* CFG_BSP_ON_CEB */
+  { "B1", B1, 0 },
+  { "B1L", B1, 1 },
+  { "B2", B2, 0 },
+  { "B2L", B2, 1 },
+  { "B3", B3, 0 },
+  { "B3L", B3, 1 },
+  { "SW1", B1, 0 },
+  { "SW1L", B1, 1 },
+  { "SW2", B2, 0 },
+  { "SW2L", B2, 1 },
+  { "SW3", B3, 0 },
+  { "SW3L", B3, 1 },
+#endif /* CFG_BSP_ON_CEB */
+};
+#endif /* ( CFG_BUTTON_SUPPORTED == 1 ) */
+
+#if ( CFG_JOYSTICK_SUPPORTED == 1 )
+static const SerialKey_t SerialJoystick[] =
+{
+  { "DOWN", JOY_DOWN, 0 },
+  { "LEFT", JOY_LEFT, 0 },
+  { "RIGHT", JOY_RIGHT, 0 },
+  { "SELECT", JOY_SEL, 0 },
+  { "UP", JOY_UP, 0 },
+};
+#endif /* ( CFG_JOYSTICK_SUPPORTED == 1 ) */
+
 #ifdef CFG_BSP_ON_FREERTOS
 #if (CFG_JOYSTICK_SUPPORTED == 1)
 /* FreeRtos Joystick Up stack attributes */
@@ -229,7 +285,9 @@ static ButtonDesc_t         buttonDesc[BUTTON_NB_MAX] = { { B1, { 0 }, 0, 0 } ,
 
 #if (CFG_JOYSTICK_SUPPORTED == 1)
 /* Joystick management */
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0)
 static UTIL_TIMER_Object_t  joystickTimer;
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0) */
 #ifdef CFG_BSP_ON_THREADX
 TX_SEMAPHORE         JoystickUpSemaphore, JoystickRightSemaphore, JoystickDownSemaphore, JoystickLeftSemaphore, JoystickSelectSemaphore;
 TX_THREAD            JoystickUpThread, JoystickRightThread, JoystickDownThread, JoystickLeftThread, JoystickSelectThread;
@@ -244,7 +302,20 @@ osThreadId_t         JoystickUpThread, JoystickRightThread, JoystickDownThread,
 
 /* Private functions prototypes-----------------------------------------------*/
 #if (CFG_BUTTON_SUPPORTED == 1)
+static void Button_LaunchActionTask       ( Button_TypeDef button );
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+static void Button_EdgeInitAll            ( void );
+static void Button_EdgeInit               ( Button_TypeDef button, GPIO_TypeDef * port, uint16_t pin, uint32_t line,
+                                            void ( * pCallback )( void ) );
+static void Button_Edge                   ( Button_TypeDef button );
+#ifndef CFG_BSP_ON_CEB
+static void ButtonB1EdgeCallback          ( void );
+static void ButtonB3EdgeCallback          ( void );
+#endif /* CFG_BSP_ON_CEB */
+static void ButtonB2EdgeCallback          ( void );
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 static void Button_TriggerActions         ( void * arg );
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 #endif /* (CFG_BUTTON_SUPPORTED == 1) */
 
 /* External variables --------------------------------------------------------*/
@@ -285,7 +356,12 @@ void APP_BSP_PostIdle( void )
   if ( ( PWR->WUSR & PWR_WAKEUP_PIN2 ) != 0 )
   {
     PWR->WUSCR = PWR_WAKEUP_PIN2;
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+    /* The press edge was lost in Standby : short press */
+    Button_LaunchActionTask( B1 );
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
     BSP_PB_Callback( B1 );
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   }
 #endif /* (CFG_BUTTON_SUPPORTED == 1) */
 #if (CFG_JOYSTICK_SUPPORTED == 1)
@@ -329,6 +405,10 @@ void APP_BSP_StandbyExit( void )
   BSP_PB_Init( B2, BUTTON_MODE_EXTI );
   BSP_PB_Init( B3, BUTTON_MODE_EXTI );
 #endif /* CFG_BSP_ON_NUCLEO */
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  /* Both edges of the buttons */
+  Button_EdgeInitAll();
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 #endif /* (CFG_BUTTON_SUPPORTED == 1) */
 }
 
@@ -564,23 +644,23 @@ static void Joystick_LaunchActionTask( JOYPin_TypeDef joystickState )
 #endif /* CFG_BSP_ON_THREADX */
 #ifdef CFG_BSP_ON_SEQUENCER
     case JOY_UP:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_JOY_UP, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_UP ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case JOY_RIGHT:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_JOY_RIGHT, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_RIGHT ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case JOY_DOWN:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_JOY_DOWN, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_DOWN ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case JOY_LEFT:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_JOY_LEFT, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_LEFT ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case JOY_SEL:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_JOY_SELECT, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_SELECT ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 #endif /* CFG_BSP_ON_SEQUENCER */
     default :   /* No Action */
@@ -588,6 +668,7 @@ static void Joystick_LaunchActionTask( JOYPin_TypeDef joystickState )
   }
 }
 
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0)
 /**
  *
  */
@@ -614,6 +695,92 @@ static void APP_BSP_JoystickTimerCallback(void *arg)
   joystickPreviousState = joystickState;
 }
 
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0) */
+/**
+ * @brief  Window of the analog watchdog of the Joystick : out of it when a key is pressed, or when the pressed key is
+ *         released.
+ *
+ * @param  pressed  '1' if a key is pressed.
+ * @retval None
+ */
+static void Joystick_SetWatchWindow( uint8_t pressed )
+{
+  if ( pressed != 0u )
+  {
+    LL_ADC_ConfigAnalogWDThresholds( hjoy_adc[JOY1].Instance, LL_ADC_AWD1, ( JOYSTICK_IDLE_LEVEL - 1u ), 0u );
+  }
+  else
+  {
+    LL_ADC_ConfigAnalogWDThresholds( hjoy_adc[JOY1].Instance, LL_ADC_AWD1, JOYSTICK_ADC_MAX_LEVEL, JOYSTICK_IDLE_LEVEL );
+  }
+}
+
+/**
+ * @brief  Start the watch of the Joystick : continuous conversions compared by the analog watchdog, that interrupts
+ *         only on a press or a release (no periodic sampling).
+ */
+static void Joystick_WatchStart( void )
+{
+  ADC_AnalogWDGConfTypeDef  stWatchdog;
+
+  BSP_JOY_Init( JOY1, JOY_MODE_EXTI, JOY_ALL );
+
+  hjoy_adc[JOY1].Init.ContinuousConvMode = ENABLE;
+  (void)HAL_ADC_Init( &hjoy_adc[JOY1] );
+
+  memset( &stWatchdog, 0, sizeof( stWatchdog ) );
+  stWatchdog.WatchdogNumber = ADC_ANALOGWATCHDOG_1;
+  stWatchdog.WatchdogMode = ADC_ANALOGWATCHDOG_ALL_REG;
+  stWatchdog.HighThreshold = JOYSTICK_ADC_MAX_LEVEL;
+  stWatchdog.LowThreshold = JOYSTICK_IDLE_LEVEL;
+  stWatchdog.ITMode = ENABLE;
+  (void)HAL_ADC_AnalogWDGConfig( &hjoy_adc[JOY1], &stWatchdog );
+
+  HAL_NVIC_SetPriority( ADC4_IRQn, 0x0Fu, 0u );
+  HAL_NVIC_EnableIRQ( ADC4_IRQn );
+  (void)HAL_ADC_Start( &hjoy_adc[JOY1] );
+}
+
+/**
+ * @brief  Analog watchdog of the Joystick : a key is pressed (its action is launched) or released.
+ */
+void HAL_ADC_LevelOutOfWindowCallback( ADC_HandleTypeDef * hadc )
+{
+  static uint8_t  joystickPressed = 0;
+  int32_t         joystickState;
+
+  if ( hadc != &hjoy_adc[JOY1] )
+  {
+    return;
+  }
+
+  joystickState = BSP_JOY_GetState( JOY1 );
+  if ( joystickPressed == 0u )
+  {
+    if ( joystickState != JOY_NONE )
+    {
+      joystickPressed = 1;
+      Joystick_SetWatchWindow( 1 );
+      Joystick_LaunchActionTask( (JOYPin_TypeDef) joystickState );
+    }
+  }
+  else if ( joystickState == JOY_NONE )
+  {
+    joystickPressed = 0;
+    Joystick_SetWatchWindow( 0 );
+  }
+}
+
+/**
+ * @brief  Interrupt of the Joystick ADC (analog watchdog).
+ */
+void APP_BSP_JoystickIRQHandler( void )
+{
+  HAL_ADC_IRQHandler( &hjoy_adc[JOY1] );
+}
+
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0) */
+
 #ifdef CFG_BSP_ON_FREERTOS
 
 /**
@@ -906,11 +1073,11 @@ static void Joystick_InitTask( void )
 static void Joystick_InitTask( void)
 {
   /* Task associated with Joystick */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_JOY_UP, UTIL_SEQ_RFU, APP_BSP_JoystickUpAction );
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_JOY_RIGHT, UTIL_SEQ_RFU, APP_BSP_JoystickRightAction );
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_JOY_DOWN, UTIL_SEQ_RFU, APP_BSP_JoystickDownAction );
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_JOY_LEFT, UTIL_SEQ_RFU, APP_BSP_JoystickLeftAction );
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_JOY_SELECT, UTIL_SEQ_RFU, APP_BSP_JoystickSelectAction );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_UP ), UTIL_SEQ_RFU, APP_BSP_JoystickUpAction );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_RIGHT ), UTIL_SEQ_RFU, APP_BSP_JoystickRightAction );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_DOWN ), UTIL_SEQ_RFU, APP_BSP_JoystickDownAction );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_LEFT ), UTIL_SEQ_RFU, APP_BSP_JoystickLeftAction );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_JOY_SELECT ), UTIL_SEQ_RFU, APP_BSP_JoystickSelectAction );
 }
 
 #endif /* CFG_BSP_ON_SEQUENCER */
@@ -926,9 +1093,15 @@ void APP_BSP_JoystickInit( void )
   /* StandBy WakeUp via Joystick */
   HAL_PWR_EnableWakeUpPin(PWR_WAKEUP_PIN3_HIGH_1);              /* JOY-PA1. */
 
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  /* Joystick watched by the analog watchdog of its ADC */
+  Joystick_WatchStart();
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   /* Create periodic timer for joystick position reading */
   UTIL_TIMER_Create(&joystickTimer, JOYSTICK_PRESS_SAMPLE_MS, UTIL_TIMER_PERIODIC, &APP_BSP_JoystickTimerCallback, 0);
+  UTIL_TIMER_SetSlack(&joystickTimer, JOYSTICK_PRESS_SAMPLE_SLACK_MS);
   UTIL_TIMER_Start(&joystickTimer);
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 }
 
 #endif /* (CFG_JOYSTICK_SUPPORTED == 1) */
@@ -1121,16 +1294,16 @@ static void Button_InitTask( void )
 {
 #ifdef CFG_BSP_ON_CEB
   /* Task associated with push button B2 */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_BUTTON_B2, UTIL_SEQ_RFU, APP_BSP_Button2Action );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B2 ), UTIL_SEQ_RFU, APP_BSP_Button2Action );
 #else /* CFG_BSP_ON_CEB */
   /* Task associated with push button B1 */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_BUTTON_B1, UTIL_SEQ_RFU, APP_BSP_Button1Action );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B1 ), UTIL_SEQ_RFU, APP_BSP_Button1Action );
 
   /* Task associated with push button B2 */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_BUTTON_B2, UTIL_SEQ_RFU, APP_BSP_Button2Action );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B2 ), UTIL_SEQ_RFU, APP_BSP_Button2Action );
 
   /* Task associated with push button B3 */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_BSP_BUTTON_B3, UTIL_SEQ_RFU, APP_BSP_Button3Action );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B3 ), UTIL_SEQ_RFU, APP_BSP_Button3Action );
 #endif /* CFG_BSP_ON_CEB */
 }
 
@@ -1159,6 +1332,11 @@ void APP_BSP_ButtonInit( void )
   /* StandBy WakeUp via buttons */
   HAL_PWR_EnableWakeUpPin(PWR_WAKEUP_PIN2_HIGH_1);              /* GPIO PC13. */
 
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  /* Press and release edges time stamped (no timer) */
+  UNUSED( buttonIndex );
+  Button_EdgeInitAll();
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   /* Button timers initialisation (one for each button) */
 #ifdef CFG_BSP_ON_CEB
   buttonIndex = B2;
@@ -1169,6 +1347,7 @@ void APP_BSP_ButtonInit( void )
     UTIL_TIMER_Create( &buttonDesc[buttonIndex].longTimerId, 0, UTIL_TIMER_PERIODIC, &Button_TriggerActions, &buttonDesc[buttonIndex] );
   }
 #endif /* CFG_BSP_ON_CEB */
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 }
 
 /**
@@ -1189,7 +1368,7 @@ static void Button_LaunchActionTask( Button_TypeDef button )
     tx_semaphore_put( &ButtonB2Semaphore );
 #endif /* CFG_BSP_ON_THREADX */
 #ifdef CFG_BSP_ON_SEQUENCER
-    UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_BUTTON_B2, CFG_SEQ_PRIO_0 );
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B2 ), CFG_TASK_PRIO_BUTTON_Bx );
 #endif /* CFG_BSP_ON_SEQUENCER */
   }
 #endif /* CFG_BSP_ON_CEB */
@@ -1224,15 +1403,15 @@ static void Button_LaunchActionTask( Button_TypeDef button )
 #endif /* CFG_BSP_ON_THREADX */
 #ifdef CFG_BSP_ON_SEQUENCER
     case B1:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_BUTTON_B1, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B1 ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case B2:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_BUTTON_B2, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B2 ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 
     case B3:
-        UTIL_SEQ_SetTask( 1U << CFG_TASK_BSP_BUTTON_B3, CFG_SEQ_PRIO_0 );
+        UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BSP_BUTTON_B3 ), CFG_TASK_PRIO_BUTTON_Bx );
         break;
 #endif /* CFG_BSP_ON_SEQUENCER */
 
@@ -1242,6 +1421,7 @@ static void Button_LaunchActionTask( Button_TypeDef button )
 #endif /* CFG_BSP_ON_NUCLEO */
 }
 
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0)
 /**
  *
  */
@@ -1271,18 +1451,157 @@ static void Button_TriggerActions( void * arg )
   /* Launch Task */
   Button_LaunchActionTask( p_buttonDesc->button );
 }
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 0) */
 
 /**
  *
  */
 void BSP_PB_Callback( Button_TypeDef button )
 {
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+  Button_Edge( button );
+#else /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
   buttonDesc[button].waitingTime = 0;
   UTIL_TIMER_StartWithPeriod( &buttonDesc[button].longTimerId, BUTTON_LONG_PRESS_SAMPLE_MS );
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
+}
+
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+/**
+ * @brief  Edge (press or release) of a button : at the release, the press duration gives the long press and the
+ *         action is launched. A press shorter than BUTTON_DEBOUNCE_MS is a bounce.
+ *
+ * @param  button  ID of the button.
+ * @retval None
+ */
+static void Button_Edge( Button_TypeDef button )
+{
+  ButtonDesc_t  * p_buttonDesc = &buttonDesc[button];
+  uint32_t      now = UTIL_TIMER_GetCurrentTime();
+  uint32_t      duration;
+
+  if ( BSP_PB_GetState( button ) != 0 )
+  {
+    if ( p_buttonDesc->pressed == 0u )
+    {
+      p_buttonDesc->pressed = 1;
+      p_buttonDesc->pressTime = now;
+    }
+    return;
+  }
+
+  if ( p_buttonDesc->pressed == 0u )
+  {
+    return;
+  }
+
+  p_buttonDesc->pressed = 0;
+  duration = now - p_buttonDesc->pressTime;
+  if ( duration < BUTTON_DEBOUNCE_MS )
+  {
+    return;
+  }
+
+  if ( duration >= BUTTON_LONG_PRESS_THRESHOLD_MS )
+  {
+    APP_BSP_SetButtonIsLongPressed( button );
+  }
+  Button_LaunchActionTask( button );
+}
+
+/**
+ * @brief  Interrupt on both edges of the buttons.
+ */
+static void Button_EdgeInitAll( void )
+{
+#ifdef CFG_BSP_ON_CEB
+  Button_EdgeInit( B2, B2_GPIO_PORT, B2_PIN, B2_EXTI_LINE, ButtonB2EdgeCallback );
+#else /* CFG_BSP_ON_CEB */
+  Button_EdgeInit( B1, B1_GPIO_PORT, B1_PIN, B1_EXTI_LINE, ButtonB1EdgeCallback );
+  Button_EdgeInit( B2, B2_GPIO_PORT, B2_PIN, B2_EXTI_LINE, ButtonB2EdgeCallback );
+  Button_EdgeInit( B3, B3_GPIO_PORT, B3_PIN, B3_EXTI_LINE, ButtonB3EdgeCallback );
+#endif /* CFG_BSP_ON_CEB */
+}
+
+/**
+ * @brief  Interrupt on both edges of a button, on its own EXTI handle (the BSP one only has the press edge).
+ *
+ * @param  button     ID of the button.
+ * @param  port       GPIO port of the button.
+ * @param  pin        GPIO pin of the button.
+ * @param  line       EXTI line of the button.
+ * @param  pCallback  Callback of the EXTI line.
+ * @retval None
+ */
+static void Button_EdgeInit( Button_TypeDef button, GPIO_TypeDef * port, uint16_t pin, uint32_t line,
+                             void ( * pCallback )( void ) )
+{
+  GPIO_InitTypeDef  stGpioInit;
+
+  stGpioInit.Pin = pin;
+  stGpioInit.Mode = GPIO_MODE_IT_RISING_FALLING;
+  stGpioInit.Pull = GPIO_PULLUP;
+  stGpioInit.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init( port, &stGpioInit );
+
+  buttonDesc[button].pressed = 0;
+  if ( ( HAL_EXTI_GetHandle( &buttonDesc[button].exti, line ) != HAL_OK ) ||
+       ( HAL_EXTI_RegisterCallback( &buttonDesc[button].exti, HAL_EXTI_COMMON_CB_ID, pCallback ) != HAL_OK ) )
+  {
+    LOG_ERROR_APP( "Error, button %d edges not configured.", button );
+  }
+}
+
+#ifndef CFG_BSP_ON_CEB
+/**
+ * @brief  Edge of the button B1.
+ */
+static void ButtonB1EdgeCallback( void )
+{
+  Button_Edge( B1 );
+}
+
+/**
+ * @brief  Edge of the button B3.
+ */
+static void ButtonB3EdgeCallback( void )
+{
+  Button_Edge( B3 );
+}
+#endif /* CFG_BSP_ON_CEB */
+
+/**
+ * @brief  Edge of the button B2.
+ */
+static void ButtonB2EdgeCallback( void )
+{
+  Button_Edge( B2 );
 }
 
+/**
+ * @brief  Interrupt of the EXTI line of a button (both edges).
+ *
+ * @param  button  ID of the button.
+ * @retval None
+ */
+void APP_BSP_ButtonIRQHandler( Button_TypeDef button )
+{
+  HAL_EXTI_IRQHandler( &buttonDesc[button].exti );
+}
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
+
 #endif /* ( CFG_BUTTON_SUPPORTED == 1 )  */
 
+#if ( CFG_BUTTON_SUPPORTED == 1 ) || ( CFG_JOYSTICK_SUPPORTED == 1 )
+/**
+ * @brief  Compare a serial command with the name of a key, for bsearch.
+ */
+static int SerialKeyCompare( const void * pKey, const void * pEntry )
+{
+  return strcmp( (const char *)pKey, ((const SerialKey_t *)pEntry)->szName );
+}
+#endif /* ( CFG_BUTTON_SUPPORTED == 1 ) || ( CFG_JOYSTICK_SUPPORTED == 1 ) */
+
 /**
  * @brief  Treat USART commands to simulate button press for instance.
  *
@@ -1294,78 +1613,29 @@ uint8_t APP_BSP_SerialCmdExecute( uint8_t * pRxBuffer, uint16_t iRxBufferSize )
 {
   uint8_t   cReturn = 0;
   uint16_t  iUserChoice = UINT16_MAX;
+#if ( CFG_BUTTON_SUPPORTED == 1 ) || ( CFG_JOYSTICK_SUPPORTED == 1 )
+  const SerialKey_t * pstKey;
+#endif /* ( CFG_BUTTON_SUPPORTED == 1 ) || ( CFG_JOYSTICK_SUPPORTED == 1 ) */
 
   /* Parse received frame */
 #if ( CFG_BUTTON_SUPPORTED == 1 )
-#ifdef CFG_BSP_ON_CEB
-  /* For Board B_WBA5M_WPAN, the only button (same as B1 on other board) is named B2. */
-  if ( (strcmp( (char const*)pRxBuffer, "B2" ) == 0) ||
-       (strcmp( (char const*)pRxBuffer, "SW2" ) == 0) )
-  {
-    iUserChoice = B2;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B2L" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW2L" ) == 0) )
-  {
-    APP_BSP_SetButtonIsLongPressed(B2);
-    iUserChoice = B2;
-  }
-#else /* CFG_BSP_ON_CEB */
-  if ( (strcmp( (char const*)pRxBuffer, "B1" ) == 0) ||
-       (strcmp( (char const*)pRxBuffer, "SW1" ) == 0) )
-  {
-    iUserChoice = B1;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B1L" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW1L" ) == 0) )
-  {
-    APP_BSP_SetButtonIsLongPressed(B1);
-    iUserChoice = B1;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B2" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW2" ) == 0) )
-  {
-    iUserChoice = B2;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B2L" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW2L" ) == 0) )
+  pstKey = bsearch( pRxBuffer, SerialButtons, ( sizeof( SerialButtons ) / sizeof( SerialButtons[0] ) ),
+                    sizeof( SerialKey_t ), SerialKeyCompare );
+  if ( pstKey != NULL )
   {
-    APP_BSP_SetButtonIsLongPressed(B2);
-    iUserChoice = B2;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B3" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW3" ) == 0) )
-  {
-    iUserChoice = B3;
-  }
-  else if ( (strcmp( (char const*)pRxBuffer, "B3L" ) == 0) ||
-            (strcmp( (char const*)pRxBuffer, "SW3L" ) == 0) )
-  {
-    APP_BSP_SetButtonIsLongPressed(B3);
-    iUserChoice = B3;
+    if ( pstKey->cLongPress != 0u )
+    {
+      APP_BSP_SetButtonIsLongPressed( (Button_TypeDef)pstKey->iUserChoice );
+    }
+    iUserChoice = pstKey->iUserChoice;
   }
-#endif /* CFG_BSP_ON_CEB */
 #endif /* ( CFG_BUTTON_SUPPORTED == 1 )  */
 #if ( CFG_JOYSTICK_SUPPORTED == 1 )
-  if (strcmp( (char const*)pRxBuffer, "UP" ) == 0)
-  {
-    iUserChoice = JOY_UP;
-  }
-  else if (strcmp( (char const*)pRxBuffer, "RIGHT" ) == 0)
-  {
-    iUserChoice = JOY_RIGHT;
-  }
-  else if (strcmp( (char const*)pRxBuffer, "DOWN" ) == 0 )
-  {
-    iUserChoice = JOY_DOWN;
-  }
-  else if (strcmp( (char const*)pRxBuffer, "LEFT" ) == 0)
-  {
-    iUserChoice = JOY_LEFT;
-  }
-  else if (strcmp( (char const*)pRxBuffer, "SELECT" ) == 0)
+  pstKey = bsearch( pRxBuffer, SerialJoystick, ( sizeof( SerialJoystick ) / sizeof( SerialJoystick[0] ) ),
+                    sizeof( SerialKey_t ), SerialKeyCompare );
+  if ( pstKey != NULL )
   {
-    iUserChoice = JOY_SEL;
+    iUserChoice = pstKey->iUserChoice;
   }
 #endif /* ( CFG_JOYSTICK_SUPPORTED == 1 )  */
 
@@ -115,6 +115,9 @@ void      APP_BSP_Button2Action           ( void );
 void      APP_BSP_Button3Action           ( void );
 
 void      BSP_PB_Callback                 ( Button_TypeDef button );
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+void      APP_BSP_ButtonIRQHandler        ( Button_TypeDef button );
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 
 #endif /* ( CFG_BUTTON_SUPPORTED == 1 )  */
 #if ( CFG_JOYSTICK_SUPPORTED == 1 )
@@ -127,6 +130,9 @@ void      APP_BSP_JoystickLeftAction      ( void );
 void      APP_BSP_JoystickSelectAction    ( void );
 
 void      BSP_JOY_Callback                ( JOY_TypeDef joyNb, JOYPin_TypeDef joyPin );
+#if (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1)
+void      APP_BSP_JoystickIRQHandler      ( void );
+#endif /* (CFG_BSP_EDGE_TIMESTAMP_SUPPORTED == 1) */
 
 #endif /* CFG_JOYSTICK_SUPPORTED */
 
@@ -0,0 +1,636 @@
+/**
+  ******************************************************************************
+  * @file    app_crash_log.c
+  * @author  MCD Application Team
+  * @brief   Crash log : the last logs are captured as binary frames in a RAM
+  *          ring kept across the resets (.noinit section). A fatal error adds
+  *          its cause and the profiling counters. At the next boot after a
+  *          fatal error or a watchdog reset, the whole entry is written by the
+  *          Flash Manager in a circular log of two flash pages, retrievable
+  *          with the CRASHLOG serial command.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_manager.h"
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "main.h"
+#include "app_crash_log.h"
+#include "app_frame_log.h"
+#include "assert.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+#include "stm32_adv_trace.h"
+
+#if (CFG_CRASH_LOG_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define CRASH_LOG_MAGIC                 (0x43524C47u)           /* "CRLG" : Crash Log entry in flash */
+#define CRASH_LOG_RAM_MAGIC             (0x43524C52u)           /* "CRLR" : Crash Log entry collected in RAM */
+#define CRASH_LOG_ERASED                (0xFFFFFFFFu)
+#define CRASH_LOG_PAGE_NB               (2u)
+#define CRASH_LOG_TASK_NB               (32u)                   /* Sequencer task ids [0:31] */
+#define CRASH_LOG_HEADER_SIZE           (80u)
+#define CRASH_LOG_RECORD_SIZE           ( LOG_BINARY_FRAME_SIZE_MAX + 4u )
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+#define CRASH_LOG_FRAMES_SIZE           ( CFG_FRAME_LOG_RECORD_NB * 16u )   /* APP_FRAME_LOG_Record_t */
+#else /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+#define CRASH_LOG_FRAMES_SIZE           (0u)
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+#define CRASH_LOG_ENTRY_SIZE            ( CRASH_LOG_HEADER_SIZE + ( CRASH_LOG_TASK_NB * 12u ) + ( CFG_CRASH_LOG_RECORD_NB * CRASH_LOG_RECORD_SIZE ) + CRASH_LOG_FRAMES_SIZE )
+#define CRASH_LOG_ENTRY_PER_PAGE        ( FLASH_PAGE_SIZE / sizeof( CrashLogEntry_t ) )
+#define CRASH_LOG_SLOT_NB               ( CRASH_LOG_PAGE_NB * CRASH_LOG_ENTRY_PER_PAGE )
+#define CRASH_LOG_SLOT_NONE             (0xFFFFu)
+#define CRASH_LOG_WATCHDOG_FLAGS        ( RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF )
+
+#if ( ( CRASH_LOG_RECORD_SIZE % 16u ) != 0u )
+#error A crash log record shall be a multiple of 128 bits
+#endif /* ( ( CRASH_LOG_RECORD_SIZE % 16u ) != 0u ) */
+
+#if ( CRASH_LOG_ENTRY_SIZE > FLASH_PAGE_SIZE )
+#error CFG_CRASH_LOG_RECORD_NB records do not fit in a flash page
+#endif /* ( CRASH_LOG_ENTRY_SIZE > FLASH_PAGE_SIZE ) */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Log captured : binary frame of the log module */
+typedef struct
+{
+  uint16_t    iSize;                  /* Size of the frame, 0 when the record is unused */
+  uint16_t    iRfu;
+  uint8_t     acFrame[LOG_BINARY_FRAME_SIZE_MAX];
+} CrashLogRecord_t;
+
+/* Profiling counters of a sequencer task (times in the unit of UTIL_SEQ_PROFILING_GET_TIME) */
+typedef struct
+{
+  uint32_t    lCallCount;
+  uint32_t    lMaxTime;
+  uint32_t    lMaxLatency;
+} CrashLogTaskStats_t;
+
+/* Entry of the log : same layout in RAM and in flash (one flash write) */
+typedef struct
+{
+  uint32_t              lMagic;
+  uint32_t              lSequence;
+  uint32_t              lSequenceInv;         /* ~lSequence */
+  uint8_t               cReason;              /* APP_CRASH_LOG_Reason_t */
+  uint8_t               cRfu;
+  uint16_t              iRecordNb;            /* Records of the ring ( CFG_CRASH_LOG_RECORD_NB ) */
+  uint32_t              lRecordsTotal;        /* Logs captured : the last one is in record ( lRecordsTotal - 1 ) % iRecordNb */
+  uint32_t              lErrorId;
+  uint32_t              lErrorCode;
+  uint32_t              lCaller;              /* Return address of the APP_CRASH_LOG_Fatal call */
+  uint32_t              lResetFlags;          /* RCC_CSR at the boot that saved the entry */
+  uint32_t              lUptime;              /* ms, at the fatal error */
+  FM_WindowStats_t      stFlashStats;
+  uint32_t              lFramesTotal;         /* Frames of the frame log : the last one is in astFrames[( lFramesTotal - 1 ) % ...] */
+  CrashLogTaskStats_t   astTasks[CRASH_LOG_TASK_NB];
+  CrashLogRecord_t      astRecords[CFG_CRASH_LOG_RECORD_NB];
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  APP_FRAME_LOG_Record_t astFrames[CFG_FRAME_LOG_RECORD_NB];
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+} CrashLogEntry_t;
+
+static_assert( sizeof( CrashLogEntry_t ) == CRASH_LOG_ENTRY_SIZE, "Crash log entry layout differs from CRASH_LOG_ENTRY_SIZE" );
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+static_assert( sizeof( APP_FRAME_LOG_Record_t ) == 16u, "Frame log record differs from CRASH_LOG_FRAMES_SIZE" );
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+typedef enum
+{
+  CRASH_LOG_FLASH_IDLE,
+  CRASH_LOG_FLASH_ERASE,              /* Page erased before the write of the entry */
+  CRASH_LOG_FLASH_WRITE,
+  CRASH_LOG_FLASH_CLEAR,              /* CRASHLOG ERASE */
+} CrashLogFlashState_t;
+
+/* Private variables ---------------------------------------------------------*/
+static CrashLogEntry_t              stCrashLogRam PLACE_IN_SECTION( ".noinit" ) ALIGN( 16 );
+
+static bool                         bCrashLogCapture;       /* The RAM ring receives the logs */
+static bool                         bCrashLogFatal;         /* A fatal error is being recorded */
+static uint32_t                     lCrashLogSequence;      /* Sequence of the next entry written */
+static uint16_t                     iCrashLogNewest = CRASH_LOG_SLOT_NONE;
+static uint16_t                     iCrashLogNext;          /* Slot of the next entry written */
+static uint32_t                     lCrashLogSaved;         /* Entries written since the boot */
+static uint32_t                     lCrashLogErrors;        /* Flash operations failed */
+static CrashLogFlashState_t         eCrashLogFlashState;
+static FM_FlashOpNode_t             stCrashLogFlashOp;
+
+static const char * const           szCrashLogReason[] =
+{
+  "none", "Zigbee error", "Error_Handler", "assert", "HardFault", "watchdog"
+};
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     CrashLogReset           ( void );
+static bool     CrashLogRamIsValid      ( void );
+static void     CrashLogCaptureFrame    ( const uint8_t * pFrame, uint16_t iSize );
+static void     CrashLogScan            ( void );
+static void     CrashLogSave            ( void );
+static void     CrashLogWrite           ( void );
+static void     CrashLogFlashCallback   ( FM_FlashOp_Status_t eStatus );
+static void     CrashLogPrintEntry      ( const CrashLogEntry_t * pstEntry );
+static void     CrashLogDump            ( const CrashLogEntry_t * pstEntry );
+static const CrashLogEntry_t * CrashLogGetEntry     ( uint16_t iSlot );
+static bool     CrashLogEntryIsValid    ( const CrashLogEntry_t * pstEntry );
+static bool     CrashLogIsErased        ( const uint32_t * plAddress, uint32_t lSize );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the crash log : the entry kept in RAM is saved in flash after a fatal error or a watchdog
+ *         reset, else the RAM ring restarts empty. Then the logs are captured.
+ * @param  None
+ * @retval None
+ */
+void APP_CRASH_LOG_Init( void )
+{
+  uint32_t  lResetFlags = RCC->CSR;
+
+  __HAL_RCC_CLEAR_RESET_FLAGS();
+
+  CrashLogScan();
+  stCrashLogFlashOp.Callback = CrashLogFlashCallback;
+
+  if ( ( CrashLogRamIsValid() != false ) &&
+       ( ( stCrashLogRam.cReason != (uint8_t)APP_CRASH_LOG_REASON_NONE ) || ( ( lResetFlags & CRASH_LOG_WATCHDOG_FLAGS ) != 0u ) ) )
+  {
+    if ( stCrashLogRam.cReason == (uint8_t)APP_CRASH_LOG_REASON_NONE )
+    {
+      stCrashLogRam.cReason = (uint8_t)APP_CRASH_LOG_REASON_WATCHDOG;
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+      /* The frames before the watchdog reset are still in the ring of the frame log */
+      stCrashLogRam.lFramesTotal = APP_FRAME_LOG_Copy( stCrashLogRam.astFrames );
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+    }
+    stCrashLogRam.lResetFlags = lResetFlags;
+
+    LOG_INFO_APP( "Crash log : %s before the reset (%u logs), saved in slot %d.", szCrashLogReason[stCrashLogRam.cReason],
+                  stCrashLogRam.lRecordsTotal, iCrashLogNext );
+    CrashLogSave();
+  }
+  else
+  {
+    CrashLogReset();
+    bCrashLogCapture = true;
+  }
+
+  Log_Module_RegisterCaptureFunction( CrashLogCaptureFrame );
+}
+
+/**
+ * @brief  Record a fatal error in the RAM entry, with the profiling counters. The entry is saved in flash at the
+ *         next boot. Can be called from any context, before APP_CRASH_LOG_Init.
+ * @param  eReason  Cause of the fatal error
+ * @param  lId      First information on the error (see APP_CRASH_LOG_Reason_t)
+ * @param  lCode    Second information on the error
+ * @retval None
+ */
+void APP_CRASH_LOG_Fatal( APP_CRASH_LOG_Reason_t eReason, uint32_t lId, uint32_t lCode )
+{
+  UTIL_SEQ_TaskStats_t  stTaskStats;
+  uint32_t              lCaller = (uint32_t)__builtin_return_address( 0 );
+
+  /* Only the first error is recorded (an assert ends in Error_Handler) */
+  if ( bCrashLogFatal != false )
+  {
+    return;
+  }
+  bCrashLogFatal = true;
+  bCrashLogCapture = false;
+
+  if ( CrashLogRamIsValid() == false )
+  {
+    CrashLogReset();
+  }
+
+  stCrashLogRam.cReason = (uint8_t)eReason;
+  stCrashLogRam.lErrorId = lId;
+  stCrashLogRam.lErrorCode = lCode;
+  stCrashLogRam.lCaller = lCaller;
+  stCrashLogRam.lUptime = UTIL_TIMER_GetCurrentTime();
+  FM_GetWindowStats( &stCrashLogRam.stFlashStats );
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  stCrashLogRam.lFramesTotal = APP_FRAME_LOG_Copy( stCrashLogRam.astFrames );
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+  for ( uint32_t lTask = 0; lTask < CRASH_LOG_TASK_NB; lTask++ )
+  {
+    if ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lTask ), &stTaskStats ) != 0u )
+    {
+      stCrashLogRam.astTasks[lTask].lCallCount = stTaskStats.CallCount;
+      stCrashLogRam.astTasks[lTask].lMaxTime = stTaskStats.MaxTime;
+      stCrashLogRam.astTasks[lTask].lMaxLatency = stTaskStats.MaxLatency;
+    }
+  }
+
+#if (CFG_CRASH_LOG_RESET_ON_FATAL != 0)
+  NVIC_SystemReset();
+#endif /* (CFG_CRASH_LOG_RESET_ON_FATAL != 0) */
+}
+
+/**
+ * @brief  Crash log serial commands : CRASHLOG (entries in flash), CRASHLOG DUMP (profiling counters and logs of the
+ *         newest entry, logs sent as binary frames for log_decode.py), CRASHLOG ERASE.
+ * @param  szCommand  Command received
+ * @retval True if the command is a crash log command.
+ */
+bool APP_CRASH_LOG_SerialCmdExecute( const char * szCommand )
+{
+  const CrashLogEntry_t   * pstEntry;
+  uint16_t                iSlot;
+  uint16_t                iCount = 0;
+
+  if ( strcmp( szCommand, "CRASHLOG" ) == 0 )
+  {
+    if ( iCrashLogNewest != CRASH_LOG_SLOT_NONE )
+    {
+      /* Oldest first : the slots after the newest one */
+      for ( uint16_t iIndex = 1; iIndex <= CRASH_LOG_SLOT_NB; iIndex++ )
+      {
+        iSlot = (uint16_t)( ( iCrashLogNewest + iIndex ) % CRASH_LOG_SLOT_NB );
+        pstEntry = CrashLogGetEntry( iSlot );
+        if ( CrashLogEntryIsValid( pstEntry ) != false )
+        {
+          CrashLogPrintEntry( pstEntry );
+          iCount++;
+        }
+      }
+    }
+
+    LOG_INFO_APP( "Crash log : %d entries, %u saved since the boot, %u errors.", iCount, lCrashLogSaved, lCrashLogErrors );
+    return true;
+  }
+
+  if ( strcmp( szCommand, "CRASHLOG DUMP" ) == 0 )
+  {
+    if ( iCrashLogNewest == CRASH_LOG_SLOT_NONE )
+    {
+      LOG_INFO_APP( "Crash log : empty." );
+    }
+    else
+    {
+      CrashLogDump( CrashLogGetEntry( iCrashLogNewest ) );
+    }
+    return true;
+  }
+
+  if ( strcmp( szCommand, "CRASHLOG ERASE" ) == 0 )
+  {
+    if ( eCrashLogFlashState != CRASH_LOG_FLASH_IDLE )
+    {
+      LOG_INFO_APP( "Crash log : busy." );
+    }
+    else
+    {
+      eCrashLogFlashState = CRASH_LOG_FLASH_CLEAR;
+      if ( FM_QueueErase( CFG_CRASH_LOG_SECTOR_ID, CRASH_LOG_PAGE_NB, FM_PRIORITY_LOG, &stCrashLogFlashOp ) != FM_OK )
+      {
+        LOG_ERROR_APP( "Error, crash log erase refused." );
+        eCrashLogFlashState = CRASH_LOG_FLASH_IDLE;
+        lCrashLogErrors++;
+      }
+    }
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief  Restart the RAM entry empty.
+ * @param  None
+ * @retval None
+ */
+static void CrashLogReset( void )
+{
+  memset( &stCrashLogRam, 0, sizeof( stCrashLogRam ) );
+  stCrashLogRam.lMagic = CRASH_LOG_RAM_MAGIC;
+  stCrashLogRam.lSequenceInv = ~stCrashLogRam.lSequence;
+  stCrashLogRam.iRecordNb = CFG_CRASH_LOG_RECORD_NB;
+}
+
+/**
+ * @brief  Check of the RAM entry (random content after a power-on).
+ * @param  None
+ * @retval True if the RAM entry was filled before the reset.
+ */
+static bool CrashLogRamIsValid( void )
+{
+  /* The magic of the flash is set during the save : an entry not saved is saved again */
+  return ( ( ( stCrashLogRam.lMagic == CRASH_LOG_RAM_MAGIC ) || ( stCrashLogRam.lMagic == CRASH_LOG_MAGIC ) ) &&
+           ( stCrashLogRam.lSequenceInv == ~stCrashLogRam.lSequence ) &&
+           ( stCrashLogRam.iRecordNb == CFG_CRASH_LOG_RECORD_NB ) &&
+           ( stCrashLogRam.cReason <= (uint8_t)APP_CRASH_LOG_REASON_WATCHDOG ) );
+}
+
+/**
+ * @brief  Log module capture function : the frame replaces the oldest record of the ring. May be called from an
+ *         interrupt.
+ * @param  pFrame   Binary frame of the log
+ * @param  iSize    Size of the frame
+ * @retval None
+ */
+static void CrashLogCaptureFrame( const uint8_t * pFrame, uint16_t iSize )
+{
+  CrashLogRecord_t  * pstRecord;
+
+  if ( iSize > LOG_BINARY_FRAME_SIZE_MAX )
+  {
+    return;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  if ( bCrashLogCapture != false )
+  {
+    pstRecord = &stCrashLogRam.astRecords[stCrashLogRam.lRecordsTotal % CFG_CRASH_LOG_RECORD_NB];
+    memcpy( pstRecord->acFrame, pFrame, iSize );
+    pstRecord->iSize = iSize;
+    stCrashLogRam.lRecordsTotal++;
+  }
+
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief  Read the two pages : newest entry, sequence and slot of the next entry.
+ * @param  None
+ * @retval None
+ */
+static void CrashLogScan( void )
+{
+  const CrashLogEntry_t   * pstEntry;
+  uint16_t                iSlot;
+
+  iCrashLogNewest = CRASH_LOG_SLOT_NONE;
+  lCrashLogSequence = 0;
+
+  for ( iSlot = 0; iSlot < CRASH_LOG_SLOT_NB; iSlot++ )
+  {
+    pstEntry = CrashLogGetEntry( iSlot );
+    if ( ( CrashLogEntryIsValid( pstEntry ) != false ) && ( pstEntry->lSequence >= lCrashLogSequence ) )
+    {
+      lCrashLogSequence = pstEntry->lSequence + 1u;
+      iCrashLogNewest = iSlot;
+    }
+  }
+
+  iCrashLogNext = ( iCrashLogNewest == CRASH_LOG_SLOT_NONE ) ? 0u : (uint16_t)( ( iCrashLogNewest + 1u ) % CRASH_LOG_SLOT_NB );
+
+  /* A slot not erased (interrupted write) : the entries restart on the next page */
+  if ( ( ( iCrashLogNext % CRASH_LOG_ENTRY_PER_PAGE ) != 0u ) &&
+       ( CrashLogIsErased( (const uint32_t *)CrashLogGetEntry( iCrashLogNext ), sizeof( CrashLogEntry_t ) ) == false ) )
+  {
+    iCrashLogNext = (uint16_t)( ( ( ( iCrashLogNext / CRASH_LOG_ENTRY_PER_PAGE ) + 1u ) * CRASH_LOG_ENTRY_PER_PAGE ) % CRASH_LOG_SLOT_NB );
+  }
+}
+
+/**
+ * @brief  Save the RAM entry in the next slot : the capture is stopped until the end of the write (the RAM entry is
+ *         the source). A page is erased before its first entry.
+ * @param  None
+ * @retval None
+ */
+static void CrashLogSave( void )
+{
+  const uint32_t  * plPage;
+  uint32_t        lPage = iCrashLogNext / CRASH_LOG_ENTRY_PER_PAGE;
+
+  bCrashLogCapture = false;
+  stCrashLogRam.lMagic = CRASH_LOG_MAGIC;
+  stCrashLogRam.lSequence = lCrashLogSequence;
+  stCrashLogRam.lSequenceInv = ~lCrashLogSequence;
+
+  plPage = (const uint32_t *)( CFG_CRASH_LOG_ADDRESS + ( lPage * FLASH_PAGE_SIZE ) );
+  if ( ( ( iCrashLogNext % CRASH_LOG_ENTRY_PER_PAGE ) == 0u ) && ( CrashLogIsErased( plPage, FLASH_PAGE_SIZE ) == false ) )
+  {
+    eCrashLogFlashState = CRASH_LOG_FLASH_ERASE;
+    if ( FM_QueueErase( ( CFG_CRASH_LOG_SECTOR_ID + lPage ), 1u, FM_PRIORITY_LOG, &stCrashLogFlashOp ) != FM_OK )
+    {
+      LOG_ERROR_APP( "Error, crash log erase refused (page %d).", lPage );
+      eCrashLogFlashState = CRASH_LOG_FLASH_IDLE;
+      lCrashLogErrors++;
+      CrashLogReset();
+      bCrashLogCapture = true;
+    }
+  }
+  else
+  {
+    CrashLogWrite();
+  }
+}
+
+/**
+ * @brief  Write the RAM entry in the next slot.
+ * @param  None
+ * @retval None
+ */
+static void CrashLogWrite( void )
+{
+  eCrashLogFlashState = CRASH_LOG_FLASH_WRITE;
+  if ( FM_QueueWrite( (uint32_t *)&stCrashLogRam, (uint32_t *)CrashLogGetEntry( iCrashLogNext ),
+                      (int32_t)( sizeof( stCrashLogRam ) / sizeof( uint32_t ) ), FM_PRIORITY_LOG, &stCrashLogFlashOp ) != FM_OK )
+  {
+    LOG_ERROR_APP( "Error, crash log write refused (slot %d).", iCrashLogNext );
+    eCrashLogFlashState = CRASH_LOG_FLASH_IDLE;
+    lCrashLogErrors++;
+    CrashLogReset();
+    bCrashLogCapture = true;
+  }
+}
+
+/**
+ * @brief  Flash Manager callback : end of a queued erase/write. The write of the entry is queued at the end of the
+ *         erase of its page. The RAM ring restarts empty once the entry is written (or lost).
+ * @param  eStatus  Flash operation status
+ * @retval None
+ */
+static void CrashLogFlashCallback( FM_FlashOp_Status_t eStatus )
+{
+  CrashLogFlashState_t  eState = eCrashLogFlashState;
+
+  eCrashLogFlashState = CRASH_LOG_FLASH_IDLE;
+
+  if ( eStatus != FM_OPERATION_COMPLETE )
+  {
+    LOG_ERROR_APP( "Error, crash log flash operation failed." );
+    lCrashLogErrors++;
+  }
+  else if ( eState == CRASH_LOG_FLASH_ERASE )
+  {
+    CrashLogWrite();
+    return;
+  }
+  else if ( eState == CRASH_LOG_FLASH_WRITE )
+  {
+    iCrashLogNewest = iCrashLogNext;
+    iCrashLogNext = (uint16_t)( ( iCrashLogNext + 1u ) % CRASH_LOG_SLOT_NB );
+    lCrashLogSequence++;
+    lCrashLogSaved++;
+  }
+  else if ( eState == CRASH_LOG_FLASH_CLEAR )
+  {
+    LOG_INFO_APP( "Crash log erased." );
+    iCrashLogNewest = CRASH_LOG_SLOT_NONE;
+    iCrashLogNext = 0;
+    return;
+  }
+
+  if ( ( eState == CRASH_LOG_FLASH_ERASE ) || ( eState == CRASH_LOG_FLASH_WRITE ) )
+  {
+    CrashLogReset();
+    bCrashLogCapture = true;
+  }
+}
+
+/**
+ * @brief  Print the summary of an entry.
+ * @param  pstEntry   Entry in flash
+ * @retval None
+ */
+static void CrashLogPrintEntry( const CrashLogEntry_t * pstEntry )
+{
+  LOG_INFO_APP( "Crash #%u : %s at %u ms, Id 0x%08X, Code 0x%08X, caller 0x%08X, reset flags 0x%08X, %u logs.",
+                pstEntry->lSequence, szCrashLogReason[pstEntry->cReason], pstEntry->lUptime, pstEntry->lErrorId,
+                pstEntry->lErrorCode, pstEntry->lCaller, pstEntry->lResetFlags, pstEntry->lRecordsTotal );
+}
+
+/**
+ * @brief  Print the profiling counters of an entry, then send its logs (oldest first) as binary frames. The frames
+ *         refer to the format strings of the firmware that crashed. The dump stops when the trace FIFO is full.
+ * @param  pstEntry   Entry in flash
+ * @retval None
+ */
+static void CrashLogDump( const CrashLogEntry_t * pstEntry )
+{
+  const CrashLogRecord_t  * pstRecord;
+  uint32_t                lCount;
+  uint32_t                lFirst;
+  uint32_t                lSent = 0;
+
+  CrashLogPrintEntry( pstEntry );
+  LOG_INFO_APP( "  Flash : %u windows, %u us granted, %u us used, %u quad-words, %u sectors.",
+                pstEntry->stFlashStats.WindowCount, pstEntry->stFlashStats.GrantedTime, pstEntry->stFlashStats.UsedTime,
+                pstEntry->stFlashStats.QuadWords, pstEntry->stFlashStats.Sectors );
+
+  for ( uint32_t lTask = 0; lTask < CRASH_LOG_TASK_NB; lTask++ )
+  {
+    if ( pstEntry->astTasks[lTask].lCallCount != 0u )
+    {
+      LOG_INFO_APP( "  Task %2d : %u runs, max %u, max latency %u.", lTask, pstEntry->astTasks[lTask].lCallCount,
+                    pstEntry->astTasks[lTask].lMaxTime, pstEntry->astTasks[lTask].lMaxLatency );
+    }
+  }
+
+  lCount = ( pstEntry->lRecordsTotal < CFG_CRASH_LOG_RECORD_NB ) ? pstEntry->lRecordsTotal : CFG_CRASH_LOG_RECORD_NB;
+  lFirst = pstEntry->lRecordsTotal - lCount;
+  for ( uint32_t lIndex = 0; lIndex < lCount; lIndex++ )
+  {
+    pstRecord = &pstEntry->astRecords[( lFirst + lIndex ) % CFG_CRASH_LOG_RECORD_NB];
+    if ( ( pstRecord->iSize == 0u ) || ( pstRecord->iSize > LOG_BINARY_FRAME_SIZE_MAX ) )
+    {
+      continue;
+    }
+    if ( UTIL_ADV_TRACE_Send( pstRecord->acFrame, pstRecord->iSize ) != UTIL_ADV_TRACE_OK )
+    {
+      break;
+    }
+    lSent++;
+  }
+
+  LOG_INFO_APP( "  %u of the last %u logs sent.", lSent, lCount );
+
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  APP_FRAME_LOG_Print( pstEntry->astFrames, pstEntry->lFramesTotal );
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+}
+
+/**
+ * @brief  Entry of the log in flash.
+ * @param  iSlot    Slot of the entry
+ * @retval Entry
+ */
+static const CrashLogEntry_t * CrashLogGetEntry( uint16_t iSlot )
+{
+  uint32_t  lPage = iSlot / CRASH_LOG_ENTRY_PER_PAGE;
+  uint32_t  lIndex = iSlot % CRASH_LOG_ENTRY_PER_PAGE;
+
+  return (const CrashLogEntry_t *)( CFG_CRASH_LOG_ADDRESS + ( lPage * FLASH_PAGE_SIZE ) + ( lIndex * sizeof( CrashLogEntry_t ) ) );
+}
+
+/**
+ * @brief  Check of an entry read from flash.
+ * @param  pstEntry   Entry
+ * @retval True if the entry holds a crash.
+ */
+static bool CrashLogEntryIsValid( const CrashLogEntry_t * pstEntry )
+{
+  return ( ( pstEntry->lMagic == CRASH_LOG_MAGIC ) && ( pstEntry->lSequenceInv == ~pstEntry->lSequence ) &&
+           ( pstEntry->iRecordNb == CFG_CRASH_LOG_RECORD_NB ) && ( pstEntry->cReason <= (uint8_t)APP_CRASH_LOG_REASON_WATCHDOG ) );
+}
+
+/**
+ * @brief  Check of a flash area.
+ * @param  plAddress  Start of the area
+ * @param  lSize      Size of the area in bytes
+ * @retval True if the area is erased (can be written).
+ */
+static bool CrashLogIsErased( const uint32_t * plAddress, uint32_t lSize )
+{
+  for ( uint32_t lWord = 0; lWord < ( lSize / sizeof( uint32_t ) ); lWord++ )
+  {
+    if ( plAddress[lWord] != CRASH_LOG_ERASED )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#else /* (CFG_CRASH_LOG_SUPPORTED != 0) */
+
+/**
+ * @brief  Crash log not supported.
+ */
+void APP_CRASH_LOG_Init( void )
+{
+}
+
+/**
+ * @brief  Crash log not supported : the fatal error is not recorded.
+ */
+void APP_CRASH_LOG_Fatal( APP_CRASH_LOG_Reason_t eReason, uint32_t lId, uint32_t lCode )
+{
+  UNUSED( eReason );
+  UNUSED( lId );
+  UNUSED( lCode );
+}
+
+/**
+ * @brief  Crash log not supported : no command.
+ */
+bool APP_CRASH_LOG_SerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_CRASH_LOG_SUPPORTED != 0) */
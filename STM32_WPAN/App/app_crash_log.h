@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    app_crash_log.h
+  * @author  MCD Application Team
+  * @brief   Interface of the crash log (last logs and profiling counters kept
+  *          across the resets, saved in flash after a fatal error).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CRASH_LOG_H
+#define APP_CRASH_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Cause of a crash log entry */
+typedef enum
+{
+  APP_CRASH_LOG_REASON_NONE,
+  APP_CRASH_LOG_REASON_ZIGBEE_ERROR,    /* APP_ZIGBEE_Error : Id = message address, Code = error code */
+  APP_CRASH_LOG_REASON_ERROR_HANDLER,   /* Error_Handler : Id and Code unused */
+  APP_CRASH_LOG_REASON_ASSERT,          /* assert_failed : Id = line, Code = file name address */
+  APP_CRASH_LOG_REASON_HARDFAULT,       /* HardFault : Id = HFSR, Code = CFSR */
+  APP_CRASH_LOG_REASON_WATCHDOG,        /* Watchdog reset seen at boot : Id and Code unused */
+} APP_CRASH_LOG_Reason_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_CRASH_LOG_Init                ( void );
+void      APP_CRASH_LOG_Fatal               ( APP_CRASH_LOG_Reason_t eReason, uint32_t lId, uint32_t lCode );
+bool      APP_CRASH_LOG_SerialCmdExecute    ( const char * szCommand );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CRASH_LOG_H */
@@ -0,0 +1,387 @@
+/**
+  ******************************************************************************
+  * @file    app_crypto_bench.c
+  * @author  MCD Application Team
+  * @brief   Crypto micro-benchmarks : the AES, BasicAES and PKA P-256 operations
+  *          are timed in DWT cycles over a range of sizes, one iteration per
+  *          run of the Task (the radio stacks keep running in between), and
+  *          the results are printed in CSV on the trace UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_crypto_bench.h"
+
+#include "stm32_rtos.h"
+#include "hw.h"
+#include "baes.h"
+
+#if (CFG_CRYPTO_BENCH_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define CRYPTO_BENCH_DATA_MAX           (1024u)     /* Largest size benchmarked */
+#define CRYPTO_BENCH_CCM_NONCE_LENGTH   (13u)
+#define CRYPTO_BENCH_CCM_AUTH_LENGTH    (16u)
+#define CRYPTO_BENCH_CCM_MIC_LENGTH     (4u)
+
+/* Private typedef -----------------------------------------------------------*/
+/* One benchmarked operation : pfPrepare and pfRelease (can be NULL) are not timed */
+typedef struct
+{
+  const char  * szName;
+  uint16_t    iSize;
+  uint16_t    iIterations;
+  void        (*pfPrepare)( void );
+  bool        (*pfRun)( uint16_t iSize );
+  void        (*pfRelease)( void );
+} CryptoBenchCase_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     CryptoBenchTask             ( void );
+static void     CryptoBenchAesPrepare       ( void );
+static void     CryptoBenchAesRelease       ( void );
+static bool     CryptoBenchAesCrypt         ( uint16_t iSize );
+static bool     CryptoBenchAesCryptBlocks   ( uint16_t iSize );
+static bool     CryptoBenchEcbCrypt         ( uint16_t iSize );
+static bool     CryptoBenchCmacCompute      ( uint16_t iSize );
+static bool     CryptoBenchCcmCrypt         ( uint16_t iSize );
+static bool     CryptoBenchMmoHash          ( uint16_t iSize );
+static bool     CryptoBenchPkaRangeCheck    ( uint16_t iSize );
+static bool     CryptoBenchPkaEccScalarMul  ( uint16_t iSize );
+static bool     CryptoBenchPkaPointCheck    ( uint16_t iSize );
+
+/* Private variables ---------------------------------------------------------*/
+static const CryptoBenchCase_t  astCryptoBenchCases[] =
+{
+  { "HW_AES_Crypt",                 16u,    CFG_CRYPTO_BENCH_ITERATIONS,       CryptoBenchAesPrepare,  CryptoBenchAesCrypt,        CryptoBenchAesRelease },
+  { "HW_AES_CryptBlocks",           64u,    CFG_CRYPTO_BENCH_ITERATIONS,       CryptoBenchAesPrepare,  CryptoBenchAesCryptBlocks,  CryptoBenchAesRelease },
+  { "HW_AES_CryptBlocks",           256u,   CFG_CRYPTO_BENCH_ITERATIONS,       CryptoBenchAesPrepare,  CryptoBenchAesCryptBlocks,  CryptoBenchAesRelease },
+  { "HW_AES_CryptBlocks",           1024u,  CFG_CRYPTO_BENCH_ITERATIONS,       CryptoBenchAesPrepare,  CryptoBenchAesCryptBlocks,  CryptoBenchAesRelease },
+  { "BAES_EcbCrypt",                16u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchEcbCrypt,        NULL },
+  { "BAES_CmacCompute",             16u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCmacCompute,     NULL },
+  { "BAES_CmacCompute",             64u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCmacCompute,     NULL },
+  { "BAES_CmacCompute",             256u,   CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCmacCompute,     NULL },
+  { "BAES_CmacCompute",             1024u,  CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCmacCompute,     NULL },
+  { "BAES_CcmCrypt",                16u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCcmCrypt,        NULL },
+  { "BAES_CcmCrypt",                64u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCcmCrypt,        NULL },
+  { "BAES_CcmCrypt",                100u,   CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchCcmCrypt,        NULL },
+  { "BAES_MmoHash",                 18u,    CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchMmoHash,         NULL },
+  { "BAES_MmoHash",                 256u,   CFG_CRYPTO_BENCH_ITERATIONS,       NULL,                   CryptoBenchMmoHash,         NULL },
+  { "HW_PKA_P256_RangeCheck",       32u,    CFG_CRYPTO_BENCH_PKA_ITERATIONS,   NULL,                   CryptoBenchPkaRangeCheck,   NULL },
+  { "HW_PKA_P256_EccScalarMul",     32u,    CFG_CRYPTO_BENCH_PKA_ITERATIONS,   NULL,                   CryptoBenchPkaEccScalarMul, NULL },
+  { "HW_PKA_P256_PointCheck",       64u,    CFG_CRYPTO_BENCH_PKA_ITERATIONS,   NULL,                   CryptoBenchPkaPointCheck,   NULL },
+};
+
+static const uint8_t            aCryptoBenchKey[16] =
+{
+  0x2Bu, 0x7Eu, 0x15u, 0x16u, 0x28u, 0xAEu, 0xD2u, 0xA6u, 0xABu, 0xF7u, 0x15u, 0x88u, 0x09u, 0xCFu, 0x4Fu, 0x3Cu
+};
+
+/* Scalar of the PKA operations (lower than the order of the curve), LSB first */
+static const uint32_t           alCryptoBenchScalar[8] =
+{
+  0x1B2C3D4Eu, 0x5F607182u, 0x93A4B5C6u, 0xD7E8F901u, 0x12233445u, 0x56677889u, 0x9AABBCCDu, 0x5A5A5A5Au
+};
+
+static uint32_t                 alCryptoBenchInput[CRYPTO_BENCH_DATA_MAX / 4u];
+static uint32_t                 alCryptoBenchOutput[CRYPTO_BENCH_DATA_MAX / 4u];
+static uint32_t                 alCryptoBenchPointX[8];
+static uint32_t                 alCryptoBenchPointY[8];
+static uint8_t                  aCryptoBenchTag[16];
+
+static bool                     bCryptoBenchRunning;
+static uint16_t                 iCryptoBenchCase;
+static uint16_t                 iCryptoBenchIteration;
+static uint32_t                 lCryptoBenchMin, lCryptoBenchMax;
+static uint64_t                 llCryptoBenchTotal;
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the Task of the benchmarks and the DWT cycle counter.
+ * @param  None
+ * @retval None
+ */
+void APP_CRYPTO_BenchInit( void )
+{
+  uint32_t  lIndex;
+
+  for ( lIndex = 0; lIndex < ( CRYPTO_BENCH_DATA_MAX / 4u ); lIndex++ )
+  {
+    alCryptoBenchInput[lIndex] = ( lIndex * 0x01010101u ) ^ 0xA5C31E07u;
+  }
+
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_CRYPTO_BENCH ), UTIL_SEQ_RFU, CryptoBenchTask );
+}
+
+/**
+ * @brief  Benchmark serial command : CRYPTOBENCH (run all the benchmarks).
+ * @param  szCommand  Command received
+ * @retval True if the command is a benchmark command.
+ */
+bool APP_CRYPTO_BenchSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "CRYPTOBENCH" ) != 0 )
+  {
+    return false;
+  }
+
+  if ( bCryptoBenchRunning != false )
+  {
+    LOG_INFO_APP( "Crypto benchmarks already running." );
+    return true;
+  }
+
+  /* Chip cut and clock first, so that the results of several devices can be compared */
+  LOG_INFO_APP( "CRYPTOBENCH,device,0x%03X,revision,0x%04X,sysclk,%d", HAL_GetDEVID(), HAL_GetREVID(), SystemCoreClock );
+  LOG_INFO_APP( "CRYPTOBENCH,operation,size,iterations,min_cycles,avg_cycles,max_cycles" );
+
+  bCryptoBenchRunning = true;
+  iCryptoBenchCase = 0;
+  iCryptoBenchIteration = 0;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_CRYPTO_BENCH ), TASK_PRIO_CRYPTO_BENCH );
+
+  return true;
+}
+
+/**
+ * @brief  One iteration of the current benchmark, its CSV line after the last one.
+ * @param  None
+ * @retval None
+ */
+static void CryptoBenchTask( void )
+{
+  const CryptoBenchCase_t * pstCase = &astCryptoBenchCases[iCryptoBenchCase];
+  uint32_t                  lStart, lCycles;
+  bool                      bSuccess;
+
+  if ( iCryptoBenchIteration == 0u )
+  {
+    lCryptoBenchMin = UINT32_MAX;
+    lCryptoBenchMax = 0;
+    llCryptoBenchTotal = 0;
+  }
+
+  if ( pstCase->pfPrepare != NULL )
+  {
+    pstCase->pfPrepare();
+  }
+
+  lStart = DWT->CYCCNT;
+  bSuccess = pstCase->pfRun( pstCase->iSize );
+  lCycles = DWT->CYCCNT - lStart;
+
+  if ( pstCase->pfRelease != NULL )
+  {
+    pstCase->pfRelease();
+  }
+
+  if ( bSuccess == false )
+  {
+    LOG_INFO_APP( "CRYPTOBENCH,%s,%d,0,,,", pstCase->szName, pstCase->iSize );
+    iCryptoBenchIteration = pstCase->iIterations;
+  }
+  else
+  {
+    lCryptoBenchMin = MIN( lCryptoBenchMin, lCycles );
+    lCryptoBenchMax = MAX( lCryptoBenchMax, lCycles );
+    llCryptoBenchTotal += lCycles;
+
+    iCryptoBenchIteration++;
+    if ( iCryptoBenchIteration >= pstCase->iIterations )
+    {
+      LOG_INFO_APP( "CRYPTOBENCH,%s,%d,%d,%d,%d,%d", pstCase->szName, pstCase->iSize, pstCase->iIterations,
+                    lCryptoBenchMin, (uint32_t)( llCryptoBenchTotal / pstCase->iIterations ), lCryptoBenchMax );
+    }
+  }
+
+  if ( iCryptoBenchIteration >= pstCase->iIterations )
+  {
+    iCryptoBenchIteration = 0;
+    iCryptoBenchCase++;
+    if ( iCryptoBenchCase >= ( sizeof( astCryptoBenchCases ) / sizeof( astCryptoBenchCases[0] ) ) )
+    {
+      bCryptoBenchRunning = false;
+      LOG_INFO_APP( "CRYPTOBENCH,end" );
+      return;
+    }
+  }
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_CRYPTO_BENCH ), TASK_PRIO_CRYPTO_BENCH );
+}
+
+/**
+ * @brief  Raw AES : key loaded out of the measure.
+ */
+static void CryptoBenchAesPrepare( void )
+{
+  HW_AES_Enable();
+  HW_AES_SetKey( HW_AES_ENC, aCryptoBenchKey );
+}
+
+/**
+ * @brief  Raw AES : end.
+ */
+static void CryptoBenchAesRelease( void )
+{
+  HW_AES_Disable();
+}
+
+/**
+ * @brief  One block through HW_AES_Crypt.
+ */
+static bool CryptoBenchAesCrypt( uint16_t iSize )
+{
+  UNUSED( iSize );
+
+  HW_AES_Crypt( alCryptoBenchInput, alCryptoBenchOutput );
+  return true;
+}
+
+/**
+ * @brief  iSize bytes through the pipelined HW_AES_CryptBlocks.
+ */
+static bool CryptoBenchAesCryptBlocks( uint16_t iSize )
+{
+  HW_AES_CryptBlocks( alCryptoBenchInput, alCryptoBenchOutput, ( iSize / 16u ) );
+  return true;
+}
+
+/**
+ * @brief  One block through BAES_EcbCrypt (key and clock of the AES set at each call).
+ */
+static bool CryptoBenchEcbCrypt( uint16_t iSize )
+{
+  UNUSED( iSize );
+
+  BAES_EcbCrypt( aCryptoBenchKey, (const uint8_t *)alCryptoBenchInput, (uint8_t *)alCryptoBenchOutput, HW_AES_ENC );
+  return true;
+}
+
+/**
+ * @brief  CMAC of iSize bytes (key set included).
+ */
+static bool CryptoBenchCmacCompute( uint16_t iSize )
+{
+  BAES_CmacSetKey( aCryptoBenchKey );
+  BAES_CmacCompute( (const uint8_t *)alCryptoBenchInput, iSize, aCryptoBenchTag );
+  return true;
+}
+
+/**
+ * @brief  CCM encryption of iSize bytes, with the header and MIC of a secured Zigbee frame.
+ */
+static bool CryptoBenchCcmCrypt( uint16_t iSize )
+{
+  (void)BAES_CcmCrypt( 0, aCryptoBenchKey, CRYPTO_BENCH_CCM_NONCE_LENGTH, (const uint8_t *)alCryptoBenchOutput,
+                       CRYPTO_BENCH_CCM_AUTH_LENGTH, (const uint8_t *)alCryptoBenchInput, iSize,
+                       (const uint8_t *)alCryptoBenchInput, CRYPTO_BENCH_CCM_MIC_LENGTH, aCryptoBenchTag,
+                       (uint8_t *)alCryptoBenchOutput );
+  return true;
+}
+
+/**
+ * @brief  AES-MMO hash of iSize bytes.
+ */
+static bool CryptoBenchMmoHash( uint16_t iSize )
+{
+  BAES_MmoHash( (const uint8_t *)alCryptoBenchInput, iSize, aCryptoBenchTag );
+  return true;
+}
+
+/**
+ * @brief  PKA P-256 range check of a coordinate (PKA enabled and released in the measure).
+ */
+static bool CryptoBenchPkaRangeCheck( uint16_t iSize )
+{
+  UNUSED( iSize );
+
+  if ( HW_PKA_Enable() == FALSE )
+  {
+    return false;
+  }
+
+  HW_PKA_P256_StartRangeCheck( alCryptoBenchScalar );
+  while ( HW_PKA_EndOfOperation() == 0 ) {}
+  (void)HW_PKA_P256_IsRangeCheckOk();
+  HW_PKA_Disable();
+
+  return true;
+}
+
+/**
+ * @brief  PKA P-256 scalar multiplication of the base point. The result is the point of the point check.
+ */
+static bool CryptoBenchPkaEccScalarMul( uint16_t iSize )
+{
+  UNUSED( iSize );
+
+  if ( HW_PKA_Enable() == FALSE )
+  {
+    return false;
+  }
+
+  HW_PKA_P256_StartEccScalarMul( alCryptoBenchScalar, NULL, NULL );
+  while ( HW_PKA_EndOfOperation() == 0 ) {}
+  HW_PKA_P256_ReadEccScalarMul( alCryptoBenchPointX, alCryptoBenchPointY );
+  HW_PKA_Disable();
+
+  return true;
+}
+
+/**
+ * @brief  PKA P-256 check of the point computed by the scalar multiplication.
+ */
+static bool CryptoBenchPkaPointCheck( uint16_t iSize )
+{
+  UNUSED( iSize );
+
+  if ( HW_PKA_Enable() == FALSE )
+  {
+    return false;
+  }
+
+  HW_PKA_P256_StartPointCheck( alCryptoBenchPointX, alCryptoBenchPointY );
+  while ( HW_PKA_EndOfOperation() == 0 ) {}
+  (void)HW_PKA_P256_IsPointCheckOk();
+  HW_PKA_Disable();
+
+  return true;
+}
+
+#else /* (CFG_CRYPTO_BENCH_SUPPORTED != 0) */
+
+/**
+ * @brief  No benchmark.
+ */
+void APP_CRYPTO_BenchInit( void )
+{
+}
+
+/**
+ * @brief  No benchmark : no command.
+ */
+bool APP_CRYPTO_BenchSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_CRYPTO_BENCH_SUPPORTED != 0) */
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    app_crypto_bench.h
+  * @author  MCD Application Team
+  * @brief   Interface of the crypto micro-benchmarks (CRYPTOBENCH command).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_CRYPTO_BENCH_H
+#define APP_CRYPTO_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_CRYPTO_BenchInit              ( void );
+bool      APP_CRYPTO_BenchSerialCmdExecute  ( const char * szCommand );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CRYPTO_BENCH_H */
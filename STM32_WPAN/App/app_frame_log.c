@@ -0,0 +1,292 @@
+/**
+  ******************************************************************************
+  * @file    app_frame_log.c
+  * @author  MCD Application Team
+  * @brief   Frame log : the metadata of the last frames sent or received by
+  *          the MAC are kept in a RAM ring (.noinit section), filled in the
+  *          radio callbacks without any formatting. Printed with the FRAMELOG
+  *          serial command and added to the crash log entry.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_frame_log.h"
+
+#include "stm32_timer.h"
+
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define FRAME_LOG_MAGIC                 (0x46524C47u)           /* "FRLG" */
+
+/* IEEE 802.15.4-2006 MAC header */
+#define FRAME_LOG_MAC_HEADER_MIN        (3u)                    /* Frame Control, Sequence Number */
+#define FRAME_LOG_MAC_TYPE_DATA         (1u)
+#define FRAME_LOG_MAC_SECURITY          (0x0008u)
+#define FRAME_LOG_MAC_PANID_COMPRESSION (0x0040u)
+#define FRAME_LOG_MAC_DST_MODE_POS      (10u)
+#define FRAME_LOG_MAC_SRC_MODE_POS      (14u)
+#define FRAME_LOG_MAC_ADDR_MODE_MASK    (0x03u)
+#define FRAME_LOG_MAC_ADDR_SHORT        (2u)
+
+/* Zigbee NWK header : Frame Control, Destination, Source, Radius, Sequence Number */
+#define FRAME_LOG_NWK_HEADER_MIN        (8u)
+#define FRAME_LOG_NWK_SEQUENCE_OFFSET   (7u)
+#define FRAME_LOG_NWK_TYPE_MASK         (0x03u)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Ring of the records : kept across the resets, saved by the crash log after a watchdog reset */
+typedef struct
+{
+  uint32_t                lMagic;
+  uint16_t                iRecordNb;            /* CFG_FRAME_LOG_RECORD_NB */
+  uint16_t                iRfu;
+  uint32_t                lTotal;               /* Frames recorded : the last one is in record ( lTotal - 1 ) % iRecordNb */
+  APP_FRAME_LOG_Record_t  astRecords[CFG_FRAME_LOG_RECORD_NB];
+} FrameLog_t;
+
+/* Private variables ---------------------------------------------------------*/
+static FrameLog_t                   stFrameLog PLACE_IN_SECTION( ".noinit" );
+static bool                         bFrameLogCapture;
+
+static const char * const           szFrameLogMacType[] = { "beacon", "data", "ack", "command", "?", "?", "?", "?" };
+static const char * const           szFrameLogNwkType[] = { "data", "command", "?", "inter-PAN" };
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Restart the ring empty, then record the frames. Called after APP_CRASH_LOG_Init, that takes the ring of the
+ *         previous run after a watchdog reset.
+ * @param  None
+ * @retval None
+ */
+void APP_FRAME_LOG_Init( void )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  memset( &stFrameLog, 0, sizeof( stFrameLog ) );
+  stFrameLog.lMagic = FRAME_LOG_MAGIC;
+  stFrameLog.iRecordNb = CFG_FRAME_LOG_RECORD_NB;
+  bFrameLogCapture = true;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief  Record the metadata of a frame in place of the oldest one : only the fixed fields of the MAC header and the
+ *         NWK sequence number of the data frames are read. Called from the radio interrupt.
+ * @param  bTx      True for a frame sent
+ * @param  pFrame   MAC frame (Frame Control first)
+ * @param  iLength  Length of the frame
+ * @param  cRssi    RSSI of the frame received, or of the acknowledgment of the frame sent
+ * @param  cLqi     LQI, same as cRssi
+ * @param  cResult  Result of the transmission or of the reception (ral_error_enum_t)
+ * @retval None
+ */
+void APP_FRAME_LOG_Record( bool bTx, const uint8_t * pFrame, uint16_t iLength, int8_t cRssi, uint8_t cLqi, uint8_t cResult )
+{
+  APP_FRAME_LOG_Record_t  stRecord;
+  uint16_t                iControl;
+  uint16_t                iIndex = FRAME_LOG_MAC_HEADER_MIN;
+  uint8_t                 cMode;
+
+  if ( ( bFrameLogCapture == false ) || ( pFrame == NULL ) || ( iLength < FRAME_LOG_MAC_HEADER_MIN ) )
+  {
+    return;
+  }
+
+  iControl = (uint16_t)pFrame[0] | ( (uint16_t)pFrame[1] << 8 );
+
+  stRecord.lTime = UTIL_TIMER_GetCurrentTime();
+  stRecord.iSource = APP_FRAME_LOG_ADDR_NONE;
+  stRecord.iDestination = APP_FRAME_LOG_ADDR_NONE;
+  stRecord.cMacSequence = pFrame[2];
+  stRecord.cNwkSequence = 0;
+  stRecord.cType = (uint8_t)( ( iControl & APP_FRAME_LOG_TYPE_MAC_MASK ) | ( ( bTx != false ) ? APP_FRAME_LOG_TYPE_TX : 0u ) );
+  stRecord.cLength = ( iLength > UINT8_MAX ) ? UINT8_MAX : (uint8_t)iLength;
+  stRecord.cRssi = cRssi;
+  stRecord.cLqi = cLqi;
+  stRecord.cResult = cResult;
+  stRecord.cRfu = 0;
+
+  /* Destination : PAN Id then address */
+  cMode = (uint8_t)( ( iControl >> FRAME_LOG_MAC_DST_MODE_POS ) & FRAME_LOG_MAC_ADDR_MODE_MASK );
+  if ( cMode != 0u )
+  {
+    iIndex += 2u;
+    if ( ( cMode == FRAME_LOG_MAC_ADDR_SHORT ) && ( ( iIndex + 2u ) <= iLength ) )
+    {
+      stRecord.iDestination = (uint16_t)pFrame[iIndex] | ( (uint16_t)pFrame[iIndex + 1u] << 8 );
+    }
+    iIndex += ( cMode == FRAME_LOG_MAC_ADDR_SHORT ) ? 2u : 8u;
+  }
+
+  /* Source : PAN Id when not compressed, then address */
+  cMode = (uint8_t)( ( iControl >> FRAME_LOG_MAC_SRC_MODE_POS ) & FRAME_LOG_MAC_ADDR_MODE_MASK );
+  if ( cMode != 0u )
+  {
+    if ( ( iControl & FRAME_LOG_MAC_PANID_COMPRESSION ) == 0u )
+    {
+      iIndex += 2u;
+    }
+    if ( ( cMode == FRAME_LOG_MAC_ADDR_SHORT ) && ( ( iIndex + 2u ) <= iLength ) )
+    {
+      stRecord.iSource = (uint16_t)pFrame[iIndex] | ( (uint16_t)pFrame[iIndex + 1u] << 8 );
+    }
+    iIndex += ( cMode == FRAME_LOG_MAC_ADDR_SHORT ) ? 2u : 8u;
+  }
+
+  /* NWK header of a data frame (Zigbee does not secure at the MAC layer) */
+  if ( ( ( iControl & APP_FRAME_LOG_TYPE_MAC_MASK ) == FRAME_LOG_MAC_TYPE_DATA ) &&
+       ( ( iControl & FRAME_LOG_MAC_SECURITY ) == 0u ) && ( ( iIndex + FRAME_LOG_NWK_HEADER_MIN ) <= iLength ) )
+  {
+    stRecord.cNwkSequence = pFrame[iIndex + FRAME_LOG_NWK_SEQUENCE_OFFSET];
+    stRecord.cType |= (uint8_t)( ( ( pFrame[iIndex] & FRAME_LOG_NWK_TYPE_MASK ) << APP_FRAME_LOG_TYPE_NWK_POS ) | APP_FRAME_LOG_TYPE_NWK );
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  stFrameLog.astRecords[stFrameLog.lTotal % CFG_FRAME_LOG_RECORD_NB] = stRecord;
+  stFrameLog.lTotal++;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief  Copy the ring (kept across a reset until APP_FRAME_LOG_Init). Can be called from any context.
+ * @param  pstRecords   CFG_FRAME_LOG_RECORD_NB records to fill
+ * @retval Frames recorded in the ring, 0 if the ring is not valid (power-on).
+ */
+uint32_t APP_FRAME_LOG_Copy( APP_FRAME_LOG_Record_t * pstRecords )
+{
+  uint32_t  lTotal = 0;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( ( stFrameLog.lMagic == FRAME_LOG_MAGIC ) && ( stFrameLog.iRecordNb == CFG_FRAME_LOG_RECORD_NB ) )
+  {
+    memcpy( pstRecords, stFrameLog.astRecords, sizeof( stFrameLog.astRecords ) );
+    lTotal = stFrameLog.lTotal;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return lTotal;
+}
+
+/**
+ * @brief  Print the records of a ring, oldest first.
+ * @param  pstRecords   CFG_FRAME_LOG_RECORD_NB records
+ * @param  lTotal       Frames recorded in the ring
+ * @retval None
+ */
+void APP_FRAME_LOG_Print( const APP_FRAME_LOG_Record_t * pstRecords, uint32_t lTotal )
+{
+  const APP_FRAME_LOG_Record_t  * pstRecord;
+  uint32_t                      lCount;
+  uint32_t                      lFirst;
+
+  lCount = ( lTotal < CFG_FRAME_LOG_RECORD_NB ) ? lTotal : CFG_FRAME_LOG_RECORD_NB;
+  lFirst = lTotal - lCount;
+
+  for ( uint32_t lIndex = 0; lIndex < lCount; lIndex++ )
+  {
+    pstRecord = &pstRecords[( lFirst + lIndex ) % CFG_FRAME_LOG_RECORD_NB];
+    if ( ( pstRecord->cType & APP_FRAME_LOG_TYPE_NWK ) != 0u )
+    {
+      LOG_INFO_APP( "  %10u ms %s 0x%04X > 0x%04X, MAC %s #%u, NWK %s #%u, %u bytes, RSSI %d LQI %u, result %u.",
+                    pstRecord->lTime, ( ( pstRecord->cType & APP_FRAME_LOG_TYPE_TX ) != 0u ) ? "TX" : "RX",
+                    pstRecord->iSource, pstRecord->iDestination,
+                    szFrameLogMacType[pstRecord->cType & APP_FRAME_LOG_TYPE_MAC_MASK], pstRecord->cMacSequence,
+                    szFrameLogNwkType[( pstRecord->cType & APP_FRAME_LOG_TYPE_NWK_MASK ) >> APP_FRAME_LOG_TYPE_NWK_POS],
+                    pstRecord->cNwkSequence, pstRecord->cLength, pstRecord->cRssi, pstRecord->cLqi, pstRecord->cResult );
+    }
+    else
+    {
+      LOG_INFO_APP( "  %10u ms %s 0x%04X > 0x%04X, MAC %s #%u, %u bytes, RSSI %d LQI %u, result %u.",
+                    pstRecord->lTime, ( ( pstRecord->cType & APP_FRAME_LOG_TYPE_TX ) != 0u ) ? "TX" : "RX",
+                    pstRecord->iSource, pstRecord->iDestination,
+                    szFrameLogMacType[pstRecord->cType & APP_FRAME_LOG_TYPE_MAC_MASK], pstRecord->cMacSequence,
+                    pstRecord->cLength, pstRecord->cRssi, pstRecord->cLqi, pstRecord->cResult );
+    }
+  }
+
+  LOG_INFO_APP( "  %u of the last %u frames (0x%04X : extended or no address).", lCount, lTotal, APP_FRAME_LOG_ADDR_NONE );
+}
+
+/**
+ * @brief  Frame log serial command : FRAMELOG (records of the ring, oldest first).
+ * @param  szCommand  Command received
+ * @retval True if the command is a frame log command.
+ */
+bool APP_FRAME_LOG_SerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "FRAMELOG" ) == 0 )
+  {
+    /* Printed from the ring itself : the frames recorded meanwhile replace the oldest ones */
+    APP_FRAME_LOG_Print( stFrameLog.astRecords, stFrameLog.lTotal );
+    return true;
+  }
+
+  return false;
+}
+
+#else /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+/**
+ * @brief  Frame log not supported.
+ */
+void APP_FRAME_LOG_Init( void )
+{
+}
+
+/**
+ * @brief  Frame log not supported : the frame is not recorded.
+ */
+void APP_FRAME_LOG_Record( bool bTx, const uint8_t * pFrame, uint16_t iLength, int8_t cRssi, uint8_t cLqi, uint8_t cResult )
+{
+  UNUSED( bTx );
+  UNUSED( pFrame );
+  UNUSED( iLength );
+  UNUSED( cRssi );
+  UNUSED( cLqi );
+  UNUSED( cResult );
+}
+
+/**
+ * @brief  Frame log not supported : no record.
+ */
+uint32_t APP_FRAME_LOG_Copy( APP_FRAME_LOG_Record_t * pstRecords )
+{
+  UNUSED( pstRecords );
+
+  return 0;
+}
+
+/**
+ * @brief  Frame log not supported : nothing printed.
+ */
+void APP_FRAME_LOG_Print( const APP_FRAME_LOG_Record_t * pstRecords, uint32_t lTotal )
+{
+  UNUSED( pstRecords );
+  UNUSED( lTotal );
+}
+
+/**
+ * @brief  Frame log not supported : no command.
+ */
+bool APP_FRAME_LOG_SerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    app_frame_log.h
+  * @author  MCD Application Team
+  * @brief   Interface of the frame log (metadata of the last MAC frames kept
+  *          in a RAM ring, added to the crash log).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_FRAME_LOG_H
+#define APP_FRAME_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_conf.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Fields of APP_FRAME_LOG_Record_t.cType */
+#define APP_FRAME_LOG_TYPE_MAC_MASK         (0x07u)   /* MAC frame type (beacon, data, ack, command) */
+#define APP_FRAME_LOG_TYPE_NWK_POS          (3u)
+#define APP_FRAME_LOG_TYPE_NWK_MASK         (0x18u)   /* NWK frame type (data, command, inter-PAN) */
+#define APP_FRAME_LOG_TYPE_NWK              (0x20u)   /* NWK header decoded : cNwkSequence is valid */
+#define APP_FRAME_LOG_TYPE_TX               (0x80u)   /* Frame sent, else received */
+
+/* Address not short (absent or extended) */
+#define APP_FRAME_LOG_ADDR_NONE             (0xFFFEu)
+
+/* Exported types ------------------------------------------------------------*/
+/* Metadata of a frame (16 bytes) */
+typedef struct
+{
+  uint32_t    lTime;                  /* ms, UTIL_TIMER_GetCurrentTime */
+  uint16_t    iSource;                /* MAC source short address */
+  uint16_t    iDestination;           /* MAC destination short address */
+  uint8_t     cMacSequence;
+  uint8_t     cNwkSequence;
+  uint8_t     cType;                  /* APP_FRAME_LOG_TYPE_xxx */
+  uint8_t     cLength;                /* Length of the MAC frame */
+  int8_t      cRssi;                  /* dBm, of the acknowledgment for a frame sent */
+  uint8_t     cLqi;
+  uint8_t     cResult;                /* ral_error_enum_t of the transmission or of the reception */
+  uint8_t     cRfu;
+} APP_FRAME_LOG_Record_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_FRAME_LOG_Init                ( void );
+void      APP_FRAME_LOG_Record              ( bool bTx, const uint8_t * pFrame, uint16_t iLength, int8_t cRssi,
+                                              uint8_t cLqi, uint8_t cResult );
+uint32_t  APP_FRAME_LOG_Copy                ( APP_FRAME_LOG_Record_t * pstRecords );
+void      APP_FRAME_LOG_Print               ( const APP_FRAME_LOG_Record_t * pstRecords, uint32_t lTotal );
+bool      APP_FRAME_LOG_SerialCmdExecute    ( const char * szCommand );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_FRAME_LOG_H */
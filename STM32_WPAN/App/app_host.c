@@ -0,0 +1,817 @@
+/**
+  ******************************************************************************
+  * @file    app_host.c
+  * @author  MCD Application Team
+  * @brief   Binary host control protocol : frames on the log UART, received by
+  *          a circular DMA and executed by a Task, so that an automation host
+  *          can pipeline ZCL sends, NIB accesses, statistics and persistence
+  *          requests instead of typing serial commands.
+  *
+  *          Frame : 0xA5, length, type, sequence, data, CRC-16 (CCITT, 0xFFFF,
+  *          little endian) of the length up to the data. The length counts the
+  *          type, the sequence and the data. The other bytes are serial
+  *          commands. Each request gets a response with the same sequence, in
+  *          the order of the requests ; the ZCL responses follow as events.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "main.h"
+#include "app_zigbee.h"
+#include "app_host.h"
+#include "app_zigbee_frag.h"
+#include "app_zigbee_route.h"
+#include "app_zigbee_addr.h"
+
+#include "stm32_rtos.h"
+#include "stm32_adv_trace.h"
+#include "stm_queue.h"
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.aps.h"
+#include "zcl/zcl.h"
+
+#if (CFG_HOST_PROTOCOL_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define HOST_HEADER_SIZE              (2u)        /* Type and sequence */
+#define HOST_DATA_MAX                 ( CFG_HOST_FRAME_MAX - HOST_HEADER_SIZE )
+#define HOST_SLOT_SIZE                ( 1u + CFG_HOST_FRAME_MAX )  /* Length, type, sequence, data */
+#define HOST_CRC_INIT                 (0xFFFFu)
+#define HOST_CRC_POLYNOMIAL           (0x1021u)
+
+/* ZCL_SEND flags */
+#define HOST_ZCL_CLUSTER_SPECIFIC     (0x01u)
+#define HOST_ZCL_TO_CLIENT            (0x02u)
+#define HOST_ZCL_NO_DEFAULT_RSP       (0x04u)
+#define HOST_ZCL_APS_ACK              (0x08u)
+#define HOST_ZCL_FIXED_SIZE           (9u)        /* Mode, endpoints, profile, cluster, flags, command */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  HOST_RX_SYNC = 0,
+  HOST_RX_LENGTH,
+  HOST_RX_BODY,
+  HOST_RX_CRC_LOW,
+  HOST_RX_CRC_HIGH,
+} HostRxState_t;
+
+/* ZCL request waiting for its response */
+typedef struct
+{
+  bool        bUsed;
+  bool        bFragmented;            /* Sent with APS fragmentation */
+  uint8_t     cSequence;              /* Sequence of the host request */
+  uint16_t    iLength;                /* Length of the payload */
+  uint32_t    lStartTick;
+  struct ZbApsAddrT stDest;
+} HostZclRequest_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_HOST_Stats_t             stHostStats;
+
+/* Reception (UART or DMA interrupt) */
+static HostRxState_t                eHostRxState;
+static uint8_t                      cHostRxLength;
+static uint8_t                      cHostRxIndex;
+static uint8_t                      cHostRxType;
+static uint8_t                      cHostRxSequence;
+static uint16_t                     iHostRxCrc;
+static uint16_t                     iHostRxReceivedCrc;
+static uint8_t                      * pHostRxSlot;
+
+/* Frames received, waiting for the Task */
+static uint8_t                      aHostRxFrames[CFG_HOST_RX_FRAMES * HOST_SLOT_SIZE];
+static spsc_queue_t                 stHostRxQueue;
+
+static HostZclRequest_t             astHostZclRequests[CFG_HOST_ZCL_INFLIGHT];
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     HostRxData              ( uint8_t * pData, uint16_t iSize, uint8_t cError );
+static void     HostRxByte              ( uint8_t cByte );
+static void     HostTask                ( void );
+static void     HostExecute             ( const uint8_t * pFrame );
+static void     HostZclSend             ( uint8_t cSequence, const uint8_t * pData, uint8_t cSize );
+static void     HostZclCallback         ( struct ZbZclCommandRspT * pstRsp, void * arg );
+static void     HostNibGet              ( uint8_t cSequence, const uint8_t * pData, uint8_t cSize );
+static void     HostNibSet              ( uint8_t cSequence, const uint8_t * pData, uint8_t cSize );
+static void     HostStats               ( uint8_t cSequence );
+static void     HostPersist             ( uint8_t cSequence, const uint8_t * pData, uint8_t cSize );
+static void     HostText                ( uint8_t cSequence, const uint8_t * pData, uint8_t cSize );
+static void     HostRespond             ( uint8_t cType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize );
+static bool     HostSend                ( uint8_t cType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize );
+static uint16_t HostCrcUpdate           ( uint16_t iCrc, uint8_t cByte );
+static uint8_t  HostPut16               ( uint8_t * pBuffer, uint16_t iValue );
+static uint8_t  HostPut32               ( uint8_t * pBuffer, uint32_t lValue );
+static void     HostPrintStats          ( void );
+
+static const SerialCmd_t            astHostSerialCmds[] =
+{
+  { "HOSTSTATS", HostPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stHostSerialCmdTable =
+{
+  astHostSerialCmds, ( sizeof( astHostSerialCmds ) / sizeof( astHostSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the host protocol : it becomes the consumer of the log UART reception (circular DMA), whose
+ *         bytes are split between the frames and the serial commands.
+ * @param  None
+ * @retval None
+ */
+void APP_HOST_Init( void )
+{
+  (void)CircularQueue_SpscInit( &stHostRxQueue, aHostRxFrames, CFG_HOST_RX_FRAMES, HOST_SLOT_SIZE );
+
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_HOST_PROTOCOL ), UTIL_SEQ_RFU, HostTask );
+  Serial_CMD_Interpreter_RegisterTable( &stHostSerialCmdTable );
+
+  if ( UTIL_ADV_TRACE_StartRxProcess( HostRxData ) != UTIL_ADV_TRACE_OK )
+  {
+    LOG_ERROR_APP( "Error, host protocol reception not started." );
+    return;
+  }
+
+  LOG_INFO_APP( "Host protocol ready (%u frames of %u bytes).", CFG_HOST_RX_FRAMES, CFG_HOST_FRAME_MAX );
+}
+
+/**
+ * @brief  Send an event of another module, with its own sequence (to detect the events lost by the host).
+ * @param  eType      Event type (APP_HOST_EVENT_...)
+ * @param  cSequence  Sequence of the event
+ * @param  pData      Data
+ * @param  iSize      Size of the data, at most APP_HOST_EVENT_DATA_MAX
+ * @retval True if the event is queued in the trace FIFO, else it is counted as dropped.
+ */
+bool APP_HOST_SendEvent( APP_HOST_Type_t eType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize )
+{
+  if ( ( (uint8_t)eType < APP_HOST_EVENT_ZCL_RSP ) || ( iSize > APP_HOST_EVENT_DATA_MAX ) )
+  {
+    return false;
+  }
+
+  if ( HostSend( (uint8_t)eType, cSequence, pData, iSize ) == false )
+  {
+    stHostStats.lTxDropped++;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Reception (UART or DMA interrupt) : the bytes received since the previous call are parsed. On a reception
+ *         error (overrun, noise, framing), the frame in progress is lost.
+ * @param  pData   Bytes received
+ * @param  iSize   Number of bytes
+ * @param  cError  Not 0 on a reception error
+ * @retval None
+ */
+static void HostRxData( uint8_t * pData, uint16_t iSize, uint8_t cError )
+{
+  uint16_t  iIndex;
+
+  if ( cError != 0u )
+  {
+    stHostStats.lRxUartErrors++;
+    eHostRxState = HOST_RX_SYNC;
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < iSize; iIndex++ )
+  {
+    HostRxByte( pData[iIndex] );
+  }
+}
+
+/**
+ * @brief  Parse one received byte : out of a frame, the bytes are serial commands. A frame is written in a queue slot
+ *         as it arrives and committed once its CRC is checked ; without a free slot, it is refused (BUSY).
+ * @param  cByte  Byte received
+ * @retval None
+ */
+static void HostRxByte( uint8_t cByte )
+{
+  uint8_t   aStatus[1];
+
+  switch ( eHostRxState )
+  {
+    case HOST_RX_SYNC:
+        if ( cByte == APP_HOST_SYNC )
+        {
+          eHostRxState = HOST_RX_LENGTH;
+        }
+        else
+        {
+          Serial_CMD_Interpreter_RxData( &cByte, 1u );
+        }
+        break;
+
+    case HOST_RX_LENGTH:
+        if ( ( cByte < HOST_HEADER_SIZE ) || ( cByte > CFG_HOST_FRAME_MAX ) )
+        {
+          stHostStats.lRxCrcErrors++;
+          eHostRxState = HOST_RX_SYNC;
+          break;
+        }
+        cHostRxLength = cByte;
+        cHostRxIndex = 0;
+        iHostRxCrc = HostCrcUpdate( HOST_CRC_INIT, cByte );
+        pHostRxSlot = CircularQueue_SpscReserve( &stHostRxQueue );
+        if ( pHostRxSlot != NULL )
+        {
+          pHostRxSlot[0] = cByte;
+        }
+        eHostRxState = HOST_RX_BODY;
+        break;
+
+    case HOST_RX_BODY:
+        if ( cHostRxIndex == 0u )
+        {
+          cHostRxType = cByte;
+        }
+        else if ( cHostRxIndex == 1u )
+        {
+          cHostRxSequence = cByte;
+        }
+        if ( pHostRxSlot != NULL )
+        {
+          pHostRxSlot[1u + cHostRxIndex] = cByte;
+        }
+        iHostRxCrc = HostCrcUpdate( iHostRxCrc, cByte );
+        cHostRxIndex++;
+        if ( cHostRxIndex == cHostRxLength )
+        {
+          eHostRxState = HOST_RX_CRC_LOW;
+        }
+        break;
+
+    case HOST_RX_CRC_LOW:
+        iHostRxReceivedCrc = cByte;
+        eHostRxState = HOST_RX_CRC_HIGH;
+        break;
+
+    case HOST_RX_CRC_HIGH:
+        eHostRxState = HOST_RX_SYNC;
+        iHostRxReceivedCrc |= (uint16_t)( (uint16_t)cByte << 8 );
+        if ( iHostRxReceivedCrc != iHostRxCrc )
+        {
+          /* The sequence can not be trusted : no response, the host times out */
+          stHostStats.lRxCrcErrors++;
+        }
+        else if ( pHostRxSlot == NULL )
+        {
+          stHostStats.lRxBusy++;
+          aStatus[0] = APP_HOST_STATUS_BUSY;
+          HostRespond( cHostRxType, cHostRxSequence, aStatus, sizeof( aStatus ) );
+        }
+        else
+        {
+          CircularQueue_SpscCommit( &stHostRxQueue );
+          UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_HOST_PROTOCOL ), TASK_PRIO_HOST_PROTOCOL );
+        }
+        break;
+
+    default:
+        eHostRxState = HOST_RX_SYNC;
+        break;
+  }
+}
+
+/**
+ * @brief  Task of the protocol : the frames received are executed in their order.
+ * @param  None
+ * @retval None
+ */
+static void HostTask( void )
+{
+  uint8_t   * pFrame;
+
+  while ( ( pFrame = CircularQueue_SpscSense( &stHostRxQueue ) ) != NULL )
+  {
+    HostExecute( pFrame );
+    CircularQueue_SpscRelease( &stHostRxQueue );
+    stHostStats.lRxFrames++;
+  }
+}
+
+/**
+ * @brief  Execute a frame.
+ * @param  pFrame   Length, type, sequence, data
+ * @retval None
+ */
+static void HostExecute( const uint8_t * pFrame )
+{
+  uint8_t         cType = pFrame[1];
+  uint8_t         cSequence = pFrame[2];
+  const uint8_t   * pData = &pFrame[3];
+  uint8_t         cSize = (uint8_t)( pFrame[0] - HOST_HEADER_SIZE );
+  uint8_t         aStatus[1];
+
+  switch ( cType )
+  {
+    case APP_HOST_CMD_PING:
+        HostRespond( cType, cSequence, pData, cSize );
+        break;
+
+    case APP_HOST_CMD_ZCL_SEND:
+        HostZclSend( cSequence, pData, cSize );
+        break;
+
+    case APP_HOST_CMD_NIB_GET:
+        HostNibGet( cSequence, pData, cSize );
+        break;
+
+    case APP_HOST_CMD_NIB_SET:
+        HostNibSet( cSequence, pData, cSize );
+        break;
+
+    case APP_HOST_CMD_STATS:
+        HostStats( cSequence );
+        break;
+
+    case APP_HOST_CMD_PERSIST:
+        HostPersist( cSequence, pData, cSize );
+        break;
+
+    case APP_HOST_CMD_TEXT:
+        HostText( cSequence, pData, cSize );
+        break;
+
+    default:
+        aStatus[0] = APP_HOST_STATUS_UNKNOWN;
+        HostRespond( cType, cSequence, aStatus, sizeof( aStatus ) );
+        break;
+  }
+}
+
+/**
+ * @brief  Send a ZCL command. The response is [status][ZCL status], then the ZCL response comes as an event.
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Mode, address, dest. endpoint, source endpoint, profile, cluster, flags, command, payload
+ * @param  cSize      Size of the data
+ * @retval None
+ */
+static void HostZclSend( uint8_t cSequence, const uint8_t * pData, uint8_t cSize )
+{
+  struct ZbZclCommandReqT   stRequest;
+  HostZclRequest_t          * pstContext = NULL;
+  enum ZclStatusCodeT       eZclStatus;
+  uint8_t                   aResponse[2];
+  uint8_t                   cAddressSize;
+  uint8_t                   cFlags;
+  uint16_t                  iIndex;
+
+  aResponse[0] = APP_HOST_STATUS_INVALID;
+  aResponse[1] = (uint8_t)ZCL_STATUS_FAILURE;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst.mode = ( cSize != 0u ) ? (enum ZbApsAddrModeT)pData[0] : ZB_APSDE_ADDRMODE_NOTPRESENT;
+  cAddressSize = ( stRequest.dst.mode == ZB_APSDE_ADDRMODE_EXT ) ? 8u : 2u;
+  if ( ( ( stRequest.dst.mode != ZB_APSDE_ADDRMODE_GROUP ) && ( stRequest.dst.mode != ZB_APSDE_ADDRMODE_SHORT ) &&
+         ( stRequest.dst.mode != ZB_APSDE_ADDRMODE_EXT ) ) || ( cSize < ( HOST_ZCL_FIXED_SIZE + cAddressSize ) ) )
+  {
+    HostRespond( APP_HOST_CMD_ZCL_SEND, cSequence, aResponse, sizeof( aResponse ) );
+    return;
+  }
+
+  pData++;
+  if ( cAddressSize == 8u )
+  {
+    memcpy( &stRequest.dst.extAddr, pData, sizeof( stRequest.dst.extAddr ) );
+  }
+  else
+  {
+    stRequest.dst.nwkAddr = (uint16_t)( pData[0] | ( (uint16_t)pData[1] << 8 ) );
+  }
+  pData += cAddressSize;
+  stRequest.dst.endpoint = pData[0];
+  stRequest.srcEndpt = pData[1];
+  stRequest.profileId = (uint16_t)( pData[2] | ( (uint16_t)pData[3] << 8 ) );
+  stRequest.clusterId = (enum ZbZclClusterIdT)( pData[4] | ( (uint16_t)pData[5] << 8 ) );
+  cFlags = pData[6];
+  stRequest.hdr.cmdId = pData[7];
+  stRequest.payload = (void *)&pData[8];
+  stRequest.length = (unsigned int)( cSize - HOST_ZCL_FIXED_SIZE - cAddressSize );
+
+  stRequest.txOptions = ( ZB_APSDE_DATAREQ_TXOPTIONS_SECURITY | ZB_APSDE_DATAREQ_TXOPTIONS_NWKKEY );
+  if ( ( cFlags & HOST_ZCL_APS_ACK ) != 0u )
+  {
+    stRequest.txOptions |= ZB_APSDE_DATAREQ_TXOPTIONS_ACK;
+  }
+  APP_ZIGBEE_AddrResolve( &stRequest.dst );
+  stRequest.discoverRoute = APP_ZIGBEE_RouteUse( &stRequest.dst );
+  stRequest.hdr.frameCtrl.frameType = ( ( cFlags & HOST_ZCL_CLUSTER_SPECIFIC ) != 0u ) ? ZCL_FRAMETYPE_CLUSTER : ZCL_FRAMETYPE_PROFILE;
+  stRequest.hdr.frameCtrl.direction = ( ( cFlags & HOST_ZCL_TO_CLIENT ) != 0u ) ? ZCL_DIRECTION_TO_CLIENT : ZCL_DIRECTION_TO_SERVER;
+  stRequest.hdr.frameCtrl.noDefaultResp = ( ( cFlags & HOST_ZCL_NO_DEFAULT_RSP ) != 0u ) ? ZCL_NO_DEFAULT_RESPONSE_TRUE : ZCL_NO_DEFAULT_RESPONSE_FALSE;
+
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    aResponse[0] = APP_HOST_STATUS_NOT_READY;
+    HostRespond( APP_HOST_CMD_ZCL_SEND, cSequence, aResponse, sizeof( aResponse ) );
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_HOST_ZCL_INFLIGHT; iIndex++ )
+  {
+    if ( astHostZclRequests[iIndex].bUsed == false )
+    {
+      pstContext = &astHostZclRequests[iIndex];
+      break;
+    }
+  }
+  if ( pstContext == NULL )
+  {
+    aResponse[0] = APP_HOST_STATUS_BUSY;
+    HostRespond( APP_HOST_CMD_ZCL_SEND, cSequence, aResponse, sizeof( aResponse ) );
+    return;
+  }
+
+  stRequest.hdr.seqNum = ZbZclGetNextSeqnum( stZigbeeAppInfo.pstZigbee );
+  pstContext->bUsed = true;
+  pstContext->cSequence = cSequence;
+  pstContext->bFragmented = ( stRequest.length > CFG_HOST_ZCL_FRAG_SIZE );
+  pstContext->iLength = (uint16_t)stRequest.length;
+  pstContext->lStartTick = HAL_GetTick();
+  pstContext->stDest = stRequest.dst;
+  if ( pstContext->bFragmented != false )
+  {
+    /* Large payload : window and delay tuned for the destination */
+    stRequest.txOptions |= ZB_APSDE_DATAREQ_TXOPTIONS_FRAG;
+    APP_ZIGBEE_FragBegin( &stRequest.dst );
+  }
+
+  eZclStatus = ZbZclCommandReq( stZigbeeAppInfo.pstZigbee, &stRequest, HostZclCallback, pstContext );
+  if ( eZclStatus == ZCL_STATUS_SUCCESS )
+  {
+    stHostStats.lZclSent++;
+    aResponse[0] = APP_HOST_STATUS_OK;
+  }
+  else
+  {
+    if ( pstContext->bFragmented != false )
+    {
+      APP_ZIGBEE_FragEnd( &pstContext->stDest, 0u, 0u, false );
+    }
+    pstContext->bUsed = false;
+    aResponse[0] = APP_HOST_STATUS_FAILED;
+  }
+  aResponse[1] = (uint8_t)eZclStatus;
+  HostRespond( APP_HOST_CMD_ZCL_SEND, cSequence, aResponse, sizeof( aResponse ) );
+}
+
+/**
+ * @brief  Response (or timeout) of a ZCL command, sent as an event : APS status, ZCL status, command, payload.
+ * @param  pstRsp   ZCL command response
+ * @param  arg      Host request
+ * @retval None
+ */
+static void HostZclCallback( struct ZbZclCommandRspT * pstRsp, void * arg )
+{
+  HostZclRequest_t  * pstContext = (HostZclRequest_t *)arg;
+  uint8_t           aEvent[HOST_DATA_MAX];
+  uint16_t          iPayloadSize;
+
+  aEvent[0] = (uint8_t)pstRsp->aps_status;
+  aEvent[1] = (uint8_t)pstRsp->status;
+  aEvent[2] = pstRsp->hdr.cmdId;
+  iPayloadSize = ( pstRsp->length < ( HOST_DATA_MAX - 3u ) ) ? pstRsp->length : ( HOST_DATA_MAX - 3u );
+  if ( iPayloadSize != 0u )
+  {
+    memcpy( &aEvent[3], pstRsp->payload, iPayloadSize );
+  }
+
+  if ( pstContext->bFragmented != false )
+  {
+    APP_ZIGBEE_FragEnd( &pstContext->stDest, pstContext->iLength, ( HAL_GetTick() - pstContext->lStartTick ),
+                        ( pstRsp->aps_status == ZB_STATUS_SUCCESS ) );
+  }
+
+  stHostStats.lZclResponses++;
+  pstContext->bUsed = false;
+  HostRespond( APP_HOST_EVENT_ZCL_RSP, pstContext->cSequence, aEvent, (uint16_t)( 3u + iPayloadSize ) );
+}
+
+/**
+ * @brief  Read a NIB attribute. The response is [status][Zigbee status][value].
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Attribute (16 bits)
+ * @param  cSize      Size of the data
+ * @retval None
+ */
+static void HostNibGet( uint8_t cSequence, const uint8_t * pData, uint8_t cSize )
+{
+  uint8_t             aResponse[HOST_DATA_MAX];
+  unsigned int        lValueSize = ( HOST_DATA_MAX - 2u );
+  enum ZbStatusCodeT  eStatus;
+
+  if ( cSize != 2u )
+  {
+    aResponse[0] = APP_HOST_STATUS_INVALID;
+    HostRespond( APP_HOST_CMD_NIB_GET, cSequence, aResponse, 1u );
+    return;
+  }
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    aResponse[0] = APP_HOST_STATUS_NOT_READY;
+    HostRespond( APP_HOST_CMD_NIB_GET, cSequence, aResponse, 1u );
+    return;
+  }
+
+  eStatus = ZbNwkGetArray( stZigbeeAppInfo.pstZigbee, (enum ZbNwkNibAttrIdT)( pData[0] | ( (uint16_t)pData[1] << 8 ) ),
+                           &aResponse[2], &lValueSize );
+  aResponse[0] = ( eStatus == ZB_STATUS_SUCCESS ) ? APP_HOST_STATUS_OK : APP_HOST_STATUS_FAILED;
+  aResponse[1] = (uint8_t)eStatus;
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    lValueSize = 0;
+  }
+  HostRespond( APP_HOST_CMD_NIB_GET, cSequence, aResponse, (uint16_t)( 2u + lValueSize ) );
+}
+
+/**
+ * @brief  Write a NIB attribute. The response is [status][Zigbee status].
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Attribute (16 bits), value
+ * @param  cSize      Size of the data
+ * @retval None
+ */
+static void HostNibSet( uint8_t cSequence, const uint8_t * pData, uint8_t cSize )
+{
+  uint8_t             aValue[HOST_DATA_MAX];
+  uint8_t             aResponse[2];
+  enum ZbStatusCodeT  eStatus;
+
+  aResponse[1] = (uint8_t)ZB_STATUS_SUCCESS;
+  if ( cSize < 3u )
+  {
+    aResponse[0] = APP_HOST_STATUS_INVALID;
+    HostRespond( APP_HOST_CMD_NIB_SET, cSequence, aResponse, 1u );
+    return;
+  }
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    aResponse[0] = APP_HOST_STATUS_NOT_READY;
+    HostRespond( APP_HOST_CMD_NIB_SET, cSequence, aResponse, 1u );
+    return;
+  }
+
+  /* Aligned copy of the value */
+  memcpy( aValue, &pData[2], (uint32_t)( cSize - 2u ) );
+  eStatus = ZbNwkSet( stZigbeeAppInfo.pstZigbee, (enum ZbNwkNibAttrIdT)( pData[0] | ( (uint16_t)pData[1] << 8 ) ),
+                      aValue, (unsigned int)( cSize - 2u ) );
+  aResponse[0] = ( eStatus == ZB_STATUS_SUCCESS ) ? APP_HOST_STATUS_OK : APP_HOST_STATUS_FAILED;
+  aResponse[1] = (uint8_t)eStatus;
+  HostRespond( APP_HOST_CMD_NIB_SET, cSequence, aResponse, sizeof( aResponse ) );
+}
+
+/**
+ * @brief  Statistics : [status], the counters of the protocol (32 bits each, in the order of APP_HOST_Stats_t), then
+ *         if the stack runs, the APS unicast success, retries and failures (16 bits), the MAC unicast transmissions
+ *         (32 bits), retries and failures (16 bits).
+ * @param  cSequence  Sequence of the request
+ * @retval None
+ */
+static void HostStats( uint8_t cSequence )
+{
+  struct ZbApsStatTableT  stApsStats;
+  uint8_t                 aResponse[1u + ( 7u * 4u ) + ( 3u * 2u ) + 4u + ( 2u * 2u )];
+  uint8_t                 cSize = 0;
+
+  aResponse[cSize++] = APP_HOST_STATUS_OK;
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lRxFrames );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lRxCrcErrors );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lRxBusy );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lRxUartErrors );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lTxDropped );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lZclSent );
+  cSize += HostPut32( &aResponse[cSize], stHostStats.lZclResponses );
+
+  if ( ( stZigbeeAppInfo.pstZigbee != NULL ) &&
+       ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) == ZB_STATUS_SUCCESS ) )
+  {
+    cSize += HostPut16( &aResponse[cSize], stApsStats.aps_tx_ucast_success );
+    cSize += HostPut16( &aResponse[cSize], stApsStats.aps_tx_ucast_retry );
+    cSize += HostPut16( &aResponse[cSize], stApsStats.aps_tx_ucast_fail );
+    cSize += HostPut32( &aResponse[cSize], stApsStats.mac_tx_ucast );
+    cSize += HostPut16( &aResponse[cSize], stApsStats.mac_tx_ucast_retry );
+    cSize += HostPut16( &aResponse[cSize], stApsStats.mac_tx_ucast_fail );
+  }
+
+  HostRespond( APP_HOST_CMD_STATS, cSequence, aResponse, cSize );
+}
+
+/**
+ * @brief  Persistence control : 0 saves the persistence now, 1 saves it as if the stack asked (delayed, coalesced).
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Operation
+ * @param  cSize      Size of the data
+ * @retval None
+ */
+static void HostPersist( uint8_t cSequence, const uint8_t * pData, uint8_t cSize )
+{
+  uint8_t   aResponse[1];
+
+  if ( ( cSize != 1u ) || ( pData[0] > 1u ) )
+  {
+    aResponse[0] = APP_HOST_STATUS_INVALID;
+  }
+  else if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    aResponse[0] = APP_HOST_STATUS_NOT_READY;
+  }
+  else if ( pData[0] == 0u )
+  {
+    aResponse[0] = ( APP_ZIGBEE_PersistenceSave() != false ) ? APP_HOST_STATUS_OK : APP_HOST_STATUS_FAILED;
+  }
+  else
+  {
+    APP_ZIGBEE_PersistenceNotify();
+    aResponse[0] = APP_HOST_STATUS_OK;
+  }
+
+  HostRespond( APP_HOST_CMD_PERSIST, cSequence, aResponse, sizeof( aResponse ) );
+}
+
+/**
+ * @brief  Serial command : executed as if typed, its output goes to the logs. The response follows the execution.
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Command
+ * @param  cSize      Size of the data
+ * @retval None
+ */
+static void HostText( uint8_t cSequence, const uint8_t * pData, uint8_t cSize )
+{
+  uint8_t   szCommand[HOST_DATA_MAX + 1u];
+  uint8_t   aResponse[1];
+
+  memcpy( szCommand, pData, cSize );
+  szCommand[cSize] = '\0';
+  Serial_CMD_Interpreter_CmdExecute( szCommand, cSize );
+
+  aResponse[0] = APP_HOST_STATUS_OK;
+  HostRespond( APP_HOST_CMD_TEXT, cSequence, aResponse, sizeof( aResponse ) );
+}
+
+/**
+ * @brief  Send a response (the type of the request with APP_HOST_RESPONSE) or an event.
+ * @param  cType      Type of the request or of the event
+ * @param  cSequence  Sequence of the request
+ * @param  pData      Data
+ * @param  iSize      Size of the data
+ * @retval None
+ */
+static void HostRespond( uint8_t cType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize )
+{
+  if ( cType < APP_HOST_EVENT_ZCL_RSP )
+  {
+    cType |= APP_HOST_RESPONSE;
+  }
+
+  if ( HostSend( cType, cSequence, pData, iSize ) == false )
+  {
+    stHostStats.lTxDropped++;
+  }
+}
+
+/**
+ * @brief  Write a frame in the trace FIFO, as one block between the logs.
+ * @param  cType      Type
+ * @param  cSequence  Sequence
+ * @param  pData      Data
+ * @param  iSize      Size of the data (at most HOST_DATA_MAX)
+ * @retval True if the frame is queued, false if the FIFO is full.
+ */
+static bool HostSend( uint8_t cType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize )
+{
+  uint8_t   aHeader[4];
+  uint8_t   * pFifo;
+  uint16_t  iFifoSize;
+  uint16_t  iWritePos;
+  uint16_t  iIndex;
+  uint16_t  iCrc = HOST_CRC_INIT;
+
+  aHeader[0] = APP_HOST_SYNC;
+  aHeader[1] = (uint8_t)( HOST_HEADER_SIZE + iSize );
+  aHeader[2] = cType;
+  aHeader[3] = cSequence;
+
+  if ( UTIL_ADV_TRACE_ZCSend_Allocation( (uint16_t)( sizeof( aHeader ) + iSize + 2u ), &pFifo, &iFifoSize, &iWritePos ) != UTIL_ADV_TRACE_OK )
+  {
+    return false;
+  }
+
+  for ( iIndex = 0; iIndex < sizeof( aHeader ); iIndex++ )
+  {
+    if ( iIndex != 0u )
+    {
+      iCrc = HostCrcUpdate( iCrc, aHeader[iIndex] );
+    }
+    pFifo[iWritePos] = aHeader[iIndex];
+    iWritePos = (uint16_t)( ( iWritePos + 1u ) % iFifoSize );
+  }
+  for ( iIndex = 0; iIndex < iSize; iIndex++ )
+  {
+    iCrc = HostCrcUpdate( iCrc, pData[iIndex] );
+    pFifo[iWritePos] = pData[iIndex];
+    iWritePos = (uint16_t)( ( iWritePos + 1u ) % iFifoSize );
+  }
+  pFifo[iWritePos] = (uint8_t)iCrc;
+  iWritePos = (uint16_t)( ( iWritePos + 1u ) % iFifoSize );
+  pFifo[iWritePos] = (uint8_t)( iCrc >> 8 );
+
+  (void)UTIL_ADV_TRACE_ZCSend_Finalize();
+
+  return true;
+}
+
+/**
+ * @brief  CRC-16 CCITT of one more byte.
+ * @param  iCrc   CRC of the previous bytes
+ * @param  cByte  Byte
+ * @retval CRC including the byte.
+ */
+static uint16_t HostCrcUpdate( uint16_t iCrc, uint8_t cByte )
+{
+  uint8_t   cBit;
+
+  iCrc ^= (uint16_t)( (uint16_t)cByte << 8 );
+  for ( cBit = 0; cBit < 8u; cBit++ )
+  {
+    iCrc = ( ( iCrc & 0x8000u ) != 0u ) ? (uint16_t)( ( iCrc << 1 ) ^ HOST_CRC_POLYNOMIAL ) : (uint16_t)( iCrc << 1 );
+  }
+
+  return iCrc;
+}
+
+/**
+ * @brief  Write a 16 bits value, little endian.
+ * @param  pBuffer  Destination
+ * @param  iValue   Value
+ * @retval Number of bytes written.
+ */
+static uint8_t HostPut16( uint8_t * pBuffer, uint16_t iValue )
+{
+  pBuffer[0] = (uint8_t)iValue;
+  pBuffer[1] = (uint8_t)( iValue >> 8 );
+
+  return 2u;
+}
+
+/**
+ * @brief  Write a 32 bits value, little endian.
+ * @param  pBuffer  Destination
+ * @param  lValue   Value
+ * @retval Number of bytes written.
+ */
+static uint8_t HostPut32( uint8_t * pBuffer, uint32_t lValue )
+{
+  (void)HostPut16( pBuffer, (uint16_t)lValue );
+  (void)HostPut16( &pBuffer[2], (uint16_t)( lValue >> 16 ) );
+
+  return 4u;
+}
+
+/**
+ * @brief  Print the statistics of the protocol (HOSTSTATS).
+ * @param  None
+ * @retval None
+ */
+static void HostPrintStats( void )
+{
+  LOG_INFO_APP( "Host protocol : %u frames executed, %u queued, %u CRC errors, %u refused (busy), %u UART errors.",
+                stHostStats.lRxFrames, CircularQueue_SpscNbElement( &stHostRxQueue ), stHostStats.lRxCrcErrors,
+                stHostStats.lRxBusy, stHostStats.lRxUartErrors );
+  LOG_INFO_APP( "Host protocol : %u ZCL sent, %u responses, %u frames dropped (trace FIFO full).", stHostStats.lZclSent,
+                stHostStats.lZclResponses, stHostStats.lTxDropped );
+}
+
+#else /* (CFG_HOST_PROTOCOL_SUPPORTED != 0) */
+
+/**
+ * @brief  No host protocol : the serial commands only.
+ */
+void APP_HOST_Init( void )
+{
+}
+
+#endif /* (CFG_HOST_PROTOCOL_SUPPORTED != 0) */
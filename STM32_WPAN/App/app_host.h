@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    app_host.h
+  * @author  MCD Application Team
+  * @brief   Interface of the binary host control protocol.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_HOST_H
+#define APP_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Frame types : a response has the type of its request with APP_HOST_RESPONSE set, and the same sequence */
+typedef enum
+{
+  APP_HOST_CMD_PING         = 0x01,   /* Data echoed */
+  APP_HOST_CMD_ZCL_SEND     = 0x02,   /* Mode, address (2 or 8 bytes), dest. and source endpoints, profile, cluster, flags, command, payload */
+  APP_HOST_CMD_NIB_GET      = 0x03,   /* NIB attribute */
+  APP_HOST_CMD_NIB_SET      = 0x04,   /* NIB attribute, value */
+  APP_HOST_CMD_STATS        = 0x05,   /* None */
+  APP_HOST_CMD_PERSIST      = 0x06,   /* Operation : 0 save now, 1 save when the stack asks */
+  APP_HOST_CMD_TEXT         = 0x07,   /* Serial command, without '\r' */
+
+  APP_HOST_EVENT_ZCL_RSP    = 0xC0,   /* Response of a ZCL_SEND, with its sequence : APS status, ZCL status, command, payload */
+  APP_HOST_EVENT_HEAP_TRACE = 0xC1,   /* Zigbee heap calls recorded (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED), own sequence */
+} APP_HOST_Type_t;
+
+/* First data byte of the responses */
+typedef enum
+{
+  APP_HOST_STATUS_OK        = 0,
+  APP_HOST_STATUS_UNKNOWN,            /* Unknown type */
+  APP_HOST_STATUS_INVALID,            /* Invalid data */
+  APP_HOST_STATUS_BUSY,               /* No room for the frame, or too many ZCL requests waiting */
+  APP_HOST_STATUS_FAILED,             /* Refused by the stack */
+  APP_HOST_STATUS_NOT_READY,          /* Stack not started */
+} APP_HOST_Status_t;
+
+/* Statistics of the protocol */
+typedef struct
+{
+  uint32_t    lRxFrames;              /* Frames received and executed */
+  uint32_t    lRxCrcErrors;           /* Frames dropped, wrong CRC */
+  uint32_t    lRxBusy;                /* Frames refused, the queue full */
+  uint32_t    lRxUartErrors;          /* Reception errors (overrun, noise, framing), the DMA restarted */
+  uint32_t    lTxDropped;             /* Responses and events dropped, the trace FIFO full */
+  uint32_t    lZclSent;               /* ZCL requests accepted by the stack */
+  uint32_t    lZclResponses;          /* ZCL responses (or timeouts) sent as events */
+} APP_HOST_Stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+#define APP_HOST_SYNC               (0xA5u)   /* Not ASCII : the frames and the serial commands share the link */
+#define APP_HOST_RESPONSE           (0x80u)
+#define APP_HOST_EVENT_DATA_MAX     (253u)    /* Length byte : type, sequence and data */
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_HOST_Init                     ( void );
+bool      APP_HOST_SendEvent                ( APP_HOST_Type_t eType, uint8_t cSequence, const uint8_t * pData, uint16_t iSize );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_HOST_H */
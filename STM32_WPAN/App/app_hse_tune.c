@@ -0,0 +1,309 @@
+/**
+  ******************************************************************************
+  * @file    app_hse_tune.c
+  * @author  MCD Application Team
+  * @brief   HSE stabilization delay tuning : the HSE start-up time measured by
+  *          the SCM at each exit of the low power modes sets the delay waited
+  *          after HSERDY, with a margin. The slowest start-up of the device is
+  *          kept in a flash page written by the Flash Manager, so that the
+  *          tuned delay applies from the boot.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_manager.h"
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_hse_tune.h"
+#include "scm.h"
+
+#include "stm32_timer.h"
+
+#if (CFG_SCM_HSE_TUNE_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define HSE_TUNE_MAGIC                  (0x48534554u)           /* "HSET" : HSE Tuning */
+#define HSE_TUNE_ERASED                 (0xFFFFFFFFu)
+#define HSE_TUNE_SLOT_NB                ( FLASH_PAGE_SIZE / sizeof( HseTuneRecord_t ) )
+#define HSE_TUNE_SAVE_DELAY             (1000u)                 /* ms : the slowest start-ups of a burst in one record */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Record of the page : one flash write (128 bits) */
+typedef struct
+{
+  uint32_t    lMagic;
+  uint32_t    lReadyUs;               /* Slowest start-up (enable to HSERDY) in us */
+  uint32_t    lReadyUsInv;            /* ~lReadyUs */
+  uint32_t    lSamples;               /* Start-ups measured before this record (this boot) */
+} HseTuneRecord_t;
+
+typedef enum
+{
+  HSE_TUNE_FLASH_IDLE,
+  HSE_TUNE_FLASH_ERASE,
+  HSE_TUNE_FLASH_WRITE,
+} HseTuneFlashState_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_HSE_TuneState_t          stHseTuneState;
+static HseTuneRecord_t              stHseTuneRecord;        /* Record being written */
+static HseTuneFlashState_t          eHseTuneFlashState;
+static FM_FlashOpNode_t             stHseTuneFlashOp;
+static UTIL_TIMER_Object_t          stHseTuneTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     HseTuneApply            ( uint32_t lReadyUs );
+static void     HseTuneTimerCallback    ( void * arg );
+static void     HseTuneFlashProcess     ( void );
+static void     HseTuneFlashCallback    ( FM_FlashOp_Status_t eStatus );
+static const HseTuneRecord_t * HseTuneGetRecord ( uint32_t lSlot );
+static bool     HseTuneRecordIsValid    ( const HseTuneRecord_t * pstRecord );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the HSE tuning : the last record of the page gives the slowest start-up saved, and the
+ *         stabilization delay that follows from it.
+ * @param  None
+ * @retval None
+ */
+void APP_HSE_TuneInit( void )
+{
+  const HseTuneRecord_t   * pstRecord;
+  uint32_t                lSlot;
+
+  memset( &stHseTuneState, 0, sizeof( stHseTuneState ) );
+
+  /* The records are appended : the valid ones first, then the erased slots */
+  for ( lSlot = 0; lSlot < HSE_TUNE_SLOT_NB; lSlot++ )
+  {
+    pstRecord = HseTuneGetRecord( lSlot );
+    if ( HseTuneRecordIsValid( pstRecord ) == false )
+    {
+      break;
+    }
+    stHseTuneState.lSavedUs = pstRecord->lReadyUs;
+  }
+
+  /* A slot neither valid nor erased (interrupted write) : the page is erased at the next record */
+  if ( ( lSlot < HSE_TUNE_SLOT_NB ) && ( HseTuneGetRecord( lSlot )->lMagic != HSE_TUNE_ERASED ) )
+  {
+    lSlot = HSE_TUNE_SLOT_NB;
+  }
+  stHseTuneState.iSlot = (uint16_t)lSlot;
+
+  stHseTuneState.lDelayUs = SCM_HSE_GetStabilizationTime();
+  if ( stHseTuneState.lSavedUs != 0u )
+  {
+    HseTuneApply( stHseTuneState.lSavedUs );
+  }
+
+  LOG_INFO_APP( "HSE start-up saved : %u us, stabilization delay %u us.", stHseTuneState.lSavedUs, stHseTuneState.lDelayUs );
+
+  stHseTuneFlashOp.Callback = HseTuneFlashCallback;
+  UTIL_TIMER_Create( &stHseTuneTimer, HSE_TUNE_SAVE_DELAY, UTIL_TIMER_ONESHOT, &HseTuneTimerCallback, NULL );
+}
+
+/**
+ * @brief  HSE tuning serial command : HSESTATS (start-ups measured and delay in use).
+ * @param  szCommand  Command received
+ * @retval True if the command is a HSE tuning command.
+ */
+bool APP_HSE_TuneSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "HSESTATS" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "HSE start-up : %u measured, last %u us, max %u us, saved %u us.", stHseTuneState.lSamples,
+                stHseTuneState.lLastUs, stHseTuneState.lMaxUs, stHseTuneState.lSavedUs );
+  LOG_INFO_APP( "HSE stabilization delay : %u us (default %u us), %d records (slot %d), %d erases, %d errors.",
+                stHseTuneState.lDelayUs, SCM_HSE_STABILIZATION_TIME_DEFAULT, stHseTuneState.lRecords,
+                stHseTuneState.iSlot, stHseTuneState.lErases, stHseTuneState.lErrors );
+
+  return true;
+}
+
+/**
+ * @brief  HSE start-up measured by the SCM (under interrupt). Once enough start-ups are measured, a slower one than
+ *         saved updates the delay at once and is saved a little later.
+ * @param  ready_time_us  Start-up time in us
+ * @retval None
+ */
+void SCM_HSE_ReadyTimeMeasured( uint32_t ready_time_us )
+{
+  stHseTuneState.lSamples++;
+  stHseTuneState.lLastUs = ready_time_us;
+  if ( ready_time_us > stHseTuneState.lMaxUs )
+  {
+    stHseTuneState.lMaxUs = ready_time_us;
+  }
+
+  if ( ( stHseTuneState.lSamples >= CFG_SCM_HSE_TUNE_SAMPLES ) && ( stHseTuneState.lMaxUs > stHseTuneState.lSavedUs ) )
+  {
+    HseTuneApply( stHseTuneState.lMaxUs );
+    if ( UTIL_TIMER_IsRunning( &stHseTuneTimer ) == 0u )
+    {
+      UTIL_TIMER_Start( &stHseTuneTimer );
+    }
+  }
+}
+
+/**
+ * @brief  Stabilization delay from the slowest start-up : CFG_SCM_HSE_TUNE_RATIO percent plus CFG_SCM_HSE_TUNE_MARGIN,
+ *         never above the default delay.
+ * @param  lReadyUs   Slowest start-up in us
+ * @retval None
+ */
+static void HseTuneApply( uint32_t lReadyUs )
+{
+  uint32_t  lDelayUs;
+
+  lDelayUs = ( ( lReadyUs * CFG_SCM_HSE_TUNE_RATIO ) / 100u ) + CFG_SCM_HSE_TUNE_MARGIN;
+  lDelayUs = MIN( lDelayUs, SCM_HSE_STABILIZATION_TIME_DEFAULT );
+
+  if ( lDelayUs != stHseTuneState.lDelayUs )
+  {
+    SCM_HSE_SetStabilizationTime( lDelayUs );
+    stHseTuneState.lDelayUs = lDelayUs;
+  }
+}
+
+/**
+ * @brief  Save of the slowest start-up, after HSE_TUNE_SAVE_DELAY (Task context of the Timer Server).
+ * @param  arg : Not used
+ * @retval None
+ */
+static void HseTuneTimerCallback( void * arg )
+{
+  UNUSED( arg );
+
+  if ( ( eHseTuneFlashState == HSE_TUNE_FLASH_IDLE ) && ( stHseTuneState.lMaxUs > stHseTuneState.lSavedUs ) )
+  {
+    HseTuneFlashProcess();
+  }
+}
+
+/**
+ * @brief  Write of a record with the slowest start-up, the page being erased first when full.
+ * @param  None
+ * @retval None
+ */
+static void HseTuneFlashProcess( void )
+{
+  FM_Cmd_Status_t   eStatus;
+
+  if ( stHseTuneState.iSlot >= HSE_TUNE_SLOT_NB )
+  {
+    eHseTuneFlashState = HSE_TUNE_FLASH_ERASE;
+    eStatus = FM_QueueErase( CFG_SCM_HSE_TUNE_SECTOR_ID, 1u, FM_PRIORITY_NVM, &stHseTuneFlashOp );
+  }
+  else
+  {
+    stHseTuneRecord.lMagic = HSE_TUNE_MAGIC;
+    stHseTuneRecord.lReadyUs = stHseTuneState.lMaxUs;
+    stHseTuneRecord.lReadyUsInv = ~stHseTuneRecord.lReadyUs;
+    stHseTuneRecord.lSamples = stHseTuneState.lSamples;
+
+    eHseTuneFlashState = HSE_TUNE_FLASH_WRITE;
+    eStatus = FM_QueueWrite( (uint32_t *)&stHseTuneRecord, (uint32_t *)HseTuneGetRecord( stHseTuneState.iSlot ),
+                             (int32_t)( sizeof( stHseTuneRecord ) / sizeof( uint32_t ) ), FM_PRIORITY_NVM, &stHseTuneFlashOp );
+  }
+
+  /* One operation at a time : the queue of the class is never full */
+  if ( eStatus != FM_OK )
+  {
+    LOG_ERROR_APP( "Error, HSE start-up record flash operation refused (record %d).", stHseTuneState.iSlot );
+    eHseTuneFlashState = HSE_TUNE_FLASH_IDLE;
+    stHseTuneState.lErrors++;
+  }
+}
+
+/**
+ * @brief  Flash Manager callback : end of a queued erase/write. The record follows the erase at once.
+ * @param  eStatus  Flash operation status
+ * @retval None
+ */
+static void HseTuneFlashCallback( FM_FlashOp_Status_t eStatus )
+{
+  HseTuneFlashState_t eState = eHseTuneFlashState;
+
+  eHseTuneFlashState = HSE_TUNE_FLASH_IDLE;
+  if ( eStatus != FM_OPERATION_COMPLETE )
+  {
+    stHseTuneState.lErrors++;
+    return;
+  }
+
+  if ( eState == HSE_TUNE_FLASH_ERASE )
+  {
+    stHseTuneState.iSlot = 0;
+    stHseTuneState.lErases++;
+    HseTuneFlashProcess();
+  }
+  else if ( eState == HSE_TUNE_FLASH_WRITE )
+  {
+    stHseTuneState.iSlot++;
+    stHseTuneState.lSavedUs = stHseTuneRecord.lReadyUs;
+    stHseTuneState.lRecords++;
+
+    /* A slower start-up measured during the write */
+    if ( stHseTuneState.lMaxUs > stHseTuneState.lSavedUs )
+    {
+      UTIL_TIMER_Start( &stHseTuneTimer );
+    }
+  }
+}
+
+/**
+ * @brief  Record of the page in flash.
+ * @param  lSlot    Record in the page
+ * @retval Record
+ */
+static const HseTuneRecord_t * HseTuneGetRecord( uint32_t lSlot )
+{
+  return (const HseTuneRecord_t *)( CFG_SCM_HSE_TUNE_ADDRESS + ( lSlot * sizeof( HseTuneRecord_t ) ) );
+}
+
+/**
+ * @brief  Check of a record read from flash.
+ * @param  pstRecord  Record
+ * @retval True if the record holds a start-up time.
+ */
+static bool HseTuneRecordIsValid( const HseTuneRecord_t * pstRecord )
+{
+  return ( ( pstRecord->lMagic == HSE_TUNE_MAGIC ) && ( pstRecord->lReadyUsInv == ~pstRecord->lReadyUs ) );
+}
+
+#else /* (CFG_SCM_HSE_TUNE_SUPPORTED != 0) */
+
+/**
+ * @brief  No HSE tuning : the default stabilization delay is kept.
+ */
+void APP_HSE_TuneInit( void )
+{
+}
+
+/**
+ * @brief  No HSE tuning : no command.
+ */
+bool APP_HSE_TuneSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_SCM_HSE_TUNE_SUPPORTED != 0) */
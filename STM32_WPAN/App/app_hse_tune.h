@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    app_hse_tune.h
+  * @author  MCD Application Team
+  * @brief   Interface of the HSE stabilization delay tuning.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_HSE_TUNE_H
+#define APP_HSE_TUNE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the HSE stabilization delay tuning */
+typedef struct
+{
+  uint32_t    lSamples;               /* Start-ups measured since the boot */
+  uint32_t    lLastUs;                /* Last start-up (enable to HSERDY) in us */
+  uint32_t    lMaxUs;                 /* Slowest start-up since the boot in us */
+  uint32_t    lSavedUs;               /* Slowest start-up saved in flash in us (0 : none) */
+  uint32_t    lDelayUs;               /* Stabilization delay after HSERDY in use in us */
+  uint32_t    lRecords;               /* Records written since the boot */
+  uint32_t    lErases;                /* Page erases since the boot */
+  uint32_t    lErrors;                /* Flash operations refused */
+  uint16_t    iSlot;                  /* Next free record of the page */
+} APP_HSE_TuneState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_HSE_TuneInit                  ( void );
+bool      APP_HSE_TuneSerialCmdExecute      ( const char * szCommand );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_HSE_TUNE_H */
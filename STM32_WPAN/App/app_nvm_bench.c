@@ -0,0 +1,454 @@
+/**
+  ******************************************************************************
+  * @file    app_nvm_bench.c
+  * @author  MCD Application Team
+  * @brief   Persistence benchmark and flash wear estimator : the flash patterns
+  *          of the Zigbee persistence (SNVMA bank rewrite, SNVML record append
+  *          and compaction, NWK frame counter record) are replayed with the
+  *          Flash Manager in two scratch pages while the radio stacks keep
+  *          running. The commit latency percentiles, the wait for the radio
+  *          windows, the erases per hour and the projected flash lifetime are
+  *          printed in CSV on the trace UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_manager.h"
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_nvm_bench.h"
+#include "app_entry.h"
+#include "simple_nvm_log.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#if (CFG_NVM_BENCH_SUPPORTED != 0)
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED == 0)
+#error "CFG_NVM_BENCH_SUPPORTED needs the Flash Manager of CFG_ZIGBEE_PERSISTENCE_SUPPORTED."
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED == 0) */
+
+/* Private defines -----------------------------------------------------------*/
+#define NVM_BENCH_PAGE_NB               (2u)
+#define NVM_BENCH_BANK_SIZE             ( CFG_ZIGBEE_PERSISTENCE_BUFFER_SIZE * 4u )
+#define NVM_BENCH_LOG_COMPACT_SIZE      ( SNVML_SLOT_SIZE * ( SNVML_RECORD_MAX + 1u ) )
+#define NVM_BENCH_DATA_MAX              MAX( NVM_BENCH_BANK_SIZE, NVM_BENCH_LOG_COMPACT_SIZE )
+#define NVM_BENCH_HOURS_PER_YEAR        (8760u)
+
+/* Private typedef -----------------------------------------------------------*/
+/* One persistence pattern : iAppendSize bytes appended per commit in the current page (0 : always iSwitchSize),
+ * iSwitchSize bytes written in the other page, erased first, when the current one is full */
+typedef struct
+{
+  const char  * szName;
+  uint16_t    iAppendSize;
+  uint16_t    iSwitchSize;
+  uint32_t    lPeriodMs;
+} NvmBenchWorkload_t;
+
+/* Flash operation on going */
+typedef enum
+{
+  NVM_BENCH_STATE_IDLE,
+  NVM_BENCH_STATE_PREPARE,            /* Erase of the two pages before the first commit */
+  NVM_BENCH_STATE_ERASE,              /* Erase of the other page of a commit */
+  NVM_BENCH_STATE_WRITE,              /* Write of a commit */
+  NVM_BENCH_STATE_WAIT,               /* Period between two commits */
+} NvmBenchState_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     NvmBenchTask            ( void );
+static void     NvmBenchTimerCallback   ( void * arg );
+static void     NvmBenchFlashCallback   ( FM_FlashOp_Status_t eStatus );
+static void     NvmBenchWrite           ( void );
+static void     NvmBenchDone            ( void );
+static void     NvmBenchReport          ( void );
+static void     NvmBenchEnd             ( void );
+
+/* Private variables ---------------------------------------------------------*/
+static const NvmBenchWorkload_t   astNvmBenchWorkloads[] =
+{
+  { "BANK",     0u,                                 NVM_BENCH_BANK_SIZE,        CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY },
+  { "LOG",      (uint16_t)( 3u * SNVML_SLOT_SIZE ), NVM_BENCH_LOG_COMPACT_SIZE, CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY },
+  { "COUNTER",  16u,                                16u,                        1000u },
+};
+
+static uint32_t                 * plNvmBenchData;         /* Scratch buffer, taken for the time of a run */
+static uint32_t                   alNvmBenchLatency[CFG_NVM_BENCH_COMMIT_MAX];
+
+static const NvmBenchWorkload_t * pstNvmBench;
+static NvmBenchState_t            eNvmBenchState;
+static FM_FlashOpNode_t           stNvmBenchFlashOp;
+static UTIL_TIMER_Object_t        stNvmBenchTimer;
+static FM_WindowStats_t           stNvmBenchWindowStart;
+
+static uint32_t                   lNvmBenchCommits;
+static uint32_t                   lNvmBenchCommit;
+static uint32_t                   lNvmBenchPeriodMs;
+static uint32_t                   lNvmBenchFieldRate;
+static uint32_t                   lNvmBenchPage;
+static uint32_t                   lNvmBenchOffset;
+static uint32_t                   lNvmBenchWriteSize;
+static uint32_t                   lNvmBenchStart;
+static uint32_t                   lNvmBenchRunStart;
+static uint32_t                   lNvmBenchErases;
+static uint32_t                   lNvmBenchFailures;
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the Task and timer of the benchmark and the DWT cycle counter.
+ * @param  None
+ * @retval None
+ */
+void APP_NVM_BenchInit( void )
+{
+  stNvmBenchFlashOp.Callback = NvmBenchFlashCallback;
+
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  UTIL_TIMER_Create( &stNvmBenchTimer, 0, UTIL_TIMER_ONESHOT, &NvmBenchTimerCallback, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_NVM_BENCH ), UTIL_SEQ_RFU, NvmBenchTask );
+}
+
+/**
+ * @brief  Benchmark serial command : NVMBENCH <BANK|LOG|COUNTER> [commits] [period_ms] [field commits/h].
+ *         The field rate used for the lifetime defaults to one commit per debounce delay.
+ * @param  szCommand  Command received
+ * @retval True if the command is a benchmark command.
+ */
+bool APP_NVM_BenchSerialCmdExecute( const char * szCommand )
+{
+  const NvmBenchWorkload_t  * pstWorkload = NULL;
+  const char                * szText;
+  char                      * pEnd;
+  uint32_t                  lIndex, lLength, lValue[3];
+
+  if ( strncmp( szCommand, "NVMBENCH", 8 ) != 0 )
+  {
+    return false;
+  }
+
+  if ( eNvmBenchState != NVM_BENCH_STATE_IDLE )
+  {
+    LOG_INFO_APP( "Persistence benchmark already running." );
+    return true;
+  }
+
+  for ( lIndex = 0; lIndex < ( sizeof( astNvmBenchWorkloads ) / sizeof( astNvmBenchWorkloads[0] ) ); lIndex++ )
+  {
+    lLength = strlen( astNvmBenchWorkloads[lIndex].szName );
+    if ( ( szCommand[8] == ' ' ) && ( strncmp( &szCommand[9], astNvmBenchWorkloads[lIndex].szName, lLength ) == 0 ) &&
+         ( ( szCommand[9 + lLength] == ' ' ) || ( szCommand[9 + lLength] == '\0' ) ) )
+    {
+      pstWorkload = &astNvmBenchWorkloads[lIndex];
+      break;
+    }
+  }
+
+  if ( pstWorkload == NULL )
+  {
+    LOG_INFO_APP( "Usage : NVMBENCH <BANK|LOG|COUNTER> [commits] [period_ms] [field commits/h]" );
+    return true;
+  }
+
+  /* Optional values, defaults of the workload */
+  lValue[0] = CFG_NVM_BENCH_COMMIT_MAX;
+  lValue[1] = pstWorkload->lPeriodMs;
+  lValue[2] = ( 3600000u / CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY );
+  szText = &szCommand[9 + strlen( pstWorkload->szName )];
+  for ( lIndex = 0; ( lIndex < 3u ) && ( *szText == ' ' ); lIndex++ )
+  {
+    lValue[lIndex] = strtoul( &szText[1], &pEnd, 0 );
+    if ( pEnd == &szText[1] )
+    {
+      break;
+    }
+    szText = pEnd;
+  }
+
+  if ( *szText != '\0' )
+  {
+    LOG_INFO_APP( "Usage : NVMBENCH <BANK|LOG|COUNTER> [commits] [period_ms] [field commits/h]" );
+    return true;
+  }
+
+  /* Data of the commits, not needed across Standby */
+  plNvmBenchData = APPE_MEM_Alloc( NVM_BENCH_DATA_MAX, APPE_MEM_SCRATCH );
+  if ( plNvmBenchData == NULL )
+  {
+    LOG_ERROR_APP( "Error, no memory for the persistence benchmark." );
+    return true;
+  }
+  for ( lIndex = 0; lIndex < ( NVM_BENCH_DATA_MAX / 4u ); lIndex++ )
+  {
+    plNvmBenchData[lIndex] = ( lIndex * 0x01010101u ) ^ 0xA5C31E07u;
+  }
+
+  pstNvmBench = pstWorkload;
+  lNvmBenchCommits = MIN( MAX( lValue[0], 1u ), CFG_NVM_BENCH_COMMIT_MAX );
+  lNvmBenchPeriodMs = lValue[1];
+  lNvmBenchFieldRate = MAX( lValue[2], 1u );
+  lNvmBenchCommit = 0;
+  lNvmBenchErases = 0;
+  lNvmBenchFailures = 0;
+  lNvmBenchPage = 0;
+  lNvmBenchOffset = 0;
+
+  LOG_INFO_APP( "NVMBENCH,start,%s,%d,%d,%d", pstNvmBench->szName, lNvmBenchCommits, lNvmBenchPeriodMs,
+                lNvmBenchFieldRate );
+
+  /* Both scratch pages blank before the first commit, out of the measure */
+  eNvmBenchState = NVM_BENCH_STATE_PREPARE;
+  if ( FM_QueueErase( CFG_NVM_BENCH_SECTOR_ID, NVM_BENCH_PAGE_NB, FM_PRIORITY_NVM, &stNvmBenchFlashOp ) != FM_OK )
+  {
+    LOG_ERROR_APP( "Error, persistence benchmark erase refused." );
+    NvmBenchEnd();
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Start of a commit : erase of the other page when the current one is full, then write.
+ * @param  None
+ * @retval None
+ */
+static void NvmBenchTask( void )
+{
+  bool  bSwitch;
+
+  if ( eNvmBenchState != NVM_BENCH_STATE_WAIT )
+  {
+    return;
+  }
+
+  /* Data of the commit changed as the persistence buffer would */
+  plNvmBenchData[0] = lNvmBenchCommit;
+
+  bSwitch = ( ( pstNvmBench->iAppendSize == 0u ) || ( lNvmBenchOffset + pstNvmBench->iAppendSize > FLASH_PAGE_SIZE ) );
+  lNvmBenchStart = DWT->CYCCNT;
+  if ( bSwitch != false )
+  {
+    lNvmBenchPage ^= 1u;
+    lNvmBenchOffset = 0;
+    lNvmBenchWriteSize = pstNvmBench->iSwitchSize;
+    lNvmBenchErases++;
+
+    eNvmBenchState = NVM_BENCH_STATE_ERASE;
+    if ( FM_QueueErase( ( CFG_NVM_BENCH_SECTOR_ID + lNvmBenchPage ), 1u, FM_PRIORITY_NVM, &stNvmBenchFlashOp ) != FM_OK )
+    {
+      lNvmBenchFailures++;
+      NvmBenchDone();
+    }
+  }
+  else
+  {
+    lNvmBenchWriteSize = pstNvmBench->iAppendSize;
+    NvmBenchWrite();
+  }
+}
+
+/**
+ * @brief  Write of the commit at the current offset of the current page.
+ * @param  None
+ * @retval None
+ */
+static void NvmBenchWrite( void )
+{
+  uint32_t  * plDest;
+
+  plDest = (uint32_t *)( CFG_NVM_BENCH_ADDRESS + ( lNvmBenchPage * FLASH_PAGE_SIZE ) + lNvmBenchOffset );
+
+  eNvmBenchState = NVM_BENCH_STATE_WRITE;
+  if ( FM_QueueWrite( plNvmBenchData, plDest, (int32_t)( lNvmBenchWriteSize / 4u ), FM_PRIORITY_NVM,
+                      &stNvmBenchFlashOp ) != FM_OK )
+  {
+    lNvmBenchFailures++;
+    NvmBenchDone();
+  }
+}
+
+/**
+ * @brief  Flash Manager callback : end of a queued erase/write of the benchmark.
+ * @param  eStatus  Flash operation status
+ * @retval None
+ */
+static void NvmBenchFlashCallback( FM_FlashOp_Status_t eStatus )
+{
+  if ( eStatus != FM_OPERATION_COMPLETE )
+  {
+    lNvmBenchFailures++;
+  }
+
+  switch ( eNvmBenchState )
+  {
+    case NVM_BENCH_STATE_PREPARE:
+      FM_GetWindowStats( &stNvmBenchWindowStart );
+      lNvmBenchRunStart = HAL_GetTick();
+      eNvmBenchState = NVM_BENCH_STATE_WAIT;
+      UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_NVM_BENCH ), TASK_PRIO_NVM_BENCH );
+      break;
+
+    case NVM_BENCH_STATE_ERASE:
+      if ( eStatus == FM_OPERATION_COMPLETE )
+      {
+        NvmBenchWrite();
+      }
+      else
+      {
+        NvmBenchDone();
+      }
+      break;
+
+    case NVM_BENCH_STATE_WRITE:
+      lNvmBenchOffset += lNvmBenchWriteSize;
+      NvmBenchDone();
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief  End of a commit : latency sample, then next commit after the period or report after the last one.
+ * @param  None
+ * @retval None
+ */
+static void NvmBenchDone( void )
+{
+  alNvmBenchLatency[lNvmBenchCommit] = ( DWT->CYCCNT - lNvmBenchStart ) / ( SystemCoreClock / 1000000u );
+  lNvmBenchCommit++;
+
+  eNvmBenchState = NVM_BENCH_STATE_WAIT;
+  if ( lNvmBenchCommit >= lNvmBenchCommits )
+  {
+    NvmBenchReport();
+    NvmBenchEnd();
+  }
+  else if ( lNvmBenchPeriodMs == 0u )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_NVM_BENCH ), TASK_PRIO_NVM_BENCH );
+  }
+  else
+  {
+    UTIL_TIMER_StartWithPeriod( &stNvmBenchTimer, lNvmBenchPeriodMs );
+  }
+}
+
+/**
+ * @brief  End of the run : release of the data buffer.
+ * @param  None
+ * @retval None
+ */
+static void NvmBenchEnd( void )
+{
+  APPE_MEM_Free( plNvmBenchData );
+  plNvmBenchData = NULL;
+  eNvmBenchState = NVM_BENCH_STATE_IDLE;
+}
+
+/**
+ * @brief  Period between two commits elapsed.
+ * @param  arg  Unused
+ * @retval None
+ */
+static void NvmBenchTimerCallback( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_NVM_BENCH ), TASK_PRIO_NVM_BENCH );
+}
+
+/**
+ * @brief  CSV report of the run : latency percentiles (samples sorted in place), wait for the radio windows, erases
+ *         per hour at the rate of the run, and flash lifetime at the field rate (the two pages share the erases).
+ * @param  None
+ * @retval None
+ */
+static void NvmBenchReport( void )
+{
+  FM_WindowStats_t  stWindowEnd;
+  uint32_t          lIndex, lSlot, lSample, lElapsedMs, lWindows, lWaitAvg, lErasesPerHour;
+  uint64_t          llLifetime;
+
+  /* Insertion sort : at most CFG_NVM_BENCH_COMMIT_MAX samples, once per run */
+  for ( lIndex = 1; lIndex < lNvmBenchCommits; lIndex++ )
+  {
+    lSample = alNvmBenchLatency[lIndex];
+    for ( lSlot = lIndex; ( lSlot > 0u ) && ( alNvmBenchLatency[lSlot - 1u] > lSample ); lSlot-- )
+    {
+      alNvmBenchLatency[lSlot] = alNvmBenchLatency[lSlot - 1u];
+    }
+    alNvmBenchLatency[lSlot] = lSample;
+  }
+
+  FM_GetWindowStats( &stWindowEnd );
+  lWindows = stWindowEnd.WindowCount - stNvmBenchWindowStart.WindowCount;
+  lWaitAvg = ( lWindows != 0u ) ? ( ( stWindowEnd.WaitTime - stNvmBenchWindowStart.WaitTime ) / lWindows ) : 0u;
+
+  lElapsedMs = MAX( ( HAL_GetTick() - lNvmBenchRunStart ), 1u );
+  lErasesPerHour = (uint32_t)( ( (uint64_t)lNvmBenchErases * 3600000u ) / lElapsedMs );
+
+  LOG_INFO_APP( "NVMBENCH,workload,commits,failures,p50_us,p90_us,p99_us,max_us,windows,wait_avg_us,wait_max_us,"
+                "erases,erases_per_hour,field_commits_per_hour,lifetime_years_x10" );
+
+  if ( lNvmBenchErases == 0u )
+  {
+    /* No page switch in the run : not enough commits for a projection */
+    LOG_INFO_APP( "NVMBENCH,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,0,0,%d,", pstNvmBench->szName, lNvmBenchCommits,
+                  lNvmBenchFailures, alNvmBenchLatency[( lNvmBenchCommits * 50u ) / 100u],
+                  alNvmBenchLatency[( lNvmBenchCommits * 90u ) / 100u], alNvmBenchLatency[( lNvmBenchCommits * 99u ) / 100u],
+                  alNvmBenchLatency[lNvmBenchCommits - 1u], lWindows, lWaitAvg, stWindowEnd.MaxWaitTime,
+                  lNvmBenchFieldRate );
+  }
+  else
+  {
+    /* Hours = Endurance x Pages / ( Erases per commit x Field commits per hour ) */
+    llLifetime = ( (uint64_t)CFG_NVM_BENCH_ENDURANCE * NVM_BENCH_PAGE_NB * lNvmBenchCommits * 10u ) /
+                 ( (uint64_t)lNvmBenchErases * lNvmBenchFieldRate * NVM_BENCH_HOURS_PER_YEAR );
+
+    LOG_INFO_APP( "NVMBENCH,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", pstNvmBench->szName, lNvmBenchCommits,
+                  lNvmBenchFailures, alNvmBenchLatency[( lNvmBenchCommits * 50u ) / 100u],
+                  alNvmBenchLatency[( lNvmBenchCommits * 90u ) / 100u], alNvmBenchLatency[( lNvmBenchCommits * 99u ) / 100u],
+                  alNvmBenchLatency[lNvmBenchCommits - 1u], lWindows, lWaitAvg, stWindowEnd.MaxWaitTime,
+                  lNvmBenchErases, lErasesPerHour, lNvmBenchFieldRate, (uint32_t)llLifetime );
+  }
+
+  LOG_INFO_APP( "NVMBENCH,end" );
+}
+
+#else /* (CFG_NVM_BENCH_SUPPORTED != 0) */
+
+/**
+ * @brief  No benchmark.
+ */
+void APP_NVM_BenchInit( void )
+{
+}
+
+/**
+ * @brief  No benchmark : no command.
+ */
+bool APP_NVM_BenchSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_NVM_BENCH_SUPPORTED != 0) */
@@ -0,0 +1,169 @@
+/**
+  ******************************************************************************
+  * @file    app_supply.c
+  * @author  MCD Application Team
+  * @brief   Supply voltage monitoring : the internal voltage reference is
+  *          converted every CFG_APP_SUPPLY_PERIOD by an ADC batch, queued with
+  *          the temperature measurements of the link layer so that they share
+  *          the activations of the ADC. The analog supply (VDDA, bonded to VDD
+  *          on the packages without Vref+) follows from its calibration.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_supply.h"
+#include "adc_ctrl.h"
+#include "adc_ctrl_conf.h"
+
+#include "stm32_timer.h"
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+
+/* Private variables ---------------------------------------------------------*/
+static APP_SUPPLY_State_t           stSupplyState;
+static ADCCTRL_Batch_t              stSupplyBatch;
+static UTIL_TIMER_Object_t          stSupplyTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     SupplyTimerCallback     ( void * arg );
+static void     SupplyBatchEnd          ( ADCCTRL_Batch_t * pstBatch );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the supply voltage monitoring : the first measurement is done after one period, once the link
+ *         layer made its own first (polled) one.
+ * @param  None
+ * @retval None
+ */
+void APP_SUPPLY_Init( void )
+{
+  ADCCTRL_Cmd_Status_t eStatus;
+
+  eStatus = ADCCTRL_RegisterHandle( &AppSupplyRequest_Handle );
+  if ( ( eStatus != ADCCTRL_OK ) && ( eStatus != ADCCTRL_HANDLE_ALREADY_REGISTERED ) )
+  {
+    LOG_ERROR_APP( "Error, supply voltage ADC handle not registered (%d).", eStatus );
+    return;
+  }
+
+  stSupplyBatch.p_Handle = &AppSupplyRequest_Handle;
+  stSupplyBatch.Callback = &SupplyBatchEnd;
+  stSupplyState.iMinMv = UINT16_MAX;
+
+  (void)UTIL_TIMER_Create( &stSupplyTimer, CFG_APP_SUPPLY_PERIOD, UTIL_TIMER_PERIODIC, &SupplyTimerCallback, NULL );
+  (void)UTIL_TIMER_Start( &stSupplyTimer );
+}
+
+/**
+ * @brief  Print the supply voltage statistics (VDDSTATS).
+ * @param  szCommand  Received command
+ * @retval True if the command is a supply voltage command.
+ */
+bool APP_SUPPLY_SerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "VDDSTATS" ) != 0 )
+  {
+    return false;
+  }
+
+  if ( stSupplyState.lSamples == 0u )
+  {
+    LOG_INFO_APP( "Supply voltage : not measured yet (period %u ms).", CFG_APP_SUPPLY_PERIOD );
+  }
+  else
+  {
+    LOG_INFO_APP( "Supply voltage : last %u mV, min %u mV, max %u mV, %u measured.", stSupplyState.iLastMv,
+                  stSupplyState.iMinMv, stSupplyState.iMaxMv, stSupplyState.lSamples );
+  }
+  LOG_INFO_APP( "Supply voltage : %u periods skipped, %u errors.", stSupplyState.lSkipped, stSupplyState.lErrors );
+
+  return true;
+}
+
+/**
+ * @brief  Period of the measurements : a batch is queued, unless the previous one is still waiting.
+ * @param  arg  Not used
+ * @retval None
+ */
+static void SupplyTimerCallback( void * arg )
+{
+  UNUSED( arg );
+
+  if ( stSupplyState.bPending != false )
+  {
+    stSupplyState.lSkipped++;
+    return;
+  }
+
+  stSupplyState.bPending = true;
+  if ( ADCCTRL_SubmitBatch( &stSupplyBatch ) != ADCCTRL_OK )
+  {
+    stSupplyState.bPending = false;
+    stSupplyState.lErrors++;
+  }
+}
+
+/**
+ * @brief  End of the batch (DMA interrupt) : the average of the samples gives the supply voltage.
+ * @param  pstBatch  Supply voltage batch
+ * @retval None
+ */
+static void SupplyBatchEnd( ADCCTRL_Batch_t * pstBatch )
+{
+  uint16_t  iVoltageMv;
+
+  stSupplyState.bPending = false;
+
+  iVoltageMv = ADCCTRL_ConvertSupplyVoltage( pstBatch->p_Handle, pstBatch->Average );
+  if ( ( pstBatch->Status != ADCCTRL_OK ) || ( iVoltageMv == 0u ) )
+  {
+    stSupplyState.lErrors++;
+    return;
+  }
+
+  stSupplyState.lSamples++;
+  stSupplyState.iLastMv = iVoltageMv;
+  if ( iVoltageMv < stSupplyState.iMinMv )
+  {
+    stSupplyState.iMinMv = iVoltageMv;
+  }
+  if ( iVoltageMv > stSupplyState.iMaxMv )
+  {
+    stSupplyState.iMaxMv = iVoltageMv;
+  }
+}
+
+#else /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+/**
+ * @brief  No ADC batches : no supply voltage monitoring.
+ */
+void APP_SUPPLY_Init( void )
+{
+}
+
+/**
+ * @brief  No supply voltage monitoring : no command.
+ */
+bool APP_SUPPLY_SerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    app_supply.h
+  * @author  MCD Application Team
+  * @brief   Interface of the supply voltage monitoring.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_SUPPLY_H
+#define APP_SUPPLY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the supply voltage monitoring */
+typedef struct
+{
+  uint32_t    lSamples;               /* Measurements since the boot */
+  uint32_t    lSkipped;               /* Periods skipped, the previous measurement still queued */
+  uint32_t    lErrors;                /* Batches refused or failed */
+  uint16_t    iLastMv;                /* Last supply voltage in mV */
+  uint16_t    iMinMv;                 /* Lowest supply voltage since the boot in mV */
+  uint16_t    iMaxMv;                 /* Highest supply voltage since the boot in mV */
+  volatile bool bPending;             /* A measurement is queued or running */
+} APP_SUPPLY_State_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_SUPPLY_Init                   ( void );
+bool      APP_SUPPLY_SerialCmdExecute       ( const char * szCommand );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_SUPPLY_H */
@@ -0,0 +1,373 @@
+/**
+  ******************************************************************************
+  * @file    app_util_bench.c
+  * @author  MCD Application Team
+  * @brief   Micro-benchmarks of the timer server and of the memory manager :
+  *          timer start, stop and expiry costs versus the number of timers
+  *          running, AMM allocation and release costs and fragmentation under
+  *          a replayed Zigbee allocation trace. Timed in DWT cycles on the
+  *          device, the results printed in CSV on the trace UART.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_util_bench.h"
+#include "app_entry.h"
+
+#include "stm32_timer.h"
+#include "advanced_memory_manager.h"
+#include "serial_cmd_interpreter.h"
+
+#if (CFG_UTIL_BENCH_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define UTIL_BENCH_FILL_PERIOD_MS       (3600000u)  /* Timers of the fill : never expire during the benchmark */
+#define UTIL_BENCH_FILL_STEP_MS         (1000u)
+#define UTIL_BENCH_PROBE_PERIOD_MS      ( UTIL_BENCH_FILL_PERIOD_MS + ( UTIL_BENCH_FILL_STEP_MS * CFG_UTIL_BENCH_TIMER_NBR / 2u ) )
+#define UTIL_BENCH_EXPIRY_WAIT_MS       (3u)
+#define UTIL_BENCH_ALLOC_SLOT_NBR       (12u)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Cycles of one measured operation */
+typedef struct
+{
+  uint32_t    lMin;
+  uint32_t    lMax;
+  uint64_t    llTotal;
+  uint16_t    iCount;
+} UtilBenchStats_t;
+
+/* One step of the allocation trace : iSize bytes allocated in the slot cSlot (after the release of its buffer, if
+ * any), or the buffer of the slot released if iSize is 0 */
+typedef struct
+{
+  uint8_t     cSlot;
+  uint16_t    iSize;
+} UtilBenchAllocStep_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     UtilBenchRun                ( void );
+static void     UtilBenchTimers             ( void );
+static void     UtilBenchTimersLevel        ( uint32_t lFillNbr );
+static void     UtilBenchAmm                ( void );
+static void     UtilBenchAmmFree            ( uint8_t cSlot, UtilBenchStats_t * pstStats );
+static void     UtilBenchTimerCallback      ( void * arg );
+static void     UtilBenchStatsReset         ( UtilBenchStats_t * pstStats );
+static void     UtilBenchStatsAdd           ( UtilBenchStats_t * pstStats, uint32_t lCycles );
+static void     UtilBenchStatsPrint         ( const char * szName, uint32_t lSize, const UtilBenchStats_t * pstStats );
+
+/* Private variables ---------------------------------------------------------*/
+/* Allocation pattern of the Zigbee stack from the join to the ZCL traffic : long-lived table entries (neighbor,
+ * keys) among short-lived NWK frames, APS and ZCL buffers and timers released out of order. The long-lived buffers
+ * are kept from one replay to the next one. */
+static const UtilBenchAllocStep_t astUtilBenchAllocTrace[] =
+{
+  { 0u, 200u }, { 1u, 127u }, { 1u, 0u },   { 2u, 127u }, { 3u, 64u },  { 2u, 0u },   { 4u, 40u },  { 5u, 24u },
+  { 3u, 0u },   { 6u, 127u }, { 7u, 96u },  { 5u, 0u },   { 8u, 48u },  { 6u, 0u },   { 9u, 127u }, { 4u, 0u },
+  { 10u, 300u },{ 7u, 0u },   { 8u, 0u },   { 11u, 127u },{ 9u, 0u },   { 1u, 80u },  { 11u, 0u },  { 2u, 24u },
+  { 1u, 0u },   { 3u, 127u }, { 4u, 160u }, { 2u, 0u },   { 5u, 40u },  { 3u, 0u },   { 6u, 256u }, { 5u, 0u },
+  { 7u, 127u }, { 4u, 0u },   { 7u, 0u },   { 6u, 0u },
+};
+
+static UTIL_TIMER_Object_t        astUtilBenchTimers[CFG_UTIL_BENCH_TIMER_NBR];
+static UTIL_TIMER_Object_t        stUtilBenchProbe;
+static uint32_t *                 apUtilBenchBuffers[UTIL_BENCH_ALLOC_SLOT_NBR];
+static volatile uint32_t          lUtilBenchExpiries;
+
+static const SerialCmd_t          astUtilBenchSerialCmds[] =
+{
+  { "UTILBENCH", UtilBenchRun, NULL },
+};
+
+static SerialCmdTable_t           stUtilBenchSerialCmdTable =
+{
+  astUtilBenchSerialCmds, ( sizeof( astUtilBenchSerialCmds ) / sizeof( astUtilBenchSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the timers of the benchmarks, the DWT cycle counter and the serial command.
+ * @param  None
+ * @retval None
+ */
+void APP_UTIL_BenchInit( void )
+{
+  uint32_t  lIndex;
+
+  for ( lIndex = 0; lIndex < CFG_UTIL_BENCH_TIMER_NBR; lIndex++ )
+  {
+    UTIL_TIMER_Create( &astUtilBenchTimers[lIndex], ( UTIL_BENCH_FILL_PERIOD_MS + ( lIndex * UTIL_BENCH_FILL_STEP_MS ) ),
+                       UTIL_TIMER_ONESHOT, &UtilBenchTimerCallback, NULL );
+  }
+  UTIL_TIMER_Create( &stUtilBenchProbe, UTIL_BENCH_PROBE_PERIOD_MS, UTIL_TIMER_ONESHOT, &UtilBenchTimerCallback, NULL );
+
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  Serial_CMD_Interpreter_RegisterTable( &stUtilBenchSerialCmdTable );
+}
+
+/**
+ * @brief  Benchmark serial command : UTILBENCH (run all the benchmarks, in the command itself).
+ * @param  None
+ * @retval None
+ */
+static void UtilBenchRun( void )
+{
+  LOG_INFO_APP( "UTILBENCH,device,0x%03X,revision,0x%04X,sysclk,%d", HAL_GetDEVID(), HAL_GetREVID(), SystemCoreClock );
+  LOG_INFO_APP( "UTILBENCH,operation,size,iterations,min_cycles,avg_cycles,max_cycles" );
+
+  UtilBenchTimers();
+  UtilBenchAmm();
+
+  LOG_INFO_APP( "UTILBENCH,end" );
+}
+
+/**
+ * @brief  Timer server : the costs measured with 0, 1, 2, 4... timers of the benchmark running, added to the timers
+ *         of the application. One place is left for the measured timer.
+ */
+static void UtilBenchTimers( void )
+{
+  UTIL_TIMER_Object_t * apRunning[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+  uint32_t              lFree, lFillNbr;
+
+  lFree = UTIL_TIMER_CONF_MAX_TIMER_NBR - UTIL_TIMER_GetRunningTimers( apRunning, UTIL_TIMER_CONF_MAX_TIMER_NBR );
+  if ( lFree == 0u )
+  {
+    LOG_INFO_APP( "UTILBENCH,timer,no free timer" );
+    return;
+  }
+  lFree = MIN( ( lFree - 1u ), CFG_UTIL_BENCH_TIMER_NBR );
+
+  lFillNbr = 0;
+  while ( true )
+  {
+    UtilBenchTimersLevel( lFillNbr );
+    APPE_SEQ_YieldToRadio();
+    if ( lFillNbr >= lFree )
+    {
+      break;
+    }
+    lFillNbr = ( ( lFillNbr == 0u ) ? 1u : MIN( ( lFillNbr * 2u ), lFree ) );
+  }
+}
+
+/**
+ * @brief  Timer server : start, stop and expiry of a timer with lFillNbr timers of the benchmark running. The size
+ *         printed is the number of timers running, those of the application included.
+ */
+static void UtilBenchTimersLevel( uint32_t lFillNbr )
+{
+  UTIL_TIMER_Object_t * apRunning[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+  UtilBenchStats_t      stStart, stStop, stExpiry;
+  uint32_t              lIndex, lRunning, lStart, lCycles, lWait, lExpiries, primask_bit;
+
+  for ( lIndex = 0; lIndex < lFillNbr; lIndex++ )
+  {
+    (void)UTIL_TIMER_Start( &astUtilBenchTimers[lIndex] );
+  }
+  lRunning = UTIL_TIMER_GetRunningTimers( apRunning, UTIL_TIMER_CONF_MAX_TIMER_NBR );
+
+  UtilBenchStatsReset( &stStart );
+  UtilBenchStatsReset( &stStop );
+  UtilBenchStatsReset( &stExpiry );
+  lWait = ( SystemCoreClock / 1000u ) * UTIL_BENCH_EXPIRY_WAIT_MS;
+
+  for ( lIndex = 0; lIndex < CFG_UTIL_BENCH_ITERATIONS; lIndex++ )
+  {
+    /* Insertion in the middle of the timers of the benchmark, then removal */
+    (void)UTIL_TIMER_SetPeriod( &stUtilBenchProbe, UTIL_BENCH_PROBE_PERIOD_MS );
+
+    lStart = DWT->CYCCNT;
+    (void)UTIL_TIMER_Start( &stUtilBenchProbe );
+    UtilBenchStatsAdd( &stStart, ( DWT->CYCCNT - lStart ) );
+
+    lStart = DWT->CYCCNT;
+    (void)UTIL_TIMER_Stop( &stUtilBenchProbe );
+    UtilBenchStatsAdd( &stStop, ( DWT->CYCCNT - lStart ) );
+
+    /* Expiry : the interrupts are masked until the pass processing it, so that the timer server interrupt does
+     * not take it first */
+    (void)UTIL_TIMER_SetPeriod( &stUtilBenchProbe, 1u );
+    lExpiries = lUtilBenchExpiries;
+
+    primask_bit = __get_PRIMASK();
+    __disable_irq();
+
+    (void)UTIL_TIMER_Start( &stUtilBenchProbe );
+    lStart = DWT->CYCCNT;
+    while ( ( DWT->CYCCNT - lStart ) < lWait ) {}
+
+    lStart = DWT->CYCCNT;
+    UTIL_TIMER_ProcessExpired();
+    lCycles = DWT->CYCCNT - lStart;
+
+    __set_PRIMASK( primask_bit );
+
+    if ( lUtilBenchExpiries != lExpiries )
+    {
+      UtilBenchStatsAdd( &stExpiry, lCycles );
+    }
+    else
+    {
+      (void)UTIL_TIMER_Stop( &stUtilBenchProbe );
+    }
+  }
+
+  for ( lIndex = 0; lIndex < lFillNbr; lIndex++ )
+  {
+    (void)UTIL_TIMER_Stop( &astUtilBenchTimers[lIndex] );
+  }
+
+  UtilBenchStatsPrint( "UTIL_TIMER_Start", lRunning, &stStart );
+  UtilBenchStatsPrint( "UTIL_TIMER_Stop", lRunning, &stStop );
+  UtilBenchStatsPrint( "UTIL_TIMER_ProcessExpired", lRunning, &stExpiry );
+}
+
+/**
+ * @brief  AMM : CFG_UTIL_BENCH_TRACE_LOOPS replays of the allocation trace in the Zigbee heap virtual memory. The
+ *         free size of the shared pool and its largest block are printed after each replay, the long-lived buffers
+ *         still allocated.
+ */
+static void UtilBenchAmm( void )
+{
+  const UtilBenchAllocStep_t  * pstStep;
+  UtilBenchStats_t            stAlloc, stFree;
+  AMM_VirtualMemoryStats_t    stAmmStats;
+  uint32_t                    lLoop, lIndex, lStart, lCycles, lLargest, lFailures = 0;
+  AMM_Function_Error_t        eStatus;
+
+  UtilBenchStatsReset( &stAlloc );
+  UtilBenchStatsReset( &stFree );
+
+  LOG_INFO_APP( "UTILBENCH,amm_fragmentation,loop,free_words,largest_free_words" );
+
+  for ( lLoop = 0; lLoop < CFG_UTIL_BENCH_TRACE_LOOPS; lLoop++ )
+  {
+    for ( lIndex = 0; lIndex < ( sizeof( astUtilBenchAllocTrace ) / sizeof( astUtilBenchAllocTrace[0] ) ); lIndex++ )
+    {
+      pstStep = &astUtilBenchAllocTrace[lIndex];
+      UtilBenchAmmFree( pstStep->cSlot, &stFree );
+
+      if ( pstStep->iSize != 0u )
+      {
+        lStart = DWT->CYCCNT;
+        eStatus = AMM_Alloc( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, DIVC( pstStep->iSize, sizeof( uint32_t ) ),
+                             &apUtilBenchBuffers[pstStep->cSlot], NULL );
+        lCycles = DWT->CYCCNT - lStart;
+
+        if ( eStatus == AMM_ERROR_OK )
+        {
+          UtilBenchStatsAdd( &stAlloc, lCycles );
+        }
+        else
+        {
+          apUtilBenchBuffers[pstStep->cSlot] = NULL;
+          lFailures++;
+        }
+      }
+    }
+
+    lLargest = 0;
+    (void)AMM_GetLargestFreeBlock( &lLargest );
+    stAmmStats.AvailableSize = 0;
+    (void)AMM_GetVirtualMemoryStats( AMM_NO_VIRTUAL_ID, &stAmmStats );
+    LOG_INFO_APP( "UTILBENCH,amm_fragmentation,%d,%d,%d", lLoop, stAmmStats.AvailableSize, lLargest );
+    APPE_SEQ_YieldToRadio();
+  }
+
+  for ( lIndex = 0; lIndex < UTIL_BENCH_ALLOC_SLOT_NBR; lIndex++ )
+  {
+    UtilBenchAmmFree( (uint8_t)lIndex, &stFree );
+  }
+
+  UtilBenchStatsPrint( "AMM_Alloc", 0u, &stAlloc );
+  UtilBenchStatsPrint( "AMM_Free", 0u, &stFree );
+  if ( lFailures != 0u )
+  {
+    LOG_INFO_APP( "UTILBENCH,AMM_Alloc,%d failures", lFailures );
+  }
+}
+
+/**
+ * @brief  AMM : release of the buffer of a slot, if any.
+ */
+static void UtilBenchAmmFree( uint8_t cSlot, UtilBenchStats_t * pstStats )
+{
+  uint32_t  lStart;
+
+  if ( apUtilBenchBuffers[cSlot] == NULL )
+  {
+    return;
+  }
+
+  lStart = DWT->CYCCNT;
+  (void)AMM_Free( apUtilBenchBuffers[cSlot] );
+  UtilBenchStatsAdd( pstStats, ( DWT->CYCCNT - lStart ) );
+
+  apUtilBenchBuffers[cSlot] = NULL;
+}
+
+/**
+ * @brief  Expiry of a timer of the benchmark.
+ */
+static void UtilBenchTimerCallback( void * arg )
+{
+  UNUSED( arg );
+
+  lUtilBenchExpiries++;
+}
+
+static void UtilBenchStatsReset( UtilBenchStats_t * pstStats )
+{
+  pstStats->lMin = UINT32_MAX;
+  pstStats->lMax = 0;
+  pstStats->llTotal = 0;
+  pstStats->iCount = 0;
+}
+
+static void UtilBenchStatsAdd( UtilBenchStats_t * pstStats, uint32_t lCycles )
+{
+  pstStats->lMin = MIN( pstStats->lMin, lCycles );
+  pstStats->lMax = MAX( pstStats->lMax, lCycles );
+  pstStats->llTotal += lCycles;
+  pstStats->iCount++;
+}
+
+static void UtilBenchStatsPrint( const char * szName, uint32_t lSize, const UtilBenchStats_t * pstStats )
+{
+  if ( pstStats->iCount == 0u )
+  {
+    LOG_INFO_APP( "UTILBENCH,%s,%d,0,,,", szName, lSize );
+    return;
+  }
+
+  LOG_INFO_APP( "UTILBENCH,%s,%d,%d,%d,%d,%d", szName, lSize, pstStats->iCount, pstStats->lMin,
+                (uint32_t)( pstStats->llTotal / pstStats->iCount ), pstStats->lMax );
+}
+
+#else /* (CFG_UTIL_BENCH_SUPPORTED != 0) */
+
+/**
+ * @brief  No benchmark.
+ */
+void APP_UTIL_BenchInit( void )
+{
+}
+
+#endif /* (CFG_UTIL_BENCH_SUPPORTED != 0) */
@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file    app_util_bench.h
+  * @author  MCD Application Team
+  * @brief   Interface of the timer server and memory manager micro-benchmarks.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_UTIL_BENCH_H
+#define APP_UTIL_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_UTIL_BenchInit                ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_UTIL_BENCH_H */
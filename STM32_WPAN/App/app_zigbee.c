@@ -27,12 +27,21 @@
 #include "app_entry.h"
 #include "app_zigbee.h"
 #include "app_zigbee_endpoint.h"
+#include "app_zigbee_broadcast.h"
+#include "app_zigbee_tckey.h"
+#include "app_zigbee_hashkey.h"
+#include "app_zigbee_batch.h"
 #include "dbg_trace.h"
 #include "ieee802154_enums.h"
 #include "mcp_enums.h"
 
 #include "stm32_rtos.h"
 #include "stm32_timer.h"
+#include "zigbee_plat.h"
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+#include "simple_nvm_arbiter.h"
+#include "simple_nvm_log.h"
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
 
 #include "zigbee.h"
 #include "zigbee.nwk.h"
@@ -43,6 +52,7 @@
 /* Private includes -----------------------------------------------------------*/
 /* USER CODE BEGIN PI */
 #include "app_bsp.h"
+#include "app_crash_log.h"
 
 /* USER CODE END PI */
 
@@ -54,8 +64,19 @@ ZigbeeAppInfo_t                                     stZigbeeAppInfo;
 /* USER CODE END PV */
 
 /* Private defines -----------------------------------------------------------*/
-#define APP_ZIGBEE_STARTUP_FAIL_DELAY               500u        // Time (in ms) between two tentative to Join a Coord/Router.
+#define APP_ZIGBEE_STARTUP_FAIL_DELAY               500u        // Time (in ms) before the first new tentative to Join a Coord/Router, doubled at each consecutive failure.
+#define APP_ZIGBEE_STARTUP_FAIL_DELAY_MAX           60000u      // Maximum time (in ms) between two tentatives.
+#define APP_ZIGBEE_STARTUP_FAIL_JITTER              50u         // Part (in %) of the time between two tentatives that is random, to not retry in lockstep with the other devices.
 #define APP_ZIGBEE_STARTUP_WAIT_JOINT_DELAY         1000u       // Time (in ms) between two Timer callback during the time after the Join (17 s).
+#define APP_ZIGBEE_STARTUP_WAIT_JOINT_SLACK         200u        // Tolerated lateness (in ms) of this Timer callback.
+#define APP_ZIGBEE_SCAN_DURATION                    2u          // Duration (MAC exponent, about 60 ms per channel) of the active scan that ranks the channels before a Join.
+#define APP_ZIGBEE_SCAN_NETWORK_MAX                 16u         // Maximum number of discovered networks read to rank the channels.
+
+#define APP_ZIGBEE_INSTALL_CODE_PER_TASK            4u          // Number of link keys derived at each run of the 'Install Code' Task, to not hold the sequencer.
+
+#define APP_ZIGBEE_PERSIST_MAGIC                    0x5A425053u // 'ZBPS', identify a valid persistence image.
+#define APP_ZIGBEE_PERSIST_HASH_INIT                0x811C9DC5u // FNV-1a offset basis, used to detect unchanged persistence data.
+#define APP_ZIGBEE_PERSIST_HASH_PRIME               0x01000193u // FNV-1a prime.
 
 /* Defines for Basic Cluster Server */
 #define APP_ZIGBEE_MFR_NAME                         "STMicroelectronics"
@@ -72,6 +93,28 @@ ZigbeeAppInfo_t                                     stZigbeeAppInfo;
 
 /* USER CODE END PD */
 
+/* Private typedef -----------------------------------------------------------*/
+/* States of the 'Network Form or Join' Task */
+typedef enum
+{
+  APP_ZIGBEE_NWK_FORM_IDLE,                 /* Nothing launched yet */
+  APP_ZIGBEE_NWK_FORM_PERSIST_ONGOING,      /* ZbStartupPersist launched, waiting for ZbStartupWaitCallback */
+  APP_ZIGBEE_NWK_FORM_SCAN_ONGOING,         /* Active scan launched to rank the channels, waiting for its callback */
+  APP_ZIGBEE_NWK_FORM_STARTUP_ONGOING,      /* ZbStartup launched, waiting for ZbStartupWaitCallback */
+  APP_ZIGBEE_NWK_FORM_RETRY_WAIT,           /* Startup failed, waiting for the next tentative */
+  APP_ZIGBEE_NWK_FORM_DONE,                 /* Network formed or joined */
+} APP_ZIGBEE_NwkFormState_t;
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+/* Persistence image saved in NVM, its size shall be a multiple of 32 bits */
+typedef struct
+{
+  uint32_t              lMagic;
+  uint32_t              lSize;
+  uint8_t               cData[( CFG_ZIGBEE_PERSISTENCE_BUFFER_SIZE - 2u ) * sizeof( uint32_t )];
+} APP_ZIGBEE_PersistImage_t;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
 /* Private constants ---------------------------------------------------------*/
 /* USER CODE BEGIN PC */
 
@@ -79,12 +122,49 @@ ZigbeeAppInfo_t                                     stZigbeeAppInfo;
 
 /* Private function prototypes -----------------------------------------------*/
 static enum ZbStatusCodeT ZbStartupWait       ( struct ZigBeeT * zb, struct ZbStartupT * pstConfig );
-
+static enum ZbStatusCodeT ZbStartupWaitEnd    ( void );
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+static enum ZbStatusCodeT ZbStartupPersistWait ( struct ZigBeeT * pstZigbee );
+
+static bool APP_ZIGBEE_PersistenceRegister    ( void );
+static bool APP_ZIGBEE_PersistenceLoad        ( void );
+static void APP_ZIGBEE_PersistenceTask        ( void );
+static uint32_t APP_ZIGBEE_PersistenceHash    ( const uint8_t * pData, uint32_t lSize );
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+static void APP_ZIGBEE_PersistenceWriteCallback ( SNVML_Callback_Status_t eStatus );
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+static void APP_ZIGBEE_PersistenceWriteCallback ( SNVMA_Callback_Status_t eStatus );
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+static void APP_ZIGBEE_InstallCodeTask        ( void );
+static bool APP_ZIGBEE_ParseHex               ( const char ** pszText, uint8_t * pData, uint16_t iLength );
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+static void APP_ZIGBEE_JoinAdmissionElapsed   ( void * arg );
+static void APP_ZIGBEE_JoinAdmissionTask      ( void );
+static enum zb_msg_filter_rc APP_ZIGBEE_JoinAdmissionCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+static void APP_ZIGBEE_ConcentratorElapsed    ( void * arg );
+static void APP_ZIGBEE_ConcentratorTask       ( void );
+static uint16_t APP_ZIGBEE_CountNwkTable      ( enum ZbNwkNibAttrIdT eAttrId, void * pEntry, uint16_t iEntrySize, const uint16_t * piAddress, uint16_t * piSize );
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+
+static bool APP_ZIGBEE_AddInstallCodeKey      ( uint64_t dlExtendedAddress, const uint8_t * szInstallCode );
 static void APP_ZIGBEE_ConfigBasicServer      ( void );
+static uint32_t APP_ZIGBEE_HeapCurrentSize    ( void );
 static void APP_ZIGBEE_TraceError             ( const char * pMess, uint32_t lErrCode );
 static void APP_ZIGBEE_ConfigMeshNetwork      ( void );
 static void APP_ZIGBEE_NwkFormWaitElapsed     ( void * arg );
 static void APP_ZIGBEE_NwkFormWaitJoinElapsed ( void * arg );
+static uint32_t APP_ZIGBEE_GetStartupRetryDelay ( uint32_t lConsecutiveFailures );
+static enum ZbStatusCodeT APP_ZIGBEE_ChannelScanStart ( void );
+static void APP_ZIGBEE_ChannelScanCallback    ( struct ZbNlmeNetDiscConfT * pstConfig, void * arg );
+static void APP_ZIGBEE_ChannelRank            ( void );
 static void APP_ZIGBEE_Printf                 ( struct ZigBeeT * zb, uint32_t lMask, const char * pHeader, const char * pFrame, va_list argptr );
 
 static enum zb_msg_filter_rc APP_ZIGBEE_DeviceJointCallback   ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
@@ -95,6 +175,36 @@ static enum zb_msg_filter_rc APP_ZIGBEE_DeviceJointCallback   ( struct ZigBeeT *
 
 /* Private variabless -----------------------------------------------*/
 static enum ZbStatusCodeT       eZbStartupWaitStatus;
+static APP_ZIGBEE_NwkFormState_t eNwkFormState = APP_ZIGBEE_NWK_FORM_IDLE;
+static bool                     bJoinLastChannelFirst = true;
+static uint32_t                 lNwkFormStartTick;
+static uint8_t                  acJoinChannelRank[ZB_CHANNEL_LIST_NUM_MAX - 2u];
+static uint8_t                  cJoinChannelRankNb;
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+static APP_ZIGBEE_PersistImage_t  stPersistImage;
+static bool                     bPersistRegistered, bPersistWriteOnGoing, bPersistSavePending;
+static bool                     bPersistDelayed;
+static uint32_t                 lPersistFirstNotifyTick, lPersistHash;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+static APP_ZIGBEE_InstallCode_t astInstallCodeQueue[CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE];
+static uint16_t                 iInstallCodeHead, iInstallCodeCount;
+static uint8_t                  cInstallCodeJoinDelay;
+static uint32_t                 lInstallCodeAdded, lInstallCodeFailed, lInstallCodeJoined;
+static uint32_t                 lInstallCodeWindowTick, lInstallCodeWindowTime;
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+static struct ZbMsgFilterT *    pstJoinAdmissionFilter;
+static UTIL_TIMER_Object_t      stJoinAdmissionTimer;
+static bool                     bJoinAdmissionDeferred;
+static uint8_t                  cJoinAdmissionDuration;
+static uint32_t                 lJoinAdmissionWindowTick, lJoinAdmissionCloseTick;
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+static UTIL_TIMER_Object_t      stConcentratorTimer;
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+static struct ZbStartupT        stZbStartupConfig;
 static UTIL_TIMER_Object_t      stNwkFormWaitTimer, stNwkFormWaitJoinTimer;
 
 /* USER CODE BEGIN PV */
@@ -117,13 +227,16 @@ void APP_ZIGBEE_NwkFormOrJoinTaskInit( void )
   {
     /* Create the Timer service to can advertise user during the time after the Join (by default 17 seconds) */
     UTIL_TIMER_Create( &stNwkFormWaitJoinTimer, APP_ZIGBEE_STARTUP_WAIT_JOINT_DELAY, UTIL_TIMER_PERIODIC, &APP_ZIGBEE_NwkFormWaitJoinElapsed, NULL );
+
+    /* Led blinking does not need an exact period, allow it to share wakeups with other timers */
+    UTIL_TIMER_SetSlack( &stNwkFormWaitJoinTimer, APP_ZIGBEE_STARTUP_WAIT_JOINT_SLACK );
   }
 
   /* Create the Task associated with network creation process */
-  UTIL_SEQ_RegTask( 1U << CFG_TASK_ZIGBEE_NETWORK_FORM, UTIL_SEQ_RFU, APP_ZIGBEE_NwkFormOrJoin );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), UTIL_SEQ_RFU, APP_ZIGBEE_NwkFormOrJoin );
 
   /* launch the startup of the mesh network setup */
-  UTIL_SEQ_SetTask( 1U << CFG_TASK_ZIGBEE_NETWORK_FORM, TASK_PRIO_ZIGBEE_NETWORK_FORM );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM );
 }
 
 /**
@@ -161,6 +274,70 @@ static void APP_ZIGBEE_ConfigBasicServer( void )
   ZbZclBasicServerConfigDefaults( stZigbeeAppInfo.pstZigbee , &stBasicServerDefaults );
 }
 
+/**
+ * @brief  Memory currently used in the Zigbee heaps (init and runtime)
+ * @param  None
+ * @retval Used size (in bytes)
+ */
+static uint32_t APP_ZIGBEE_HeapCurrentSize( void )
+{
+  return ( (uint32_t)ZIGBEE_PLAT_ZbHeapMallocCurrentSize() + (uint32_t)ZIGBEE_PLAT_HeapMallocCurrentSize() );
+}
+
+/**
+ * @brief  Create the Endpoints then allocate and register the Clusters described in two tables (const, in flash).
+ *         The heap used by each Cluster is displayed.
+ * @param  pstEndpoints   Endpoints to create
+ * @param  cEndpointNb    Number of Endpoints
+ * @param  pstClusters    Clusters to allocate, each one on a described Endpoint
+ * @param  cClusterNb     Number of Clusters
+ * @retval Total heap (in bytes) used by the Clusters.
+ */
+uint32_t APP_ZIGBEE_ConfigEndpointTable( const APP_ZIGBEE_EndpointDesc_t * pstEndpoints, uint8_t cEndpointNb,
+                                         const APP_ZIGBEE_ClusterDesc_t * pstClusters, uint8_t cClusterNb )
+{
+  struct ZbApsmeAddEndpointReqT   stRequest;
+  struct ZbApsmeAddEndpointConfT  stConfig;
+  struct ZbZclClusterT            * pstCluster;
+  const APP_ZIGBEE_ClusterDesc_t  * pstDesc;
+  uint32_t                        lHeapSize, lHeapCost, lHeapTotal = 0u;
+  uint8_t                         cIndex;
+
+  /* Add Endpoints */
+  for ( cIndex = 0u; cIndex < cEndpointNb; cIndex++ )
+  {
+    memset( &stRequest, 0, sizeof( stRequest ) );
+    memset( &stConfig, 0, sizeof( stConfig ) );
+
+    stRequest.profileId = pstEndpoints[cIndex].iProfileId;
+    stRequest.deviceId = pstEndpoints[cIndex].iDeviceId;
+    stRequest.endpoint = pstEndpoints[cIndex].cEndpoint;
+    ZbZclAddEndpoint( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfig );
+    assert( stConfig.status == ZB_STATUS_SUCCESS );
+  }
+
+  /* Add Clusters */
+  for ( cIndex = 0u; cIndex < cClusterNb; cIndex++ )
+  {
+    pstDesc = &pstClusters[cIndex];
+    assert( pstDesc->cClusterIndex < CLUSTER_NB_MAX );
+
+    lHeapSize = APP_ZIGBEE_HeapCurrentSize();
+    pstCluster = pstDesc->pfAlloc( stZigbeeAppInfo.pstZigbee, pstDesc->cEndpoint );
+    assert( pstCluster != NULL );
+    ZbZclClusterEndpointRegister( pstCluster );
+    lHeapCost = ( APP_ZIGBEE_HeapCurrentSize() - lHeapSize );
+
+    stZigbeeAppInfo.pstZbCluster[pstDesc->cClusterIndex] = pstCluster;
+    lHeapTotal += lHeapCost;
+    LOG_INFO_APP( "%s on Endpoint %d : %d bytes of heap.", pstDesc->szName, pstDesc->cEndpoint, lHeapCost );
+  }
+
+  LOG_INFO_APP( "%d Endpoint(s), %d Cluster(s) : %d bytes of heap.", cEndpointNb, cClusterNb, lHeapTotal );
+
+  return lHeapTotal;
+}
+
 /**
  * @brief  Initialize Zigbee stack layers
  * @param  None
@@ -173,15 +350,22 @@ void APP_ZIGBEE_StackLayersInit( void )
   /* Initialise Zigbee */
   stZigbeeAppInfo.pstZigbee = ZbInit( 0U, NULL, NULL );
   assert(stZigbeeAppInfo.pstZigbee != NULL);
+  APPE_BOOT_Mark( APPE_BOOT_ZIGBEE_INIT );
 
   /* Configure Zigbee Logging with log Error/Warning/Info/Debug */
+#if LOG_IS_COMPILED( ZIGBEE, INFO )
   ZbSetLogging( stZigbeeAppInfo.pstZigbee, ZIGBEE_CONFIG_LOG_LEVEL, APP_ZIGBEE_Printf );
+#else /* LOG_IS_COMPILED( ZIGBEE, INFO ) */
+  /* Zigbee logs are compiled out, the stack has no log to build */
+  ZbSetLogging( stZigbeeAppInfo.pstZigbee, 0u, APP_ZIGBEE_Printf );
+#endif /* LOG_IS_COMPILED( ZIGBEE, INFO ) */
 
   /* Configure Application Basic Server */
   APP_ZIGBEE_ConfigBasicServer();
 
   /* Create the endpoint and cluster(s) */
   APP_ZIGBEE_ConfigEndpoints();
+  APPE_BOOT_Mark( APPE_BOOT_ENDPOINTS );
 
   /* USER CODE BEGIN APP_ZIGBEE_StackLayersInit1 */
   /* All Led Off at startup */
@@ -194,6 +378,8 @@ void APP_ZIGBEE_StackLayersInit( void )
   /* Configure the joining parameters */
   stZigbeeAppInfo.eJoinStatus = (enum ZbStatusCodeT) 0x01;  /* init to error status */
   stZigbeeAppInfo.lJoinDelay = HAL_GetTick();               /* now */
+  memset( &stZigbeeAppInfo.stJoinStats, 0, sizeof( stZigbeeAppInfo.stJoinStats ) );
+  memset( &stZigbeeAppInfo.stAdmissionStats, 0, sizeof( stZigbeeAppInfo.stAdmissionStats ) );
 
   /* Initialization Complete */
   stZigbeeAppInfo.bHasInit = true;
@@ -202,7 +388,33 @@ void APP_ZIGBEE_StackLayersInit( void )
   APP_ZIGBEE_PrintApplicationInfo();
 
   if ( stZigbeeAppInfo.bPersistNotification != false )
-    { APP_ZIGBEE_PersistenceStartup(); }
+  {
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+    /* Task saving the persistence data, set after the notifications of the stack */
+    UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSISTENCE ), UTIL_SEQ_RFU, APP_ZIGBEE_PersistenceTask );
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+    APP_ZIGBEE_PersistenceStartup();
+  }
+
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+  /* Task deriving in background the link keys of the queued Install Codes */
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_INSTALL_CODE ), UTIL_SEQ_RFU, APP_ZIGBEE_InstallCodeTask );
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+  /* Timer and Task opening again the Permit Join at the end of a deferral */
+  UTIL_TIMER_Create( &stJoinAdmissionTimer, CFG_ZIGBEE_JOIN_ADMISSION_WINDOW, UTIL_TIMER_ONESHOT, &APP_ZIGBEE_JoinAdmissionElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_JOIN_ADMISSION ), UTIL_SEQ_RFU, APP_ZIGBEE_JoinAdmissionTask );
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+  /* Timer and Task tuning periodically the Concentrator parameters */
+  memset( &stZigbeeAppInfo.stConcentratorInfo, 0, sizeof( stZigbeeAppInfo.stConcentratorInfo ) );
+  UTIL_TIMER_Create( &stConcentratorTimer, CFG_ZIGBEE_CONCENTRATOR_PERIOD, UTIL_TIMER_PERIODIC, &APP_ZIGBEE_ConcentratorElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CONCENTRATOR ), UTIL_SEQ_RFU, APP_ZIGBEE_ConcentratorTask );
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+
+  /* Timer and Task adapting the broadcast parameters to the load */
+  APP_ZIGBEE_BroadcastInit();
 
   if ( stZigbeeAppInfo.bNwkStartup != false )
   {
@@ -238,7 +450,7 @@ static void APP_ZIGBEE_NwkFormWaitElapsed( void * arg )
     UTIL_TIMER_Stop( &stNwkFormWaitJoinTimer );
   }
 
-  UTIL_SEQ_SetTask( 1U << CFG_TASK_ZIGBEE_NETWORK_FORM, TASK_PRIO_ZIGBEE_NETWORK_FORM );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM );
 }
 
 /**
@@ -275,57 +487,343 @@ static void APP_ZIGBEE_NwkFormWaitJoinElapsed( void  * arg )
  */
 void APP_ZIGBEE_NwkFormOrJoin(void)
 {
-  struct ZbStartupT   stConfig;
+  enum ZbStatusCodeT  eStatus;
+  bool                bWarmStart = false;
 
-  if ( stZigbeeAppInfo.eJoinStatus != ZB_STATUS_SUCCESS )
+  switch ( eNwkFormState )
   {
-    /* Application configure Startup */
-    APP_ZIGBEE_GetStartupConfig( &stConfig );
+    case APP_ZIGBEE_NWK_FORM_IDLE :
+        APPE_BOOT_Mark( APPE_BOOT_STARTUP_BEGIN );
+        lNwkFormStartTick = HAL_GetTick();
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+        /* Restart from the persistence data when some were saved : no scan and no new join */
+        if ( ( stZigbeeAppInfo.bPersistNotification != false ) && ( APP_ZIGBEE_PersistenceLoad() != false ) )
+        {
+          LOG_INFO_APP( "Restart from the persistence data (%d bytes).", stPersistImage.lSize );
+          eStatus = ZbStartupPersistWait( stZigbeeAppInfo.pstZigbee );
+          if ( eStatus == ZB_STATUS_SUCCESS )
+          {
+            eNwkFormState = APP_ZIGBEE_NWK_FORM_PERSIST_ONGOING;
+            return;
+          }
+
+          LOG_INFO_APP( "Restart from the persistence data failed (0x%02X), Startup from scratch.", eStatus );
+          stPersistImage.lSize = 0;
+        }
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+        /* fall through */
+
+    case APP_ZIGBEE_NWK_FORM_RETRY_WAIT :
+        /* Join when the last channel is not tried alone : first rank the channels with a quick active scan */
+        if ( ( stZigbeeAppInfo.eStartupControl == ZbStartTypeJoin ) && ( bJoinLastChannelFirst == false ) )
+        {
+          if ( APP_ZIGBEE_ChannelScanStart() == ZB_STATUS_SUCCESS )
+          {
+            eNwkFormState = APP_ZIGBEE_NWK_FORM_SCAN_ONGOING;
+            return;
+          }
+        }
+        /* fall through */
+
+    case APP_ZIGBEE_NWK_FORM_SCAN_ONGOING :
+        /* Application configure Startup */
+        APP_ZIGBEE_GetStartupConfig( &stZbStartupConfig );
+
+        /* Using ZbStartupWait (non blocking), the Task is set again by ZbStartupWaitCallback at the end of the Startup */
+        stZigbeeAppInfo.stJoinStats.lAttempts++;
+        eStatus = ZbStartupWait( stZigbeeAppInfo.pstZigbee, &stZbStartupConfig );
+        if ( eStatus == ZB_STATUS_SUCCESS )
+        {
+          eNwkFormState = APP_ZIGBEE_NWK_FORM_STARTUP_ONGOING;
+          return;
+        }
+        break;
 
-    /* Using ZbStartupWait (blocking) */
-    stZigbeeAppInfo.eJoinStatus = ZbStartupWait( stZigbeeAppInfo.pstZigbee, &stConfig );
+    case APP_ZIGBEE_NWK_FORM_STARTUP_ONGOING :
+        /* Startup ended */
+        eStatus = ZbStartupWaitEnd();
+        break;
 
-    if ( stZigbeeAppInfo.eJoinStatus == ZB_STATUS_SUCCESS )
-    {
-      stZigbeeAppInfo.lJoinDelay = 0u;
-      stZigbeeAppInfo.bInitAfterJoin = true;
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+    case APP_ZIGBEE_NWK_FORM_PERSIST_ONGOING :
+        /* Startup from the persistence data ended */
+        eStatus = ZbStartupWaitEnd();
+        if ( eStatus != ZB_STATUS_SUCCESS )
+        {
+          LOG_INFO_APP( "Restart from the persistence data failed (0x%02X), Startup from scratch.", eStatus );
+          stPersistImage.lSize = 0;
+
+          /* Reset ZigBee data to be sure that start with good data, then start again without delay */
+          ZbReset( stZigbeeAppInfo.pstZigbee );
+          eNwkFormState = APP_ZIGBEE_NWK_FORM_RETRY_WAIT;
+          UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM );
+          return;
+        }
+        bWarmStart = true;
+        break;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+    case APP_ZIGBEE_NWK_FORM_DONE :
+    default :
+        /* Nothing more to do */
+        return;
+  }
+
+  stZigbeeAppInfo.eJoinStatus = eStatus;
+  stZigbeeAppInfo.stJoinStats.eLastStatus = eStatus;
+  if ( stZigbeeAppInfo.eJoinStatus == ZB_STATUS_SUCCESS )
+  {
+    eNwkFormState = APP_ZIGBEE_NWK_FORM_DONE;
+    stZigbeeAppInfo.lJoinDelay = 0u;
+    APPE_BOOT_Mark( APPE_BOOT_STARTUP_END );
+    stZigbeeAppInfo.stJoinStats.lLastJoinTime = ( HAL_GetTick() - lNwkFormStartTick );
+    stZigbeeAppInfo.bInitAfterJoin = true;
 
-      /* USER CODE BEGIN APP_ZIGBEE_NwkFormOrJoin */
-      APP_LED_ON( LED_BLUE );
+    /* USER CODE BEGIN APP_ZIGBEE_NwkFormOrJoin */
+    APP_LED_ON( LED_BLUE );
 
-      /* USER CODE END APP_ZIGBEE_NwkFormOrJoin */
+    /* USER CODE END APP_ZIGBEE_NwkFormOrJoin */
+    if ( bWarmStart != false )
+    {
+      LOG_INFO_APP( "Network restored from the persistence data." );
+    }
+    else
+    {
       if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeForm )
         { LOG_INFO_APP( "Mesh network created." ); }
       else
         { LOG_INFO_APP( "Association accepted." ); }
+      LOG_INFO_APP( "Startup succeeded after %d tentative(s).", stZigbeeAppInfo.stJoinStats.lConsecutiveFailures + 1u );
+
+      /* Save at once the new network parameters */
+      if ( stZigbeeAppInfo.bPersistNotification != false )
+        { (void)APP_ZIGBEE_PersistenceSave(); }
     }
-    else
+
+    /* Channel to try first at the next Join */
+    (void)APP_ZIGBEE_GetCurrentChannel( &stZigbeeAppInfo.cLastChannel );
+    bJoinLastChannelFirst = true;
+    LOG_INFO_APP( "Channel used : %d.", stZigbeeAppInfo.cLastChannel );
+
+    stZigbeeAppInfo.stJoinStats.lConsecutiveFailures = 0;
+    APP_ZIGBEE_ConfigMeshNetwork();
+    APP_ZIGBEE_ApplicationStart();
+  }
+  else
+  {
+    eNwkFormState = APP_ZIGBEE_NWK_FORM_RETRY_WAIT;
+
+    stZigbeeAppInfo.stJoinStats.lFailures++;
+    stZigbeeAppInfo.stJoinStats.lConsecutiveFailures++;
+    if ( stZigbeeAppInfo.stJoinStats.lConsecutiveFailures > stZigbeeAppInfo.stJoinStats.lMaxConsecutiveFailures )
+    {
+      stZigbeeAppInfo.stJoinStats.lMaxConsecutiveFailures = stZigbeeAppInfo.stJoinStats.lConsecutiveFailures;
+    }
+    stZigbeeAppInfo.stJoinStats.lLastRetryDelay = APP_ZIGBEE_GetStartupRetryDelay( stZigbeeAppInfo.stJoinStats.lConsecutiveFailures );
+
+    LOG_INFO_APP( "Startup Wait Callback Status : 0x%02X", stZigbeeAppInfo.eJoinStatus );
+    LOG_INFO_APP( "Startup failed (%d consecutive), attempting again after %d ms", stZigbeeAppInfo.stJoinStats.lConsecutiveFailures,
+                  stZigbeeAppInfo.stJoinStats.lLastRetryDelay );
+
+    if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeJoin )
+    {
+      /* Reset ZigBee data to be sure that start with good data */
+      ZbReset( stZigbeeAppInfo.pstZigbee );
+    }
+
+    /* Reschedule the current task to retry the process */
+    stZigbeeAppInfo.lJoinDelay = HAL_GetTick() + stZigbeeAppInfo.stJoinStats.lLastRetryDelay;
+    UTIL_TIMER_StartWithPeriod( &stNwkFormWaitTimer, stZigbeeAppInfo.stJoinStats.lLastRetryDelay );
+  }
+}
+
+/**
+ * @brief  Launch a quick active scan on the channel mask, to rank the channels before a Join. The 'NwkFormOrJoin'
+ *         Task is set again by the scan callback.
+ * @param  None
+ * @retval ZB_STATUS_SUCCESS if the scan is launched.
+ */
+static enum ZbStatusCodeT APP_ZIGBEE_ChannelScanStart( void )
+{
+  enum ZbStatusCodeT        eStatus;
+  struct ZbNlmeNetDiscReqT  stRequest;
+
+  cJoinChannelRankNb = 0;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.scanChannels.count = 1;
+  stRequest.scanChannels.list[0].page = 0;
+  stRequest.scanChannels.list[0].channelMask = stZigbeeAppInfo.lChannelMask;
+  stRequest.scanDuration = APP_ZIGBEE_SCAN_DURATION;
+  stRequest.scanType = ZB_SCAN_TYPE_ACTIVE;
+
+  eStatus = ZbNlmeNetDiscReq( stZigbeeAppInfo.pstZigbee, &stRequest, APP_ZIGBEE_ChannelScanCallback, NULL );
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    LOG_INFO_APP( "Channel scan not launched (0x%02X), Join on all the channels.", eStatus );
+  }
+
+  return eStatus;
+}
+
+/**
+ * @brief  End of the active scan : rank the channels and set again the 'NwkFormOrJoin' Task
+ * @param  pstConfig  NLME-NETWORK-DISCOVERY.confirm
+ * @param  arg        Not used
+ * @retval None
+ */
+static void APP_ZIGBEE_ChannelScanCallback( struct ZbNlmeNetDiscConfT * pstConfig, void * arg )
+{
+  if ( pstConfig->status == ZB_STATUS_SUCCESS )
+  {
+    APP_ZIGBEE_ChannelRank();
+  }
+  else
+  {
+    LOG_INFO_APP( "Channel scan failed (0x%02X), Join on all the channels.", pstConfig->status );
+  }
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM );
+}
+
+/**
+ * @brief  Rank the channels from the discovered networks : a network that permits the Join first, then the best
+ *         link quality.
+ * @param  None
+ * @retval None
+ */
+static void APP_ZIGBEE_ChannelRank( void )
+{
+  uint32_t                    lIndex;
+  uint16_t                    iScore, aiScore[WPAN_PAGE_CHANNELS_MAX];
+  uint8_t                     cChannel, cBest;
+  struct ZbNwkDiscoveryInfoT  stDiscovery;
+
+  memset( aiScore, 0, sizeof( aiScore ) );
+  for ( lIndex = 0; lIndex < APP_ZIGBEE_SCAN_NETWORK_MAX; lIndex++ )
+  {
+    if ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_DiscoveryTable, &stDiscovery, sizeof( stDiscovery ), lIndex ) != ZB_STATUS_SUCCESS )
+    {
+      break;
+    }
+
+    if ( ( stDiscovery.logicalChannel >= WPAN_PAGE_CHANNELS_MAX ) || ( ( stZigbeeAppInfo.lChannelMask & ( 1u << stDiscovery.logicalChannel ) ) == 0u ) )
     {
-      LOG_INFO_APP( "Startup Wait Callback Status : 0x%02X", stZigbeeAppInfo.eJoinStatus );
-      LOG_INFO_APP( "Startup failed, attempting again after a short delay (%d ms)", APP_ZIGBEE_STARTUP_FAIL_DELAY );
+      continue;
+    }
+
+    iScore = ( ( stDiscovery.permitJoin != false ) ? 0x200u : 0x100u ) | stDiscovery.lqi;
+    if ( iScore > aiScore[stDiscovery.logicalChannel] )
+    {
+      aiScore[stDiscovery.logicalChannel] = iScore;
+    }
+  }
 
-      if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeJoin )
+  /* Channels with a network, by decreasing score */
+  cJoinChannelRankNb = 0;
+  while ( cJoinChannelRankNb < sizeof( acJoinChannelRank ) )
+  {
+    cBest = 0;
+    for ( cChannel = 1; cChannel < WPAN_PAGE_CHANNELS_MAX; cChannel++ )
+    {
+      if ( aiScore[cChannel] > aiScore[cBest] )
       {
-        /* Reset ZigBee data to be sure that start with good data */
-        ZbReset( stZigbeeAppInfo.pstZigbee );
+        cBest = cChannel;
       }
+    }
 
-      stZigbeeAppInfo.lJoinDelay = HAL_GetTick() + APP_ZIGBEE_STARTUP_FAIL_DELAY;
+    if ( aiScore[cBest] == 0u )
+    {
+      break;
     }
+
+    acJoinChannelRank[cJoinChannelRankNb++] = cBest;
+    aiScore[cBest] = 0;
   }
 
-  /* If Network forming/joining was not successful reschedule the current task to retry the process */
-  if ( stZigbeeAppInfo.eJoinStatus != ZB_STATUS_SUCCESS )
+  LOG_INFO_APP( "Channel scan : %d channel(s) with a network (%d networks).", cJoinChannelRankNb, lIndex );
+}
+
+/**
+ * @brief  Fill the list of channels for a Join : the last successful channel alone at the first tentative, else the
+ *         channels ranked by the last scan, then the remaining channels of the mask together.
+ * @param  pstChannelList  List of channels to fill
+ * @retval None
+ */
+void APP_ZIGBEE_GetJoinChannelList( struct ZbChannelListT * pstChannelList )
+{
+  uint32_t  lRemainingMask = stZigbeeAppInfo.lChannelMask;
+  uint32_t  lChannelMask;
+  uint8_t   cIndex;
+
+  memset( pstChannelList, 0, sizeof( struct ZbChannelListT ) );
+
+  /* Last successful channel alone : fastest Join when the network has not moved */
+  if ( bJoinLastChannelFirst != false )
   {
-    UTIL_TIMER_Start( &stNwkFormWaitTimer );
+    bJoinLastChannelFirst = false;
+    if ( stZigbeeAppInfo.cLastChannel < WPAN_PAGE_CHANNELS_MAX )
+    {
+      lChannelMask = ( 1u << stZigbeeAppInfo.cLastChannel );
+      if ( ( lRemainingMask & lChannelMask ) != 0u )
+      {
+        pstChannelList->count = 1;
+        pstChannelList->list[0].page = 0;
+        pstChannelList->list[0].channelMask = lChannelMask;
+        return;
+      }
+    }
   }
-  else
+
+  for ( cIndex = 0; cIndex < cJoinChannelRankNb; cIndex++ )
   {
-    APP_ZIGBEE_ConfigMeshNetwork();
-    APP_ZIGBEE_ApplicationStart();
+    lChannelMask = ( 1u << acJoinChannelRank[cIndex] );
+    if ( ( lRemainingMask & lChannelMask ) != 0u )
+    {
+      pstChannelList->list[pstChannelList->count].page = 0;
+      pstChannelList->list[pstChannelList->count].channelMask = lChannelMask;
+      pstChannelList->count++;
+      lRemainingMask &= ~lChannelMask;
+    }
+  }
+
+  if ( lRemainingMask != 0u )
+  {
+    pstChannelList->list[pstChannelList->count].page = 0;
+    pstChannelList->list[pstChannelList->count].channelMask = lRemainingMask;
+    pstChannelList->count++;
   }
 }
 
+/**
+ * @brief  Compute the time before the next 'Join' tentative : exponential backoff, from a short first delay up to a
+ *         maximum, of which a part is random so that the devices restarted together do not retry in lockstep.
+ * @param  lConsecutiveFailures : Number of consecutive failed tentatives (1 for the first failure)
+ * @retval Delay in ms
+ */
+static uint32_t APP_ZIGBEE_GetStartupRetryDelay( uint32_t lConsecutiveFailures )
+{
+  uint32_t  lDelay = APP_ZIGBEE_STARTUP_FAIL_DELAY;
+  uint32_t  lJitter, lRandom;
+
+  while ( ( lConsecutiveFailures > 1u ) && ( lDelay < APP_ZIGBEE_STARTUP_FAIL_DELAY_MAX ) )
+  {
+    lDelay <<= 1u;
+    lConsecutiveFailures--;
+  }
+
+  if ( lDelay > APP_ZIGBEE_STARTUP_FAIL_DELAY_MAX )
+  {
+    lDelay = APP_ZIGBEE_STARTUP_FAIL_DELAY_MAX;
+  }
+
+  /* Delay taken in [ Delay - Jitter ; Delay ] */
+  lJitter = ( lDelay * APP_ZIGBEE_STARTUP_FAIL_JITTER ) / 100u;
+  ZIGBEE_PLAT_RngGet( sizeof( lRandom ), (uint8_t *)&lRandom );
+
+  return ( lDelay - lJitter + ( lRandom % ( lJitter + 1u ) ) );
+}
+
 /**
  * @brief  Handle Zigbee network forming and joining
  * @param  None
@@ -334,24 +832,41 @@ void APP_ZIGBEE_NwkFormOrJoin(void)
 static void APP_ZIGBEE_ConfigMeshNetwork(void)
 {
   bool      bReturn;
-  uint32_t  lBroadcastTimeOut = 3;
 
   stZigbeeAppInfo.bInitAfterJoin = false;
 
   /* Assign ourselves to the group addresses */
   bReturn = APP_ZIGBEE_ConfigGroupAddr();
 
-  /* If we're using group addressing (broadcast), shorten the broadcast timeout */
+  /* If we're using group addressing (broadcast), shorten the broadcast timeout, then adapt it to the load */
   if ( bReturn != false )
   {
-    ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NetworkBroadcastDeliveryTime, &lBroadcastTimeOut, sizeof( lBroadcastTimeOut ) );
+    APP_ZIGBEE_BroadcastStart();
   }
 
   /* If Coord or Router, start the possibility to know where a 'Device' (End Device ou Router) Join the Network */
   if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeForm )
   {
     ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ZB_MSG_FILTER_JOIN_IND, ZB_MSG_DEFAULT_PRIO, APP_ZIGBEE_DeviceJointCallback, NULL );
+
+    /* Trust Center : device keys found through their EUI64 index, TC link keys derived from the EUI64 */
+    APP_ZIGBEE_TcKeyStart();
+    APP_ZIGBEE_HashKeyStart();
+  }
+
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+  /* Coord and Router : pace the Joins on this device, before the other Application filters */
+  if ( pstJoinAdmissionFilter == NULL )
+  {
+    pstJoinAdmissionFilter = ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ZB_MSG_FILTER_JOIN_IND, ( ZB_MSG_DEFAULT_PRIO + 1u ),
+                                                  APP_ZIGBEE_JoinAdmissionCallback, NULL );
   }
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+  /* Concentrator mode (or not) applied from the Task */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CONCENTRATOR ), TASK_PRIO_ZIGBEE_CONCENTRATOR );
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
 }
 
 /**
@@ -368,10 +883,11 @@ static void ZbStartupWaitCallback( enum ZbStatusCodeT eZbStatus, void * pCallBac
 }
 
 /**
- * @brief ZbStartupWait
+ * @brief ZbStartupWait : launch the Startup and request the 'NwkFormOrJoin' Task to be set again when it ends,
+ *        without waiting on the stack (see ZbStartupWaitEnd).
  * @param  zb : Zigbee stack handler
- * @param  config : Configuration parameter used to form or join the network
- * @retval None
+ * @param  config : Configuration parameter used to form or join the network. Shall remain valid until the end of the Startup.
+ * @retval Status of the Startup request
  */
 static enum ZbStatusCodeT ZbStartupWait( struct ZigBeeT * pstZigbee, struct ZbStartupT * pstConfig )
 {
@@ -386,15 +902,54 @@ static enum ZbStatusCodeT ZbStartupWait( struct ZigBeeT * pstZigbee, struct ZbSt
     UTIL_TIMER_Start( &stNwkFormWaitJoinTimer );
   }
 
+  UTIL_SEQ_ClrEvt( EVENT_ZIGBEE_STARTUP_ENDED );
   eZbStatus = ZbStartup( pstZigbee, pstConfig, ZbStartupWaitCallback, NULL );
   if ( eZbStatus != ZB_STATUS_SUCCESS )
   {
     return eZbStatus;
   }
 
-  /* Wait ZB Join finished */
-  UTIL_SEQ_WaitEvt( EVENT_ZIGBEE_STARTUP_ENDED );
+  /* ZB Join finished will set again the 'NwkFormOrJoin' Task */
+  UTIL_SEQ_SetTaskOnEvt( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM, EVENT_ZIGBEE_STARTUP_ENDED );
+
+  return eZbStatus;
+}
+
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
+/**
+ * @brief ZbStartupPersistWait : launch the Startup from the persistence image and request the 'NwkFormOrJoin' Task
+ *        to be set again when it ends, without waiting on the stack (see ZbStartupWaitEnd).
+ * @param  zb : Zigbee stack handler
+ * @retval Status of the Startup request
+ */
+static enum ZbStatusCodeT ZbStartupPersistWait( struct ZigBeeT * pstZigbee )
+{
+  enum ZbStatusCodeT  eZbStatus;
+
+  /* Variable also used by ZbStartupWaitCallback */
+  eZbStartupWaitStatus = ZB_STATUS_SUCCESS;
+
+  UTIL_SEQ_ClrEvt( EVENT_ZIGBEE_STARTUP_ENDED );
+  eZbStatus = ZbStartupPersist( pstZigbee, stPersistImage.cData, stPersistImage.lSize, NULL, ZbStartupWaitCallback, NULL );
+  if ( eZbStatus != ZB_STATUS_SUCCESS )
+  {
+    return eZbStatus;
+  }
+
+  /* ZB Startup finished will set again the 'NwkFormOrJoin' Task */
+  UTIL_SEQ_SetTaskOnEvt( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_NETWORK_FORM ), TASK_PRIO_ZIGBEE_NETWORK_FORM, EVENT_ZIGBEE_STARTUP_ENDED );
 
+  return eZbStatus;
+}
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+/**
+ * @brief ZbStartupWaitEnd : to be called when the Startup launched by ZbStartupWait has ended
+ * @param  None
+ * @retval Status of the Startup
+ */
+static enum ZbStatusCodeT ZbStartupWaitEnd( void )
+{
   /* Stop Timer that can advertise user during 'Join' waiting time */
   if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeJoin )
   {
@@ -408,124 +963,670 @@ static enum ZbStatusCodeT ZbStartupWait( struct ZigBeeT * pstZigbee, struct ZbSt
   return eZbStartupWaitStatus;
 }
 
+#if (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0)
 /**
- * @brief Callback called every time a new Device (Router ou EndDevice) join the Network.
- *        Information around the Device (Address & Capability) are sent on 'APP_ZIGBEE_NewDevice()' function.
- * @param zb        Zigbee stack handler
- * @param lId       Type of filter Message
- * @param pMessage  Pointer on Message information
- * @param arg       Pointer on User Argument.
+ * @brief  Register the persistence image to the Simple NVM Arbiter or to the Simple NVM Log (once)
+ * @param  None
+ * @retval True if the image is registered, else false.
  */
-static enum zb_msg_filter_rc APP_ZIGBEE_DeviceJointCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+static bool APP_ZIGBEE_PersistenceRegister( void )
 {
-  struct ZbNlmeJoinIndT * pstJoinMessage;
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  SNVML_Cmd_Status_t  eStatus;
 
-  if ( lId == ZB_MSG_FILTER_JOIN_IND )
+  if ( bPersistRegistered == false )
   {
-    pstJoinMessage = ( struct ZbNlmeJoinIndT * )pMessage;
+    eStatus = SNVML_Register( (uint32_t *)&stPersistImage, ( sizeof( stPersistImage ) / sizeof( uint32_t ) ) );
+    if ( eStatus != SNVML_ERROR_OK )
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  SNVMA_Cmd_Status_t  eStatus;
 
-    switch ( pstJoinMessage->rejoinNetwork )
+  if ( bPersistRegistered == false )
+  {
+    eStatus = SNVMA_Register( APP_ZIGBEE_NvmBuffer, (uint32_t *)&stPersistImage, ( sizeof( stPersistImage ) / sizeof( uint32_t ) ) );
+    if ( eStatus != SNVMA_ERROR_OK )
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
     {
-      case ZB_NWK_REJOIN_TYPE_ASSOC :
-      case ZB_NWK_REJOIN_TYPE_ORPHAN :
-      case ZB_NWK_REJOIN_TYPE_NWKREJOIN :
-      case ZB_NWK_REJOIN_TYPE_NWKCOMMISS_JOIN :
-      case ZB_NWK_REJOIN_TYPE_NWKCOMMISS_REJOIN :
-          /* A new Device has Join Network at MAC/NWK level */
-          APP_ZIGBEE_SetNewDevice( pstJoinMessage->nwkAddr, pstJoinMessage->extAddr, pstJoinMessage->capabilityInfo );
-          break;
-
-      default :
-          break;
+      LOG_ERROR_APP( "Error, Persistence NVM registration failed (%d)", eStatus );
+    }
+    else
+    {
+      bPersistRegistered = true;
     }
   }
 
-  return( ZB_MSG_CONTINUE );
+  return bPersistRegistered;
 }
 
-/*************************************************************
- *
- * GENERIC FUNCTIONS
- *
- *************************************************************/
-
 /**
- * @brief  Callback that indicate if a 'Permit to Join' the network can be done
+ * @brief  Read the persistence image saved in NVM
  * @param  None
- * @retval None
+ * @retval True if a valid image is available, else false.
  */
-static void APP_ZIGBEE_ZbZdoPermitJoinReqCallback( struct ZbZdoPermitJoinRspT * pstJoinResponse, void * arg )
+static bool APP_ZIGBEE_PersistenceLoad( void )
 {
-  UNUSED( arg );
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  SNVML_Cmd_Status_t  eStatus;
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  SNVMA_Cmd_Status_t  eStatus;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
 
-  if ( pstJoinResponse->status != ZB_STATUS_SUCCESS )
+  if ( APP_ZIGBEE_PersistenceRegister() == false )
   {
-    LOG_ERROR_APP( "Error, cannot set Permit Join duration (%d)", pstJoinResponse->status );
+    return false;
   }
-  else
+
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  eStatus = SNVML_Restore();
+  if ( eStatus != SNVML_ERROR_OK )
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  eStatus = SNVMA_Restore( APP_ZIGBEE_NvmBuffer );
+  if ( eStatus != SNVMA_ERROR_OK )
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
   {
-    LOG_INFO_APP( "Permit Join duration successfully changed." );
+    LOG_INFO_APP( "No persistence data available (%d).", eStatus );
+    return false;
+  }
+
+  if ( ( stPersistImage.lMagic != APP_ZIGBEE_PERSIST_MAGIC ) || ( stPersistImage.lSize == 0u ) || ( stPersistImage.lSize > sizeof( stPersistImage.cData ) ) )
+  {
+    LOG_INFO_APP( "Persistence data not valid." );
+    return false;
   }
+
+  /* Content of the NVM, no need to write it again */
+  lPersistHash = APP_ZIGBEE_PersistenceHash( stPersistImage.cData, stPersistImage.lSize );
+
+  return true;
 }
 
 /**
- * @brief  Send the request to NWK layer a Permit to Join the network
- * @param  cPermitJoinDelay   Delay in second during the new Permit to Join is available
- * @retval None
+ * @brief  Hash (FNV-1a) of the persistence data, to detect that they have not changed since the last write
+ * @param  pData : Persistence data
+ * @param  lSize : Size of the persistence data
+ * @retval Hash value
  */
-void APP_ZIGBEE_PermitJoin( uint8_t cPermitJoinDelay )
+static uint32_t APP_ZIGBEE_PersistenceHash( const uint8_t * pData, uint32_t lSize )
 {
-  struct ZbZdoPermitJoinReqT  stJoinRequest;
-  enum ZbStatusCodeT          eStatus;
+  uint32_t  lHash = APP_ZIGBEE_PERSIST_HASH_INIT;
 
-  memset( &stJoinRequest, 0, sizeof( stJoinRequest ) );
-  stJoinRequest.destAddr = ZB_NWK_ADDR_UNDEFINED;
-  stJoinRequest.tcSignificance = true;
-  stJoinRequest.duration = cPermitJoinDelay;
-
-  LOG_INFO_APP( "Send command Permit Join during %ds", cPermitJoinDelay );
-  eStatus = ZbZdoPermitJoinReq( stZigbeeAppInfo.pstZigbee, &stJoinRequest, APP_ZIGBEE_ZbZdoPermitJoinReqCallback, NULL);
-  if ( eStatus != ZB_STATUS_SUCCESS )
+  while ( lSize > 0u )
   {
-    LOG_ERROR_APP( "Error during command Permit Join (%d)", eStatus );
+    lHash = ( lHash ^ *pData ) * APP_ZIGBEE_PERSIST_HASH_PRIME;
+    pData++;
+    lSize--;
   }
+
+  return lHash;
 }
 
 /**
- * @brief  Indicate if Application as already join the network
+ * @brief  To be called at each persistence notification of the stack. The persistence data is saved once the
+ *         notifications stop for CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY, without waiting more than
+ *         CFG_ZIGBEE_PERSISTENCE_MAX_DELAY since the first one.
  * @param  None
- * @retval True if Join OK, else False
+ * @retval None
  */
-bool APP_ZIGBEE_IsAppliJoinNetwork( void )
+void APP_ZIGBEE_PersistenceNotify( void )
 {
-  bool                bJoinOk = false;
-  uint64_t            dlEpid = 0U;
-  enum ZbStatusCodeT  eZbStatus;
+  uint32_t  lNow = HAL_GetTick();
 
-  if ( stZigbeeAppInfo.pstZigbee != NULL )
+  /* Saved with the batch of attribute changes in progress */
+  if ( APP_ZIGBEE_BatchMergeNotify() != false )
   {
-    /* Check if the router joined the network, and if the waiting time after the Join is finished */
-    eZbStatus = ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_ExtendedPanId, &dlEpid, sizeof( dlEpid ) );
-    if ( ( eZbStatus == ZB_STATUS_SUCCESS) && ( dlEpid != 0u ) && ( stZigbeeAppInfo.eJoinStatus == ZB_STATUS_SUCCESS ) )
-      { bJoinOk = true; }
+    return;
   }
 
-  return( bJoinOk );
+  if ( bPersistDelayed == false )
+  {
+    bPersistDelayed = true;
+    lPersistFirstNotifyTick = lNow;
+  }
+  else if ( ( lNow - lPersistFirstNotifyTick ) >= ( CFG_ZIGBEE_PERSISTENCE_MAX_DELAY - CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY ) )
+  {
+    /* Save already planned, not postponed any more */
+    return;
+  }
+
+  /* A new request restarts the delay */
+  if ( UTIL_SEQ_SetTaskDelayed( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSISTENCE ), TASK_PRIO_ZIGBEE_PERSISTENCE, CFG_ZIGBEE_PERSISTENCE_DEBOUNCE_DELAY ) == 0u )
+  {
+    /* No delayed slot available : save without debounce */
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSISTENCE ), TASK_PRIO_ZIGBEE_PERSISTENCE );
+  }
 }
 
 /**
- * @brief   Indicate a Device with Install Code request a Join.
- *          Add the LinkKey (from Install Code) on List and start a Join during 30s.
+ * @brief  Task saving the persistence data once the notifications of the stack are debounced
+ * @param  None
+ * @retval None
+ */
+static void APP_ZIGBEE_PersistenceTask( void )
+{
+  bPersistDelayed = false;
+
+  (void)APP_ZIGBEE_PersistenceSave();
+}
+
+/**
+ * @brief  Save the stack persistence data in NVM, when they differ from the last saved ones. The write is done
+ *         in background by the Flash Manager; a request received during a write is done once the write has ended.
+ * @param  None
+ * @retval True if the save is requested, else false.
+ */
+bool APP_ZIGBEE_PersistenceSave( void )
+{
+  uint32_t            lSize, lHash;
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  SNVML_Cmd_Status_t  eStatus;
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  SNVMA_Cmd_Status_t  eStatus;
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+
+  if ( bPersistWriteOnGoing != false )
+  {
+    bPersistSavePending = true;
+    return true;
+  }
+
+  if ( APP_ZIGBEE_PersistenceRegister() == false )
+  {
+    return false;
+  }
+
+  lSize = ZbPersistGet( stZigbeeAppInfo.pstZigbee, stPersistImage.cData, sizeof( stPersistImage.cData ) );
+  if ( ( lSize == 0u ) || ( lSize > sizeof( stPersistImage.cData ) ) )
+  {
+    LOG_ERROR_APP( "Error, Persistence data size not supported (%d bytes)", lSize );
+    return false;
+  }
+
+  /* Same data as the last saved ones : flash not written */
+  lHash = APP_ZIGBEE_PersistenceHash( stPersistImage.cData, lSize );
+  if ( ( lHash == lPersistHash ) && ( lSize == stPersistImage.lSize ) && ( stPersistImage.lMagic == APP_ZIGBEE_PERSIST_MAGIC ) )
+  {
+    stZigbeeAppInfo.lPersistNumUnchanged++;
+    return true;
+  }
+
+  stPersistImage.lMagic = APP_ZIGBEE_PERSIST_MAGIC;
+  stPersistImage.lSize = lSize;
+
+  bPersistWriteOnGoing = true;
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  /* Only the records of the image that have changed are written */
+  eStatus = SNVML_Write( APP_ZIGBEE_PersistenceWriteCallback );
+  if ( eStatus == SNVML_ERROR_UNCHANGED )
+  {
+    bPersistWriteOnGoing = false;
+    lPersistHash = lHash;
+    stZigbeeAppInfo.lPersistNumUnchanged++;
+    return true;
+  }
+  if ( eStatus != SNVML_ERROR_OK )
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  eStatus = SNVMA_Write( APP_ZIGBEE_NvmBuffer, APP_ZIGBEE_PersistenceWriteCallback );
+  if ( eStatus == SNVMA_ERROR_UNCHANGED )
+  {
+    bPersistWriteOnGoing = false;
+    lPersistHash = lHash;
+    stZigbeeAppInfo.lPersistNumUnchanged++;
+    return true;
+  }
+  if ( eStatus != SNVMA_ERROR_OK )
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  {
+    bPersistWriteOnGoing = false;
+    LOG_ERROR_APP( "Error, Persistence NVM write failed (%d)", eStatus );
+    return false;
+  }
+
+  lPersistHash = lHash;
+  stZigbeeAppInfo.lPersistNumWrites++;
+
+  return true;
+}
+
+/**
+ * @brief  Callback called by the Simple NVM Arbiter (or Log) when the write of the persistence image has ended
+ * @param  eStatus : Status of the write
+ * @retval None
+ */
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+static void APP_ZIGBEE_PersistenceWriteCallback( SNVML_Callback_Status_t eStatus )
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+static void APP_ZIGBEE_PersistenceWriteCallback( SNVMA_Callback_Status_t eStatus )
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+{
+  bPersistWriteOnGoing = false;
+
+#if (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0)
+  if ( eStatus != SNVML_OPERATION_COMPLETE )
+#else /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  if ( eStatus != SNVMA_OPERATION_COMPLETE )
+#endif /* (CFG_ZIGBEE_PERSISTENCE_LOG_SUPPORTED != 0) */
+  {
+    /* Written again at the next request */
+    lPersistHash = ~lPersistHash;
+    LOG_ERROR_APP( "Error, Persistence NVM write not completed" );
+  }
+
+  if ( bPersistSavePending != false )
+  {
+    bPersistSavePending = false;
+    (void)APP_ZIGBEE_PersistenceSave();
+  }
+}
+#else /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+/**
+ * @brief  Persistence not supported
+ * @param  None
+ * @retval False.
+ */
+bool APP_ZIGBEE_PersistenceSave( void )
+{
+  return false;
+}
+
+/**
+ * @brief  Persistence not supported
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_PersistenceNotify( void )
+{
+}
+#endif /* (CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+/**
+ * @brief  Join admission : count the Joins per window and, when too many Devices have joined in the current
+ *         window, close the local Permit Join until its end. The refused Devices retry their association later.
+ * @param  zb       Zigbee stack instance
+ * @param  lId      Message filter identifier
+ * @param  pMessage NLME-JOIN.indication
+ * @param  arg      Not used
+ * @retval ZB_MSG_CONTINUE, the Join indication is always given to the other filters.
+ */
+static enum zb_msg_filter_rc APP_ZIGBEE_JoinAdmissionCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  uint32_t                    lNow = HAL_GetTick();
+  struct ZbNlmePermitJoinReqT stPermitReq;
+  struct ZbNlmePermitJoinConfT stPermitConf;
+  APP_ZIGBEE_AdmissionStats_t * pstStats = &stZigbeeAppInfo.stAdmissionStats;
+
+  if ( lId != ZB_MSG_FILTER_JOIN_IND )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  /* New window */
+  if ( ( lNow - lJoinAdmissionWindowTick ) >= CFG_ZIGBEE_JOIN_ADMISSION_WINDOW )
+  {
+    pstStats->lLastWindowJoins = pstStats->lWindowJoins;
+    pstStats->lWindowJoins = 0;
+    lJoinAdmissionWindowTick = lNow;
+  }
+
+  pstStats->lWindowJoins++;
+  pstStats->lTotalJoins++;
+  if ( pstStats->lWindowJoins > pstStats->lMaxWindowJoins )
+  {
+    pstStats->lMaxWindowJoins = pstStats->lWindowJoins;
+  }
+
+  if ( ( pstStats->lWindowJoins >= CFG_ZIGBEE_JOIN_ADMISSION_MAX ) && ( bJoinAdmissionDeferred == false ) )
+  {
+    /* Nothing to defer if the Permit Join is already closed (Rejoins) */
+    cJoinAdmissionDuration = 0;
+    (void)ZbNwkGet( zb, ZB_NWK_NIB_ID_PermitJoinCounter, &cJoinAdmissionDuration, sizeof( cJoinAdmissionDuration ) );
+    if ( cJoinAdmissionDuration != 0u )
+    {
+      memset( &stPermitReq, 0, sizeof( stPermitReq ) );
+      stPermitReq.permitDuration = 0;
+      ZbNlmePermitJoinReq( zb, &stPermitReq, &stPermitConf );
+      if ( stPermitConf.status == ZB_STATUS_SUCCESS )
+      {
+        bJoinAdmissionDeferred = true;
+        lJoinAdmissionCloseTick = lNow;
+        pstStats->lDeferrals++;
+
+        UTIL_TIMER_StartWithPeriod( &stJoinAdmissionTimer, ( CFG_ZIGBEE_JOIN_ADMISSION_WINDOW - ( lNow - lJoinAdmissionWindowTick ) ) );
+        LOG_INFO_APP( "%d Joins in the window, next Joins deferred.", pstStats->lWindowJoins );
+      }
+    }
+  }
+
+  return( ZB_MSG_CONTINUE );
+}
+
+/**
+  * @brief  Callback triggered at the end of the window where the Joins are deferred
+  * @param  arg : Not used
+  * @retval None
+  */
+static void APP_ZIGBEE_JoinAdmissionElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_JOIN_ADMISSION ), TASK_PRIO_ZIGBEE_JOIN_ADMISSION );
+}
+
+/**
+ * @brief  'Join Admission' Task : open again the Permit Join for its remaining time.
+ * @param  None
+ * @retval None
+ */
+static void APP_ZIGBEE_JoinAdmissionTask( void )
+{
+  uint32_t                    lClosedTime, lElapsedSeconds;
+  struct ZbNlmePermitJoinReqT stPermitReq;
+  struct ZbNlmePermitJoinConfT stPermitConf;
+
+  if ( bJoinAdmissionDeferred == false )
+  {
+    return;
+  }
+
+  bJoinAdmissionDeferred = false;
+  lClosedTime = ( HAL_GetTick() - lJoinAdmissionCloseTick );
+  stZigbeeAppInfo.stAdmissionStats.lDeferredTime += lClosedTime;
+
+  /* 0xFF : Permit Join without end */
+  memset( &stPermitReq, 0, sizeof( stPermitReq ) );
+  stPermitReq.permitDuration = cJoinAdmissionDuration;
+  if ( cJoinAdmissionDuration != 0xFFu )
+  {
+    lElapsedSeconds = ( ( lClosedTime + 999u ) / 1000u );
+    stPermitReq.permitDuration = ( cJoinAdmissionDuration > lElapsedSeconds ) ? (uint8_t)( cJoinAdmissionDuration - lElapsedSeconds ) : 0u;
+  }
+
+  if ( stPermitReq.permitDuration != 0u )
+  {
+    ZbNlmePermitJoinReq( stZigbeeAppInfo.pstZigbee, &stPermitReq, &stPermitConf );
+    if ( stPermitConf.status != ZB_STATUS_SUCCESS )
+    {
+      LOG_ERROR_APP( "Error, Permit Join not opened again (0x%02X)", stPermitConf.status );
+    }
+  }
+}
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+/**
+ * @brief  Enable or disable the Concentrator mode (many-to-one routing towards this Router, for a gateway-adjacent
+ *         Router). Applied at once if on a Network, else when the Network is joined.
+ * @param  bEnable  True to be a Concentrator
+ * @retval None
+ */
+void APP_ZIGBEE_SetConcentrator( bool bEnable )
+{
+  stZigbeeAppInfo.bConcentrator = bEnable;
+
+  if ( APP_ZIGBEE_IsAppliJoinNetwork() != false )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CONCENTRATOR ), TASK_PRIO_ZIGBEE_CONCENTRATOR );
+  }
+}
+
+/**
+ * @brief  Callback triggered when the period between two tunings of the Concentrator expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void APP_ZIGBEE_ConcentratorElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CONCENTRATOR ), TASK_PRIO_ZIGBEE_CONCENTRATOR );
+}
+
+/**
+ * @brief  Concentrator Task : estimate the Network size from the NWK tables, then tune the source route length,
+ *         the Many-to-One Route Request radius and its period.
+ * @param  None
+ * @retval None
+ */
+static void APP_ZIGBEE_ConcentratorTask( void )
+{
+  APP_ZIGBEE_ConcentratorInfo_t * pstInfo = &stZigbeeAppInfo.stConcentratorInfo;
+  struct ZbNwkNeighborT           stNeighbor;
+  struct ZbNwkRouteEntryT         stRoute;
+  struct ZbNwkAddrMapEntryT       stAddrMap;
+  uint16_t                        iSize;
+  uint8_t                         cIsConcentrator, cMaxSourceRoute, cRadius, cDiscoveryTime;
+
+  if ( stZigbeeAppInfo.bConcentrator == false )
+  {
+    UTIL_TIMER_Stop( &stConcentratorTimer );
+    cIsConcentrator = 0;
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_IsConcentrator, &cIsConcentrator, sizeof( cIsConcentrator ) );
+
+    /* Parameters applied again at the next enable */
+    pstInfo->cMaxSourceRoute = 0;
+    return;
+  }
+
+  /* Occupancy of the tables. The Route Record table is not accessible : the Address Map resolves the source routes */
+  pstInfo->iNeighborNb = APP_ZIGBEE_CountNwkTable( ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), &stNeighbor.nwkAddr, &iSize );
+  pstInfo->iRouteNb = APP_ZIGBEE_CountNwkTable( ZB_NWK_NIB_ID_RouteTable, &stRoute, sizeof( stRoute ), &stRoute.destAddr, &pstInfo->iRouteSize );
+  pstInfo->iAddrMapNb = APP_ZIGBEE_CountNwkTable( ZB_NWK_NIB_ID_AddressMap, &stAddrMap, sizeof( stAddrMap ), &stAddrMap.nwkAddr, &pstInfo->iAddrMapSize );
+
+  pstInfo->iNetworkSize = ( pstInfo->iNeighborNb + pstInfo->iRouteNb );
+  if ( pstInfo->iAddrMapNb > pstInfo->iNetworkSize )
+  {
+    pstInfo->iNetworkSize = pstInfo->iAddrMapNb;
+  }
+
+  /* Larger Network : longer source routes, and less frequent Many-to-One Route Requests (they are broadcasts) */
+  if ( pstInfo->iNetworkSize <= CFG_ZIGBEE_CONCENTRATOR_SMALL_NETWORK )
+  {
+    cMaxSourceRoute = ( ZB_NWK_CONST_MAX_SOURCE_ROUTE / 2u );
+    cDiscoveryTime = 60u;
+  }
+  else if ( pstInfo->iNetworkSize <= ( CFG_ZIGBEE_CONCENTRATOR_SMALL_NETWORK * 4u ) )
+  {
+    cMaxSourceRoute = ( ( ZB_NWK_CONST_MAX_SOURCE_ROUTE * 2u ) / 3u );
+    cDiscoveryTime = 120u;
+  }
+  else
+  {
+    cMaxSourceRoute = ZB_NWK_CONST_MAX_SOURCE_ROUTE;
+    cDiscoveryTime = 240u;
+  }
+  cRadius = ( cMaxSourceRoute + 2u );
+
+  if ( ( ( pstInfo->iAddrMapSize != 0u ) && ( ( pstInfo->iAddrMapNb * 100u ) >= ( pstInfo->iAddrMapSize * 90u ) ) ) ||
+       ( ( pstInfo->iRouteSize != 0u ) && ( ( pstInfo->iRouteNb * 100u ) >= ( pstInfo->iRouteSize * 90u ) ) ) )
+  {
+    LOG_INFO_APP( "[CONCENTRATOR] Warning, tables almost full : %d/%d routes, %d/%d address map.", pstInfo->iRouteNb,
+                  pstInfo->iRouteSize, pstInfo->iAddrMapNb, pstInfo->iAddrMapSize );
+  }
+
+  if ( ( cMaxSourceRoute != pstInfo->cMaxSourceRoute ) || ( cRadius != pstInfo->cRadius ) || ( cDiscoveryTime != pstInfo->cDiscoveryTime ) )
+  {
+    LOG_INFO_APP( "[CONCENTRATOR] %d Devices : source route %d hops, radius %d, discovery every %d s.", pstInfo->iNetworkSize,
+                  cMaxSourceRoute, cRadius, cDiscoveryTime );
+
+    cIsConcentrator = 1;
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_MaxSourceRoute, &cMaxSourceRoute, sizeof( cMaxSourceRoute ) );
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_ConcentratorRadius, &cRadius, sizeof( cRadius ) );
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_ConcentratorDiscoveryTime, &cDiscoveryTime, sizeof( cDiscoveryTime ) );
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_IsConcentrator, &cIsConcentrator, sizeof( cIsConcentrator ) );
+
+    pstInfo->cMaxSourceRoute = cMaxSourceRoute;
+    pstInfo->cRadius = cRadius;
+    pstInfo->cDiscoveryTime = cDiscoveryTime;
+    pstInfo->lTunings++;
+  }
+
+  if ( UTIL_TIMER_IsRunning( &stConcentratorTimer ) == 0u )
+  {
+    UTIL_TIMER_Start( &stConcentratorTimer );
+  }
+}
+
+/**
+ * @brief  Count the used entries of a NWK table.
+ * @param  eAttrId      NIB attribute of the table
+ * @param  pEntry       Buffer of one entry
+ * @param  iEntrySize   Size of one entry
+ * @param  piAddress    Address field of the entry in pEntry, ZB_NWK_ADDR_UNDEFINED when the entry is free
+ * @param  piSize       Number of entries of the table
+ * @retval Number of used entries.
+ */
+static uint16_t APP_ZIGBEE_CountNwkTable( enum ZbNwkNibAttrIdT eAttrId, void * pEntry, uint16_t iEntrySize, const uint16_t * piAddress, uint16_t * piSize )
+{
+  uint16_t  iIndex = 0, iUsed = 0;
+
+  while ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, eAttrId, pEntry, iEntrySize, iIndex ) == ZB_STATUS_SUCCESS )
+  {
+    if ( *piAddress != ZB_NWK_ADDR_UNDEFINED )
+    {
+      iUsed++;
+    }
+    iIndex++;
+  }
+
+  *piSize = iIndex;
+
+  return iUsed;
+}
+#else /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+
+/**
+ * @brief  Concentrator mode not supported.
+ */
+void APP_ZIGBEE_SetConcentrator( bool bEnable )
+{
+  UNUSED( bEnable );
+}
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+
+/**
+ * @brief Callback called every time a new Device (Router ou EndDevice) join the Network.
+ *        Information around the Device (Address & Capability) are sent on 'APP_ZIGBEE_NewDevice()' function.
+ * @param zb        Zigbee stack handler
+ * @param lId       Type of filter Message
+ * @param pMessage  Pointer on Message information
+ * @param arg       Pointer on User Argument.
+ */
+static enum zb_msg_filter_rc APP_ZIGBEE_DeviceJointCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  struct ZbNlmeJoinIndT * pstJoinMessage;
+
+  if ( lId == ZB_MSG_FILTER_JOIN_IND )
+  {
+    pstJoinMessage = ( struct ZbNlmeJoinIndT * )pMessage;
+
+    switch ( pstJoinMessage->rejoinNetwork )
+    {
+      case ZB_NWK_REJOIN_TYPE_ASSOC :
+      case ZB_NWK_REJOIN_TYPE_ORPHAN :
+      case ZB_NWK_REJOIN_TYPE_NWKREJOIN :
+      case ZB_NWK_REJOIN_TYPE_NWKCOMMISS_JOIN :
+      case ZB_NWK_REJOIN_TYPE_NWKCOMMISS_REJOIN :
+          /* A new Device has Join Network at MAC/NWK level */
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+          if ( ( lInstallCodeWindowTick != 0u ) && ( pstJoinMessage->rejoinNetwork == ZB_NWK_REJOIN_TYPE_ASSOC ) )
+          {
+            lInstallCodeJoined++;
+          }
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+          APP_ZIGBEE_SetNewDevice( pstJoinMessage->nwkAddr, pstJoinMessage->extAddr, pstJoinMessage->capabilityInfo );
+          break;
+
+      default :
+          break;
+    }
+  }
+
+  return( ZB_MSG_CONTINUE );
+}
+
+/*************************************************************
  *
- * @param   dlExtendedAddress   Device Extended Address
- * @param   szInstallCode       Device Install Code
- * @param   cPermitJoinDelay    Time to Device to Join network. If 0, PermitJoin is not called.
+ * GENERIC FUNCTIONS
+ *
+ *************************************************************/
+
+/**
+ * @brief  Callback that indicate if a 'Permit to Join' the network can be done
+ * @param  None
+ * @retval None
  */
-void APP_ZIGBEE_AddDeviceWithInstallCode( uint64_t dlExtendedAddress, uint8_t * szInstallCode, uint8_t cPermitJoinDelay )
+static void APP_ZIGBEE_ZbZdoPermitJoinReqCallback( struct ZbZdoPermitJoinRspT * pstJoinResponse, void * arg )
+{
+  UNUSED( arg );
+
+  if ( pstJoinResponse->status != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, cannot set Permit Join duration (%d)", pstJoinResponse->status );
+  }
+  else
+  {
+    LOG_INFO_APP( "Permit Join duration successfully changed." );
+  }
+}
+
+/**
+ * @brief  Send the request to NWK layer a Permit to Join the network
+ * @param  cPermitJoinDelay   Delay in second during the new Permit to Join is available
+ * @retval None
+ */
+void APP_ZIGBEE_PermitJoin( uint8_t cPermitJoinDelay )
+{
+  struct ZbZdoPermitJoinReqT  stJoinRequest;
+  enum ZbStatusCodeT          eStatus;
+
+  memset( &stJoinRequest, 0, sizeof( stJoinRequest ) );
+  stJoinRequest.destAddr = ZB_NWK_ADDR_UNDEFINED;
+  stJoinRequest.tcSignificance = true;
+  stJoinRequest.duration = cPermitJoinDelay;
+
+  LOG_INFO_APP( "Send command Permit Join during %ds", cPermitJoinDelay );
+  eStatus = ZbZdoPermitJoinReq( stZigbeeAppInfo.pstZigbee, &stJoinRequest, APP_ZIGBEE_ZbZdoPermitJoinReqCallback, NULL);
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error during command Permit Join (%d)", eStatus );
+  }
+}
+
+/**
+ * @brief  Indicate if Application as already join the network
+ * @param  None
+ * @retval True if Join OK, else False
+ */
+bool APP_ZIGBEE_IsAppliJoinNetwork( void )
+{
+  bool                bJoinOk = false;
+  uint64_t            dlEpid = 0U;
+  enum ZbStatusCodeT  eZbStatus;
+
+  if ( stZigbeeAppInfo.pstZigbee != NULL )
+  {
+    /* Check if the router joined the network, and if the waiting time after the Join is finished */
+    eZbStatus = ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_ExtendedPanId, &dlEpid, sizeof( dlEpid ) );
+    if ( ( eZbStatus == ZB_STATUS_SUCCESS) && ( dlEpid != 0u ) && ( stZigbeeAppInfo.eJoinStatus == ZB_STATUS_SUCCESS ) )
+      { bJoinOk = true; }
+  }
+
+  return( bJoinOk );
+}
+
+/**
+ * @brief  Derive the Link Key of a Device from its Install Code and add it to the Trust Center
+ * @param  dlExtendedAddress  Extended Address of the Device
+ * @param  szInstallCode      Install Code (with its CRC) of the Device
+ * @retval True if the Link Key is added, else false.
+ */
+static bool APP_ZIGBEE_AddInstallCodeKey( uint64_t dlExtendedAddress, const uint8_t * szInstallCode )
 {
   uint32_t                  lTcPolicy = 0;
   struct ZbApsmeAddKeyReqT  stAddKeyReq;
   struct ZbApsmeAddKeyConfT stAddKeyConf;
+  struct ZbApsmeKeyPairT    stKeyPair;
   static  bool              bTrustCenterDone = false;
 
   if ( bTrustCenterDone == false )
@@ -546,15 +1647,38 @@ void APP_ZIGBEE_AddDeviceWithInstallCode( uint64_t dlExtendedAddress, uint8_t *
   stAddKeyReq.partnerAddr = dlExtendedAddress;
 
   /*Extract Link Key from the Install Code*/
-  ZbAesMmoHash( szInstallCode, ( ZB_SEC_KEYSIZE + 2u ), stAddKeyReq.key );
+  ZIGBEE_PLAT_AesMmoHash( szInstallCode, ( ZB_SEC_KEYSIZE + 2u ), stAddKeyReq.key );
+
+  /* Device already commissioned with this Link Key : nothing to add */
+  if ( ( APP_ZIGBEE_TcKeyLookup( dlExtendedAddress, &stKeyPair ) != false ) &&
+       ( memcmp( stKeyPair.linkKey, stAddKeyReq.key, ZB_SEC_KEYSIZE ) == 0 ) )
+  {
+    return true;
+  }
 
   /* Add the new Link Key */
   ZbApsmeAddKeyReq( stZigbeeAppInfo.pstZigbee, &stAddKeyReq, &stAddKeyConf );
   if ( stAddKeyConf.status != ZB_STATUS_SUCCESS )
   {
-    LOG_ERROR_APP( "Error Add Link Key (0x%02X)", stAddKeyConf.status );
+    LOG_ERROR_APP( "Error Add Link Key of " LOG_DISPLAY64() " (0x%02X)", LOG_NUMBER64( dlExtendedAddress ), stAddKeyConf.status );
+    return false;
   }
-  else
+
+  APP_ZIGBEE_TcKeyAdded( dlExtendedAddress );
+  return true;
+}
+
+/**
+ * @brief   Indicate a Device with Install Code request a Join.
+ *          Add the LinkKey (from Install Code) on List and start a Join during 30s.
+ *
+ * @param   dlExtendedAddress   Device Extended Address
+ * @param   szInstallCode       Device Install Code
+ * @param   cPermitJoinDelay    Time to Device to Join network. If 0, PermitJoin is not called.
+ */
+void APP_ZIGBEE_AddDeviceWithInstallCode( uint64_t dlExtendedAddress, uint8_t * szInstallCode, uint8_t cPermitJoinDelay )
+{
+  if ( APP_ZIGBEE_AddInstallCodeKey( dlExtendedAddress, szInstallCode ) != false )
   {
     LOG_INFO_APP( "Add of Device Link Key OK." );
     if ( cPermitJoinDelay != 0 )
@@ -565,6 +1689,288 @@ void APP_ZIGBEE_AddDeviceWithInstallCode( uint64_t dlExtendedAddress, uint8_t *
   }
 }
 
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+/**
+ * @brief  Queue a table of Devices to commission with their Install Code. The Link Keys are derived and added in
+ *         background, then a single Permit Join window is opened when the queue is empty.
+ * @param  pstDevices         Table of Devices (can be NULL if iNumber is 0)
+ * @param  iNumber            Number of Devices in the table
+ * @param  cPermitJoinDelay   Duration (in s) of the Permit Join window. With 0, no window is opened : more
+ *                            Devices can be queued before a last call that opens it.
+ * @retval Number of Devices queued (less than iNumber if the queue is full).
+ */
+uint16_t APP_ZIGBEE_AddDevicesWithInstallCode( const APP_ZIGBEE_InstallCode_t * pstDevices, uint16_t iNumber, uint8_t cPermitJoinDelay )
+{
+  uint16_t  iIndex, iQueued = 0;
+
+  for ( iIndex = 0; iIndex < iNumber; iIndex++ )
+  {
+    if ( iInstallCodeCount >= CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE )
+    {
+      LOG_ERROR_APP( "Error, Install Code queue full (%d Devices not queued)", ( iNumber - iIndex ) );
+      break;
+    }
+
+    astInstallCodeQueue[( iInstallCodeHead + iInstallCodeCount ) % CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE] = pstDevices[iIndex];
+    iInstallCodeCount++;
+    iQueued++;
+  }
+
+  if ( cPermitJoinDelay != 0u )
+  {
+    cInstallCodeJoinDelay = cPermitJoinDelay;
+  }
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  /* Link Keys derived at the PLL clock until the queue is empty */
+  if ( iInstallCodeCount != 0u )
+  {
+    APPE_CLK_SetBoost( ( 1U << CFG_SCM_BOOST_INSTALL_CODE ), true );
+  }
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_INSTALL_CODE ), TASK_PRIO_ZIGBEE_INSTALL_CODE );
+
+  return iQueued;
+}
+
+/**
+ * @brief  'Install Code' Task : add the Link Keys of some queued Devices, then open the Permit Join window once
+ *         the queue is empty.
+ * @param  None
+ * @retval None
+ */
+static void APP_ZIGBEE_InstallCodeTask( void )
+{
+  uint16_t                    iIndex;
+  APP_ZIGBEE_InstallCode_t  * pstDevice;
+
+  for ( iIndex = 0; ( iIndex < APP_ZIGBEE_INSTALL_CODE_PER_TASK ) && ( iInstallCodeCount != 0u ); iIndex++ )
+  {
+    pstDevice = &astInstallCodeQueue[iInstallCodeHead];
+    if ( APP_ZIGBEE_AddInstallCodeKey( pstDevice->dlExtendedAddress, pstDevice->szInstallCode ) != false )
+    {
+      lInstallCodeAdded++;
+    }
+    else
+    {
+      lInstallCodeFailed++;
+    }
+
+    iInstallCodeHead = ( iInstallCodeHead + 1u ) % CFG_ZIGBEE_INSTALL_CODE_QUEUE_SIZE;
+    iInstallCodeCount--;
+  }
+
+  if ( iInstallCodeCount != 0u )
+  {
+    /* Remaining Devices at the next run, to let the other Tasks run in between */
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_INSTALL_CODE ), TASK_PRIO_ZIGBEE_INSTALL_CODE );
+    return;
+  }
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  APPE_CLK_SetBoost( ( 1U << CFG_SCM_BOOST_INSTALL_CODE ), false );
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+  if ( cInstallCodeJoinDelay != 0u )
+  {
+    LOG_INFO_APP( "%d Device Link Keys added (%d failed), Devices can now Join Network during %d seconds.",
+                  lInstallCodeAdded, lInstallCodeFailed, cInstallCodeJoinDelay );
+
+    lInstallCodeJoined = 0;
+    lInstallCodeWindowTick = HAL_GetTick();
+    lInstallCodeWindowTime = ( (uint32_t)cInstallCodeJoinDelay * 1000u );
+    APP_ZIGBEE_PermitJoin( cInstallCodeJoinDelay );
+    cInstallCodeJoinDelay = 0;
+  }
+}
+
+/**
+ * @brief  Read an hexadecimal number of a fixed length (most significant byte first)
+ * @param  pszText   Text to parse, moved after the number and the following spaces
+ * @param  pData     Bytes read
+ * @param  iLength   Number of bytes to read
+ * @retval True if the number is read, else false.
+ */
+static bool APP_ZIGBEE_ParseHex( const char ** pszText, uint8_t * pData, uint16_t iLength )
+{
+  const char  * szText = *pszText;
+  uint16_t    iIndex;
+  uint8_t     cNibble, cDigit;
+  char        cChar;
+
+  for ( iIndex = 0; iIndex < ( iLength * 2u ); iIndex++ )
+  {
+    cChar = szText[iIndex];
+    if ( ( cChar >= '0' ) && ( cChar <= '9' ) )
+    {
+      cNibble = (uint8_t)( cChar - '0' );
+    }
+    else if ( ( cChar >= 'A' ) && ( cChar <= 'F' ) )
+    {
+      cNibble = (uint8_t)( cChar - 'A' + 10 );
+    }
+    else if ( ( cChar >= 'a' ) && ( cChar <= 'f' ) )
+    {
+      cNibble = (uint8_t)( cChar - 'a' + 10 );
+    }
+    else
+    {
+      return false;
+    }
+
+    cDigit = ( ( iIndex & 1u ) == 0u ) ? (uint8_t)( cNibble << 4 ) : (uint8_t)( pData[iIndex / 2u] | cNibble );
+    pData[iIndex / 2u] = cDigit;
+  }
+
+  szText += ( iLength * 2u );
+  if ( ( *szText != ' ' ) && ( *szText != '\0' ) )
+  {
+    return false;
+  }
+
+  while ( *szText == ' ' )
+  {
+    szText++;
+  }
+
+  *pszText = szText;
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+/**
+ * @brief  Queued commissioning not supported : nothing queued.
+ */
+uint16_t APP_ZIGBEE_AddDevicesWithInstallCode( const APP_ZIGBEE_InstallCode_t * pstDevices, uint16_t iNumber, uint8_t cPermitJoinDelay )
+{
+  return 0;
+}
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+
+/**
+ * @brief  Commissioning commands from the serial console :
+ *         ICADD <EUI64> <InstallCode> [<EUI64> <InstallCode> ...] queues Devices (hexadecimal, 16 and 36 digits),
+ *         ICJOIN <seconds> opens the Permit Join window once the queued Link Keys are added and
+ *         ICSTATUS displays the counters and the commissioning rate of the last window,
+ *         JOINSTATS displays the counters of the Join admission.
+ * @param  szCommand  Command received.
+ * @retval True if the command is a commissioning command.
+ */
+bool APP_ZIGBEE_SerialCmdExecute( const char * szCommand )
+{
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+  const char                * szText;
+  char                      * pEnd;
+  uint8_t                   acExtendedAddress[8];
+  uint16_t                  iIndex, iNumber = 0;
+#if (CFG_LOG_SUPPORTED != 0)
+  uint16_t                  iQueued;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  uint32_t                  lValue, lElapsed;
+  APP_ZIGBEE_InstallCode_t  astDevices[4];
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) && (CFG_LOG_SUPPORTED != 0)
+  APP_ZIGBEE_AdmissionStats_t * pstStats = &stZigbeeAppInfo.stAdmissionStats;
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) && (CFG_LOG_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) && (CFG_LOG_SUPPORTED != 0)
+  APP_ZIGBEE_ConcentratorInfo_t * pstConcentrator = &stZigbeeAppInfo.stConcentratorInfo;
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) && (CFG_LOG_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0)
+  if ( strncmp( szCommand, "ICADD ", 6u ) == 0 )
+  {
+    szText = &szCommand[6];
+    while ( *szText != '\0' )
+    {
+      if ( ( iNumber == ( sizeof( astDevices ) / sizeof( astDevices[0] ) ) ) ||
+           ( APP_ZIGBEE_ParseHex( &szText, acExtendedAddress, sizeof( acExtendedAddress ) ) == false ) ||
+           ( APP_ZIGBEE_ParseHex( &szText, astDevices[iNumber].szInstallCode, sizeof( astDevices[iNumber].szInstallCode ) ) == false ) )
+      {
+        LOG_ERROR_APP( "Invalid ICADD command after %d Devices : %s", iNumber, szText );
+        break;
+      }
+
+      astDevices[iNumber].dlExtendedAddress = 0;
+      for ( iIndex = 0; iIndex < sizeof( acExtendedAddress ); iIndex++ )
+      {
+        astDevices[iNumber].dlExtendedAddress = ( astDevices[iNumber].dlExtendedAddress << 8 ) | acExtendedAddress[iIndex];
+      }
+      iNumber++;
+    }
+
+#if (CFG_LOG_SUPPORTED != 0)
+    iQueued = APP_ZIGBEE_AddDevicesWithInstallCode( astDevices, iNumber, 0 );
+    LOG_INFO_APP( "%d Devices queued (%d waiting).", iQueued, iInstallCodeCount );
+#else /* (CFG_LOG_SUPPORTED != 0) */
+    (void)APP_ZIGBEE_AddDevicesWithInstallCode( astDevices, iNumber, 0 );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  }
+  else if ( strncmp( szCommand, "ICJOIN ", 7u ) == 0 )
+  {
+    lValue = strtoul( &szCommand[7], &pEnd, 0 );
+    if ( ( pEnd == &szCommand[7] ) || ( lValue == 0u ) || ( lValue > UINT8_MAX ) )
+    {
+      LOG_ERROR_APP( "Invalid ICJOIN command : %s", szCommand );
+    }
+    else
+    {
+      (void)APP_ZIGBEE_AddDevicesWithInstallCode( NULL, 0, (uint8_t)lValue );
+    }
+  }
+  else if ( strcmp( szCommand, "ICSTATUS" ) == 0 )
+  {
+    LOG_INFO_APP( "Install Codes : %d waiting, %d Link Keys added, %d failed.", iInstallCodeCount, lInstallCodeAdded, lInstallCodeFailed );
+    if ( lInstallCodeWindowTick != 0u )
+    {
+      lElapsed = ( HAL_GetTick() - lInstallCodeWindowTick );
+      if ( lElapsed > lInstallCodeWindowTime )
+      {
+        lElapsed = lInstallCodeWindowTime;
+      }
+      LOG_INFO_APP( "Last Permit Join window : %d Devices joined in %d ms (%d per minute).", lInstallCodeJoined, lElapsed,
+                    ( lElapsed != 0u ) ? (uint32_t)( ( (uint64_t)lInstallCodeJoined * 60000u ) / lElapsed ) : 0u );
+    }
+  }
+  else
+#endif /* (CFG_ZIGBEE_INSTALL_CODE_BATCH_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0)
+  if ( strcmp( szCommand, "JOINSTATS" ) == 0 )
+  {
+    LOG_INFO_APP( "Joins : %d in the current window, %d in the last one, %d at most (%d per %d ms allowed), %d in total.",
+                  pstStats->lWindowJoins, pstStats->lLastWindowJoins, pstStats->lMaxWindowJoins, CFG_ZIGBEE_JOIN_ADMISSION_MAX,
+                  CFG_ZIGBEE_JOIN_ADMISSION_WINDOW, pstStats->lTotalJoins );
+    LOG_INFO_APP( "Joins deferred %d times, Permit Join closed during %d ms.", pstStats->lDeferrals, pstStats->lDeferredTime );
+  }
+  else
+#endif /* (CFG_ZIGBEE_JOIN_ADMISSION_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0)
+  if ( strcmp( szCommand, "CONCENTRATOR ON" ) == 0 )
+  {
+    APP_ZIGBEE_SetConcentrator( true );
+  }
+  else if ( strcmp( szCommand, "CONCENTRATOR OFF" ) == 0 )
+  {
+    APP_ZIGBEE_SetConcentrator( false );
+  }
+  else if ( strcmp( szCommand, "CONCSTATS" ) == 0 )
+  {
+    LOG_INFO_APP( "Concentrator %s : %d Devices estimated (%d neighbors, %d/%d routes, %d/%d address map).",
+                  ( stZigbeeAppInfo.bConcentrator != false ) ? "ON" : "OFF", pstConcentrator->iNetworkSize, pstConcentrator->iNeighborNb,
+                  pstConcentrator->iRouteNb, pstConcentrator->iRouteSize, pstConcentrator->iAddrMapNb, pstConcentrator->iAddrMapSize );
+    LOG_INFO_APP( "Concentrator source route %d hops, radius %d, discovery every %d s (%d tunings).", pstConcentrator->cMaxSourceRoute,
+                  pstConcentrator->cRadius, pstConcentrator->cDiscoveryTime, pstConcentrator->lTunings );
+  }
+  else
+#endif /* (CFG_ZIGBEE_CONCENTRATOR_SUPPORTED != 0) */
+  {
+    /* Not a commissioning command */
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * @brief  Get the current RF channel
  * @param  cCurrentChannel    Current Channel
@@ -617,6 +2023,28 @@ bool APP_ZIGBEE_SetTxPower( uint8_t cTxPower )
   return ZbNwkIfSetTxPower( stZigbeeAppInfo.pstZigbee, "wpan0", cTxPower );
 }
 
+/**
+ * @brief  Change the mask of the Zigbee stack logs (ZB_LOG_MASK_xxx)
+ * @param  lMask       New log mask
+ * @retval True if Ok, false if the stack is not initialized or its logs are compiled out.
+ */
+bool APP_ZIGBEE_SetLogMask( uint32_t lMask )
+{
+  bool  bResult = false;
+
+#if LOG_IS_COMPILED( ZIGBEE, INFO )
+  if ( stZigbeeAppInfo.pstZigbee != NULL )
+  {
+    ZbSetLogging( stZigbeeAppInfo.pstZigbee, lMask, APP_ZIGBEE_Printf );
+    bResult = true;
+  }
+#else /* LOG_IS_COMPILED( ZIGBEE, INFO ) */
+  UNUSED( lMask );
+#endif /* LOG_IS_COMPILED( ZIGBEE, INFO ) */
+
+  return( bResult );
+}
+
 /**
  * @brief Display a Security Key or Install Code
  *
@@ -625,27 +2053,10 @@ bool APP_ZIGBEE_SetTxPower( uint8_t cTxPower )
  */
 char * APP_ZIGBEE_GetDisplaySecKey( const uint8_t * szCode, uint16_t iLength, bool bSpace )
 {
-  uint16_t      iIndex;
   static char   szCodeValue[( ( ZB_SEC_KEYSIZE + 2u ) * 3u ) + 1u];
 
-  /* Initialize & verify parameters */
-  memset( szCodeValue, 0, sizeof(szCodeValue) );
-  if ( iLength > ( ZB_SEC_KEYSIZE + 2u ) )
-  {
-    iLength = ( ZB_SEC_KEYSIZE + 2u );
-  }
-
-  for ( iIndex= 0; iIndex < iLength; iIndex++ )
-  {
-    if ( bSpace != false )
-    {
-      snprintf( &szCodeValue[iIndex * 3u], ( sizeof(szCodeValue) - ( iIndex * 3u ) ), "%02X ", szCode[iIndex] );
-    }
-    else
-    {
-      snprintf( &szCodeValue[iIndex * 2u], ( sizeof(szCodeValue) - ( iIndex * 2u ) ), "%02X", szCode[iIndex] );
-    }
-  }
+  /* Codes longer than the buffer are truncated */
+  Log_Module_HexToText( szCodeValue, sizeof(szCodeValue), szCode, iLength, ( ( bSpace != false ) ? ' ' : '\0' ) );
 
   return (char *)&szCodeValue;
 }
@@ -670,7 +2081,7 @@ void APP_ZIGBEE_PrintGenericInfo( void )
   LOG_INFO_APP( "Zigbee Extended Address : " LOG_DISPLAY64(), LOG_NUMBER64( ZbExtendedAddress( stZigbeeAppInfo.pstZigbee ) ) );
 
   /* Display Link Key */
-  LOG_INFO_APP( "Link Key : %s", APP_ZIGBEE_GetDisplaySecKey( sec_key_ha, ZB_SEC_KEYSIZE, true ) );
+  LOG_HEXDUMP_INFO_APP( "Link Key : ", sec_key_ha, ZB_SEC_KEYSIZE );
 }
 
 /**
@@ -684,12 +2095,12 @@ void APP_ZIGBEE_PrintGenericInfo( void )
  */
 static void APP_ZIGBEE_Printf( struct ZigBeeT * pstZigbee, uint32_t lMask, const char * pFunctionName, const char * pData, va_list pArgList )
 {
-#if (CFG_LOG_SUPPORTED != 0)
+#if LOG_IS_COMPILED( ZIGBEE, INFO )
   if ( ( lMask & ZIGBEE_CONFIG_LOG_LEVEL ) != 0u )
   {
     Log_Module_PrintWithArg( LOG_VERBOSE_INFO, LOG_REGION_ZIGBEE, pData, pArgList );
   }
-#endif /* (CFG_LOG_SUPPORTED != 0) */
+#endif /* LOG_IS_COMPILED( ZIGBEE, INFO ) */
 }
 
 /**
@@ -718,6 +2129,7 @@ void APP_ZIGBEE_Error( uint32_t ErrId, uint32_t ErrCode )
 static void APP_ZIGBEE_TraceError( const char * pMess, uint32_t ErrCode )
 {
   LOG_ERROR_APP( "**** Fatal error = %s (Err = 0x%02X) ****", pMess, ErrCode );
+  APP_CRASH_LOG_Fatal( APP_CRASH_LOG_REASON_ZIGBEE_ERROR, (uint32_t)pMess, ErrCode );
 
   // Intentional INFINITE_LOOP
   // coverity[no_escape]
@@ -46,6 +46,70 @@ typedef enum
   APP_ZIGBEE_ERROR    = 0x01u,
 } APP_ZIGBEE_StatusTypeDef;
 
+/* --- Zigbee Application 'Network Form or Join' statistics --- */
+typedef struct
+{
+  uint32_t              lAttempts;                  /* Number of Startup tentatives */
+  uint32_t              lFailures;                  /* Number of failed Startup tentatives */
+  uint32_t              lConsecutiveFailures;       /* Number of failed tentatives since the last success */
+  uint32_t              lMaxConsecutiveFailures;    /* Highest number of consecutive failed tentatives */
+  uint32_t              lLastRetryDelay;            /* Last time (in ms) waited before a new tentative */
+  uint32_t              lLastJoinTime;              /* Time (in ms) from the first tentative to the last success */
+  enum ZbStatusCodeT    eLastStatus;                /* Status of the last tentative */
+} APP_ZIGBEE_JoinStats_t;
+
+/* --- Zigbee Application Join admission statistics --- */
+typedef struct
+{
+  uint32_t              lWindowJoins;               /* Number of Joins in the current window */
+  uint32_t              lLastWindowJoins;           /* Number of Joins in the last ended window */
+  uint32_t              lMaxWindowJoins;            /* Highest number of Joins in a window */
+  uint32_t              lTotalJoins;                /* Number of Joins since the startup */
+  uint32_t              lDeferrals;                 /* Number of times the Permit Join was closed to defer the Joins */
+  uint32_t              lDeferredTime;              /* Total time (in ms) the Permit Join was closed */
+} APP_ZIGBEE_AdmissionStats_t;
+
+/* --- Zigbee Application Concentrator information --- */
+typedef struct
+{
+  uint16_t              iNetworkSize;               /* Estimated number of Devices on the Network */
+  uint16_t              iNeighborNb;                /* Neighbors in the Neighbor table */
+  uint16_t              iRouteNb;                   /* Routes in the Route table */
+  uint16_t              iRouteSize;                 /* Size of the Route table */
+  uint16_t              iAddrMapNb;                 /* Entries in the Address Map (used to resolve the source routes) */
+  uint16_t              iAddrMapSize;               /* Size of the Address Map */
+  uint8_t               cMaxSourceRoute;            /* Current nwkMaxSourceRoute */
+  uint8_t               cRadius;                    /* Current nwkConcentratorRadius */
+  uint8_t               cDiscoveryTime;             /* Current nwkConcentratorDiscoveryTime (in s) */
+  uint32_t              lTunings;                   /* Number of times the parameters have been changed */
+} APP_ZIGBEE_ConcentratorInfo_t;
+
+/* --- Zigbee Application Device to commission with an Install Code --- */
+typedef struct
+{
+  uint64_t              dlExtendedAddress;                      /* EUI64 of the Device */
+  uint8_t               szInstallCode[ZB_SEC_KEYSIZE + 2u];     /* Install Code, with its CRC */
+} APP_ZIGBEE_InstallCode_t;
+
+/* --- Zigbee Application Endpoint description --- */
+typedef struct
+{
+  uint8_t               cEndpoint;                  /* Endpoint number */
+  uint16_t              iProfileId;                 /* Profile of the Endpoint */
+  uint16_t              iDeviceId;                  /* Device of the Endpoint */
+} APP_ZIGBEE_EndpointDesc_t;
+
+/* --- Zigbee Application Cluster description --- */
+typedef struct ZbZclClusterT * (*APP_ZIGBEE_ClusterAlloc_t)( struct ZigBeeT * pstZigbee, uint8_t cEndpoint );
+
+typedef struct
+{
+  uint8_t               cEndpoint;                  /* Endpoint of the Cluster (shall be described) */
+  uint8_t               cClusterIndex;              /* Index in pstZbCluster[] (lower than CLUSTER_NB_MAX) */
+  APP_ZIGBEE_ClusterAlloc_t pfAlloc;                /* Allocation of the Cluster */
+  const char            * szName;                   /* Name displayed at startup */
+} APP_ZIGBEE_ClusterDesc_t;
+
 /* --- Zigbee Application Information --- */
 typedef struct ZigbeeAppInfoT
 {
@@ -57,8 +121,15 @@ typedef struct ZigbeeAppInfoT
   enum ZbStartType      eStartupControl;
   enum ZbStatusCodeT    eJoinStatus;
   uint32_t              lPersistNumWrites;
+  uint32_t              lPersistNumUnchanged;
   uint32_t              lJoinDelay;
+  uint32_t              lChannelMask;
+  uint8_t               cLastChannel;
   uint64_t              dlExtendedAddress;
+  APP_ZIGBEE_JoinStats_t stJoinStats;
+  APP_ZIGBEE_AdmissionStats_t stAdmissionStats;
+  bool                  bConcentrator;
+  APP_ZIGBEE_ConcentratorInfo_t stConcentratorInfo;
 
   /* USER CODE BEGIN ZigbeeAppInfo_t */
 
@@ -97,12 +168,21 @@ extern void       APP_ZIGBEE_Task                         ( void );
 extern void       APP_ZIGBEE_StackLayersInit              ( void );
 extern void       APP_ZIGBEE_NwkFormOrJoinTaskInit        ( void );
 extern void       APP_ZIGBEE_NwkFormOrJoin                ( void );
+extern uint32_t   APP_ZIGBEE_ConfigEndpointTable          ( const APP_ZIGBEE_EndpointDesc_t * pstEndpoints, uint8_t cEndpointNb,
+                                                            const APP_ZIGBEE_ClusterDesc_t * pstClusters, uint8_t cClusterNb );
 
 extern void       APP_ZIGBEE_PermitJoin                   ( uint8_t cPermitJoinDelay );
 extern bool       APP_ZIGBEE_IsAppliJoinNetwork           ( void );
 extern void       APP_ZIGBEE_AddDeviceWithInstallCode     ( uint64_t dlExtendedAddress, uint8_t * szInstallCode, uint8_t cPermitJoinDelay );
+extern uint16_t   APP_ZIGBEE_AddDevicesWithInstallCode    ( const APP_ZIGBEE_InstallCode_t * pstDevices, uint16_t iNumber, uint8_t cPermitJoinDelay );
+extern bool       APP_ZIGBEE_SerialCmdExecute             ( const char * szCommand );
+extern void       APP_ZIGBEE_SetConcentrator              ( bool bEnable );
 extern bool       APP_ZIGBEE_GetCurrentChannel            ( uint8_t * cCurrentChannel );
+extern void       APP_ZIGBEE_GetJoinChannelList           ( struct ZbChannelListT * pstChannelList );
 extern bool       APP_ZIGBEE_SetTxPower                   ( uint8_t cTxPower );
+extern bool       APP_ZIGBEE_SetLogMask                   ( uint32_t lMask );
+extern bool       APP_ZIGBEE_PersistenceSave              ( void );
+extern void       APP_ZIGBEE_PersistenceNotify            ( void );
 extern char *     APP_ZIGBEE_GetDisplaySecKey             ( const uint8_t * szCode, uint16_t iLength, bool bSpace );
 extern void       APP_ZIGBEE_PrintGenericInfo             ( void );
 extern void       APP_ZIGBEE_PrintApplicationInfo         ( void );
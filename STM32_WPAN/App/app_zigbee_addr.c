@@ -0,0 +1,499 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_addr.c
+  * @author  MCD Application Team
+  * @brief   Address cache : the short addresses of the destinations given by
+  *          IEEE address are kept in a LRU cache, learned from the
+  *          Device_annce and the incoming frames, so that the unicast is sent
+  *          by short address without address discovery. The entries used
+  *          often are refreshed ahead, out of the send path.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_addr.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.aps.h"
+#include "zigbee.zdo.h"
+
+#if (CFG_ZIGBEE_ADDR_CACHE_SUPPORTED != 0)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint64_t    llExtAddr;
+  uint16_t    iNwkAddr;               /* ZB_NWK_ADDR_UNDEFINED when free */
+  uint16_t    iUses;                  /* Lookups during the current tick */
+  uint32_t    lUsedTick;              /* Last lookup (LRU) */
+  uint32_t    lConfirmedTick;         /* Last Device_annce, frame or response of the device */
+  bool        bBroadcast;             /* Next refresh broadcast (the unicast one failed) */
+} AddrEntry_t;
+
+/* Private variables ---------------------------------------------------------*/
+static AddrEntry_t                  astAddrCache[CFG_ZIGBEE_ADDR_CACHE_SIZE];
+static APP_ZIGBEE_AddrStats_t       stAddrStats;
+static struct ZigBeeT             * pstAddrZigbee;
+static struct ZbTimerT            * pstAddrTimer;
+static uint64_t                     llAddrRequestExt;       /* IEEE address of the NWK_addr_req pending */
+static bool                         bAddrRequesting;
+
+/* Private functions prototypes-----------------------------------------------*/
+static AddrEntry_t * AddrFind           ( uint64_t llExtAddr );
+static void     AddrLearn               ( uint64_t llExtAddr, uint16_t iNwkAddr, bool bInsert );
+static void     AddrRequest             ( uint64_t llExtAddr, uint16_t iDstAddr );
+static void     AddrRequestCallback     ( struct ZbZdoNwkAddrRspT * pstRsp, void * arg );
+static void     AddrTimerCallback       ( struct ZigBeeT * zb, void * arg );
+static void     AddrPrintStats          ( void );
+
+static enum zb_msg_filter_rc AddrDeviceAnnceCallback ( struct ZigBeeT * zb, struct ZbZdoDeviceAnnceT * pstAnnce, uint8_t cSeqno, void * arg );
+static enum zb_msg_filter_rc AddrDataIndCallback     ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the address cache */
+static const SerialCmd_t            astAddrSerialCmds[] =
+{
+  { "ADDRCACHE", AddrPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stAddrSerialCmdTable =
+{
+  astAddrSerialCmds, ( sizeof( astAddrSerialCmds ) / sizeof( astAddrSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the address cache : no entry, Device_annce and incoming frames listened to, Timer of the
+ *         refreshes.
+ * @param  pstZigbee  Zigbee stack instance
+ * @retval None
+ */
+void APP_ZIGBEE_AddrInit( struct ZigBeeT * pstZigbee )
+{
+  uint16_t  iIndex;
+
+  memset( astAddrCache, 0, sizeof( astAddrCache ) );
+  memset( &stAddrStats, 0, sizeof( stAddrStats ) );
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_ADDR_CACHE_SIZE; iIndex++ )
+  {
+    astAddrCache[iIndex].iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+  }
+  pstAddrZigbee = pstZigbee;
+  bAddrRequesting = false;
+
+  pstAddrTimer = ZbTimerAlloc( pstZigbee, AddrTimerCallback, NULL );
+  if ( ( pstAddrTimer == NULL ) ||
+       ( ZbZdoDeviceAnnceFilterRegister( pstZigbee, NULL, AddrDeviceAnnceCallback, NULL ) == NULL ) ||
+       ( ZbMsgFilterRegister( pstZigbee, ZB_MSG_FILTER_APSDE_DATA_IND, ( ZB_MSG_INTERNAL_PRIO + 1u ), AddrDataIndCallback, NULL ) == NULL ) )
+  {
+    LOG_ERROR_APP( "Error, Address cache registration failed." );
+    return;
+  }
+
+  ZbTimerReset( pstAddrTimer, CFG_ZIGBEE_ADDR_TICK );
+  Serial_CMD_Interpreter_RegisterTable( &stAddrSerialCmdTable );
+}
+
+/**
+ * @brief  Short address of an IEEE address : from the cache, else from the address map of the stack (then cached).
+ *         When not known, a NWK_addr_req is started for the next lookups.
+ * @param  llExtAddr  IEEE address
+ * @retval Short address, ZB_NWK_ADDR_UNDEFINED if not known.
+ */
+uint16_t APP_ZIGBEE_AddrLookupNwk( uint64_t llExtAddr )
+{
+  AddrEntry_t   * pstEntry;
+  uint16_t      iNwkAddr;
+
+  if ( pstAddrZigbee == NULL )
+  {
+    return ZB_NWK_ADDR_UNDEFINED;
+  }
+
+  stAddrStats.lLookups++;
+  pstEntry = AddrFind( llExtAddr );
+  if ( pstEntry == NULL )
+  {
+    stAddrStats.lMisses++;
+    iNwkAddr = ZbNwkAddrLookupNwk( pstAddrZigbee, llExtAddr );
+    if ( iNwkAddr >= ZB_NWK_ADDR_BCAST_MIN )
+    {
+      AddrRequest( llExtAddr, ZB_NWK_ADDR_BCAST_RXON );
+      return ZB_NWK_ADDR_UNDEFINED;
+    }
+
+    AddrLearn( llExtAddr, iNwkAddr, true );
+    pstEntry = AddrFind( llExtAddr );
+    if ( pstEntry == NULL )
+    {
+      return iNwkAddr;
+    }
+  }
+  else
+  {
+    stAddrStats.lHits++;
+  }
+
+  pstEntry->lUsedTick = HAL_GetTick();
+  if ( pstEntry->iUses < UINT16_MAX )
+  {
+    pstEntry->iUses++;
+  }
+
+  return pstEntry->iNwkAddr;
+}
+
+/**
+ * @brief  Destination given by IEEE address changed to its short address when known (no address discovery by the
+ *         stack). The other destinations are not changed.
+ * @param  pstDest    Destination of the frame
+ * @retval None
+ */
+void APP_ZIGBEE_AddrResolve( struct ZbApsAddrT * pstDest )
+{
+  uint16_t  iNwkAddr;
+
+  if ( pstDest->mode != ZB_APSDE_ADDRMODE_EXT )
+  {
+    return;
+  }
+
+  iNwkAddr = APP_ZIGBEE_AddrLookupNwk( pstDest->extAddr );
+  if ( iNwkAddr < ZB_NWK_ADDR_BCAST_MIN )
+  {
+    pstDest->mode = ZB_APSDE_ADDRMODE_SHORT;
+    pstDest->nwkAddr = iNwkAddr;
+  }
+}
+
+/**
+ * @brief  Return the statistics of the address cache.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_AddrStats_t * APP_ZIGBEE_AddrGetStats( void )
+{
+  return &stAddrStats;
+}
+
+/**
+ * @brief  Entry of an IEEE address.
+ * @param  llExtAddr  IEEE address
+ * @retval Entry, NULL if not cached.
+ */
+static AddrEntry_t * AddrFind( uint64_t llExtAddr )
+{
+  AddrEntry_t   * pstEntry;
+
+  for ( pstEntry = astAddrCache; pstEntry < &astAddrCache[CFG_ZIGBEE_ADDR_CACHE_SIZE]; pstEntry++ )
+  {
+    if ( ( pstEntry->iNwkAddr != ZB_NWK_ADDR_UNDEFINED ) && ( pstEntry->llExtAddr == llExtAddr ) )
+    {
+      return pstEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Address pair heard from the device : the entry is confirmed (short address updated if changed), or added in
+ *         place of the least recently used one if asked. An other entry with the same short address is removed (address
+ *         given again after a conflict or a rejoin). The address map of the stack is updated on change.
+ * @param  llExtAddr  IEEE address
+ * @param  iNwkAddr   Short address
+ * @param  bInsert    True to add the entry if not cached
+ * @retval None
+ */
+static void AddrLearn( uint64_t llExtAddr, uint16_t iNwkAddr, bool bInsert )
+{
+  AddrEntry_t   * pstEntry = NULL;
+  AddrEntry_t   * pstOldest = &astAddrCache[0];
+  AddrEntry_t   * pstScan;
+
+  if ( ( llExtAddr == 0u ) || ( iNwkAddr >= ZB_NWK_ADDR_BCAST_MIN ) )
+  {
+    return;
+  }
+
+  for ( pstScan = astAddrCache; pstScan < &astAddrCache[CFG_ZIGBEE_ADDR_CACHE_SIZE]; pstScan++ )
+  {
+    if ( pstScan->iNwkAddr == ZB_NWK_ADDR_UNDEFINED )
+    {
+      if ( pstOldest->iNwkAddr != ZB_NWK_ADDR_UNDEFINED )
+      {
+        pstOldest = pstScan;
+      }
+      continue;
+    }
+
+    if ( pstScan->llExtAddr == llExtAddr )
+    {
+      pstEntry = pstScan;
+    }
+    else if ( pstScan->iNwkAddr == iNwkAddr )
+    {
+      pstScan->iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+    }
+    else if ( ( pstOldest->iNwkAddr != ZB_NWK_ADDR_UNDEFINED ) &&
+              ( (int32_t)( pstScan->lUsedTick - pstOldest->lUsedTick ) < 0 ) )
+    {
+      pstOldest = pstScan;
+    }
+  }
+
+  if ( pstEntry == NULL )
+  {
+    if ( bInsert == false )
+    {
+      return;
+    }
+
+    if ( pstOldest->iNwkAddr != ZB_NWK_ADDR_UNDEFINED )
+    {
+      stAddrStats.lEvicted++;
+    }
+    pstEntry = pstOldest;
+    memset( pstEntry, 0, sizeof( AddrEntry_t ) );
+    pstEntry->llExtAddr = llExtAddr;
+    pstEntry->lUsedTick = HAL_GetTick();
+    stAddrStats.lLearned++;
+  }
+  else if ( pstEntry->iNwkAddr != iNwkAddr )
+  {
+    stAddrStats.lChanged++;
+  }
+  else
+  {
+    pstEntry->lConfirmedTick = HAL_GetTick();
+    pstEntry->bBroadcast = false;
+    return;
+  }
+
+  pstEntry->iNwkAddr = iNwkAddr;
+  pstEntry->lConfirmedTick = HAL_GetTick();
+  pstEntry->bBroadcast = false;
+  (void)ZbNwkAddrStoreMap( pstAddrZigbee, iNwkAddr, llExtAddr, false );
+}
+
+/**
+ * @brief  Start a NWK_addr_req for an IEEE address (one at a time), to the device itself or broadcast.
+ * @param  llExtAddr  IEEE address
+ * @param  iDstAddr   Short address of the device, or ZB_NWK_ADDR_BCAST_RXON
+ * @retval None
+ */
+static void AddrRequest( uint64_t llExtAddr, uint16_t iDstAddr )
+{
+  struct ZbZdoNwkAddrReqT   stRequest;
+
+  if ( ( bAddrRequesting != false ) || ( APP_ZIGBEE_IsAppliJoinNetwork() == false ) )
+  {
+    return;
+  }
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dstNwkAddr = iDstAddr;
+  stRequest.extAddr = llExtAddr;
+  stRequest.reqType = ZB_ZDO_ADDR_REQ_TYPE_SINGLE;
+  stRequest.startIndex = 0;
+
+  stAddrStats.lRequests++;
+  llAddrRequestExt = llExtAddr;
+  bAddrRequesting = true;
+  if ( ZbZdoNwkAddrReq( pstAddrZigbee, &stRequest, AddrRequestCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    bAddrRequesting = false;
+    stAddrStats.lRequestFailures++;
+  }
+}
+
+/**
+ * @brief  NWK_addr_rsp : the address pair is learned. On failure of a refresh by unicast, the next one is broadcast.
+ * @param  pstRsp   Response
+ * @param  arg      Not used
+ * @retval None
+ */
+static void AddrRequestCallback( struct ZbZdoNwkAddrRspT * pstRsp, void * arg )
+{
+  AddrEntry_t   * pstEntry;
+
+  UNUSED( arg );
+
+  bAddrRequesting = false;
+  if ( ( pstRsp->status == ZB_STATUS_SUCCESS ) && ( pstRsp->extAddr == llAddrRequestExt ) )
+  {
+    AddrLearn( pstRsp->extAddr, pstRsp->nwkAddr, true );
+    return;
+  }
+
+  stAddrStats.lRequestFailures++;
+  pstEntry = AddrFind( llAddrRequestExt );
+  if ( pstEntry != NULL )
+  {
+    pstEntry->bBroadcast = true;
+  }
+}
+
+/**
+ * @brief  Tick of the address cache : the hot entry confirmed the longest ago, if after CFG_ZIGBEE_ADDR_REFRESH_AGE,
+ *         is refreshed (NWK_addr_req to the device, broadcast if it failed). Uses restarted.
+ * @param  zb   Zigbee stack instance
+ * @param  arg  Not used
+ * @retval None
+ */
+static void AddrTimerCallback( struct ZigBeeT * zb, void * arg )
+{
+  AddrEntry_t   * pstEntry, * pstDue = NULL;
+  uint32_t      lTick, lAge, lDueAge = 0;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  lTick = HAL_GetTick();
+  for ( pstEntry = astAddrCache; pstEntry < &astAddrCache[CFG_ZIGBEE_ADDR_CACHE_SIZE]; pstEntry++ )
+  {
+    if ( pstEntry->iNwkAddr == ZB_NWK_ADDR_UNDEFINED )
+    {
+      continue;
+    }
+
+    lAge = ( lTick - pstEntry->lConfirmedTick );
+    if ( ( pstEntry->iUses >= CFG_ZIGBEE_ADDR_HOT_THRESHOLD ) && ( lAge >= CFG_ZIGBEE_ADDR_REFRESH_AGE ) && ( lAge >= lDueAge ) )
+    {
+      pstDue = pstEntry;
+      lDueAge = lAge;
+    }
+    pstEntry->iUses = 0;
+  }
+
+  if ( pstDue != NULL )
+  {
+    AddrRequest( pstDue->llExtAddr, ( ( pstDue->bBroadcast != false ) ? ZB_NWK_ADDR_BCAST_RXON : pstDue->iNwkAddr ) );
+  }
+
+  ZbTimerReset( pstAddrTimer, CFG_ZIGBEE_ADDR_TICK );
+}
+
+/**
+ * @brief  Device_annce : the device is added to the cache (it is likely to be addressed soon).
+ * @param  zb         Zigbee stack instance
+ * @param  pstAnnce   Device_annce
+ * @param  cSeqno     Not used
+ * @param  arg        Not used
+ * @retval ZB_MSG_CONTINUE, the Device_annce is always given to the stack.
+ */
+static enum zb_msg_filter_rc AddrDeviceAnnceCallback( struct ZigBeeT * zb, struct ZbZdoDeviceAnnceT * pstAnnce, uint8_t cSeqno, void * arg )
+{
+  UNUSED( zb );
+  UNUSED( cSeqno );
+  UNUSED( arg );
+
+  AddrLearn( pstAnnce->extAddr, pstAnnce->nwkAddr, true );
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Incoming frame : the entry of its source, if cached and known by IEEE address, is confirmed.
+ * @param  zb         Zigbee stack instance
+ * @param  lId        Message
+ * @param  pMessage   APSDE-DATA.indication
+ * @param  arg        Not used
+ * @retval ZB_MSG_CONTINUE, the indication is always given to the stack.
+ */
+static enum zb_msg_filter_rc AddrDataIndCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbApsdeDataIndT  * pstIndication = (const struct ZbApsdeDataIndT *)pMessage;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( lId == ZB_MSG_FILTER_APSDE_DATA_IND )
+  {
+    AddrLearn( pstIndication->src.extAddr, pstIndication->src.nwkAddr, false );
+  }
+
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Print the statistics and the entries of the address cache.
+ * @param  None
+ * @retval None
+ */
+static void AddrPrintStats( void )
+{
+  const AddrEntry_t   * pstEntry;
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t            lTick = HAL_GetTick();
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_APP( "Address cache : %d lookups, %d hits, %d misses, %d learned, %d changed, %d evicted.", stAddrStats.lLookups,
+                stAddrStats.lHits, stAddrStats.lMisses, stAddrStats.lLearned, stAddrStats.lChanged, stAddrStats.lEvicted );
+  LOG_INFO_APP( "  %d NWK_addr_req, %d failed.", stAddrStats.lRequests, stAddrStats.lRequestFailures );
+
+  for ( pstEntry = astAddrCache; pstEntry < &astAddrCache[CFG_ZIGBEE_ADDR_CACHE_SIZE]; pstEntry++ )
+  {
+    if ( pstEntry->iNwkAddr != ZB_NWK_ADDR_UNDEFINED )
+    {
+      LOG_INFO_APP( "  0x%08X%08X : 0x%04X, %d uses, confirmed %d s ago.", (uint32_t)( pstEntry->llExtAddr >> 32 ),
+                    (uint32_t)pstEntry->llExtAddr, pstEntry->iNwkAddr, pstEntry->iUses, ( lTick - pstEntry->lConfirmedTick ) / 1000u );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_ADDR_CACHE_SUPPORTED != 0) */
+
+/**
+ * @brief  Address cache not supported.
+ */
+void APP_ZIGBEE_AddrInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Address cache not supported : address map of the stack.
+ */
+uint16_t APP_ZIGBEE_AddrLookupNwk( uint64_t llExtAddr )
+{
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    return ZB_NWK_ADDR_UNDEFINED;
+  }
+
+  return ZbNwkAddrLookupNwk( stZigbeeAppInfo.pstZigbee, llExtAddr );
+}
+
+/**
+ * @brief  Address cache not supported : the destination is not changed.
+ */
+void APP_ZIGBEE_AddrResolve( struct ZbApsAddrT * pstDest )
+{
+  UNUSED( pstDest );
+}
+
+/**
+ * @brief  Address cache not supported : no statistics.
+ */
+const APP_ZIGBEE_AddrStats_t * APP_ZIGBEE_AddrGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_ADDR_CACHE_SUPPORTED != 0) */
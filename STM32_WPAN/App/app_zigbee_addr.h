@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_addr.h
+  * @author  MCD Application Team
+  * @brief   Interface of the address cache (IEEE to short address of the
+  *          unicast destinations).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_ADDR_H
+#define APP_ZIGBEE_ADDR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the address cache */
+typedef struct
+{
+  uint32_t    lLookups;               /* IEEE addresses resolved */
+  uint32_t    lHits;                  /* Resolved from the cache */
+  uint32_t    lMisses;                /* Not in the cache (stack address map, or NWK_addr_req) */
+  uint32_t    lLearned;               /* Entries added (Device_annce, lookups, responses) */
+  uint32_t    lChanged;               /* Short addresses changed (Device_annce, frames, responses) */
+  uint32_t    lEvicted;               /* Least recently used entries replaced */
+  uint32_t    lRequests;              /* NWK_addr_req sent (misses and refreshes) */
+  uint32_t    lRequestFailures;       /* NWK_addr_req refused, failed or without response */
+} APP_ZIGBEE_AddrStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_AddrInit               ( struct ZigBeeT * pstZigbee );
+uint16_t  APP_ZIGBEE_AddrLookupNwk          ( uint64_t llExtAddr );
+void      APP_ZIGBEE_AddrResolve            ( struct ZbApsAddrT * pstDest );
+
+const APP_ZIGBEE_AddrStats_t * APP_ZIGBEE_AddrGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_ADDR_H */
@@ -0,0 +1,369 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_attr.c
+  * @author  MCD Application Team
+  * @brief   Packed attribute store of the application clusters : the const
+  *          descriptors stay in flash and the values of a cluster are kept in
+  *          one block of a static pool, in ZCL format. The stack reaches them
+  *          through the attribute callback, the value being found from its
+  *          descriptor by index : no heap allocation per attribute and no
+  *          list search on the Read Attributes and the report scans.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_attr.h"
+#include "app_zigbee_batch.h"
+#include "serial_cmd_interpreter.h"
+
+#if (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#if ( ( CFG_ZIGBEE_ATTR_STORE_POOL_SIZE % 4u ) != 0 ) || ( CFG_ZIGBEE_ATTR_STORE_POOL_SIZE > 0xFFFFu )
+#error "CFG_ZIGBEE_ATTR_STORE_POOL_SIZE must be a multiple of 4, at most 0xFFFF"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Store of a cluster : the block holds the ( iAttrNb + 1 ) offsets of the values, then the values */
+typedef struct
+{
+  struct ZbZclClusterT      * pstCluster;
+  const struct ZbZclAttrT   * pstAttrList;        /* Descriptors, in the order of the values */
+  uint16_t                  * piOffset;           /* Offset of each value in pcValues, then the end of the values */
+  uint8_t                   * pcValues;
+  uint16_t                    iAttrNb;
+} AttrStore_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t                     alAttrPool[CFG_ZIGBEE_ATTR_STORE_POOL_SIZE / 4u];
+static AttrStore_t                  astAttrStore[CFG_ZIGBEE_ATTR_STORE_MAX];
+static APP_ZIGBEE_AttrStats_t       stAttrStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static AttrStore_t *  AttrStoreFind         ( const struct ZbZclClusterT * pstCluster, const struct ZbZclAttrT * pstAttr );
+static uint32_t       AttrSlotSize          ( const struct ZbZclAttrT * pstAttr );
+static void           AttrPrintStats        ( void );
+
+/* Serial commands of the attribute store */
+static const SerialCmd_t            astAttrSerialCmds[] =
+{
+  { "ATTRSTATS", AttrPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stAttrSerialCmdTable =
+{
+  astAttrSerialCmds, ( sizeof( astAttrSerialCmds ) / sizeof( astAttrSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the attribute store (empty pool) and register its serial command.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_AttrInit( void )
+{
+  memset( astAttrStore, 0, sizeof( astAttrStore ) );
+  memset( &stAttrStats, 0, sizeof( stAttrStats ) );
+
+  Serial_CMD_Interpreter_RegisterTable( &stAttrSerialCmdTable );
+}
+
+/**
+ * @brief  Append to a cluster attributes kept in the store, in place of ZbZclAttrAppendList(). The descriptors shall
+ *         be const (they stay attached to the cluster) and built with APP_ZIGBEE_ATTR_STORE_ENTRY. Their values take
+ *         one block of the pool, initialized to the default value of their type.
+ * @param  pstCluster   Cluster
+ * @param  pstAttrList  Descriptors of the attributes
+ * @param  iAttrNb      Number of attributes
+ * @retval ZCL status.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreAppend( struct ZbZclClusterT * pstCluster, const struct ZbZclAttrT * pstAttrList,
+                                                uint16_t iAttrNb )
+{
+  AttrStore_t           * pstStore;
+  uint8_t               * pcBlock;
+  enum ZclStatusCodeT   eStatus;
+  uint32_t              lIndex, lSlotSize, lBlockSize, lValuesSize = 0;
+
+  if ( ( iAttrNb == 0u ) || ( stAttrStats.iStoreNb >= CFG_ZIGBEE_ATTR_STORE_MAX ) )
+  {
+    return ZCL_STATUS_INSUFFICIENT_SPACE;
+  }
+
+  for ( lIndex = 0; lIndex < iAttrNb; lIndex++ )
+  {
+    lSlotSize = AttrSlotSize( &pstAttrList[lIndex] );
+    if ( ( lSlotSize == 0u ) || ( pstAttrList[lIndex].callback != APP_ZIGBEE_AttrStoreCallback ) )
+    {
+      LOG_ERROR_APP( "Error, attribute 0x%04X not built for the store.", pstAttrList[lIndex].attributeId );
+      return ZCL_STATUS_INVALID_VALUE;
+    }
+    lValuesSize += lSlotSize;
+  }
+
+  lBlockSize = ( ( ( iAttrNb + 1u ) * sizeof( uint16_t ) ) + lValuesSize + 3u ) & ~3u;
+  if ( ( stAttrStats.iPoolUsed + lBlockSize ) > CFG_ZIGBEE_ATTR_STORE_POOL_SIZE )
+  {
+    LOG_ERROR_APP( "Error, attribute store pool full (%d bytes more needed).",
+                   ( stAttrStats.iPoolUsed + lBlockSize - CFG_ZIGBEE_ATTR_STORE_POOL_SIZE ) );
+    return ZCL_STATUS_INSUFFICIENT_SPACE;
+  }
+
+  /* Block taken at the end of the pool, with the offsets first (aligned) */
+  pcBlock = &( (uint8_t *)alAttrPool )[stAttrStats.iPoolUsed];
+  pstStore = &astAttrStore[stAttrStats.iStoreNb];
+  pstStore->pstCluster = pstCluster;
+  pstStore->pstAttrList = pstAttrList;
+  pstStore->piOffset = (uint16_t *)pcBlock;
+  pstStore->pcValues = &pcBlock[( iAttrNb + 1u ) * sizeof( uint16_t )];
+  pstStore->iAttrNb = iAttrNb;
+
+  pstStore->piOffset[0] = 0;
+  for ( lIndex = 0; lIndex < iAttrNb; lIndex++ )
+  {
+    lSlotSize = AttrSlotSize( &pstAttrList[lIndex] );
+    pstStore->piOffset[lIndex + 1u] = (uint16_t)( pstStore->piOffset[lIndex] + lSlotSize );
+    if ( ZbZclAttrDefaultValue( pstAttrList[lIndex].dataType, &pstStore->pcValues[pstStore->piOffset[lIndex]], lSlotSize ) < 0 )
+    {
+      memset( &pstStore->pcValues[pstStore->piOffset[lIndex]], 0, lSlotSize );
+    }
+  }
+
+  /* Store known before the append : the stack may already read or write the values */
+  stAttrStats.iStoreNb++;
+  eStatus = ZbZclAttrAppendList( pstCluster, pstAttrList, iAttrNb );
+  if ( eStatus != ZCL_STATUS_SUCCESS )
+  {
+    stAttrStats.iStoreNb--;
+    memset( pstStore, 0, sizeof( AttrStore_t ) );
+    return eStatus;
+  }
+
+  stAttrStats.iPoolUsed += (uint16_t)lBlockSize;
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Attribute callback of the store : read (Read Attributes, reports, persistence) or write of a value, found
+ *         by the index of its descriptor.
+ * @param  pstCluster   Cluster
+ * @param  pstInfo      Attribute, type of access and ZCL data
+ * @retval ZCL status.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAttrCbInfoT * pstInfo )
+{
+  AttrStore_t   * pstStore;
+  uint8_t       * pcValue;
+  uint32_t      lIndex, lSlotSize;
+  int           iLength;
+
+  pstStore = AttrStoreFind( pstCluster, pstInfo->info );
+  if ( pstStore == NULL )
+  {
+    return ZCL_STATUS_UNSUPP_ATTRIBUTE;
+  }
+
+  lIndex = (uint32_t)( pstInfo->info - pstStore->pstAttrList );
+  pcValue = &pstStore->pcValues[pstStore->piOffset[lIndex]];
+  lSlotSize = (uint32_t)pstStore->piOffset[lIndex + 1u] - pstStore->piOffset[lIndex];
+
+  if ( pstInfo->type == ZCL_ATTR_CB_TYPE_READ )
+  {
+    iLength = ZbZclAttrParseLength( pstInfo->info->dataType, pcValue, lSlotSize, 0 );
+    if ( iLength < 0 )
+    {
+      return ZCL_STATUS_FAILURE;
+    }
+    if ( (uint32_t)iLength > pstInfo->zcl_len )
+    {
+      return ZCL_STATUS_INSUFFICIENT_SPACE;
+    }
+
+    memcpy( pstInfo->zcl_data, pcValue, (uint32_t)iLength );
+    stAttrStats.lReadNb++;
+    return ZCL_STATUS_SUCCESS;
+  }
+
+  iLength = ZbZclAttrParseLength( pstInfo->info->dataType, pstInfo->zcl_data, pstInfo->zcl_len, 0 );
+  if ( ( iLength < 0 ) || ( (uint32_t)iLength > lSlotSize ) )
+  {
+    stAttrStats.lWriteRejectNb++;
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  if ( ( pstInfo->write_mode & ZCL_ATTR_WRITE_FLAG_TEST ) == 0u )
+  {
+    memcpy( pcValue, pstInfo->zcl_data, (uint32_t)iLength );
+    stAttrStats.lWriteNb++;
+    if ( ( pstInfo->info->flags & ZCL_ATTR_FLAG_PERSISTABLE ) != 0u )
+    {
+      APP_ZIGBEE_BatchChange( pstCluster, pstInfo->info->attributeId );
+    }
+  }
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Value of an attribute of the store (ZCL format, little endian), to be updated directly by its cluster : the
+ *         report scans read it from there.
+ * @param  pstCluster   Cluster
+ * @param  iIndex       Index of the attribute in the list given to APP_ZIGBEE_AttrStoreAppend()
+ * @retval Value, NULL if not in the store.
+ */
+uint8_t * APP_ZIGBEE_AttrStoreValue( struct ZbZclClusterT * pstCluster, uint16_t iIndex )
+{
+  uint32_t    lStore;
+
+  for ( lStore = 0; lStore < stAttrStats.iStoreNb; lStore++ )
+  {
+    if ( ( astAttrStore[lStore].pstCluster == pstCluster ) && ( iIndex < astAttrStore[lStore].iAttrNb ) )
+    {
+      return &astAttrStore[lStore].pcValues[astAttrStore[lStore].piOffset[iIndex]];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Return the statistics of the attribute store.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_AttrStats_t * APP_ZIGBEE_AttrGetStats( void )
+{
+  return &stAttrStats;
+}
+
+/**
+ * @brief  Store of an attribute : the one of the cluster whose descriptors hold it.
+ * @param  pstCluster   Cluster
+ * @param  pstAttr      Descriptor of the attribute given to the stack
+ * @retval Store, NULL if not found.
+ */
+static AttrStore_t * AttrStoreFind( const struct ZbZclClusterT * pstCluster, const struct ZbZclAttrT * pstAttr )
+{
+  uint32_t    lStore;
+  uintptr_t   lAttr = (uintptr_t)pstAttr;
+
+  for ( lStore = 0; lStore < stAttrStats.iStoreNb; lStore++ )
+  {
+    if ( ( astAttrStore[lStore].pstCluster == pstCluster ) &&
+         ( lAttr >= (uintptr_t)astAttrStore[lStore].pstAttrList ) &&
+         ( lAttr < (uintptr_t)&astAttrStore[lStore].pstAttrList[astAttrStore[lStore].iAttrNb] ) )
+    {
+      return &astAttrStore[lStore];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Size of the slot of an attribute : its custom size if given (strings, arrays, persistable), else the size
+ *         of its type.
+ * @param  pstAttr  Descriptor of the attribute
+ * @retval Size in bytes, 0 if unknown.
+ */
+static uint32_t AttrSlotSize( const struct ZbZclAttrT * pstAttr )
+{
+  if ( pstAttr->customValSz != 0u )
+  {
+    return pstAttr->customValSz;
+  }
+
+  return ZbZclAttrTypeLength( pstAttr->dataType );
+}
+
+/**
+ * @brief  Print the clusters of the attribute store and its statistics.
+ * @param  None
+ * @retval None
+ */
+static void AttrPrintStats( void )
+{
+  uint32_t    lStore;
+#if (CFG_LOG_SUPPORTED != 0)
+  AttrStore_t * pstStore;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_APP( "Attribute store : %d clusters of %d, pool %d / %d bytes.", stAttrStats.iStoreNb, CFG_ZIGBEE_ATTR_STORE_MAX,
+                stAttrStats.iPoolUsed, CFG_ZIGBEE_ATTR_STORE_POOL_SIZE );
+  for ( lStore = 0; lStore < stAttrStats.iStoreNb; lStore++ )
+  {
+#if (CFG_LOG_SUPPORTED != 0)
+    pstStore = &astAttrStore[lStore];
+    LOG_INFO_APP( "  Cluster 0x%04X (Endpoint %d) : %d attributes, %d bytes.", ZbZclClusterGetClusterId( pstStore->pstCluster ),
+                  ZbZclClusterGetEndpoint( pstStore->pstCluster ), pstStore->iAttrNb, pstStore->piOffset[pstStore->iAttrNb] );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  }
+  LOG_INFO_APP( "  %d reads, %d writes, %d writes rejected.", stAttrStats.lReadNb, stAttrStats.lWriteNb,
+                stAttrStats.lWriteRejectNb );
+}
+
+#else /* (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0) */
+
+/**
+ * @brief  Attribute store not supported.
+ */
+void APP_ZIGBEE_AttrInit( void )
+{
+}
+
+/**
+ * @brief  Attribute store not supported : attributes kept by the stack.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreAppend( struct ZbZclClusterT * pstCluster, const struct ZbZclAttrT * pstAttrList,
+                                                uint16_t iAttrNb )
+{
+  return ZbZclAttrAppendList( pstCluster, pstAttrList, iAttrNb );
+}
+
+/**
+ * @brief  Attribute store not supported : no attribute.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAttrCbInfoT * pstInfo )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstInfo );
+
+  return ZCL_STATUS_UNSUPP_ATTRIBUTE;
+}
+
+/**
+ * @brief  Attribute store not supported : no value.
+ */
+uint8_t * APP_ZIGBEE_AttrStoreValue( struct ZbZclClusterT * pstCluster, uint16_t iIndex )
+{
+  UNUSED( pstCluster );
+  UNUSED( iIndex );
+
+  return NULL;
+}
+
+/**
+ * @brief  Attribute store not supported : no statistics.
+ */
+const APP_ZIGBEE_AttrStats_t * APP_ZIGBEE_AttrGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0) */
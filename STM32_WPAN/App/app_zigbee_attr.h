@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_attr.h
+  * @author  MCD Application Team
+  * @brief   Interface of the packed attribute store of the application clusters.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_ATTR_H
+#define APP_ZIGBEE_ATTR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported macros -----------------------------------------------------------*/
+/* Descriptor (const) of an attribute kept in the store. _SIZE_ is the size of the string/array types (ZCL format,
+ * length included), 0 for the other types */
+#if (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0)
+#define APP_ZIGBEE_ATTR_STORE_ENTRY( _ID_, _TYPE_, _FLAGS_, _SIZE_ ) \
+  { (_ID_), (_TYPE_), ( (_FLAGS_) | ZCL_ATTR_FLAG_CB_READ | ZCL_ATTR_FLAG_CB_WRITE ), (_SIZE_), \
+    APP_ZIGBEE_AttrStoreCallback, { 0, 0 }, { 0, 0 } }
+#else /* (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0) */
+#define APP_ZIGBEE_ATTR_STORE_ENTRY( _ID_, _TYPE_, _FLAGS_, _SIZE_ ) \
+  { (_ID_), (_TYPE_), (_FLAGS_), (_SIZE_), NULL, { 0, 0 }, { 0, 0 } }
+#endif /* (CFG_ZIGBEE_ATTR_STORE_SUPPORTED != 0) */
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the attribute store */
+typedef struct
+{
+  uint32_t    lReadNb;                /* Values read (Read Attributes, reports) */
+  uint32_t    lWriteNb;               /* Values written */
+  uint32_t    lWriteRejectNb;         /* Values rejected (longer than their slot) */
+  uint16_t    iStoreNb;               /* Clusters using the store */
+  uint16_t    iPoolUsed;              /* Bytes of the pool used */
+} APP_ZIGBEE_AttrStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_AttrInit               ( void );
+
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreAppend  ( struct ZbZclClusterT * pstCluster, const struct ZbZclAttrT * pstAttrList,
+                                                  uint16_t iAttrNb );
+enum ZclStatusCodeT APP_ZIGBEE_AttrStoreCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAttrCbInfoT * pstInfo );
+uint8_t * APP_ZIGBEE_AttrStoreValue         ( struct ZbZclClusterT * pstCluster, uint16_t iIndex );
+
+const APP_ZIGBEE_AttrStats_t * APP_ZIGBEE_AttrGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_ATTR_H */
@@ -0,0 +1,315 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_batch.c
+  * @author  MCD Application Team
+  * @brief   Batched persistence of the attributes : the changes of the
+  *          persistable attributes of several clusters (OnOff, Level, Color,
+  *          Write Attributes of a controller) are collected, then given to
+  *          the stack and saved in one write of the persistence image after
+  *          a quiet period or a maximum latency, instead of a persistence
+  *          request at each change during the automation sequences.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_batch.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#if (CFG_ZIGBEE_PERSIST_BATCH_SUPPORTED != 0)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  struct ZbZclClusterT  * pstCluster;
+  uint16_t              iAttrId;
+} BatchAttr_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_BatchStats_t  stBatchStats;
+static BatchAttr_t              astBatchAttr[CFG_ZIGBEE_PERSIST_BATCH_ATTR_NB];
+static UTIL_TIMER_Object_t      stBatchTimer;
+static uint32_t                 lBatchFirstTick;      /* Time of the first change of the open batch */
+static bool                     bBatchOpen;
+static bool                     bBatchFlushing;       /* Notifications of ZbZclAttrPersist : saved by the flush */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BatchTask               ( void );
+static void     BatchTimerElapsed       ( void * arg );
+static void     BatchFlushRequest       ( void );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialization of the batches.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BatchInit( void )
+{
+  UTIL_TIMER_Create( &stBatchTimer, CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY, UTIL_TIMER_ONESHOT, &BatchTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSIST_BATCH ), UTIL_SEQ_RFU, BatchTask );
+}
+
+/**
+ * @brief  Change of a persistable attribute on the network : added to the batch (once), that is flushed after the
+ *         quiet period, the maximum latency or at once when full.
+ * @param  pstCluster  Cluster of the attribute
+ * @param  iAttrId     Attribute
+ * @retval None
+ */
+void APP_ZIGBEE_BatchChange( struct ZbZclClusterT * pstCluster, uint16_t iAttrId )
+{
+  uint32_t  lNow = HAL_GetTick();
+  uint16_t  iIndex;
+
+  /* Off the network, nothing to save (the image is restored or written by the Startup) */
+  if ( ( pstCluster == NULL ) || ( APP_ZIGBEE_IsAppliJoinNetwork() == false ) )
+  {
+    return;
+  }
+
+  stBatchStats.lChangeNb++;
+  if ( bBatchOpen == false )
+  {
+    bBatchOpen = true;
+    lBatchFirstTick = lNow;
+  }
+
+  for ( iIndex = 0; iIndex < stBatchStats.iPendingNb; iIndex++ )
+  {
+    if ( ( astBatchAttr[iIndex].pstCluster == pstCluster ) && ( astBatchAttr[iIndex].iAttrId == iAttrId ) )
+    {
+      stBatchStats.lMergedNb++;
+      break;
+    }
+  }
+
+  if ( iIndex == stBatchStats.iPendingNb )
+  {
+    if ( stBatchStats.iPendingNb == CFG_ZIGBEE_PERSIST_BATCH_ATTR_NB )
+    {
+      /* Flush already requested : this one is given to the stack at once, saved with the batch */
+      (void)ZbZclAttrPersist( pstCluster, iAttrId );
+      stBatchStats.lOverflowNb++;
+      return;
+    }
+
+    astBatchAttr[iIndex].pstCluster = pstCluster;
+    astBatchAttr[iIndex].iAttrId = iAttrId;
+    stBatchStats.iPendingNb++;
+    stBatchStats.iPendingMax = MAX( stBatchStats.iPendingMax, stBatchStats.iPendingNb );
+
+    if ( stBatchStats.iPendingNb == CFG_ZIGBEE_PERSIST_BATCH_ATTR_NB )
+    {
+      stBatchStats.lFullFlushNb++;
+      BatchFlushRequest();
+      return;
+    }
+  }
+
+  /* A new change restarts the quiet period, until the maximum latency */
+  if ( ( lNow - lBatchFirstTick ) <= ( CFG_ZIGBEE_PERSIST_BATCH_MAX_DELAY - CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY ) )
+  {
+    UTIL_TIMER_StartWithPeriod( &stBatchTimer, CFG_ZIGBEE_PERSIST_BATCH_QUIET_DELAY );
+  }
+}
+
+/**
+ * @brief  Persistence notification of the stack : merged in the open batch (or in the flush in progress), the image
+ *         being saved at its flush.
+ * @param  None
+ * @retval True if merged, else the notification follows its own debounce.
+ */
+bool APP_ZIGBEE_BatchMergeNotify( void )
+{
+  if ( ( bBatchOpen == false ) && ( bBatchFlushing == false ) )
+  {
+    return false;
+  }
+
+  stBatchStats.lNotifyMergedNb++;
+  return true;
+}
+
+/**
+ * @brief  Flush of the open batch, without waiting for its delay.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BatchFlush( void )
+{
+  if ( bBatchOpen != false )
+  {
+    BatchFlushRequest();
+  }
+}
+
+/**
+ * @brief  Statistics of the batches.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_BatchStats_t * APP_ZIGBEE_BatchGetStats( void )
+{
+  return &stBatchStats;
+}
+
+/**
+ * @brief  Batch serial commands : PERSISTBATCH (statistics), PERSISTBATCH FLUSH.
+ * @param  szCommand  Command received
+ * @retval True if the command is a batch command.
+ */
+bool APP_ZIGBEE_BatchSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "PERSISTBATCH FLUSH" ) == 0 )
+  {
+    LOG_INFO_APP( "Persistence batch : %d attributes flushed.", stBatchStats.iPendingNb );
+    APP_ZIGBEE_BatchFlush();
+    return true;
+  }
+
+  if ( strcmp( szCommand, "PERSISTBATCH" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "Persistence batch : %u changes (%u merged, %u overflows), %u stack notifications merged.",
+                stBatchStats.lChangeNb, stBatchStats.lMergedNb, stBatchStats.lOverflowNb, stBatchStats.lNotifyMergedNb );
+  LOG_INFO_APP( "Persistence batch : %u flushes (%u full), %u attributes saved, %u not persistable, %d pending (max %d).",
+                stBatchStats.lFlushNb, stBatchStats.lFullFlushNb, stBatchStats.lPersistNb, stBatchStats.lNotPersistableNb,
+                stBatchStats.iPendingNb, stBatchStats.iPendingMax );
+
+  return true;
+}
+
+/**
+ * @brief  Flush of the batch : attributes given to the stack, then one save of the persistence image.
+ * @param  None
+ * @retval None
+ */
+static void BatchTask( void )
+{
+  uint16_t  iIndex;
+
+  if ( bBatchOpen == false )
+  {
+    return;
+  }
+
+  UTIL_TIMER_Stop( &stBatchTimer );
+
+  /* The notifications of ZbZclAttrPersist are covered by the save below */
+  bBatchFlushing = true;
+  for ( iIndex = 0; iIndex < stBatchStats.iPendingNb; iIndex++ )
+  {
+    if ( ZbZclAttrPersist( astBatchAttr[iIndex].pstCluster, astBatchAttr[iIndex].iAttrId ) != false )
+    {
+      stBatchStats.lPersistNb++;
+    }
+    else
+    {
+      stBatchStats.lNotPersistableNb++;
+    }
+  }
+
+  stBatchStats.iPendingNb = 0;
+  stBatchStats.lFlushNb++;
+  bBatchOpen = false;
+
+  (void)APP_ZIGBEE_PersistenceSave();
+  bBatchFlushing = false;
+}
+
+/**
+ * @brief  End of the quiet period or of the maximum latency (IRQ context) : flush by the task.
+ * @param  arg  Not used
+ * @retval None
+ */
+static void BatchTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSIST_BATCH ), TASK_PRIO_ZIGBEE_PERSIST_BATCH );
+}
+
+/**
+ * @brief  Flush of the batch requested at once.
+ * @param  None
+ * @retval None
+ */
+static void BatchFlushRequest( void )
+{
+  UTIL_TIMER_Stop( &stBatchTimer );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_PERSIST_BATCH ), TASK_PRIO_ZIGBEE_PERSIST_BATCH );
+}
+
+#else /* (CFG_ZIGBEE_PERSIST_BATCH_SUPPORTED != 0) */
+
+/**
+ * @brief  Batched persistence not supported : nothing to initialize.
+ */
+void APP_ZIGBEE_BatchInit( void )
+{
+}
+
+/**
+ * @brief  Batched persistence not supported : the change is given to the stack at once.
+ */
+void APP_ZIGBEE_BatchChange( struct ZbZclClusterT * pstCluster, uint16_t iAttrId )
+{
+  if ( pstCluster != NULL )
+  {
+    (void)ZbZclAttrPersist( pstCluster, iAttrId );
+  }
+}
+
+/**
+ * @brief  Batched persistence not supported : notifications follow their own debounce.
+ */
+bool APP_ZIGBEE_BatchMergeNotify( void )
+{
+  return false;
+}
+
+/**
+ * @brief  Batched persistence not supported : nothing to flush.
+ */
+void APP_ZIGBEE_BatchFlush( void )
+{
+}
+
+/**
+ * @brief  Batched persistence not supported : no command.
+ */
+bool APP_ZIGBEE_BatchSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Batched persistence not supported : no statistics.
+ */
+const APP_ZIGBEE_BatchStats_t * APP_ZIGBEE_BatchGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_PERSIST_BATCH_SUPPORTED != 0) */
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_batch.h
+  * @author  MCD Application Team
+  * @brief   Interface of the batched persistence of the attributes.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_BATCH_H
+#define APP_ZIGBEE_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the batches */
+typedef struct
+{
+  uint32_t    lChangeNb;              /* Attribute changes given to the batch */
+  uint32_t    lMergedNb;              /* Changes of an attribute already in the batch */
+  uint32_t    lNotifyMergedNb;        /* Stack persistence notifications merged in a batch */
+  uint32_t    lOverflowNb;            /* Changes given to the stack at once (batch full) */
+  uint32_t    lFlushNb;               /* Batches flushed (one save of the persistence image each) */
+  uint32_t    lFullFlushNb;           /* Batches flushed before their delay (full) */
+  uint32_t    lPersistNb;             /* Attributes given to the stack */
+  uint32_t    lNotPersistableNb;      /* Attributes refused by the stack (not persistable) */
+  uint16_t    iPendingNb;             /* Attributes in the open batch */
+  uint16_t    iPendingMax;            /* Most attributes in a batch */
+} APP_ZIGBEE_BatchStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_BatchInit              ( void );
+void      APP_ZIGBEE_BatchChange            ( struct ZbZclClusterT * pstCluster, uint16_t iAttrId );
+bool      APP_ZIGBEE_BatchMergeNotify       ( void );
+void      APP_ZIGBEE_BatchFlush             ( void );
+bool      APP_ZIGBEE_BatchSerialCmdExecute  ( const char * szCommand );
+
+const APP_ZIGBEE_BatchStats_t * APP_ZIGBEE_BatchGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_BATCH_H */
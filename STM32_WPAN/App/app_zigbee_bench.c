@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_bench.c
+  * @author  MCD Application Team
+  * @brief   Zigbee stack variant benchmark : the figures compared between the
+  *          R22, R22 Smart Energy and R23 builds (time of the Startup, latency
+  *          of the Toggle, APS throughput of the traffic generator, peak of
+  *          the Zigbee heap) are printed in CSV on the trace UART, the memory
+  *          footprint being given by the report of the build.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_bench.h"
+#include "app_zigbee_latency.h"
+#include "app_zigbee_traffic.h"
+
+#include "serial_cmd_interpreter.h"
+#include "zigbee_plat.h"
+
+#if (CFG_ZIGBEE_BENCH_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_ZCL_HEADER_SIZE           (3u)          /* Frame control, sequence, command of the Toggle */
+
+#if (CONFIG_ZB_REV >= 23)
+#define BENCH_STACK_REVISION            "R23"
+#else
+#define BENCH_STACK_REVISION            "R22"
+#endif
+
+#if (CFG_ZIGBEE_STACK_SE != 0)
+#define BENCH_STACK_VARIANT             BENCH_STACK_REVISION "_SE_FFD"
+#elif (CFG_ZIGBEE_SED_SUPPORTED != 0)
+#define BENCH_STACK_VARIANT             BENCH_STACK_REVISION "_RFD"
+#else
+#define BENCH_STACK_VARIANT             BENCH_STACK_REVISION "_FFD"
+#endif
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BenchPrintResults       ( void );
+
+/* Private variables ---------------------------------------------------------*/
+/* Serial commands of the benchmark */
+static const SerialCmd_t            astBenchSerialCmds[] =
+{
+  { "STACKBENCH", BenchPrintResults, NULL },
+};
+
+static SerialCmdTable_t             stBenchSerialCmdTable =
+{
+  astBenchSerialCmds, ( sizeof( astBenchSerialCmds ) / sizeof( astBenchSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the benchmark summary : its serial command.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BenchInit( void )
+{
+  Serial_CMD_Interpreter_RegisterTable( &stBenchSerialCmdTable );
+}
+
+/**
+ * @brief  STACKBENCH command : figures of the stack variant in CSV, to be collected with the memory report of the
+ *         build (see stack_bench.py). The Toggle latency is the one of the first destination (LATRESET before the
+ *         run), the throughput the one of the last run of the traffic generator.
+ * @param  None
+ * @retval None
+ */
+static void BenchPrintResults( void )
+{
+  const APP_ZIGBEE_LatencyStats_t   * pstLatency = APP_ZIGBEE_LatencyGetStats( 0 );
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_TrafficReport_t  * pstReport = APP_ZIGBEE_TrafficGetReport();
+  const APP_ZIGBEE_TrafficConfig_t  * pstConfig = APP_ZIGBEE_TrafficGetConfig();
+  uint32_t                            lThroughput = 0;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  ZigbeePlatHeapStats_t               stHeapStats;
+  uint32_t                            lHeapPeak = 0, lId;
+
+#if (CFG_LOG_SUPPORTED != 0)
+  if ( ( pstReport != NULL ) && ( pstConfig != NULL ) && ( pstReport->lRunTime != 0u ) )
+  {
+    lThroughput = (uint32_t)( ( (uint64_t)pstReport->lSuccess * ( BENCH_ZCL_HEADER_SIZE + pstConfig->cPayloadSize ) * 8000u )
+                              / pstReport->lRunTime );
+  }
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  for ( lId = 0u; lId <= AMM_CONF_VIRTUAL_ID_MAX; lId++ )
+  {
+    if ( ZIGBEE_PLAT_GetHeapStats( (uint8_t)lId, &stHeapStats ) == true )
+    {
+      lHeapPeak += stHeapStats.lPeakSize;
+    }
+  }
+
+  LOG_INFO_APP( "STACKBENCH,stack,%s,revision,%d", BENCH_STACK_VARIANT, CONFIG_ZB_REV );
+  LOG_INFO_APP( "STACKBENCH,metric,value,unit" );
+  LOG_INFO_APP( "STACKBENCH,join_time,%d,ms", stZigbeeAppInfo.stJoinStats.lLastJoinTime );
+  LOG_INFO_APP( "STACKBENCH,join_attempts,%d,", stZigbeeAppInfo.stJoinStats.lAttempts );
+  if ( ( pstLatency != NULL ) && ( pstLatency->lNumber != 0u ) )
+  {
+    LOG_INFO_APP( "STACKBENCH,toggle_avg,%d,ms", ( pstLatency->lSum / pstLatency->lNumber ) );
+    LOG_INFO_APP( "STACKBENCH,toggle_p50,%d,ms", APP_ZIGBEE_LatencyGetPercentile( pstLatency, 50u ) );
+    LOG_INFO_APP( "STACKBENCH,toggle_p99,%d,ms", APP_ZIGBEE_LatencyGetPercentile( pstLatency, 99u ) );
+  }
+  LOG_INFO_APP( "STACKBENCH,aps_throughput,%d,bps", lThroughput );
+  LOG_INFO_APP( "STACKBENCH,aps_success,%d,", ( ( pstReport != NULL ) ? pstReport->lSuccess : 0u ) );
+  LOG_INFO_APP( "STACKBENCH,heap_peak,%d,bytes", lHeapPeak );
+  LOG_INFO_APP( "STACKBENCH,end" );
+}
+
+#else /* (CFG_ZIGBEE_BENCH_SUPPORTED != 0) */
+
+/**
+ * @brief  Stack variant benchmark not supported.
+ */
+void APP_ZIGBEE_BenchInit( void )
+{
+}
+
+#endif /* (CFG_ZIGBEE_BENCH_SUPPORTED != 0) */
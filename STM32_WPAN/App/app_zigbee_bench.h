@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_bench.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Zigbee stack variant benchmark summary.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_BENCH_H
+#define APP_ZIGBEE_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_BenchInit              ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_BENCH_H */
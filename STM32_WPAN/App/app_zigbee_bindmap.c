@@ -0,0 +1,697 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_bindmap.c
+  * @author  MCD Application Team
+  * @brief   Indexed mirror of the APS binding and group tables : the bound
+  *          destinations of a cluster and the group memberships are found in
+  *          one hash bucket, instead of a walk of the stack tables.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_bindmap.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.aps.h"
+#include "zigbee.zdo.h"
+#include "zcl/zcl.enum.h"
+
+#if (CFG_ZIGBEE_BINDMAP_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define BINDMAP_NO_NODE                 (0xFFu)
+#define BINDMAP_BUCKET_MASK             ( CFG_ZIGBEE_BINDMAP_BUCKETS - 1u )
+
+/* Fibonacci hash of a key on the buckets */
+#define BINDMAP_HASH(_key_)             ( (uint8_t)( ( (uint32_t)(_key_) * 0x9E3779B1u ) >> 24u ) & BINDMAP_BUCKET_MASK )
+
+/* Keys : source endpoint and cluster of a binding, group and endpoint of a membership */
+#define BINDMAP_BIND_KEY(_ep_, _cl_)    ( ( (uint32_t)(_cl_) << 8u ) | (uint32_t)(_ep_) )
+#define BINDMAP_GROUP_KEY(_gr_, _ep_)   ( ( (uint32_t)(_gr_) << 8u ) | (uint32_t)(_ep_) )
+#define BINDMAP_KEY_ENDPOINT(_key_)     ( (uint8_t)( (_key_) & 0xFFu ) )
+#define BINDMAP_KEY_HIGH(_key_)         ( (uint16_t)( (_key_) >> 8u ) )
+
+#if ( ( CFG_ZIGBEE_BINDMAP_BUCKETS & BINDMAP_BUCKET_MASK ) != 0 )
+#error "CFG_ZIGBEE_BINDMAP_BUCKETS shall be a power of 2"
+#endif
+#if ( CFG_ZIGBEE_BINDMAP_BIND_MAX >= BINDMAP_NO_NODE ) || ( CFG_ZIGBEE_BINDMAP_GROUP_MAX >= BINDMAP_NO_NODE )
+#error "CFG_ZIGBEE_BINDMAP_BIND_MAX and CFG_ZIGBEE_BINDMAP_GROUP_MAX shall be less than 255"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Chained hash index : the nodes are the entries of the arrays of the mirror */
+typedef struct
+{
+  uint8_t     acHead[CFG_ZIGBEE_BINDMAP_BUCKETS];   /* First node of each bucket */
+  uint8_t *   pcNext;                               /* Next node of each node (bucket or free list) */
+  uint32_t *  plKey;                                /* Key of each node */
+  uint8_t     cSize;                                /* Number of nodes */
+  uint8_t     cFree;                                /* First free node */
+  uint16_t    iUsed;                                /* Number of nodes used */
+} BindMapIndex_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t                      acBindMapBindNext[CFG_ZIGBEE_BINDMAP_BIND_MAX];
+static uint32_t                     alBindMapBindKey[CFG_ZIGBEE_BINDMAP_BIND_MAX];
+static struct ZbApsAddrT            astBindMapBindDest[CFG_ZIGBEE_BINDMAP_BIND_MAX];
+static uint8_t                      acBindMapGroupNext[CFG_ZIGBEE_BINDMAP_GROUP_MAX];
+static uint32_t                     alBindMapGroupKey[CFG_ZIGBEE_BINDMAP_GROUP_MAX];
+
+static BindMapIndex_t               stBindMapBind = { { 0 }, acBindMapBindNext, alBindMapBindKey, CFG_ZIGBEE_BINDMAP_BIND_MAX, 0, 0 };
+static BindMapIndex_t               stBindMapGroup = { { 0 }, acBindMapGroupNext, alBindMapGroupKey, CFG_ZIGBEE_BINDMAP_GROUP_MAX, 0, 0 };
+
+static APP_ZIGBEE_BindMapStats_t    stBindMapStats;
+static struct ZbMsgFilterT *        pstBindMapFilter;
+static bool                         bBindMapStale = true;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BindMapIndexReset       ( BindMapIndex_t * pstIndex );
+static uint8_t  BindMapIndexInsert      ( BindMapIndex_t * pstIndex, uint32_t lKey, uint8_t cBucket );
+static void     BindMapIndexRemove      ( BindMapIndex_t * pstIndex, uint8_t cNode, uint8_t cBucket );
+static uint8_t  BindMapFindBinding      ( uint32_t lKey, const struct ZbApsAddrT * pstDest );
+static uint8_t  BindMapFindGroup        ( uint16_t iGroupAddr, uint8_t cEndpoint );
+static bool     BindMapIsSameDest       ( const struct ZbApsAddrT * pstDest1, const struct ZbApsAddrT * pstDest2 );
+static void     BindMapRefresh          ( void );
+static void     BindMapPrintStats       ( void );
+static enum zb_msg_filter_rc BindMapDataIndCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the mirror */
+static const SerialCmd_t            astBindMapSerialCmds[] =
+{
+  { "BINDSTATS", BindMapPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stBindMapSerialCmdTable =
+{
+  astBindMapSerialCmds, ( sizeof( astBindMapSerialCmds ) / sizeof( astBindMapSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the mirror : empty, built from the stack tables at the first lookup after the network start.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BindMapInit( void )
+{
+  BindMapIndexReset( &stBindMapBind );
+  BindMapIndexReset( &stBindMapGroup );
+  bBindMapStale = true;
+
+  Serial_CMD_Interpreter_RegisterTable( &stBindMapSerialCmdTable );
+}
+
+/**
+ * @brief  Build again the mirror from the binding and group tables of the stack (network started, or tables
+ *         changed by a remote request). The remote requests are watched from there.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BindMapRebuild( void )
+{
+  struct ZbApsmeBindT   stBinding;
+  struct ZbApsmeGroupT  stGroup;
+  uint64_t              dlExtAddr;
+  uint32_t              lKey;
+  uint8_t               cNode;
+  unsigned int          iIndex;
+
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    return;
+  }
+
+  if ( pstBindMapFilter == NULL )
+  {
+    pstBindMapFilter = ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ZB_MSG_FILTER_APSDE_DATA_IND, ( ZB_MSG_DEFAULT_PRIO + 1u ),
+                                            BindMapDataIndCallback, NULL );
+  }
+
+  BindMapIndexReset( &stBindMapBind );
+  BindMapIndexReset( &stBindMapGroup );
+  bBindMapStale = false;
+  stBindMapStats.lRebuilds++;
+
+  /* Bindings of this device (the entries of other sources are not sent by it) */
+  dlExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  for ( iIndex = 0; ZbApsGetIndex( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_BINDING_TABLE, &stBinding, sizeof( stBinding ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( stBinding.srcExtAddr != dlExtAddr )
+    {
+      continue;
+    }
+
+    lKey = BINDMAP_BIND_KEY( stBinding.srcEndpt, stBinding.clusterId );
+    cNode = BindMapIndexInsert( &stBindMapBind, lKey, BINDMAP_HASH( lKey ) );
+    if ( cNode == BINDMAP_NO_NODE )
+    {
+      stBindMapStats.lOverflows++;
+      continue;
+    }
+
+    astBindMapBindDest[cNode] = stBinding.dst;
+  }
+
+  for ( iIndex = 0; ZbApsGetIndex( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_GROUP_TABLE, &stGroup, sizeof( stGroup ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    /* Free entries have no endpoint */
+    if ( ( stGroup.endpoint == 0u ) || ( stGroup.endpoint == ZB_ENDPOINT_BCAST ) )
+    {
+      continue;
+    }
+
+    if ( BindMapIndexInsert( &stBindMapGroup, BINDMAP_GROUP_KEY( stGroup.groupAddr, stGroup.endpoint ), BINDMAP_HASH( stGroup.groupAddr ) ) == BINDMAP_NO_NODE )
+    {
+      stBindMapStats.lOverflows++;
+    }
+  }
+}
+
+/**
+ * @brief  Indicate if an endpoint is member of a group (like ZbApsGroupIsMember, from one bucket of the mirror).
+ * @param  iGroupAddr   Group
+ * @param  cEndpoint    Endpoint, or ZB_ENDPOINT_BCAST for any endpoint
+ * @retval True if member.
+ */
+bool APP_ZIGBEE_BindMapIsGroupMember( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  stBindMapStats.lLookups++;
+  BindMapRefresh();
+
+  return ( BindMapFindGroup( iGroupAddr, cEndpoint ) != BINDMAP_NO_NODE );
+}
+
+/**
+ * @brief  Copy the bound destinations of a cluster of this device (from one bucket of the mirror).
+ * @param  cEndpoint    Source endpoint
+ * @param  iClusterId   Cluster
+ * @param  pstDestList  List filled with the destinations
+ * @param  iDestMax     Size of the list
+ * @retval Number of destinations copied.
+ */
+uint16_t APP_ZIGBEE_BindMapGetDestinations( uint8_t cEndpoint, uint16_t iClusterId, struct ZbApsAddrT * pstDestList, uint16_t iDestMax )
+{
+  uint32_t  lKey = BINDMAP_BIND_KEY( cEndpoint, iClusterId );
+  uint16_t  iNumber = 0;
+  uint8_t   cNode;
+
+  stBindMapStats.lLookups++;
+  BindMapRefresh();
+
+  for ( cNode = stBindMapBind.acHead[BINDMAP_HASH( lKey )]; ( cNode != BINDMAP_NO_NODE ) && ( iNumber < iDestMax ); cNode = stBindMapBind.pcNext[cNode] )
+  {
+    if ( stBindMapBind.plKey[cNode] == lKey )
+    {
+      pstDestList[iNumber++] = astBindMapBindDest[cNode];
+    }
+  }
+
+  return iNumber;
+}
+
+/**
+ * @brief  Add an endpoint to a group (APSME-ADD-GROUP), and to the mirror.
+ * @param  iGroupAddr   Group
+ * @param  cEndpoint    Endpoint
+ * @retval Status of the APSME-ADD-GROUP.confirm.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapAddGroup( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  struct ZbApsmeAddGroupReqT  stRequest;
+  struct ZbApsmeAddGroupConfT stConfirm;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.groupAddr = iGroupAddr;
+  stRequest.endpt = cEndpoint;
+  ZbApsmeAddGroupReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  if ( ( stConfirm.status == ZB_STATUS_SUCCESS ) && ( bBindMapStale == false ) && ( BindMapFindGroup( iGroupAddr, cEndpoint ) == BINDMAP_NO_NODE ) )
+  {
+    if ( BindMapIndexInsert( &stBindMapGroup, BINDMAP_GROUP_KEY( iGroupAddr, cEndpoint ), BINDMAP_HASH( iGroupAddr ) ) == BINDMAP_NO_NODE )
+    {
+      stBindMapStats.lOverflows++;
+    }
+  }
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Remove an endpoint from a group (APSME-REMOVE-GROUP), and from the mirror.
+ * @param  iGroupAddr   Group
+ * @param  cEndpoint    Endpoint
+ * @retval Status of the APSME-REMOVE-GROUP.confirm.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapRemoveGroup( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  struct ZbApsmeRemoveGroupReqT   stRequest;
+  struct ZbApsmeRemoveGroupConfT  stConfirm;
+  uint8_t                         cNode;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.groupAddr = iGroupAddr;
+  stRequest.endpt = cEndpoint;
+  ZbApsmeRemoveGroupReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  if ( ( stConfirm.status == ZB_STATUS_SUCCESS ) && ( bBindMapStale == false ) )
+  {
+    cNode = BindMapFindGroup( iGroupAddr, cEndpoint );
+    if ( cNode != BINDMAP_NO_NODE )
+    {
+      BindMapIndexRemove( &stBindMapGroup, cNode, BINDMAP_HASH( iGroupAddr ) );
+    }
+  }
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Bind a cluster of this device to a destination (APSME-BIND), and add it to the mirror.
+ * @param  cEndpoint    Source endpoint
+ * @param  iClusterId   Cluster
+ * @param  pstDest      Destination (extended address and endpoint, or group)
+ * @retval Status of the APSME-BIND.confirm.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapBind( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest )
+{
+  struct ZbApsmeBindReqT  stRequest;
+  struct ZbApsmeBindConfT stConfirm;
+  uint32_t                lKey = BINDMAP_BIND_KEY( cEndpoint, iClusterId );
+  uint8_t                 cNode;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.srcExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  stRequest.srcEndpt = cEndpoint;
+  stRequest.clusterId = iClusterId;
+  stRequest.dst = *pstDest;
+  ZbApsmeBindReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  if ( ( stConfirm.status == ZB_STATUS_SUCCESS ) && ( bBindMapStale == false ) && ( BindMapFindBinding( lKey, pstDest ) == BINDMAP_NO_NODE ) )
+  {
+    cNode = BindMapIndexInsert( &stBindMapBind, lKey, BINDMAP_HASH( lKey ) );
+    if ( cNode == BINDMAP_NO_NODE )
+    {
+      stBindMapStats.lOverflows++;
+    }
+    else
+    {
+      astBindMapBindDest[cNode] = *pstDest;
+    }
+  }
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Unbind a cluster of this device from a destination (APSME-UNBIND), and remove it from the mirror.
+ * @param  cEndpoint    Source endpoint
+ * @param  iClusterId   Cluster
+ * @param  pstDest      Destination (extended address and endpoint, or group)
+ * @retval Status of the APSME-UNBIND.confirm.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapUnbind( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest )
+{
+  struct ZbApsmeUnbindReqT  stRequest;
+  struct ZbApsmeUnbindConfT stConfirm;
+  uint32_t                  lKey = BINDMAP_BIND_KEY( cEndpoint, iClusterId );
+  uint8_t                   cNode;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.srcExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  stRequest.srcEndpt = cEndpoint;
+  stRequest.clusterId = iClusterId;
+  stRequest.dst = *pstDest;
+  ZbApsmeUnbindReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  if ( ( stConfirm.status == ZB_STATUS_SUCCESS ) && ( bBindMapStale == false ) )
+  {
+    cNode = BindMapFindBinding( lKey, pstDest );
+    if ( cNode != BINDMAP_NO_NODE )
+    {
+      BindMapIndexRemove( &stBindMapBind, cNode, BINDMAP_HASH( lKey ) );
+    }
+  }
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Return the statistics of the mirror.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_BindMapStats_t * APP_ZIGBEE_BindMapGetStats( void )
+{
+  stBindMapStats.iBindings = stBindMapBind.iUsed;
+  stBindMapStats.iGroups = stBindMapGroup.iUsed;
+
+  return &stBindMapStats;
+}
+
+/**
+ * @brief  Empty an index : all its nodes in the free list.
+ * @param  pstIndex   Index
+ * @retval None
+ */
+static void BindMapIndexReset( BindMapIndex_t * pstIndex )
+{
+  uint8_t   cNode;
+
+  memset( pstIndex->acHead, BINDMAP_NO_NODE, sizeof( pstIndex->acHead ) );
+  for ( cNode = 0; cNode < pstIndex->cSize; cNode++ )
+  {
+    pstIndex->pcNext[cNode] = ( cNode + 1u );
+  }
+
+  pstIndex->pcNext[pstIndex->cSize - 1u] = BINDMAP_NO_NODE;
+  pstIndex->cFree = 0;
+  pstIndex->iUsed = 0;
+}
+
+/**
+ * @brief  Add a node to an index.
+ * @param  pstIndex   Index
+ * @param  lKey       Key of the node
+ * @param  cBucket    Bucket of the key
+ * @retval Node added, BINDMAP_NO_NODE if the index is full.
+ */
+static uint8_t BindMapIndexInsert( BindMapIndex_t * pstIndex, uint32_t lKey, uint8_t cBucket )
+{
+  uint8_t   cNode = pstIndex->cFree;
+
+  if ( cNode == BINDMAP_NO_NODE )
+  {
+    return BINDMAP_NO_NODE;
+  }
+
+  pstIndex->cFree = pstIndex->pcNext[cNode];
+  pstIndex->plKey[cNode] = lKey;
+  pstIndex->pcNext[cNode] = pstIndex->acHead[cBucket];
+  pstIndex->acHead[cBucket] = cNode;
+  pstIndex->iUsed++;
+
+  return cNode;
+}
+
+/**
+ * @brief  Remove a node from an index.
+ * @param  pstIndex   Index
+ * @param  cNode      Node to remove
+ * @param  cBucket    Bucket of its key
+ * @retval None
+ */
+static void BindMapIndexRemove( BindMapIndex_t * pstIndex, uint8_t cNode, uint8_t cBucket )
+{
+  uint8_t * pcLink = &pstIndex->acHead[cBucket];
+
+  while ( ( *pcLink != BINDMAP_NO_NODE ) && ( *pcLink != cNode ) )
+  {
+    pcLink = &pstIndex->pcNext[*pcLink];
+  }
+
+  if ( *pcLink == BINDMAP_NO_NODE )
+  {
+    return;
+  }
+
+  *pcLink = pstIndex->pcNext[cNode];
+  pstIndex->pcNext[cNode] = pstIndex->cFree;
+  pstIndex->cFree = cNode;
+  pstIndex->iUsed--;
+}
+
+/**
+ * @brief  Find a binding in the mirror.
+ * @param  lKey     Key of the binding (source endpoint and cluster)
+ * @param  pstDest  Destination of the binding
+ * @retval Node of the binding, BINDMAP_NO_NODE if not found.
+ */
+static uint8_t BindMapFindBinding( uint32_t lKey, const struct ZbApsAddrT * pstDest )
+{
+  uint8_t   cNode;
+
+  for ( cNode = stBindMapBind.acHead[BINDMAP_HASH( lKey )]; cNode != BINDMAP_NO_NODE; cNode = stBindMapBind.pcNext[cNode] )
+  {
+    if ( ( stBindMapBind.plKey[cNode] == lKey ) && ( BindMapIsSameDest( &astBindMapBindDest[cNode], pstDest ) != false ) )
+    {
+      return cNode;
+    }
+  }
+
+  return BINDMAP_NO_NODE;
+}
+
+/**
+ * @brief  Find a group membership in the mirror.
+ * @param  iGroupAddr   Group
+ * @param  cEndpoint    Endpoint, or ZB_ENDPOINT_BCAST for any endpoint
+ * @retval Node of the membership, BINDMAP_NO_NODE if not found.
+ */
+static uint8_t BindMapFindGroup( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  uint32_t  lKey;
+  uint8_t   cNode;
+
+  for ( cNode = stBindMapGroup.acHead[BINDMAP_HASH( iGroupAddr )]; cNode != BINDMAP_NO_NODE; cNode = stBindMapGroup.pcNext[cNode] )
+  {
+    lKey = stBindMapGroup.plKey[cNode];
+    if ( ( BINDMAP_KEY_HIGH( lKey ) == iGroupAddr ) &&
+         ( ( cEndpoint == ZB_ENDPOINT_BCAST ) || ( BINDMAP_KEY_ENDPOINT( lKey ) == cEndpoint ) ) )
+    {
+      return cNode;
+    }
+  }
+
+  return BINDMAP_NO_NODE;
+}
+
+/**
+ * @brief  Compare two binding destinations (group, or extended address and endpoint).
+ * @param  pstDest1   First destination
+ * @param  pstDest2   Second destination
+ * @retval True if same destination.
+ */
+static bool BindMapIsSameDest( const struct ZbApsAddrT * pstDest1, const struct ZbApsAddrT * pstDest2 )
+{
+  if ( pstDest1->mode != pstDest2->mode )
+  {
+    return false;
+  }
+
+  if ( pstDest1->mode == ZB_APSDE_ADDRMODE_GROUP )
+  {
+    return ( pstDest1->nwkAddr == pstDest2->nwkAddr );
+  }
+
+  return ( ( pstDest1->extAddr == pstDest2->extAddr ) && ( pstDest1->endpoint == pstDest2->endpoint ) );
+}
+
+/**
+ * @brief  Build again the mirror if the stack tables have been changed by a remote request.
+ * @param  None
+ * @retval None
+ */
+static void BindMapRefresh( void )
+{
+  if ( bBindMapStale != false )
+  {
+    APP_ZIGBEE_BindMapRebuild();
+  }
+}
+
+/**
+ * @brief  APSDE-DATA.indication filter : the ZDO Bind, Unbind and Mgmt_Leave requests, and the Groups cluster
+ *         commands, change the tables after it. The mirror is built again at the next lookup.
+ * @param  zb       Zigbee stack instance
+ * @param  lId      Message filter identifier
+ * @param  pMessage APSDE-DATA.indication
+ * @param  arg      Not used
+ * @retval ZB_MSG_CONTINUE, the indication is always given to the stack.
+ */
+static enum zb_msg_filter_rc BindMapDataIndCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbApsdeDataIndT  * pstIndication = (const struct ZbApsdeDataIndT *)pMessage;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( lId != ZB_MSG_FILTER_APSDE_DATA_IND )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  if ( pstIndication->profileId == ZB_ZDO_PROFILE_ID )
+  {
+    if ( ( pstIndication->clusterId == ZB_ZDO_BIND_REQ ) || ( pstIndication->clusterId == ZB_ZDO_UNBIND_REQ ) ||
+         ( pstIndication->clusterId == ZB_ZDO_MGMT_LEAVE_REQ ) )
+    {
+      bBindMapStale = true;
+    }
+  }
+  else if ( pstIndication->clusterId == (uint16_t)ZCL_CLUSTER_GROUPS )
+  {
+    bBindMapStale = true;
+  }
+
+  return( ZB_MSG_CONTINUE );
+}
+
+/**
+ * @brief  Print the statistics of the mirror.
+ * @param  None
+ * @retval None
+ */
+static void BindMapPrintStats( void )
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_BindMapStats_t * pstStats = APP_ZIGBEE_BindMapGetStats();
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_APP( "Binding map : %d bindings, %d group memberships%s, %d lookups, %d rebuilds, %d not mirrored.",
+                pstStats->iBindings, pstStats->iGroups, ( bBindMapStale != false ) ? " (stale)" : "",
+                pstStats->lLookups, pstStats->lRebuilds, pstStats->lOverflows );
+}
+
+#else /* (CFG_ZIGBEE_BINDMAP_SUPPORTED != 0) */
+
+/**
+ * @brief  Mirror not supported.
+ */
+void APP_ZIGBEE_BindMapInit( void )
+{
+}
+
+/**
+ * @brief  Mirror not supported.
+ */
+void APP_ZIGBEE_BindMapRebuild( void )
+{
+}
+
+/**
+ * @brief  Mirror not supported : lookup in the stack table.
+ */
+bool APP_ZIGBEE_BindMapIsGroupMember( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  return ZbApsGroupIsMember( stZigbeeAppInfo.pstZigbee, iGroupAddr, cEndpoint );
+}
+
+/**
+ * @brief  Mirror not supported : walk of the stack binding table.
+ */
+uint16_t APP_ZIGBEE_BindMapGetDestinations( uint8_t cEndpoint, uint16_t iClusterId, struct ZbApsAddrT * pstDestList, uint16_t iDestMax )
+{
+  struct ZbApsmeBindT   stBinding;
+  uint64_t              dlExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  uint16_t              iNumber = 0;
+  unsigned int          iIndex;
+
+  for ( iIndex = 0; ( iNumber < iDestMax ) &&
+        ( ZbApsGetIndex( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_BINDING_TABLE, &stBinding, sizeof( stBinding ), iIndex ) == ZB_STATUS_SUCCESS ); iIndex++ )
+  {
+    if ( ( stBinding.srcExtAddr == dlExtAddr ) && ( stBinding.srcEndpt == cEndpoint ) && ( stBinding.clusterId == iClusterId ) )
+    {
+      pstDestList[iNumber++] = stBinding.dst;
+    }
+  }
+
+  return iNumber;
+}
+
+/**
+ * @brief  Mirror not supported : APSME-ADD-GROUP only.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapAddGroup( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  struct ZbApsmeAddGroupReqT  stRequest;
+  struct ZbApsmeAddGroupConfT stConfirm;
+
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.groupAddr = iGroupAddr;
+  stRequest.endpt = cEndpoint;
+  ZbApsmeAddGroupReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Mirror not supported : APSME-REMOVE-GROUP only.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapRemoveGroup( uint16_t iGroupAddr, uint8_t cEndpoint )
+{
+  struct ZbApsmeRemoveGroupReqT   stRequest;
+  struct ZbApsmeRemoveGroupConfT  stConfirm;
+
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.groupAddr = iGroupAddr;
+  stRequest.endpt = cEndpoint;
+  ZbApsmeRemoveGroupReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Mirror not supported : APSME-BIND only.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapBind( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest )
+{
+  struct ZbApsmeBindReqT  stRequest;
+  struct ZbApsmeBindConfT stConfirm;
+
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.srcExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  stRequest.srcEndpt = cEndpoint;
+  stRequest.clusterId = iClusterId;
+  stRequest.dst = *pstDest;
+  ZbApsmeBindReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Mirror not supported : APSME-UNBIND only.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_BindMapUnbind( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest )
+{
+  struct ZbApsmeUnbindReqT  stRequest;
+  struct ZbApsmeUnbindConfT stConfirm;
+
+  memset( &stConfirm, 0, sizeof( stConfirm ) );
+  stRequest.srcExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  stRequest.srcEndpt = cEndpoint;
+  stRequest.clusterId = iClusterId;
+  stRequest.dst = *pstDest;
+  ZbApsmeUnbindReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfirm );
+
+  return stConfirm.status;
+}
+
+/**
+ * @brief  Mirror not supported : no statistics.
+ */
+const APP_ZIGBEE_BindMapStats_t * APP_ZIGBEE_BindMapGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_BINDMAP_SUPPORTED != 0) */
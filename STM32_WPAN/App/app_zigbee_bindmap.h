@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_bindmap.h
+  * @author  MCD Application Team
+  * @brief   Interface of the indexed mirror of the APS binding and group tables.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_BINDMAP_H
+#define APP_ZIGBEE_BINDMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the mirror */
+typedef struct
+{
+  uint32_t    lLookups;               /* Number of lookups (group membership, bound destinations) */
+  uint32_t    lRebuilds;              /* Number of rebuilds from the stack tables */
+  uint32_t    lOverflows;             /* Number of entries not mirrored (mirror full) */
+  uint16_t    iBindings;              /* Bindings mirrored */
+  uint16_t    iGroups;                /* Group memberships mirrored */
+} APP_ZIGBEE_BindMapStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_BindMapInit            ( void );
+void      APP_ZIGBEE_BindMapRebuild         ( void );
+bool      APP_ZIGBEE_BindMapIsGroupMember   ( uint16_t iGroupAddr, uint8_t cEndpoint );
+uint16_t  APP_ZIGBEE_BindMapGetDestinations ( uint8_t cEndpoint, uint16_t iClusterId, struct ZbApsAddrT * pstDestList, uint16_t iDestMax );
+
+enum ZbStatusCodeT APP_ZIGBEE_BindMapAddGroup    ( uint16_t iGroupAddr, uint8_t cEndpoint );
+enum ZbStatusCodeT APP_ZIGBEE_BindMapRemoveGroup ( uint16_t iGroupAddr, uint8_t cEndpoint );
+enum ZbStatusCodeT APP_ZIGBEE_BindMapBind        ( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest );
+enum ZbStatusCodeT APP_ZIGBEE_BindMapUnbind      ( uint8_t cEndpoint, uint16_t iClusterId, const struct ZbApsAddrT * pstDest );
+
+const APP_ZIGBEE_BindMapStats_t * APP_ZIGBEE_BindMapGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_BINDMAP_H */
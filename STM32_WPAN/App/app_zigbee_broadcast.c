@@ -0,0 +1,405 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_broadcast.c
+  * @author  MCD Application Team
+  * @brief   Adaptive broadcast policy : watches the Broadcast Transaction Table
+  *          occupancy, the channel load and the density of the Router
+  *          neighbors, then tunes the broadcast delivery time, the broadcast
+  *          retries, the passive-acks and the spacing of the local broadcasts.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_broadcast.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.aps.h"
+#include "zcl/zcl.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BROADCAST_DELIVERY_TIME_MIN     (3u)        /* s, delivery time without congestion */
+#define BROADCAST_RETRIES_DEFAULT       (3u)        /* nwkMaxBroadcastRetries default value */
+#define BROADCAST_RETRIES_MIN           (1u)        /* At least one passive-ack retry is kept */
+#define BROADCAST_LOAD_HIGH             (75u)       /* %, level increased above */
+#define BROADCAST_LOAD_LOW              (25u)       /* %, level decreased below */
+#define BROADCAST_PASSIVE_ACK_TIMEOUT   (50u)       /* nwkPassiveAckTimeout default value */
+#define BROADCAST_LINK_COST_GOOD        (3u)        /* Highest outgoing cost of a good link */
+
+#if (CFG_ZIGBEE_BROADCAST_POLICY_SUPPORTED != 0)
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_BroadcastState_t  stBroadcastState;
+static uint8_t                      cBroadcastRetriesDefault, cBroadcastPassiveAckTimeoutDefault;
+static bool                         bBroadcastStarted, bBroadcastMacValid;
+static uint32_t                     lBroadcastMacTx, lBroadcastMacRetry, lBroadcastMacFail;
+static UTIL_TIMER_Object_t          stBroadcastTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BroadcastTask           ( void );
+static void     BroadcastTimerElapsed   ( void * arg );
+static uint8_t  BroadcastGetBttOccupancy( void );
+static uint8_t  BroadcastGetChannelBusy ( void );
+static uint8_t  BroadcastGetDensity     ( void );
+static void     BroadcastApplyLevel     ( uint8_t cLevel );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the broadcast policy : Task and Timer of the samples.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BroadcastInit( void )
+{
+  UTIL_TIMER_Create( &stBroadcastTimer, CFG_ZIGBEE_BROADCAST_POLICY_PERIOD, UTIL_TIMER_PERIODIC, &BroadcastTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_BROADCAST ), UTIL_SEQ_RFU, BroadcastTask );
+}
+
+/**
+ * @brief  Start the policy once on the Network (group addressing used) : apply the idle level and sample periodically.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_BroadcastStart( void )
+{
+  if ( bBroadcastStarted == false )
+  {
+    /* Retries configured by the stack are the ones without congestion */
+    if ( ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_MaxBroadcastRetries, &cBroadcastRetriesDefault, sizeof( cBroadcastRetriesDefault ) ) != ZB_STATUS_SUCCESS )
+    {
+      cBroadcastRetriesDefault = BROADCAST_RETRIES_DEFAULT;
+    }
+    if ( ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_PassiveAckTimeout, &cBroadcastPassiveAckTimeoutDefault, sizeof( cBroadcastPassiveAckTimeoutDefault ) ) != ZB_STATUS_SUCCESS )
+    {
+      cBroadcastPassiveAckTimeoutDefault = BROADCAST_PASSIVE_ACK_TIMEOUT;
+    }
+    bBroadcastStarted = true;
+  }
+
+  memset( &stBroadcastState, 0, sizeof( stBroadcastState ) );
+  bBroadcastMacValid = false;
+  BroadcastApplyLevel( 0u );
+
+  UTIL_TIMER_Start( &stBroadcastTimer );
+}
+
+/**
+ * @brief  Spacing between two broadcasts (groups included) originated by the application.
+ * @param  None
+ * @retval Spacing in ms.
+ */
+uint32_t APP_ZIGBEE_BroadcastGetSpacing( void )
+{
+  if ( bBroadcastStarted == false )
+  {
+    return CFG_ZIGBEE_FANOUT_BROADCAST_SPACING;
+  }
+
+  return stBroadcastState.lSpacing;
+}
+
+/**
+ * @brief  State of the broadcast policy.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_BroadcastState_t * APP_ZIGBEE_BroadcastGetState( void )
+{
+  return &stBroadcastState;
+}
+
+/**
+ * @brief  Broadcast Task : sample the load and move the congestion level by one step, with hysteresis. The density
+ *         of the neighborhood is sampled at the same time.
+ * @param  None
+ * @retval None
+ */
+static void BroadcastTask( void )
+{
+  uint8_t   cLoad, cLevel, cDensity;
+
+  stBroadcastState.cBttOccupancy = BroadcastGetBttOccupancy();
+  stBroadcastState.cChannelBusy = BroadcastGetChannelBusy();
+  if ( stBroadcastState.cBttOccupancy > stBroadcastState.cMaxBttOccupancy )
+  {
+    stBroadcastState.cMaxBttOccupancy = stBroadcastState.cBttOccupancy;
+  }
+
+  cLoad = stBroadcastState.cBttOccupancy;
+  if ( stBroadcastState.cChannelBusy > cLoad )
+  {
+    cLoad = stBroadcastState.cChannelBusy;
+  }
+
+  cLevel = stBroadcastState.cLevel;
+  if ( ( cLoad >= BROADCAST_LOAD_HIGH ) && ( cLevel < ( APP_ZIGBEE_BROADCAST_LEVEL_NB - 1u ) ) )
+  {
+    cLevel++;
+  }
+  else if ( ( cLoad <= BROADCAST_LOAD_LOW ) && ( cLevel > 0u ) )
+  {
+    cLevel--;
+  }
+
+  cDensity = BroadcastGetDensity();
+  if ( cDensity != stBroadcastState.cDensity )
+  {
+    LOG_INFO_APP( "[BCAST] %d Router neighbors (%d %% on good links) : density %d -> %d.", stBroadcastState.cRouters,
+                  stBroadcastState.cGoodLinks, stBroadcastState.cDensity, cDensity );
+    stBroadcastState.cDensity = cDensity;
+    BroadcastApplyLevel( stBroadcastState.cLevel );
+  }
+
+  if ( cLevel != stBroadcastState.cLevel )
+  {
+    LOG_INFO_APP( "[BCAST] Load %d %% (BTT %d %%, channel %d %%) : level %d -> %d.", cLoad, stBroadcastState.cBttOccupancy,
+                  stBroadcastState.cChannelBusy, stBroadcastState.cLevel, cLevel );
+    stBroadcastState.lLevelChanges++;
+    BroadcastApplyLevel( cLevel );
+  }
+}
+
+/**
+ * @brief  Callback triggered when the period between two samples expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void BroadcastTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_BROADCAST ), TASK_PRIO_ZIGBEE_BROADCAST );
+}
+
+/**
+ * @brief  Occupancy of the Broadcast Transaction Table : entries not yet expired.
+ * @param  None
+ * @retval Occupancy in %.
+ */
+static uint8_t BroadcastGetBttOccupancy( void )
+{
+  struct ZbNwkBttEntryT   stEntry;
+  ZbUptimeT               lNow = ZbZclUptime( stZigbeeAppInfo.pstZigbee );
+  uint16_t                iIndex = 0, iUsed = 0;
+
+  while ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_BroadcastTransactionTable, &stEntry, sizeof( stEntry ), iIndex ) == ZB_STATUS_SUCCESS )
+  {
+    if ( ZbTimeoutRemaining( lNow, stEntry.expireTime ) != 0u )
+    {
+      iUsed++;
+    }
+    iIndex++;
+  }
+
+  if ( iIndex == 0u )
+  {
+    return 0;
+  }
+
+  return (uint8_t)( ( iUsed * 100u ) / iIndex );
+}
+
+/**
+ * @brief  Channel load seen by the MAC : retries and failures over the unicasts sent since the previous sample.
+ * @param  None
+ * @retval Load in %.
+ */
+static uint8_t BroadcastGetChannelBusy( void )
+{
+  struct ZbApsStatTableT  stApsStats;
+  uint32_t                lTx, lBusy;
+  uint8_t                 cBusy = 0;
+
+  if ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) != ZB_STATUS_SUCCESS )
+  {
+    return 0;
+  }
+
+  if ( bBroadcastMacValid != false )
+  {
+    lTx = ( stApsStats.mac_tx_ucast - lBroadcastMacTx );
+    lBusy = (uint16_t)( stApsStats.mac_tx_ucast_retry - lBroadcastMacRetry ) + (uint16_t)( stApsStats.mac_tx_ucast_fail - lBroadcastMacFail );
+    if ( lTx != 0u )
+    {
+      cBusy = (uint8_t)( ( lBusy >= lTx ) ? 100u : ( ( lBusy * 100u ) / lTx ) );
+    }
+  }
+
+  lBroadcastMacTx = stApsStats.mac_tx_ucast;
+  lBroadcastMacRetry = stApsStats.mac_tx_ucast_retry;
+  lBroadcastMacFail = stApsStats.mac_tx_ucast_fail;
+  bBroadcastMacValid = true;
+
+  return cBusy;
+}
+
+/**
+ * @brief  Density of the neighborhood, from the Router neighbors and the share of them on good links (no transmit
+ *         failure and a low outgoing cost), i.e. the ones whose relays are heard as passive-acks.
+ * @param  None
+ * @retval Density, from 0 (sparse) to APP_ZIGBEE_BROADCAST_DENSITY_NB - 1.
+ */
+static uint8_t BroadcastGetDensity( void )
+{
+  struct ZbNwkNeighborT   stNeighbor;
+  uint16_t                iIndex = 0, iRouters = 0, iGood = 0;
+
+  while ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) == ZB_STATUS_SUCCESS )
+  {
+    iIndex++;
+    if ( ( stNeighbor.nwkAddr == ZB_NWK_ADDR_UNDEFINED ) ||
+         ( ( stNeighbor.deviceType != ZB_NWK_NEIGHBOR_TYPE_ROUTER ) && ( stNeighbor.deviceType != ZB_NWK_NEIGHBOR_TYPE_COORD ) ) )
+    {
+      continue;
+    }
+
+    iRouters++;
+    if ( ( stNeighbor.txFailure == 0u ) && ( stNeighbor.outgoingCost != 0u ) && ( stNeighbor.outgoingCost <= BROADCAST_LINK_COST_GOOD ) )
+    {
+      iGood++;
+    }
+  }
+
+  stBroadcastState.cRouters = (uint8_t)( ( iRouters > UINT8_MAX ) ? UINT8_MAX : iRouters );
+  stBroadcastState.cGoodLinks = (uint8_t)( ( iRouters == 0u ) ? 0u : ( ( iGood * 100u ) / iRouters ) );
+
+  if ( ( iRouters >= CFG_ZIGBEE_BROADCAST_CROWDED_ROUTERS ) && ( stBroadcastState.cGoodLinks >= CFG_ZIGBEE_BROADCAST_GOOD_LINKS ) )
+  {
+    return 2u;
+  }
+  if ( iRouters >= CFG_ZIGBEE_BROADCAST_DENSE_ROUTERS )
+  {
+    return 1u;
+  }
+
+  return 0u;
+}
+
+/**
+ * @brief  Apply a congestion level : a longer delivery time (broadcasts relayed slower on a busy channel), less
+ *         passive-ack retries and a doubled spacing of the local broadcasts at each level. A dense neighborhood
+ *         removes one more retry and lengthens the passive-ack timeout, a crowded one disables the passive-acks.
+ * @param  cLevel   Congestion level
+ * @retval None
+ */
+static void BroadcastApplyLevel( uint8_t cLevel )
+{
+  uint8_t   cRetries = BROADCAST_RETRIES_MIN;
+  uint8_t   cSteps = cLevel;
+  uint16_t  iTimeout = cBroadcastPassiveAckTimeoutDefault;
+
+  if ( stBroadcastState.cDensity != 0u )
+  {
+    cSteps++;
+    iTimeout += ( cBroadcastPassiveAckTimeoutDefault / 2u );
+  }
+
+  if ( cBroadcastRetriesDefault > ( BROADCAST_RETRIES_MIN + cSteps ) )
+  {
+    cRetries = ( cBroadcastRetriesDefault - cSteps );
+  }
+  else if ( cBroadcastRetriesDefault < BROADCAST_RETRIES_MIN )
+  {
+    cRetries = cBroadcastRetriesDefault;
+  }
+
+  stBroadcastState.cLevel = cLevel;
+  stBroadcastState.cMaxRetries = cRetries;
+  stBroadcastState.lDeliveryTime = ( BROADCAST_DELIVERY_TIME_MIN + cLevel );
+  stBroadcastState.lSpacing = ( CFG_ZIGBEE_FANOUT_BROADCAST_SPACING << cLevel );
+  stBroadcastState.cPassiveAck = ( ( stBroadcastState.cDensity < ( APP_ZIGBEE_BROADCAST_DENSITY_NB - 1u ) ) ? 1u : 0u );
+  stBroadcastState.cPassiveAckTimeout = (uint8_t)( ( iTimeout > UINT8_MAX ) ? UINT8_MAX : iTimeout );
+
+  ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NetworkBroadcastDeliveryTime, &stBroadcastState.lDeliveryTime, sizeof( stBroadcastState.lDeliveryTime ) );
+  ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_MaxBroadcastRetries, &stBroadcastState.cMaxRetries, sizeof( stBroadcastState.cMaxRetries ) );
+  ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_PassiveAckTimeout, &stBroadcastState.cPassiveAckTimeout, sizeof( stBroadcastState.cPassiveAckTimeout ) );
+  ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_PassiveAckEnabled, &stBroadcastState.cPassiveAck, sizeof( stBroadcastState.cPassiveAck ) );
+}
+
+/**
+ * @brief  Broadcast policy serial command : BCASTSTATS.
+ * @param  szCommand  Command received
+ * @retval True if the command is a broadcast policy command.
+ */
+bool APP_ZIGBEE_BroadcastSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "BCASTSTATS" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "Broadcast level %d (%d changes) : BTT %d %% (max %d %%), channel %d %%.", stBroadcastState.cLevel,
+                stBroadcastState.lLevelChanges, stBroadcastState.cBttOccupancy, stBroadcastState.cMaxBttOccupancy,
+                stBroadcastState.cChannelBusy );
+  LOG_INFO_APP( "Broadcast delivery time %d s, %d retries, %d ms between local broadcasts.", stBroadcastState.lDeliveryTime,
+                stBroadcastState.cMaxRetries, stBroadcastState.lSpacing );
+  LOG_INFO_APP( "Broadcast density %d : %d Router neighbors (%d %% on good links), passive-ack %s (timeout %d).",
+                stBroadcastState.cDensity, stBroadcastState.cRouters, stBroadcastState.cGoodLinks,
+                ( ( stBroadcastState.cPassiveAck != 0u ) ? "on" : "off" ), stBroadcastState.cPassiveAckTimeout );
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_BROADCAST_POLICY_SUPPORTED != 0) */
+
+/**
+ * @brief  Broadcast policy not supported.
+ */
+void APP_ZIGBEE_BroadcastInit( void )
+{
+}
+
+/**
+ * @brief  Broadcast policy not supported : shorten the broadcast delivery time once.
+ */
+void APP_ZIGBEE_BroadcastStart( void )
+{
+  uint32_t  lDeliveryTime = BROADCAST_DELIVERY_TIME_MIN;
+
+  ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NetworkBroadcastDeliveryTime, &lDeliveryTime, sizeof( lDeliveryTime ) );
+}
+
+/**
+ * @brief  Broadcast policy not supported : fixed spacing.
+ */
+uint32_t APP_ZIGBEE_BroadcastGetSpacing( void )
+{
+  return CFG_ZIGBEE_FANOUT_BROADCAST_SPACING;
+}
+
+/**
+ * @brief  Broadcast policy not supported : no command.
+ */
+bool APP_ZIGBEE_BroadcastSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Broadcast policy not supported : no state.
+ */
+const APP_ZIGBEE_BroadcastState_t * APP_ZIGBEE_BroadcastGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_BROADCAST_POLICY_SUPPORTED != 0) */
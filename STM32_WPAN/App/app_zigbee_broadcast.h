@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_broadcast.h
+  * @author  MCD Application Team
+  * @brief   Interface of the adaptive broadcast policy.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_BROADCAST_H
+#define APP_ZIGBEE_BROADCAST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define APP_ZIGBEE_BROADCAST_LEVEL_NB     (4u)
+#define APP_ZIGBEE_BROADCAST_DENSITY_NB   (3u)
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the broadcast policy */
+typedef struct
+{
+  uint8_t     cLevel;                 /* Congestion level, from 0 (idle) to APP_ZIGBEE_BROADCAST_LEVEL_NB - 1 */
+  uint8_t     cBttOccupancy;          /* Last Broadcast Transaction Table occupancy (in %) */
+  uint8_t     cChannelBusy;           /* Last MAC unicast retry/failure rate (in %) */
+  uint8_t     cMaxRetries;            /* Current nwkMaxBroadcastRetries */
+  uint32_t    lDeliveryTime;          /* Current nwkNetworkBroadcastDeliveryTime (in s) */
+  uint32_t    lSpacing;               /* Current spacing (in ms) between two local broadcasts */
+  uint32_t    lLevelChanges;          /* Number of level changes */
+  uint8_t     cMaxBttOccupancy;       /* Highest occupancy seen (in %) */
+  uint8_t     cDensity;               /* Neighborhood density, from 0 (sparse) to APP_ZIGBEE_BROADCAST_DENSITY_NB - 1 */
+  uint8_t     cRouters;               /* Last Router neighbors count */
+  uint8_t     cGoodLinks;             /* Last share of Router neighbors on good links (in %) */
+  uint8_t     cPassiveAck;            /* Current nwkPassiveAckEnabled */
+  uint8_t     cPassiveAckTimeout;     /* Current nwkPassiveAckTimeout */
+} APP_ZIGBEE_BroadcastState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_BroadcastInit          ( void );
+void      APP_ZIGBEE_BroadcastStart         ( void );
+uint32_t  APP_ZIGBEE_BroadcastGetSpacing    ( void );
+bool      APP_ZIGBEE_BroadcastSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_BroadcastState_t * APP_ZIGBEE_BroadcastGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_BROADCAST_H */
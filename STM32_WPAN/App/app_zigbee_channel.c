@@ -0,0 +1,438 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_channel.c
+  * @author  MCD Application Team
+  * @brief   Channel quality monitor : short energy scans of one channel at a
+  *          time (NLME-ED-SCAN, done by the MAC between its frames) while the
+  *          MAC is idle, noise histograms per channel, and a channel change
+  *          proposed to the Network Manager (nwkNextChannelChange and
+  *          Mgmt_Nwk_Update_notify) when the current channel is noisy.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_channel.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+#include "mac_sys_if.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.zdo.h"
+
+#if (CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define CHANNEL_AVERAGE_SHIFT           (3u)        /* Moving average over 8 scans */
+#define CHANNEL_HISTO_SHIFT             (5u)        /* 8 bins of 32 energy levels */
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_ChannelQuality_t  astChannelQuality[APP_ZIGBEE_CHANNEL_NB];
+static APP_ZIGBEE_ChannelState_t    stChannelState;
+static UTIL_TIMER_Object_t          stChannelTimer;
+static uint32_t                     lChannelMask;
+static uint8_t                      cChannelScanned;
+static uint8_t                      cChannelSkipNb;
+static uint8_t                      cChannelHoldOff;
+static bool                         bChannelScanInProgress;
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+static uint32_t                     lChannelMacActivity;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     ChannelTask             ( void );
+static void     ChannelTimerElapsed     ( void * arg );
+static bool     ChannelIsMacIdle        ( void );
+static uint8_t  ChannelGetNext          ( uint8_t cChannel );
+static void     ChannelScanCallback     ( struct ZbNlmeEdScanConfT * pstScanConf, void * arg );
+static void     ChannelSweepEnd         ( void );
+static void     ChannelTrigger          ( uint8_t cChannel );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the channel quality monitor : Task and Timer of the energy scans.
+ * @param  lMask    Channels monitored (2.4 GHz page)
+ * @retval None
+ */
+void APP_ZIGBEE_ChannelInit( uint32_t lMask )
+{
+  lChannelMask = ( lMask & WPAN_CHANNELMASK_2400MHZ );
+
+  UTIL_TIMER_Create( &stChannelTimer, CFG_ZIGBEE_CHANNEL_SCAN_PERIOD, UTIL_TIMER_PERIODIC, &ChannelTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CHANNEL ), UTIL_SEQ_RFU, ChannelTask );
+}
+
+/**
+ * @brief  Start the energy scans (Network joined), from the first channel of the mask.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_ChannelStart( void )
+{
+  if ( lChannelMask == 0u )
+  {
+    return;
+  }
+
+  cChannelScanned = 0;
+  cChannelSkipNb = 0;
+  UTIL_TIMER_Start( &stChannelTimer );
+}
+
+/**
+ * @brief  State of the channel quality monitor.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_ChannelState_t * APP_ZIGBEE_ChannelGetState( void )
+{
+  return &stChannelState;
+}
+
+/**
+ * @brief  Noise of a channel.
+ * @param  cChannel   Channel (11 to 26)
+ * @retval Noise of the channel, or NULL if not a 2.4 GHz channel.
+ */
+const APP_ZIGBEE_ChannelQuality_t * APP_ZIGBEE_ChannelGetQuality( uint8_t cChannel )
+{
+  if ( ( cChannel < APP_ZIGBEE_CHANNEL_FIRST ) || ( cChannel >= ( APP_ZIGBEE_CHANNEL_FIRST + APP_ZIGBEE_CHANNEL_NB ) ) )
+  {
+    return NULL;
+  }
+
+  return &astChannelQuality[cChannel - APP_ZIGBEE_CHANNEL_FIRST];
+}
+
+/**
+ * @brief  Channel quality serial command : CHANNEL (state and noise histograms).
+ * @param  szCommand  Command received
+ * @retval True if the command is a channel quality command.
+ */
+bool APP_ZIGBEE_ChannelSerialCmdExecute( const char * szCommand )
+{
+  const APP_ZIGBEE_ChannelQuality_t   * pstQuality;
+  uint8_t                             cChannel;
+
+  if ( strcmp( szCommand, "CHANNEL" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "Channel monitor : %d scans, %d skipped, %d errors, quietest channel %d, %d changes proposed (last to %d).",
+                stChannelState.lScans, stChannelState.lSkipped, stChannelState.lErrors, stChannelState.cBestChannel,
+                stChannelState.lTriggers, stChannelState.cNextChannel );
+
+  for ( cChannel = APP_ZIGBEE_CHANNEL_FIRST; cChannel < ( APP_ZIGBEE_CHANNEL_FIRST + APP_ZIGBEE_CHANNEL_NB ); cChannel++ )
+  {
+    if ( ( lChannelMask & ( 1u << cChannel ) ) == 0u )
+    {
+      continue;
+    }
+
+    pstQuality = APP_ZIGBEE_ChannelGetQuality( cChannel );
+    LOG_INFO_APP( "  Channel %2d : last %3d, average %3d, max %3d, histogram %d %d %d %d %d %d %d %d", cChannel,
+                  pstQuality->cLast, ( pstQuality->iAverage >> CHANNEL_AVERAGE_SHIFT ), pstQuality->cMax,
+                  pstQuality->aiHisto[0], pstQuality->aiHisto[1], pstQuality->aiHisto[2], pstQuality->aiHisto[3],
+                  pstQuality->aiHisto[4], pstQuality->aiHisto[5], pstQuality->aiHisto[6], pstQuality->aiHisto[7] );
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Callback triggered when the period between two energy scans expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void ChannelTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CHANNEL ), TASK_PRIO_ZIGBEE_CHANNEL );
+}
+
+/**
+ * @brief  Channel quality Task : energy scan of the next channel of the mask, when the MAC is idle.
+ * @param  None
+ * @retval None
+ */
+static void ChannelTask( void )
+{
+  struct ZbNlmeEdScanReqT   stScanReq;
+  uint8_t                   cChannel;
+
+  if ( ( bChannelScanInProgress != false ) || ( ChannelIsMacIdle() == false ) )
+  {
+    stChannelState.lSkipped++;
+    return;
+  }
+
+  cChannel = ChannelGetNext( cChannelScanned );
+  stScanReq.channelMask = ZB_CHANNELMASK( ( 1u << cChannel ), 0u );
+  stScanReq.scanDuration = CFG_ZIGBEE_CHANNEL_SCAN_DURATION;
+
+  if ( ZbNlmeEdScanReq( stZigbeeAppInfo.pstZigbee, &stScanReq, ChannelScanCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    stChannelState.lErrors++;
+    return;
+  }
+
+  bChannelScanInProgress = true;
+  cChannelScanned = cChannel;
+}
+
+/**
+ * @brief  Idle window of the MAC : no frame sent or received since the last period. After
+ *         CFG_ZIGBEE_CHANNEL_SKIP_MAX busy periods, the scan is done anyway to not starve the monitor.
+ * @param  None
+ * @retval True if the energy scan can be done.
+ */
+static bool ChannelIsMacIdle( void )
+{
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MAC_SYS_Stats_t   stMacStats;
+  uint32_t          lActivity;
+
+  MacSys_GetStats( &stMacStats );
+  lActivity = stMacStats.Total.TxCount + stMacStats.Total.RxCount;
+  if ( ( lActivity != lChannelMacActivity ) && ( cChannelSkipNb < CFG_ZIGBEE_CHANNEL_SKIP_MAX ) )
+  {
+    lChannelMacActivity = lActivity;
+    cChannelSkipNb++;
+    return false;
+  }
+
+  lChannelMacActivity = lActivity;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+  cChannelSkipNb = 0;
+  return true;
+}
+
+/**
+ * @brief  Next channel of the mask, after the given one (wraps to the first).
+ * @param  cChannel   Previous channel (0 to get the first)
+ * @retval Next channel
+ */
+static uint8_t ChannelGetNext( uint8_t cChannel )
+{
+  uint8_t   cIndex;
+
+  for ( cIndex = 0; cIndex < WPAN_PAGE_CHANNELS_MAX; cIndex++ )
+  {
+    cChannel = (uint8_t)( ( cChannel + 1u ) % WPAN_PAGE_CHANNELS_MAX );
+    if ( ( lChannelMask & ( 1u << cChannel ) ) != 0u )
+    {
+      break;
+    }
+  }
+
+  return cChannel;
+}
+
+/**
+ * @brief  End of an energy scan : the energy of the channel feeds its histogram and average.
+ * @param  pstScanConf  NLME-ED-SCAN confirm
+ * @param  arg          Not used
+ * @retval None
+ */
+static void ChannelScanCallback( struct ZbNlmeEdScanConfT * pstScanConf, void * arg )
+{
+  APP_ZIGBEE_ChannelQuality_t   * pstQuality;
+  uint8_t                       cEnergy;
+
+  UNUSED( arg );
+  bChannelScanInProgress = false;
+
+  if ( ( pstScanConf->status != ZB_STATUS_SUCCESS ) || ( ( pstScanConf->unscannedChannels & ( 1u << cChannelScanned ) ) != 0u ) )
+  {
+    stChannelState.lErrors++;
+    return;
+  }
+
+  stChannelState.lScans++;
+  cEnergy = pstScanConf->energyDetectList[cChannelScanned];
+  pstQuality = &astChannelQuality[cChannelScanned - APP_ZIGBEE_CHANNEL_FIRST];
+
+  if ( pstQuality->aiHisto[cEnergy >> CHANNEL_HISTO_SHIFT] < UINT16_MAX )
+  {
+    pstQuality->aiHisto[cEnergy >> CHANNEL_HISTO_SHIFT]++;
+  }
+  if ( pstQuality->iAverage == 0u )
+  {
+    pstQuality->iAverage = (uint16_t)( (uint16_t)cEnergy << CHANNEL_AVERAGE_SHIFT );
+  }
+  else
+  {
+    pstQuality->iAverage = (uint16_t)( pstQuality->iAverage - ( pstQuality->iAverage >> CHANNEL_AVERAGE_SHIFT ) + cEnergy );
+  }
+  pstQuality->cLast = cEnergy;
+  if ( cEnergy > pstQuality->cMax )
+  {
+    pstQuality->cMax = cEnergy;
+  }
+
+  /* Last channel of the mask : the sweep is complete */
+  if ( ChannelGetNext( cChannelScanned ) <= cChannelScanned )
+  {
+    ChannelSweepEnd();
+  }
+}
+
+/**
+ * @brief  End of a sweep of the channels : a change is proposed when the current channel is above
+ *         CFG_ZIGBEE_CHANNEL_ED_THRESHOLD and the quietest one is better by CFG_ZIGBEE_CHANNEL_ED_MARGIN.
+ * @param  None
+ * @retval None
+ */
+static void ChannelSweepEnd( void )
+{
+  uint8_t   cChannel;
+  uint8_t   cCurrent = 0;
+  uint8_t   cBest = 0;
+  uint16_t  iBestAverage = UINT16_MAX;
+  uint16_t  iCurrentAverage;
+
+  for ( cChannel = APP_ZIGBEE_CHANNEL_FIRST; cChannel < ( APP_ZIGBEE_CHANNEL_FIRST + APP_ZIGBEE_CHANNEL_NB ); cChannel++ )
+  {
+    if ( ( ( lChannelMask & ( 1u << cChannel ) ) != 0u )
+         && ( astChannelQuality[cChannel - APP_ZIGBEE_CHANNEL_FIRST].iAverage < iBestAverage ) )
+    {
+      iBestAverage = astChannelQuality[cChannel - APP_ZIGBEE_CHANNEL_FIRST].iAverage;
+      cBest = cChannel;
+    }
+  }
+  stChannelState.cBestChannel = cBest;
+
+  if ( cChannelHoldOff != 0u )
+  {
+    cChannelHoldOff--;
+    return;
+  }
+
+  if ( ( APP_ZIGBEE_GetCurrentChannel( &cCurrent ) == false ) || ( APP_ZIGBEE_ChannelGetQuality( cCurrent ) == NULL )
+       || ( cBest == cCurrent ) )
+  {
+    return;
+  }
+
+  iCurrentAverage = APP_ZIGBEE_ChannelGetQuality( cCurrent )->iAverage;
+  if ( ( iCurrentAverage >= ( CFG_ZIGBEE_CHANNEL_ED_THRESHOLD << CHANNEL_AVERAGE_SHIFT ) )
+       && ( ( iBestAverage + ( CFG_ZIGBEE_CHANNEL_ED_MARGIN << CHANNEL_AVERAGE_SHIFT ) ) <= iCurrentAverage ) )
+  {
+    ChannelTrigger( cBest );
+  }
+}
+
+/**
+ * @brief  Propose a channel change : nwkNextChannelChange is set to the quietest channel, and the noise of the
+ *         channels is sent to the Network Manager (unsolicited Mgmt_Nwk_Update_notify), which decides the change.
+ * @param  cChannel   Quietest channel
+ * @retval None
+ */
+static void ChannelTrigger( uint8_t cChannel )
+{
+  struct ZbChannelListT           stNextChannel;
+  struct ZbZdoNwkUpdateNotifyT    stNotify;
+  uint8_t                         cIndex;
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MAC_SYS_Stats_t                 stMacStats;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+  memset( &stNextChannel, 0, sizeof( stNextChannel ) );
+  stNextChannel.count = 1u;
+  stNextChannel.list[0].page = 0u;
+  stNextChannel.list[0].channelMask = ( 1u << cChannel );
+  if ( ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NextChannelChange, &stNextChannel, sizeof( stNextChannel ) ) != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, set of the Next Channel Change failed." );
+  }
+
+  memset( &stNotify, 0, sizeof( stNotify ) );
+  stNotify.status = ZB_STATUS_SUCCESS;
+  stNotify.scannedChannels = lChannelMask;
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MacSys_GetStats( &stMacStats );
+  stNotify.txTotal = (uint16_t)stMacStats.Interval.TxCount;
+  stNotify.txFails = (uint16_t)( stMacStats.Interval.TxCount - stMacStats.Interval.TxSuccessCount );
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+  for ( cIndex = APP_ZIGBEE_CHANNEL_FIRST; cIndex < ( APP_ZIGBEE_CHANNEL_FIRST + APP_ZIGBEE_CHANNEL_NB ); cIndex++ )
+  {
+    if ( ( ( lChannelMask & ( 1u << cIndex ) ) != 0u ) && ( stNotify.channelListSz < ZB_ZDO_CHANNEL_LIST_MAXSZ ) )
+    {
+      stNotify.channelList[stNotify.channelListSz++] = (uint8_t)( astChannelQuality[cIndex - APP_ZIGBEE_CHANNEL_FIRST].iAverage >> CHANNEL_AVERAGE_SHIFT );
+    }
+  }
+  if ( ZbZdoNwkUpdateNotify( stZigbeeAppInfo.pstZigbee, &stNotify ) != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, send of the Mgmt_Nwk_Update_notify failed." );
+  }
+
+  stChannelState.lTriggers++;
+  stChannelState.cNextChannel = cChannel;
+  cChannelHoldOff = CFG_ZIGBEE_CHANNEL_TRIGGER_HOLDOFF;
+  LOG_INFO_APP( "Noisy channel, change to channel %d proposed.", cChannel );
+}
+
+#else /* (CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED != 0) */
+
+/**
+ * @brief  Channel quality monitor not supported : no energy scan.
+ */
+void APP_ZIGBEE_ChannelInit( uint32_t lMask )
+{
+  UNUSED( lMask );
+}
+
+/**
+ * @brief  Channel quality monitor not supported : no energy scan.
+ */
+void APP_ZIGBEE_ChannelStart( void )
+{
+}
+
+/**
+ * @brief  Channel quality monitor not supported : no command.
+ */
+bool APP_ZIGBEE_ChannelSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Channel quality monitor not supported : no state.
+ */
+const APP_ZIGBEE_ChannelState_t * APP_ZIGBEE_ChannelGetState( void )
+{
+  return NULL;
+}
+
+/**
+ * @brief  Channel quality monitor not supported : no noise.
+ */
+const APP_ZIGBEE_ChannelQuality_t * APP_ZIGBEE_ChannelGetQuality( uint8_t cChannel )
+{
+  UNUSED( cChannel );
+
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_CHANNEL_MONITOR_SUPPORTED != 0) */
@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_channel.h
+  * @author  MCD Application Team
+  * @brief   Interface of the channel quality monitor (background energy scans).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_CHANNEL_H
+#define APP_ZIGBEE_CHANNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define APP_ZIGBEE_CHANNEL_FIRST            (11u)       /* Channels of the 2.4 GHz page, 11 to 26 */
+#define APP_ZIGBEE_CHANNEL_NB               (16u)
+#define APP_ZIGBEE_CHANNEL_HISTO_NB         (8u)        /* Bins of the energy histograms (ED / 32) */
+
+/* Exported types ------------------------------------------------------------*/
+/* Noise of one channel */
+typedef struct
+{
+  uint16_t    aiHisto[APP_ZIGBEE_CHANNEL_HISTO_NB]; /* Energy scans per bin of the energy (saturated) */
+  uint16_t    iAverage;                             /* Average energy, x8 (moving average over 8 scans) */
+  uint8_t     cLast;                                /* Energy of the last scan */
+  uint8_t     cMax;                                 /* Highest energy scanned */
+} APP_ZIGBEE_ChannelQuality_t;
+
+/* State of the channel quality monitor */
+typedef struct
+{
+  uint32_t    lScans;                 /* Energy scans done */
+  uint32_t    lSkipped;               /* Periods without scan (MAC busy or scan in progress) */
+  uint32_t    lErrors;                /* Energy scans failed */
+  uint32_t    lTriggers;              /* Channel changes proposed to the Network Manager */
+  uint8_t     cBestChannel;           /* Quietest channel of the last sweep */
+  uint8_t     cNextChannel;           /* Channel of the last proposal (0 if none) */
+} APP_ZIGBEE_ChannelState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_ChannelInit            ( uint32_t lMask );
+void      APP_ZIGBEE_ChannelStart           ( void );
+bool      APP_ZIGBEE_ChannelSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_ChannelState_t *   APP_ZIGBEE_ChannelGetState    ( void );
+const APP_ZIGBEE_ChannelQuality_t * APP_ZIGBEE_ChannelGetQuality  ( uint8_t cChannel );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_CHANNEL_H */
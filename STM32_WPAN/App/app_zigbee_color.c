@@ -0,0 +1,599 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_color.c
+  * @author  MCD Application Team
+  * @brief   Color Control Server of the color light (Hue Saturation and XY) :
+  *          the color weights the R, G, B PWM channels of the Level Control
+  *          Server. A transition is interpolated frame by frame and converted
+  *          in fixed point (no float) : the frames are computed by batches
+  *          ahead of time and handed to the transition engine of the Level
+  *          Server, the CPU being woken once per batch.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_level.h"
+#include "app_zigbee_color.h"
+#include "app_zigbee_batch.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zcl/general/zcl.color.h"
+
+#if (CFG_ZIGBEE_COLOR_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define COLOR_CHANNELS                  APP_ZIGBEE_LEVEL_PWM_CHANNELS
+#define COLOR_HUE_WHEEL                 ( ZCL_COLOR_MAX_HUE_SAT )   /* Hue 254 is 360 degrees */
+#define COLOR_WEIGHT_MAX                (0xFFFFu)
+#define COLOR_XY_Y_MIN                  (0x0100u)                   /* Bound of the luminance ratio X/Y and Z/Y */
+#define COLOR_FRAME_REPEAT              ( ( CFG_ZIGBEE_LEVEL_PWM_FREQUENCY * CFG_ZIGBEE_COLOR_STEP_PERIOD ) / 1000u )
+#define COLOR_D65_X                     (20493u)                    /* White point, 0.3127 */
+#define COLOR_D65_Y                     (21561u)                    /* White point, 0.3290 */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Color of the output, in its color mode */
+typedef struct
+{
+  int32_t     lHue;                   /* 0 to COLOR_HUE_WHEEL - 1 */
+  int32_t     lSat;                   /* 0 to ZCL_COLOR_MAX_HUE_SAT */
+  int32_t     lX;                     /* CIE x * 65536 */
+  int32_t     lY;                     /* CIE y * 65536 */
+} ColorPoint_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* XYZ to linear sRGB, Q14 (rows R, G, B) */
+static const int32_t                aalColorXyzToRgb[3][3] =
+{
+  {  53094, -25185,  -8169 },
+  { -15874,  30733,    680 },
+  {    913,  -3342,  17318 },
+};
+
+static struct ZbZclClusterT       * pstColorServer;
+static uint8_t                      cColorMode;
+static ColorPoint_t                 stColorCurrent;         /* Color of the output, start of the transition if ongoing */
+static ColorPoint_t                 stColorDelta;           /* Transition from stColorCurrent */
+static uint32_t                     lColorFrames;           /* Frames of the transition */
+static uint32_t                     lColorNext;             /* Next frame to compute */
+static APP_ZIGBEE_ColorStats_t      stColorStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     ColorHsToRgb            ( int32_t lHue, int32_t lSat, uint16_t * piColor );
+static void     ColorXyToRgb            ( int32_t lX, int32_t lY, uint16_t * piColor );
+static void     ColorAt                 ( uint32_t lFrame, ColorPoint_t * pstColor, uint16_t * piColor );
+static void     ColorApply              ( const ColorPoint_t * pstColor );
+static void     ColorStart              ( uint8_t cMode, uint16_t iTransitionTime );
+static uint16_t ColorFill               ( uint16_t * piFrames, uint16_t iFramesMax );
+static void     ColorEnd                ( uint32_t lFrames, bool bStopped );
+static void     ColorPrintStats         ( void );
+
+static enum ZclStatusCodeT ColorMoveToHueCallback    ( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToHueReqT * pstReq,
+                                                       struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT ColorMoveToSatCallback    ( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToSatReqT * pstReq,
+                                                       struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT ColorMoveToHueSatCallback ( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToHueSatReqT * pstReq,
+                                                       struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT ColorMoveToXyCallback     ( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToColorXYReqT * pstReq,
+                                                       struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT ColorStopCallback         ( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientStopMoveStepReqT * pstReq,
+                                                       struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+
+/* Serial commands of the Color Control Server */
+static const SerialCmd_t            astColorSerialCmds[] =
+{
+  { "COLORSTATS", ColorPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stColorSerialCmdTable =
+{
+  astColorSerialCmds, ( sizeof( astColorSerialCmds ) / sizeof( astColorSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Add the Color Control Server (Hue Saturation and XY) on the OnOff Server Endpoint, at the D65 white.
+ * @param  pstZigbee       Zigbee stack instance
+ * @param  cEndpoint       Endpoint of the OnOff Server
+ * @param  pstOnOffServer  OnOff Server of the Endpoint
+ * @retval None
+ */
+void APP_ZIGBEE_ColorInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer )
+{
+  static struct ZbColorClusterConfig  stConfig =
+  {
+    .callbacks =
+    {
+      .move_to_hue = ColorMoveToHueCallback,
+      .move_to_sat = ColorMoveToSatCallback,
+      .move_to_hue_sat = ColorMoveToHueSatCallback,
+      .move_to_color_xy = ColorMoveToXyCallback,
+      .stop_move_step = ColorStopCallback,
+    },
+    .capabilities = ( ZCL_COLOR_CAP_HS | ZCL_COLOR_CAP_XY ),
+  };
+
+  memset( &stColorStats, 0, sizeof( stColorStats ) );
+  memset( &stColorCurrent, 0, sizeof( stColorCurrent ) );
+  stColorCurrent.lX = COLOR_D65_X;
+  stColorCurrent.lY = COLOR_D65_Y;
+  cColorMode = ZCL_COLOR_MODE_XY;
+
+  pstColorServer = ZbZclColorServerAlloc( pstZigbee, cEndpoint, pstOnOffServer, NULL, 0, &stConfig, NULL );
+  if ( pstColorServer == NULL )
+  {
+    LOG_ERROR_APP( "Error, Color Server allocation failed." );
+    return;
+  }
+
+  if ( ZbZclClusterEndpointRegister( pstColorServer ) == false )
+  {
+    LOG_ERROR_APP( "Error, Color Server registration failed." );
+    return;
+  }
+
+  ColorApply( &stColorCurrent );
+  Serial_CMD_Interpreter_RegisterTable( &stColorSerialCmdTable );
+}
+
+/**
+ * @brief  Return the statistics of the Color Control Server.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_ColorStats_t * APP_ZIGBEE_ColorGetStats( void )
+{
+  stColorStats.cMode = cColorMode;
+  return &stColorStats;
+}
+
+/**
+ * @brief  Hue and Saturation (full value) to linear R, G, B weights : integer sextant of the hue wheel.
+ * @param  lHue     Hue (0 to COLOR_HUE_WHEEL - 1)
+ * @param  lSat     Saturation (0 to ZCL_COLOR_MAX_HUE_SAT)
+ * @param  piColor  R, G, B weights (0 to 0xFFFF)
+ * @retval None
+ */
+static void ColorHsToRgb( int32_t lHue, int32_t lSat, uint16_t * piColor )
+{
+  uint32_t  lPosition, lFraction, lSat16;
+  uint16_t  iP, iQ, iT, iV = COLOR_WEIGHT_MAX;
+
+  lPosition = ( ( (uint32_t)lHue * 6u ) << 16u ) / COLOR_HUE_WHEEL;
+  lFraction = ( lPosition & 0xFFFFu );
+  lSat16 = ( ( (uint32_t)lSat * COLOR_WEIGHT_MAX ) / ZCL_COLOR_MAX_HUE_SAT );
+
+  iP = (uint16_t)( COLOR_WEIGHT_MAX - lSat16 );
+  iQ = (uint16_t)( COLOR_WEIGHT_MAX - ( ( lSat16 * lFraction ) >> 16u ) );
+  iT = (uint16_t)( COLOR_WEIGHT_MAX - ( ( lSat16 * ( 0xFFFFu - lFraction ) ) >> 16u ) );
+
+  switch ( lPosition >> 16u )
+  {
+    case 0:   piColor[0] = iV; piColor[1] = iT; piColor[2] = iP; break;
+    case 1:   piColor[0] = iQ; piColor[1] = iV; piColor[2] = iP; break;
+    case 2:   piColor[0] = iP; piColor[1] = iV; piColor[2] = iT; break;
+    case 3:   piColor[0] = iP; piColor[1] = iQ; piColor[2] = iV; break;
+    case 4:   piColor[0] = iT; piColor[1] = iP; piColor[2] = iV; break;
+    default:  piColor[0] = iV; piColor[1] = iP; piColor[2] = iQ; break;
+  }
+}
+
+/**
+ * @brief  CIE xy to linear R, G, B weights : XYZ at Y = 1 (Q16), sRGB matrix (Q14), negative channels (out of gamut)
+ *         clipped, then normalized to the brightest channel (the level sets the brightness).
+ * @param  lX       CIE x * 65536
+ * @param  lY       CIE y * 65536
+ * @param  piColor  R, G, B weights (0 to 0xFFFF)
+ * @retval None
+ */
+static void ColorXyToRgb( int32_t lX, int32_t lY, uint16_t * piColor )
+{
+  int64_t   allXyz[3];
+  int64_t   llRgb;
+  uint32_t  alRgb[3];
+  uint32_t  lMax = 0, lReciprocal, lWeight;
+  uint8_t   cRow;
+
+  if ( lY < (int32_t)COLOR_XY_Y_MIN )
+  {
+    lY = COLOR_XY_Y_MIN;
+  }
+
+  allXyz[0] = ( ( (int64_t)lX << 16 ) / lY );
+  allXyz[1] = ( 1LL << 16 );
+  allXyz[2] = ( ( lX + lY ) < 65536 ) ? ( ( (int64_t)( 65536 - lX - lY ) << 16 ) / lY ) : 0;
+
+  for ( cRow = 0; cRow < 3u; cRow++ )
+  {
+    llRgb = ( ( aalColorXyzToRgb[cRow][0] * allXyz[0] ) + ( aalColorXyzToRgb[cRow][1] * allXyz[1] ) +
+              ( aalColorXyzToRgb[cRow][2] * allXyz[2] ) ) >> 14;
+    alRgb[cRow] = ( ( llRgb > 0 ) ? (uint32_t)llRgb : 0u );
+    if ( alRgb[cRow] > lMax )
+    {
+      lMax = alRgb[cRow];
+    }
+  }
+
+  /* One division, then a multiply per channel */
+  lReciprocal = ( ( lMax != 0u ) ? ( 0xFFFFFFFFu / lMax ) : 0u );
+  for ( cRow = 0; cRow < 3u; cRow++ )
+  {
+    lWeight = (uint32_t)( ( (uint64_t)alRgb[cRow] * lReciprocal ) >> 16u );
+    piColor[cRow] = (uint16_t)( ( lWeight > COLOR_WEIGHT_MAX ) ? COLOR_WEIGHT_MAX : lWeight );
+  }
+}
+
+/**
+ * @brief  Color of a frame of the transition, and its R, G, B weights.
+ * @param  lFrame    Frame (0 : start, lColorFrames : end)
+ * @param  pstColor  Color of the frame (can be NULL)
+ * @param  piColor   R, G, B weights of the frame
+ * @retval None
+ */
+static void ColorAt( uint32_t lFrame, ColorPoint_t * pstColor, uint16_t * piColor )
+{
+  ColorPoint_t  stColor;
+  int32_t       lFrames = (int32_t)( ( lColorFrames != 0u ) ? lColorFrames : 1u );
+
+  stColor.lHue = ( stColorCurrent.lHue + ( ( stColorDelta.lHue * (int32_t)lFrame ) / lFrames ) ) % (int32_t)COLOR_HUE_WHEEL;
+  if ( stColor.lHue < 0 )
+  {
+    stColor.lHue += COLOR_HUE_WHEEL;
+  }
+  stColor.lSat = stColorCurrent.lSat + ( ( stColorDelta.lSat * (int32_t)lFrame ) / lFrames );
+  stColor.lX = stColorCurrent.lX + (int32_t)( ( (int64_t)stColorDelta.lX * lFrame ) / lFrames );
+  stColor.lY = stColorCurrent.lY + (int32_t)( ( (int64_t)stColorDelta.lY * lFrame ) / lFrames );
+
+  if ( cColorMode == ZCL_COLOR_MODE_HS )
+  {
+    ColorHsToRgb( stColor.lHue, stColor.lSat, piColor );
+  }
+  else
+  {
+    ColorXyToRgb( stColor.lX, stColor.lY, piColor );
+  }
+
+  if ( pstColor != NULL )
+  {
+    *pstColor = stColor;
+  }
+}
+
+/**
+ * @brief  Apply a color at once : output and attributes of the color mode.
+ * @param  pstColor  Color
+ * @retval None
+ */
+static void ColorApply( const ColorPoint_t * pstColor )
+{
+  uint16_t  aiColor[COLOR_CHANNELS];
+
+  stColorCurrent = *pstColor;
+  memset( &stColorDelta, 0, sizeof( stColorDelta ) );
+  lColorFrames = 0;
+  ColorAt( 0, NULL, aiColor );
+  APP_ZIGBEE_LevelSetColor( aiColor );
+
+  if ( cColorMode == ZCL_COLOR_MODE_HS )
+  {
+    (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_CURRENT_HUE, pstColor->lHue );
+    (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_CURRENT_SAT, pstColor->lSat );
+    APP_ZIGBEE_BatchChange( pstColorServer, ZCL_COLOR_ATTR_CURRENT_HUE );
+    APP_ZIGBEE_BatchChange( pstColorServer, ZCL_COLOR_ATTR_CURRENT_SAT );
+  }
+  else
+  {
+    (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_CURRENT_X, pstColor->lX );
+    (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_CURRENT_Y, pstColor->lY );
+    APP_ZIGBEE_BatchChange( pstColorServer, ZCL_COLOR_ATTR_CURRENT_X );
+    APP_ZIGBEE_BatchChange( pstColorServer, ZCL_COLOR_ATTR_CURRENT_Y );
+  }
+  (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_COLOR_MODE, cColorMode );
+  (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_ENH_COLOR_MODE, cColorMode );
+  (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_REMAINING_TIME, 0 );
+  APP_ZIGBEE_BatchChange( pstColorServer, ZCL_COLOR_ATTR_COLOR_MODE );
+}
+
+/**
+ * @brief  Start the transition set in stColorDelta, one frame per CFG_ZIGBEE_COLOR_STEP_PERIOD. Without transition
+ *         time, or when the output is off, the target is applied at once.
+ * @param  cMode            Color mode of the target
+ * @param  iTransitionTime  Transition time (1/10 s)
+ * @retval None
+ */
+static void ColorStart( uint8_t cMode, uint16_t iTransitionTime )
+{
+  ColorPoint_t  stTarget;
+  uint16_t      aiColor[COLOR_CHANNELS];
+
+  cColorMode = cMode;
+  lColorFrames = ( ( (uint32_t)iTransitionTime * 100u ) / CFG_ZIGBEE_COLOR_STEP_PERIOD );
+  lColorNext = 0;
+
+  if ( lColorFrames != 0u )
+  {
+    (void)ZbZclAttrIntegerWrite( pstColorServer, ZCL_COLOR_ATTR_REMAINING_TIME, iTransitionTime );
+    if ( APP_ZIGBEE_LevelPlay( ColorFill, ColorEnd, COLOR_FRAME_REPEAT ) != false )
+    {
+      stColorStats.lTransitions++;
+      return;
+    }
+  }
+
+  stColorStats.lImmediate++;
+  lColorFrames = 1u;
+  ColorAt( 1u, &stTarget, aiColor );
+  ColorApply( &stTarget );
+}
+
+/**
+ * @brief  Next batch of the color transition : color of each frame, weighted by the current level.
+ * @param  piFrames    Batch to fill
+ * @param  iFramesMax  Frames of the batch
+ * @retval Frames filled, 0 at the end of the transition.
+ */
+static uint16_t ColorFill( uint16_t * piFrames, uint16_t iFramesMax )
+{
+  uint16_t  aiColor[COLOR_CHANNELS];
+  uint16_t  iFrames = 0;
+
+  while ( ( iFrames < iFramesMax ) && ( lColorNext < lColorFrames ) )
+  {
+    lColorNext++;
+    ColorAt( lColorNext, NULL, aiColor );
+    APP_ZIGBEE_LevelColorFrame( &piFrames[iFrames * COLOR_CHANNELS], aiColor );
+    iFrames++;
+  }
+
+  stColorStats.lFrames += iFrames;
+  return iFrames;
+}
+
+/**
+ * @brief  End of the color transition : color of the last frame played, attributes updated.
+ * @param  lFrames   Frames played
+ * @param  bStopped  Transition stopped before its end
+ * @retval None
+ */
+static void ColorEnd( uint32_t lFrames, bool bStopped )
+{
+  ColorPoint_t  stColor;
+  uint16_t      aiColor[COLOR_CHANNELS];
+
+  if ( bStopped != false )
+  {
+    stColorStats.lStopped++;
+  }
+
+  ColorAt( lFrames, &stColor, aiColor );
+  ColorApply( &stColor );
+}
+
+/**
+ * @brief  Color Server 'Move To Hue' command, in the direction requested.
+ * @param  pstCluster  Color Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT ColorMoveToHueCallback( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToHueReqT * pstReq,
+                                                   struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  int32_t   lDelta;
+
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stColorStats.lCommands++;
+  if ( pstReq->hue > ZCL_COLOR_MAX_HUE_SAT )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  APP_ZIGBEE_LevelPlayStop( ColorFill );
+  memset( &stColorDelta, 0, sizeof( stColorDelta ) );
+
+  lDelta = ( ( (int32_t)( pstReq->hue % COLOR_HUE_WHEEL ) - stColorCurrent.lHue ) + (int32_t)COLOR_HUE_WHEEL ) % (int32_t)COLOR_HUE_WHEEL;
+  switch ( pstReq->direction )
+  {
+    case ZCL_COLOR_MOVE_TO_DIR_SHORTEST:
+      lDelta = ( ( lDelta > ( (int32_t)COLOR_HUE_WHEEL / 2 ) ) ? ( lDelta - (int32_t)COLOR_HUE_WHEEL ) : lDelta );
+      break;
+
+    case ZCL_COLOR_MOVE_TO_DIR_LONGEST:
+      lDelta = ( ( ( lDelta != 0 ) && ( lDelta < ( (int32_t)COLOR_HUE_WHEEL / 2 ) ) ) ? ( lDelta - (int32_t)COLOR_HUE_WHEEL ) : lDelta );
+      break;
+
+    case ZCL_COLOR_MOVE_TO_DIR_UP:
+      break;
+
+    case ZCL_COLOR_MOVE_TO_DIR_DOWN:
+      lDelta = ( ( lDelta != 0 ) ? ( lDelta - (int32_t)COLOR_HUE_WHEEL ) : 0 );
+      break;
+
+    default:
+      return ZCL_STATUS_INVALID_FIELD;
+  }
+
+  stColorDelta.lHue = lDelta;
+  ColorStart( ZCL_COLOR_MODE_HS, pstReq->transition_time );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Color Server 'Move To Saturation' command.
+ * @param  pstCluster  Color Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT ColorMoveToSatCallback( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToSatReqT * pstReq,
+                                                   struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stColorStats.lCommands++;
+  if ( pstReq->sat > ZCL_COLOR_MAX_HUE_SAT )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  APP_ZIGBEE_LevelPlayStop( ColorFill );
+  memset( &stColorDelta, 0, sizeof( stColorDelta ) );
+  stColorDelta.lSat = ( (int32_t)pstReq->sat - stColorCurrent.lSat );
+  ColorStart( ZCL_COLOR_MODE_HS, pstReq->transition_time );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Color Server 'Move To Hue and Saturation' command, the hue by the shortest way.
+ * @param  pstCluster  Color Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT ColorMoveToHueSatCallback( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToHueSatReqT * pstReq,
+                                                      struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  int32_t   lDelta;
+
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stColorStats.lCommands++;
+  if ( ( pstReq->hue > ZCL_COLOR_MAX_HUE_SAT ) || ( pstReq->sat > ZCL_COLOR_MAX_HUE_SAT ) )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  APP_ZIGBEE_LevelPlayStop( ColorFill );
+  memset( &stColorDelta, 0, sizeof( stColorDelta ) );
+
+  lDelta = ( ( (int32_t)( pstReq->hue % COLOR_HUE_WHEEL ) - stColorCurrent.lHue ) + (int32_t)COLOR_HUE_WHEEL ) % (int32_t)COLOR_HUE_WHEEL;
+  stColorDelta.lHue = ( ( lDelta > ( (int32_t)COLOR_HUE_WHEEL / 2 ) ) ? ( lDelta - (int32_t)COLOR_HUE_WHEEL ) : lDelta );
+  stColorDelta.lSat = ( (int32_t)pstReq->sat - stColorCurrent.lSat );
+  ColorStart( ZCL_COLOR_MODE_HS, pstReq->transition_time );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Color Server 'Move To Color' command (CIE xy).
+ * @param  pstCluster  Color Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT ColorMoveToXyCallback( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientMoveToColorXYReqT * pstReq,
+                                                  struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stColorStats.lCommands++;
+  if ( ( pstReq->color_x > ZCL_COLOR_X_MAX ) || ( pstReq->color_y > ZCL_COLOR_Y_MAX ) )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  APP_ZIGBEE_LevelPlayStop( ColorFill );
+  memset( &stColorDelta, 0, sizeof( stColorDelta ) );
+  stColorDelta.lX = ( (int32_t)pstReq->color_x - stColorCurrent.lX );
+  stColorDelta.lY = ( (int32_t)pstReq->color_y - stColorCurrent.lY );
+  ColorStart( ZCL_COLOR_MODE_XY, pstReq->transition_time );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Color Server 'Stop Move Step' command : the ongoing transition stops at the color reached.
+ * @param  pstCluster  Color Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT ColorStopCallback( struct ZbZclClusterT * pstCluster, struct ZbZclColorClientStopMoveStepReqT * pstReq,
+                                              struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstReq );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stColorStats.lCommands++;
+  APP_ZIGBEE_LevelPlayStop( ColorFill );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Print the statistics of the Color Control Server.
+ * @param  None
+ * @retval None
+ */
+static void ColorPrintStats( void )
+{
+  uint16_t  aiColor[COLOR_CHANNELS];
+
+  ColorAt( 0, NULL, aiColor );
+  if ( cColorMode == ZCL_COLOR_MODE_HS )
+  {
+    LOG_INFO_APP( "Color : hue %d, saturation %d (RGB 0x%04X 0x%04X 0x%04X).", stColorCurrent.lHue, stColorCurrent.lSat,
+                  aiColor[0], aiColor[1], aiColor[2] );
+  }
+  else
+  {
+    LOG_INFO_APP( "Color : x 0x%04X, y 0x%04X (RGB 0x%04X 0x%04X 0x%04X).", stColorCurrent.lX, stColorCurrent.lY,
+                  aiColor[0], aiColor[1], aiColor[2] );
+  }
+  LOG_INFO_APP( "  %d commands, %d transitions (%d frames), %d immediate, %d stopped.", stColorStats.lCommands,
+                stColorStats.lTransitions, stColorStats.lFrames, stColorStats.lImmediate, stColorStats.lStopped );
+}
+
+#else /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
+
+/**
+ * @brief  Color Control Server not supported.
+ */
+void APP_ZIGBEE_ColorInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( pstOnOffServer );
+}
+
+/**
+ * @brief  Color Control Server not supported : no statistics.
+ */
+const APP_ZIGBEE_ColorStats_t * APP_ZIGBEE_ColorGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
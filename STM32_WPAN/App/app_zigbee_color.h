@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_color.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Color Control Server of the color light (R, G, B
+  *          PWM output of the Level Control Server).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_COLOR_H
+#define APP_ZIGBEE_COLOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the Color Control Server */
+typedef struct
+{
+  uint32_t    lCommands;              /* Move To Hue, Saturation, Hue and Saturation, Color and Stop commands received */
+  uint32_t    lTransitions;           /* Transitions played by the engine of the Level Server */
+  uint32_t    lImmediate;             /* Colors applied at once (no transition time, or output off) */
+  uint32_t    lStopped;               /* Transitions stopped before their end */
+  uint32_t    lFrames;                /* Frames of the transitions computed */
+  uint8_t     cMode;                  /* Color mode (ZCL_COLOR_MODE_HS or ZCL_COLOR_MODE_XY) */
+} APP_ZIGBEE_ColorStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_ColorInit              ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer );
+
+const APP_ZIGBEE_ColorStats_t * APP_ZIGBEE_ColorGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_COLOR_H */
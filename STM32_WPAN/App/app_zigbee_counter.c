@@ -0,0 +1,368 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_counter.c
+  * @author  MCD Application Team
+  * @brief   NWK frame counter log : the outgoing NWK frame counter is saved
+  *          in an append-only log of 16-byte records (one flash write each)
+  *          in two alternate flash pages, apart from the persistence data.
+  *          Each record reserves a stride of frame counters, and the counter
+  *          skips ahead to the last reservation at each Startup.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_manager.h"
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_counter.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_COUNTER_LOG_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define COUNTER_LOG_MAGIC               (0x4E46434Cu)           /* "NFCL" : NWK Frame Counter Log */
+#define COUNTER_LOG_ERASED              (0xFFFFFFFFu)
+#define COUNTER_LOG_PAGE_NB             (2u)
+#define COUNTER_LOG_SLOT_NB             ( FLASH_PAGE_SIZE / sizeof( CounterRecord_t ) )
+#define COUNTER_LOG_RESERVED_MAX        (0xFFFFFFFFu)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Record of the log : one flash write (128 bits) */
+typedef struct
+{
+  uint32_t    lMagic;
+  uint32_t    lReserved;              /* The frame counters used are below this value */
+  uint32_t    lReservedInv;           /* ~lReserved */
+  uint32_t    lRfu;
+} CounterRecord_t;
+
+typedef enum
+{
+  COUNTER_FLASH_IDLE,
+  COUNTER_FLASH_ERASE,
+  COUNTER_FLASH_WRITE,
+} CounterFlashState_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_CounterState_t    stCounterState;
+static CounterRecord_t              stCounterRecord;        /* Record being written */
+static bool                         bCounterRecordPending;  /* stCounterRecord not yet in flash */
+static CounterFlashState_t          eCounterFlashState;
+static FM_FlashOpNode_t             stCounterFlashOp;
+static UTIL_TIMER_Object_t          stCounterTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     CounterTask             ( void );
+static void     CounterTimerElapsed     ( void * arg );
+static void     CounterFlashProcess     ( void );
+static void     CounterFlashCallback    ( FM_FlashOp_Status_t eStatus );
+static const CounterRecord_t * CounterGetRecord   ( uint8_t cPage, uint32_t lSlot );
+static bool     CounterRecordIsValid    ( const CounterRecord_t * pstRecord );
+static bool     CounterRecordIsErased   ( const CounterRecord_t * pstRecord );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the NWK frame counter log : last reservation and next free record read from the two pages,
+ *         Task and Timer of the counter checks.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_CounterInit( void )
+{
+  const CounterRecord_t   * pstRecord;
+  uint32_t                alUsed[COUNTER_LOG_PAGE_NB];
+  bool                    abClean[COUNTER_LOG_PAGE_NB];
+  uint32_t                lSlot;
+  uint8_t                 cPage;
+
+  memset( &stCounterState, 0, sizeof( stCounterState ) );
+
+  for ( cPage = 0; cPage < COUNTER_LOG_PAGE_NB; cPage++ )
+  {
+    /* The records are appended : the valid ones first, then the erased slots */
+    alUsed[cPage] = 0;
+    abClean[cPage] = true;
+    for ( lSlot = 0; lSlot < COUNTER_LOG_SLOT_NB; lSlot++ )
+    {
+      pstRecord = CounterGetRecord( cPage, lSlot );
+      if ( ( lSlot == alUsed[cPage] ) && ( CounterRecordIsValid( pstRecord ) != false ) )
+      {
+        alUsed[cPage]++;
+        if ( pstRecord->lReserved > stCounterState.lReserved )
+        {
+          stCounterState.lReserved = pstRecord->lReserved;
+          stCounterState.cPage = cPage;
+        }
+      }
+      else if ( CounterRecordIsErased( pstRecord ) == false )
+      {
+        abClean[cPage] = false;
+      }
+    }
+  }
+
+  /* A page not clean after its records (interrupted write, other data) is full : the next record goes to the other page */
+  cPage = stCounterState.cPage;
+  stCounterState.iSlot = (uint16_t)( ( abClean[cPage] != false ) ? alUsed[cPage] : COUNTER_LOG_SLOT_NB );
+
+  LOG_INFO_APP( "NWK frame counter log : reservation %u (page %d, %d records).", stCounterState.lReserved, cPage, alUsed[cPage] );
+
+  stCounterFlashOp.Callback = CounterFlashCallback;
+  UTIL_TIMER_Create( &stCounterTimer, CFG_ZIGBEE_COUNTER_LOG_PERIOD, UTIL_TIMER_PERIODIC, &CounterTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_COUNTER ), UTIL_SEQ_RFU, CounterTask );
+}
+
+/**
+ * @brief  Start the NWK frame counter log (Network started) : the outgoing counter skips ahead to the last reservation,
+ *         then a new reservation is saved at once.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_CounterStart( void )
+{
+  uint32_t  lCounter = 0;
+
+  (void)ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_OutgoingCounter, &lCounter, sizeof( lCounter ) );
+  if ( lCounter < stCounterState.lReserved )
+  {
+    LOG_INFO_APP( "NWK frame counter restored from %u to %u.", lCounter, stCounterState.lReserved );
+    lCounter = stCounterState.lReserved;
+    (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_OutgoingCounter, &lCounter, sizeof( lCounter ) );
+  }
+  stCounterState.lCounter = lCounter;
+
+  UTIL_TIMER_Start( &stCounterTimer );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_COUNTER ), TASK_PRIO_ZIGBEE_COUNTER );
+}
+
+/**
+ * @brief  State of the NWK frame counter log.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_CounterState_t * APP_ZIGBEE_CounterGetState( void )
+{
+  return &stCounterState;
+}
+
+/**
+ * @brief  NWK frame counter log serial command : NWKCOUNTER (state of the log).
+ * @param  szCommand  Command received
+ * @retval True if the command is a frame counter log command.
+ */
+bool APP_ZIGBEE_CounterSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "NWKCOUNTER" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "NWK frame counter : %u, reserved up to %u (page %d, record %d), %d records, %d erases, %d errors.",
+                stCounterState.lCounter, stCounterState.lReserved, stCounterState.cPage, stCounterState.iSlot,
+                stCounterState.lRecords, stCounterState.lErases, stCounterState.lErrors );
+
+  return true;
+}
+
+/**
+ * @brief  Callback triggered when the period between two counter checks expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void CounterTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_COUNTER ), TASK_PRIO_ZIGBEE_COUNTER );
+}
+
+/**
+ * @brief  Frame counter log Task : a new reservation is saved when the outgoing counter comes within half a stride
+ *         of the last one. Also restarts the flash operation after an erase or a busy Flash Manager.
+ * @param  None
+ * @retval None
+ */
+static void CounterTask( void )
+{
+  uint32_t  lCounter;
+
+  if ( eCounterFlashState != COUNTER_FLASH_IDLE )
+  {
+    return;
+  }
+
+  if ( bCounterRecordPending == false )
+  {
+    if ( ZbNwkGet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_OutgoingCounter, &lCounter, sizeof( lCounter ) ) != ZB_STATUS_SUCCESS )
+    {
+      return;
+    }
+    stCounterState.lCounter = lCounter;
+
+    /* Enough frame counters left in the reservation */
+    if ( ( lCounter < stCounterState.lReserved ) && ( ( stCounterState.lReserved - lCounter ) > ( CFG_ZIGBEE_COUNTER_LOG_STRIDE / 2u ) ) )
+    {
+      return;
+    }
+
+    stCounterRecord.lMagic = COUNTER_LOG_MAGIC;
+    stCounterRecord.lReserved = ( lCounter < ( COUNTER_LOG_RESERVED_MAX - CFG_ZIGBEE_COUNTER_LOG_STRIDE ) ) ?
+                                ( lCounter + CFG_ZIGBEE_COUNTER_LOG_STRIDE ) : COUNTER_LOG_RESERVED_MAX;
+    stCounterRecord.lReservedInv = ~stCounterRecord.lReserved;
+    stCounterRecord.lRfu = 0;
+    bCounterRecordPending = true;
+  }
+
+  CounterFlashProcess();
+}
+
+/**
+ * @brief  Write the pending record in the next free slot. When the current page is full, the other page is erased
+ *         first : the full page keeps the last reservation until the record is written.
+ * @param  None
+ * @retval None
+ */
+static void CounterFlashProcess( void )
+{
+  FM_Cmd_Status_t   eStatus;
+  uint8_t           cPage = stCounterState.cPage;
+
+  if ( stCounterState.iSlot >= COUNTER_LOG_SLOT_NB )
+  {
+    eCounterFlashState = COUNTER_FLASH_ERASE;
+    eStatus = FM_QueueErase( ( CFG_ZIGBEE_COUNTER_LOG_SECTOR_ID + ( cPage ^ 1u ) ), 1u, FM_PRIORITY_NVM, &stCounterFlashOp );
+  }
+  else
+  {
+    eCounterFlashState = COUNTER_FLASH_WRITE;
+    eStatus = FM_QueueWrite( (uint32_t *)&stCounterRecord, (uint32_t *)CounterGetRecord( cPage, stCounterState.iSlot ),
+                             (int32_t)( sizeof( stCounterRecord ) / sizeof( uint32_t ) ), FM_PRIORITY_NVM, &stCounterFlashOp );
+  }
+
+  /* One operation at a time : the queue of the class is never full */
+  if ( eStatus != FM_OK )
+  {
+    LOG_ERROR_APP( "Error, NWK frame counter log flash operation refused (page %d, record %d).", cPage, stCounterState.iSlot );
+    eCounterFlashState = COUNTER_FLASH_IDLE;
+    bCounterRecordPending = false;
+    stCounterState.lErrors++;
+  }
+}
+
+/**
+ * @brief  Flash Manager callback : end of a queued erase/write.
+ * @param  eStatus  Flash operation status
+ * @retval None
+ */
+static void CounterFlashCallback( FM_FlashOp_Status_t eStatus )
+{
+  if ( eStatus == FM_OPERATION_COMPLETE )
+  {
+    if ( eCounterFlashState == COUNTER_FLASH_ERASE )
+    {
+      stCounterState.cPage ^= 1u;
+      stCounterState.iSlot = 0;
+      stCounterState.lErases++;
+    }
+    else if ( eCounterFlashState == COUNTER_FLASH_WRITE )
+    {
+      stCounterState.iSlot++;
+      stCounterState.lReserved = stCounterRecord.lReserved;
+      stCounterState.lRecords++;
+      bCounterRecordPending = false;
+    }
+  }
+
+  /* After an erase, the record is written by the Task */
+  eCounterFlashState = COUNTER_FLASH_IDLE;
+  if ( bCounterRecordPending != false )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_COUNTER ), TASK_PRIO_ZIGBEE_COUNTER );
+  }
+}
+
+/**
+ * @brief  Record of the log in flash.
+ * @param  cPage    Page of the log (0 or 1)
+ * @param  lSlot    Record in the page
+ * @retval Record
+ */
+static const CounterRecord_t * CounterGetRecord( uint8_t cPage, uint32_t lSlot )
+{
+  return (const CounterRecord_t *)( CFG_ZIGBEE_COUNTER_LOG_ADDRESS + ( (uint32_t)cPage * FLASH_PAGE_SIZE ) +
+                                    ( lSlot * sizeof( CounterRecord_t ) ) );
+}
+
+/**
+ * @brief  Check of a record read from flash.
+ * @param  pstRecord  Record
+ * @retval True if the record holds a reservation.
+ */
+static bool CounterRecordIsValid( const CounterRecord_t * pstRecord )
+{
+  return ( ( pstRecord->lMagic == COUNTER_LOG_MAGIC ) && ( pstRecord->lReservedInv == ~pstRecord->lReserved ) );
+}
+
+/**
+ * @brief  Check of a free slot.
+ * @param  pstRecord  Record
+ * @retval True if the record is erased (can be written).
+ */
+static bool CounterRecordIsErased( const CounterRecord_t * pstRecord )
+{
+  return ( ( pstRecord->lMagic == COUNTER_LOG_ERASED ) && ( pstRecord->lReserved == COUNTER_LOG_ERASED ) &&
+           ( pstRecord->lReservedInv == COUNTER_LOG_ERASED ) && ( pstRecord->lRfu == COUNTER_LOG_ERASED ) );
+}
+
+#else /* (CFG_ZIGBEE_COUNTER_LOG_SUPPORTED != 0) */
+
+/**
+ * @brief  NWK frame counter log not supported : counter saved with the persistence data only.
+ */
+void APP_ZIGBEE_CounterInit( void )
+{
+}
+
+/**
+ * @brief  NWK frame counter log not supported : counter saved with the persistence data only.
+ */
+void APP_ZIGBEE_CounterStart( void )
+{
+}
+
+/**
+ * @brief  NWK frame counter log not supported : no command.
+ */
+bool APP_ZIGBEE_CounterSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  NWK frame counter log not supported : no state.
+ */
+const APP_ZIGBEE_CounterState_t * APP_ZIGBEE_CounterGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_COUNTER_LOG_SUPPORTED != 0) */
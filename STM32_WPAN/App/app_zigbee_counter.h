@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_counter.h
+  * @author  MCD Application Team
+  * @brief   Interface of the NWK frame counter log (append-only flash records).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_COUNTER_H
+#define APP_ZIGBEE_COUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the NWK frame counter log */
+typedef struct
+{
+  uint32_t    lCounter;               /* Outgoing NWK frame counter at the last check */
+  uint32_t    lReserved;              /* Last reservation saved : the counter restarts from it */
+  uint32_t    lRecords;               /* Records written since the boot */
+  uint32_t    lErases;                /* Pages erased since the boot */
+  uint32_t    lErrors;                /* Flash operations refused */
+  uint16_t    iSlot;                  /* Next free record of the current page */
+  uint8_t     cPage;                  /* Current page of the log (0 or 1) */
+} APP_ZIGBEE_CounterState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_CounterInit            ( void );
+void      APP_ZIGBEE_CounterStart           ( void );
+bool      APP_ZIGBEE_CounterSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_CounterState_t *   APP_ZIGBEE_CounterGetState    ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_COUNTER_H */
@@ -0,0 +1,365 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_csma.c
+  * @author  MCD Application Team
+  * @brief   CSMA-CA parameters tuning : the CCA failure and no acknowledgment
+  *          rates of the MAC transmissions are sampled, the backoff (macMinBE,
+  *          macMaxBE, macMaxCSMABackoffs) is widened under contention and
+  *          narrowed on a quiet channel, the frame retries follow the losses,
+  *          all within configured bounds.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_csma.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_CSMA_TUNING_SUPPORTED != 0)
+#include "ieee802154_api.h"
+#include "mcp_enums.h"
+#include "mac_sys_if.h"
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_CsmaState_t       stCsmaState;
+static bool                         bCsmaDefaultRead;
+static MAC_SYS_Counters_t           stCsmaSampleStart;      /* MAC counters at the start of the sample */
+static UTIL_TIMER_Object_t          stCsmaTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     CsmaTask                ( void );
+static void     CsmaTimerElapsed        ( void * arg );
+static struct WpanPublicT * CsmaGetMac  ( void );
+static bool     CsmaRead                ( struct WpanPublicT * pstMac, APP_ZIGBEE_CsmaParams_t * pstParams );
+static void     CsmaApply               ( struct WpanPublicT * pstMac, const APP_ZIGBEE_CsmaParams_t * pstParams );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the CSMA-CA parameters tuning : Task and Timer of the samples.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_CsmaInit( void )
+{
+  UTIL_TIMER_Create( &stCsmaTimer, CFG_ZIGBEE_CSMA_PERIOD, UTIL_TIMER_PERIODIC, &CsmaTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CSMA ), UTIL_SEQ_RFU, CsmaTask );
+}
+
+/**
+ * @brief  Start the tuning (once on the Network) : the parameters of the MAC at the first start are the defaults,
+ *         the parameters in use are set again after a new start.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_CsmaStart( void )
+{
+  MAC_SYS_Stats_t       stMacStats;
+  struct WpanPublicT  * pstMac = CsmaGetMac();
+
+  if ( pstMac == NULL )
+  {
+    LOG_ERROR_APP( "Error, CSMA tuning : no MAC interface." );
+    return;
+  }
+
+  if ( bCsmaDefaultRead == false )
+  {
+    if ( CsmaRead( pstMac, &stCsmaState.stDefault ) == false )
+    {
+      LOG_ERROR_APP( "Error, CSMA tuning : CSMA parameters of the MAC not readable." );
+      return;
+    }
+    stCsmaState.stParams = stCsmaState.stDefault;
+    bCsmaDefaultRead = true;
+  }
+  else
+  {
+    CsmaApply( pstMac, &stCsmaState.stParams );
+  }
+
+  MacSys_GetStats( &stMacStats );
+  stCsmaSampleStart = stMacStats.Total;
+  UTIL_TIMER_Start( &stCsmaTimer );
+}
+
+/**
+ * @brief  State of the CSMA-CA parameters tuning.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_CsmaState_t * APP_ZIGBEE_CsmaGetState( void )
+{
+  return &stCsmaState;
+}
+
+/**
+ * @brief  CSMA serial command : CSMA (state).
+ * @param  szCommand  Command received
+ * @retval True if the command is a CSMA command.
+ */
+bool APP_ZIGBEE_CsmaSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "CSMA" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "CSMA : BE %d-%d, %d backoffs, %d retries (defaults BE %d-%d, %d backoffs, %d retries).",
+                stCsmaState.stParams.cMinBe, stCsmaState.stParams.cMaxBe, stCsmaState.stParams.cMaxBackoffs,
+                stCsmaState.stParams.cMaxRetries, stCsmaState.stDefault.cMinBe, stCsmaState.stDefault.cMaxBe,
+                stCsmaState.stDefault.cMaxBackoffs, stCsmaState.stDefault.cMaxRetries );
+  LOG_INFO_APP( "CSMA : last sample %u TX, CCA failures %d %%, no ACK %d %%, %u samples.",
+                stCsmaState.lTxNb, stCsmaState.cCcaFailRate, stCsmaState.cNoAckRate, stCsmaState.lSampleNb );
+  LOG_INFO_APP( "CSMA : backoff %u widened / %u narrowed, retries %u up / %u down, %u restores, %u set failures.",
+                stCsmaState.lWidens, stCsmaState.lNarrows, stCsmaState.lRetryIncreases, stCsmaState.lRetryDecreases,
+                stCsmaState.lRestores, stCsmaState.lSetFailures );
+
+  return true;
+}
+
+/**
+ * @brief  CSMA Task : rates of the sample, then one step of each parameter. Under contention (CCA failures above
+ *         CFG_ZIGBEE_CSMA_CCA_HIGH) the backoff is widened, on a quiet channel (below CFG_ZIGBEE_CSMA_CCA_LOW, and
+ *         acknowledgments received) it is narrowed. The frame retries are raised on losses (no acknowledgment above
+ *         CFG_ZIGBEE_CSMA_NO_ACK_HIGH) and lowered back to the default below CFG_ZIGBEE_CSMA_NO_ACK_LOW.
+ * @param  None
+ * @retval None
+ */
+static void CsmaTask( void )
+{
+  MAC_SYS_Stats_t           stMacStats;
+  APP_ZIGBEE_CsmaParams_t   stParams = stCsmaState.stParams;
+  APP_ZIGBEE_CsmaParams_t   stMacParams;
+  struct WpanPublicT        * pstMac;
+  uint32_t                  lTxNb, lCcaFailNb, lNoAckNb, lSentNb;
+  uint8_t                   cMaxBeLow;
+
+  MacSys_GetStats( &stMacStats );
+  lTxNb = stMacStats.Total.TxCount - stCsmaSampleStart.TxCount;
+  lCcaFailNb = stMacStats.Total.TxCcaFailCount - stCsmaSampleStart.TxCcaFailCount;
+  lNoAckNb = stMacStats.Total.TxNoAckCount - stCsmaSampleStart.TxNoAckCount;
+
+  /* Too few transmissions : the sample goes on */
+  if ( lTxNb < CFG_ZIGBEE_CSMA_TX_MIN )
+  {
+    return;
+  }
+
+  stCsmaSampleStart = stMacStats.Total;
+  lSentNb = ( lTxNb > lCcaFailNb ) ? ( lTxNb - lCcaFailNb ) : 0u;
+  stCsmaState.lTxNb = lTxNb;
+  stCsmaState.lSampleNb++;
+  stCsmaState.cCcaFailRate = (uint8_t)( ( lCcaFailNb * 100u ) / lTxNb );
+  stCsmaState.cNoAckRate = ( lSentNb != 0u ) ? (uint8_t)( ( lNoAckNb * 100u ) / lSentNb ) : 0u;
+
+  pstMac = CsmaGetMac();
+  if ( pstMac == NULL )
+  {
+    return;
+  }
+
+  /* Parameters set back to the defaults of the MAC (MLME-RESET) : set again */
+  if ( ( CsmaRead( pstMac, &stMacParams ) != false ) && ( memcmp( &stMacParams, &stCsmaState.stParams, sizeof( stMacParams ) ) != 0 ) )
+  {
+    stCsmaState.lRestores++;
+    CsmaApply( pstMac, &stCsmaState.stParams );
+  }
+
+  /* macMaxBE never below the default nor macMinBE */
+  if ( stCsmaState.cCcaFailRate >= CFG_ZIGBEE_CSMA_CCA_HIGH )
+  {
+    if ( stParams.cMinBe < CFG_ZIGBEE_CSMA_MIN_BE_HIGH )
+    {
+      stParams.cMinBe++;
+    }
+    if ( stParams.cMaxBe < CFG_ZIGBEE_CSMA_MAX_BE_HIGH )
+    {
+      stParams.cMaxBe++;
+    }
+    if ( stParams.cMaxBackoffs < CFG_ZIGBEE_CSMA_BACKOFFS_HIGH )
+    {
+      stParams.cMaxBackoffs++;
+    }
+  }
+  else if ( ( stCsmaState.cCcaFailRate <= CFG_ZIGBEE_CSMA_CCA_LOW ) && ( stCsmaState.cNoAckRate < CFG_ZIGBEE_CSMA_NO_ACK_HIGH ) )
+  {
+    if ( stParams.cMinBe > CFG_ZIGBEE_CSMA_MIN_BE_LOW )
+    {
+      stParams.cMinBe--;
+    }
+    if ( stParams.cMaxBe > stCsmaState.stDefault.cMaxBe )
+    {
+      stParams.cMaxBe--;
+    }
+    if ( stParams.cMaxBackoffs > stCsmaState.stDefault.cMaxBackoffs )
+    {
+      stParams.cMaxBackoffs--;
+    }
+  }
+  cMaxBeLow = ( stParams.cMinBe > stCsmaState.stDefault.cMaxBe ) ? stParams.cMinBe : stCsmaState.stDefault.cMaxBe;
+  if ( stParams.cMaxBe < cMaxBeLow )
+  {
+    stParams.cMaxBe = cMaxBeLow;
+  }
+
+  if ( ( stCsmaState.cNoAckRate >= CFG_ZIGBEE_CSMA_NO_ACK_HIGH ) && ( stParams.cMaxRetries < CFG_ZIGBEE_CSMA_RETRIES_HIGH ) )
+  {
+    stParams.cMaxRetries++;
+    stCsmaState.lRetryIncreases++;
+  }
+  else if ( ( stCsmaState.cNoAckRate <= CFG_ZIGBEE_CSMA_NO_ACK_LOW ) && ( stParams.cMaxRetries > stCsmaState.stDefault.cMaxRetries ) )
+  {
+    stParams.cMaxRetries--;
+    stCsmaState.lRetryDecreases++;
+  }
+
+  if ( ( stParams.cMaxBe + stParams.cMinBe + stParams.cMaxBackoffs ) >
+       ( stCsmaState.stParams.cMaxBe + stCsmaState.stParams.cMinBe + stCsmaState.stParams.cMaxBackoffs ) )
+  {
+    stCsmaState.lWidens++;
+  }
+  else if ( ( stParams.cMaxBe + stParams.cMinBe + stParams.cMaxBackoffs ) <
+            ( stCsmaState.stParams.cMaxBe + stCsmaState.stParams.cMinBe + stCsmaState.stParams.cMaxBackoffs ) )
+  {
+    stCsmaState.lNarrows++;
+  }
+
+  if ( memcmp( &stParams, &stCsmaState.stParams, sizeof( stParams ) ) != 0 )
+  {
+    CsmaApply( pstMac, &stParams );
+    LOG_DEBUG_APP( "CSMA : BE %d-%d, %d backoffs, %d retries (CCA failures %d %%, no ACK %d %%).", stParams.cMinBe,
+                   stParams.cMaxBe, stParams.cMaxBackoffs, stParams.cMaxRetries, stCsmaState.cCcaFailRate, stCsmaState.cNoAckRate );
+  }
+}
+
+/**
+ * @brief  Callback triggered when the period between two samples expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void CsmaTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_CSMA ), TASK_PRIO_ZIGBEE_CSMA );
+}
+
+/**
+ * @brief  MAC interface of the stack (NLME-GET-INTERFACE on Interface 0).
+ * @param  None
+ * @retval MAC interface, NULL if unknown.
+ */
+static struct WpanPublicT * CsmaGetMac( void )
+{
+  struct ZbNlmeGetInterfaceReqT   stZbNlmeRequest;
+  struct ZbNlmeGetInterfaceConfT  stZbNlmeConfig;
+
+  memset( &stZbNlmeRequest, 0, sizeof( stZbNlmeRequest ) );
+  memset( &stZbNlmeConfig, 0, sizeof( stZbNlmeConfig ) );
+  stZbNlmeRequest.ifcIndex = 0;
+
+  ZbNlmeGetInterface( stZigbeeAppInfo.pstZigbee, &stZbNlmeRequest, &stZbNlmeConfig );
+  return ( stZbNlmeConfig.status == ZB_STATUS_SUCCESS ) ? stZbNlmeConfig.mac : NULL;
+}
+
+/**
+ * @brief  Read the CSMA-CA parameters of the MAC (MLME-GET).
+ * @param  pstMac     MAC interface
+ * @param  pstParams  Parameters read
+ * @retval True if all the parameters are read.
+ */
+static bool CsmaRead( struct WpanPublicT * pstMac, APP_ZIGBEE_CsmaParams_t * pstParams )
+{
+  return ( wpan_get_uint8( pstMac, mcp_macMinBE, &pstParams->cMinBe, 0 ) != false ) &&
+         ( wpan_get_uint8( pstMac, mcp_macMaxBE, &pstParams->cMaxBe, 0 ) != false ) &&
+         ( wpan_get_uint8( pstMac, mcp_macMaxCsmaBackoffs, &pstParams->cMaxBackoffs, 0 ) != false ) &&
+         ( wpan_get_uint8( pstMac, mcp_macMaxFrameRetries, &pstParams->cMaxRetries, 0 ) != false );
+}
+
+/**
+ * @brief  Set the CSMA-CA parameters of the MAC (MLME-SET). macMaxBE is set first when raised : macMinBE shall not
+ *         exceed it.
+ * @param  pstMac     MAC interface
+ * @param  pstParams  Parameters to set
+ * @retval None
+ */
+static void CsmaApply( struct WpanPublicT * pstMac, const APP_ZIGBEE_CsmaParams_t * pstParams )
+{
+  bool    bResult = true;
+
+  if ( pstParams->cMaxBe >= stCsmaState.stParams.cMaxBe )
+  {
+    bResult &= wpan_set_uint8( pstMac, mcp_macMaxBE, pstParams->cMaxBe, 0 );
+    bResult &= wpan_set_uint8( pstMac, mcp_macMinBE, pstParams->cMinBe, 0 );
+  }
+  else
+  {
+    bResult &= wpan_set_uint8( pstMac, mcp_macMinBE, pstParams->cMinBe, 0 );
+    bResult &= wpan_set_uint8( pstMac, mcp_macMaxBE, pstParams->cMaxBe, 0 );
+  }
+  bResult &= wpan_set_uint8( pstMac, mcp_macMaxCsmaBackoffs, pstParams->cMaxBackoffs, 0 );
+  bResult &= wpan_set_uint8( pstMac, mcp_macMaxFrameRetries, pstParams->cMaxRetries, 0 );
+
+  if ( bResult == false )
+  {
+    stCsmaState.lSetFailures++;
+    LOG_ERROR_APP( "Error, CSMA parameters refused by the MAC." );
+    return;
+  }
+
+  stCsmaState.stParams = *pstParams;
+}
+
+#else /* (CFG_ZIGBEE_CSMA_TUNING_SUPPORTED != 0) */
+
+/**
+ * @brief  CSMA-CA parameters tuning not supported : defaults of the MAC.
+ */
+void APP_ZIGBEE_CsmaInit( void )
+{
+}
+
+/**
+ * @brief  CSMA-CA parameters tuning not supported : defaults of the MAC.
+ */
+void APP_ZIGBEE_CsmaStart( void )
+{
+}
+
+/**
+ * @brief  CSMA-CA parameters tuning not supported : no command.
+ */
+bool APP_ZIGBEE_CsmaSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  CSMA-CA parameters tuning not supported : no state.
+ */
+const APP_ZIGBEE_CsmaState_t * APP_ZIGBEE_CsmaGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_CSMA_TUNING_SUPPORTED != 0) */
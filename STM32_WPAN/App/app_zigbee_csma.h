@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_csma.h
+  * @author  MCD Application Team
+  * @brief   Interface of the CSMA-CA parameters tuning.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_CSMA_H
+#define APP_ZIGBEE_CSMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* CSMA-CA parameters of the MAC (PIB) */
+typedef struct
+{
+  uint8_t     cMinBe;                 /* macMinBE */
+  uint8_t     cMaxBe;                 /* macMaxBE */
+  uint8_t     cMaxBackoffs;           /* macMaxCSMABackoffs */
+  uint8_t     cMaxRetries;            /* macMaxFrameRetries */
+} APP_ZIGBEE_CsmaParams_t;
+
+/* State of the CSMA-CA parameters tuning */
+typedef struct
+{
+  APP_ZIGBEE_CsmaParams_t   stParams;       /* Parameters in use */
+  APP_ZIGBEE_CsmaParams_t   stDefault;      /* Parameters of the MAC at the start (lower bounds, except macMinBE) */
+  uint8_t     cCcaFailRate;           /* %, CCA failures of the transmissions of the last sample */
+  uint8_t     cNoAckRate;             /* %, transmissions not acknowledged of the last sample */
+  uint32_t    lTxNb;                  /* Transmissions of the last sample */
+  uint32_t    lSampleNb;              /* Samples done (with enough transmissions) */
+  uint32_t    lWidens;                /* Steps up of the backoff */
+  uint32_t    lNarrows;               /* Steps down of the backoff */
+  uint32_t    lRetryIncreases;        /* Steps up of the frame retries */
+  uint32_t    lRetryDecreases;        /* Steps down of the frame retries */
+  uint32_t    lRestores;              /* Parameters found changed in the MAC (reset) and set again */
+  uint32_t    lSetFailures;           /* MLME-SET refused */
+} APP_ZIGBEE_CsmaState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_CsmaInit               ( void );
+void      APP_ZIGBEE_CsmaStart              ( void );
+bool      APP_ZIGBEE_CsmaSerialCmdExecute   ( const char * szCommand );
+
+const APP_ZIGBEE_CsmaState_t * APP_ZIGBEE_CsmaGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_CSMA_H */
@@ -44,13 +44,50 @@
 
 /* USER CODE BEGIN PI */
 #include "app_bsp.h"
+#include "app_zigbee_fanout.h"
+#include "app_zigbee_indirect.h"
+#include "app_zigbee_findbind.h"
+#include "app_zigbee_traffic.h"
+#include "app_zigbee_health.h"
+#include "app_zigbee_report.h"
+#include "app_zigbee_route.h"
+#include "app_zigbee_linkstatus.h"
+#include "app_zigbee_addr.h"
+#include "app_zigbee_bindmap.h"
+#include "app_zigbee_tckey.h"
+#include "app_zigbee_hashkey.h"
+#include "app_zigbee_ota.h"
+#include "app_zigbee_ota_server.h"
+#include "app_zigbee_stagger.h"
+#include "app_zigbee_poll.h"
+#include "app_zigbee_perf.h"
+#include "app_zigbee_attr.h"
+#include "app_zigbee_batch.h"
+#include "app_zigbee_meter.h"
+#include "app_zigbee_frag.h"
+#include "app_zigbee_gp.h"
+#include "app_zigbee_touchlink.h"
+#include "app_zigbee_zdd.h"
+#include "app_zigbee_bench.h"
+#include "app_zigbee_txpower.h"
+#include "app_zigbee_csma.h"
+#include "app_zigbee_channel.h"
+#include "app_zigbee_counter.h"
+#include "app_zigbee_level.h"
+#include "app_zigbee_color.h"
+#include "app_zigbee_scene.h"
+#include "app_zigbee_timesync.h"
+#include "zcl/general/zcl.diagnostics.h"
+#include "zcl/general/zcl.groups.h"
+#include "zcl/general/zcl.scenes.h"
 
 /* USER CODE END PI */
 
 /* Private defines -----------------------------------------------------------*/
-#define APP_ZIGBEE_CHANNEL                14u
-#define APP_ZIGBEE_CHANNEL_MASK           ( 1u << APP_ZIGBEE_CHANNEL )
-#define APP_ZIGBEE_TX_POWER               ((int8_t) 10)    /* TX-Power is at +10 dBm. */
+#define APP_ZIGBEE_CHANNEL                14u                         /* Channel tried first at the first Join */
+#define APP_ZIGBEE_CHANNEL_MASK           WPAN_CHANNELMASK_2400MHZ    /* Channels allowed to Form/Join (11 to 26) */
+#define APP_ZIGBEE_TX_POWER               ((int8_t) 10)    /* TX-Power is at +10 dBm (maximum of the adaptive TX power). */
+#define APP_ZIGBEE_CONCENTRATOR           false                       /* Gateway-adjacent Routers only (CONCENTRATOR ON) */
 
 #define APP_ZIGBEE_ENDPOINT               17u
 #define APP_ZIGBEE_PROFILE_ID             ZCL_PROFILE_HOME_AUTOMATION
@@ -66,25 +103,91 @@
 
 #define APP_ZIGBEE_TOGGLE_PERIOD          (uint32_t)( 1000u ) /* Toggle OnOff every seconds 1s */
 
+#define APP_ZIGBEE_SERVER_ENDPOINT        18u                         /* Paired actuator (OnOff Server) */
+#if (CFG_ZIGBEE_COLOR_SUPPORTED != 0)
+#define APP_ZIGBEE_SERVER_DEVICE_ID       ZCL_DEVICE_COLOR_DIMMABLE_LIGHT   /* Color light (Level & Color Servers) */
+#elif (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0)
+#define APP_ZIGBEE_SERVER_DEVICE_ID       ZCL_DEVICE_LEVEL_OUTPUT     /* Dimmer (Level Server) */
+#else /* (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) */
+#define APP_ZIGBEE_SERVER_DEVICE_ID       ZCL_DEVICE_ONOFF_OUTPUT
+#endif /* (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) */
+#define APP_ZIGBEE_SERVER_LED             LED_GREEN
+
+#define APP_ZIGBEE_FASTPATH_CLUSTER_MAX   ( ZCL_CLUSTER_LEVEL_CONTROL + 1u )  /* Hot clusters : Groups, Scenes, OnOff, Level */
+
 /* USER CODE END PD */
 
 // -- Redefine Clusters to better code read --
-#define OnOffClient                       pstZbCluster[0]
+#define APP_ZIGBEE_ONOFF_CLIENT_INDEX     0u
+#define APP_ZIGBEE_ONOFF_SERVER_INDEX     1u
+#define APP_ZIGBEE_GROUPS_SERVER_INDEX    2u
+#define APP_ZIGBEE_SCENES_SERVER_INDEX    3u
+#define OnOffClient                       pstZbCluster[APP_ZIGBEE_ONOFF_CLIENT_INDEX]
+#define OnOffServer                       pstZbCluster[APP_ZIGBEE_ONOFF_SERVER_INDEX]
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+/* Fast path handler of a hot cluster, called with the ZCL header and payload of a cluster specific command to the Server */
+typedef void ( * APP_ZIGBEE_FastPathHandler_t )( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength );
 
 /* USER CODE END PTD */
 
 /* Private constants ---------------------------------------------------------*/
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+static struct ZbZclClusterT * APP_ZIGBEE_OnOffServerAlloc   ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint );
+static struct ZbZclClusterT * APP_ZIGBEE_ScenesServerAlloc  ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+
+/* Endpoints and Clusters of the application, walked by APP_ZIGBEE_ConfigEndpoints (one line per Endpoint/Cluster) */
+static const APP_ZIGBEE_EndpointDesc_t    astEndpointTable[] =
+{
+  { APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID, APP_ZIGBEE_DEVICE_ID },
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+  { APP_ZIGBEE_SERVER_ENDPOINT, APP_ZIGBEE_PROFILE_ID, APP_ZIGBEE_SERVER_DEVICE_ID },
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+};
+
+static const APP_ZIGBEE_ClusterDesc_t     astClusterTable[] =
+{
+  { APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_ONOFF_CLIENT_INDEX, ZbZclOnOffClientAlloc, APP_ZIGBEE_CLUSTER_NAME },
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+  { APP_ZIGBEE_SERVER_ENDPOINT, APP_ZIGBEE_ONOFF_SERVER_INDEX, APP_ZIGBEE_OnOffServerAlloc, "OnOff Server" },
+  { APP_ZIGBEE_SERVER_ENDPOINT, APP_ZIGBEE_GROUPS_SERVER_INDEX, ZbZclGroupsServerAlloc, "Groups Server" },
+  { APP_ZIGBEE_SERVER_ENDPOINT, APP_ZIGBEE_SCENES_SERVER_INDEX, APP_ZIGBEE_ScenesServerAlloc, "Scenes Server" },
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+};
+
 /* USER CODE BEGIN PC */
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
+static void APP_ZIGBEE_OnOffServerFastPath    ( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength );
+#if (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0)
+static void APP_ZIGBEE_GroupsServerFastPath   ( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength );
+static void APP_ZIGBEE_ScenesServerFastPath   ( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength );
+#endif /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) */
+
+/* Hot clusters of the Server Endpoint, indexed by cluster (the Level Server of the dimmer goes through the stack) */
+static const APP_ZIGBEE_FastPathHandler_t apfFastPathTable[APP_ZIGBEE_FASTPATH_CLUSTER_MAX] =
+{
+  [ZCL_CLUSTER_ONOFF] = APP_ZIGBEE_OnOffServerFastPath,
+#if (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0)
+  [ZCL_CLUSTER_GROUPS] = APP_ZIGBEE_GroupsServerFastPath,
+  [ZCL_CLUSTER_SCENES] = APP_ZIGBEE_ScenesServerFastPath,
+#endif /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) */
+};
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
 
 /* USER CODE END PC */
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
-
-static UTIL_TIMER_Object_t      stTimerToggle;
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+static bool     bOnOffServerOutput;             /* Output state, cached to answer without an attribute read */
+static enum ZclStatusCodeT (*pfOnOffServerSetSceneData)( struct ZbZclClusterT * cluster, uint8_t * extData, uint8_t extLen, uint16_t transition_tenths );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
+static uint16_t iFastPathLastSrc = ZB_NWK_ADDR_UNDEFINED;   /* Source and ZCL sequence of the last fast path command */
+static uint8_t  cFastPathLastSeq;
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
 
 /* USER CODE END PV */
 
@@ -93,7 +196,20 @@ static UTIL_TIMER_Object_t      stTimerToggle;
 /* USER CODE BEGIN PFP */
 static void APP_ZIGBEE_ApplicationTaskInit    ( void );
 static void APP_ZIGBEE_OnOffClientStart       ( void );
-static void APP_ZIGBEE_TimerToggleCallback    ( void * arg );
+static void APP_ZIGBEE_PersistNotifyCallback  ( struct ZigBeeT * zb, void * cbarg );
+static void APP_ZIGBEE_OnOffFanoutCallback    ( const APP_ZIGBEE_FanoutResult_t * pstResult, void * arg );
+static void APP_ZIGBEE_FindBindCallback       ( const APP_ZIGBEE_FindBindResult_t * pstResult, void * arg );
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+static void APP_ZIGBEE_OnOffServerOutput      ( struct ZbZclClusterT * pstCluster, bool bOn );
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerOffCallback     ( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerOnCallback      ( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerToggleCallback  ( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerSetSceneData    ( struct ZbZclClusterT * pstCluster, uint8_t * pExtData, uint8_t cExtLength, uint16_t iTransition );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
+static enum zb_msg_filter_rc APP_ZIGBEE_FastPathCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+static void APP_ZIGBEE_ServerTimedOutput      ( uint16_t iClusterId, const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
 
 /* USER CODE END PFP */
 
@@ -113,8 +229,11 @@ void APP_ZIGBEE_ApplicationInit(void)
 
   /* Configure Application Form/Join parameters : Startup, Persistence and Start with/without Form/Join */
   stZigbeeAppInfo.eStartupControl = ZbStartTypeJoin;
-  stZigbeeAppInfo.bPersistNotification = false;
+  stZigbeeAppInfo.bPersistNotification = ( CFG_ZIGBEE_PERSISTENCE_SUPPORTED != 0 );
   stZigbeeAppInfo.bNwkStartup = true;
+  stZigbeeAppInfo.lChannelMask = APP_ZIGBEE_CHANNEL_MASK;
+  stZigbeeAppInfo.cLastChannel = APP_ZIGBEE_CHANNEL;
+  stZigbeeAppInfo.bConcentrator = APP_ZIGBEE_CONCENTRATOR;
 
   /* USER CODE BEGIN APP_ZIGBEE_ApplicationInit */
   /* Initialization of used Tasks */
@@ -135,13 +254,40 @@ void APP_ZIGBEE_ApplicationStart( void )
 {
   /* USER CODE BEGIN APP_ZIGBEE_ApplicationStart */
 
+  /* Outgoing NWK frame counter skipped ahead to its last reservation, before any frame of the Application */
+  APP_ZIGBEE_CounterStart();
+
   /* Start OnOff Client */
   APP_ZIGBEE_OnOffClientStart();
 
+  /* Start the samples of the Network health */
+  APP_ZIGBEE_HealthStart();
+
+  /* Sleepy End Device : start the data polls of the Parent */
+  APP_ZIGBEE_PollStart();
+
+  /* Adapt the TX power to the links */
+  APP_ZIGBEE_TxPowerStart();
+
+  /* Tune the CSMA-CA parameters to the contention */
+  APP_ZIGBEE_CsmaStart();
+
+  /* Monitor the noise of the channels */
+  APP_ZIGBEE_ChannelStart();
+
+  /* Share the time base of the master */
+  APP_ZIGBEE_TimeSyncStart();
+
   /* Display Short Address */
   LOG_INFO_APP( "Use Short Address : 0x%04X", ZbShortAddress( stZigbeeAppInfo.pstZigbee ) );
   LOG_INFO_APP( "%s ready to work !", APP_ZIGBEE_APPLICATION_NAME );
 
+  /* Operational : end of the boot profile (printed once) */
+  APPE_BOOT_Mark( APPE_BOOT_APPLICATION_START );
+
+  /* Boot allocations done : part of the ZIGBEE_INIT reservation can go to the runtime */
+  APPE_AMM_RebalanceStart();
+
   /* USER CODE END APP_ZIGBEE_ApplicationStart */
 
 #if ( CFG_LPM_LEVEL != 0)
@@ -161,6 +307,11 @@ void APP_ZIGBEE_ApplicationStart( void )
 void APP_ZIGBEE_PersistenceStartup(void)
 {
   /* USER CODE BEGIN APP_ZIGBEE_PersistenceStartup */
+  /* Save the stack persistence data every time the stack notifies a change */
+  if ( ZbPersistNotifyRegister( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_PersistNotifyCallback, NULL ) == false )
+  {
+    LOG_ERROR_APP( "Error, Persistence notification registration failed" );
+  }
 
   /* USER CODE END APP_ZIGBEE_PersistenceStartup */
 }
@@ -172,28 +323,86 @@ void APP_ZIGBEE_PersistenceStartup(void)
  */
 void APP_ZIGBEE_ConfigEndpoints(void)
 {
-  struct ZbApsmeAddEndpointReqT   stRequest;
-  struct ZbApsmeAddEndpointConfT  stConfig;
   /* USER CODE BEGIN APP_ZIGBEE_ConfigEndpoints1 */
 
   /* USER CODE END APP_ZIGBEE_ConfigEndpoints1 */
 
-  /* Add EndPoint */
-  memset( &stRequest, 0, sizeof( stRequest ) );
-  memset( &stConfig, 0, sizeof( stConfig ) );
+  /* Add EndPoints and Clusters from the tables */
+  (void)APP_ZIGBEE_ConfigEndpointTable( astEndpointTable, (uint8_t)( sizeof( astEndpointTable ) / sizeof( astEndpointTable[0] ) ),
+                                        astClusterTable, (uint8_t)( sizeof( astClusterTable ) / sizeof( astClusterTable[0] ) ) );
 
-  stRequest.profileId = APP_ZIGBEE_PROFILE_ID;
-  stRequest.deviceId = APP_ZIGBEE_DEVICE_ID;
-  stRequest.endpoint = APP_ZIGBEE_ENDPOINT;
-  ZbZclAddEndpoint( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfig );
-  assert( stConfig.status == ZB_STATUS_SUCCESS );
+  /* USER CODE BEGIN APP_ZIGBEE_ConfigEndpoints2 */
+  /* Traffic generator (SW3) sends its Toggle with this OnOff Client */
+  APP_ZIGBEE_TrafficInit( stZigbeeAppInfo.OnOffClient, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_GROUP_ADDRESS );
 
-  /* Add OnOff Client Cluster */
-  stZigbeeAppInfo.OnOffClient = ZbZclOnOffClientAlloc( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT );
-  assert( stZigbeeAppInfo.OnOffClient != NULL );
-  ZbZclClusterEndpointRegister( stZigbeeAppInfo.OnOffClient );
+  /* OTA Upgrade Client, streaming the new image in flash */
+  APP_ZIGBEE_OtaInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID );
 
-  /* USER CODE BEGIN APP_ZIGBEE_ConfigEndpoints2 */
+  /* OTA Upgrade Server, serving the neighbours from its block cache */
+  APP_ZIGBEE_OtaServerInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID );
+
+  /* Network-wide operations of the Coordinator (OTA, rebinding) staggered over time slots */
+  APP_ZIGBEE_StaggerInit( APP_ZIGBEE_ENDPOINT );
+
+  /* Sleepy End Device : Poll Control Server and data polls */
+  APP_ZIGBEE_PollInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID );
+
+#if (CFG_ZIGBEE_HEALTH_SUPPORTED != 0)
+  /* Add Diagnostics Server Cluster (one per device), to read the counters remotely */
+  if ( ZbZclDiagServerAlloc( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID, ZB_APS_STATUS_SECURED_NWK_KEY ) == false )
+  {
+    LOG_ERROR_APP( "Error, Diagnostics Server allocation failed." );
+  }
+#endif /* (CFG_ZIGBEE_HEALTH_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
+  /* Hot clusters of the Server Endpoint dispatched before the stack, to drive the output first */
+  if ( ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ZB_MSG_FILTER_APSDE_DATA_IND, ( ZB_MSG_INTERNAL_PRIO + 1u ),
+                            APP_ZIGBEE_FastPathCallback, NULL ) == NULL )
+  {
+    LOG_ERROR_APP( "Error, Fast path filter registration failed." );
+  }
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
+
+  /* Packed attribute store of the application clusters, before the clusters using it */
+  APP_ZIGBEE_AttrInit();
+
+  /* Manufacturer specific performance telemetry Server */
+  APP_ZIGBEE_PerfInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID );
+
+  /* Metering Server of the sub-meter (pulses time stamped by DMA) */
+  APP_ZIGBEE_MeterInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT );
+
+  /* APS fragmentation tuner of the bulk transfers */
+  APP_ZIGBEE_FragInit( stZigbeeAppInfo.pstZigbee );
+
+  /* Green Power : duplicate GP frames dropped before the Proxy Basic of the stack */
+  APP_ZIGBEE_GpInit( stZigbeeAppInfo.pstZigbee );
+
+  /* Touchlink initiator of the installer workflows */
+  APP_ZIGBEE_TouchlinkInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_DEVICE_ID );
+
+  /* Zigbee Direct : commissioning by a phone over BLE, its tunnelled requests windowed into the network */
+  APP_ZIGBEE_ZddInit( stZigbeeAppInfo.pstZigbee );
+
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+  /* Dimmer : Level Server of the OnOff Server Endpoint, transitions of its PWM output written by DMA */
+  APP_ZIGBEE_LevelInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_SERVER_ENDPOINT, stZigbeeAppInfo.OnOffServer );
+
+  /* Color light : Color Control Server, its transitions played by the engine of the Level Server */
+  APP_ZIGBEE_ColorInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_SERVER_ENDPOINT, stZigbeeAppInfo.OnOffServer );
+
+  /* Scene cache : scenes recalled from the fast path */
+  APP_ZIGBEE_SceneInit();
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+
+  /* Time Server and mesh time : the commands sent with a mesh time are driven at that time by the fast path */
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
+  APP_ZIGBEE_TimeSyncInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID, APP_ZIGBEE_SERVER_ENDPOINT,
+                           APP_ZIGBEE_ServerTimedOutput );
+#else /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
+  APP_ZIGBEE_TimeSyncInit( stZigbeeAppInfo.pstZigbee, APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID, APP_ZIGBEE_SERVER_ENDPOINT, NULL );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) && (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
 
   /* USER CODE END APP_ZIGBEE_ConfigEndpoints2 */
 }
@@ -205,14 +414,14 @@ void APP_ZIGBEE_ConfigEndpoints(void)
  */
 bool APP_ZIGBEE_ConfigGroupAddr( void )
 {
-  struct ZbApsmeAddGroupReqT  stRequest;
-  struct ZbApsmeAddGroupConfT stConfig;
+  /* Group memberships from the binding map, to keep its mirror up to date */
+  APP_ZIGBEE_BindMapRebuild();
+  (void)APP_ZIGBEE_BindMapAddGroup( APP_ZIGBEE_GROUP_ADDRESS, APP_ZIGBEE_ENDPOINT );
 
-  memset( &stRequest, 0, sizeof( stRequest ) );
-
-  stRequest.endpt = APP_ZIGBEE_ENDPOINT;
-  stRequest.groupAddr = APP_ZIGBEE_GROUP_ADDRESS;
-  ZbApsmeAddGroupReq( stZigbeeAppInfo.pstZigbee, &stRequest, &stConfig );
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+  /* The actuator receives the group commands of the paired switch */
+  (void)APP_ZIGBEE_BindMapAddGroup( APP_ZIGBEE_GROUP_ADDRESS, APP_ZIGBEE_SERVER_ENDPOINT );
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
 
   return true;
 }
@@ -232,9 +441,18 @@ void APP_ZIGBEE_GetStartupConfig( struct ZbStartupT * pstConfig )
 
   /* Setting up additional startup configuration parameters */
   pstConfig->startupControl = stZigbeeAppInfo.eStartupControl;
-  pstConfig->channelList.count = 1;
-  pstConfig->channelList.list[0].page = 0;
-  pstConfig->channelList.list[0].channelMask = APP_ZIGBEE_CHANNEL_MASK;
+  if ( stZigbeeAppInfo.eStartupControl == ZbStartTypeJoin )
+  {
+    /* Last successful channel first, then the channels ranked by the scan */
+    APP_ZIGBEE_GetJoinChannelList( &pstConfig->channelList );
+  }
+  else
+  {
+    /* The Form selects itself the channel of the mask (energy scan) */
+    pstConfig->channelList.count = 1;
+    pstConfig->channelList.list[0].page = 0;
+    pstConfig->channelList.list[0].channelMask = APP_ZIGBEE_CHANNEL_MASK;
+  }
 
   /* Set the TX-Power */
   if ( APP_ZIGBEE_SetTxPower( APP_ZIGBEE_TX_POWER ) == false )
@@ -244,6 +462,12 @@ void APP_ZIGBEE_GetStartupConfig( struct ZbStartupT * pstConfig )
   }
 
   /* USER CODE BEGIN APP_ZIGBEE_GetStartupConfig */
+#if (CFG_ZIGBEE_SED_SUPPORTED != 0)
+  /* Sleepy End Device : battery powered, receiver off when idle, polls its Parent */
+  pstConfig->capability &= (uint8_t)~( MCP_ASSOC_CAP_PWR_SRC | MCP_ASSOC_CAP_RXONIDLE | MCP_ASSOC_CAP_DEV_TYPE );
+  pstConfig->endDeviceTimeout = CFG_ZIGBEE_SED_TIMEOUT;
+  pstConfig->fastPollPeriod = CFG_ZIGBEE_SED_FAST_POLL_PERIOD;
+#endif /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
 
   /* USER CODE END APP_ZIGBEE_GetStartupConfig */
 }
@@ -278,7 +502,7 @@ void APP_ZIGBEE_PrintApplicationInfo(void)
   LOG_INFO_APP( "Application Flashed : Zigbee %s%s", APP_ZIGBEE_APPLICATION_NAME, APP_ZIGBEE_APPLICATION_OS_NAME );
 
   /* USER CODE END APP_ZIGBEE_PrintApplicationInfo1 */
-  LOG_INFO_APP( "Channel used: %d.", APP_ZIGBEE_CHANNEL );
+  LOG_INFO_APP( "Channel mask : 0x%08X (first tried : %d).", APP_ZIGBEE_CHANNEL_MASK, APP_ZIGBEE_CHANNEL );
 
   APP_ZIGBEE_PrintGenericInfo();
 
@@ -301,8 +525,72 @@ void APP_ZIGBEE_PrintApplicationInfo(void)
  */
 static void APP_ZIGBEE_ApplicationTaskInit( void )
 {
-  /* Create timer to toggle the OnOff */
-  UTIL_TIMER_Create( &stTimerToggle, APP_ZIGBEE_TOGGLE_PERIOD, UTIL_TIMER_PERIODIC, APP_ZIGBEE_TimerToggleCallback, NULL );
+  /* Automatic toggle of the OnOff is the traffic generator (see Button3), or a periodic Button1 task without it */
+
+  /* OnOff commands are sent through the fan-out (list of destinations) */
+  APP_ZIGBEE_FanoutInit();
+
+  /* Frames held for the sleepy children bounded per child */
+  APP_ZIGBEE_IndirectInit( stZigbeeAppInfo.pstZigbee );
+
+  /* OnOff Client bound to the Servers of the Network (SW2), targets pipelined */
+  APP_ZIGBEE_FindBindInit( stZigbeeAppInfo.pstZigbee );
+
+  /* Health of the Neighbors/Routes, sampled once on the Network */
+  APP_ZIGBEE_HealthInit();
+
+  /* Server attributes added with APP_ZIGBEE_ReportAdd are reported on a shared schedule */
+  APP_ZIGBEE_ReportInit();
+
+  /* Short addresses of the destinations given by IEEE address cached, refreshed ahead */
+  APP_ZIGBEE_AddrInit( stZigbeeAppInfo.pstZigbee );
+
+  /* Routes of the unicast destinations used often discovered ahead, out of the send path */
+  APP_ZIGBEE_RouteInit();
+
+  /* Link Status period stretched while the Router neighbors are stable */
+  APP_ZIGBEE_LinkStatusInit( stZigbeeAppInfo.pstZigbee );
+
+  /* Bindings and group memberships mirrored in hash indexes */
+  APP_ZIGBEE_BindMapInit();
+
+  /* Trust Center device keys indexed by EUI64 */
+  APP_ZIGBEE_TcKeyInit();
+
+  /* Trust Center link keys derived from the EUI64, only the ones used recently kept */
+  APP_ZIGBEE_HashKeyInit();
+
+  /* Figures of the stack variant (STACKBENCH) */
+  APP_ZIGBEE_BenchInit();
+
+  /* TX power lowered on strong links, at most APP_ZIGBEE_TX_POWER */
+  APP_ZIGBEE_TxPowerInit( APP_ZIGBEE_TX_POWER );
+
+  /* Backoff and frame retries of the MAC following the CCA failures and the losses */
+  APP_ZIGBEE_CsmaInit();
+
+  /* Energy scans of the channels allowed to Form/Join, at the Network Manager disposal */
+  APP_ZIGBEE_ChannelInit( APP_ZIGBEE_CHANNEL_MASK );
+
+  /* Outgoing NWK frame counter saved in its own flash log, apart from the persistence data */
+  APP_ZIGBEE_CounterInit();
+
+  /* Changes of the persistable attributes saved by batches */
+  APP_ZIGBEE_BatchInit();
+}
+
+/**
+ * @brief  Callback called by the stack when its persistence data have changed
+ * @param  zb     Zigbee stack handler
+ * @param  cbarg  Not used
+ * @retval None
+ */
+static void APP_ZIGBEE_PersistNotifyCallback( struct ZigBeeT * zb, void * cbarg )
+{
+  UNUSED( zb );
+  UNUSED( cbarg );
+
+  APP_ZIGBEE_PersistenceNotify();
 }
 
 /**
@@ -324,7 +612,6 @@ static void APP_ZIGBEE_OnOffClientStart(void)
 void APP_BSP_Button1Action(void)
 {
   struct ZbApsAddrT     stDest;
-  enum ZclStatusCodeT   eStatus;
   
   /* First, verify if Appli has already Join a Network  */ 
   if ( APP_ZIGBEE_IsAppliJoinNetwork() != false )
@@ -336,33 +623,475 @@ void APP_BSP_Button1Action(void)
     stDest.nwkAddr = APP_ZIGBEE_GROUP_ADDRESS;
 
     LOG_INFO_APP( "[ONOFF] SW1 pushed, sending 'TOGGLE'" );
-    eStatus = ZbZclOnOffClientToggleReq( stZigbeeAppInfo.OnOffClient, &stDest, NULL, NULL );
-    if ( eStatus != ZCL_STATUS_SUCCESS )
+    APP_ZIGBEE_PollActivity();
+    if ( APP_ZIGBEE_FanoutStart( stZigbeeAppInfo.OnOffClient, ZbZclOnOffClientToggleReq, &stDest, 1u, APP_ZIGBEE_OnOffFanoutCallback, NULL ) == false )
     {
-      LOG_ERROR_APP( "[ONOFF] Error, OnOff Client Request failed (0x%02X).", eStatus );
+      LOG_ERROR_APP( "[ONOFF] Error, OnOff Client Request failed (previous one ongoing)." );
     }
   }
 }
 
-
 /**
- * @brief  Management of the toggle OnOff (via Button SW1) with the Timer
+ * @brief  Management of the SW2 button : Bind the OnOff Client to the OnOff Servers of the Network
  * @param  None
  * @retval None
  */
-static void APP_ZIGBEE_TimerToggleCallback( void * arg )
+void APP_BSP_Button2Action(void)
+{
+  static const uint16_t   aiClusterList[] = { APP_ZIGBEE_CLUSTER_ID };
+
+  /* First, verify if Appli has already Join a Network  */
+  if ( APP_ZIGBEE_IsAppliJoinNetwork() != false )
+  {
+    LOG_INFO_APP( "[ONOFF] SW2 pushed, finding & binding." );
+    if ( APP_ZIGBEE_FindBindStart( APP_ZIGBEE_ENDPOINT, APP_ZIGBEE_PROFILE_ID, aiClusterList,
+                                   (uint8_t)( sizeof( aiClusterList ) / sizeof( aiClusterList[0] ) ), APP_ZIGBEE_FindBindCallback, NULL ) == false )
+    {
+      LOG_ERROR_APP( "[ONOFF] Error, finding & binding failed (previous one ongoing)." );
+    }
+  }
+}
+
+/**
+ * @brief  End of the finding & binding of the OnOff Client
+ * @param  pstResult  Aggregate result
+ * @param  arg        Not used
+ * @retval None
+ */
+static void APP_ZIGBEE_FindBindCallback( const APP_ZIGBEE_FindBindResult_t * pstResult, void * arg )
+{
+  UNUSED( arg );
+
+  LOG_INFO_APP( "[ONOFF] Finding & binding : %d targets, %d bound, %d failed in %d ms.", pstResult->iTargets,
+                pstResult->iBound, pstResult->iFailed, pstResult->lDuration );
+}
+
+/**
+ * @brief  End of an OnOff command sent to a list of destinations
+ * @param  pstResult  Aggregate result
+ * @param  arg        Not used
+ * @retval None
+ */
+static void APP_ZIGBEE_OnOffFanoutCallback( const APP_ZIGBEE_FanoutResult_t * pstResult, void * arg )
+{
+  UNUSED( arg );
+
+  if ( ( pstResult->iFailed != 0u ) || ( pstResult->iRefused != 0u ) )
+  {
+    LOG_ERROR_APP( "[ONOFF] Error, OnOff Client Request failed for %d/%d destinations (first status 0x%02X).",
+                   ( pstResult->iFailed + pstResult->iRefused ), pstResult->iNumber, pstResult->peStatus[0] );
+  }
+}
+
+
+#if (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0)
+/**
+ * @brief  Allocate the OnOff Server, with its commands and scene recalls handled by the application fast path.
+ * @param  pstZigbee  Zigbee stack handler
+ * @param  cEndpoint  Endpoint of the Server
+ * @retval Cluster pointer, or NULL on error.
+ */
+static struct ZbZclClusterT * APP_ZIGBEE_OnOffServerAlloc( struct ZigBeeT * pstZigbee, uint8_t cEndpoint )
+{
+  static struct ZbZclOnOffServerCallbacksT  stCallbacks =
+  {
+    .off = APP_ZIGBEE_OnOffServerOffCallback,
+    .on = APP_ZIGBEE_OnOffServerOnCallback,
+    .toggle = APP_ZIGBEE_OnOffServerToggleCallback,
+  };
+  struct ZbZclClusterT  * pstCluster;
+
+  pstCluster = ZbZclOnOffServerAlloc( pstZigbee, cEndpoint, &stCallbacks, NULL );
+  if ( pstCluster != NULL )
+  {
+    /* A scene recall drives the output from the scene data, then the stack updates the attribute */
+    pfOnOffServerSetSceneData = pstCluster->set_scene_data;
+    pstCluster->set_scene_data = APP_ZIGBEE_OnOffServerSetSceneData;
+
+    bOnOffServerOutput = false;
+    APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+  }
+
+  return pstCluster;
+}
+
+/**
+ * @brief  Allocate the Scenes Server of the OnOff Server Endpoint.
+ * @param  pstZigbee  Zigbee stack handler
+ * @param  cEndpoint  Endpoint of the Server
+ * @retval Cluster pointer, or NULL on error.
+ */
+static struct ZbZclClusterT * APP_ZIGBEE_ScenesServerAlloc( struct ZigBeeT * pstZigbee, uint8_t cEndpoint )
+{
+  return ZbZclScenesServerAlloc( pstZigbee, cEndpoint, CFG_ZIGBEE_ONOFF_SERVER_SCENES_MAX );
+}
+
+/**
+ * @brief  Drive the output first (GPIO), then update the OnOff attribute. No log and no Task on this path.
+ * @param  pstCluster OnOff Server
+ * @param  bOn        New state of the output
+ * @retval None
+ */
+static void APP_ZIGBEE_OnOffServerOutput( struct ZbZclClusterT * pstCluster, bool bOn )
 {
-  UTIL_SEQ_SetTask( TASK_BSP_BUTTON_B1, CFG_TASK_PRIO_BUTTON_Bx );
+  if ( bOn != false )
+  {
+    APP_LED_ON( APP_ZIGBEE_SERVER_LED );
+  }
+  else
+  {
+    APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+  }
+  APP_ZIGBEE_LevelOnOff( bOn );
+
+  if ( bOn != bOnOffServerOutput )
+  {
+    bOnOffServerOutput = bOn;
+    (void)ZbZclAttrIntegerWrite( pstCluster, ZCL_ONOFF_ATTR_ONOFF, ( bOn != false ) ? 1 : 0 );
+    APP_ZIGBEE_BatchChange( pstCluster, ZCL_ONOFF_ATTR_ONOFF );
+  }
 }
 
+/**
+ * @brief  OnOff Server 'Off' command (unicast or group)
+ * @param  pstCluster OnOff Server
+ * @param  pstSrcInfo Source of the command
+ * @param  arg        Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerOffCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  APP_ZIGBEE_OnOffServerOutput( pstCluster, false );
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  OnOff Server 'On' command (unicast or group)
+ * @param  pstCluster OnOff Server
+ * @param  pstSrcInfo Source of the command
+ * @param  arg        Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerOnCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  APP_ZIGBEE_OnOffServerOutput( pstCluster, true );
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  OnOff Server 'Toggle' command (unicast or group) : the new state comes from the RAM cache.
+ * @param  pstCluster OnOff Server
+ * @param  pstSrcInfo Source of the command
+ * @param  arg        Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerToggleCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  APP_ZIGBEE_OnOffServerOutput( pstCluster, !bOnOffServerOutput );
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Scene recall on the OnOff Server : the scene extension data is the OnOff attribute (1 byte).
+ * @param  pstCluster   OnOff Server
+ * @param  pExtData     Scene extension data
+ * @param  cExtLength   Length of the extension data
+ * @param  iTransition  Transition time (in 1/10 s)
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT APP_ZIGBEE_OnOffServerSetSceneData( struct ZbZclClusterT * pstCluster, uint8_t * pExtData, uint8_t cExtLength, uint16_t iTransition )
+{
+  enum ZclStatusCodeT   eStatus = ZCL_STATUS_SUCCESS;
+
+  if ( cExtLength >= 1u )
+  {
+    if ( pExtData[0] != 0u )
+    {
+      APP_LED_ON( APP_ZIGBEE_SERVER_LED );
+    }
+    else
+    {
+      APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+    }
+    bOnOffServerOutput = ( pExtData[0] != 0u );
+    APP_ZIGBEE_LevelOnOff( bOnOffServerOutput );
+  }
 
+  if ( pfOnOffServerSetSceneData != NULL )
+  {
+    eStatus = pfOnOffServerSetSceneData( pstCluster, pExtData, cExtLength, iTransition );
+  }
+
+  return eStatus;
+}
+
+#if (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0)
 /**
- * @brief  Management of the SW3 button : Start/Stop Automatic Toggle
+ * @brief  APSDE-DATA.indication filter, before the stack : a cluster specific command of a hot cluster to the Server
+ *         Endpoint (or one of its groups) goes to its handler in one indexed jump. The stack then processes it.
+ * @param  zb       Zigbee stack instance
+ * @param  lId      Message filter identifier
+ * @param  pMessage APSDE-DATA.indication
+ * @param  arg      Not used
+ * @retval ZB_MSG_CONTINUE, the indication is always given to the stack.
+ */
+static enum zb_msg_filter_rc APP_ZIGBEE_FastPathCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbApsdeDataIndT  * pstIndication = (const struct ZbApsdeDataIndT *)pMessage;
+  APP_ZIGBEE_FastPathHandler_t    pfHandler;
+  struct ZbZclHeaderT             stHeader;
+  int                             iHeaderLength;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( ( lId != ZB_MSG_FILTER_APSDE_DATA_IND ) || ( pstIndication->clusterId >= APP_ZIGBEE_FASTPATH_CLUSTER_MAX ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  pfHandler = apfFastPathTable[pstIndication->clusterId];
+  if ( ( pfHandler == NULL ) || ( pstIndication->profileId != APP_ZIGBEE_PROFILE_ID ) ||
+       ( pstIndication->securityStatus == ZB_APS_STATUS_UNSECURED ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  /* Only the frames the Server accepts */
+  if ( pstIndication->dst.mode == ZB_APSDE_ADDRMODE_GROUP )
+  {
+    if ( APP_ZIGBEE_BindMapIsGroupMember( pstIndication->dst.nwkAddr, APP_ZIGBEE_SERVER_ENDPOINT ) == false )
+    {
+      return( ZB_MSG_CONTINUE );
+    }
+  }
+  else if ( ( pstIndication->dst.endpoint != APP_ZIGBEE_SERVER_ENDPOINT ) && ( pstIndication->dst.endpoint != ZB_ENDPOINT_BCAST ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  iHeaderLength = ZbZclParseHeader( &stHeader, pstIndication->asdu, pstIndication->asduLength );
+  if ( ( iHeaderLength <= 0 ) ||
+       ( stHeader.frameCtrl.frameType != ZCL_FRAMETYPE_CLUSTER ) || ( stHeader.frameCtrl.manufacturer != 0u ) ||
+       ( stHeader.frameCtrl.direction != ZCL_DIRECTION_TO_SERVER ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  /* A repeated command (same source and sequence) is not driven twice */
+  if ( ( pstIndication->src.nwkAddr == iFastPathLastSrc ) && ( stHeader.seqNum == cFastPathLastSeq ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  iFastPathLastSrc = pstIndication->src.nwkAddr;
+  cFastPathLastSeq = stHeader.seqNum;
+  pfHandler( &stHeader, &pstIndication->asdu[iHeaderLength], (uint16_t)( pstIndication->asduLength - (unsigned int)iHeaderLength ) );
+
+  return( ZB_MSG_CONTINUE );
+}
+
+/**
+ * @brief  Output of a command applied at its mesh time : the fast path handler of its cluster, if any (the stack then
+ *         processes the command).
+ * @param  iClusterId Cluster of the command
+ * @param  pstHeader  ZCL header of the command
+ * @param  pPayload   Payload of the command
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void APP_ZIGBEE_ServerTimedOutput( uint16_t iClusterId, const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength )
+{
+  if ( ( iClusterId < APP_ZIGBEE_FASTPATH_CLUSTER_MAX ) && ( apfFastPathTable[iClusterId] != NULL ) )
+  {
+    apfFastPathTable[iClusterId]( pstHeader, pPayload, iLength );
+  }
+}
+
+/**
+ * @brief  Fast path of the OnOff Server : the output (GPIO) only. The stack callback then drives it again to the same
+ *         state, and updates the attribute and the cached state.
+ * @param  pstHeader  ZCL header of the command
+ * @param  pPayload   Payload of the command (not used)
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void APP_ZIGBEE_OnOffServerFastPath( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength )
+{
+  UNUSED( pPayload );
+  UNUSED( iLength );
+
+  switch ( pstHeader->cmdId )
+  {
+    case ZCL_ONOFF_COMMAND_OFF:
+        APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+        break;
+
+    case ZCL_ONOFF_COMMAND_ON:
+        APP_LED_ON( APP_ZIGBEE_SERVER_LED );
+        break;
+
+    case ZCL_ONOFF_COMMAND_TOGGLE:
+        if ( bOnOffServerOutput != false )
+        {
+          APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+        }
+        else
+        {
+          APP_LED_ON( APP_ZIGBEE_SERVER_LED );
+        }
+        break;
+
+    default:
+        break;
+  }
+}
+
+#if (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0)
+/**
+ * @brief  Fast path of the Groups Server : the stack removes the scenes of the groups removed, their snapshots too.
+ * @param  pstHeader  ZCL header of the command
+ * @param  pPayload   Payload of the command
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void APP_ZIGBEE_GroupsServerFastPath( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength )
+{
+  switch ( pstHeader->cmdId )
+  {
+    case ZCL_GROUPS_COMMAND_REMOVE:
+        if ( iLength >= 2u )
+        {
+          APP_ZIGBEE_SceneRemove( (uint16_t)( pPayload[0] | ( (uint16_t)pPayload[1] << 8 ) ), APP_ZIGBEE_SCENE_ALL );
+        }
+        break;
+
+    case ZCL_GROUPS_COMMAND_REMOVE_ALL:
+        APP_ZIGBEE_SceneRemove( APP_ZIGBEE_SCENE_GROUP_ALL, APP_ZIGBEE_SCENE_ALL );
+        break;
+
+    default:
+        break;
+  }
+}
+
+/**
+ * @brief  Fast path of the Scenes Server : a Store Scene keeps the output as a snapshot, a Recall Scene without
+ *         transition drives the output from its snapshot (OnOff output and PWM frame, whatever the clusters of the
+ *         scene). The scenes added or copied are not cached (their recall goes through the stack). The stack then
+ *         processes the command as before.
+ * @param  pstHeader  ZCL header of the command
+ * @param  pPayload   Payload of the command
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void APP_ZIGBEE_ScenesServerFastPath( const struct ZbZclHeaderT * pstHeader, const uint8_t * pPayload, uint16_t iLength )
+{
+  static const uint16_t               aiOff[APP_ZIGBEE_LEVEL_PWM_CHANNELS] = { 0 };
+  const APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+  uint16_t                            iGroup, iTransition;
+
+  if ( iLength < 3u )
+  {
+    return;
+  }
+
+  iGroup = (uint16_t)( pPayload[0] | ( (uint16_t)pPayload[1] << 8 ) );
+  switch ( pstHeader->cmdId )
+  {
+    case ZCL_SCENES_COMMAND_RECALL_SCENE:
+        /* A transition time of the command (Optional) goes through the stack */
+        iTransition = ( ( iLength >= 5u ) ? (uint16_t)( pPayload[3] | ( (uint16_t)pPayload[4] << 8 ) ) : ZCL_SCENES_RECALL_TRANSITION_INVALID );
+        if ( ( iTransition != ZCL_SCENES_RECALL_TRANSITION_INVALID ) && ( iTransition != 0u ) )
+        {
+          break;
+        }
+
+        pstSnapshot = APP_ZIGBEE_SceneFind( iGroup, pPayload[2] );
+        if ( pstSnapshot != NULL )
+        {
+          if ( pstSnapshot->bOn != false )
+          {
+            APP_LED_ON( APP_ZIGBEE_SERVER_LED );
+          }
+          else
+          {
+            APP_LED_OFF( APP_ZIGBEE_SERVER_LED );
+          }
+          APP_ZIGBEE_LevelApplyFrame( ( pstSnapshot->bOn != false ) ? pstSnapshot->aiFrame : aiOff );
+        }
+        break;
+
+    case ZCL_SCENES_COMMAND_STORE_SCENE:
+        /* Same check as the stack : a scene of a group the Endpoint is not member of is not stored */
+        if ( ( iGroup == 0u ) || ( APP_ZIGBEE_BindMapIsGroupMember( iGroup, APP_ZIGBEE_SERVER_ENDPOINT ) != false ) )
+        {
+          APP_ZIGBEE_SceneStore( iGroup, pPayload[2], bOnOffServerOutput );
+        }
+        break;
+
+    case ZCL_SCENES_COMMAND_ADD_SCENE:
+    case ZCL_SCENES_COMMAND_ENH_ADD_SCENE:
+    case ZCL_SCENES_COMMAND_REMOVE_SCENE:
+        APP_ZIGBEE_SceneRemove( iGroup, pPayload[2] );
+        break;
+
+    case ZCL_SCENES_COMMAND_REMOVE_ALL_SCENES:
+        APP_ZIGBEE_SceneRemove( iGroup, APP_ZIGBEE_SCENE_ALL );
+        break;
+
+    case ZCL_SCENES_COMMAND_COPY_SCENE:
+        /* Mode, From group & scene, To group & scene : the scenes copied are no more the ones cached */
+        if ( iLength >= 7u )
+        {
+          APP_ZIGBEE_SceneRemove( (uint16_t)( pPayload[4] | ( (uint16_t)pPayload[5] << 8 ) ),
+                                  ( ( pPayload[0] & 0x01u ) != 0u ) ? APP_ZIGBEE_SCENE_ALL : pPayload[6] );
+        }
+        break;
+
+    default:
+        break;
+  }
+}
+#endif /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) */
+#endif /* (CFG_ZIGBEE_FASTPATH_SUPPORTED != 0) */
+#endif /* (CFG_ZIGBEE_ONOFF_SERVER_SUPPORTED != 0) */
+
+/**
+ * @brief  Management of the SW3 button : Start/Stop the traffic generator (by default, a Toggle every second)
  * @param  None
  * @retval None
  */
 void APP_BSP_Button3Action(void)
 {
+#if (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0)
+  /* First, verify if Appli has already Join a Network  */ 
+  if ( APP_ZIGBEE_IsAppliJoinNetwork() != false )
+  {
+    if ( APP_ZIGBEE_TrafficIsRunning() == false )
+    {
+      LOG_INFO_APP( "[ONOFF] SW3 pushed, Start traffic generator." );
+      if ( APP_ZIGBEE_TrafficStart() == false )
+      {
+        LOG_ERROR_APP( "[ONOFF] Error, invalid traffic configuration." );
+      }
+    }
+    else
+    {
+      LOG_INFO_APP( "[ONOFF] SW3 pushed, Stop traffic generator." );
+      APP_ZIGBEE_TrafficStop();
+    }
+  }
+#else /* (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0) */
   static  uint8_t   cToggleOn = 0;
   
   /* First, verify if Appli has already Join a Network  */ 
@@ -371,16 +1100,17 @@ void APP_BSP_Button3Action(void)
     if ( cToggleOn == 0u )
     {
       LOG_INFO_APP( "[ONOFF] SW3 pushed, Start automatic On/Off." );
-      UTIL_TIMER_Start( &stTimerToggle );
+      UTIL_SEQ_SetTaskPeriodic( TASK_BSP_BUTTON_B1, CFG_TASK_PRIO_BUTTON_Bx, APP_ZIGBEE_TOGGLE_PERIOD );
       cToggleOn = 1;
     }
     else
     {
       LOG_INFO_APP( "[ONOFF] SW3 pushed, Stop automatic On/Off." );
-      UTIL_TIMER_Stop( &stTimerToggle ); 
+      UTIL_SEQ_CancelTaskDelayed( TASK_BSP_BUTTON_B1 );
       cToggleOn = 0;
     }
   }
+#endif /* (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0) */
 }
 
 /* USER CODE END FD_LOCAL_FUNCTIONS */
@@ -0,0 +1,321 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_fanout.c
+  * @author  MCD Application Team
+  * @brief   Send a ZCL command to a list of destinations (groups, unicasts), paced
+  *          so that the APS/MAC queues are not overflowed, with one aggregate
+  *          completion callback.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_fanout.h"
+#include "app_zigbee_latency.h"
+#include "app_zigbee_broadcast.h"
+#include "app_zigbee_route.h"
+#include "app_zigbee_bindmap.h"
+#include "app_zigbee_indirect.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define FANOUT_NWK_ADDR_BROADCAST_MIN         (0xFFF8u)   /* First NWK broadcast address */
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZbApsAddrT            astFanoutDest[CFG_ZIGBEE_FANOUT_DEST_MAX];
+static enum ZclStatusCodeT          aeFanoutStatus[CFG_ZIGBEE_FANOUT_DEST_MAX];
+static bool                         abFanoutPending[CFG_ZIGBEE_FANOUT_DEST_MAX];
+
+static struct ZbZclClusterT *       pstFanoutCluster;
+static APP_ZIGBEE_FanoutRequest_t   pfFanoutRequest;
+static APP_ZIGBEE_FanoutCallback_t  pfFanoutCallback;
+static void *                       pFanoutArg;
+
+static bool                         bFanoutBusy, bFanoutBroadcastSent;
+static uint16_t                     iFanoutNext, iFanoutInFlight, iFanoutDone;
+static uint32_t                     lFanoutStartTick, lFanoutBroadcastTick;
+static APP_ZIGBEE_FanoutResult_t    stFanoutResult;
+static UTIL_TIMER_Object_t          stFanoutSpacingTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void FanoutTask                ( void );
+static void FanoutSpacingElapsed      ( void * arg );
+static void FanoutRspCallback         ( struct ZbZclCommandRspT * pstRsp, void * arg );
+static bool FanoutIsBroadcast         ( const struct ZbApsAddrT * pstDest );
+static void FanoutBegin               ( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest, uint16_t iDestNumber,
+                                        APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the fan-out : Task and Timer used to pace the requests.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_FanoutInit( void )
+{
+  UTIL_TIMER_Create( &stFanoutSpacingTimer, CFG_ZIGBEE_FANOUT_BROADCAST_SPACING, UTIL_TIMER_ONESHOT, &FanoutSpacingElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_FANOUT ), UTIL_SEQ_RFU, FanoutTask );
+}
+
+/**
+ * @brief  Send a ZCL command to a list of destinations. At most CFG_ZIGBEE_FANOUT_MAX_INFLIGHT requests wait for
+ *         their confirmation at the same time, and the group/broadcast requests are spaced by
+ *         APP_ZIGBEE_BroadcastGetSpacing() (they hold a Broadcast Transaction Table entry).
+ * @param  pstCluster   Client cluster sending the command
+ * @param  pfRequest    Request of the command (ZbZclOnOffClientToggleReq, ...)
+ * @param  pstDestList  List of destinations, copied
+ * @param  iDestNumber  Number of destinations (at most CFG_ZIGBEE_FANOUT_DEST_MAX)
+ * @param  pfCallback   Callback called once all the destinations have confirmed (can be NULL)
+ * @param  arg          Argument of the callback
+ * @retval True if the fan-out is started, false if another one is ongoing or the list is not valid.
+ */
+bool APP_ZIGBEE_FanoutStart( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest,
+                             const struct ZbApsAddrT * pstDestList, uint16_t iDestNumber,
+                             APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg )
+{
+  if ( ( bFanoutBusy != false ) || ( pstCluster == NULL ) || ( pfRequest == NULL ) ||
+       ( iDestNumber == 0u ) || ( iDestNumber > CFG_ZIGBEE_FANOUT_DEST_MAX ) )
+  {
+    return false;
+  }
+
+  memcpy( astFanoutDest, pstDestList, ( iDestNumber * sizeof( struct ZbApsAddrT ) ) );
+  FanoutBegin( pstCluster, pfRequest, iDestNumber, pfCallback, arg );
+
+  return true;
+}
+
+/**
+ * @brief  Send a ZCL command to the destinations bound to the cluster (at most CFG_ZIGBEE_FANOUT_DEST_MAX), found
+ *         in the binding map, with the pacing of APP_ZIGBEE_FanoutStart.
+ * @param  pstCluster   Client cluster sending the command
+ * @param  pfRequest    Request of the command (ZbZclOnOffClientToggleReq, ...)
+ * @param  pfCallback   Callback called once all the destinations have confirmed (can be NULL)
+ * @param  arg          Argument of the callback
+ * @retval True if the fan-out is started, false if another one is ongoing or the cluster is not bound.
+ */
+bool APP_ZIGBEE_FanoutStartBound( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest,
+                                  APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg )
+{
+  uint16_t  iDestNumber;
+
+  if ( ( bFanoutBusy != false ) || ( pstCluster == NULL ) || ( pfRequest == NULL ) )
+  {
+    return false;
+  }
+
+  iDestNumber = APP_ZIGBEE_BindMapGetDestinations( pstCluster->endpoint, (uint16_t)pstCluster->clusterId, astFanoutDest, CFG_ZIGBEE_FANOUT_DEST_MAX );
+  if ( iDestNumber == 0u )
+  {
+    return false;
+  }
+
+  FanoutBegin( pstCluster, pfRequest, iDestNumber, pfCallback, arg );
+
+  return true;
+}
+
+/**
+ * @brief  Indicate if a fan-out is ongoing.
+ * @param  None
+ * @retval True if a fan-out is ongoing.
+ */
+bool APP_ZIGBEE_FanoutIsBusy( void )
+{
+  return bFanoutBusy;
+}
+
+/**
+ * @brief  Fan-out Task : send the next requests that the pacing allows, then call the completion callback
+ *         when all the destinations have confirmed.
+ * @param  None
+ * @retval None
+ */
+static void FanoutTask( void )
+{
+  uint16_t              iIndex;
+  uint32_t              lElapsed, lSpacing;
+  enum ZclStatusCodeT   eStatus;
+
+  if ( bFanoutBusy == false )
+  {
+    return;
+  }
+
+  while ( ( iFanoutNext < stFanoutResult.iNumber ) && ( iFanoutInFlight < CFG_ZIGBEE_FANOUT_MAX_INFLIGHT ) )
+  {
+    iIndex = iFanoutNext;
+    if ( FanoutIsBroadcast( &astFanoutDest[iIndex] ) != false )
+    {
+      /* Spacing adapted to the broadcast load */
+      lSpacing = APP_ZIGBEE_BroadcastGetSpacing();
+      lElapsed = ( HAL_GetTick() - lFanoutBroadcastTick );
+      if ( ( bFanoutBroadcastSent != false ) && ( lElapsed < lSpacing ) )
+      {
+        /* Too early for the next broadcast, the Timer sets the Task again */
+        UTIL_TIMER_StartWithPeriod( &stFanoutSpacingTimer, ( lSpacing - lElapsed ) );
+        return;
+      }
+
+      bFanoutBroadcastSent = true;
+      lFanoutBroadcastTick = HAL_GetTick();
+    }
+    else
+    {
+      /* Frames held for a sleepy child are bounded */
+      if ( APP_ZIGBEE_IndirectAdmit( &astFanoutDest[iIndex], false ) == false )
+      {
+        iFanoutNext++;
+        iFanoutDone++;
+        aeFanoutStatus[iIndex] = ZCL_STATUS_INSUFFICIENT_SPACE;
+        stFanoutResult.iRefused++;
+        continue;
+      }
+
+      /* The route discovery of the ZCL request is not controlled : the route of a hot destination is kept ahead */
+      (void)APP_ZIGBEE_RouteUse( &astFanoutDest[iIndex] );
+    }
+
+    iFanoutNext++;
+    iFanoutInFlight++;
+    abFanoutPending[iIndex] = true;
+
+    eStatus = APP_ZIGBEE_LatencyRequest( pfFanoutRequest, pstFanoutCluster, &astFanoutDest[iIndex], FanoutRspCallback, (void *)(uintptr_t)iIndex );
+    if ( ( eStatus != ZCL_STATUS_SUCCESS ) && ( abFanoutPending[iIndex] != false ) )
+    {
+      /* Not sent : no confirmation to wait for */
+      APP_ZIGBEE_IndirectRelease( &astFanoutDest[iIndex] );
+      abFanoutPending[iIndex] = false;
+      aeFanoutStatus[iIndex] = eStatus;
+      iFanoutInFlight--;
+      iFanoutDone++;
+      stFanoutResult.iRefused++;
+    }
+  }
+
+  if ( iFanoutDone == stFanoutResult.iNumber )
+  {
+    stFanoutResult.lDuration = ( HAL_GetTick() - lFanoutStartTick );
+    bFanoutBusy = false;
+
+    if ( pfFanoutCallback != NULL )
+    {
+      pfFanoutCallback( &stFanoutResult, pFanoutArg );
+    }
+  }
+}
+
+/**
+ * @brief  Confirmation (APS confirmation, ZCL response or timeout) of one destination.
+ * @param  pstRsp   ZCL command response
+ * @param  arg      Index of the destination
+ * @retval None
+ */
+static void FanoutRspCallback( struct ZbZclCommandRspT * pstRsp, void * arg )
+{
+  uint16_t  iIndex = (uint16_t)(uintptr_t)arg;
+
+  if ( ( iIndex >= CFG_ZIGBEE_FANOUT_DEST_MAX ) || ( abFanoutPending[iIndex] == false ) )
+  {
+    return;
+  }
+
+  abFanoutPending[iIndex] = false;
+  iFanoutInFlight--;
+  iFanoutDone++;
+  APP_ZIGBEE_IndirectRelease( &astFanoutDest[iIndex] );
+
+  if ( pstRsp->aps_status != ZB_STATUS_SUCCESS )
+  {
+    aeFanoutStatus[iIndex] = (enum ZclStatusCodeT)pstRsp->aps_status;
+  }
+  else
+  {
+    aeFanoutStatus[iIndex] = pstRsp->status;
+  }
+
+  if ( aeFanoutStatus[iIndex] == ZCL_STATUS_SUCCESS )
+  {
+    stFanoutResult.iSuccess++;
+  }
+  else
+  {
+    stFanoutResult.iFailed++;
+  }
+
+  /* Next requests, or completion, from the Task */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_FANOUT ), TASK_PRIO_ZIGBEE_FANOUT );
+}
+
+/**
+ * @brief  Callback triggered when the spacing between two broadcasts expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void FanoutSpacingElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_FANOUT ), TASK_PRIO_ZIGBEE_FANOUT );
+}
+
+/**
+ * @brief  Start the fan-out to the first destinations of astFanoutDest.
+ * @param  pstCluster   Client cluster sending the command
+ * @param  pfRequest    Request of the command
+ * @param  iDestNumber  Number of destinations
+ * @param  pfCallback   Callback called once all the destinations have confirmed (can be NULL)
+ * @param  arg          Argument of the callback
+ * @retval None
+ */
+static void FanoutBegin( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest, uint16_t iDestNumber,
+                         APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg )
+{
+  memset( abFanoutPending, 0, sizeof( abFanoutPending ) );
+  memset( &stFanoutResult, 0, sizeof( stFanoutResult ) );
+
+  pstFanoutCluster = pstCluster;
+  pfFanoutRequest = pfRequest;
+  pfFanoutCallback = pfCallback;
+  pFanoutArg = arg;
+
+  iFanoutNext = 0;
+  iFanoutInFlight = 0;
+  iFanoutDone = 0;
+  stFanoutResult.iNumber = iDestNumber;
+  stFanoutResult.peStatus = aeFanoutStatus;
+  lFanoutStartTick = HAL_GetTick();
+  bFanoutBusy = true;
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_FANOUT ), TASK_PRIO_ZIGBEE_FANOUT );
+}
+
+/**
+ * @brief  Indicate if a destination is a group or a broadcast (sent as a NWK broadcast)
+ * @param  pstDest  Destination
+ * @retval True if the destination is a group or a broadcast.
+ */
+static bool FanoutIsBroadcast( const struct ZbApsAddrT * pstDest )
+{
+  if ( pstDest->mode == ZB_APSDE_ADDRMODE_GROUP )
+  {
+    return true;
+  }
+
+  return ( ( pstDest->mode == ZB_APSDE_ADDRMODE_SHORT ) && ( pstDest->nwkAddr >= FANOUT_NWK_ADDR_BROADCAST_MIN ) );
+}
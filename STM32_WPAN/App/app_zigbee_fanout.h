@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_fanout.h
+  * @author  MCD Application Team
+  * @brief   Interface to send a ZCL command to a list of destinations.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_FANOUT_H
+#define APP_ZIGBEE_FANOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* ZCL client request, with the prototype of ZbZclOnOffClientToggleReq, ZbZclOnOffClientOnReq, ... */
+typedef enum ZclStatusCodeT ( * APP_ZIGBEE_FanoutRequest_t )( struct ZbZclClusterT * pstCluster, const struct ZbApsAddrT * pstDest,
+                                                              void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg );
+
+/* Aggregate result of a fan-out */
+typedef struct
+{
+  uint16_t                    iNumber;          /* Number of destinations */
+  uint16_t                    iSuccess;         /* Number of destinations that confirmed the command */
+  uint16_t                    iFailed;          /* Number of destinations with an APS or ZCL error */
+  uint16_t                    iRefused;         /* Number of requests refused by the stack */
+  uint32_t                    lDuration;        /* Time (in ms) from the start to the last confirmation */
+  const enum ZclStatusCodeT * peStatus;         /* Status of each destination, in the order of the list */
+} APP_ZIGBEE_FanoutResult_t;
+
+/* Callback called when all the destinations have confirmed (or failed) */
+typedef void ( * APP_ZIGBEE_FanoutCallback_t )( const APP_ZIGBEE_FanoutResult_t * pstResult, void * arg );
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_FanoutInit             ( void );
+bool      APP_ZIGBEE_FanoutStart            ( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest,
+                                              const struct ZbApsAddrT * pstDestList, uint16_t iDestNumber,
+                                              APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg );
+bool      APP_ZIGBEE_FanoutStartBound       ( struct ZbZclClusterT * pstCluster, APP_ZIGBEE_FanoutRequest_t pfRequest,
+                                              APP_ZIGBEE_FanoutCallback_t pfCallback, void * arg );
+bool      APP_ZIGBEE_FanoutIsBusy           ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_FANOUT_H */
@@ -0,0 +1,453 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_findbind.c
+  * @author  MCD Application Team
+  * @brief   Finding & binding engine : the targets are found by one broadcast
+  *          Match_Desc, then their IEEE_addr and Simple_Desc requests are
+  *          pipelined (bounded number waiting for their response) as the
+  *          targets come, instead of one target after another. The bindings
+  *          are created locally, with one aggregate completion callback.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_findbind.h"
+#include "app_zigbee_bindmap.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.zdo.h"
+
+#if (CFG_ZIGBEE_FINDBIND_SUPPORTED != 0)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Step of a target */
+typedef enum
+{
+  FINDBIND_STEP_ADDR,                       /* IEEE address to request */
+  FINDBIND_STEP_DESC,                       /* Simple descriptor to request */
+  FINDBIND_STEP_WAIT,                       /* Request waiting for its response */
+  FINDBIND_STEP_DONE,
+} FindBindStep_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_FindBindTarget_t  astFindBindTarget[CFG_ZIGBEE_FINDBIND_TARGET_MAX];
+static FindBindStep_t               aeFindBindStep[CFG_ZIGBEE_FINDBIND_TARGET_MAX];
+
+static struct ZigBeeT             * pstFindBindZigbee;
+static APP_ZIGBEE_FindBindCallback_t pfFindBindCallback;
+static void                       * pFindBindArg;
+static uint16_t                     aiFindBindCluster[ZB_ZDO_CLUSTER_LIST_MAX_SZ];
+static uint8_t                      cFindBindClusterNumber;
+static uint8_t                      cFindBindEndpoint;
+static uint16_t                     iFindBindProfileId;
+
+static bool                         bFindBindBusy, bFindBindDiscovering;
+static uint16_t                     iFindBindNext, iFindBindInFlight, iFindBindDone;
+static uint32_t                     lFindBindStartTick;
+static APP_ZIGBEE_FindBindResult_t  stFindBindResult;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     FindBindPump            ( void );
+static void     FindBindTargetEnd       ( uint16_t iIndex, enum ZbStatusCodeT eStatus );
+static void     FindBindMatchCallback   ( struct ZbZdoMatchDescRspT * pstRsp, void * arg );
+static void     FindBindAddrCallback    ( struct ZbZdoIeeeAddrRspT * pstRsp, void * arg );
+static void     FindBindDescCallback    ( struct ZbZdoSimpleDescRspT * pstRsp, void * arg );
+static void     FindBindPrintStats      ( void );
+
+/* Serial commands of the finding & binding */
+static const SerialCmd_t            astFindBindSerialCmds[] =
+{
+  { "FINDBINDSTATS", FindBindPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stFindBindSerialCmdTable =
+{
+  astFindBindSerialCmds, ( sizeof( astFindBindSerialCmds ) / sizeof( astFindBindSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the finding & binding engine.
+ * @param  pstZigbee  Zigbee stack instance
+ * @retval None
+ */
+void APP_ZIGBEE_FindBindInit( struct ZigBeeT * pstZigbee )
+{
+  pstFindBindZigbee = pstZigbee;
+  bFindBindBusy = false;
+  memset( &stFindBindResult, 0, sizeof( stFindBindResult ) );
+  stFindBindResult.pstTargets = astFindBindTarget;
+
+  Serial_CMD_Interpreter_RegisterTable( &stFindBindSerialCmdTable );
+}
+
+/**
+ * @brief  Bind the client clusters of an Endpoint to the matching Servers of the Network. The targets answering the
+ *         broadcast Match_Desc are processed as they come : IEEE_addr_req if their IEEE address is not known, then
+ *         Simple_Desc_req, at most CFG_ZIGBEE_FINDBIND_MAX_INFLIGHT waiting for their response at the same time.
+ *         Each client cluster that the target has as server is bound to it.
+ * @param  cEndpoint       Endpoint of the client clusters (initiator)
+ * @param  iProfileId      Profile of the Endpoint
+ * @param  piClusterList   Client clusters to bind, copied
+ * @param  cClusterNumber  Number of clusters (at most ZB_ZDO_CLUSTER_LIST_MAX_SZ)
+ * @param  pfCallback      Callback called once all the targets have been processed (can be NULL)
+ * @param  arg             Argument of the callback
+ * @retval True if started, false if another one is ongoing or the Match_Desc is refused.
+ */
+bool APP_ZIGBEE_FindBindStart( uint8_t cEndpoint, uint16_t iProfileId, const uint16_t * piClusterList,
+                               uint8_t cClusterNumber, APP_ZIGBEE_FindBindCallback_t pfCallback, void * arg )
+{
+  struct ZbZdoMatchDescReqT   stRequest;
+
+  if ( ( bFindBindBusy != false ) || ( pstFindBindZigbee == NULL ) || ( cClusterNumber == 0u ) ||
+       ( cClusterNumber > ZB_ZDO_CLUSTER_LIST_MAX_SZ ) )
+  {
+    return false;
+  }
+
+  memset( astFindBindTarget, 0, sizeof( astFindBindTarget ) );
+  memset( &stFindBindResult, 0, sizeof( stFindBindResult ) );
+  memcpy( aiFindBindCluster, piClusterList, ( cClusterNumber * sizeof( uint16_t ) ) );
+  cFindBindClusterNumber = cClusterNumber;
+  cFindBindEndpoint = cEndpoint;
+  iFindBindProfileId = iProfileId;
+  pfFindBindCallback = pfCallback;
+  pFindBindArg = arg;
+
+  iFindBindNext = 0;
+  iFindBindInFlight = 0;
+  iFindBindDone = 0;
+  stFindBindResult.pstTargets = astFindBindTarget;
+  lFindBindStartTick = HAL_GetTick();
+
+  /* Servers of the client clusters of the Endpoint */
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dstNwkAddr = ZB_NWK_ADDR_BCAST_RXON;
+  stRequest.nwkAddrOfInterest = ZB_NWK_ADDR_BCAST_RXON;
+  stRequest.profileId = iProfileId;
+  stRequest.numInClusters = cClusterNumber;
+  memcpy( stRequest.inClusterList, piClusterList, ( cClusterNumber * sizeof( uint16_t ) ) );
+
+  bFindBindBusy = true;
+  bFindBindDiscovering = true;
+  if ( ZbZdoMatchDescMulti( pstFindBindZigbee, &stRequest, FindBindMatchCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    bFindBindBusy = false;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Indicate if a finding & binding is ongoing.
+ * @param  None
+ * @retval True if ongoing.
+ */
+bool APP_ZIGBEE_FindBindIsBusy( void )
+{
+  return bFindBindBusy;
+}
+
+/**
+ * @brief  Send the next requests that the window allows, then call the completion callback when the Match_Desc has
+ *         ended and all the targets are done.
+ * @param  None
+ * @retval None
+ */
+static void FindBindPump( void )
+{
+  struct ZbZdoIeeeAddrReqT    stAddrRequest;
+  struct ZbZdoSimpleDescReqT  stDescRequest;
+  APP_ZIGBEE_FindBindTarget_t * pstTarget;
+  enum ZbStatusCodeT          eStatus;
+  uint16_t                    iIndex;
+
+  if ( bFindBindBusy == false )
+  {
+    return;
+  }
+
+  for ( iIndex = iFindBindNext; ( iIndex < stFindBindResult.iTargets ) && ( iFindBindInFlight < CFG_ZIGBEE_FINDBIND_MAX_INFLIGHT ); iIndex++ )
+  {
+    pstTarget = &astFindBindTarget[iIndex];
+    if ( aeFindBindStep[iIndex] == FINDBIND_STEP_ADDR )
+    {
+      memset( &stAddrRequest, 0, sizeof( stAddrRequest ) );
+      stAddrRequest.dstNwkAddr = pstTarget->iNwkAddr;
+      stAddrRequest.nwkAddrOfInterest = pstTarget->iNwkAddr;
+      stAddrRequest.reqType = ZB_ZDO_ADDR_REQ_TYPE_SINGLE;
+      aeFindBindStep[iIndex] = FINDBIND_STEP_WAIT;
+      iFindBindInFlight++;
+      eStatus = ZbZdoIeeeAddrReq( pstFindBindZigbee, &stAddrRequest, FindBindAddrCallback, (void *)(uintptr_t)iIndex );
+    }
+    else if ( aeFindBindStep[iIndex] == FINDBIND_STEP_DESC )
+    {
+      memset( &stDescRequest, 0, sizeof( stDescRequest ) );
+      stDescRequest.dstNwkAddr = pstTarget->iNwkAddr;
+      stDescRequest.nwkAddrOfInterest = pstTarget->iNwkAddr;
+      stDescRequest.endpt = pstTarget->cEndpoint;
+      aeFindBindStep[iIndex] = FINDBIND_STEP_WAIT;
+      iFindBindInFlight++;
+      eStatus = ZbZdoSimpleDescReq( pstFindBindZigbee, &stDescRequest, FindBindDescCallback, (void *)(uintptr_t)iIndex );
+    }
+    else
+    {
+      continue;
+    }
+
+    if ( eStatus != ZB_STATUS_SUCCESS )
+    {
+      /* Not sent : no response to wait for */
+      iFindBindInFlight--;
+      FindBindTargetEnd( iIndex, eStatus );
+    }
+  }
+
+  /* Targets before the first one with a request to send are all waiting or done */
+  while ( ( iFindBindNext < stFindBindResult.iTargets ) &&
+          ( ( aeFindBindStep[iFindBindNext] == FINDBIND_STEP_WAIT ) || ( aeFindBindStep[iFindBindNext] == FINDBIND_STEP_DONE ) ) )
+  {
+    iFindBindNext++;
+  }
+
+  if ( ( bFindBindDiscovering == false ) && ( iFindBindDone == stFindBindResult.iTargets ) )
+  {
+    stFindBindResult.lDuration = ( HAL_GetTick() - lFindBindStartTick );
+    bFindBindBusy = false;
+
+    if ( pfFindBindCallback != NULL )
+    {
+      pfFindBindCallback( &stFindBindResult, pFindBindArg );
+    }
+  }
+}
+
+/**
+ * @brief  End of a target.
+ * @param  iIndex   Index of the target
+ * @param  eStatus  Status of its last request
+ * @retval None
+ */
+static void FindBindTargetEnd( uint16_t iIndex, enum ZbStatusCodeT eStatus )
+{
+  aeFindBindStep[iIndex] = FINDBIND_STEP_DONE;
+  astFindBindTarget[iIndex].eStatus = eStatus;
+  iFindBindDone++;
+
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    stFindBindResult.iFailed++;
+  }
+  else if ( astFindBindTarget[iIndex].cBound != 0u )
+  {
+    stFindBindResult.iBound++;
+  }
+}
+
+/**
+ * @brief  Match_Desc_rsp of a device : each Endpoint matched is a new target, processed at once if the window allows.
+ *         The timeout ends the discovery.
+ * @param  pstRsp   Response
+ * @param  arg      Not used
+ * @retval None
+ */
+static void FindBindMatchCallback( struct ZbZdoMatchDescRspT * pstRsp, void * arg )
+{
+  APP_ZIGBEE_FindBindTarget_t * pstTarget;
+  uint8_t                     cIndex;
+
+  UNUSED( arg );
+
+  if ( bFindBindBusy == false )
+  {
+    return;
+  }
+
+  if ( pstRsp->status == ZB_ZDP_STATUS_TIMEOUT )
+  {
+    bFindBindDiscovering = false;
+  }
+  else if ( ( pstRsp->status == ZB_STATUS_SUCCESS ) && ( pstRsp->nwkAddr != ZbShortAddress( pstFindBindZigbee ) ) )
+  {
+    for ( cIndex = 0; cIndex < pstRsp->matchLength; cIndex++ )
+    {
+      if ( stFindBindResult.iTargets >= CFG_ZIGBEE_FINDBIND_TARGET_MAX )
+      {
+        stFindBindResult.iDropped++;
+        continue;
+      }
+
+      pstTarget = &astFindBindTarget[stFindBindResult.iTargets];
+      pstTarget->iNwkAddr = pstRsp->nwkAddr;
+      pstTarget->cEndpoint = pstRsp->matchList[cIndex];
+      pstTarget->llExtAddr = ZbNwkAddrLookupExt( pstFindBindZigbee, pstRsp->nwkAddr );
+      aeFindBindStep[stFindBindResult.iTargets] = ( pstTarget->llExtAddr == 0u ) ? FINDBIND_STEP_ADDR : FINDBIND_STEP_DESC;
+      stFindBindResult.iTargets++;
+    }
+  }
+
+  FindBindPump();
+}
+
+/**
+ * @brief  IEEE_addr_rsp of a target : its Simple_Desc is requested next.
+ * @param  pstRsp   Response
+ * @param  arg      Index of the target
+ * @retval None
+ */
+static void FindBindAddrCallback( struct ZbZdoIeeeAddrRspT * pstRsp, void * arg )
+{
+  uint16_t  iIndex = (uint16_t)(uintptr_t)arg;
+
+  if ( ( bFindBindBusy == false ) || ( iIndex >= stFindBindResult.iTargets ) || ( aeFindBindStep[iIndex] != FINDBIND_STEP_WAIT ) )
+  {
+    return;
+  }
+
+  iFindBindInFlight--;
+  if ( ( pstRsp->status != ZB_STATUS_SUCCESS ) || ( pstRsp->extAddr == 0u ) )
+  {
+    FindBindTargetEnd( iIndex, pstRsp->status );
+  }
+  else
+  {
+    astFindBindTarget[iIndex].llExtAddr = pstRsp->extAddr;
+    aeFindBindStep[iIndex] = FINDBIND_STEP_DESC;
+    if ( iIndex < iFindBindNext )
+    {
+      iFindBindNext = iIndex;
+    }
+  }
+
+  FindBindPump();
+}
+
+/**
+ * @brief  Simple_Desc_rsp of a target : each client cluster of the initiator that the target has as server is bound.
+ * @param  pstRsp   Response
+ * @param  arg      Index of the target
+ * @retval None
+ */
+static void FindBindDescCallback( struct ZbZdoSimpleDescRspT * pstRsp, void * arg )
+{
+  APP_ZIGBEE_FindBindTarget_t * pstTarget;
+  struct ZbApsAddrT           stDest;
+  enum ZbStatusCodeT          eStatus;
+  uint16_t                    iIndex = (uint16_t)(uintptr_t)arg;
+  uint8_t                     cCluster, cServer;
+
+  if ( ( bFindBindBusy == false ) || ( iIndex >= stFindBindResult.iTargets ) || ( aeFindBindStep[iIndex] != FINDBIND_STEP_WAIT ) )
+  {
+    return;
+  }
+
+  iFindBindInFlight--;
+  pstTarget = &astFindBindTarget[iIndex];
+  eStatus = pstRsp->status;
+  if ( ( eStatus == ZB_STATUS_SUCCESS ) && ( pstRsp->simpleDesc.profileId == iFindBindProfileId ) )
+  {
+    memset( &stDest, 0, sizeof( stDest ) );
+    stDest.mode = ZB_APSDE_ADDRMODE_EXT;
+    stDest.extAddr = pstTarget->llExtAddr;
+    stDest.endpoint = pstTarget->cEndpoint;
+
+    for ( cCluster = 0; cCluster < cFindBindClusterNumber; cCluster++ )
+    {
+      for ( cServer = 0; ( cServer < pstRsp->simpleDesc.inputClusterCount ) && ( cServer < ZB_ZDO_CLUSTER_LIST_MAX_SZ ); cServer++ )
+      {
+        if ( pstRsp->simpleDesc.inputClusterList[cServer] == aiFindBindCluster[cCluster] )
+        {
+          eStatus = APP_ZIGBEE_BindMapBind( cFindBindEndpoint, aiFindBindCluster[cCluster], &stDest );
+          if ( eStatus == ZB_STATUS_SUCCESS )
+          {
+            pstTarget->cBound++;
+            stFindBindResult.iBindings++;
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  FindBindTargetEnd( iIndex, eStatus );
+  FindBindPump();
+}
+
+/**
+ * @brief  Print the result of the last finding & binding.
+ * @param  None
+ * @retval None
+ */
+static void FindBindPrintStats( void )
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_FindBindTarget_t * pstTarget;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  uint16_t                          iIndex;
+
+  LOG_INFO_APP( "Finding & binding%s : %d targets (%d dropped), %d bound, %d failed, %d bindings in %d ms.",
+                ( ( bFindBindBusy != false ) ? " (ongoing)" : "" ), stFindBindResult.iTargets, stFindBindResult.iDropped,
+                stFindBindResult.iBound, stFindBindResult.iFailed, stFindBindResult.iBindings, stFindBindResult.lDuration );
+
+  for ( iIndex = 0; iIndex < stFindBindResult.iTargets; iIndex++ )
+  {
+#if (CFG_LOG_SUPPORTED != 0)
+    pstTarget = &astFindBindTarget[iIndex];
+    LOG_INFO_APP( "  0x%04X/%d : %d bound, status 0x%02X.", pstTarget->iNwkAddr, pstTarget->cEndpoint, pstTarget->cBound,
+                  pstTarget->eStatus );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  }
+}
+
+#else /* (CFG_ZIGBEE_FINDBIND_SUPPORTED != 0) */
+
+/**
+ * @brief  Finding & binding not supported.
+ */
+void APP_ZIGBEE_FindBindInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Finding & binding not supported : never started.
+ */
+bool APP_ZIGBEE_FindBindStart( uint8_t cEndpoint, uint16_t iProfileId, const uint16_t * piClusterList,
+                               uint8_t cClusterNumber, APP_ZIGBEE_FindBindCallback_t pfCallback, void * arg )
+{
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+  UNUSED( piClusterList );
+  UNUSED( cClusterNumber );
+  UNUSED( pfCallback );
+  UNUSED( arg );
+  return false;
+}
+
+/**
+ * @brief  Finding & binding not supported : never busy.
+ */
+bool APP_ZIGBEE_FindBindIsBusy( void )
+{
+  return false;
+}
+
+#endif /* (CFG_ZIGBEE_FINDBIND_SUPPORTED != 0) */
@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_findbind.h
+  * @author  MCD Application Team
+  * @brief   Interface of the finding & binding engine (ZDO requests of the
+  *          targets pipelined).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_FINDBIND_H
+#define APP_ZIGBEE_FINDBIND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Target (Endpoint of a device) found by the Match_Desc */
+typedef struct
+{
+  uint64_t            llExtAddr;
+  uint16_t            iNwkAddr;
+  uint8_t             cEndpoint;
+  uint8_t             cBound;           /* Bindings created to the target */
+  enum ZbStatusCodeT  eStatus;          /* Status of the last request of the target */
+} APP_ZIGBEE_FindBindTarget_t;
+
+/* Aggregate result of a finding & binding */
+typedef struct
+{
+  uint16_t                            iTargets;     /* Number of targets found */
+  uint16_t                            iBound;       /* Number of targets with at least one binding */
+  uint16_t                            iFailed;      /* Number of targets with a failed or refused request */
+  uint16_t                            iBindings;    /* Number of bindings created */
+  uint16_t                            iDropped;     /* Number of targets found above CFG_ZIGBEE_FINDBIND_TARGET_MAX */
+  uint32_t                            lDuration;    /* Time (in ms) from the start to the last response */
+  const APP_ZIGBEE_FindBindTarget_t * pstTargets;   /* Targets, in the order of their Match_Desc response */
+} APP_ZIGBEE_FindBindResult_t;
+
+/* Callback called when all the targets have been processed */
+typedef void ( * APP_ZIGBEE_FindBindCallback_t )( const APP_ZIGBEE_FindBindResult_t * pstResult, void * arg );
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_FindBindInit           ( struct ZigBeeT * pstZigbee );
+bool      APP_ZIGBEE_FindBindStart          ( uint8_t cEndpoint, uint16_t iProfileId, const uint16_t * piClusterList,
+                                              uint8_t cClusterNumber, APP_ZIGBEE_FindBindCallback_t pfCallback, void * arg );
+bool      APP_ZIGBEE_FindBindIsBusy         ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_FINDBIND_H */
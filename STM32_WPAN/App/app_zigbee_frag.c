@@ -0,0 +1,366 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_frag.c
+  * @author  MCD Application Team
+  * @brief   APS fragmentation tuner : the window size and the interframe delay
+  *          of the fragmented transfers are set per peer, first from the link
+  *          quality, then moved towards the best goodput measured.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_frag.h"
+#include "app_zigbee_addr.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.aps.h"
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_FRAG_TUNER_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define FRAG_LQI_GOOD                   (200u)      /* Neighbor LQI of a good link */
+#define FRAG_LQI_FAIR                   (100u)      /* Neighbor LQI of a fair link */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t    iNwkAddr;               /* Peer, ZB_NWK_ADDR_UNDEFINED when free */
+  uint8_t     cWindow;                /* Window size of the next transfer */
+  uint8_t     cDelay;                 /* Interframe delay (ms) of the next transfer */
+  uint8_t     cBestWindow;
+  uint8_t     cBestDelay;
+  uint8_t     cHold;                  /* Transfers left at the best settings before the next probe */
+  uint32_t    lBestGoodput;           /* Bytes/s, 0 when not measured */
+  uint32_t    lLastUse;
+} FragPeer_t;
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZigBeeT               * pstFragZigbee;
+static FragPeer_t                   astFragPeer[CFG_ZIGBEE_FRAG_PEER_MAX];
+static APP_ZIGBEE_FragStats_t       stFragStats;
+static uint8_t                      cFragDefaultWindow;
+static uint8_t                      cFragDefaultDelay;
+static uint32_t                     lFragClock;
+
+/* Private functions prototypes-----------------------------------------------*/
+static FragPeer_t * FragGetPeer         ( const struct ZbApsAddrT * pstDest, bool bCreate );
+static void         FragApply           ( uint8_t cWindow, uint8_t cDelay );
+static void         FragPrintStats      ( void );
+
+/* Serial commands of the tuner */
+static const SerialCmd_t            astFragSerialCmds[] =
+{
+  { "FRAGSTATS", FragPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stFragSerialCmdTable =
+{
+  astFragSerialCmds, ( sizeof( astFragSerialCmds ) / sizeof( astFragSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the tuner : fragmentation threshold (stack default if CFG_ZIGBEE_FRAG_THRESHOLD is 0), and
+ *         default window and delay kept for the other transfers.
+ * @param  pstZigbee    Zigbee stack handler
+ * @retval None
+ */
+void APP_ZIGBEE_FragInit( struct ZigBeeT * pstZigbee )
+{
+  uint8_t   cThreshold = CFG_ZIGBEE_FRAG_THRESHOLD;
+  uint16_t  iIndex;
+
+  pstFragZigbee = pstZigbee;
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_FRAG_PEER_MAX; iIndex++ )
+  {
+    astFragPeer[iIndex].iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+  }
+
+  if ( cThreshold != 0u )
+  {
+    (void)ZbApsSet( pstZigbee, ZB_APS_IB_ID_FRAGMENTATION_THRESH, &cThreshold, sizeof( cThreshold ) );
+  }
+  if ( ZbApsGet( pstZigbee, ZB_APS_IB_ID_MAX_WINDOW_SIZE, &cFragDefaultWindow, sizeof( cFragDefaultWindow ) ) != ZB_STATUS_SUCCESS )
+  {
+    cFragDefaultWindow = 1u;
+  }
+  if ( ZbApsGet( pstZigbee, ZB_APS_IB_ID_INTERFRAME_DELAY, &cFragDefaultDelay, sizeof( cFragDefaultDelay ) ) != ZB_STATUS_SUCCESS )
+  {
+    cFragDefaultDelay = CFG_ZIGBEE_FRAG_DELAY_MAX;
+  }
+
+  Serial_CMD_Interpreter_RegisterTable( &stFragSerialCmdTable );
+}
+
+/**
+ * @brief  Start of a fragmented transfer (TX option ZB_APSDE_DATAREQ_TXOPTIONS_FRAG) : the window and the delay of the
+ *         peer are set in the APS. A new peer starts from the LQI of its link (conservative when not a Neighbor).
+ *         The APS settings are global : the last transfer started sets them.
+ * @param  pstDest    Destination of the transfer
+ * @retval None
+ */
+void APP_ZIGBEE_FragBegin( const struct ZbApsAddrT * pstDest )
+{
+  struct ZbNwkNeighborT   stNeighbor;
+  FragPeer_t              * pstPeer;
+  uint16_t                iIndex;
+  uint8_t                 cLqi = 0;
+
+  pstPeer = FragGetPeer( pstDest, true );
+  if ( pstPeer == NULL )
+  {
+    return;
+  }
+
+  if ( pstPeer->cWindow == 0u )
+  {
+    for ( iIndex = 0; ZbNwkGetIndex( pstFragZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+    {
+      if ( stNeighbor.nwkAddr == pstPeer->iNwkAddr )
+      {
+        cLqi = stNeighbor.lqi;
+        break;
+      }
+    }
+
+    if ( cLqi >= FRAG_LQI_GOOD )
+    {
+      pstPeer->cWindow = ( ZB_APS_CONST_MAX_WINDOW_SIZE / 2u );
+      pstPeer->cDelay = CFG_ZIGBEE_FRAG_DELAY_MIN;
+    }
+    else if ( cLqi >= FRAG_LQI_FAIR )
+    {
+      pstPeer->cWindow = 2u;
+      pstPeer->cDelay = ( CFG_ZIGBEE_FRAG_DELAY_MIN + CFG_ZIGBEE_FRAG_DELAY_MAX ) / 2u;
+    }
+    else
+    {
+      pstPeer->cWindow = 1u;
+      pstPeer->cDelay = CFG_ZIGBEE_FRAG_DELAY_MAX;
+    }
+    pstPeer->cBestWindow = pstPeer->cWindow;
+    pstPeer->cBestDelay = pstPeer->cDelay;
+  }
+
+  stFragStats.lTransfers++;
+  FragApply( pstPeer->cWindow, pstPeer->cDelay );
+}
+
+/**
+ * @brief  End of a fragmented transfer : the settings of the peer move towards the best goodput. A success at least
+ *         as fast as the best one becomes the best and the next transfer probes a larger window (then a shorter delay)
+ *         after CFG_ZIGBEE_FRAG_HOLD transfers; a slower one returns to the best settings; a failure halves the
+ *         window and lengthens the delay. The default APS settings are restored.
+ * @param  pstDest    Destination of the transfer
+ * @param  lBytes     Bytes transferred
+ * @param  lDuration  Duration of the transfer (ms)
+ * @param  bSuccess   True if the transfer is confirmed
+ * @retval None
+ */
+void APP_ZIGBEE_FragEnd( const struct ZbApsAddrT * pstDest, uint32_t lBytes, uint32_t lDuration, bool bSuccess )
+{
+  FragPeer_t  * pstPeer;
+  uint32_t    lGoodput;
+
+  FragApply( cFragDefaultWindow, cFragDefaultDelay );
+
+  pstPeer = FragGetPeer( pstDest, false );
+  if ( ( pstPeer == NULL ) || ( pstPeer->cWindow == 0u ) )
+  {
+    return;
+  }
+
+  if ( bSuccess == false )
+  {
+    stFragStats.lFailures++;
+    pstPeer->cWindow = MAX( ( pstPeer->cWindow / 2u ), 1u );
+    pstPeer->cDelay = MIN( ( pstPeer->cDelay + CFG_ZIGBEE_FRAG_DELAY_STEP ), CFG_ZIGBEE_FRAG_DELAY_MAX );
+    pstPeer->cBestWindow = pstPeer->cWindow;
+    pstPeer->cBestDelay = pstPeer->cDelay;
+    pstPeer->lBestGoodput = 0;
+    pstPeer->cHold = 0;
+    return;
+  }
+
+  stFragStats.lBytes += lBytes;
+  lGoodput = (uint32_t)( ( (uint64_t)lBytes * 1000u ) / MAX( lDuration, 1u ) );
+  if ( lGoodput >= pstPeer->lBestGoodput )
+  {
+    pstPeer->lBestGoodput = lGoodput;
+    pstPeer->cBestWindow = pstPeer->cWindow;
+    pstPeer->cBestDelay = pstPeer->cDelay;
+  }
+  else
+  {
+    pstPeer->cWindow = pstPeer->cBestWindow;
+    pstPeer->cDelay = pstPeer->cBestDelay;
+    pstPeer->cHold = CFG_ZIGBEE_FRAG_HOLD;
+  }
+
+  if ( pstPeer->cHold != 0u )
+  {
+    pstPeer->cHold--;
+  }
+  else if ( pstPeer->cWindow < ZB_APS_CONST_MAX_WINDOW_SIZE )
+  {
+    pstPeer->cWindow++;
+  }
+  else if ( pstPeer->cDelay >= ( CFG_ZIGBEE_FRAG_DELAY_MIN + CFG_ZIGBEE_FRAG_DELAY_STEP ) )
+  {
+    pstPeer->cDelay -= CFG_ZIGBEE_FRAG_DELAY_STEP;
+  }
+}
+
+/**
+ * @brief  Statistics of the tuner.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_FragStats_t * APP_ZIGBEE_FragGetStats( void )
+{
+  return &stFragStats;
+}
+
+/**
+ * @brief  Peer of a destination (unicast only), created in place of the least recently used one if asked.
+ * @param  pstDest    Destination
+ * @param  bCreate    True to create the peer if not known
+ * @retval Peer, NULL if not an unicast or not known.
+ */
+static FragPeer_t * FragGetPeer( const struct ZbApsAddrT * pstDest, bool bCreate )
+{
+  FragPeer_t        * pstOldest = &astFragPeer[0];
+  uint16_t          iNwkAddr, iIndex;
+
+  if ( pstDest->mode == ZB_APSDE_ADDRMODE_SHORT )
+  {
+    iNwkAddr = pstDest->nwkAddr;
+  }
+  else if ( pstDest->mode == ZB_APSDE_ADDRMODE_EXT )
+  {
+    iNwkAddr = APP_ZIGBEE_AddrLookupNwk( pstDest->extAddr );
+  }
+  else
+  {
+    return NULL;
+  }
+
+  if ( iNwkAddr >= ZB_NWK_ADDR_BCAST_MIN )
+  {
+    return NULL;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_FRAG_PEER_MAX; iIndex++ )
+  {
+    if ( astFragPeer[iIndex].iNwkAddr == iNwkAddr )
+    {
+      astFragPeer[iIndex].lLastUse = ++lFragClock;
+      return &astFragPeer[iIndex];
+    }
+    if ( astFragPeer[iIndex].lLastUse < pstOldest->lLastUse )
+    {
+      pstOldest = &astFragPeer[iIndex];
+    }
+  }
+
+  if ( bCreate == false )
+  {
+    return NULL;
+  }
+
+  memset( pstOldest, 0, sizeof( FragPeer_t ) );
+  pstOldest->iNwkAddr = iNwkAddr;
+  pstOldest->lLastUse = ++lFragClock;
+
+  return pstOldest;
+}
+
+/**
+ * @brief  Set the window size and the interframe delay of the APS.
+ * @param  cWindow    Window size
+ * @param  cDelay     Interframe delay (ms)
+ * @retval None
+ */
+static void FragApply( uint8_t cWindow, uint8_t cDelay )
+{
+  (void)ZbApsSet( pstFragZigbee, ZB_APS_IB_ID_MAX_WINDOW_SIZE, &cWindow, sizeof( cWindow ) );
+  (void)ZbApsSet( pstFragZigbee, ZB_APS_IB_ID_INTERFRAME_DELAY, &cDelay, sizeof( cDelay ) );
+}
+
+/**
+ * @brief  Print the settings of the peers and the statistics of the tuner.
+ * @param  None
+ * @retval None
+ */
+static void FragPrintStats( void )
+{
+  const FragPeer_t  * pstPeer;
+  uint16_t          iIndex;
+
+  LOG_INFO_APP( "Fragmentation : default window %d delay %d ms, %d transfers (%d failed), %d bytes.", cFragDefaultWindow, cFragDefaultDelay, stFragStats.lTransfers,
+                stFragStats.lFailures, stFragStats.lBytes );
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_FRAG_PEER_MAX; iIndex++ )
+  {
+    pstPeer = &astFragPeer[iIndex];
+    if ( ( pstPeer->iNwkAddr != ZB_NWK_ADDR_UNDEFINED ) && ( pstPeer->cWindow != 0u ) )
+    {
+      LOG_INFO_APP( "  0x%04X : window %d delay %d ms, best %d B/s (window %d delay %d ms)", pstPeer->iNwkAddr,
+                    pstPeer->cWindow, pstPeer->cDelay, pstPeer->lBestGoodput, pstPeer->cBestWindow, pstPeer->cBestDelay );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_FRAG_TUNER_SUPPORTED != 0) */
+
+/**
+ * @brief  Fragmentation tuner not supported.
+ */
+void APP_ZIGBEE_FragInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Fragmentation tuner not supported : default APS settings.
+ */
+void APP_ZIGBEE_FragBegin( const struct ZbApsAddrT * pstDest )
+{
+  UNUSED( pstDest );
+}
+
+/**
+ * @brief  Fragmentation tuner not supported.
+ */
+void APP_ZIGBEE_FragEnd( const struct ZbApsAddrT * pstDest, uint32_t lBytes, uint32_t lDuration, bool bSuccess )
+{
+  UNUSED( pstDest );
+  UNUSED( lBytes );
+  UNUSED( lDuration );
+  UNUSED( bSuccess );
+}
+
+/**
+ * @brief  Fragmentation tuner not supported : no statistics.
+ */
+const APP_ZIGBEE_FragStats_t * APP_ZIGBEE_FragGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_FRAG_TUNER_SUPPORTED != 0) */
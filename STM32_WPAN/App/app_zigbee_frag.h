@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_frag.h
+  * @author  MCD Application Team
+  * @brief   Interface of the APS fragmentation tuner (window and interframe
+  *          delay per peer).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_FRAG_H
+#define APP_ZIGBEE_FRAG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the tuner */
+typedef struct
+{
+  uint32_t    lTransfers;             /* Number of fragmented transfers */
+  uint32_t    lFailures;              /* Number of fragmented transfers failed */
+  uint32_t    lBytes;                 /* Bytes of the transfers succeeded */
+} APP_ZIGBEE_FragStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_FragInit               ( struct ZigBeeT * pstZigbee );
+void      APP_ZIGBEE_FragBegin              ( const struct ZbApsAddrT * pstDest );
+void      APP_ZIGBEE_FragEnd                ( const struct ZbApsAddrT * pstDest, uint32_t lBytes, uint32_t lDuration, bool bSuccess );
+
+const APP_ZIGBEE_FragStats_t * APP_ZIGBEE_FragGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_FRAG_H */
@@ -0,0 +1,144 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_frame.c
+  * @author  MCD Application Team
+  * @brief   ZCL frame builder : the ZCL header and the payload are serialized
+  *          once, in place, in the final buffer of the frame, which is given as
+  *          is to the APS (no temporary payload buffer, no ZCL re-assembly).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "app_conf.h"
+#include "app_zigbee_frame.h"
+#include "app_zigbee_route.h"
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Start a frame in the buffer of the caller : its ZCL header is written at the start.
+ * @param  pstFrame     Frame
+ * @param  pBuffer      Final buffer of the frame, kept until the frame is sent
+ * @param  iSize        Size of the buffer (APP_ZIGBEE_FRAME_HEADROOM and the payload)
+ * @param  pstCluster   Cluster sending the frame
+ * @param  pstHeader    ZCL header of the frame
+ * @retval True if the header is written.
+ */
+bool APP_ZIGBEE_FrameStart( APP_ZIGBEE_Frame_t * pstFrame, uint8_t * pBuffer, uint16_t iSize,
+                            struct ZbZclClusterT * pstCluster, struct ZbZclHeaderT * pstHeader )
+{
+  int   iLength;
+
+  pstFrame->pstCluster = pstCluster;
+  pstFrame->pBuffer = pBuffer;
+  pstFrame->iSize = iSize;
+  pstFrame->iLength = 0;
+
+  iLength = ZbZclAppendHeader( pstHeader, pBuffer, iSize );
+  if ( iLength <= 0 )
+  {
+    return false;
+  }
+
+  pstFrame->iLength = (uint16_t)iLength;
+  return true;
+}
+
+/**
+ * @brief  End of the frame, where the next field is to be serialized in place.
+ * @param  pstFrame   Frame
+ * @param  piRoom     Bytes left in the buffer
+ * @retval Address of the end of the frame.
+ */
+uint8_t * APP_ZIGBEE_FrameTail( APP_ZIGBEE_Frame_t * pstFrame, uint16_t * piRoom )
+{
+  *piRoom = ( pstFrame->iSize - pstFrame->iLength );
+
+  return &pstFrame->pBuffer[pstFrame->iLength];
+}
+
+/**
+ * @brief  Add to the frame the bytes serialized at its end (at most the room given by APP_ZIGBEE_FrameTail).
+ * @param  pstFrame   Frame
+ * @param  iLength    Bytes serialized
+ * @retval None
+ */
+void APP_ZIGBEE_FrameCommit( APP_ZIGBEE_Frame_t * pstFrame, uint16_t iLength )
+{
+  pstFrame->iLength += MIN( iLength, ( pstFrame->iSize - pstFrame->iLength ) );
+}
+
+/**
+ * @brief  Add an uint16 (little endian) to the frame.
+ * @param  pstFrame   Frame
+ * @param  iValue     Value
+ * @retval True if added, false if the frame is full.
+ */
+bool APP_ZIGBEE_FramePutUint16( APP_ZIGBEE_Frame_t * pstFrame, uint16_t iValue )
+{
+  if ( ( pstFrame->iSize - pstFrame->iLength ) < 2u )
+  {
+    return false;
+  }
+
+  pstFrame->pBuffer[pstFrame->iLength++] = (uint8_t)( iValue & 0xFFu );
+  pstFrame->pBuffer[pstFrame->iLength++] = (uint8_t)( iValue >> 8u );
+  return true;
+}
+
+/**
+ * @brief  Add an uint8 to the frame.
+ * @param  pstFrame   Frame
+ * @param  cValue     Value
+ * @retval True if added, false if the frame is full.
+ */
+bool APP_ZIGBEE_FramePutUint8( APP_ZIGBEE_Frame_t * pstFrame, uint8_t cValue )
+{
+  if ( pstFrame->iLength == pstFrame->iSize )
+  {
+    return false;
+  }
+
+  pstFrame->pBuffer[pstFrame->iLength++] = cValue;
+  return true;
+}
+
+/**
+ * @brief  Send the frame as the ASDU of an APSDE-DATA.request, with the addressing and options of its cluster.
+ *         The APS copies it in the NWK buffer : the buffer of the frame can be reused on return.
+ *         No ZCL response is waited for : for the frames without response (reports, no default response).
+ * @param  pstFrame   Frame
+ * @param  pstDest    Destination, mode ZB_APSDE_ADDRMODE_NOTPRESENT for the binding table
+ * @param  callback   APSDE-DATA.confirm callback, may be NULL
+ * @param  arg        Argument of the callback
+ * @retval Status of the request.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_FrameSend( const APP_ZIGBEE_Frame_t * pstFrame, const struct ZbApsAddrT * pstDest,
+                                         void (*callback)(struct ZbApsdeDataConfT * pstConf, void * arg), void * arg )
+{
+  struct ZbApsdeDataReqT  stRequest;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst = *pstDest;
+  stRequest.profileId = ZbZclClusterGetProfileId( pstFrame->pstCluster );
+  stRequest.clusterId = (uint16_t)pstFrame->pstCluster->clusterId;
+  stRequest.srcEndpt = pstFrame->pstCluster->endpoint;
+  stRequest.asdu = pstFrame->pBuffer;
+  stRequest.asduLength = pstFrame->iLength;
+  stRequest.txOptions = pstFrame->pstCluster->txOptions;
+  stRequest.discoverRoute = APP_ZIGBEE_RouteUse( pstDest );
+  stRequest.radius = pstFrame->pstCluster->radius;
+
+  return ZbApsdeDataReqCallback( pstFrame->pstCluster->zb, &stRequest, callback, arg );
+}
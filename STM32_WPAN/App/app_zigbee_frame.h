@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_frame.h
+  * @author  MCD Application Team
+  * @brief   Interface of the ZCL frame builder : frames serialized in place in
+  *          their final buffer and given as is to the APS.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_FRAME_H
+#define APP_ZIGBEE_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zigbee.aps.h"
+#include "zcl/zcl.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Headroom of the ZCL header : Frame Control (1), Manufacturer Code (2), Sequence Number (1), Command Id (1) */
+#define APP_ZIGBEE_FRAME_HEADROOM           (5u)
+
+/* Exported types ------------------------------------------------------------*/
+/* Frame being built : ZCL header then payload, in the buffer of the caller */
+typedef struct
+{
+  struct ZbZclClusterT  * pstCluster;       /* Cluster sending the frame */
+  uint8_t               * pBuffer;          /* Final buffer of the frame (APS payload) */
+  uint16_t              iSize;              /* Size of the buffer */
+  uint16_t              iLength;            /* Length of the frame (header included) */
+} APP_ZIGBEE_Frame_t;
+
+/* Exported functions ------------------------------------------------------- */
+bool      APP_ZIGBEE_FrameStart             ( APP_ZIGBEE_Frame_t * pstFrame, uint8_t * pBuffer, uint16_t iSize,
+                                              struct ZbZclClusterT * pstCluster, struct ZbZclHeaderT * pstHeader );
+uint8_t * APP_ZIGBEE_FrameTail              ( APP_ZIGBEE_Frame_t * pstFrame, uint16_t * piRoom );
+void      APP_ZIGBEE_FrameCommit            ( APP_ZIGBEE_Frame_t * pstFrame, uint16_t iLength );
+bool      APP_ZIGBEE_FramePutUint16         ( APP_ZIGBEE_Frame_t * pstFrame, uint16_t iValue );
+bool      APP_ZIGBEE_FramePutUint8          ( APP_ZIGBEE_Frame_t * pstFrame, uint8_t cValue );
+
+enum ZbStatusCodeT APP_ZIGBEE_FrameSend     ( const APP_ZIGBEE_Frame_t * pstFrame, const struct ZbApsAddrT * pstDest,
+                                              void (*callback)(struct ZbApsdeDataConfT * pstConf, void * arg), void * arg );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_FRAME_H */
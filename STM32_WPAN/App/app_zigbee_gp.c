@@ -0,0 +1,435 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_gp.c
+  * @author  MCD Application Team
+  * @brief   Green Power proxy helper : the Proxy Basic of the stack (Green
+  *          Power Endpoint) is fed through a filter that drops the repeated GP
+  *          frames (same source and content within a window), and that keeps
+  *          a RAM cache of the paired GPD.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_gp.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zcl/zcl.h"
+#include "zgp/zgp.proxybasic.h"
+
+#if (CFG_ZIGBEE_GP_PROXY_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define GP_PROFILE_ID                   (0xA1E0u)     /* Green Power profile */
+#define GP_SEEN_MASK                    ( CFG_ZIGBEE_GP_DEDUP_SIZE - 1u )
+#define GP_SEEN_PROBES                  (4u)          /* Slots probed in the duplicates set */
+#define GP_GPD_NONE                     (0xFFFFu)
+
+#define GP_FNV_OFFSET                   (0x811C9DC5u)
+#define GP_FNV_PRIME                    (0x01000193u)
+
+#if ( ( CFG_ZIGBEE_GP_DEDUP_SIZE & GP_SEEN_MASK ) != 0 ) || ( CFG_ZIGBEE_GP_DEDUP_SIZE < GP_SEEN_PROBES )
+#error "CFG_ZIGBEE_GP_DEDUP_SIZE shall be a power of 2, at least 4"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t    lGpdId;                 /* SrcID, or folded IEEE address */
+  uint32_t    lLastTick;              /* Last GP frame of the GPD */
+  uint32_t    lNotifications;         /* GP Notifications of the GPD */
+  bool        bUsed;
+} GpPairedGpd_t;
+
+/* Private variables ---------------------------------------------------------*/
+static GpPairedGpd_t                astGpPairedGpd[CFG_ZIGBEE_GP_GPD_MAX];
+static uint32_t                     alGpSeenHash[CFG_ZIGBEE_GP_DEDUP_SIZE];
+static uint32_t                     alGpSeenTick[CFG_ZIGBEE_GP_DEDUP_SIZE];
+static APP_ZIGBEE_GpStats_t         stGpStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static enum zb_msg_filter_rc GpDataIndCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+static bool     GpIsDuplicate           ( uint32_t lHash );
+static bool     GpGetGpdId              ( uint16_t iOptions, const uint8_t * pPayload, uint16_t iLength, uint32_t * plGpdId );
+static uint16_t GpFindGpd               ( uint32_t lGpdId );
+static void     GpPairing               ( const uint8_t * pPayload, uint16_t iLength );
+static void     GpNotification          ( const uint8_t * pPayload, uint16_t iLength );
+static void     GpPrintStats            ( void );
+
+/* Serial commands of the Green Power proxy helper */
+static const SerialCmd_t            astGpSerialCmds[] =
+{
+  { "GPSTATS", GpPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stGpSerialCmdTable =
+{
+  astGpSerialCmds, ( sizeof( astGpSerialCmds ) / sizeof( astGpSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the helper : filter of the GP frames, before the Proxy Basic of the stack.
+ * @param  pstZigbee  Zigbee stack instance
+ * @retval None
+ */
+void APP_ZIGBEE_GpInit( struct ZigBeeT * pstZigbee )
+{
+  memset( astGpPairedGpd, 0, sizeof( astGpPairedGpd ) );
+  memset( alGpSeenTick, 0, sizeof( alGpSeenTick ) );
+
+  if ( ZbMsgFilterRegister( pstZigbee, ZB_MSG_FILTER_APSDE_DATA_IND, ( ZB_MSG_INTERNAL_PRIO + 1u ), GpDataIndCallback, NULL ) == NULL )
+  {
+    LOG_ERROR_APP( "Error, Green Power filter registration failed." );
+    return;
+  }
+
+  Serial_CMD_Interpreter_RegisterTable( &stGpSerialCmdTable );
+}
+
+/**
+ * @brief  Indicate if a GPD has been paired by a sink through this proxy (RAM cache of the GP Pairings).
+ * @param  lGpdId   GPD SrcID
+ * @retval True if paired.
+ */
+bool APP_ZIGBEE_GpIsPaired( uint32_t lGpdId )
+{
+  return ( GpFindGpd( lGpdId ) != GP_GPD_NONE );
+}
+
+/**
+ * @brief  Return the statistics of the helper.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_GpStats_t * APP_ZIGBEE_GpGetStats( void )
+{
+  uint16_t  iIndex;
+
+  stGpStats.iPairedGpd = 0;
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_GP_GPD_MAX; iIndex++ )
+  {
+    if ( astGpPairedGpd[iIndex].bUsed != false )
+    {
+      stGpStats.iPairedGpd++;
+    }
+  }
+
+  return &stGpStats;
+}
+
+/**
+ * @brief  APSDE-DATA.indication filter, before the stack : GP Notifications and GP Pairings of the Green Power
+ *         Endpoint. Such a frame already received from the same source within CFG_ZIGBEE_GP_DEDUP_WINDOW is dropped.
+ * @param  zb       Zigbee stack instance
+ * @param  lId      Message filter identifier
+ * @param  pMessage APSDE-DATA.indication
+ * @param  arg      Not used
+ * @retval ZB_MSG_DISCARD for a duplicate, else ZB_MSG_CONTINUE.
+ */
+static enum zb_msg_filter_rc GpDataIndCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbApsdeDataIndT  * pstIndication = (const struct ZbApsdeDataIndT *)pMessage;
+  struct ZbZclHeaderT             stHeader;
+  const uint8_t                 * pPayload;
+  uint16_t                        iLength, iIndex;
+  uint32_t                        lHash;
+  int                             iHeaderLength;
+  bool                            bNotification;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( ( lId != ZB_MSG_FILTER_APSDE_DATA_IND ) || ( pstIndication->dst.endpoint != ZB_ENDPOINT_GREENPOWER ) ||
+       ( pstIndication->clusterId != (uint16_t)ZCL_CLUSTER_GREEN_POWER ) || ( pstIndication->profileId != GP_PROFILE_ID ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  iHeaderLength = ZbZclParseHeader( &stHeader, pstIndication->asdu, pstIndication->asduLength );
+  if ( ( iHeaderLength <= 0 ) || ( stHeader.frameCtrl.frameType != ZCL_FRAMETYPE_CLUSTER ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  /* Only the GP Notifications (to the sinks) and the GP Pairings (from the sinks) */
+  bNotification = ( ( stHeader.cmdId == ZB_ZGP_GP_NOTIFICATION ) && ( stHeader.frameCtrl.direction == ZCL_DIRECTION_TO_SERVER ) );
+  if ( ( bNotification == false ) &&
+       ( ( stHeader.cmdId != ZB_ZGP_GP_PAIRING ) || ( stHeader.frameCtrl.direction != ZCL_DIRECTION_TO_CLIENT ) ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  pPayload = &pstIndication->asdu[iHeaderLength];
+  iLength = ( pstIndication->asduLength - (uint16_t)iHeaderLength );
+
+  /* Duplicate : same source, command and content (the ZCL sequence is not in the hash, repeats have a new one) */
+  lHash = GP_FNV_OFFSET;
+  lHash = ( lHash ^ ( pstIndication->src.nwkAddr & 0xFFu ) ) * GP_FNV_PRIME;
+  lHash = ( lHash ^ ( pstIndication->src.nwkAddr >> 8u ) ) * GP_FNV_PRIME;
+  lHash = ( lHash ^ stHeader.cmdId ) * GP_FNV_PRIME;
+  for ( iIndex = 0; iIndex < iLength; iIndex++ )
+  {
+    lHash = ( lHash ^ pPayload[iIndex] ) * GP_FNV_PRIME;
+  }
+
+  if ( GpIsDuplicate( lHash ) != false )
+  {
+    stGpStats.lDuplicates++;
+    return( ZB_MSG_DISCARD );
+  }
+
+  if ( bNotification != false )
+  {
+    GpNotification( pPayload, iLength );
+  }
+  else
+  {
+    GpPairing( pPayload, iLength );
+  }
+
+  return( ZB_MSG_CONTINUE );
+}
+
+/**
+ * @brief  Look for a GP frame in the duplicates set, and add it if not found (or older than the window).
+ * @param  lHash  Hash of the frame
+ * @retval True if the frame has been received within the window.
+ */
+static bool GpIsDuplicate( uint32_t lHash )
+{
+  uint32_t  lNow = HAL_GetTick();
+  uint32_t  lAge, lOldestAge = 0;
+  uint16_t  iProbe, iSlot, iVictim = 0;
+
+  for ( iProbe = 0; iProbe < GP_SEEN_PROBES; iProbe++ )
+  {
+    iSlot = (uint16_t)( ( lHash + iProbe ) & GP_SEEN_MASK );
+    lAge = ( lNow - alGpSeenTick[iSlot] );
+    if ( ( alGpSeenTick[iSlot] != 0u ) && ( lAge < CFG_ZIGBEE_GP_DEDUP_WINDOW ) && ( alGpSeenHash[iSlot] == lHash ) )
+    {
+      return true;
+    }
+
+    /* Replaced : a free slot, else the oldest one */
+    if ( alGpSeenTick[iSlot] == 0u )
+    {
+      lAge = UINT32_MAX;
+    }
+
+    if ( lAge >= lOldestAge )
+    {
+      lOldestAge = lAge;
+      iVictim = iSlot;
+    }
+  }
+
+  alGpSeenHash[iVictim] = lHash;
+  alGpSeenTick[iVictim] = ( ( lNow != 0u ) ? lNow : 1u );
+
+  return false;
+}
+
+/**
+ * @brief  Identifier of the GPD of a GP command : SrcID, or IEEE address folded on 32 bits.
+ * @param  iOptions   Options of the command (Application ID in the bits 0 to 2)
+ * @param  pPayload   GPD identifier in the command
+ * @param  iLength    Length left in the command
+ * @param  plGpdId    Identifier
+ * @retval True if the identifier is present.
+ */
+static bool GpGetGpdId( uint16_t iOptions, const uint8_t * pPayload, uint16_t iLength, uint32_t * plGpdId )
+{
+  uint32_t  lLow, lHigh;
+
+  if ( ( iOptions & ZGP_PT_APPLICATIONID ) == ZGP_PT_APPLICATIONID_IEEE )
+  {
+    if ( iLength < 8u )
+    {
+      return false;
+    }
+
+    lLow = ( (uint32_t)pPayload[0] | ( (uint32_t)pPayload[1] << 8u ) | ( (uint32_t)pPayload[2] << 16u ) | ( (uint32_t)pPayload[3] << 24u ) );
+    lHigh = ( (uint32_t)pPayload[4] | ( (uint32_t)pPayload[5] << 8u ) | ( (uint32_t)pPayload[6] << 16u ) | ( (uint32_t)pPayload[7] << 24u ) );
+    *plGpdId = ( lLow ^ lHigh );
+    return true;
+  }
+
+  if ( iLength < 4u )
+  {
+    return false;
+  }
+
+  *plGpdId = ( (uint32_t)pPayload[0] | ( (uint32_t)pPayload[1] << 8u ) | ( (uint32_t)pPayload[2] << 16u ) | ( (uint32_t)pPayload[3] << 24u ) );
+  return true;
+}
+
+/**
+ * @brief  Find a GPD in the paired GPD cache.
+ * @param  lGpdId   GPD identifier
+ * @retval Index of the GPD, GP_GPD_NONE if not found.
+ */
+static uint16_t GpFindGpd( uint32_t lGpdId )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_GP_GPD_MAX; iIndex++ )
+  {
+    if ( ( astGpPairedGpd[iIndex].bUsed != false ) && ( astGpPairedGpd[iIndex].lGpdId == lGpdId ) )
+    {
+      return iIndex;
+    }
+  }
+
+  return GP_GPD_NONE;
+}
+
+/**
+ * @brief  GP Pairing of a sink : the GPD is added to (or removed from) the cache.
+ * @param  pPayload   Payload of the command (Options on 24 bits, then the GPD identifier)
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void GpPairing( const uint8_t * pPayload, uint16_t iLength )
+{
+  uint32_t  lOptions, lGpdId;
+  uint16_t  iIndex;
+
+  stGpStats.lPairings++;
+  if ( iLength < 3u )
+  {
+    return;
+  }
+
+  lOptions = ( (uint32_t)pPayload[0] | ( (uint32_t)pPayload[1] << 8u ) | ( (uint32_t)pPayload[2] << 16u ) );
+  if ( GpGetGpdId( (uint16_t)lOptions, &pPayload[3], ( iLength - 3u ), &lGpdId ) == false )
+  {
+    return;
+  }
+
+  iIndex = GpFindGpd( lGpdId );
+  if ( ( lOptions & ZGP_PAIR_REMOVE_GPD ) != 0u )
+  {
+    if ( iIndex != GP_GPD_NONE )
+    {
+      astGpPairedGpd[iIndex].bUsed = false;
+    }
+    return;
+  }
+
+  if ( ( ( lOptions & ZGP_PAIR_ADD_SINK ) == 0u ) || ( iIndex != GP_GPD_NONE ) )
+  {
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_GP_GPD_MAX; iIndex++ )
+  {
+    if ( astGpPairedGpd[iIndex].bUsed == false )
+    {
+      astGpPairedGpd[iIndex].lGpdId = lGpdId;
+      astGpPairedGpd[iIndex].lLastTick = HAL_GetTick();
+      astGpPairedGpd[iIndex].lNotifications = 0;
+      astGpPairedGpd[iIndex].bUsed = true;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief  GP Notification of another proxy : activity of the GPD.
+ * @param  pPayload   Payload of the command (Options on 16 bits, then the GPD identifier)
+ * @param  iLength    Length of the payload
+ * @retval None
+ */
+static void GpNotification( const uint8_t * pPayload, uint16_t iLength )
+{
+  uint32_t  lGpdId;
+  uint16_t  iOptions, iIndex;
+
+  stGpStats.lNotifications++;
+  if ( iLength < 2u )
+  {
+    return;
+  }
+
+  iOptions = (uint16_t)( pPayload[0] | ( pPayload[1] << 8u ) );
+  if ( GpGetGpdId( iOptions, &pPayload[2], ( iLength - 2u ), &lGpdId ) == false )
+  {
+    return;
+  }
+
+  iIndex = GpFindGpd( lGpdId );
+  if ( iIndex != GP_GPD_NONE )
+  {
+    astGpPairedGpd[iIndex].lLastTick = HAL_GetTick();
+    astGpPairedGpd[iIndex].lNotifications++;
+  }
+}
+
+/**
+ * @brief  Print the paired GPD and the statistics of the helper.
+ * @param  None
+ * @retval None
+ */
+static void GpPrintStats( void )
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_GpStats_t  * pstStats = APP_ZIGBEE_GpGetStats();
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  uint16_t                      iIndex;
+
+  LOG_INFO_APP( "Green Power : %d notifications, %d pairings, %d duplicates dropped, %d GPD paired.",
+                pstStats->lNotifications, pstStats->lPairings, pstStats->lDuplicates, pstStats->iPairedGpd );
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_GP_GPD_MAX; iIndex++ )
+  {
+    if ( astGpPairedGpd[iIndex].bUsed != false )
+    {
+      LOG_INFO_APP( "  GPD 0x%08X : %d notifications, last %d ms ago", astGpPairedGpd[iIndex].lGpdId,
+                    astGpPairedGpd[iIndex].lNotifications, ( HAL_GetTick() - astGpPairedGpd[iIndex].lLastTick ) );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_GP_PROXY_SUPPORTED != 0) */
+
+/**
+ * @brief  Green Power proxy helper not supported.
+ */
+void APP_ZIGBEE_GpInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Green Power proxy helper not supported : no paired GPD known.
+ */
+bool APP_ZIGBEE_GpIsPaired( uint32_t lGpdId )
+{
+  UNUSED( lGpdId );
+
+  return false;
+}
+
+/**
+ * @brief  Green Power proxy helper not supported : no statistics.
+ */
+const APP_ZIGBEE_GpStats_t * APP_ZIGBEE_GpGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_GP_PROXY_SUPPORTED != 0) */
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_gp.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Green Power proxy helper (paired GPD cache and
+  *          duplicate GP frames filter).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_GP_H
+#define APP_ZIGBEE_GP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the Green Power proxy helper */
+typedef struct
+{
+  uint32_t    lNotifications;         /* GP Notifications received (from the other proxies) */
+  uint32_t    lPairings;              /* GP Pairings received (from the sinks) */
+  uint32_t    lDuplicates;            /* GP frames dropped as duplicates */
+  uint16_t    iPairedGpd;             /* GPD in the paired GPD cache */
+} APP_ZIGBEE_GpStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_GpInit                 ( struct ZigBeeT * pstZigbee );
+bool      APP_ZIGBEE_GpIsPaired             ( uint32_t lGpdId );
+
+const APP_ZIGBEE_GpStats_t * APP_ZIGBEE_GpGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_GP_H */
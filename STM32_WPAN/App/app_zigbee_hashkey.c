@@ -0,0 +1,423 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_hashkey.c
+  * @author  MCD Application Team
+  * @brief   Hashed Trust Center link keys : the link key of a device is derived
+  *          from a secret of the network and its EUI64 when it is needed, and
+  *          only the keys used recently are kept in the stack table.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_hashkey.h"
+#include "app_zigbee_tckey.h"
+#include "serial_cmd_interpreter.h"
+#include "zigbee.aps.h"
+#include "zigbee.nwk.h"
+#include "zigbee.hash.h"
+
+#if (CFG_ZIGBEE_HASHED_TCLK_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define HASHKEY_NO_ENTRY                (0xFFu)
+
+#if ( CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE >= HASHKEY_NO_ENTRY )
+#error "CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE shall be less than 255"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Device whose derived key is in the stack table */
+typedef struct
+{
+  uint64_t    dlExtAddr;              /* EUI64 of the device, 0 if free */
+  uint32_t    lLastUse;               /* Clock of the last use */
+} HashKeyEntry_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t                acHashKeyProductSecret[ZB_SEC_KEYSIZE] = CFG_ZIGBEE_HASHED_TCLK_SECRET;
+
+static uint8_t                      acHashKeySecret[ZB_SEC_KEYSIZE];    /* Secret of the network */
+static HashKeyEntry_t               astHashKeyCache[CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE];
+static uint32_t                     lHashKeyClock;
+static APP_ZIGBEE_HashKeyStats_t    stHashKeyStats;
+static struct ZbMsgFilterT *        pstHashKeyFilter;
+
+/* Private functions prototypes-----------------------------------------------*/
+static uint8_t  HashKeyFind             ( uint64_t dlExtAddr );
+static void     HashKeyCache            ( uint64_t dlExtAddr );
+static bool     HashKeyIssue            ( uint64_t dlExtAddr );
+static void     HashKeyRestore          ( uint64_t dlExtAddr );
+static void     HashKeyPrintStats       ( void );
+static enum zb_msg_filter_rc HashKeyFilterCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the hashed link keys */
+static const SerialCmd_t            astHashKeySerialCmds[] =
+{
+  { "HASHKEYSTATS", HashKeyPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stHashKeySerialCmdTable =
+{
+  astHashKeySerialCmds, ( sizeof( astHashKeySerialCmds ) / sizeof( astHashKeySerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the hashed link keys : empty cache.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_HashKeyInit( void )
+{
+  memset( astHashKeyCache, 0, sizeof( astHashKeyCache ) );
+  memset( &stHashKeyStats, 0, sizeof( stHashKeyStats ) );
+  lHashKeyClock = 0;
+
+  Serial_CMD_Interpreter_RegisterTable( &stHashKeySerialCmdTable );
+}
+
+/**
+ * @brief  Network formed (this device is the Trust Center) : secret of the network derived from the product secret
+ *         and the EUI64 of the Trust Center, then the TC link key requests and the rejoins are watched.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_HashKeyStart( void )
+{
+  struct ZbHash   stHash;
+  uint64_t        dlExtAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  uint8_t         acExtAddr[8], cIndex;
+
+  for ( cIndex = 0; cIndex < 8u; cIndex++ )
+  {
+    acExtAddr[cIndex] = (uint8_t)( dlExtAddr >> ( 8u * cIndex ) );
+  }
+
+  ZbHmacInit( &stHash, acHashKeyProductSecret, ZB_SEC_KEYSIZE );
+  ZbHmacAdd( &stHash, acExtAddr, sizeof( acExtAddr ) );
+  ZbHmacDigest( &stHash, acHashKeySecret );
+
+  if ( pstHashKeyFilter == NULL )
+  {
+    /* Before the stack : the key of a device is in the table when the stack needs it */
+    pstHashKeyFilter = ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ( ZB_MSG_FILTER_JOIN_IND | ZB_MSG_FILTER_APS_COMMAND_IND ),
+                                            ( ZB_MSG_INTERNAL_PRIO + 1u ), HashKeyFilterCallback, NULL );
+  }
+}
+
+/**
+ * @brief  Derive the TC link key of a device : HMAC (AES-MMO) of its EUI64 with the secret of the network.
+ * @param  dlExtAddr  EUI64 of the device
+ * @param  pcKey      Link key derived (ZB_SEC_KEYSIZE bytes)
+ * @retval None
+ */
+void APP_ZIGBEE_HashKeyDerive( uint64_t dlExtAddr, uint8_t * pcKey )
+{
+  struct ZbHash   stHash;
+  uint8_t         acExtAddr[8], cIndex;
+
+  for ( cIndex = 0; cIndex < 8u; cIndex++ )
+  {
+    acExtAddr[cIndex] = (uint8_t)( dlExtAddr >> ( 8u * cIndex ) );
+  }
+
+  ZbHmacInit( &stHash, acHashKeySecret, ZB_SEC_KEYSIZE );
+  ZbHmacAdd( &stHash, acExtAddr, sizeof( acExtAddr ) );
+  ZbHmacDigest( &stHash, pcKey );
+}
+
+/**
+ * @brief  Return the statistics of the hashed link keys.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_HashKeyStats_t * APP_ZIGBEE_HashKeyGetStats( void )
+{
+  return &stHashKeyStats;
+}
+
+/**
+ * @brief  Find a device in the cache.
+ * @param  dlExtAddr  EUI64 of the device
+ * @retval Entry, or HASHKEY_NO_ENTRY if not cached.
+ */
+static uint8_t HashKeyFind( uint64_t dlExtAddr )
+{
+  uint8_t   cIndex;
+
+  for ( cIndex = 0; cIndex < CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE; cIndex++ )
+  {
+    if ( astHashKeyCache[cIndex].dlExtAddr == dlExtAddr )
+    {
+      return cIndex;
+    }
+  }
+
+  return HASHKEY_NO_ENTRY;
+}
+
+/**
+ * @brief  Mark the key of a device as used. When the cache is full, the key least recently used is removed from the
+ *         stack table : it is derived again at the next rejoin of its device.
+ * @param  dlExtAddr  EUI64 of the device
+ * @retval None
+ */
+static void HashKeyCache( uint64_t dlExtAddr )
+{
+  struct ZbApsmeRemoveKeyReqT   stRemoveReq;
+  struct ZbApsmeRemoveKeyConfT  stRemoveConf;
+  uint8_t                       cIndex, cEntry;
+
+  cEntry = HashKeyFind( dlExtAddr );
+  if ( cEntry == HASHKEY_NO_ENTRY )
+  {
+    cEntry = 0;
+    for ( cIndex = 0; cIndex < CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE; cIndex++ )
+    {
+      if ( astHashKeyCache[cIndex].dlExtAddr == 0u )
+      {
+        cEntry = cIndex;
+        break;
+      }
+      if ( astHashKeyCache[cIndex].lLastUse < astHashKeyCache[cEntry].lLastUse )
+      {
+        cEntry = cIndex;
+      }
+    }
+
+    if ( astHashKeyCache[cEntry].dlExtAddr != 0u )
+    {
+      memset( &stRemoveReq, 0, sizeof( stRemoveReq ) );
+      stRemoveReq.keyType = ZB_SEC_KEYTYPE_TC_LINK;
+      stRemoveReq.partnerAddr = astHashKeyCache[cEntry].dlExtAddr;
+      ZbApsmeRemoveKeyReq( stZigbeeAppInfo.pstZigbee, &stRemoveReq, &stRemoveConf );
+      stHashKeyStats.lEvicted++;
+    }
+    else
+    {
+      stHashKeyStats.iCached++;
+    }
+    astHashKeyCache[cEntry].dlExtAddr = dlExtAddr;
+  }
+  else
+  {
+    stHashKeyStats.lHits++;
+  }
+
+  astHashKeyCache[cEntry].lLastUse = ++lHashKeyClock;
+}
+
+/**
+ * @brief  TC link key request of a device : its derived key is added (unverified, the shared key is still used
+ *         until its Verify Key) and sent to it, in place of a random key of the stack.
+ * @param  dlExtAddr  EUI64 of the device
+ * @retval True if the key is sent, else false (request left to the stack).
+ */
+static bool HashKeyIssue( uint64_t dlExtAddr )
+{
+  struct ZbApsmeAddKeyReqT        stAddKeyReq;
+  struct ZbApsmeAddKeyConfT       stAddKeyConf;
+  struct ZbApsmeTransportKeyReqT  stTransportReq;
+
+  memset( &stAddKeyReq, 0, sizeof( stAddKeyReq ) );
+  memset( &stAddKeyConf, 0, sizeof( stAddKeyConf ) );
+  stAddKeyReq.keyType = ZB_SEC_KEYTYPE_TC_LINK;
+  stAddKeyReq.keyAttribute = ( ZB_APSME_KEY_ATTR_UNVERIFIED | ZB_APSME_KEY_ATTR_TCLK_DERIVED );
+  stAddKeyReq.partnerAddr = dlExtAddr;
+  APP_ZIGBEE_HashKeyDerive( dlExtAddr, stAddKeyReq.key );
+
+  ZbApsmeAddKeyReq( stZigbeeAppInfo.pstZigbee, &stAddKeyReq, &stAddKeyConf );
+  if ( stAddKeyConf.status != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error Add hashed Link Key of " LOG_DISPLAY64() " (0x%02X)", LOG_NUMBER64( dlExtAddr ), stAddKeyConf.status );
+    return false;
+  }
+
+  memset( &stTransportReq, 0, sizeof( stTransportReq ) );
+  stTransportReq.dst.mode = ZB_APSDE_ADDRMODE_EXT;
+  stTransportReq.dst.extAddr = dlExtAddr;
+  stTransportReq.keyType = ZB_SEC_KEYTYPE_TC_LINK;
+  memcpy( stTransportReq.keyinfo.trustKey.key, stAddKeyReq.key, ZB_SEC_KEYSIZE );
+  ZbApsmeTransportKeyReq( stZigbeeAppInfo.pstZigbee, &stTransportReq );
+
+  APP_ZIGBEE_TcKeyAdded( dlExtAddr );
+  HashKeyCache( dlExtAddr );
+  stHashKeyStats.lIssued++;
+
+  return true;
+}
+
+/**
+ * @brief  Trust Center rejoin of a device : without key in the stack table (evicted), its key is derived again.
+ * @param  dlExtAddr  EUI64 of the device
+ * @retval None
+ */
+static void HashKeyRestore( uint64_t dlExtAddr )
+{
+  struct ZbApsmeAddKeyReqT    stAddKeyReq;
+  struct ZbApsmeAddKeyConfT   stAddKeyConf;
+
+  if ( HashKeyFind( dlExtAddr ) != HASHKEY_NO_ENTRY )
+  {
+    HashKeyCache( dlExtAddr );
+    return;
+  }
+
+  /* Key of its own (install code, ...) or not a device of this Trust Center */
+  if ( APP_ZIGBEE_TcKeyLookup( dlExtAddr, NULL ) != false )
+  {
+    return;
+  }
+
+  memset( &stAddKeyReq, 0, sizeof( stAddKeyReq ) );
+  memset( &stAddKeyConf, 0, sizeof( stAddKeyConf ) );
+  stAddKeyReq.keyType = ZB_SEC_KEYTYPE_TC_LINK;
+  stAddKeyReq.keyAttribute = ZB_APSME_KEY_ATTR_VERIFIED;
+  stAddKeyReq.partnerAddr = dlExtAddr;
+  APP_ZIGBEE_HashKeyDerive( dlExtAddr, stAddKeyReq.key );
+
+  ZbApsmeAddKeyReq( stZigbeeAppInfo.pstZigbee, &stAddKeyReq, &stAddKeyConf );
+  if ( stAddKeyConf.status == ZB_STATUS_SUCCESS )
+  {
+    APP_ZIGBEE_TcKeyAdded( dlExtAddr );
+    HashKeyCache( dlExtAddr );
+    stHashKeyStats.lRestored++;
+  }
+}
+
+/**
+ * @brief  Join indications and APS commands, before the stack : TC link key requests answered with the derived key,
+ *         key of the devices rejoining through the Trust Center derived again if evicted.
+ * @param  zb         Zigbee stack instance
+ * @param  lId        Message
+ * @param  pMessage   Join indication or APS command
+ * @param  arg        Not used
+ * @retval ZB_MSG_DISCARD if the TC link key request is answered, else ZB_MSG_CONTINUE.
+ */
+static enum zb_msg_filter_rc HashKeyFilterCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbNlmeJoinIndT   * pstJoin;
+  const struct ZbMsgApsCommandT * pstCommand;
+  uint32_t                        lTcPolicy = 0;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( lId == ZB_MSG_FILTER_JOIN_IND )
+  {
+    /* Trust Center rejoin of a child of the Trust Center */
+    pstJoin = (const struct ZbNlmeJoinIndT *)pMessage;
+    if ( ( pstJoin->rejoinNetwork == ZB_NWK_REJOIN_TYPE_NWKREJOIN ) && ( pstJoin->secureRejoin == false ) )
+    {
+      HashKeyRestore( pstJoin->extAddr );
+    }
+    return ZB_MSG_CONTINUE;
+  }
+
+  if ( lId != ZB_MSG_FILTER_APS_COMMAND_IND )
+  {
+    return ZB_MSG_CONTINUE;
+  }
+
+  pstCommand = (const struct ZbMsgApsCommandT *)pMessage;
+  switch ( pstCommand->id )
+  {
+    case ZB_APS_CMD_REQUEST_KEY:
+      if ( pstCommand->data.request_key.keyType != ZB_APS_REQKEY_KEYTYPE_TC_LINK )
+      {
+        break;
+      }
+
+      /* Requests answered only if the Trust Center policy allows them */
+      ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_TRUST_CENTER_POLICY, &lTcPolicy, sizeof( lTcPolicy ) );
+      if ( ( ( lTcPolicy & ZB_APSME_POLICY_TC_KEY_REQ_MASK ) != 0u ) &&
+           ( HashKeyIssue( pstCommand->data.request_key.srcExtAddr ) != false ) )
+      {
+        return ZB_MSG_DISCARD;
+      }
+      break;
+
+    case ZB_APS_CMD_UPDATE_DEVICE:
+      /* Trust Center rejoin through a Router */
+      if ( pstCommand->data.update_device.status == ZB_APSME_DEV_STD_INSECURE_REJOIN )
+      {
+        HashKeyRestore( pstCommand->data.update_device.devExtAddr );
+      }
+      break;
+
+    case ZB_APS_CMD_VERIFY_KEY:
+      if ( HashKeyFind( pstCommand->data.verify_key.srcExtAddr ) != HASHKEY_NO_ENTRY )
+      {
+        HashKeyCache( pstCommand->data.verify_key.srcExtAddr );
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Print the statistics of the hashed link keys.
+ * @param  None
+ * @retval None
+ */
+static void HashKeyPrintStats( void )
+{
+  LOG_INFO_APP( "Hashed TC link keys : %d cached of %d, %d hits.", stHashKeyStats.iCached, CFG_ZIGBEE_HASHED_TCLK_CACHE_SIZE,
+                stHashKeyStats.lHits );
+  LOG_INFO_APP( "  %d issued, %d restored, %d evicted.", stHashKeyStats.lIssued, stHashKeyStats.lRestored, stHashKeyStats.lEvicted );
+}
+
+#else /* (CFG_ZIGBEE_HASHED_TCLK_SUPPORTED != 0) */
+
+/**
+ * @brief  Hashed TC link keys not supported.
+ */
+void APP_ZIGBEE_HashKeyInit( void )
+{
+}
+
+/**
+ * @brief  Hashed TC link keys not supported : keys of the stack.
+ */
+void APP_ZIGBEE_HashKeyStart( void )
+{
+}
+
+/**
+ * @brief  Hashed TC link keys not supported : no key.
+ */
+void APP_ZIGBEE_HashKeyDerive( uint64_t dlExtAddr, uint8_t * pcKey )
+{
+  UNUSED( dlExtAddr );
+
+  memset( pcKey, 0, ZB_SEC_KEYSIZE );
+}
+
+/**
+ * @brief  Hashed TC link keys not supported : no statistics.
+ */
+const APP_ZIGBEE_HashKeyStats_t * APP_ZIGBEE_HashKeyGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_HASHED_TCLK_SUPPORTED != 0) */
@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_hashkey.h
+  * @author  MCD Application Team
+  * @brief   Interface of the hashed Trust Center link keys.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_HASHKEY_H
+#define APP_ZIGBEE_HASHKEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the hashed link keys */
+typedef struct
+{
+  uint32_t    lIssued;                /* Keys derived and sent on a TC link key request */
+  uint32_t    lRestored;              /* Keys derived again for the rejoin of a device not cached */
+  uint32_t    lEvicted;               /* Keys removed from the stack table (least recently used) */
+  uint32_t    lHits;                  /* Devices found in the cache */
+  uint16_t    iCached;                /* Keys in the cache */
+} APP_ZIGBEE_HashKeyStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_HashKeyInit            ( void );
+void      APP_ZIGBEE_HashKeyStart           ( void );
+void      APP_ZIGBEE_HashKeyDerive          ( uint64_t dlExtAddr, uint8_t * pcKey );
+
+const APP_ZIGBEE_HashKeyStats_t * APP_ZIGBEE_HashKeyGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_HASHKEY_H */
@@ -0,0 +1,476 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_health.c
+  * @author  MCD Application Team
+  * @brief   Router health sampler : reads periodically the Neighbor and Route
+  *          tables and the APS counters, a few entries per Task run, and keeps
+  *          a short LQI/cost trend of each neighbor.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_health.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.aps.h"
+
+#if (CFG_ZIGBEE_HEALTH_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define HEALTH_ENTRIES_PER_TASK         (8u)        /* Table entries read per Task run, to not hold the Sequencer */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  HEALTH_PHASE_IDLE = 0,
+  HEALTH_PHASE_NEIGHBORS,
+  HEALTH_PHASE_ROUTES,
+} HealthPhase_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_HealthNeighbor_t  astHealthNeighbor[CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX];
+static bool                         abHealthSeen[CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX];
+static uint8_t                      acHealthRoutes[CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX];
+
+static APP_ZIGBEE_HealthSummary_t   stHealthSummary, stHealthSample;
+static struct ZbApsStatTableT       stHealthApsStats;
+static bool                         bHealthApsStatsValid;
+
+static HealthPhase_t                eHealthPhase;
+static uint16_t                     iHealthIndex;
+static UTIL_TIMER_Object_t          stHealthTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     HealthTask              ( void );
+static void     HealthTimerElapsed      ( void * arg );
+static bool     HealthReadNeighbor      ( uint16_t iIndex );
+static bool     HealthReadRoute         ( uint16_t iIndex );
+static void     HealthSampleEnd         ( void );
+static uint16_t HealthFindNeighbor      ( uint64_t dlExtendedAddress, uint16_t iShortAddress );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the health sampler : Task and Timer of the samples.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_HealthInit( void )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX; iIndex++ )
+  {
+    astHealthNeighbor[iIndex].iShortAddress = ZB_NWK_ADDR_UNDEFINED;
+  }
+
+  UTIL_TIMER_Create( &stHealthTimer, CFG_ZIGBEE_HEALTH_PERIOD, UTIL_TIMER_PERIODIC, &HealthTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_HEALTH ), UTIL_SEQ_TASK_DEFERRABLE, HealthTask );
+}
+
+/**
+ * @brief  Start the periodic samples (once on the Network). A first sample is done now.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_HealthStart( void )
+{
+  UTIL_TIMER_Start( &stHealthTimer );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_HEALTH ), TASK_PRIO_ZIGBEE_HEALTH );
+}
+
+/**
+ * @brief  Summary of the last sample.
+ * @param  None
+ * @retval Summary
+ */
+const APP_ZIGBEE_HealthSummary_t * APP_ZIGBEE_HealthGetSummary( void )
+{
+  return &stHealthSummary;
+}
+
+/**
+ * @brief  Health of a tracked neighbor.
+ * @param  iIndex   Index of the entry (from 0 to CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX - 1)
+ * @retval Neighbor, NULL if the entry is free.
+ */
+const APP_ZIGBEE_HealthNeighbor_t * APP_ZIGBEE_HealthGetNeighbor( uint16_t iIndex )
+{
+  if ( ( iIndex >= CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX ) || ( astHealthNeighbor[iIndex].iShortAddress == ZB_NWK_ADDR_UNDEFINED ) )
+  {
+    return NULL;
+  }
+
+  return &astHealthNeighbor[iIndex];
+}
+
+/**
+ * @brief  Health Task : read the next entries of the tables, then close the sample.
+ * @param  None
+ * @retval None
+ */
+static void HealthTask( void )
+{
+  uint16_t  iRead;
+
+  if ( eHealthPhase == HEALTH_PHASE_IDLE )
+  {
+    memset( abHealthSeen, 0, sizeof( abHealthSeen ) );
+    memset( acHealthRoutes, 0, sizeof( acHealthRoutes ) );
+    memset( &stHealthSample, 0, sizeof( stHealthSample ) );
+    eHealthPhase = HEALTH_PHASE_NEIGHBORS;
+    iHealthIndex = 0;
+  }
+
+  for ( iRead = 0; iRead < HEALTH_ENTRIES_PER_TASK; iRead++ )
+  {
+    if ( eHealthPhase == HEALTH_PHASE_NEIGHBORS )
+    {
+      if ( HealthReadNeighbor( iHealthIndex ) == false )
+      {
+        eHealthPhase = HEALTH_PHASE_ROUTES;
+        iHealthIndex = 0;
+        continue;
+      }
+    }
+    else
+    {
+      if ( HealthReadRoute( iHealthIndex ) == false )
+      {
+        HealthSampleEnd();
+        return;
+      }
+    }
+
+    iHealthIndex++;
+  }
+
+  /* Next entries on the next run */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_HEALTH ), TASK_PRIO_ZIGBEE_HEALTH );
+}
+
+/**
+ * @brief  Callback triggered when the period between two samples expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void HealthTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  /* A sample still ongoing is not restarted */
+  if ( eHealthPhase == HEALTH_PHASE_IDLE )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_HEALTH ), TASK_PRIO_ZIGBEE_HEALTH );
+  }
+}
+
+/**
+ * @brief  Read one entry of the Neighbor table and add it to the trend of this neighbor.
+ * @param  iIndex   Index in the table
+ * @retval False at the end of the table.
+ */
+static bool HealthReadNeighbor( uint16_t iIndex )
+{
+  struct ZbNwkNeighborT         stNeighbor;
+  APP_ZIGBEE_HealthNeighbor_t   * pstHealth;
+  uint16_t                      iEntry;
+
+  if ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) != ZB_STATUS_SUCCESS )
+  {
+    return false;
+  }
+
+  if ( stNeighbor.nwkAddr == ZB_NWK_ADDR_UNDEFINED )
+  {
+    return true;
+  }
+
+  stHealthSample.iNeighborNb++;
+  iEntry = HealthFindNeighbor( stNeighbor.extAddr, stNeighbor.nwkAddr );
+  if ( iEntry == CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX )
+  {
+    stHealthSample.iNeighborUntracked++;
+    return true;
+  }
+
+  pstHealth = &astHealthNeighbor[iEntry];
+  if ( pstHealth->iShortAddress == ZB_NWK_ADDR_UNDEFINED )
+  {
+    memset( pstHealth, 0, sizeof( APP_ZIGBEE_HealthNeighbor_t ) );
+  }
+
+  pstHealth->dlExtendedAddress = stNeighbor.extAddr;
+  pstHealth->iShortAddress = stNeighbor.nwkAddr;
+  pstHealth->cDeviceType = (uint8_t)stNeighbor.deviceType;
+  pstHealth->cRelationship = (uint8_t)stNeighbor.relationship;
+  pstHealth->cTxFailure = stNeighbor.txFailure;
+
+  pstHealth->acLqi[pstHealth->cSampleNext] = stNeighbor.lqi;
+  pstHealth->acCost[pstHealth->cSampleNext] = stNeighbor.outgoingCost;
+  pstHealth->cSampleNext = (uint8_t)( ( pstHealth->cSampleNext + 1u ) % CFG_ZIGBEE_HEALTH_TREND_DEPTH );
+  if ( pstHealth->cSampleNb < CFG_ZIGBEE_HEALTH_TREND_DEPTH )
+  {
+    pstHealth->cSampleNb++;
+  }
+
+  abHealthSeen[iEntry] = true;
+
+  return true;
+}
+
+/**
+ * @brief  Read one entry of the Route table and count it on its next hop.
+ * @param  iIndex   Index in the table
+ * @retval False at the end of the table.
+ */
+static bool HealthReadRoute( uint16_t iIndex )
+{
+  struct ZbNwkRouteEntryT   stRoute;
+  uint16_t                  iEntry;
+
+  if ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_RouteTable, &stRoute, sizeof( stRoute ), iIndex ) != ZB_STATUS_SUCCESS )
+  {
+    return false;
+  }
+
+  if ( stRoute.destAddr == ZB_NWK_ADDR_UNDEFINED )
+  {
+    return true;
+  }
+
+  stHealthSample.iRouteNb++;
+  if ( stRoute.status == ZB_NWK_ROUTE_STATUS_DISCOVERY_FAILED )
+  {
+    stHealthSample.iRouteFailed++;
+  }
+  else if ( stRoute.status == ZB_NWK_ROUTE_STATUS_ACTIVE )
+  {
+    stHealthSample.iRouteActive++;
+    for ( iEntry = 0; iEntry < CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX; iEntry++ )
+    {
+      if ( ( abHealthSeen[iEntry] != false ) && ( astHealthNeighbor[iEntry].iShortAddress == stRoute.nextAddr ) )
+      {
+        if ( acHealthRoutes[iEntry] < UINT8_MAX )
+        {
+          acHealthRoutes[iEntry]++;
+        }
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief  End of a sample : free the neighbors gone, and compute the APS counters since the previous sample.
+ * @param  None
+ * @retval None
+ */
+static void HealthSampleEnd( void )
+{
+  struct ZbApsStatTableT    stApsStats;
+  uint16_t                  iEntry;
+
+  for ( iEntry = 0; iEntry < CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX; iEntry++ )
+  {
+    if ( abHealthSeen[iEntry] == false )
+    {
+      astHealthNeighbor[iEntry].iShortAddress = ZB_NWK_ADDR_UNDEFINED;
+    }
+    else
+    {
+      astHealthNeighbor[iEntry].cRoutes = acHealthRoutes[iEntry];
+    }
+  }
+
+  if ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) == ZB_STATUS_SUCCESS )
+  {
+    if ( bHealthApsStatsValid != false )
+    {
+      stHealthSample.iApsTxSuccess = (uint16_t)( stApsStats.aps_tx_ucast_success - stHealthApsStats.aps_tx_ucast_success );
+      stHealthSample.iApsTxRetry = (uint16_t)( stApsStats.aps_tx_ucast_retry - stHealthApsStats.aps_tx_ucast_retry );
+      stHealthSample.iApsTxFail = (uint16_t)( stApsStats.aps_tx_ucast_fail - stHealthApsStats.aps_tx_ucast_fail );
+      stHealthSample.iMacTxRetry = (uint16_t)( stApsStats.mac_tx_ucast_retry - stHealthApsStats.mac_tx_ucast_retry );
+      stHealthSample.iMacTxFail = (uint16_t)( stApsStats.mac_tx_ucast_fail - stHealthApsStats.mac_tx_ucast_fail );
+    }
+    stHealthApsStats = stApsStats;
+    bHealthApsStatsValid = true;
+  }
+
+  stHealthSample.lSampleNb = ( stHealthSummary.lSampleNb + 1u );
+  stHealthSummary = stHealthSample;
+  eHealthPhase = HEALTH_PHASE_IDLE;
+}
+
+/**
+ * @brief  Find the entry of a neighbor (by its Extended address when known), or a free entry.
+ * @param  dlExtendedAddress  Extended address (0 if unknown)
+ * @param  iShortAddress      Short address
+ * @retval Index of the entry, CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX if none.
+ */
+static uint16_t HealthFindNeighbor( uint64_t dlExtendedAddress, uint16_t iShortAddress )
+{
+  uint16_t  iEntry, iFree = CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX;
+
+  for ( iEntry = 0; iEntry < CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX; iEntry++ )
+  {
+    if ( astHealthNeighbor[iEntry].iShortAddress == ZB_NWK_ADDR_UNDEFINED )
+    {
+      if ( iFree == CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX )
+      {
+        iFree = iEntry;
+      }
+    }
+    else if ( ( dlExtendedAddress != 0u ) ? ( astHealthNeighbor[iEntry].dlExtendedAddress == dlExtendedAddress ) :
+                                            ( astHealthNeighbor[iEntry].iShortAddress == iShortAddress ) )
+    {
+      return iEntry;
+    }
+  }
+
+  return iFree;
+}
+
+/**
+ * @brief  Print the summary of the last sample and, if requested, the trend of each neighbor (oldest sample first).
+ * @param  bNeighbors   True to print the neighbors
+ * @retval None
+ */
+void APP_ZIGBEE_HealthPrint( bool bNeighbors )
+{
+  const APP_ZIGBEE_HealthNeighbor_t   * pstHealth;
+  char      szLqi[( CFG_ZIGBEE_HEALTH_TREND_DEPTH * 4u ) + 1u];
+  char      szCost[( CFG_ZIGBEE_HEALTH_TREND_DEPTH * 4u ) + 1u];
+  uint16_t  iEntry;
+  uint8_t   cSample, cIndex;
+
+  LOG_INFO_APP( "Health (sample %d, every %d ms) : %d neighbors (%d not tracked), %d routes (%d active, %d failed).",
+                stHealthSummary.lSampleNb, CFG_ZIGBEE_HEALTH_PERIOD, stHealthSummary.iNeighborNb, stHealthSummary.iNeighborUntracked,
+                stHealthSummary.iRouteNb, stHealthSummary.iRouteActive, stHealthSummary.iRouteFailed );
+  LOG_INFO_APP( "Health last period : APS unicast %d confirmed / %d retries / %d failed, MAC unicast %d retries / %d failed.",
+                stHealthSummary.iApsTxSuccess, stHealthSummary.iApsTxRetry, stHealthSummary.iApsTxFail,
+                stHealthSummary.iMacTxRetry, stHealthSummary.iMacTxFail );
+
+  if ( bNeighbors == false )
+  {
+    return;
+  }
+
+  for ( iEntry = 0; iEntry < CFG_ZIGBEE_HEALTH_NEIGHBOR_MAX; iEntry++ )
+  {
+    pstHealth = APP_ZIGBEE_HealthGetNeighbor( iEntry );
+    if ( pstHealth == NULL )
+    {
+      continue;
+    }
+
+    szLqi[0] = '\0';
+    szCost[0] = '\0';
+    for ( cSample = 0; cSample < pstHealth->cSampleNb; cSample++ )
+    {
+      cIndex = (uint8_t)( ( pstHealth->cSampleNext + CFG_ZIGBEE_HEALTH_TREND_DEPTH - pstHealth->cSampleNb + cSample ) % CFG_ZIGBEE_HEALTH_TREND_DEPTH );
+      (void)snprintf( &szLqi[strlen( szLqi )], ( sizeof( szLqi ) - strlen( szLqi ) ), " %d", pstHealth->acLqi[cIndex] );
+      (void)snprintf( &szCost[strlen( szCost )], ( sizeof( szCost ) - strlen( szCost ) ), " %d", pstHealth->acCost[cIndex] );
+    }
+
+    LOG_INFO_APP( "  0x%04X ( " LOG_DISPLAY64() " ) type %d rel %d : %d tx failures, %d routes, LQI%s, cost%s",
+                  pstHealth->iShortAddress, LOG_NUMBER64( pstHealth->dlExtendedAddress ), pstHealth->cDeviceType,
+                  pstHealth->cRelationship, pstHealth->cTxFailure, pstHealth->cRoutes, szLqi, szCost );
+  }
+}
+
+/**
+ * @brief  Health serial commands : HEALTH (summary) and HEALTHNBR (summary and neighbors).
+ * @param  szCommand  Command received
+ * @retval True if the command is a health command.
+ */
+bool APP_ZIGBEE_HealthSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "HEALTH" ) == 0 )
+  {
+    APP_ZIGBEE_HealthPrint( false );
+  }
+  else if ( strcmp( szCommand, "HEALTHNBR" ) == 0 )
+  {
+    APP_ZIGBEE_HealthPrint( true );
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_HEALTH_SUPPORTED != 0) */
+
+/**
+ * @brief  Health sampler not supported.
+ */
+void APP_ZIGBEE_HealthInit( void )
+{
+}
+
+/**
+ * @brief  Health sampler not supported.
+ */
+void APP_ZIGBEE_HealthStart( void )
+{
+}
+
+/**
+ * @brief  Health sampler not supported.
+ */
+void APP_ZIGBEE_HealthPrint( bool bNeighbors )
+{
+  UNUSED( bNeighbors );
+}
+
+/**
+ * @brief  Health sampler not supported : no command.
+ */
+bool APP_ZIGBEE_HealthSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Health sampler not supported : no summary.
+ */
+const APP_ZIGBEE_HealthSummary_t * APP_ZIGBEE_HealthGetSummary( void )
+{
+  return NULL;
+}
+
+/**
+ * @brief  Health sampler not supported : no neighbor.
+ */
+const APP_ZIGBEE_HealthNeighbor_t * APP_ZIGBEE_HealthGetNeighbor( uint16_t iIndex )
+{
+  UNUSED( iIndex );
+
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_HEALTH_SUPPORTED != 0) */
@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_health.h
+  * @author  MCD Application Team
+  * @brief   Interface of the router health sampler (neighbors, routes, APS counters).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_HEALTH_H
+#define APP_ZIGBEE_HEALTH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Health of one neighbor, with the trend of its last samples */
+typedef struct
+{
+  uint64_t    dlExtendedAddress;                          /* Extended address (0 if unknown) */
+  uint16_t    iShortAddress;                              /* Short address, ZB_NWK_ADDR_UNDEFINED if the entry is free */
+  uint8_t     cDeviceType;                                /* enum ZbNwkNeighborTypeT */
+  uint8_t     cRelationship;                              /* enum ZbNwkNeighborRelT */
+  uint8_t     cTxFailure;                                 /* Last transmit failure count */
+  uint8_t     cRoutes;                                    /* Number of active routes using it as next hop */
+  uint8_t     cSampleNb;                                  /* Number of samples in the trend (at most CFG_ZIGBEE_HEALTH_TREND_DEPTH) */
+  uint8_t     cSampleNext;                                /* Next sample written in the trend */
+  uint8_t     acLqi[CFG_ZIGBEE_HEALTH_TREND_DEPTH];       /* Trend of the average LQI */
+  uint8_t     acCost[CFG_ZIGBEE_HEALTH_TREND_DEPTH];      /* Trend of the outgoing cost */
+} APP_ZIGBEE_HealthNeighbor_t;
+
+/* Summary of the last sample */
+typedef struct
+{
+  uint32_t    lSampleNb;                                  /* Number of samples done */
+  uint16_t    iNeighborNb;                                /* Neighbors in the table */
+  uint16_t    iNeighborUntracked;                         /* Neighbors not tracked (no free entry) */
+  uint16_t    iRouteNb;                                   /* Routes in the table */
+  uint16_t    iRouteActive;                               /* Active routes */
+  uint16_t    iRouteFailed;                               /* Routes with a failed discovery */
+  uint16_t    iApsTxSuccess;                              /* APS unicasts confirmed since the previous sample */
+  uint16_t    iApsTxRetry;                                /* APS unicast retries since the previous sample */
+  uint16_t    iApsTxFail;                                 /* APS unicasts failed since the previous sample */
+  uint16_t    iMacTxRetry;                                /* MAC unicast retries since the previous sample */
+  uint16_t    iMacTxFail;                                 /* MAC unicasts failed since the previous sample */
+} APP_ZIGBEE_HealthSummary_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_HealthInit             ( void );
+void      APP_ZIGBEE_HealthStart            ( void );
+void      APP_ZIGBEE_HealthPrint            ( bool bNeighbors );
+bool      APP_ZIGBEE_HealthSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_HealthSummary_t * APP_ZIGBEE_HealthGetSummary ( void );
+const APP_ZIGBEE_HealthNeighbor_t * APP_ZIGBEE_HealthGetNeighbor ( uint16_t iIndex );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_HEALTH_H */
@@ -0,0 +1,452 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_indirect.c
+  * @author  MCD Application Team
+  * @brief   Indirect transmission manager of the router : the frames held
+  *          for the sleepy children until they poll are bounded per child
+  *          (stack queue, and admission of the frames of the application),
+  *          the low priority ones being refused first to a child that lets
+  *          its frames expire. The expiries and capacity failures are
+  *          counted per child.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_indirect.h"
+#include "app_zigbee_addr.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_INDIRECT_SUPPORTED != 0)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t    iNwkAddr;               /* ZB_NWK_ADDR_UNDEFINED when free */
+  bool        bSleepy;
+  bool        bSeen;                  /* Found at the last scan of the Neighbor table */
+  uint8_t     cPending;               /* Frames of the application admitted, not yet confirmed */
+  uint8_t     cPendingMax;
+  uint16_t    iExpiredTick;           /* Expiries during the current tick */
+  uint32_t    lExpired;
+  uint32_t    lNoCapacity;
+  uint32_t    lRefused;
+} IndirectChild_t;
+
+/* Private variables ---------------------------------------------------------*/
+static IndirectChild_t              astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX];
+static bool                         abIndirectCongested[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX];  /* Expiry during the last tick */
+static APP_ZIGBEE_IndirectStats_t   stIndirectStats;
+static struct ZigBeeT             * pstIndirectZigbee;
+static struct ZbTimerT            * pstIndirectTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static IndirectChild_t * IndirectFindChild ( const struct ZbApsAddrT * pstDest );
+static IndirectChild_t * IndirectLookup    ( uint16_t iNwkAddr );
+static void     IndirectConfigure       ( void );
+static void     IndirectTimerCallback   ( struct ZigBeeT * zb, void * arg );
+static void     IndirectPrintStats      ( void );
+
+static enum zb_msg_filter_rc IndirectStatusCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the indirect transmission manager */
+static const SerialCmd_t            astIndirectSerialCmds[] =
+{
+  { "INDIRECTSTATS", IndirectPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stIndirectSerialCmdTable =
+{
+  astIndirectSerialCmds, ( sizeof( astIndirectSerialCmds ) / sizeof( astIndirectSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the indirect transmission manager : no child, NLME-NWK-STATUS.indications listened to, Timer of
+ *         the scan of the children.
+ * @param  pstZigbee  Zigbee stack instance
+ * @retval None
+ */
+void APP_ZIGBEE_IndirectInit( struct ZigBeeT * pstZigbee )
+{
+  uint16_t  iIndex;
+
+  memset( astIndirectChild, 0, sizeof( astIndirectChild ) );
+  memset( abIndirectCongested, 0, sizeof( abIndirectCongested ) );
+  memset( &stIndirectStats, 0, sizeof( stIndirectStats ) );
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_INDIRECT_CHILDREN_MAX; iIndex++ )
+  {
+    astIndirectChild[iIndex].iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+  }
+  pstIndirectZigbee = pstZigbee;
+
+  pstIndirectTimer = ZbTimerAlloc( pstZigbee, IndirectTimerCallback, NULL );
+  if ( ( pstIndirectTimer == NULL ) ||
+       ( ZbMsgFilterRegister( pstZigbee, ZB_MSG_FILTER_STATUS_IND, ( ZB_MSG_INTERNAL_PRIO + 1u ), IndirectStatusCallback, NULL ) == NULL ) )
+  {
+    LOG_ERROR_APP( "Error, Indirect manager registration failed." );
+    return;
+  }
+
+  IndirectConfigure();
+  ZbTimerReset( pstIndirectTimer, CFG_ZIGBEE_INDIRECT_TICK );
+  Serial_CMD_Interpreter_RegisterTable( &stIndirectSerialCmdTable );
+}
+
+/**
+ * @brief  Admission of a frame of the application : to a sleepy child, at most CFG_ZIGBEE_INDIRECT_CHILD_FRAMES
+ *         frames are held at the same time (half for the low priority ones, none after an expiry of the child during
+ *         the last tick). An admitted frame is released by APP_ZIGBEE_IndirectRelease at its confirmation.
+ * @param  pstDest        Destination of the frame
+ * @param  bLowPriority   True for a frame that can be dropped first
+ * @retval True if the frame can be sent.
+ */
+bool APP_ZIGBEE_IndirectAdmit( const struct ZbApsAddrT * pstDest, bool bLowPriority )
+{
+  IndirectChild_t   * pstChild;
+  uint8_t           cLimit = CFG_ZIGBEE_INDIRECT_CHILD_FRAMES;
+
+  pstChild = IndirectFindChild( pstDest );
+  if ( pstChild == NULL )
+  {
+    return true;
+  }
+
+  if ( bLowPriority != false )
+  {
+    cLimit = ( abIndirectCongested[pstChild - astIndirectChild] != false ) ? 0u : ( ( cLimit + 1u ) / 2u );
+  }
+
+  if ( pstChild->cPending >= cLimit )
+  {
+    pstChild->lRefused++;
+    stIndirectStats.lRefused++;
+    return false;
+  }
+
+  pstChild->cPending++;
+  if ( pstChild->cPending > pstChild->cPendingMax )
+  {
+    pstChild->cPendingMax = pstChild->cPending;
+  }
+
+  stIndirectStats.lAdmitted++;
+  stIndirectStats.iPending++;
+  if ( stIndirectStats.iPending > stIndirectStats.iPendingMax )
+  {
+    stIndirectStats.iPendingMax = stIndirectStats.iPending;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Confirmation (or failure) of a frame admitted by APP_ZIGBEE_IndirectAdmit.
+ * @param  pstDest    Destination of the frame
+ * @retval None
+ */
+void APP_ZIGBEE_IndirectRelease( const struct ZbApsAddrT * pstDest )
+{
+  IndirectChild_t   * pstChild;
+
+  pstChild = IndirectFindChild( pstDest );
+  if ( ( pstChild != NULL ) && ( pstChild->cPending != 0u ) )
+  {
+    pstChild->cPending--;
+    stIndirectStats.iPending--;
+  }
+}
+
+/**
+ * @brief  Return the statistics of the indirect transmission manager.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_IndirectStats_t * APP_ZIGBEE_IndirectGetStats( void )
+{
+  return &stIndirectStats;
+}
+
+/**
+ * @brief  Sleepy child of a destination.
+ * @param  pstDest    Destination
+ * @retval Child, NULL if the destination is not a sleepy child.
+ */
+static IndirectChild_t * IndirectFindChild( const struct ZbApsAddrT * pstDest )
+{
+  IndirectChild_t   * pstChild;
+  uint16_t          iNwkAddr;
+
+  if ( pstDest->mode == ZB_APSDE_ADDRMODE_SHORT )
+  {
+    iNwkAddr = pstDest->nwkAddr;
+  }
+  else if ( pstDest->mode == ZB_APSDE_ADDRMODE_EXT )
+  {
+    iNwkAddr = APP_ZIGBEE_AddrLookupNwk( pstDest->extAddr );
+  }
+  else
+  {
+    return NULL;
+  }
+
+  pstChild = IndirectLookup( iNwkAddr );
+  if ( ( pstChild == NULL ) || ( pstChild->bSleepy == false ) )
+  {
+    return NULL;
+  }
+
+  return pstChild;
+}
+
+/**
+ * @brief  Child of a short address.
+ * @param  iNwkAddr   Short address
+ * @retval Child, NULL if not a child.
+ */
+static IndirectChild_t * IndirectLookup( uint16_t iNwkAddr )
+{
+  IndirectChild_t   * pstChild;
+
+  if ( iNwkAddr >= ZB_NWK_ADDR_BCAST_MIN )
+  {
+    return NULL;
+  }
+
+  for ( pstChild = astIndirectChild; pstChild < &astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX]; pstChild++ )
+  {
+    if ( pstChild->iNwkAddr == iNwkAddr )
+    {
+      return pstChild;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Limits of the stack queue of the sleepy children : frames per child, and persistence if configured.
+ * @param  None
+ * @retval None
+ */
+static void IndirectConfigure( void )
+{
+  uint8_t   cValue;
+
+  cValue = CFG_ZIGBEE_INDIRECT_CHILD_FRAMES;
+  if ( ZbNwkSet( pstIndirectZigbee, ZB_NWK_NIB_ID_SedMaxMcpsData, &cValue, sizeof( cValue ) ) != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, Indirect frames per child not set." );
+  }
+
+#if (CFG_ZIGBEE_INDIRECT_PERSISTENCE != 0)
+  cValue = CFG_ZIGBEE_INDIRECT_PERSISTENCE;
+  if ( ZbNwkSet( pstIndirectZigbee, ZB_NWK_NIB_ID_TransactionPersistenceTime, &cValue, sizeof( cValue ) ) != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, Indirect persistence not set." );
+  }
+#endif /* (CFG_ZIGBEE_INDIRECT_PERSISTENCE != 0) */
+}
+
+/**
+ * @brief  Tick of the manager : children (and their sleepy state) from the Neighbor table, the ones gone being freed,
+ *         and the congestion of each child (expiry during the tick).
+ * @param  zb   Zigbee stack instance
+ * @param  arg  Not used
+ * @retval None
+ */
+static void IndirectTimerCallback( struct ZigBeeT * zb, void * arg )
+{
+  struct ZbNwkNeighborT   stNeighbor;
+  IndirectChild_t         * pstChild, * pstFree;
+  uint16_t                iIndex;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  for ( pstChild = astIndirectChild; pstChild < &astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX]; pstChild++ )
+  {
+    pstChild->bSeen = false;
+  }
+
+  stIndirectStats.iChildren = 0;
+  stIndirectStats.iSleepyChildren = 0;
+  for ( iIndex = 0; ZbNwkGetIndex( pstIndirectZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( ( stNeighbor.nwkAddr == ZB_NWK_ADDR_UNDEFINED ) || ( stNeighbor.relationship != ZB_NWK_NEIGHBOR_REL_CHILD ) )
+    {
+      continue;
+    }
+
+    stIndirectStats.iChildren++;
+    pstChild = IndirectLookup( stNeighbor.nwkAddr );
+    if ( pstChild == NULL )
+    {
+      for ( pstFree = astIndirectChild; pstFree < &astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX]; pstFree++ )
+      {
+        if ( pstFree->iNwkAddr == ZB_NWK_ADDR_UNDEFINED )
+        {
+          break;
+        }
+      }
+      if ( pstFree == &astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX] )
+      {
+        continue;
+      }
+
+      pstChild = pstFree;
+      memset( pstChild, 0, sizeof( IndirectChild_t ) );
+      pstChild->iNwkAddr = stNeighbor.nwkAddr;
+    }
+
+    pstChild->bSeen = true;
+    pstChild->bSleepy = ( ( stNeighbor.capability & MCP_ASSOC_CAP_RXONIDLE ) == 0u );
+    if ( pstChild->bSleepy != false )
+    {
+      stIndirectStats.iSleepyChildren++;
+    }
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_INDIRECT_CHILDREN_MAX; iIndex++ )
+  {
+    pstChild = &astIndirectChild[iIndex];
+    if ( ( pstChild->iNwkAddr != ZB_NWK_ADDR_UNDEFINED ) && ( pstChild->bSeen == false ) )
+    {
+      /* Child gone : its frames are not confirmed any more */
+      stIndirectStats.iPending -= pstChild->cPending;
+      pstChild->iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+    }
+
+    abIndirectCongested[iIndex] = ( pstChild->iExpiredTick != 0u );
+    pstChild->iExpiredTick = 0;
+  }
+
+  ZbTimerReset( pstIndirectTimer, CFG_ZIGBEE_INDIRECT_TICK );
+}
+
+/**
+ * @brief  NLME-NWK-STATUS.indication : expiries and capacity failures of the indirect frames, per child.
+ * @param  zb         Zigbee stack instance
+ * @param  lId        Message
+ * @param  pMessage   NLME-NWK-STATUS.indication
+ * @param  arg        Not used
+ * @retval ZB_MSG_CONTINUE, the indication is always given to the stack.
+ */
+static enum zb_msg_filter_rc IndirectStatusCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbNlmeNetworkStatusIndT  * pstIndication = (const struct ZbNlmeNetworkStatusIndT *)pMessage;
+  IndirectChild_t                       * pstChild;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( lId != ZB_MSG_FILTER_STATUS_IND )
+  {
+    return ZB_MSG_CONTINUE;
+  }
+
+  pstChild = IndirectLookup( pstIndication->shortAddr );
+  if ( pstIndication->status == ZB_NWK_STATUS_CODE_INDIRECT_EXPIRY )
+  {
+    stIndirectStats.lExpired++;
+    if ( pstChild != NULL )
+    {
+      pstChild->lExpired++;
+      if ( pstChild->iExpiredTick < UINT16_MAX )
+      {
+        pstChild->iExpiredTick++;
+      }
+      abIndirectCongested[pstChild - astIndirectChild] = true;
+    }
+  }
+  else if ( pstIndication->status == ZB_NWK_STATUS_CODE_NO_INDIRECT_CAPACITY )
+  {
+    stIndirectStats.lNoCapacity++;
+    if ( pstChild != NULL )
+    {
+      pstChild->lNoCapacity++;
+    }
+  }
+
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Print the statistics and the sleepy children with frames held, expired or refused.
+ * @param  None
+ * @retval None
+ */
+static void IndirectPrintStats( void )
+{
+  const IndirectChild_t   * pstChild;
+
+  LOG_INFO_APP( "Indirect : %d children (%d sleepy), %d frames held (max %d), limit %d per child.", stIndirectStats.iChildren,
+                stIndirectStats.iSleepyChildren, stIndirectStats.iPending, stIndirectStats.iPendingMax, CFG_ZIGBEE_INDIRECT_CHILD_FRAMES );
+  LOG_INFO_APP( "  %d admitted, %d refused, %d expired, %d without capacity.", stIndirectStats.lAdmitted, stIndirectStats.lRefused,
+                stIndirectStats.lExpired, stIndirectStats.lNoCapacity );
+
+  for ( pstChild = astIndirectChild; pstChild < &astIndirectChild[CFG_ZIGBEE_INDIRECT_CHILDREN_MAX]; pstChild++ )
+  {
+    if ( ( pstChild->iNwkAddr != ZB_NWK_ADDR_UNDEFINED ) && ( pstChild->bSleepy != false ) &&
+         ( ( pstChild->cPendingMax != 0u ) || ( pstChild->lExpired != 0u ) || ( pstChild->lNoCapacity != 0u ) ) )
+    {
+      LOG_INFO_APP( "  0x%04X : %d held (max %d), %d expired, %d without capacity, %d refused.", pstChild->iNwkAddr,
+                    pstChild->cPending, pstChild->cPendingMax, pstChild->lExpired, pstChild->lNoCapacity, pstChild->lRefused );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_INDIRECT_SUPPORTED != 0) */
+
+/**
+ * @brief  Indirect transmission manager not supported.
+ */
+void APP_ZIGBEE_IndirectInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Indirect transmission manager not supported : always admitted.
+ */
+bool APP_ZIGBEE_IndirectAdmit( const struct ZbApsAddrT * pstDest, bool bLowPriority )
+{
+  UNUSED( pstDest );
+  UNUSED( bLowPriority );
+  return true;
+}
+
+/**
+ * @brief  Indirect transmission manager not supported.
+ */
+void APP_ZIGBEE_IndirectRelease( const struct ZbApsAddrT * pstDest )
+{
+  UNUSED( pstDest );
+}
+
+/**
+ * @brief  Indirect transmission manager not supported : no statistics.
+ */
+const APP_ZIGBEE_IndirectStats_t * APP_ZIGBEE_IndirectGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_INDIRECT_SUPPORTED != 0) */
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_indirect.h
+  * @author  MCD Application Team
+  * @brief   Interface of the indirect transmission manager (frames held for
+  *          the sleepy children).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_INDIRECT_H
+#define APP_ZIGBEE_INDIRECT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the indirect transmission manager */
+typedef struct
+{
+  uint16_t    iChildren;              /* Children at the last tick */
+  uint16_t    iSleepyChildren;        /* Sleepy children at the last tick */
+  uint16_t    iPending;               /* Frames of the application held for the sleepy children */
+  uint16_t    iPendingMax;            /* Most frames held at the same time */
+  uint32_t    lAdmitted;              /* Frames to a sleepy child admitted */
+  uint32_t    lRefused;               /* Frames to a sleepy child refused (limit, or expiry for the low priority) */
+  uint32_t    lExpired;               /* Frames expired before the poll of the child (NLME-NWK-STATUS) */
+  uint32_t    lNoCapacity;            /* Frames refused by the stack for lack of indirect capacity */
+} APP_ZIGBEE_IndirectStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_IndirectInit           ( struct ZigBeeT * pstZigbee );
+bool      APP_ZIGBEE_IndirectAdmit          ( const struct ZbApsAddrT * pstDest, bool bLowPriority );
+void      APP_ZIGBEE_IndirectRelease        ( const struct ZbApsAddrT * pstDest );
+
+const APP_ZIGBEE_IndirectStats_t * APP_ZIGBEE_IndirectGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_INDIRECT_H */
@@ -0,0 +1,336 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_latency.c
+  * @author  MCD Application Team
+  * @brief   Measure the end-to-end latency of the ZCL requests : time from the
+  *          submission to the completion (ZCL response, or APS confirmation for
+  *          the groups and broadcasts), with an histogram per destination.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_latency.h"
+#include "timer_if.h"
+
+#if (CFG_ZIGBEE_LATENCY_SUPPORTED != 0)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Request waiting for its completion */
+typedef struct
+{
+  bool                bUsed;
+  bool                bMeasured;
+  uint64_t            dlSubmitUs;             /* Microseconds time base, the HAL tick stops in Stop modes */
+  uint16_t            iStatsIndex;
+  void                (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg);
+  void *              arg;
+} LatencyPending_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_LatencyStats_t    astLatencyStats[CFG_ZIGBEE_LATENCY_DEST_MAX];
+static LatencyPending_t             astLatencyPending[CFG_ZIGBEE_LATENCY_PENDING_MAX];
+static uint16_t                     iLatencyStatsNb;
+static uint32_t                     lLatencyUntracked;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     LatencyRspCallback      ( struct ZbZclCommandRspT * pstRsp, void * arg );
+static uint16_t LatencyFindStats        ( const struct ZbApsAddrT * pstDest );
+static uint8_t  LatencyGetBucket        ( uint32_t lLatency );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Send a ZCL request and measure its latency. The request is sent without measure when its destination
+ *         table or the pending table is full.
+ * @param  pfRequest    Request of the command (ZbZclOnOffClientToggleReq, ...)
+ * @param  pstCluster   Client cluster sending the command
+ * @param  pstDest      Destination
+ * @param  callback     Callback of the request (can be NULL)
+ * @param  arg          Argument of the callback
+ * @retval Status of the request.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_LatencyRequest( APP_ZIGBEE_LatencyRequest_t pfRequest, struct ZbZclClusterT * pstCluster,
+                                               const struct ZbApsAddrT * pstDest,
+                                               void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg )
+{
+  uint16_t              iIndex, iStatsIndex;
+  enum ZclStatusCodeT   eStatus;
+  LatencyPending_t    * pstPending = NULL;
+
+  iStatsIndex = LatencyFindStats( pstDest );
+  for ( iIndex = 0; ( iIndex < CFG_ZIGBEE_LATENCY_PENDING_MAX ) && ( iStatsIndex < CFG_ZIGBEE_LATENCY_DEST_MAX ); iIndex++ )
+  {
+    if ( astLatencyPending[iIndex].bUsed == false )
+    {
+      pstPending = &astLatencyPending[iIndex];
+      break;
+    }
+  }
+
+  if ( pstPending == NULL )
+  {
+    lLatencyUntracked++;
+    return pfRequest( pstCluster, pstDest, callback, arg );
+  }
+
+  pstPending->bUsed = true;
+  pstPending->bMeasured = true;
+  pstPending->iStatsIndex = iStatsIndex;
+  pstPending->callback = callback;
+  pstPending->arg = arg;
+  pstPending->dlSubmitUs = TIMER_IF_GetTimeUs();
+
+  eStatus = pfRequest( pstCluster, pstDest, LatencyRspCallback, pstPending );
+  if ( eStatus != ZCL_STATUS_SUCCESS )
+  {
+    /* Not sent : the callback is never called */
+    pstPending->bUsed = false;
+  }
+
+  return eStatus;
+}
+
+/**
+ * @brief  Completion of a measured request : update the statistics of its destination, then call the callback
+ *         of the request.
+ * @param  pstRsp   ZCL command response
+ * @param  arg      Pending request
+ * @retval None
+ */
+static void LatencyRspCallback( struct ZbZclCommandRspT * pstRsp, void * arg )
+{
+  LatencyPending_t          * pstPending = (LatencyPending_t *)arg;
+  APP_ZIGBEE_LatencyStats_t * pstStats;
+  uint32_t                  lLatency;
+
+  lLatency = (uint32_t)( ( TIMER_IF_GetTimeUs() - pstPending->dlSubmitUs ) / 1000u );
+  pstStats = &astLatencyStats[pstPending->iStatsIndex];
+  pstPending->bUsed = false;
+
+  /* Statistics cleared since the submission : not counted */
+  if ( pstPending->bMeasured != false )
+  {
+    if ( ( lLatency < pstStats->lMin ) || ( pstStats->lNumber == 0u ) )
+    {
+      pstStats->lMin = lLatency;
+    }
+    if ( lLatency > pstStats->lMax )
+    {
+      pstStats->lMax = lLatency;
+    }
+    pstStats->lSum += lLatency;
+    pstStats->lNumber++;
+    pstStats->alBucket[LatencyGetBucket( lLatency )]++;
+
+    if ( ( pstRsp->aps_status != ZB_STATUS_SUCCESS ) || ( pstRsp->status != ZCL_STATUS_SUCCESS ) )
+    {
+      pstStats->lFailures++;
+    }
+  }
+
+  if ( pstPending->callback != NULL )
+  {
+    pstPending->callback( pstRsp, pstPending->arg );
+  }
+}
+
+/**
+ * @brief  Find the statistics of a destination, or allocate them.
+ * @param  pstDest  Destination
+ * @retval Index of the statistics, CFG_ZIGBEE_LATENCY_DEST_MAX if the table is full.
+ */
+static uint16_t LatencyFindStats( const struct ZbApsAddrT * pstDest )
+{
+  uint16_t            iIndex;
+  struct ZbApsAddrT * pstKnown;
+
+  for ( iIndex = 0; iIndex < iLatencyStatsNb; iIndex++ )
+  {
+    pstKnown = &astLatencyStats[iIndex].stDest;
+    if ( ( pstKnown->mode == pstDest->mode ) && ( pstKnown->endpoint == pstDest->endpoint ) &&
+         ( ( ( pstDest->mode == ZB_APSDE_ADDRMODE_EXT ) && ( pstKnown->extAddr == pstDest->extAddr ) ) ||
+           ( ( pstDest->mode != ZB_APSDE_ADDRMODE_EXT ) && ( pstKnown->nwkAddr == pstDest->nwkAddr ) ) ) )
+    {
+      return iIndex;
+    }
+  }
+
+  if ( iLatencyStatsNb < CFG_ZIGBEE_LATENCY_DEST_MAX )
+  {
+    memset( &astLatencyStats[iLatencyStatsNb], 0, sizeof( APP_ZIGBEE_LatencyStats_t ) );
+    astLatencyStats[iLatencyStatsNb].stDest = *pstDest;
+    iLatencyStatsNb++;
+  }
+
+  return iIndex;
+}
+
+/**
+ * @brief  Histogram bucket of a latency : 0 below 1 ms, then n for [2^(n-1), 2^n[ ms.
+ * @param  lLatency   Latency (in ms)
+ * @retval Bucket index
+ */
+static uint8_t LatencyGetBucket( uint32_t lLatency )
+{
+  uint8_t   cBucket = 0;
+
+  while ( ( lLatency != 0u ) && ( cBucket < ( APP_ZIGBEE_LATENCY_BUCKET_NB - 1u ) ) )
+  {
+    lLatency >>= 1;
+    cBucket++;
+  }
+
+  return cBucket;
+}
+
+/**
+ * @brief  Statistics of a destination.
+ * @param  iIndex   Index of the destination (from 0, in the order of the first request)
+ * @retval Statistics, NULL if no destination at this index.
+ */
+const APP_ZIGBEE_LatencyStats_t * APP_ZIGBEE_LatencyGetStats( uint16_t iIndex )
+{
+  if ( iIndex >= iLatencyStatsNb )
+  {
+    return NULL;
+  }
+
+  return &astLatencyStats[iIndex];
+}
+
+/**
+ * @brief  Percentile of the latencies, from the histogram : upper bound of the bucket holding it.
+ * @param  pstStats   Statistics of a destination
+ * @param  cPercent   Percentile (50, 90, 99, ...)
+ * @retval Latency (in ms) below which cPercent % of the requests completed.
+ */
+uint32_t APP_ZIGBEE_LatencyGetPercentile( const APP_ZIGBEE_LatencyStats_t * pstStats, uint8_t cPercent )
+{
+  uint32_t  lRank, lCount = 0, lBound;
+  uint8_t   cBucket;
+
+  if ( pstStats->lNumber == 0u )
+  {
+    return 0;
+  }
+
+  lRank = ( ( pstStats->lNumber * cPercent ) + 99u ) / 100u;
+  for ( cBucket = 0; cBucket < ( APP_ZIGBEE_LATENCY_BUCKET_NB - 1u ); cBucket++ )
+  {
+    lCount += pstStats->alBucket[cBucket];
+    if ( lCount >= lRank )
+    {
+      break;
+    }
+  }
+
+  lBound = ( 1uL << cBucket );
+  if ( ( lBound > pstStats->lMax ) || ( cBucket == ( APP_ZIGBEE_LATENCY_BUCKET_NB - 1u ) ) )
+  {
+    lBound = pstStats->lMax;
+  }
+
+  return lBound;
+}
+
+/**
+ * @brief  Clear all the statistics. The requests still pending are not counted.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_LatencyReset( void )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_LATENCY_PENDING_MAX; iIndex++ )
+  {
+    astLatencyPending[iIndex].bMeasured = false;
+  }
+
+  memset( astLatencyStats, 0, sizeof( astLatencyStats ) );
+  iLatencyStatsNb = 0;
+  lLatencyUntracked = 0;
+}
+
+/**
+ * @brief  Print the latency statistics of each destination (LATSTATS serial command).
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_LatencyPrintStats( void )
+{
+  uint16_t                          iIndex;
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_LatencyStats_t   * pstStats;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_APP( "ZCL latency : %d destinations, %d requests not measured.", iLatencyStatsNb, lLatencyUntracked );
+  for ( iIndex = 0; iIndex < iLatencyStatsNb; iIndex++ )
+  {
+#if (CFG_LOG_SUPPORTED != 0)
+    pstStats = &astLatencyStats[iIndex];
+    LOG_INFO_APP( "  Dest mode %d 0x%04X/%d : %d requests (%d failed), min %d / avg %d / max %d ms, p50 %d / p90 %d / p99 %d ms",
+                  pstStats->stDest.mode, pstStats->stDest.nwkAddr, pstStats->stDest.endpoint, pstStats->lNumber,
+                  pstStats->lFailures, pstStats->lMin, ( pstStats->lNumber != 0u ) ? ( pstStats->lSum / pstStats->lNumber ) : 0u,
+                  pstStats->lMax, APP_ZIGBEE_LatencyGetPercentile( pstStats, 50u ), APP_ZIGBEE_LatencyGetPercentile( pstStats, 90u ),
+                  APP_ZIGBEE_LatencyGetPercentile( pstStats, 99u ) );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  }
+}
+
+#else /* (CFG_ZIGBEE_LATENCY_SUPPORTED != 0) */
+
+/**
+ * @brief  Latency measure not supported : send the request.
+ */
+enum ZclStatusCodeT APP_ZIGBEE_LatencyRequest( APP_ZIGBEE_LatencyRequest_t pfRequest, struct ZbZclClusterT * pstCluster,
+                                               const struct ZbApsAddrT * pstDest,
+                                               void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg )
+{
+  return pfRequest( pstCluster, pstDest, callback, arg );
+}
+
+/**
+ * @brief  Latency measure not supported : no statistics.
+ */
+const APP_ZIGBEE_LatencyStats_t * APP_ZIGBEE_LatencyGetStats( uint16_t iIndex )
+{
+  return NULL;
+}
+
+/**
+ * @brief  Latency measure not supported : no percentile.
+ */
+uint32_t APP_ZIGBEE_LatencyGetPercentile( const APP_ZIGBEE_LatencyStats_t * pstStats, uint8_t cPercent )
+{
+  return 0;
+}
+
+/**
+ * @brief  Latency measure not supported : nothing to clear.
+ */
+void APP_ZIGBEE_LatencyReset( void )
+{
+}
+
+/**
+ * @brief  Latency measure not supported : nothing to print.
+ */
+void APP_ZIGBEE_LatencyPrintStats( void )
+{
+}
+
+#endif /* (CFG_ZIGBEE_LATENCY_SUPPORTED != 0) */
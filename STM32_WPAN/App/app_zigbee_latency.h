@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_latency.h
+  * @author  MCD Application Team
+  * @brief   Interface to measure the end-to-end latency of the ZCL requests.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_LATENCY_H
+#define APP_ZIGBEE_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define APP_ZIGBEE_LATENCY_BUCKET_NB      (16u)     /* Histogram buckets : < 1 ms, < 2 ms, < 4 ms, ... , >= 16 s */
+
+/* Exported types ------------------------------------------------------------*/
+/* ZCL client request, with the prototype of ZbZclOnOffClientToggleReq, ZbZclOnOffClientOnReq, ... */
+typedef enum ZclStatusCodeT ( * APP_ZIGBEE_LatencyRequest_t )( struct ZbZclClusterT * pstCluster, const struct ZbApsAddrT * pstDest,
+                                                               void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg );
+
+/* Latency statistics of one destination */
+typedef struct
+{
+  struct ZbApsAddrT   stDest;                                       /* Destination */
+  uint32_t            lNumber;                                      /* Number of completed requests */
+  uint32_t            lFailures;                                    /* Number of requests completed with an APS or ZCL error */
+  uint32_t            lMin;                                         /* Lowest latency (in ms) */
+  uint32_t            lMax;                                         /* Highest latency (in ms) */
+  uint32_t            lSum;                                         /* Sum of the latencies (in ms) */
+  uint32_t            alBucket[APP_ZIGBEE_LATENCY_BUCKET_NB];       /* Histogram of the latencies */
+} APP_ZIGBEE_LatencyStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+enum ZclStatusCodeT APP_ZIGBEE_LatencyRequest       ( APP_ZIGBEE_LatencyRequest_t pfRequest, struct ZbZclClusterT * pstCluster,
+                                                      const struct ZbApsAddrT * pstDest,
+                                                      void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg );
+const APP_ZIGBEE_LatencyStats_t * APP_ZIGBEE_LatencyGetStats ( uint16_t iIndex );
+uint32_t  APP_ZIGBEE_LatencyGetPercentile   ( const APP_ZIGBEE_LatencyStats_t * pstStats, uint8_t cPercent );
+void      APP_ZIGBEE_LatencyReset           ( void );
+void      APP_ZIGBEE_LatencyPrintStats      ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_LATENCY_H */
@@ -0,0 +1,934 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_level.c
+  * @author  MCD Application Team
+  * @brief   Level Control Server of the dimmer : the level drives a TIM1 PWM
+  *          through a gamma table (one channel, or R, G, B weighted by the
+  *          color). The transitions are played by an engine : their frames
+  *          are computed by batches ahead of time, and written in the compare
+  *          registers by the DMA at the update events of the timer, its
+  *          repetition counter holding each frame for several periods. The
+  *          CPU is woken once per batch only.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "main.h"
+#include "app_zigbee_level.h"
+#include "app_zigbee_batch.h"
+
+#include "stm32_lpm.h"
+#include "serial_cmd_interpreter.h"
+
+#include "zcl/general/zcl.level.h"
+
+#if (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define LEVEL_PWM_TIMER                 TIM1
+#define LEVEL_PWM_CHANNEL( x )          ( TIM_CHANNEL_1 + ( 4u * (x) ) )   /* CH1, then CH2 and CH3 for the color */
+#define LEVEL_PWM_DMA_CHANNEL           GPDMA1_Channel6
+#define LEVEL_PWM_DMA_REQUEST           GPDMA1_REQUEST_TIM1_UP
+
+#if (CFG_ZIGBEE_COLOR_SUPPORTED != 0)
+#define LEVEL_PWM_GPIO_PINS             CFG_ZIGBEE_COLOR_PWM_GPIO_PINS
+#else /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
+#define LEVEL_PWM_GPIO_PINS             CFG_ZIGBEE_LEVEL_PWM_GPIO_PIN
+#endif /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
+
+#define LEVEL_WEIGHT_FULL               ( 1UL << 16u )              /* Weight of a channel at full scale */
+#define LEVEL_REPEAT_MAX                ( TIM_RCR_REP_Msk + 1u )    /* PWM periods of a frame */
+#define LEVEL_TRANSITION_DEFAULT        (0xFFFFu)                   /* Transition time 'use OnOffTransitionTime' */
+#define LEVEL_RATE_DEFAULT              (0xFFu)                     /* Rate 'use DefaultMoveRate' */
+
+/* Private variables ---------------------------------------------------------*/
+/* Level (0 to ZCL_LEVEL_MAXIMUM_LEVEL) to full scale pulse, gamma 2.2 */
+static const uint16_t               aiLevelGamma[ZCL_LEVEL_MAXIMUM_LEVEL + 1u] =
+{
+      0,     0,     2,     4,     7,    12,    17,    24,    33,    42,    53,    66,
+     79,    95,   112,   130,   150,   171,   194,   218,   244,   272,   301,   332,
+    365,   399,   435,   473,   512,   553,   596,   641,   687,   735,   785,   837,
+    891,   946,  1003,  1062,  1123,  1186,  1250,  1317,  1385,  1455,  1527,  1601,
+   1677,  1755,  1835,  1916,  2000,  2086,  2173,  2263,  2354,  2448,  2543,  2641,
+   2740,  2842,  2945,  3051,  3158,  3268,  3379,  3493,  3609,  3727,  3846,  3968,
+   4092,  4218,  4347,  4477,  4609,  4744,  4880,  5019,  5160,  5303,  5448,  5595,
+   5745,  5896,  6050,  6206,  6364,  6524,  6686,  6851,  7017,  7186,  7357,  7531,
+   7706,  7884,  8064,  8246,  8430,  8617,  8806,  8997,  9190,  9385,  9583,  9783,
+   9986, 10190, 10397, 10606, 10817, 11031, 11247, 11465, 11685, 11908, 12133, 12361,
+  12590, 12822, 13057, 13293, 13532, 13773, 14017, 14263, 14511, 14762, 15015, 15270,
+  15528, 15787, 16050, 16314, 16582, 16851, 17123, 17397, 17673, 17952, 18234, 18517,
+  18803, 19092, 19383, 19676, 19972, 20270, 20570, 20873, 21178, 21486, 21796, 22109,
+  22424, 22741, 23061, 23384, 23708, 24036, 24365, 24697, 25032, 25369, 25709, 26050,
+  26395, 26742, 27091, 27443, 27797, 28154, 28513, 28875, 29239, 29606, 29975, 30347,
+  30721, 31098, 31477, 31859, 32243, 32630, 33019, 33411, 33805, 34202, 34602, 35004,
+  35408, 35815, 36225, 36637, 37051, 37468, 37888, 38310, 38735, 39163, 39592, 40025,
+  40460, 40898, 41338, 41781, 42226, 42674, 43124, 43577, 44033, 44491, 44952, 45415,
+  45881, 46350, 46821, 47295, 47772, 48251, 48732, 49216, 49703, 50193, 50685, 51179,
+  51677, 52177, 52679, 53185, 53692, 54203, 54716, 55232, 55750, 56271, 56795, 57321,
+  57850, 58382, 58916, 59453, 59992, 60535, 61080, 61627, 62177, 62730, 63286, 63844,
+  64405, 64969, 65535,
+};
+
+static struct ZbZclClusterT       * pstLevelServer;
+static struct ZbTimerT            * pstLevelTimer;          /* End of the batch played */
+static TIM_HandleTypeDef            stLevelTim;
+static DMA_HandleTypeDef            stLevelDma;
+static uint32_t                     alLevelWeight[APP_ZIGBEE_LEVEL_PWM_CHANNELS];   /* Color of the output (full scale 1 << 16) */
+static uint8_t                      cLevelCurrent;          /* Output level, start of the transition if ongoing */
+static bool                         bLevelOn;
+static APP_ZIGBEE_LevelStats_t      stLevelStats;
+
+/* Transition engine : two batches of frames, one played by the DMA while the next one is computed ahead */
+static uint16_t                     aiLevelBatch[2][CFG_ZIGBEE_LEVEL_BATCH_FRAMES * APP_ZIGBEE_LEVEL_PWM_CHANNELS];
+static uint16_t                     aiLevelBatchFrames[2];
+static uint8_t                      cLevelBatch;            /* Batch played */
+static uint32_t                     lLevelRepeat;           /* PWM periods of a frame */
+static uint32_t                     lLevelPlayed;           /* Frames played before the batch played */
+static uint32_t                     lLevelPlayTick;
+static bool                         bLevelPlaying;
+static APP_ZIGBEE_LevelFill_t       pfLevelFill;
+static APP_ZIGBEE_LevelEnd_t        pfLevelEnd;
+
+/* Level transition, source of the engine */
+static uint8_t                      cLevelStart;
+static uint8_t                      cLevelTarget;
+static uint32_t                     lLevelRampSize;         /* Frames of the transition */
+static uint32_t                     lLevelRampNext;         /* Next frame to compute */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     LevelPwmInit            ( void );
+static uint16_t LevelToPulse            ( uint8_t cLevel );
+static void     LevelFrame              ( uint16_t * piFrame, uint16_t iPulse );
+static void     LevelOutput             ( void );
+static void     LevelSet                ( uint8_t cLevel );
+static void     LevelWithOnOff          ( bool bWithOnOff, uint8_t cTarget );
+static bool     LevelBatchStart         ( uint8_t cBatch );
+static void     LevelBatchEndCallback   ( struct ZigBeeT * zb, void * arg );
+static void     LevelPlayEnd            ( bool bStopped );
+static void     LevelPlayStop           ( void );
+static void     LevelRampStart          ( uint8_t cTarget, uint32_t lPeriods );
+static uint16_t LevelRampFill           ( uint16_t * piFrames, uint16_t iFramesMax );
+static void     LevelRampEnd            ( uint32_t lFrames, bool bStopped );
+static void     LevelPrintStats         ( void );
+
+static enum ZclStatusCodeT LevelMoveToLevelCallback ( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientMoveToLevelReqT * pstReq,
+                                                      struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT LevelMoveCallback        ( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientMoveReqT * pstReq,
+                                                      struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT LevelStepCallback        ( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientStepReqT * pstReq,
+                                                      struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+static enum ZclStatusCodeT LevelStopCallback        ( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientStopReqT * pstReq,
+                                                      struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+
+/* Serial commands of the Level Control Server */
+static const SerialCmd_t            astLevelSerialCmds[] =
+{
+  { "LEVELSTATS", LevelPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stLevelSerialCmdTable =
+{
+  astLevelSerialCmds, ( sizeof( astLevelSerialCmds ) / sizeof( astLevelSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the PWM output and its DMA, then add the Level Control Server on the OnOff Server Endpoint.
+ * @param  pstZigbee       Zigbee stack instance
+ * @param  cEndpoint       Endpoint of the OnOff Server
+ * @param  pstOnOffServer  OnOff Server of the Endpoint (commands 'with OnOff' and Options)
+ * @retval None
+ */
+void APP_ZIGBEE_LevelInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer )
+{
+  static struct ZbZclLevelServerCallbacksT  stCallbacks =
+  {
+    .move_to_level = LevelMoveToLevelCallback,
+    .move = LevelMoveCallback,
+    .step = LevelStepCallback,
+    .stop = LevelStopCallback,
+  };
+  uint8_t   cChannel;
+
+  memset( &stLevelStats, 0, sizeof( stLevelStats ) );
+  cLevelCurrent = ZCL_LEVEL_MAXIMUM_LEVEL;
+  bLevelOn = false;
+  bLevelPlaying = false;
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    alLevelWeight[cChannel] = LEVEL_WEIGHT_FULL;
+  }
+
+  LevelPwmInit();
+
+  pstLevelTimer = ZbTimerAlloc( pstZigbee, LevelBatchEndCallback, NULL );
+  pstLevelServer = ZbZclLevelServerAlloc( pstZigbee, cEndpoint, pstOnOffServer, &stCallbacks, NULL );
+  if ( ( pstLevelTimer == NULL ) || ( pstLevelServer == NULL ) )
+  {
+    LOG_ERROR_APP( "Error, Level Server allocation failed." );
+    return;
+  }
+
+  if ( ZbZclClusterEndpointRegister( pstLevelServer ) == false )
+  {
+    LOG_ERROR_APP( "Error, Level Server registration failed." );
+    return;
+  }
+
+  LevelSet( cLevelCurrent );
+  Serial_CMD_Interpreter_RegisterTable( &stLevelSerialCmdTable );
+}
+
+/**
+ * @brief  Output switched by the OnOff Server : the level is kept, an ongoing transition is stopped at Off.
+ * @param  bOn  New state of the output
+ * @retval None
+ */
+void APP_ZIGBEE_LevelOnOff( bool bOn )
+{
+  if ( ( pstLevelServer == NULL ) || ( bOn == bLevelOn ) )
+  {
+    return;
+  }
+
+  bLevelOn = bOn;
+  if ( bOn == false )
+  {
+    LevelPlayStop();
+  }
+  LevelOutput();
+}
+
+/**
+ * @brief  Set the color of the output : linear weight of each channel, applied to the pulse of the level. An ongoing
+ *         transition keeps its frames, the color is applied from the next one.
+ * @param  piColor  Weight of each channel (0 to 0xFFFF, full scale)
+ * @retval None
+ */
+void APP_ZIGBEE_LevelSetColor( const uint16_t * piColor )
+{
+  uint8_t   cChannel;
+
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    alLevelWeight[cChannel] = ( (uint32_t)piColor[cChannel] + ( piColor[cChannel] >> 15u ) );
+  }
+
+  if ( ( pstLevelServer != NULL ) && ( bLevelPlaying == false ) )
+  {
+    LevelOutput();
+  }
+}
+
+/**
+ * @brief  Frame (pulse of each channel) of a color at the current level, for the transitions of the other sources.
+ * @param  piFrame  Frame to fill (APP_ZIGBEE_LEVEL_PWM_CHANNELS pulses)
+ * @param  piColor  Weight of each channel (0 to 0xFFFF, full scale)
+ * @retval None
+ */
+void APP_ZIGBEE_LevelColorFrame( uint16_t * piFrame, const uint16_t * piColor )
+{
+  uint32_t  lPulse;
+  uint8_t   cChannel;
+
+  lPulse = ( ( bLevelOn != false ) ? LevelToPulse( cLevelCurrent ) : 0u );
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    piFrame[cChannel] = (uint16_t)( ( lPulse * ( (uint32_t)piColor[cChannel] + ( piColor[cChannel] >> 15u ) ) ) >> 16u );
+  }
+}
+
+/**
+ * @brief  Frame (pulse of each channel) of the current level and color, the output being on.
+ * @param  piFrame  Frame to fill (APP_ZIGBEE_LEVEL_PWM_CHANNELS pulses)
+ * @retval None
+ */
+void APP_ZIGBEE_LevelGetFrame( uint16_t * piFrame )
+{
+  LevelFrame( piFrame, LevelToPulse( cLevelCurrent ) );
+}
+
+/**
+ * @brief  Drive the output with a frame at once (scene recall), an ongoing transition being stopped. The level is
+ *         not changed : the stack then recalls it, to the same output.
+ * @param  piFrame  Frame (APP_ZIGBEE_LEVEL_PWM_CHANNELS pulses)
+ * @retval None
+ */
+void APP_ZIGBEE_LevelApplyFrame( const uint16_t * piFrame )
+{
+  uint8_t   cChannel;
+  bool      bLit = false;
+
+  if ( pstLevelServer == NULL )
+  {
+    return;
+  }
+
+  LevelPlayStop();
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    __HAL_TIM_SET_COMPARE( &stLevelTim, LEVEL_PWM_CHANNEL( cChannel ), piFrame[cChannel] );
+    bLit |= ( piFrame[cChannel] != 0u );
+  }
+
+  if ( bLit != false )
+  {
+    UTIL_LPM_SetStopMode( ( 1U << CFG_LPM_LEVEL_PWM ), UTIL_LPM_DISABLE );
+  }
+}
+
+/**
+ * @brief  Play a transition : the source fills the batches of frames, each frame held lRepeat PWM periods. The first
+ *         batch is started, the next one is computed ahead while it is played. A transition already playing is
+ *         stopped first (its end callback is called).
+ * @param  pfFill   Fill of the next batch, returns 0 at the end of the transition
+ * @param  pfEnd    End of the transition (frames played, stopped or not)
+ * @param  lRepeat  PWM periods of each frame
+ * @retval True if playing, false if the output is off or the transition is empty (the source applies its end).
+ */
+bool APP_ZIGBEE_LevelPlay( APP_ZIGBEE_LevelFill_t pfFill, APP_ZIGBEE_LevelEnd_t pfEnd, uint32_t lRepeat )
+{
+  LevelPlayStop();
+
+  if ( ( pstLevelServer == NULL ) || ( bLevelOn == false ) || ( lRepeat == 0u ) )
+  {
+    return false;
+  }
+
+  pfLevelFill = pfFill;
+  pfLevelEnd = pfEnd;
+  lLevelRepeat = ( ( lRepeat > LEVEL_REPEAT_MAX ) ? LEVEL_REPEAT_MAX : lRepeat );
+  lLevelPlayed = 0;
+  cLevelBatch = 0;
+
+  aiLevelBatchFrames[0] = pfFill( aiLevelBatch[0], CFG_ZIGBEE_LEVEL_BATCH_FRAMES );
+  if ( ( aiLevelBatchFrames[0] == 0u ) || ( LevelBatchStart( 0 ) == false ) )
+  {
+    return false;
+  }
+
+  bLevelPlaying = true;
+  lLevelPlayTick = HAL_GetTick();
+  stLevelStats.lRamps++;
+  LevelOutput();
+
+  /* Update event now : repetition counter loaded, first frame requested */
+  LEVEL_PWM_TIMER->RCR = ( lLevelRepeat - 1u );
+  __HAL_TIM_ENABLE_DMA( &stLevelTim, TIM_DMA_UPDATE );
+  LEVEL_PWM_TIMER->EGR = TIM_EGR_UG;
+
+  /* Next batch computed while the first one is played */
+  aiLevelBatchFrames[1] = pfFill( aiLevelBatch[1], CFG_ZIGBEE_LEVEL_BATCH_FRAMES );
+
+  return true;
+}
+
+/**
+ * @brief  Stop the transition of a source, if it is the one playing.
+ * @param  pfFill  Fill of the source
+ * @retval None
+ */
+void APP_ZIGBEE_LevelPlayStop( APP_ZIGBEE_LevelFill_t pfFill )
+{
+  if ( ( bLevelPlaying != false ) && ( pfLevelFill == pfFill ) )
+  {
+    LevelPlayStop();
+  }
+}
+
+/**
+ * @brief  Return the statistics of the Level Control Server.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_LevelStats_t * APP_ZIGBEE_LevelGetStats( void )
+{
+  stLevelStats.cLevel = cLevelCurrent;
+  return &stLevelStats;
+}
+
+/**
+ * @brief  TIM1 PWM at CFG_ZIGBEE_LEVEL_PWM_FREQUENCY on APP_ZIGBEE_LEVEL_PWM_CHANNELS channels. The update event
+ *         requests a DMA burst of one frame to the compare registers (the repetition counter sets the length of a
+ *         frame), through a GPDMA1 channel without interrupt.
+ * @param  None
+ * @retval None
+ */
+static void LevelPwmInit( void )
+{
+  GPIO_InitTypeDef    stGpio = { 0 };
+  TIM_OC_InitTypeDef  stOc = { 0 };
+  uint32_t            lClock;
+  uint8_t             cChannel;
+
+  __HAL_RCC_TIM1_CLK_ENABLE();
+  __HAL_RCC_GPDMA1_CLK_ENABLE();
+  CFG_ZIGBEE_LEVEL_PWM_GPIO_CLK_ENABLE();
+
+  stGpio.Pin = LEVEL_PWM_GPIO_PINS;
+  stGpio.Mode = GPIO_MODE_AF_PP;
+  stGpio.Pull = GPIO_NOPULL;
+  stGpio.Speed = GPIO_SPEED_FREQ_LOW;
+  stGpio.Alternate = CFG_ZIGBEE_LEVEL_PWM_GPIO_AF;
+  HAL_GPIO_Init( CFG_ZIGBEE_LEVEL_PWM_GPIO_PORT, &stGpio );
+
+  /* Timer clock is twice PCLK2 when APB2 is divided */
+  lClock = HAL_RCC_GetPCLK2Freq();
+  if ( lClock != HAL_RCC_GetHCLKFreq() )
+  {
+    lClock *= 2u;
+  }
+  lClock /= ( CFG_ZIGBEE_LEVEL_PWM_FREQUENCY * CFG_ZIGBEE_LEVEL_PWM_RESOLUTION );
+
+  stLevelTim.Instance = LEVEL_PWM_TIMER;
+  stLevelTim.Init.Prescaler = ( ( lClock != 0u ) ? ( lClock - 1u ) : 0u );
+  stLevelTim.Init.CounterMode = TIM_COUNTERMODE_UP;
+  stLevelTim.Init.Period = ( CFG_ZIGBEE_LEVEL_PWM_RESOLUTION - 1u );
+  stLevelTim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  stLevelTim.Init.RepetitionCounter = 0;
+  stLevelTim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+
+  /* Compare preloaded : a frame written by the DMA is applied at the next update, without glitch */
+  stOc.OCMode = TIM_OCMODE_PWM1;
+  stOc.Pulse = 0;
+  stOc.OCPolarity = TIM_OCPOLARITY_HIGH;
+  stOc.OCFastMode = TIM_OCFAST_DISABLE;
+  stOc.OCIdleState = TIM_OCIDLESTATE_RESET;
+
+  if ( HAL_TIM_PWM_Init( &stLevelTim ) != HAL_OK )
+  {
+    LOG_ERROR_APP( "Error, Level PWM initialization failed." );
+    return;
+  }
+
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    if ( ( HAL_TIM_PWM_ConfigChannel( &stLevelTim, &stOc, LEVEL_PWM_CHANNEL( cChannel ) ) != HAL_OK ) ||
+         ( HAL_TIM_PWM_Start( &stLevelTim, LEVEL_PWM_CHANNEL( cChannel ) ) != HAL_OK ) )
+    {
+      LOG_ERROR_APP( "Error, Level PWM channel %d initialization failed.", cChannel );
+    }
+  }
+
+  /* DMA burst of a frame to the compare registers, from CCR1 */
+  LEVEL_PWM_TIMER->DCR = ( TIM_DMABASE_CCR1 | ( ( APP_ZIGBEE_LEVEL_PWM_CHANNELS - 1u ) << TIM_DCR_DBL_Pos ) );
+
+  stLevelDma.Instance = LEVEL_PWM_DMA_CHANNEL;
+  stLevelDma.Init.Request = LEVEL_PWM_DMA_REQUEST;
+  stLevelDma.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+  stLevelDma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  stLevelDma.Init.SrcInc = DMA_SINC_INCREMENTED;
+  stLevelDma.Init.DestInc = DMA_DINC_FIXED;
+  stLevelDma.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_HALFWORD;
+  stLevelDma.Init.DestDataWidth = DMA_DEST_DATAWIDTH_HALFWORD;
+  stLevelDma.Init.Priority = DMA_LOW_PRIORITY_LOW_WEIGHT;
+  stLevelDma.Init.SrcBurstLength = 1;
+  stLevelDma.Init.DestBurstLength = 1;
+  stLevelDma.Init.TransferAllocatedPort = ( DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT0 );
+  stLevelDma.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  stLevelDma.Init.Mode = DMA_NORMAL;
+
+  if ( ( HAL_DMA_Init( &stLevelDma ) != HAL_OK ) ||
+       ( HAL_DMA_ConfigChannelAttributes( &stLevelDma, DMA_CHANNEL_NPRIV ) != HAL_OK ) )
+  {
+    LOG_ERROR_APP( "Error, Level DMA initialization failed." );
+  }
+}
+
+/**
+ * @brief  Pulse of a level, through the gamma table. A level above 0 gives at least one count.
+ * @param  cLevel  Level
+ * @retval Pulse (timer counts).
+ */
+static uint16_t LevelToPulse( uint8_t cLevel )
+{
+  uint32_t  lPulse;
+
+  lPulse = ( ( (uint32_t)aiLevelGamma[cLevel] * CFG_ZIGBEE_LEVEL_PWM_RESOLUTION ) + 0x8000u ) >> 16u;
+  if ( ( lPulse == 0u ) && ( cLevel != 0u ) )
+  {
+    lPulse = 1u;
+  }
+
+  return (uint16_t)lPulse;
+}
+
+/**
+ * @brief  Frame of a pulse, with the color of the output.
+ * @param  piFrame  Frame to fill (APP_ZIGBEE_LEVEL_PWM_CHANNELS pulses)
+ * @param  iPulse   Pulse at full weight
+ * @retval None
+ */
+static void LevelFrame( uint16_t * piFrame, uint16_t iPulse )
+{
+  uint8_t   cChannel;
+
+  for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+  {
+    piFrame[cChannel] = (uint16_t)( ( (uint32_t)iPulse * alLevelWeight[cChannel] ) >> 16u );
+  }
+}
+
+/**
+ * @brief  Drive the output from the level, the color and the OnOff state (the DMA drives it during a transition).
+ *         The timer does not run in Stop mode : Stop is not allowed while the output is on or a transition is ongoing.
+ * @param  None
+ * @retval None
+ */
+static void LevelOutput( void )
+{
+  uint16_t  aiFrame[APP_ZIGBEE_LEVEL_PWM_CHANNELS];
+  uint16_t  iPulse;
+  uint8_t   cChannel;
+
+  iPulse = ( ( bLevelOn != false ) ? LevelToPulse( cLevelCurrent ) : 0u );
+  if ( bLevelPlaying == false )
+  {
+    LevelFrame( aiFrame, iPulse );
+    for ( cChannel = 0; cChannel < APP_ZIGBEE_LEVEL_PWM_CHANNELS; cChannel++ )
+    {
+      __HAL_TIM_SET_COMPARE( &stLevelTim, LEVEL_PWM_CHANNEL( cChannel ), aiFrame[cChannel] );
+    }
+  }
+
+  UTIL_LPM_SetStopMode( ( 1U << CFG_LPM_LEVEL_PWM ), ( ( ( iPulse != 0u ) || ( bLevelPlaying != false ) ) ? UTIL_LPM_DISABLE : UTIL_LPM_ENABLE ) );
+}
+
+/**
+ * @brief  Set the level without transition : output, then CurrentLevel attribute.
+ * @param  cLevel  New level
+ * @retval None
+ */
+static void LevelSet( uint8_t cLevel )
+{
+  cLevelCurrent = cLevel;
+  LevelOutput();
+  (void)ZbZclAttrIntegerWrite( pstLevelServer, ZCL_LEVEL_ATTR_CURRLEVEL, cLevel );
+  APP_ZIGBEE_BatchChange( pstLevelServer, ZCL_LEVEL_ATTR_CURRLEVEL );
+}
+
+/**
+ * @brief  A command 'with OnOff' raising the level switches the output on (the stack updates the OnOff attribute).
+ * @param  bWithOnOff  Command 'with OnOff'
+ * @param  cTarget     Level at the end of the command
+ * @retval None
+ */
+static void LevelWithOnOff( bool bWithOnOff, uint8_t cTarget )
+{
+  if ( ( bWithOnOff != false ) && ( cTarget > ZCL_LEVEL_MINIMUM_LEVEL ) )
+  {
+    bLevelOn = true;
+  }
+}
+
+/**
+ * @brief  Start the DMA of a batch, and the stack timer of its end.
+ * @param  cBatch  Batch to play
+ * @retval True if started.
+ */
+static bool LevelBatchStart( uint8_t cBatch )
+{
+  uint32_t  lFrames = aiLevelBatchFrames[cBatch];
+
+  if ( HAL_DMA_Start( &stLevelDma, (uint32_t)aiLevelBatch[cBatch], (uint32_t)&LEVEL_PWM_TIMER->DMAR,
+                      ( lFrames * APP_ZIGBEE_LEVEL_PWM_CHANNELS * sizeof( uint16_t ) ) ) != HAL_OK )
+  {
+    return false;
+  }
+
+  ZbTimerReset( pstLevelTimer, (uint32_t)( ( (uint64_t)lFrames * lLevelRepeat * 1000u ) / CFG_ZIGBEE_LEVEL_PWM_FREQUENCY ) + 1u );
+  return true;
+}
+
+/**
+ * @brief  End of the batch played (stack timer) : the batch computed ahead is started at once, then the next one is
+ *         computed. The transition ends after its last batch.
+ * @param  zb   Zigbee stack instance
+ * @param  arg  Not used
+ * @retval None
+ */
+static void LevelBatchEndCallback( struct ZigBeeT * zb, void * arg )
+{
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( bLevelPlaying == false )
+  {
+    return;
+  }
+
+  /* Transfer ended (aborted if the last frame is not yet written) */
+  (void)HAL_DMA_PollForTransfer( &stLevelDma, HAL_DMA_FULL_TRANSFER, 0u );
+  lLevelPlayed += aiLevelBatchFrames[cLevelBatch];
+  stLevelStats.lBatches++;
+
+  cLevelBatch ^= 1u;
+  if ( ( aiLevelBatchFrames[cLevelBatch] == 0u ) || ( LevelBatchStart( cLevelBatch ) == false ) )
+  {
+    LevelPlayEnd( false );
+    return;
+  }
+
+  aiLevelBatchFrames[cLevelBatch ^ 1u] = pfLevelFill( aiLevelBatch[cLevelBatch ^ 1u], CFG_ZIGBEE_LEVEL_BATCH_FRAMES );
+}
+
+/**
+ * @brief  End of the transition played : DMA requests of the timer disabled, end callback of the source.
+ * @param  bStopped  Transition stopped before its end
+ * @retval None
+ */
+static void LevelPlayEnd( bool bStopped )
+{
+  __HAL_TIM_DISABLE_DMA( &stLevelTim, TIM_DMA_UPDATE );
+
+  bLevelPlaying = false;
+  stLevelStats.lFrames += lLevelPlayed;
+  stLevelStats.lLastDuration = ( HAL_GetTick() - lLevelPlayTick );
+  LevelOutput();
+
+  pfLevelEnd( lLevelPlayed, bStopped );
+}
+
+/**
+ * @brief  Stop the transition played at the last frame written by the DMA.
+ * @param  None
+ * @retval None
+ */
+static void LevelPlayStop( void )
+{
+  uint32_t  lRemaining;
+
+  if ( bLevelPlaying == false )
+  {
+    return;
+  }
+
+  lRemaining = ( ( __HAL_DMA_GET_COUNTER( &stLevelDma ) + ( APP_ZIGBEE_LEVEL_PWM_CHANNELS * sizeof( uint16_t ) ) - 1u ) /
+                 ( APP_ZIGBEE_LEVEL_PWM_CHANNELS * sizeof( uint16_t ) ) );
+  (void)HAL_DMA_Abort( &stLevelDma );
+  ZbTimerStop( pstLevelTimer );
+
+  lLevelPlayed += ( aiLevelBatchFrames[cLevelBatch] - lRemaining );
+  stLevelStats.lStopped++;
+  LevelPlayEnd( true );
+}
+
+/**
+ * @brief  Start a level transition from the current level. It holds one frame per level at least, more when a frame
+ *         would exceed the repetition counter.
+ * @param  cTarget   Level at the end of the transition
+ * @param  lPeriods  Duration of the transition, in PWM periods
+ * @retval None
+ */
+static void LevelRampStart( uint8_t cTarget, uint32_t lPeriods )
+{
+  int32_t   lDelta;
+  uint32_t  lSize;
+
+  LevelPlayStop();
+
+  lDelta = ( (int32_t)cTarget - (int32_t)cLevelCurrent );
+  if ( ( bLevelOn == false ) || ( lDelta == 0 ) || ( lPeriods == 0u ) )
+  {
+    LevelSet( cTarget );
+    return;
+  }
+
+  lSize = (uint32_t)( ( lDelta < 0 ) ? -lDelta : lDelta );
+  if ( lSize < ( ( lPeriods + LEVEL_REPEAT_MAX - 1u ) / LEVEL_REPEAT_MAX ) )
+  {
+    lSize = ( ( lPeriods + LEVEL_REPEAT_MAX - 1u ) / LEVEL_REPEAT_MAX );
+  }
+  if ( lSize > lPeriods )
+  {
+    lSize = lPeriods;
+  }
+
+  cLevelStart = cLevelCurrent;
+  cLevelTarget = cTarget;
+  lLevelRampSize = lSize;
+  lLevelRampNext = 0;
+
+  if ( APP_ZIGBEE_LevelPlay( LevelRampFill, LevelRampEnd, ( lPeriods / lSize ) ) == false )
+  {
+    LevelSet( cTarget );
+  }
+}
+
+/**
+ * @brief  Next batch of the level transition.
+ * @param  piFrames    Batch to fill
+ * @param  iFramesMax  Frames of the batch
+ * @retval Frames filled, 0 at the end of the transition.
+ */
+static uint16_t LevelRampFill( uint16_t * piFrames, uint16_t iFramesMax )
+{
+  int32_t   lDelta = ( (int32_t)cLevelTarget - (int32_t)cLevelStart );
+  uint16_t  iFrames = 0;
+
+  while ( ( iFrames < iFramesMax ) && ( lLevelRampNext < lLevelRampSize ) )
+  {
+    lLevelRampNext++;
+    LevelFrame( &piFrames[iFrames * APP_ZIGBEE_LEVEL_PWM_CHANNELS],
+                LevelToPulse( (uint8_t)( (int32_t)cLevelStart + ( ( lDelta * (int32_t)lLevelRampNext ) / (int32_t)lLevelRampSize ) ) ) );
+    iFrames++;
+  }
+
+  return iFrames;
+}
+
+/**
+ * @brief  End of the level transition : level of the last frame played, CurrentLevel updated.
+ * @param  lFrames   Frames played
+ * @param  bStopped  Not used (level of the frames played)
+ * @retval None
+ */
+static void LevelRampEnd( uint32_t lFrames, bool bStopped )
+{
+  int32_t   lDelta = ( (int32_t)cLevelTarget - (int32_t)cLevelStart );
+
+  UNUSED( bStopped );
+
+  LevelSet( (uint8_t)( (int32_t)cLevelStart + ( ( lDelta * (int32_t)lFrames ) / (int32_t)lLevelRampSize ) ) );
+}
+
+/**
+ * @brief  Level Server 'Move To Level' command. A transition time 'use OnOffTransitionTime' moves at once.
+ * @param  pstCluster  Level Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT LevelMoveToLevelCallback( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientMoveToLevelReqT * pstReq,
+                                                     struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  uint8_t   cTarget;
+  uint32_t  lPeriods;
+
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stLevelStats.lCommands++;
+  cTarget = ( ( pstReq->level > ZCL_LEVEL_MAXIMUM_LEVEL ) ? ZCL_LEVEL_MAXIMUM_LEVEL : pstReq->level );
+  lPeriods = ( ( pstReq->transition_time != LEVEL_TRANSITION_DEFAULT ) ?
+               ( ( (uint32_t)pstReq->transition_time * CFG_ZIGBEE_LEVEL_PWM_FREQUENCY ) / 10u ) : 0u );
+
+  LevelWithOnOff( pstReq->with_onoff, cTarget );
+  LevelRampStart( cTarget, lPeriods );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Level Server 'Move' command : transition to the maximum or the minimum level at the rate (units/s). A
+ *         rate 'use DefaultMoveRate' moves at once.
+ * @param  pstCluster  Level Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT LevelMoveCallback( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientMoveReqT * pstReq,
+                                              struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  uint8_t   cTarget;
+  uint32_t  lPeriods = 0;
+
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stLevelStats.lCommands++;
+  if ( pstReq->rate == 0u )
+  {
+    return ZCL_STATUS_INVALID_FIELD;
+  }
+
+  LevelPlayStop();
+  cTarget = ( ( pstReq->mode == ZCL_LEVEL_MODE_UP ) ? ZCL_LEVEL_MAXIMUM_LEVEL : ZCL_LEVEL_MINIMUM_LEVEL );
+  if ( pstReq->rate != LEVEL_RATE_DEFAULT )
+  {
+    lPeriods = ( (uint32_t)( ( cTarget > cLevelCurrent ) ? ( cTarget - cLevelCurrent ) : ( cLevelCurrent - cTarget ) )
+                 * CFG_ZIGBEE_LEVEL_PWM_FREQUENCY ) / pstReq->rate;
+  }
+
+  LevelWithOnOff( pstReq->with_onoff, cTarget );
+  LevelRampStart( cTarget, lPeriods );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Level Server 'Step' command : transition of 'size' levels up or down, bounded.
+ * @param  pstCluster  Level Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT LevelStepCallback( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientStepReqT * pstReq,
+                                              struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  int32_t   lTarget;
+  uint32_t  lPeriods;
+
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stLevelStats.lCommands++;
+  LevelPlayStop();
+
+  lTarget = ( ( pstReq->mode == ZCL_LEVEL_MODE_UP ) ? ( (int32_t)cLevelCurrent + pstReq->size ) : ( (int32_t)cLevelCurrent - pstReq->size ) );
+  if ( lTarget > ZCL_LEVEL_MAXIMUM_LEVEL )
+  {
+    lTarget = ZCL_LEVEL_MAXIMUM_LEVEL;
+  }
+  else if ( lTarget < ZCL_LEVEL_MINIMUM_LEVEL )
+  {
+    lTarget = ZCL_LEVEL_MINIMUM_LEVEL;
+  }
+  lPeriods = ( ( pstReq->transition_time != LEVEL_TRANSITION_DEFAULT ) ?
+               ( ( (uint32_t)pstReq->transition_time * CFG_ZIGBEE_LEVEL_PWM_FREQUENCY ) / 10u ) : 0u );
+
+  LevelWithOnOff( pstReq->with_onoff, (uint8_t)lTarget );
+  LevelRampStart( (uint8_t)lTarget, lPeriods );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Level Server 'Stop' command : the ongoing transition stops at the level reached.
+ * @param  pstCluster  Level Server
+ * @param  pstReq      Command
+ * @param  pstSrcInfo  Source of the command
+ * @param  arg         Not used
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT LevelStopCallback( struct ZbZclClusterT * pstCluster, struct ZbZclLevelClientStopReqT * pstReq,
+                                              struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstReq );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  stLevelStats.lCommands++;
+  APP_ZIGBEE_LevelPlayStop( LevelRampFill );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Print the statistics of the Level Control Server.
+ * @param  None
+ * @retval None
+ */
+static void LevelPrintStats( void )
+{
+  LOG_INFO_APP( "Level : %d (output %s), %d commands, %d transitions (%d frames, %d batches), %d stopped, last %d ms.",
+                cLevelCurrent, ( ( bLevelOn != false ) ? "on" : "off" ), stLevelStats.lCommands, stLevelStats.lRamps,
+                stLevelStats.lFrames, stLevelStats.lBatches, stLevelStats.lStopped, stLevelStats.lLastDuration );
+  if ( bLevelPlaying != false )
+  {
+    LOG_INFO_APP( "  Transition ongoing (%d frames played, %d PWM periods each).", lLevelPlayed, lLevelRepeat );
+  }
+}
+
+#else /* (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) */
+
+/**
+ * @brief  Level Control Server not supported.
+ */
+void APP_ZIGBEE_LevelInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( pstOnOffServer );
+}
+
+/**
+ * @brief  Level Control Server not supported.
+ */
+void APP_ZIGBEE_LevelOnOff( bool bOn )
+{
+  UNUSED( bOn );
+}
+
+/**
+ * @brief  Level Control Server not supported.
+ */
+void APP_ZIGBEE_LevelSetColor( const uint16_t * piColor )
+{
+  UNUSED( piColor );
+}
+
+/**
+ * @brief  Level Control Server not supported : output off.
+ */
+void APP_ZIGBEE_LevelColorFrame( uint16_t * piFrame, const uint16_t * piColor )
+{
+  UNUSED( piColor );
+  memset( piFrame, 0, ( APP_ZIGBEE_LEVEL_PWM_CHANNELS * sizeof( uint16_t ) ) );
+}
+
+/**
+ * @brief  Level Control Server not supported : output off.
+ */
+void APP_ZIGBEE_LevelGetFrame( uint16_t * piFrame )
+{
+  memset( piFrame, 0, ( APP_ZIGBEE_LEVEL_PWM_CHANNELS * sizeof( uint16_t ) ) );
+}
+
+/**
+ * @brief  Level Control Server not supported.
+ */
+void APP_ZIGBEE_LevelApplyFrame( const uint16_t * piFrame )
+{
+  UNUSED( piFrame );
+}
+
+/**
+ * @brief  Level Control Server not supported : no transition.
+ */
+bool APP_ZIGBEE_LevelPlay( APP_ZIGBEE_LevelFill_t pfFill, APP_ZIGBEE_LevelEnd_t pfEnd, uint32_t lRepeat )
+{
+  UNUSED( pfFill );
+  UNUSED( pfEnd );
+  UNUSED( lRepeat );
+  return false;
+}
+
+/**
+ * @brief  Level Control Server not supported.
+ */
+void APP_ZIGBEE_LevelPlayStop( APP_ZIGBEE_LevelFill_t pfFill )
+{
+  UNUSED( pfFill );
+}
+
+/**
+ * @brief  Level Control Server not supported : no statistics.
+ */
+const APP_ZIGBEE_LevelStats_t * APP_ZIGBEE_LevelGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_LEVEL_PWM_SUPPORTED != 0) */
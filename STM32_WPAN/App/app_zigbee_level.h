@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_level.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Level Control Server of the dimmer (PWM output
+  *          with the transitions written by DMA) and of its transition engine.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_LEVEL_H
+#define APP_ZIGBEE_LEVEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* PWM channels of the output : R, G, B with the Color Control Server, else one */
+#if (CFG_ZIGBEE_COLOR_SUPPORTED != 0)
+#define APP_ZIGBEE_LEVEL_PWM_CHANNELS   (3u)
+#else /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
+#define APP_ZIGBEE_LEVEL_PWM_CHANNELS   (1u)
+#endif /* (CFG_ZIGBEE_COLOR_SUPPORTED != 0) */
+
+/* Exported types ------------------------------------------------------------*/
+/* Transition source : fills the next batch (APP_ZIGBEE_LEVEL_PWM_CHANNELS pulses per frame), returns the frames
+ * filled, 0 at the end of the transition */
+typedef uint16_t ( * APP_ZIGBEE_LevelFill_t )( uint16_t * piFrames, uint16_t iFramesMax );
+
+/* Transition source : end of the transition, with the frames played */
+typedef void ( * APP_ZIGBEE_LevelEnd_t )( uint32_t lFrames, bool bStopped );
+
+/* Statistics of the Level Control Server */
+typedef struct
+{
+  uint32_t    lCommands;              /* Move To Level, Move, Step and Stop commands received */
+  uint32_t    lRamps;                 /* Transitions played by the DMA (level and color) */
+  uint32_t    lFrames;                /* Frames of the transitions written by the DMA */
+  uint32_t    lBatches;               /* Batches played, one CPU wake each */
+  uint32_t    lStopped;               /* Transitions stopped before their end (Stop or new command) */
+  uint32_t    lLastDuration;          /* Duration of the last transition (ms) */
+  uint8_t     cLevel;                 /* Level of the output (start of the transition if ongoing) */
+} APP_ZIGBEE_LevelStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_LevelInit              ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, struct ZbZclClusterT * pstOnOffServer );
+void      APP_ZIGBEE_LevelOnOff             ( bool bOn );
+void      APP_ZIGBEE_LevelSetColor          ( const uint16_t * piColor );
+void      APP_ZIGBEE_LevelColorFrame        ( uint16_t * piFrame, const uint16_t * piColor );
+void      APP_ZIGBEE_LevelGetFrame          ( uint16_t * piFrame );
+void      APP_ZIGBEE_LevelApplyFrame        ( const uint16_t * piFrame );
+bool      APP_ZIGBEE_LevelPlay              ( APP_ZIGBEE_LevelFill_t pfFill, APP_ZIGBEE_LevelEnd_t pfEnd, uint32_t lRepeat );
+void      APP_ZIGBEE_LevelPlayStop          ( APP_ZIGBEE_LevelFill_t pfFill );
+
+const APP_ZIGBEE_LevelStats_t * APP_ZIGBEE_LevelGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_LEVEL_H */
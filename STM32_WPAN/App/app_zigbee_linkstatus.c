@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_linkstatus.c
+  * @author  MCD Application Team
+  * @brief   Adaptive Link Status period of the Router : stretched while the
+  *          Router neighbors do not change, restored at once after a change
+  *          of the mesh. The Router age limit follows, so that a neighbor
+  *          gone is still aged out in about the same time.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_linkstatus.h"
+#include "serial_cmd_interpreter.h"
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_LINK_STATUS_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define LINK_STATUS_AGE_LIMIT_MIN       (2u)
+#define LINK_STATUS_AGE_LIMIT_MAX       (3u)        /* Default of the stack */
+
+#define LINK_STATUS_FILTERS             ( ZB_MSG_FILTER_JOIN_IND | ZB_MSG_FILTER_LEAVE_IND | ZB_MSG_FILTER_STATUS_IND )
+
+#if ( CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX > 255u ) || ( CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN > CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX )
+#error "CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN/MAX not valid (at most 255 s)"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_LinkStatusStats_t stLinkStatusStats;
+static struct ZigBeeT             * pstLinkStatusZigbee;
+static struct ZbTimerT            * pstLinkStatusTimer;
+static uint32_t                     lLinkStatusSignature;     /* Router neighbors at the last tick */
+
+/* Private functions prototypes-----------------------------------------------*/
+static uint32_t LinkStatusSignature     ( uint16_t * piRouters );
+static void     LinkStatusApply         ( uint8_t cPeriod );
+static void     LinkStatusTimerCallback ( struct ZigBeeT * zb, void * arg );
+static void     LinkStatusPrintStats    ( void );
+
+static enum zb_msg_filter_rc LinkStatusEventCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the adaptive Link Status */
+static const SerialCmd_t            astLinkStatusSerialCmds[] =
+{
+  { "LINKSTATS", LinkStatusPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stLinkStatusSerialCmdTable =
+{
+  astLinkStatusSerialCmds, ( sizeof( astLinkStatusSerialCmds ) / sizeof( astLinkStatusSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the adaptive Link Status : shortest period, changes of the mesh listened to, Timer of the ticks.
+ * @param  pstZigbee  Zigbee stack instance
+ * @retval None
+ */
+void APP_ZIGBEE_LinkStatusInit( struct ZigBeeT * pstZigbee )
+{
+  memset( &stLinkStatusStats, 0, sizeof( stLinkStatusStats ) );
+  pstLinkStatusZigbee = pstZigbee;
+  lLinkStatusSignature = 0;
+
+  pstLinkStatusTimer = ZbTimerAlloc( pstZigbee, LinkStatusTimerCallback, NULL );
+  if ( ( pstLinkStatusTimer == NULL ) ||
+       ( ZbMsgFilterRegister( pstZigbee, LINK_STATUS_FILTERS, ( ZB_MSG_INTERNAL_PRIO + 1u ), LinkStatusEventCallback, NULL ) == NULL ) )
+  {
+    LOG_ERROR_APP( "Error, Link Status policy registration failed." );
+    return;
+  }
+
+  LinkStatusApply( CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN );
+  ZbTimerReset( pstLinkStatusTimer, CFG_ZIGBEE_LINK_STATUS_TICK );
+  Serial_CMD_Interpreter_RegisterTable( &stLinkStatusSerialCmdTable );
+}
+
+/**
+ * @brief  Return the state of the adaptive Link Status.
+ * @param  None
+ * @retval State.
+ */
+const APP_ZIGBEE_LinkStatusStats_t * APP_ZIGBEE_LinkStatusGetStats( void )
+{
+  return &stLinkStatusStats;
+}
+
+/**
+ * @brief  Signature of the Router neighbors (addresses and outgoing costs), order independent.
+ * @param  piRouters  Number of Router neighbors
+ * @retval Signature.
+ */
+static uint32_t LinkStatusSignature( uint16_t * piRouters )
+{
+  struct ZbNwkNeighborT   stNeighbor;
+  uint32_t                lSignature = 0, lEntry;
+  uint16_t                iIndex;
+
+  *piRouters = 0;
+  for ( iIndex = 0; ZbNwkGetIndex( pstLinkStatusZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( ( stNeighbor.nwkAddr == ZB_NWK_ADDR_UNDEFINED ) ||
+         ( ( stNeighbor.deviceType != ZB_NWK_NEIGHBOR_TYPE_ROUTER ) && ( stNeighbor.deviceType != ZB_NWK_NEIGHBOR_TYPE_COORD ) ) )
+    {
+      continue;
+    }
+
+    /* Sum of mixed entries : the same set gives the same signature in any order */
+    lEntry = ( ( (uint32_t)stNeighbor.nwkAddr << 8 ) | stNeighbor.outgoingCost );
+    lEntry *= 0x9E3779B1u;
+    lSignature += ( lEntry ^ ( lEntry >> 15 ) );
+    ( *piRouters )++;
+  }
+
+  return lSignature;
+}
+
+/**
+ * @brief  Apply a Link Status period, with the Router age limit that ages a neighbor out after about
+ *         CFG_ZIGBEE_LINK_STATUS_AGE_TIME.
+ * @param  cPeriod  Link Status period (s)
+ * @retval None
+ */
+static void LinkStatusApply( uint8_t cPeriod )
+{
+  uint8_t   cAgeLimit;
+
+  cAgeLimit = (uint8_t)( ( CFG_ZIGBEE_LINK_STATUS_AGE_TIME + cPeriod - 1u ) / cPeriod );
+  if ( cAgeLimit < LINK_STATUS_AGE_LIMIT_MIN )
+  {
+    cAgeLimit = LINK_STATUS_AGE_LIMIT_MIN;
+  }
+  else if ( cAgeLimit > LINK_STATUS_AGE_LIMIT_MAX )
+  {
+    cAgeLimit = LINK_STATUS_AGE_LIMIT_MAX;
+  }
+
+  if ( ( ZbNwkSet( pstLinkStatusZigbee, ZB_NWK_NIB_ID_LinkStatusPeriod, &cPeriod, sizeof( cPeriod ) ) != ZB_STATUS_SUCCESS ) ||
+       ( ZbNwkSet( pstLinkStatusZigbee, ZB_NWK_NIB_ID_RouterAgeLimit, &cAgeLimit, sizeof( cAgeLimit ) ) != ZB_STATUS_SUCCESS ) )
+  {
+    LOG_ERROR_APP( "Error, Link Status period not set." );
+    return;
+  }
+
+  stLinkStatusStats.cPeriod = cPeriod;
+  stLinkStatusStats.cAgeLimit = cAgeLimit;
+}
+
+/**
+ * @brief  Tick of the policy : the period is doubled after CFG_ZIGBEE_LINK_STATUS_STABLE_TICKS ticks with the same
+ *         Router neighbors, and restored to the shortest one when they change.
+ * @param  zb   Zigbee stack instance
+ * @param  arg  Not used
+ * @retval None
+ */
+static void LinkStatusTimerCallback( struct ZigBeeT * zb, void * arg )
+{
+  uint32_t  lSignature, lPeriod;
+  uint16_t  iRouters;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( APP_ZIGBEE_IsAppliJoinNetwork() != false )
+  {
+    lSignature = LinkStatusSignature( &iRouters );
+    if ( ( lSignature != lLinkStatusSignature ) || ( iRouters != stLinkStatusStats.iRouters ) )
+    {
+      if ( stLinkStatusStats.cPeriod != CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN )
+      {
+        stLinkStatusStats.lChanges++;
+        LinkStatusApply( CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN );
+      }
+      stLinkStatusStats.iStableTicks = 0;
+    }
+    else if ( ++stLinkStatusStats.iStableTicks >= CFG_ZIGBEE_LINK_STATUS_STABLE_TICKS )
+    {
+      stLinkStatusStats.iStableTicks = 0;
+      if ( stLinkStatusStats.cPeriod < CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX )
+      {
+        lPeriod = ( (uint32_t)stLinkStatusStats.cPeriod * 2u );
+        LinkStatusApply( (uint8_t)( ( lPeriod > CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX ) ? CFG_ZIGBEE_LINK_STATUS_PERIOD_MAX : lPeriod ) );
+        stLinkStatusStats.lStretches++;
+      }
+    }
+
+    lLinkStatusSignature = lSignature;
+    stLinkStatusStats.iRouters = iRouters;
+  }
+
+  ZbTimerReset( pstLinkStatusTimer, CFG_ZIGBEE_LINK_STATUS_TICK );
+}
+
+/**
+ * @brief  Change of the mesh (join of a Router, leave of a neighbor, link failure) : shortest period at once.
+ * @param  zb         Zigbee stack instance
+ * @param  lId        Message
+ * @param  pMessage   NLME indication
+ * @param  arg        Not used
+ * @retval ZB_MSG_CONTINUE, the indication is always given to the stack.
+ */
+static enum zb_msg_filter_rc LinkStatusEventCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  bool  bChange = false;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  switch ( lId )
+  {
+    case ZB_MSG_FILTER_JOIN_IND:
+      bChange = ( ( ( (const struct ZbNlmeJoinIndT *)pMessage )->capabilityInfo & MCP_ASSOC_CAP_DEV_TYPE ) != 0u );
+      break;
+
+    case ZB_MSG_FILTER_LEAVE_IND:
+      bChange = ( ( (const struct ZbNlmeLeaveIndT *)pMessage )->relationship != ZB_NWK_NEIGHBOR_REL_CHILD );
+      break;
+
+    case ZB_MSG_FILTER_STATUS_IND:
+      bChange = ( ( ( (const struct ZbNlmeNetworkStatusIndT *)pMessage )->status == ZB_NWK_STATUS_CODE_TREE_LINK_FAILURE ) ||
+                  ( ( (const struct ZbNlmeNetworkStatusIndT *)pMessage )->status == ZB_NWK_STATUS_CODE_NON_TREE_LINK_FAILURE ) );
+      break;
+
+    default:
+      break;
+  }
+
+  if ( ( bChange != false ) && ( stLinkStatusStats.cPeriod != CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN ) )
+  {
+    stLinkStatusStats.lChanges++;
+    stLinkStatusStats.iStableTicks = 0;
+    LinkStatusApply( CFG_ZIGBEE_LINK_STATUS_PERIOD_MIN );
+  }
+
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Print the state of the adaptive Link Status.
+ * @param  None
+ * @retval None
+ */
+static void LinkStatusPrintStats( void )
+{
+  LOG_INFO_APP( "Link Status : period %d s, age limit %d, %d Router neighbors stable for %d ticks.", stLinkStatusStats.cPeriod,
+                stLinkStatusStats.cAgeLimit, stLinkStatusStats.iRouters, stLinkStatusStats.iStableTicks );
+  LOG_INFO_APP( "  %d stretches, %d changes of the mesh.", stLinkStatusStats.lStretches, stLinkStatusStats.lChanges );
+}
+
+#else /* (CFG_ZIGBEE_LINK_STATUS_SUPPORTED != 0) */
+
+/**
+ * @brief  Adaptive Link Status not supported.
+ */
+void APP_ZIGBEE_LinkStatusInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Adaptive Link Status not supported : no state.
+ */
+const APP_ZIGBEE_LinkStatusStats_t * APP_ZIGBEE_LinkStatusGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_LINK_STATUS_SUPPORTED != 0) */
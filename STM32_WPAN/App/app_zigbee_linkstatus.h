@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_linkstatus.h
+  * @author  MCD Application Team
+  * @brief   Interface of the adaptive Link Status period of the Router.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_LINKSTATUS_H
+#define APP_ZIGBEE_LINKSTATUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the adaptive Link Status period */
+typedef struct
+{
+  uint8_t     cPeriod;                /* Link Status period (s) */
+  uint8_t     cAgeLimit;              /* Router age limit (periods) */
+  uint16_t    iRouters;               /* Router neighbors at the last tick */
+  uint16_t    iStableTicks;           /* Ticks without change */
+  uint32_t    lChanges;               /* Changes of the mesh (period restored) */
+  uint32_t    lStretches;             /* Period doubled */
+} APP_ZIGBEE_LinkStatusStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_LinkStatusInit         ( struct ZigBeeT * pstZigbee );
+
+const APP_ZIGBEE_LinkStatusStats_t * APP_ZIGBEE_LinkStatusGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_LINKSTATUS_H */
@@ -0,0 +1,401 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_meter.c
+  * @author  MCD Application Team
+  * @brief   Metering Server of the sub-meter : each pulse of the meter is
+  *          time stamped by the TIM2 input capture and written by the DMA in a
+  *          circular ring, without interrupt. The ring is processed by batches
+  *          in the stack context (summation, demand from the pulse period,
+  *          interval accumulation), the attributes being updated once per
+  *          batch : no interrupt per pulse, whatever the pulse rate.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "main.h"
+#include "app_zigbee_meter.h"
+#include "app_zigbee_attr.h"
+
+#include "stm32_lpm.h"
+#include "serial_cmd_interpreter.h"
+
+#include "zcl/zcl.h"
+
+#if (CFG_ZIGBEE_METER_SUPPORTED != 0)
+#include "zcl/se/zcl.meter.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define METER_TIMER                     TIM2
+#define METER_TIMER_FREQUENCY           (1000000u)                  /* Time stamps in us */
+#define METER_DMA_CHANNEL               GPDMA1_Channel6
+#define METER_DMA_REQUEST               GPDMA1_REQUEST_TIM2_CH1
+
+#define METER_RING_MASK                 ( CFG_ZIGBEE_METER_RING_SIZE - 1u )
+#define METER_PROCESS_PERIOD_MIN        (10u)                       /* ms */
+#define METER_DEMAND_MAX                (0x7FFFFF)                  /* InstantaneousDemand, signed 24 bits */
+#define METER_US_PER_HOUR               (3600000000ULL)
+
+#define METER_ATTR( _ID_, _TYPE_ )      APP_ZIGBEE_ATTR_STORE_ENTRY( (_ID_), (_TYPE_), ZCL_ATTR_FLAG_REPORTABLE, 0 )
+
+#if ( ( CFG_ZIGBEE_METER_RING_SIZE & METER_RING_MASK ) != 0 )
+#error "CFG_ZIGBEE_METER_RING_SIZE must be a power of 2"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Optional attributes of the Metering Server, kept in the attribute store */
+static const struct ZbZclAttrT      astMeterAttrList[] =
+{
+  METER_ATTR( ZCL_METER_SVR_ATTR_MULTIPLIER, ZCL_DATATYPE_UNSIGNED_24BIT ),
+  METER_ATTR( ZCL_METER_SVR_ATTR_DIVISOR, ZCL_DATATYPE_UNSIGNED_24BIT ),
+  METER_ATTR( ZCL_METER_SVR_ATTR_DEMAND_FORMAT, ZCL_DATATYPE_BITMAP_8BIT ),
+  METER_ATTR( ZCL_METER_SVR_ATTR_INSTANTANEOUS_DEMAND, ZCL_DATATYPE_SIGNED_24BIT ),
+  METER_ATTR( ZCL_METER_SVR_ATTR_CURPRTL_DELIV, ZCL_DATATYPE_UNSIGNED_32BIT ),
+};
+
+static struct ZbZclClusterT       * pstMeterServer;
+static struct ZbTimerT            * pstMeterTimer;
+static TIM_HandleTypeDef            stMeterTim;
+static DMA_HandleTypeDef            stMeterDma;
+static DMA_NodeTypeDef              stMeterNode;
+static DMA_QListTypeDef             stMeterList;
+static uint32_t                     alMeterRing[CFG_ZIGBEE_METER_RING_SIZE];    /* Time stamps of the pulses */
+static uint32_t                     lMeterRead;             /* Next time stamp to process */
+static uint32_t                     lMeterLastStamp;        /* Time stamp of the last pulse processed */
+static uint32_t                     lMeterLastTick;         /* Tick of the processing of the last pulse */
+static uint32_t                     lMeterIntervalTick;     /* Start of the current interval */
+static bool                         bMeterStamped;          /* A pulse has been processed */
+static APP_ZIGBEE_MeterStats_t      stMeterStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static bool     MeterCaptureInit        ( void );
+static void     MeterProcessCallback    ( struct ZigBeeT * zb, void * arg );
+static void     MeterPrintStats         ( void );
+
+/* Serial commands of the Metering Server */
+static const SerialCmd_t            astMeterSerialCmds[] =
+{
+  { "METERSTATS", MeterPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stMeterSerialCmdTable =
+{
+  astMeterSerialCmds, ( sizeof( astMeterSerialCmds ) / sizeof( astMeterSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Add the Metering Server (electricity, kWh) on the Endpoint, then start the capture of the pulses and their
+ *         processing.
+ * @param  pstZigbee  Zigbee stack instance
+ * @param  cEndpoint  Endpoint of the Server
+ * @retval None
+ */
+void APP_ZIGBEE_MeterInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint )
+{
+  memset( &stMeterStats, 0, sizeof( stMeterStats ) );
+  lMeterRead = 0;
+  bMeterStamped = false;
+
+  pstMeterTimer = ZbTimerAlloc( pstZigbee, MeterProcessCallback, NULL );
+  pstMeterServer = ZbZclMeterServerAlloc( pstZigbee, cEndpoint, NULL, NULL );
+  if ( ( pstMeterTimer == NULL ) || ( pstMeterServer == NULL ) )
+  {
+    LOG_ERROR_APP( "Error, Metering Server allocation failed." );
+    return;
+  }
+
+  if ( ( APP_ZIGBEE_AttrStoreAppend( pstMeterServer, astMeterAttrList, ZCL_ATTR_LIST_LEN( astMeterAttrList ) ) != ZCL_STATUS_SUCCESS ) ||
+       ( ZbZclClusterEndpointRegister( pstMeterServer ) == false ) )
+  {
+    LOG_ERROR_APP( "Error, Metering Server configuration failed." );
+    return;
+  }
+
+  /* Summation in pulses : CFG_ZIGBEE_METER_PULSES_PER_UNIT make one kWh */
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_DEVICE_TYPE, ZCL_METER_TYPE_ELECTRIC );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_UNIT_OF_MEASURE, ZCL_METER_UNITS_BINARY_KWH );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_MULTIPLIER, 1 );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_DIVISOR, CFG_ZIGBEE_METER_PULSES_PER_UNIT );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_SUMMATION_FORMAT, ( 6u << ZCL_METER_FORMAT_OFFSET_INTEGER ) | 3u );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_DEMAND_FORMAT, ( 4u << ZCL_METER_FORMAT_OFFSET_INTEGER ) | 3u );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_CURSUM_DELIV, 0 );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_INSTANTANEOUS_DEMAND, 0 );
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_CURPRTL_DELIV, 0 );
+
+  if ( MeterCaptureInit() == false )
+  {
+    LOG_ERROR_APP( "Error, Metering pulse capture initialization failed." );
+    return;
+  }
+
+  lMeterLastTick = HAL_GetTick();
+  lMeterIntervalTick = lMeterLastTick;
+  ZbTimerReset( pstMeterTimer, CFG_ZIGBEE_METER_PROCESS_PERIOD );
+  Serial_CMD_Interpreter_RegisterTable( &stMeterSerialCmdTable );
+}
+
+/**
+ * @brief  Return the statistics of the Metering Server.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_MeterStats_t * APP_ZIGBEE_MeterGetStats( void )
+{
+  return &stMeterStats;
+}
+
+/**
+ * @brief  TIM2 free running at 1 MHz, its channel 1 capturing the rising edges of the pulses (filtered). Each capture
+ *         requests the DMA, which writes the time stamp in the ring (linked-list with one node, circular), without
+ *         interrupt.
+ * @param  None
+ * @retval True if started.
+ */
+static bool MeterCaptureInit( void )
+{
+  GPIO_InitTypeDef      stGpio = { 0 };
+  TIM_IC_InitTypeDef    stIc = { 0 };
+  DMA_NodeConfTypeDef   stNodeConfig;
+  uint32_t              lClock;
+
+  __HAL_RCC_TIM2_CLK_ENABLE();
+  __HAL_RCC_GPDMA1_CLK_ENABLE();
+  CFG_ZIGBEE_METER_PULSE_GPIO_CLK_ENABLE();
+
+  stGpio.Pin = CFG_ZIGBEE_METER_PULSE_GPIO_PIN;
+  stGpio.Mode = GPIO_MODE_AF_PP;
+  stGpio.Pull = GPIO_NOPULL;
+  stGpio.Speed = GPIO_SPEED_FREQ_LOW;
+  stGpio.Alternate = CFG_ZIGBEE_METER_PULSE_GPIO_AF;
+  HAL_GPIO_Init( CFG_ZIGBEE_METER_PULSE_GPIO_PORT, &stGpio );
+
+  /* Timer clock is twice PCLK1 when APB1 is divided */
+  lClock = HAL_RCC_GetPCLK1Freq();
+  if ( lClock != HAL_RCC_GetHCLKFreq() )
+  {
+    lClock *= 2u;
+  }
+
+  stMeterTim.Instance = METER_TIMER;
+  stMeterTim.Init.Prescaler = ( ( lClock / METER_TIMER_FREQUENCY ) - 1u );
+  stMeterTim.Init.CounterMode = TIM_COUNTERMODE_UP;
+  stMeterTim.Init.Period = 0xFFFFFFFFu;
+  stMeterTim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  stMeterTim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+  stIc.ICPolarity = TIM_ICPOLARITY_RISING;
+  stIc.ICSelection = TIM_ICSELECTION_DIRECTTI;
+  stIc.ICPrescaler = TIM_ICPSC_DIV1;
+  stIc.ICFilter = CFG_ZIGBEE_METER_PULSE_FILTER;
+
+  if ( ( HAL_TIM_IC_Init( &stMeterTim ) != HAL_OK ) ||
+       ( HAL_TIM_IC_ConfigChannel( &stMeterTim, &stIc, TIM_CHANNEL_1 ) != HAL_OK ) )
+  {
+    return false;
+  }
+
+  /* Ring of time stamps : one node looping on itself */
+  stMeterDma.Instance = METER_DMA_CHANNEL;
+  memset( &stNodeConfig, 0, sizeof( stNodeConfig ) );
+  stNodeConfig.NodeType = DMA_GPDMA_LINEAR_NODE;
+  stNodeConfig.Init.Request = METER_DMA_REQUEST;
+  stNodeConfig.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+  stNodeConfig.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  stNodeConfig.Init.SrcInc = DMA_SINC_FIXED;
+  stNodeConfig.Init.DestInc = DMA_DINC_INCREMENTED;
+  stNodeConfig.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_WORD;
+  stNodeConfig.Init.DestDataWidth = DMA_DEST_DATAWIDTH_WORD;
+  stNodeConfig.Init.SrcBurstLength = 1;
+  stNodeConfig.Init.DestBurstLength = 1;
+  stNodeConfig.Init.TransferAllocatedPort = ( DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT0 );
+  stNodeConfig.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  stNodeConfig.Init.Mode = DMA_NORMAL;
+  stNodeConfig.DataHandlingConfig.DataExchange = DMA_EXCHANGE_NONE;
+  stNodeConfig.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+  stNodeConfig.TriggerConfig.TriggerPolarity = DMA_TRIG_POLARITY_MASKED;
+  stNodeConfig.SrcAddress = (uint32_t)&METER_TIMER->CCR1;
+  stNodeConfig.DstAddress = (uint32_t)alMeterRing;
+  stNodeConfig.DataSize = sizeof( alMeterRing );
+
+  memset( &stMeterList, 0, sizeof( stMeterList ) );
+  if ( ( HAL_DMAEx_List_BuildNode( &stNodeConfig, &stMeterNode ) != HAL_OK ) ||
+       ( HAL_DMAEx_List_InsertNode_Tail( &stMeterList, &stMeterNode ) != HAL_OK ) ||
+       ( HAL_DMAEx_List_SetCircularMode( &stMeterList ) != HAL_OK ) )
+  {
+    return false;
+  }
+
+  stMeterDma.InitLinkedList.Priority = DMA_LOW_PRIORITY_HIGH_WEIGHT;
+  stMeterDma.InitLinkedList.LinkStepMode = DMA_LSM_FULL_EXECUTION;
+  stMeterDma.InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT0;
+  stMeterDma.InitLinkedList.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  stMeterDma.InitLinkedList.LinkedListMode = DMA_LINKEDLIST_CIRCULAR;
+  if ( ( HAL_DMAEx_List_Init( &stMeterDma ) != HAL_OK ) || ( HAL_DMAEx_List_LinkQ( &stMeterDma, &stMeterList ) != HAL_OK ) ||
+       ( HAL_DMA_ConfigChannelAttributes( &stMeterDma, DMA_CHANNEL_NPRIV ) != HAL_OK ) ||
+       ( HAL_DMAEx_List_Start( &stMeterDma ) != HAL_OK ) )
+  {
+    return false;
+  }
+
+  /* The timer does not run in Stop mode */
+  UTIL_LPM_SetStopMode( ( 1U << CFG_LPM_METER ), UTIL_LPM_DISABLE );
+
+  __HAL_TIM_ENABLE_DMA( &stMeterTim, TIM_DMA_CC1 );
+  return ( HAL_TIM_IC_Start( &stMeterTim, TIM_CHANNEL_1 ) == HAL_OK );
+}
+
+/**
+ * @brief  Processing of the ring (stack timer) : the pulses time stamped since the previous processing are counted,
+ *         the demand comes from their period, then the attributes are updated once. The next processing comes sooner
+ *         when the pulse rate would fill half of the ring before CFG_ZIGBEE_METER_PROCESS_PERIOD.
+ * @param  zb   Zigbee stack instance
+ * @param  arg  Not used
+ * @retval None
+ */
+static void MeterProcessCallback( struct ZigBeeT * zb, void * arg )
+{
+  uint32_t  lWrite, lPulses, lStamp, lTick, lNext;
+  uint64_t  llPeriodUs = 0;
+  int32_t   lDemand;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  /* Write position of the DMA (remaining bytes of the node) */
+  lWrite = ( ( CFG_ZIGBEE_METER_RING_SIZE - ( __HAL_DMA_GET_COUNTER( &stMeterDma ) / sizeof( uint32_t ) ) ) & METER_RING_MASK );
+  lPulses = ( ( lWrite - lMeterRead ) & METER_RING_MASK );
+  lTick = HAL_GetTick();
+  stMeterStats.lProcessings++;
+
+  if ( lPulses != 0u )
+  {
+    lStamp = alMeterRing[( lWrite - 1u ) & METER_RING_MASK];
+    if ( bMeterStamped != false )
+    {
+      llPeriodUs = ( ( lStamp - lMeterLastStamp ) / lPulses );
+    }
+    else if ( lPulses > 1u )
+    {
+      llPeriodUs = ( ( lStamp - alMeterRing[lMeterRead] ) / ( lPulses - 1u ) );
+    }
+
+    lMeterRead = lWrite;
+    lMeterLastStamp = lStamp;
+    lMeterLastTick = lTick;
+    bMeterStamped = true;
+
+    stMeterStats.llSummation += lPulses;
+    stMeterStats.lInterval += lPulses;
+    if ( lPulses > stMeterStats.lBatchMax )
+    {
+      stMeterStats.lBatchMax = lPulses;
+    }
+    if ( lPulses > ( ( CFG_ZIGBEE_METER_RING_SIZE * 3u ) / 4u ) )
+    {
+      stMeterStats.lNearFull++;
+    }
+  }
+  else if ( bMeterStamped != false )
+  {
+    /* No pulse : the period is at least the time since the last one (the demand decays) */
+    llPeriodUs = ( (uint64_t)( lTick - lMeterLastTick ) * 1000u );
+    if ( llPeriodUs < stMeterStats.lPeriodUs )
+    {
+      llPeriodUs = stMeterStats.lPeriodUs;
+    }
+  }
+
+  if ( llPeriodUs != 0u )
+  {
+    stMeterStats.lPeriodUs = (uint32_t)( ( llPeriodUs > 0xFFFFFFFFu ) ? 0xFFFFFFFFu : llPeriodUs );
+  }
+
+  /* Demand in pulses per hour (same Divisor as the summation) */
+  lDemand = 0;
+  if ( llPeriodUs != 0u )
+  {
+    llPeriodUs = ( METER_US_PER_HOUR / llPeriodUs );
+    lDemand = (int32_t)( ( llPeriodUs > (uint64_t)METER_DEMAND_MAX ) ? METER_DEMAND_MAX : llPeriodUs );
+  }
+
+  /* Interval accumulation */
+  if ( ( lTick - lMeterIntervalTick ) >= ( CFG_ZIGBEE_METER_INTERVAL * 1000u ) )
+  {
+    stMeterStats.lLastInterval = stMeterStats.lInterval;
+    stMeterStats.lInterval = 0;
+    lMeterIntervalTick += ( CFG_ZIGBEE_METER_INTERVAL * 1000u );
+  }
+
+  /* Attributes updated once per batch */
+  if ( lPulses != 0u )
+  {
+    (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_CURSUM_DELIV, (long long)stMeterStats.llSummation );
+  }
+  if ( lDemand != stMeterStats.lDemand )
+  {
+    stMeterStats.lDemand = lDemand;
+    (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_INSTANTANEOUS_DEMAND, lDemand );
+  }
+  (void)ZbZclAttrIntegerWrite( pstMeterServer, ZCL_METER_SVR_ATTR_CURPRTL_DELIV, stMeterStats.lInterval );
+
+  /* Next processing before half of the ring is filled at the current rate */
+  lNext = CFG_ZIGBEE_METER_PROCESS_PERIOD;
+  if ( ( lPulses != 0u ) && ( stMeterStats.lPeriodUs != 0u ) )
+  {
+    llPeriodUs = ( ( (uint64_t)stMeterStats.lPeriodUs * ( CFG_ZIGBEE_METER_RING_SIZE / 2u ) ) / 1000u );
+    if ( llPeriodUs < lNext )
+    {
+      lNext = ( ( llPeriodUs > METER_PROCESS_PERIOD_MIN ) ? (uint32_t)llPeriodUs : METER_PROCESS_PERIOD_MIN );
+    }
+  }
+  ZbTimerReset( pstMeterTimer, lNext );
+}
+
+/**
+ * @brief  Print the statistics of the Metering Server.
+ * @param  None
+ * @retval None
+ */
+static void MeterPrintStats( void )
+{
+  LOG_INFO_APP( "Meter : %d pulses, demand %d pulses/h (period %d us), interval %d (last %d).",
+                (uint32_t)stMeterStats.llSummation, stMeterStats.lDemand, stMeterStats.lPeriodUs, stMeterStats.lInterval,
+                stMeterStats.lLastInterval );
+  LOG_INFO_APP( "  %d processings, batch max %d pulses, %d near full (ring %d).", stMeterStats.lProcessings,
+                stMeterStats.lBatchMax, stMeterStats.lNearFull, CFG_ZIGBEE_METER_RING_SIZE );
+}
+
+#else /* (CFG_ZIGBEE_METER_SUPPORTED != 0) */
+
+/**
+ * @brief  Metering Server not supported.
+ */
+void APP_ZIGBEE_MeterInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+}
+
+/**
+ * @brief  Metering Server not supported : no statistics.
+ */
+const APP_ZIGBEE_MeterStats_t * APP_ZIGBEE_MeterGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_METER_SUPPORTED != 0) */
@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_meter.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Metering Server of the sub-meter (pulses time
+  *          stamped by DMA, processed by batches).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_METER_H
+#define APP_ZIGBEE_METER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the Metering Server */
+typedef struct
+{
+  uint64_t    llSummation;            /* Pulses counted (CurrentSummationDelivered) */
+  uint32_t    lProcessings;           /* Processings of the ring */
+  uint32_t    lBatchMax;              /* Most pulses in one processing */
+  uint32_t    lNearFull;              /* Processings with the ring filled above 3/4 (pulse rate to check) */
+  uint32_t    lPeriodUs;              /* Last pulse period (us), 0 if unknown */
+  int32_t     lDemand;                /* InstantaneousDemand (pulses per hour) */
+  uint32_t    lInterval;              /* Pulses of the current interval */
+  uint32_t    lLastInterval;          /* Pulses of the last complete interval */
+} APP_ZIGBEE_MeterStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_MeterInit              ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint );
+
+const APP_ZIGBEE_MeterStats_t * APP_ZIGBEE_MeterGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_METER_H */
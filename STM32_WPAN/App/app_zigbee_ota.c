@@ -0,0 +1,1052 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_ota.c
+  * @author  MCD Application Team
+  * @brief   Streaming OTA Upgrade Client : the image blocks are copied in two
+  *          alternate RAM buffers, each full buffer being written in the download
+  *          area by the Flash Manager while the other one is filled, and the image
+  *          hash (and the SHA-256 of the signed firmware) is computed as the blocks
+  *          arrive.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_manager.h"
+#include "flash_driver.h"
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_entry.h"
+#include "app_zigbee_ota.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.hash.h"
+#include "zcl/zcl.h"
+#include "zcl/general/zcl.ota.h"
+
+#if (CFG_ZIGBEE_OTA_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define OTA_MANUFACTURER_CODE           (0x1041u)               /* STMicroelectronics */
+#define OTA_IMAGE_TYPE                  (0x0001u)               /* Zigbee Router OnOff */
+#define OTA_FILE_VERSION                (0x00000015u)           /* Version of the running image */
+#define OTA_HARDWARE_VERSION            (0x0100u)
+
+#define OTA_BLOCK_MAX                   (255u)                  /* Largest block given by the write_image callback */
+#define OTA_FLASH_ALIGNMENT             (16u)                   /* Flash writes are done per 128 bits */
+#define OTA_BUFFER_NB                   (2u)
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+#define OTA_TAG_ECDSA_P256              (0xF000u)               /* Manufacturer tag : ECDSA P-256 signature (r, s) */
+#define OTA_SIGNATURE_LEN               (64u)
+#define OTA_SHA256_LEN                  (32u)
+#define OTA_HASH_TIMEOUT                (10u)                   /* ms */
+
+/* Public key of the image signer (X then Y, big-endian). Test key of private key 1 (the P-256 base point) : to be
+ * replaced by the manufacturer key */
+#define OTA_SIGNER_PUBLIC_KEY \
+  { 0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2, \
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96, \
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16, \
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5 }
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+#if !defined(FLASH_DBANK_SUPPORT)
+#error "CFG_ZIGBEE_OTA_AB_SUPPORTED needs a dual bank flash"
+#endif /* !defined(FLASH_DBANK_SUPPORT) */
+
+#define OTA_AB_DATA_ADDRESS             ( CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS + CFG_ZIGBEE_OTA_DOWNLOAD_SIZE )
+#define OTA_AB_TRIAL_MAGIC              (0x4F544100u)           /* "OTA" + boots on trial in the low byte */
+#define OTA_AB_ROLLBACK_MAGIC           (0x4F54524Bu)           /* "OTRK" : banks swapped back */
+#define OTA_AB_RECORD_NONE              (0x00000000u)
+#define OTA_AB_FLASH_WORD_SIZE          (16u)
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  OTA_FLASH_IDLE,
+  OTA_FLASH_ERASE,
+  OTA_FLASH_WRITE,
+} OtaFlashState_t;
+
+typedef struct
+{
+  uint32_t    alData[CFG_ZIGBEE_OTA_BUFFER_SIZE / sizeof( uint32_t )];
+  uint16_t    iLength;                /* Bytes copied in the buffer */
+  bool        bFull;                  /* Buffer given to the flash, not yet written */
+} OtaBuffer_t;
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+typedef enum
+{
+  OTA_SIGN_NONE,                      /* Signature tag not (fully) received */
+  OTA_SIGN_PENDING,                   /* PKA verification queued */
+  OTA_SIGN_VALID,
+  OTA_SIGN_INVALID,
+} OtaSignState_t;
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZbZclClusterT       * pstOtaClient;
+static OtaBuffer_t                astOtaBuffer[OTA_BUFFER_NB];
+static uint8_t                    cOtaFillIndex;          /* Buffer receiving the blocks */
+static uint8_t                    cOtaWriteIndex;         /* Next buffer to write in flash */
+static OtaFlashState_t            eOtaFlashState;
+static uint32_t                   lOtaErasedSize;         /* Bytes of the download area already erased */
+static bool                       bOtaWaitForData;        /* Client waiting for a free buffer */
+static bool                       bOtaResumePending;      /* Client paused after a block failure */
+static uint8_t                    cOtaRetries;            /* Consecutive block failures */
+static struct ZbHash              stOtaHash;
+static uint8_t                    acOtaIntegrityCode[ZCL_OTA_INTEGRITY_CODE_LEN];
+static bool                       bOtaIntegrityCode;
+static APP_ZIGBEE_OtaState_t      stOtaState;
+static FM_FlashOpNode_t           stOtaFlashOp;
+static UTIL_TIMER_Object_t        stOtaRetryTimer;
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+static UTIL_TIMER_Object_t        stOtaConfirmTimer;
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+
+static void (*pfOtaDefaultQueryNext)( struct ZbZclClusterT * cluster, enum ZclStatusCodeT status,
+                                      struct ZbZclOtaImageDefinition * image_definition, uint32_t image_size, void * arg );
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+static const uint8_t              acOtaSignerKey[2u * OTA_SHA256_LEN] = OTA_SIGNER_PUBLIC_KEY;
+static HASH_HandleTypeDef         stOtaSha256;
+static uint8_t                    acOtaSignature[OTA_SIGNATURE_LEN];
+static uint8_t                    cOtaSignatureLength;    /* Bytes of the signature tag received */
+static volatile OtaSignState_t    eOtaSignState;
+static uint32_t                   alOtaSignE[8];          /* PKA operands (least significant word first) */
+static uint32_t                   alOtaSignR[8];
+static uint32_t                   alOtaSignS[8];
+static uint32_t                   alOtaSignQx[8];
+static uint32_t                   alOtaSignQy[8];
+static HW_PKA_P256_ECDSA_VERIF_JOB_T  stOtaSignJob;
+
+static enum ZclStatusCodeT (*pfOtaDefaultWriteTag)( struct ZbZclClusterT * cluster, struct ZbZclOtaHeader * header,
+                                                    uint16_t tag_id, uint32_t tag_length, uint8_t data_length,
+                                                    uint8_t * data, void * arg );
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     OtaTask                 ( void );
+static void     OtaReset                ( void );
+static void     OtaFlashProcess         ( void );
+static void     OtaFlashCallback        ( FM_FlashOp_Status_t eStatus );
+static void     OtaRetryTimerElapsed    ( void * arg );
+static bool     OtaMustWait             ( void );
+
+static void     OtaQueryNextCallback    ( struct ZbZclClusterT * pstCluster, enum ZclStatusCodeT eStatus,
+                                          struct ZbZclOtaImageDefinition * pstImage, uint32_t lImageSize, void * arg );
+static enum ZclStatusCodeT OtaUpdateRawCallback     ( struct ZbZclClusterT * pstCluster, uint8_t cLength, uint8_t * pData, void * arg );
+static enum ZclStatusCodeT OtaWriteImageCallback    ( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                                      uint8_t cLength, uint8_t * pData, void * arg );
+static void     OtaIntegrityCodeCallback( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                          uint8_t cLength, uint8_t * pData, void * arg );
+static enum ZclStatusCodeT OtaImageValidateCallback ( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader, void * arg );
+static void     OtaRebootCallback       ( struct ZbZclClusterT * pstCluster, void * arg );
+static enum ZclStatusCodeT OtaAbortCallback         ( struct ZbZclClusterT * pstCluster, enum ZbZclOtaCommandId eCommandId, void * arg );
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+static void     OtaSha256Update         ( const OtaBuffer_t * pstBuffer );
+static void     OtaSignatureVerify      ( void );
+static void     OtaSignatureCallback    ( HW_PKA_JOB_T * pstJob );
+static enum ZclStatusCodeT OtaWriteTagCallback      ( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                                      uint16_t iTagId, uint32_t lTagLength, uint8_t cLength,
+                                                      uint8_t * pData, void * arg );
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+extern RTC_HandleTypeDef          hrtc;
+
+static bool     OtaBankActivate         ( uint32_t lRecord );
+static bool     OtaBankCopyData         ( void );
+static void     OtaConfirmTimerElapsed  ( void * arg );
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Allocate the OTA Upgrade Client, with the streaming callbacks, and its Task.
+ * @param  pstZigbee    Zigbee stack handler
+ * @param  cEndpoint    Endpoint of the Client
+ * @param  iProfileId   Profile of the Endpoint
+ * @retval None
+ */
+void APP_ZIGBEE_OtaInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  struct ZbZclOtaClientConfig   stConfig;
+
+  memset( &stConfig, 0, sizeof( stConfig ) );
+  stConfig.profile_id = iProfileId;
+  stConfig.endpoint = cEndpoint;
+  stConfig.activation_policy = ZCL_OTA_ACTIVATION_POLICY_SERVER;
+  stConfig.timeout_policy = ZCL_OTA_TIMEOUT_POLICY_APPLY_UPGRADE;
+  stConfig.image_block_delay = 0u;
+  stConfig.hardware_version = OTA_HARDWARE_VERSION;
+
+  stConfig.current_image.manufacturer_code = OTA_MANUFACTURER_CODE;
+  stConfig.current_image.image_type = OTA_IMAGE_TYPE;
+  stConfig.current_image.file_version = OTA_FILE_VERSION;
+  stConfig.current_image.stack_version = ZCL_OTA_STACK_VERSION_PRO;
+
+  /* Default handlers for the discovery, notify and tags. The image data, its hash and the pauses are handled here */
+  ZbZclOtaClientGetDefaultCallbacks( &stConfig.callbacks );
+  pfOtaDefaultQueryNext = stConfig.callbacks.query_next;
+  stConfig.callbacks.query_next = OtaQueryNextCallback;
+  stConfig.callbacks.update_raw = OtaUpdateRawCallback;
+  stConfig.callbacks.write_image = OtaWriteImageCallback;
+  stConfig.callbacks.integrity_code = OtaIntegrityCodeCallback;
+  stConfig.callbacks.image_validate = OtaImageValidateCallback;
+  stConfig.callbacks.reboot = OtaRebootCallback;
+  stConfig.callbacks.abort_download = OtaAbortCallback;
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+  /* Signature tag captured here, the other tags (image data) given to the default handler */
+  pfOtaDefaultWriteTag = stConfig.callbacks.write_tag;
+  stConfig.callbacks.write_tag = OtaWriteTagCallback;
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+  pstOtaClient = ZbZclOtaClientAlloc( pstZigbee, &stConfig, NULL );
+  if ( pstOtaClient == NULL )
+  {
+    LOG_ERROR_APP( "Error, OTA Client allocation failed." );
+    return;
+  }
+  ZbZclClusterEndpointRegister( pstOtaClient );
+
+  stOtaFlashOp.Callback = OtaFlashCallback;
+  UTIL_TIMER_Create( &stOtaRetryTimer, 0, UTIL_TIMER_ONESHOT, &OtaRetryTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA ), UTIL_SEQ_RFU, OtaTask );
+}
+
+/**
+ * @brief  Discover an OTA Upgrade Server on the Network. The default handlers then query and download a new image.
+ * @param  None
+ * @retval True if the discovery is launched.
+ */
+bool APP_ZIGBEE_OtaStart( void )
+{
+  struct ZbApsAddrT   stDest;
+
+  if ( ( pstOtaClient == NULL ) || ( stOtaState.bInProgress != false ) )
+  {
+    return false;
+  }
+
+  memset( &stDest, 0, sizeof( stDest ) );
+  stDest.mode = ZB_APSDE_ADDRMODE_SHORT;
+  stDest.nwkAddr = ZB_NWK_ADDR_BCAST_RXON;
+  stDest.endpoint = ZB_ENDPOINT_BCAST;
+
+  return ( ZbZclOtaClientDiscover( pstOtaClient, &stDest ) == ZCL_STATUS_SUCCESS );
+}
+
+/**
+ * @brief  State of the OTA download.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_OtaState_t * APP_ZIGBEE_OtaGetState( void )
+{
+  return &stOtaState;
+}
+
+/**
+ * @brief  Restart the pipeline and the hash for a new image.
+ * @param  None
+ * @retval None
+ */
+static void OtaReset( void )
+{
+  memset( astOtaBuffer, 0, sizeof( astOtaBuffer ) );
+  cOtaFillIndex = 0;
+  cOtaWriteIndex = 0;
+  lOtaErasedSize = 0;
+  bOtaWaitForData = false;
+  bOtaResumePending = false;
+  cOtaRetries = 0;
+  bOtaIntegrityCode = false;
+  ZbHashInit( &stOtaHash );
+
+  stOtaState.lImageSize = 0;
+  stOtaState.lFlashSize = 0;
+  stOtaState.lBlocks = 0;
+  stOtaState.lWaits = 0;
+  stOtaState.lRetries = 0;
+  stOtaState.lStartTime = HAL_GetTick();
+  stOtaState.bInProgress = true;
+  stOtaState.bVerified = false;
+  stOtaState.bError = false;
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+  /* SHA-256 of the firmware, updated by the HASH on each buffer given to the flash */
+  stOtaState.lSignatureTime = 0;
+  stOtaState.bSigned = false;
+  cOtaSignatureLength = 0;
+  eOtaSignState = OTA_SIGN_NONE;
+  (void)HAL_HASH_DeInit( &stOtaSha256 );
+  stOtaSha256.Instance = HASH;
+  stOtaSha256.Init.DataType = HASH_BYTE_SWAP;
+  stOtaSha256.Init.Algorithm = HASH_ALGOSELECTION_SHA256;
+  if ( HAL_HASH_Init( &stOtaSha256 ) != HAL_OK )
+  {
+    stOtaState.bError = true;
+  }
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  /* Blocks hashed and copied at the PLL clock until the end of the download */
+  APPE_CLK_SetBoost( ( 1U << CFG_SCM_BOOST_OTA ), true );
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+}
+
+/**
+ * @brief  Indicate if the next block could not be copied : the buffer being filled has not room for a whole block
+ *         and the other one is still being written in flash.
+ * @param  None
+ * @retval True if the Client shall wait.
+ */
+static bool OtaMustWait( void )
+{
+  const OtaBuffer_t   * pstFill = &astOtaBuffer[cOtaFillIndex];
+
+  return ( ( pstFill->bFull != false ) ||
+           ( ( ( CFG_ZIGBEE_OTA_BUFFER_SIZE - pstFill->iLength ) < OTA_BLOCK_MAX ) && ( astOtaBuffer[cOtaFillIndex ^ 1u].bFull != false ) ) );
+}
+
+/**
+ * @brief  OTA Task : start the next flash operation, and resume the Client when it can send a new block.
+ * @param  None
+ * @retval None
+ */
+static void OtaTask( void )
+{
+  OtaFlashProcess();
+
+  if ( ( bOtaWaitForData != false ) && ( OtaMustWait() == false ) )
+  {
+    bOtaWaitForData = false;
+    (void)ZbZclOtaClientImageTransferResume( pstOtaClient );
+  }
+
+  if ( bOtaResumePending != false )
+  {
+    bOtaResumePending = false;
+    (void)ZbZclOtaClientImageTransferResume( pstOtaClient );
+  }
+}
+
+/**
+ * @brief  Start the next flash operation of the pipeline : erase the next page of the download area when needed,
+ *         else write the next full buffer.
+ * @param  None
+ * @retval None
+ */
+static void OtaFlashProcess( void )
+{
+  OtaBuffer_t         * pstBuffer = &astOtaBuffer[cOtaWriteIndex];
+  FM_Cmd_Status_t     eStatus;
+  uint32_t            lSize;
+
+  if ( ( eOtaFlashState != OTA_FLASH_IDLE ) || ( pstBuffer->bFull == false ) || ( stOtaState.bError != false ) )
+  {
+    return;
+  }
+
+  lSize = ( ( (uint32_t)pstBuffer->iLength + OTA_FLASH_ALIGNMENT - 1u ) & ~( OTA_FLASH_ALIGNMENT - 1u ) );
+  if ( ( stOtaState.lFlashSize + lSize ) > lOtaErasedSize )
+  {
+    eOtaFlashState = OTA_FLASH_ERASE;
+    eStatus = FM_QueueErase( ( ( CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS + lOtaErasedSize - FLASH_BASE ) / FLASH_PAGE_SIZE ), 1u,
+                             FM_PRIORITY_OTA, &stOtaFlashOp );
+  }
+  else
+  {
+    eOtaFlashState = OTA_FLASH_WRITE;
+    eStatus = FM_QueueWrite( pstBuffer->alData, (uint32_t *)( CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS + stOtaState.lFlashSize ),
+                             (int32_t)( lSize / sizeof( uint32_t ) ), FM_PRIORITY_OTA, &stOtaFlashOp );
+  }
+
+  /* One operation at a time : the queue of the class is never full */
+  if ( eStatus != FM_OK )
+  {
+    LOG_ERROR_APP( "[OTA] Error, flash operation refused at offset 0x%08X.", stOtaState.lFlashSize );
+    eOtaFlashState = OTA_FLASH_IDLE;
+    stOtaState.bError = true;
+  }
+}
+
+/**
+ * @brief  Flash Manager callback : end of a queued erase/write.
+ * @param  eStatus  Flash operation status
+ * @retval None
+ */
+static void OtaFlashCallback( FM_FlashOp_Status_t eStatus )
+{
+  OtaBuffer_t   * pstBuffer = &astOtaBuffer[cOtaWriteIndex];
+
+  if ( eStatus == FM_OPERATION_COMPLETE )
+  {
+    if ( eOtaFlashState == OTA_FLASH_ERASE )
+    {
+      lOtaErasedSize += FLASH_PAGE_SIZE;
+    }
+    else if ( eOtaFlashState == OTA_FLASH_WRITE )
+    {
+      stOtaState.lFlashSize += ( ( (uint32_t)pstBuffer->iLength + OTA_FLASH_ALIGNMENT - 1u ) & ~( OTA_FLASH_ALIGNMENT - 1u ) );
+      pstBuffer->iLength = 0;
+      pstBuffer->bFull = false;
+      cOtaWriteIndex ^= 1u;
+    }
+  }
+
+  eOtaFlashState = OTA_FLASH_IDLE;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA ), TASK_PRIO_ZIGBEE_OTA );
+}
+
+/**
+ * @brief  Query Next Image Response : a new image will be downloaded.
+ * @param  pstCluster   OTA Client
+ * @param  eStatus      Status of the response
+ * @param  pstImage     Image proposed by the Server
+ * @param  lImageSize   Size of the OTA file
+ * @param  arg          Application argument
+ * @retval None
+ */
+static void OtaQueryNextCallback( struct ZbZclClusterT * pstCluster, enum ZclStatusCodeT eStatus,
+                                  struct ZbZclOtaImageDefinition * pstImage, uint32_t lImageSize, void * arg )
+{
+  if ( eStatus == ZCL_STATUS_SUCCESS )
+  {
+    if ( ( lImageSize > CFG_ZIGBEE_OTA_DOWNLOAD_SIZE ) || ( eOtaFlashState != OTA_FLASH_IDLE ) )
+    {
+      LOG_ERROR_APP( "[OTA] Error, image of %d bytes refused.", lImageSize );
+      return;
+    }
+
+    LOG_INFO_APP( "[OTA] Download of version 0x%08X (%d bytes).", pstImage->file_version, lImageSize );
+    OtaReset();
+  }
+
+  if ( pfOtaDefaultQueryNext != NULL )
+  {
+    pfOtaDefaultQueryNext( pstCluster, eStatus, pstImage, lImageSize, arg );
+  }
+}
+
+/**
+ * @brief  Raw OTA file data (header and tags up to the Integrity Code) : the hash is updated as the blocks arrive.
+ * @param  pstCluster   OTA Client
+ * @param  cLength      Length of the data
+ * @param  pData        Data
+ * @param  arg          Application argument
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT OtaUpdateRawCallback( struct ZbZclClusterT * pstCluster, uint8_t cLength, uint8_t * pData, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( arg );
+
+  return ( ( ZbHashAdd( &stOtaHash, pData, cLength ) != false ) ? ZCL_STATUS_SUCCESS : ZCL_STATUS_FAILURE );
+}
+
+/**
+ * @brief  Firmware data of the image : copied in the buffer being filled, which is given to the flash once full.
+ * @param  pstCluster   OTA Client
+ * @param  pstHeader    OTA header of the image
+ * @param  cLength      Length of the data
+ * @param  pData        Data
+ * @param  arg          Application argument
+ * @retval ZCL_STATUS_SUCCESS for the next block, ZCL_STATUS_WAIT_FOR_DATA if no buffer is free, else an error.
+ */
+static enum ZclStatusCodeT OtaWriteImageCallback( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                                  uint8_t cLength, uint8_t * pData, void * arg )
+{
+  OtaBuffer_t   * pstBuffer;
+  uint16_t      iCopy;
+
+  UNUSED( pstCluster );
+  UNUSED( pstHeader );
+  UNUSED( arg );
+
+  if ( ( stOtaState.bError != false ) || ( ( stOtaState.lImageSize + cLength ) > CFG_ZIGBEE_OTA_DOWNLOAD_SIZE ) )
+  {
+    return ZCL_STATUS_FAILURE;
+  }
+
+  stOtaState.lBlocks++;
+  stOtaState.lImageSize += cLength;
+  cOtaRetries = 0;
+
+  while ( cLength != 0u )
+  {
+    pstBuffer = &astOtaBuffer[cOtaFillIndex];
+    iCopy = CFG_ZIGBEE_OTA_BUFFER_SIZE - pstBuffer->iLength;
+    if ( iCopy > cLength )
+    {
+      iCopy = cLength;
+    }
+
+    memcpy( &( (uint8_t *)pstBuffer->alData )[pstBuffer->iLength], pData, iCopy );
+    pstBuffer->iLength += iCopy;
+    pData += iCopy;
+    cLength -= (uint8_t)iCopy;
+
+    if ( pstBuffer->iLength == CFG_ZIGBEE_OTA_BUFFER_SIZE )
+    {
+      /* Buffer full : written while the other one is filled */
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+      OtaSha256Update( pstBuffer );
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+      pstBuffer->bFull = true;
+      cOtaFillIndex ^= 1u;
+      UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA ), TASK_PRIO_ZIGBEE_OTA );
+    }
+  }
+
+  if ( OtaMustWait() != false )
+  {
+    stOtaState.lWaits++;
+    bOtaWaitForData = true;
+    return ZCL_STATUS_WAIT_FOR_DATA;
+  }
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Integrity Code of the OTA file (AES-MMO hash of the data before it).
+ * @param  pstCluster   OTA Client
+ * @param  pstHeader    OTA header of the image
+ * @param  cLength      Length of the code
+ * @param  pData        Code
+ * @param  arg          Application argument
+ * @retval None
+ */
+static void OtaIntegrityCodeCallback( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                      uint8_t cLength, uint8_t * pData, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstHeader );
+  UNUSED( arg );
+
+  if ( cLength == ZCL_OTA_INTEGRITY_CODE_LEN )
+  {
+    memcpy( acOtaIntegrityCode, pData, ZCL_OTA_INTEGRITY_CODE_LEN );
+    bOtaIntegrityCode = true;
+  }
+}
+
+/**
+ * @brief  End of the download : the hash computed on the fly is compared to the Integrity Code (no re-read of the
+ *         flash), and the last partial buffer is given to the flash.
+ * @param  pstCluster   OTA Client
+ * @param  pstHeader    OTA header of the image
+ * @param  arg          Application argument
+ * @retval ZCL_STATUS_SUCCESS or ZCL_STATUS_INVALID_IMAGE
+ */
+static enum ZclStatusCodeT OtaImageValidateCallback( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader, void * arg )
+{
+  uint8_t   acDigest[ZCL_OTA_INTEGRITY_CODE_LEN];
+  uint8_t   cPadding;
+
+  UNUSED( pstCluster );
+  UNUSED( arg );
+
+  /* Last partial buffer, padded with erased flash value */
+  if ( ( astOtaBuffer[cOtaFillIndex].bFull == false ) && ( astOtaBuffer[cOtaFillIndex].iLength != 0u ) )
+  {
+    cPadding = (uint8_t)( ( OTA_FLASH_ALIGNMENT - ( astOtaBuffer[cOtaFillIndex].iLength % OTA_FLASH_ALIGNMENT ) ) % OTA_FLASH_ALIGNMENT );
+    memset( &( (uint8_t *)astOtaBuffer[cOtaFillIndex].alData )[astOtaBuffer[cOtaFillIndex].iLength], 0xFF, cPadding );
+    astOtaBuffer[cOtaFillIndex].bFull = true;
+    cOtaFillIndex ^= 1u;
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA ), TASK_PRIO_ZIGBEE_OTA );
+  }
+
+  stOtaState.lDuration = HAL_GetTick() - stOtaState.lStartTime;
+  stOtaState.bInProgress = false;
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  APPE_CLK_SetBoost( ( 1U << CFG_SCM_BOOST_OTA ), false );
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+  if ( bOtaIntegrityCode == false )
+  {
+    LOG_ERROR_APP( "[OTA] Error, image of version 0x%08X has no Integrity Code.", pstHeader->file_version );
+    stOtaState.bError = true;
+    return ZCL_STATUS_INVALID_IMAGE;
+  }
+
+  ZbHashDigest( &stOtaHash, acDigest );
+  if ( ( memcmp( acDigest, acOtaIntegrityCode, ZCL_OTA_INTEGRITY_CODE_LEN ) != 0 ) || ( stOtaState.bError != false ) )
+  {
+    LOG_ERROR_APP( "[OTA] Error, image of version 0x%08X is invalid.", pstHeader->file_version );
+    stOtaState.bError = true;
+    return ZCL_STATUS_INVALID_IMAGE;
+  }
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+  /* The verification was queued on the signature tag, usually already done : else run the PKA jobs to its end */
+  while ( eOtaSignState == OTA_SIGN_PENDING )
+  {
+    HW_PKA_Process();
+  }
+
+  if ( eOtaSignState != OTA_SIGN_VALID )
+  {
+    LOG_ERROR_APP( "[OTA] Error, image of version 0x%08X has %s signature.", pstHeader->file_version,
+                   ( ( eOtaSignState == OTA_SIGN_NONE ) ? "no" : "an invalid" ) );
+    stOtaState.bError = true;
+    return ZCL_STATUS_INVALID_IMAGE;
+  }
+  stOtaState.bSigned = true;
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+  stOtaState.bVerified = true;
+  LOG_INFO_APP( "[OTA] Image of version 0x%08X verified : %d bytes in %d ms (%d waits for the flash).",
+                pstHeader->file_version, stOtaState.lImageSize, stOtaState.lDuration, stOtaState.lWaits );
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Upgrade time reached (default 'upgrade_end' handler) : the verified image is in the download area, its
+ *         installation is done by the bootloader.
+ * @param  pstCluster   OTA Client
+ * @param  arg          Application argument
+ * @retval None
+ */
+static void OtaRebootCallback( struct ZbZclClusterT * pstCluster, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( arg );
+
+  if ( ( stOtaState.bVerified == false ) || ( stOtaState.bError != false ) || ( eOtaFlashState != OTA_FLASH_IDLE ) )
+  {
+    LOG_ERROR_APP( "[OTA] Error, no valid image to install." );
+    return;
+  }
+
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+  LOG_INFO_APP( "[OTA] Image ready in the inactive bank (%d bytes) : bank swap and reboot.", stOtaState.lFlashSize );
+  if ( OtaBankActivate( OTA_AB_TRIAL_MAGIC ) == false )
+  {
+    LOG_ERROR_APP( "[OTA] Error, image not activated." );
+  }
+#else /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+  LOG_INFO_APP( "[OTA] Image ready at 0x%08X (%d bytes), to be installed at the next reboot.",
+                CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS, stOtaState.lFlashSize );
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+}
+
+/**
+ * @brief  Problem on the download : a failed Image Block is retried after a growing delay, then the download is
+ *         aborted.
+ * @param  pstCluster   OTA Client
+ * @param  eCommandId   OTA command at the origin of the problem
+ * @param  arg          Application argument
+ * @retval ZCL_STATUS_FAILURE to pause the transfer, ZCL_STATUS_SUCCESS to abort it.
+ */
+static enum ZclStatusCodeT OtaAbortCallback( struct ZbZclClusterT * pstCluster, enum ZbZclOtaCommandId eCommandId, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( arg );
+
+  if ( ( eCommandId == ZCL_OTA_COMMAND_IMAGE_BLOCK_REQUEST ) && ( cOtaRetries < CFG_ZIGBEE_OTA_RETRY_MAX ) && ( stOtaState.bError == false ) )
+  {
+    /* Pause, and leave the link to recover before the next Image Block Request */
+    stOtaState.lRetries++;
+    UTIL_TIMER_StartWithPeriod( &stOtaRetryTimer, ( CFG_ZIGBEE_OTA_RETRY_DELAY << cOtaRetries ) );
+    cOtaRetries++;
+    return ZCL_STATUS_FAILURE;
+  }
+
+  LOG_ERROR_APP( "[OTA] Error, download aborted (command 0x%02X) after %d bytes.", eCommandId, stOtaState.lImageSize );
+  stOtaState.bInProgress = false;
+  stOtaState.bError = true;
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+  (void)HAL_HASH_DeInit( &stOtaSha256 );
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+#if (CFG_SCM_GOVERNOR_SUPPORTED != 0)
+  APPE_CLK_SetBoost( ( 1U << CFG_SCM_BOOST_OTA ), false );
+#endif /* (CFG_SCM_GOVERNOR_SUPPORTED != 0) */
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Callback triggered at the end of the delay before a retry
+ * @param  arg : Not used
+ * @retval None
+ */
+static void OtaRetryTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  bOtaResumePending = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_OTA ), TASK_PRIO_ZIGBEE_OTA );
+}
+
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+/**
+ * @brief  Boot of an image activated by a bank swap : on trial until it runs CFG_ZIGBEE_OTA_AB_CONFIRM_DELAY, the
+ *         banks are swapped back after CFG_ZIGBEE_OTA_AB_TRIAL_BOOTS resets on trial. To be called early at boot.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_OtaBootCheck( void )
+{
+  uint32_t  lRecord = HAL_RTCEx_BKUPRead( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER );
+  uint32_t  lBoots;
+
+  if ( lRecord == OTA_AB_ROLLBACK_MAGIC )
+  {
+    LOG_ERROR_APP( "[OTA] Error, the new image did not start : back to the previous image." );
+    HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, OTA_AB_RECORD_NONE );
+    return;
+  }
+
+  if ( ( lRecord & ~0xFFu ) != OTA_AB_TRIAL_MAGIC )
+  {
+    return;
+  }
+
+  lBoots = ( lRecord & 0xFFu ) + 1u;
+  if ( lBoots > CFG_ZIGBEE_OTA_AB_TRIAL_BOOTS )
+  {
+    LOG_ERROR_APP( "[OTA] Error, %d resets on trial : swap back to the previous image.", ( lBoots - 1u ) );
+    if ( OtaBankActivate( OTA_AB_ROLLBACK_MAGIC ) == false )
+    {
+      /* Keep this image rather than retrying the swap at each boot */
+      LOG_ERROR_APP( "[OTA] Error, previous image not activated." );
+      HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, OTA_AB_RECORD_NONE );
+    }
+    return;
+  }
+
+  HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, ( OTA_AB_TRIAL_MAGIC | lBoots ) );
+  LOG_INFO_APP( "[OTA] New image on trial (boot %d of %d).", lBoots, CFG_ZIGBEE_OTA_AB_TRIAL_BOOTS );
+
+  UTIL_TIMER_Create( &stOtaConfirmTimer, CFG_ZIGBEE_OTA_AB_CONFIRM_DELAY, UTIL_TIMER_ONESHOT, &OtaConfirmTimerElapsed, NULL );
+  UTIL_TIMER_Start( &stOtaConfirmTimer );
+}
+
+/**
+ * @brief  Activate the image of the inactive bank : the data pages are copied in the active bank, the trial record
+ *         is written, then the banks are swapped by the option bytes reload (reset).
+ * @param  lRecord    Trial record for the next boot (OTA_AB_TRIAL_MAGIC or OTA_AB_ROLLBACK_MAGIC)
+ * @retval False if the swap could not be done (no return else).
+ */
+static bool OtaBankActivate( uint32_t lRecord )
+{
+  FLASH_OBProgramInitTypeDef  stOptionBytes;
+
+  /* The download area shall be the whole inactive bank, below the data pages */
+  if ( ( CFG_ZIGBEE_OTA_DOWNLOAD_ADDRESS != ( FLASH_BASE + FLASH_BANK_SIZE ) ) || ( OtaBankCopyData() == false ) )
+  {
+    return false;
+  }
+
+  HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, lRecord );
+
+  memset( &stOptionBytes, 0, sizeof( stOptionBytes ) );
+  stOptionBytes.OptionType = OPTIONBYTE_USER;
+  stOptionBytes.USERType = OB_USER_SWAP_BANK;
+  stOptionBytes.USERConfig = ( ( READ_BIT( FLASH->OPTR, FLASH_OPTR_SWAP_BANK ) != 0u ) ? OB_SWAP_BANK_DISABLE : OB_SWAP_BANK_ENABLE );
+
+  (void)HAL_FLASH_Unlock();
+  (void)HAL_FLASH_OB_Unlock();
+  if ( HAL_FLASHEx_OBProgram( &stOptionBytes ) == HAL_OK )
+  {
+    /* Option bytes reload : reset on the swapped banks */
+    (void)HAL_FLASH_OB_Launch();
+  }
+  (void)HAL_FLASH_OB_Lock();
+  (void)HAL_FLASH_Lock();
+
+  HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, OTA_AB_RECORD_NONE );
+  return false;
+}
+
+/**
+ * @brief  Copy the data pages (above the download area) in the same place of the active bank, where the swap maps
+ *         them. The erased flash words are not written.
+ * @param  None
+ * @retval True if the copy is done.
+ */
+static bool OtaBankCopyData( void )
+{
+  const uint32_t  * plSource;
+  uint32_t        lAddress;
+  uint32_t        lOffset;
+  bool            bSuccess = true;
+
+  (void)HAL_FLASH_Unlock();
+
+  for ( lAddress = OTA_AB_DATA_ADDRESS; ( lAddress < ( FLASH_BASE + FLASH_SIZE ) ) && ( bSuccess != false ); lAddress += FLASH_PAGE_SIZE )
+  {
+    if ( FD_EraseSectors( ( lAddress - FLASH_BANK_SIZE - FLASH_BASE ) / FLASH_PAGE_SIZE ) != FD_FLASHOP_SUCCESS )
+    {
+      bSuccess = false;
+    }
+
+    for ( lOffset = 0; ( lOffset < FLASH_PAGE_SIZE ) && ( bSuccess != false ); lOffset += OTA_AB_FLASH_WORD_SIZE )
+    {
+      plSource = (const uint32_t *)( lAddress + lOffset );
+      if ( ( plSource[0] & plSource[1] & plSource[2] & plSource[3] ) != 0xFFFFFFFFu )
+      {
+        bSuccess = ( FD_WriteData( ( lAddress - FLASH_BANK_SIZE + lOffset ), (uint32_t)plSource ) == FD_FLASHOP_SUCCESS );
+      }
+    }
+  }
+
+  (void)HAL_FLASH_Lock();
+
+  if ( bSuccess == false )
+  {
+    LOG_ERROR_APP( "[OTA] Error, data page copy failed at 0x%08X.", lAddress );
+  }
+
+  return bSuccess;
+}
+
+/**
+ * @brief  Callback triggered when the new image ran CFG_ZIGBEE_OTA_AB_CONFIRM_DELAY : end of the trial.
+ * @param  arg : Not used
+ * @retval None
+ */
+static void OtaConfirmTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  HAL_RTCEx_BKUPWrite( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER, OTA_AB_RECORD_NONE );
+}
+
+#else /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+
+/**
+ * @brief  No A/B slots : the image is installed by the bootloader, no trial.
+ */
+void APP_ZIGBEE_OtaBootCheck( void )
+{
+}
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+/**
+ * @brief  Add the firmware data of a buffer to the SHA-256, before it is given to the flash (never read back).
+ * @param  pstBuffer  Buffer (whole buffers, multiple of 4 bytes)
+ * @retval None
+ */
+static void OtaSha256Update( const OtaBuffer_t * pstBuffer )
+{
+  if ( HAL_HASH_Accumulate( &stOtaSha256, (const uint8_t *)pstBuffer->alData, pstBuffer->iLength, OTA_HASH_TIMEOUT ) != HAL_OK )
+  {
+    LOG_ERROR_APP( "[OTA] Error, SHA-256 update failed." );
+    stOtaState.bError = true;
+  }
+}
+
+/**
+ * @brief  Convert a big-endian 256-bit number to PKA operand (least significant word first).
+ * @param  pcBytes    Number (32 bytes, big-endian)
+ * @param  plWords    PKA operand (8 words)
+ * @retval None
+ */
+static void OtaBytesToOperand( const uint8_t * pcBytes, uint32_t * plWords )
+{
+  uint8_t   cIndex;
+
+  for ( cIndex = 0; cIndex < 8u; cIndex++ )
+  {
+    plWords[7u - cIndex] = ( ( (uint32_t)pcBytes[4u * cIndex] << 24u ) | ( (uint32_t)pcBytes[4u * cIndex + 1u] << 16u ) |
+                             ( (uint32_t)pcBytes[4u * cIndex + 2u] << 8u ) | (uint32_t)pcBytes[4u * cIndex + 3u] );
+  }
+}
+
+/**
+ * @brief  Signature received, after the whole firmware : the SHA-256 is completed with the buffer being filled (its
+ *         data only, not the padding) and the PKA verification is queued, the download going on meanwhile.
+ * @param  None
+ * @retval None
+ */
+static void OtaSignatureVerify( void )
+{
+  const OtaBuffer_t   * pstFill = &astOtaBuffer[cOtaFillIndex];
+  uint8_t             acDigest[OTA_SHA256_LEN];
+
+  stOtaState.lSignatureTime = HAL_GetTick();
+  if ( HAL_HASH_AccumulateLast( &stOtaSha256, (const uint8_t *)pstFill->alData, pstFill->iLength, acDigest,
+                                OTA_HASH_TIMEOUT ) != HAL_OK )
+  {
+    LOG_ERROR_APP( "[OTA] Error, SHA-256 completion failed." );
+    eOtaSignState = OTA_SIGN_INVALID;
+    return;
+  }
+  (void)HAL_HASH_DeInit( &stOtaSha256 );
+
+  OtaBytesToOperand( acDigest, alOtaSignE );
+  OtaBytesToOperand( &acOtaSignature[0], alOtaSignR );
+  OtaBytesToOperand( &acOtaSignature[OTA_SHA256_LEN], alOtaSignS );
+  OtaBytesToOperand( &acOtaSignerKey[0], alOtaSignQx );
+  OtaBytesToOperand( &acOtaSignerKey[OTA_SHA256_LEN], alOtaSignQy );
+
+  stOtaSignJob.e = alOtaSignE;
+  stOtaSignJob.r = alOtaSignR;
+  stOtaSignJob.s = alOtaSignS;
+  stOtaSignJob.q_x = alOtaSignQx;
+  stOtaSignJob.q_y = alOtaSignQy;
+
+  eOtaSignState = OTA_SIGN_PENDING;
+  HW_PKA_P256_EcdsaVerifAsync( &stOtaSignJob, OtaSignatureCallback );
+}
+
+/**
+ * @brief  End of the PKA verification of the signature.
+ * @param  pstJob   PKA job
+ * @retval None
+ */
+static void OtaSignatureCallback( HW_PKA_JOB_T * pstJob )
+{
+  UNUSED( pstJob );
+
+  stOtaState.lSignatureTime = HAL_GetTick() - stOtaState.lSignatureTime;
+  eOtaSignState = ( ( stOtaSignJob.success != 0u ) ? OTA_SIGN_VALID : OTA_SIGN_INVALID );
+}
+
+/**
+ * @brief  Tag data of the OTA file : the signature tag is kept for the verification, the other tags are given to the
+ *         default handler (which gives the firmware to OtaWriteImageCallback).
+ * @param  pstCluster   OTA Client
+ * @param  pstHeader    OTA header of the image
+ * @param  iTagId       Tag of the data
+ * @param  lTagLength   Length of the whole tag
+ * @param  cLength      Length of the data
+ * @param  pData        Data
+ * @param  arg          Application argument
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT OtaWriteTagCallback( struct ZbZclClusterT * pstCluster, struct ZbZclOtaHeader * pstHeader,
+                                                uint16_t iTagId, uint32_t lTagLength, uint8_t cLength,
+                                                uint8_t * pData, void * arg )
+{
+  if ( iTagId != OTA_TAG_ECDSA_P256 )
+  {
+    return pfOtaDefaultWriteTag( pstCluster, pstHeader, iTagId, lTagLength, cLength, pData, arg );
+  }
+
+  if ( ( lTagLength != OTA_SIGNATURE_LEN ) || ( ( cOtaSignatureLength + cLength ) > OTA_SIGNATURE_LEN ) ||
+       ( eOtaSignState != OTA_SIGN_NONE ) || ( stOtaState.bError != false ) )
+  {
+    LOG_ERROR_APP( "[OTA] Error, invalid signature tag." );
+    return ZCL_STATUS_FAILURE;
+  }
+
+  memcpy( &acOtaSignature[cOtaSignatureLength], pData, cLength );
+  cOtaSignatureLength += cLength;
+  if ( cOtaSignatureLength == OTA_SIGNATURE_LEN )
+  {
+    OtaSignatureVerify();
+  }
+
+  return ZCL_STATUS_SUCCESS;
+}
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+/**
+ * @brief  OTA serial commands : OTA (state) and OTA START (discover a Server and download).
+ * @param  szCommand  Command received
+ * @retval True if the command is an OTA command.
+ */
+bool APP_ZIGBEE_OtaSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "OTA START" ) == 0 )
+  {
+    if ( APP_ZIGBEE_OtaStart() == false )
+    {
+      LOG_ERROR_APP( "[OTA] Error, OTA Server discovery not launched." );
+    }
+    return true;
+  }
+
+  if ( strcmp( szCommand, "OTA" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "OTA : %s, %d bytes received in %d blocks, %d written in flash, %d waits, %d retries%s%s.",
+                ( ( stOtaState.bInProgress != false ) ? "in progress" : "idle" ), stOtaState.lImageSize, stOtaState.lBlocks,
+                stOtaState.lFlashSize, stOtaState.lWaits, stOtaState.lRetries,
+                ( ( stOtaState.bVerified != false ) ? ", verified" : "" ), ( ( stOtaState.bError != false ) ? ", error" : "" ) );
+#if (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0)
+  LOG_INFO_APP( "OTA : running from bank %d%s.", ( ( READ_BIT( FLASH->OPTR, FLASH_OPTR_SWAP_BANK ) != 0u ) ? 2 : 1 ),
+                ( ( ( HAL_RTCEx_BKUPRead( &hrtc, CFG_ZIGBEE_OTA_AB_BKP_REGISTER ) & ~0xFFu ) == OTA_AB_TRIAL_MAGIC ) ? ", on trial" : "" ) );
+#endif /* (CFG_ZIGBEE_OTA_AB_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0)
+  if ( stOtaState.bSigned != false )
+  {
+    LOG_INFO_APP( "OTA : signature verified in %d ms after its reception.", stOtaState.lSignatureTime );
+  }
+#endif /* (CFG_ZIGBEE_OTA_SIGNATURE_SUPPORTED != 0) */
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_OTA_SUPPORTED != 0) */
+
+/**
+ * @brief  OTA not supported.
+ */
+void APP_ZIGBEE_OtaInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+}
+
+/**
+ * @brief  OTA not supported : no download.
+ */
+bool APP_ZIGBEE_OtaStart( void )
+{
+  return false;
+}
+
+/**
+ * @brief  OTA not supported : no command.
+ */
+bool APP_ZIGBEE_OtaSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  OTA not supported : no image on trial.
+ */
+void APP_ZIGBEE_OtaBootCheck( void )
+{
+}
+
+/**
+ * @brief  OTA not supported : no state.
+ */
+const APP_ZIGBEE_OtaState_t * APP_ZIGBEE_OtaGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_OTA_SUPPORTED != 0) */
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_ota.h
+  * @author  MCD Application Team
+  * @brief   Interface of the streaming OTA Upgrade Client.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_OTA_H
+#define APP_ZIGBEE_OTA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the OTA download */
+typedef struct
+{
+  uint32_t    lImageSize;             /* Size of the image tag (firmware) received */
+  uint32_t    lFlashSize;             /* Bytes written in the download area */
+  uint32_t    lBlocks;                /* Number of Image Blocks received */
+  uint32_t    lWaits;                 /* Number of times the download waited for the flash */
+  uint32_t    lRetries;               /* Number of transfers paused then resumed after a block failure */
+  uint32_t    lStartTime;             /* Time (in ms) of the first block */
+  uint32_t    lDuration;              /* Duration (in ms) of the last completed download */
+  uint32_t    lSignatureTime;         /* Time (in ms) from the signature reception to the end of its verification */
+  bool        bInProgress;            /* A download is in progress */
+  bool        bVerified;              /* Integrity Code verified on the last download */
+  bool        bError;                 /* Flash or verification error on the current/last download */
+  bool        bSigned;                /* Signature verified on the last download */
+} APP_ZIGBEE_OtaState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_OtaInit                ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId );
+bool      APP_ZIGBEE_OtaStart               ( void );
+void      APP_ZIGBEE_OtaBootCheck           ( void );
+bool      APP_ZIGBEE_OtaSerialCmdExecute    ( const char * szCommand );
+
+const APP_ZIGBEE_OtaState_t * APP_ZIGBEE_OtaGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_OTA_H */
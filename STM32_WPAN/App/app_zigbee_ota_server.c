@@ -0,0 +1,492 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_ota_server.c
+  * @author  MCD Application Team
+  * @brief   Local OTA Upgrade Server : the Image Block Requests are served from a
+  *          RAM cache of the recent lines of the OTA file (LRU). A line is read
+  *          once from the storage, the requests received while it is read are
+  *          told to wait instead of reading it again.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_ota_server.h"
+#include "app_zigbee_stagger.h"
+
+#if (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define OTA_SERVER_NOTIFY_JITTER        (100u)      /* All the Clients answer to the Image Notify */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  OTA_CACHE_LINE_EMPTY,
+  OTA_CACHE_LINE_LOADING,
+  OTA_CACHE_LINE_VALID,
+} OtaCacheLineState_t;
+
+typedef struct
+{
+  OtaCacheLineState_t   eState;
+  uint32_t              lOffset;                                      /* Offset of the line in the OTA file */
+  uint32_t              lLastUse;                                     /* Cache clock of the last use */
+  uint16_t              iLength;
+  uint8_t               aData[CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE];
+} OtaCacheLine_t;
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZbZclClusterT             * pstOtaServer;
+static struct ZbZclOtaImageDefinition   stOtaServerImage;
+static uint32_t                         lOtaServerImageSize;
+static APP_ZIGBEE_OtaServerRead_t       pfOtaServerRead;
+static OtaCacheLine_t                   astOtaCacheLine[CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB];
+static uint32_t                         lOtaCacheClock;
+static APP_ZIGBEE_OtaServerStats_t      stOtaServerStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static OtaCacheLine_t * OtaServerCacheGet   ( uint32_t lLineOffset, bool * pbHit );
+static bool     OtaServerImageEval          ( struct ZbZclOtaImageDefinition * pstQuery, uint8_t cFieldControl,
+                                              uint16_t iHardwareVersion, uint32_t * plImageSize, void * arg );
+static enum ZclStatusCodeT OtaServerImageRead   ( struct ZbZclOtaImageDefinition * pstImage, struct ZbZclOtaImageData * pstImageData,
+                                                  uint8_t cFieldControl, uint64_t dlRequestAddress,
+                                                  struct ZbZclOtaImageWaitForData * pstImageWait, void * arg );
+static enum ZclStatusCodeT OtaServerUpgradeEnd  ( struct ZbZclOtaImageDefinition * pstImage, enum ZclStatusCodeT eUpgradeStatus,
+                                                  struct ZbZclOtaEndResponseTimes * pstEndTimes, struct ZbZclAddrInfoT * pstSrcInfo,
+                                                  void * arg );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Allocate the OTA Upgrade Server.
+ * @param  pstZigbee    Zigbee stack handler
+ * @param  cEndpoint    Endpoint of the Server
+ * @param  iProfileId   Profile of the Endpoint
+ * @retval None
+ */
+void APP_ZIGBEE_OtaServerInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  struct ZbZclOtaServerConfig   stConfig;
+
+  memset( &stConfig, 0, sizeof( stConfig ) );
+  stConfig.profile_id = iProfileId;
+  stConfig.endpoint = cEndpoint;
+  stConfig.minimum_block_period = 0u;
+  stConfig.image_eval = OtaServerImageEval;
+  stConfig.image_read = OtaServerImageRead;
+  stConfig.image_upgrade_end_req = OtaServerUpgradeEnd;
+
+  pstOtaServer = ZbZclOtaServerAlloc( pstZigbee, &stConfig, NULL );
+  if ( pstOtaServer == NULL )
+  {
+    LOG_ERROR_APP( "Error, OTA Server allocation failed." );
+    return;
+  }
+  ZbZclClusterEndpointRegister( pstOtaServer );
+}
+
+/**
+ * @brief  Set the image proposed by the Server. The cache is emptied.
+ * @param  pstImage     Manufacturer, type and version of the image
+ * @param  lImageSize   Size of the OTA file
+ * @param  pfRead       Read of the OTA file in its storage
+ * @retval True if the image is set.
+ */
+bool APP_ZIGBEE_OtaServerSetImage( const struct ZbZclOtaImageDefinition * pstImage, uint32_t lImageSize, APP_ZIGBEE_OtaServerRead_t pfRead )
+{
+  uint16_t    iIndex;
+
+  if ( ( pstImage == NULL ) || ( pfRead == NULL ) || ( lImageSize == 0u ) )
+  {
+    return false;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB; iIndex++ )
+  {
+    if ( astOtaCacheLine[iIndex].eState == OTA_CACHE_LINE_LOADING )
+    {
+      /* A read of the previous image is in progress */
+      return false;
+    }
+  }
+
+  memset( astOtaCacheLine, 0, sizeof( astOtaCacheLine ) );
+  stOtaServerImage = *pstImage;
+  lOtaServerImageSize = lImageSize;
+  pfOtaServerRead = pfRead;
+
+  return true;
+}
+
+/**
+ * @brief  End of a read of the storage that has returned ZCL_STATUS_WAIT_FOR_DATA.
+ * @param  lOffset    Offset given to the read
+ * @param  bSuccess   True if the data have been read
+ * @retval None
+ */
+void APP_ZIGBEE_OtaServerReadDone( uint32_t lOffset, bool bSuccess )
+{
+  uint16_t    iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB; iIndex++ )
+  {
+    if ( ( astOtaCacheLine[iIndex].eState == OTA_CACHE_LINE_LOADING ) && ( astOtaCacheLine[iIndex].lOffset == lOffset ) )
+    {
+      if ( bSuccess != false )
+      {
+        astOtaCacheLine[iIndex].eState = OTA_CACHE_LINE_VALID;
+      }
+      else
+      {
+        astOtaCacheLine[iIndex].eState = OTA_CACHE_LINE_EMPTY;
+        stOtaServerStats.lErrors++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Statistics of the block cache.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_OtaServerStats_t * APP_ZIGBEE_OtaServerGetStats( void )
+{
+  return &stOtaServerStats;
+}
+
+/**
+ * @brief  Get the cache line of an offset. On a miss, the least recently used line (not being read) is read again
+ *         from the storage.
+ * @param  lLineOffset  Offset of the line in the OTA file
+ * @param  pbHit        True if the line was already in the cache (valid or being read)
+ * @retval Cache line, NULL if no line can be used or the read failed.
+ */
+static OtaCacheLine_t * OtaServerCacheGet( uint32_t lLineOffset, bool * pbHit )
+{
+  OtaCacheLine_t        * pstLine = NULL;
+  enum ZclStatusCodeT   eStatus;
+  uint16_t              iIndex;
+
+  *pbHit = false;
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_NB; iIndex++ )
+  {
+    if ( ( astOtaCacheLine[iIndex].eState != OTA_CACHE_LINE_EMPTY ) && ( astOtaCacheLine[iIndex].lOffset == lLineOffset ) )
+    {
+      *pbHit = true;
+      return &astOtaCacheLine[iIndex];
+    }
+
+    /* Victim : an empty line first, else the least recently used one */
+    if ( ( astOtaCacheLine[iIndex].eState != OTA_CACHE_LINE_LOADING ) &&
+         ( ( pstLine == NULL ) || ( ( pstLine->eState != OTA_CACHE_LINE_EMPTY ) &&
+           ( ( astOtaCacheLine[iIndex].eState == OTA_CACHE_LINE_EMPTY ) || ( astOtaCacheLine[iIndex].lLastUse < pstLine->lLastUse ) ) ) ) )
+    {
+      pstLine = &astOtaCacheLine[iIndex];
+    }
+  }
+
+  if ( pstLine == NULL )
+  {
+    return NULL;
+  }
+
+  pstLine->eState = OTA_CACHE_LINE_LOADING;
+  pstLine->lOffset = lLineOffset;
+  pstLine->iLength = CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE;
+  if ( ( lOtaServerImageSize - lLineOffset ) < CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE )
+  {
+    pstLine->iLength = (uint16_t)( lOtaServerImageSize - lLineOffset );
+  }
+
+  stOtaServerStats.lStorageReads++;
+  eStatus = pfOtaServerRead( lLineOffset, pstLine->aData, pstLine->iLength );
+  if ( eStatus == ZCL_STATUS_SUCCESS )
+  {
+    pstLine->eState = OTA_CACHE_LINE_VALID;
+  }
+  else if ( eStatus != ZCL_STATUS_WAIT_FOR_DATA )
+  {
+    pstLine->eState = OTA_CACHE_LINE_EMPTY;
+    stOtaServerStats.lErrors++;
+    return NULL;
+  }
+
+  return pstLine;
+}
+
+/**
+ * @brief  Query Next Image Request : the image is proposed to the Clients of the same manufacturer and type that
+ *         do not already run its version.
+ * @param  pstQuery           Current image of the Client
+ * @param  cFieldControl      Field control of the request
+ * @param  iHardwareVersion   Hardware version of the Client
+ * @param  plImageSize        Size of the OTA file
+ * @param  arg                Application argument
+ * @retval True if the image is proposed.
+ */
+static bool OtaServerImageEval( struct ZbZclOtaImageDefinition * pstQuery, uint8_t cFieldControl,
+                                uint16_t iHardwareVersion, uint32_t * plImageSize, void * arg )
+{
+  UNUSED( cFieldControl );
+  UNUSED( iHardwareVersion );
+  UNUSED( arg );
+
+  if ( ( lOtaServerImageSize == 0u ) || ( pstQuery->manufacturer_code != stOtaServerImage.manufacturer_code ) ||
+       ( pstQuery->image_type != stOtaServerImage.image_type ) || ( pstQuery->file_version == stOtaServerImage.file_version ) )
+  {
+    return false;
+  }
+
+  pstQuery->file_version = stOtaServerImage.file_version;
+  *plImageSize = lOtaServerImageSize;
+
+  return true;
+}
+
+/**
+ * @brief  Image Block Request : the block is served from its cache line, up to the end of the line. A request on a
+ *         line being read is told to wait, and does not read it again.
+ * @param  pstImage           Image requested
+ * @param  pstImageData       Offset and maximum size requested, data served
+ * @param  cFieldControl      Field control of the request
+ * @param  dlRequestAddress   Address of the Client
+ * @param  pstImageWait       Delay to indicate with ZCL_STATUS_WAIT_FOR_DATA
+ * @param  arg                Application argument
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT OtaServerImageRead( struct ZbZclOtaImageDefinition * pstImage, struct ZbZclOtaImageData * pstImageData,
+                                               uint8_t cFieldControl, uint64_t dlRequestAddress,
+                                               struct ZbZclOtaImageWaitForData * pstImageWait, void * arg )
+{
+  OtaCacheLine_t    * pstLine;
+  uint32_t          lLineOffset, lLength;
+  bool              bHit;
+
+  UNUSED( cFieldControl );
+  UNUSED( dlRequestAddress );
+  UNUSED( arg );
+
+  if ( ( lOtaServerImageSize == 0u ) || ( pstImage->manufacturer_code != stOtaServerImage.manufacturer_code ) ||
+       ( pstImage->image_type != stOtaServerImage.image_type ) || ( pstImage->file_version != stOtaServerImage.file_version ) )
+  {
+    return ZCL_STATUS_NO_IMAGE_AVAILABLE;
+  }
+
+  if ( pstImageData->file_offset >= lOtaServerImageSize )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  stOtaServerStats.lRequests++;
+  lLineOffset = pstImageData->file_offset - ( pstImageData->file_offset % CFG_ZIGBEE_OTA_SERVER_CACHE_LINE_SIZE );
+  pstLine = OtaServerCacheGet( lLineOffset, &bHit );
+  if ( pstLine == NULL )
+  {
+    return ZCL_STATUS_FAILURE;
+  }
+
+  if ( pstLine->eState == OTA_CACHE_LINE_LOADING )
+  {
+    /* Coalesced : the Client requests the block again after the read */
+    if ( bHit != false )
+    {
+      stOtaServerStats.lCoalesced++;
+    }
+    else
+    {
+      stOtaServerStats.lMisses++;
+    }
+    pstImageWait->current_time = 0u;
+    pstImageWait->request_time = CFG_ZIGBEE_OTA_SERVER_WAIT_TIME;
+    pstImageWait->minimum_block_period = 0u;
+    return ZCL_STATUS_WAIT_FOR_DATA;
+  }
+
+  if ( bHit != false )
+  {
+    stOtaServerStats.lHits++;
+  }
+  else
+  {
+    stOtaServerStats.lMisses++;
+  }
+
+  /* Up to the end of the line : the Client asks the rest with the next block */
+  lLength = pstLine->iLength - ( pstImageData->file_offset - lLineOffset );
+  if ( lLength > pstImageData->data_size )
+  {
+    lLength = pstImageData->data_size;
+  }
+  if ( lLength > sizeof( pstImageData->data ) )
+  {
+    lLength = sizeof( pstImageData->data );
+  }
+
+  memcpy( pstImageData->data, &pstLine->aData[pstImageData->file_offset - lLineOffset], lLength );
+  pstImageData->data_size = (uint8_t)lLength;
+  pstLine->lLastUse = ++lOtaCacheClock;
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Upgrade End Request of a Client : upgrade now.
+ * @param  pstImage         Image downloaded
+ * @param  eUpgradeStatus   Status of the download on the Client
+ * @param  pstEndTimes      Times of the Upgrade End Response
+ * @param  pstSrcInfo       Client
+ * @param  arg              Application argument
+ * @retval ZCL status
+ */
+static enum ZclStatusCodeT OtaServerUpgradeEnd( struct ZbZclOtaImageDefinition * pstImage, enum ZclStatusCodeT eUpgradeStatus,
+                                                struct ZbZclOtaEndResponseTimes * pstEndTimes, struct ZbZclAddrInfoT * pstSrcInfo,
+                                                void * arg )
+{
+  UNUSED( arg );
+
+  LOG_INFO_APP( "[OTA] Client 0x%04X : end of the download of version 0x%08X (status 0x%02X).",
+                pstSrcInfo->addr.nwkAddr, pstImage->file_version, eUpgradeStatus );
+
+  /* End of the OTA of this Client in a staggered campaign */
+  APP_ZIGBEE_StaggerDone( pstSrcInfo->addr.nwkAddr, ( eUpgradeStatus == ZCL_STATUS_SUCCESS ) );
+
+  pstEndTimes->current_time = 0u;
+  pstEndTimes->upgrade_time = 0u;
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Image Notify of the image set to one Client (staggered OTA of the Network).
+ * @param  iNwkAddr   Short address of the Client
+ * @retval True if the Image Notify is sent.
+ */
+bool APP_ZIGBEE_OtaServerNotify( uint16_t iNwkAddr )
+{
+  struct ZbApsAddrT   stDest;
+
+  if ( ( pstOtaServer == NULL ) || ( lOtaServerImageSize == 0u ) )
+  {
+    return false;
+  }
+
+  memset( &stDest, 0, sizeof( stDest ) );
+  stDest.mode = ZB_APSDE_ADDRMODE_SHORT;
+  stDest.nwkAddr = iNwkAddr;
+  stDest.endpoint = ZB_ENDPOINT_BCAST;
+
+  return ( ZbZclOtaServerImageNotifyReq( pstOtaServer, &stDest, ZCL_OTA_NOTIFY_TYPE_FILE_VERSION, OTA_SERVER_NOTIFY_JITTER, &stOtaServerImage ) == ZCL_STATUS_SUCCESS );
+}
+
+/**
+ * @brief  OTA Server serial commands : OTASRV (cache statistics) and OTASRV NOTIFY (Image Notify broadcast).
+ * @param  szCommand  Command received
+ * @retval True if the command is an OTA Server command.
+ */
+bool APP_ZIGBEE_OtaServerSerialCmdExecute( const char * szCommand )
+{
+  struct ZbApsAddrT   stDest;
+
+  if ( strcmp( szCommand, "OTASRV NOTIFY" ) == 0 )
+  {
+    memset( &stDest, 0, sizeof( stDest ) );
+    stDest.mode = ZB_APSDE_ADDRMODE_SHORT;
+    stDest.nwkAddr = ZB_NWK_ADDR_BCAST_RXON;
+    stDest.endpoint = ZB_ENDPOINT_BCAST;
+
+    if ( ( pstOtaServer == NULL ) || ( lOtaServerImageSize == 0u ) ||
+         ( ZbZclOtaServerImageNotifyReq( pstOtaServer, &stDest, ZCL_OTA_NOTIFY_TYPE_FILE_VERSION, OTA_SERVER_NOTIFY_JITTER, &stOtaServerImage ) != ZCL_STATUS_SUCCESS ) )
+    {
+      LOG_ERROR_APP( "[OTA] Error, Image Notify not sent." );
+    }
+    return true;
+  }
+
+  if ( strcmp( szCommand, "OTASRV" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "OTA Server : image 0x%08X (%d bytes), %d block requests, %d hits, %d misses, %d coalesced, %d storage reads (%d failed).",
+                stOtaServerImage.file_version, lOtaServerImageSize, stOtaServerStats.lRequests, stOtaServerStats.lHits,
+                stOtaServerStats.lMisses, stOtaServerStats.lCoalesced, stOtaServerStats.lStorageReads, stOtaServerStats.lErrors );
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0) */
+
+/**
+ * @brief  OTA Server not supported.
+ */
+void APP_ZIGBEE_OtaServerInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+}
+
+/**
+ * @brief  OTA Server not supported : no image.
+ */
+bool APP_ZIGBEE_OtaServerSetImage( const struct ZbZclOtaImageDefinition * pstImage, uint32_t lImageSize, APP_ZIGBEE_OtaServerRead_t pfRead )
+{
+  UNUSED( pstImage );
+  UNUSED( lImageSize );
+  UNUSED( pfRead );
+
+  return false;
+}
+
+/**
+ * @brief  OTA Server not supported : no read.
+ */
+void APP_ZIGBEE_OtaServerReadDone( uint32_t lOffset, bool bSuccess )
+{
+  UNUSED( lOffset );
+  UNUSED( bSuccess );
+}
+
+/**
+ * @brief  OTA Server not supported : no image.
+ */
+bool APP_ZIGBEE_OtaServerNotify( uint16_t iNwkAddr )
+{
+  UNUSED( iNwkAddr );
+
+  return false;
+}
+
+/**
+ * @brief  OTA Server not supported : no command.
+ */
+bool APP_ZIGBEE_OtaServerSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  OTA Server not supported : no statistics.
+ */
+const APP_ZIGBEE_OtaServerStats_t * APP_ZIGBEE_OtaServerGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0) */
@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_ota_server.h
+  * @author  MCD Application Team
+  * @brief   Interface of the local OTA Upgrade Server with its block cache.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_OTA_SERVER_H
+#define APP_ZIGBEE_OTA_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+#include "zcl/general/zcl.ota.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Read of the OTA file in its storage (flash, host...). Returns ZCL_STATUS_SUCCESS when pData is filled, or
+ * ZCL_STATUS_WAIT_FOR_DATA when it will be filled later (APP_ZIGBEE_OtaServerReadDone is then called). */
+typedef enum ZclStatusCodeT (*APP_ZIGBEE_OtaServerRead_t)( uint32_t lOffset, uint8_t * pData, uint16_t iLength );
+
+/* Statistics of the block cache */
+typedef struct
+{
+  uint32_t    lRequests;              /* Image Block Requests served or delayed */
+  uint32_t    lHits;                  /* Blocks served from the cache */
+  uint32_t    lMisses;                /* Blocks that needed a read of the storage */
+  uint32_t    lCoalesced;             /* Requests delayed on a read already in progress */
+  uint32_t    lStorageReads;          /* Reads of the storage */
+  uint32_t    lErrors;                /* Reads of the storage failed */
+} APP_ZIGBEE_OtaServerStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_OtaServerInit          ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId );
+bool      APP_ZIGBEE_OtaServerSetImage      ( const struct ZbZclOtaImageDefinition * pstImage, uint32_t lImageSize,
+                                              APP_ZIGBEE_OtaServerRead_t pfRead );
+void      APP_ZIGBEE_OtaServerReadDone      ( uint32_t lOffset, bool bSuccess );
+bool      APP_ZIGBEE_OtaServerNotify        ( uint16_t iNwkAddr );
+bool      APP_ZIGBEE_OtaServerSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_OtaServerStats_t * APP_ZIGBEE_OtaServerGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_OTA_SERVER_H */
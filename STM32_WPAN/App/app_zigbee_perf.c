@@ -0,0 +1,227 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_perf.c
+  * @author  MCD Application Team
+  * @brief   Manufacturer specific performance telemetry cluster : the CPU
+  *          load, heap, MAC retries, trace drops and sequencer latency of the
+  *          Router, readable and reportable over the network.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_entry.h"
+#include "app_zigbee.h"
+#include "app_zigbee_perf.h"
+
+#include "stm32_rtos.h"
+#include "stm32_adv_trace.h"
+#include "zigbee.aps.h"
+#include "zigbee_plat.h"
+#include "zcl/zcl.h"
+
+#if (CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define PERF_MANUFACTURER_CODE          (0x1041u)   /* STMicroelectronics */
+#define PERF_TRACE_STATS                ( (CFG_LOG_SUPPORTED != 0) && (CFG_LOG_TRACE_STATS_SUPPORTED != 0) )
+
+#define PERF_ATTR( _ID_, _TYPE_ )       { (_ID_), (_TYPE_), ( ZCL_ATTR_FLAG_CB_READ | ZCL_ATTR_FLAG_REPORTABLE ), 0, \
+                                          PerfReadCallback, { 0, 0 }, { CFG_ZIGBEE_PERF_REPORT_MIN, CFG_ZIGBEE_PERF_REPORT_MAX } }
+
+/* Private functions prototypes-----------------------------------------------*/
+static enum ZclStatusCodeT  PerfReadCallback    ( struct ZbZclClusterT * pstCluster, struct ZbZclAttrCbInfoT * pstInfo );
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZigBeeT               * pstPerfZigbee;
+
+/* Attributes of the counters built */
+static const struct ZbZclAttrT      astPerfAttrList[] =
+{
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_LOAD_1S, ZCL_DATATYPE_UNSIGNED_16BIT ),
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_LOAD_10S, ZCL_DATATYPE_UNSIGNED_16BIT ),
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_LOAD_60S, ZCL_DATATYPE_UNSIGNED_16BIT ),
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_HEAP_USED, ZCL_DATATYPE_UNSIGNED_32BIT ),
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_HEAP_PEAK, ZCL_DATATYPE_UNSIGNED_32BIT ),
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_MAC_RETRY_RATE, ZCL_DATATYPE_UNSIGNED_16BIT ),
+#if PERF_TRACE_STATS
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_TRACE_DROPS, ZCL_DATATYPE_UNSIGNED_32BIT ),
+#endif /* PERF_TRACE_STATS */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  PERF_ATTR( APP_ZIGBEE_PERF_ATTR_SEQ_MAX_LATENCY, ZCL_DATATYPE_UNSIGNED_32BIT ),
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Allocate the performance telemetry Server on the Endpoint, with the default reporting of its attributes.
+ * @param  pstZigbee    Zigbee stack handler
+ * @param  cEndpoint    Endpoint of the Server
+ * @param  iProfileId   Profile of the Endpoint
+ * @retval None
+ */
+void APP_ZIGBEE_PerfInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  struct ZbZclClusterT  * pstCluster;
+  uint32_t              lIndex;
+
+  pstPerfZigbee = pstZigbee;
+
+  pstCluster = ZbZclClusterAlloc( pstZigbee, sizeof( struct ZbZclClusterT ), (enum ZbZclClusterIdT)CFG_ZIGBEE_PERF_CLUSTER_ID,
+                                  cEndpoint, ZCL_DIRECTION_TO_SERVER );
+  if ( pstCluster == NULL )
+  {
+    LOG_ERROR_APP( "Error, Performance Server allocation failed." );
+    return;
+  }
+
+  pstCluster->mfrCode = PERF_MANUFACTURER_CODE;
+  ZbZclClusterSetProfileId( pstCluster, iProfileId );
+  if ( ( ZbZclAttrAppendList( pstCluster, astPerfAttrList, ZCL_ATTR_LIST_LEN( astPerfAttrList ) ) != ZCL_STATUS_SUCCESS )
+       || ( ZbZclClusterAttach( pstCluster ) != ZCL_STATUS_SUCCESS ) )
+  {
+    LOG_ERROR_APP( "Error, Performance Server configuration failed." );
+    ZbZclClusterFree( pstCluster );
+    return;
+  }
+  (void)ZbZclClusterEndpointRegister( pstCluster );
+
+  /* Reported at most every CFG_ZIGBEE_PERF_REPORT_MIN, at least every CFG_ZIGBEE_PERF_REPORT_MAX */
+  for ( lIndex = 0; lIndex < ZCL_ATTR_LIST_LEN( astPerfAttrList ); lIndex++ )
+  {
+    (void)ZbZclAttrReportConfigDefault( pstCluster, astPerfAttrList[lIndex].attributeId, CFG_ZIGBEE_PERF_REPORT_MIN,
+                                        CFG_ZIGBEE_PERF_REPORT_MAX, NULL );
+  }
+}
+
+/**
+ * @brief  Read of an attribute (Read Attributes or report) : the current value of its counter.
+ * @param  pstCluster   Performance Server
+ * @param  pstInfo      Attribute and destination of its value (little endian)
+ * @retval ZCL status.
+ */
+static enum ZclStatusCodeT PerfReadCallback( struct ZbZclClusterT * pstCluster, struct ZbZclAttrCbInfoT * pstInfo )
+{
+  ZigbeePlatHeapStats_t   stHeapStats;
+  struct ZbApsStatTableT  stApsStats;
+#if PERF_TRACE_STATS
+  UTIL_ADV_TRACE_Stats_t  stTraceStats;
+#endif /* PERF_TRACE_STATS */
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+  UTIL_SEQ_TaskStats_t    stTaskStats;
+  uint32_t                lTaskIdx;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+  uint32_t                lValue = 0;
+  uint32_t                lSize = 4u;
+
+  UNUSED( pstCluster );
+
+  if ( pstInfo->type != ZCL_ATTR_CB_TYPE_READ )
+  {
+    return ZCL_STATUS_FAILURE;
+  }
+
+  switch ( pstInfo->info->attributeId )
+  {
+#if (CFG_LOAD_METER_SUPPORTED != 0)
+    case APP_ZIGBEE_PERF_ATTR_LOAD_1S :
+        lValue = APPE_LOAD_Get( 1u );
+        lSize = 2u;
+        break;
+
+    case APP_ZIGBEE_PERF_ATTR_LOAD_10S :
+        lValue = APPE_LOAD_Get( 10u );
+        lSize = 2u;
+        break;
+
+    case APP_ZIGBEE_PERF_ATTR_LOAD_60S :
+        lValue = APPE_LOAD_Get( 60u );
+        lSize = 2u;
+        break;
+#endif /* (CFG_LOAD_METER_SUPPORTED != 0) */
+
+    case APP_ZIGBEE_PERF_ATTR_HEAP_USED :
+    case APP_ZIGBEE_PERF_ATTR_HEAP_PEAK :
+        if ( ZIGBEE_PLAT_GetHeapStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, &stHeapStats ) == true )
+        {
+          lValue = ( pstInfo->info->attributeId == APP_ZIGBEE_PERF_ATTR_HEAP_USED ) ? stHeapStats.lUsedSize : stHeapStats.lPeakSize;
+        }
+        break;
+
+    case APP_ZIGBEE_PERF_ATTR_MAC_RETRY_RATE :
+        if ( ( ZbApsGet( pstPerfZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) == ZB_STATUS_SUCCESS )
+             && ( stApsStats.mac_tx_ucast != 0u ) )
+        {
+          lValue = MIN( ( (uint32_t)stApsStats.mac_tx_ucast_retry * 1000u ) / stApsStats.mac_tx_ucast, 0xFFFFu );
+        }
+        lSize = 2u;
+        break;
+
+#if PERF_TRACE_STATS
+    case APP_ZIGBEE_PERF_ATTR_TRACE_DROPS :
+        UTIL_ADV_TRACE_GetStats( &stTraceStats );
+        lValue = stTraceStats.DroppedNbr;
+        break;
+#endif /* PERF_TRACE_STATS */
+
+#if (CFG_SEQ_PROFILING_SUPPORTED != 0)
+    case APP_ZIGBEE_PERF_ATTR_SEQ_MAX_LATENCY :
+        for ( lTaskIdx = 0u; lTaskIdx < (uint32_t)CFG_TASK_NBR; lTaskIdx++ )
+        {
+          if ( UTIL_SEQ_GetStats( UTIL_SEQ_TASK_BM( lTaskIdx ), &stTaskStats ) != 0u )
+          {
+            lValue = MAX( lValue, stTaskStats.MaxLatency );
+          }
+        }
+        lValue /= MAX( SystemCoreClock / 1000000u, 1u );
+        break;
+#endif /* (CFG_SEQ_PROFILING_SUPPORTED != 0) */
+
+    default :
+        return ZCL_STATUS_UNSUPP_ATTRIBUTE;
+  }
+
+  if ( pstInfo->zcl_len < lSize )
+  {
+    return ZCL_STATUS_INSUFFICIENT_SPACE;
+  }
+
+  pstInfo->zcl_data[0] = (uint8_t)( lValue & 0xFFu );
+  pstInfo->zcl_data[1] = (uint8_t)( ( lValue >> 8u ) & 0xFFu );
+  if ( lSize == 4u )
+  {
+    pstInfo->zcl_data[2] = (uint8_t)( ( lValue >> 16u ) & 0xFFu );
+    pstInfo->zcl_data[3] = (uint8_t)( lValue >> 24u );
+  }
+
+  return ZCL_STATUS_SUCCESS;
+}
+
+#else /* (CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED != 0) */
+
+/**
+ * @brief  No performance telemetry cluster.
+ */
+void APP_ZIGBEE_PerfInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+}
+
+#endif /* (CFG_ZIGBEE_PERF_CLUSTER_SUPPORTED != 0) */
@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_perf.h
+  * @author  MCD Application Team
+  * @brief   Interface of the manufacturer specific performance telemetry cluster.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_PERF_H
+#define APP_ZIGBEE_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Attributes of the performance telemetry cluster (read-only, reportable) */
+#define APP_ZIGBEE_PERF_ATTR_LOAD_1S          0x0000u     /* CPU load over 1 s (per mille), uint16 */
+#define APP_ZIGBEE_PERF_ATTR_LOAD_10S         0x0001u     /* CPU load over 10 s (per mille), uint16 */
+#define APP_ZIGBEE_PERF_ATTR_LOAD_60S         0x0002u     /* CPU load over 60 s (per mille), uint16 */
+#define APP_ZIGBEE_PERF_ATTR_HEAP_USED        0x0010u     /* Zigbee heap used (bytes), uint32 */
+#define APP_ZIGBEE_PERF_ATTR_HEAP_PEAK        0x0011u     /* Zigbee heap peak (bytes), uint32 */
+#define APP_ZIGBEE_PERF_ATTR_MAC_RETRY_RATE   0x0020u     /* MAC unicast retries per transmission (per mille), uint16 */
+#define APP_ZIGBEE_PERF_ATTR_TRACE_DROPS      0x0030u     /* Traces dropped (trace FIFO full), uint32 */
+#define APP_ZIGBEE_PERF_ATTR_SEQ_MAX_LATENCY  0x0040u     /* Sequencer max SetTask to run latency (us), uint32 */
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_PerfInit               ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_PERF_H */
@@ -0,0 +1,330 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_poll.c
+  * @author  MCD Application Team
+  * @brief   Data poll scheduling of the Sleepy End Device : the long poll
+  *          interval follows the recent traffic (back to the minimum when the
+  *          Parent has data, doubled up to the LongPollInterval attribute when
+  *          not), and an activity of the application requests a fast poll period.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_poll.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+#include "zigbee.nwk.h"
+#include "zcl/zcl.h"
+#include "zcl/general/zcl.poll.control.h"
+
+#if (CFG_ZIGBEE_SED_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define POLL_QUARTER_SECOND             (250u)      /* Unit (in ms) of the Poll Control attributes */
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZigBeeT               * pstPollZigbee;
+static struct ZbZclClusterT         * pstPollServer;
+static UTIL_TIMER_Object_t          stPollTimer;
+static APP_ZIGBEE_PollStats_t       stPollStats;
+static bool                         bPollInProgress;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     PollTask                ( void );
+static void     PollTimerElapsed        ( void * arg );
+static void     PollSyncCallback        ( struct ZbNlmeSyncConfT * pstSyncConf, void * arg );
+static void     PollSchedule            ( void );
+static uint32_t PollGetLongInterval     ( void );
+static bool     PollCheckInRsp          ( struct ZbZclClusterT * pstCluster, struct zcl_poll_checkin_rsp_t * pstRspInfo,
+                                          struct ZbZclAddrInfoT * pstSrcInfo, void * arg );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Allocate the Poll Control Server and initialize the Task and Timer of the data polls.
+ * @param  pstZigbee    Zigbee stack handler
+ * @param  cEndpoint    Endpoint of the Server
+ * @param  iProfileId   Profile of the Endpoint
+ * @retval None
+ */
+void APP_ZIGBEE_PollInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  struct ZbZclPollControlServerCallbackT  stCallbacks;
+
+  UNUSED( iProfileId );
+
+  pstPollZigbee = pstZigbee;
+  stPollStats.lInterval = CFG_ZIGBEE_SED_LONG_POLL_MIN;
+
+  UTIL_TIMER_Create( &stPollTimer, CFG_ZIGBEE_SED_LONG_POLL_MIN, UTIL_TIMER_ONESHOT, &PollTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_POLL ), UTIL_SEQ_RFU, PollTask );
+
+  memset( &stCallbacks, 0, sizeof( stCallbacks ) );
+  stCallbacks.checkin_rsp = PollCheckInRsp;
+
+  pstPollServer = zcl_poll_server_alloc( pstZigbee, cEndpoint, &stCallbacks, NULL );
+  if ( pstPollServer == NULL )
+  {
+    LOG_ERROR_APP( "Error, Poll Control Server allocation failed." );
+    return;
+  }
+  ZbZclClusterEndpointRegister( pstPollServer );
+
+  /* The long polls are done by the application, at most every LongPollInterval (writable by the Client) */
+  (void)ZbZclAttrIntegerWrite( pstPollServer, ZCL_POLL_LONG_POLL_INTERVAL, ( CFG_ZIGBEE_SED_LONG_POLL_MAX / POLL_QUARTER_SECOND ) );
+  (void)ZbZclAttrIntegerWrite( pstPollServer, ZCL_POLL_LONG_POLL_FROM_CLUSTER, 0 );
+}
+
+/**
+ * @brief  Start the data polls (Network joined).
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_PollStart( void )
+{
+  stPollStats.lInterval = CFG_ZIGBEE_SED_LONG_POLL_MIN;
+  PollSchedule();
+}
+
+/**
+ * @brief  Activity of the application (a request waiting for its response) : poll fast for
+ *         CFG_ZIGBEE_SED_FAST_POLL_TIMEOUT, then restart the long polls from the minimum interval.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_PollActivity( void )
+{
+  if ( ( pstPollZigbee == NULL ) || ( APP_ZIGBEE_IsAppliJoinNetwork() == false ) )
+  {
+    return;
+  }
+
+  if ( ZbNwkFastPollRequest( pstPollZigbee, ZB_NWK_SYNC_DEFAULT_DELAY_MS, CFG_ZIGBEE_SED_FAST_POLL_TIMEOUT ) != NULL )
+  {
+    stPollStats.lFastPolls++;
+  }
+
+  stPollStats.lInterval = CFG_ZIGBEE_SED_LONG_POLL_MIN;
+  PollSchedule();
+}
+
+/**
+ * @brief  Statistics of the data polls.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_PollStats_t * APP_ZIGBEE_PollGetStats( void )
+{
+  return &stPollStats;
+}
+
+/**
+ * @brief  Data poll serial command : POLL (statistics).
+ * @param  szCommand  Command received
+ * @retval True if the command is a data poll command.
+ */
+bool APP_ZIGBEE_PollSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "POLL" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "Polls : %d sent, %d with data, %d fast poll periods, %d errors, long poll every %d ms (at most %d ms).",
+                stPollStats.lPolls, stPollStats.lDataPolls, stPollStats.lFastPolls, stPollStats.lErrors,
+                stPollStats.lInterval, PollGetLongInterval() );
+
+  return true;
+}
+
+/**
+ * @brief  Maximum long poll interval : LongPollInterval attribute.
+ * @param  None
+ * @retval Interval in ms
+ */
+static uint32_t PollGetLongInterval( void )
+{
+  enum ZclStatusCodeT   eStatus = ZCL_STATUS_FAILURE;
+  long long             llValue = 0;
+
+  if ( pstPollServer != NULL )
+  {
+    llValue = ZbZclAttrIntegerRead( pstPollServer, ZCL_POLL_LONG_POLL_INTERVAL, NULL, &eStatus );
+  }
+  if ( ( eStatus != ZCL_STATUS_SUCCESS ) || ( llValue <= 0 ) )
+  {
+    return CFG_ZIGBEE_SED_LONG_POLL_MAX;
+  }
+
+  return ( (uint32_t)llValue * POLL_QUARTER_SECOND );
+}
+
+/**
+ * @brief  Schedule the next long poll at the current interval.
+ * @param  None
+ * @retval None
+ */
+static void PollSchedule( void )
+{
+  (void)UTIL_TIMER_Stop( &stPollTimer );
+  (void)UTIL_TIMER_SetPeriod( &stPollTimer, stPollStats.lInterval );
+  (void)UTIL_TIMER_Start( &stPollTimer );
+}
+
+/**
+ * @brief  Long poll Timer elapsed : poll in the Task.
+ * @param  arg    Not used
+ * @retval None
+ */
+static void PollTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_POLL ), TASK_PRIO_ZIGBEE_POLL );
+}
+
+/**
+ * @brief  Send a data poll to the Parent (NLME-SYNC).
+ * @param  None
+ * @retval None
+ */
+static void PollTask( void )
+{
+  struct ZbNlmeSyncReqT   stSyncReq;
+
+  if ( bPollInProgress != false )
+  {
+    return;
+  }
+
+  stSyncReq.track = false;
+  if ( ZbNlmeSyncReq( pstPollZigbee, &stSyncReq, PollSyncCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    stPollStats.lErrors++;
+    PollSchedule();
+    return;
+  }
+
+  bPollInProgress = true;
+  stPollStats.lPolls++;
+}
+
+/**
+ * @brief  End of a data poll : data in the Parent means more may follow (minimum interval), no data
+ *         doubles the interval up to the LongPollInterval.
+ * @param  pstSyncConf  NLME-SYNC confirm
+ * @param  arg          Not used
+ * @retval None
+ */
+static void PollSyncCallback( struct ZbNlmeSyncConfT * pstSyncConf, void * arg )
+{
+  uint32_t    lMax;
+
+  UNUSED( arg );
+  bPollInProgress = false;
+
+  lMax = PollGetLongInterval();
+  if ( pstSyncConf->status == ZB_STATUS_SUCCESS )
+  {
+    stPollStats.lDataPolls++;
+    stPollStats.lInterval = CFG_ZIGBEE_SED_LONG_POLL_MIN;
+  }
+  else
+  {
+    if ( pstSyncConf->status != ZB_WPAN_STATUS_NO_DATA )
+    {
+      stPollStats.lErrors++;
+    }
+    stPollStats.lInterval *= 2u;
+  }
+
+  if ( stPollStats.lInterval > lMax )
+  {
+    stPollStats.lInterval = lMax;
+  }
+  PollSchedule();
+}
+
+/**
+ * @brief  Check-in Response of a Client : the fast poll period requested is accepted.
+ * @param  pstCluster   Poll Control Server
+ * @param  pstRspInfo   Check-in Response
+ * @param  pstSrcInfo   Client
+ * @param  arg          Not used
+ * @retval True to start the fast polls.
+ */
+static bool PollCheckInRsp( struct ZbZclClusterT * pstCluster, struct zcl_poll_checkin_rsp_t * pstRspInfo,
+                            struct ZbZclAddrInfoT * pstSrcInfo, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( pstSrcInfo );
+  UNUSED( arg );
+
+  if ( pstRspInfo->start_fast_poll != false )
+  {
+    stPollStats.lFastPolls++;
+  }
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
+
+/**
+ * @brief  Router : no data poll.
+ */
+void APP_ZIGBEE_PollInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+}
+
+/**
+ * @brief  Router : no data poll.
+ */
+void APP_ZIGBEE_PollStart( void )
+{
+}
+
+/**
+ * @brief  Router : no data poll.
+ */
+void APP_ZIGBEE_PollActivity( void )
+{
+}
+
+/**
+ * @brief  Router : no command.
+ */
+bool APP_ZIGBEE_PollSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Router : no statistics.
+ */
+const APP_ZIGBEE_PollStats_t * APP_ZIGBEE_PollGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_SED_SUPPORTED != 0) */
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_poll.h
+  * @author  MCD Application Team
+  * @brief   Interface of the data poll scheduling of the Sleepy End Device.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_POLL_H
+#define APP_ZIGBEE_POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the data polls */
+typedef struct
+{
+  uint32_t    lPolls;                 /* Data polls sent to the Parent */
+  uint32_t    lDataPolls;             /* Data polls that have received data */
+  uint32_t    lFastPolls;             /* Fast poll periods requested on activity */
+  uint32_t    lErrors;                /* Data polls not sent or without answer of the Parent */
+  uint32_t    lInterval;              /* Current long poll interval (in ms) */
+} APP_ZIGBEE_PollStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_PollInit               ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId );
+void      APP_ZIGBEE_PollStart              ( void );
+void      APP_ZIGBEE_PollActivity           ( void );
+bool      APP_ZIGBEE_PollSerialCmdExecute   ( const char * szCommand );
+
+const APP_ZIGBEE_PollStats_t * APP_ZIGBEE_PollGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_POLL_H */
@@ -0,0 +1,394 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_report.c
+  * @author  MCD Application Team
+  * @brief   Attribute report aggregator : the attributes registered are reported
+  *          on a shared schedule, and the ones due at the same tick for the same
+  *          destination and cluster are sent in a single Report Attributes frame.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_report.h"
+#include "app_zigbee_frame.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#if (CFG_ZIGBEE_REPORT_AGGREGATION_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define REPORT_RECORD_HEADER_LENGTH     (3u)        /* Attribute Id (2) and Data Type (1) of a report record */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  struct ZbZclClusterT  * pstCluster;
+  struct ZbApsAddrT     stDest;
+  uint16_t              iAttributeId;
+  uint16_t              iMinInterval;                         /* s */
+  uint16_t              iMaxInterval;                         /* s */
+  uint32_t              lLastReportTick;
+  uint8_t               cValueLength;
+  uint8_t               acValue[CFG_ZIGBEE_REPORT_VALUE_MAX]; /* Last value reported */
+  bool                  bDue;
+} ReportAttribute_t;
+
+/* Private variables ---------------------------------------------------------*/
+static ReportAttribute_t            astReportAttribute[CFG_ZIGBEE_REPORT_ATTRIBUTE_MAX];
+static uint16_t                     iReportAttributeNb;
+static uint8_t                      acReportFrame[APP_ZIGBEE_FRAME_HEADROOM + CFG_ZIGBEE_REPORT_FRAME_MAX];
+static APP_ZIGBEE_ReportStats_t     stReportStats;
+static UTIL_TIMER_Object_t          stReportTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     ReportTask              ( void );
+static void     ReportTimerElapsed      ( void * arg );
+static void     ReportSendFrame         ( uint16_t iFirst );
+static void     ReportSendCallback      ( struct ZbApsdeDataConfT * pstConf, void * arg );
+static bool     ReportIsSameTarget      ( const ReportAttribute_t * pstFirst, const ReportAttribute_t * pstSecond );
+static uint8_t  ReportReadValue         ( const ReportAttribute_t * pstAttribute, enum ZclDataTypeT * peType, uint8_t * pValue );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the aggregator : Task and Timer of the shared schedule.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_ReportInit( void )
+{
+  UTIL_TIMER_Create( &stReportTimer, CFG_ZIGBEE_REPORT_WINDOW, UTIL_TIMER_PERIODIC, &ReportTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_REPORT ), UTIL_SEQ_RFU, ReportTask );
+}
+
+/**
+ * @brief  Report an attribute through the aggregator instead of the stack own reporting of the cluster.
+ *         A changed value is reported after iMinInterval at least, and the value is reported at least every
+ *         iMaxInterval. Both are aligned on the CFG_ZIGBEE_REPORT_WINDOW schedule.
+ * @param  pstCluster     Server cluster of the attribute
+ * @param  iAttributeId   Attribute, reportable, of at most CFG_ZIGBEE_REPORT_VALUE_MAX bytes
+ * @param  iMinInterval   Minimum interval (in s) between two reports
+ * @param  iMaxInterval   Maximum interval (in s) between two reports
+ * @param  pstDest        Destination of the reports, NULL for the binding table
+ * @retval True if the attribute is added.
+ */
+bool APP_ZIGBEE_ReportAdd( struct ZbZclClusterT * pstCluster, uint16_t iAttributeId, uint16_t iMinInterval,
+                           uint16_t iMaxInterval, const struct ZbApsAddrT * pstDest )
+{
+  ReportAttribute_t   * pstAttribute;
+  enum ZclDataTypeT   eType;
+
+  if ( ( pstCluster == NULL ) || ( iReportAttributeNb == CFG_ZIGBEE_REPORT_ATTRIBUTE_MAX ) || ( iMaxInterval < iMinInterval ) )
+  {
+    return false;
+  }
+
+  pstAttribute = &astReportAttribute[iReportAttributeNb];
+  memset( pstAttribute, 0, sizeof( ReportAttribute_t ) );
+  pstAttribute->pstCluster = pstCluster;
+  pstAttribute->iAttributeId = iAttributeId;
+  pstAttribute->iMinInterval = iMinInterval;
+  pstAttribute->iMaxInterval = iMaxInterval;
+  if ( pstDest != NULL )
+  {
+    pstAttribute->stDest = *pstDest;
+  }
+  else
+  {
+    pstAttribute->stDest.mode = ZB_APSDE_ADDRMODE_NOTPRESENT;
+  }
+
+  /* Verify that the attribute can be reported, and keep its value */
+  pstAttribute->cValueLength = ReportReadValue( pstAttribute, &eType, pstAttribute->acValue );
+  if ( pstAttribute->cValueLength == 0u )
+  {
+    return false;
+  }
+
+  /* The stack does not report it anymore */
+  (void)ZbZclAttrReportConfigDefault( pstCluster, iAttributeId, ZCL_ATTR_REPORT_MIN_INTVL_DISABLE, ZCL_ATTR_REPORT_MAX_INTVL_DISABLE, NULL );
+
+  /* First report at the next tick */
+  pstAttribute->lLastReportTick = ( HAL_GetTick() - ( (uint32_t)iMaxInterval * 1000u ) );
+  iReportAttributeNb++;
+
+  if ( UTIL_TIMER_IsRunning( &stReportTimer ) == 0u )
+  {
+    UTIL_TIMER_Start( &stReportTimer );
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Statistics of the aggregator.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_ReportStats_t * APP_ZIGBEE_ReportGetStats( void )
+{
+  return &stReportStats;
+}
+
+/**
+ * @brief  Report Task : mark the attributes due before the next tick, then send them grouped by destination and cluster.
+ * @param  None
+ * @retval None
+ */
+static void ReportTask( void )
+{
+  ReportAttribute_t   * pstAttribute;
+  enum ZclDataTypeT   eType;
+  uint8_t             acValue[CFG_ZIGBEE_REPORT_VALUE_MAX];
+  uint8_t             cLength;
+  uint16_t            iIndex;
+  uint32_t            lElapsed;
+  bool                bChanged;
+
+  stReportStats.lTicks++;
+  for ( iIndex = 0; iIndex < iReportAttributeNb; iIndex++ )
+  {
+    pstAttribute = &astReportAttribute[iIndex];
+    cLength = ReportReadValue( pstAttribute, &eType, acValue );
+    if ( cLength == 0u )
+    {
+      continue;
+    }
+
+    bChanged = ( ( cLength != pstAttribute->cValueLength ) || ( memcmp( acValue, pstAttribute->acValue, cLength ) != 0 ) );
+    lElapsed = ( HAL_GetTick() - pstAttribute->lLastReportTick );
+
+    /* Maximum interval ending before the next tick is anticipated, minimum interval is always respected */
+    if ( ( ( lElapsed + CFG_ZIGBEE_REPORT_WINDOW ) > ( (uint32_t)pstAttribute->iMaxInterval * 1000u ) ) ||
+         ( ( bChanged != false ) && ( lElapsed >= ( (uint32_t)pstAttribute->iMinInterval * 1000u ) ) ) )
+    {
+      pstAttribute->bDue = true;
+    }
+  }
+
+  for ( iIndex = 0; iIndex < iReportAttributeNb; iIndex++ )
+  {
+    if ( astReportAttribute[iIndex].bDue != false )
+    {
+      ReportSendFrame( iIndex );
+    }
+  }
+}
+
+/**
+ * @brief  Send one Report Attributes frame with the due attributes of the same destination and cluster. The records
+ *         are serialized in place in the frame, the values read directly at their position.
+ * @param  iFirst   First due attribute of the frame
+ * @retval None
+ */
+static void ReportSendFrame( uint16_t iFirst )
+{
+  ReportAttribute_t         * pstFirst = &astReportAttribute[iFirst];
+  ReportAttribute_t         * pstAttribute;
+  APP_ZIGBEE_Frame_t        stFrame;
+  struct ZbZclHeaderT       stHeader;
+  enum ZclDataTypeT         eType;
+  uint8_t                   * pRecord;
+  uint8_t                   cLength;
+  uint16_t                  iIndex, iRoom, iAttributes = 0;
+
+  memset( &stHeader, 0, sizeof( stHeader ) );
+  stHeader.frameCtrl.frameType = ZCL_FRAMETYPE_PROFILE;
+  stHeader.frameCtrl.direction = ZCL_DIRECTION_TO_CLIENT;
+  stHeader.frameCtrl.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_TRUE;
+  stHeader.seqNum = ZbZclGetNextSeqnum( pstFirst->pstCluster->zb );
+  stHeader.cmdId = ZCL_COMMAND_REPORT;
+  if ( APP_ZIGBEE_FrameStart( &stFrame, acReportFrame, sizeof( acReportFrame ), pstFirst->pstCluster, &stHeader ) == false )
+  {
+    stReportStats.lFailures++;
+    return;
+  }
+
+  for ( iIndex = iFirst; iIndex < iReportAttributeNb; iIndex++ )
+  {
+    pstAttribute = &astReportAttribute[iIndex];
+    if ( ( pstAttribute->bDue == false ) || ( ReportIsSameTarget( pstFirst, pstAttribute ) == false ) )
+    {
+      continue;
+    }
+
+    pRecord = APP_ZIGBEE_FrameTail( &stFrame, &iRoom );
+    if ( iRoom < ( REPORT_RECORD_HEADER_LENGTH + CFG_ZIGBEE_REPORT_VALUE_MAX ) )
+    {
+      /* Frame full : the remaining attributes go in the next frame */
+      break;
+    }
+
+    cLength = ReportReadValue( pstAttribute, &eType, &pRecord[REPORT_RECORD_HEADER_LENGTH] );
+    if ( cLength == 0u )
+    {
+      pstAttribute->bDue = false;
+      continue;
+    }
+
+    pRecord[0] = (uint8_t)( pstAttribute->iAttributeId & 0xFFu );
+    pRecord[1] = (uint8_t)( pstAttribute->iAttributeId >> 8u );
+    pRecord[2] = (uint8_t)eType;
+    APP_ZIGBEE_FrameCommit( &stFrame, ( REPORT_RECORD_HEADER_LENGTH + cLength ) );
+
+    memcpy( pstAttribute->acValue, &pRecord[REPORT_RECORD_HEADER_LENGTH], cLength );
+    pstAttribute->cValueLength = cLength;
+    pstAttribute->lLastReportTick = HAL_GetTick();
+    pstAttribute->bDue = false;
+    iAttributes++;
+  }
+
+  if ( iAttributes == 0u )
+  {
+    return;
+  }
+
+  stReportStats.lAttributes += iAttributes;
+  stReportStats.lFrames++;
+  if ( APP_ZIGBEE_FrameSend( &stFrame, &pstFirst->stDest, ReportSendCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    stReportStats.lFailures++;
+  }
+}
+
+/**
+ * @brief  Confirmation of a Report Attributes frame.
+ * @param  pstConf  APSDE-DATA.confirm
+ * @param  arg      Not used
+ * @retval None
+ */
+static void ReportSendCallback( struct ZbApsdeDataConfT * pstConf, void * arg )
+{
+  UNUSED( arg );
+
+  if ( pstConf->status != ZB_STATUS_SUCCESS )
+  {
+    stReportStats.lFailures++;
+  }
+}
+
+/**
+ * @brief  Callback triggered at each tick of the shared schedule
+ * @param  arg : Not used
+ * @retval None
+ */
+static void ReportTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_REPORT ), TASK_PRIO_ZIGBEE_REPORT );
+}
+
+/**
+ * @brief  Indicate if two attributes can be reported in the same frame (same cluster and destination)
+ * @param  pstFirst   First attribute
+ * @param  pstSecond  Second attribute
+ * @retval True if same cluster and destination.
+ */
+static bool ReportIsSameTarget( const ReportAttribute_t * pstFirst, const ReportAttribute_t * pstSecond )
+{
+  const struct ZbApsAddrT   * pstDest1 = &pstFirst->stDest;
+  const struct ZbApsAddrT   * pstDest2 = &pstSecond->stDest;
+
+  return ( ( pstFirst->pstCluster == pstSecond->pstCluster ) && ( pstDest1->mode == pstDest2->mode ) &&
+           ( pstDest1->endpoint == pstDest2->endpoint ) && ( pstDest1->nwkAddr == pstDest2->nwkAddr ) &&
+           ( pstDest1->extAddr == pstDest2->extAddr ) );
+}
+
+/**
+ * @brief  Read the value of an attribute, in the ZCL format of the reports.
+ * @param  pstAttribute   Attribute
+ * @param  peType         Data type of the attribute
+ * @param  pValue         Value (CFG_ZIGBEE_REPORT_VALUE_MAX bytes)
+ * @retval Length of the value, 0 if it cannot be read or reported.
+ */
+static uint8_t ReportReadValue( const ReportAttribute_t * pstAttribute, enum ZclDataTypeT * peType, uint8_t * pValue )
+{
+  int   iLength;
+
+  if ( ZbZclAttrRead( pstAttribute->pstCluster, pstAttribute->iAttributeId, peType, pValue, CFG_ZIGBEE_REPORT_VALUE_MAX, true ) != ZCL_STATUS_SUCCESS )
+  {
+    return 0;
+  }
+
+  iLength = ZbZclAttrParseLength( *peType, pValue, CFG_ZIGBEE_REPORT_VALUE_MAX, 0 );
+  if ( ( iLength <= 0 ) || ( iLength > (int)CFG_ZIGBEE_REPORT_VALUE_MAX ) )
+  {
+    return 0;
+  }
+
+  return (uint8_t)iLength;
+}
+
+/**
+ * @brief  Aggregator serial command : REPORTSTATS.
+ * @param  szCommand  Command received
+ * @retval True if the command is an aggregator command.
+ */
+bool APP_ZIGBEE_ReportSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "REPORTSTATS" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "Reports : %d attributes on a %d ms schedule, %d ticks, %d attributes sent in %d frames (%d failed).",
+                iReportAttributeNb, CFG_ZIGBEE_REPORT_WINDOW, stReportStats.lTicks, stReportStats.lAttributes,
+                stReportStats.lFrames, stReportStats.lFailures );
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_REPORT_AGGREGATION_SUPPORTED != 0) */
+
+/**
+ * @brief  Report aggregation not supported.
+ */
+void APP_ZIGBEE_ReportInit( void )
+{
+}
+
+/**
+ * @brief  Report aggregation not supported : the attribute is reported by the stack.
+ */
+bool APP_ZIGBEE_ReportAdd( struct ZbZclClusterT * pstCluster, uint16_t iAttributeId, uint16_t iMinInterval,
+                           uint16_t iMaxInterval, const struct ZbApsAddrT * pstDest )
+{
+  UNUSED( pstDest );
+
+  return ( ZbZclAttrReportConfigDefault( pstCluster, iAttributeId, iMinInterval, iMaxInterval, NULL ) == ZCL_STATUS_SUCCESS );
+}
+
+/**
+ * @brief  Report aggregation not supported : no command.
+ */
+bool APP_ZIGBEE_ReportSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Report aggregation not supported : no statistics.
+ */
+const APP_ZIGBEE_ReportStats_t * APP_ZIGBEE_ReportGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_REPORT_AGGREGATION_SUPPORTED != 0) */
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_report.h
+  * @author  MCD Application Team
+  * @brief   Interface of the attribute report aggregator.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_REPORT_H
+#define APP_ZIGBEE_REPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the aggregator */
+typedef struct
+{
+  uint32_t    lTicks;                 /* Number of schedule ticks */
+  uint32_t    lAttributes;            /* Number of attributes reported */
+  uint32_t    lFrames;                /* Number of Report Attributes frames sent */
+  uint32_t    lFailures;              /* Number of frames refused by the stack or not confirmed */
+} APP_ZIGBEE_ReportStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_ReportInit             ( void );
+bool      APP_ZIGBEE_ReportAdd              ( struct ZbZclClusterT * pstCluster, uint16_t iAttributeId, uint16_t iMinInterval,
+                                              uint16_t iMaxInterval, const struct ZbApsAddrT * pstDest );
+bool      APP_ZIGBEE_ReportSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_ReportStats_t * APP_ZIGBEE_ReportGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_REPORT_H */
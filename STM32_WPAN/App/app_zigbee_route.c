@@ -0,0 +1,354 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_route.c
+  * @author  MCD Application Team
+  * @brief   Hot destinations tracker : the unicast destinations used often get
+  *          their route discovered ahead, out of the send path, and are then
+  *          sent to without route discovery.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_route.h"
+#include "app_zigbee_addr.h"
+
+#include "stm32_timer.h"
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.nwk.h"
+
+#if (CFG_ZIGBEE_ROUTE_CACHE_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define ROUTE_NO_ENTRY                  (0xFFFFu)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint16_t    iNwkAddr;               /* Destination, ZB_NWK_ADDR_UNDEFINED when free */
+  uint16_t    iScore;                 /* Uses, halved at each tick */
+  uint32_t    lRefreshTick;           /* Last route discovery started */
+  bool        bRouteActive;           /* Active route or Neighbor at the last tick */
+} RouteHotDest_t;
+
+/* Private variables ---------------------------------------------------------*/
+static RouteHotDest_t               astRouteHotDest[CFG_ZIGBEE_ROUTE_HOT_MAX];
+static APP_ZIGBEE_RouteStats_t      stRouteStats;
+static UTIL_TIMER_Object_t          stRouteTimer;
+static uint16_t                     iRouteDiscovering = ROUTE_NO_ENTRY;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     RouteTimerElapsed       ( void * arg );
+static void     RouteDiscoveryCallback  ( struct ZbNlmeRouteDiscConfT * pstConf, void * arg );
+static bool     RouteIsActive           ( uint16_t iNwkAddr );
+static bool     RouteIsHot              ( const RouteHotDest_t * pstHotDest );
+static void     RoutePrintStats         ( void );
+
+/* Serial commands of the tracker */
+static const SerialCmd_t            astRouteSerialCmds[] =
+{
+  { "ROUTESTATS", RoutePrintStats, NULL },
+};
+
+static SerialCmdTable_t             stRouteSerialCmdTable =
+{
+  astRouteSerialCmds, ( sizeof( astRouteSerialCmds ) / sizeof( astRouteSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the tracker : no destination, Timer of the route refreshes.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_RouteInit( void )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_ROUTE_HOT_MAX; iIndex++ )
+  {
+    astRouteHotDest[iIndex].iNwkAddr = ZB_NWK_ADDR_UNDEFINED;
+  }
+
+  UTIL_TIMER_Create( &stRouteTimer, CFG_ZIGBEE_ROUTE_TICK, UTIL_TIMER_PERIODIC, &RouteTimerElapsed, NULL );
+  UTIL_TIMER_Start( &stRouteTimer );
+  Serial_CMD_Interpreter_RegisterTable( &stRouteSerialCmdTable );
+}
+
+/**
+ * @brief  Record an unicast to a destination, and indicate if its route shall be discovered by the send.
+ *         A hot destination with an active route is sent to without route discovery (discoverRoute = false).
+ * @param  pstDest    Destination of the frame
+ * @retval Value of discoverRoute for the request.
+ */
+bool APP_ZIGBEE_RouteUse( const struct ZbApsAddrT * pstDest )
+{
+  RouteHotDest_t  * pstHotDest = NULL;
+  uint16_t        iNwkAddr, iIndex, iColdest = 0;
+
+  if ( pstDest->mode == ZB_APSDE_ADDRMODE_SHORT )
+  {
+    iNwkAddr = pstDest->nwkAddr;
+  }
+  else if ( pstDest->mode == ZB_APSDE_ADDRMODE_EXT )
+  {
+    iNwkAddr = APP_ZIGBEE_AddrLookupNwk( pstDest->extAddr );
+  }
+  else
+  {
+    /* Group, binding table : not tracked */
+    return true;
+  }
+
+  if ( iNwkAddr >= ZB_NWK_ADDR_BCAST_MIN )
+  {
+    return true;
+  }
+
+  stRouteStats.lUses++;
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_ROUTE_HOT_MAX; iIndex++ )
+  {
+    if ( astRouteHotDest[iIndex].iNwkAddr == iNwkAddr )
+    {
+      pstHotDest = &astRouteHotDest[iIndex];
+      break;
+    }
+    if ( astRouteHotDest[iIndex].iScore < astRouteHotDest[iColdest].iScore )
+    {
+      iColdest = iIndex;
+    }
+  }
+
+  if ( pstHotDest == NULL )
+  {
+    /* New destination in place of the least used one (a free one has a null score) */
+    if ( iColdest == iRouteDiscovering )
+    {
+      return true;
+    }
+    pstHotDest = &astRouteHotDest[iColdest];
+    memset( pstHotDest, 0, sizeof( RouteHotDest_t ) );
+    pstHotDest->iNwkAddr = iNwkAddr;
+  }
+
+  if ( pstHotDest->iScore < UINT16_MAX )
+  {
+    pstHotDest->iScore++;
+  }
+
+  if ( ( RouteIsHot( pstHotDest ) != false ) && ( pstHotDest->bRouteActive != false ) )
+  {
+    stRouteStats.lHotActive++;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Statistics of the tracker.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_RouteStats_t * APP_ZIGBEE_RouteGetStats( void )
+{
+  return &stRouteStats;
+}
+
+/**
+ * @brief  Tick of the tracker : state of the routes of the hot destinations, and discovery ahead of the one not active
+ *         (or the oldest refreshed after CFG_ZIGBEE_ROUTE_REFRESH_AGE). One discovery at a time.
+ * @param  arg : Not used
+ * @retval None
+ */
+static void RouteTimerElapsed( void * arg )
+{
+  struct ZbNlmeRouteDiscReqT  stRequest;
+  RouteHotDest_t              * pstHotDest;
+  uint16_t                    iIndex, iDue = ROUTE_NO_ENTRY;
+  uint32_t                    lAge, lDueAge = 0;
+
+  UNUSED( arg );
+
+  if ( APP_ZIGBEE_IsAppliJoinNetwork() == false )
+  {
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_ROUTE_HOT_MAX; iIndex++ )
+  {
+    pstHotDest = &astRouteHotDest[iIndex];
+    if ( pstHotDest->iNwkAddr == ZB_NWK_ADDR_UNDEFINED )
+    {
+      continue;
+    }
+
+    pstHotDest->bRouteActive = RouteIsActive( pstHotDest->iNwkAddr );
+    if ( RouteIsHot( pstHotDest ) != false )
+    {
+      lAge = ( HAL_GetTick() - pstHotDest->lRefreshTick );
+      if ( pstHotDest->bRouteActive == false )
+      {
+        lAge = UINT32_MAX;
+      }
+      if ( ( lAge >= CFG_ZIGBEE_ROUTE_REFRESH_AGE ) && ( lAge >= lDueAge ) )
+      {
+        iDue = iIndex;
+        lDueAge = lAge;
+      }
+    }
+
+    /* The uses of the previous ticks count for less and less */
+    pstHotDest->iScore >>= 1u;
+  }
+
+  if ( ( iDue == ROUTE_NO_ENTRY ) || ( iRouteDiscovering != ROUTE_NO_ENTRY ) )
+  {
+    return;
+  }
+
+  pstHotDest = &astRouteHotDest[iDue];
+  pstHotDest->lRefreshTick = HAL_GetTick();
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dstAddrMode = ZB_NWK_ADDRMODE_SHORT;
+  stRequest.dstAddr = pstHotDest->iNwkAddr;
+  stRequest.radius = 0;
+  stRequest.noRouteCache = 0;
+
+  stRouteStats.lDiscoveries++;
+  iRouteDiscovering = iDue;
+  if ( ZbNlmeRouteDiscReq( stZigbeeAppInfo.pstZigbee, &stRequest, RouteDiscoveryCallback, NULL ) != ZB_STATUS_SUCCESS )
+  {
+    iRouteDiscovering = ROUTE_NO_ENTRY;
+    stRouteStats.lDiscoveryFailures++;
+  }
+}
+
+/**
+ * @brief  End of a route discovery started ahead.
+ * @param  pstConf  NLME-ROUTE-DISCOVERY.confirm
+ * @param  arg      Not used
+ * @retval None
+ */
+static void RouteDiscoveryCallback( struct ZbNlmeRouteDiscConfT * pstConf, void * arg )
+{
+  UNUSED( arg );
+
+  if ( iRouteDiscovering != ROUTE_NO_ENTRY )
+  {
+    astRouteHotDest[iRouteDiscovering].bRouteActive = ( pstConf->status == ZB_STATUS_SUCCESS );
+    iRouteDiscovering = ROUTE_NO_ENTRY;
+  }
+
+  if ( pstConf->status != ZB_STATUS_SUCCESS )
+  {
+    stRouteStats.lDiscoveryFailures++;
+  }
+}
+
+/**
+ * @brief  Indicate if a destination is reached without route discovery : Neighbor or active route.
+ * @param  iNwkAddr   Destination
+ * @retval True if no discovery is needed.
+ */
+static bool RouteIsActive( uint16_t iNwkAddr )
+{
+  struct ZbNwkNeighborT     stNeighbor;
+  struct ZbNwkRouteEntryT   stRoute;
+  uint16_t                  iIndex;
+
+  for ( iIndex = 0; ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( stNeighbor.nwkAddr == iNwkAddr )
+    {
+      return true;
+    }
+  }
+
+  for ( iIndex = 0; ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_RouteTable, &stRoute, sizeof( stRoute ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( stRoute.destAddr == iNwkAddr )
+    {
+      return ( stRoute.status == ZB_NWK_ROUTE_STATUS_ACTIVE );
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief  Indicate if a destination is hot : used at least CFG_ZIGBEE_ROUTE_HOT_THRESHOLD times recently.
+ * @param  pstHotDest   Destination
+ * @retval True if hot.
+ */
+static bool RouteIsHot( const RouteHotDest_t * pstHotDest )
+{
+  return ( pstHotDest->iScore >= CFG_ZIGBEE_ROUTE_HOT_THRESHOLD );
+}
+
+/**
+ * @brief  Print the hot destinations and the statistics of the tracker.
+ * @param  None
+ * @retval None
+ */
+static void RoutePrintStats( void )
+{
+  uint16_t  iIndex;
+
+  LOG_INFO_APP( "Routes : %d unicasts, %d to a hot destination with a route, %d discoveries ahead (%d failed).",
+                stRouteStats.lUses, stRouteStats.lHotActive, stRouteStats.lDiscoveries, stRouteStats.lDiscoveryFailures );
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_ROUTE_HOT_MAX; iIndex++ )
+  {
+    if ( astRouteHotDest[iIndex].iNwkAddr != ZB_NWK_ADDR_UNDEFINED )
+    {
+      LOG_INFO_APP( "  0x%04X : score %d%s, route %s", astRouteHotDest[iIndex].iNwkAddr, astRouteHotDest[iIndex].iScore,
+                    ( RouteIsHot( &astRouteHotDest[iIndex] ) != false ) ? " (hot)" : "",
+                    ( astRouteHotDest[iIndex].bRouteActive != false ) ? "active" : "unknown" );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_ROUTE_CACHE_SUPPORTED != 0) */
+
+/**
+ * @brief  Hot destinations tracker not supported.
+ */
+void APP_ZIGBEE_RouteInit( void )
+{
+}
+
+/**
+ * @brief  Hot destinations tracker not supported : the route is discovered by the send.
+ */
+bool APP_ZIGBEE_RouteUse( const struct ZbApsAddrT * pstDest )
+{
+  UNUSED( pstDest );
+
+  return true;
+}
+
+/**
+ * @brief  Hot destinations tracker not supported : no statistics.
+ */
+const APP_ZIGBEE_RouteStats_t * APP_ZIGBEE_RouteGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_ROUTE_CACHE_SUPPORTED != 0) */
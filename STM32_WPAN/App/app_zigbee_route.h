@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_route.h
+  * @author  MCD Application Team
+  * @brief   Interface of the hot destinations tracker (routes discovered ahead).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_ROUTE_H
+#define APP_ZIGBEE_ROUTE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the tracker */
+typedef struct
+{
+  uint32_t    lUses;                  /* Number of unicasts recorded */
+  uint32_t    lHotActive;             /* Number of unicasts to a hot destination with an active route */
+  uint32_t    lDiscoveries;           /* Number of route discoveries started ahead */
+  uint32_t    lDiscoveryFailures;     /* Number of route discoveries refused or failed */
+} APP_ZIGBEE_RouteStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_RouteInit              ( void );
+bool      APP_ZIGBEE_RouteUse               ( const struct ZbApsAddrT * pstDest );
+
+const APP_ZIGBEE_RouteStats_t * APP_ZIGBEE_RouteGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_ROUTE_H */
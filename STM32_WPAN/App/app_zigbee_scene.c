@@ -0,0 +1,255 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_scene.c
+  * @author  MCD Application Team
+  * @brief   Scene cache of the OnOff Server Endpoint : at Store Scene, the
+  *          output as driven (OnOff state and PWM frame) is kept as a
+  *          snapshot, so that a Recall Scene drives it from the fast path in
+  *          constant time, without parsing the extension fields of each
+  *          cluster of the scene. The stack keeps the scene table, and still
+  *          processes the recall (attributes, response).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_level.h"
+#include "app_zigbee_scene.h"
+
+#include "serial_cmd_interpreter.h"
+
+#if (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define SCENE_CACHE_SIZE                CFG_ZIGBEE_ONOFF_SERVER_SCENES_MAX   /* As the scene table of the stack */
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_SceneSnapshot_t   astSceneCache[SCENE_CACHE_SIZE];
+static APP_ZIGBEE_SceneStats_t      stSceneStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static APP_ZIGBEE_SceneSnapshot_t * SceneLookup ( uint16_t iGroup, uint8_t cScene );
+static void     ScenePrintStats         ( void );
+
+/* Serial commands of the scene cache */
+static const SerialCmd_t            astSceneSerialCmds[] =
+{
+  { "SCENECACHE", ScenePrintStats, NULL },
+};
+
+static SerialCmdTable_t             stSceneSerialCmdTable =
+{
+  astSceneSerialCmds, ( sizeof( astSceneSerialCmds ) / sizeof( astSceneSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the scene cache : no snapshot.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_SceneInit( void )
+{
+  memset( astSceneCache, 0, sizeof( astSceneCache ) );
+  memset( &stSceneStats, 0, sizeof( stSceneStats ) );
+
+  Serial_CMD_Interpreter_RegisterTable( &stSceneSerialCmdTable );
+}
+
+/**
+ * @brief  Store Scene : snapshot of the output as driven, replacing the previous one of the scene.
+ * @param  iGroup  Group of the scene
+ * @param  cScene  Scene
+ * @param  bOn     OnOff state of the output
+ * @retval None
+ */
+void APP_ZIGBEE_SceneStore( uint16_t iGroup, uint8_t cScene, bool bOn )
+{
+  APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+  uint8_t                       cIndex;
+
+  pstSnapshot = SceneLookup( iGroup, cScene );
+  for ( cIndex = 0; ( pstSnapshot == NULL ) && ( cIndex < SCENE_CACHE_SIZE ); cIndex++ )
+  {
+    if ( astSceneCache[cIndex].bValid == false )
+    {
+      pstSnapshot = &astSceneCache[cIndex];
+    }
+  }
+
+  if ( pstSnapshot == NULL )
+  {
+    stSceneStats.lFull++;
+    return;
+  }
+
+  pstSnapshot->iGroup = iGroup;
+  pstSnapshot->cScene = cScene;
+  pstSnapshot->bOn = bOn;
+  APP_ZIGBEE_LevelGetFrame( pstSnapshot->aiFrame );
+  pstSnapshot->bValid = true;
+  stSceneStats.lStored++;
+}
+
+/**
+ * @brief  Remove the snapshots of scenes the stack removes or rewrites (Add Scene, Copy Scene : the recall of these
+ *         ones goes through the stack).
+ * @param  lGroup  Group, or APP_ZIGBEE_SCENE_GROUP_ALL
+ * @param  iScene  Scene, or APP_ZIGBEE_SCENE_ALL
+ * @retval None
+ */
+void APP_ZIGBEE_SceneRemove( uint32_t lGroup, uint16_t iScene )
+{
+  APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+
+  for ( pstSnapshot = astSceneCache; pstSnapshot < &astSceneCache[SCENE_CACHE_SIZE]; pstSnapshot++ )
+  {
+    if ( ( pstSnapshot->bValid != false ) &&
+         ( ( lGroup == pstSnapshot->iGroup ) || ( ( lGroup == APP_ZIGBEE_SCENE_GROUP_ALL ) && ( pstSnapshot->iGroup != 0u ) ) ) &&
+         ( ( iScene == pstSnapshot->cScene ) || ( iScene == APP_ZIGBEE_SCENE_ALL ) ) )
+    {
+      pstSnapshot->bValid = false;
+      stSceneStats.lRemoved++;
+    }
+  }
+}
+
+/**
+ * @brief  Snapshot of a scene, for its recall.
+ * @param  iGroup  Group of the scene
+ * @param  cScene  Scene
+ * @retval Snapshot, or NULL if the scene is not cached.
+ */
+const APP_ZIGBEE_SceneSnapshot_t * APP_ZIGBEE_SceneFind( uint16_t iGroup, uint8_t cScene )
+{
+  const APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+
+  pstSnapshot = SceneLookup( iGroup, cScene );
+  if ( pstSnapshot != NULL )
+  {
+    stSceneStats.lRecalled++;
+  }
+  else
+  {
+    stSceneStats.lMissed++;
+  }
+
+  return pstSnapshot;
+}
+
+/**
+ * @brief  Return the statistics of the scene cache.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_SceneStats_t * APP_ZIGBEE_SceneGetStats( void )
+{
+  return &stSceneStats;
+}
+
+/**
+ * @brief  Snapshot of a scene (at most CFG_ZIGBEE_ONOFF_SERVER_SCENES_MAX compared, the clusters of the scene do not
+ *         matter).
+ * @param  iGroup  Group of the scene
+ * @param  cScene  Scene
+ * @retval Snapshot, or NULL if the scene is not cached.
+ */
+static APP_ZIGBEE_SceneSnapshot_t * SceneLookup( uint16_t iGroup, uint8_t cScene )
+{
+  APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+
+  for ( pstSnapshot = astSceneCache; pstSnapshot < &astSceneCache[SCENE_CACHE_SIZE]; pstSnapshot++ )
+  {
+    if ( ( pstSnapshot->bValid != false ) && ( pstSnapshot->iGroup == iGroup ) && ( pstSnapshot->cScene == cScene ) )
+    {
+      return pstSnapshot;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief  Print the statistics and the snapshots of the scene cache.
+ * @param  None
+ * @retval None
+ */
+static void ScenePrintStats( void )
+{
+  const APP_ZIGBEE_SceneSnapshot_t  * pstSnapshot;
+
+  LOG_INFO_APP( "Scene cache : %d stored, %d recalled, %d missed, %d removed, %d full.", stSceneStats.lStored,
+                stSceneStats.lRecalled, stSceneStats.lMissed, stSceneStats.lRemoved, stSceneStats.lFull );
+
+  for ( pstSnapshot = astSceneCache; pstSnapshot < &astSceneCache[SCENE_CACHE_SIZE]; pstSnapshot++ )
+  {
+    if ( pstSnapshot->bValid != false )
+    {
+      LOG_INFO_APP( "  Group 0x%04X scene %d : %s, pulse %d.", pstSnapshot->iGroup, pstSnapshot->cScene,
+                    ( ( pstSnapshot->bOn != false ) ? "on" : "off" ), pstSnapshot->aiFrame[0] );
+    }
+  }
+}
+
+#else /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) */
+
+/**
+ * @brief  Scene cache not supported.
+ */
+void APP_ZIGBEE_SceneInit( void )
+{
+}
+
+/**
+ * @brief  Scene cache not supported.
+ */
+void APP_ZIGBEE_SceneStore( uint16_t iGroup, uint8_t cScene, bool bOn )
+{
+  UNUSED( iGroup );
+  UNUSED( cScene );
+  UNUSED( bOn );
+}
+
+/**
+ * @brief  Scene cache not supported.
+ */
+void APP_ZIGBEE_SceneRemove( uint32_t lGroup, uint16_t iScene )
+{
+  UNUSED( lGroup );
+  UNUSED( iScene );
+}
+
+/**
+ * @brief  Scene cache not supported : never cached.
+ */
+const APP_ZIGBEE_SceneSnapshot_t * APP_ZIGBEE_SceneFind( uint16_t iGroup, uint8_t cScene )
+{
+  UNUSED( iGroup );
+  UNUSED( cScene );
+  return NULL;
+}
+
+/**
+ * @brief  Scene cache not supported : no statistics.
+ */
+const APP_ZIGBEE_SceneStats_t * APP_ZIGBEE_SceneGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_SCENE_CACHE_SUPPORTED != 0) */
@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_scene.h
+  * @author  MCD Application Team
+  * @brief   Interface of the scene cache of the OnOff Server Endpoint
+  *          (actuation snapshots recalled from the fast path).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_SCENE_H
+#define APP_ZIGBEE_SCENE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "app_zigbee_level.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define APP_ZIGBEE_SCENE_ALL              (0x100u)      /* All the scenes of a group */
+#define APP_ZIGBEE_SCENE_GROUP_ALL        (0x10000uL)   /* All the groups (not the scenes of group 0) */
+
+/* Exported types ------------------------------------------------------------*/
+/* Actuation snapshot of a scene : the output as driven */
+typedef struct
+{
+  uint16_t    iGroup;
+  uint8_t     cScene;
+  bool        bValid;
+  bool        bOn;
+  uint16_t    aiFrame[APP_ZIGBEE_LEVEL_PWM_CHANNELS];   /* PWM pulses of the output when on */
+} APP_ZIGBEE_SceneSnapshot_t;
+
+/* Statistics of the scene cache */
+typedef struct
+{
+  uint32_t    lStored;                /* Snapshots taken (Store Scene) */
+  uint32_t    lRecalled;              /* Recalls driven from a snapshot */
+  uint32_t    lMissed;                /* Recalls without snapshot (stack only) */
+  uint32_t    lRemoved;               /* Snapshots removed (scene added, copied or removed, group removed) */
+  uint32_t    lFull;                  /* Store Scene without free snapshot */
+} APP_ZIGBEE_SceneStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_SceneInit              ( void );
+void      APP_ZIGBEE_SceneStore             ( uint16_t iGroup, uint8_t cScene, bool bOn );
+void      APP_ZIGBEE_SceneRemove            ( uint32_t lGroup, uint16_t iScene );
+
+const APP_ZIGBEE_SceneSnapshot_t * APP_ZIGBEE_SceneFind      ( uint16_t iGroup, uint8_t cScene );
+const APP_ZIGBEE_SceneStats_t *    APP_ZIGBEE_SceneGetStats  ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_SCENE_H */
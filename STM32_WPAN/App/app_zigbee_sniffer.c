@@ -0,0 +1,394 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_sniffer.c
+  * @author  MCD Application Team
+  * @brief   802.15.4 sniffer : the raw MAC receives every frame of the channel,
+  *          and each frame is written, with its time stamp, RSSI and LQI, as a
+  *          PCAP record (LINKTYPE_IEEE802_15_4_TAP) directly in the trace FIFO.
+  *          The Zigbee stack is not started and the logs are masked while the
+  *          frames are streamed, so that the UART carries a valid PCAP stream
+  *          (e.g. for Wireshark : a named pipe fed with the UART).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee_sniffer.h"
+
+#include "stm32_adv_trace.h"
+#include "timer_if.h"
+
+#if (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0)
+
+#include "st_mac_802_15_4_raw_svc.h"
+
+#if (CFG_LOG_SUPPORTED == 0)
+#error "The sniffer streams the frames through the trace FIFO : CFG_LOG_SUPPORTED is needed."
+#endif /* (CFG_LOG_SUPPORTED == 0) */
+
+/* Private defines -----------------------------------------------------------*/
+#define SNIFFER_PCAP_MAGIC              (0xA1B2C3D4u)   /* Time stamps in microseconds */
+#define SNIFFER_PCAP_VERSION_MAJOR      (2u)
+#define SNIFFER_PCAP_VERSION_MINOR      (4u)
+#define SNIFFER_PCAP_SNAPLEN            (256u)
+#define SNIFFER_PCAP_LINKTYPE           (283u)          /* LINKTYPE_IEEE802_15_4_TAP */
+#define SNIFFER_PCAP_HEADER_SIZE        (24u)
+#define SNIFFER_PCAP_RECORD_SIZE        (16u)
+
+#define SNIFFER_TAP_TLV_FCS_TYPE        (0u)            /* FCS type : 0 = no FCS in the frame */
+#define SNIFFER_TAP_TLV_RSS             (1u)            /* Received signal strength, float in dBm */
+#define SNIFFER_TAP_TLV_CHANNEL         (3u)            /* Channel (16 bits) and page (8 bits) */
+#define SNIFFER_TAP_TLV_LQI             (10u)           /* Link quality indicator */
+#define SNIFFER_TAP_HEADER_SIZE         (4u + 8u + 8u + 8u + 8u)
+
+#define SNIFFER_FRAME_HEADER_SIZE       ( SNIFFER_PCAP_RECORD_SIZE + SNIFFER_TAP_HEADER_SIZE )
+
+#define SNIFFER_CHANNEL_MIN             (11u)
+#define SNIFFER_CHANNEL_MAX             (26u)
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_SnifferStats_t    stSnifferStats;
+static MAC_handle                   stSnifferMacHandle;
+static uint32_t                     lSnifferRegionMask;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     SnifferRxDone           ( const ST_MAC_raw_single_RX_event_t * pstRxEvent );
+static void     SnifferNotify           ( MAC_RAW_State_t eState );
+static uint16_t SnifferPut32            ( uint8_t * pBuffer, uint16_t iIndex, uint32_t lValue );
+static uint16_t SnifferPut16            ( uint8_t * pBuffer, uint16_t iIndex, uint16_t iValue );
+static bool     SnifferWrite            ( const uint8_t * pHeader, uint16_t iHeaderSize, const uint8_t * pPayload, uint16_t iPayloadSize );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the sniffer (instead of the Zigbee application) and start it on CFG_ZIGBEE_SNIFFER_CHANNEL.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_SnifferInit( void )
+{
+  static ST_MAC_Raw_event_callbacks_t   stSnifferCallbacks;
+
+  stSnifferCallbacks.p_Notif = SnifferNotify;
+  stSnifferCallbacks.p_RX_Done = SnifferRxDone;
+  stSnifferCallbacks.p_TX_Done = NULL;
+
+  LOG_INFO_APP( "802.15.4 Sniffer Init" );
+  if ( ST_MAC_raw_init( &stSnifferCallbacks, RAW_CONFIG ) != MAC_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, raw MAC initialization failed." );
+    return;
+  }
+
+  (void)APP_ZIGBEE_SnifferStart( CFG_ZIGBEE_SNIFFER_CHANNEL );
+}
+
+/**
+ * @brief  Start the capture on a channel : the logs are masked and the PCAP global header is sent, then each frame
+ *         received is streamed.
+ * @param  cChannel   802.15.4 channel (11 to 26)
+ * @retval True if the reception is started.
+ */
+bool APP_ZIGBEE_SnifferStart( uint8_t cChannel )
+{
+  ST_MAC_raw_RX_start_t   stRxStart;
+  uint8_t                 aHeader[SNIFFER_PCAP_HEADER_SIZE];
+  uint16_t                iIndex;
+
+  if ( ( cChannel < SNIFFER_CHANNEL_MIN ) || ( cChannel > SNIFFER_CHANNEL_MAX ) )
+  {
+    LOG_ERROR_APP( "Error, channel %d not in %d to %d.", cChannel, SNIFFER_CHANNEL_MIN, SNIFFER_CHANNEL_MAX );
+    return false;
+  }
+
+  if ( stSnifferStats.bRunning != false )
+  {
+    (void)ST_MAC_raw_stop_RX();
+    stSnifferStats.bRunning = false;
+  }
+
+  LOG_INFO_APP( "Sniffer : capture on channel %d, PCAP stream follows.", cChannel );
+
+  /* From now, the UART carries only the PCAP stream */
+  lSnifferRegionMask = Log_Module_Get_Region_Mask();
+  Log_Module_Set_Multiple_Regions( 0u );
+
+  iIndex = SnifferPut32( aHeader, 0u, SNIFFER_PCAP_MAGIC );
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_PCAP_VERSION_MAJOR );
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_PCAP_VERSION_MINOR );
+  iIndex = SnifferPut32( aHeader, iIndex, 0u );                         /* Time zone */
+  iIndex = SnifferPut32( aHeader, iIndex, 0u );                         /* Accuracy of the time stamps */
+  iIndex = SnifferPut32( aHeader, iIndex, SNIFFER_PCAP_SNAPLEN );
+  (void)SnifferPut32( aHeader, iIndex, SNIFFER_PCAP_LINKTYPE );
+  while ( SnifferWrite( aHeader, SNIFFER_PCAP_HEADER_SIZE, NULL, 0u ) == false )
+  {
+    /* The previous logs leave the FIFO */
+  }
+
+  memset( &stRxStart, 0, sizeof( stRxStart ) );
+  stRxStart.channel_number = cChannel;
+  stRxStart.period = 0;                       /* Infinite */
+  stRxStart.frames_number = 0;                /* Infinite */
+  if ( ST_MAC_raw_start_RX( &stSnifferMacHandle, &stRxStart ) != MAC_SUCCESS )
+  {
+    Log_Module_Set_Multiple_Regions( lSnifferRegionMask );
+    LOG_ERROR_APP( "Error, raw MAC reception not started." );
+    return false;
+  }
+
+  stSnifferStats.cChannel = cChannel;
+  stSnifferStats.bRunning = true;
+
+  return true;
+}
+
+/**
+ * @brief  Stop the capture : the logs are restored.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_SnifferStop( void )
+{
+  if ( stSnifferStats.bRunning == false )
+  {
+    return;
+  }
+
+  (void)ST_MAC_raw_stop_RX();
+  stSnifferStats.bRunning = false;
+  Log_Module_Set_Multiple_Regions( lSnifferRegionMask );
+}
+
+/**
+ * @brief  Statistics of the sniffer.
+ * @param  None
+ * @retval Statistics
+ */
+const APP_ZIGBEE_SnifferStats_t * APP_ZIGBEE_SnifferGetStats( void )
+{
+  return &stSnifferStats;
+}
+
+/**
+ * @brief  Sniffer serial commands : SNIFF <channel> (restart the capture on this channel) and SNIFF STOP (stop the
+ *         capture and print the statistics).
+ * @param  szCommand  Command received
+ * @retval True if the command is a sniffer command.
+ */
+bool APP_ZIGBEE_SnifferSerialCmdExecute( const char * szCommand )
+{
+  if ( strncmp( szCommand, "SNIFF ", 6 ) != 0 )
+  {
+    return false;
+  }
+
+  szCommand += 6;
+  if ( strcmp( szCommand, "STOP" ) == 0 )
+  {
+    APP_ZIGBEE_SnifferStop();
+    LOG_INFO_APP( "Sniffer : channel %d, %d frames (%d bytes), %d dropped, %d rejected.", stSnifferStats.cChannel,
+                  stSnifferStats.lFrames, stSnifferStats.lBytes, stSnifferStats.lDropped, stSnifferStats.lRejected );
+  }
+  else
+  {
+    (void)APP_ZIGBEE_SnifferStart( (uint8_t)strtoul( szCommand, NULL, 10 ) );
+  }
+
+  return true;
+}
+
+/**
+ * @brief  Frame received by the raw MAC : written as a PCAP record in the trace FIFO (dropped if it is full).
+ * @param  pstRxEvent   Reception event
+ * @retval None
+ */
+static void SnifferRxDone( const ST_MAC_raw_single_RX_event_t * pstRxEvent )
+{
+  uint8_t     aHeader[SNIFFER_FRAME_HEADER_SIZE];
+  uint64_t    dlTimeUs;
+  float       fRss;
+  uint32_t    lRss;
+  uint16_t    iLength;
+  uint16_t    iIndex;
+
+  dlTimeUs = TIMER_IF_GetTimeUs();
+
+  if ( ( pstRxEvent->rx_status != RX_SUCCESS ) || ( pstRxEvent->payload_ptr == NULL ) || ( pstRxEvent->payload_len == 0u ) )
+  {
+    stSnifferStats.lRejected++;
+    return;
+  }
+
+  iLength = (uint16_t)( SNIFFER_TAP_HEADER_SIZE + pstRxEvent->payload_len );
+  fRss = (float)pstRxEvent->rssi;
+  memcpy( &lRss, &fRss, sizeof( lRss ) );
+
+  /* PCAP record header */
+  iIndex = SnifferPut32( aHeader, 0u, (uint32_t)( dlTimeUs / 1000000u ) );
+  iIndex = SnifferPut32( aHeader, iIndex, (uint32_t)( dlTimeUs % 1000000u ) );
+  iIndex = SnifferPut32( aHeader, iIndex, iLength );
+  iIndex = SnifferPut32( aHeader, iIndex, iLength );
+
+  /* TAP header and its TLVs (values padded to 4 bytes) */
+  iIndex = SnifferPut16( aHeader, iIndex, 0u );                         /* Version and reserved */
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_TAP_HEADER_SIZE );
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_TAP_TLV_FCS_TYPE );
+  iIndex = SnifferPut16( aHeader, iIndex, 1u );
+  iIndex = SnifferPut32( aHeader, iIndex, 0u );
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_TAP_TLV_RSS );
+  iIndex = SnifferPut16( aHeader, iIndex, 4u );
+  iIndex = SnifferPut32( aHeader, iIndex, lRss );
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_TAP_TLV_CHANNEL );
+  iIndex = SnifferPut16( aHeader, iIndex, 3u );
+  iIndex = SnifferPut32( aHeader, iIndex, stSnifferStats.cChannel );   /* Channel, page 0 */
+  iIndex = SnifferPut16( aHeader, iIndex, SNIFFER_TAP_TLV_LQI );
+  iIndex = SnifferPut16( aHeader, iIndex, 1u );
+  (void)SnifferPut32( aHeader, iIndex, pstRxEvent->lqi );
+
+  if ( SnifferWrite( aHeader, SNIFFER_FRAME_HEADER_SIZE, pstRxEvent->payload_ptr, pstRxEvent->payload_len ) == false )
+  {
+    stSnifferStats.lDropped++;
+    return;
+  }
+
+  stSnifferStats.lFrames++;
+  stSnifferStats.lBytes += ( SNIFFER_PCAP_RECORD_SIZE + iLength );
+}
+
+/**
+ * @brief  State of the raw MAC : not used.
+ * @param  eState   New state
+ * @retval None
+ */
+static void SnifferNotify( MAC_RAW_State_t eState )
+{
+  UNUSED( eState );
+}
+
+/**
+ * @brief  Write a 32 bits value in little endian (PCAP and TAP are little endian here).
+ * @param  pBuffer  Buffer
+ * @param  iIndex   Index of the value in the buffer
+ * @param  lValue   Value
+ * @retval Index after the value
+ */
+static uint16_t SnifferPut32( uint8_t * pBuffer, uint16_t iIndex, uint32_t lValue )
+{
+  pBuffer[iIndex] = (uint8_t)lValue;
+  pBuffer[iIndex + 1u] = (uint8_t)( lValue >> 8u );
+  pBuffer[iIndex + 2u] = (uint8_t)( lValue >> 16u );
+  pBuffer[iIndex + 3u] = (uint8_t)( lValue >> 24u );
+
+  return (uint16_t)( iIndex + 4u );
+}
+
+/**
+ * @brief  Write a 16 bits value in little endian.
+ * @param  pBuffer  Buffer
+ * @param  iIndex   Index of the value in the buffer
+ * @param  iValue   Value
+ * @retval Index after the value
+ */
+static uint16_t SnifferPut16( uint8_t * pBuffer, uint16_t iIndex, uint16_t iValue )
+{
+  pBuffer[iIndex] = (uint8_t)iValue;
+  pBuffer[iIndex + 1u] = (uint8_t)( iValue >> 8u );
+
+  return (uint16_t)( iIndex + 2u );
+}
+
+/**
+ * @brief  Write a header and the payload of the frame directly in the trace FIFO (no intermediate copy of the frame).
+ * @param  pHeader        Header
+ * @param  iHeaderSize    Size of the header
+ * @param  pPayload       Payload (NULL if none)
+ * @param  iPayloadSize   Size of the payload
+ * @retval False if the FIFO is full.
+ */
+static bool SnifferWrite( const uint8_t * pHeader, uint16_t iHeaderSize, const uint8_t * pPayload, uint16_t iPayloadSize )
+{
+  uint8_t   * pFifo;
+  uint16_t  iFifoSize;
+  uint16_t  iWritePos;
+  uint16_t  iIndex;
+
+  if ( UTIL_ADV_TRACE_ZCSend_Allocation( (uint16_t)( iHeaderSize + iPayloadSize ), &pFifo, &iFifoSize, &iWritePos ) != UTIL_ADV_TRACE_OK )
+  {
+    return false;
+  }
+
+  for ( iIndex = 0; iIndex < iHeaderSize; iIndex++ )
+  {
+    pFifo[iWritePos] = pHeader[iIndex];
+    iWritePos = (uint16_t)( ( iWritePos + 1u ) % iFifoSize );
+  }
+  for ( iIndex = 0; iIndex < iPayloadSize; iIndex++ )
+  {
+    pFifo[iWritePos] = pPayload[iIndex];
+    iWritePos = (uint16_t)( ( iWritePos + 1u ) % iFifoSize );
+  }
+
+  (void)UTIL_ADV_TRACE_ZCSend_Finalize();
+
+  return true;
+}
+
+#else /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
+
+/**
+ * @brief  Sniffer not supported : nothing to do.
+ */
+void APP_ZIGBEE_SnifferInit( void )
+{
+}
+
+/**
+ * @brief  Sniffer not supported : no capture.
+ */
+bool APP_ZIGBEE_SnifferStart( uint8_t cChannel )
+{
+  UNUSED( cChannel );
+
+  return false;
+}
+
+/**
+ * @brief  Sniffer not supported : no capture.
+ */
+void APP_ZIGBEE_SnifferStop( void )
+{
+}
+
+/**
+ * @brief  Sniffer not supported : no command.
+ */
+bool APP_ZIGBEE_SnifferSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Sniffer not supported : no statistics.
+ */
+const APP_ZIGBEE_SnifferStats_t * APP_ZIGBEE_SnifferGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_SNIFFER_SUPPORTED != 0) */
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_sniffer.h
+  * @author  MCD Application Team
+  * @brief   Interface of the 802.15.4 sniffer (raw MAC reception streamed in
+  *          PCAP format on the trace UART).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_SNIFFER_H
+#define APP_ZIGBEE_SNIFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the sniffer */
+typedef struct
+{
+  uint32_t    lFrames;                /* Frames streamed */
+  uint32_t    lBytes;                 /* Bytes written in the trace FIFO */
+  uint32_t    lDropped;               /* Frames dropped (trace FIFO full) */
+  uint32_t    lRejected;              /* Receptions without a valid frame (FCS error, no payload...) */
+  uint8_t     cChannel;               /* Channel listened */
+  bool        bRunning;               /* Reception in progress */
+} APP_ZIGBEE_SnifferStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_SnifferInit            ( void );
+bool      APP_ZIGBEE_SnifferStart           ( uint8_t cChannel );
+void      APP_ZIGBEE_SnifferStop            ( void );
+bool      APP_ZIGBEE_SnifferSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_SnifferStats_t * APP_ZIGBEE_SnifferGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_SNIFFER_H */
@@ -0,0 +1,515 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_stagger.c
+  * @author  MCD Application Team
+  * @brief   Staggered network-wide operations of the Coordinator (OTA Image
+  *          Notify, rebinding, ...) : each node of the Address Map gets a
+  *          time slot from a hash of its short address, and the operations
+  *          in progress at once are limited by the load of the channel (CCA
+  *          failures of the MAC), instead of one request to the whole
+  *          Network answered by all the nodes together.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_stagger.h"
+#include "app_zigbee_ota_server.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+#include "zigbee.zdo.h"
+
+#if (CFG_ZIGBEE_STAGGER_SUPPORTED != 0)
+#include "mac_sys_if.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  STAGGER_NODE_PENDING,
+  STAGGER_NODE_RUNNING,
+  STAGGER_NODE_DONE,
+  STAGGER_NODE_FAILED,
+  STAGGER_NODE_EXPIRED,
+} StaggerNodeState_t;
+
+typedef struct
+{
+  uint64_t              dlExtAddr;
+  uint16_t              iNwkAddr;
+  uint8_t               cSlot;
+  StaggerNodeState_t    eState;
+  uint32_t              lStart;       /* Time of the start of the operation */
+} StaggerNode_t;
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_StaggerState_t      stStaggerState;
+static StaggerNode_t                  astStaggerNode[CFG_ZIGBEE_STAGGER_NODE_MAX];
+static APP_ZIGBEE_StaggerOperation_t  pfStaggerOperation;
+static void                           * pStaggerArg;
+static uint32_t                       lStaggerTimeout;
+static uint32_t                       lStaggerStart;
+static UTIL_TIMER_Object_t            stStaggerTimer;
+static uint8_t                        cStaggerEndpoint;
+static uint8_t                        cStaggerBindEndpoint;   /* Endpoint and cluster of the nodes to bind (STAGGER BIND) */
+static uint16_t                       iStaggerBindCluster;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     StaggerTask             ( void );
+static void     StaggerTimerElapsed     ( void * arg );
+static uint8_t  StaggerSlot             ( uint16_t iNwkAddr );
+static uint8_t  StaggerConcurrency      ( void );
+static void     StaggerEnd              ( void );
+static bool     StaggerBindOperation    ( uint16_t iNwkAddr, uint64_t dlExtAddr, void * arg );
+static void     StaggerBindRsp          ( struct ZbZdoBindRspT * pstRsp, void * arg );
+#if (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0)
+static bool     StaggerOtaOperation     ( uint16_t iNwkAddr, uint64_t dlExtAddr, void * arg );
+#endif /* (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0) */
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the staggered operations : Task and Timer of the slots.
+ * @param  cEndpoint    Endpoint of the Coordinator (destination of the bindings)
+ * @retval None
+ */
+void APP_ZIGBEE_StaggerInit( uint8_t cEndpoint )
+{
+  cStaggerEndpoint = cEndpoint;
+
+  UTIL_TIMER_Create( &stStaggerTimer, CFG_ZIGBEE_STAGGER_SLOT_DURATION, UTIL_TIMER_PERIODIC, &StaggerTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_STAGGER ), UTIL_SEQ_RFU, StaggerTask );
+}
+
+/**
+ * @brief  Start a campaign : the operation is applied to each node of the Address Map, in its slot.
+ * @param  szName       Name of the operation (kept, not copied)
+ * @param  pfOperation  Operation on one node
+ * @param  lTimeout     Time (ms) after which an operation without end is expired
+ * @param  arg          Argument of the operation
+ * @retval True if the campaign is started.
+ */
+bool APP_ZIGBEE_StaggerStart( const char * szName, APP_ZIGBEE_StaggerOperation_t pfOperation, uint32_t lTimeout, void * arg )
+{
+  struct ZbNwkAddrMapEntryT   stAddrMap;
+  uint16_t                    iIndex = 0;
+
+  if ( stStaggerState.bRunning != false )
+  {
+    LOG_ERROR_APP( "Error, campaign '%s' in progress.", stStaggerState.szName );
+    return false;
+  }
+  if ( ZbShortAddress( stZigbeeAppInfo.pstZigbee ) != ZB_NWK_ADDR_COORDINATOR )
+  {
+    LOG_ERROR_APP( "Error, staggered operations only on the Coordinator." );
+    return false;
+  }
+
+  memset( &stStaggerState, 0, sizeof( stStaggerState ) );
+  stStaggerState.szName = szName;
+
+  while ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_AddressMap, &stAddrMap, sizeof( stAddrMap ), iIndex++ ) == ZB_STATUS_SUCCESS )
+  {
+    if ( ( stAddrMap.nwkAddr == ZB_NWK_ADDR_UNDEFINED ) || ( stAddrMap.nwkAddr == ZB_NWK_ADDR_COORDINATOR ) )
+    {
+      continue;
+    }
+    if ( stStaggerState.iNodeNb >= CFG_ZIGBEE_STAGGER_NODE_MAX )
+    {
+      stStaggerState.iSkipped++;
+      continue;
+    }
+
+    astStaggerNode[stStaggerState.iNodeNb].dlExtAddr = stAddrMap.extAddr;
+    astStaggerNode[stStaggerState.iNodeNb].iNwkAddr = stAddrMap.nwkAddr;
+    astStaggerNode[stStaggerState.iNodeNb].cSlot = StaggerSlot( stAddrMap.nwkAddr );
+    astStaggerNode[stStaggerState.iNodeNb].eState = STAGGER_NODE_PENDING;
+    stStaggerState.iNodeNb++;
+  }
+
+  if ( stStaggerState.iNodeNb == 0u )
+  {
+    LOG_ERROR_APP( "Error, no node in the Address Map." );
+    return false;
+  }
+
+  pfStaggerOperation = pfOperation;
+  pStaggerArg = arg;
+  lStaggerTimeout = lTimeout;
+  lStaggerStart = UTIL_TIMER_GetCurrentTime();
+  stStaggerState.iPending = stStaggerState.iNodeNb;
+  stStaggerState.cConcurrencyMin = CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX;
+  stStaggerState.bRunning = true;
+
+  LOG_INFO_APP( "Campaign '%s' : %d nodes over %d slots of %d ms (%d left out).", szName, stStaggerState.iNodeNb,
+                CFG_ZIGBEE_STAGGER_SLOT_NB, CFG_ZIGBEE_STAGGER_SLOT_DURATION, stStaggerState.iSkipped );
+
+  /* First slot at once */
+  UTIL_TIMER_Start( &stStaggerTimer );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_STAGGER ), TASK_PRIO_ZIGBEE_STAGGER );
+
+  return true;
+}
+
+/**
+ * @brief  Stop the campaign : the nodes not started are left, the operations in progress go on unfollowed.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_StaggerStop( void )
+{
+  if ( stStaggerState.bRunning != false )
+  {
+    StaggerEnd();
+  }
+}
+
+/**
+ * @brief  End of the operation in progress on a node (operation callback).
+ * @param  iNwkAddr   Short address of the node
+ * @param  bSuccess   True if the operation succeeded
+ * @retval None
+ */
+void APP_ZIGBEE_StaggerDone( uint16_t iNwkAddr, bool bSuccess )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < stStaggerState.iNodeNb; iIndex++ )
+  {
+    if ( ( astStaggerNode[iIndex].iNwkAddr == iNwkAddr ) && ( astStaggerNode[iIndex].eState == STAGGER_NODE_RUNNING ) )
+    {
+      astStaggerNode[iIndex].eState = ( bSuccess != false ) ? STAGGER_NODE_DONE : STAGGER_NODE_FAILED;
+      stStaggerState.iRunning--;
+      if ( bSuccess != false )
+      {
+        stStaggerState.iDone++;
+      }
+      else
+      {
+        stStaggerState.iFailed++;
+      }
+      return;
+    }
+  }
+}
+
+/**
+ * @brief  State of the campaign.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_StaggerState_t * APP_ZIGBEE_StaggerGetState( void )
+{
+  if ( stStaggerState.bRunning != false )
+  {
+    stStaggerState.lDuration = UTIL_TIMER_GetCurrentTime() - lStaggerStart;
+  }
+
+  return &stStaggerState;
+}
+
+/**
+ * @brief  Staggered operations serial commands : STAGGER (state), STAGGER OTA (Image Notify), STAGGER BIND <endpoint>
+ *         <cluster> (binding of the cluster of the nodes to the Coordinator) and STAGGER STOP.
+ * @param  szCommand  Command received
+ * @retval True if the command is a staggered operations command.
+ */
+bool APP_ZIGBEE_StaggerSerialCmdExecute( const char * szCommand )
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  const APP_ZIGBEE_StaggerState_t   * pstState;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  char                              * pEnd;
+
+  if ( strncmp( szCommand, "STAGGER", 7u ) != 0 )
+  {
+    return false;
+  }
+
+  if ( strcmp( szCommand, "STAGGER STOP" ) == 0 )
+  {
+    APP_ZIGBEE_StaggerStop();
+  }
+#if (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0)
+  else if ( strcmp( szCommand, "STAGGER OTA" ) == 0 )
+  {
+    (void)APP_ZIGBEE_StaggerStart( "OTA", StaggerOtaOperation, CFG_ZIGBEE_STAGGER_OTA_TIMEOUT, NULL );
+  }
+#endif /* (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0) */
+  else if ( strncmp( szCommand, "STAGGER BIND ", 13u ) == 0 )
+  {
+    cStaggerBindEndpoint = (uint8_t)strtoul( &szCommand[13], &pEnd, 0 );
+    iStaggerBindCluster = (uint16_t)strtoul( pEnd, NULL, 0 );
+    (void)APP_ZIGBEE_StaggerStart( "BIND", StaggerBindOperation, CFG_ZIGBEE_STAGGER_BIND_TIMEOUT, NULL );
+  }
+  else if ( strcmp( szCommand, "STAGGER" ) != 0 )
+  {
+    return false;
+  }
+
+#if (CFG_LOG_SUPPORTED != 0)
+  pstState = APP_ZIGBEE_StaggerGetState();
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  LOG_INFO_APP( "Campaign '%s' (%s) : %d nodes, %d pending, %d running, %d done, %d failed, %d expired, %d left out.",
+                ( pstState->szName != NULL ) ? pstState->szName : "none", ( pstState->bRunning != false ) ? "running" : "ended",
+                pstState->iNodeNb, pstState->iPending, pstState->iRunning, pstState->iDone, pstState->iFailed,
+                pstState->iExpired, pstState->iSkipped );
+  LOG_INFO_APP( "Campaign : slot %d/%d, %d operations at once (min %d), %u ms.", pstState->cSlot, CFG_ZIGBEE_STAGGER_SLOT_NB,
+                pstState->cConcurrency, pstState->cConcurrencyMin, pstState->lDuration );
+
+  return true;
+}
+
+/**
+ * @brief  Staggered operations Task, once per slot : the operations without end are expired, then the nodes of the
+ *         slot (and the ones of the previous slots still pending) are started while the channel load allows it.
+ * @param  None
+ * @retval None
+ */
+static void StaggerTask( void )
+{
+  StaggerNode_t   * pstNode;
+  uint32_t        lNow = UTIL_TIMER_GetCurrentTime();
+  uint16_t        iIndex;
+
+  if ( stStaggerState.bRunning == false )
+  {
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < stStaggerState.iNodeNb; iIndex++ )
+  {
+    pstNode = &astStaggerNode[iIndex];
+    if ( ( pstNode->eState == STAGGER_NODE_RUNNING ) && ( ( lNow - pstNode->lStart ) >= lStaggerTimeout ) )
+    {
+      pstNode->eState = STAGGER_NODE_EXPIRED;
+      stStaggerState.iRunning--;
+      stStaggerState.iExpired++;
+    }
+  }
+
+  stStaggerState.cConcurrency = StaggerConcurrency();
+  if ( stStaggerState.cConcurrency < stStaggerState.cConcurrencyMin )
+  {
+    stStaggerState.cConcurrencyMin = stStaggerState.cConcurrency;
+  }
+
+  for ( iIndex = 0; ( iIndex < stStaggerState.iNodeNb ) && ( stStaggerState.iRunning < stStaggerState.cConcurrency ); iIndex++ )
+  {
+    pstNode = &astStaggerNode[iIndex];
+    if ( ( pstNode->eState != STAGGER_NODE_PENDING ) || ( pstNode->cSlot > stStaggerState.cSlot ) )
+    {
+      continue;
+    }
+
+    /* Running before the call : the operation may end at once */
+    pstNode->eState = STAGGER_NODE_RUNNING;
+    pstNode->lStart = lNow;
+    stStaggerState.iPending--;
+    stStaggerState.iRunning++;
+    if ( pfStaggerOperation( pstNode->iNwkAddr, pstNode->dlExtAddr, pStaggerArg ) == false )
+    {
+      APP_ZIGBEE_StaggerDone( pstNode->iNwkAddr, false );
+    }
+  }
+
+  /* After the last slot, the nodes left wait for free operations */
+  if ( stStaggerState.cSlot < ( CFG_ZIGBEE_STAGGER_SLOT_NB - 1u ) )
+  {
+    stStaggerState.cSlot++;
+  }
+
+  if ( ( stStaggerState.iPending == 0u ) && ( stStaggerState.iRunning == 0u ) )
+  {
+    StaggerEnd();
+  }
+}
+
+/**
+ * @brief  Callback triggered at the start of each slot
+ * @param  arg : Not used
+ * @retval None
+ */
+static void StaggerTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_STAGGER ), TASK_PRIO_ZIGBEE_STAGGER );
+}
+
+/**
+ * @brief  Slot of a node : multiplicative hash of its short address (the stochastic addresses are spread over all
+ *         the slots, the close ones too).
+ * @param  iNwkAddr   Short address of the node
+ * @retval Slot
+ */
+static uint8_t StaggerSlot( uint16_t iNwkAddr )
+{
+  uint16_t  iHash = (uint16_t)( (uint32_t)iNwkAddr * 40503u );
+
+  return (uint8_t)( ( (uint32_t)iHash * CFG_ZIGBEE_STAGGER_SLOT_NB ) >> 16 );
+}
+
+/**
+ * @brief  Operations allowed at once from the CCA failures of the last MAC interval : CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX
+ *         up to CFG_ZIGBEE_STAGGER_CCA_LOW %, one from CFG_ZIGBEE_STAGGER_CCA_HIGH %, linear in between.
+ * @param  None
+ * @retval Operations allowed at once
+ */
+static uint8_t StaggerConcurrency( void )
+{
+  MAC_SYS_Stats_t   stMacStats;
+  uint32_t          lRate;
+
+  MacSys_GetStats( &stMacStats );
+  if ( stMacStats.Interval.TxCount == 0u )
+  {
+    return CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX;
+  }
+
+  lRate = ( stMacStats.Interval.TxCcaFailCount * 100u ) / stMacStats.Interval.TxCount;
+  if ( lRate <= CFG_ZIGBEE_STAGGER_CCA_LOW )
+  {
+    return CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX;
+  }
+  if ( lRate >= CFG_ZIGBEE_STAGGER_CCA_HIGH )
+  {
+    return 1u;
+  }
+
+  return (uint8_t)( CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX - ( ( CFG_ZIGBEE_STAGGER_CONCURRENCY_MAX - 1u ) * ( lRate - CFG_ZIGBEE_STAGGER_CCA_LOW ) ) /
+                                                         ( CFG_ZIGBEE_STAGGER_CCA_HIGH - CFG_ZIGBEE_STAGGER_CCA_LOW ) );
+}
+
+/**
+ * @brief  End of the campaign.
+ * @param  None
+ * @retval None
+ */
+static void StaggerEnd( void )
+{
+  UTIL_TIMER_Stop( &stStaggerTimer );
+  stStaggerState.lDuration = UTIL_TIMER_GetCurrentTime() - lStaggerStart;
+  stStaggerState.bRunning = false;
+
+  LOG_INFO_APP( "Campaign '%s' ended in %u ms : %d done, %d failed, %d expired, %d not started.", stStaggerState.szName,
+                stStaggerState.lDuration, stStaggerState.iDone, stStaggerState.iFailed, stStaggerState.iExpired,
+                stStaggerState.iPending );
+}
+
+/**
+ * @brief  Rebinding of a node : Bind_req of its cluster (STAGGER BIND) to the endpoint of the Coordinator.
+ */
+static bool StaggerBindOperation( uint16_t iNwkAddr, uint64_t dlExtAddr, void * arg )
+{
+  struct ZbZdoBindReqT  stBindReq;
+
+  UNUSED( arg );
+
+  memset( &stBindReq, 0, sizeof( stBindReq ) );
+  stBindReq.target = iNwkAddr;
+  stBindReq.srcExtAddr = dlExtAddr;
+  stBindReq.srcEndpt = cStaggerBindEndpoint;
+  stBindReq.clusterId = iStaggerBindCluster;
+  stBindReq.dst.mode = ZB_APSDE_ADDRMODE_EXT;
+  stBindReq.dst.extAddr = ZbExtendedAddress( stZigbeeAppInfo.pstZigbee );
+  stBindReq.dst.endpoint = cStaggerEndpoint;
+
+  return ( ZbZdoBindReq( stZigbeeAppInfo.pstZigbee, &stBindReq, StaggerBindRsp, (void *)(uintptr_t)iNwkAddr ) == ZB_STATUS_SUCCESS );
+}
+
+/**
+ * @brief  Bind_rsp of a node : end of its rebinding.
+ */
+static void StaggerBindRsp( struct ZbZdoBindRspT * pstRsp, void * arg )
+{
+  APP_ZIGBEE_StaggerDone( (uint16_t)(uintptr_t)arg, ( pstRsp->status == ZB_STATUS_SUCCESS ) );
+}
+
+#if (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0)
+/**
+ * @brief  OTA of a node : unicast Image Notify. The download ends with the Upgrade End Request of the node (or the
+ *         operation expires when the node does not take the image).
+ */
+static bool StaggerOtaOperation( uint16_t iNwkAddr, uint64_t dlExtAddr, void * arg )
+{
+  UNUSED( dlExtAddr );
+  UNUSED( arg );
+
+  return APP_ZIGBEE_OtaServerNotify( iNwkAddr );
+}
+#endif /* (CFG_ZIGBEE_OTA_SERVER_SUPPORTED != 0) */
+
+#else /* (CFG_ZIGBEE_STAGGER_SUPPORTED != 0) */
+
+/**
+ * @brief  Staggered operations not supported.
+ */
+void APP_ZIGBEE_StaggerInit( uint8_t cEndpoint )
+{
+  UNUSED( cEndpoint );
+}
+
+/**
+ * @brief  Staggered operations not supported : no campaign.
+ */
+bool APP_ZIGBEE_StaggerStart( const char * szName, APP_ZIGBEE_StaggerOperation_t pfOperation, uint32_t lTimeout, void * arg )
+{
+  UNUSED( szName );
+  UNUSED( pfOperation );
+  UNUSED( lTimeout );
+  UNUSED( arg );
+
+  return false;
+}
+
+/**
+ * @brief  Staggered operations not supported : no campaign.
+ */
+void APP_ZIGBEE_StaggerStop( void )
+{
+}
+
+/**
+ * @brief  Staggered operations not supported : no campaign.
+ */
+void APP_ZIGBEE_StaggerDone( uint16_t iNwkAddr, bool bSuccess )
+{
+  UNUSED( iNwkAddr );
+  UNUSED( bSuccess );
+}
+
+/**
+ * @brief  Staggered operations not supported : no command.
+ */
+bool APP_ZIGBEE_StaggerSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Staggered operations not supported : no state.
+ */
+const APP_ZIGBEE_StaggerState_t * APP_ZIGBEE_StaggerGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_STAGGER_SUPPORTED != 0) */
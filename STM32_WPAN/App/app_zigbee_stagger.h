@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_stagger.h
+  * @author  MCD Application Team
+  * @brief   Interface of the staggered network-wide operations (Coordinator).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_STAGGER_H
+#define APP_ZIGBEE_STAGGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Operation on one node. Returns false if the operation is not started (the node fails), else the end of the
+ * operation is given by APP_ZIGBEE_StaggerDone (possibly before returning), or it expires after its timeout. */
+typedef bool ( * APP_ZIGBEE_StaggerOperation_t )( uint16_t iNwkAddr, uint64_t dlExtAddr, void * arg );
+
+/* State of the campaign in progress (or of the last one) */
+typedef struct
+{
+  const char  * szName;               /* Operation of the campaign */
+  bool        bRunning;
+  uint16_t    iNodeNb;                /* Nodes of the campaign (Address Map) */
+  uint16_t    iSkipped;               /* Nodes left out (more than CFG_ZIGBEE_STAGGER_NODE_MAX) */
+  uint16_t    iPending;               /* Nodes waiting for their slot or for a free operation */
+  uint16_t    iRunning;               /* Operations in progress */
+  uint16_t    iDone;                  /* Operations ended with success */
+  uint16_t    iFailed;                /* Operations refused or ended with an error */
+  uint16_t    iExpired;               /* Operations without end before their timeout */
+  uint8_t     cSlot;                  /* Current slot */
+  uint8_t     cConcurrency;           /* Operations allowed at once (channel load of the last slot) */
+  uint8_t     cConcurrencyMin;        /* Fewest operations allowed at once during the campaign */
+  uint32_t    lDuration;              /* ms, from the start to the end (or to now) */
+} APP_ZIGBEE_StaggerState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_StaggerInit            ( uint8_t cEndpoint );
+bool      APP_ZIGBEE_StaggerStart           ( const char * szName, APP_ZIGBEE_StaggerOperation_t pfOperation,
+                                              uint32_t lTimeout, void * arg );
+void      APP_ZIGBEE_StaggerStop            ( void );
+void      APP_ZIGBEE_StaggerDone            ( uint16_t iNwkAddr, bool bSuccess );
+bool      APP_ZIGBEE_StaggerSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_StaggerState_t * APP_ZIGBEE_StaggerGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_STAGGER_H */
@@ -0,0 +1,440 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_tckey.c
+  * @author  MCD Application Team
+  * @brief   EUI64 index of the Trust Center device key pair set : the key of a
+  *          device is read at its slot of the stack table, found by a hash of
+  *          its EUI64, instead of a walk of the whole table.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_tckey.h"
+#include "serial_cmd_interpreter.h"
+#include "zigbee.aps.h"
+
+#if (CFG_ZIGBEE_TC_KEY_INDEX_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define TCKEY_SLOT_EMPTY                (0u)
+#define TCKEY_SLOT_MASK                 ( CFG_ZIGBEE_TC_KEY_INDEX_SIZE - 1u )
+#define TCKEY_PENDING_MAX               (8u)        /* Devices whose key changed, indexed at the next lookup */
+
+#if ( ( CFG_ZIGBEE_TC_KEY_INDEX_SIZE & TCKEY_SLOT_MASK ) != 0 ) || ( CFG_ZIGBEE_TC_KEY_INDEX_SIZE > 0x8000u )
+#error "CFG_ZIGBEE_TC_KEY_INDEX_SIZE shall be a power of 2, at most 32768"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t                     aiTcKeyEntry[CFG_ZIGBEE_TC_KEY_INDEX_SIZE];   /* Index in the stack table + 1 */
+static uint16_t                     aiTcKeyTag[CFG_ZIGBEE_TC_KEY_INDEX_SIZE];     /* High bits of the EUI64 hash */
+static uint64_t                     adlTcKeyPending[TCKEY_PENDING_MAX];
+static uint8_t                      cTcKeyPendingCount;
+
+static APP_ZIGBEE_TcKeyStats_t      stTcKeyStats;
+static struct ZbMsgFilterT *        pstTcKeyFilter;
+static bool                         bTcKeyStale = true;       /* Index to build again from the stack table */
+static bool                         bTcKeyComplete;           /* Every key of the stack table is indexed */
+
+/* Private functions prototypes-----------------------------------------------*/
+static uint32_t TcKeyHash               ( uint64_t dlExtAddr );
+static void     TcKeyInsert             ( uint64_t dlExtAddr, uint16_t iIndex );
+static void     TcKeyRebuild            ( void );
+static void     TcKeyLearn              ( uint64_t dlExtAddr );
+static void     TcKeyPrintStats         ( void );
+static enum zb_msg_filter_rc TcKeyApsCommandCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+
+/* Serial commands of the index */
+static const SerialCmd_t            astTcKeySerialCmds[] =
+{
+  { "TCKEYSTATS", TcKeyPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stTcKeySerialCmdTable =
+{
+  astTcKeySerialCmds, ( sizeof( astTcKeySerialCmds ) / sizeof( astTcKeySerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the index : empty, built from the stack table when the network is formed.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_TcKeyInit( void )
+{
+  memset( &stTcKeyStats, 0, sizeof( stTcKeyStats ) );
+  cTcKeyPendingCount = 0;
+  bTcKeyStale = true;
+  bTcKeyComplete = false;
+
+  Serial_CMD_Interpreter_RegisterTable( &stTcKeySerialCmdTable );
+}
+
+/**
+ * @brief  Network formed (this device is the Trust Center) : build the index from the stack table, and watch the
+ *         APS commands that change the key of a device (Update Device, Request Key, Verify Key).
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_TcKeyStart( void )
+{
+  if ( pstTcKeyFilter == NULL )
+  {
+    pstTcKeyFilter = ZbMsgFilterRegister( stZigbeeAppInfo.pstZigbee, ZB_MSG_FILTER_APS_COMMAND_IND, ( ZB_MSG_INTERNAL_PRIO + 1u ),
+                                          TcKeyApsCommandCallback, NULL );
+  }
+
+  TcKeyRebuild();
+}
+
+/**
+ * @brief  A key has been added to the stack table by the Application : index it at once.
+ * @param  dlExtAddr  Extended address of the device
+ * @retval None
+ */
+void APP_ZIGBEE_TcKeyAdded( uint64_t dlExtAddr )
+{
+  struct ZbApsmeKeyPairT  stKeyPair;
+
+  /* A key replaced in place keeps its slot, else the slot of the new key is searched once */
+  if ( APP_ZIGBEE_TcKeyLookup( dlExtAddr, &stKeyPair ) == false )
+  {
+    TcKeyLearn( dlExtAddr );
+  }
+}
+
+/**
+ * @brief  Look up the key of a device in the Trust Center table through the index. The stack table is only walked
+ *         when the index is not complete (index full or not yet built).
+ * @param  dlExtAddr    Extended address of the device
+ * @param  pstKeyPair   Key pair descriptor read (can be NULL)
+ * @retval True if the device has a key, else false.
+ */
+bool APP_ZIGBEE_TcKeyLookup( uint64_t dlExtAddr, struct ZbApsmeKeyPairT * pstKeyPair )
+{
+  struct ZbApsmeKeyPairT  stKeyPair;
+  uint32_t                lHash;
+  uint16_t                iSlot, iProbe, iTag;
+  uint8_t                 cPending;
+  unsigned int            iIndex;
+  bool                    bRetry = true, bRebuilt = false;
+
+  if ( ( stZigbeeAppInfo.pstZigbee == NULL ) || ( dlExtAddr == 0u ) )
+  {
+    return false;
+  }
+
+  if ( pstKeyPair == NULL )
+  {
+    pstKeyPair = &stKeyPair;
+  }
+
+  if ( bTcKeyStale != false )
+  {
+    TcKeyRebuild();
+  }
+
+  /* Keys changed by the stack since the previous lookup */
+  cPending = cTcKeyPendingCount;
+  cTcKeyPendingCount = 0;
+  while ( cPending != 0u )
+  {
+    cPending--;
+    TcKeyLearn( adlTcKeyPending[cPending] );
+  }
+
+  stTcKeyStats.lLookups++;
+  lHash = TcKeyHash( dlExtAddr );
+  iTag = (uint16_t)( lHash >> 16u );
+
+  while ( bRetry != false )
+  {
+    bRetry = false;
+    iSlot = (uint16_t)( lHash & TCKEY_SLOT_MASK );
+    for ( iProbe = 0; ( iProbe < CFG_ZIGBEE_TC_KEY_INDEX_SIZE ) && ( aiTcKeyEntry[iSlot] != TCKEY_SLOT_EMPTY ); iProbe++ )
+    {
+      if ( aiTcKeyTag[iSlot] == iTag )
+      {
+        if ( ZbApsGetIndex( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_DEVICE_KEY_PAIR_SET, pstKeyPair, sizeof( *pstKeyPair ),
+                            ( aiTcKeyEntry[iSlot] - 1u ) ) != ZB_STATUS_SUCCESS )
+        {
+          pstKeyPair->deviceAddress = 0;
+        }
+
+        if ( pstKeyPair->deviceAddress == dlExtAddr )
+        {
+          stTcKeyStats.lHits++;
+          return true;
+        }
+
+        if ( ( pstKeyPair->deviceAddress == 0u ) && ( bRebuilt == false ) )
+        {
+          /* Key removed or moved by the stack : slots no more valid, index built again once */
+          TcKeyRebuild();
+          bRebuilt = true;
+          bRetry = true;
+          break;
+        }
+      }
+      iSlot = ( ( iSlot + 1u ) & TCKEY_SLOT_MASK );
+    }
+  }
+
+  if ( bTcKeyComplete != false )
+  {
+    return false;
+  }
+
+  /* Index not complete : the stack table is walked, and the key indexed if there is room */
+  stTcKeyStats.lWalks++;
+  if ( ZbApsLookupKey( stZigbeeAppInfo.pstZigbee, pstKeyPair, dlExtAddr, &iIndex ) == NULL )
+  {
+    return false;
+  }
+
+  TcKeyInsert( dlExtAddr, (uint16_t)iIndex );
+  return true;
+}
+
+/**
+ * @brief  Return the statistics of the index.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_TcKeyStats_t * APP_ZIGBEE_TcKeyGetStats( void )
+{
+  return &stTcKeyStats;
+}
+
+/**
+ * @brief  Hash of an EUI64 : the low bits select the first slot, the high bits are the tag of the slot.
+ * @param  dlExtAddr  Extended address
+ * @retval Hash.
+ */
+static uint32_t TcKeyHash( uint64_t dlExtAddr )
+{
+  uint32_t  lHash;
+
+  lHash = ( (uint32_t)dlExtAddr ^ (uint32_t)( dlExtAddr >> 32u ) );
+  lHash *= 0x9E3779B1u;
+
+  return ( lHash ^ ( lHash >> 15u ) );
+}
+
+/**
+ * @brief  Index a key (linear probing). A slot already pointing to the same entry of the stack table is reused.
+ * @param  dlExtAddr  Extended address of the device
+ * @param  iIndex     Index of the key in the stack table
+ * @retval None
+ */
+static void TcKeyInsert( uint64_t dlExtAddr, uint16_t iIndex )
+{
+  uint32_t  lHash = TcKeyHash( dlExtAddr );
+  uint16_t  iSlot, iProbe;
+
+  if ( iIndex >= UINT16_MAX )
+  {
+    stTcKeyStats.lOverflows++;
+    bTcKeyComplete = false;
+    return;
+  }
+
+  iSlot = (uint16_t)( lHash & TCKEY_SLOT_MASK );
+  for ( iProbe = 0; iProbe < CFG_ZIGBEE_TC_KEY_INDEX_SIZE; iProbe++ )
+  {
+    if ( ( aiTcKeyEntry[iSlot] == TCKEY_SLOT_EMPTY ) || ( aiTcKeyEntry[iSlot] == ( iIndex + 1u ) ) )
+    {
+      if ( aiTcKeyEntry[iSlot] == TCKEY_SLOT_EMPTY )
+      {
+        stTcKeyStats.iKeys++;
+      }
+      aiTcKeyEntry[iSlot] = ( iIndex + 1u );
+      aiTcKeyTag[iSlot] = (uint16_t)( lHash >> 16u );
+      if ( iProbe >= stTcKeyStats.iMaxProbes )
+      {
+        stTcKeyStats.iMaxProbes = ( iProbe + 1u );
+      }
+      return;
+    }
+    iSlot = ( ( iSlot + 1u ) & TCKEY_SLOT_MASK );
+  }
+
+  /* Index full : the keys not indexed are found by a walk of the stack table */
+  stTcKeyStats.lOverflows++;
+  bTcKeyComplete = false;
+}
+
+/**
+ * @brief  Build again the index from the device key pair set of the stack.
+ * @param  None
+ * @retval None
+ */
+static void TcKeyRebuild( void )
+{
+  struct ZbApsmeKeyPairT  stKeyPair;
+  unsigned int            iIndex;
+
+  memset( aiTcKeyEntry, 0, sizeof( aiTcKeyEntry ) );
+  stTcKeyStats.iKeys = 0;
+  stTcKeyStats.iMaxProbes = 0;
+  stTcKeyStats.lRebuilds++;
+  cTcKeyPendingCount = 0;
+  bTcKeyComplete = true;
+  bTcKeyStale = false;
+
+  for ( iIndex = 0; ZbApsGetIndex( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_DEVICE_KEY_PAIR_SET, &stKeyPair, sizeof( stKeyPair ), iIndex ) == ZB_STATUS_SUCCESS; iIndex++ )
+  {
+    if ( stKeyPair.deviceAddress != 0u )
+    {
+      TcKeyInsert( stKeyPair.deviceAddress, (uint16_t)iIndex );
+    }
+  }
+}
+
+/**
+ * @brief  Index the key of a device added or changed outside of the index (one walk of the stack table).
+ * @param  dlExtAddr  Extended address of the device
+ * @retval None
+ */
+static void TcKeyLearn( uint64_t dlExtAddr )
+{
+  struct ZbApsmeKeyPairT  stKeyPair;
+  unsigned int            iIndex;
+
+  stTcKeyStats.lWalks++;
+  if ( ZbApsLookupKey( stZigbeeAppInfo.pstZigbee, &stKeyPair, dlExtAddr, &iIndex ) != NULL )
+  {
+    TcKeyInsert( dlExtAddr, (uint16_t)iIndex );
+  }
+}
+
+/**
+ * @brief  APS commands received by the Trust Center : the devices whose key may change are indexed at the next
+ *         lookup, once the stack has processed the command.
+ * @param  zb         Zigbee stack instance
+ * @param  lId        Message
+ * @param  pMessage   APS command
+ * @param  arg        Not used
+ * @retval ZB_MSG_CONTINUE, the command is always given to the stack.
+ */
+static enum zb_msg_filter_rc TcKeyApsCommandCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbMsgApsCommandT * pstCommand = (const struct ZbMsgApsCommandT *)pMessage;
+  uint64_t                        dlExtAddr;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( lId != ZB_MSG_FILTER_APS_COMMAND_IND )
+  {
+    return ZB_MSG_CONTINUE;
+  }
+
+  switch ( pstCommand->id )
+  {
+    case ZB_APS_CMD_UPDATE_DEVICE:
+      dlExtAddr = pstCommand->data.update_device.devExtAddr;
+      break;
+
+    case ZB_APS_CMD_REQUEST_KEY:
+      dlExtAddr = pstCommand->data.request_key.srcExtAddr;
+      break;
+
+    case ZB_APS_CMD_VERIFY_KEY:
+      dlExtAddr = pstCommand->data.verify_key.srcExtAddr;
+      break;
+
+    default:
+      return ZB_MSG_CONTINUE;
+  }
+
+  if ( cTcKeyPendingCount < TCKEY_PENDING_MAX )
+  {
+    adlTcKeyPending[cTcKeyPendingCount++] = dlExtAddr;
+  }
+  else
+  {
+    /* More changes than expected between two lookups : index built again */
+    bTcKeyStale = true;
+  }
+
+  return ZB_MSG_CONTINUE;
+}
+
+/**
+ * @brief  Print the statistics of the index.
+ * @param  None
+ * @retval None
+ */
+static void TcKeyPrintStats( void )
+{
+  LOG_INFO_APP( "TC key index : %d keys in %d slots (longest probe %d), %s.", stTcKeyStats.iKeys, CFG_ZIGBEE_TC_KEY_INDEX_SIZE,
+                stTcKeyStats.iMaxProbes, ( ( bTcKeyComplete != false ) ? "complete" : "partial" ) );
+  LOG_INFO_APP( "  %d lookups, %d hits, %d table walks, %d rebuilds, %d overflows.", stTcKeyStats.lLookups, stTcKeyStats.lHits,
+                stTcKeyStats.lWalks, stTcKeyStats.lRebuilds, stTcKeyStats.lOverflows );
+}
+
+#else /* (CFG_ZIGBEE_TC_KEY_INDEX_SUPPORTED != 0) */
+
+/**
+ * @brief  TC key index not supported.
+ */
+void APP_ZIGBEE_TcKeyInit( void )
+{
+}
+
+/**
+ * @brief  TC key index not supported.
+ */
+void APP_ZIGBEE_TcKeyStart( void )
+{
+}
+
+/**
+ * @brief  TC key index not supported.
+ */
+void APP_ZIGBEE_TcKeyAdded( uint64_t dlExtAddr )
+{
+  UNUSED( dlExtAddr );
+}
+
+/**
+ * @brief  TC key index not supported : walk of the stack table.
+ */
+bool APP_ZIGBEE_TcKeyLookup( uint64_t dlExtAddr, struct ZbApsmeKeyPairT * pstKeyPair )
+{
+  struct ZbApsmeKeyPairT  stKeyPair;
+  unsigned int            iIndex;
+
+  if ( stZigbeeAppInfo.pstZigbee == NULL )
+  {
+    return false;
+  }
+
+  return ( ZbApsLookupKey( stZigbeeAppInfo.pstZigbee, ( ( pstKeyPair != NULL ) ? pstKeyPair : &stKeyPair ), dlExtAddr, &iIndex ) != NULL );
+}
+
+/**
+ * @brief  TC key index not supported : no statistics.
+ */
+const APP_ZIGBEE_TcKeyStats_t * APP_ZIGBEE_TcKeyGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_TC_KEY_INDEX_SUPPORTED != 0) */
@@ -0,0 +1,57 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_tckey.h
+  * @author  MCD Application Team
+  * @brief   Interface of the EUI64 index of the Trust Center device keys.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_TCKEY_H
+#define APP_ZIGBEE_TCKEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zigbee.aps.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the index */
+typedef struct
+{
+  uint32_t    lLookups;               /* Number of lookups */
+  uint32_t    lHits;                  /* Lookups answered by the index */
+  uint32_t    lWalks;                 /* Lookups or adds that walked the stack table */
+  uint32_t    lRebuilds;              /* Number of rebuilds from the stack table */
+  uint32_t    lOverflows;             /* Number of keys not indexed (index full) */
+  uint16_t    iKeys;                  /* Keys indexed */
+  uint16_t    iMaxProbes;             /* Longest probe sequence seen */
+} APP_ZIGBEE_TcKeyStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_TcKeyInit              ( void );
+void      APP_ZIGBEE_TcKeyStart             ( void );
+void      APP_ZIGBEE_TcKeyAdded             ( uint64_t dlExtAddr );
+bool      APP_ZIGBEE_TcKeyLookup            ( uint64_t dlExtAddr, struct ZbApsmeKeyPairT * pstKeyPair );
+
+const APP_ZIGBEE_TcKeyStats_t * APP_ZIGBEE_TcKeyGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_TCKEY_H */
@@ -0,0 +1,943 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_timesync.c
+  * @author  MCD Application Team
+  * @brief   Mesh time synchronization : the us time base of the master is
+  *          shared by two-way exchanges (manufacturer specific commands of the
+  *          Time cluster), and the OnOff/Level/Scenes commands sent with a mesh
+  *          time are applied at that time by all their receivers.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_bindmap.h"
+#include "app_zigbee_timesync.h"
+#include "timer_if.h"
+
+#include "zigbee.aps.h"
+#include "zcl/zcl.h"
+#include "zcl/general/zcl.time.h"
+
+#if (CFG_ZIGBEE_TIMESYNC_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define TIMESYNC_MANUFACTURER_CODE      (0x1041u)   /* STMicroelectronics */
+#define TIMESYNC_REQ_LENGTH             (8u)        /* t1 */
+#define TIMESYNC_RSP_LENGTH             (28u)       /* t1, t2, t3, Zigbee time of the mesh time 0 */
+#define TIMESYNC_APPLY_HEADER_LENGTH    (11u)       /* Mesh time, cluster, command */
+#define TIMESYNC_EPOCH_NONE             (UINT32_MAX)
+#define TIMESYNC_SKEW_MAX               (200000)    /* ppb, larger rates are measurement errors */
+#define TIMESYNC_SKEW_MIN_INTERVAL      (1000000)   /* us, between the two synchronizations giving the rate */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Command waiting for its mesh time */
+typedef struct
+{
+  bool        bUsed;
+  uint16_t    iClusterId;
+  uint8_t     cCmdId;
+  uint8_t     cLength;
+  uint64_t    dlLocalTime;            /* us, local time of the mesh time */
+  uint8_t     aPayload[CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX];
+} TimeSyncApply_t;
+
+/* Private functions prototypes-----------------------------------------------*/
+static enum zb_msg_filter_rc TimeSyncFilterCallback ( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg );
+static void     TimeSyncSyncRequest     ( void );
+static void     TimeSyncSyncResponse    ( const struct ZbApsdeDataIndT * pstIndication, uint8_t cSequence,
+                                          const uint8_t * pPayload, uint64_t dlRxTime );
+static void     TimeSyncSample          ( const uint8_t * pPayload, uint64_t dlRxTime );
+static void     TimeSyncBurstEnd        ( void );
+static void     TimeSyncTimerCallback   ( struct ZigBeeT * zb, void * arg );
+static void     TimeSyncApplyReceived   ( const struct ZbApsdeDataIndT * pstIndication, const uint8_t * pPayload,
+                                          uint16_t iLength, uint64_t dlRxTime );
+static void     TimeSyncApplyArm        ( void );
+static void     TimeSyncApplyTimerCallback ( struct ZigBeeT * zb, void * arg );
+static void     TimeSyncApplyOutput     ( TimeSyncApply_t * pstApply );
+static void     TimeSyncUpdateStatus    ( void );
+static uint64_t TimeSyncLocalToMesh     ( uint64_t dlLocalTime );
+static uint64_t TimeSyncMeshToLocal     ( uint64_t dlMeshTime );
+static void     TimeSyncPut64           ( uint8_t * pData, uint64_t dlValue );
+static uint64_t TimeSyncGet64           ( const uint8_t * pData );
+static uint32_t TimeSyncServerGetTime   ( struct ZbZclClusterT * pstCluster, void * arg );
+static void     TimeSyncServerSetTime   ( struct ZbZclClusterT * pstCluster, uint32_t lTime, void * arg );
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZigBeeT             * pstTimeSyncZigbee;
+static struct ZbZclClusterT       * pstTimeSyncServer;
+static struct ZbTimerT            * pstTimeSyncTimer;       /* Period of the synchronizations, then timeout of a sample */
+static struct ZbTimerT            * pstTimeSyncApplyTimer;  /* Next command to apply, CFG_ZIGBEE_TIMESYNC_APPLY_LEAD ahead */
+static APP_ZIGBEE_TimeSyncOutput_t  pfTimeSyncOutput;
+static APP_ZIGBEE_TimeSyncState_t   stTimeSyncState;
+static uint8_t                      cTimeSyncEndpoint;
+static uint8_t                      cTimeSyncServerEndpoint;
+static uint16_t                     iTimeSyncProfileId;
+static uint32_t                     lTimeSyncEpoch = TIMESYNC_EPOCH_NONE;   /* Zigbee time (s) of the mesh time 0 */
+static uint64_t                     dlTimeSyncLocal;        /* us, local time of the last synchronization */
+
+/* Burst of samples of a synchronization : the one of shortest round trip is kept */
+static bool                         bTimeSyncBurst;
+static uint8_t                      cTimeSyncSample;
+static uint64_t                     dlTimeSyncT1;           /* t1 of the sample waiting for its response, 0 if none */
+static uint32_t                     lTimeSyncBestDelay;
+static int64_t                      dlTimeSyncBestOffset;
+static uint32_t                     lTimeSyncBestEpoch;
+
+static TimeSyncApply_t              astTimeSyncApply[CFG_ZIGBEE_TIMESYNC_APPLY_NB];
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Allocate the Time Server of the Endpoint, with the filter of the synchronization and of the commands
+ *         applied at a mesh time.
+ * @param  pstZigbee        Zigbee stack handler
+ * @param  cEndpoint        Endpoint of the Time Server (same Endpoint on the master)
+ * @param  iProfileId       Profile of the Endpoint
+ * @param  cServerEndpoint  Endpoint of the Servers the commands applied at a mesh time are delivered to
+ * @param  pfOutput         Output of these commands at their mesh time (NULL : the stack drives it)
+ * @retval None
+ */
+void APP_ZIGBEE_TimeSyncInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId,
+                              uint8_t cServerEndpoint, APP_ZIGBEE_TimeSyncOutput_t pfOutput )
+{
+  static struct ZbZclTimeServerCallbacks  stCallbacks =
+  {
+    .get_time = TimeSyncServerGetTime,
+    .set_time = TimeSyncServerSetTime,
+  };
+
+  pstTimeSyncZigbee = pstZigbee;
+  cTimeSyncEndpoint = cEndpoint;
+  cTimeSyncServerEndpoint = cServerEndpoint;
+  iTimeSyncProfileId = iProfileId;
+  pfTimeSyncOutput = pfOutput;
+  stTimeSyncState.iMaster = CFG_ZIGBEE_TIMESYNC_MASTER;
+
+  pstTimeSyncServer = ZbZclTimeServerAlloc( pstZigbee, cEndpoint, &stCallbacks, NULL );
+  if ( pstTimeSyncServer == NULL )
+  {
+    LOG_ERROR_APP( "Error, Time Server allocation failed." );
+  }
+  else
+  {
+    (void)ZbZclClusterEndpointRegister( pstTimeSyncServer );
+  }
+
+  pstTimeSyncTimer = ZbTimerAlloc( pstZigbee, TimeSyncTimerCallback, NULL );
+  pstTimeSyncApplyTimer = ZbTimerAlloc( pstZigbee, TimeSyncApplyTimerCallback, NULL );
+
+  /* Before the fast path : the output of a command received late is driven at once */
+  if ( ZbMsgFilterRegister( pstZigbee, ZB_MSG_FILTER_APSDE_DATA_IND, ( ZB_MSG_INTERNAL_PRIO + 2u ),
+                            TimeSyncFilterCallback, NULL ) == NULL )
+  {
+    LOG_ERROR_APP( "Error, Time synchronization filter registration failed." );
+  }
+}
+
+/**
+ * @brief  Start the synchronizations (once on the Network) : the master (CFG_ZIGBEE_TIMESYNC_MASTER) is the time base,
+ *         the other nodes synchronize every CFG_ZIGBEE_TIMESYNC_PERIOD.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_TimeSyncStart( void )
+{
+  stTimeSyncState.bMaster = ( ZbShortAddress( pstTimeSyncZigbee ) == stTimeSyncState.iMaster );
+  bTimeSyncBurst = false;
+  TimeSyncUpdateStatus();
+
+  if ( stTimeSyncState.bMaster == false )
+  {
+    /* First synchronization spread over a second (by the EUI64), the nodes of a Network are started together */
+    ZbTimerReset( pstTimeSyncTimer, 100u + (uint32_t)( ZbExtendedAddress( pstTimeSyncZigbee ) % 1000u ) );
+  }
+  else
+  {
+    ZbTimerStop( pstTimeSyncTimer );
+  }
+}
+
+/**
+ * @brief  Current mesh time.
+ * @param  pdlMeshTime  Mesh time (us of the master)
+ * @retval True if the time is the mesh time (master or synchronized).
+ */
+bool APP_ZIGBEE_TimeSyncGetTime( uint64_t * pdlMeshTime )
+{
+  *pdlMeshTime = TimeSyncLocalToMesh( TIMER_IF_GetTimeUs() );
+
+  return ( ( stTimeSyncState.bMaster != false ) || ( stTimeSyncState.bSynchronized != false ) );
+}
+
+/**
+ * @brief  Send a cluster specific command (to the Server) applied by its receivers at the mesh time lDelay from now.
+ * @param  pstDest      Destination (a group for the receivers to actuate together)
+ * @param  iClusterId   Cluster of the command (OnOff, Level Control, Scenes)
+ * @param  cCmdId       Command
+ * @param  pPayload     Payload of the command
+ * @param  cLength      Length of the payload (at most CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX)
+ * @param  lDelay       ms, larger than the delivery time to all the receivers
+ * @retval True if the command is sent.
+ */
+bool APP_ZIGBEE_TimeSyncSendAt( const struct ZbApsAddrT * pstDest, uint16_t iClusterId, uint8_t cCmdId,
+                                const uint8_t * pPayload, uint8_t cLength, uint32_t lDelay )
+{
+  struct ZbZclCommandReqT   stRequest;
+  uint8_t                   aPayload[TIMESYNC_APPLY_HEADER_LENGTH + CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX];
+  uint64_t                  dlMeshTime;
+
+  if ( ( cLength > CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX ) || ( APP_ZIGBEE_TimeSyncGetTime( &dlMeshTime ) == false ) )
+  {
+    return false;
+  }
+
+  TimeSyncPut64( aPayload, dlMeshTime + ( (uint64_t)lDelay * 1000u ) );
+  aPayload[8] = (uint8_t)( iClusterId & 0xFFu );
+  aPayload[9] = (uint8_t)( iClusterId >> 8u );
+  aPayload[10] = cCmdId;
+  if ( cLength != 0u )
+  {
+    memcpy( &aPayload[TIMESYNC_APPLY_HEADER_LENGTH], pPayload, cLength );
+  }
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst = *pstDest;
+  stRequest.profileId = iTimeSyncProfileId;
+  stRequest.clusterId = ZCL_CLUSTER_TIME;
+  stRequest.srcEndpt = cTimeSyncEndpoint;
+  stRequest.txOptions = ZB_APSDE_DATAREQ_TXOPTIONS_SECURITY;
+  stRequest.discoverRoute = true;
+  stRequest.radius = 0;
+  stRequest.hdr.frameCtrl.frameType = ZCL_FRAMETYPE_CLUSTER;
+  stRequest.hdr.frameCtrl.manufacturer = 1u;
+  stRequest.hdr.frameCtrl.direction = ZCL_DIRECTION_TO_SERVER;
+  stRequest.hdr.frameCtrl.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_TRUE;
+  stRequest.hdr.manufacturerCode = TIMESYNC_MANUFACTURER_CODE;
+  stRequest.hdr.seqNum = ZbZclGetNextSeqnum( pstTimeSyncZigbee );
+  stRequest.hdr.cmdId = APP_ZIGBEE_TIMESYNC_CMD_APPLY_AT;
+  stRequest.payload = aPayload;
+  stRequest.length = TIMESYNC_APPLY_HEADER_LENGTH + cLength;
+
+  if ( ZbZclCommandReq( pstTimeSyncZigbee, &stRequest, NULL, NULL ) != ZCL_STATUS_SUCCESS )
+  {
+    return false;
+  }
+
+  stTimeSyncState.lApplySent++;
+  return true;
+}
+
+/**
+ * @brief  State of the time synchronization.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_TimeSyncState_t * APP_ZIGBEE_TimeSyncGetState( void )
+{
+  return &stTimeSyncState;
+}
+
+/**
+ * @brief  Time synchronization serial commands : TIMESYNC (state), TIMESYNC MASTER <address> (time base of the mesh),
+ *         TIMESYNC ONOFF <group> <command> <delay ms> (OnOff command applied at a mesh time by the group).
+ * @param  szCommand  Command received
+ * @retval True if the command is a time synchronization command.
+ */
+bool APP_ZIGBEE_TimeSyncSerialCmdExecute( const char * szCommand )
+{
+  struct ZbApsAddrT   stDest;
+  char              * pEnd;
+  uint32_t            lGroup, lCmdId, lDelay;
+
+  if ( strncmp( szCommand, "TIMESYNC", 8u ) != 0 )
+  {
+    return false;
+  }
+
+  if ( strncmp( szCommand, "TIMESYNC MASTER ", 16u ) == 0 )
+  {
+    stTimeSyncState.iMaster = (uint16_t)strtoul( &szCommand[16], NULL, 0 );
+    stTimeSyncState.bSynchronized = false;
+    APP_ZIGBEE_TimeSyncStart();
+  }
+  else if ( strncmp( szCommand, "TIMESYNC ONOFF ", 15u ) == 0 )
+  {
+    lGroup = strtoul( &szCommand[15], &pEnd, 0 );
+    lCmdId = strtoul( pEnd, &pEnd, 0 );
+    lDelay = strtoul( pEnd, &pEnd, 0 );
+
+    memset( &stDest, 0, sizeof( stDest ) );
+    stDest.mode = ZB_APSDE_ADDRMODE_GROUP;
+    stDest.nwkAddr = (uint16_t)lGroup;
+    stDest.endpoint = ZB_ENDPOINT_BCAST;
+    if ( APP_ZIGBEE_TimeSyncSendAt( &stDest, ZCL_CLUSTER_ONOFF, (uint8_t)lCmdId, NULL, 0u, lDelay ) == false )
+    {
+      LOG_ERROR_APP( "[TIMESYNC] Error, OnOff command not sent (not synchronized)." );
+    }
+  }
+  else if ( szCommand[8] != '\0' )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "[TIMESYNC] Master 0x%04X (%s), %s, offset %d ms, skew %d ppb, delay %u us, %u syncs (%u failed).",
+                stTimeSyncState.iMaster, ( stTimeSyncState.bMaster != false ) ? "this node" : "remote",
+                ( ( stTimeSyncState.bMaster != false ) || ( stTimeSyncState.bSynchronized != false ) ) ? "synchronized" : "not synchronized",
+                (int32_t)( stTimeSyncState.dlOffset / 1000 ), stTimeSyncState.lSkew, stTimeSyncState.lDelay,
+                stTimeSyncState.lSyncNb, stTimeSyncState.lSyncFailed );
+  LOG_INFO_APP( "[TIMESYNC] Apply at : %u sent, %u applied (worst lateness %u us), %u late, %u dropped.",
+                stTimeSyncState.lApplySent, stTimeSyncState.lApplied, stTimeSyncState.lApplyErrorMax,
+                stTimeSyncState.lApplyLate, stTimeSyncState.lApplyDropped );
+
+  return true;
+}
+
+/**
+ * @brief  APSDE-DATA.indication filter, before the stack : the manufacturer specific commands of the Time cluster. The
+ *         reception time is taken first, it is the t2 or t4 of the synchronization.
+ * @param  zb       Zigbee stack instance
+ * @param  lId      Message filter identifier
+ * @param  pMessage APSDE-DATA.indication
+ * @param  arg      Not used
+ * @retval ZB_MSG_DISCARD for the commands processed here, else ZB_MSG_CONTINUE.
+ */
+static enum zb_msg_filter_rc TimeSyncFilterCallback( struct ZigBeeT * zb, uint32_t lId, void * pMessage, void * arg )
+{
+  const struct ZbApsdeDataIndT  * pstIndication = (const struct ZbApsdeDataIndT *)pMessage;
+  struct ZbZclHeaderT             stHeader;
+  const uint8_t                 * pPayload;
+  uint64_t                        dlRxTime = TIMER_IF_GetTimeUs();
+  uint16_t                        iLength;
+  int                             iHeaderLength;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( ( lId != ZB_MSG_FILTER_APSDE_DATA_IND ) || ( pstIndication->clusterId != ZCL_CLUSTER_TIME ) ||
+       ( pstIndication->profileId != iTimeSyncProfileId ) || ( pstIndication->securityStatus == ZB_APS_STATUS_UNSECURED ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  iHeaderLength = ZbZclParseHeader( &stHeader, pstIndication->asdu, pstIndication->asduLength );
+  if ( ( iHeaderLength <= 0 ) || ( stHeader.frameCtrl.frameType != ZCL_FRAMETYPE_CLUSTER ) ||
+       ( stHeader.frameCtrl.manufacturer == 0u ) || ( stHeader.manufacturerCode != TIMESYNC_MANUFACTURER_CODE ) )
+  {
+    return( ZB_MSG_CONTINUE );
+  }
+
+  pPayload = &pstIndication->asdu[iHeaderLength];
+  iLength = (uint16_t)( pstIndication->asduLength - (unsigned int)iHeaderLength );
+
+  if ( stHeader.frameCtrl.direction == ZCL_DIRECTION_TO_SERVER )
+  {
+    if ( ( stHeader.cmdId == APP_ZIGBEE_TIMESYNC_CMD_SYNC_REQ ) && ( iLength >= TIMESYNC_REQ_LENGTH ) )
+    {
+      /* Only the master answers : the mesh time is never the one of a synchronized node */
+      if ( stTimeSyncState.bMaster != false )
+      {
+        TimeSyncSyncResponse( pstIndication, stHeader.seqNum, pPayload, dlRxTime );
+      }
+    }
+    else if ( ( stHeader.cmdId == APP_ZIGBEE_TIMESYNC_CMD_APPLY_AT ) && ( iLength >= TIMESYNC_APPLY_HEADER_LENGTH ) )
+    {
+      TimeSyncApplyReceived( pstIndication, pPayload, iLength, dlRxTime );
+    }
+  }
+  else if ( ( stHeader.cmdId == APP_ZIGBEE_TIMESYNC_CMD_SYNC_RSP ) && ( iLength >= TIMESYNC_RSP_LENGTH ) )
+  {
+    TimeSyncSample( pPayload, dlRxTime );
+  }
+
+  return( ZB_MSG_DISCARD );
+}
+
+/**
+ * @brief  Send a sample request (t1) to the master, then wait its response at most CFG_ZIGBEE_TIMESYNC_SAMPLE_TIMEOUT.
+ * @param  None
+ * @retval None
+ */
+static void TimeSyncSyncRequest( void )
+{
+  struct ZbZclCommandReqT   stRequest;
+  uint8_t                   aPayload[TIMESYNC_REQ_LENGTH];
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst.mode = ZB_APSDE_ADDRMODE_SHORT;
+  stRequest.dst.nwkAddr = stTimeSyncState.iMaster;
+  stRequest.dst.endpoint = cTimeSyncEndpoint;
+  stRequest.profileId = iTimeSyncProfileId;
+  stRequest.clusterId = ZCL_CLUSTER_TIME;
+  stRequest.srcEndpt = cTimeSyncEndpoint;
+  stRequest.txOptions = ZB_APSDE_DATAREQ_TXOPTIONS_SECURITY;
+  stRequest.discoverRoute = true;
+  stRequest.hdr.frameCtrl.frameType = ZCL_FRAMETYPE_CLUSTER;
+  stRequest.hdr.frameCtrl.manufacturer = 1u;
+  stRequest.hdr.frameCtrl.direction = ZCL_DIRECTION_TO_SERVER;
+  stRequest.hdr.frameCtrl.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_TRUE;
+  stRequest.hdr.manufacturerCode = TIMESYNC_MANUFACTURER_CODE;
+  stRequest.hdr.seqNum = ZbZclGetNextSeqnum( pstTimeSyncZigbee );
+  stRequest.hdr.cmdId = APP_ZIGBEE_TIMESYNC_CMD_SYNC_REQ;
+  stRequest.payload = aPayload;
+  stRequest.length = sizeof( aPayload );
+
+  /* t1 taken last : the time to build the frame is not part of the round trip */
+  dlTimeSyncT1 = TIMER_IF_GetTimeUs();
+  TimeSyncPut64( aPayload, dlTimeSyncT1 );
+  if ( ZbZclCommandReq( pstTimeSyncZigbee, &stRequest, NULL, NULL ) != ZCL_STATUS_SUCCESS )
+  {
+    dlTimeSyncT1 = 0u;
+  }
+
+  ZbTimerReset( pstTimeSyncTimer, CFG_ZIGBEE_TIMESYNC_SAMPLE_TIMEOUT );
+}
+
+/**
+ * @brief  Master : response to a sample request, with t1, its reception time t2 and its transmission time t3.
+ * @param  pstIndication  Sample request
+ * @param  cSequence      ZCL sequence of the request
+ * @param  pPayload       t1
+ * @param  dlRxTime       t2
+ * @retval None
+ */
+static void TimeSyncSyncResponse( const struct ZbApsdeDataIndT * pstIndication, uint8_t cSequence,
+                                  const uint8_t * pPayload, uint64_t dlRxTime )
+{
+  struct ZbZclCommandReqT   stRequest;
+  uint8_t                   aPayload[TIMESYNC_RSP_LENGTH];
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst.mode = ZB_APSDE_ADDRMODE_SHORT;
+  stRequest.dst.nwkAddr = pstIndication->src.nwkAddr;
+  stRequest.dst.endpoint = pstIndication->src.endpoint;
+  stRequest.profileId = iTimeSyncProfileId;
+  stRequest.clusterId = ZCL_CLUSTER_TIME;
+  stRequest.srcEndpt = cTimeSyncEndpoint;
+  stRequest.txOptions = ZB_APSDE_DATAREQ_TXOPTIONS_SECURITY;
+  stRequest.discoverRoute = true;
+  stRequest.hdr.frameCtrl.frameType = ZCL_FRAMETYPE_CLUSTER;
+  stRequest.hdr.frameCtrl.manufacturer = 1u;
+  stRequest.hdr.frameCtrl.direction = ZCL_DIRECTION_TO_CLIENT;
+  stRequest.hdr.frameCtrl.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_TRUE;
+  stRequest.hdr.manufacturerCode = TIMESYNC_MANUFACTURER_CODE;
+  stRequest.hdr.seqNum = cSequence;
+  stRequest.hdr.cmdId = APP_ZIGBEE_TIMESYNC_CMD_SYNC_RSP;
+  stRequest.payload = aPayload;
+  stRequest.length = sizeof( aPayload );
+
+  memcpy( aPayload, pPayload, 8u );
+  TimeSyncPut64( &aPayload[8], dlRxTime );
+  aPayload[24] = (uint8_t)( lTimeSyncEpoch & 0xFFu );
+  aPayload[25] = (uint8_t)( ( lTimeSyncEpoch >> 8u ) & 0xFFu );
+  aPayload[26] = (uint8_t)( ( lTimeSyncEpoch >> 16u ) & 0xFFu );
+  aPayload[27] = (uint8_t)( lTimeSyncEpoch >> 24u );
+  TimeSyncPut64( &aPayload[16], TIMER_IF_GetTimeUs() );
+
+  (void)ZbZclCommandReq( pstTimeSyncZigbee, &stRequest, NULL, NULL );
+}
+
+/**
+ * @brief  Sample response (t4 its reception time) : offset ((t2 - t1) + (t3 - t4)) / 2, its error bounded by half the
+ *         round trip (t4 - t1) - (t3 - t2). The sample of shortest round trip of the burst is kept.
+ * @param  pPayload   t1, t2, t3, Zigbee time of the mesh time 0
+ * @param  dlRxTime   t4
+ * @retval None
+ */
+static void TimeSyncSample( const uint8_t * pPayload, uint64_t dlRxTime )
+{
+  uint64_t  dlT1, dlT2, dlT3;
+  int64_t   dlRoundTrip;
+
+  dlT1 = TimeSyncGet64( pPayload );
+  dlT2 = TimeSyncGet64( &pPayload[8] );
+  dlT3 = TimeSyncGet64( &pPayload[16] );
+
+  /* Only the response to the sample waited (a late one has a longer round trip anyway) */
+  if ( ( bTimeSyncBurst == false ) || ( dlT1 != dlTimeSyncT1 ) || ( dlT1 == 0u ) )
+  {
+    return;
+  }
+  dlTimeSyncT1 = 0u;
+
+  dlRoundTrip = (int64_t)( dlRxTime - dlT1 ) - (int64_t)( dlT3 - dlT2 );
+  if ( ( dlRoundTrip >= 0 ) && ( dlRoundTrip < (int64_t)lTimeSyncBestDelay ) )
+  {
+    lTimeSyncBestDelay = (uint32_t)dlRoundTrip;
+    dlTimeSyncBestOffset = ( ( (int64_t)( dlT2 - dlT1 ) ) + ( (int64_t)( dlT3 - dlRxTime ) ) ) / 2;
+    lTimeSyncBestEpoch = (uint32_t)pPayload[24] | ( (uint32_t)pPayload[25] << 8u ) | ( (uint32_t)pPayload[26] << 16u ) |
+                         ( (uint32_t)pPayload[27] << 24u );
+  }
+
+  /* Next sample out of the stack callback */
+  ZbTimerReset( pstTimeSyncTimer, 0u );
+}
+
+/**
+ * @brief  End of a burst : offset of the sample kept, rate of the master clock from the previous synchronization.
+ * @param  None
+ * @retval None
+ */
+static void TimeSyncBurstEnd( void )
+{
+  uint64_t  dlNow = TIMER_IF_GetTimeUs();
+  int64_t   dlSkew;
+
+  bTimeSyncBurst = false;
+  if ( lTimeSyncBestDelay == UINT32_MAX )
+  {
+    stTimeSyncState.lSyncFailed++;
+    return;
+  }
+
+  if ( ( stTimeSyncState.bSynchronized != false ) && ( ( dlNow - dlTimeSyncLocal ) > TIMESYNC_SKEW_MIN_INTERVAL ) )
+  {
+    dlSkew = ( ( dlTimeSyncBestOffset - stTimeSyncState.dlOffset ) * 1000000000 ) / (int64_t)( dlNow - dlTimeSyncLocal );
+    if ( ( dlSkew > -TIMESYNC_SKEW_MAX ) && ( dlSkew < TIMESYNC_SKEW_MAX ) )
+    {
+      /* Smoothed from the second rate on */
+      stTimeSyncState.lSkew = ( stTimeSyncState.lSyncNb < 2u ) ? (int32_t)dlSkew : ( ( stTimeSyncState.lSkew + (int32_t)dlSkew ) / 2 );
+    }
+  }
+
+  stTimeSyncState.dlOffset = dlTimeSyncBestOffset;
+  stTimeSyncState.lDelay = lTimeSyncBestDelay;
+  stTimeSyncState.lSyncNb++;
+  dlTimeSyncLocal = dlNow;
+  lTimeSyncEpoch = lTimeSyncBestEpoch;
+  if ( stTimeSyncState.bSynchronized == false )
+  {
+    stTimeSyncState.bSynchronized = true;
+    TimeSyncUpdateStatus();
+  }
+}
+
+/**
+ * @brief  Synchronization timer : start of a burst every CFG_ZIGBEE_TIMESYNC_PERIOD, then next sample of the burst.
+ * @param  zb     Zigbee stack instance
+ * @param  arg    Not used
+ * @retval None
+ */
+static void TimeSyncTimerCallback( struct ZigBeeT * zb, void * arg )
+{
+  UNUSED( zb );
+  UNUSED( arg );
+
+  if ( ( stTimeSyncState.bMaster != false ) || ( APP_ZIGBEE_IsAppliJoinNetwork() == false ) )
+  {
+    return;
+  }
+
+  if ( bTimeSyncBurst == false )
+  {
+    bTimeSyncBurst = true;
+    cTimeSyncSample = 0;
+    lTimeSyncBestDelay = UINT32_MAX;
+  }
+
+  if ( cTimeSyncSample < CFG_ZIGBEE_TIMESYNC_BURST_NB )
+  {
+    cTimeSyncSample++;
+    TimeSyncSyncRequest();
+  }
+  else
+  {
+    TimeSyncBurstEnd();
+    ZbTimerReset( pstTimeSyncTimer, CFG_ZIGBEE_TIMESYNC_PERIOD );
+  }
+}
+
+/**
+ * @brief  Command to apply at a mesh time : kept until its local time, applied at once if late.
+ * @param  pstIndication  APSDE-DATA.indication
+ * @param  pPayload       Mesh time, cluster, command and its payload
+ * @param  iLength        Length of the payload
+ * @param  dlRxTime       Reception time
+ * @retval None
+ */
+static void TimeSyncApplyReceived( const struct ZbApsdeDataIndT * pstIndication, const uint8_t * pPayload,
+                                   uint16_t iLength, uint64_t dlRxTime )
+{
+  TimeSyncApply_t   * pstApply = NULL;
+  uint16_t            iIndex;
+
+  /* Only the frames the Servers accept */
+  if ( pstIndication->dst.mode == ZB_APSDE_ADDRMODE_GROUP )
+  {
+    if ( APP_ZIGBEE_BindMapIsGroupMember( pstIndication->dst.nwkAddr, cTimeSyncServerEndpoint ) == false )
+    {
+      return;
+    }
+  }
+  else if ( ( pstIndication->dst.endpoint != cTimeSyncServerEndpoint ) && ( pstIndication->dst.endpoint != cTimeSyncEndpoint )
+            && ( pstIndication->dst.endpoint != ZB_ENDPOINT_BCAST ) )
+  {
+    return;
+  }
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_TIMESYNC_APPLY_NB; iIndex++ )
+  {
+    if ( astTimeSyncApply[iIndex].bUsed == false )
+    {
+      pstApply = &astTimeSyncApply[iIndex];
+      break;
+    }
+  }
+
+  if ( ( pstApply == NULL ) || ( ( iLength - TIMESYNC_APPLY_HEADER_LENGTH ) > CFG_ZIGBEE_TIMESYNC_PAYLOAD_MAX ) ||
+       ( ( stTimeSyncState.bMaster == false ) && ( stTimeSyncState.bSynchronized == false ) ) )
+  {
+    stTimeSyncState.lApplyDropped++;
+    return;
+  }
+
+  pstApply->dlLocalTime = TimeSyncMeshToLocal( TimeSyncGet64( pPayload ) );
+  if ( pstApply->dlLocalTime > ( dlRxTime + ( (uint64_t)CFG_ZIGBEE_TIMESYNC_APPLY_MAX * 1000u ) ) )
+  {
+    stTimeSyncState.lApplyDropped++;
+    return;
+  }
+
+  pstApply->bUsed = true;
+  pstApply->iClusterId = (uint16_t)( pPayload[8] | ( (uint16_t)pPayload[9] << 8u ) );
+  pstApply->cCmdId = pPayload[10];
+  pstApply->cLength = (uint8_t)( iLength - TIMESYNC_APPLY_HEADER_LENGTH );
+  memcpy( pstApply->aPayload, &pPayload[TIMESYNC_APPLY_HEADER_LENGTH], pstApply->cLength );
+
+  if ( pstApply->dlLocalTime <= dlRxTime )
+  {
+    stTimeSyncState.lApplyLate++;
+    TimeSyncApplyOutput( pstApply );
+  }
+
+  TimeSyncApplyArm();
+}
+
+/**
+ * @brief  Arm the apply timer CFG_ZIGBEE_TIMESYNC_APPLY_LEAD ahead of the next command to apply.
+ * @param  None
+ * @retval None
+ */
+static void TimeSyncApplyArm( void )
+{
+  uint64_t  dlNext = UINT64_MAX;
+  uint64_t  dlNow = TIMER_IF_GetTimeUs();
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < CFG_ZIGBEE_TIMESYNC_APPLY_NB; iIndex++ )
+  {
+    if ( ( astTimeSyncApply[iIndex].bUsed != false ) && ( astTimeSyncApply[iIndex].dlLocalTime < dlNext ) )
+    {
+      dlNext = astTimeSyncApply[iIndex].dlLocalTime;
+    }
+  }
+
+  if ( dlNext == UINT64_MAX )
+  {
+    ZbTimerStop( pstTimeSyncApplyTimer );
+  }
+  else if ( dlNext <= ( dlNow + ( CFG_ZIGBEE_TIMESYNC_APPLY_LEAD * 1000u ) ) )
+  {
+    ZbTimerReset( pstTimeSyncApplyTimer, 0u );
+  }
+  else
+  {
+    ZbTimerReset( pstTimeSyncApplyTimer, (unsigned int)( ( dlNext - dlNow ) / 1000u ) - CFG_ZIGBEE_TIMESYNC_APPLY_LEAD );
+  }
+}
+
+/**
+ * @brief  Apply timer : the commands due within CFG_ZIGBEE_TIMESYNC_APPLY_LEAD are applied at their exact local time
+ *         (the us time base is polled until then).
+ * @param  zb     Zigbee stack instance
+ * @param  arg    Not used
+ * @retval None
+ */
+static void TimeSyncApplyTimerCallback( struct ZigBeeT * zb, void * arg )
+{
+  TimeSyncApply_t   * pstApply;
+  uint64_t            dlNow;
+  uint16_t            iIndex;
+  bool                bDue;
+
+  UNUSED( zb );
+  UNUSED( arg );
+
+  do
+  {
+    pstApply = NULL;
+    for ( iIndex = 0; iIndex < CFG_ZIGBEE_TIMESYNC_APPLY_NB; iIndex++ )
+    {
+      if ( ( astTimeSyncApply[iIndex].bUsed != false ) &&
+           ( ( pstApply == NULL ) || ( astTimeSyncApply[iIndex].dlLocalTime < pstApply->dlLocalTime ) ) )
+      {
+        pstApply = &astTimeSyncApply[iIndex];
+      }
+    }
+
+    dlNow = TIMER_IF_GetTimeUs();
+    bDue = ( ( pstApply != NULL ) && ( pstApply->dlLocalTime <= ( dlNow + ( CFG_ZIGBEE_TIMESYNC_APPLY_LEAD * 1000u ) ) ) );
+    if ( bDue != false )
+    {
+      while ( TIMER_IF_GetTimeUs() < pstApply->dlLocalTime )
+      {
+      }
+      TimeSyncApplyOutput( pstApply );
+    }
+  }
+  while ( bDue != false );
+
+  TimeSyncApplyArm();
+}
+
+/**
+ * @brief  Output of a command at its local time (GPIO/PWM, no log), then the command is delivered to the Server Endpoint
+ *         for the stack to process it as if just received (attributes, transitions, scenes).
+ * @param  pstApply   Command to apply
+ * @retval None
+ */
+static void TimeSyncApplyOutput( TimeSyncApply_t * pstApply )
+{
+  struct ZbZclCommandReqT   stRequest;
+  uint32_t                  lLateness;
+
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.hdr.frameCtrl.frameType = ZCL_FRAMETYPE_CLUSTER;
+  stRequest.hdr.frameCtrl.direction = ZCL_DIRECTION_TO_SERVER;
+  stRequest.hdr.frameCtrl.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_TRUE;
+  stRequest.hdr.seqNum = ZbZclGetNextSeqnum( pstTimeSyncZigbee );
+  stRequest.hdr.cmdId = pstApply->cCmdId;
+
+  if ( pfTimeSyncOutput != NULL )
+  {
+    pfTimeSyncOutput( pstApply->iClusterId, &stRequest.hdr, pstApply->aPayload, pstApply->cLength );
+  }
+
+  lLateness = (uint32_t)( TIMER_IF_GetTimeUs() - pstApply->dlLocalTime );
+  if ( lLateness < ( CFG_ZIGBEE_TIMESYNC_APPLY_LEAD * 1000u ) )
+  {
+    stTimeSyncState.lApplyErrorMax = MAX( stTimeSyncState.lApplyErrorMax, lLateness );
+  }
+  stTimeSyncState.lApplied++;
+
+  stRequest.dst.mode = ZB_APSDE_ADDRMODE_SHORT;
+  stRequest.dst.nwkAddr = ZbShortAddress( pstTimeSyncZigbee );
+  stRequest.dst.endpoint = cTimeSyncServerEndpoint;
+  stRequest.profileId = iTimeSyncProfileId;
+  stRequest.clusterId = (enum ZbZclClusterIdT)pstApply->iClusterId;
+  stRequest.srcEndpt = cTimeSyncEndpoint;
+  stRequest.txOptions = ZB_APSDE_DATAREQ_TXOPTIONS_SECURITY;
+  stRequest.payload = pstApply->aPayload;
+  stRequest.length = pstApply->cLength;
+  (void)ZbZclCommandReq( pstTimeSyncZigbee, &stRequest, NULL, NULL );
+
+  pstApply->bUsed = false;
+}
+
+/**
+ * @brief  TimeStatus attribute of the Time Server : Master or Synchronized.
+ * @param  None
+ * @retval None
+ */
+static void TimeSyncUpdateStatus( void )
+{
+  uint8_t   cStatus = 0;
+
+  if ( pstTimeSyncServer == NULL )
+  {
+    return;
+  }
+
+  if ( stTimeSyncState.bMaster != false )
+  {
+    cStatus = ZCL_TIME_STATUS_MASTER;
+  }
+  else if ( stTimeSyncState.bSynchronized != false )
+  {
+    cStatus = ZCL_TIME_STATUS_SYNCHRONIZED;
+  }
+  (void)ZbZclAttrIntegerWrite( pstTimeSyncServer, ZCL_TIME_ATTR_STATUS, cStatus );
+}
+
+/**
+ * @brief  Mesh time of a local time : offset of the last synchronization, extrapolated with the rate of the master clock.
+ * @param  dlLocalTime  us, local time
+ * @retval us, mesh time
+ */
+static uint64_t TimeSyncLocalToMesh( uint64_t dlLocalTime )
+{
+  int64_t   dlElapsed;
+
+  if ( stTimeSyncState.bMaster != false )
+  {
+    return dlLocalTime;
+  }
+
+  dlElapsed = (int64_t)( dlLocalTime - dlTimeSyncLocal );
+  return (uint64_t)( (int64_t)dlLocalTime + stTimeSyncState.dlOffset + ( ( dlElapsed * stTimeSyncState.lSkew ) / 1000000000 ) );
+}
+
+/**
+ * @brief  Local time of a mesh time (first order inverse of TimeSyncLocalToMesh).
+ * @param  dlMeshTime   us, mesh time
+ * @retval us, local time
+ */
+static uint64_t TimeSyncMeshToLocal( uint64_t dlMeshTime )
+{
+  int64_t   dlLocal;
+
+  if ( stTimeSyncState.bMaster != false )
+  {
+    return dlMeshTime;
+  }
+
+  dlLocal = (int64_t)dlMeshTime - stTimeSyncState.dlOffset;
+  return (uint64_t)( dlLocal - ( ( ( dlLocal - (int64_t)dlTimeSyncLocal ) * stTimeSyncState.lSkew ) / 1000000000 ) );
+}
+
+/**
+ * @brief  Write a uint64 (little endian).
+ */
+static void TimeSyncPut64( uint8_t * pData, uint64_t dlValue )
+{
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < 8u; iIndex++ )
+  {
+    pData[iIndex] = (uint8_t)( dlValue >> ( 8u * iIndex ) );
+  }
+}
+
+/**
+ * @brief  Read a uint64 (little endian).
+ */
+static uint64_t TimeSyncGet64( const uint8_t * pData )
+{
+  uint64_t  dlValue = 0;
+  uint16_t  iIndex;
+
+  for ( iIndex = 0; iIndex < 8u; iIndex++ )
+  {
+    dlValue |= ( (uint64_t)pData[iIndex] << ( 8u * iIndex ) );
+  }
+
+  return dlValue;
+}
+
+/**
+ * @brief  Time attribute read : Zigbee time (s since 2000) of the mesh time, 0xFFFFFFFF until the time is set.
+ * @param  pstCluster   Time Server
+ * @param  arg          Not used
+ * @retval Zigbee time
+ */
+static uint32_t TimeSyncServerGetTime( struct ZbZclClusterT * pstCluster, void * arg )
+{
+  UNUSED( pstCluster );
+  UNUSED( arg );
+
+  if ( lTimeSyncEpoch == TIMESYNC_EPOCH_NONE )
+  {
+    return ZCL_INVALID_UNSIGNED_32BIT;
+  }
+
+  return lTimeSyncEpoch + (uint32_t)( TimeSyncLocalToMesh( TIMER_IF_GetTimeUs() ) / 1000000u );
+}
+
+/**
+ * @brief  Time attribute write (the master time set by the gateway) : Zigbee time of the mesh time 0, shared with the
+ *         nodes by the synchronizations.
+ * @param  pstCluster   Time Server
+ * @param  lTime        Zigbee time (s since 2000)
+ * @param  arg          Not used
+ * @retval None
+ */
+static void TimeSyncServerSetTime( struct ZbZclClusterT * pstCluster, uint32_t lTime, void * arg )
+{
+  UNUSED( arg );
+
+  lTimeSyncEpoch = lTime - (uint32_t)( TimeSyncLocalToMesh( TIMER_IF_GetTimeUs() ) / 1000000u );
+  (void)ZbZclAttrIntegerWrite( pstCluster, ZCL_TIME_ATTR_LAST_SET_TIME, lTime );
+}
+
+#else /* (CFG_ZIGBEE_TIMESYNC_SUPPORTED != 0) */
+
+/**
+ * @brief  No time synchronization.
+ */
+void APP_ZIGBEE_TimeSyncInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId,
+                              uint8_t cServerEndpoint, APP_ZIGBEE_TimeSyncOutput_t pfOutput )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iProfileId );
+  UNUSED( cServerEndpoint );
+  UNUSED( pfOutput );
+}
+
+/**
+ * @brief  No time synchronization.
+ */
+void APP_ZIGBEE_TimeSyncStart( void )
+{
+}
+
+/**
+ * @brief  No time synchronization : the mesh time is not known.
+ */
+bool APP_ZIGBEE_TimeSyncGetTime( uint64_t * pdlMeshTime )
+{
+  *pdlMeshTime = 0u;
+
+  return false;
+}
+
+/**
+ * @brief  No time synchronization : no command applied at a mesh time.
+ */
+bool APP_ZIGBEE_TimeSyncSendAt( const struct ZbApsAddrT * pstDest, uint16_t iClusterId, uint8_t cCmdId,
+                                const uint8_t * pPayload, uint8_t cLength, uint32_t lDelay )
+{
+  UNUSED( pstDest );
+  UNUSED( iClusterId );
+  UNUSED( cCmdId );
+  UNUSED( pPayload );
+  UNUSED( cLength );
+  UNUSED( lDelay );
+
+  return false;
+}
+
+/**
+ * @brief  No time synchronization command.
+ */
+bool APP_ZIGBEE_TimeSyncSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  No time synchronization : no state.
+ */
+const APP_ZIGBEE_TimeSyncState_t * APP_ZIGBEE_TimeSyncGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_TIMESYNC_SUPPORTED != 0) */
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_timesync.h
+  * @author  MCD Application Team
+  * @brief   Interface of the mesh time synchronization (Time cluster, us time
+  *          base of the master) and of the commands applied at a mesh time.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_TIMESYNC_H
+#define APP_ZIGBEE_TIMESYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Manufacturer specific commands of the Time cluster (to the Server) */
+#define APP_ZIGBEE_TIMESYNC_CMD_SYNC_REQ      0x00u   /* t1 (us, requester), uint64 */
+#define APP_ZIGBEE_TIMESYNC_CMD_APPLY_AT      0x01u   /* Mesh time (us) uint64, cluster uint16, command uint8, payload */
+
+/* Manufacturer specific commands of the Time cluster (to the Client) */
+#define APP_ZIGBEE_TIMESYNC_CMD_SYNC_RSP      0x00u   /* t1, t2, t3 (us) uint64, Zigbee time of the mesh time 0 uint32 */
+
+/* Exported types ------------------------------------------------------------*/
+/* Output of a command at its mesh time (the stack then processes the command as if just received) */
+typedef void ( * APP_ZIGBEE_TimeSyncOutput_t )( uint16_t iClusterId, const struct ZbZclHeaderT * pstHeader,
+                                                const uint8_t * pPayload, uint16_t iLength );
+
+/* State of the time synchronization */
+typedef struct
+{
+  bool        bMaster;                /* Time base of the mesh */
+  bool        bSynchronized;          /* Offset to the master known */
+  uint16_t    iMaster;                /* Short address of the master */
+  int64_t     dlOffset;               /* us, mesh time - local time at the last synchronization */
+  int32_t     lSkew;                  /* ppb, rate of the master clock relative to the local clock */
+  uint32_t    lDelay;                 /* us, round trip (without the master processing) of the sample kept */
+  uint32_t    lSyncNb;                /* Synchronizations done */
+  uint32_t    lSyncFailed;            /* Synchronizations without any answer of the master */
+  uint32_t    lApplySent;             /* Commands sent to be applied at a mesh time */
+  uint32_t    lApplied;               /* Commands applied at their mesh time */
+  uint32_t    lApplyLate;             /* Commands received after their mesh time (applied at once) */
+  uint32_t    lApplyDropped;          /* Commands dropped (not synchronized, no slot left, too far ahead) */
+  uint32_t    lApplyErrorMax;         /* us, worst lateness of the output of a command applied on time */
+} APP_ZIGBEE_TimeSyncState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_TimeSyncInit           ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iProfileId,
+                                              uint8_t cServerEndpoint, APP_ZIGBEE_TimeSyncOutput_t pfOutput );
+void      APP_ZIGBEE_TimeSyncStart          ( void );
+bool      APP_ZIGBEE_TimeSyncGetTime        ( uint64_t * pdlMeshTime );
+bool      APP_ZIGBEE_TimeSyncSendAt         ( const struct ZbApsAddrT * pstDest, uint16_t iClusterId, uint8_t cCmdId,
+                                              const uint8_t * pPayload, uint8_t cLength, uint32_t lDelay );
+bool      APP_ZIGBEE_TimeSyncSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_TimeSyncState_t * APP_ZIGBEE_TimeSyncGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_TIMESYNC_H */
@@ -0,0 +1,275 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_touchlink.c
+  * @author  MCD Application Team
+  * @brief   Touchlink initiator for the installer workflows : one request
+  *          commissions the target close to the device. The channels where
+  *          the targets have been found are learned, so that a session scans
+  *          only them and the primary channels, the secondary channels being
+  *          scanned only after a session without target. A request received
+  *          during a session is merged into it (no new scan).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_endpoint.h"
+#include "app_zigbee_touchlink.h"
+
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.bdb.h"
+#include "zigbee.startup.h"
+#include "zcl/zcl.touchlink.h"
+
+#if (CFG_ZIGBEE_TOUCHLINK_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define TOUCHLINK_ZB_INFO               ( ZCL_TL_ZBINFO_TYPE_ROUTER | ZCL_TL_ZBINFO_RX_ON_IDLE )
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZigBeeT             * pstTlZigbee;
+static uint8_t                      cTlEndpoint;
+static uint16_t                     iTlDeviceId;
+static bool                         bTlOngoing;
+static bool                         bTlWideScan;
+static uint32_t                     lTlStartTick;
+static struct ZbStartupT            stTlConfig;
+static APP_ZIGBEE_TouchlinkStats_t  stTlStats;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     TouchlinkStartupCallback ( enum ZbStatusCodeT eStatus, void * arg );
+static void     TouchlinkCmdStart        ( void );
+static void     TouchlinkPrintStats      ( void );
+
+/* Serial commands of the Touchlink initiator */
+static const SerialCmd_t            astTlSerialCmds[] =
+{
+  { "TLSTART", TouchlinkCmdStart, NULL },
+  { "TLSTATS", TouchlinkPrintStats, NULL },
+};
+
+static SerialCmdTable_t             stTlSerialCmdTable =
+{
+  astTlSerialCmds, ( sizeof( astTlSerialCmds ) / sizeof( astTlSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the Touchlink initiator : short identify of the target and RSSI threshold (target close to the
+ *         device).
+ * @param  pstZigbee  Zigbee stack instance
+ * @param  cEndpoint  Endpoint of the Touchlink cluster, also used for the bindings of the target
+ * @param  iDeviceId  Device Identifier advertised to the targets
+ * @retval None
+ */
+void APP_ZIGBEE_TouchlinkInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iDeviceId )
+{
+  uint16_t  iIdentifyTime = CFG_ZIGBEE_TOUCHLINK_IDENTIFY_TIME;
+  int8_t    cRssiMin = CFG_ZIGBEE_TOUCHLINK_RSSI_MIN;
+
+  pstTlZigbee = pstZigbee;
+  cTlEndpoint = cEndpoint;
+  iTlDeviceId = iDeviceId;
+  bTlOngoing = false;
+  bTlWideScan = false;
+  memset( &stTlStats, 0, sizeof( stTlStats ) );
+
+  if ( ( ZbBdbSet( pstZigbee, ZB_BDB_TLIdentifyTime, &iIdentifyTime, sizeof( iIdentifyTime ) ) != ZB_STATUS_SUCCESS ) ||
+       ( ZbBdbSet( pstZigbee, ZB_BDB_TLRssiMin, &cRssiMin, sizeof( cRssiMin ) ) != ZB_STATUS_SUCCESS ) )
+  {
+    LOG_ERROR_APP( "Error, Touchlink configuration failed." );
+  }
+
+  Serial_CMD_Interpreter_RegisterTable( &stTlSerialCmdTable );
+}
+
+/**
+ * @brief  Request a Touchlink commissioning of the target close to the device. When a session is already ongoing, the
+ *         request is merged into it.
+ * @param  None
+ * @retval ZB_STATUS_SUCCESS if a session is started or ongoing, else the error.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_TouchlinkStart( void )
+{
+  enum ZbStatusCodeT  eStatus;
+
+  stTlStats.lRequests++;
+  if ( bTlOngoing != false )
+  {
+    stTlStats.lMerged++;
+    return ZB_STATUS_SUCCESS;
+  }
+
+  /* The initiator brings the target in its network : not during the network Startup */
+  if ( ( pstTlZigbee == NULL ) || ( APP_ZIGBEE_IsAppliJoinNetwork() == false ) )
+  {
+    return ZB_NWK_STATUS_INVALID_REQUEST;
+  }
+
+  /* Same keys & TX-Power than the network Startup, then the Touchlink initiator */
+  APP_ZIGBEE_GetStartupConfig( &stTlConfig );
+  stTlConfig.bdbCommissioningMode |= BDB_COMMISSION_MODE_TOUCHLINK;
+  stTlConfig.touchlink.tl_endpoint = cTlEndpoint;
+  stTlConfig.touchlink.bind_endpoint = cTlEndpoint;
+  stTlConfig.touchlink.deviceId = iTlDeviceId;
+  stTlConfig.touchlink.zb_info = TOUCHLINK_ZB_INFO;
+  stTlConfig.touchlink.flags = 0;
+
+  /* Primary channels and learned channels first, the secondary ones only after a session without target */
+  stTlConfig.channelList.count = 0;
+  stTlConfig.bdbPrimaryChannelSet = ( BDBC_TL_PRIMARY_CHANNEL_SET | stTlStats.lLearnedChannelMask );
+  stTlConfig.bdbSecondaryChannelSet = ( ( bTlWideScan != false ) ? ( BDBC_TL_SECONDARY_CHANNEL_SET & ~stTlConfig.bdbPrimaryChannelSet ) : 0u );
+
+  eStatus = ZbStartup( pstTlZigbee, &stTlConfig, TouchlinkStartupCallback, NULL );
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, Touchlink start failed (0x%02X).", eStatus );
+    return eStatus;
+  }
+
+  bTlOngoing = true;
+  lTlStartTick = HAL_GetTick();
+  stTlStats.lSessions++;
+  if ( bTlWideScan != false )
+  {
+    stTlStats.lWideScans++;
+  }
+
+  LOG_INFO_APP( "Touchlink started (channels 0x%08X).", ( stTlConfig.bdbPrimaryChannelSet | stTlConfig.bdbSecondaryChannelSet ) );
+  return ZB_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Indicate if a Touchlink session is ongoing.
+ * @param  None
+ * @retval True if ongoing.
+ */
+bool APP_ZIGBEE_TouchlinkIsOngoing( void )
+{
+  return bTlOngoing;
+}
+
+/**
+ * @brief  Return the statistics of the Touchlink initiator.
+ * @param  None
+ * @retval Statistics.
+ */
+const APP_ZIGBEE_TouchlinkStats_t * APP_ZIGBEE_TouchlinkGetStats( void )
+{
+  return &stTlStats;
+}
+
+/**
+ * @brief  End of a Touchlink session : the channel of the target is learned, or the next session scans wider.
+ * @param  eStatus  Status of the session
+ * @param  arg      Not used
+ * @retval None
+ */
+static void TouchlinkStartupCallback( enum ZbStatusCodeT eStatus, void * arg )
+{
+  uint8_t   cChannel;
+
+  UNUSED( arg );
+
+  bTlOngoing = false;
+  stTlStats.lLastDuration = ( HAL_GetTick() - lTlStartTick );
+
+  if ( eStatus == ZB_STATUS_SUCCESS )
+  {
+    stTlStats.lSuccesses++;
+    bTlWideScan = false;
+    if ( APP_ZIGBEE_GetCurrentChannel( &cChannel ) != false )
+    {
+      stTlStats.lLearnedChannelMask |= ( 1UL << cChannel );
+    }
+    LOG_INFO_APP( "Touchlink succeeded in %d ms.", stTlStats.lLastDuration );
+  }
+  else
+  {
+    bTlWideScan = true;
+    LOG_INFO_APP( "Touchlink failed (0x%02X) after %d ms, next one on all the channels.", eStatus, stTlStats.lLastDuration );
+  }
+}
+
+/**
+ * @brief  TLSTART command : Touchlink commissioning of the target close to the device.
+ * @param  None
+ * @retval None
+ */
+static void TouchlinkCmdStart( void )
+{
+  enum ZbStatusCodeT  eStatus;
+
+  eStatus = APP_ZIGBEE_TouchlinkStart();
+  if ( eStatus != ZB_STATUS_SUCCESS )
+  {
+    LOG_INFO_APP( "Touchlink not started (0x%02X).", eStatus );
+  }
+}
+
+/**
+ * @brief  Print the statistics of the Touchlink initiator.
+ * @param  None
+ * @retval None
+ */
+static void TouchlinkPrintStats( void )
+{
+  LOG_INFO_APP( "Touchlink : %d requests, %d sessions (%d wide), %d merged, %d succeeded, last %d ms.", stTlStats.lRequests,
+                stTlStats.lSessions, stTlStats.lWideScans, stTlStats.lMerged, stTlStats.lSuccesses, stTlStats.lLastDuration );
+  LOG_INFO_APP( "  Learned channels 0x%08X%s", stTlStats.lLearnedChannelMask, ( ( bTlOngoing != false ) ? ", session ongoing." : "." ) );
+}
+
+#else /* (CFG_ZIGBEE_TOUCHLINK_SUPPORTED != 0) */
+
+/**
+ * @brief  Touchlink initiator not supported.
+ */
+void APP_ZIGBEE_TouchlinkInit( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iDeviceId )
+{
+  UNUSED( pstZigbee );
+  UNUSED( cEndpoint );
+  UNUSED( iDeviceId );
+}
+
+/**
+ * @brief  Touchlink initiator not supported.
+ */
+enum ZbStatusCodeT APP_ZIGBEE_TouchlinkStart( void )
+{
+  return ZB_NWK_STATUS_INVALID_REQUEST;
+}
+
+/**
+ * @brief  Touchlink initiator not supported : never ongoing.
+ */
+bool APP_ZIGBEE_TouchlinkIsOngoing( void )
+{
+  return false;
+}
+
+/**
+ * @brief  Touchlink initiator not supported : no statistics.
+ */
+const APP_ZIGBEE_TouchlinkStats_t * APP_ZIGBEE_TouchlinkGetStats( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_TOUCHLINK_SUPPORTED != 0) */
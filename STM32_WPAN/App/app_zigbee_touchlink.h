@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_touchlink.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Touchlink initiator (installer commissioning).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_TOUCHLINK_H
+#define APP_ZIGBEE_TOUCHLINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the Touchlink initiator */
+typedef struct
+{
+  uint32_t    lRequests;              /* Touchlink requests (commands or API) */
+  uint32_t    lSessions;              /* Touchlink sessions started (scans) */
+  uint32_t    lMerged;                /* Requests merged into the session already ongoing */
+  uint32_t    lSuccesses;             /* Sessions ended with a target commissioned */
+  uint32_t    lWideScans;             /* Sessions scanning also the secondary channels */
+  uint32_t    lLastDuration;          /* Duration of the last session (ms) */
+  uint32_t    lLearnedChannelMask;    /* Channels where targets have been found */
+} APP_ZIGBEE_TouchlinkStats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_TouchlinkInit          ( struct ZigBeeT * pstZigbee, uint8_t cEndpoint, uint16_t iDeviceId );
+enum ZbStatusCodeT APP_ZIGBEE_TouchlinkStart ( void );
+bool      APP_ZIGBEE_TouchlinkIsOngoing     ( void );
+
+const APP_ZIGBEE_TouchlinkStats_t * APP_ZIGBEE_TouchlinkGetStats ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_TOUCHLINK_H */
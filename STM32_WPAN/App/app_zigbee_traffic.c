@@ -0,0 +1,554 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_traffic.c
+  * @author  MCD Application Team
+  * @brief   OnOff traffic generator : bursts of Toggle sent periodically to an
+  *          unicast, group or broadcast destination, configured from the serial
+  *          link, with a report (success ratio, retries, latency) at the end.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_traffic.h"
+#include "app_zigbee_fanout.h"
+#include "app_zigbee_latency.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+#include "stm32_tiny_sscanf.h"
+#include "serial_cmd_interpreter.h"
+
+#include "zigbee.aps.h"
+#include "zcl/general/zcl.onoff.h"
+
+#if (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define TRAFFIC_DEFAULT_PERIOD          (1000u)     /* Toggle every seconds, as the previous automatic toggle */
+#define TRAFFIC_DEFAULT_BURST           (1u)
+
+/* Private variables ---------------------------------------------------------*/
+static struct ZbZclClusterT *       pstTrafficCluster;
+static APP_ZIGBEE_TrafficConfig_t   stTrafficConfig;
+static APP_ZIGBEE_TrafficReport_t   stTrafficReport;
+static struct ZbApsAddrT            astTrafficDest[CFG_ZIGBEE_FANOUT_DEST_MAX];
+static uint8_t                      acTrafficPayload[CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX];
+
+static bool                         bTrafficRunning, bTrafficStopping, bTrafficBurstOngoing, bTrafficRetriesValid;
+static uint32_t                     lTrafficStartTick;
+static struct ZbApsStatTableT       stTrafficApsStats;
+static UTIL_TIMER_Object_t          stTrafficTimer;
+
+/* Private functions prototypes-----------------------------------------------*/
+static void TrafficTask               ( void );
+static void TrafficTimerElapsed       ( void * arg );
+static void TrafficBurstCallback      ( const APP_ZIGBEE_FanoutResult_t * pstResult, void * arg );
+static void TrafficReport             ( void );
+static void TrafficPrintConfig        ( void );
+static void TrafficSerialCmd          ( const char * szText );
+static bool TrafficParseValue         ( const char * szText, uint32_t lMax, uint32_t * plValue );
+static enum ZclStatusCodeT TrafficToggleReq ( struct ZbZclClusterT * pstCluster, const struct ZbApsAddrT * pstDest,
+                                              void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg );
+
+/* Serial commands of the traffic generator */
+static const SerialCmd_t            astTrafficSerialCmds[] =
+{
+  { "TRAFFIC", TrafficPrintConfig, TrafficSerialCmd },
+};
+
+static SerialCmdTable_t             stTrafficSerialCmdTable =
+{
+  astTrafficSerialCmds, ( sizeof( astTrafficSerialCmds ) / sizeof( astTrafficSerialCmds[0] ) ), NULL
+};
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the traffic generator with its default configuration : a Toggle every second to the group.
+ * @param  pstCluster     OnOff Client cluster sending the Toggle
+ * @param  cEndpoint      Endpoint of the OnOff Servers
+ * @param  iGroupAddress  Group of the OnOff Servers
+ * @retval None
+ */
+void APP_ZIGBEE_TrafficInit( struct ZbZclClusterT * pstCluster, uint8_t cEndpoint, uint16_t iGroupAddress )
+{
+  pstTrafficCluster = pstCluster;
+
+  memset( &stTrafficConfig, 0, sizeof( stTrafficConfig ) );
+  stTrafficConfig.lPeriod = TRAFFIC_DEFAULT_PERIOD;
+  stTrafficConfig.iBurst = TRAFFIC_DEFAULT_BURST;
+  stTrafficConfig.eMode = APP_ZIGBEE_TRAFFIC_GROUP;
+  stTrafficConfig.iAddress = iGroupAddress;
+  stTrafficConfig.cEndpoint = cEndpoint;
+
+  UTIL_TIMER_Create( &stTrafficTimer, TRAFFIC_DEFAULT_PERIOD, UTIL_TIMER_PERIODIC, &TrafficTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TRAFFIC ), UTIL_SEQ_RFU, TrafficTask );
+  Serial_CMD_Interpreter_RegisterTable( &stTrafficSerialCmdTable );
+}
+
+/**
+ * @brief  Configuration of the traffic generator, can be modified when it is stopped.
+ * @param  None
+ * @retval Configuration
+ */
+APP_ZIGBEE_TrafficConfig_t * APP_ZIGBEE_TrafficGetConfig( void )
+{
+  return &stTrafficConfig;
+}
+
+/**
+ * @brief  Report of the current (or last) run.
+ * @param  None
+ * @retval Report
+ */
+const APP_ZIGBEE_TrafficReport_t * APP_ZIGBEE_TrafficGetReport( void )
+{
+  return &stTrafficReport;
+}
+
+/**
+ * @brief  Indicate if the traffic generator is running.
+ * @param  None
+ * @retval True if a run is ongoing.
+ */
+bool APP_ZIGBEE_TrafficIsRunning( void )
+{
+  return ( bTrafficRunning || bTrafficStopping );
+}
+
+/**
+ * @brief  Start a run with the current configuration. The latency statistics are cleared.
+ * @param  None
+ * @retval True if started, false if already running or the configuration is not valid.
+ */
+bool APP_ZIGBEE_TrafficStart( void )
+{
+  uint16_t  iIndex;
+
+  if ( ( APP_ZIGBEE_TrafficIsRunning() != false ) || ( pstTrafficCluster == NULL ) || ( stTrafficConfig.lPeriod == 0u ) ||
+       ( stTrafficConfig.iBurst == 0u ) || ( stTrafficConfig.iBurst > CFG_ZIGBEE_FANOUT_DEST_MAX ) ||
+       ( stTrafficConfig.cPayloadSize > CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX ) )
+  {
+    return false;
+  }
+
+  /* A burst is the same destination repeated : the fan-out paces it */
+  memset( astTrafficDest, 0, sizeof( astTrafficDest ) );
+  for ( iIndex = 0; iIndex < stTrafficConfig.iBurst; iIndex++ )
+  {
+    switch ( stTrafficConfig.eMode )
+    {
+      case APP_ZIGBEE_TRAFFIC_UNICAST:
+          astTrafficDest[iIndex].mode = ZB_APSDE_ADDRMODE_SHORT;
+          astTrafficDest[iIndex].nwkAddr = stTrafficConfig.iAddress;
+          astTrafficDest[iIndex].endpoint = stTrafficConfig.cEndpoint;
+          break;
+
+      case APP_ZIGBEE_TRAFFIC_GROUP:
+          astTrafficDest[iIndex].mode = ZB_APSDE_ADDRMODE_GROUP;
+          astTrafficDest[iIndex].nwkAddr = stTrafficConfig.iAddress;
+          astTrafficDest[iIndex].endpoint = stTrafficConfig.cEndpoint;
+          break;
+
+      case APP_ZIGBEE_TRAFFIC_BROADCAST:
+      default:
+          astTrafficDest[iIndex].mode = ZB_APSDE_ADDRMODE_SHORT;
+          astTrafficDest[iIndex].nwkAddr = ZB_NWK_ADDR_BCAST_RXON;
+          astTrafficDest[iIndex].endpoint = ZB_ENDPOINT_BCAST;
+          break;
+    }
+  }
+
+  for ( iIndex = 0; iIndex < stTrafficConfig.cPayloadSize; iIndex++ )
+  {
+    acTrafficPayload[iIndex] = (uint8_t)iIndex;
+  }
+
+  memset( &stTrafficReport, 0, sizeof( stTrafficReport ) );
+  APP_ZIGBEE_LatencyReset();
+
+  /* Retries are device-wide counters : keep their value at the start */
+  bTrafficRetriesValid = ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stTrafficApsStats, sizeof( stTrafficApsStats ) ) == ZB_STATUS_SUCCESS );
+
+  LOG_INFO_APP( "[TRAFFIC] Start : burst of %d Toggle every %d ms, %d bytes of payload, during %d s.", stTrafficConfig.iBurst,
+                stTrafficConfig.lPeriod, stTrafficConfig.cPayloadSize, stTrafficConfig.lDuration );
+
+  lTrafficStartTick = HAL_GetTick();
+  bTrafficRunning = true;
+  bTrafficBurstOngoing = false;
+
+  /* First burst now, the next ones on the Timer */
+  UTIL_TIMER_StartWithPeriod( &stTrafficTimer, stTrafficConfig.lPeriod );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TRAFFIC ), TASK_PRIO_ZIGBEE_TRAFFIC );
+
+  return true;
+}
+
+/**
+ * @brief  Stop the run. The report is printed once the ongoing burst has confirmed.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_TrafficStop( void )
+{
+  if ( bTrafficRunning == false )
+  {
+    return;
+  }
+
+  UTIL_TIMER_Stop( &stTrafficTimer );
+  bTrafficRunning = false;
+
+  if ( bTrafficBurstOngoing != false )
+  {
+    bTrafficStopping = true;
+  }
+  else
+  {
+    TrafficReport();
+  }
+}
+
+/**
+ * @brief  Traffic Task : send the next burst, or stop at the end of the duration.
+ * @param  None
+ * @retval None
+ */
+static void TrafficTask( void )
+{
+  if ( bTrafficRunning == false )
+  {
+    return;
+  }
+
+  if ( ( stTrafficConfig.lDuration != 0u ) && ( ( HAL_GetTick() - lTrafficStartTick ) >= ( stTrafficConfig.lDuration * 1000u ) ) )
+  {
+    APP_ZIGBEE_TrafficStop();
+    return;
+  }
+
+  /* One burst at a time : a burst not confirmed within the period delays the next one */
+  if ( ( bTrafficBurstOngoing != false ) ||
+       ( APP_ZIGBEE_FanoutStart( pstTrafficCluster, TrafficToggleReq, astTrafficDest, stTrafficConfig.iBurst, TrafficBurstCallback, NULL ) == false ) )
+  {
+    stTrafficReport.lBurstsSkipped++;
+    return;
+  }
+
+  bTrafficBurstOngoing = true;
+  stTrafficReport.lBursts++;
+  stTrafficReport.lRequests += stTrafficConfig.iBurst;
+}
+
+/**
+ * @brief  Callback triggered when the period between two bursts expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void TrafficTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TRAFFIC ), TASK_PRIO_ZIGBEE_TRAFFIC );
+}
+
+/**
+ * @brief  End of a burst
+ * @param  pstResult  Aggregate result of the burst
+ * @param  arg        Not used
+ * @retval None
+ */
+static void TrafficBurstCallback( const APP_ZIGBEE_FanoutResult_t * pstResult, void * arg )
+{
+  UNUSED( arg );
+
+  bTrafficBurstOngoing = false;
+  stTrafficReport.lSuccess += pstResult->iSuccess;
+  stTrafficReport.lFailed += pstResult->iFailed;
+  stTrafficReport.lRefused += pstResult->iRefused;
+
+  if ( bTrafficStopping != false )
+  {
+    bTrafficStopping = false;
+    TrafficReport();
+  }
+}
+
+/**
+ * @brief  Request of one Toggle, with the padding of the configuration after the command.
+ * @param  pstCluster   OnOff Client cluster
+ * @param  pstDest      Destination
+ * @param  callback     Confirmation callback
+ * @param  arg          Argument of the callback
+ * @retval ZCL status of the request.
+ */
+static enum ZclStatusCodeT TrafficToggleReq( struct ZbZclClusterT * pstCluster, const struct ZbApsAddrT * pstDest,
+                                             void (*callback)(struct ZbZclCommandRspT * pstRsp, void * arg), void * arg )
+{
+  struct ZbZclClusterCommandReqT  stRequest;
+
+  if ( stTrafficConfig.cPayloadSize == 0u )
+  {
+    return ZbZclOnOffClientToggleReq( pstCluster, pstDest, callback, arg );
+  }
+
+  /* Toggle has no payload : the OnOff Server ignores the padding */
+  memset( &stRequest, 0, sizeof( stRequest ) );
+  stRequest.dst = *pstDest;
+  stRequest.cmdId = ZCL_ONOFF_COMMAND_TOGGLE;
+  stRequest.noDefaultResp = ZCL_NO_DEFAULT_RESPONSE_FALSE;
+  stRequest.payload = acTrafficPayload;
+  stRequest.length = stTrafficConfig.cPayloadSize;
+
+  return ZbZclClusterCommandReq( pstCluster, &stRequest, 0, callback, arg );
+}
+
+/**
+ * @brief  Print the report of the run : success ratio, retries and latency statistics.
+ * @param  None
+ * @retval None
+ */
+static void TrafficReport( void )
+{
+  struct ZbApsStatTableT    stApsStats;
+#if (CFG_LOG_SUPPORTED != 0)
+  uint32_t                  lDone;
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  stTrafficReport.lRunTime = ( HAL_GetTick() - lTrafficStartTick );
+  if ( ( bTrafficRetriesValid != false ) &&
+       ( ZbApsGet( stZigbeeAppInfo.pstZigbee, ZB_APS_IB_ID_STAT_TABLE, &stApsStats, sizeof( stApsStats ) ) == ZB_STATUS_SUCCESS ) )
+  {
+    stTrafficReport.lApsRetries = (uint16_t)( stApsStats.aps_tx_ucast_retry - stTrafficApsStats.aps_tx_ucast_retry );
+    stTrafficReport.lMacRetries = (uint16_t)( stApsStats.mac_tx_ucast_retry - stTrafficApsStats.mac_tx_ucast_retry );
+  }
+
+#if (CFG_LOG_SUPPORTED != 0)
+  lDone = ( stTrafficReport.lSuccess + stTrafficReport.lFailed + stTrafficReport.lRefused );
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+  LOG_INFO_APP( "[TRAFFIC] End after %d ms : %d bursts sent, %d skipped (previous one ongoing).", stTrafficReport.lRunTime,
+                stTrafficReport.lBursts, stTrafficReport.lBurstsSkipped );
+  LOG_INFO_APP( "[TRAFFIC] %d Toggle : %d confirmed (%d %%), %d failed, %d refused.", stTrafficReport.lRequests,
+                stTrafficReport.lSuccess, ( lDone != 0u ) ? ( ( stTrafficReport.lSuccess * 100u ) / lDone ) : 0u,
+                stTrafficReport.lFailed, stTrafficReport.lRefused );
+  if ( bTrafficRetriesValid != false )
+  {
+    LOG_INFO_APP( "[TRAFFIC] Retries (whole device) : %d APS, %d MAC.", stTrafficReport.lApsRetries, stTrafficReport.lMacRetries );
+  }
+  else
+  {
+    LOG_INFO_APP( "[TRAFFIC] Retries not available." );
+  }
+
+  APP_ZIGBEE_LatencyPrintStats();
+}
+
+/**
+ * @brief  Print the configuration and the state of the generator.
+ * @param  None
+ * @retval None
+ */
+static void TrafficPrintConfig( void )
+{
+#if (CFG_LOG_SUPPORTED != 0)
+  static const char * const aszMode[] = { "Unicast", "Group", "Broadcast" };
+#endif /* (CFG_LOG_SUPPORTED != 0) */
+
+  LOG_INFO_APP( "[TRAFFIC] %s : %s 0x%04X/%d, burst of %d every %d ms, %d bytes of payload, during %d s.",
+                ( APP_ZIGBEE_TrafficIsRunning() != false ) ? "Running" : "Stopped", aszMode[stTrafficConfig.eMode],
+                stTrafficConfig.iAddress, stTrafficConfig.cEndpoint, stTrafficConfig.iBurst, stTrafficConfig.lPeriod,
+                stTrafficConfig.cPayloadSize, stTrafficConfig.lDuration );
+}
+
+/**
+ * @brief  Parse a decimal (or 0x hexadecimal) value.
+ * @param  szText   Text of the value
+ * @param  lMax     Highest value allowed
+ * @param  plValue  Value parsed
+ * @retval True if the text is a valid value.
+ */
+static bool TrafficParseValue( const char * szText, uint32_t lMax, uint32_t * plValue )
+{
+  char  * pEnd;
+
+  *plValue = strtoul( szText, &pEnd, 0 );
+
+  return ( ( pEnd != szText ) && ( *pEnd == '\0' ) && ( *plValue <= lMax ) );
+}
+
+/**
+ * @brief  Traffic generator serial commands (TRAFFIC alone prints the configuration) :
+ *         TRAFFIC START, TRAFFIC STOP, TRAFFIC PERIOD <ms>, TRAFFIC BURST <n>, TRAFFIC SIZE <bytes>,
+ *         TRAFFIC DURATION <s>, TRAFFIC UCAST <addr> <endpoint>, TRAFFIC GROUP <group>, TRAFFIC BCAST.
+ * @param  szText  Arguments of the TRAFFIC command
+ * @retval None
+ */
+static void TrafficSerialCmd( const char * szText )
+{
+  uint32_t    lValue;
+  int         iAddress, iEndpoint, iLength = 0;
+  bool        bValid = true;
+
+  if ( strcmp( szText, "START" ) == 0 )
+  {
+    if ( APP_ZIGBEE_IsAppliJoinNetwork() == false )
+    {
+      LOG_ERROR_APP( "[TRAFFIC] Not on a Network." );
+    }
+    else if ( APP_ZIGBEE_TrafficStart() == false )
+    {
+      LOG_ERROR_APP( "[TRAFFIC] Cannot start (already running or invalid configuration)." );
+    }
+    return;
+  }
+
+  if ( strcmp( szText, "STOP" ) == 0 )
+  {
+    APP_ZIGBEE_TrafficStop();
+    return;
+  }
+
+  if ( APP_ZIGBEE_TrafficIsRunning() != false )
+  {
+    LOG_ERROR_APP( "[TRAFFIC] Configuration cannot be modified while running." );
+    return;
+  }
+
+  if ( strncmp( szText, "PERIOD ", 7u ) == 0 )
+  {
+    bValid = ( TrafficParseValue( &szText[7], UINT32_MAX, &lValue ) && ( lValue != 0u ) );
+    if ( bValid != false )
+    {
+      stTrafficConfig.lPeriod = lValue;
+    }
+  }
+  else if ( strncmp( szText, "BURST ", 6u ) == 0 )
+  {
+    bValid = ( TrafficParseValue( &szText[6], CFG_ZIGBEE_FANOUT_DEST_MAX, &lValue ) && ( lValue != 0u ) );
+    if ( bValid != false )
+    {
+      stTrafficConfig.iBurst = (uint16_t)lValue;
+    }
+  }
+  else if ( strncmp( szText, "SIZE ", 5u ) == 0 )
+  {
+    bValid = TrafficParseValue( &szText[5], CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX, &lValue );
+    if ( bValid != false )
+    {
+      stTrafficConfig.cPayloadSize = (uint8_t)lValue;
+    }
+  }
+  else if ( strncmp( szText, "DURATION ", 9u ) == 0 )
+  {
+    bValid = TrafficParseValue( &szText[9], ( UINT32_MAX / 1000u ), &lValue );
+    if ( bValid != false )
+    {
+      stTrafficConfig.lDuration = lValue;
+    }
+  }
+  else if ( strncmp( szText, "UCAST ", 6u ) == 0 )
+  {
+    bValid = ( ( tiny_sscanf( &szText[6], "%i %i%n", &iAddress, &iEndpoint, &iLength ) == 2 ) &&
+               ( szText[6 + iLength] == '\0' ) && ( iAddress >= 0 ) && ( iAddress < ZB_NWK_ADDR_BCAST_MIN ) &&
+               ( iEndpoint >= 0 ) && ( iEndpoint <= UINT8_MAX ) );
+    if ( bValid != false )
+    {
+      stTrafficConfig.eMode = APP_ZIGBEE_TRAFFIC_UNICAST;
+      stTrafficConfig.iAddress = (uint16_t)iAddress;
+      stTrafficConfig.cEndpoint = (uint8_t)iEndpoint;
+    }
+  }
+  else if ( strncmp( szText, "GROUP ", 6u ) == 0 )
+  {
+    bValid = TrafficParseValue( &szText[6], UINT16_MAX, &lValue );
+    if ( bValid != false )
+    {
+      stTrafficConfig.eMode = APP_ZIGBEE_TRAFFIC_GROUP;
+      stTrafficConfig.iAddress = (uint16_t)lValue;
+    }
+  }
+  else if ( strcmp( szText, "BCAST" ) == 0 )
+  {
+    stTrafficConfig.eMode = APP_ZIGBEE_TRAFFIC_BROADCAST;
+  }
+  else
+  {
+    bValid = false;
+  }
+
+  if ( bValid == false )
+  {
+    LOG_ERROR_APP( "Invalid TRAFFIC command : TRAFFIC %s", szText );
+  }
+  else
+  {
+    TrafficPrintConfig();
+  }
+}
+
+#else /* (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0) */
+
+/**
+ * @brief  Traffic generator not supported.
+ */
+void APP_ZIGBEE_TrafficInit( struct ZbZclClusterT * pstCluster, uint8_t cEndpoint, uint16_t iGroupAddress )
+{
+  UNUSED( pstCluster );
+  UNUSED( cEndpoint );
+  UNUSED( iGroupAddress );
+}
+
+/**
+ * @brief  Traffic generator not supported : nothing started.
+ */
+bool APP_ZIGBEE_TrafficStart( void )
+{
+  return false;
+}
+
+/**
+ * @brief  Traffic generator not supported.
+ */
+void APP_ZIGBEE_TrafficStop( void )
+{
+}
+
+/**
+ * @brief  Traffic generator not supported : never running.
+ */
+bool APP_ZIGBEE_TrafficIsRunning( void )
+{
+  return false;
+}
+
+/**
+ * @brief  Traffic generator not supported : no configuration.
+ */
+APP_ZIGBEE_TrafficConfig_t * APP_ZIGBEE_TrafficGetConfig( void )
+{
+  return NULL;
+}
+
+/**
+ * @brief  Traffic generator not supported : no report.
+ */
+const APP_ZIGBEE_TrafficReport_t * APP_ZIGBEE_TrafficGetReport( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_TRAFFIC_SUPPORTED != 0) */
@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_traffic.h
+  * @author  MCD Application Team
+  * @brief   Interface of the OnOff traffic generator (on-target load benchmark).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_TRAFFIC_H
+#define APP_ZIGBEE_TRAFFIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+#include "zcl/zcl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Destination of the generated traffic */
+typedef enum
+{
+  APP_ZIGBEE_TRAFFIC_UNICAST = 0,
+  APP_ZIGBEE_TRAFFIC_GROUP,
+  APP_ZIGBEE_TRAFFIC_BROADCAST,
+} APP_ZIGBEE_TrafficMode_t;
+
+/* Configuration of the generator */
+typedef struct
+{
+  uint32_t                  lPeriod;          /* Time (in ms) between two bursts */
+  uint16_t                  iBurst;           /* Number of Toggle per burst (at most CFG_ZIGBEE_FANOUT_DEST_MAX) */
+  APP_ZIGBEE_TrafficMode_t  eMode;            /* Unicast, Group or Broadcast */
+  uint16_t                  iAddress;         /* Short address (unicast) or Group address */
+  uint8_t                   cEndpoint;        /* Destination endpoint (unicast) */
+  uint8_t                   cPayloadSize;     /* Padding added after the Toggle command (at most CFG_ZIGBEE_TRAFFIC_PAYLOAD_MAX) */
+  uint32_t                  lDuration;        /* Duration of the run (in s), 0 until stopped */
+} APP_ZIGBEE_TrafficConfig_t;
+
+/* Report of a run */
+typedef struct
+{
+  uint32_t                  lBursts;          /* Number of bursts sent */
+  uint32_t                  lBurstsSkipped;   /* Number of bursts skipped, previous one still ongoing */
+  uint32_t                  lRequests;        /* Number of Toggle requested */
+  uint32_t                  lSuccess;         /* Number of Toggle confirmed */
+  uint32_t                  lFailed;          /* Number of Toggle with an APS or ZCL error */
+  uint32_t                  lRefused;         /* Number of Toggle refused by the stack */
+  uint32_t                  lApsRetries;      /* APS unicast retries during the run (whole device) */
+  uint32_t                  lMacRetries;      /* MAC unicast retries during the run (whole device) */
+  uint32_t                  lRunTime;         /* Time (in ms) from the start to the last confirmation */
+} APP_ZIGBEE_TrafficReport_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_TrafficInit            ( struct ZbZclClusterT * pstCluster, uint8_t cEndpoint, uint16_t iGroupAddress );
+bool      APP_ZIGBEE_TrafficStart           ( void );
+void      APP_ZIGBEE_TrafficStop            ( void );
+bool      APP_ZIGBEE_TrafficIsRunning       ( void );
+
+APP_ZIGBEE_TrafficConfig_t * APP_ZIGBEE_TrafficGetConfig ( void );
+const APP_ZIGBEE_TrafficReport_t * APP_ZIGBEE_TrafficGetReport ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_TRAFFIC_H */
@@ -0,0 +1,382 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_txpower.c
+  * @author  MCD Application Team
+  * @brief   Adaptive TX power manager : the Link Power Delta negotiation of the
+  *          stack adapts the power toward each neighbor, and the power of the
+  *          interface follows the weakest link of the Neighbor table (lowered
+  *          while all the links are strong, raised on a weak link or a
+  *          transmit failure).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_txpower.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#include "zigbee.nwk.h"
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+#include "ll_sys_if.h"
+#include "mac_sys_if.h"
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED != 0)
+
+/* Private defines -----------------------------------------------------------*/
+#define TXPOWER_ENTRIES_PER_TASK        (8u)        /* Neighbor entries read per Task run, to not hold the Sequencer */
+#define TXPOWER_TABLE_MAX_POWER         (0u)        /* TX power tables of power_table.c */
+#define TXPOWER_TABLE_LOW_POWER         (1u)
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_TxPowerState_t    stTxPowerState;
+static APP_ZIGBEE_TxPowerState_t    stTxPowerSample;
+static bool                         bTxPowerSampling;
+static uint16_t                     iTxPowerIndex;
+static UTIL_TIMER_Object_t          stTxPowerTimer;
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+static uint32_t                     lTxPowerTableStart;     /* Time of the last account of the table in use */
+static uint32_t                     lTxPowerTableTxStart;   /* Transmissions at the last account */
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     TxPowerTask             ( void );
+static void     TxPowerTimerElapsed     ( void * arg );
+static bool     TxPowerReadNeighbor     ( uint16_t iIndex );
+static void     TxPowerSampleEnd        ( void );
+static void     TxPowerApply            ( int8_t cPower );
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+static void     TxPowerSelectTable      ( uint8_t cTable );
+static void     TxPowerTableAccount     ( void );
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Initialize the TX power manager : Task and Timer of the samples.
+ * @param  cPowerMax  TX power set at startup, never exceeded (dBm)
+ * @retval None
+ */
+void APP_ZIGBEE_TxPowerInit( int8_t cPowerMax )
+{
+  stTxPowerState.cPowerMax = cPowerMax;
+  stTxPowerState.cPower = cPowerMax;
+  stTxPowerState.cTable = CFG_RF_TX_POWER_TABLE_ID;
+
+  UTIL_TIMER_Create( &stTxPowerTimer, CFG_ZIGBEE_TX_POWER_PERIOD, UTIL_TIMER_PERIODIC, &TxPowerTimerElapsed, NULL );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TX_POWER ), UTIL_SEQ_RFU, TxPowerTask );
+}
+
+/**
+ * @brief  Start the manager (once on the Network) : Link Power Delta negotiation with the neighbors, then the
+ *         samples of the Neighbor table from the maximum TX power.
+ * @param  None
+ * @retval None
+ */
+void APP_ZIGBEE_TxPowerStart( void )
+{
+  uint8_t   cEnable = 1u;
+  uint16_t  iPeriod = CFG_ZIGBEE_TX_POWER_DELTA_PERIOD;
+
+  if ( ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_TxPowerMgmtSupported, &cEnable, sizeof( cEnable ) ) != ZB_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, TX power management not supported by the stack." );
+  }
+  (void)ZbNwkSet( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_LinkPowerDeltaPeriod, &iPeriod, sizeof( iPeriod ) );
+
+  TxPowerApply( stTxPowerState.cPowerMax );
+  UTIL_TIMER_Start( &stTxPowerTimer );
+}
+
+/**
+ * @brief  State of the TX power manager.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_TxPowerState_t * APP_ZIGBEE_TxPowerGetState( void )
+{
+  return &stTxPowerState;
+}
+
+/**
+ * @brief  TX power serial command : TXPOWER (state).
+ * @param  szCommand  Command received
+ * @retval True if the command is a TX power command.
+ */
+bool APP_ZIGBEE_TxPowerSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "TXPOWER" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "TX power : %d dBm (max %d dBm), %d links (LQI min %d, TX failures max %d), %d up / %d down in %d samples.",
+                stTxPowerState.cPower, stTxPowerState.cPowerMax, stTxPowerState.iLinkNb, stTxPowerState.cLqiMin,
+                stTxPowerState.cTxFailureMax, stTxPowerState.lIncreases, stTxPowerState.lDecreases, stTxPowerState.lSampleNb );
+
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+  TxPowerTableAccount();
+  LOG_INFO_APP( "TX power table : %s, max power %u s (%u TX), low power %u s (%u TX), %u switches.",
+                ( stTxPowerState.cTable == TXPOWER_TABLE_LOW_POWER ) ? "low power" : "max power",
+                ( stTxPowerState.alTableTime[TXPOWER_TABLE_MAX_POWER] / 1000u ), stTxPowerState.alTableTx[TXPOWER_TABLE_MAX_POWER],
+                ( stTxPowerState.alTableTime[TXPOWER_TABLE_LOW_POWER] / 1000u ), stTxPowerState.alTableTx[TXPOWER_TABLE_LOW_POWER],
+                stTxPowerState.lTableSwitches );
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+  return true;
+}
+
+/**
+ * @brief  TX power Task : read the next entries of the Neighbor table, then close the sample.
+ * @param  None
+ * @retval None
+ */
+static void TxPowerTask( void )
+{
+  uint16_t  iRead;
+
+  if ( bTxPowerSampling == false )
+  {
+    stTxPowerSample.cLqiMin = UINT8_MAX;
+    stTxPowerSample.cTxFailureMax = 0;
+    stTxPowerSample.iLinkNb = 0;
+    bTxPowerSampling = true;
+    iTxPowerIndex = 0;
+  }
+
+  for ( iRead = 0; iRead < TXPOWER_ENTRIES_PER_TASK; iRead++ )
+  {
+    if ( TxPowerReadNeighbor( iTxPowerIndex ) == false )
+    {
+      TxPowerSampleEnd();
+      return;
+    }
+    iTxPowerIndex++;
+  }
+
+  /* Next entries on the next run */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TX_POWER ), TASK_PRIO_ZIGBEE_TX_POWER );
+}
+
+/**
+ * @brief  Callback triggered when the period between two samples expire
+ * @param  arg : Not used
+ * @retval None
+ */
+static void TxPowerTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  /* A sample still ongoing is not restarted */
+  if ( bTxPowerSampling == false )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_TX_POWER ), TASK_PRIO_ZIGBEE_TX_POWER );
+  }
+}
+
+/**
+ * @brief  Read one entry of the Neighbor table : only the links in use (Parent, Children, Routers) count.
+ * @param  iIndex   Index in the table
+ * @retval False at the end of the table.
+ */
+static bool TxPowerReadNeighbor( uint16_t iIndex )
+{
+  struct ZbNwkNeighborT   stNeighbor;
+
+  if ( ZbNwkGetIndex( stZigbeeAppInfo.pstZigbee, ZB_NWK_NIB_ID_NeighborTable, &stNeighbor, sizeof( stNeighbor ), iIndex ) != ZB_STATUS_SUCCESS )
+  {
+    return false;
+  }
+
+  if ( ( stNeighbor.nwkAddr == ZB_NWK_ADDR_UNDEFINED ) || ( stNeighbor.relationship > ZB_NWK_NEIGHBOR_REL_SIBLING ) )
+  {
+    return true;
+  }
+
+  stTxPowerSample.iLinkNb++;
+  if ( stNeighbor.lqi < stTxPowerSample.cLqiMin )
+  {
+    stTxPowerSample.cLqiMin = stNeighbor.lqi;
+  }
+  if ( stNeighbor.txFailure > stTxPowerSample.cTxFailureMax )
+  {
+    stTxPowerSample.cTxFailureMax = stNeighbor.txFailure;
+  }
+
+  return true;
+}
+
+/**
+ * @brief  End of a sample : a weak link or a transmit failure raises the TX power of one step, strong links
+ *         only lower it of one step. Without link, the maximum TX power is used.
+ * @param  None
+ * @retval None
+ */
+static void TxPowerSampleEnd( void )
+{
+  int8_t    cPower = stTxPowerState.cPower;
+
+  bTxPowerSampling = false;
+  stTxPowerState.lSampleNb++;
+  stTxPowerState.iLinkNb = stTxPowerSample.iLinkNb;
+  stTxPowerState.cLqiMin = ( stTxPowerSample.iLinkNb != 0u ) ? stTxPowerSample.cLqiMin : 0u;
+  stTxPowerState.cTxFailureMax = stTxPowerSample.cTxFailureMax;
+
+  if ( stTxPowerSample.iLinkNb == 0u )
+  {
+    cPower = stTxPowerState.cPowerMax;
+  }
+  else if ( ( stTxPowerSample.cLqiMin < CFG_ZIGBEE_TX_POWER_LQI_LOW ) || ( stTxPowerSample.cTxFailureMax != 0u ) )
+  {
+    cPower = (int8_t)( cPower + CFG_ZIGBEE_TX_POWER_STEP );
+    if ( cPower > stTxPowerState.cPowerMax )
+    {
+      cPower = stTxPowerState.cPowerMax;
+    }
+  }
+  else if ( stTxPowerSample.cLqiMin > CFG_ZIGBEE_TX_POWER_LQI_HIGH )
+  {
+    cPower = (int8_t)( cPower - CFG_ZIGBEE_TX_POWER_STEP );
+    if ( cPower < CFG_ZIGBEE_TX_POWER_MIN )
+    {
+      cPower = CFG_ZIGBEE_TX_POWER_MIN;
+    }
+  }
+
+  if ( cPower > stTxPowerState.cPower )
+  {
+    stTxPowerState.lIncreases++;
+  }
+  else if ( cPower < stTxPowerState.cPower )
+  {
+    stTxPowerState.lDecreases++;
+  }
+  else
+  {
+    return;
+  }
+
+  TxPowerApply( cPower );
+}
+
+/**
+ * @brief  Set the TX power of the interface.
+ * @param  cPower   TX power (dBm)
+ * @retval None
+ */
+static void TxPowerApply( int8_t cPower )
+{
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+  /* The table is changed first : the TX power set next is taken from the new table */
+  TxPowerSelectTable( ( cPower <= CFG_ZIGBEE_TX_POWER_LOW_TABLE_MAX ) ? TXPOWER_TABLE_LOW_POWER : TXPOWER_TABLE_MAX_POWER );
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+  if ( APP_ZIGBEE_SetTxPower( (uint8_t)cPower ) == false )
+  {
+    LOG_ERROR_APP( "Switching to %d dB failed.", cPower );
+    return;
+  }
+
+  stTxPowerState.cPower = cPower;
+  LOG_DEBUG_APP( "TX power : %d dBm.", cPower );
+}
+
+#if (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0)
+/**
+ * @brief  Select the TX power table of the link layer (and its PA supply setting), if not already in use.
+ * @param  cTable   TX power table
+ * @retval None
+ */
+static void TxPowerSelectTable( uint8_t cTable )
+{
+  if ( cTable == stTxPowerState.cTable )
+  {
+    return;
+  }
+
+  if ( ll_sys_select_tx_power_table( cTable ) != 0u )
+  {
+    LOG_ERROR_APP( "Error, TX power table %d refused.", cTable );
+    return;
+  }
+
+  TxPowerTableAccount();
+  stTxPowerState.cTable = cTable;
+  stTxPowerState.lTableSwitches++;
+  LOG_DEBUG_APP( "TX power table : %s.", ( cTable == TXPOWER_TABLE_LOW_POWER ) ? "low power" : "max power" );
+}
+
+/**
+ * @brief  Add the time and the transmissions since the last account to the table in use.
+ * @param  None
+ * @retval None
+ */
+static void TxPowerTableAccount( void )
+{
+  uint32_t  lNow = UTIL_TIMER_GetCurrentTime();
+  uint32_t  lTxCount = 0;
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  MAC_SYS_Stats_t   stMacStats;
+
+  MacSys_GetStats( &stMacStats );
+  lTxCount = stMacStats.Total.TxCount;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+  stTxPowerState.alTableTime[stTxPowerState.cTable] += lNow - lTxPowerTableStart;
+  stTxPowerState.alTableTx[stTxPowerState.cTable] += lTxCount - lTxPowerTableTxStart;
+  lTxPowerTableStart = lNow;
+  lTxPowerTableTxStart = lTxCount;
+}
+#endif /* (CFG_ZIGBEE_TX_POWER_TABLE_SWITCH_SUPPORTED != 0) */
+
+#else /* (CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED != 0) */
+
+/**
+ * @brief  TX power manager not supported : fixed TX power.
+ */
+void APP_ZIGBEE_TxPowerInit( int8_t cPowerMax )
+{
+  UNUSED( cPowerMax );
+}
+
+/**
+ * @brief  TX power manager not supported : fixed TX power.
+ */
+void APP_ZIGBEE_TxPowerStart( void )
+{
+}
+
+/**
+ * @brief  TX power manager not supported : no command.
+ */
+bool APP_ZIGBEE_TxPowerSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  TX power manager not supported : no state.
+ */
+const APP_ZIGBEE_TxPowerState_t * APP_ZIGBEE_TxPowerGetState( void )
+{
+  return NULL;
+}
+
+#endif /* (CFG_ZIGBEE_TX_POWER_ADAPTIVE_SUPPORTED != 0) */
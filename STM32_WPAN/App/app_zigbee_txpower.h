@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_txpower.h
+  * @author  MCD Application Team
+  * @brief   Interface of the adaptive TX power manager.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_TXPOWER_H
+#define APP_ZIGBEE_TXPOWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* State of the TX power manager */
+typedef struct
+{
+  int8_t      cPower;                 /* TX power of the interface (dBm) */
+  int8_t      cPowerMax;              /* Maximum TX power (dBm) */
+  uint8_t     cLqiMin;                /* Lowest LQI of the links of the last sample */
+  uint8_t     cTxFailureMax;          /* Highest transmit failure count of the last sample */
+  uint16_t    iLinkNb;                /* Links (Parent, Children, Routers) of the last sample */
+  uint32_t    lSampleNb;              /* Samples done */
+  uint32_t    lIncreases;             /* Steps up of the TX power */
+  uint32_t    lDecreases;             /* Steps down of the TX power */
+  uint8_t     cTable;                 /* TX power table of the link layer (0 : max power, 1 : low power) */
+  uint32_t    lTableSwitches;         /* Changes of TX power table */
+  uint32_t    alTableTime[2];         /* Time spent with each table (ms) */
+  uint32_t    alTableTx[2];           /* Transmissions with each table (CFG_MAC_STATS_SUPPORTED) */
+} APP_ZIGBEE_TxPowerState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_TxPowerInit            ( int8_t cPowerMax );
+void      APP_ZIGBEE_TxPowerStart           ( void );
+bool      APP_ZIGBEE_TxPowerSerialCmdExecute ( const char * szCommand );
+
+const APP_ZIGBEE_TxPowerState_t * APP_ZIGBEE_TxPowerGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_TXPOWER_H */
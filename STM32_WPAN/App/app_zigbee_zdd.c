@@ -0,0 +1,820 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_zdd.c
+  * @author  MCD Application Team
+  * @brief   Zigbee Direct Device of the ZDD build : BLE host of the ZDD stack
+  *          (events routed to its port) and commissioning proxy of the phone.
+  *          The requests written in the tunnel characteristic are given to
+  *          the stack at most CFG_ZIGBEE_ZDD_WINDOW at a time, the next ones
+  *          waiting in a queue, so that the mesh is kept busy without
+  *          flooding the APS queue. A request is in flight until a frame is
+  *          tunnelled back to the phone or until its timeout : latency of the
+  *          requests per BLE session.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "log_module.h"
+#include "app_conf.h"
+#include "app_zigbee.h"
+#include "app_zigbee_zdd.h"
+
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+#if (CFG_ZIGBEE_ZDD_SUPPORTED != 0)
+#include "app_zigbee_endpoint.h"
+#include "zigbee.zd.h"
+#include "ble_plat.h"
+#include "ll_sys.h"
+#include "blestack.h"
+#include "ble_core.h"
+#include "auto/ble_raw_api.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define ZDD_LINK_NB                     (1u)
+#define ZDD_GATT_ATTRIBUTE_NB           (72u)     /* Commissioning, security and tunnel services, with GAP and GATT */
+#define ZDD_GATT_SERVICE_NB             (6u)
+#define ZDD_ATT_VALUE_SIZE              (1536u)   /* Values of all the characteristics */
+#define ZDD_ATT_MTU                     (247u)    /* A tunnel frame in one write */
+#define ZDD_PREP_WRITE_NB               BLE_PREP_WRITE_X_ATT( ZDD_CHAR_SZ_TUNNEL )
+#define ZDD_MBLOCK_NB                   BLE_MBLOCKS_CALC( ZDD_PREP_WRITE_NB, ZDD_ATT_MTU, ZDD_LINK_NB )
+#define ZDD_HOST_BUFFER_SIZE            BLE_TOTAL_BUFFER_SIZE( ZDD_LINK_NB, ZDD_MBLOCK_NB )
+#define ZDD_GATT_BUFFER_SIZE            BLE_TOTAL_BUFFER_SIZE_GATT( ZDD_GATT_ATTRIBUTE_NB, ZDD_GATT_SERVICE_NB, \
+                                                                    ZDD_ATT_VALUE_SIZE )
+
+#define ZDD_LL_DATA_LENGTH              (251u)    /* Bytes of a LL data PDU */
+#define ZDD_LL_DATA_TIME                (2120u)   /* us, LL data PDU of 251 bytes on the LE 1M PHY */
+#define ZDD_HANDLE_NONE                 (0xFFFFu)
+#define ZDD_UUID_SIZE                   (16u)
+#define ZDD_OFFSET_MASK                 (0x7FFFu) /* Bit 15 of the offset : more data of a long write */
+#define ZDD_INFLIGHT_NB                 ( CFG_ZIGBEE_ZDD_WINDOW + CFG_ZIGBEE_ZDD_QUEUE_NB )
+#define ZDD_DIVC( x, y )                ( ( (x) + (y) - 1u ) / (y) )
+#define ZDD_EVENT_WORD_NB               ZDD_DIVC( ( sizeof( aci_gatt_attribute_modified_event_rp0 ) + ZDD_CHAR_SZ_TUNNEL ), 4u )
+
+/* SVCCTL_EvtAckStatus_t of the port (svc_ctl.h) */
+#define ZDD_EVT_NOT_ACK                 (0u)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Write of the phone in the tunnel characteristic, waiting for the window */
+typedef struct
+{
+  uint16_t    iEvent;                           /* ACI_GATT_ATTRIBUTE_MODIFIED or ACI_GATT_WRITE_PERMIT_REQ */
+  uint16_t    iOffset;                          /* In the characteristic : 0 at the start of a request */
+  uint32_t    alEvent[ZDD_EVENT_WORD_NB];       /* Parameters of the event, as received */
+} ZddWrite_t;
+
+/* Port of the ZDD stack (no header) */
+extern bool     handle_new_zdd_connection           ( void );
+extern void     update_zdd_port_handle              ( uint16_t conn_handle );
+extern bool     check_zdd_connection_handle         ( uint16_t conn_handle );
+extern bool     handle_zdd_read_request             ( uint16_t attribute_handle );
+extern bool     processWriteForZdd                  ( aci_gatt_write_permit_req_event_rp0 * write_perm_req );
+extern uint8_t  handle_zdd_aci_gatt_atribute_modif  ( aci_gatt_attribute_modified_event_rp0 * attribute_modified,
+                                                      uint8_t ret );
+extern void     zdd_port_task                       ( void );
+extern void     initialize_zdd_ble_asynch_event_queue ( void );
+extern void     disconnect_zdd_port_zvd             ( void );
+
+/* Tunnel frames given back to the phone (wrapped by the linker) */
+extern bool     __real_zdd_port_send_tun_data       ( struct ZigBeeT * zb, uint8_t * bindata, uint8_t binlen );
+bool            __wrap_zdd_port_send_tun_data       ( struct ZigBeeT * zb, uint8_t * bindata, uint8_t binlen );
+
+/* Called by the ZDD stack */
+bool            zdd_port_ble_init                   ( void );
+tBleStatus      ZddSetDiscoverable                  ( void );
+
+/* Private variables ---------------------------------------------------------*/
+static APP_ZIGBEE_ZddState_t  stZddState;
+static struct ZigBeeT         * pstZddZigbee;
+static UTIL_TIMER_Object_t    stZddTimer;
+static bool                   bZddBleStarted;
+static uint16_t               iZddConnection = ZDD_HANDLE_NONE;
+static uint16_t               iZddTunnelHandle = ZDD_HANDLE_NONE;   /* Declaration of the tunnel characteristic */
+static bool                   bZddAdvertise;          /* Deferred to the task : advertising restarted */
+static bool                   bZddLinkSetup;          /* Deferred to the task : PHY and data length of a new link */
+
+/* Writes waiting for the window (FIFO) */
+static ZddWrite_t             astZddQueue[CFG_ZIGBEE_ZDD_QUEUE_NB];
+static uint16_t               iZddQueueRead;
+
+/* Start time of the requests in flight, oldest first (over the window only on a queue overflow) */
+static uint32_t               alZddInFlightTick[ZDD_INFLIGHT_NB];
+static uint16_t               iZddInFlightRead;
+
+/* Buffers of the host */
+static uint32_t               alZddHostBuffer[ZDD_DIVC( ZDD_HOST_BUFFER_SIZE, 4u )];
+static uint32_t               alZddGattBuffer[ZDD_DIVC( ZDD_GATT_BUFFER_SIZE, 4u )];
+
+/* Private functions prototypes-----------------------------------------------*/
+static bool     ZddBleInit              ( void );
+static bool     ZddCheck                ( tBleStatus eStatus, const char * szCommand );
+static void     ZddHostTask             ( void );
+static void     ZddTask                 ( void );
+static void     ZddTimerElapsed         ( void * arg );
+static void     ZddWriteQueue           ( uint16_t iEvent, uint16_t iOffset, const uint8_t * pData, uint16_t iSize );
+static void     ZddWriteRelease         ( void );
+static void     ZddWriteGive            ( const ZddWrite_t * pstWrite );
+static void     ZddInFlightExpire       ( void );
+static void     ZddSessionStart         ( void );
+static void     ZddStatsPrint           ( const char * szName, const APP_ZIGBEE_ZddStats_t * pstStats );
+static void     ZddConnected            ( uint16_t iConnection );
+static void     ZddDisconnected         ( const hci_disconnection_complete_event_rp0 * pstEvent );
+static void     ZddLeMetaEvent          ( uint8_t cSubEvent, const uint8_t * pData );
+static void     ZddVendorEvent          ( uint16_t iEvent, const uint8_t * pData );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Start of the Zigbee Direct : GATT services of the ZDD stack (ZDD Server cluster on its endpoint, tunnel
+ *         opened with the stack) and advertising. To call once the stack is allocated.
+ * @param  pstZigbee  Zigbee stack
+ * @retval None
+ */
+void APP_ZIGBEE_ZddInit( struct ZigBeeT * pstZigbee )
+{
+  struct zb_zdd_config_t  stConfig;
+
+  pstZddZigbee = pstZigbee;
+  stZddState.stTotal.lLatencyMin = UINT32_MAX;
+  UTIL_TIMER_Create( &stZddTimer, CFG_ZIGBEE_ZDD_REQ_TIMEOUT, UTIL_TIMER_ONESHOT, &ZddTimerElapsed, NULL );
+
+  /* Started by the stack (zdd_port_ble_init) or else here */
+  if ( ZddBleInit() == false )
+  {
+    return;
+  }
+
+  memset( &stConfig, 0, sizeof( stConfig ) );
+  APP_ZIGBEE_GetStartupConfig( &stConfig.startup );
+  stConfig.open_tunnel = true;
+  stConfig.zdd_server_endpt = CFG_ZIGBEE_ZDD_ENDPOINT;
+
+  if ( zb_zdd_init( pstZigbee, &stConfig ) == false )
+  {
+    LOG_ERROR_APP( "Error, ZDD : initialization failed." );
+    return;
+  }
+
+  if ( iZddTunnelHandle == ZDD_HANDLE_NONE )
+  {
+    LOG_WARNING_APP( "ZDD : tunnel characteristic not found, its writes are not windowed." );
+  }
+
+  LOG_INFO_APP( "ZDD : started (endpoint %d, window of %d requests).", CFG_ZIGBEE_ZDD_ENDPOINT, CFG_ZIGBEE_ZDD_WINDOW );
+}
+
+/**
+ * @brief  Characteristic added by the ZDD stack (post-processing of aci_gatt_add_char) : handle of the tunnel kept.
+ * @param  cStatus    Status of the command
+ * @param  cUuidType  Type of the UUID
+ * @param  pUuid      UUID of the characteristic (LSB first)
+ * @param  iHandle    Handle of its declaration
+ * @retval None
+ */
+void APP_ZIGBEE_ZddCharAdded( uint8_t cStatus, uint8_t cUuidType, const uint8_t * pUuid, uint16_t iHandle )
+{
+  uint8_t   cIndex;
+
+  if ( ( cStatus != BLE_STATUS_SUCCESS ) || ( cUuidType != UUID_TYPE_128 ) )
+  {
+    return;
+  }
+
+  /* tunnelling_UUID is MSB first */
+  for ( cIndex = 0; cIndex < ZDD_UUID_SIZE; cIndex++ )
+  {
+    if ( pUuid[cIndex] != tunnelling_UUID[ZDD_UUID_SIZE - 1u - cIndex] )
+    {
+      return;
+    }
+  }
+
+  iZddTunnelHandle = iHandle;
+}
+
+/**
+ * @brief  State of the Zigbee Direct.
+ * @param  None
+ * @retval State
+ */
+const APP_ZIGBEE_ZddState_t * APP_ZIGBEE_ZddGetState( void )
+{
+  return &stZddState;
+}
+
+/**
+ * @brief  Zigbee Direct serial command : ZDD (state and latency of the tunnelled requests).
+ * @param  szCommand  Command received
+ * @retval True if the command is a Zigbee Direct command.
+ */
+bool APP_ZIGBEE_ZddSerialCmdExecute( const char * szCommand )
+{
+  if ( strcmp( szCommand, "ZDD" ) != 0 )
+  {
+    return false;
+  }
+
+  LOG_INFO_APP( "ZDD : %s, %u sessions, %d requests in flight (window %d), %d writes waiting.",
+                ( stZddState.bConnected ? "connected" : "advertising" ), stZddState.lSessionNb,
+                stZddState.iInFlightNb, CFG_ZIGBEE_ZDD_WINDOW, stZddState.iQueueNb );
+  ZddStatsPrint( "session", &stZddState.stSession );
+  ZddStatsPrint( "total", &stZddState.stTotal );
+
+  return true;
+}
+
+/**
+ * @brief  Background process of the link layer : the host stack has to run.
+ * @param  None
+ * @retval None
+ */
+void HostStack_Process( void )
+{
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  Event or ACL data given by the host stack (from BleStack_Process).
+ * @param  data, length          HCI packet
+ * @param  ext_data, ext_length  End of a long packet (not used by our events)
+ * @retval BLE_STATUS_SUCCESS (packet consumed)
+ */
+uint8_t BLECB_Indication( const uint8_t * data, uint16_t length, const uint8_t * ext_data, uint16_t ext_length )
+{
+  UNUSED( ext_data );
+  UNUSED( ext_length );
+
+  if ( ( length < 3u ) || ( data[0] != HCI_EVENT_PKT_TYPE ) )
+  {
+    return BLE_STATUS_SUCCESS;
+  }
+
+  switch ( data[1] )
+  {
+    case HCI_DISCONNECTION_COMPLETE_EVT_CODE:
+        ZddDisconnected( (const hci_disconnection_complete_event_rp0 *)&data[3] );
+        break;
+
+    case HCI_LE_META_EVT_CODE:
+        ZddLeMetaEvent( data[3], &data[4] );
+        break;
+
+    case HCI_VENDOR_SPECIFIC_DEBUG_EVT_CODE:
+        ZddVendorEvent( (uint16_t)( data[3] | ( (uint16_t)data[4] << 8u ) ), &data[5] );
+        break;
+
+    default:
+        break;
+  }
+
+  return BLE_STATUS_SUCCESS;
+}
+
+/**
+ * @brief  Start of the BLE host for the ZDD stack (called by the stack at its initialization).
+ * @param  None
+ * @retval True on success.
+ */
+bool zdd_port_ble_init( void )
+{
+  return ZddBleInit();
+}
+
+/**
+ * @brief  Connectable advertising of the ZDD (called by the ZDD stack, that sets the advertising data).
+ * @param  None
+ * @retval Status of the command
+ */
+tBleStatus ZddSetDiscoverable( void )
+{
+  tBleStatus  eStatus;
+
+  eStatus = ACI_GAP_SET_DISCOVERABLE( ADV_IND, CFG_ZIGBEE_ZDD_ADV_INTERVAL_MIN, CFG_ZIGBEE_ZDD_ADV_INTERVAL_MAX,
+                                      GAP_PUBLIC_ADDR, HCI_ADV_FILTER_NO, 0u, NULL, 0u, NULL, 0u, 0u );
+  (void)ZddCheck( eStatus, "advertising" );
+
+  return eStatus;
+}
+
+/**
+ * @brief  Frame tunnelled back to the phone by the ZDD stack : the oldest request in flight is answered.
+ * @param  zb       Zigbee stack
+ * @param  bindata  Tunnel frame
+ * @param  binlen   Size of the frame
+ * @retval Result of the port.
+ */
+bool __wrap_zdd_port_send_tun_data( struct ZigBeeT * zb, uint8_t * bindata, uint8_t binlen )
+{
+  uint32_t  lLatency;
+
+  if ( stZddState.iInFlightNb == 0u )
+  {
+    stZddState.stSession.lUnsolicitedNb++;
+    stZddState.stTotal.lUnsolicitedNb++;
+  }
+  else
+  {
+    lLatency = HAL_GetTick() - alZddInFlightTick[iZddInFlightRead];
+    iZddInFlightRead = (uint16_t)( ( iZddInFlightRead + 1u ) % ZDD_INFLIGHT_NB );
+    stZddState.iInFlightNb--;
+
+    stZddState.stSession.lResponseNb++;
+    stZddState.stSession.lLatencySum += lLatency;
+    stZddState.stSession.lLatencyMin = MIN( stZddState.stSession.lLatencyMin, lLatency );
+    stZddState.stSession.lLatencyMax = MAX( stZddState.stSession.lLatencyMax, lLatency );
+    stZddState.stTotal.lResponseNb++;
+    stZddState.stTotal.lLatencySum += lLatency;
+    stZddState.stTotal.lLatencyMin = MIN( stZddState.stTotal.lLatencyMin, lLatency );
+    stZddState.stTotal.lLatencyMax = MAX( stZddState.stTotal.lLatencyMax, lLatency );
+
+    /* A place in the window */
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+  }
+
+  return __real_zdd_port_send_tun_data( zb, bindata, binlen );
+}
+
+/**
+ * @brief  Host stack (its buffers sized for the services of the ZDD stack), HCI and GATT. The GAP, the services and
+ *         the address are set by the ZDD stack.
+ * @param  None
+ * @retval True on success.
+ */
+static bool ZddBleInit( void )
+{
+  BleStack_init_t   stInit;
+  tBleStatus        eStatus;
+  bool              bOk;
+
+  if ( bZddBleStarted != false )
+  {
+    return true;
+  }
+
+  memset( &stInit, 0, sizeof( stInit ) );
+  stInit.bleStartRamAddress = (uint8_t *)alZddHostBuffer;
+  stInit.total_buffer_size = ZDD_HOST_BUFFER_SIZE;
+  stInit.bleStartRamAddress_GATT = (uint8_t *)alZddGattBuffer;
+  stInit.total_buffer_size_GATT = ZDD_GATT_BUFFER_SIZE;
+  stInit.numAttrRecord = ZDD_GATT_ATTRIBUTE_NB;
+  stInit.numAttrServ = ZDD_GATT_SERVICE_NB;
+  stInit.attrValueArrSize = ZDD_ATT_VALUE_SIZE;
+  stInit.numOfLinks = ZDD_LINK_NB;
+  stInit.prWriteListSize = ZDD_PREP_WRITE_NB;
+  stInit.mblockCount = ZDD_MBLOCK_NB;
+  stInit.attMtu = ZDD_ATT_MTU;
+  stInit.max_coc_mps = BLE_DEFAULT_ATT_MTU;
+  stInit.options = BLE_OPTIONS_DEV_NAME_READ_ONLY;
+
+  /* The timers of the host and the host itself run in the host task */
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), UTIL_SEQ_RFU, ZddHostTask );
+  UTIL_SEQ_RegTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), UTIL_SEQ_RFU, ZddTask );
+
+  eStatus = BleStack_Init( &stInit );
+  if ( eStatus != BLE_STATUS_SUCCESS )
+  {
+    LOG_ERROR_APP( "Error, ZDD : host stack not started (0x%02X).", eStatus );
+    return false;
+  }
+
+  bOk = ZddCheck( HCI_RESET(), "HCI reset" );
+  bOk = bOk && ZddCheck( HCI_LE_WRITE_SUGGESTED_DEFAULT_DATA_LENGTH( ZDD_LL_DATA_LENGTH, ZDD_LL_DATA_TIME ),
+                         "default data length" );
+  bOk = bOk && ZddCheck( HCI_LE_SET_DEFAULT_PHY( 0u, ( HCI_TX_PHYS_LE_1M_PREF | HCI_TX_PHYS_LE_2M_PREF ),
+                                                 ( HCI_RX_PHYS_LE_1M_PREF | HCI_RX_PHYS_LE_2M_PREF ) ), "default PHY" );
+  bOk = bOk && ZddCheck( ACI_GATT_INIT(), "GATT init" );
+  if ( bOk == false )
+  {
+    return false;
+  }
+
+  initialize_zdd_ble_asynch_event_queue();
+  bZddBleStarted = true;
+
+  return true;
+}
+
+/**
+ * @brief  Status of a BLE command (error logged).
+ * @param  eStatus    Status returned by the command
+ * @param  szCommand  Name of the command
+ * @retval True on success.
+ */
+static bool ZddCheck( tBleStatus eStatus, const char * szCommand )
+{
+  if ( eStatus == BLE_STATUS_SUCCESS )
+  {
+    return true;
+  }
+
+  LOG_ERROR_APP( "Error, ZDD : %s (0x%02X).", szCommand, eStatus );
+
+  return false;
+}
+
+/**
+ * @brief  Host task : expired timers of the host then the host stack.
+ * @param  None
+ * @retval None
+ */
+static void ZddHostTask( void )
+{
+  BLE_PLAT_TimerProcess();
+
+  if ( BleStack_Process() == BLE_SLEEPMODE_RUNNING )
+  {
+    UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+  }
+}
+
+/**
+ * @brief  ZDD task : BLE commands deferred from the events, requests expired, writes given to the stack in the
+ *         window, then the port of the ZDD stack.
+ * @param  None
+ * @retval None
+ */
+static void ZddTask( void )
+{
+  uint32_t  lElapsed;
+
+  if ( bZddLinkSetup != false )
+  {
+    bZddLinkSetup = false;
+    (void)ZddCheck( HCI_LE_SET_DATA_LENGTH( iZddConnection, ZDD_LL_DATA_LENGTH, ZDD_LL_DATA_TIME ), "data length" );
+    (void)ZddCheck( HCI_LE_SET_PHY( iZddConnection, 0u, HCI_TX_PHYS_LE_2M_PREF, HCI_RX_PHYS_LE_2M_PREF, 0u ), "PHY" );
+  }
+
+  if ( bZddAdvertise != false )
+  {
+    bZddAdvertise = false;
+    zb_zdd_update_advert( pstZddZigbee, true );
+  }
+
+  ZddInFlightExpire();
+
+  while ( stZddState.iQueueNb != 0u )
+  {
+    /* The end of a long write follows its start, without waiting */
+    if ( ( astZddQueue[iZddQueueRead].iOffset == 0u ) && ( stZddState.iInFlightNb >= CFG_ZIGBEE_ZDD_WINDOW ) )
+    {
+      break;
+    }
+
+    ZddWriteRelease();
+  }
+
+  zdd_port_task();
+
+  /* Timeout of the oldest request */
+  UTIL_TIMER_Stop( &stZddTimer );
+  if ( stZddState.iInFlightNb != 0u )
+  {
+    lElapsed = HAL_GetTick() - alZddInFlightTick[iZddInFlightRead];
+    UTIL_TIMER_StartWithPeriod( &stZddTimer, ( CFG_ZIGBEE_ZDD_REQ_TIMEOUT - MIN( lElapsed, ( CFG_ZIGBEE_ZDD_REQ_TIMEOUT - 1u ) ) ) );
+  }
+
+  /* The commands given to the host are processed by its task */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  Timeout of the oldest request in flight (IRQ context) : expired by the task.
+ * @param  arg  Not used
+ * @retval None
+ */
+static void ZddTimerElapsed( void * arg )
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+}
+
+/**
+ * @brief  Write of the phone in the tunnel characteristic added to the queue. When the queue is full, its oldest write
+ *         is given to the stack at once, over the window.
+ * @param  iEvent   ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE or ACI_GATT_WRITE_PERMIT_REQ_VSEVT_CODE
+ * @param  iOffset  Offset of the data in the characteristic
+ * @param  pData    Parameters of the event
+ * @param  iSize    Size of the parameters
+ * @retval None
+ */
+static void ZddWriteQueue( uint16_t iEvent, uint16_t iOffset, const uint8_t * pData, uint16_t iSize )
+{
+  ZddWrite_t  * pstWrite;
+
+  if ( stZddState.iQueueNb == CFG_ZIGBEE_ZDD_QUEUE_NB )
+  {
+    stZddState.stSession.lOverflowNb++;
+    stZddState.stTotal.lOverflowNb++;
+    ZddWriteRelease();
+  }
+
+  pstWrite = &astZddQueue[( iZddQueueRead + stZddState.iQueueNb ) % CFG_ZIGBEE_ZDD_QUEUE_NB];
+  pstWrite->iEvent = iEvent;
+  pstWrite->iOffset = iOffset;
+  memcpy( pstWrite->alEvent, pData, iSize );
+
+  stZddState.iQueueNb++;
+  stZddState.stSession.iQueueMax = MAX( stZddState.stSession.iQueueMax, stZddState.iQueueNb );
+  stZddState.stTotal.iQueueMax = MAX( stZddState.stTotal.iQueueMax, stZddState.iQueueNb );
+
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+}
+
+/**
+ * @brief  Oldest write of the queue given to the stack, in flight from now if it starts a request.
+ * @param  None
+ * @retval None
+ */
+static void ZddWriteRelease( void )
+{
+  const ZddWrite_t  * pstWrite = &astZddQueue[iZddQueueRead];
+
+  if ( ( pstWrite->iOffset == 0u ) && ( stZddState.iInFlightNb < ZDD_INFLIGHT_NB ) )
+  {
+    alZddInFlightTick[( iZddInFlightRead + stZddState.iInFlightNb ) % ZDD_INFLIGHT_NB] = HAL_GetTick();
+    stZddState.iInFlightNb++;
+    stZddState.stSession.iInFlightMax = MAX( stZddState.stSession.iInFlightMax, stZddState.iInFlightNb );
+    stZddState.stTotal.iInFlightMax = MAX( stZddState.stTotal.iInFlightMax, stZddState.iInFlightNb );
+    stZddState.stSession.lRequestNb++;
+    stZddState.stTotal.lRequestNb++;
+  }
+
+  ZddWriteGive( pstWrite );
+
+  iZddQueueRead = (uint16_t)( ( iZddQueueRead + 1u ) % CFG_ZIGBEE_ZDD_QUEUE_NB );
+  stZddState.iQueueNb--;
+}
+
+/**
+ * @brief  Write given to the port of the ZDD stack, as received from the host.
+ * @param  pstWrite  Write of the queue
+ * @retval None
+ */
+static void ZddWriteGive( const ZddWrite_t * pstWrite )
+{
+  if ( pstWrite->iEvent == ACI_GATT_WRITE_PERMIT_REQ_VSEVT_CODE )
+  {
+    (void)processWriteForZdd( (aci_gatt_write_permit_req_event_rp0 *)pstWrite->alEvent );
+  }
+  else
+  {
+    (void)handle_zdd_aci_gatt_atribute_modif( (aci_gatt_attribute_modified_event_rp0 *)pstWrite->alEvent,
+                                              ZDD_EVT_NOT_ACK );
+  }
+}
+
+/**
+ * @brief  Requests in flight for longer than CFG_ZIGBEE_ZDD_REQ_TIMEOUT released from the window.
+ * @param  None
+ * @retval None
+ */
+static void ZddInFlightExpire( void )
+{
+  uint32_t  lNow = HAL_GetTick();
+
+  while ( ( stZddState.iInFlightNb != 0u ) &&
+          ( ( lNow - alZddInFlightTick[iZddInFlightRead] ) >= CFG_ZIGBEE_ZDD_REQ_TIMEOUT ) )
+  {
+    iZddInFlightRead = (uint16_t)( ( iZddInFlightRead + 1u ) % ZDD_INFLIGHT_NB );
+    stZddState.iInFlightNb--;
+    stZddState.stSession.lTimeoutNb++;
+    stZddState.stTotal.lTimeoutNb++;
+  }
+}
+
+/**
+ * @brief  New session (BLE link) : its statistics cleared.
+ * @param  None
+ * @retval None
+ */
+static void ZddSessionStart( void )
+{
+  memset( &stZddState.stSession, 0, sizeof( stZddState.stSession ) );
+  stZddState.stSession.lLatencyMin = UINT32_MAX;
+  stZddState.lSessionNb++;
+}
+
+/**
+ * @brief  Statistics of the tunnelled requests printed.
+ * @param  szName    Session or total
+ * @param  pstStats  Statistics
+ * @retval None
+ */
+static void ZddStatsPrint( const char * szName, const APP_ZIGBEE_ZddStats_t * pstStats )
+{
+  uint32_t  lAverage = 0, lMin = 0;
+
+  if ( pstStats->lResponseNb != 0u )
+  {
+    lAverage = pstStats->lLatencySum / pstStats->lResponseNb;
+    lMin = pstStats->lLatencyMin;
+  }
+
+  LOG_INFO_APP( "ZDD %s : %u requests, %u responses (%u unsolicited), %u timeouts, %u overflows.", szName,
+                pstStats->lRequestNb, pstStats->lResponseNb, pstStats->lUnsolicitedNb, pstStats->lTimeoutNb,
+                pstStats->lOverflowNb );
+  LOG_INFO_APP( "ZDD %s : latency %u / %u / %u ms (min / avg / max), most %d in flight, %d waiting.", szName,
+                lMin, lAverage, pstStats->lLatencyMax, pstStats->iInFlightMax, pstStats->iQueueMax );
+}
+
+/**
+ * @brief  New link : given to the port, new session, PHY and data length deferred to the task.
+ * @param  iConnection  Handle of the link
+ * @retval None
+ */
+static void ZddConnected( uint16_t iConnection )
+{
+  iZddConnection = iConnection;
+  update_zdd_port_handle( iConnection );
+  if ( handle_new_zdd_connection() == false )
+  {
+    LOG_WARNING_APP( "ZDD : connection 0x%04X refused by the port.", iConnection );
+  }
+
+  stZddState.bConnected = true;
+  ZddSessionStart();
+
+  bZddLinkSetup = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+  LOG_INFO_APP( "ZDD : connected (0x%04X).", iConnection );
+}
+
+/**
+ * @brief  End of the link : writes waiting dropped, statistics of the session printed, advertising restarted.
+ * @param  pstEvent  HCI_DISCONNECTION_COMPLETE_EVENT
+ * @retval None
+ */
+static void ZddDisconnected( const hci_disconnection_complete_event_rp0 * pstEvent )
+{
+  if ( ( pstEvent->Status != BLE_STATUS_SUCCESS ) || ( check_zdd_connection_handle( pstEvent->Connection_Handle ) == false ) )
+  {
+    return;
+  }
+
+  disconnect_zdd_port_zvd();
+
+  iZddConnection = ZDD_HANDLE_NONE;
+  stZddState.bConnected = false;
+  stZddState.iQueueNb = 0;
+  stZddState.iInFlightNb = 0;
+  bZddLinkSetup = false;
+
+  LOG_INFO_APP( "ZDD : disconnected (reason 0x%02X).", pstEvent->Reason );
+  ZddStatsPrint( "session", &stZddState.stSession );
+
+  bZddAdvertise = true;
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+}
+
+/**
+ * @brief  LE meta events : connection of the phone.
+ * @param  cSubEvent  Subevent code
+ * @param  pData      Parameters of the subevent
+ * @retval None
+ */
+static void ZddLeMetaEvent( uint8_t cSubEvent, const uint8_t * pData )
+{
+  switch ( cSubEvent )
+  {
+    case HCI_LE_CONNECTION_COMPLETE_SUBEVT_CODE:
+        {
+          const hci_le_connection_complete_event_rp0 * pstEvent = (const hci_le_connection_complete_event_rp0 *)pData;
+
+          if ( pstEvent->Status == BLE_STATUS_SUCCESS )
+          {
+            ZddConnected( pstEvent->Connection_Handle );
+          }
+        }
+        break;
+
+    case HCI_LE_ENHANCED_CONNECTION_COMPLETE_SUBEVT_CODE:
+        {
+          const hci_le_enhanced_connection_complete_event_rp0 * pstEvent =
+            (const hci_le_enhanced_connection_complete_event_rp0 *)pData;
+
+          if ( pstEvent->Status == BLE_STATUS_SUCCESS )
+          {
+            ZddConnected( pstEvent->Connection_Handle );
+          }
+        }
+        break;
+
+    default:
+        break;
+  }
+}
+
+/**
+ * @brief  Vendor events : reads and writes of the phone. The writes of the tunnel wait for the window, the others are
+ *         given to the port at once.
+ * @param  iEvent  Vendor event code
+ * @param  pData   Parameters of the event
+ * @retval None
+ */
+static void ZddVendorEvent( uint16_t iEvent, const uint8_t * pData )
+{
+  switch ( iEvent )
+  {
+    case ACI_GATT_ATTRIBUTE_MODIFIED_VSEVT_CODE:
+        {
+          aci_gatt_attribute_modified_event_rp0 * pstEvent = (aci_gatt_attribute_modified_event_rp0 *)pData;
+
+          if ( ( pstEvent->Attr_Handle == ( iZddTunnelHandle + 1u ) ) && ( pstEvent->Attr_Data_Length <= ZDD_CHAR_SZ_TUNNEL ) )
+          {
+            ZddWriteQueue( iEvent, ( pstEvent->Offset & ZDD_OFFSET_MASK ), pData,
+                           (uint16_t)( sizeof( *pstEvent ) + pstEvent->Attr_Data_Length ) );
+          }
+          else
+          {
+            (void)handle_zdd_aci_gatt_atribute_modif( pstEvent, ZDD_EVT_NOT_ACK );
+          }
+        }
+        break;
+
+    case ACI_GATT_WRITE_PERMIT_REQ_VSEVT_CODE:
+        {
+          aci_gatt_write_permit_req_event_rp0 * pstEvent = (aci_gatt_write_permit_req_event_rp0 *)pData;
+
+          if ( pstEvent->Attribute_Handle == ( iZddTunnelHandle + 1u ) )
+          {
+            ZddWriteQueue( iEvent, 0u, pData, (uint16_t)( sizeof( *pstEvent ) + pstEvent->Data_Length ) );
+          }
+          else
+          {
+            (void)processWriteForZdd( pstEvent );
+          }
+        }
+        break;
+
+    case ACI_GATT_READ_PERMIT_REQ_VSEVT_CODE:
+        {
+          const aci_gatt_read_permit_req_event_rp0 * pstEvent = (const aci_gatt_read_permit_req_event_rp0 *)pData;
+
+          (void)handle_zdd_read_request( pstEvent->Attribute_Handle );
+          (void)ZddCheck( ACI_GATT_ALLOW_READ( pstEvent->Connection_Handle ), "allow read" );
+        }
+        break;
+
+    default:
+        return;
+  }
+
+  /* Events of the port processed by its task */
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_ZIGBEE_ZDD ), TASK_PRIO_ZIGBEE_ZDD );
+}
+
+#else /* (CFG_ZIGBEE_ZDD_SUPPORTED != 0) */
+
+static APP_ZIGBEE_ZddState_t  stZddState;
+
+/**
+ * @brief  Zigbee Direct not supported : nothing to start.
+ */
+void APP_ZIGBEE_ZddInit( struct ZigBeeT * pstZigbee )
+{
+  UNUSED( pstZigbee );
+}
+
+/**
+ * @brief  Zigbee Direct not supported : no tunnel.
+ */
+void APP_ZIGBEE_ZddCharAdded( uint8_t cStatus, uint8_t cUuidType, const uint8_t * pUuid, uint16_t iHandle )
+{
+  UNUSED( cStatus );
+  UNUSED( cUuidType );
+  UNUSED( pUuid );
+  UNUSED( iHandle );
+}
+
+/**
+ * @brief  Zigbee Direct not supported : no command.
+ */
+bool APP_ZIGBEE_ZddSerialCmdExecute( const char * szCommand )
+{
+  UNUSED( szCommand );
+
+  return false;
+}
+
+/**
+ * @brief  Zigbee Direct not supported : state never connected.
+ */
+const APP_ZIGBEE_ZddState_t * APP_ZIGBEE_ZddGetState( void )
+{
+  return &stZddState;
+}
+
+#endif /* (CFG_ZIGBEE_ZDD_SUPPORTED != 0) */
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    app_zigbee_zdd.h
+  * @author  MCD Application Team
+  * @brief   Interface of the Zigbee Direct Device (BLE commissioning and
+  *          windowed tunnel of the phone requests into the network).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_ZIGBEE_ZDD_H
+#define APP_ZIGBEE_ZDD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_conf.h"
+#include "zigbee.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Statistics of the tunnelled requests */
+typedef struct
+{
+  uint32_t    lRequestNb;             /* Requests given to the stack */
+  uint32_t    lResponseNb;            /* Frames tunnelled back to the phone, matched with the oldest request */
+  uint32_t    lUnsolicitedNb;         /* Frames tunnelled back without request in flight */
+  uint32_t    lTimeoutNb;             /* Requests without response after CFG_ZIGBEE_ZDD_REQ_TIMEOUT */
+  uint32_t    lOverflowNb;            /* Writes given to the stack at once (queue full) */
+  uint32_t    lLatencySum;            /* ms, of the responses */
+  uint32_t    lLatencyMin;            /* ms */
+  uint32_t    lLatencyMax;            /* ms */
+  uint16_t    iQueueMax;              /* Most writes waiting for the window */
+  uint16_t    iInFlightMax;           /* Most requests in flight */
+} APP_ZIGBEE_ZddStats_t;
+
+/* State of the Zigbee Direct */
+typedef struct
+{
+  bool                    bConnected;     /* Phone connected by BLE */
+  uint16_t                iQueueNb;       /* Writes waiting for the window */
+  uint16_t                iInFlightNb;    /* Requests in flight */
+  uint32_t                lSessionNb;     /* BLE links */
+  APP_ZIGBEE_ZddStats_t   stSession;      /* Current (or last) BLE link */
+  APP_ZIGBEE_ZddStats_t   stTotal;        /* Since the reset */
+} APP_ZIGBEE_ZddState_t;
+
+/* Exported functions ------------------------------------------------------- */
+void      APP_ZIGBEE_ZddInit                ( struct ZigBeeT * pstZigbee );
+void      APP_ZIGBEE_ZddCharAdded           ( uint8_t cStatus, uint8_t cUuidType, const uint8_t * pUuid, uint16_t iHandle );
+bool      APP_ZIGBEE_ZddSerialCmdExecute    ( const char * szCommand );
+
+const APP_ZIGBEE_ZddState_t * APP_ZIGBEE_ZddGetState ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ZIGBEE_ZDD_H */
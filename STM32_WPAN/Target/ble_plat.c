@@ -0,0 +1,503 @@
+/**
+  ******************************************************************************
+  * @file    ble_plat.c
+  * @author  MCD Application Team
+  * @brief   Platform functions of the BLE host stack (bleplat.h) : AES on the
+  *          BasicAES module, random numbers from the HW_RNG pool, P-256 keys
+  *          on the asynchronous PKA jobs, timers on the UTIL_TIMER (expiries
+  *          given to the host from its task), and the security records kept
+  *          in RAM until the reset (no bonding).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_common.h"
+#include "app_conf.h"
+#include "ble_plat.h"
+
+#if (CFG_BLE_HOST_SUPPORTED != 0)
+#include "hw.h"
+#include "baes.h"
+#include "bleplat.h"
+#include "stm32_rtos.h"
+#include "stm32_timer.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define BLE_PLAT_P256_WORD_NB           (8u)                    /* Coordinate or scalar of the P-256 curve */
+#define BLE_PLAT_NVM_HEADER_SIZE        (4u)                    /* Type, RFU, size of the data (16 bits) */
+#define BLE_PLAT_NVM_NONE               (0xFFFFu)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Timer of the BLE host */
+typedef struct
+{
+  UTIL_TIMER_Object_t   stTimer;
+  uint16_t              iId;                    /* Identifier given by the host */
+  bool                  bUsed;
+} BlePlatTimer_t;
+
+/* Private variables ---------------------------------------------------------*/
+static BLE_PLAT_Stats_t             stBlePlatStats;
+static BlePlatTimer_t               astBlePlatTimers[CFG_BLE_HOST_TIMER_NB];
+static volatile uint32_t            lBlePlatTimerExpired;   /* One bit per entry of astBlePlatTimers */
+static BAES_CMAC_t                  stBlePlatCmac;          /* Own context : the Zigbee stack uses the default one */
+static HW_PKA_P256_ECC_MUL_JOB_T    stBlePlatPkaJob;
+static uint32_t                     alBlePlatPkaScalar[BLE_PLAT_P256_WORD_NB];
+static uint32_t                     alBlePlatPkaPoint[2u * BLE_PLAT_P256_WORD_NB];
+static bool                         bBlePlatPkaBusy;
+static uint8_t                      acBlePlatNvm[CFG_BLE_HOST_NVM_SIZE];
+static uint16_t                     iBlePlatNvmCurrent = BLE_PLAT_NVM_NONE;  /* Record read */
+static bool                         bBlePlatNvmDiscarded;   /* The current record was discarded : the next one is in place */
+
+/* Private functions prototypes-----------------------------------------------*/
+static void     BlePlatTimerElapsed     ( void * arg );
+static void     BlePlatPkaEnd           ( HW_PKA_JOB_T * pstJob );
+static uint16_t BlePlatNvmDataSize      ( uint16_t iRecord );
+static uint16_t BlePlatNvmFind          ( uint16_t iRecord, uint8_t cType );
+
+/* Functions Definition ------------------------------------------------------*/
+
+/**
+ * @brief  Called by the BLE host at its initialization and at each HCI reset : the timers are stopped. The records
+ *         are kept (as the content of a NVM).
+ * @param  None
+ * @retval None
+ */
+void BLEPLAT_Init( void )
+{
+  for ( uint32_t lIndex = 0; lIndex < CFG_BLE_HOST_TIMER_NB; lIndex++ )
+  {
+    /* Creating a timer stops it */
+    UTIL_TIMER_Create( &astBlePlatTimers[lIndex].stTimer, 0, UTIL_TIMER_ONESHOT, &BlePlatTimerElapsed, (void *)lIndex );
+    astBlePlatTimers[lIndex].bUsed = false;
+  }
+  lBlePlatTimerExpired = 0;
+
+  iBlePlatNvmCurrent = BLE_PLAT_NVM_NONE;
+  bBlePlatNvmDiscarded = false;
+}
+
+/**
+ * @brief  Store a record (the data followed by the extra data).
+ */
+int BLEPLAT_NvmAdd( uint8_t type, const uint8_t * data, uint16_t size, const uint8_t * extra_data, uint16_t extra_size )
+{
+  uint8_t   * pRecord = &acBlePlatNvm[stBlePlatStats.iNvmUsedSize];
+  uint32_t  lDataSize = (uint32_t)size + ( ( extra_data != NULL ) ? extra_size : 0u );
+
+  if ( ( stBlePlatStats.iNvmUsedSize + BLE_PLAT_NVM_HEADER_SIZE + lDataSize ) > CFG_BLE_HOST_NVM_SIZE )
+  {
+    stBlePlatStats.iNvmFullNb++;
+    return BLEPLAT_FULL;
+  }
+
+  pRecord[0] = type;
+  pRecord[1] = 0;
+  pRecord[2] = (uint8_t)lDataSize;
+  pRecord[3] = (uint8_t)( lDataSize >> 8 );
+  memcpy( &pRecord[BLE_PLAT_NVM_HEADER_SIZE], data, size );
+  if ( extra_data != NULL )
+  {
+    memcpy( &pRecord[BLE_PLAT_NVM_HEADER_SIZE + size], extra_data, extra_size );
+  }
+  stBlePlatStats.iNvmUsedSize += (uint16_t)( BLE_PLAT_NVM_HEADER_SIZE + lDataSize );
+
+  return BLEPLAT_OK;
+}
+
+/**
+ * @brief  Read the first, next or current record of a type, from an offset in its data.
+ */
+int BLEPLAT_NvmGet( uint8_t mode, uint8_t type, uint16_t offset, uint8_t * data, uint16_t size )
+{
+  uint16_t  iRecord;
+  uint16_t  iDataSize;
+
+  switch ( mode )
+  {
+    case BLEPLAT_NVM_FIRST:
+        iRecord = BlePlatNvmFind( 0, type );
+        break;
+
+    case BLEPLAT_NVM_NEXT:
+        iRecord = iBlePlatNvmCurrent;
+        if ( iRecord != BLE_PLAT_NVM_NONE )
+        {
+          if ( bBlePlatNvmDiscarded == false )
+          {
+            iRecord += BLE_PLAT_NVM_HEADER_SIZE + BlePlatNvmDataSize( iRecord );
+          }
+          iRecord = BlePlatNvmFind( iRecord, type );
+        }
+        break;
+
+    case BLEPLAT_NVM_CURRENT:
+        iRecord = ( bBlePlatNvmDiscarded == false ) ? iBlePlatNvmCurrent : BLE_PLAT_NVM_NONE;
+        break;
+
+    default:
+        return BLEPLAT_ERROR;
+  }
+
+  iBlePlatNvmCurrent = iRecord;
+  bBlePlatNvmDiscarded = false;
+  if ( iRecord == BLE_PLAT_NVM_NONE )
+  {
+    return BLEPLAT_EOF;
+  }
+
+  iDataSize = BlePlatNvmDataSize( iRecord );
+  if ( offset >= iDataSize )
+  {
+    return 0;
+  }
+  size = MIN( size, ( iDataSize - offset ) );
+  memcpy( data, &acBlePlatNvm[iRecord + BLE_PLAT_NVM_HEADER_SIZE + offset], size );
+
+  return (int)size;
+}
+
+/**
+ * @brief  Compare data with the current record, from an offset in its data.
+ */
+int BLEPLAT_NvmCompare( uint16_t offset, const uint8_t * data, uint16_t size )
+{
+  if ( ( iBlePlatNvmCurrent == BLE_PLAT_NVM_NONE ) || ( bBlePlatNvmDiscarded != false ) )
+  {
+    return BLEPLAT_ERROR;
+  }
+  if ( ( (uint32_t)offset + size ) > BlePlatNvmDataSize( iBlePlatNvmCurrent ) )
+  {
+    return 1;
+  }
+
+  return ( memcmp( &acBlePlatNvm[iBlePlatNvmCurrent + BLE_PLAT_NVM_HEADER_SIZE + offset], data, size ) == 0 ) ? BLEPLAT_OK : 1;
+}
+
+/**
+ * @brief  Clear all the records, or the current one (the following ones move in its place).
+ */
+void BLEPLAT_NvmDiscard( uint8_t mode )
+{
+  uint16_t  iRecordSize;
+
+  if ( mode == BLEPLAT_NVM_ALL )
+  {
+    stBlePlatStats.iNvmUsedSize = 0;
+    iBlePlatNvmCurrent = BLE_PLAT_NVM_NONE;
+    bBlePlatNvmDiscarded = false;
+  }
+  else if ( ( iBlePlatNvmCurrent != BLE_PLAT_NVM_NONE ) && ( bBlePlatNvmDiscarded == false ) )
+  {
+    iRecordSize = BLE_PLAT_NVM_HEADER_SIZE + BlePlatNvmDataSize( iBlePlatNvmCurrent );
+    memmove( &acBlePlatNvm[iBlePlatNvmCurrent], &acBlePlatNvm[iBlePlatNvmCurrent + iRecordSize],
+             ( stBlePlatStats.iNvmUsedSize - iBlePlatNvmCurrent - iRecordSize ) );
+    stBlePlatStats.iNvmUsedSize -= iRecordSize;
+    bBlePlatNvmDiscarded = true;
+  }
+}
+
+/**
+ * @brief  Start the generation of the P-256 public key (scalar multiplication of the base point), on the PKA queue.
+ */
+int BLEPLAT_PkaStartP256Key( const uint32_t * local_private_key )
+{
+  if ( bBlePlatPkaBusy != false )
+  {
+    return BLEPLAT_BUSY;
+  }
+  bBlePlatPkaBusy = true;
+  stBlePlatStats.lPkaJobNb++;
+
+  memcpy( alBlePlatPkaScalar, local_private_key, sizeof( alBlePlatPkaScalar ) );
+  stBlePlatPkaJob.k = alBlePlatPkaScalar;
+  stBlePlatPkaJob.p_x = NULL;
+  stBlePlatPkaJob.p_y = NULL;
+  HW_PKA_P256_EccScalarMulAsync( &stBlePlatPkaJob, &BlePlatPkaEnd );
+
+  return BLEPLAT_OK;
+}
+
+/**
+ * @brief  Public key generated : X then Y.
+ */
+void BLEPLAT_PkaReadP256Key( uint32_t * local_public_key )
+{
+  memcpy( &local_public_key[0], stBlePlatPkaJob.r_x, sizeof( stBlePlatPkaJob.r_x ) );
+  memcpy( &local_public_key[BLE_PLAT_P256_WORD_NB], stBlePlatPkaJob.r_y, sizeof( stBlePlatPkaJob.r_y ) );
+}
+
+/**
+ * @brief  Start the computation of the DH key (scalar multiplication of the remote public key), on the PKA queue.
+ */
+int BLEPLAT_PkaStartDhKey( const uint32_t * local_private_key, const uint32_t * remote_public_key )
+{
+  if ( bBlePlatPkaBusy != false )
+  {
+    return BLEPLAT_BUSY;
+  }
+  bBlePlatPkaBusy = true;
+  stBlePlatStats.lPkaJobNb++;
+
+  memcpy( alBlePlatPkaScalar, local_private_key, sizeof( alBlePlatPkaScalar ) );
+  memcpy( alBlePlatPkaPoint, remote_public_key, sizeof( alBlePlatPkaPoint ) );
+  stBlePlatPkaJob.k = alBlePlatPkaScalar;
+  stBlePlatPkaJob.p_x = &alBlePlatPkaPoint[0];
+  stBlePlatPkaJob.p_y = &alBlePlatPkaPoint[BLE_PLAT_P256_WORD_NB];
+  HW_PKA_P256_EccScalarMulAsync( &stBlePlatPkaJob, &BlePlatPkaEnd );
+
+  return BLEPLAT_OK;
+}
+
+/**
+ * @brief  DH key computed : X of the result, error if the remote key is not a point of the curve.
+ */
+int BLEPLAT_PkaReadDhKey( uint32_t * dh_key )
+{
+  if ( stBlePlatPkaJob.success == 0u )
+  {
+    return BLEPLAT_ERROR;
+  }
+  memcpy( dh_key, stBlePlatPkaJob.r_x, sizeof( stBlePlatPkaJob.r_x ) );
+
+  return BLEPLAT_OK;
+}
+
+/**
+ * @brief  Encrypt a block (AES-128 ECB).
+ */
+void BLEPLAT_AesEcbEncrypt( const uint8_t * key, const uint8_t * input, uint8_t * output )
+{
+  BAES_EcbCrypt( key, input, output, 1 );
+}
+
+/**
+ * @brief  Key of the CMAC computation.
+ */
+void BLEPLAT_AesCmacSetKey( const uint8_t * key )
+{
+  BAES_CmacCtxSetKey( &stBlePlatCmac, key );
+}
+
+/**
+ * @brief  CMAC computation : data appended while output_tag is NULL, tag given at the end.
+ */
+void BLEPLAT_AesCmacCompute( const uint8_t * input, uint32_t input_length, uint8_t * output_tag )
+{
+  BAES_CmacCtxCompute( &stBlePlatCmac, input, input_length, output_tag );
+}
+
+/**
+ * @brief  CCM encryption or decryption.
+ */
+int BLEPLAT_AesCcmCrypt( uint8_t mode, const uint8_t * key, uint8_t iv_length, const uint8_t * iv, uint16_t add_length,
+                         const uint8_t * add, uint32_t input_length, const uint8_t * input, uint8_t tag_length,
+                         uint8_t * tag, uint8_t * output )
+{
+  if ( input_length > UINT16_MAX )
+  {
+    return BLEPLAT_ERROR;
+  }
+
+  return ( BAES_CcmCrypt( mode, key, iv_length, iv, add_length, add, (uint16_t)input_length, input, tag_length, tag,
+                          output ) == 0 ) ? BLEPLAT_OK : BLEPLAT_ERROR;
+}
+
+/**
+ * @brief  Random 32-bit words, from the pool of the HW_RNG.
+ */
+void BLEPLAT_RngGet( uint8_t n, uint32_t * val )
+{
+  HW_RNG_Get( n, val );
+}
+
+/**
+ * @brief  Start (or restart) a timer of the host.
+ */
+uint8_t BLEPLAT_TimerStart( uint16_t id, uint32_t timeout )
+{
+  uint32_t  lIndex;
+  uint32_t  lFree = CFG_BLE_HOST_TIMER_NB;
+
+  for ( lIndex = 0; lIndex < CFG_BLE_HOST_TIMER_NB; lIndex++ )
+  {
+    if ( astBlePlatTimers[lIndex].bUsed == false )
+    {
+      lFree = MIN( lFree, lIndex );
+    }
+    else if ( astBlePlatTimers[lIndex].iId == id )
+    {
+      break;
+    }
+  }
+  if ( lIndex == CFG_BLE_HOST_TIMER_NB )
+  {
+    lIndex = lFree;
+    if ( lIndex == CFG_BLE_HOST_TIMER_NB )
+    {
+      stBlePlatStats.lTimerFullNb++;
+      return (uint8_t)BLEPLAT_FULL;
+    }
+  }
+
+  astBlePlatTimers[lIndex].iId = id;
+  astBlePlatTimers[lIndex].bUsed = true;
+  UTILS_ENTER_CRITICAL_SECTION();
+  lBlePlatTimerExpired &= ~( 1UL << lIndex );
+  UTILS_EXIT_CRITICAL_SECTION();
+  UTIL_TIMER_StartWithPeriod( &astBlePlatTimers[lIndex].stTimer, timeout );
+  stBlePlatStats.lTimerStartNb++;
+
+  return (uint8_t)BLEPLAT_OK;
+}
+
+/**
+ * @brief  Stop a timer of the host (its expiry not yet given is cancelled).
+ */
+void BLEPLAT_TimerStop( uint16_t id )
+{
+  for ( uint32_t lIndex = 0; lIndex < CFG_BLE_HOST_TIMER_NB; lIndex++ )
+  {
+    if ( ( astBlePlatTimers[lIndex].bUsed != false ) && ( astBlePlatTimers[lIndex].iId == id ) )
+    {
+      UTIL_TIMER_Stop( &astBlePlatTimers[lIndex].stTimer );
+      UTILS_ENTER_CRITICAL_SECTION();
+      lBlePlatTimerExpired &= ~( 1UL << lIndex );
+      UTILS_EXIT_CRITICAL_SECTION();
+      astBlePlatTimers[lIndex].bUsed = false;
+    }
+  }
+}
+
+/**
+ * @brief  Give the expired timers to the host. Called from the task of the host.
+ * @param  None
+ * @retval None
+ */
+void BLE_PLAT_TimerProcess( void )
+{
+  uint32_t  lExpired;
+  uint16_t  iId;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  lExpired = lBlePlatTimerExpired;
+  lBlePlatTimerExpired = 0;
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  for ( uint32_t lIndex = 0; lIndex < CFG_BLE_HOST_TIMER_NB; lIndex++ )
+  {
+    if ( ( lExpired & ( 1UL << lIndex ) ) != 0u )
+    {
+      /* The entry is free before the callback, which can start a timer again */
+      iId = astBlePlatTimers[lIndex].iId;
+      astBlePlatTimers[lIndex].bUsed = false;
+      stBlePlatStats.lTimerExpiryNb++;
+      BLEPLATCB_TimerExpiry( iId );
+    }
+  }
+}
+
+/**
+ * @brief  Activity of the platform functions.
+ * @param  pstStats   Statistics to fill
+ * @retval None
+ */
+void BLE_PLAT_GetStats( BLE_PLAT_Stats_t * pstStats )
+{
+  *pstStats = stBlePlatStats;
+}
+
+/**
+ * @brief  Timer of the host expired (interrupt context) : given to the host from its task.
+ * @param  arg  Entry of the timer
+ * @retval None
+ */
+static void BlePlatTimerElapsed( void * arg )
+{
+  lBlePlatTimerExpired |= ( 1UL << (uint32_t)arg );
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  End of the PKA job (task context) : the host reads the result from its task.
+ * @param  pstJob   Job ended
+ * @retval None
+ */
+static void BlePlatPkaEnd( HW_PKA_JOB_T * pstJob )
+{
+  UNUSED( pstJob );
+
+  bBlePlatPkaBusy = false;
+  BLEPLATCB_PkaComplete();
+  UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( CFG_TASK_BLE_HOST ), TASK_PRIO_BLE_HOST );
+}
+
+/**
+ * @brief  Size of the data of a record.
+ * @param  iRecord  Offset of the record
+ * @retval Size in bytes
+ */
+static uint16_t BlePlatNvmDataSize( uint16_t iRecord )
+{
+  return (uint16_t)acBlePlatNvm[iRecord + 2u] | ( (uint16_t)acBlePlatNvm[iRecord + 3u] << 8 );
+}
+
+/**
+ * @brief  First record of a type from an offset.
+ * @param  iRecord  Offset of the first record checked
+ * @param  cType    Type of the record
+ * @retval Offset of the record, BLE_PLAT_NVM_NONE if none.
+ */
+static uint16_t BlePlatNvmFind( uint16_t iRecord, uint8_t cType )
+{
+  while ( iRecord < stBlePlatStats.iNvmUsedSize )
+  {
+    if ( acBlePlatNvm[iRecord] == cType )
+    {
+      return iRecord;
+    }
+    iRecord += BLE_PLAT_NVM_HEADER_SIZE + BlePlatNvmDataSize( iRecord );
+  }
+
+  return BLE_PLAT_NVM_NONE;
+}
+
+#if (CFG_ZIGBEE_ZDD_SUPPORTED != 0)
+/* ACI commands of the ZDD stack (aci_xxx, hci_xxx) : the characteristics it adds are given to the application, for
+ * the handle of its tunnel */
+#include "app_zigbee_zdd.h"
+
+#define BLE_WRAP_ACI_GATT_ADD_CHAR_POSTPROC( ) \
+  APP_ZIGBEE_ZddCharAdded( status, Char_UUID_Type, (const uint8_t *)Char_UUID, *Char_Handle )
+
+#include "auto/ble_wrap.c"
+#endif /* (CFG_ZIGBEE_ZDD_SUPPORTED != 0) */
+
+#else /* (CFG_BLE_HOST_SUPPORTED != 0) */
+
+/**
+ * @brief  No BLE host : no timer.
+ */
+void BLE_PLAT_TimerProcess( void )
+{
+}
+
+/**
+ * @brief  No BLE host : no activity.
+ */
+void BLE_PLAT_GetStats( BLE_PLAT_Stats_t * pstStats )
+{
+  memset( pstStats, 0, sizeof( *pstStats ) );
+}
+
+#endif /* (CFG_BLE_HOST_SUPPORTED != 0) */
@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * File Name          : ble_plat.h
+  * Description        : Header for the BLE host platform adaptation layer.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BLE_PLAT_H
+#define BLE_PLAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Activity of the platform functions of the BLE host */
+typedef struct
+{
+  uint32_t  lTimerStartNb;      /* Timers started */
+  uint32_t  lTimerExpiryNb;     /* Timers expired (given to the host) */
+  uint32_t  lTimerFullNb;       /* Timers refused (CFG_BLE_HOST_TIMER_NB running) */
+  uint32_t  lPkaJobNb;          /* P-256 key generations and DH key computations */
+  uint16_t  iNvmUsedSize;       /* RAM records of the host, in bytes */
+  uint16_t  iNvmFullNb;         /* Records refused (CFG_BLE_HOST_NVM_SIZE) */
+} BLE_PLAT_Stats_t;
+
+/* Exported functions ------------------------------------------------------- */
+void BLE_PLAT_TimerProcess  ( void );
+void BLE_PLAT_GetStats      ( BLE_PLAT_Stats_t * pstStats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLE_PLAT_H */
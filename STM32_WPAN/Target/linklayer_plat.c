@@ -34,6 +34,11 @@
 #endif /* (CFG_LPM_LEVEL != 0) */
 
 /* USER CODE BEGIN Includes */
+#include "ll_sys_if.h"
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+#include "stm32wbaxx_ll_bus.h"
+#include "stm32wbaxx_ll_tim.h"
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
 
 /* USER CODE END Includes */
 
@@ -61,6 +66,41 @@ volatile uint8_t radio_sw_low_isr_is_running_high_prio = 0;
 uint8_t AHB5_SwitchedOff = 0;
 uint32_t radio_sleep_timer_val = 0;
 
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+/* Delays of the link layer */
+#define DELAY_TIMER                     TIM17
+#define DELAY_TIMER_IRQn                TIM17_IRQn
+#define DELAY_TIMER_MAX_US              (0x10000U)
+
+static LINKLAYER_PLAT_DelayStats_t delay_stats;
+static uint8_t delay_timer_init = 0;
+
+static void LINKLAYER_PLAT_DelayTimerInit(void);
+static void LINKLAYER_PLAT_DelayTimerWait(uint32_t delay);
+static void LINKLAYER_PLAT_DelayCycles(uint32_t delay);
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+/* Radio events, for the scheduling of the RCO calibrations */
+static volatile uint8_t radio_evt_active = 0;
+static volatile uint32_t radio_evt_count = 0;
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+/* Radio ISRs measurement : the link layer callbacks are called by wrappers */
+static void (*radio_isr_user_callback)(void) = NULL;
+static void (*low_isr_user_callback)(void) = NULL;
+static LINKLAYER_PLAT_IsrStats_t isr_stats;
+static volatile uint32_t isr_nesting = 0;
+static volatile uint32_t low_isr_trigger_cycle = 0;
+static volatile uint8_t low_isr_triggered = 0;
+static uint32_t irq_off_start_cycle = 0;
+static uint32_t irq_off_caller = 0;
+
+static void LINKLAYER_PLAT_RadioIsrWrapper(void);
+static void LINKLAYER_PLAT_SwLowIsrWrapper(void);
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+
 /**
   * @brief  Configure the necessary clock sources for the radio.
   * @param  None
@@ -89,12 +129,41 @@ void LINKLAYER_PLAT_ClockInit()
   */
 void LINKLAYER_PLAT_DelayUs(uint32_t delay)
 {
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+  if (delay_timer_init == 0)
+  {
+    LINKLAYER_PLAT_DelayTimerInit();
+  }
+
+  delay_stats.Count++;
+  delay_stats.TotalDelay += delay;
+  if (delay > delay_stats.MaxDelay)
+  {
+    delay_stats.MaxDelay = delay;
+  }
+
+  if (delay < CFG_LL_DELAY_WFE_MIN_US)
+  {
+    LINKLAYER_PLAT_DelayCycles(delay);
+  }
+  else
+  {
+    delay_stats.TimerCount++;
+    while (delay > DELAY_TIMER_MAX_US)
+    {
+      LINKLAYER_PLAT_DelayTimerWait(DELAY_TIMER_MAX_US);
+      delay -= DELAY_TIMER_MAX_US;
+    }
+    LINKLAYER_PLAT_DelayTimerWait(delay);
+  }
+#else
   __IO register uint32_t Delay = delay * (SystemCoreClock / 1000000U);
   do
   {
     __NOP();
   }
   while (Delay --);
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
 }
 
 /**
@@ -198,24 +267,8 @@ void LINKLAYER_PLAT_AclkCtrl(uint8_t enable)
   */
 void LINKLAYER_PLAT_GetRNG(uint8_t *ptr_rnd, uint32_t len)
 {
-  uint32_t nb_remaining_rng = len;
-  uint32_t generated_rng;
-
-  /* Get the requested RNGs (4 bytes by 4bytes) */
-  while(nb_remaining_rng >= 4)
-  {
-    generated_rng = 0;
-    HW_RNG_Get(1, &generated_rng);
-    memcpy((ptr_rnd+(len-nb_remaining_rng)), &generated_rng, 4);
-    nb_remaining_rng -=4;
-  }
-
-  /* Get the remaining number of RNGs */
-  if(nb_remaining_rng>0){
-    generated_rng = 0;
-    HW_RNG_Get(1, &generated_rng);
-    memcpy((ptr_rnd+(len-nb_remaining_rng)), &generated_rng, nb_remaining_rng);
-  }
+  /* Get the requested RNGs straight from the pool */
+  HW_RNG_GetBytes(len, ptr_rnd);
 }
 
 /**
@@ -225,7 +278,16 @@ void LINKLAYER_PLAT_GetRNG(uint8_t *ptr_rnd, uint32_t len)
   */
 void LINKLAYER_PLAT_SetupRadioIT(void (*intr_cb)())
 {
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+  /* Cycle counter for the measurements */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  radio_isr_user_callback = intr_cb;
+  radio_callback = LINKLAYER_PLAT_RadioIsrWrapper;
+#else
   radio_callback = intr_cb;
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
   HAL_NVIC_SetPriority((IRQn_Type) RADIO_INTR_NUM, RADIO_INTR_PRIO_HIGH, 0);
   HAL_NVIC_EnableIRQ((IRQn_Type) RADIO_INTR_NUM);
 }
@@ -237,7 +299,12 @@ void LINKLAYER_PLAT_SetupRadioIT(void (*intr_cb)())
   */
 void LINKLAYER_PLAT_SetupSwLowIT(void (*intr_cb)())
 {
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+  low_isr_user_callback = intr_cb;
+  low_isr_callback = LINKLAYER_PLAT_SwLowIsrWrapper;
+#else
   low_isr_callback = intr_cb;
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
 
   HAL_NVIC_SetPriority((IRQn_Type) RADIO_SW_LOW_INTR_NUM, RADIO_SW_LOW_INTR_PRIO, 0);
   HAL_NVIC_EnableIRQ((IRQn_Type) RADIO_SW_LOW_INTR_NUM);
@@ -278,9 +345,24 @@ void LINKLAYER_PLAT_TriggerSwLowIT(uint8_t priority)
        * will run with RADIO_INTR_PRIO_LOW priority
        **/
       radio_sw_low_isr_is_running_high_prio = 1;
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+      isr_stats.LowHandoffCount++;
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
     }
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+    isr_stats.LowRetriggerCount++;
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
   }
 
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+  /* Latency measured from the first trigger of a pending ISR */
+  if (low_isr_triggered == 0)
+  {
+    low_isr_trigger_cycle = DWT->CYCCNT;
+    low_isr_triggered = 1;
+  }
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+
   HAL_NVIC_SetPendingIRQ((IRQn_Type) RADIO_SW_LOW_INTR_NUM);
 }
 
@@ -295,6 +377,20 @@ void LINKLAYER_PLAT_EnableIRQ(void)
 
   if(irq_counter == 0)
   {
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+    uint32_t duration = DWT->CYCCNT - irq_off_start_cycle;
+
+    if (duration > isr_stats.IrqOffMaxDuration)
+    {
+      isr_stats.IrqOffMaxDuration = duration;
+      isr_stats.IrqOffMaxCaller = irq_off_caller;
+    }
+    if (NVIC_GetPendingIRQ(RADIO_INTR_NUM) != 0)
+    {
+      /* The radio ISR has waited for the end of this critical section */
+      isr_stats.HighDelayedCount++;
+    }
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
     /* When irq_counter reaches 0, restore primask bit */
     __set_PRIMASK(primask_bit);
   }
@@ -313,6 +409,13 @@ void LINKLAYER_PLAT_DisableIRQ(void)
     primask_bit= __get_PRIMASK();
   }
   __disable_irq();
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+  if(irq_counter == 0)
+  {
+    irq_off_start_cycle = DWT->CYCCNT;
+    irq_off_caller = (uint32_t)__builtin_return_address(0);
+  }
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
   irq_counter ++;
 }
 
@@ -457,6 +560,10 @@ void LINKLAYER_PLAT_StartRadioEvt(void)
 {
   __HAL_RCC_RADIO_CLK_SLEEP_ENABLE();
   NVIC_SetPriority(RADIO_INTR_NUM, RADIO_INTR_PRIO_HIGH);
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  radio_evt_active = 1;
+  radio_evt_count++;
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 #if (CFG_SCM_SUPPORTED == 1)
   scm_notifyradiostate(SCM_RADIO_ACTIVE);
 #endif /* CFG_SCM_SUPPORTED */
@@ -471,6 +578,9 @@ void LINKLAYER_PLAT_StopRadioEvt(void)
 {
   __HAL_RCC_RADIO_CLK_SLEEP_DISABLE();
   NVIC_SetPriority(RADIO_INTR_NUM, RADIO_INTR_PRIO_LOW);
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  radio_evt_active = 0;
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 #if (CFG_SCM_SUPPORTED == 1)
   scm_notifyradiostate(SCM_RADIO_NOT_ACTIVE);
 #endif /* CFG_SCM_SUPPORTED */
@@ -509,6 +619,9 @@ void LINKLAYER_PLAT_RCOStopClbr(void)
   scm_setsystemclock(SCM_USER_LL_HW_RCO_CLBR, HSE_16MHZ);
   while (LL_PWR_IsActiveFlag_VOS() == 0);
 #endif /* (CFG_SCM_SUPPORTED == 1) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  ll_sys_rco_clbr_end();
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 }
 
 /**
@@ -518,6 +631,9 @@ void LINKLAYER_PLAT_RCOStopClbr(void)
   */
 void LINKLAYER_PLAT_RequestTemperature(void)
 {
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  ll_sys_bg_temperature_measurement();
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 }
 
 /**
@@ -583,5 +699,227 @@ uint32_t LINKLAYER_PLAT_GetUDN(void)
 }
 
 /* USER CODE BEGIN LINKLAYER_PLAT 0 */
+#if (CFG_LL_ISR_STATS_SUPPORTED != 0)
+/**
+  * @brief  Radio high priority ISR measured : duration and nesting.
+  * @param  None
+  * @retval None
+  */
+HOT_CODE static void LINKLAYER_PLAT_RadioIsrWrapper(void)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t duration;
+
+  isr_nesting++;
+  if (isr_nesting > isr_stats.MaxNesting)
+  {
+    isr_stats.MaxNesting = isr_nesting;
+  }
+
+  if (radio_isr_user_callback != NULL)
+  {
+    radio_isr_user_callback();
+  }
+
+  duration = DWT->CYCCNT - start;
+  isr_nesting--;
+
+  isr_stats.HighCount++;
+  isr_stats.HighTotalDuration += duration;
+  if (duration > isr_stats.HighMaxDuration)
+  {
+    isr_stats.HighMaxDuration = duration;
+  }
+}
+
+/**
+  * @brief  Radio SW low ISR measured : latency from its trigger, duration and nesting.
+  * @param  None
+  * @retval None
+  */
+HOT_CODE static void LINKLAYER_PLAT_SwLowIsrWrapper(void)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t duration;
+
+  if (low_isr_triggered != 0)
+  {
+    low_isr_triggered = 0;
+    if ((start - low_isr_trigger_cycle) > isr_stats.LowMaxLatency)
+    {
+      isr_stats.LowMaxLatency = start - low_isr_trigger_cycle;
+    }
+  }
+
+  isr_nesting++;
+  if (isr_nesting > isr_stats.MaxNesting)
+  {
+    isr_stats.MaxNesting = isr_nesting;
+  }
+
+  if (low_isr_user_callback != NULL)
+  {
+    low_isr_user_callback();
+  }
+
+  duration = DWT->CYCCNT - start;
+  isr_nesting--;
+
+  isr_stats.LowCount++;
+  isr_stats.LowTotalDuration += duration;
+  if (duration > isr_stats.LowMaxDuration)
+  {
+    isr_stats.LowMaxDuration = duration;
+  }
+}
+
+/**
+  * @brief  Get the statistics of the radio ISRs.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void LINKLAYER_PLAT_GetIsrStats(LINKLAYER_PLAT_IsrStats_t * p_stats)
+{
+  LINKLAYER_PLAT_DisableIRQ();
+  *p_stats = isr_stats;
+  LINKLAYER_PLAT_EnableIRQ();
+}
+
+/**
+  * @brief  Reset the statistics of the radio ISRs.
+  * @param  None
+  * @retval None
+  */
+void LINKLAYER_PLAT_ResetIsrStats(void)
+{
+  LINKLAYER_PLAT_DisableIRQ();
+  memset(&isr_stats, 0, sizeof(isr_stats));
+  LINKLAYER_PLAT_EnableIRQ();
+}
+#else /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+
+/**
+  * @brief  Radio ISRs not measured : no statistics.
+  */
+void LINKLAYER_PLAT_GetIsrStats(LINKLAYER_PLAT_IsrStats_t * p_stats)
+{
+  memset(p_stats, 0, sizeof(LINKLAYER_PLAT_IsrStats_t));
+}
+
+/**
+  * @brief  Radio ISRs not measured : no statistics.
+  */
+void LINKLAYER_PLAT_ResetIsrStats(void)
+{
+}
+#endif /* (CFG_LL_ISR_STATS_SUPPORTED != 0) */
+
+#if (CFG_LL_DELAY_TIMER_SUPPORTED != 0)
+/**
+  * @brief  Delay timer initialization : one pulse mode, update only on the counter overflow. Its interrupt stays
+  *         disabled in the NVIC, it only becomes pending to wake the CPU from WFE.
+  * @param  None
+  * @retval None
+  */
+static void LINKLAYER_PLAT_DelayTimerInit(void)
+{
+  /* Cycle counter for the short delays */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM17);
+  LL_TIM_SetOnePulseMode(DELAY_TIMER, LL_TIM_ONEPULSEMODE_SINGLE);
+  LL_TIM_SetUpdateSource(DELAY_TIMER, LL_TIM_UPDATESOURCE_COUNTER);
+  LL_TIM_EnableIT_UPDATE(DELAY_TIMER);
+  NVIC_DisableIRQ(DELAY_TIMER_IRQn);
+
+  delay_timer_init = 1;
+}
+
+/**
+  * @brief  Wait on the delay timer with the CPU in WFE.
+  * @param  delay: delay in us, up to DELAY_TIMER_MAX_US.
+  * @retval None
+  */
+static void LINKLAYER_PLAT_DelayTimerWait(uint32_t delay)
+{
+  uint32_t timer_clock = HAL_RCC_GetPCLK2Freq();
+  uint32_t scr = SCB->SCR;
+
+  if (LL_RCC_GetAPB2Prescaler() != LL_RCC_APB2_DIV_1)
+  {
+    timer_clock *= 2U;
+  }
+
+  LL_TIM_SetPrescaler(DELAY_TIMER, (timer_clock / 1000000U) - 1U);
+  LL_TIM_SetAutoReload(DELAY_TIMER, delay - 1U);
+  LL_TIM_GenerateEvent_UPDATE(DELAY_TIMER);
+  LL_TIM_ClearFlag_UPDATE(DELAY_TIMER);
+  NVIC_ClearPendingIRQ(DELAY_TIMER_IRQn);
+
+  /* Wake up on the pending interrupt, in sleep mode only (the timer is stopped in the low power modes) */
+  SCB->SCR = (scr | SCB_SCR_SEVONPEND_Msk) & ~SCB_SCR_SLEEPDEEP_Msk;
+  LL_TIM_EnableCounter(DELAY_TIMER);
+
+  while (LL_TIM_IsActiveFlag_UPDATE(DELAY_TIMER) == 0U)
+  {
+    __WFE();
+  }
+
+  LL_TIM_ClearFlag_UPDATE(DELAY_TIMER);
+  NVIC_ClearPendingIRQ(DELAY_TIMER_IRQn);
+  SCB->SCR = scr;
+}
+
+/**
+  * @brief  Busy wait on the cycle counter, for the delays too short for the timer.
+  * @param  delay: delay in us.
+  * @retval None
+  */
+static void LINKLAYER_PLAT_DelayCycles(uint32_t delay)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t cycles = delay * (SystemCoreClock / 1000000U);
+
+  while ((DWT->CYCCNT - start) < cycles)
+  {
+  }
+}
+
+/**
+  * @brief  Get the statistics of the delays of the link layer.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void LINKLAYER_PLAT_GetDelayStats(LINKLAYER_PLAT_DelayStats_t * p_stats)
+{
+  LINKLAYER_PLAT_DisableIRQ();
+  *p_stats = delay_stats;
+  LINKLAYER_PLAT_EnableIRQ();
+}
+#else /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+
+/**
+  * @brief  Delays not measured : no statistics.
+  */
+void LINKLAYER_PLAT_GetDelayStats(LINKLAYER_PLAT_DelayStats_t * p_stats)
+{
+  memset(p_stats, 0, sizeof(LINKLAYER_PLAT_DelayStats_t));
+}
+#endif /* (CFG_LL_DELAY_TIMER_SUPPORTED != 0) */
+
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+/**
+  * @brief  Activity of the radio.
+  * @param  p_count: filled with the number of radio events started.
+  * @retval 1 if a radio event is running, 0 otherwise.
+  */
+uint8_t LINKLAYER_PLAT_GetRadioActivity(uint32_t * p_count)
+{
+  *p_count = radio_evt_count;
+
+  return radio_evt_active;
+}
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 
 /* USER CODE END LINKLAYER_PLAT 0 */
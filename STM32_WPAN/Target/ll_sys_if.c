@@ -27,6 +27,16 @@
 #include "ll_sys_if.h"
 #include "stm32_rtos.h"
 #include "utilities_common.h"
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+#include "evnt_schdlr_gnrc_if.h"
+#include "stm32_timer.h"
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+#include "adc_ctrl.h"
+#include "adc_ctrl_conf.h"
+#include "temp_measurement.h"
+#include "stm32_timer.h"
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 
 /* Private defines -----------------------------------------------------------*/
 /* Radio event scheduling method - must be set at 1 */
@@ -34,6 +44,12 @@
 #define NEXT_EVENT_SCHEDULING_FROM_ISR      (1)
 
 /* USER CODE BEGIN PD */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) && (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/* State of the temperature batch */
+#define LL_TEMP_BATCH_IDLE                  (0u)
+#define LL_TEMP_BATCH_RUNNING               (1u)
+#define LL_TEMP_BATCH_DONE                  (2u)
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) && (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
 
 /* USER CODE END PD */
 
@@ -49,6 +65,33 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+static volatile uint8_t ll_bg_process_pending = 0;
+static volatile uint8_t ll_bg_process_running = 0;
+static LL_SYS_BgStats_t ll_bg_stats;
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+static LL_SYS_CoexStats_t ll_coex_stats = { .AirtimeShare = CFG_LL_COEX_ZIGBEE_AIRTIME };
+static uint32_t ll_coex_window_start;
+static uint32_t ll_coex_window_airtime;
+/* Scheduler callbacks of the MAC, replaced at the registration of its events */
+static uint32_t (*ll_coex_mac_strtd_cbk)(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr);
+static uint32_t (*ll_coex_mac_blckd_cbk)(extrnl_evnt_state_e blocked_state);
+static uint32_t (*ll_coex_mac_idle_strtd_cbk)(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr);
+static uint32_t (*ll_coex_mac_idle_abortd_cbk)(void);
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+static UTIL_TIMER_Object_t ll_temp_meas_timer;
+static LL_SYS_RcoClbrStats_t ll_rco_clbr_stats;
+static volatile uint8_t ll_rco_clbr_end_pending = 0;
+static uint8_t ll_rco_clbr_requested = 0;
+static uint8_t ll_rco_clbr_deferred = 0;
+static uint32_t ll_radio_evt_count = 0;
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+static ADCCTRL_Batch_t ll_temp_batch;
+static volatile uint8_t ll_temp_batch_state = LL_TEMP_BATCH_IDLE;
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 
 /* USER CODE END PV */
 
@@ -61,6 +104,28 @@
 static void ll_sys_sleep_clock_source_selection(void);
 
 /* USER CODE BEGIN PFP */
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+static void ll_sys_bg_process_task(void);
+static void ll_sys_bg_process_request(void);
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+ext_evnt_hndl_t __real_evnt_schdlr_rgstr_gnrc_evnt(extrnl_evnt_st_t * p_extrnl_evnt_st);
+ext_evnt_hndl_t __real_evnt_schdlr_rgstr_on_idle_evnt(extrnl_evnt_st_t * p_extrnl_evnt_st);
+static void ll_sys_coex_window_update(void);
+static uint32_t ll_sys_coex_mac_strtd(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr);
+static uint32_t ll_sys_coex_mac_blckd(extrnl_evnt_state_e blocked_state);
+static uint32_t ll_sys_coex_mac_idle_strtd(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr);
+static uint32_t ll_sys_coex_mac_idle_abortd(void);
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+static void ll_sys_bg_temperature_measurement_init(void);
+static void ll_sys_temperature_task(void);
+static void ll_sys_temperature_timer_elapsed(void * arg);
+static int16_t ll_sys_temperature_measure(void);
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+static void ll_sys_temperature_batch_end(ADCCTRL_Batch_t * p_batch);
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 
 /* USER CODE END PFP */
 
@@ -79,8 +144,17 @@ static void ll_sys_sleep_clock_source_selection(void);
   */
 void ll_sys_bg_process_init(void)
 {
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+  /* Cycle counter for the time budget */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  /* Register Link Layer task */
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), UTIL_SEQ_RFU, ll_sys_bg_process_task);
+#else
   /* Register Link Layer task */
-  UTIL_SEQ_RegTask(1U << CFG_TASK_LINK_LAYER, UTIL_SEQ_RFU, ll_sys_bg_process);
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), UTIL_SEQ_RFU, ll_sys_bg_process);
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
 }
 
 /**
@@ -90,7 +164,11 @@ void ll_sys_bg_process_init(void)
   */
 void ll_sys_schedule_bg_process(void)
 {
-  UTIL_SEQ_SetTask(1U << CFG_TASK_LINK_LAYER, TASK_PRIO_LINK_LAYER);
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+  ll_sys_bg_process_request();
+#else
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), TASK_PRIO_LINK_LAYER);
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
 }
 
 /**
@@ -100,7 +178,11 @@ void ll_sys_schedule_bg_process(void)
   */
 void ll_sys_schedule_bg_process_isr(void)
 {
-  UTIL_SEQ_SetTask(1U << CFG_TASK_LINK_LAYER, TASK_PRIO_LINK_LAYER);
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+  ll_sys_bg_process_request();
+#else
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), TASK_PRIO_LINK_LAYER);
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
 }
 
 /**
@@ -129,10 +211,568 @@ void ll_sys_config_params(void)
   /* Link Layer power table */
   ll_intf_cmn_select_tx_power_table(CFG_RF_TX_POWER_TABLE_ID);
 /* USER CODE BEGIN ll_sys_config_params_2 */
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+  ll_sys_bg_temperature_measurement_init();
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
 
 /* USER CODE END ll_sys_config_params_2 */
 }
 
+#if (CFG_BLE_HOST_SUPPORTED != 0)
+/**
+  * @brief  Link Layer configuration after a HCI reset of the BLE host (the reset restores the defaults).
+  * @param  None
+  * @retval None
+  */
+void ll_sys_reset(void)
+{
+  /* Apply the selected link layer sleep timer source */
+  ll_sys_sleep_clock_source_selection();
+
+  /* Link Layer power table */
+  ll_intf_cmn_select_tx_power_table(CFG_RF_TX_POWER_TABLE_ID);
+}
+#endif /* (CFG_BLE_HOST_SUPPORTED != 0) */
+
+/* USER CODE BEGIN FD */
+#if (CFG_LL_BG_COALESCING_SUPPORTED != 0)
+/**
+  * @brief  Request a Link Layer background process iteration : the task is posted only if it is not already
+  *         pending, nor running (the running task loops on the request).
+  * @param  None
+  * @retval None
+  */
+static void ll_sys_bg_process_request(void)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  if (ll_bg_process_pending != 0)
+  {
+    ll_bg_stats.CoalescedCount++;
+  }
+  else
+  {
+    ll_bg_process_pending = 1;
+    if (ll_bg_process_running == 0)
+    {
+      ll_bg_stats.PostCount++;
+      UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), TASK_PRIO_LINK_LAYER);
+    }
+  }
+
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+  * @brief  Link Layer background task : runs the background process while new iterations are requested, up to
+  *         CFG_LL_BG_PROCESS_BUDGET_US, then yields to the other tasks.
+  * @param  None
+  * @retval None
+  */
+static void ll_sys_bg_process_task(void)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t budget = CFG_LL_BG_PROCESS_BUDGET_US * (SystemCoreClock / 1000000U);
+  uint32_t iterations = 0;
+
+  ll_bg_process_running = 1;
+  do
+  {
+    ll_bg_process_pending = 0;
+    ll_sys_bg_process();
+    iterations++;
+  }
+  while ((ll_bg_process_pending != 0) && ((DWT->CYCCNT - start) < budget));
+
+  UTILS_ENTER_CRITICAL_SECTION();
+
+  ll_bg_process_running = 0;
+  ll_bg_stats.RunCount++;
+  ll_bg_stats.IterationCount += iterations;
+  if (iterations > ll_bg_stats.MaxIterations)
+  {
+    ll_bg_stats.MaxIterations = iterations;
+  }
+  if (ll_bg_process_pending != 0)
+  {
+    /* Budget exhausted : the remaining work runs at the next turn of the sequencer */
+    ll_bg_stats.BudgetExceededCount++;
+    ll_bg_stats.PostCount++;
+    UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_LINK_LAYER ), TASK_PRIO_LINK_LAYER);
+  }
+
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+  * @brief  Get the statistics of the Link Layer background task.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void ll_sys_bg_get_stats(LL_SYS_BgStats_t * p_stats)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_stats = ll_bg_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+#else /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+
+/**
+  * @brief  Link Layer background task not coalesced : no statistics.
+  */
+void ll_sys_bg_get_stats(LL_SYS_BgStats_t * p_stats)
+{
+  memset(p_stats, 0, sizeof(LL_SYS_BgStats_t));
+}
+#endif /* (CFG_LL_BG_COALESCING_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0)
+/**
+  * @brief  Registration of a radio event of the MAC in the BLE/802.15.4 event scheduler (linker --wrap) : the
+  *         event is raised to high priority while the MAC is within its airtime share of the current window (or
+  *         always when the Zigbee protection is on), and its callbacks are interposed for the statistics.
+  *         The scheduler copies the event, the structure of the MAC is restored after the registration.
+  * @param  p_extrnl_evnt_st: event to register.
+  * @retval Handle of the event, NULL if not registered.
+  */
+ext_evnt_hndl_t __wrap_evnt_schdlr_rgstr_gnrc_evnt(extrnl_evnt_st_t * p_extrnl_evnt_st)
+{
+  extrnl_evnt_st_t event = *p_extrnl_evnt_st;
+  ext_evnt_hndl_t handle;
+
+  ll_sys_coex_window_update();
+  ll_coex_stats.MacEventCount++;
+
+  if ((ll_coex_mac_strtd_cbk == NULL) || (ll_coex_mac_strtd_cbk == p_extrnl_evnt_st->evnt_strtd_cbk))
+  {
+    ll_coex_mac_strtd_cbk = p_extrnl_evnt_st->evnt_strtd_cbk;
+    p_extrnl_evnt_st->evnt_strtd_cbk = ll_sys_coex_mac_strtd;
+  }
+  if ((p_extrnl_evnt_st->evnt_blckd_cbk != NULL)
+      && ((ll_coex_mac_blckd_cbk == NULL) || (ll_coex_mac_blckd_cbk == p_extrnl_evnt_st->evnt_blckd_cbk)))
+  {
+    ll_coex_mac_blckd_cbk = p_extrnl_evnt_st->evnt_blckd_cbk;
+    p_extrnl_evnt_st->evnt_blckd_cbk = ll_sys_coex_mac_blckd;
+  }
+
+  if ((p_extrnl_evnt_st->priority == PRIORITY_DEFAULT)
+      && ((ll_coex_stats.ZigbeeProtect != 0)
+          || (ll_coex_window_airtime < ((uint32_t)ll_coex_stats.AirtimeShare * CFG_LL_COEX_WINDOW_MS * 10U))))
+  {
+    p_extrnl_evnt_st->priority = PRIORITY_HIGH;
+    ll_coex_stats.MacRaisedCount++;
+  }
+
+  handle = __real_evnt_schdlr_rgstr_gnrc_evnt(p_extrnl_evnt_st);
+  *p_extrnl_evnt_st = event;
+
+  return handle;
+}
+
+/**
+  * @brief  Registration of the receiver on idle of the MAC (linker --wrap) : its callbacks are interposed to
+  *         count the receive windows preempted by the BLE events.
+  * @param  p_extrnl_evnt_st: event to register.
+  * @retval Handle of the event, NULL if not registered.
+  */
+ext_evnt_hndl_t __wrap_evnt_schdlr_rgstr_on_idle_evnt(extrnl_evnt_st_t * p_extrnl_evnt_st)
+{
+  extrnl_evnt_st_t event = *p_extrnl_evnt_st;
+  ext_evnt_hndl_t handle;
+
+  if (ll_coex_mac_idle_strtd_cbk == NULL)
+  {
+    ll_coex_mac_idle_strtd_cbk = p_extrnl_evnt_st->evnt_strtd_cbk;
+    ll_coex_mac_idle_abortd_cbk = p_extrnl_evnt_st->evnt_abortd_cbk;
+  }
+  if ((ll_coex_mac_idle_strtd_cbk == p_extrnl_evnt_st->evnt_strtd_cbk)
+      && (ll_coex_mac_idle_abortd_cbk == p_extrnl_evnt_st->evnt_abortd_cbk))
+  {
+    p_extrnl_evnt_st->evnt_strtd_cbk = ll_sys_coex_mac_idle_strtd;
+    p_extrnl_evnt_st->evnt_abortd_cbk = ll_sys_coex_mac_idle_abortd;
+  }
+
+  handle = __real_evnt_schdlr_rgstr_on_idle_evnt(p_extrnl_evnt_st);
+  *p_extrnl_evnt_st = event;
+
+  return handle;
+}
+
+/**
+  * @brief  Close the airtime window of CFG_LL_COEX_WINDOW_MS when elapsed.
+  * @param  None
+  * @retval None
+  */
+static void ll_sys_coex_window_update(void)
+{
+  uint32_t now = UTIL_TIMER_GetCurrentTime();
+  uint32_t elapsed = now - ll_coex_window_start;
+
+  if (elapsed >= CFG_LL_COEX_WINDOW_MS)
+  {
+    ll_coex_stats.WindowCount++;
+    ll_coex_stats.LastWindowShare = (uint8_t)(MIN(100U, ll_coex_window_airtime / (elapsed * 10U)));
+    ll_coex_window_start = now;
+    ll_coex_window_airtime = 0;
+  }
+}
+
+/**
+  * @brief  Grant of a MAC event : its slot counts in the airtime of the window.
+  */
+static uint32_t ll_sys_coex_mac_strtd(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr)
+{
+  ll_sys_coex_window_update();
+  ll_coex_stats.MacGrantCount++;
+  ll_coex_window_airtime += slot_durn;
+
+  return ll_coex_mac_strtd_cbk(evnt_hndl, slot_durn, priv_data_ptr);
+}
+
+/**
+  * @brief  MAC event blocked : counted, with the ones lost to a higher priority event.
+  */
+static uint32_t ll_sys_coex_mac_blckd(extrnl_evnt_state_e blocked_state)
+{
+  ll_coex_stats.MacBlockedCount++;
+  if (blocked_state == STATE_BLOCKED_PRIORITY)
+  {
+    ll_coex_stats.MacBlockedPriorityCount++;
+  }
+
+  return ll_coex_mac_blckd_cbk(blocked_state);
+}
+
+/**
+  * @brief  Receiver on idle granted.
+  */
+static uint32_t ll_sys_coex_mac_idle_strtd(ext_evnt_hndl_t evnt_hndl, uint32_t slot_durn, void * priv_data_ptr)
+{
+  ll_coex_stats.MacIdleGrantCount++;
+
+  return ll_coex_mac_idle_strtd_cbk(evnt_hndl, slot_durn, priv_data_ptr);
+}
+
+/**
+  * @brief  Receiver on idle aborted for a scheduled event.
+  */
+static uint32_t ll_sys_coex_mac_idle_abortd(void)
+{
+  ll_coex_stats.MacIdleAbortCount++;
+
+  return ll_coex_mac_idle_abortd_cbk();
+}
+
+/**
+  * @brief  Get the statistics of the BLE/802.15.4 arbitration.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void ll_sys_coex_get_stats(LL_SYS_CoexStats_t * p_stats)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_stats = ll_coex_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+  * @brief  Set the airtime share of each window served to the MAC at high priority.
+  * @param  share: share in %, 0 for the default CFG_LL_COEX_ZIGBEE_AIRTIME.
+  * @retval None
+  */
+void ll_sys_coex_set_airtime_share(uint8_t share)
+{
+  ll_coex_stats.AirtimeShare = (share == 0U) ? CFG_LL_COEX_ZIGBEE_AIRTIME : MIN(share, 100U);
+}
+
+/**
+  * @brief  Zigbee protection : all the MAC events at high priority (e.g. while a BLE commissioning runs, so that
+  *         the Zigbee routing is not degraded by the connection events).
+  * @param  enable: 1 to protect the Zigbee traffic, 0 to come back to the airtime share.
+  * @retval None
+  */
+void ll_sys_coex_set_zigbee_protect(uint8_t enable)
+{
+  ll_coex_stats.ZigbeeProtect = (enable != 0U) ? 1U : 0U;
+}
+#else /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+
+/**
+  * @brief  802.15.4 only link layer : no arbitration.
+  */
+void ll_sys_coex_get_stats(LL_SYS_CoexStats_t * p_stats)
+{
+  memset(p_stats, 0, sizeof(LL_SYS_CoexStats_t));
+}
+
+/**
+  * @brief  802.15.4 only link layer : no arbitration.
+  */
+void ll_sys_coex_set_airtime_share(uint8_t share)
+{
+  UNUSED(share);
+}
+
+/**
+  * @brief  802.15.4 only link layer : no arbitration.
+  */
+void ll_sys_coex_set_zigbee_protect(uint8_t enable)
+{
+  UNUSED(enable);
+}
+#endif /* (CFG_ZIGBEE_CONCURRENT_SUPPORTED != 0) */
+
+#if (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1)
+/**
+  * @brief  Temperature measurements initialization : the ADC is registered, the link layer is told that the temperature
+  *         is available and, with the sleep timer on the RCO, its periodic calibration is slowed down as the
+  *         recalibrations are then requested on the temperature drifts.
+  * @param  None
+  * @retval None
+  */
+static void ll_sys_bg_temperature_measurement_init(void)
+{
+  (void)ADCCTRL_Init();
+  if (TEMPMEAS_Init() != TEMPMEAS_OK)
+  {
+    LOG_ERROR_SYSTEM("Error, temperature measurement initialization failed.");
+    return;
+  }
+
+  UTIL_SEQ_RegTask(UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS ), UTIL_SEQ_RFU, ll_sys_temperature_task);
+  ll_intf_cmn_set_temperature_sensor_state();
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+  /* The measurements of the task run by DMA, this first one is polled */
+  ll_temp_batch.p_Handle = &LLTempRequest_Handle;
+  ll_temp_batch.Callback = &ll_sys_temperature_batch_end;
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+  ll_rco_clbr_stats.Temperature = ll_sys_temperature_measure();
+  ll_rco_clbr_stats.ClbrTemperature = ll_rco_clbr_stats.Temperature;
+
+  if (LL_RCC_RADIO_GetSleepTimerClockSource() == LL_RCC_RADIOSLEEPSOURCE_LSI)
+  {
+    ll_rco_clbr_stats.RcoSleepClock = 1U;
+    (void)ll_intf_cmn_le_set_rco_clbr_evnt_params(CFG_LL_RCO_CLBR_DURATION, CFG_LL_RCO_CLBR_INTERVAL_IDLE);
+  }
+
+  (void)UTIL_TIMER_Create(&ll_temp_meas_timer, CFG_LL_TEMP_MEAS_PERIOD, UTIL_TIMER_PERIODIC,
+                          &ll_sys_temperature_timer_elapsed, NULL);
+  (void)UTIL_TIMER_Start(&ll_temp_meas_timer);
+}
+
+/**
+  * @brief  Temperature requested by the link layer : measured in the task.
+  * @param  None
+  * @retval None
+  */
+void ll_sys_bg_temperature_measurement(void)
+{
+  ll_rco_clbr_stats.LlRequestCount++;
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS ), TASK_PRIO_TEMP_MEAS);
+}
+
+/**
+  * @brief  End of an RCO calibration (link layer context) : its temperature is recorded in the task.
+  * @param  None
+  * @retval None
+  */
+void ll_sys_rco_clbr_end(void)
+{
+  ll_rco_clbr_end_pending = 1;
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS ), TASK_PRIO_TEMP_MEAS);
+}
+
+/**
+  * @brief  Periodic temperature measurement.
+  * @param  arg: not used.
+  * @retval None
+  */
+static void ll_sys_temperature_timer_elapsed(void * arg)
+{
+  UNUSED(arg);
+
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS ), TASK_PRIO_TEMP_MEAS);
+}
+
+/**
+  * @brief  Measure the temperature and give it to the link layer.
+  * @param  None
+  * @retval Temperature in Celsius degrees.
+  */
+static int16_t ll_sys_temperature_measure(void)
+{
+  uint16_t temperature_value = 0;
+  ADCCTRL_Cmd_Status_t status;
+
+  /* Enter limited critical section : the link layer interrupts are held during the conversion */
+  UTILS_ENTER_LIMITED_CRITICAL_SECTION(RCC_INTR_PRIO << 4U);
+
+  (void)ADCCTRL_RequestIpState(&LLTempRequest_Handle, ADC_ON);
+  status = ADCCTRL_RequestTemperature(&LLTempRequest_Handle, &temperature_value);
+  (void)ADCCTRL_RequestIpState(&LLTempRequest_Handle, ADC_OFF);
+
+  /* No conversion (ADC busy) : the last temperature is kept */
+  if (status != ADCCTRL_OK)
+  {
+    UTILS_EXIT_LIMITED_CRITICAL_SECTION();
+    return ll_rco_clbr_stats.Temperature;
+  }
+
+  ll_intf_cmn_set_temperature_value(temperature_value);
+
+  UTILS_EXIT_LIMITED_CRITICAL_SECTION();
+
+  ll_rco_clbr_stats.MeasureCount++;
+
+  return (int16_t)temperature_value;
+}
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/**
+  * @brief  End of the temperature batch (DMA interrupt) : its result is processed by the task.
+  * @param  p_batch: the temperature batch.
+  * @retval None
+  */
+static void ll_sys_temperature_batch_end(ADCCTRL_Batch_t * p_batch)
+{
+  UNUSED(p_batch);
+
+  ll_temp_batch_state = LL_TEMP_BATCH_DONE;
+  UTIL_SEQ_SetTask(UTIL_SEQ_TASK_BM( CFG_TASK_TEMP_MEAS ), TASK_PRIO_TEMP_MEAS);
+}
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+/**
+  * @brief  Temperature task : a finished calibration is recorded (and the slow period restored if it was requested),
+  *         a drift of CFG_LL_RCO_CLBR_TEMP_DRIFT since the last calibration requests a new one while no radio event
+  *         runs, nor ran since the previous measurement, or after CFG_LL_RCO_CLBR_DEFER_MAX busy measurements.
+  *         The link layer only exposes the period of the calibration events : a recalibration is requested by
+  *         shortening it to CFG_LL_RCO_CLBR_INTERVAL_DRIFT until the next calibration ends.
+  * @param  None
+  * @retval None
+  */
+static void ll_sys_temperature_task(void)
+{
+  int16_t temperature;
+  int16_t drift;
+  uint32_t evt_count;
+  uint8_t radio_busy;
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+  /* The batch is started here, the task is posted again at its end : the requests meanwhile share its result */
+  if (ll_temp_batch_state != LL_TEMP_BATCH_DONE)
+  {
+    if (ll_temp_batch_state == LL_TEMP_BATCH_IDLE)
+    {
+      ll_temp_batch_state = LL_TEMP_BATCH_RUNNING;
+      if (ADCCTRL_SubmitBatch(&ll_temp_batch) != ADCCTRL_OK)
+      {
+        ll_temp_batch_state = LL_TEMP_BATCH_IDLE;
+      }
+    }
+    return;
+  }
+
+  ll_temp_batch_state = LL_TEMP_BATCH_IDLE;
+  if (ll_temp_batch.Status == ADCCTRL_OK)
+  {
+    temperature = (int16_t)ADCCTRL_ConvertTemperature(&LLTempRequest_Handle, ll_temp_batch.Average);
+
+    UTILS_ENTER_LIMITED_CRITICAL_SECTION(RCC_INTR_PRIO << 4U);
+    ll_intf_cmn_set_temperature_value((uint16_t)temperature);
+    UTILS_EXIT_LIMITED_CRITICAL_SECTION();
+
+    ll_rco_clbr_stats.MeasureCount++;
+  }
+  else
+  {
+    temperature = ll_sys_temperature_measure();
+  }
+#else
+  temperature = ll_sys_temperature_measure();
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+  ll_rco_clbr_stats.Temperature = temperature;
+
+  if (ll_rco_clbr_end_pending != 0)
+  {
+    ll_rco_clbr_end_pending = 0;
+    ll_rco_clbr_stats.ClbrCount++;
+    ll_rco_clbr_stats.ClbrTemperature = temperature;
+    if (ll_rco_clbr_requested != 0)
+    {
+      ll_rco_clbr_requested = 0;
+      (void)ll_intf_cmn_le_set_rco_clbr_evnt_params(CFG_LL_RCO_CLBR_DURATION, CFG_LL_RCO_CLBR_INTERVAL_IDLE);
+    }
+  }
+
+  if ((ll_rco_clbr_stats.RcoSleepClock == 0U) || (ll_rco_clbr_requested != 0))
+  {
+    return;
+  }
+
+  radio_busy = LINKLAYER_PLAT_GetRadioActivity(&evt_count);
+  radio_busy |= (evt_count != ll_radio_evt_count) ? 1U : 0U;
+  ll_radio_evt_count = evt_count;
+
+  drift = temperature - ll_rco_clbr_stats.ClbrTemperature;
+  if ((drift < CFG_LL_RCO_CLBR_TEMP_DRIFT) && (drift > -CFG_LL_RCO_CLBR_TEMP_DRIFT))
+  {
+    ll_rco_clbr_deferred = 0;
+    return;
+  }
+
+  if (radio_busy != 0U)
+  {
+    if (ll_rco_clbr_deferred < CFG_LL_RCO_CLBR_DEFER_MAX)
+    {
+      ll_rco_clbr_deferred++;
+      ll_rco_clbr_stats.DeferredCount++;
+      return;
+    }
+    ll_rco_clbr_stats.ForcedCount++;
+  }
+
+  ll_rco_clbr_deferred = 0;
+  ll_rco_clbr_requested = 1;
+  ll_rco_clbr_stats.ClbrRequestCount++;
+  (void)ll_intf_cmn_le_set_rco_clbr_evnt_params(CFG_LL_RCO_CLBR_DURATION, CFG_LL_RCO_CLBR_INTERVAL_DRIFT);
+}
+
+/**
+  * @brief  Get the statistics of the temperature measurements and RCO recalibrations.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void ll_sys_rco_clbr_get_stats(LL_SYS_RcoClbrStats_t * p_stats)
+{
+  *p_stats = ll_rco_clbr_stats;
+}
+#else /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+
+/**
+  * @brief  No temperature measurement : no statistics.
+  */
+void ll_sys_rco_clbr_get_stats(LL_SYS_RcoClbrStats_t * p_stats)
+{
+  memset(p_stats, 0, sizeof(LL_SYS_RcoClbrStats_t));
+}
+#endif /* (USE_TEMPERATURE_BASED_RADIO_CALIBRATION == 1) */
+
+/**
+  * @brief  Select the TX power table, and so the PA supply setting, after the one of CFG_RF_TX_POWER_TABLE_ID applied
+  *         at the initialization. The TX power shall then be set again.
+  * @param  table_id: TX power table ID (0 : max power, 1 : low power).
+  * @retval 0 if Ok, else error code of the link layer.
+  */
+uint8_t ll_sys_select_tx_power_table(uint8_t table_id)
+{
+  return ll_intf_cmn_select_tx_power_table(table_id);
+}
+/* USER CODE END FD */
+
 void ll_sys_sleep_clock_source_selection(void)
 {
   uint16_t freq_value = 0;
@@ -30,11 +30,80 @@ extern "C" {
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <stdint.h>
 
 /* USER CODE END Includes */
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
+/* Statistics of the radio ISRs (CPU cycles) */
+typedef struct
+{
+  uint32_t    HighCount;              /* Radio high priority ISR calls */
+  uint32_t    HighMaxDuration;
+  uint64_t    HighTotalDuration;
+  uint32_t    HighDelayedCount;       /* Radio ISR pending at the end of a DisableIRQ section */
+  uint32_t    LowCount;               /* SW low ISR calls */
+  uint32_t    LowMaxDuration;
+  uint64_t    LowTotalDuration;
+  uint32_t    LowMaxLatency;          /* From LINKLAYER_PLAT_TriggerSwLowIT to the ISR entry */
+  uint32_t    LowRetriggerCount;      /* Triggers while the SW low ISR runs */
+  uint32_t    LowHandoffCount;        /* Nested high priority triggers run after the ISR at low priority */
+  uint32_t    MaxNesting;             /* Radio ISRs running at the same time */
+  uint32_t    IrqOffMaxDuration;      /* Longest LINKLAYER_PLAT_DisableIRQ critical section */
+  uint32_t    IrqOffMaxCaller;        /* Return address of its LINKLAYER_PLAT_DisableIRQ */
+} LINKLAYER_PLAT_IsrStats_t;
+
+/* Statistics of the delays of the link layer */
+typedef struct
+{
+  uint32_t    Count;                  /* LINKLAYER_PLAT_DelayUs calls */
+  uint32_t    TimerCount;             /* Delays timed by the hardware timer, CPU in WFE */
+  uint32_t    MaxDelay;               /* Longest delay requested (us) */
+  uint64_t    TotalDelay;             /* Time spent in the delays (us) */
+} LINKLAYER_PLAT_DelayStats_t;
+
+/* Statistics of the link layer background task */
+typedef struct
+{
+  uint32_t    PostCount;              /* Task posted to the sequencer */
+  uint32_t    CoalescedCount;         /* Requests while the task was already pending */
+  uint32_t    RunCount;               /* Task runs */
+  uint32_t    IterationCount;         /* Background process iterations */
+  uint32_t    MaxIterations;          /* Iterations in a single run */
+  uint32_t    BudgetExceededCount;    /* Runs yielding with work still requested */
+} LL_SYS_BgStats_t;
+
+/* Statistics of the arbitration between the BLE and 802.15.4 radio events (concurrent build) */
+typedef struct
+{
+  uint32_t    MacEventCount;          /* MAC radio events registered in the scheduler */
+  uint32_t    MacRaisedCount;         /* MAC events raised in priority (airtime share or protection) */
+  uint32_t    MacGrantCount;          /* MAC events granted */
+  uint32_t    MacBlockedCount;        /* MAC events blocked */
+  uint32_t    MacBlockedPriorityCount;/* MAC events blocked by a higher priority (BLE) event */
+  uint32_t    MacIdleGrantCount;      /* Receiver on idle windows granted */
+  uint32_t    MacIdleAbortCount;      /* Receiver on idle windows aborted for another event */
+  uint32_t    WindowCount;            /* Airtime windows of CFG_LL_COEX_WINDOW_MS completed */
+  uint8_t     LastWindowShare;        /* MAC airtime granted in the last window (%) */
+  uint8_t     AirtimeShare;           /* MAC airtime share served at high priority (%) */
+  uint8_t     ZigbeeProtect;          /* All the MAC events at high priority */
+} LL_SYS_CoexStats_t;
+
+/* Statistics of the temperature measurements and of the RCO recalibrations */
+typedef struct
+{
+  uint32_t    MeasureCount;           /* Temperature measurements */
+  uint32_t    LlRequestCount;         /* Measurements requested by the link layer */
+  uint32_t    ClbrRequestCount;       /* RCO recalibrations requested on a temperature drift */
+  uint32_t    DeferredCount;          /* Measurements with a recalibration waiting for the radio idle */
+  uint32_t    ForcedCount;            /* Recalibrations requested after CFG_LL_RCO_CLBR_DEFER_MAX busy measurements */
+  uint32_t    ClbrCount;              /* RCO calibrations done (periodic or requested) */
+  int16_t     Temperature;            /* Last measurement (Celsius degrees) */
+  int16_t     ClbrTemperature;        /* Temperature at the last RCO calibration */
+  uint8_t     RcoSleepClock;          /* Sleep timer on the RCO : recalibrations scheduled on the drifts */
+} LL_SYS_RcoClbrStats_t;
+
 
 /* USER CODE END ET */
 
@@ -55,6 +124,18 @@ extern "C" {
 
 /* Exported functions prototypes ---------------------------------------------*/
 /* USER CODE BEGIN EFP */
+void LINKLAYER_PLAT_GetIsrStats(LINKLAYER_PLAT_IsrStats_t * p_stats);
+void LINKLAYER_PLAT_ResetIsrStats(void);
+void LINKLAYER_PLAT_GetDelayStats(LINKLAYER_PLAT_DelayStats_t * p_stats);
+void ll_sys_bg_get_stats(LL_SYS_BgStats_t * p_stats);
+void ll_sys_coex_get_stats(LL_SYS_CoexStats_t * p_stats);
+void ll_sys_coex_set_airtime_share(uint8_t share);
+void ll_sys_coex_set_zigbee_protect(uint8_t enable);
+void ll_sys_rco_clbr_get_stats(LL_SYS_RcoClbrStats_t * p_stats);
+uint8_t LINKLAYER_PLAT_GetRadioActivity(uint32_t * p_count);
+void ll_sys_bg_temperature_measurement(void);
+void ll_sys_rco_clbr_end(void);
+uint8_t ll_sys_select_tx_power_table(uint8_t table_id);
 
 /* USER CODE END EFP */
 
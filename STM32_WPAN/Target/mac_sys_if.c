@@ -24,11 +24,22 @@
 #include "log_module.h"
 #include "stm32_rtos.h"
 #include "st_mac_802_15_4_sys.h"
+#include "mac_sys_if.h"
+#include "stm32_timer.h"
+#include "ral.h"
+#include "app_frame_log.h"
+#include "st_mac_802_15_4_sap.h"
 
 extern void mac_baremetal_run(void);
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* Addressing modes of the MAC primitives */
+#define MAC_SYS_ADDR_MODE_SHORT       (0x02u)
+#define MAC_SYS_ADDR_MODE_EXT         (0x03u)
+
+/* Handle of an association response in the source address match frames (confirmed by MLME-COMM-STATUS) */
+#define MAC_SYS_SRC_MATCH_ASSOC_HANDLE  (0xFFFFu)
 
 /* USER CODE END PD */
 
@@ -39,6 +50,39 @@ extern void mac_baremetal_run(void);
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+static MAC_SYS_Stats_t            mac_stats;
+static MAC_SYS_Counters_t         mac_stats_interval_start;
+static UTIL_TIMER_Object_t        mac_stats_timer;
+
+/* Callbacks of the MAC to the radio abstraction layer, called after the counting */
+static ral_cbk_dispatch_tbl_st    mac_ral_cbk_mac;
+static ral_cbk_dispatch_tbl_st    mac_ral_cbk_counted;
+static uint8_t                    mac_ral_cbk_set;
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+static MAC_SYS_BufferStats_t      mac_buffer_stats;
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+/* Indirect frame held by the MAC for a child until it polls */
+typedef struct
+{
+  uint16_t    handle;                 /* MSDU handle, MAC_SYS_SRC_MATCH_ASSOC_HANDLE, or 0 when the slot is free */
+  uint8_t     addr_mode;              /* MAC_SYS_ADDR_MODE_SHORT or MAC_SYS_ADDR_MODE_EXT, 0 when the slot is free */
+  uint8_t     addr[8];
+} mac_sys_src_match_frame_t;
+
+static mac_sys_src_match_frame_t  mac_src_match_frames[CFG_MAC_SRC_MATCH_FRAME_NB];
+static MAC_SYS_SrcMatchStats_t    mac_src_match_stats;
+static ral_instance_t             mac_ral_instance;
+static uint8_t                    mac_ral_instance_set;
+
+/* Callbacks of the Zigbee stack to the MAC, called after the update of the source address match table */
+static ST_MAC_callbacks_t         mac_src_match_cbk_nwk;
+static ST_MAC_callbacks_t         mac_src_match_cbk;
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
 
 /* USER CODE END PV */
 
@@ -47,6 +91,57 @@ extern void mac_baremetal_run(void);
 
 /* USER CODE END GV */
 
+/* Private functions prototypes-----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+/* Radio abstraction layer initialization, wrapped by the linker (--wrap) */
+extern ral_instance_t __real_ral_init(ral_cbk_dispatch_tbl_st * ptr_cbk_dispatch_tbl);
+ral_instance_t        __wrap_ral_init(ral_cbk_dispatch_tbl_st * ptr_cbk_dispatch_tbl);
+
+/* Buffer pool and queues of the MAC library (st_mac_buffer_management.h, st_mac_queue.h, st_mac_802_15_4_core_config.h),
+ * wrapped by the linker (--wrap) */
+typedef struct
+{
+  uint8_t head;
+  uint8_t tail;
+  uint8_t total_capacity;
+  uint8_t current_capacity;
+} mac_sys_queue_t;
+
+extern const uint8_t g_Small_Buffer_Size_c;
+extern const uint8_t g_Large_Buffer_Size_c;
+extern const uint8_t g_Total_Number_Of_Small_Buffers_c;
+extern const uint8_t g_Total_Number_Of_Large_Buffers_c;
+
+extern uint8_t  buffMgmt_getNumberofFreeBuffers(uint8_t size);
+extern uint8_t  __real_buffMgmt_allocateBuffer(uint8_t size);
+uint8_t         __wrap_buffMgmt_allocateBuffer(uint8_t size);
+extern uint8_t  __real_queueMgmt_enqueue(mac_sys_queue_t * p_queue, uint8_t buffer_id);
+uint8_t         __wrap_queueMgmt_enqueue(mac_sys_queue_t * p_queue, uint8_t buffer_id);
+
+/* MAC primitives of the Zigbee stack, wrapped by the linker (--wrap) */
+extern MAC_Status_t __real_ST_MAC_init(ST_MAC_callbacks_t * macCallback);
+MAC_Status_t        __wrap_ST_MAC_init(ST_MAC_callbacks_t * macCallback);
+extern MAC_Status_t __real_ST_MAC_MCPSDataReq(MAC_handle st_mac_hndl, const ST_MAC_dataReq_t * pDataReq);
+MAC_Status_t        __wrap_ST_MAC_MCPSDataReq(MAC_handle st_mac_hndl, const ST_MAC_dataReq_t * pDataReq);
+extern MAC_Status_t __real_ST_MAC_MLMEAssociateRes(MAC_handle st_mac_hndl, const ST_MAC_associateRes_t * pAssociateRes);
+MAC_Status_t        __wrap_ST_MAC_MLMEAssociateRes(MAC_handle st_mac_hndl, const ST_MAC_associateRes_t * pAssociateRes);
+
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+static void MacSys_SrcMatchAdd(uint16_t handle, uint8_t addr_mode, const uint8_t * p_addr);
+static void MacSys_SrcMatchRemove(uint16_t handle, uint8_t addr_mode, const uint8_t * p_addr);
+static MAC_Status_t MacSys_SrcMatchDataCnf(const ST_MAC_dataCnf_t * pDataCnf);
+static MAC_Status_t MacSys_SrcMatchPurgeCnf(const ST_MAC_purgeCnf_t * pPurgeCnf);
+static MAC_Status_t MacSys_SrcMatchCommStatusInd(const ST_MAC_commStatusInd_t * pCommStatusInd);
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+static void MacSys_StatsTxDone(ral_instance_t ral_instance, ral_pkt_st * ptr_tx_pkt, ral_pkt_st * ptr_ack_pkt, ral_error_enum_t tx_error);
+static void MacSys_StatsRxDone(ral_instance_t ral_instance, ral_pkt_st * ptr_rx_pkt, ral_error_enum_t rx_error);
+static void MacSys_StatsTimerElapsed(void * arg);
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+/* USER CODE END PFP */
+
 /* Functions Definition ------------------------------------------------------*/
 
 /**
@@ -58,6 +153,19 @@ void MacSys_Init(void)
 {
   /* Register tasks */
   UTIL_SEQ_RegTask( TASK_MAC_LAYER, UTIL_SEQ_RFU, mac_baremetal_run);
+
+  /* USER CODE BEGIN MacSys_Init */
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  UTIL_TIMER_Create( &mac_stats_timer, CFG_MAC_STATS_PERIOD, UTIL_TIMER_PERIODIC, &MacSys_StatsTimerElapsed, NULL );
+  UTIL_TIMER_Start( &mac_stats_timer );
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  mac_buffer_stats.SmallTotal = g_Total_Number_Of_Small_Buffers_c;
+  mac_buffer_stats.LargeTotal = g_Total_Number_Of_Large_Buffers_c;
+  mac_buffer_stats.SmallSize = g_Small_Buffer_Size_c;
+  mac_buffer_stats.LargeSize = g_Large_Buffer_Size_c;
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+  /* USER CODE END MacSys_Init */
 }
 
 /**
@@ -110,3 +218,576 @@ void MacSys_EventWait( void )
   UTIL_SEQ_WaitEvt( EVENT_MAC_LAYER );
 }
 
+/* USER CODE BEGIN FD */
+/**
+  * @brief  Radio abstraction layer initialization, called instead of ral_init() thanks to the linker --wrap option :
+  *         the transmission and reception callbacks of the MAC are counted before being called.
+  * @param  ptr_cbk_dispatch_tbl: callbacks of the MAC
+  * @retval RAL instance
+  */
+ral_instance_t __wrap_ral_init(ral_cbk_dispatch_tbl_st * ptr_cbk_dispatch_tbl)
+{
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  ral_instance_t  instance;
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+  /* Only the first instance (the MAC) is counted */
+  if ( ( ptr_cbk_dispatch_tbl != NULL ) && ( mac_ral_cbk_set == 0u ) )
+  {
+    mac_ral_cbk_set = 1u;
+    mac_ral_cbk_mac = *ptr_cbk_dispatch_tbl;
+    mac_ral_cbk_counted = *ptr_cbk_dispatch_tbl;
+    mac_ral_cbk_counted.ral_tx_done = MacSys_StatsTxDone;
+    mac_ral_cbk_counted.ral_rx_done = MacSys_StatsRxDone;
+    ptr_cbk_dispatch_tbl = &mac_ral_cbk_counted;
+  }
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  /* The first instance (the MAC) owns the source address match table */
+  instance = __real_ral_init( ptr_cbk_dispatch_tbl );
+  if ( mac_ral_instance_set == 0u )
+  {
+    mac_ral_instance_set = 1u;
+    mac_ral_instance = instance;
+  }
+  return instance;
+#else /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+  return __real_ral_init( ptr_cbk_dispatch_tbl );
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+}
+
+/**
+  * @brief  Allocation of a buffer of the MAC pool, called instead of buffMgmt_allocateBuffer() thanks to the linker
+  *         --wrap option : the allocations, the failures and the peak of buffers used are counted.
+  * @param  size: size requested
+  * @retval Buffer identifier, INVALID_BUFFER_ID (0xFF) when no buffer is free
+  */
+uint8_t __wrap_buffMgmt_allocateBuffer(uint8_t size)
+{
+  uint8_t   buffer_id;
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  uint8_t   used;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  buffer_id = __real_buffMgmt_allocateBuffer( size );
+  if ( buffer_id == 0xFFu )
+  {
+    mac_buffer_stats.AllocFailCount++;
+  }
+  else
+  {
+    mac_buffer_stats.AllocCount++;
+
+    /* The library may give a large buffer to a small request : both kinds are checked */
+    if ( mac_buffer_stats.SmallTotal != 0u )
+    {
+      used = mac_buffer_stats.SmallTotal - buffMgmt_getNumberofFreeBuffers( mac_buffer_stats.SmallSize );
+      if ( used > mac_buffer_stats.SmallPeak )
+      {
+        mac_buffer_stats.SmallPeak = used;
+      }
+    }
+    if ( mac_buffer_stats.LargeTotal != 0u )
+    {
+      used = mac_buffer_stats.LargeTotal - buffMgmt_getNumberofFreeBuffers( mac_buffer_stats.LargeSize );
+      if ( used > mac_buffer_stats.LargePeak )
+      {
+        mac_buffer_stats.LargePeak = used;
+      }
+    }
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+#else /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+  buffer_id = __real_buffMgmt_allocateBuffer( size );
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+
+  return buffer_id;
+}
+
+/**
+  * @brief  Enqueue of a buffer in a MAC queue, called instead of queueMgmt_enqueue() thanks to the linker --wrap
+  *         option : the enqueues, the failures and the peak of entries used are counted by queue.
+  * @param  p_queue: queue
+  * @param  buffer_id: buffer to enqueue
+  * @retval QUEUE_SUCCESS (0) or QUEUE_FAIL (0xFF)
+  */
+uint8_t __wrap_queueMgmt_enqueue(mac_sys_queue_t * p_queue, uint8_t buffer_id)
+{
+  uint8_t   status;
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  MAC_SYS_QueueStats_t  * p_stats = NULL;
+  uint32_t              index;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  status = __real_queueMgmt_enqueue( p_queue, buffer_id );
+
+  for ( index = 0; ( index < mac_buffer_stats.QueueNb ) && ( p_stats == NULL ); index++ )
+  {
+    if ( mac_buffer_stats.Queues[index].Queue == p_queue )
+    {
+      p_stats = &mac_buffer_stats.Queues[index];
+    }
+  }
+  if ( p_stats == NULL )
+  {
+    if ( mac_buffer_stats.QueueNb < CFG_MAC_BUFFER_STATS_QUEUE_NB )
+    {
+      p_stats = &mac_buffer_stats.Queues[mac_buffer_stats.QueueNb++];
+      p_stats->Queue = p_queue;
+    }
+    else
+    {
+      mac_buffer_stats.QueueUntrackedNb++;
+    }
+  }
+
+  if ( p_stats != NULL )
+  {
+    p_stats->Capacity = p_queue->total_capacity;
+    if ( status == 0u )
+    {
+      p_stats->EnqueueCount++;
+      if ( p_queue->current_capacity > p_stats->Peak )
+      {
+        p_stats->Peak = p_queue->current_capacity;
+      }
+    }
+    else
+    {
+      p_stats->EnqueueFailCount++;
+    }
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+#else /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+  status = __real_queueMgmt_enqueue( p_queue, buffer_id );
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+
+  return status;
+}
+
+/**
+  * @brief  MAC initialization, called instead of ST_MAC_init() thanks to the linker --wrap option : the confirmations
+  *         of the indirect frames are followed before being given to the Zigbee stack, and the source address match
+  *         of the radio is enabled (frame pending bit of the ACK to a data request set only for the children with a
+  *         frame held).
+  * @param  macCallback: callbacks of the Zigbee stack
+  * @retval MAC status
+  */
+MAC_Status_t __wrap_ST_MAC_init(ST_MAC_callbacks_t * macCallback)
+{
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  MAC_Status_t  status;
+
+  if ( macCallback != NULL )
+  {
+    mac_src_match_cbk_nwk = *macCallback;
+    mac_src_match_cbk = *macCallback;
+    mac_src_match_cbk.mcpsDataCnfCb = MacSys_SrcMatchDataCnf;
+    mac_src_match_cbk.mcpsPurgeCnfCb = MacSys_SrcMatchPurgeCnf;
+    mac_src_match_cbk.mlmeCommStatusIndCb = MacSys_SrcMatchCommStatusInd;
+    macCallback = &mac_src_match_cbk;
+  }
+
+  status = __real_ST_MAC_init( macCallback );
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  memset( mac_src_match_frames, 0, sizeof( mac_src_match_frames ) );
+  mac_src_match_stats.Pending = 0u;
+  mac_src_match_stats.Fallback = 0u;
+  UTILS_EXIT_CRITICAL_SECTION();
+  if ( mac_ral_instance_set != 0u )
+  {
+    ral_clr_all_src_match_short( mac_ral_instance );
+    ral_clr_all_src_match_ext( mac_ral_instance );
+    ral_set_src_match_state( mac_ral_instance, RAL_ENABLE );
+  }
+
+  return status;
+#else /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+  return __real_ST_MAC_init( macCallback );
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+}
+
+/**
+  * @brief  MCPS-DATA.request of the Zigbee stack, called instead of ST_MAC_MCPSDataReq() thanks to the linker --wrap
+  *         option : an indirect frame puts its destination in the source address match table until its confirmation.
+  * @param  st_mac_hndl: MAC handle
+  * @param  pDataReq: request
+  * @retval MAC status
+  */
+MAC_Status_t __wrap_ST_MAC_MCPSDataReq(MAC_handle st_mac_hndl, const ST_MAC_dataReq_t * pDataReq)
+{
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  MAC_Status_t  status;
+  uint8_t       indirect;
+
+  indirect = ( ( pDataReq->indirect_Tx != 0u ) &&
+               ( ( pDataReq->dst_addr_mode == MAC_SYS_ADDR_MODE_SHORT ) || ( pDataReq->dst_addr_mode == MAC_SYS_ADDR_MODE_EXT ) ) ) ? 1u : 0u;
+
+  /* Added before the request : the child may poll as soon as the frame is queued */
+  if ( indirect != 0u )
+  {
+    MacSys_SrcMatchAdd( pDataReq->msdu_handle, pDataReq->dst_addr_mode, pDataReq->dst_address.a_extend_addr );
+  }
+
+  status = __real_ST_MAC_MCPSDataReq( st_mac_hndl, pDataReq );
+  if ( ( indirect != 0u ) && ( status != MAC_SUCCESS ) )
+  {
+    MacSys_SrcMatchRemove( pDataReq->msdu_handle, 0u, NULL );
+  }
+
+  return status;
+#else /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+  return __real_ST_MAC_MCPSDataReq( st_mac_hndl, pDataReq );
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+}
+
+/**
+  * @brief  MLME-ASSOCIATE.response of the Zigbee stack, called instead of ST_MAC_MLMEAssociateRes() thanks to the
+  *         linker --wrap option : the joining device is in the source address match table until the MLME-COMM-STATUS.
+  * @param  st_mac_hndl: MAC handle
+  * @param  pAssociateRes: response
+  * @retval MAC status
+  */
+MAC_Status_t __wrap_ST_MAC_MLMEAssociateRes(MAC_handle st_mac_hndl, const ST_MAC_associateRes_t * pAssociateRes)
+{
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+  MAC_Status_t  status;
+
+  MacSys_SrcMatchAdd( MAC_SYS_SRC_MATCH_ASSOC_HANDLE, MAC_SYS_ADDR_MODE_EXT, pAssociateRes->a_device_address );
+
+  status = __real_ST_MAC_MLMEAssociateRes( st_mac_hndl, pAssociateRes );
+  if ( status != MAC_SUCCESS )
+  {
+    MacSys_SrcMatchRemove( MAC_SYS_SRC_MATCH_ASSOC_HANDLE, MAC_SYS_ADDR_MODE_EXT, pAssociateRes->a_device_address );
+  }
+
+  return status;
+#else /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+  return __real_ST_MAC_MLMEAssociateRes( st_mac_hndl, pAssociateRes );
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+}
+
+#if (CFG_MAC_SRC_MATCH_SUPPORTED != 0)
+/**
+  * @brief  Get the statistics of the source address match table.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void MacSys_GetSrcMatchStats(MAC_SYS_SrcMatchStats_t * p_stats)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_stats = mac_src_match_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+  * @brief  Indirect frame held for a destination : the destination is added to the table with its first frame. When
+  *         no slot is left, the source address match is disabled (frame pending bit set for all the children) until
+  *         the frames followed are all confirmed.
+  */
+static void MacSys_SrcMatchAdd(uint16_t handle, uint8_t addr_mode, const uint8_t * p_addr)
+{
+  mac_sys_src_match_frame_t   * p_frame, * p_free = NULL;
+  uint8_t                     addr_len = ( addr_mode == MAC_SYS_ADDR_MODE_SHORT ) ? 2u : 8u;
+  uint8_t                     first = 1u, fallback = 0u;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  for ( p_frame = mac_src_match_frames; p_frame < &mac_src_match_frames[CFG_MAC_SRC_MATCH_FRAME_NB]; p_frame++ )
+  {
+    if ( p_frame->addr_mode == 0u )
+    {
+      if ( p_free == NULL )
+      {
+        p_free = p_frame;
+      }
+    }
+    else if ( ( p_frame->addr_mode == addr_mode ) && ( memcmp( p_frame->addr, p_addr, addr_len ) == 0 ) )
+    {
+      first = 0u;
+    }
+  }
+
+  if ( p_free != NULL )
+  {
+    p_free->handle = handle;
+    p_free->addr_mode = addr_mode;
+    memcpy( p_free->addr, p_addr, addr_len );
+    mac_src_match_stats.FrameCount++;
+    mac_src_match_stats.Pending++;
+    if ( mac_src_match_stats.Pending > mac_src_match_stats.PendingPeak )
+    {
+      mac_src_match_stats.PendingPeak = mac_src_match_stats.Pending;
+    }
+  }
+  else
+  {
+    mac_src_match_stats.OverflowCount++;
+    fallback = ( mac_src_match_stats.Fallback == 0u ) ? 1u : 0u;
+    mac_src_match_stats.Fallback = 1u;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( mac_ral_instance_set == 0u )
+  {
+    return;
+  }
+  if ( fallback != 0u )
+  {
+    ral_set_src_match_state( mac_ral_instance, RAL_DISABLE );
+  }
+  else if ( ( p_free != NULL ) && ( first != 0u ) )
+  {
+    if ( ( ( addr_mode == MAC_SYS_ADDR_MODE_SHORT ) ? ral_add_src_match_short( mac_ral_instance, (uint16_t)p_addr[0] | ( (uint16_t)p_addr[1] << 8 ) )
+                                                    : ral_add_src_match_ext( mac_ral_instance, p_addr ) ) != RAL_ERROR_NONE )
+    {
+      /* Table of the radio full : the frame pending bit is set for all the children */
+      UTILS_ENTER_CRITICAL_SECTION();
+      mac_src_match_stats.OverflowCount++;
+      mac_src_match_stats.Fallback = 1u;
+      UTILS_EXIT_CRITICAL_SECTION();
+      ral_set_src_match_state( mac_ral_instance, RAL_DISABLE );
+    }
+  }
+}
+
+/**
+  * @brief  Indirect frame confirmed, purged or refused : found by its handle (and its destination for an association
+  *         response, p_addr NULL otherwise). The destination is removed from the table with its last frame.
+  */
+static void MacSys_SrcMatchRemove(uint16_t handle, uint8_t addr_mode, const uint8_t * p_addr)
+{
+  mac_sys_src_match_frame_t   * p_frame, * p_found = NULL;
+  mac_sys_src_match_frame_t   removed;
+  uint8_t                     addr_len, last = 1u, restore = 0u;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  for ( p_frame = mac_src_match_frames; ( p_frame < &mac_src_match_frames[CFG_MAC_SRC_MATCH_FRAME_NB] ) && ( p_found == NULL ); p_frame++ )
+  {
+    if ( ( p_frame->addr_mode != 0u ) && ( p_frame->handle == handle ) &&
+         ( ( p_addr == NULL ) || ( ( p_frame->addr_mode == addr_mode ) && ( memcmp( p_frame->addr, p_addr, 8u ) == 0 ) ) ) )
+    {
+      p_found = p_frame;
+    }
+  }
+
+  if ( p_found == NULL )
+  {
+    UTILS_EXIT_CRITICAL_SECTION();
+    return;
+  }
+
+  removed = *p_found;
+  memset( p_found, 0, sizeof( mac_sys_src_match_frame_t ) );
+  mac_src_match_stats.Pending--;
+  addr_len = ( removed.addr_mode == MAC_SYS_ADDR_MODE_SHORT ) ? 2u : 8u;
+  for ( p_frame = mac_src_match_frames; p_frame < &mac_src_match_frames[CFG_MAC_SRC_MATCH_FRAME_NB]; p_frame++ )
+  {
+    if ( ( p_frame->addr_mode == removed.addr_mode ) && ( memcmp( p_frame->addr, removed.addr, addr_len ) == 0 ) )
+    {
+      last = 0u;
+    }
+  }
+  if ( ( mac_src_match_stats.Fallback != 0u ) && ( mac_src_match_stats.Pending == 0u ) )
+  {
+    mac_src_match_stats.Fallback = 0u;
+    restore = 1u;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( mac_ral_instance_set == 0u )
+  {
+    return;
+  }
+  if ( last != 0u )
+  {
+    if ( removed.addr_mode == MAC_SYS_ADDR_MODE_SHORT )
+    {
+      (void)ral_clr_src_match_short( mac_ral_instance, (uint16_t)removed.addr[0] | ( (uint16_t)removed.addr[1] << 8 ) );
+    }
+    else
+    {
+      (void)ral_clr_src_match_ext( mac_ral_instance, removed.addr );
+    }
+  }
+  if ( restore != 0u )
+  {
+    /* All the frames followed again : the table of the radio is exact */
+    ral_set_src_match_state( mac_ral_instance, RAL_ENABLE );
+  }
+}
+
+/**
+  * @brief  MCPS-DATA.confirm (sent, expired or failed) : the frame is no more held, then given to the Zigbee stack.
+  */
+static MAC_Status_t MacSys_SrcMatchDataCnf(const ST_MAC_dataCnf_t * pDataCnf)
+{
+  MacSys_SrcMatchRemove( pDataCnf->msdu_handle, 0u, NULL );
+
+  return ( mac_src_match_cbk_nwk.mcpsDataCnfCb != NULL ) ? mac_src_match_cbk_nwk.mcpsDataCnfCb( pDataCnf ) : MAC_SUCCESS;
+}
+
+/**
+  * @brief  MCPS-PURGE.confirm : a frame purged is no more held, then given to the Zigbee stack.
+  */
+static MAC_Status_t MacSys_SrcMatchPurgeCnf(const ST_MAC_purgeCnf_t * pPurgeCnf)
+{
+  if ( pPurgeCnf->status == MAC_SUCCESS )
+  {
+    MacSys_SrcMatchRemove( pPurgeCnf->msdu_handle, 0u, NULL );
+  }
+
+  return ( mac_src_match_cbk_nwk.mcpsPurgeCnfCb != NULL ) ? mac_src_match_cbk_nwk.mcpsPurgeCnfCb( pPurgeCnf ) : MAC_SUCCESS;
+}
+
+/**
+  * @brief  MLME-COMM-STATUS.indication : end of an association response, then given to the Zigbee stack.
+  */
+static MAC_Status_t MacSys_SrcMatchCommStatusInd(const ST_MAC_commStatusInd_t * pCommStatusInd)
+{
+  if ( pCommStatusInd->dst_addr_mode == MAC_SYS_ADDR_MODE_EXT )
+  {
+    MacSys_SrcMatchRemove( MAC_SYS_SRC_MATCH_ASSOC_HANDLE, MAC_SYS_ADDR_MODE_EXT, pCommStatusInd->dst_address.a_extend_addr );
+  }
+
+  return ( mac_src_match_cbk_nwk.mlmeCommStatusIndCb != NULL ) ? mac_src_match_cbk_nwk.mlmeCommStatusIndCb( pCommStatusInd ) : MAC_SUCCESS;
+}
+#endif /* (CFG_MAC_SRC_MATCH_SUPPORTED != 0) */
+
+#if (CFG_MAC_STATS_SUPPORTED != 0)
+/**
+  * @brief  Get the statistics of the MAC.
+  * @param  p_stats: statistics to fill.
+  * @retval None
+  */
+void MacSys_GetStats(MAC_SYS_Stats_t * p_stats)
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_stats = mac_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+  * @brief  End of a transmission (radio ISR) : counted by result, then given to the MAC.
+  */
+static void MacSys_StatsTxDone(ral_instance_t ral_instance, ral_pkt_st * ptr_tx_pkt, ral_pkt_st * ptr_ack_pkt, ral_error_enum_t tx_error)
+{
+  mac_stats.Total.TxCount++;
+  switch ( tx_error )
+  {
+    case RAL_ERROR_NONE:
+      mac_stats.Total.TxSuccessCount++;
+      break;
+
+    case RAL_ERROR_CCA_FAILURE:
+      mac_stats.Total.TxCcaFailCount++;
+      break;
+
+    case RAL_ERROR_NO_ACK:
+      mac_stats.Total.TxNoAckCount++;
+      break;
+
+    default:
+      mac_stats.Total.TxErrorCount++;
+      break;
+  }
+
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  if ( ptr_tx_pkt != NULL )
+  {
+    APP_FRAME_LOG_Record( true, ptr_tx_pkt->ptr_pyld, ptr_tx_pkt->pyld_len,
+                          ( ( ptr_ack_pkt != NULL ) ? ptr_ack_pkt->tx_rx_u.rx_info.rssi : 0 ),
+                          ( ( ptr_ack_pkt != NULL ) ? ptr_ack_pkt->tx_rx_u.rx_info.lqi : 0u ), (uint8_t)tx_error );
+  }
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+  if ( mac_ral_cbk_mac.ral_tx_done != NULL )
+  {
+    mac_ral_cbk_mac.ral_tx_done( ral_instance, ptr_tx_pkt, ptr_ack_pkt, tx_error );
+  }
+}
+
+/**
+  * @brief  End of a reception (radio ISR) : counted by result, then given to the MAC.
+  */
+static void MacSys_StatsRxDone(ral_instance_t ral_instance, ral_pkt_st * ptr_rx_pkt, ral_error_enum_t rx_error)
+{
+  if ( rx_error == RAL_ERROR_NONE )
+  {
+    mac_stats.Total.RxCount++;
+  }
+  else if ( rx_error == RAL_ERROR_FCS )
+  {
+    mac_stats.Total.RxCrcErrorCount++;
+  }
+  else
+  {
+    mac_stats.Total.RxErrorCount++;
+  }
+
+#if (CFG_FRAME_LOG_SUPPORTED != 0)
+  if ( ptr_rx_pkt != NULL )
+  {
+    APP_FRAME_LOG_Record( false, ptr_rx_pkt->ptr_pyld, ptr_rx_pkt->pyld_len, ptr_rx_pkt->tx_rx_u.rx_info.rssi,
+                          ptr_rx_pkt->tx_rx_u.rx_info.lqi, (uint8_t)rx_error );
+  }
+#endif /* (CFG_FRAME_LOG_SUPPORTED != 0) */
+
+  if ( mac_ral_cbk_mac.ral_rx_done != NULL )
+  {
+    mac_ral_cbk_mac.ral_rx_done( ral_instance, ptr_rx_pkt, rx_error );
+  }
+}
+
+/**
+  * @brief  End of an interval : the counters of the interval are kept until the end of the next one.
+  */
+static void MacSys_StatsTimerElapsed(void * arg)
+{
+  MAC_SYS_Counters_t  total;
+  uint32_t            * p_total = (uint32_t *)&total;
+  uint32_t            * p_start = (uint32_t *)&mac_stats_interval_start;
+  uint32_t            * p_interval = (uint32_t *)&mac_stats.Interval;
+  uint32_t            index;
+
+  UNUSED( arg );
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  total = mac_stats.Total;
+  for ( index = 0; index < ( sizeof( MAC_SYS_Counters_t ) / sizeof( uint32_t ) ); index++ )
+  {
+    p_interval[index] = p_total[index] - p_start[index];
+  }
+  mac_stats_interval_start = total;
+  mac_stats.IntervalNb++;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+#else /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+/**
+  * @brief  MAC statistics not supported : no statistics.
+  */
+void MacSys_GetStats(MAC_SYS_Stats_t * p_stats)
+{
+  memset( p_stats, 0, sizeof( MAC_SYS_Stats_t ) );
+}
+#endif /* (CFG_MAC_STATS_SUPPORTED != 0) */
+
+/**
+  * @brief  Get the usage of the MAC buffer pool and of the MAC queues.
+  * @param  p_stats: usage to fill (zeroed when not supported).
+  * @retval None
+  */
+void MacSys_GetBufferStats(MAC_SYS_BufferStats_t * p_stats)
+{
+#if (CFG_MAC_BUFFER_STATS_SUPPORTED != 0)
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_stats = mac_buffer_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+#else /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+  memset( p_stats, 0, sizeof( MAC_SYS_BufferStats_t ) );
+#endif /* (CFG_MAC_BUFFER_STATS_SUPPORTED != 0) */
+}
+/* USER CODE END FD */
@@ -0,0 +1,126 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    mac_sys_if.h
+  * @author  MCD Application Team
+  * @brief   Header file for using MAC Layer with a RTOS
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MAC_SYS_IF_H
+#define MAC_SYS_IF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include <stdint.h>
+#include "app_conf.h"
+
+/* USER CODE END Includes */
+
+/* Exported types ------------------------------------------------------------*/
+/* USER CODE BEGIN ET */
+/* Counters of the radio transmissions and receptions of the MAC */
+typedef struct
+{
+  uint32_t    TxCount;                /* Transmissions (each MAC retry counts) */
+  uint32_t    TxSuccessCount;         /* Transmissions acknowledged (or without acknowledgment request) */
+  uint32_t    TxCcaFailCount;         /* Channel busy (CSMA-CA failure) */
+  uint32_t    TxNoAckCount;           /* No acknowledgment received */
+  uint32_t    TxErrorCount;           /* Other transmission failures */
+  uint32_t    RxCount;                /* Frames received */
+  uint32_t    RxCrcErrorCount;        /* Frames received with a FCS error */
+  uint32_t    RxErrorCount;           /* Other reception failures */
+} MAC_SYS_Counters_t;
+
+/* Statistics of the MAC : since the start, and over the last complete interval of CFG_MAC_STATS_PERIOD */
+typedef struct
+{
+  MAC_SYS_Counters_t    Total;
+  MAC_SYS_Counters_t    Interval;
+  uint32_t              IntervalNb;   /* Complete intervals since the start */
+} MAC_SYS_Stats_t;
+
+/* Usage of one MAC queue, identified by its address in the MAC */
+typedef struct
+{
+  const void  * Queue;
+  uint32_t    EnqueueCount;           /* Buffers enqueued */
+  uint32_t    EnqueueFailCount;       /* Buffers refused (queue full) */
+  uint8_t     Capacity;               /* Entries of the queue */
+  uint8_t     Peak;                   /* Most entries used at once */
+} MAC_SYS_QueueStats_t;
+
+/* Usage of the MAC buffer pool (small and large buffers) and of the MAC queues since the start */
+typedef struct
+{
+  uint32_t              AllocCount;           /* Buffers allocated */
+  uint32_t              AllocFailCount;       /* Allocations failed (no free buffer) */
+  uint8_t               SmallTotal;           /* Small buffers of the pool */
+  uint8_t               SmallPeak;            /* Most small buffers used at once */
+  uint8_t               LargeTotal;           /* Large buffers of the pool */
+  uint8_t               LargePeak;            /* Most large buffers used at once */
+  uint8_t               SmallSize;            /* Size of a small buffer (bytes) */
+  uint8_t               LargeSize;            /* Size of a large buffer (bytes) */
+  uint8_t               QueueNb;              /* Queues in the table */
+  uint8_t               QueueUntrackedNb;     /* Queues seen with the table full */
+  MAC_SYS_QueueStats_t  Queues[CFG_MAC_BUFFER_STATS_QUEUE_NB];
+} MAC_SYS_BufferStats_t;
+
+/* Source address match table of the radio (children with an indirect frame held) since the start */
+typedef struct
+{
+  uint32_t              FrameCount;           /* Indirect frames followed */
+  uint32_t              OverflowCount;        /* Frames not followed (no slot left, or table of the radio full) */
+  uint8_t               Pending;              /* Indirect frames held now */
+  uint8_t               PendingPeak;          /* Most indirect frames held at once */
+  uint8_t               Fallback;             /* 1 when the frame pending bit is set for all the children */
+} MAC_SYS_SrcMatchStats_t;
+
+/* USER CODE END ET */
+
+/* Exported constants --------------------------------------------------------*/
+/* USER CODE BEGIN EC */
+
+/* USER CODE END EC */
+
+/* External variables --------------------------------------------------------*/
+/* USER CODE BEGIN EV */
+
+/* USER CODE END EV */
+
+/* Exported macro ------------------------------------------------------------*/
+/* USER CODE BEGIN EM */
+
+/* USER CODE END EM */
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* USER CODE BEGIN EFP */
+void MacSys_GetStats(MAC_SYS_Stats_t * p_stats);
+void MacSys_GetBufferStats(MAC_SYS_BufferStats_t * p_stats);
+void MacSys_GetSrcMatchStats(MAC_SYS_SrcMatchStats_t * p_stats);
+
+/* USER CODE END EFP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAC_SYS_IF_H */
@@ -29,21 +29,110 @@
 
 /* Private includes -----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "utilities_conf.h"
+#include "log_module.h"
+#include "stm32_timer.h"
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+#include "timer_if.h"
+#include "app_host.h"
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
 
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+/* Pool of fixed-size blocks. Free blocks are chained through their first word. */
+typedef struct
+{
+  uint32_t  * const pBuffer;        /* Start of the blocks */
+  uint16_t  const   iBlockWords;    /* Size of a block in words (32 bits) */
+  uint16_t  const   iBlockNbr;      /* Number of blocks */
+  uint16_t          iBlockUntouched;/* Blocks never allocated start from this index */
+  uint32_t          * pFreeList;    /* Released blocks */
+} ZigbeeSlab_t;
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
+
+/* Accounting of a Zigbee heap, the used size is the AMM occupation plus the pools blocks. */
+typedef struct
+{
+  uint8_t   cVirtualMemoryId; /* AMM Virtual Memory of the heap */
+  uint32_t  lSlabSize;        /* Size of the pools blocks currently allocated (in bytes) */
+  uint32_t  lPeakSize;        /* Highest used size (in bytes) */
+  uint32_t  lAllocNbr;        /* Number of buffers currently allocated */
+  uint32_t  lAllocFailedNbr;  /* Number of allocations failed */
+} ZigbeeHeapInfo_t;
+
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+/* One allocation or release done by the Zigbee stack */
+typedef struct
+{
+  uint32_t  lAddress;         /* Buffer address */
+  uint32_t  lCaller;          /* Return address of the zb_heap_alloc/zb_heap_free call */
+  uint32_t  lTimestamp;       /* Time of the call in ms */
+  uint16_t  iSize;            /* Requested size, ZIGBEE_HEAP_TRACE_FREE for a release */
+  uint16_t  iLine;            /* Line given by the stack, only with a memory debug stack library */
+} ZigbeeHeapTrace_t;
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+/* One call of a Zigbee heap streamed to the host (12 bytes, little endian) */
+typedef struct
+{
+  uint32_t  lTimeUs;          /* Time of the call in us (low 32 bits) */
+  uint32_t  lAddress;         /* Buffer address, 0 for a failed allocation */
+  uint16_t  iSize;            /* Requested size, 0 for a release */
+  uint8_t   cHeap;            /* ZIGBEE_HEAP_INIT_INDEX (ZbHeap) or ZIGBEE_HEAP_INDEX (Heap) */
+  uint8_t   cEvent;           /* ZIGBEE_HEAP_RECORD_ALLOC, _FREE or _FAILED */
+} ZigbeeHeapRecord_t;
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+/* Linear allocator. Blocks have no header, only the last one can be given back before the arena is empty. */
+typedef struct
+{
+  uint32_t  * pBuffer;          /* Arena block taken in the AMM, NULL if not available */
+  uint32_t  lWords;             /* Size of the arena in words */
+  uint32_t  lOffset;            /* First free word */
+  uint32_t  lLastOffset;        /* Start of the last block allocated */
+  uint32_t  lLiveNbr;           /* Number of blocks currently allocated */
+  uint32_t  lReservedSize;      /* AMM occupation of the arena block (in bytes) */
+  bool      bInitDone;          /* Arena block already requested to the AMM */
+  bool      bClosed;            /* A block was released out of order, allocations go to the AMM */
+} ZigbeeArena_t;
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+
+/* Zigbee stack instance, only used as a pointer */
+struct ZigBeeT;
 
 /* USER CODE END PTD */
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define ZIGBEE_SLAB_CLASS_NBR         (4u)
+
+#define ZIGBEE_HEAP_INIT_INDEX        (0u)
+#define ZIGBEE_HEAP_INDEX             (1u)
+#define ZIGBEE_HEAP_NBR               (2u)
+
+#define ZIGBEE_HEAP_TRACE_FREE        (0xFFFFu)
+
+#define ZIGBEE_HEAP_RECORD_ALLOC      (0u)
+#define ZIGBEE_HEAP_RECORD_FREE       (1u)
+#define ZIGBEE_HEAP_RECORD_FAILED     (2u)
 
 /* USER CODE END PD */
 
 /* Private macros ------------------------------------------------------------*/
 /* USER CODE BEGIN PM */
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+/* Measurement of a crypto entry point with the DWT cycle counter */
+#define ZIGBEE_PLAT_CRYPTO_START()        uint32_t lCryptoStartCycle = DWT->CYCCNT
+#define ZIGBEE_PLAT_CRYPTO_STOP( op )     ZIGBEE_PLAT_CryptoStatsRecord( (op), lCryptoStartCycle )
+#else /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+#define ZIGBEE_PLAT_CRYPTO_START()
+#define ZIGBEE_PLAT_CRYPTO_STOP( op )
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
 
 /* USER CODE END PM */
 
@@ -57,6 +146,49 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+static uint32_t   aZbSlab16Buffer[CFG_ZIGBEE_SLAB_16_NBR * BYTES_TO_WORD32(16u)];
+static uint32_t   aZbSlab32Buffer[CFG_ZIGBEE_SLAB_32_NBR * BYTES_TO_WORD32(32u)];
+static uint32_t   aZbSlab64Buffer[CFG_ZIGBEE_SLAB_64_NBR * BYTES_TO_WORD32(64u)];
+static uint32_t   aZbSlab128Buffer[CFG_ZIGBEE_SLAB_128_NBR * BYTES_TO_WORD32(128u)];
+
+/* Sorted by increasing block size */
+static ZigbeeSlab_t stZbSlab[ZIGBEE_SLAB_CLASS_NBR] =
+{
+  { aZbSlab16Buffer,  BYTES_TO_WORD32(16u),  CFG_ZIGBEE_SLAB_16_NBR,  0u, NULL },
+  { aZbSlab32Buffer,  BYTES_TO_WORD32(32u),  CFG_ZIGBEE_SLAB_32_NBR,  0u, NULL },
+  { aZbSlab64Buffer,  BYTES_TO_WORD32(64u),  CFG_ZIGBEE_SLAB_64_NBR,  0u, NULL },
+  { aZbSlab128Buffer, BYTES_TO_WORD32(128u), CFG_ZIGBEE_SLAB_128_NBR, 0u, NULL },
+};
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
+
+static ZigbeeHeapInfo_t stZbHeapInfo[ZIGBEE_HEAP_NBR] =
+{
+  { CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, 0u, 0u, 0u, 0u },
+  { CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, 0u, 0u, 0u, 0u },
+};
+
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+static ZigbeeHeapTrace_t  stZbHeapTrace[CFG_ZIGBEE_HEAP_TRACE_NBR];
+static uint32_t           lZbHeapTraceCount;    /* Number of records since boot */
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+static ZigbeeHeapRecord_t stZbHeapRecord[CFG_ZIGBEE_HEAP_RECORD_BATCH];
+static uint32_t           lZbHeapRecordNbr;     /* Records waiting in the batch */
+static uint8_t            cZbHeapRecordSequence;
+static bool               bZbHeapRecording;
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+
+static bool               bZbHeapLow;           /* AMM shared pool below its low watermark */
+
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+static ZigbeeArena_t      stZbInitArena;
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+static ZigbeePlatCryptoStats_t  stZbCryptoStats[ZIGBEE_PLAT_CRYPTO_NBR];
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
 
 /* USER CODE END PV */
 
@@ -67,6 +199,39 @@
 
 /* Private functions prototypes-----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+static void *   ZIGBEE_PLAT_Alloc       ( ZigbeeHeapInfo_t * pHeap, uint32_t iSize );
+static void     ZIGBEE_PLAT_Free        ( ZigbeeHeapInfo_t * pHeap, void * ptr );
+static uint32_t ZIGBEE_PLAT_GetUsedSize ( ZigbeeHeapInfo_t * pHeap );
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+static void *   ZIGBEE_PLAT_SlabAlloc   ( uint32_t iSize, uint32_t * pSlabSize );
+static bool     ZIGBEE_PLAT_SlabFree    ( void * ptr, uint32_t * pSlabSize );
+static bool     ZIGBEE_PLAT_SlabCheckAlloc( uint32_t iSize );
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+static void     ZIGBEE_PLAT_ArenaInit   ( void );
+static void *   ZIGBEE_PLAT_ArenaAlloc  ( uint32_t iSize );
+static bool     ZIGBEE_PLAT_ArenaFree   ( void * ptr );
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+static void     ZIGBEE_PLAT_HeapTraceRecord( void * ptr, uint32_t iSize, uint32_t iLine, void * pCaller );
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+static void     ZIGBEE_PLAT_HeapRecord  ( ZigbeeHeapInfo_t * pHeap, void * ptr, uint32_t iSize, uint8_t cEvent );
+static void     ZIGBEE_PLAT_HeapRecordFlush( void );
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+static void     ZIGBEE_PLAT_CryptoStatsRecord( uint8_t cOperation, uint32_t lStartCycle );
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+
+/* Zigbee stack heap entry points, wrapped by the linker (--wrap) */
+extern void *   __real_zb_heap_alloc    ( struct ZigBeeT * zb, unsigned int sz, const char * funcname, unsigned int linenum );
+extern void     __real_zb_heap_free     ( struct ZigBeeT * zb, void * ptr, const char * funcname, unsigned int linenum );
+void *          __wrap_zb_heap_alloc    ( struct ZigBeeT * zb, unsigned int sz, const char * funcname, unsigned int linenum );
+void            __wrap_zb_heap_free     ( struct ZigBeeT * zb, void * ptr, const char * funcname, unsigned int linenum );
+
+/* Software AES block encryption of the stack (CCM* of the frames, hash, PRNG), wrapped by the linker (--wrap) */
+extern void     __real_ZbAesEncrypt     ( const uint8_t * pInput, uint8_t * pOutput, void * pContext );
+void            __wrap_ZbAesEncrypt     ( const uint8_t * pInput, uint8_t * pOutput, void * pContext );
 
 /* USER CODE END PFP */
 
@@ -94,8 +259,11 @@ void ZIGBEE_PLAT_RngInit( void )
  */
 void ZIGBEE_PLAT_RngProcess( void )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   // -- Generate new Random numbers --
   HW_RNG_Process();
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_RNG_PROCESS );
 }
 
 /**
@@ -103,25 +271,11 @@ void ZIGBEE_PLAT_RngProcess( void )
  */
 void ZIGBEE_PLAT_RngGet( uint8_t cNumberOfBytes, uint8_t * pValue )
 {
-  uint8_t   cNbRemainingBytes = cNumberOfBytes;
-  uint8_t   *pData = pValue;
-  uint32_t  lGeneratedRandom;
-
-  /* Get the requested RNGs (4 bytes by 4bytes) */
-  while ( cNbRemainingBytes >= 4u )
-  {
-    HW_RNG_Get(1, &lGeneratedRandom);
-    memcpy( pData, &lGeneratedRandom, 4);
-    cNbRemainingBytes -= 4u;
-    pData += 4u;
-  }
+  ZIGBEE_PLAT_CRYPTO_START();
 
-  /* Get the remaining number of RNGs */
-  if ( cNbRemainingBytes > 0u )
-  {
-    HW_RNG_Get(1, &lGeneratedRandom);
-    memcpy( pData, &lGeneratedRandom, cNbRemainingBytes);
-  }
+  /* Get the requested RNGs straight from the pool */
+  HW_RNG_GetBytes( cNumberOfBytes, pValue );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_RNG_GET );
 }
 
 /**
@@ -129,7 +283,10 @@ void ZIGBEE_PLAT_RngGet( uint8_t cNumberOfBytes, uint8_t * pValue )
  */
 void ZIGBEE_PLAT_AesEcbEncrypt( const uint8_t * pKey, const uint8_t * pInput, uint8_t * pOutput )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   BAES_EcbCrypt( pKey, pInput, pOutput, HW_AES_ENC );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_ECB_ENCRYPT );
 }
 
 /**
@@ -137,7 +294,10 @@ void ZIGBEE_PLAT_AesEcbEncrypt( const uint8_t * pKey, const uint8_t * pInput, ui
  */
 void ZIGBEE_PLAT_AesCmacSetKey( const uint8_t * pKey )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   BAES_CmacSetKey( pKey );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CMAC_SET_KEY );
 }
 
 /**
@@ -145,7 +305,10 @@ void ZIGBEE_PLAT_AesCmacSetKey( const uint8_t * pKey )
  */
 void ZIGBEE_PLAT_AesCmacSetVector( const uint8_t * pIV )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   BAES_CmacSetVector( pIV );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CMAC_SET_VECTOR );
 }
 
 /**
@@ -153,7 +316,10 @@ void ZIGBEE_PLAT_AesCmacSetVector( const uint8_t * pIV )
  */
 void ZIGBEE_PLAT_AesCrypt32( const uint32_t * pInput, uint32_t * pOutput )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   HW_AES_Crypt( pInput, pOutput );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CRYPT32 );
 }
 
 /**
@@ -161,7 +327,10 @@ void ZIGBEE_PLAT_AesCrypt32( const uint32_t * pInput, uint32_t * pOutput )
  */
 void ZIGBEE_PLAT_AesCrypt( const uint8_t * pInput, uint8_t * pOutput )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   HW_AES_Crypt8( pInput, pOutput );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CRYPT );
 }
 
 /**
@@ -169,7 +338,58 @@ void ZIGBEE_PLAT_AesCrypt( const uint8_t * pInput, uint8_t * pOutput )
  */
 void ZIGBEE_PLAT_AesCmacCompute( const uint8_t * pInput, uint32_t lInputLength, uint8_t * pOutputTag )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
   BAES_CmacCompute( pInput, lInputLength, pOutputTag );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CMAC_COMPUTE );
+}
+
+/**
+ * @brief  AES-MMO hash (install code to link key derivation), all the steps in the hardware AES.
+ * @param  pInput         Data to hash
+ * @param  lInputLength   Length of the data
+ * @param  pDigest        Hash (16 bytes)
+ * @retval None
+ */
+void ZIGBEE_PLAT_AesMmoHash( const uint8_t * pInput, uint32_t lInputLength, uint8_t * pDigest )
+{
+  ZIGBEE_PLAT_CRYPTO_START();
+
+  BAES_MmoHash( pInput, lInputLength, pDigest );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_MMO_HASH );
+}
+
+/**
+ * @brief  CCM* of a secured frame (NWK/APS), encryption or decryption and MIC in one hardware pass.
+ * @param  cMode          0 to encrypt (pMic written), 1 to decrypt (pMic checked)
+ * @param  pKey           Key (16 bytes)
+ * @param  pNonce         CCM* nonce (13 bytes : source address, frame counter, security control)
+ * @param  pAuth          Authenticated data 'a' (frame header up to the auxiliary header included)
+ * @param  iAuthLength    Length of the authenticated data
+ * @param  pInput         Payload to encrypt or decrypt
+ * @param  iInputLength   Length of the payload
+ * @param  cMicLength     Length of the MIC : 0 (encryption only), 4, 8 or 16
+ * @param  pMic           MIC
+ * @param  pOutput        Payload encrypted or decrypted (can be pInput)
+ * @retval 0 on success, else MIC mismatch, parameter not supported or AES in use (-1).
+ */
+int ZIGBEE_PLAT_AesCcmCrypt( uint8_t cMode, const uint8_t * pKey, const uint8_t * pNonce, const uint8_t * pAuth, uint16_t iAuthLength,
+                             const uint8_t * pInput, uint16_t iInputLength, uint8_t cMicLength, uint8_t * pMic, uint8_t * pOutput )
+{
+  int   iStatus;
+
+  if ( ( cMicLength != 0u ) && ( cMicLength != 4u ) && ( cMicLength != 8u ) && ( cMicLength != 16u ) )
+  {
+    return -1;
+  }
+
+  ZIGBEE_PLAT_CRYPTO_START();
+
+  iStatus = BAES_CcmCrypt( cMode, pKey, ZIGBEE_PLAT_CCM_NONCE_LENGTH, pNonce, iAuthLength, pAuth,
+                           iInputLength, pInput, cMicLength, pMic, pOutput );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_AES_CCM_CRYPT );
+
+  return iStatus;
 }
 
 /**
@@ -177,6 +397,15 @@ void ZIGBEE_PLAT_AesCmacCompute( const uint8_t * pInput, uint32_t lInputLength,
  */
 bool ZIGBEE_PLAT_ZbHeapInit( void )
 {
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+  /* First call of the stack (ZbInit) : cycle counter for the crypto measurements */
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+  ZIGBEE_PLAT_ArenaInit();
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
 
   return true;
 }
@@ -186,61 +415,478 @@ bool ZIGBEE_PLAT_ZbHeapInit( void )
  */
 void * ZIGBEE_PLAT_ZbHeapMalloc( uint32_t iSize )
 {
-  void  *ptr = NULL;
+  return ZIGBEE_PLAT_Alloc( &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX], iSize );
+}
 
-  /* Fix a problem with AMM if iSize is null */
-  if ( iSize == 0u )
+/**
+ *
+ */
+void ZIGBEE_PLAT_ZbHeapFree( void * ptr )
+{
+  ZIGBEE_PLAT_Free( &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX], ptr );
+}
+
+/**
+ *
+ */
+unsigned int ZIGBEE_PLAT_ZbHeapMallocCurrentSize()
+{
+  return ZIGBEE_PLAT_GetUsedSize( &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX] );
+}
+
+/**
+ *
+ */
+bool ZIGBEE_PLAT_HeapInit( void )
+{
+  return true;
+}
+
+/**
+ *
+ */
+void * ZIGBEE_PLAT_HeapMalloc( uint32_t iSize )
+{
+  return ZIGBEE_PLAT_Alloc( &stZbHeapInfo[ZIGBEE_HEAP_INDEX], iSize );
+}
+
+/**
+ *
+ */
+void ZIGBEE_PLAT_HeapFree( void * ptr )
+{
+  ZIGBEE_PLAT_Free( &stZbHeapInfo[ZIGBEE_HEAP_INDEX], ptr );
+}
+
+/**
+ *
+ */
+unsigned int ZIGBEE_PLAT_HeapMallocCurrentSize( void )
+{
+  return ZIGBEE_PLAT_GetUsedSize( &stZbHeapInfo[ZIGBEE_HEAP_INDEX] );
+}
+
+/**
+ *
+ */
+unsigned long ZIGBEE_PLAT_HeapAvailable( void )
+{
+  AMM_VirtualMemoryStats_t  stAmmStats;
+
+  if ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, &stAmmStats ) != AMM_ERROR_OK )
   {
-    iSize = 1;
+    return 0U;
+  }
+
+  return ( stAmmStats.AvailableSize * sizeof( uint32_t ) );
+}
+
+/**
+ *
+ */
+bool ZIGBEE_PLAT_HeapCheckAlloc( uint32_t iSize )
+{
+  AMM_VirtualMemoryStats_t  stAmmStats;
+  uint32_t                  lLargestFreeBlock;
+  uint32_t                  lWords = BYTES_TO_WORD32( iSize );
+
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+  if ( ZIGBEE_PLAT_SlabCheckAlloc( iSize ) == true )
+  {
+    return true;
   }
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
 
-  if ( AMM_Alloc( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, BYTES_TO_WORD32(iSize), (uint32_t**)&ptr, NULL ) != AMM_ERROR_OK )
+  /* Shed the load while the memory is low, the stack retries later */
+  if ( bZbHeapLow == true )
   {
-    ptr = NULL;
+    return false;
   }
 
-  return ptr;
+  if ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, &stAmmStats ) != AMM_ERROR_OK )
+  {
+    return false;
+  }
+
+  /* Same check as done by the AMM */
+  if ( lWords >= stAmmStats.AvailableSize )
+  {
+    return false;
+  }
+
+  /* Then the allocator shall have a block large enough */
+  if ( ( AMM_GetLargestFreeBlock( &lLargestFreeBlock ) == AMM_ERROR_OK ) && ( lWords > lLargestFreeBlock ) )
+  {
+    return false;
+  }
+
+  return true;
 }
 
 /**
  *
  */
-void ZIGBEE_PLAT_ZbHeapFree( void * ptr )
+unsigned long ZIGBEE_PLAT_HeapUsed( void )
 {
-  if ( ptr != NULL )
+  return ZIGBEE_PLAT_GetUsedSize( &stZbHeapInfo[ZIGBEE_HEAP_INDEX] );
+}
+
+/**
+ *
+ */
+unsigned long ZIGBEE_PLAT_HeapHighWaterMark( void )
+{
+  return stZbHeapInfo[ZIGBEE_HEAP_INDEX].lPeakSize;
+}
+
+/**
+ * @brief  Get the accounting of one of the Zigbee heaps.
+ *
+ * @param  cVirtualMemoryId   CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT or CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP.
+ * @param  pStats             Statistics to fill.
+ * @retval true if the heap is known.
+ */
+bool ZIGBEE_PLAT_GetHeapStats( uint8_t cVirtualMemoryId, ZigbeePlatHeapStats_t * pStats )
+{
+  ZigbeeHeapInfo_t  * pHeap;
+  uint32_t          lLargestFreeBlock = 0u;
+
+  if ( cVirtualMemoryId == CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT )
   {
-    AMM_Free( ptr );
+    pHeap = &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX];
+  }
+  else if ( cVirtualMemoryId == CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP )
+  {
+    pHeap = &stZbHeapInfo[ZIGBEE_HEAP_INDEX];
   }
   else
   {
-    /* Intentional INFINITE_LOOP */
-    /* coverity[no_escape] */
-    while(1) {}
+    return false;
   }
+
+  (void)AMM_GetLargestFreeBlock( &lLargestFreeBlock );
+
+  pStats->lUsedSize = ZIGBEE_PLAT_GetUsedSize( pHeap );
+  pStats->lPeakSize = pHeap->lPeakSize;
+  pStats->lAllocNbr = pHeap->lAllocNbr;
+  pStats->lAllocFailedNbr = pHeap->lAllocFailedNbr;
+  pStats->lLargestFreeBlock = lLargestFreeBlock * sizeof( uint32_t );
+
+  return true;
 }
 
 /**
+ * @brief  Called when the AMM shared pool crosses its low watermark.
  *
+ * @param  bLow   true when the pool goes below the watermark, false when it goes back above.
  */
-unsigned int ZIGBEE_PLAT_ZbHeapMallocCurrentSize()
+void ZIGBEE_PLAT_HeapLowNotification( bool bLow )
 {
-  return 0U;
+  bZbHeapLow = bLow;
 }
 
 /**
+ * @brief  Indicate whether the AMM shared pool is below its low watermark.
  *
+ * @retval true if the memory is low.
  */
-bool ZIGBEE_PLAT_HeapInit( void )
+bool ZIGBEE_PLAT_IsHeapLow( void )
+{
+  return bZbHeapLow;
+}
+
+/**
+ * @brief  Zigbee stack allocation, called instead of zb_heap_alloc() thanks to the linker --wrap option.
+ */
+void * __wrap_zb_heap_alloc( struct ZigBeeT * zb, unsigned int sz, const char * funcname, unsigned int linenum )
+{
+  void  *ptr;
+
+  ptr = __real_zb_heap_alloc( zb, sz, funcname, linenum );
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+  if ( ptr != NULL )
+  {
+    ZIGBEE_PLAT_HeapTraceRecord( ptr, sz, linenum, __builtin_return_address( 0 ) );
+  }
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+  return ptr;
+}
+
+/**
+ * @brief  Zigbee stack release, called instead of zb_heap_free() thanks to the linker --wrap option.
+ */
+void __wrap_zb_heap_free( struct ZigBeeT * zb, void * ptr, const char * funcname, unsigned int linenum )
+{
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+  ZIGBEE_PLAT_HeapTraceRecord( ptr, ZIGBEE_HEAP_TRACE_FREE, linenum, __builtin_return_address( 0 ) );
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+  __real_zb_heap_free( zb, ptr, funcname, linenum );
+}
+
+/**
+ * @brief  Stack AES block encryption, called instead of ZbAesEncrypt() thanks to the linker --wrap option.
+ *         The stack secures its NWK/APS frames with its own software CCM*, built on this block encryption.
+ */
+void __wrap_ZbAesEncrypt( const uint8_t * pInput, uint8_t * pOutput, void * pContext )
 {
+  ZIGBEE_PLAT_CRYPTO_START();
+
+  __real_ZbAesEncrypt( pInput, pOutput, pContext );
+  ZIGBEE_PLAT_CRYPTO_STOP( ZIGBEE_PLAT_CRYPTO_STACK_AES_BLOCK );
+}
+
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+/**
+ * @brief  Get the cost of a crypto entry point since the last reset.
+ *
+ * @param  cOperation   Entry point (ZigbeePlatCryptoOp_t).
+ * @param  pStats       Statistics to fill.
+ * @retval true if the entry point is known.
+ */
+bool ZIGBEE_PLAT_GetCryptoStats( uint8_t cOperation, ZigbeePlatCryptoStats_t * pStats )
+{
+  if ( cOperation >= (uint8_t)ZIGBEE_PLAT_CRYPTO_NBR )
+  {
+    return false;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  *pStats = stZbCryptoStats[cOperation];
+  UTILS_EXIT_CRITICAL_SECTION();
+
   return true;
 }
 
 /**
+ * @brief  Reset the cost of all the crypto entry points.
+ */
+void ZIGBEE_PLAT_ResetCryptoStats( void )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  memset( stZbCryptoStats, 0, sizeof( stZbCryptoStats ) );
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief  Account a call of a crypto entry point.
  *
+ * @param  cOperation   Entry point (ZigbeePlatCryptoOp_t).
+ * @param  lStartCycle  DWT cycle counter at the start of the call.
  */
-void * ZIGBEE_PLAT_HeapMalloc( uint32_t iSize )
+static void ZIGBEE_PLAT_CryptoStatsRecord( uint8_t cOperation, uint32_t lStartCycle )
+{
+  ZigbeePlatCryptoStats_t   * pStats = &stZbCryptoStats[cOperation];
+  uint32_t                  lCycles = DWT->CYCCNT - lStartCycle;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  pStats->lCallNbr++;
+  pStats->llTotalCycles += lCycles;
+  if ( lCycles > pStats->lMaxCycles )
+  {
+    pStats->lMaxCycles = lCycles;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+/**
+ * @brief  Dump the Zigbee stack allocations recorded in the trace buffer.
+ *
+ * @param  bLeaksOnly   If true, only the allocations not released since are dumped.
+ */
+void ZIGBEE_PLAT_HeapTraceDump( bool bLeaksOnly )
 {
-  void  *ptr = NULL;
+  ZigbeeHeapTrace_t   stTrace;
+  uint32_t            lCount;
+  uint32_t            lNbr;
+  uint32_t            lIndex;
+  uint32_t            lNext;
+  bool                bFreed;
+
+  lCount = lZbHeapTraceCount;
+  lNbr = ( lCount < CFG_ZIGBEE_HEAP_TRACE_NBR ) ? lCount : CFG_ZIGBEE_HEAP_TRACE_NBR;
+
+  LOG_INFO_APP( "Zigbee heap trace : %u records, %u lost", lCount, ( lCount - lNbr ) );
+
+  /* From the oldest to the newest record */
+  for ( lIndex = ( lCount - lNbr ); lIndex < lCount; lIndex++ )
+  {
+    stTrace = stZbHeapTrace[lIndex % CFG_ZIGBEE_HEAP_TRACE_NBR];
+
+    if ( stTrace.iSize == ZIGBEE_HEAP_TRACE_FREE )
+    {
+      if ( bLeaksOnly == false )
+      {
+        LOG_INFO_APP( "%8u ms : free  0x%08X          by 0x%08X (%u)", stTrace.lTimestamp, stTrace.lAddress,
+                      stTrace.lCaller, stTrace.iLine );
+      }
+      continue;
+    }
+
+    /* Search for a later release of this buffer */
+    bFreed = false;
+    for ( lNext = lIndex + 1u; ( lNext < lCount ) && ( bFreed == false ); lNext++ )
+    {
+      if ( ( stZbHeapTrace[lNext % CFG_ZIGBEE_HEAP_TRACE_NBR].lAddress == stTrace.lAddress )
+        && ( stZbHeapTrace[lNext % CFG_ZIGBEE_HEAP_TRACE_NBR].iSize == ZIGBEE_HEAP_TRACE_FREE ) )
+      {
+        bFreed = true;
+      }
+    }
+
+    if ( ( bLeaksOnly == false ) || ( bFreed == false ) )
+    {
+      LOG_INFO_APP( "%8u ms : alloc 0x%08X %5u by 0x%08X (%u)%s", stTrace.lTimestamp, stTrace.lAddress, stTrace.iSize,
+                    stTrace.lCaller, stTrace.iLine, ( ( bFreed == false ) ? " not freed" : "" ) );
+    }
+  }
+}
+
+/**
+ * @brief  Store an allocation or a release in the trace buffer, the oldest record is overwritten.
+ *
+ * @param  ptr      Buffer address.
+ * @param  iSize    Requested size, ZIGBEE_HEAP_TRACE_FREE for a release.
+ * @param  iLine    Line of the call given by the stack.
+ * @param  pCaller  Return address of the call.
+ */
+static void ZIGBEE_PLAT_HeapTraceRecord( void * ptr, uint32_t iSize, uint32_t iLine, void * pCaller )
+{
+  ZigbeeHeapTrace_t   * pTrace;
+  uint32_t            lTimestamp = UTIL_TIMER_GetCurrentTime();
+
+  /* Saturate the big sizes, a real size can not be mistaken for a release */
+  if ( iSize > ( ZIGBEE_HEAP_TRACE_FREE - 1u ) )
+  {
+    iSize = ( ZIGBEE_HEAP_TRACE_FREE - 1u );
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  pTrace = &stZbHeapTrace[lZbHeapTraceCount % CFG_ZIGBEE_HEAP_TRACE_NBR];
+  lZbHeapTraceCount++;
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  pTrace->lAddress = (uint32_t)ptr;
+  pTrace->lCaller = (uint32_t)pCaller;
+  pTrace->lTimestamp = lTimestamp;
+  pTrace->iSize = (uint16_t)iSize;
+  pTrace->iLine = (uint16_t)iLine;
+}
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+/**
+ * @brief  Start to stream the calls of the Zigbee heaps to the host.
+ */
+void ZIGBEE_PLAT_HeapRecordStart( void )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  lZbHeapRecordNbr = 0;
+  bZbHeapRecording = true;
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  LOG_INFO_APP( "Zigbee heap recording started (event sequence %u).", cZbHeapRecordSequence );
+}
+
+/**
+ * @brief  Stop the stream, the records of the last batch sent.
+ */
+void ZIGBEE_PLAT_HeapRecordStop( void )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  bZbHeapRecording = false;
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  ZIGBEE_PLAT_HeapRecordFlush();
+
+  LOG_INFO_APP( "Zigbee heap recording stopped (event sequence %u).", cZbHeapRecordSequence );
+}
+
+/**
+ * @brief  Add a call to the batch, the batch sent when full.
+ *
+ * @param  pHeap    Zigbee heap.
+ * @param  ptr      Buffer address, NULL for a failed allocation.
+ * @param  iSize    Requested size, 0 for a release.
+ * @param  cEvent   ZIGBEE_HEAP_RECORD_ALLOC, _FREE or _FAILED.
+ */
+static void ZIGBEE_PLAT_HeapRecord( ZigbeeHeapInfo_t * pHeap, void * ptr, uint32_t iSize, uint8_t cEvent )
+{
+  ZigbeeHeapRecord_t  * pRecord;
+  uint32_t            lTimeUs;
+  bool                bFull = false;
+
+  if ( bZbHeapRecording == false )
+  {
+    return;
+  }
+
+  lTimeUs = (uint32_t)TIMER_IF_GetTimeUs();
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( lZbHeapRecordNbr < CFG_ZIGBEE_HEAP_RECORD_BATCH )
+  {
+    pRecord = &stZbHeapRecord[lZbHeapRecordNbr];
+    lZbHeapRecordNbr++;
+
+    pRecord->lTimeUs = lTimeUs;
+    pRecord->lAddress = (uint32_t)ptr;
+    pRecord->iSize = (uint16_t)MIN( iSize, UINT16_MAX );
+    pRecord->cHeap = (uint8_t)( pHeap - stZbHeapInfo );
+    pRecord->cEvent = cEvent;
+
+    bFull = ( lZbHeapRecordNbr == CFG_ZIGBEE_HEAP_RECORD_BATCH );
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( bFull != false )
+  {
+    ZIGBEE_PLAT_HeapRecordFlush();
+  }
+}
+
+/**
+ * @brief  Send the records of the batch in one event. An event lost (trace FIFO full) leaves a gap in the sequences.
+ */
+static void ZIGBEE_PLAT_HeapRecordFlush( void )
+{
+  ZigbeeHeapRecord_t  astBatch[CFG_ZIGBEE_HEAP_RECORD_BATCH];
+  uint32_t            lNbr;
+  uint8_t             cSequence;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  lNbr = lZbHeapRecordNbr;
+  memcpy( astBatch, stZbHeapRecord, ( lNbr * sizeof( ZigbeeHeapRecord_t ) ) );
+  lZbHeapRecordNbr = 0;
+  cSequence = cZbHeapRecordSequence;
+  if ( lNbr != 0u )
+  {
+    cZbHeapRecordSequence++;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if ( lNbr != 0u )
+  {
+    (void)APP_HOST_SendEvent( APP_HOST_EVENT_HEAP_TRACE, cSequence, (const uint8_t *)astBatch,
+                              (uint16_t)( lNbr * sizeof( ZigbeeHeapRecord_t ) ) );
+  }
+}
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+
+/**
+ * @brief  Allocate a buffer for a Zigbee heap, first from the pools then from the AMM.
+ *
+ * @param  pHeap  Zigbee heap.
+ * @param  iSize  Requested size in bytes.
+ * @retval Pointer on the buffer, NULL if no memory.
+ */
+static void * ZIGBEE_PLAT_Alloc( ZigbeeHeapInfo_t * pHeap, uint32_t iSize )
+{
+  void      *ptr = NULL;
+  uint32_t  lUsedSize;
 
   /* Fix a problem with AMM if iSize is null */
   if ( iSize == 0u )
@@ -248,21 +894,76 @@ void * ZIGBEE_PLAT_HeapMalloc( uint32_t iSize )
     iSize = 1;
   }
 
-  if ( AMM_Alloc( CFG_AMM_VIRTUAL_STACK_ZIGBEE_HEAP, BYTES_TO_WORD32(iSize), (uint32_t**)&ptr, NULL ) != AMM_ERROR_OK )
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+  if ( pHeap == &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX] )
+  {
+    ptr = ZIGBEE_PLAT_ArenaAlloc( iSize );
+  }
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+  if ( ptr == NULL )
+  {
+    ptr = ZIGBEE_PLAT_SlabAlloc( iSize, &pHeap->lSlabSize );
+  }
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
+
+  if ( ptr == NULL )
   {
-    ptr = NULL;
+    if ( AMM_Alloc( pHeap->cVirtualMemoryId, BYTES_TO_WORD32(iSize), (uint32_t**)&ptr, NULL ) != AMM_ERROR_OK )
+    {
+      ptr = NULL;
+    }
   }
 
+  if ( ptr != NULL )
+  {
+    pHeap->lAllocNbr++;
+
+    lUsedSize = ZIGBEE_PLAT_GetUsedSize( pHeap );
+    if ( lUsedSize > pHeap->lPeakSize )
+    {
+      pHeap->lPeakSize = lUsedSize;
+    }
+  }
+  else
+  {
+    pHeap->lAllocFailedNbr++;
+  }
+
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+  ZIGBEE_PLAT_HeapRecord( pHeap, ptr, iSize, ( ( ptr != NULL ) ? ZIGBEE_HEAP_RECORD_ALLOC : ZIGBEE_HEAP_RECORD_FAILED ) );
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+
   return ptr;
 }
 
 /**
+ * @brief  Release a buffer of a Zigbee heap.
  *
+ * @param  pHeap  Zigbee heap.
+ * @param  ptr    Pointer on the buffer.
  */
-void ZIGBEE_PLAT_HeapFree( void * ptr )
+static void ZIGBEE_PLAT_Free( ZigbeeHeapInfo_t * pHeap, void * ptr )
 {
   if ( ptr != NULL )
   {
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+    ZIGBEE_PLAT_HeapRecord( pHeap, ptr, 0u, ZIGBEE_HEAP_RECORD_FREE );
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+    pHeap->lAllocNbr--;
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+    if ( ZIGBEE_PLAT_ArenaFree( ptr ) == true )
+    {
+      return;
+    }
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
+    if ( ZIGBEE_PLAT_SlabFree( ptr, &pHeap->lSlabSize ) == true )
+    {
+      return;
+    }
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
     AMM_Free( ptr );
   }
   else
@@ -274,44 +975,239 @@ void ZIGBEE_PLAT_HeapFree( void * ptr )
 }
 
 /**
+ * @brief  Compute the memory used by a Zigbee heap, headers included.
  *
+ * @param  pHeap  Zigbee heap.
+ * @retval Used size in bytes.
  */
-unsigned int ZIGBEE_PLAT_HeapMallocCurrentSize( void )
+static uint32_t ZIGBEE_PLAT_GetUsedSize( ZigbeeHeapInfo_t * pHeap )
 {
-  return 0U;
+  AMM_VirtualMemoryStats_t  stAmmStats;
+  uint32_t                  lUsedSize = 0u;
+
+  if ( AMM_GetVirtualMemoryStats( pHeap->cVirtualMemoryId, &stAmmStats ) == AMM_ERROR_OK )
+  {
+    lUsedSize = stAmmStats.OccupiedSize * sizeof( uint32_t );
+  }
+
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
+  /* Only the used part of the arena is counted */
+  if ( ( pHeap == &stZbHeapInfo[ZIGBEE_HEAP_INIT_INDEX] ) && ( stZbInitArena.pBuffer != NULL ) )
+  {
+    lUsedSize -= stZbInitArena.lReservedSize;
+    lUsedSize += ( stZbInitArena.lOffset * sizeof( uint32_t ) );
+  }
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
+
+  return ( lUsedSize + pHeap->lSlabSize );
 }
 
+#if (CFG_ZIGBEE_SLAB_SUPPORTED != 0)
 /**
+ * @brief  Allocate a block from the smallest pool that fits the requested size.
  *
+ * @param  iSize       Requested size in bytes.
+ * @param  pSlabSize   Size of the blocks owned by the caller, updated with the allocated block.
+ * @retval Pointer on the block, NULL if the size is too big or if the pools are full.
  */
-unsigned long ZIGBEE_PLAT_HeapAvailable( void )
+HOT_CODE static void * ZIGBEE_PLAT_SlabAlloc( uint32_t iSize, uint32_t * pSlabSize )
 {
-    return 0U;
+  uint32_t      lWords = BYTES_TO_WORD32( iSize );
+  uint32_t      * pBlock = NULL;
+  ZigbeeSlab_t  * pSlab;
+  uint32_t      lIndex;
+
+  for ( lIndex = 0u; ( lIndex < ZIGBEE_SLAB_CLASS_NBR ) && ( pBlock == NULL ); lIndex++ )
+  {
+    pSlab = &stZbSlab[lIndex];
+    if ( lWords <= pSlab->iBlockWords )
+    {
+      UTILS_ENTER_CRITICAL_SECTION();
+      if ( pSlab->pFreeList != NULL )
+      {
+        pBlock = pSlab->pFreeList;
+        pSlab->pFreeList = *(uint32_t **)pBlock;
+      }
+      else if ( pSlab->iBlockUntouched < pSlab->iBlockNbr )
+      {
+        pBlock = &pSlab->pBuffer[(uint32_t)pSlab->iBlockUntouched * pSlab->iBlockWords];
+        pSlab->iBlockUntouched++;
+      }
+      UTILS_EXIT_CRITICAL_SECTION();
+
+      if ( pBlock != NULL )
+      {
+        *pSlabSize += ( (uint32_t)pSlab->iBlockWords * sizeof( uint32_t ) );
+      }
+    }
+  }
+
+  return pBlock;
 }
 
 /**
+ * @brief  Check whether a pool can provide a block for the requested size.
  *
+ * @param  iSize       Requested size in bytes.
+ * @retval true if a block is available.
  */
-bool ZIGBEE_PLAT_HeapCheckAlloc( uint32_t iSize )
+static bool ZIGBEE_PLAT_SlabCheckAlloc( uint32_t iSize )
 {
-    /* Just assume we have enough memory in the system heap */
-    return true;
+  uint32_t      lWords = BYTES_TO_WORD32( iSize );
+  ZigbeeSlab_t  * pSlab;
+  uint32_t      lIndex;
+
+  for ( lIndex = 0u; lIndex < ZIGBEE_SLAB_CLASS_NBR; lIndex++ )
+  {
+    pSlab = &stZbSlab[lIndex];
+    if ( ( lWords <= pSlab->iBlockWords )
+      && ( ( pSlab->pFreeList != NULL ) || ( pSlab->iBlockUntouched < pSlab->iBlockNbr ) ) )
+    {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 /**
+ * @brief  Release a block in its pool.
  *
+ * @param  ptr        Pointer on the block.
+ * @param  pSlabSize  Size of the blocks owned by the caller, updated with the released block.
+ * @retval true if the block belongs to a pool, false if it comes from the AMM.
  */
-unsigned long ZIGBEE_PLAT_HeapUsed( void )
+HOT_CODE static bool ZIGBEE_PLAT_SlabFree( void * ptr, uint32_t * pSlabSize )
 {
-    /*  ZIGBEE_PLAT_HeapUSed is not updated in this file, because we're not tracking memory usage. */
-    return 0U;
+  uint32_t      * pBlock = (uint32_t *)ptr;
+  ZigbeeSlab_t  * pSlab;
+  uint32_t      lIndex;
+
+  for ( lIndex = 0u; lIndex < ZIGBEE_SLAB_CLASS_NBR; lIndex++ )
+  {
+    pSlab = &stZbSlab[lIndex];
+    if ( ( pBlock >= pSlab->pBuffer ) && ( pBlock < &pSlab->pBuffer[(uint32_t)pSlab->iBlockNbr * pSlab->iBlockWords] ) )
+    {
+      UTILS_ENTER_CRITICAL_SECTION();
+      *(uint32_t **)pBlock = pSlab->pFreeList;
+      pSlab->pFreeList = pBlock;
+      UTILS_EXIT_CRITICAL_SECTION();
+
+      *pSlabSize -= ( (uint32_t)pSlab->iBlockWords * sizeof( uint32_t ) );
+      return true;
+    }
+  }
+
+  return false;
 }
+#endif /* (CFG_ZIGBEE_SLAB_SUPPORTED != 0) */
 
+#if (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0)
 /**
+ * @brief  Take the arena block in the ZIGBEE_INIT virtual memory, done only once.
+ */
+static void ZIGBEE_PLAT_ArenaInit( void )
+{
+  AMM_VirtualMemoryStats_t  stAmmStats;
+  uint32_t                  lOccupiedSize = 0u;
+  uint32_t                  * pBuffer;
+
+  if ( stZbInitArena.bInitDone == true )
+  {
+    return;
+  }
+  stZbInitArena.bInitDone = true;
+
+  if ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, &stAmmStats ) == AMM_ERROR_OK )
+  {
+    lOccupiedSize = stAmmStats.OccupiedSize;
+  }
+
+  if ( AMM_Alloc( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, CFG_ZIGBEE_INIT_ARENA_SIZE, &pBuffer, NULL ) != AMM_ERROR_OK )
+  {
+    /* No arena, the ZIGBEE_INIT allocations use the AMM */
+    return;
+  }
+
+  if ( AMM_GetVirtualMemoryStats( CFG_AMM_VIRTUAL_STACK_ZIGBEE_INIT, &stAmmStats ) == AMM_ERROR_OK )
+  {
+    stZbInitArena.lReservedSize = ( stAmmStats.OccupiedSize - lOccupiedSize ) * sizeof( uint32_t );
+  }
+
+  stZbInitArena.pBuffer = pBuffer;
+  stZbInitArena.lWords = CFG_ZIGBEE_INIT_ARENA_SIZE;
+  stZbInitArena.lOffset = 0u;
+  stZbInitArena.lLastOffset = 0u;
+  stZbInitArena.lLiveNbr = 0u;
+  stZbInitArena.bClosed = false;
+}
+
+/**
+ * @brief  Allocate a block at the end of the arena.
  *
+ * @param  iSize  Requested size in bytes.
+ * @retval Pointer on the block, NULL if the arena is full or closed.
  */
-unsigned long ZIGBEE_PLAT_HeapHighWaterMark( void )
+static void * ZIGBEE_PLAT_ArenaAlloc( uint32_t iSize )
 {
-    /* ZIGBEE_PLAT_HeapHighWaterMark is not updated in this file. */
-    return 0U;
+  uint32_t  lWords = BYTES_TO_WORD32( iSize );
+  uint32_t  * pBlock = NULL;
+
+  /* ZbHeapMalloc may be used before ZbHeapInit */
+  ZIGBEE_PLAT_ArenaInit();
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  if ( ( stZbInitArena.pBuffer != NULL ) && ( stZbInitArena.bClosed == false )
+    && ( lWords <= ( stZbInitArena.lWords - stZbInitArena.lOffset ) ) )
+  {
+    pBlock = &stZbInitArena.pBuffer[stZbInitArena.lOffset];
+    stZbInitArena.lLastOffset = stZbInitArena.lOffset;
+    stZbInitArena.lOffset += lWords;
+    stZbInitArena.lLiveNbr++;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return pBlock;
+}
+
+/**
+ * @brief  Release a block of the arena. The last block is given back, an other one closes the arena
+ *         until all the blocks are released.
+ *
+ * @param  ptr  Pointer on the block.
+ * @retval true if the block belongs to the arena, false if it comes from the pools or the AMM.
+ */
+static bool ZIGBEE_PLAT_ArenaFree( void * ptr )
+{
+  uint32_t  * pBlock = (uint32_t *)ptr;
+
+  if ( ( stZbInitArena.pBuffer == NULL ) || ( pBlock < stZbInitArena.pBuffer )
+    || ( pBlock >= &stZbInitArena.pBuffer[stZbInitArena.lOffset] ) )
+  {
+    return false;
+  }
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  stZbInitArena.lLiveNbr--;
+  if ( stZbInitArena.lLiveNbr == 0u )
+  {
+    /* Arena empty, restart from its beginning */
+    stZbInitArena.lOffset = 0u;
+    stZbInitArena.lLastOffset = 0u;
+    stZbInitArena.bClosed = false;
+  }
+  else if ( ( pBlock == &stZbInitArena.pBuffer[stZbInitArena.lLastOffset] ) && ( stZbInitArena.bClosed == false ) )
+  {
+    /* Last block, its space can be allocated again */
+    stZbInitArena.lOffset = stZbInitArena.lLastOffset;
+  }
+  else
+  {
+    /* The space of this block is lost until the arena is empty */
+    stZbInitArena.bClosed = true;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  return true;
 }
+#endif /* (CFG_ZIGBEE_INIT_ARENA_SUPPORTED != 0) */
@@ -35,11 +35,48 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
+/* Accounting of a Zigbee heap (sizes in bytes, allocator headers included) */
+typedef struct
+{
+  uint32_t  lUsedSize;          /* Memory currently used */
+  uint32_t  lPeakSize;          /* Highest memory used */
+  uint32_t  lAllocNbr;          /* Number of buffers currently allocated */
+  uint32_t  lAllocFailedNbr;    /* Number of allocations failed */
+  uint32_t  lLargestFreeBlock;  /* Largest buffer that can be allocated from the memory pool */
+} ZigbeePlatHeapStats_t;
+
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+/* Crypto entry points measured */
+typedef enum
+{
+  ZIGBEE_PLAT_CRYPTO_RNG_GET = 0,
+  ZIGBEE_PLAT_CRYPTO_RNG_PROCESS,
+  ZIGBEE_PLAT_CRYPTO_AES_ECB_ENCRYPT,
+  ZIGBEE_PLAT_CRYPTO_AES_CMAC_SET_KEY,
+  ZIGBEE_PLAT_CRYPTO_AES_CMAC_SET_VECTOR,
+  ZIGBEE_PLAT_CRYPTO_AES_CRYPT32,
+  ZIGBEE_PLAT_CRYPTO_AES_CRYPT,
+  ZIGBEE_PLAT_CRYPTO_AES_CMAC_COMPUTE,
+  ZIGBEE_PLAT_CRYPTO_AES_MMO_HASH,
+  ZIGBEE_PLAT_CRYPTO_AES_CCM_CRYPT,
+  ZIGBEE_PLAT_CRYPTO_STACK_AES_BLOCK,   /* Software AES block of the stack (frame security CCM*, hash) */
+  ZIGBEE_PLAT_CRYPTO_NBR
+} ZigbeePlatCryptoOp_t;
+
+/* Cost of a crypto entry point (DWT cycles) */
+typedef struct
+{
+  uint32_t  lCallNbr;           /* Number of calls */
+  uint32_t  lMaxCycles;         /* Longest call */
+  uint64_t  llTotalCycles;      /* Time spent in the calls */
+} ZigbeePlatCryptoStats_t;
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
 
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
+#define ZIGBEE_PLAT_CCM_NONCE_LENGTH        (13u)     /* CCM* nonce of the Zigbee frame security */
 
 /* USER CODE END EC */
 
@@ -82,6 +119,24 @@ extern unsigned long  ZIGBEE_PLAT_HeapUsed                ( void );
 extern unsigned long  ZIGBEE_PLAT_HeapHighWaterMark       ( void );
 
 /* USER CODE BEGIN EFP */
+extern bool           ZIGBEE_PLAT_GetHeapStats            ( uint8_t cVirtualMemoryId, ZigbeePlatHeapStats_t * pStats );
+extern void           ZIGBEE_PLAT_HeapLowNotification     ( bool bLow );
+extern bool           ZIGBEE_PLAT_IsHeapLow               ( void );
+#if (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0)
+extern void           ZIGBEE_PLAT_HeapTraceDump           ( bool bLeaksOnly );
+#endif /* (CFG_ZIGBEE_HEAP_TRACE_SUPPORTED != 0) */
+#if (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0)
+extern void           ZIGBEE_PLAT_HeapRecordStart         ( void );
+extern void           ZIGBEE_PLAT_HeapRecordStop          ( void );
+#endif /* (CFG_ZIGBEE_HEAP_RECORD_SUPPORTED != 0) */
+extern void           ZIGBEE_PLAT_AesMmoHash              ( const uint8_t * pInput, uint32_t lInputLength, uint8_t * pDigest );
+extern int            ZIGBEE_PLAT_AesCcmCrypt             ( uint8_t cMode, const uint8_t * pKey, const uint8_t * pNonce,
+                                                            const uint8_t * pAuth, uint16_t iAuthLength, const uint8_t * pInput,
+                                                            uint16_t iInputLength, uint8_t cMicLength, uint8_t * pMic, uint8_t * pOutput );
+#if (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0)
+extern bool           ZIGBEE_PLAT_GetCryptoStats          ( uint8_t cOperation, ZigbeePlatCryptoStats_t * pStats );
+extern void           ZIGBEE_PLAT_ResetCryptoStats        ( void );
+#endif /* (CFG_ZIGBEE_CRYPTO_STATS_SUPPORTED != 0) */
 
 /* USER CODE END EFP */
 
@@ -25,6 +25,7 @@
 #include "app_zigbee.h"
 #include "stm32_rtos.h"
 #include "zigbee.stm32wba.sys.h"
+#include "stm32_timer.h"
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN PD */
@@ -38,6 +39,10 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+/* Single timer of the Zigbee stack, armed at its next deadline */
+static UTIL_TIMER_Object_t  zigbee_timer;
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
 
 /* USER CODE END PV */
 
@@ -46,6 +51,22 @@
 
 /* USER CODE END GV */
 
+/* Private functions prototypes-----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+/* Timers of the Zigbee stack port, wrapped by the linker (--wrap) */
+extern void __real_ZbTimerWork(struct ZigBeeT * zb);
+void        __wrap_ZbTimerWork(struct ZigBeeT * zb);
+extern void __real_ZbPortHwTimerReStart(uint32_t timeout);
+void        __wrap_ZbPortHwTimerReStart(uint32_t timeout);
+extern void __real_ZbPortHwTimerStop(void);
+void        __wrap_ZbPortHwTimerStop(void);
+
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+static void ZigbeeSys_TimerElapsed(void * arg);
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+
+/* USER CODE END PFP */
+
 /* Functions Definition ------------------------------------------------------*/
 
 /**
@@ -69,6 +90,12 @@ void ZigbeeSys_Init(void)
   UTIL_SEQ_RegTask( TASK_ZIGBEE_LAYER, UTIL_SEQ_RFU, ZigbeeSys_Process);
   UTIL_SEQ_SetTask( TASK_ZIGBEE_LAYER, TASK_PRIO_ZIGBEE_LAYER );
 
+  /* USER CODE BEGIN ZigbeeSys_Init */
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+  UTIL_TIMER_Create( &zigbee_timer, 0, UTIL_TIMER_ONESHOT, &ZigbeeSys_TimerElapsed, NULL );
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+  /* USER CODE END ZigbeeSys_Init */
+
   /* Register Event is not needed */
 }
 
@@ -122,3 +149,77 @@ void ZigbeeSys_EventWait( void )
   /* Not used */
 }
 
+/* USER CODE BEGIN FD */
+/**
+  * @brief  Run of the Zigbee stack timers, called instead of ZbTimerWork() thanks to the linker --wrap option : the
+  *         timer is then armed at the exact next deadline (ZbCheckTime), or stopped when no timer is scheduled. A
+  *         timer started meanwhile by the stack (ZbTimerReset) posts the Zigbee task, that comes back here.
+  * @param  zb: Zigbee stack instance
+  * @retval None
+  */
+void __wrap_ZbTimerWork(struct ZigBeeT * zb)
+{
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+  uint32_t  timeout;
+
+  __real_ZbTimerWork( zb );
+
+  timeout = ZbCheckTime( zb );
+  if ( timeout == 0u )
+  {
+    UTIL_TIMER_Stop( &zigbee_timer );
+    UTIL_SEQ_SetTask( TASK_ZIGBEE_LAYER, TASK_PRIO_ZIGBEE_LAYER );
+  }
+  else if ( timeout == UINT32_MAX )
+  {
+    UTIL_TIMER_Stop( &zigbee_timer );
+  }
+  else
+  {
+    UTIL_TIMER_StartWithPeriod( &zigbee_timer, timeout );
+  }
+#else /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+  __real_ZbTimerWork( zb );
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+}
+
+/**
+  * @brief  Restart of the periodic timer of the port, called instead of ZbPortHwTimerReStart() thanks to the linker
+  *         --wrap option : not restarted with the bridge, ZbTimerWork arms the single timer.
+  * @param  timeout: period in ms (1000 ms when no timer is scheduled)
+  * @retval None
+  */
+void __wrap_ZbPortHwTimerReStart(uint32_t timeout)
+{
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+  UNUSED( timeout );
+#else /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+  __real_ZbPortHwTimerReStart( timeout );
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+}
+
+/**
+  * @brief  Stop of the periodic timer of the port, called instead of ZbPortHwTimerStop() thanks to the linker --wrap
+  *         option : still stopped, to end the timer started by the port at the initialization.
+  * @param  None
+  * @retval None
+  */
+void __wrap_ZbPortHwTimerStop(void)
+{
+  __real_ZbPortHwTimerStop();
+}
+
+#if (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0)
+/**
+  * @brief  Next deadline of the Zigbee stack timers reached.
+  * @param  arg: Not used
+  * @retval None
+  */
+static void ZigbeeSys_TimerElapsed(void * arg)
+{
+  UNUSED( arg );
+
+  UTIL_SEQ_SetTask( TASK_ZIGBEE_LAYER, TASK_PRIO_ZIGBEE_LAYER );
+}
+#endif /* (CFG_ZIGBEE_TIMER_BRIDGE_SUPPORTED != 0) */
+/* USER CODE END FD */
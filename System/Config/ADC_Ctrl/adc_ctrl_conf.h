@@ -0,0 +1,69 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    adc_ctrl_conf.h
+  * @author  MCD Application Team
+  * @brief   Configuration Header for adc_ctrl.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ADC_CTRL_CONF_H
+#define ADC_CTRL_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+/* Own header files */
+#include "adc_ctrl.h"
+
+/* ADC configuration types */
+#include "stm32wbaxx_ll_adc.h"
+#include "stm32wbaxx_ll_bus.h"
+#include "stm32wbaxx_ll_rcc.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/**
+ * @brief Physical address of the ADC to use
+ */
+#define ADCCTRL_HWADDR                ADC4
+
+/**
+ * @brief Clock of the ADC
+ */
+#define ADCTCTRL_SET_CLOCK_SOURCE()   LL_RCC_SetADCClockSource(LL_RCC_ADC_CLKSOURCE_HSI)
+#define ADCCTRL_ENABLE_CLOCK()        LL_AHB4_GRP1_EnableClock(LL_AHB4_GRP1_PERIPH_ADC4)
+#define ADCCTRL_DISABLE_CLOCK()       LL_AHB4_GRP1_DisableClock(LL_AHB4_GRP1_PERIPH_ADC4)
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* ADC handle used for the temperature measurements of the link layer */
+extern ADCCTRL_Handle_t LLTempRequest_Handle;
+
+#if (CFG_ADCCTRL_DMA_SUPPORTED != 0)
+/* ADC handle used for the supply voltage measurements of the application */
+extern ADCCTRL_Handle_t AppSupplyRequest_Handle;
+#endif /* (CFG_ADCCTRL_DMA_SUPPORTED != 0) */
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported functions prototypes ---------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_CTRL_CONF_H */
@@ -25,6 +25,9 @@
 /* HAL CRC header */
 #include "stm32wbaxx_hal_crc.h"
 
+/* Simple NVM Arbiter configuration */
+#include "simple_nvm_arbiter_conf.h"
+
 /* Global variables ----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
@@ -33,6 +36,24 @@
 
 
 /* USER CODE BEGIN User CRC configurations */
+/* CRC16 on 32 bits words, used by the Simple NVM Arbiter to check the banks integrity */
+CRCCTRL_Handle_t SNVMA_Handle =
+{
+  .Uid = 0x00,
+  .PreviousComputedValue = 0x00,
+  .State = HANDLE_NOT_REG,
+  .Configuration =
+  {
+    .DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE,
+    .DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE,
+    .GeneratingPolynomial = SNVMA_POLY_CRC16,
+    .CRCLength = CRC_POLYLENGTH_16B,
+    .InitValue = 0xFFFFu,
+    .InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE,
+    .OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE,
+    .InputDataFormat = CRC_INPUTDATA_FORMAT_WORDS,
+  },
+};
 
 /* USER CODE END User CRC configurations */
 
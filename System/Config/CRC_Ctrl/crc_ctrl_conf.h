@@ -39,9 +39,21 @@ extern "C" {
  */
 #define CRCCTRL_HWADDR   CRC
 
+/**
+ * @brief Feeding of the CRC by CRCCTRL_AccumulateStart : set to 1 for a GPDMA1 channel, to 0 for the CPU
+ */
+#define CRCCTRL_DMA_SUPPORTED   1u
+
+/**
+ * @brief GPDMA1 channel feeding the CRC - Not used by the USART (0, 1, 7) nor the AES (2, 3) transfers
+ */
+#define CRCCTRL_DMA_CHANNEL     LL_DMA_CHANNEL_4
+
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
+/* CRC handle used by the Simple NVM Arbiter */
+extern CRCCTRL_Handle_t SNVMA_Handle;
 
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions prototypes ---------------------------------------------*/
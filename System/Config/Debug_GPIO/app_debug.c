@@ -22,6 +22,7 @@
 #if (CFG_RT_DEBUG_GPIO_MODULE == 1)
 #include "RTDebug_dtb.h"
 #include "debug_config.h"
+#include "utilities_common.h"
 
 /******************************************************************/
 /** Association table between general debug signal and used gpio **/
@@ -790,12 +791,18 @@ const st_gpio_debug_t general_debug_table[RT_DEBUG_SIGNALS_TOTAL_NUM] = {
 
 void APP_DEBUG_SIGNAL_SET(app_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_APP, (uint32_t)signal, RT_DEBUG_ITM_ACTION_SET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_SET(signal, app_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
 }
 void APP_DEBUG_SIGNAL_RESET(app_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_APP, (uint32_t)signal, RT_DEBUG_ITM_ACTION_RESET);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_RESET(signal, app_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
@@ -803,11 +810,114 @@ void APP_DEBUG_SIGNAL_RESET(app_debug_signal_t signal)
 
 void APP_DEBUG_SIGNAL_TOGGLE(app_debug_signal_t signal)
 {
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMSignal(RT_DEBUG_ITM_PORT_APP, (uint32_t)signal, RT_DEBUG_ITM_ACTION_TOGGLE);
+#endif /* CFG_RT_DEBUG_ITM */
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   GENERIC_DEBUG_GPIO_TOGGLE(signal, app_debug_table);
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
 }
 
+/**************************************/
+/** Run bus : task or timer callback **/
+/**************************************/
+
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+#define RUN_BUS_WIDTH             (6U)
+#define RUN_BUS_MASK              (((1UL << RUN_BUS_WIDTH) - 1U) << GPIO_DEBUG_RUN_BUS_FIRST_PIN)
+#define RUN_BUS_TIMER_FIRST       (32U)
+#define RUN_BUS_TIMER_OTHER       (62U)
+#define RUN_BUS_IDLE              (63U)
+
+#if ((GPIO_DEBUG_RUN_BUS_FIRST_PIN + RUN_BUS_WIDTH) > 16U)
+#error "The run bus shall fit in the 16 pins of GPIO_DEBUG_RUN_BUS_PORT"
+#endif
+
+/* Code on the bus, and callbacks of the timer codes in the order of their first expiry */
+static volatile uint32_t run_bus_code = RUN_BUS_IDLE;
+static APP_DEBUG_TimerCallback_t run_bus_timer_callback[RUN_BUS_TIMER_OTHER - RUN_BUS_TIMER_FIRST];
+static uint32_t run_bus_timer_nb;
+
+/* One BSRR write : all the pins of the bus change at once */
+static void RUN_BUS_Write(uint32_t code)
+{
+  run_bus_code = code;
+  GPIO_DEBUG_RUN_BUS_PORT->BSRR = (RUN_BUS_MASK << 16U) | (code << GPIO_DEBUG_RUN_BUS_FIRST_PIN);
+}
+
+/**
+  * @brief  Start of a sequencer task (or of any code given its ID) on the run bus.
+  * @param  code: code to write on the bus
+  * @retval Code to restore at the end (task or callback interrupted, or idle)
+  */
+uint32_t APP_DEBUG_RunBusEnter(uint32_t code)
+{
+  uint32_t previous = run_bus_code;
+
+  RUN_BUS_Write(code & RUN_BUS_IDLE);
+  return previous;
+}
+
+/**
+  * @brief  Start of a timer callback on the run bus : the callback gets the next free timer code at its first
+  *         expiry, the callbacks beyond the last code share RUN_BUS_TIMER_OTHER.
+  * @param  callback: callback of the timer
+  * @retval Code to restore at the end
+  */
+uint32_t APP_DEBUG_RunBusEnterTimer(APP_DEBUG_TimerCallback_t callback)
+{
+  uint32_t index;
+  uint32_t code = RUN_BUS_TIMER_OTHER;
+
+  UTILS_ENTER_CRITICAL_SECTION();
+  for (index = 0; index < run_bus_timer_nb; index++)
+  {
+    if (run_bus_timer_callback[index] == callback)
+    {
+      break;
+    }
+  }
+  if ((index == run_bus_timer_nb) && (index < (RUN_BUS_TIMER_OTHER - RUN_BUS_TIMER_FIRST)))
+  {
+    run_bus_timer_callback[index] = callback;
+    run_bus_timer_nb++;
+  }
+  UTILS_EXIT_CRITICAL_SECTION();
+
+  if (index < run_bus_timer_nb)
+  {
+    code = RUN_BUS_TIMER_FIRST + index;
+  }
+
+  return APP_DEBUG_RunBusEnter(code);
+}
+
+/**
+  * @brief  End of a task or timer callback on the run bus.
+  * @param  previous: code returned at the start
+  * @retval None
+  */
+void APP_DEBUG_RunBusExit(uint32_t previous)
+{
+  RUN_BUS_Write(previous);
+}
+
+/**
+  * @brief  Callback of a timer code of the run bus.
+  * @param  code: timer code (32 to 61)
+  * @retval Callback, NULL if the code is not assigned yet
+  */
+APP_DEBUG_TimerCallback_t APP_DEBUG_RunBusGetTimerCallback(uint32_t code)
+{
+  if ((code < RUN_BUS_TIMER_FIRST) || ((code - RUN_BUS_TIMER_FIRST) >= run_bus_timer_nb))
+  {
+    return NULL;
+  }
+
+  return run_bus_timer_callback[code - RUN_BUS_TIMER_FIRST];
+}
+#endif /* CFG_RT_DEBUG_RUN_BUS */
+
 /*******************************/
 /** Debug GPIO Initialization **/
 /*******************************/
@@ -838,6 +948,13 @@ void RT_DEBUG_GPIO_Init(void)
       HAL_PWREx_EnableStandbyIORetention(pwr_gpio_port, general_debug_table[cpt].GPIO_pin);
     }
   }
+
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+  GPIO_InitStruct.Pin = RUN_BUS_MASK;
+  HAL_GPIO_Init(GPIO_DEBUG_RUN_BUS_PORT, &GPIO_InitStruct);
+  HAL_PWREx_EnableStandbyIORetention(GPIO_PORT_TO_PWR_NUM(GPIO_DEBUG_RUN_BUS_PORT), RUN_BUS_MASK);
+  RUN_BUS_Write(run_bus_code);
+#endif /* CFG_RT_DEBUG_RUN_BUS */
 #endif /* CFG_RT_DEBUG_GPIO_MODULE */
 }
 
@@ -60,6 +60,18 @@ void APP_DEBUG_SIGNAL_TOGGLE(app_debug_signal_t signal);
 /*******************************/
 void RT_DEBUG_GPIO_Init(void);
 
+#if (CFG_RT_DEBUG_RUN_BUS != 0)
+/**************************************/
+/** Run bus : task or timer callback **/
+/**************************************/
+typedef void (*APP_DEBUG_TimerCallback_t)(void *);
+
+uint32_t APP_DEBUG_RunBusEnter(uint32_t code);
+uint32_t APP_DEBUG_RunBusEnterTimer(APP_DEBUG_TimerCallback_t callback);
+void APP_DEBUG_RunBusExit(uint32_t previous);
+APP_DEBUG_TimerCallback_t APP_DEBUG_RunBusGetTimerCallback(uint32_t code);
+#endif /* CFG_RT_DEBUG_RUN_BUS */
+
 #ifdef __cplusplus
 }
 #endif
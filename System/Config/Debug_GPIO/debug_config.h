@@ -615,6 +615,11 @@ extern "C" {
 #define USE_RT_DEBUG_APP_APPE_INIT                            (0)
 #define GPIO_DEBUG_APP_APPE_INIT                              {GPIOA, GPIO_PIN_0}
 
+/* Run bus (CFG_RT_DEBUG_RUN_BUS) : 6 consecutive pins of one port, from GPIO_DEBUG_RUN_BUS_FIRST_PIN (index 0 to 10),
+   not shared with the signals above */
+#define GPIO_DEBUG_RUN_BUS_PORT                               GPIOB
+#define GPIO_DEBUG_RUN_BUS_FIRST_PIN                          (8U)
+
 /********************************/
 /** Debug configuration setup **/
 /*******************************/
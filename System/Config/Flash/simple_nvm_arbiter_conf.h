@@ -39,13 +39,32 @@ extern "C" {
 /* +                            NVM part - USER DEFINED                     + */
 /* ========================================================================== */
 
+/**
+ * @brief Layouts of the NVMs
+ *
+ * @details SNVMA_NVM_LAYOUT_SINGLE : one NVM, all the buffers are rewritten together.
+ *          SNVMA_NVM_LAYOUT_HOT_WARM_COLD : three NVMs, the buffers are placed by how often they change, a write
+ *          only rewrites the banks of the NVM of its buffer : hot data (network state, counters), warm data and cold
+ *          data (keys, endpoint configuration). Each NVM has its own bank number and size, and its own persistence
+ *          policy (coalescing window and max latency).
+ *
+ */
+#define SNVMA_NVM_LAYOUT_SINGLE         0u
+#define SNVMA_NVM_LAYOUT_HOT_WARM_COLD  1u
+
+#define SNVMA_NVM_LAYOUT                SNVMA_NVM_LAYOUT_SINGLE
+
 /**
  * @brief Number of managed NVMs
  *
  * @details This number must be lower than SNVMA_MAX_NUMBER_NVM
  *
  */
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+#define SNVMA_NVM_NUMBER                3u
+#else /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 #define SNVMA_NVM_NUMBER                1u
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 
 /**
  * @brief Polynomial value for CRC16
@@ -53,6 +72,35 @@ extern "C" {
  */
 #define SNVMA_POLY_CRC16                0x1DB7u
 
+/**
+ * @brief Coalescing window of the write requests in ms
+ *
+ * @details The requests received during the window are merged into one bank write.
+ *          Each request restarts the window, 0 starts the write at once (for all the NVMs).
+ *          Default policy of the NVMs, each one can have its own (SNVMA_NVM_ID_x_COALESCING_DELAY).
+ *
+ */
+#define SNVMA_WRITE_COALESCING_DELAY    100u
+
+/**
+ * @brief Max latency in ms between the first merged request and the start of the write
+ *
+ */
+#define SNVMA_WRITE_MAX_LATENCY         1000u
+
+#if (SNVMA_WRITE_COALESCING_DELAY > SNVMA_WRITE_MAX_LATENCY)
+#error The coalescing window shall not exceed the max latency
+#endif /* (SNVMA_WRITE_COALESCING_DELAY > SNVMA_WRITE_MAX_LATENCY) */
+
+/**
+ * @brief Skip the write when the buffers are the same as the restore bank
+ *
+ * @details The buffers are compared word by word with the last written bank : when unchanged, the
+ *          bank is neither programmed nor erased. Set to 0 to always write a new bank.
+ *
+ */
+#define SNVMA_WRITE_SKIP_UNCHANGED      1u
+
 /* Check that NVM number does not exceed limitations */
 #if SNVMA_NVM_NUMBER > SNVMA_MAX_NUMBER_NVM
 #error Number of NVM to manage is to high
@@ -62,26 +110,72 @@ extern "C" {
 /* +                        NVM IDs part - USER DEFINED                     + */
 /* ========================================================================== */
 
-/* NVM ID #1 */
+/* NVM ID #1 - Hot data with SNVMA_NVM_LAYOUT_HOT_WARM_COLD : one more bank spreads the erases of its frequent writes */
 #define SNVMA_NVM_ID_1
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+#define SNVMA_NVM_ID_1_BANK_NUMBER      3u
+#else /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 #define SNVMA_NVM_ID_1_BANK_NUMBER      2u
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 #define SNVMA_NVM_ID_1_BANK_SIZE        1u
+#define SNVMA_NVM_ID_1_COALESCING_DELAY SNVMA_WRITE_COALESCING_DELAY
+#define SNVMA_NVM_ID_1_MAX_LATENCY      SNVMA_WRITE_MAX_LATENCY
 
 #if (SNVMA_NVM_ID_1_BANK_NUMBER == 0u) || (SNVMA_NVM_ID_1_BANK_SIZE == 0u)
 #error NVM ID #1 => Bank not initialized
 #elif (SNVMA_NVM_ID_1_BANK_NUMBER < SNVMA_MIN_NUMBER_BANK)
 #error NVM ID #1 => Not enough bank
+#elif (SNVMA_NVM_ID_1_COALESCING_DELAY > SNVMA_NVM_ID_1_MAX_LATENCY)
+#error NVM ID #1 => The coalescing window shall not exceed the max latency
+#endif
+
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+/* NVM ID #2 - Warm data : changes now and then, a longer window merges its writes */
+#define SNVMA_NVM_ID_2
+#define SNVMA_NVM_ID_2_BANK_NUMBER      2u
+#define SNVMA_NVM_ID_2_BANK_SIZE        1u
+#define SNVMA_NVM_ID_2_COALESCING_DELAY 1000u
+#define SNVMA_NVM_ID_2_MAX_LATENCY      10000u
+
+#if (SNVMA_NVM_ID_2_BANK_NUMBER == 0u) || (SNVMA_NVM_ID_2_BANK_SIZE == 0u)
+#error NVM ID #2 => Bank not initialized
+#elif (SNVMA_NVM_ID_2_BANK_NUMBER < SNVMA_MIN_NUMBER_BANK)
+#error NVM ID #2 => Not enough bank
+#elif (SNVMA_NVM_ID_2_COALESCING_DELAY > SNVMA_NVM_ID_2_MAX_LATENCY)
+#error NVM ID #2 => The coalescing window shall not exceed the max latency
 #endif
 
+/* NVM ID #3 - Cold data : set at commissioning, written at once */
+#define SNVMA_NVM_ID_3
+#define SNVMA_NVM_ID_3_BANK_NUMBER      2u
+#define SNVMA_NVM_ID_3_BANK_SIZE        1u
+#define SNVMA_NVM_ID_3_COALESCING_DELAY 0u
+#define SNVMA_NVM_ID_3_MAX_LATENCY      SNVMA_WRITE_MAX_LATENCY
+
+#if (SNVMA_NVM_ID_3_BANK_NUMBER == 0u) || (SNVMA_NVM_ID_3_BANK_SIZE == 0u)
+#error NVM ID #3 => Bank not initialized
+#elif (SNVMA_NVM_ID_3_BANK_NUMBER < SNVMA_MIN_NUMBER_BANK)
+#error NVM ID #3 => Not enough bank
+#endif
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
+
 /* ========================================================================== */
 /* +                       Check part - NOT USER DEFINED                    + */
 /* ========================================================================== */
 
 /* Compute the number of sectors required */
 
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+#define SNVMA_NUMBER_OF_SECTOR_NEEDED ((SNVMA_NVM_ID_1_BANK_NUMBER * SNVMA_NVM_ID_1_BANK_SIZE) + \
+                                       (SNVMA_NVM_ID_2_BANK_NUMBER * SNVMA_NVM_ID_2_BANK_SIZE) + \
+                                       (SNVMA_NVM_ID_3_BANK_NUMBER * SNVMA_NVM_ID_3_BANK_SIZE))
+
+#define SNVMA_NUMBER_OF_BANKS (SNVMA_NVM_ID_1_BANK_NUMBER + SNVMA_NVM_ID_2_BANK_NUMBER + SNVMA_NVM_ID_3_BANK_NUMBER)
+#else /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 #define SNVMA_NUMBER_OF_SECTOR_NEEDED (SNVMA_NVM_ID_1_BANK_NUMBER * SNVMA_NVM_ID_1_BANK_SIZE)
 
 #define SNVMA_NUMBER_OF_BANKS (SNVMA_NVM_ID_1_BANK_NUMBER)
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
 
 /* Check that required number of sector does not exceed Flash capacities */
 #if SNVMA_NUMBER_OF_SECTOR_NEEDED == 0u
@@ -99,21 +193,35 @@ extern "C" {
 /**
  * @brief Enumeration of the Buffer IDs available
  *
- * @details Each NVM can handle up to 4 user IDs
+ * @details Each NVM can handle up to 4 user IDs : IDs 0 to 3 are in NVM ID #1, 4 to 7 in NVM ID #2, ...
  *
  * @details Enumeration member can be renamed to fit user needs - ie: SNVMA_BufferId_4 => SNVMA_BleNvmId
  *
  */
 typedef enum SNVMA_BufferId
 {
-  APP_BLE_NvmBuffer,
+  APP_ZIGBEE_NvmBuffer,
   SNVMA_BufferId_1,
   SNVMA_BufferId_2,
   SNVMA_BufferId_3,
+#if (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD)
+  /* NVM ID #2 - Warm data */
+  SNVMA_WarmBufferId_0,
+  SNVMA_WarmBufferId_1,
+  SNVMA_WarmBufferId_2,
+  SNVMA_WarmBufferId_3,
+  /* NVM ID #3 - Cold data */
+  SNVMA_ColdBufferId_0,
+  SNVMA_ColdBufferId_1,
+  SNVMA_ColdBufferId_2,
+  SNVMA_ColdBufferId_3,
+#endif /* (SNVMA_NVM_LAYOUT == SNVMA_NVM_LAYOUT_HOT_WARM_COLD) */
   SNVMA_BufferId_Max  /* End of the enumeration */
 }SNVMA_BufferId_t;
 
 /* Exported variables --------------------------------------------------------*/
+/* Configuration of the NVMs (bank number and size), defined by the application */
+extern SNVMA_NvmElt_t SNVMA_NvmConfiguration[SNVMA_NVM_NUMBER];
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
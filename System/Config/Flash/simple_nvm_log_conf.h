@@ -0,0 +1,76 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    simple_nvm_log_conf.h
+  * @author  MCD Application Team
+  * @brief   Configuration header for simple_nvm_log.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SIMPLE_NVM_LOG_CONF_H
+#define SIMPLE_NVM_LOG_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "utilities_common.h"
+
+#include "stm32wbaxx_hal_flash.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+/* ========================================================================== */
+/* +                           Log part - USER DEFINED                      + */
+/* ========================================================================== */
+
+/* Number of flash pages of the log : the records are appended in one page, the other one receives the compaction */
+#define SNVML_PAGE_NUMBER               2u
+
+/* Size in bytes of the data of a record - Shall be a multiple of 128 bits */
+#define SNVML_RECORD_SIZE               64u
+
+/* Maximum number of records of the registered buffer */
+#define SNVML_RECORD_MAX                64u
+
+/* ========================================================================== */
+/* +                       Check part - NOT USER DEFINED                    + */
+/* ========================================================================== */
+
+/* A slot holds a 16 bytes header, then the data of the record */
+#define SNVML_SLOT_SIZE                 (16u + SNVML_RECORD_SIZE)
+
+/* The first 16 bytes of a page hold its header */
+#define SNVML_SLOT_NUMBER               ((FLASH_PAGE_SIZE - 16u) / SNVML_SLOT_SIZE)
+
+#if (SNVML_PAGE_NUMBER != 2u)
+#error The log works with two flash pages
+#endif /* (SNVML_PAGE_NUMBER != 2u) */
+
+#if ((SNVML_RECORD_SIZE == 0u) || ((SNVML_RECORD_SIZE % 16u) != 0u))
+#error SNVML_RECORD_SIZE shall be a multiple of 128 bits
+#endif /* ((SNVML_RECORD_SIZE == 0u) || ((SNVML_RECORD_SIZE % 16u) != 0u)) */
+
+/* A compaction writes all the records and their commit in the empty page */
+#if ((SNVML_RECORD_MAX + 1u) > SNVML_SLOT_NUMBER)
+#error SNVML_RECORD_MAX records do not fit in a flash page
+#endif /* ((SNVML_RECORD_MAX + 1u) > SNVML_SLOT_NUMBER) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMPLE_NVM_LOG_CONF_H */
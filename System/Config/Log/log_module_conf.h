@@ -38,7 +38,8 @@ extern "C" {
 /**
  * @brief  When this define is set to 0, there is no time stamp added to the trace data.
  *         When this define is set to 1, the time stamp is added to the trace data,
- *         according to the function registered with Log_Module_RegisterTimeStampFunction.
+ *         according to the function registered with Log_Module_RegisterTimeStampFunction,
+ *         or else the value returned by the one registered with Log_Module_RegisterBinaryTimeStampFunction.
  */
 #define LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE    CFG_LOG_INSERT_TIME_STAMP_INSIDE_THE_TRACE
 
@@ -55,6 +56,56 @@ extern "C" {
  */
 #define LOG_INSERT_EOL_INSIDE_THE_TRACE           CFG_LOG_INSERT_EOL_INSIDE_THE_TRACE
 
+/**
+ * @brief  When this define is set to 0, the trace data is formatted on target.
+ *         When this define is set to 1, a binary frame is sent instead: format string address,
+ *         time stamp (see Log_Module_RegisterBinaryTimeStampFunction) and raw arguments.
+ *         Color and End Of Line insertions do not apply.
+ *         The text logs remain compiled in, and can be selected at runtime with Log_Module_Set_Binary_Mode.
+ */
+#define LOG_INSERT_BINARY_TRACE                   CFG_LOG_BINARY_SUPPORTED
+
+/**
+ * @brief  When this define is set to 1, each log is also given in binary form (same frame as LOG_INSERT_BINARY_TRACE)
+ *         to the function registered with Log_Module_RegisterCaptureFunction, whatever the runtime mode.
+ */
+#define LOG_INSERT_CAPTURE                        CFG_LOG_CAPTURE_SUPPORTED
+
+/**
+ * @brief  When this define is set to 0, the trace data is formatted in a buffer on the stack, then copied in the trace FIFO.
+ *         When this define is set to 1, the space is first allocated in the trace FIFO and the trace data
+ *         is formatted directly inside it (no copy and no large buffer on the stack).
+ */
+#define LOG_ZERO_COPY_TRACE                       CFG_LOG_ZERO_COPY_SUPPORTED
+
+/**
+ * @brief  When this define is set to 0, all the logs are printed.
+ *         When this define is set to 1, the number of logs per region can be limited (see Log_Module_Set_Rate_Limit).
+ */
+#define LOG_RATE_LIMIT                            CFG_LOG_RATE_LIMIT_SUPPORTED
+
+/**
+ * @brief  Number of regions that can be limited, starting from LOG_REGION_BLE.
+ */
+#define LOG_RATE_LIMIT_REGION_NBR                 (16u)
+
+/**
+ * @brief  Verbose levels compiled in, per region. The logs of a higher level compile to nothing (no call, no string);
+ *         Log_Module_Set_Verbose_Level and the region mask still filter at runtime the logs compiled in.
+ *         Values are the ones of Log_Verbose_Level_t, LOG_COMPILED_LEVEL_NONE removes all the logs of the region.
+ */
+#define LOG_COMPILED_LEVEL_NONE                   (-1)
+#define LOG_COMPILED_LEVEL_INFO                   (0)
+#define LOG_COMPILED_LEVEL_ERROR                  (1)
+#define LOG_COMPILED_LEVEL_WARNING                (2)
+#define LOG_COMPILED_LEVEL_DEBUG                  (3)
+
+#define LOG_COMPILED_LEVEL_BLE                    LOG_COMPILED_LEVEL_DEBUG
+#define LOG_COMPILED_LEVEL_SYSTEM                 LOG_COMPILED_LEVEL_DEBUG
+#define LOG_COMPILED_LEVEL_APP                    LOG_COMPILED_LEVEL_DEBUG
+#define LOG_COMPILED_LEVEL_LINKLAYER              LOG_COMPILED_LEVEL_DEBUG
+#define LOG_COMPILED_LEVEL_ZIGBEE                 LOG_COMPILED_LEVEL_DEBUG
+
 /* USER CODE BEGIN Module configuration */
 
 /* USER CODE END Module configuration */
@@ -163,19 +214,31 @@ typedef enum
 #define LOG_DISPLAY64()             "0x%08X%08X"
 #define LOG_NUMBER64( number )      (uint32_t)( number >> 32u ), (uint32_t)( number )
 
+/* True when the logs of the given level are compiled in for the given region */
+#define LOG_IS_COMPILED( region, level )  ( ( CFG_LOG_SUPPORTED != 0 ) && ( LOG_COMPILED_LEVEL_##region >= LOG_COMPILED_LEVEL_##level ) )
+
 /* Module API - Log macros for each region */
 /* LOG_REGION_BLE */
-#if (CFG_LOG_SUPPORTED != 0)
+#if LOG_IS_COMPILED( BLE, INFO )
 #define LOG_INFO_BLE(...)         Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_BLE, __VA_ARGS__)
-#define LOG_ERROR_BLE(...)        Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_BLE, __VA_ARGS__)
-#define LOG_WARNING_BLE(...)      Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_BLE, __VA_ARGS__)
-#define LOG_DEBUG_BLE(...)        Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_BLE, __VA_ARGS__)
-#else /* (CFG_LOG_SUPPORTED != 0) */
+#else /* LOG_IS_COMPILED( BLE, INFO ) */
 #define LOG_INFO_BLE(...)         do {} while(0)
+#endif /* LOG_IS_COMPILED( BLE, INFO ) */
+#if LOG_IS_COMPILED( BLE, ERROR )
+#define LOG_ERROR_BLE(...)        Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_BLE, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( BLE, ERROR ) */
 #define LOG_ERROR_BLE(...)        do {} while(0)
+#endif /* LOG_IS_COMPILED( BLE, ERROR ) */
+#if LOG_IS_COMPILED( BLE, WARNING )
+#define LOG_WARNING_BLE(...)      Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_BLE, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( BLE, WARNING ) */
 #define LOG_WARNING_BLE(...)      do {} while(0)
+#endif /* LOG_IS_COMPILED( BLE, WARNING ) */
+#if LOG_IS_COMPILED( BLE, DEBUG )
+#define LOG_DEBUG_BLE(...)        Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_BLE, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( BLE, DEBUG ) */
 #define LOG_DEBUG_BLE(...)        do {} while(0)
-#endif /* (CFG_LOG_SUPPORTED != 0) */
+#endif /* LOG_IS_COMPILED( BLE, DEBUG ) */
 
 /* USER CODE BEGIN LOG_REGION_BLE */
 /**
@@ -191,17 +254,26 @@ typedef enum
 /* USER CODE END LOG_REGION_BLE */
 
 /* LOG_REGION_SYSTEM */
-#if (CFG_LOG_SUPPORTED != 0)
+#if LOG_IS_COMPILED( SYSTEM, INFO )
 #define LOG_INFO_SYSTEM(...)      Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_SYSTEM, __VA_ARGS__)
-#define LOG_ERROR_SYSTEM(...)     Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_SYSTEM, __VA_ARGS__)
-#define LOG_WARNING_SYSTEM(...)   Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_SYSTEM, __VA_ARGS__)
-#define LOG_DEBUG_SYSTEM(...)     Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_SYSTEM, __VA_ARGS__)
-#else /* (CFG_LOG_SUPPORTED != 0) */
+#else /* LOG_IS_COMPILED( SYSTEM, INFO ) */
 #define LOG_INFO_SYSTEM(...)      do {} while(0)
+#endif /* LOG_IS_COMPILED( SYSTEM, INFO ) */
+#if LOG_IS_COMPILED( SYSTEM, ERROR )
+#define LOG_ERROR_SYSTEM(...)     Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_SYSTEM, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( SYSTEM, ERROR ) */
 #define LOG_ERROR_SYSTEM(...)     do {} while(0)
+#endif /* LOG_IS_COMPILED( SYSTEM, ERROR ) */
+#if LOG_IS_COMPILED( SYSTEM, WARNING )
+#define LOG_WARNING_SYSTEM(...)   Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_SYSTEM, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( SYSTEM, WARNING ) */
 #define LOG_WARNING_SYSTEM(...)   do {} while(0)
+#endif /* LOG_IS_COMPILED( SYSTEM, WARNING ) */
+#if LOG_IS_COMPILED( SYSTEM, DEBUG )
+#define LOG_DEBUG_SYSTEM(...)     Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_SYSTEM, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( SYSTEM, DEBUG ) */
 #define LOG_DEBUG_SYSTEM(...)     do {} while(0)
-#endif /* (CFG_LOG_SUPPORTED != 0) */
+#endif /* LOG_IS_COMPILED( SYSTEM, DEBUG ) */
 
 /* USER CODE BEGIN LOG_REGION_SYSTEM */
 /**
@@ -217,17 +289,36 @@ typedef enum
 /* USER CODE END LOG_REGION_SYSTEM */
 
 /* LOG_REGION_APP */
-#if (CFG_LOG_SUPPORTED != 0)
+#if LOG_IS_COMPILED( APP, INFO )
 #define LOG_INFO_APP(...)         Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_APP, __VA_ARGS__)
-#define LOG_ERROR_APP(...)        Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_APP, __VA_ARGS__)
-#define LOG_WARNING_APP(...)      Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_APP, __VA_ARGS__)
-#define LOG_DEBUG_APP(...)        Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_APP, __VA_ARGS__)
-#else /* (CFG_LOG_SUPPORTED != 0) */
+#else /* LOG_IS_COMPILED( APP, INFO ) */
 #define LOG_INFO_APP(...)         do {} while(0)
+#endif /* LOG_IS_COMPILED( APP, INFO ) */
+#if LOG_IS_COMPILED( APP, ERROR )
+#define LOG_ERROR_APP(...)        Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_APP, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( APP, ERROR ) */
 #define LOG_ERROR_APP(...)        do {} while(0)
+#endif /* LOG_IS_COMPILED( APP, ERROR ) */
+#if LOG_IS_COMPILED( APP, WARNING )
+#define LOG_WARNING_APP(...)      Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_APP, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( APP, WARNING ) */
 #define LOG_WARNING_APP(...)      do {} while(0)
+#endif /* LOG_IS_COMPILED( APP, WARNING ) */
+#if LOG_IS_COMPILED( APP, DEBUG )
+#define LOG_DEBUG_APP(...)        Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_APP, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( APP, DEBUG ) */
 #define LOG_DEBUG_APP(...)        do {} while(0)
-#endif /* (CFG_LOG_SUPPORTED != 0) */
+#endif /* LOG_IS_COMPILED( APP, DEBUG ) */
+#if LOG_IS_COMPILED( APP, INFO )
+#define LOG_HEXDUMP_INFO_APP( text, data, size )    Log_Module_HexDump( LOG_VERBOSE_INFO, LOG_REGION_APP, text, data, size, ' ' )
+#else /* LOG_IS_COMPILED( APP, INFO ) */
+#define LOG_HEXDUMP_INFO_APP( text, data, size )    do {} while(0)
+#endif /* LOG_IS_COMPILED( APP, INFO ) */
+#if LOG_IS_COMPILED( APP, DEBUG )
+#define LOG_HEXDUMP_DEBUG_APP( text, data, size )   Log_Module_HexDump( LOG_VERBOSE_DEBUG, LOG_REGION_APP, text, data, size, ' ' )
+#else /* LOG_IS_COMPILED( APP, DEBUG ) */
+#define LOG_HEXDUMP_DEBUG_APP( text, data, size )   do {} while(0)
+#endif /* LOG_IS_COMPILED( APP, DEBUG ) */
 
 /* USER CODE BEGIN LOG_REGION_APP */
 /**
@@ -243,17 +334,26 @@ typedef enum
 /* USER CODE END LOG_REGION_APP */
 
 /* LOG_REGION_LINKLAYER */
-#if (CFG_LOG_SUPPORTED != 0)
+#if LOG_IS_COMPILED( LINKLAYER, INFO )
 #define LOG_INFO_LINKLAYER(...)   Log_Module_Print( LOG_VERBOSE_INFO, LOG_REGION_LINKLAYER, __VA_ARGS__)
-#define LOG_ERROR_LINKLAYER(...)  Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_LINKLAYER, __VA_ARGS__)
-#define LOG_WARNING_LINKLAYER(...)Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_LINKLAYER, __VA_ARGS__)
-#define LOG_DEBUG_LINKLAYER(...)  Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_LINKLAYER, __VA_ARGS__)
-#else /* (CFG_LOG_SUPPORTED != 0) */
+#else /* LOG_IS_COMPILED( LINKLAYER, INFO ) */
 #define LOG_INFO_LINKLAYER(...)   do {} while(0)
+#endif /* LOG_IS_COMPILED( LINKLAYER, INFO ) */
+#if LOG_IS_COMPILED( LINKLAYER, ERROR )
+#define LOG_ERROR_LINKLAYER(...)  Log_Module_Print( LOG_VERBOSE_ERROR, LOG_REGION_LINKLAYER, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( LINKLAYER, ERROR ) */
 #define LOG_ERROR_LINKLAYER(...)  do {} while(0)
+#endif /* LOG_IS_COMPILED( LINKLAYER, ERROR ) */
+#if LOG_IS_COMPILED( LINKLAYER, WARNING )
+#define LOG_WARNING_LINKLAYER(...)Log_Module_Print( LOG_VERBOSE_WARNING, LOG_REGION_LINKLAYER, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( LINKLAYER, WARNING ) */
 #define LOG_WARNING_LINKLAYER(...)do {} while(0)
+#endif /* LOG_IS_COMPILED( LINKLAYER, WARNING ) */
+#if LOG_IS_COMPILED( LINKLAYER, DEBUG )
+#define LOG_DEBUG_LINKLAYER(...)  Log_Module_Print( LOG_VERBOSE_DEBUG, LOG_REGION_LINKLAYER, __VA_ARGS__)
+#else /* LOG_IS_COMPILED( LINKLAYER, DEBUG ) */
 #define LOG_DEBUG_LINKLAYER(...)  do {} while(0)
-#endif /* (CFG_LOG_SUPPORTED != 0) */
+#endif /* LOG_IS_COMPILED( LINKLAYER, DEBUG ) */
 
 /* USER CODE BEGIN LOG_REGION_LINKLAYER */
 /**
@@ -37,6 +37,50 @@ extern RNG_HandleTypeDef hrng;
 
 /* USER CODE END EV */
 
+/* USER CODE BEGIN PV */
+#if (CFG_LPM_STDBY_FAST_RESTORE != 0)
+/* GPIO registers lost in Standby. The output levels are held by the IO retention meanwhile */
+typedef struct
+{
+  uint32_t MODER;
+  uint32_t OTYPER;
+  uint32_t OSPEEDR;
+  uint32_t PUPDR;
+  uint32_t ODR;
+  uint32_t AFR[2];
+} StandbyGpioContext_t;
+
+/* EXTI registers lost in Standby, with the NVIC configuration of the EXTI lines */
+typedef struct
+{
+  uint32_t EXTICR[4];
+  uint32_t RTSR1;
+  uint32_t FTSR1;
+  uint32_t IMR1;
+  uint32_t EMR1;
+  uint32_t NvicEnable;                  /* Bit n : EXTIn_IRQn enabled */
+  uint8_t  NvicPriority[16];
+} StandbyExtiContext_t;
+
+static GPIO_TypeDef * const standby_gpio_port[] = { GPIOA, GPIOB, GPIOC, GPIOH };
+
+#define STANDBY_GPIO_PORT_NB    ( sizeof(standby_gpio_port) / sizeof(standby_gpio_port[0]) )
+
+/* In SRAM, retained in Standby (see SystemPower_Config()) */
+static StandbyGpioContext_t standby_gpio_context[STANDBY_GPIO_PORT_NB];
+static StandbyExtiContext_t standby_exti_context;
+static uint32_t             standby_context_saved;
+#endif /* (CFG_LPM_STDBY_FAST_RESTORE != 0) */
+
+/* USER CODE END PV */
+
+/* USER CODE BEGIN PFP */
+#if (CFG_LPM_STDBY_FAST_RESTORE != 0)
+static uint32_t StandbyExit_ContextRestore(void);
+#endif /* (CFG_LPM_STDBY_FAST_RESTORE != 0) */
+
+/* USER CODE END PFP */
+
 /* Functions Definition ------------------------------------------------------*/
 
 /**
@@ -84,7 +128,119 @@ void MX_StandbyExit_PeripheralInit(void)
   HAL_GPIO_Init(GPIOB, &DbgIOsInit);
 #endif /* CFG_DEBUGGER_LEVEL */
   /* USER CODE BEGIN MX_STANDBY_EXIT_PERIPHERAL_INIT_2 */
+#if (CFG_LPM_STDBY_FAST_RESTORE != 0)
+  /* The BSP handles are retained : only their registers need to be written again */
+  if ( StandbyExit_ContextRestore() == 0U )
+  {
+    APP_BSP_StandbyExit();
+  }
+#else
   APP_BSP_StandbyExit();
+#endif /* (CFG_LPM_STDBY_FAST_RESTORE != 0) */
 
   /* USER CODE END MX_STANDBY_EXIT_PERIPHERAL_INIT_2 */
 }
+
+/**
+  * @brief  Save the SoC peripheral registers lost in Standby mode (GPIO ports, EXTI lines).
+  * @param  None
+  * @retval None
+  */
+void MX_StandbyEntry_PeripheralSave(void)
+{
+  /* USER CODE BEGIN MX_STANDBY_ENTRY_PERIPHERAL_SAVE */
+#if (CFG_LPM_STDBY_FAST_RESTORE != 0)
+  uint32_t index;
+
+  for (index = 0; index < STANDBY_GPIO_PORT_NB; index++)
+  {
+    standby_gpio_context[index].MODER = standby_gpio_port[index]->MODER;
+    standby_gpio_context[index].OTYPER = standby_gpio_port[index]->OTYPER;
+    standby_gpio_context[index].OSPEEDR = standby_gpio_port[index]->OSPEEDR;
+    standby_gpio_context[index].PUPDR = standby_gpio_port[index]->PUPDR;
+    standby_gpio_context[index].ODR = standby_gpio_port[index]->ODR;
+    standby_gpio_context[index].AFR[0] = standby_gpio_port[index]->AFR[0];
+    standby_gpio_context[index].AFR[1] = standby_gpio_port[index]->AFR[1];
+  }
+
+  for (index = 0; index < 4U; index++)
+  {
+    standby_exti_context.EXTICR[index] = EXTI->EXTICR[index];
+  }
+  standby_exti_context.RTSR1 = EXTI->RTSR1;
+  standby_exti_context.FTSR1 = EXTI->FTSR1;
+  standby_exti_context.IMR1 = EXTI->IMR1;
+  standby_exti_context.EMR1 = EXTI->EMR1;
+
+  standby_exti_context.NvicEnable = 0U;
+  for (index = 0; index < 16U; index++)
+  {
+    if (NVIC_GetEnableIRQ((IRQn_Type)(EXTI0_IRQn + index)) != 0U)
+    {
+      standby_exti_context.NvicEnable |= (1UL << index);
+    }
+    standby_exti_context.NvicPriority[index] = (uint8_t)NVIC_GetPriority((IRQn_Type)(EXTI0_IRQn + index));
+  }
+
+  standby_context_saved = 1U;
+#endif /* (CFG_LPM_STDBY_FAST_RESTORE != 0) */
+  /* USER CODE END MX_STANDBY_ENTRY_PERIPHERAL_SAVE */
+}
+
+/* USER CODE BEGIN 1 */
+#if (CFG_LPM_STDBY_FAST_RESTORE != 0)
+/**
+  * @brief  Write back the GPIO and EXTI registers saved at the Standby entry. The output level is written
+  *         before the mode, so that the pins do not glitch when the IO retention is released.
+  * @param  None
+  * @retval 1 if restored, 0 if no snapshot is available (full init needed)
+  */
+static uint32_t StandbyExit_ContextRestore(void)
+{
+  uint32_t index;
+
+  if (standby_context_saved == 0U)
+  {
+    return 0U;
+  }
+
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_GPIOC_CLK_ENABLE();
+  __HAL_RCC_GPIOH_CLK_ENABLE();
+
+  for (index = 0; index < STANDBY_GPIO_PORT_NB; index++)
+  {
+    standby_gpio_port[index]->ODR = standby_gpio_context[index].ODR;
+    standby_gpio_port[index]->OTYPER = standby_gpio_context[index].OTYPER;
+    standby_gpio_port[index]->OSPEEDR = standby_gpio_context[index].OSPEEDR;
+    standby_gpio_port[index]->PUPDR = standby_gpio_context[index].PUPDR;
+    standby_gpio_port[index]->AFR[0] = standby_gpio_context[index].AFR[0];
+    standby_gpio_port[index]->AFR[1] = standby_gpio_context[index].AFR[1];
+    standby_gpio_port[index]->MODER = standby_gpio_context[index].MODER;
+  }
+
+  /* Port selection and edges first, the lines are unmasked last */
+  for (index = 0; index < 4U; index++)
+  {
+    EXTI->EXTICR[index] = standby_exti_context.EXTICR[index];
+  }
+  EXTI->RTSR1 = standby_exti_context.RTSR1;
+  EXTI->FTSR1 = standby_exti_context.FTSR1;
+  EXTI->EMR1 = standby_exti_context.EMR1;
+  EXTI->IMR1 = standby_exti_context.IMR1;
+
+  for (index = 0; index < 16U; index++)
+  {
+    if ((standby_exti_context.NvicEnable & (1UL << index)) != 0U)
+    {
+      NVIC_SetPriority((IRQn_Type)(EXTI0_IRQn + index), standby_exti_context.NvicPriority[index]);
+      NVIC_EnableIRQ((IRQn_Type)(EXTI0_IRQn + index));
+    }
+  }
+
+  return 1U;
+}
+#endif /* (CFG_LPM_STDBY_FAST_RESTORE != 0) */
+
+/* USER CODE END 1 */
@@ -28,4 +28,11 @@
   */
 void MX_StandbyExit_PeripheralInit(void);
 
+/**
+  * @brief  Save the SoC peripheral registers lost in Standby mode (GPIO ports, EXTI lines).
+  * @param  None
+  * @retval None
+  */
+void MX_StandbyEntry_PeripheralSave(void);
+
 #endif /* PERIPHERAL_INIT_H */
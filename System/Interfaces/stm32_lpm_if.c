@@ -39,6 +39,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "timer_if.h"
+#include "app_entry.h"
 
 /* USER CODE END Includes */
 
@@ -109,6 +111,12 @@ static RAMCFG_HandleTypeDef sram2_ns =
 };
 #endif /* CFG_SCM_SUPPORTED */
 /* USER CODE BEGIN PV */
+static PWR_LpmStats_t lpm_stats;
+static uint32_t lpm_sleep_start;      /* At the entry : DWT cycles in Sleep mode, RTC ticks in Stop and Standby */
+static uint32_t lpm_wakeup_cycle;     /* DWT cycles at the wake-up */
+static uint32_t lpm_wakeup_flags;     /* PWR wake-up flags read at the exit of Standby */
+static uint32_t lpm_wakeup_pending;   /* Wake-up not yet followed by a task */
+static uint32_t lpm_standby_exit;     /* PWR_ExitOffMode() restores the context lost in Standby */
 
 /* USER CODE END PV */
 
@@ -122,6 +130,10 @@ void Standby_Restore_GPIO(void);
 static void Enter_Stop_Standby_Mode(void);
 static void Exit_Stop_Standby_Mode(void);
 /* USER CODE BEGIN PFP */
+static void PWR_LpmEnter( PWR_LpmMode_t mode );
+static void PWR_LpmWakeup( PWR_LpmMode_t mode, uint32_t wakeup_flags );
+static PWR_WakeupSource_t PWR_WakeupSourceGet( uint32_t wakeup_flags );
+static void PWR_LpmRestoreMeasure( uint32_t restore_us );
 
 /* USER CODE END PFP */
 
@@ -298,6 +310,8 @@ OPTIMIZED void PWR_EnterOffMode( void )
   SYSTEM_DEBUG_SIGNAL_SET(LOW_POWER_STANDBY_MODE_ENTER);
 
   /* USER CODE BEGIN PWR_EnterOffMode_1 */
+  PWR_LpmEnter( PWR_LPM_STANDBY );
+  MX_StandbyEntry_PeripheralSave();
 
   /* USER CODE END PWR_EnterOffMode_1 */
 
@@ -373,6 +387,9 @@ OPTIMIZED void PWR_EnterOffMode( void )
 #if(CFG_RT_DEBUG_GPIO_MODULE == 1)
   RT_DEBUG_GPIO_Init();
 #endif /* (CFG_RT_DEBUG_GPIO_MODULE == 1) */
+#if(CFG_RT_DEBUG_ITM == 1)
+  RT_DEBUG_ITMInit();
+#endif /* (CFG_RT_DEBUG_ITM == 1) */
   }
 
   SYSTEM_DEBUG_SIGNAL_RESET(LOW_POWER_STANDBY_MODE_ACTIVE);
@@ -388,6 +405,19 @@ OPTIMIZED void PWR_ExitOffMode( void )
   SYSTEM_DEBUG_SIGNAL_SET(LOW_POWER_STANDBY_MODE_EXIT);
 
   /* USER CODE BEGIN PWR_ExitOffMode_1 */
+  /* The DWT is reset in Standby : the wake-up to first task latency counts from here */
+  if ( 1UL == boot_after_standby )
+  {
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    lpm_wakeup_flags = LL_PWR_ReadReg( WUSR );
+  }
+  else
+  {
+    lpm_wakeup_flags = 0U;
+  }
+  lpm_standby_exit = boot_after_standby;
+  lpm_wakeup_cycle = DWT->CYCCNT;
 
   /* USER CODE END PWR_ExitOffMode_1 */
 
@@ -432,6 +462,10 @@ OPTIMIZED void PWR_ExitOffMode( void )
     LINKLAYER_PLAT_NotifyWFIExit();
 
     /* USER CODE BEGIN PWR_ExitOffMode_2 */
+#if (CFG_SRAM_SCRATCH_SUPPORTED != 0)
+    /* Scratch pool lost in Standby (no buffer allocated) */
+    APPE_MEM_ScratchReset();
+#endif /* (CFG_SRAM_SCRATCH_SUPPORTED != 0) */
 
     /* USER CODE END PWR_ExitOffMode_2 */
 
@@ -467,6 +501,14 @@ OPTIMIZED void PWR_ExitOffMode( void )
   }
 
   /* USER CODE BEGIN PWR_ExitOffMode_3 */
+  /* Radio clock, peripherals and IOs restored : the system still runs on HSI16 here, the HSE being switched
+   * in its ready interrupt once this critical section is left */
+  if ( lpm_standby_exit != 0U )
+  {
+    PWR_LpmRestoreMeasure( ( DWT->CYCCNT - lpm_wakeup_cycle ) / ( HSI_VALUE / 1000000U ) );
+  }
+  /* RTC clock and wake-up interrupts enabled again : residency and source */
+  PWR_LpmWakeup( PWR_LPM_STANDBY, lpm_wakeup_flags );
 
   /* USER CODE END PWR_ExitOffMode_3 */
 
@@ -478,6 +520,7 @@ OPTIMIZED void PWR_EnterStopMode( void )
   SYSTEM_DEBUG_SIGNAL_SET(LOW_POWER_STOP_MODE_ENTER);
 
   /* USER CODE BEGIN PWR_EnterStopMode_1 */
+  PWR_LpmEnter( PWR_LPM_STOP );
 
   /* USER CODE END PWR_EnterStopMode_1 */
 
@@ -501,6 +544,7 @@ OPTIMIZED void PWR_EnterStopMode( void )
   SYS_WAITING_CYCLES_25();
 #endif /* STM32WBAXX_SI_CUT1_0 */
   /* USER CODE BEGIN PWR_EnterStopMode_2 */
+  PWR_LpmWakeup( PWR_LPM_STOP, 0U );
 
   /* USER CODE END PWR_EnterStopMode_2 */
 
@@ -532,6 +576,10 @@ OPTIMIZED void PWR_ExitStopMode( void )
 void PWR_EnterSleepMode( void )
 {
   /* USER CODE BEGIN PWR_EnterSleepMode_1 */
+  if (sleep_mode_disabled == 0)
+  {
+    PWR_LpmEnter( PWR_LPM_SLEEP );
+  }
 
   /* USER CODE END PWR_EnterSleepMode_1 */
 
@@ -547,6 +595,10 @@ void PWR_EnterSleepMode( void )
   }
 
   /* USER CODE BEGIN PWR_EnterSleepMode_2 */
+  if (sleep_mode_disabled == 0)
+  {
+    PWR_LpmWakeup( PWR_LPM_SLEEP, 0U );
+  }
 
   /* USER CODE END PWR_EnterSleepMode_2 */
 }
@@ -616,6 +668,139 @@ uint32_t is_boot_from_standby(void)
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 1 */
+/**
+  * @brief Entry in a low power mode : counted, and its start time kept for the residency.
+  *        The DWT is still clocked in Sleep mode, the RTC is used for Stop and Standby.
+  */
+static void PWR_LpmEnter( PWR_LpmMode_t mode )
+{
+  lpm_stats.Entries[mode]++;
+  lpm_sleep_start = ( mode == PWR_LPM_SLEEP ) ? DWT->CYCCNT : TIMER_IF_GetTimerValue();
+}
+
+/**
+  * @brief Wake-up from a low power mode : residency and wake-up source. The latency to the first task
+  *        counts from here, except from Standby where it counts from the start of PWR_ExitOffMode().
+  */
+static void PWR_LpmWakeup( PWR_LpmMode_t mode, uint32_t wakeup_flags )
+{
+  if ( mode == PWR_LPM_SLEEP )
+  {
+    lpm_stats.ResidencyUs[mode] += ( ( DWT->CYCCNT - lpm_sleep_start ) / ( SystemCoreClock / 1000000U ) );
+  }
+  else
+  {
+    lpm_stats.ResidencyUs[mode] += TIMER_IF_Convert_Tick2us( TIMER_IF_GetTimerValue() - lpm_sleep_start );
+  }
+
+  lpm_stats.Wakeups[mode][PWR_WakeupSourceGet( wakeup_flags )]++;
+
+  if ( mode != PWR_LPM_STANDBY )
+  {
+    lpm_wakeup_cycle = DWT->CYCCNT;
+  }
+  lpm_wakeup_pending = 1U;
+}
+
+/**
+  * @brief Source of the wake-up. From Standby, the PWR wake-up flags give the RTC (wake-up line 7) or the
+  *        wake-up pins. Otherwise, the interrupts are masked during the low power mode, so that the one
+  *        which woke up the system is still pending in the NVIC.
+  */
+static PWR_WakeupSource_t PWR_WakeupSourceGet( uint32_t wakeup_flags )
+{
+  uint32_t index;
+
+  if ( ( wakeup_flags & PWR_WUSR_WUF7 ) != 0U )
+  {
+    return PWR_WAKEUP_RTC;
+  }
+  if ( wakeup_flags != 0U )
+  {
+    return PWR_WAKEUP_EXTI;
+  }
+
+  if ( ( NVIC_GetPendingIRQ( RADIO_INTR_NUM ) != 0U ) || ( NVIC_GetPendingIRQ( RADIO_SW_LOW_INTR_NUM ) != 0U ) )
+  {
+    return PWR_WAKEUP_RADIO;
+  }
+  if ( NVIC_GetPendingIRQ( RTC_IRQn ) != 0U )
+  {
+    return PWR_WAKEUP_RTC;
+  }
+  for ( index = (uint32_t)EXTI0_IRQn; index <= (uint32_t)EXTI15_IRQn; index++ )
+  {
+    if ( NVIC_GetPendingIRQ( (IRQn_Type)index ) != 0U )
+    {
+      return PWR_WAKEUP_EXTI;
+    }
+  }
+  if ( NVIC_GetPendingIRQ( WKUP_IRQn ) != 0U )
+  {
+    return PWR_WAKEUP_EXTI;
+  }
+  if ( NVIC_GetPendingIRQ( USART1_IRQn ) != 0U )
+  {
+    return PWR_WAKEUP_UART;
+  }
+#if defined(USART2)
+  if ( NVIC_GetPendingIRQ( USART2_IRQn ) != 0U )
+  {
+    return PWR_WAKEUP_UART;
+  }
+#endif /* USART2 */
+  if ( NVIC_GetPendingIRQ( LPUART1_IRQn ) != 0U )
+  {
+    return PWR_WAKEUP_UART;
+  }
+  for ( index = 0U; index < ( sizeof( NVIC->ISPR ) / sizeof( NVIC->ISPR[0] ) ); index++ )
+  {
+    if ( NVIC->ISPR[index] != 0U )
+    {
+      return PWR_WAKEUP_OTHER;
+    }
+  }
+
+  return PWR_WAKEUP_UNKNOWN;
+}
+
+/**
+  * @brief Time from the Standby exit to the radio ready (end of PWR_ExitOffMode())
+  */
+static void PWR_LpmRestoreMeasure( uint32_t restore_us )
+{
+  lpm_stats.RestoreCount++;
+  lpm_stats.RestoreTotalUs += restore_us;
+  if ( restore_us > lpm_stats.RestoreMaxUs )
+  {
+    lpm_stats.RestoreMaxUs = restore_us;
+  }
+}
+
+void PWR_GetLpmStats( PWR_LpmStats_t * p_Stats )
+{
+  UTILS_ENTER_CRITICAL_SECTION();
+  *p_Stats = lpm_stats;
+  UTILS_EXIT_CRITICAL_SECTION();
+}
+
+void PWR_WakeupTaskStart( void )
+{
+  uint32_t latency_us;
+
+  if ( lpm_wakeup_pending != 0U )
+  {
+    lpm_wakeup_pending = 0U;
+    latency_us = ( DWT->CYCCNT - lpm_wakeup_cycle ) / ( SystemCoreClock / 1000000U );
+
+    lpm_stats.LatencyCount++;
+    lpm_stats.LatencyTotalUs += latency_us;
+    if ( latency_us > lpm_stats.LatencyMaxUs )
+    {
+      lpm_stats.LatencyMaxUs = latency_us;
+    }
+  }
+}
 
 /* USER CODE END 1 */
 
@@ -48,6 +48,40 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
+/* Low power modes of the statistics, in the order of UTIL_LPM_Mode_t */
+typedef enum
+{
+  PWR_LPM_SLEEP,
+  PWR_LPM_STOP,
+  PWR_LPM_STANDBY,
+  PWR_LPM_MODE_NB
+} PWR_LpmMode_t;
+
+/* Source of a wake-up, from the interrupt pending at the exit of the low power mode */
+typedef enum
+{
+  PWR_WAKEUP_RADIO,        /* 2.4 GHz radio (sleep timer or radio event) */
+  PWR_WAKEUP_RTC,          /* RTC alarm of the timer server */
+  PWR_WAKEUP_EXTI,         /* EXTI line (buttons) or, from Standby, a wake-up pin */
+  PWR_WAKEUP_UART,         /* USART1, USART2 or LPUART1 */
+  PWR_WAKEUP_OTHER,        /* Another interrupt */
+  PWR_WAKEUP_UNKNOWN,      /* No interrupt pending (event, or interrupt already served) */
+  PWR_WAKEUP_SOURCE_NB
+} PWR_WakeupSource_t;
+
+/* Statistics of the low power modes since the boot */
+typedef struct
+{
+  uint32_t Entries[PWR_LPM_MODE_NB];                          /* Entries in each mode */
+  uint64_t ResidencyUs[PWR_LPM_MODE_NB];                      /* Time spent in each mode in us */
+  uint32_t Wakeups[PWR_LPM_MODE_NB][PWR_WAKEUP_SOURCE_NB];    /* Wake-ups of each mode by each source */
+  uint32_t LatencyCount;                                      /* Wake-ups followed by a task */
+  uint64_t LatencyTotalUs;                                    /* Sum of the wake-up to first task latencies in us */
+  uint32_t LatencyMaxUs;                                      /* Longest wake-up to first task latency in us */
+  uint32_t RestoreCount;                                      /* Exits of Standby */
+  uint64_t RestoreTotalUs;                                    /* Sum of the Standby exit to radio ready times in us */
+  uint32_t RestoreMaxUs;                                      /* Longest Standby exit to radio ready time in us */
+} PWR_LpmStats_t;
 
 /* USER CODE END ET */
 
@@ -143,6 +177,15 @@ void restore_system_register(void);
 void Standby_Restore_GPIO(void);
 
 /* USER CODE BEGIN EFP */
+/**
+  * @brief Get the statistics of the low power modes
+  */
+void PWR_GetLpmStats( PWR_LpmStats_t * p_Stats );
+
+/**
+  * @brief Start of a task : wake-up to first task latency (called by the sequencer)
+  */
+void PWR_WakeupTaskStart( void );
 
 /* USER CODE END EFP */
 
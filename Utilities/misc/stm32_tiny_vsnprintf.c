@@ -75,6 +75,14 @@
 static char *lower_digits = "0123456789abcdefghijklmnopqrstuvwxyz";
 static char *upper_digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
+/* "00" to "99", to convert the decimal numbers two digits at a time */
+static const char decimal_pairs[200] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
 /* Functions Definition ------------------------------------------------------*/
 #ifdef TINY_PRINTF
 #else
@@ -97,7 +105,86 @@ static int ee_skip_atoi(const char **s)
 
 #define ASSIGN_STR(_c)  do { *str++ = (_c); max_size--; if (max_size == 0) return str; } while (0)
 
-static char *ee_number(char *str, int max_size, long num, int base, int size, int precision, int type)
+/* Digits of a 32 bits value in base 10, least significant first, two at a time */
+static int ee_decimal32(char *tmp, unsigned int num)
+{
+  int i = 0;
+  unsigned int pair;
+
+  while (num >= 100U)
+  {
+    pair = (num % 100U) * 2U;
+    num /= 100U;
+    tmp[i++] = decimal_pairs[pair + 1U];
+    tmp[i++] = decimal_pairs[pair];
+  }
+
+  if (num >= 10U)
+  {
+    pair = num * 2U;
+    tmp[i++] = decimal_pairs[pair + 1U];
+    tmp[i++] = decimal_pairs[pair];
+  }
+  else
+  {
+    tmp[i++] = (char)('0' + num);
+  }
+
+  return i;
+}
+
+/* Digits of a value, least significant first. The 64 bits divisions are only done above 32 bits */
+static int ee_digits(char *tmp, unsigned long long num, int base, const char *dig)
+{
+  int i = 0;
+  int j;
+  unsigned int low;
+  unsigned int num32;
+
+  if (base == 16)
+  {
+    /* One nibble per digit */
+    do
+    {
+      tmp[i++] = dig[(unsigned int)num & 0x0FU];
+      num >>= 4;
+    } while (num != 0U);
+  }
+  else if (base == 10)
+  {
+    /* Blocks of 8 digits until the value fits in 32 bits */
+    while ((num >> 32) != 0U)
+    {
+      low = (unsigned int)(num % 100000000U);
+      num /= 100000000U;
+      j = ee_decimal32(&tmp[i], low);
+      i += j;
+      while (j++ < 8) tmp[i++] = '0';
+    }
+    i += ee_decimal32(&tmp[i], (unsigned int)num);
+  }
+  else if ((num >> 32) == 0U)
+  {
+    num32 = (unsigned int)num;
+    do
+    {
+      tmp[i++] = dig[num32 % (unsigned) base];
+      num32 /= (unsigned) base;
+    } while (num32 != 0U);
+  }
+  else
+  {
+    do
+    {
+      tmp[i++] = dig[num % (unsigned) base];
+      num /= (unsigned) base;
+    } while (num != 0U);
+  }
+
+  return i;
+}
+
+static char *ee_number(char *str, int max_size, unsigned long long num, int base, int size, int precision, int type)
 {
   char c;
   char sign, tmp[66];
@@ -115,7 +202,7 @@ static char *ee_number(char *str, int max_size, long num, int base, int size, in
   sign = 0;
   if (type & SIGN)
   {
-    if (num < 0)
+    if ((long long) num < 0)
     {
       sign = '-';
       num = -num;
@@ -147,18 +234,7 @@ static char *ee_number(char *str, int max_size, long num, int base, int size, in
   }
 #endif
 
-  i = 0;
-
-  if (num == 0)
-    tmp[i++] = '0';
-  else
-  {
-    while (num != 0)
-    {
-      tmp[i++] = dig[((unsigned long) num) % (unsigned) base];
-      num = ((unsigned long) num) / (unsigned) base;
-    }
-  }
+  i = ee_digits(tmp, num, base, dig);
 
   if (i > precision) precision = i;
   size -= precision;
@@ -484,7 +560,7 @@ static char *flt(char *str, double num, int size, int precision, char fmt, int f
 
 int tiny_vsnprintf_like(char *buf, const int size, const char *fmt, va_list args)
 {
-  unsigned long num;
+  unsigned long long num;
   int base;
   char *str;
   int len;
@@ -572,17 +648,18 @@ repeat:
     }
 #endif
 
-    // Get the conversion qualifier
+    // Get the conversion qualifier ('q' for %ll)
     qualifier = -1;
-#ifdef TINY_PRINTF
-      /* Does not support %l and %L */
-#else
     if (*fmt == 'l' || *fmt == 'L')
     {
       qualifier = *fmt;
       fmt++;
+      if (qualifier == 'l' && *fmt == 'l')
+      {
+        qualifier = 'q';
+        fmt++;
+      }
     }
-#endif
 
     // Default base
     base = 10;
@@ -680,10 +757,12 @@ repeat:
         continue;
     }
 
-    if (qualifier == 'l')
-      num = va_arg(args, unsigned long);
+    if (qualifier == 'q')
+      num = va_arg(args, unsigned long long);
+    else if (qualifier == 'l')
+      num = (flags & SIGN) ? (unsigned long long) va_arg(args, long) : va_arg(args, unsigned long);
     else if (flags & SIGN)
-      num = va_arg(args, int);
+      num = (unsigned long long) va_arg(args, int);
     else
       num = va_arg(args, unsigned int);
 
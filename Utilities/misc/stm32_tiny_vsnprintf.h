@@ -37,7 +37,8 @@ extern "C"
  *
  *         It has been adapted so that:
  *         - Tiny implementation, when defining TINY_PRINTF, is available. In such as case,
- *           not all the format are available. Instead, only %02X, %x, %d, %u, %s and %c are available.
+ *           not all the format are available. Instead, only %02X, %x, %d, %u, %s and %c are available,
+ *           with the l and ll (64 bits) qualifiers.
  *           %f,, %+, %#, %- and others are excluded
  *         - Provide a snprintf like implementation. The size of the buffer is provided,
  *           and the length of the filled buffer is returned (not including the final '\0' char).
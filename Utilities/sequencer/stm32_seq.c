@@ -20,6 +20,32 @@
 #include "stm32_seq.h"
 #include "utilities_conf.h"
 
+/**
+ * @brief number of delayed task slots, 0 (default) removes the delayed task feature.
+ *        Can be redefined in utilities_conf.h
+ */
+#ifndef UTIL_SEQ_CONF_DELAYED_TASK_NBR
+  #define UTIL_SEQ_CONF_DELAYED_TASK_NBR  (0)
+#endif
+
+/**
+ * @brief deferrable tasks, 0 (default) removes the feature.
+ *        Can be redefined in utilities_conf.h
+ *        When enabled, a task registered with UTIL_SEQ_TASK_DEFERRABLE does not prevent the idle : it runs on the
+ *        next wakeup that runs a task not deferrable, or once UTIL_SEQ_CONF_DEFER_MAX_MS has elapsed since it was set.
+ */
+#ifndef UTIL_SEQ_CONF_DEFERRABLE
+  #define UTIL_SEQ_CONF_DEFERRABLE  (0)
+#endif
+
+#ifndef UTIL_SEQ_CONF_DEFER_MAX_MS
+  #define UTIL_SEQ_CONF_DEFER_MAX_MS  (1000U)
+#endif
+
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0) || (UTIL_SEQ_CONF_DEFERRABLE == 1)
+#include "stm32_timer.h"
+#endif /* (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0) || (UTIL_SEQ_CONF_DEFERRABLE == 1) */
+
 /** @addtogroup SEQUENCER
   * @{
   */
@@ -34,10 +60,22 @@
  */
 typedef struct
 {
-  uint32_t priority;    /*!<bit field of the enabled task.          */
-  uint32_t round_robin; /*!<mask on the allowed task to be running. */
+  UTIL_SEQ_bm_t priority;    /*!<bit field of the enabled task.          */
+  UTIL_SEQ_bm_t round_robin; /*!<mask on the allowed task to be running. */
 } UTIL_SEQ_Priority_t;
 
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+/**
+ * @brief structure used to manage a delayed task request
+ */
+typedef struct
+{
+  UTIL_TIMER_Object_t Timer;     /*!<timer server object of the request.        */
+  UTIL_SEQ_bm_t       TaskId_bm; /*!<task to be set, 0 when the slot is free.   */
+  uint32_t            Task_Prio; /*!<priority used to set the task.             */
+} UTIL_SEQ_DelayedTask_t;
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+
 /**
  * @}
  */
@@ -74,24 +112,32 @@ typedef struct
 #define UTIL_SEQ_NOTASKRUNNING       (0xFFFFFFFFU)
 
 /**
- * @brief define to represent no bit set inside uint32_t mapping
+ * @brief define to represent no bit set inside UTIL_SEQ_bm_t mapping
  */
 #define UTIL_SEQ_NO_BIT_SET     (0U)
 
 /**
- * @brief define to represent all bits set inside uint32_t mapping
+ * @brief define to represent all bits set inside UTIL_SEQ_bm_t mapping
  */
-#define UTIL_SEQ_ALL_BIT_SET    (~0U)
+#define UTIL_SEQ_ALL_BIT_SET    (~(UTIL_SEQ_bm_t)0U)
 
 /**
- * @brief default number of task is default 32 (maximum), can be reduced by redefining in utilities_conf.h
+ * @brief bit used to represent a priority level inside the PrioLevelSet summary mask.
+ *        The level 0 (highest priority) is mapped on the MSB so that the highest non-empty
+ *        level is found with a single count leading zero.
+ */
+#define UTIL_SEQ_PRIO_LEVEL_BIT( _PRIO_ )    ( 0x80000000U >> (_PRIO_) )
+
+/**
+ * @brief default number of task is default 32, can be changed by redefining in utilities_conf.h
+ *        (up to 64 : above 32 the task bit mapping UTIL_SEQ_bm_t is 64 bits wide)
  */
 #ifndef UTIL_SEQ_CONF_TASK_NBR
 	#define UTIL_SEQ_CONF_TASK_NBR  (32)
 #endif
 
-#if UTIL_SEQ_CONF_TASK_NBR > 32
-#error "UTIL_SEQ_CONF_TASK_NBR must be less than or equal to 32"
+#if UTIL_SEQ_CONF_TASK_NBR > 64
+#error "UTIL_SEQ_CONF_TASK_NBR must be less than or equal to 64"
 #endif
 
 /**
@@ -101,6 +147,114 @@ typedef struct
   #define UTIL_SEQ_CONF_PRIO_NBR  (2)
 #endif
 
+#if UTIL_SEQ_CONF_PRIO_NBR > 32
+#error "UTIL_SEQ_CONF_PRIO_NBR must be less than or equal to 32"
+#endif
+
+/**
+ * @brief task profiling is disabled by default, can be enabled by redefining in utilities_conf.h
+ *        When enabled, UTIL_SEQ_PROFILING_GET_TIME() shall return a free running 32 bits counter
+ *        and UTIL_SEQ_PROFILING_INIT() may be defined to start it.
+ */
+#ifndef UTIL_SEQ_CONF_PROFILING
+  #define UTIL_SEQ_CONF_PROFILING  (0)
+#endif
+
+/**
+ * @brief task budget check is disabled by default, can be enabled by redefining in utilities_conf.h
+ *        When enabled, UTIL_SEQ_TaskOverBudget() is called each time a task runs longer than the budget
+ *        set with UTIL_SEQ_SetTaskBudget(). It uses the same time base as the profiling.
+ */
+#ifndef UTIL_SEQ_CONF_TASK_BUDGET
+  #define UTIL_SEQ_CONF_TASK_BUDGET  (0)
+#endif
+
+/**
+ * @brief hook called just before each task is executed, empty by default, can be redefined in utilities_conf.h
+ */
+#ifndef UTIL_SEQ_TASK_START_HOOK
+  #define UTIL_SEQ_TASK_START_HOOK( )
+#endif
+
+/**
+ * @brief trace of the task execution, empty by default, can be redefined in utilities_conf.h
+ *        UTIL_SEQ_TASK_TRACE_ENTER( ) is called with the task index just before the task and returns a value given
+ *        back to UTIL_SEQ_TASK_TRACE_EXIT( ) just after it (i.e. the trace state to restore on nested calls).
+ */
+#ifndef UTIL_SEQ_TASK_TRACE_ENTER
+  #define UTIL_SEQ_TASK_TRACE_ENTER( _ID_ )        ( 0U )
+#endif
+
+#ifndef UTIL_SEQ_TASK_TRACE_EXIT
+  #define UTIL_SEQ_TASK_TRACE_EXIT( _PREVIOUS_ )   ( (void)( _PREVIOUS_ ) )
+#endif
+
+/**
+ * @brief hook called just after each task is executed, empty by default, can be redefined in utilities_conf.h
+ *        It is given the index of the task and the nesting level of UTIL_SEQ_Run( ) (1 for the main loop).
+ */
+#ifndef UTIL_SEQ_TASK_END_HOOK
+  #define UTIL_SEQ_TASK_END_HOOK( _ID_, _NESTING_ )
+#endif
+
+/**
+ * @brief check of the priority given to UTIL_SEQ_SetTask( ), returns the priority to use, unchanged by default,
+ *        can be redefined in utilities_conf.h (i.e. to keep a priority level reserved to some tasks).
+ */
+#ifndef UTIL_SEQ_TASK_PRIO_CHECK
+  #define UTIL_SEQ_TASK_PRIO_CHECK( _TASK_BM_, _PRIO_ )   ( _PRIO_ )
+#endif
+
+#if (UTIL_SEQ_CONF_PROFILING == 1) || (UTIL_SEQ_CONF_TASK_BUDGET == 1)
+#define SEQ_TASK_TIMING  (1)
+#else
+#define SEQ_TASK_TIMING  (0)
+#endif
+
+#if (SEQ_TASK_TIMING == 1)
+#ifndef UTIL_SEQ_PROFILING_GET_TIME
+#error "UTIL_SEQ_PROFILING_GET_TIME() shall be defined when UTIL_SEQ_CONF_PROFILING or UTIL_SEQ_CONF_TASK_BUDGET is set to 1"
+#endif
+
+#ifndef UTIL_SEQ_PROFILING_INIT
+  #define UTIL_SEQ_PROFILING_INIT( )
+#endif
+#endif /* SEQ_TASK_TIMING == 1 */
+
+/**
+ * @brief deadline scheduling, 0 (default) removes the feature. Can be redefined in utilities_conf.h
+ *        When enabled, the tasks set with UTIL_SEQ_SetTaskDeadline( ) are run before the other tasks of their
+ *        priority level, the earliest deadline first, and UTIL_SEQ_DEADLINE_GET_TIME() shall return a free running
+ *        32 bits counter in the unit of the deadlines.
+ */
+#ifndef UTIL_SEQ_CONF_DEADLINE
+  #define UTIL_SEQ_CONF_DEADLINE  (0)
+#endif
+
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+#ifndef UTIL_SEQ_DEADLINE_GET_TIME
+#error "UTIL_SEQ_DEADLINE_GET_TIME() shall be defined when UTIL_SEQ_CONF_DEADLINE is set to 1"
+#endif
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
+/**
+ * @brief message queue feature, 0 (default) removes the messages queues.
+ *        Can be redefined in utilities_conf.h
+ */
+#ifndef UTIL_SEQ_CONF_MSG_QUEUE
+  #define UTIL_SEQ_CONF_MSG_QUEUE  (0)
+#endif
+
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+/**
+ * @brief memory barrier between the copy of a message and the update of the queue counters.
+ *        Should be redefined in utilities_conf.h (i.e. __DMB()).
+ */
+#ifndef UTIL_SEQ_MSG_BARRIER
+  #define UTIL_SEQ_MSG_BARRIER( )
+#endif
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+
 /**
  * @brief default memset function.
  */
@@ -108,6 +262,14 @@ typedef struct
 #define UTIL_SEQ_MEMSET8( dest, value, size )   UTILS_MEMSET8( dest, value, size )
 #endif
 
+/**
+ * @brief default placement attribute of the sequencer loop, can be redefined in utilities_conf.h
+ *        to run it from a RAM section.
+ */
+#ifndef UTIL_SEQ_HOT_CODE
+#define UTIL_SEQ_HOT_CODE
+#endif
+
 /**
  * @}
  */
@@ -133,6 +295,41 @@ static volatile UTIL_SEQ_bm_t TaskMask = UTIL_SEQ_ALL_BIT_SET;
  */
 static UTIL_SEQ_bm_t SuperMask = UTIL_SEQ_ALL_BIT_SET;
 
+/**
+ * @brief nesting level of UTIL_SEQ_Run( ).
+ */
+static uint32_t RunNesting;
+
+/**
+ * @brief set by UTIL_SEQ_Yield( ) : the next UTIL_SEQ_Run( ) returns without entering the idle.
+ */
+static uint32_t YieldRequest;
+
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+/**
+ * @brief tasks registered with UTIL_SEQ_TASK_DEFERRABLE.
+ */
+static UTIL_SEQ_bm_t DeferrableMask = UTIL_SEQ_NO_BIT_SET;
+
+/**
+ * @brief set once a task not deferrable has run since the last idle, or when the deferral bound has elapsed :
+ *        the deferrable tasks pending are then run with it.
+ */
+static volatile uint32_t DeferRelease = 0U;
+
+/**
+ * @brief deferral bound of the deferrable tasks, started when the first one is set.
+ */
+static UTIL_TIMER_Object_t DeferTimer;
+
+/**
+ * @brief deferrable tasks held (not run) until the next release.
+ */
+#define SEQ_DEFER_HELD( )  ( ( DeferRelease == 0U ) ? DeferrableMask : UTIL_SEQ_NO_BIT_SET )
+#else
+#define SEQ_DEFER_HELD( )  ( UTIL_SEQ_NO_BIT_SET )
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
+
 /**
  * @brief evt set mask.
  */
@@ -158,6 +355,77 @@ static void (*TaskCb[UTIL_SEQ_CONF_TASK_NBR])( void );
  */
 static volatile UTIL_SEQ_Priority_t TaskPrio[UTIL_SEQ_CONF_PRIO_NBR];
 
+/**
+ * @brief summary of the priority levels that have at least one task pending.
+ *        A bit is set when TaskPrio[n].priority is not empty (see UTIL_SEQ_PRIO_LEVEL_BIT).
+ */
+static volatile uint32_t PrioLevelSet = UTIL_SEQ_NO_BIT_SET;
+
+/**
+ * @brief tasks waiting for an event with UTIL_SEQ_SetTaskOnEvt().
+ */
+static volatile UTIL_SEQ_bm_t EvtTaskSet = UTIL_SEQ_NO_BIT_SET;
+
+/**
+ * @brief events waited by each task registered with UTIL_SEQ_SetTaskOnEvt().
+ */
+static UTIL_SEQ_bm_t EvtTaskWaited[UTIL_SEQ_CONF_TASK_NBR];
+
+/**
+ * @brief priority used to set each task registered with UTIL_SEQ_SetTaskOnEvt().
+ */
+static uint8_t EvtTaskPrio[UTIL_SEQ_CONF_TASK_NBR];
+
+#if (UTIL_SEQ_CONF_TASK_BUDGET == 1)
+/**
+ * @brief execution time budget of each task, 0 when not checked.
+ */
+static uint32_t TaskBudget[UTIL_SEQ_CONF_TASK_NBR];
+#endif /* UTIL_SEQ_CONF_TASK_BUDGET == 1 */
+
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+/**
+ * @brief message queue of each task.
+ */
+static UTIL_SEQ_MsgQueue_t *MsgQueue[UTIL_SEQ_CONF_TASK_NBR];
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+/**
+ * @brief delayed task slots.
+ */
+static UTIL_SEQ_DelayedTask_t DelayedTask[UTIL_SEQ_CONF_DELAYED_TASK_NBR];
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+/**
+ * @brief task execution statistics.
+ */
+static UTIL_SEQ_TaskStats_t TaskStats[UTIL_SEQ_CONF_TASK_NBR];
+
+/**
+ * @brief time of the UTIL_SEQ_SetTask() call that made the task pending.
+ */
+static volatile uint32_t TaskSetTime[UTIL_SEQ_CONF_TASK_NBR];
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+/**
+ * @brief tasks pending with a deadline.
+ */
+static volatile UTIL_SEQ_bm_t DeadlineSet = UTIL_SEQ_NO_BIT_SET;
+
+/**
+ * @brief deadline of each task of DeadlineSet (in the unit of UTIL_SEQ_DEADLINE_GET_TIME()).
+ */
+static uint32_t TaskDeadline[UTIL_SEQ_CONF_TASK_NBR];
+
+/**
+ * @brief deadline statistics of each task.
+ */
+static UTIL_SEQ_DeadlineStats_t DeadlineStats[UTIL_SEQ_CONF_TASK_NBR];
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
 /**
  * @}
  */
@@ -166,7 +434,21 @@ static volatile UTIL_SEQ_Priority_t TaskPrio[UTIL_SEQ_CONF_PRIO_NBR];
 /** @defgroup SEQUENCER_Private_function SEQUENCER private functions
  *  @{
  */
-uint8_t SEQ_BitPosition(uint32_t Value);
+uint8_t SEQ_BitPosition(UTIL_SEQ_bm_t Value);
+static void SEQ_EvtTaskRelease(void);
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+static uint32_t SEQ_StartDelayedTask(UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t TimeMs, UTIL_TIMER_Mode_t Mode);
+static void SEQ_DelayedTaskElapsed(void *Argument);
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+static void SEQ_ProfilingRecord(uint32_t TaskIdx, uint32_t StartTime, uint32_t EndTime);
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+static void SEQ_DeferElapsed(void *Argument);
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+static uint32_t SEQ_EarliestDeadline(UTIL_SEQ_bm_t TaskSet_bm);
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
 
 /**
  * @}
@@ -184,13 +466,35 @@ void UTIL_SEQ_Init( void )
   SuperMask = UTIL_SEQ_ALL_BIT_SET;
   EvtSet = UTIL_SEQ_NO_BIT_SET;
   EvtWaited = UTIL_SEQ_NO_BIT_SET;
+  PrioLevelSet = UTIL_SEQ_NO_BIT_SET;
   CurrentTaskIdx = 0U;
+  EvtTaskSet = UTIL_SEQ_NO_BIT_SET;
   (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskCb, 0, sizeof(TaskCb));
   for(uint32_t index = 0; index < UTIL_SEQ_CONF_PRIO_NBR; index++)
   {
       TaskPrio[index].priority = 0;
       TaskPrio[index].round_robin = 0;
   }
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)MsgQueue, 0, sizeof(MsgQueue));
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)DelayedTask, 0, sizeof(DelayedTask));
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+#if (SEQ_TASK_TIMING == 1)
+  UTIL_SEQ_PROFILING_INIT( );
+#endif /* SEQ_TASK_TIMING == 1 */
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskStats, 0, sizeof(TaskStats));
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+#if (UTIL_SEQ_CONF_TASK_BUDGET == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskBudget, 0, sizeof(TaskBudget));
+#endif /* UTIL_SEQ_CONF_TASK_BUDGET == 1 */
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+  DeferrableMask = UTIL_SEQ_NO_BIT_SET;
+  DeferRelease = 0U;
+  (void)UTIL_TIMER_Create( &DeferTimer, UTIL_SEQ_CONF_DEFER_MAX_MS, UTIL_TIMER_ONESHOT, SEQ_DeferElapsed, NULL );
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
   UTIL_SEQ_INIT_CRITICAL_SECTION( );
 }
 
@@ -204,15 +508,28 @@ void UTIL_SEQ_DeInit( void )
  * Note: These variables could have been declared static in the function.
  *
  */
-void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
+UTIL_SEQ_HOT_CODE void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
 {
   uint32_t counter;
+  uint32_t prio_level_set;
   UTIL_SEQ_bm_t current_task_set;
   UTIL_SEQ_bm_t super_mask_backup;
   UTIL_SEQ_bm_t local_taskset;
   UTIL_SEQ_bm_t local_evtset;
   UTIL_SEQ_bm_t local_taskmask;
   UTIL_SEQ_bm_t local_evtwaited;
+  uint32_t trace_previous;
+  uint32_t task_idx;
+  uint32_t no_idle;
+#if (SEQ_TASK_TIMING == 1)
+  uint32_t start_time;
+  uint32_t end_time;
+#endif /* SEQ_TASK_TIMING == 1 */
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+  uint32_t deadline = 0U;
+  uint32_t deadline_set;
+  int32_t lateness;
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
 
   /*
    * When this function is nested, the mask to be applied cannot be larger than the first call
@@ -221,6 +538,9 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
    */
   super_mask_backup = SuperMask;
   SuperMask &= Mask_bm;
+  RunNesting++;
+  no_idle = YieldRequest;
+  YieldRequest = 0U;
 
   /*
    * There are two independent mask to check:
@@ -231,22 +551,24 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
    */
   local_taskset = TaskSet;
   local_evtset = EvtSet;
-  local_taskmask = TaskMask;
+  local_taskmask = TaskMask & ~SEQ_DEFER_HELD( );
   local_evtwaited =  EvtWaited;
   while(((local_taskset & local_taskmask & SuperMask) != 0U) && ((local_evtset & local_evtwaited)==0U))
   {
-    counter = 0U;
     /*
      * When a flag is set, the associated bit is set in TaskPrio[counter].priority mask depending
      * on the priority parameter given from UTIL_SEQ_SetTask()
-     * The while loop is looking for a flag set from the highest priority maskr to the lower
+     * The PrioLevelSet summary holds one bit per non empty priority level so that the empty levels
+     * are never visited. The loop below only jumps over the levels where all pending tasks are masked
+     * and the highest priority level is found with a single count leading zero.
      */
-    while((TaskPrio[counter].priority & local_taskmask & SuperMask)== 0U)
+    prio_level_set = PrioLevelSet;
+    do
     {
-      counter++;
-    }
-
-    current_task_set = TaskPrio[counter].priority & local_taskmask & SuperMask;
+      counter = __CLZ( prio_level_set );
+      current_task_set = TaskPrio[counter].priority & local_taskmask & SuperMask;
+      prio_level_set &= ~UTIL_SEQ_PRIO_LEVEL_BIT( counter );
+    } while ( ( current_task_set == 0U ) && ( prio_level_set != 0U ) );
 
     /*
      * The round_robin register is a mask of allowed flags to be evaluated.
@@ -259,57 +581,160 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
      *
      * In the check below, the round_robin mask is reinitialize in case all pending tasks haven been executed at least once
      */
-    if ((TaskPrio[counter].round_robin & current_task_set) == 0U)
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+    /*
+     * The tasks of the level that have a deadline are run first, the earliest deadline first, out of the round robin
+     */
+    if ( ( current_task_set & DeadlineSet ) != 0U )
     {
-      TaskPrio[counter].round_robin = UTIL_SEQ_ALL_BIT_SET;
+      CurrentTaskIdx = SEQ_EarliestDeadline( current_task_set & DeadlineSet );
     }
+    else
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+    {
+      if ((TaskPrio[counter].round_robin & current_task_set) == 0U)
+      {
+        TaskPrio[counter].round_robin = UTIL_SEQ_ALL_BIT_SET;
+      }
 
-  /*
-   * Read the flag index of the task to be executed
-	 * Once the index is read, the associated task will be executed even though a higher priority stack is requested
-	 * before task execution.
-	 */
-    CurrentTaskIdx = (SEQ_BitPosition(current_task_set & TaskPrio[counter].round_robin));
+      /*
+       * Read the flag index of the task to be executed
+       * Once the index is read, the associated task will be executed even though a higher priority stack is requested
+       * before task execution.
+       */
+      CurrentTaskIdx = (SEQ_BitPosition(current_task_set & TaskPrio[counter].round_robin));
+
+      /*
+       * remove from the roun_robin mask the task that has been selected to be executed
+       */
+      TaskPrio[counter].round_robin &= ~UTIL_SEQ_TASK_BM( CurrentTaskIdx );
+    }
 
-    /*
-     * remove from the roun_robin mask the task that has been selected to be executed
-     */
-    TaskPrio[counter].round_robin &= ~(1U << CurrentTaskIdx);
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+    /* the device is awake for a task not deferrable : the deferrable tasks pending run in the same wakeup */
+    if ( ( DeferrableMask & UTIL_SEQ_TASK_BM( CurrentTaskIdx ) ) == 0U )
+    {
+      DeferRelease = 1U;
+    }
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
 
     UTIL_SEQ_ENTER_CRITICAL_SECTION( );
     /* remove from the list or pending task the one that has been selected to be executed */
-    TaskSet &= ~(1U << CurrentTaskIdx);
-    /* remove from all priority mask the task that has been selected to be executed */
-    for (counter = UTIL_SEQ_CONF_PRIO_NBR; counter != 0U; counter--)
+    TaskSet &= ~UTIL_SEQ_TASK_BM( CurrentTaskIdx );
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+    if ( ( DeadlineSet & UTIL_SEQ_TASK_BM( CurrentTaskIdx ) ) != 0U )
     {
-      TaskPrio[counter - 1U].priority &= ~(1U << CurrentTaskIdx);
+      DeadlineSet &= ~UTIL_SEQ_TASK_BM( CurrentTaskIdx );
+      deadline = TaskDeadline[CurrentTaskIdx];
+      deadline_set = 1U;
+    }
+    else
+    {
+      deadline_set = 0U;
+    }
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+    /*
+     * remove from the priority masks the task that has been selected to be executed
+     * The task cannot be pending in a higher priority level than the selected one, so only the selected
+     * level and the lower non empty levels are visited. A level becoming empty is removed from the summary.
+     */
+    prio_level_set = PrioLevelSet & ( ( UTIL_SEQ_PRIO_LEVEL_BIT( counter ) << 1U ) - 1U );
+    while ( prio_level_set != 0U )
+    {
+      counter = __CLZ( prio_level_set );
+      TaskPrio[counter].priority &= ~UTIL_SEQ_TASK_BM( CurrentTaskIdx );
+      if ( TaskPrio[counter].priority == 0U )
+      {
+        PrioLevelSet &= ~UTIL_SEQ_PRIO_LEVEL_BIT( counter );
+      }
+      prio_level_set &= ~UTIL_SEQ_PRIO_LEVEL_BIT( counter );
     }
     UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
+    UTIL_SEQ_TASK_START_HOOK( );
+    trace_previous = UTIL_SEQ_TASK_TRACE_ENTER( CurrentTaskIdx );
+
+    /* CurrentTaskIdx may be overwritten by a nested call of UTIL_SEQ_Run() */
+    task_idx = CurrentTaskIdx;
+
+#if (SEQ_TASK_TIMING == 1)
+    start_time = UTIL_SEQ_PROFILING_GET_TIME( );
+
     /* Execute the task */
-    TaskCb[CurrentTaskIdx]( );
+    TaskCb[task_idx]( );
+
+    end_time = UTIL_SEQ_PROFILING_GET_TIME( );
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+    SEQ_ProfilingRecord( task_idx, start_time, end_time );
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+#if (UTIL_SEQ_CONF_TASK_BUDGET == 1)
+    if ( ( TaskBudget[task_idx] != 0U ) && ( ( end_time - start_time ) > TaskBudget[task_idx] ) )
+    {
+      UTIL_SEQ_TaskOverBudget( task_idx, ( end_time - start_time ) );
+    }
+#endif /* UTIL_SEQ_CONF_TASK_BUDGET == 1 */
+#else
+    /* Execute the task */
+    TaskCb[task_idx]( );
+#endif /* SEQ_TASK_TIMING == 1 */
+
+    UTIL_SEQ_TASK_TRACE_EXIT( trace_previous );
+    UTIL_SEQ_TASK_END_HOOK( task_idx, RunNesting );
+
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+    /* the deadline is met when the task has completed before it */
+    if ( deadline_set != 0U )
+    {
+      lateness = (int32_t)( UTIL_SEQ_DEADLINE_GET_TIME( ) - deadline );
+      DeadlineStats[task_idx].RunCount++;
+      if ( lateness > 0 )
+      {
+        DeadlineStats[task_idx].MissCount++;
+        if ( (uint32_t)lateness > DeadlineStats[task_idx].MaxLateness )
+        {
+          DeadlineStats[task_idx].MaxLateness = (uint32_t)lateness;
+        }
+      }
+    }
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+    /* the last deferrable task pending has run : no more wakeup needed for the bound */
+    if ( ( ( DeferrableMask & UTIL_SEQ_TASK_BM( task_idx ) ) != 0U ) && ( ( TaskSet & DeferrableMask ) == 0U ) )
+    {
+      (void)UTIL_TIMER_Stop( &DeferTimer );
+    }
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
 
     local_taskset = TaskSet;
     local_evtset = EvtSet;
-    local_taskmask = TaskMask;
+    local_taskmask = TaskMask & ~SEQ_DEFER_HELD( );
     local_evtwaited = EvtWaited;
   }
 
   /* the set of CurrentTaskIdx to no task running allows to call WaitEvt in the Pre/Post ilde context */
   CurrentTaskIdx = UTIL_SEQ_NOTASKRUNNING;
-  /* if a waited event is present, ignore the IDLE sequence */
-  if ((local_evtset & EvtWaited)== 0U)
+  /* if a waited event is present or on a yield, ignore the IDLE sequence */
+  if (((local_evtset & EvtWaited)== 0U) && (no_idle == 0U))
   {
     UTIL_SEQ_PreIdle( );
 
     UTIL_SEQ_ENTER_CRITICAL_SECTION_IDLE( );
     local_taskset = TaskSet;
     local_evtset = EvtSet;
-    local_taskmask = TaskMask;
+    local_taskmask = TaskMask & ~SEQ_DEFER_HELD( );
     if ((local_taskset & local_taskmask & SuperMask) == 0U)
     {
       if ((local_evtset & EvtWaited)== 0U)
       {
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+        /* the deferrable tasks set from now wait for the next task not deferrable, or for their bound */
+        DeferRelease = 0U;
+        if ( ( ( TaskSet & DeferrableMask ) != 0U ) && ( UTIL_TIMER_IsRunning( &DeferTimer ) == 0U ) )
+        {
+          (void)UTIL_TIMER_Start( &DeferTimer );
+        }
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
         UTIL_SEQ_Idle( );
       }
     }
@@ -320,17 +745,44 @@ void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm )
 
   /* restore the mask from UTIL_SEQ_Run() */
   SuperMask = super_mask_backup;
+  RunNesting--;
 
   return;
 }
 
+void UTIL_SEQ_Yield( UTIL_SEQ_bm_t Mask_bm )
+{
+  uint32_t current_task_idx;
+
+  /* CurrentTaskIdx is overwritten by the nested call of UTIL_SEQ_Run() */
+  current_task_idx = CurrentTaskIdx;
+
+  YieldRequest = 1U;
+  UTIL_SEQ_Run( Mask_bm );
+
+  CurrentTaskIdx = current_task_idx;
+  return;
+}
+
 void UTIL_SEQ_RegTask(UTIL_SEQ_bm_t TaskId_bm, uint32_t Flags, void (*Task)( void ))
 {
-  (void)Flags;
   UTIL_SEQ_ENTER_CRITICAL_SECTION();
 
   TaskCb[SEQ_BitPosition(TaskId_bm)] = Task;
 
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+  if ( ( Flags & UTIL_SEQ_TASK_DEFERRABLE ) != 0U )
+  {
+    DeferrableMask |= TaskId_bm;
+  }
+  else
+  {
+    DeferrableMask &= ~TaskId_bm;
+  }
+#else
+  (void)Flags;
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
+
   UTIL_SEQ_EXIT_CRITICAL_SECTION();
 
   return;
@@ -352,10 +804,36 @@ uint32_t UTIL_SEQ_IsRegisteredTask(UTIL_SEQ_bm_t TaskId_bm )
 
 void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm , uint32_t Task_Prio )
 {
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+  uint32_t set_time = UTIL_SEQ_PROFILING_GET_TIME( );
+  UTIL_SEQ_bm_t new_task_set;
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+
+  Task_Prio = UTIL_SEQ_TASK_PRIO_CHECK( TaskId_bm, Task_Prio );
+
   UTIL_SEQ_ENTER_CRITICAL_SECTION( );
 
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+  /* the latency is measured from the first request, a task already pending keeps its time */
+  new_task_set = TaskId_bm & ~TaskSet;
+  while ( new_task_set != 0U )
+  {
+    TaskSetTime[SEQ_BitPosition( new_task_set )] = set_time;
+    new_task_set &= ~UTIL_SEQ_TASK_BM( SEQ_BitPosition( new_task_set ) );
+  }
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+  /* the first deferrable task held starts the deferral bound */
+  if ( ( ( TaskId_bm & DeferrableMask ) != 0U ) && ( ( TaskSet & DeferrableMask ) == 0U ) && ( DeferRelease == 0U ) )
+  {
+    (void)UTIL_TIMER_Start( &DeferTimer );
+  }
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
+
   TaskSet |= TaskId_bm;
   TaskPrio[Task_Prio].priority |= TaskId_bm;
+  PrioLevelSet |= UTIL_SEQ_PRIO_LEVEL_BIT( Task_Prio );
 
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
@@ -415,6 +893,11 @@ void UTIL_SEQ_SetEvt( UTIL_SEQ_bm_t EvtId_bm )
 
   EvtSet |= EvtId_bm;
 
+  if ( EvtTaskSet != UTIL_SEQ_NO_BIT_SET )
+  {
+    SEQ_EvtTaskRelease( );
+  }
+
   UTIL_SEQ_EXIT_CRITICAL_SECTION( );
 
   return;
@@ -447,7 +930,7 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
   }
   else
   {
-    wait_task_idx = (uint32_t)1u << CurrentTaskIdx;
+    wait_task_idx = UTIL_SEQ_TASK_BM( CurrentTaskIdx );
   }
 
   /* backup the event id that was currently waited */
@@ -484,12 +967,290 @@ void UTIL_SEQ_WaitEvt(UTIL_SEQ_bm_t EvtId_bm)
   return;
 }
 
+void UTIL_SEQ_SetTaskOnEvt( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, UTIL_SEQ_bm_t EvtId_bm )
+{
+  uint32_t task_idx = SEQ_BitPosition(TaskId_bm);
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  EvtTaskWaited[task_idx] = EvtId_bm;
+  EvtTaskPrio[task_idx] = (uint8_t)Task_Prio;
+  EvtTaskSet |= TaskId_bm;
+
+  /* the event may already be there */
+  SEQ_EvtTaskRelease( );
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return;
+}
+
 UTIL_SEQ_bm_t UTIL_SEQ_IsEvtPend( void )
 {
   UTIL_SEQ_bm_t local_evtwaited = EvtWaited;
   return (EvtSet & local_evtwaited);
 }
 
+uint32_t UTIL_SEQ_SetTaskDelayed( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t DelayMs )
+{
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+  return SEQ_StartDelayedTask( TaskId_bm, Task_Prio, DelayMs, UTIL_TIMER_ONESHOT );
+#else
+  (void)TaskId_bm;
+  (void)Task_Prio;
+  (void)DelayMs;
+  return 0U;
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+}
+
+uint32_t UTIL_SEQ_SetTaskPeriodic( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t PeriodMs )
+{
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+  return SEQ_StartDelayedTask( TaskId_bm, Task_Prio, PeriodMs, UTIL_TIMER_PERIODIC );
+#else
+  (void)TaskId_bm;
+  (void)Task_Prio;
+  (void)PeriodMs;
+  return 0U;
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+}
+
+void UTIL_SEQ_CancelTaskDelayed( UTIL_SEQ_bm_t TaskId_bm )
+{
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+  uint32_t index;
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  for ( index = 0U; index < UTIL_SEQ_CONF_DELAYED_TASK_NBR; index++ )
+  {
+    if ( DelayedTask[index].TaskId_bm == TaskId_bm )
+    {
+      (void)UTIL_TIMER_Stop( &DelayedTask[index].Timer );
+      DelayedTask[index].TaskId_bm = 0U;
+    }
+  }
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+#else
+  (void)TaskId_bm;
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+}
+
+uint32_t UTIL_SEQ_RegMsgQueue( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_MsgQueue_t * p_Queue, void * p_Buffer,
+                               uint16_t ItemSize, uint16_t ItemNbr )
+{
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+  if ( ( p_Queue == NULL ) || ( p_Buffer == NULL ) || ( ItemSize == 0U ) || ( ItemNbr == 0U )
+    || ( ( ItemNbr & ( ItemNbr - 1U ) ) != 0U ) )
+  {
+    return 0U;
+  }
+
+  p_Queue->pBuffer = (uint8_t *)p_Buffer;
+  p_Queue->ItemSize = ItemSize;
+  p_Queue->ItemNbr = ItemNbr;
+  p_Queue->WriteCount = 0U;
+  p_Queue->ReadCount = 0U;
+  p_Queue->OverflowCount = 0U;
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  MsgQueue[SEQ_BitPosition(TaskId_bm)] = p_Queue;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return 1U;
+#else
+  (void)TaskId_bm;
+  (void)p_Queue;
+  (void)p_Buffer;
+  (void)ItemSize;
+  (void)ItemNbr;
+  return 0U;
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+}
+
+uint32_t UTIL_SEQ_PostMsg( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, const void * p_Msg )
+{
+  uint32_t status = 0U;
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+  UTIL_SEQ_MsgQueue_t *p_queue = MsgQueue[SEQ_BitPosition(TaskId_bm)];
+  uint16_t write_count;
+  uint8_t *p_dest;
+  const uint8_t *p_src = (const uint8_t *)p_Msg;
+  uint32_t index;
+
+  if ( p_queue != NULL )
+  {
+    write_count = p_queue->WriteCount;
+    if ( (uint16_t)( write_count - p_queue->ReadCount ) < p_queue->ItemNbr )
+    {
+      p_dest = &p_queue->pBuffer[(uint32_t)( write_count & ( p_queue->ItemNbr - 1U ) ) * p_queue->ItemSize];
+      for ( index = 0U; index < p_queue->ItemSize; index++ )
+      {
+        p_dest[index] = p_src[index];
+      }
+
+      /* the message shall be written before it is published to the consumer */
+      UTIL_SEQ_MSG_BARRIER( );
+      p_queue->WriteCount = write_count + 1U;
+      status = 1U;
+    }
+    else
+    {
+      p_queue->OverflowCount++;
+    }
+  }
+#else
+  (void)p_Msg;
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+
+  UTIL_SEQ_SetTask( TaskId_bm, Task_Prio );
+
+  return status;
+}
+
+uint32_t UTIL_SEQ_GetMsg( UTIL_SEQ_bm_t TaskId_bm, void * p_Msg )
+{
+  uint32_t status = 0U;
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+  UTIL_SEQ_MsgQueue_t *p_queue = MsgQueue[SEQ_BitPosition(TaskId_bm)];
+  uint16_t read_count;
+  const uint8_t *p_src;
+  uint8_t *p_dest = (uint8_t *)p_Msg;
+  uint32_t index;
+
+  if ( p_queue != NULL )
+  {
+    read_count = p_queue->ReadCount;
+    if ( read_count != p_queue->WriteCount )
+    {
+      p_src = &p_queue->pBuffer[(uint32_t)( read_count & ( p_queue->ItemNbr - 1U ) ) * p_queue->ItemSize];
+      for ( index = 0U; index < p_queue->ItemSize; index++ )
+      {
+        p_dest[index] = p_src[index];
+      }
+
+      /* the message shall be read before its slot is released to the producer */
+      UTIL_SEQ_MSG_BARRIER( );
+      p_queue->ReadCount = read_count + 1U;
+      status = 1U;
+    }
+  }
+#else
+  (void)TaskId_bm;
+  (void)p_Msg;
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+
+  return status;
+}
+
+uint32_t UTIL_SEQ_GetMsgOverflow( UTIL_SEQ_bm_t TaskId_bm )
+{
+  uint32_t overflow = 0U;
+#if (UTIL_SEQ_CONF_MSG_QUEUE == 1)
+  UTIL_SEQ_MsgQueue_t *p_queue = MsgQueue[SEQ_BitPosition(TaskId_bm)];
+
+  if ( p_queue != NULL )
+  {
+    overflow = p_queue->OverflowCount;
+  }
+#else
+  (void)TaskId_bm;
+#endif /* UTIL_SEQ_CONF_MSG_QUEUE == 1 */
+
+  return overflow;
+}
+
+void UTIL_SEQ_SetTaskBudget( UTIL_SEQ_bm_t TaskId_bm, uint32_t Budget )
+{
+#if (UTIL_SEQ_CONF_TASK_BUDGET == 1)
+  UTIL_SEQ_bm_t task_set = TaskId_bm & ( UTIL_SEQ_ALL_BIT_SET >> ( ( 8U * sizeof( UTIL_SEQ_bm_t ) ) - UTIL_SEQ_CONF_TASK_NBR ) );
+  uint32_t task_idx;
+
+  while ( task_set != UTIL_SEQ_NO_BIT_SET )
+  {
+    task_idx = SEQ_BitPosition(task_set);
+    task_set &= ~UTIL_SEQ_TASK_BM( task_idx );
+    TaskBudget[task_idx] = Budget;
+  }
+#else
+  (void)TaskId_bm;
+  (void)Budget;
+#endif /* UTIL_SEQ_CONF_TASK_BUDGET == 1 */
+}
+
+uint32_t UTIL_SEQ_GetStats( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_TaskStats_t * p_Stats )
+{
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  *p_Stats = TaskStats[SEQ_BitPosition(TaskId_bm)];
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+  return 1U;
+#else
+  (void)TaskId_bm;
+  (void)p_Stats;
+  return 0U;
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+}
+
+void UTIL_SEQ_ResetStats( void )
+{
+#if (UTIL_SEQ_CONF_PROFILING == 1) || (UTIL_SEQ_CONF_DEADLINE == 1)
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)TaskStats, 0, sizeof(TaskStats));
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+  (void)UTIL_SEQ_MEMSET8((uint8_t *)DeadlineStats, 0, sizeof(DeadlineStats));
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+#endif /* (UTIL_SEQ_CONF_PROFILING == 1) || (UTIL_SEQ_CONF_DEADLINE == 1) */
+}
+
+void UTIL_SEQ_SetTaskDeadline( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t Deadline )
+{
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+  uint32_t task_idx = SEQ_BitPosition( TaskId_bm );
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  /* a task already pending with a deadline keeps the earliest one */
+  if ( ( ( DeadlineSet & TaskId_bm ) == 0U ) || ( (int32_t)( Deadline - TaskDeadline[task_idx] ) < 0 ) )
+  {
+    TaskDeadline[task_idx] = Deadline;
+  }
+  DeadlineSet |= TaskId_bm;
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+#else
+  (void)Deadline;
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
+  UTIL_SEQ_SetTask( TaskId_bm, Task_Prio );
+}
+
+uint32_t UTIL_SEQ_GetDeadlineStats( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_DeadlineStats_t * p_Stats )
+{
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  *p_Stats = DeadlineStats[SEQ_BitPosition(TaskId_bm)];
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+  return 1U;
+#else
+  (void)TaskId_bm;
+  (void)p_Stats;
+  return 0U;
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+}
+
 __WEAK void UTIL_SEQ_EvtIdle( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_bm_t EvtWaited_bm )
 {
   (void)EvtWaited_bm;
@@ -518,6 +1279,16 @@ __WEAK void UTIL_SEQ_PostIdle( void )
   return;
 }
 
+__WEAK void UTIL_SEQ_TaskOverBudget( uint32_t TaskIdx, uint32_t ElapsedTime )
+{
+  /*
+   * Unless specified by the application, there is nothing to be done
+   */
+  (void)TaskIdx;
+  (void)ElapsedTime;
+  return;
+}
+
 /**
   * @}
   */
@@ -526,6 +1297,176 @@ __WEAK void UTIL_SEQ_PostIdle( void )
  *  @{
  */
 
+/**
+ * @brief set the tasks registered with UTIL_SEQ_SetTaskOnEvt() whose event is set, and clear that event
+ * @note  shall be called in critical section
+ * @retval None
+ */
+static void SEQ_EvtTaskRelease(void)
+{
+  UTIL_SEQ_bm_t task_set = EvtTaskSet;
+  UTIL_SEQ_bm_t evt_released;
+  uint32_t task_idx;
+
+  while ( task_set != UTIL_SEQ_NO_BIT_SET )
+  {
+    task_idx = SEQ_BitPosition(task_set);
+    task_set &= ~UTIL_SEQ_TASK_BM( task_idx );
+
+    evt_released = EvtSet & EvtTaskWaited[task_idx];
+    if ( evt_released != UTIL_SEQ_NO_BIT_SET )
+    {
+      EvtSet &= ~evt_released;
+      EvtTaskSet &= ~UTIL_SEQ_TASK_BM( task_idx );
+      UTIL_SEQ_SetTask( UTIL_SEQ_TASK_BM( task_idx ), EvtTaskPrio[task_idx] );
+    }
+  }
+}
+
+#if (UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0)
+/**
+ * @brief start (or restart) the timer of a delayed task request
+ * @param TaskId_bm The Id of the task
+ * @param Task_Prio The priority of the task
+ * @param TimeMs delay or period in milliseconds
+ * @param Mode UTIL_TIMER_ONESHOT for a delayed task, UTIL_TIMER_PERIODIC for a periodic task
+ * @retval 1 when the request is accepted, 0 when no slot is available
+ */
+static uint32_t SEQ_StartDelayedTask(UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t TimeMs, UTIL_TIMER_Mode_t Mode)
+{
+  uint32_t index;
+  UTIL_SEQ_DelayedTask_t *p_slot = NULL;
+
+  UTIL_SEQ_ENTER_CRITICAL_SECTION( );
+
+  /* reuse the slot already owned by the task, else take the first free one */
+  for ( index = 0U; index < UTIL_SEQ_CONF_DELAYED_TASK_NBR; index++ )
+  {
+    if ( DelayedTask[index].TaskId_bm == TaskId_bm )
+    {
+      p_slot = &DelayedTask[index];
+      (void)UTIL_TIMER_Stop( &p_slot->Timer );
+      break;
+    }
+    if ( ( p_slot == NULL ) && ( DelayedTask[index].TaskId_bm == 0U ) )
+    {
+      p_slot = &DelayedTask[index];
+    }
+  }
+
+  if ( p_slot != NULL )
+  {
+    p_slot->TaskId_bm = TaskId_bm;
+    p_slot->Task_Prio = Task_Prio;
+    (void)UTIL_TIMER_Create( &p_slot->Timer, TimeMs, Mode, SEQ_DelayedTaskElapsed, p_slot );
+    (void)UTIL_TIMER_Start( &p_slot->Timer );
+  }
+
+  UTIL_SEQ_EXIT_CRITICAL_SECTION( );
+
+  return ( p_slot != NULL ) ? 1U : 0U;
+}
+
+/**
+ * @brief timer server expiry of a delayed task request, sets the task
+ * @param Argument pointer on the delayed task slot
+ * @retval None
+ */
+static void SEQ_DelayedTaskElapsed(void *Argument)
+{
+  UTIL_SEQ_DelayedTask_t *p_slot = (UTIL_SEQ_DelayedTask_t *)Argument;
+  UTIL_SEQ_bm_t task_id_bm = p_slot->TaskId_bm;
+
+  if ( task_id_bm != 0U )
+  {
+    UTIL_SEQ_SetTask( task_id_bm, p_slot->Task_Prio );
+
+    /* a one shot request releases its slot */
+    if ( p_slot->Timer.Mode == UTIL_TIMER_ONESHOT )
+    {
+      p_slot->TaskId_bm = 0U;
+    }
+  }
+}
+#endif /* UTIL_SEQ_CONF_DELAYED_TASK_NBR > 0 */
+
+#if (UTIL_SEQ_CONF_DEFERRABLE == 1)
+/**
+ * @brief deferral bound elapsed, the deferrable tasks pending are released
+ * @param Argument not used
+ * @retval None
+ */
+static void SEQ_DeferElapsed(void *Argument)
+{
+  (void)Argument;
+
+  DeferRelease = 1U;
+}
+#endif /* UTIL_SEQ_CONF_DEFERRABLE == 1 */
+
+#if (UTIL_SEQ_CONF_DEADLINE == 1)
+/**
+ * @brief select the task with the earliest deadline
+ * @param TaskSet_bm tasks pending with a deadline, not empty
+ * @retval index of the task
+ */
+static uint32_t SEQ_EarliestDeadline(UTIL_SEQ_bm_t TaskSet_bm)
+{
+  uint32_t task_idx = SEQ_BitPosition( TaskSet_bm );
+  uint32_t earliest_idx = task_idx;
+
+  TaskSet_bm &= ~UTIL_SEQ_TASK_BM( task_idx );
+  while ( TaskSet_bm != 0U )
+  {
+    task_idx = SEQ_BitPosition( TaskSet_bm );
+    if ( (int32_t)( TaskDeadline[task_idx] - TaskDeadline[earliest_idx] ) < 0 )
+    {
+      earliest_idx = task_idx;
+    }
+    TaskSet_bm &= ~UTIL_SEQ_TASK_BM( task_idx );
+  }
+
+  return earliest_idx;
+}
+#endif /* UTIL_SEQ_CONF_DEADLINE == 1 */
+
+#if (UTIL_SEQ_CONF_PROFILING == 1)
+/**
+ * @brief update the statistics of a task that has just been executed
+ * @param TaskIdx index of the task
+ * @param StartTime time at which the task callback has been called
+ * @param EndTime time at which the task callback has returned
+ * @retval None
+ */
+static void SEQ_ProfilingRecord(uint32_t TaskIdx, uint32_t StartTime, uint32_t EndTime)
+{
+  UTIL_SEQ_TaskStats_t *p_stats = &TaskStats[TaskIdx];
+  uint32_t elapsed = EndTime - StartTime;
+  uint32_t latency = StartTime - TaskSetTime[TaskIdx];
+  uint32_t bin = 0U;
+  uint32_t bin_limit = UTIL_SEQ_STATS_LATENCY_BIN0_TIME;
+
+  while ( ( latency >= bin_limit ) && ( bin < ( UTIL_SEQ_STATS_LATENCY_BIN_NBR - 1U ) ) )
+  {
+    bin++;
+    bin_limit <<= 2U;
+  }
+
+  p_stats->CallCount++;
+  p_stats->TotalTime += elapsed;
+  p_stats->LastTime = elapsed;
+  if ( elapsed > p_stats->MaxTime )
+  {
+    p_stats->MaxTime = elapsed;
+  }
+  if ( latency > p_stats->MaxLatency )
+  {
+    p_stats->MaxLatency = latency;
+  }
+  p_stats->LatencyHisto[bin]++;
+}
+#endif /* UTIL_SEQ_CONF_PROFILING == 1 */
+
 #if( __CORTEX_M == 0)
 const uint8_t SEQ_clz_table_4bit[16U] = { 4U, 3U, 2U, 2U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U };
 /**
@@ -533,7 +1474,7 @@ const uint8_t SEQ_clz_table_4bit[16U] = { 4U, 3U, 2U, 2U, 1U, 1U, 1U, 1U, 0U, 0U
  * @param Value 32 bit value
  * @retval bit position
  */
-uint8_t SEQ_BitPosition(uint32_t Value)
+static uint8_t SEQ_BitPosition32(uint32_t Value)
 {
 uint8_t n = 0U;
 uint32_t lvalue = Value;
@@ -552,12 +1493,32 @@ uint32_t lvalue = Value;
  * @param Value 32 bit value
  * @retval bit position
  */
-uint8_t SEQ_BitPosition(uint32_t Value)
+__STATIC_FORCEINLINE uint8_t SEQ_BitPosition32(uint32_t Value)
 {
   return (uint8_t)(31 -__CLZ( Value ));
 }
 #endif
 
+/**
+ * @brief return the position of the first bit set to 1
+ * @note  with a 64 bit task mapping, the upper word is scanned first and the lower word only when it is empty :
+ *        two count leading zero at most
+ * @param Value task bit mapping
+ * @retval bit position
+ */
+UTIL_SEQ_HOT_CODE uint8_t SEQ_BitPosition(UTIL_SEQ_bm_t Value)
+{
+#if (UTIL_SEQ_CONF_TASK_NBR > 32)
+  uint32_t high_word = (uint32_t)( Value >> 32U );
+
+  if ( high_word != 0U )
+  {
+    return (uint8_t)( 32U + SEQ_BitPosition32( high_word ) );
+  }
+#endif /* UTIL_SEQ_CONF_TASK_NBR > 32 */
+  return SEQ_BitPosition32( (uint32_t)Value );
+}
+
 /**
   * @}
   */
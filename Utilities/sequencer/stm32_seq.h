@@ -27,6 +27,7 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "stdint.h"
+#include "utilities_conf.h"
 
 /** @defgroup SEQUENCER sequencer utilities
   * @{
@@ -39,9 +40,71 @@ extern "C" {
 /**
  *  @brief  bit mapping of the task.
  *  this value is used to represent a list of task (each corresponds to a task).
+ *  It is 64 bits wide when UTIL_SEQ_CONF_TASK_NBR is above 32 (set in utilities_conf.h).
  */
-
+#if defined(UTIL_SEQ_CONF_TASK_NBR) && (UTIL_SEQ_CONF_TASK_NBR > 32)
+typedef uint64_t UTIL_SEQ_bm_t;
+#else
 typedef uint32_t UTIL_SEQ_bm_t;
+#endif /* UTIL_SEQ_CONF_TASK_NBR > 32 */
+
+/**
+ *  @brief  bit of the task of index _IDX_ in a task bit mapping (UTIL_SEQ_bm_t).
+ */
+#define UTIL_SEQ_TASK_BM( _IDX_ )   ( (UTIL_SEQ_bm_t)1U << (_IDX_) )
+
+/**
+ *  @brief  number of bins of the SetTask to run latency histogram.
+ *  Bin n counts the latencies lower than (UTIL_SEQ_STATS_LATENCY_BIN0_TIME << (2 * n)),
+ *  the last bin counts all the remaining ones.
+ */
+#define UTIL_SEQ_STATS_LATENCY_BIN_NBR    (8U)
+
+/**
+ *  @brief  upper bound of the first bin of the latency histogram (in profiling time unit).
+ */
+#define UTIL_SEQ_STATS_LATENCY_BIN0_TIME  (1024U)
+
+/**
+ *  @brief  execution statistics of a task (values are in profiling time unit, that is
+ *  the unit of UTIL_SEQ_PROFILING_GET_TIME(), i.e. CPU cycles with the DWT cycle counter).
+ *  @note   The execution time of a task includes the tasks executed by a nested UTIL_SEQ_Run()
+ *          (i.e. when the task calls UTIL_SEQ_WaitEvt()).
+ */
+typedef struct
+{
+  uint32_t CallCount;                                   /*!< number of times the task has been executed.        */
+  uint64_t TotalTime;                                   /*!< sum of all the execution times.                     */
+  uint32_t MaxTime;                                     /*!< longest execution time.                             */
+  uint32_t LastTime;                                    /*!< execution time of the last run.                     */
+  uint32_t MaxLatency;                                  /*!< longest time between UTIL_SEQ_SetTask() and the run. */
+  uint32_t LatencyHisto[UTIL_SEQ_STATS_LATENCY_BIN_NBR]; /*!< histogram of the SetTask to run latencies.          */
+} UTIL_SEQ_TaskStats_t;
+
+/**
+ *  @brief  deadline statistics of a task set with UTIL_SEQ_SetTaskDeadline() (in the unit of
+ *  UTIL_SEQ_DEADLINE_GET_TIME()). A deadline is missed when the task completes after it.
+ */
+typedef struct
+{
+  uint32_t RunCount;                                    /*!< number of runs with a deadline.                     */
+  uint32_t MissCount;                                   /*!< number of deadlines missed.                         */
+  uint32_t MaxLateness;                                 /*!< longest time between a deadline missed and the end. */
+} UTIL_SEQ_DeadlineStats_t;
+
+/**
+ *  @brief  message queue attached to a task, see UTIL_SEQ_RegMsgQueue().
+ *  Single producer (ISR or task) / single consumer (the owner task), lock free.
+ */
+typedef struct
+{
+  uint8_t           *pBuffer;        /*!< storage of ItemNbr items of ItemSize bytes.         */
+  uint16_t          ItemSize;        /*!< size of one message in bytes.                        */
+  uint16_t          ItemNbr;         /*!< number of messages, shall be a power of 2.           */
+  volatile uint16_t WriteCount;      /*!< number of messages posted, only written by producer. */
+  volatile uint16_t ReadCount;       /*!< number of messages read, only written by consumer.   */
+  volatile uint32_t OverflowCount;   /*!< number of messages lost because the queue was full.  */
+} UTIL_SEQ_MsgQueue_t;
 
 /**
   * @}
@@ -59,6 +122,13 @@ typedef uint32_t UTIL_SEQ_bm_t;
  */
 #define UTIL_SEQ_RFU 0
 
+/**
+ * @brief Flag of UTIL_SEQ_RegTask() : the task does not wake the device on its own.
+ *        It runs on the next wakeup that runs a task not deferrable, at the latest UTIL_SEQ_CONF_DEFER_MAX_MS after
+ *        it was set. Ignored when UTIL_SEQ_CONF_DEFERRABLE is not set to 1.
+ */
+#define UTIL_SEQ_TASK_DEFERRABLE  (1U)
+
 /**
  * @brief Default value used to start the scheduling.
  *
@@ -72,7 +142,7 @@ typedef uint32_t UTIL_SEQ_bm_t;
  * }\n
  *
  */
-#define UTIL_SEQ_DEFAULT         (~0U)
+#define UTIL_SEQ_DEFAULT         (~(UTIL_SEQ_bm_t)0U)
 
 /**
   * @}
@@ -184,6 +254,19 @@ void UTIL_SEQ_PreIdle( void );
  */
 void UTIL_SEQ_PostIdle( void );
 
+/**
+ * @brief This function is called by the sequencer when a task has run longer than its budget
+ *        (see UTIL_SEQ_SetTaskBudget()). Only called when UTIL_SEQ_CONF_TASK_BUDGET is set to 1.
+ *
+ * @param TaskIdx index of the task (bit position of its TaskId_bm)
+ * @param ElapsedTime execution time of the task, in the unit of UTIL_SEQ_PROFILING_GET_TIME()
+ *
+ * @note  It is called just after the task has returned, outside critical section.
+ *        It shall be called only by the sequencer.
+ *
+ */
+void UTIL_SEQ_TaskOverBudget( uint32_t TaskIdx, uint32_t ElapsedTime );
+
 /**
  * @brief This function requests the sequencer to execute all pending tasks using round robin mechanism.
  *        When no task are pending, it calls UTIL_SEQ_Idle();
@@ -199,11 +282,24 @@ void UTIL_SEQ_PostIdle( void );
  */
 void UTIL_SEQ_Run( UTIL_SEQ_bm_t Mask_bm );
 
+/**
+ * @brief This function executes the pending tasks of the mask, from a running task, and returns when none of
+ *        them is pending anymore, without entering the idle (i.e. a preemption point of a long task).
+ *
+ * @param Mask_bm list of task (bit mapping) that may be executed.
+ *
+ * @note  It shall not be called from an ISR.
+ * @note  The tasks of the mask are executed nested in the calling task : they shall not re-enter the code that
+ *        the calling task is executing.
+ *
+ */
+void UTIL_SEQ_Yield( UTIL_SEQ_bm_t Mask_bm );
+
 /**
  * @brief This function registers a task in the sequencer.
  *
  * @param TaskId_bm The Id of the task
- * @param Flags Flags are reserved param for future use
+ * @param Flags UTIL_SEQ_RFU, or UTIL_SEQ_TASK_DEFERRABLE for a task batched with the next wakeup
  * @param Task Reference of the function to be executed
  *
  * @note  It may be called from an ISR.
@@ -235,6 +331,22 @@ uint32_t UTIL_SEQ_IsRegisteredTask( UTIL_SEQ_bm_t TaskId_bm );
  */
 void UTIL_SEQ_SetTask( UTIL_SEQ_bm_t TaskId_bm , uint32_t Task_Prio );
 
+/**
+ * @brief This function requests a task to be executed before a deadline.
+ *        Within its priority level, the task is run before the tasks without deadline, the earliest deadline first.
+ *        A task already pending with a deadline keeps the earliest one. When UTIL_SEQ_CONF_DEADLINE is not set to 1,
+ *        it is the same as UTIL_SEQ_SetTask().
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param Task_Prio The priority of the task
+ * @param Deadline time (in the unit of UTIL_SEQ_DEADLINE_GET_TIME()) before which the task shall be completed
+ *
+ * @note   It may be called from an ISR
+ *
+ */
+void UTIL_SEQ_SetTaskDeadline( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t Deadline );
+
 /**
  * @brief This function checks if a task could be scheduled.
  *
@@ -321,9 +433,30 @@ void UTIL_SEQ_ClrEvt( UTIL_SEQ_bm_t EvtId_bm );
  * @note  The construction of the task must take into account the fact that there is no counting / protection on the
  *        event. Thus, when the task is running, it must perform all the operations in progress programmed before its call
  *        or manage a reprogramming of the task.
+ * @note  Each call nests a UTIL_SEQ_Run() on the stack, UTIL_SEQ_SetTaskOnEvt() is the non blocking alternative.
  */
 void UTIL_SEQ_WaitEvt( UTIL_SEQ_bm_t EvtId_bm );
 
+/**
+ * @brief This function requests a task to be set when an event is set, without blocking.
+ *        It is the stackless alternative to UTIL_SEQ_WaitEvt(): the running task registers itself and returns,
+ *        then it is set again with priority Task_Prio when one of the events of EvtId_bm is set, and resumes
+ *        from a state it has saved. No nested UTIL_SEQ_Run() is done so the stack stays flat and the other
+ *        tasks keep their priority order while waiting.
+ *        The event that releases the task is cleared (as done by UTIL_SEQ_WaitEvt()). When the event is already
+ *        set, the task is set immediately.
+ *
+ * @param TaskId_bm The Id of the task to be set
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ * @param EvtId_bm event id bit mask, the task is released by the first event set among this mask
+ *
+ * @note   A new request on the same task replaces the previous one.
+ *         It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_SetTaskOnEvt( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, UTIL_SEQ_bm_t EvtId_bm );
+
 /**
  * @brief This function returns whether the waited event is pending or not
  *        It is useful only when the UTIL_SEQ_EvtIdle() is overloaded by the application. In that case, when the low
@@ -353,6 +486,157 @@ UTIL_SEQ_bm_t UTIL_SEQ_IsEvtPend( void );
  */
 void UTIL_SEQ_EvtIdle( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_bm_t EvtWaited_bm );
 
+/**
+ * @brief This function requests a task to be executed after a delay.
+ *        The task is set with UTIL_SEQ_SetTask() directly from the timer server expiry, without any
+ *        user callback. A new request on a task already delayed restarts its delay.
+ *        Only available when UTIL_SEQ_CONF_DELAYED_TASK_NBR is greater than 0.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ * @param DelayMs Delay in milliseconds before the task is set
+ * @retval 1 when the request is accepted, 0 when no delayed task slot is available
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_SetTaskDelayed( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t DelayMs );
+
+/**
+ * @brief This function requests a task to be executed periodically.
+ *        Same behavior as UTIL_SEQ_SetTaskDelayed() but the task is set again every PeriodMs
+ *        until UTIL_SEQ_CancelTaskDelayed() is called.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ * @param PeriodMs Period in milliseconds
+ * @retval 1 when the request is accepted, 0 when no delayed task slot is available
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_SetTaskPeriodic( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, uint32_t PeriodMs );
+
+/**
+ * @brief This function cancels a delayed or periodic request of a task and releases its slot.
+ *        A task already set by an expired delay is not removed from the pending list.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_CancelTaskDelayed( UTIL_SEQ_bm_t TaskId_bm );
+
+/**
+ * @brief This function attaches a message queue to a task.
+ *        Only available when UTIL_SEQ_CONF_MSG_QUEUE is set to 1.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param p_Queue pointer on the queue control structure, provided by the application
+ * @param p_Buffer pointer on the storage of the messages (ItemNbr * ItemSize bytes), provided by the application
+ * @param ItemSize size of one message in bytes
+ * @param ItemNbr number of messages in the queue, it shall be a power of 2
+ * @retval 1 when the queue is attached, 0 when a parameter is invalid
+ *
+ * @note   It shall not be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_RegMsgQueue( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_MsgQueue_t * p_Queue, void * p_Buffer,
+                               uint16_t ItemSize, uint16_t ItemNbr );
+
+/**
+ * @brief This function copies a message in the queue of a task and sets the task (see UTIL_SEQ_SetTask()).
+ *        When the queue is full, the message is dropped and the overflow counter is incremented, the task is set anyway.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param Task_Prio The priority of the task (see UTIL_SEQ_SetTask())
+ * @param p_Msg pointer on the message (ItemSize bytes)
+ * @retval 1 when the message is queued, 0 otherwise
+ *
+ * @note   It may be called from an ISR. There shall be only one producer per queue.
+ *
+ */
+uint32_t UTIL_SEQ_PostMsg( UTIL_SEQ_bm_t TaskId_bm, uint32_t Task_Prio, const void * p_Msg );
+
+/**
+ * @brief This function reads the oldest message of the queue of a task.
+ *        The task should call it until it returns 0 to drain all the messages posted before its run.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param p_Msg pointer where the message is copied (ItemSize bytes)
+ * @retval 1 when a message has been read, 0 when the queue is empty
+ *
+ * @note   It shall be called only by the task owning the queue.
+ *
+ */
+uint32_t UTIL_SEQ_GetMsg( UTIL_SEQ_bm_t TaskId_bm, void * p_Msg );
+
+/**
+ * @brief This function returns the number of messages lost on the queue of a task because it was full.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @retval number of messages lost
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_GetMsgOverflow( UTIL_SEQ_bm_t TaskId_bm );
+
+/**
+ * @brief This function sets the execution time budget of one or several tasks.
+ *        UTIL_SEQ_TaskOverBudget() is called each time one of these tasks runs longer than Budget.
+ *        Only available when UTIL_SEQ_CONF_TASK_BUDGET is set to 1.
+ *
+ * @param TaskId_bm The Id of the tasks (bit mapping), UTIL_SEQ_DEFAULT sets all the tasks
+ * @param Budget budget in the unit of UTIL_SEQ_PROFILING_GET_TIME(), 0 disables the check
+ *
+ */
+void UTIL_SEQ_SetTaskBudget( UTIL_SEQ_bm_t TaskId_bm, uint32_t Budget );
+
+/**
+ * @brief This function returns the execution statistics of a task.
+ *        The statistics are only recorded when UTIL_SEQ_CONF_PROFILING is set to 1.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param p_Stats Pointer on the structure to be filled with a copy of the statistics
+ * @retval 1 when the statistics have been copied, 0 when profiling is disabled
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_GetStats( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_TaskStats_t * p_Stats );
+
+/**
+ * @brief This function returns the deadline statistics of a task.
+ *        The statistics are only recorded when UTIL_SEQ_CONF_DEADLINE is set to 1.
+ *
+ * @param TaskId_bm The Id of the task
+ *        It shall be (1<<task_id) where task_id is the number assigned when the task has been registered
+ * @param p_Stats Pointer on the structure to be filled with a copy of the statistics
+ * @retval 1 when the statistics have been copied, 0 when the deadline scheduling is disabled
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+uint32_t UTIL_SEQ_GetDeadlineStats( UTIL_SEQ_bm_t TaskId_bm, UTIL_SEQ_DeadlineStats_t * p_Stats );
+
+/**
+ * @brief This function clears the execution and deadline statistics of all the tasks.
+ *
+ * @note   It may be called from an ISR.
+ *
+ */
+void UTIL_SEQ_ResetStats( void );
+
 /**
   * @}
  */
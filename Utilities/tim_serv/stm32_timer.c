@@ -73,6 +73,66 @@
 #ifndef UTIL_TIMER_EXIT_CRITICAL_SECTION
   #define UTIL_TIMER_EXIT_CRITICAL_SECTION( )    UTILS_EXIT_CRITICAL_SECTION( )
 #endif
+
+/**
+  * @brief maximum number of timers created, can be redefined in utilities_conf.h
+  *        All the created timers can run at the same time.
+  *
+  */
+#ifndef UTIL_TIMER_CONF_MAX_TIMER_NBR
+  #define UTIL_TIMER_CONF_MAX_TIMER_NBR          (16U)
+#endif
+
+#if (UTIL_TIMER_CONF_MAX_TIMER_NBR > 255U)
+#error "UTIL_TIMER_CONF_MAX_TIMER_NBR must be less than or equal to 255"
+#endif
+
+/**
+  * @brief called with the callback of a timer that cannot be created (UTIL_TIMER_CONF_MAX_TIMER_NBR timers already
+  *        created) or started (heap full), empty by default, can be redefined in utilities_conf.h
+  *
+  */
+#ifndef UTIL_TIMER_CAPACITY_ERROR
+  #define UTIL_TIMER_CAPACITY_ERROR( _CALLBACK_ )
+#endif
+
+/**
+  * @brief maximum number of expired timers processed in one pass, can be redefined in utilities_conf.h
+  *        The remaining ones are deferred with UTIL_TIMER_DeferExpiry().
+  *
+  */
+#ifndef UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ
+  #define UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ     (4U)
+#endif
+
+/**
+  * @brief trace of the timer callbacks, empty by default, can be redefined in utilities_conf.h
+  *        UTIL_TIMER_CALLBACK_TRACE_ENTER( ) is called with the timer object just before its callback and returns a
+  *        value given back to UTIL_TIMER_CALLBACK_TRACE_EXIT( ) just after it.
+  *
+  */
+#ifndef UTIL_TIMER_CALLBACK_TRACE_ENTER
+  #define UTIL_TIMER_CALLBACK_TRACE_ENTER( _TIMER_ )    ( 0U )
+#endif
+
+#ifndef UTIL_TIMER_CALLBACK_TRACE_EXIT
+  #define UTIL_TIMER_CALLBACK_TRACE_EXIT( _PREVIOUS_ )  ( (void)( _PREVIOUS_ ) )
+#endif
+
+/**
+  * @brief default placement attribute of the expiry processing, can be redefined in utilities_conf.h
+  *        to run it from a RAM section.
+  */
+#ifndef UTIL_TIMER_HOT_CODE
+  #define UTIL_TIMER_HOT_CODE
+#endif
+
+/**
+  * @brief wrap safe comparison of two absolute times in ticks, true when _A_ is before _B_.
+  *        Valid as long as the two times are less than 2^31 ticks apart.
+  *
+  */
+#define TIMER_IS_BEFORE( _A_, _B_ )              ( (int32_t)( (uint32_t)(_A_) - (uint32_t)(_B_) ) < 0 )
 /**
   *  @}
   */
@@ -84,10 +144,41 @@
  */
 
 /**
-  * @brief Timers list head pointer
+  * @brief Running timers, binary min heap ordered on the absolute expiry time.
+  *        TimerHeap[0] is the next timer to expire.
+  *
+  */
+static UTIL_TIMER_Object_t *TimerHeap[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+
+/**
+  * @brief Number of timers in the heap
   *
   */
-static UTIL_TIMER_Object_t *TimerListHead = NULL;
+static uint32_t TimerHeapSize = 0U;
+
+/**
+  * @brief Created timers : the heap cannot overflow as long as only these timers are started
+  *
+  */
+static UTIL_TIMER_Object_t *TimerCreated[UTIL_TIMER_CONF_MAX_TIMER_NBR];
+
+/**
+  * @brief Number of created timers
+  *
+  */
+static uint32_t TimerCreatedNbr = 0U;
+
+/**
+  * @brief Timer for which the low layer timer is programmed
+  *
+  */
+static UTIL_TIMER_Object_t *TimerArmed = NULL;
+
+/**
+  * @brief Absolute time for which the low layer timer is programmed (valid when TimerArmed != NULL)
+  *
+  */
+static uint32_t TimerArmedTime = 0U;
 
 /**
   *  @}
@@ -98,10 +189,21 @@ static UTIL_TIMER_Object_t *TimerListHead = NULL;
  *  @{
  */
 
-void TimerInsertNewHeadTimer( UTIL_TIMER_Object_t *TimerObject );
-void TimerInsertTimer( UTIL_TIMER_Object_t *TimerObject );
-void TimerSetTimeout( UTIL_TIMER_Object_t *TimerObject );
-bool TimerExists( UTIL_TIMER_Object_t *TimerObject );
+static bool TimerExists( UTIL_TIMER_Object_t *TimerObject );
+static bool TimerRegister( UTIL_TIMER_Object_t *TimerObject );
+static void TimerSetExpiry( UTIL_TIMER_Object_t *TimerObject );
+static bool TimerInsert( UTIL_TIMER_Object_t *TimerObject );
+static void TimerRestart( UTIL_TIMER_Object_t *TimerObject );
+static bool TimerProcessExpired( void );
+static void TimerSetTimeout( void );
+static uint32_t TimerCoalescedTime( void );
+#if (UTIL_TIMER_CONF_STATS == 1)
+static void TimerRecordLateness( UTIL_TIMER_Object_t *TimerObject, uint32_t Lateness );
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+static bool TimerHeapInsert( UTIL_TIMER_Object_t *TimerObject );
+static void TimerHeapRemove( UTIL_TIMER_Object_t *TimerObject );
+static void TimerHeapSiftUp( uint32_t Index );
+static void TimerHeapSiftDown( uint32_t Index );
 
 /**
   *  @}
@@ -116,7 +218,8 @@ bool TimerExists( UTIL_TIMER_Object_t *TimerObject );
 UTIL_TIMER_Status_t UTIL_TIMER_Init(void)
 {
   UTIL_TIMER_INIT_CRITICAL_SECTION();
-  TimerListHead = NULL;
+  TimerHeapSize = 0U;
+  TimerArmed = NULL;
   return UTIL_TimerDriver.InitTimer();
 }
 
@@ -129,11 +232,26 @@ UTIL_TIMER_Status_t UTIL_TIMER_Create( UTIL_TIMER_Object_t *TimerObject, uint32_
 {
   if((TimerObject != NULL) && (Callback != NULL))
   {
+    if(TimerRegister(TimerObject) == false)
+    {
+      UTIL_TIMER_CAPACITY_ERROR( Callback );
+      return UTIL_TIMER_UNKNOWN_ERROR;
+    }
+    /* a running timer shall not be left in the heap with a reset context */
+    if(TimerExists(TimerObject))
+    {
+      (void)UTIL_TIMER_Stop(TimerObject);
+    }
     TimerObject->Timestamp = 0U;
     TimerObject->ReloadValue = UTIL_TimerDriver.ms2Tick(PeriodValue);
     TimerObject->IsPending = 0U;
     TimerObject->IsRunning = 0U;
     TimerObject->IsReloadStopped = 0U;
+    TimerObject->HeapIndex = 0U;
+    TimerObject->Slack = 0U;
+#if (UTIL_TIMER_CONF_STATS == 1)
+    (void)UTIL_TIMER_ResetStats(TimerObject);
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
     TimerObject->Callback = Callback;
     TimerObject->argument = Argument;
     TimerObject->Mode = Mode;
@@ -149,50 +267,37 @@ UTIL_TIMER_Status_t UTIL_TIMER_Create( UTIL_TIMER_Object_t *TimerObject, uint32_
 UTIL_TIMER_Status_t UTIL_TIMER_Start( UTIL_TIMER_Object_t *TimerObject)
 {
   UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
-  uint32_t elapsedTime;
-  uint32_t minValue;
-  uint32_t ticks;
-    
-  if(( TimerObject != NULL ) && ( TimerExists( TimerObject ) == false ) && (TimerObject->IsRunning == 0U))
+
+  if( TimerObject == NULL )
   {
-    UTIL_TIMER_ENTER_CRITICAL_SECTION();
-    ticks = TimerObject->ReloadValue;
-    minValue = UTIL_TimerDriver.GetMinimumTimeout( );
-    
-    if( ticks < minValue )
+    return UTIL_TIMER_INVALID_PARAM;
+  }
+
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  if(( TimerExists( TimerObject ) == false ) && (TimerObject->IsRunning == 0U))
+  {
+    if( TimerInsert( TimerObject ) == false )
     {
-      ticks = minValue;
+      /* only reached by a timer that was not created with UTIL_TIMER_Create() */
+      UTIL_TIMER_CAPACITY_ERROR( TimerObject->Callback );
+      ret = UTIL_TIMER_UNKNOWN_ERROR;
     }
-    
-    TimerObject->Timestamp = ticks;
-    TimerObject->IsPending = 0U;
-    TimerObject->IsRunning = 1U;
-    TimerObject->IsReloadStopped = 0U;
-    if( TimerListHead == NULL )
+    else if(( TimerHeap[0] == TimerObject ) || ( TimerArmed == NULL )
+         || TIMER_IS_BEFORE( TimerObject->Timestamp + TimerObject->Slack, TimerArmedTime ))
     {
-      UTIL_TimerDriver.SetTimerContext();
-      TimerInsertNewHeadTimer( TimerObject ); /* insert a timeout at now+obj->Timestamp */
+      /* new first timer to expire, or its window ends before the programmed time */
+      TimerSetTimeout( );
     }
-    else 
+    else
     {
-      elapsedTime = UTIL_TimerDriver.GetTimerElapsedTime( );
-      TimerObject->Timestamp += elapsedTime;
-      
-      if( TimerObject->Timestamp < TimerListHead->Timestamp )
-      {
-        TimerInsertNewHeadTimer( TimerObject);
-      }
-      else
-      {
-        TimerInsertTimer( TimerObject);
-      }
+      /* the low layer timer is already programmed within the window of this timer */
     }
-    UTIL_TIMER_EXIT_CRITICAL_SECTION();
   }
   else
   {
     ret =  UTIL_TIMER_INVALID_PARAM;
   }
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
   return ret;
 }
 
@@ -206,12 +311,18 @@ UTIL_TIMER_Status_t UTIL_TIMER_StartWithPeriod( UTIL_TIMER_Object_t *TimerObject
   }
   else
   {
+    UTIL_TIMER_ENTER_CRITICAL_SECTION();
     TimerObject->ReloadValue = UTIL_TimerDriver.ms2Tick(PeriodValue);
     if(TimerExists(TimerObject))
     {
-      (void)UTIL_TIMER_Stop(TimerObject);
+      /* restarted in place, no stop/start window where the heap can change */
+      TimerRestart(TimerObject);
     }
-    ret = UTIL_TIMER_Start(TimerObject);
+    else
+    {
+      ret = UTIL_TIMER_Start(TimerObject);
+    }
+    UTIL_TIMER_EXIT_CRITICAL_SECTION();
   }
   return ret;
 }
@@ -219,59 +330,34 @@ UTIL_TIMER_Status_t UTIL_TIMER_StartWithPeriod( UTIL_TIMER_Object_t *TimerObject
 UTIL_TIMER_Status_t UTIL_TIMER_Stop( UTIL_TIMER_Object_t *TimerObject )
 {
   UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
+  bool wasFirst;
 
   if (NULL != TimerObject)
   {
     UTIL_TIMER_ENTER_CRITICAL_SECTION();
-    UTIL_TIMER_Object_t* prev = TimerListHead;
-    UTIL_TIMER_Object_t* cur = TimerListHead;
     TimerObject->IsReloadStopped = 1U;
-    
-    /* List is empty or the Obj to stop does not exist  */
-    if(NULL != TimerListHead)
+
+    /* the Obj to stop may not be running */
+    if( TimerExists( TimerObject ) )
     {
       TimerObject->IsRunning = 0U;
-      
-      if( TimerListHead == TimerObject ) /* Stop the Head */
+      TimerObject->IsPending = 0U;
+      wasFirst = ( TimerHeap[0] == TimerObject );
+
+      TimerHeapRemove( TimerObject );
+
+      if( wasFirst )
       {
-          TimerListHead->IsPending = 0;
-          if( TimerListHead->Next != NULL )
-          {
-            TimerListHead = TimerListHead->Next;
-            TimerSetTimeout( TimerListHead );
-          }
-          else
-          {
-            UTIL_TimerDriver.StopTimerEvt( );
-            TimerListHead = NULL;
-          }
-      }
-      else /* Stop an object within the list */
-      {      
-        while( cur != NULL )
+        if( TimerHeapSize != 0U )
         {
-          if( cur == TimerObject )
-          {
-            if( cur->Next != NULL )
-            {
-              cur = cur->Next;
-              prev->Next = cur;
-            }
-            else
-            {
-              cur = NULL;
-              prev->Next = cur;
-            }
-            break;
-          }
-          else
-          {
-            prev = cur;
-            cur = cur->Next;
-          }
-        }   
+          TimerSetTimeout( );
+        }
+        else
+        {
+          UTIL_TimerDriver.StopTimerEvt( );
+          TimerArmed = NULL;
+        }
       }
-      ret = UTIL_TIMER_OK;
     }
     UTIL_TIMER_EXIT_CRITICAL_SECTION();
   }
@@ -292,12 +378,28 @@ UTIL_TIMER_Status_t UTIL_TIMER_SetPeriod(UTIL_TIMER_Object_t *TimerObject, uint3
   }
   else
   {
+    UTIL_TIMER_ENTER_CRITICAL_SECTION();
     TimerObject->ReloadValue = UTIL_TimerDriver.ms2Tick(NewPeriodValue);
     if(TimerExists(TimerObject))
     {
-      (void)UTIL_TIMER_Stop(TimerObject);
-      ret = UTIL_TIMER_Start(TimerObject);
+      TimerRestart(TimerObject);
     }
+    UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  }
+  return ret;
+}
+
+UTIL_TIMER_Status_t UTIL_TIMER_SetSlack(UTIL_TIMER_Object_t *TimerObject, uint32_t SlackValue)
+{
+  UTIL_TIMER_Status_t  ret = UTIL_TIMER_OK;
+
+  if(NULL == TimerObject)
+  {
+    ret = UTIL_TIMER_INVALID_PARAM;
+  }
+  else
+  {
+    TimerObject->Slack = UTIL_TimerDriver.ms2Tick(SlackValue);
   }
   return ret;
 }
@@ -320,22 +422,24 @@ UTIL_TIMER_Status_t UTIL_TIMER_SetReloadMode(UTIL_TIMER_Object_t *TimerObject, U
 UTIL_TIMER_Status_t UTIL_TIMER_GetRemainingTime(UTIL_TIMER_Object_t *TimerObject, uint32_t *ElapsedTime)
 {
   UTIL_TIMER_Status_t ret = UTIL_TIMER_OK;
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
   if(TimerExists(TimerObject))
   {
-    uint32_t time = UTIL_TimerDriver.GetTimerElapsedTime();
-    if (TimerObject->Timestamp < time )
+    uint32_t now = UTIL_TimerDriver.GetTimerValue();
+    if (TIMER_IS_BEFORE(TimerObject->Timestamp, now))
     {
       *ElapsedTime = 0;
     }
     else
     {
-      *ElapsedTime = TimerObject->Timestamp - time;
+      *ElapsedTime = TimerObject->Timestamp - now;
     }
   }
   else
   {
     ret = UTIL_TIMER_INVALID_PARAM;
   }
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
   return ret;
 }
 
@@ -355,77 +459,88 @@ uint32_t UTIL_TIMER_GetFirstRemainingTime(void)
 {
 	uint32_t NextTimer = 0xFFFFFFFFU;
 
-	if(TimerListHead != NULL)
+	if(TimerHeapSize != 0U)
 	{
-		(void)UTIL_TIMER_GetRemainingTime(TimerListHead, &NextTimer);
+		(void)UTIL_TIMER_GetRemainingTime(TimerHeap[0], &NextTimer);
 	}
 	return NextTimer;
 }
 
-void UTIL_TIMER_IRQ_Handler( void )
+UTIL_TIMER_Status_t UTIL_TIMER_GetStats(UTIL_TIMER_Object_t *TimerObject, UTIL_TIMER_Stats_t *p_Stats)
 {
-  UTIL_TIMER_Object_t *cur, *exec = NULL;
-  uint32_t old, now, DeltaContext;
-  void ( *FunctionCallback )( void *) = NULL;
-  void *argument = NULL;
+#if (UTIL_TIMER_CONF_STATS == 1)
+  if((TimerObject == NULL) || (p_Stats == NULL))
+  {
+    return UTIL_TIMER_INVALID_PARAM;
+  }
 
   UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  *p_Stats = TimerObject->Stats;
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  return UTIL_TIMER_OK;
+#else
+  (void)TimerObject;
+  (void)p_Stats;
+  return UTIL_TIMER_INVALID_PARAM;
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+}
 
-  old  =  UTIL_TimerDriver.GetTimerContext( );
-  now  =  UTIL_TimerDriver.SetTimerContext( );
-  DeltaContext = now  - old; /*intentional wrap around */
-
-  /* update timeStamp based upon new Time Reference*/
-  /* because delta context should never exceed 2^32*/
-  if ( TimerListHead != NULL )
+UTIL_TIMER_Status_t UTIL_TIMER_ResetStats(UTIL_TIMER_Object_t *TimerObject)
+{
+#if (UTIL_TIMER_CONF_STATS == 1)
+  if(TimerObject == NULL)
   {
-    cur = TimerListHead;
-	do {
-      if (cur->Timestamp > DeltaContext)
-      {
-        cur->Timestamp -= DeltaContext;
-      }
-      else
-      {
-        cur->Timestamp = 0;
+    return UTIL_TIMER_INVALID_PARAM;
+  }
 
-        /* get the first expired timer and save it context callback */
-        if (FunctionCallback == NULL)
-        {
-            /* remove the current from the chain list as it is the first expired */
-            TimerListHead = TimerListHead->Next;
-            cur->IsPending = 0;
-            cur->IsRunning = 0;
-            /* save for execution when chain list is fully update */
-            if(( cur->Mode == UTIL_TIMER_PERIODIC) && (cur->IsReloadStopped == 0U))
-            {
-              exec = cur;
-            }
-            argument = cur->argument;
-            FunctionCallback = cur->Callback;
-        }
-      }
-      cur = cur->Next;
-    } while(cur != NULL);
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  TimerObject->Stats.Count = 0U;
+  TimerObject->Stats.MinLateness = 0xFFFFFFFFU;
+  TimerObject->Stats.MaxLateness = 0U;
+  TimerObject->Stats.TotalLateness = 0U;
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  return UTIL_TIMER_OK;
+#else
+  (void)TimerObject;
+  return UTIL_TIMER_INVALID_PARAM;
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+}
 
-	if (exec != NULL) (void)UTIL_TIMER_Start(exec);
+uint32_t UTIL_TIMER_GetRunningTimers(UTIL_TIMER_Object_t **p_List, uint32_t MaxNbr)
+{
+  uint32_t index;
 
-    /* start the next TimerListHead if it exists and it is not pending*/
-    if(( TimerListHead != NULL ) && (TimerListHead->IsPending == 0U))
-    {
-      TimerSetTimeout( TimerListHead );
-    }
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  for( index = 0U; ( index < TimerHeapSize ) && ( index < MaxNbr ); index++ )
+  {
+    p_List[index] = TimerHeap[index];
   }
-
   UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  return index;
+}
+
+UTIL_TIMER_HOT_CODE void UTIL_TIMER_IRQ_Handler( void )
+{
+  UTIL_TIMER_ProcessExpired( );
+}
 
-  // Call user call back
-  if (FunctionCallback != NULL)
+UTIL_TIMER_HOT_CODE void UTIL_TIMER_ProcessExpired( void )
+{
+  if( TimerProcessExpired( ) )
   {
-    FunctionCallback(argument);
+    UTIL_TIMER_DeferExpiry( );
   }
 }
 
+__WEAK void UTIL_TIMER_DeferExpiry( void )
+{
+  /*
+   * Unless specified by the application, the remaining expired timers are processed
+   * on the next low layer timer event (programmed with the minimum timeout)
+   */
+  return;
+}
+
 UTIL_TIMER_Time_t UTIL_TIMER_GetCurrentTime(void)
 {
   uint32_t now = UTIL_TimerDriver.GetTimerValue( );
@@ -442,7 +557,13 @@ UTIL_TIMER_Time_t UTIL_TIMER_GetElapsedTime(UTIL_TIMER_Time_t past )
 
 UTIL_TIMER_Object_t *UTIL_TIMER_GetTimerList(void)
 {
-  return TimerListHead;
+  UTIL_TIMER_Object_t *first = NULL;
+
+  if( TimerHeapSize != 0U )
+  {
+    first = TimerHeap[0];
+  }
+  return first;
 }
 
 /**
@@ -457,96 +578,412 @@ UTIL_TIMER_Object_t *UTIL_TIMER_GetTimerList(void)
   *  @{
   */
 /**
- * @brief Check if the Object to be added is not already in the list
+ * @brief Check if the Object is running in the heap
  *
  * @param TimerObject Structure containing the timer object parameters
- * @retval 1 (the object is already in the list) or 0
+ * @retval 1 (the object is already in the heap) or 0
  */
-bool TimerExists( UTIL_TIMER_Object_t *TimerObject )
+static bool TimerExists( UTIL_TIMER_Object_t *TimerObject )
 {
-  UTIL_TIMER_Object_t* cur = TimerListHead;
+  uint32_t index;
 
-  while( cur != NULL )
+  if( TimerObject == NULL )
   {
-    if( cur == TimerObject )
+    return false;
+  }
+
+  /* HeapIndex is only trusted when the heap entry points back on the object */
+  index = TimerObject->HeapIndex;
+  return ( ( index != 0U ) && ( index <= TimerHeapSize ) && ( TimerHeap[index - 1U] == TimerObject ) );
+}
+
+/**
+ * @brief Record a created timer, a timer created again is only counted once
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @retval true, or false when UTIL_TIMER_CONF_MAX_TIMER_NBR other timers are already created
+ */
+static bool TimerRegister( UTIL_TIMER_Object_t *TimerObject )
+{
+  uint32_t index;
+  bool ret = true;
+
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  for( index = 0U; ( index < TimerCreatedNbr ) && ( TimerCreated[index] != TimerObject ); index++ )
+  {
+  }
+
+  if( index == TimerCreatedNbr )
+  {
+    if( TimerCreatedNbr < UTIL_TIMER_CONF_MAX_TIMER_NBR )
     {
-      return true;
+      TimerCreated[TimerCreatedNbr] = TimerObject;
+      TimerCreatedNbr++;
     }
-    cur = cur->Next;
+    else
+    {
+      ret = false;
+    }
+  }
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+  return ret;
+}
+
+/**
+ * @brief Computes the absolute expiry time of a timer, one period from now.
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ */
+static void TimerSetExpiry( UTIL_TIMER_Object_t *TimerObject )
+{
+  uint32_t ticks = TimerObject->ReloadValue;
+  uint32_t minValue = UTIL_TimerDriver.GetMinimumTimeout( );
+
+  if( ticks < minValue )
+  {
+    ticks = minValue;
   }
-  return false;
+
+  TimerObject->Timestamp = UTIL_TimerDriver.GetTimerValue( ) + ticks; /* intentional wrap around */
 }
 
 /**
- * @brief Sets a timeout with the duration "timestamp"
+ * @brief Computes the absolute expiry time of a timer and adds it to the heap.
+ *
+ * @remark The low layer timer is not programmed.
  *
  * @param TimerObject Structure containing the timer object parameters
+ * @retval true when added, false when the heap is full
  */
-void TimerSetTimeout( UTIL_TIMER_Object_t *TimerObject )
+static bool TimerInsert( UTIL_TIMER_Object_t *TimerObject )
 {
-  uint32_t minTicks= UTIL_TimerDriver.GetMinimumTimeout( );
-  TimerObject->IsPending = 1;
+  TimerSetExpiry( TimerObject );
+  TimerObject->IsPending = 0U;
+  TimerObject->IsRunning = 1U;
+  TimerObject->IsReloadStopped = 0U;
 
-  /* In case deadline too soon */
-  if(TimerObject->Timestamp  < (UTIL_TimerDriver.GetTimerElapsedTime(  ) + minTicks) )
+  if( TimerHeapInsert( TimerObject ) == false )
   {
-	  TimerObject->Timestamp = UTIL_TimerDriver.GetTimerElapsedTime(  ) + minTicks;
+    TimerObject->IsRunning = 0U;
+    return false;
   }
-  UTIL_TimerDriver.StartTimerEvt( TimerObject->Timestamp );
+  return true;
 }
 
 /**
- * @brief Adds a timer to the list.
+ * @brief Restarts a timer of the heap from now : its entry is moved in place, then the low layer
+ *        timer is programmed again when the first timer or the programmed window changes.
  *
- * @remark The list is automatically sorted. The list head always contains the
- *     next timer to expire.
+ * @remark Called in critical section, the timer shall be in the heap.
  *
  * @param TimerObject Structure containing the timer object parameters
  */
-void TimerInsertTimer( UTIL_TIMER_Object_t *TimerObject)
+static void TimerRestart( UTIL_TIMER_Object_t *TimerObject )
+{
+  bool wasFirst = ( TimerHeap[0] == TimerObject );
+
+  TimerSetExpiry( TimerObject );
+  TimerObject->IsRunning = 1U;
+  TimerObject->IsReloadStopped = 0U;
+
+  TimerHeapSiftUp( (uint32_t)TimerObject->HeapIndex - 1U );
+  TimerHeapSiftDown( (uint32_t)TimerObject->HeapIndex - 1U );
+
+  if( wasFirst || ( TimerHeap[0] == TimerObject ) || ( TimerArmed == NULL )
+   || TIMER_IS_BEFORE( TimerObject->Timestamp + TimerObject->Slack, TimerArmedTime ))
+  {
+    TimerSetTimeout( );
+  }
+}
+
+/**
+ * @brief Removes up to UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ expired timers from the heap, restarts
+ *        the periodic ones in place, programs the low layer timer once, then calls all their callbacks
+ *        outside critical section.
+ *
+ * @retval true when expired timers remain in the heap
+ */
+UTIL_TIMER_HOT_CODE static bool TimerProcessExpired( void )
 {
-  UTIL_TIMER_Object_t* cur = TimerListHead;
-  UTIL_TIMER_Object_t* next = TimerListHead->Next;
+  UTIL_TIMER_Object_t *expired[UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ];
+#if (UTIL_TIMER_CONF_STATS == 1)
+  uint32_t deadline[UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ];
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+  UTIL_TIMER_Object_t *cur;
+  uint32_t count = 0U;
+  uint32_t trace_previous;
+  uint32_t index;
+  uint32_t now;
+  bool remaining;
+
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
 
-  while (cur->Next != NULL )
-  {  
-    if( TimerObject->Timestamp  > next->Timestamp )
+  now = UTIL_TimerDriver.GetTimerValue( );
+
+  while(( count < UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ ) && ( TimerHeapSize != 0U )
+     && ( TIMER_IS_BEFORE( now, TimerHeap[0]->Timestamp ) == false ))
+  {
+    cur = TimerHeap[0];
+#if (UTIL_TIMER_CONF_STATS == 1)
+    /* deadline that fired, before a periodic restart moves it to the next one */
+    deadline[count] = cur->Timestamp;
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+    if(( cur->Mode == UTIL_TIMER_PERIODIC ) && ( cur->IsReloadStopped == 0U ))
     {
-        cur = next;
-        next = next->Next;
+      /* periodic timers restart from now, so they cannot expire again in this pass */
+      TimerSetExpiry( cur );
+      TimerHeapSiftDown( 0U );
     }
     else
     {
-        cur->Next = TimerObject;
-        TimerObject->Next = next;
-        return;
+      TimerHeapRemove( cur );
+      cur->IsRunning = 0U;
+    }
+    cur->IsPending = 0U;
+    expired[count] = cur;
+    count++;
+  }
+
+  remaining = ( TimerHeapSize != 0U ) && ( TIMER_IS_BEFORE( now, TimerHeap[0]->Timestamp ) == false );
+
+  /* program the next timer to expire if it exists */
+  if( TimerHeapSize != 0U )
+  {
+    TimerSetTimeout( );
+  }
+  else
+  {
+    UTIL_TimerDriver.StopTimerEvt( );
+    TimerArmed = NULL;
+  }
 
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+
+  // Call user call backs, except the ones of the timers stopped in the meantime (i.e. by a previous call back)
+  for( index = 0U; index < count; index++ )
+  {
+    cur = expired[index];
+    if( cur->IsReloadStopped == 0U )
+    {
+#if (UTIL_TIMER_CONF_STATS == 1)
+      TimerRecordLateness( cur, UTIL_TimerDriver.GetTimerValue( ) - deadline[index] );
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+      trace_previous = UTIL_TIMER_CALLBACK_TRACE_ENTER( cur );
+      cur->Callback( cur->argument );
+      UTIL_TIMER_CALLBACK_TRACE_EXIT( trace_previous );
     }
   }
-  cur->Next = TimerObject;
-  TimerObject->Next = NULL;
+
+  return remaining;
 }
 
 /**
- * @brief Adds or replace the head timer of the list.
+ * @brief Programs the low layer timer on the first timer of the heap
+ *
+ * @remark The heap shall not be empty.
+ */
+static void TimerSetTimeout( void )
+{
+  UTIL_TIMER_Object_t *TimerObject = TimerHeap[0];
+  uint32_t minTicks = UTIL_TimerDriver.GetMinimumTimeout( );
+  uint32_t alarmTime = TimerCoalescedTime( );
+  uint32_t now;
+  uint32_t timeout;
+
+  if( TimerArmed != NULL )
+  {
+    TimerArmed->IsPending = 0U;
+  }
+  TimerArmed = TimerObject;
+  TimerObject->IsPending = 1U;
+
+  /* the low layer timer is programmed relatively to the context */
+  now = UTIL_TimerDriver.SetTimerContext( );
+  timeout = alarmTime - now;
+
+  /* In case deadline too soon */
+  if( TIMER_IS_BEFORE( alarmTime, now + minTicks ) )
+  {
+    timeout = minTicks;
+  }
+  TimerArmedTime = now + timeout;
+  UTIL_TimerDriver.StartTimerEvt( timeout );
+}
+
+#if (UTIL_TIMER_CONF_STATS == 1)
+/**
+ * @brief Updates the lateness statistics of a timer just before its callback is called
  *
  * @param TimerObject Structure containing the timer object parameters
+ * @param Lateness time in ticks between the expiry time of the timer and now
+ */
+static void TimerRecordLateness( UTIL_TIMER_Object_t *TimerObject, uint32_t Lateness )
+{
+  UTIL_TIMER_Stats_t *p_stats = &TimerObject->Stats;
+
+  UTIL_TIMER_ENTER_CRITICAL_SECTION();
+  p_stats->Count++;
+  p_stats->TotalLateness += Lateness;
+  if( Lateness < p_stats->MinLateness )
+  {
+    p_stats->MinLateness = Lateness;
+  }
+  if( Lateness > p_stats->MaxLateness )
+  {
+    p_stats->MaxLateness = Lateness;
+  }
+  UTIL_TIMER_EXIT_CRITICAL_SECTION();
+}
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
+
+/**
+ * @brief Computes the latest time at which all the timers expiring in the window of the first timer
+ *        can be served together: the earliest end of window (expiry time + slack) among them.
+ *
+ * @remark The heap shall not be empty. Only the timers expiring before the returned time are visited,
+ *         a sub heap is skipped as soon as its root expires after it.
  *
- * @remark The list is automatically sorted. The list head always contains the
- *         next timer to expire.
+ * @retval absolute time in ticks
  */
-void TimerInsertNewHeadTimer( UTIL_TIMER_Object_t *TimerObject )
+static uint32_t TimerCoalescedTime( void )
 {
-  UTIL_TIMER_Object_t* cur = TimerListHead;
+  /* depth first walk, at most one pending sibling per heap level */
+  uint8_t stack[16];
+  uint32_t top = 0U;
+  uint32_t index;
+  uint32_t child;
+  uint32_t limit = TimerHeap[0]->Timestamp + TimerHeap[0]->Slack;
+  UTIL_TIMER_Object_t *cur;
+
+  stack[top++] = 0U;
+  while( top != 0U )
+  {
+    index = stack[--top];
+    cur = TimerHeap[index];
+
+    if( TIMER_IS_BEFORE( cur->Timestamp, limit ) )
+    {
+      if( TIMER_IS_BEFORE( cur->Timestamp + cur->Slack, limit ) )
+      {
+        limit = cur->Timestamp + cur->Slack;
+      }
+
+      child = ( 2U * index ) + 1U;
+      if( child < TimerHeapSize )
+      {
+        stack[top++] = (uint8_t)child;
+      }
+      if( ( child + 1U ) < TimerHeapSize )
+      {
+        stack[top++] = (uint8_t)( child + 1U );
+      }
+    }
+  }
+  return limit;
+}
 
-  if( cur != NULL )
+/**
+ * @brief Adds a timer to the heap.
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @retval true when added, false when the heap is full
+ */
+static bool TimerHeapInsert( UTIL_TIMER_Object_t *TimerObject )
+{
+  if( TimerHeapSize >= UTIL_TIMER_CONF_MAX_TIMER_NBR )
   {
-    cur->IsPending = 0;
+    return false;
   }
 
-  TimerObject->Next = cur;
-  TimerListHead = TimerObject;
-  TimerSetTimeout( TimerListHead );
+  TimerHeap[TimerHeapSize] = TimerObject;
+  TimerObject->HeapIndex = (uint8_t)( TimerHeapSize + 1U );
+  TimerHeapSize++;
+  TimerHeapSiftUp( TimerHeapSize - 1U );
+  return true;
+}
+
+/**
+ * @brief Removes a timer from the heap.
+ *
+ * @param TimerObject Structure containing the timer object parameters, it shall be in the heap
+ */
+static void TimerHeapRemove( UTIL_TIMER_Object_t *TimerObject )
+{
+  uint32_t index = (uint32_t)TimerObject->HeapIndex - 1U;
+  UTIL_TIMER_Object_t *last;
+
+  TimerHeapSize--;
+  TimerObject->HeapIndex = 0U;
+
+  if( index != TimerHeapSize )
+  {
+    /* move the last timer in the hole then restore the heap order */
+    last = TimerHeap[TimerHeapSize];
+    TimerHeap[index] = last;
+    last->HeapIndex = (uint8_t)( index + 1U );
+    TimerHeapSiftUp( index );
+    TimerHeapSiftDown( last->HeapIndex - 1U );
+  }
+  TimerHeap[TimerHeapSize] = NULL;
+}
+
+/**
+ * @brief Moves up a timer of the heap until its parent expires before it.
+ *
+ * @param Index position of the timer in the heap
+ */
+static void TimerHeapSiftUp( uint32_t Index )
+{
+  UTIL_TIMER_Object_t *TimerObject = TimerHeap[Index];
+  uint32_t parent;
+
+  while( Index != 0U )
+  {
+    parent = ( Index - 1U ) / 2U;
+    if( TIMER_IS_BEFORE( TimerObject->Timestamp, TimerHeap[parent]->Timestamp ) == false )
+    {
+      break;
+    }
+    TimerHeap[Index] = TimerHeap[parent];
+    TimerHeap[Index]->HeapIndex = (uint8_t)( Index + 1U );
+    Index = parent;
+  }
+  TimerHeap[Index] = TimerObject;
+  TimerObject->HeapIndex = (uint8_t)( Index + 1U );
+}
+
+/**
+ * @brief Moves down a timer of the heap until its children expire after it.
+ *
+ * @param Index position of the timer in the heap
+ */
+static void TimerHeapSiftDown( uint32_t Index )
+{
+  UTIL_TIMER_Object_t *TimerObject = TimerHeap[Index];
+  uint32_t child;
+
+  for( ;; )
+  {
+    child = ( 2U * Index ) + 1U;
+    if( child >= TimerHeapSize )
+    {
+      break;
+    }
+    if( ( ( child + 1U ) < TimerHeapSize )
+     && TIMER_IS_BEFORE( TimerHeap[child + 1U]->Timestamp, TimerHeap[child]->Timestamp ) )
+    {
+      child++;
+    }
+    if( TIMER_IS_BEFORE( TimerHeap[child]->Timestamp, TimerObject->Timestamp ) == false )
+    {
+      break;
+    }
+    TimerHeap[Index] = TimerHeap[child];
+    TimerHeap[Index]->HeapIndex = (uint8_t)( Index + 1U );
+    Index = child;
+  }
+  TimerHeap[Index] = TimerObject;
+  TimerObject->HeapIndex = (uint8_t)( Index + 1U );
 }
 
 /**
@@ -556,4 +993,3 @@ void TimerInsertNewHeadTimer( UTIL_TIMER_Object_t *TimerObject )
 /**
   *  @}
   */
-
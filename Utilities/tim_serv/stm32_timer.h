@@ -82,20 +82,44 @@ typedef enum {
   UTIL_TIMER_UNKNOWN_ERROR = 3   /*!<Unknown Error.                    */
 } UTIL_TIMER_Status_t;
 
+/**
+  * @brief Timer lateness statistics (in ticks), only recorded when UTIL_TIMER_CONF_STATS is set to 1
+  *        The lateness is the time between the expiry time of the timer and the call of its callback.
+  */
+typedef struct
+{
+  uint32_t Count;               /*!<Number of callbacks called                      */
+  uint32_t MinLateness;         /*!<Lowest lateness                                 */
+  uint32_t MaxLateness;         /*!<Highest lateness                                */
+  uint64_t TotalLateness;       /*!<Sum of all the latenesses                       */
+} UTIL_TIMER_Stats_t;
+
+/**
+  * @brief Timer lateness statistics are disabled by default, can be enabled in utilities_conf.h
+  */
+#ifndef UTIL_TIMER_CONF_STATS
+  #define UTIL_TIMER_CONF_STATS  (0)
+#endif
+
 /**
   * @brief Timer object description
   */
 typedef struct TimerEvent_s
 {
-    uint32_t Timestamp;           /*!<Expiring timer value in ticks from TimerContext */
+    uint32_t Timestamp;           /*!<Absolute expiring timer value in ticks          */
     uint32_t ReloadValue;         /*!<Reload Value when Timer is restarted            */
     uint8_t IsPending;            /*!<Is the timer waiting for an event               */
     uint8_t IsRunning;            /*!<Is the timer running                            */
     uint8_t IsReloadStopped;      /*!<Is the reload stopped                           */
+    uint8_t HeapIndex;            /*!<Position in the timer heap + 1, 0 when stopped  */
+    uint32_t Slack;               /*!<Tolerated lateness in ticks                     */
+#if (UTIL_TIMER_CONF_STATS == 1)
+    UTIL_TIMER_Stats_t Stats;     /*!<Lateness statistics                             */
+#endif /* UTIL_TIMER_CONF_STATS == 1 */
     UTIL_TIMER_Mode_t Mode;       /*!<Timer type : one-shot/continuous                */
     void ( *Callback )( void *);  /*!<callback function                               */
     void *argument;               /*!<callback argument                               */
-	struct TimerEvent_s *Next;    /*!<Pointer to the next Timer object.               */
+	struct TimerEvent_s *Next;    /*!<Not used, always NULL (kept for compatibility)  */
 } UTIL_TIMER_Object_t;
 
 /**
@@ -217,6 +241,17 @@ UTIL_TIMER_Status_t UTIL_TIMER_Stop( UTIL_TIMER_Object_t *TimerObject );
   */
 UTIL_TIMER_Status_t UTIL_TIMER_SetPeriod(UTIL_TIMER_Object_t *TimerObject, uint32_t NewPeriodValue);
 
+/**
+ * @brief set the tolerated lateness of the timer (0 by default)
+ *        The timer server may delay the expiry of the timer up to this slack to serve it on the
+ *        same low layer timer event as other timers, which reduces the number of wakeups.
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @param SlackValue tolerated lateness in ms, taken into account on the next start of the timer
+ * @retval Status based on @ref UTIL_TIMER_Status_t
+ */
+UTIL_TIMER_Status_t UTIL_TIMER_SetSlack(UTIL_TIMER_Object_t *TimerObject, uint32_t SlackValue);
+
 /**
  * @brief update the period and start the timer
  *
@@ -268,9 +303,11 @@ UTIL_TIMER_Time_t UTIL_TIMER_GetCurrentTime(void);
 UTIL_TIMER_Time_t UTIL_TIMER_GetElapsedTime(UTIL_TIMER_Time_t past );
 
 /**
-  * @brief return the list of the current timer
+  * @brief return the first timer to expire
   *
-  * @retval pointer on @ref UTIL_TIMER_Object_t
+  * @retval pointer on @ref UTIL_TIMER_Object_t, NULL when no timer is running
+  *
+  * @Note : the running timers are stored in a heap, they are not chained with the Next field.
   *
   * @Note : the use of this function is dangerous and must be done with precaution, the risks are:
   *         1 - an update of this data structure may affect the operation of timer server
@@ -278,15 +315,60 @@ UTIL_TIMER_Time_t UTIL_TIMER_GetElapsedTime(UTIL_TIMER_Time_t past );
   */
 UTIL_TIMER_Object_t *UTIL_TIMER_GetTimerList(void);
 
+/**
+ * @brief get the lateness statistics of the timer
+ *        Only available when UTIL_TIMER_CONF_STATS is set to 1.
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @param p_Stats statistics of the timer (in ticks)
+ * @retval Status based on @ref UTIL_TIMER_Status_t
+ */
+UTIL_TIMER_Status_t UTIL_TIMER_GetStats(UTIL_TIMER_Object_t *TimerObject, UTIL_TIMER_Stats_t *p_Stats);
+
+/**
+ * @brief reset the lateness statistics of the timer
+ *
+ * @param TimerObject Structure containing the timer object parameters
+ * @retval Status based on @ref UTIL_TIMER_Status_t
+ */
+UTIL_TIMER_Status_t UTIL_TIMER_ResetStats(UTIL_TIMER_Object_t *TimerObject);
+
+/**
+ * @brief copy the list of the running timers (i.e. to dump their statistics)
+ *
+ * @param p_List array filled with the running timers
+ * @param MaxNbr size of the array
+ * @retval number of timers copied in the array
+ */
+uint32_t UTIL_TIMER_GetRunningTimers(UTIL_TIMER_Object_t **p_List, uint32_t MaxNbr);
+
 /**
  * @brief Timer IRQ event handler
  *
- * @note Head Timer Object is automatically removed from the List
+ * @note Expired Timer Objects are automatically removed from the heap, all of them (up to
+ *       UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ) are processed in one pass, see UTIL_TIMER_ProcessExpired()
  *
  * @note e.g. it is not needed to stop it
  */
 void UTIL_TIMER_IRQ_Handler( void );
 
+/**
+ * @brief Processes the expired timers: removes them from the heap, restarts the periodic ones,
+ *        programs the low layer timer once then calls their callbacks outside critical section.
+ *        When more than UTIL_TIMER_CONF_MAX_EXPIRY_PER_IRQ timers are expired, UTIL_TIMER_DeferExpiry() is called.
+ *
+ * @note Called by UTIL_TIMER_IRQ_Handler(), and by the application task that handles the deferred expiries.
+ */
+void UTIL_TIMER_ProcessExpired( void );
+
+/**
+ * @brief Called when expired timers remain after a UTIL_TIMER_ProcessExpired() pass.
+ *
+ * @note Weak function. When not implemented by the application, the remaining timers are processed on
+ *       the next low layer timer event. Else the application may schedule a task calling UTIL_TIMER_ProcessExpired().
+ */
+void UTIL_TIMER_DeferExpiry( void );
+
 /**
   * @}
   */
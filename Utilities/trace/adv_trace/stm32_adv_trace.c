@@ -110,6 +110,10 @@ typedef struct {
   uint16_t TraceWrPtr; /*!<write pointer the trace system.                            */
   uint16_t TraceSentSize; /*!<size of the latest transfer.                            */
   uint16_t TraceLock; /*!<lock counter of the trace system.                           */
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+  UTIL_ADV_TRACE_Stats_t Stats; /*!<statistics of the fifo.                             */
+  uint8_t  FifoFull; /*!<1 when the latest allocation has failed.                       */
+#endif
 } ADV_TRACE_Context;
 
 /**
@@ -152,6 +156,9 @@ static UTIL_ADV_TRACE_Status_t TRACE_Send(void);
 static void TRACE_Lock(void);
 static void TRACE_UnLock(void);
 static uint32_t TRACE_IsLocked(void);
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+static void TRACE_UpdateFill(void);
+#endif
 
 /**
  * @}
@@ -192,6 +199,24 @@ uint8_t UTIL_ADV_TRACE_IsBufferEmpty(void)
   return 0;
 }
 
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+void UTIL_ADV_TRACE_GetStats(UTIL_ADV_TRACE_Stats_t *pStats)
+{
+  UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION();
+  *pStats = ADV_TRACE_Ctx.Stats;
+  UTIL_ADV_TRACE_EXIT_CRITICAL_SECTION();
+  pStats->FifoSize = (uint16_t)UTIL_ADV_TRACE_FIFO_SIZE;
+}
+
+void UTIL_ADV_TRACE_ResetStats(void)
+{
+  UTIL_ADV_TRACE_ENTER_CRITICAL_SECTION();
+  (void)UTIL_ADV_TRACE_MEMSET8(&ADV_TRACE_Ctx.Stats, 0x0, sizeof(ADV_TRACE_Ctx.Stats));
+  ADV_TRACE_Ctx.FifoFull = 0u;
+  UTIL_ADV_TRACE_EXIT_CRITICAL_SECTION();
+}
+#endif
+
 UTIL_ADV_TRACE_Status_t UTIL_ADV_TRACE_StartRxProcess(void (*UserCallback)(uint8_t *PData, uint16_t Size, uint8_t Error))
 {
   /* start the RX process */
@@ -758,6 +783,10 @@ static int16_t TRACE_AllocateBufer(uint16_t Size, uint16_t *Pos)
     *Pos = ADV_TRACE_Ctx.TraceWrPtr;
     ADV_TRACE_Ctx.TraceWrPtr = (ADV_TRACE_Ctx.TraceWrPtr + Size) % UTIL_ADV_TRACE_FIFO_SIZE;
     ret = 0;
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+    TRACE_UpdateFill();
+    ADV_TRACE_Ctx.FifoFull = 0u;
+#endif
 #if defined(UTIL_ADV_TRACE_OVERRUN)
     if(ADV_TRACE_Ctx.OverRunStatus == TRACE_OVERRUN_EXECUTED)
     {
@@ -772,14 +801,25 @@ static int16_t TRACE_AllocateBufer(uint16_t Size, uint16_t *Pos)
     UTIL_ADV_TRACE_DEBUG("\n--TRACE_AllocateBufer(%d-%d::%d-%d)--\n",freesize - Size, Size, ADV_TRACE_Ctx.TraceRdPtr, ADV_TRACE_Ctx.TraceWrPtr);
 #endif
   }
-#if defined(UTIL_ADV_TRACE_OVERRUN)
+#if defined(UTIL_ADV_TRACE_OVERRUN) || (UTIL_ADV_TRACE_STATISTICS != 0)
   else
   {
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+    ADV_TRACE_Ctx.Stats.DroppedBytes += Size;
+    ADV_TRACE_Ctx.Stats.DroppedNbr++;
+    if(ADV_TRACE_Ctx.FifoFull == 0u)
+    {
+      ADV_TRACE_Ctx.FifoFull = 1u;
+      ADV_TRACE_Ctx.Stats.OverrunNbr++;
+    }
+#endif
+#if defined(UTIL_ADV_TRACE_OVERRUN)
     if((ADV_TRACE_Ctx.OverRunStatus == TRACE_OVERRUN_NONE) && (NULL != ADV_TRACE_Ctx.overrun_func))
     {
       UTIL_ADV_TRACE_DEBUG(":TRACE_OVERRUN_INDICATION");
       ADV_TRACE_Ctx.OverRunStatus = TRACE_OVERRUN_INDICATION;
     }
+#endif
   }
 #endif
 
@@ -787,6 +827,32 @@ static int16_t TRACE_AllocateBufer(uint16_t Size, uint16_t *Pos)
   return ret;
 }
 
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+/**
+ * @brief  Update the highest fill of the fifo, shall be called in critical section.
+ * @note   The bytes left unused at the end of the fifo by the unchunk mode are counted as occupied.
+ * @retval None.
+ */
+static void TRACE_UpdateFill(void)
+{
+  uint16_t fill;
+
+  if(ADV_TRACE_Ctx.TraceWrPtr >= ADV_TRACE_Ctx.TraceRdPtr)
+  {
+    fill = ADV_TRACE_Ctx.TraceWrPtr - ADV_TRACE_Ctx.TraceRdPtr;
+  }
+  else
+  {
+    fill = UTIL_ADV_TRACE_FIFO_SIZE - ADV_TRACE_Ctx.TraceRdPtr + ADV_TRACE_Ctx.TraceWrPtr;
+  }
+
+  if(fill > ADV_TRACE_Ctx.Stats.MaxFill)
+  {
+    ADV_TRACE_Ctx.Stats.MaxFill = fill;
+  }
+}
+#endif
+
 /**
  * @brief  Lock the trace buffer.
  * @retval None.
@@ -28,6 +28,10 @@ extern "C" {
 #include "stdint.h"
 #include "utilities_conf.h"
 
+#ifndef UTIL_ADV_TRACE_STATISTICS
+#define UTIL_ADV_TRACE_STATISTICS 0
+#endif
+
 /** @defgroup ADV_TRACE advanced tracer
   * @{
   */
@@ -62,6 +66,19 @@ typedef enum{
 #endif
 } UTIL_ADV_TRACE_Status_t;
 
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+/**
+ * @brief Advanced trace FIFO statistics
+ */
+typedef struct {
+  uint32_t DroppedBytes;    /*!< Number of bytes dropped because the fifo was full.            */
+  uint32_t DroppedNbr;      /*!< Number of traces dropped because the fifo was full.           */
+  uint32_t OverrunNbr;      /*!< Number of times the fifo became full (one per drop sequence). */
+  uint16_t MaxFill;         /*!< Highest number of bytes occupied in the fifo.                 */
+  uint16_t FifoSize;        /*!< Size of the fifo.                                             */
+} UTIL_ADV_TRACE_Stats_t;
+#endif
+
 /**
  * @brief Advanced trace driver definition
  */
@@ -167,6 +184,19 @@ void UTIL_ADV_TRACE_PreSendHook(void);
  */
 void UTIL_ADV_TRACE_PostSendHook(void);
 
+#if (UTIL_ADV_TRACE_STATISTICS != 0)
+/**
+ * @brief Get the statistics of the trace fifo
+ * @param pStats pointer on the statistics to fill
+ */
+void UTIL_ADV_TRACE_GetStats(UTIL_ADV_TRACE_Stats_t *pStats);
+
+/**
+ * @brief Reset the statistics of the trace fifo
+ */
+void UTIL_ADV_TRACE_ResetStats(void);
+#endif
+
 #if defined(UTIL_ADV_TRACE_OVERRUN)
 /**
  * @brief Register a function used to add overrun info inside the trace